@@ -0,0 +1,287 @@
+// Measures the per-frame time of the tracker on recorded or generated detections.
+//
+// Detections file format: one detection per line, `frame x y width height score label`, where
+// frame is a zero-based frame index; lines starting with `#` are ignored.
+
+#include <bytetrack/BatchTracker.h>
+#include <bytetrack/BYTETracker.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace byte_track;
+using Clock = std::chrono::steady_clock;
+
+using Recording = std::vector<std::vector<Object>>; //< Detections of each frame.
+
+struct Options
+{
+    std::string detectionsPath;
+    std::string recordPath;
+    int objectCount = 200;
+    int frameCount = 1000;
+    int streamCount = 1;
+    int threadCount = 0;
+    int64_t frameIntervalUs = 1000000 / 15;
+};
+
+void printUsage(const char* appName)
+{
+    std::cout << "Usage: " << appName << " [options]\n"
+        << "  --detections <file>  Recorded detections to track.\n"
+        << "  --objects <n>        Objects per frame of the generated detections ("
+            << Options().objectCount << ").\n"
+        << "  --frames <n>         Frames of the generated detections ("
+            << Options().frameCount << ").\n"
+        << "  --record <file>      Save the generated detections to the file.\n"
+        << "  --streams <n>        Streams tracked at once by BatchTracker ("
+            << Options().streamCount << ").\n"
+        << "  --threads <n>        BatchTracker threads, 0 for the hardware threads ("
+            << Options().threadCount << ").\n";
+}
+
+bool parseOptions(int argc, char** argv, Options* options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc)
+            return false;
+
+        const char* value = argv[++i];
+        if (arg == "--detections")
+            options->detectionsPath = value;
+        else if (arg == "--record")
+            options->recordPath = value;
+        else if (arg == "--objects")
+            options->objectCount = std::atoi(value);
+        else if (arg == "--frames")
+            options->frameCount = std::atoi(value);
+        else if (arg == "--streams")
+            options->streamCount = std::max(std::atoi(value), 1);
+        else if (arg == "--threads")
+            options->threadCount = std::max(std::atoi(value), 0);
+        else
+            return false;
+    }
+    return true;
+}
+
+bool loadRecording(const std::string& path, Recording* recording)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream stream(line);
+        size_t frame = 0;
+        float x = 0, y = 0, width = 0, height = 0, score = 0;
+        int label = 0;
+        if (!(stream >> frame >> x >> y >> width >> height >> score >> label))
+        {
+            std::cerr << "Invalid detection: " << line << std::endl;
+            return false;
+        }
+
+        if (recording->size() <= frame)
+            recording->resize(frame + 1);
+        (*recording)[frame].emplace_back(Rect<float>(x, y, width, height), label, score);
+    }
+    return true;
+}
+
+bool saveRecording(const std::string& path, const Recording& recording)
+{
+    std::ofstream file(path);
+    file << "# frame x y width height score label\n";
+    for (size_t frame = 0; frame < recording.size(); ++frame)
+    {
+        for (const auto& object: recording[frame])
+        {
+            const auto& rect = object.rect;
+            file << frame << ' ' << rect.x() << ' ' << rect.y() << ' ' << rect.width() << ' '
+                << rect.height() << ' ' << object.prob << ' ' << object.label << '\n';
+        }
+    }
+    return (bool) file;
+}
+
+/**
+ * Crowded scene: objects walk across a 1920x1080 frame with a noisy detector, which misses some
+ * objects and reports some of them with a low score; objects leaving the frame are replaced.
+ */
+Recording generateRecording(int objectCount, int frameCount)
+{
+    struct Walker
+    {
+        float x, y, vx, vy, width, height;
+        int label;
+    };
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> uniform(0, 1);
+    std::normal_distribution<float> noise(0, 1.5f);
+
+    const auto spawn =
+        [&]()
+        {
+            Walker walker;
+            walker.width = 20 + 40 * uniform(random);
+            walker.height = walker.width * (1.5f + uniform(random));
+            walker.x = uniform(random) * (1920 - walker.width);
+            walker.y = uniform(random) * (1080 - walker.height);
+            walker.vx = 6 * (uniform(random) - 0.5f);
+            walker.vy = 3 * (uniform(random) - 0.5f);
+            walker.label = uniform(random) < 0.8f ? 0 : 1;
+            return walker;
+        };
+
+    std::vector<Walker> walkers(objectCount);
+    std::generate(walkers.begin(), walkers.end(), spawn);
+
+    Recording recording(frameCount);
+    for (auto& objects: recording)
+    {
+        for (auto& walker: walkers)
+        {
+            walker.x += walker.vx;
+            walker.y += walker.vy;
+            if (walker.x < 0 || walker.y < 0
+                || walker.x + walker.width > 1920 || walker.y + walker.height > 1080)
+            {
+                walker = spawn();
+            }
+
+            const float chance = uniform(random);
+            if (chance < 0.05f)
+                continue; //< Missed detection.
+
+            const float score = chance < 0.2f ? 0.1f + 0.3f * uniform(random)
+                : 0.6f + 0.4f * uniform(random);
+            objects.emplace_back(
+                Rect<float>(walker.x + noise(random), walker.y + noise(random),
+                    walker.width + noise(random), walker.height + noise(random)),
+                walker.label, score);
+        }
+    }
+    return recording;
+}
+
+void printStats(const std::string& title, std::vector<double> durationsMs, double frameCount)
+{
+    if (durationsMs.empty())
+        return;
+
+    std::sort(durationsMs.begin(), durationsMs.end());
+    const auto percentile =
+        [&](double p) { return durationsMs[(size_t) (p * (durationsMs.size() - 1))]; };
+
+    double totalMs = 0;
+    for (const double duration: durationsMs)
+        totalMs += duration;
+
+    std::cout << title << ": mean " << totalMs / durationsMs.size()
+        << " ms, p50 " << percentile(0.5) << " ms, p95 " << percentile(0.95)
+        << " ms, p99 " << percentile(0.99) << " ms, max " << durationsMs.back()
+        << " ms, " << frameCount * 1000 / totalMs << " frames/s" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, &options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Recording recording;
+    if (!options.detectionsPath.empty())
+    {
+        if (!loadRecording(options.detectionsPath, &recording))
+        {
+            std::cerr << "Unable to load detections from " << options.detectionsPath << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        recording = generateRecording(options.objectCount, options.frameCount);
+        if (!options.recordPath.empty() && !saveRecording(options.recordPath, recording))
+        {
+            std::cerr << "Unable to save detections to " << options.recordPath << std::endl;
+            return 1;
+        }
+    }
+
+    size_t detectionCount = 0;
+    for (const auto& objects: recording)
+        detectionCount += objects.size();
+    std::cout << recording.size() << " frames, " << detectionCount << " detections" << std::endl;
+
+    const ByteTrackerConfig config;
+    std::vector<double> durationsMs;
+    durationsMs.reserve(recording.size());
+
+    if (options.streamCount == 1)
+    {
+        BYTETracker tracker(config);
+        size_t trackCount = 0;
+        for (size_t frame = 0; frame < recording.size(); ++frame)
+        {
+            const auto start = Clock::now();
+            const auto tracks =
+                tracker.update(recording[frame], (int64_t) frame * options.frameIntervalUs);
+            durationsMs.push_back(
+                std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            trackCount += tracks.size();
+        }
+        std::cout << trackCount / std::max<size_t>(recording.size(), 1)
+            << " tracks per frame on average" << std::endl;
+        printStats("Per frame", durationsMs, recording.size());
+        return 0;
+    }
+
+    // Each stream plays the recording from a different position.
+    BatchTracker tracker(config, options.threadCount);
+    std::vector<BatchTracker::Frame> batch(options.streamCount);
+    for (int stream = 0; stream < options.streamCount; ++stream)
+        batch[stream].streamId = std::to_string(stream);
+
+    for (size_t frame = 0; frame < recording.size(); ++frame)
+    {
+        for (int stream = 0; stream < options.streamCount; ++stream)
+        {
+            const size_t offset = recording.size() * stream / options.streamCount;
+            batch[stream].objects = recording[(frame + offset) % recording.size()];
+            batch[stream].timestampUs = (int64_t) frame * options.frameIntervalUs;
+        }
+
+        const auto start = Clock::now();
+        tracker.update(batch);
+        durationsMs.push_back(
+            std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    printStats("Per batch of " + std::to_string(options.streamCount) + " frames", durationsMs,
+        (double) recording.size() * options.streamCount);
+    return 0;
+}
@@ -5,10 +5,13 @@
 #include <map>
 #include <memory>
 #include <stdexcept>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <iostream>
 
+#include <Eigen/Core>
+
 #include <nx/utils/log/assert.h>
 #include <nx/utils/log/log.h>
 
@@ -99,10 +102,10 @@ std::vector<byte_track::STrackPtr> byte_track::BYTETracker::update(
     std::vector<STrackPtr> refind_stracks;
 
     {
-        std::vector<std::vector<int>> matches_idx;
+        std::vector<std::pair<int, int>> matches_idx;
         std::vector<int> unmatch_detection_idx, unmatch_track_idx;
 
-        const auto dists = calcIouDistance(strack_pool, det_stracks);
+        const auto& dists = calcIouDistance(strack_pool, det_stracks);
         linearAssignment(dists,
             strack_pool.size(),
             det_stracks.size(),
@@ -113,8 +116,8 @@ std::vector<byte_track::STrackPtr> byte_track::BYTETracker::update(
 
         for (const auto &match_idx : matches_idx)
         {
-            const auto track = strack_pool[match_idx[0]];
-            const auto det = det_stracks[match_idx[1]];
+            const auto track = strack_pool[match_idx.first];
+            const auto det = det_stracks[match_idx.second];
             if (track->getSTrackState() == STrackState::Tracked)
             {
                 track->update(*det, frame_id_);
@@ -147,10 +150,10 @@ std::vector<byte_track::STrackPtr> byte_track::BYTETracker::update(
     std::vector<STrackPtr> current_removed_stracks;
 
     {
-        std::vector<std::vector<int>> matches_idx;
+        std::vector<std::pair<int, int>> matches_idx;
         std::vector<int> unmatch_track_idx, unmatch_detection_idx;
 
-        const auto dists = calcIouDistance(remain_tracked_stracks, det_low_stracks);
+        const auto& dists = calcIouDistance(remain_tracked_stracks, det_low_stracks);
         linearAssignment(dists,
             remain_tracked_stracks.size(),
             det_low_stracks.size(),
@@ -161,8 +164,8 @@ std::vector<byte_track::STrackPtr> byte_track::BYTETracker::update(
 
         for (const auto &match_idx : matches_idx)
         {
-            const auto track = remain_tracked_stracks[match_idx[0]];
-            const auto det = det_low_stracks[match_idx[1]];
+            const auto track = remain_tracked_stracks[match_idx.first];
+            const auto det = det_low_stracks[match_idx.second];
 
             if (m_timestampUs - track->getGoodUpdateTimestampUs()
                 > m_config.maxTimeWithoutGoodUpdateMs * 1000)
@@ -199,9 +202,9 @@ std::vector<byte_track::STrackPtr> byte_track::BYTETracker::update(
     {
         std::vector<int> unmatch_detection_idx;
         std::vector<int> unmatch_unconfirmed_idx;
-        std::vector<std::vector<int>> matches_idx;
+        std::vector<std::pair<int, int>> matches_idx;
 
-        const auto dists = calcIouDistance(non_active_stracks, remain_det_stracks);
+        const auto& dists = calcIouDistance(non_active_stracks, remain_det_stracks);
         linearAssignment(dists,
             non_active_stracks.size(),
             remain_det_stracks.size(),
@@ -212,8 +215,8 @@ std::vector<byte_track::STrackPtr> byte_track::BYTETracker::update(
 
         for (const auto &match_idx : matches_idx)
         {
-            non_active_stracks[match_idx[0]]->update(*remain_det_stracks[match_idx[1]], frame_id_);
-            current_tracked_stracks.push_back(non_active_stracks[match_idx[0]]);
+            non_active_stracks[match_idx.first]->update(*remain_det_stracks[match_idx.second], frame_id_);
+            current_tracked_stracks.push_back(non_active_stracks[match_idx.first]);
         }
 
         for (const auto &unmatch_idx : unmatch_unconfirmed_idx)
@@ -262,19 +265,19 @@ std::vector<byte_track::STrackPtr> byte_track::BYTETracker::update(
 std::vector<byte_track::STrackPtr> byte_track::BYTETracker::jointStracks(const std::vector<STrackPtr> &a_tlist,
                                                                                       const std::vector<STrackPtr> &b_tlist) const
 {
-    std::map<int, int> exists;
+    std::unordered_set<int> exists;
+    exists.reserve(a_tlist.size() + b_tlist.size());
     std::vector<STrackPtr> res;
+    res.reserve(a_tlist.size() + b_tlist.size());
     for (size_t i = 0; i < a_tlist.size(); i++)
     {
-        exists.emplace(a_tlist[i]->getTrackId(), 1);
+        exists.insert((int) a_tlist[i]->getTrackId());
         res.push_back(a_tlist[i]);
     }
     for (size_t i = 0; i < b_tlist.size(); i++)
     {
-        const int &tid = b_tlist[i]->getTrackId();
-        if (!exists[tid] || exists.count(tid) == 0)
+        if (exists.insert((int) b_tlist[i]->getTrackId()).second)
         {
-            exists[tid] = 1;
             res.push_back(b_tlist[i]);
         }
     }
@@ -312,34 +315,31 @@ std::vector<byte_track::STrackPtr> byte_track::BYTETracker::subStracks(const std
 void byte_track::BYTETracker::removeDuplicateStracks(const std::vector<STrackPtr> &a_stracks,
                                                      const std::vector<STrackPtr> &b_stracks,
                                                      std::vector<STrackPtr> &a_res,
-                                                     std::vector<STrackPtr> &b_res) const
+                                                     std::vector<STrackPtr> &b_res)
 {
-    const auto ious = calcIouDistance(a_stracks, b_stracks);
+    const auto& ious = calcIouDistance(a_stracks, b_stracks);
 
-    std::vector<std::pair<size_t, size_t>> overlapping_combinations;
-    for (size_t i = 0; i < ious.size(); i++)
+    std::vector<bool> a_overlapping(a_stracks.size(), false), b_overlapping(b_stracks.size(), false);
+    for (int a_idx = 0; a_idx < ious.rows; a_idx++)
     {
-        for (size_t j = 0; j < ious[i].size(); j++)
+        const float* row = ious.row(a_idx);
+        for (int b_idx = 0; b_idx < ious.cols; b_idx++)
         {
-            if (ious[i][j] < m_config.iouRemoveDuplicateThreshold)
+            if (row[b_idx] >= m_config.iouRemoveDuplicateThreshold)
             {
-                overlapping_combinations.emplace_back(i, j);
+                continue;
             }
-        }
-    }
 
-    std::vector<bool> a_overlapping(a_stracks.size(), false), b_overlapping(b_stracks.size(), false);
-    for (const auto &[a_idx, b_idx] : overlapping_combinations)
-    {
-        const int timep = a_stracks[a_idx]->getFrameId() - a_stracks[a_idx]->getStartFrameId();
-        const int timeq = b_stracks[b_idx]->getFrameId() - b_stracks[b_idx]->getStartFrameId();
-        if (timep > timeq)
-        {
-            b_overlapping[b_idx] = true;
-        }
-        else
-        {
-            a_overlapping[a_idx] = true;
+            const int timep = a_stracks[a_idx]->getFrameId() - a_stracks[a_idx]->getStartFrameId();
+            const int timeq = b_stracks[b_idx]->getFrameId() - b_stracks[b_idx]->getStartFrameId();
+            if (timep > timeq)
+            {
+                b_overlapping[b_idx] = true;
+            }
+            else
+            {
+                a_overlapping[a_idx] = true;
+            }
         }
     }
 
@@ -360,15 +360,15 @@ void byte_track::BYTETracker::removeDuplicateStracks(const std::vector<STrackPtr
     }
 }
 
-void byte_track::BYTETracker::linearAssignment(const std::vector<std::vector<float>> &cost_matrix,
+void byte_track::BYTETracker::linearAssignment(const CostMatrix &cost_matrix,
                                                const int &cost_matrix_size,
                                                const int &cost_matrix_size_size,
                                                const float &thresh,
-                                               std::vector<std::vector<int>> &matches,
+                                               std::vector<std::pair<int, int>> &matches,
                                                std::vector<int> &a_unmatched,
-                                               std::vector<int> &b_unmatched) const
+                                               std::vector<int> &b_unmatched)
 {
-    if (cost_matrix.size() == 0)
+    if (cost_matrix.empty())
     {
         for (int i = 0; i < cost_matrix_size; i++)
         {
@@ -381,16 +381,12 @@ void byte_track::BYTETracker::linearAssignment(const std::vector<std::vector<flo
         return;
     }
 
-    std::vector<int> rowsol; std::vector<int> colsol;
-    execLapjv(cost_matrix, rowsol, colsol, true, thresh);
-    for (size_t i = 0; i < rowsol.size(); i++)
+    execLapjv(cost_matrix, m_rowsol, m_colsol, true, thresh);
+    for (size_t i = 0; i < m_rowsol.size(); i++)
     {
-        if (rowsol[i] >= 0)
+        if (m_rowsol[i] >= 0)
         {
-            std::vector<int> match;
-            match.push_back(i);
-            match.push_back(rowsol[i]);
-            matches.push_back(match);
+            matches.emplace_back((int) i, m_rowsol[i]);
         }
         else
         {
@@ -398,88 +394,98 @@ void byte_track::BYTETracker::linearAssignment(const std::vector<std::vector<flo
         }
     }
 
-    for (size_t i = 0; i < colsol.size(); i++)
+    for (size_t i = 0; i < m_colsol.size(); i++)
     {
-        if (colsol[i] < 0)
+        if (m_colsol[i] < 0)
         {
             b_unmatched.push_back(i);
         }
     }
 }
 
-std::vector<std::vector<float>> byte_track::BYTETracker::calcIous(const std::vector<Rect<float>> &a_rect,
-                                                                  const std::vector<Rect<float>> &b_rect) const
+void byte_track::CostMatrix::resize(int rowCount, int colCount)
 {
-    std::vector<std::vector<float>> ious;
-    if (a_rect.size() * b_rect.size() == 0)
-    {
-        return ious;
-    }
-
-    ious.resize(a_rect.size());
-    for (size_t i = 0; i < ious.size(); i++)
-    {
-        ious[i].resize(b_rect.size());
-    }
+    rows = rowCount;
+    cols = colCount;
+    // Does not free the memory when shrinking, so the buffer stops growing after a few frames.
+    data.resize((size_t) rows * cols);
+}
 
-    for (size_t bi = 0; bi < b_rect.size(); bi++)
-    {
-        for (size_t ai = 0; ai < a_rect.size(); ai++)
-        {
-            ious[ai][bi] = b_rect[bi].calcIoU(a_rect[ai]);
-        }
+void byte_track::BoxSet::assign(const std::vector<STrackPtr>& tracks)
+{
+    const size_t count = tracks.size();
+    x1.resize(count);
+    y1.resize(count);
+    x2.resize(count);
+    y2.resize(count);
+    area.resize(count);
+    spanArea.resize(count);
+    objectClass.resize(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto& rect = tracks[i]->getRect();
+        x1[i] = rect.x();
+        y1[i] = rect.y();
+        x2[i] = rect.x() + rect.width();
+        y2[i] = rect.y() + rect.height();
+        area[i] = (rect.width() + 1) * (rect.height() + 1);
+        spanArea[i] = (x2[i] - x1[i] + 1) * (y2[i] - y1[i] + 1);
+        objectClass[i] = tracks[i]->getObjectClass();
     }
-    return ious;
 }
 
-std::vector<std::vector<float> > byte_track::BYTETracker::calcIouDistance(const std::vector<STrackPtr> &a_tracks,
-                                                                          const std::vector<STrackPtr> &b_tracks,
-                                                                          bool checkTrackClass) const
+const byte_track::CostMatrix& byte_track::BYTETracker::calcIouDistance(
+    const std::vector<STrackPtr> &a_tracks,
+    const std::vector<STrackPtr> &b_tracks,
+    bool checkTrackClass)
 {
-    std::vector<byte_track::Rect<float>> a_rects, b_rects;
-    for (size_t i = 0; i < a_tracks.size(); i++)
+    if (a_tracks.empty() || b_tracks.empty())
     {
-        a_rects.push_back(a_tracks[i]->getRect());
+        m_costMatrix.resize(0, 0);
+        return m_costMatrix;
     }
 
-    for (size_t i = 0; i < b_tracks.size(); i++)
-    {
-        b_rects.push_back(b_tracks[i]->getRect());
-    }
+    m_aBoxes.assign(a_tracks);
+    m_bBoxes.assign(b_tracks);
+    m_costMatrix.resize(m_aBoxes.size(), m_bBoxes.size());
 
-    const auto ious = calcIous(a_rects, b_rects);
+    using FloatArray = Eigen::Map<const Eigen::ArrayXf>;
+    using IntArray = Eigen::Map<const Eigen::ArrayXi>;
+    const int b_count = m_bBoxes.size();
+    const FloatArray b_x1(m_bBoxes.x1.data(), b_count);
+    const FloatArray b_y1(m_bBoxes.y1.data(), b_count);
+    const FloatArray b_x2(m_bBoxes.x2.data(), b_count);
+    const FloatArray b_y2(m_bBoxes.y2.data(), b_count);
+    const FloatArray b_spanArea(m_bBoxes.spanArea.data(), b_count);
+    const IntArray b_objectClass(m_bBoxes.objectClass.data(), b_count);
 
-    std::vector<std::vector<float>> cost_matrix;
-    for (size_t i = 0; i < ious.size(); i++) // a_tracks
+    // Each row is computed for all the b boxes at once, with the same rounding as Rect::calcIoU()
+    // called for the b box with the a box as an argument.
+    for (int ai = 0; ai < m_aBoxes.size(); ai++)
     {
-        std::vector<float> iou;
-        for (size_t j = 0; j < ious[i].size(); j++) // b_tracks
-        {
-            auto value = ious[i][j];
-            if (checkTrackClass && a_tracks[i]->getObjectClass() != b_tracks[j]->getObjectClass())
-                value = 0.0;
-            iou.push_back(1 - value);
-        }
-        cost_matrix.push_back(iou);
+        const auto iw = (b_x2.min(m_aBoxes.x2[ai]) - b_x1.max(m_aBoxes.x1[ai]) + 1).max(0.0f);
+        const auto ih = (b_y2.min(m_aBoxes.y2[ai]) - b_y1.max(m_aBoxes.y1[ai]) + 1).max(0.0f);
+        const Eigen::ArrayXf intersection = iw * ih;
+        Eigen::ArrayXf iou = intersection / (b_spanArea + m_aBoxes.area[ai] - intersection);
+        if (checkTrackClass)
+            iou = (b_objectClass == m_aBoxes.objectClass[ai]).select(iou, 0.0f);
+
+        Eigen::Map<Eigen::ArrayXf>(m_costMatrix.row(ai), b_count) = 1 - iou;
     }
 
-    return cost_matrix;
+    return m_costMatrix;
 }
 
-double byte_track::BYTETracker::execLapjv(const std::vector<std::vector<float>> &cost,
+double byte_track::BYTETracker::execLapjv(const CostMatrix &cost,
                                           std::vector<int> &rowsol,
                                           std::vector<int> &colsol,
                                           bool extend_cost,
                                           float cost_limit,
-                                          bool return_cost) const
+                                          bool return_cost)
 {
-    std::vector<std::vector<float> > cost_c;
-    cost_c.assign(cost.begin(), cost.end());
-
-    std::vector<std::vector<float> > cost_c_extended;
-
-    int n_rows = cost.size();
-    int n_cols = cost[0].size();
+    const int n_rows = cost.rows;
+    const int n_cols = cost.cols;
     rowsol.resize(n_rows);
     colsol.resize(n_cols);
 
@@ -496,79 +502,65 @@ double byte_track::BYTETracker::execLapjv(const std::vector<std::vector<float>>
         }
     }
 
-    if (extend_cost || cost_limit < std::numeric_limits<float>::max())
+    const bool extended = extend_cost || cost_limit < std::numeric_limits<float>::max();
+    if (extended)
     {
         n = n_rows + n_cols;
-        cost_c_extended.resize(n);
-        for (size_t i = 0; i < cost_c_extended.size(); i++)
-            cost_c_extended[i].resize(n);
+    }
+
+    m_lapjvCosts.resize((size_t) n * n);
+    m_lapjvRows.resize(n);
+    m_lapjvX.resize(n);
+    m_lapjvY.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        m_lapjvRows[i] = m_lapjvCosts.data() + (size_t) i * n;
+    }
 
+    if (extended)
+    {
+        // The padding values are rounded to float, as the cost values are.
+        float padding = 0;
         if (cost_limit < std::numeric_limits<float>::max())
         {
-            for (size_t i = 0; i < cost_c_extended.size(); i++)
-            {
-                for (size_t j = 0; j < cost_c_extended[i].size(); j++)
-                {
-                    cost_c_extended[i][j] = cost_limit / 2.0;
-                }
-            }
+            padding = cost_limit / 2.0;
         }
         else
         {
             float cost_max = -1;
-            for (size_t i = 0; i < cost_c.size(); i++)
-            {
-                for (size_t j = 0; j < cost_c[i].size(); j++)
-                {
-                    if (cost_c[i][j] > cost_max)
-                        cost_max = cost_c[i][j];
-                }
-            }
-            for (size_t i = 0; i < cost_c_extended.size(); i++)
+            for (const float value: cost.data)
             {
-                for (size_t j = 0; j < cost_c_extended[i].size(); j++)
-                {
-                    cost_c_extended[i][j] = cost_max + 1;
-                }
+                if (value > cost_max)
+                    cost_max = value;
             }
+            padding = cost_max + 1;
         }
 
-        for (size_t i = n_rows; i < cost_c_extended.size(); i++)
+        for (int i = 0; i < n; i++)
         {
-            for (size_t j = n_cols; j < cost_c_extended[i].size(); j++)
+            double* row = m_lapjvRows[i];
+            if (i < n_rows)
             {
-                cost_c_extended[i][j] = 0;
+                const float* cost_row = cost.row(i);
+                std::copy(cost_row, cost_row + n_cols, row);
+                std::fill(row + n_cols, row + n, padding);
             }
-        }
-        for (int i = 0; i < n_rows; i++)
-        {
-            for (int j = 0; j < n_cols; j++)
+            else
             {
-                cost_c_extended[i][j] = cost_c[i][j];
+                std::fill(row, row + n_cols, padding);
+                std::fill(row + n_cols, row + n, 0.0);
             }
         }
-
-        cost_c.clear();
-        cost_c.assign(cost_c_extended.begin(), cost_c_extended.end());
     }
-
-    double **cost_ptr;
-    cost_ptr = new double *[sizeof(double *) * n];
-    for (int i = 0; i < n; i++)
-        cost_ptr[i] = new double[sizeof(double) * n];
-
-    for (int i = 0; i < n; i++)
+    else
     {
-        for (int j = 0; j < n; j++)
-        {
-            cost_ptr[i][j] = cost_c[i][j];
-        }
+        std::copy(cost.data.begin(), cost.data.end(), m_lapjvCosts.begin());
     }
 
-    int* x_c = new int[sizeof(int) * n];
-    int *y_c = new int[sizeof(int) * n];
+    int* x_c = m_lapjvX.data();
+    int* y_c = m_lapjvY.data();
 
-    int ret = lapjv_internal(n, cost_ptr, x_c, y_c);
+    int ret = lapjv_internal(n, m_lapjvRows.data(), x_c, y_c);
     if (ret != 0)
     {
         throw std::runtime_error("The result of lapjv_internal() is invalid.");
@@ -600,7 +592,7 @@ double byte_track::BYTETracker::execLapjv(const std::vector<std::vector<float>>
             {
                 if (rowsol[i] != -1)
                 {
-                    opt += cost_ptr[i][rowsol[i]];
+                    opt += m_lapjvRows[i][rowsol[i]];
                 }
             }
         }
@@ -609,18 +601,10 @@ double byte_track::BYTETracker::execLapjv(const std::vector<std::vector<float>>
     {
         for (size_t i = 0; i < rowsol.size(); i++)
         {
-            opt += cost_ptr[i][rowsol[i]];
+            opt += m_lapjvRows[i][rowsol[i]];
         }
     }
 
-    for (int i = 0; i < n; i++)
-    {
-        delete[]cost_ptr[i];
-    }
-    delete[]cost_ptr;
-    delete[]x_c;
-    delete[]y_c;
-
     return opt;
 }
 
@@ -10,6 +10,8 @@
 #include <memory>
 #include <vector>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 
 namespace byte_track
 {
@@ -37,6 +39,38 @@ struct ByteTrackerConfig
     virtual ~ByteTrackerConfig() = default;
 };
 
+// Association costs between tracks (rows) and detections (columns), stored row-major in a single
+// buffer which is reused from frame to frame.
+struct CostMatrix
+{
+    int rows = 0;
+    int cols = 0;
+    std::vector<float> data;
+
+    void resize(int rowCount, int colCount);
+    bool empty() const { return rows == 0 || cols == 0; }
+    float* row(int i) { return data.data() + (size_t) i * cols; }
+    const float* row(int i) const { return data.data() + (size_t) i * cols; }
+};
+
+// Boxes of a track list in structure-of-arrays layout, so that the IoU of one box against all
+// the others is computed with vector instructions.
+struct BoxSet
+{
+    std::vector<float> x1;
+    std::vector<float> y1;
+    std::vector<float> x2;
+    std::vector<float> y2;
+    // (width + 1) * (height + 1), as the box of the other rect in Rect::calcIoU().
+    std::vector<float> area;
+    // (x2 - x1 + 1) * (y2 - y1 + 1), as the box of this rect in Rect::calcIoU().
+    std::vector<float> spanArea;
+    std::vector<int> objectClass;
+
+    void assign(const std::vector<STrackPtr>& tracks);
+    int size() const { return (int) x1.size(); }
+};
+
 class BYTETracker
 {
 public:
@@ -60,32 +94,30 @@ private:
     void removeDuplicateStracks(const std::vector<STrackPtr> &a_stracks,
                                 const std::vector<STrackPtr> &b_stracks,
                                 std::vector<STrackPtr> &a_res,
-                                std::vector<STrackPtr> &b_res) const;
+                                std::vector<STrackPtr> &b_res);
 
     // Solver linear assignment problem to find best association between new detections and existing tracks.
-    void linearAssignment(const std::vector<std::vector<float>> &cost_matrix,
+    void linearAssignment(const CostMatrix &cost_matrix,
                           const int &cost_matrix_size,
                           const int &cost_matrix_size_size,
                           const float &thresh,
-                          std::vector<std::vector<int>> &matches,
+                          std::vector<std::pair<int, int>> &matches,
                           std::vector<int> &b_unmatched,
-                          std::vector<int> &a_unmatched) const;
+                          std::vector<int> &a_unmatched);
 
-    // Calculate metric IOU (Intersection over Union) for input containers.
-    std::vector<std::vector<float>> calcIouDistance(const std::vector<STrackPtr> &a_tracks,
-                                                    const std::vector<STrackPtr> &b_tracks,
-                                                    bool checkTrackClass=true) const;
-
-    std::vector<std::vector<float>> calcIous(const std::vector<Rect<float>> &a_rect,
-                                             const std::vector<Rect<float>> &b_rect) const;
+    // Calculate metric IOU (Intersection over Union) distance for input containers into
+    // m_costMatrix.
+    const CostMatrix& calcIouDistance(const std::vector<STrackPtr> &a_tracks,
+                                      const std::vector<STrackPtr> &b_tracks,
+                                      bool checkTrackClass=true);
 
     // Wrapper for Linear Assignment Solver using Jonker-Volgenant algorithm.
-    double execLapjv(const std::vector<std::vector<float> > &cost,
+    double execLapjv(const CostMatrix &cost,
                      std::vector<int> &rowsol,
                      std::vector<int> &colsol,
                      bool extend_cost = false,
                      float cost_limit = std::numeric_limits<float>::max(),
-                     bool return_cost = true) const;
+                     bool return_cost = true);
 
     bool isGoodDetection(STrackPtr detection);
     bool isBirthDetection(STrackPtr detection);
@@ -103,6 +135,17 @@ private:
 
     std::vector<STrackPtr> tracked_stracks_;
     std::vector<STrackPtr> lost_stracks_;
+
+    // Scratch buffers of the association steps, kept between frames to avoid reallocations.
+    BoxSet m_aBoxes;
+    BoxSet m_bBoxes;
+    CostMatrix m_costMatrix;
+    std::vector<double> m_lapjvCosts;
+    std::vector<double*> m_lapjvRows;
+    std::vector<int> m_lapjvX;
+    std::vector<int> m_lapjvY;
+    std::vector<int> m_rowsol;
+    std::vector<int> m_colsol;
 };
 
 }
@@ -0,0 +1,160 @@
+#include "BatchTracker.h"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+byte_track::BatchTracker::BatchTracker(const ByteTrackerConfig& config, int threadCount):
+    m_config(config)
+{
+    if (threadCount <= 0)
+        threadCount = (int) std::max(std::thread::hardware_concurrency(), 1U);
+
+    for (int i = 1; i < threadCount; i++)
+        m_threads.emplace_back([this]() { workerThreadFunc(); });
+}
+
+byte_track::BatchTracker::~BatchTracker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_terminated = true;
+    }
+    m_batchStarted.notify_all();
+
+    for (auto& thread: m_threads)
+        thread.join();
+}
+
+std::vector<std::vector<byte_track::STrackPtr>> byte_track::BatchTracker::update(
+    const std::vector<Frame>& frames)
+{
+    std::vector<std::vector<STrackPtr>> results(frames.size());
+
+    // Trackers are created here, so that the workers do not modify m_trackers.
+    std::map<BYTETracker*, size_t> jobIndexes;
+    std::vector<StreamJob> jobs;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        auto& tracker = m_trackers[frames[i].streamId];
+        if (!tracker)
+        {
+            tracker = std::make_unique<BYTETracker>(m_config);
+            if (m_confidences)
+            {
+                std::apply(
+                    [&tracker](auto&&... args) { tracker->setConfidences(args...); },
+                    *m_confidences);
+            }
+        }
+
+        const auto [it, isNew] = jobIndexes.emplace(tracker.get(), jobs.size());
+        if (isNew)
+        {
+            jobs.emplace_back();
+            jobs.back().tracker = tracker.get();
+        }
+        jobs[it->second].frameIndexes.push_back(i);
+    }
+
+    if (jobs.empty())
+        return results;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frames = &frames;
+        m_results = &results;
+        m_jobs = std::move(jobs);
+        m_nextJob = 0;
+        m_unfinishedJobs = m_jobs.size();
+        m_error = nullptr;
+        ++m_batchNumber;
+    }
+    if (m_jobs.size() > 1)
+        m_batchStarted.notify_all();
+
+    runJobs();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batchFinished.wait(lock, [this]() { return m_unfinishedJobs == 0; });
+    m_frames = nullptr;
+    m_results = nullptr;
+    if (m_error)
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+
+    return results;
+}
+
+void byte_track::BatchTracker::removeStream(const std::string& streamId)
+{
+    m_trackers.erase(streamId);
+}
+
+void byte_track::BatchTracker::setConfidences(float defaultTrackBirthConfidence,
+    std::shared_ptr<ConfidenceMap> trackBirthConfidences,
+    float defaultGoodDetectionConfidence,
+    std::shared_ptr<ConfidenceMap> goodDetectionConfidences)
+{
+    m_confidences.emplace(defaultTrackBirthConfidence, trackBirthConfidences,
+        defaultGoodDetectionConfidence, goodDetectionConfidences);
+
+    for (auto& [streamId, tracker]: m_trackers)
+    {
+        tracker->setConfidences(defaultTrackBirthConfidence, trackBirthConfidences,
+            defaultGoodDetectionConfidence, goodDetectionConfidences);
+    }
+}
+
+void byte_track::BatchTracker::workerThreadFunc()
+{
+    uint64_t lastBatchNumber = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_batchStarted.wait(lock,
+                [&]() { return m_terminated || m_batchNumber != lastBatchNumber; });
+            if (m_terminated)
+                return;
+            lastBatchNumber = m_batchNumber;
+        }
+
+        runJobs();
+    }
+}
+
+void byte_track::BatchTracker::runJobs()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_frames && m_nextJob < m_jobs.size())
+    {
+        const StreamJob& job = m_jobs[m_nextJob++];
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+        {
+            runJob(job);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        if (error && !m_error)
+            m_error = error;
+        if (--m_unfinishedJobs == 0)
+            m_batchFinished.notify_all();
+    }
+}
+
+void byte_track::BatchTracker::runJob(const StreamJob& job)
+{
+    // A job is the only user of its tracker and of its frames' results during the batch.
+    for (const size_t frameIndex: job.frameIndexes)
+    {
+        const Frame& frame = (*m_frames)[frameIndex];
+        (*m_results)[frameIndex] = job.tracker->update(frame.objects, frame.timestampUs);
+    }
+}
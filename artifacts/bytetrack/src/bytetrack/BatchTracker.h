@@ -0,0 +1,88 @@
+#pragma once
+
+#include "BYTETracker.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace byte_track
+{
+// Tracks objects in several video streams at once. Each stream has its own BYTETracker; the
+// frames of different streams of a batch are processed in parallel by a fixed set of threads,
+// the frames of one stream are processed in their order in the batch.
+class BatchTracker
+{
+public:
+    struct Frame
+    {
+        std::string streamId;
+        std::vector<Object> objects;
+        std::optional<int64_t> timestampUs;
+    };
+
+    // threadCount of 0 means the number of hardware threads. The calling thread is counted too.
+    BatchTracker(const ByteTrackerConfig& config, int threadCount = 0);
+    ~BatchTracker();
+
+    BatchTracker(const BatchTracker&) = delete;
+    BatchTracker& operator=(const BatchTracker&) = delete;
+
+    // Returns the tracks of each frame, in the order of the frames.
+    std::vector<std::vector<STrackPtr>> update(const std::vector<Frame>& frames);
+
+    // Forgets the tracks of the stream, e.g. when the device is disabled.
+    void removeStream(const std::string& streamId);
+
+    // Applied to the trackers of the current and the future streams.
+    void setConfidences(float defaultTrackBirthConfidence,
+        std::shared_ptr<ConfidenceMap> trackBirthConfidences,
+        float defaultGoodDetectionConfidence,
+        std::shared_ptr<ConfidenceMap> goodDetectionConfidences);
+
+    size_t streamCount() const { return m_trackers.size(); }
+
+private:
+    // Frames of one stream in a batch.
+    struct StreamJob
+    {
+        BYTETracker* tracker = nullptr;
+        std::vector<size_t> frameIndexes;
+    };
+
+    void workerThreadFunc();
+    // Runs the jobs of the current batch until there are none left.
+    void runJobs();
+    void runJob(const StreamJob& job);
+
+private:
+    ByteTrackerConfig m_config;
+    std::optional<std::tuple<float, std::shared_ptr<ConfidenceMap>,
+        float, std::shared_ptr<ConfidenceMap>>> m_confidences;
+    std::map<std::string, std::unique_ptr<BYTETracker>> m_trackers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_batchStarted;
+    std::condition_variable m_batchFinished;
+    std::vector<std::thread> m_threads;
+    bool m_terminated = false;
+    uint64_t m_batchNumber = 0;
+
+    // State of the current batch, guarded by m_mutex.
+    const std::vector<Frame>* m_frames = nullptr;
+    std::vector<std::vector<STrackPtr>>* m_results = nullptr;
+    std::vector<StreamJob> m_jobs;
+    size_t m_nextJob = 0;
+    size_t m_unfinishedJobs = 0;
+    std::exception_ptr m_error;
+};
+
+}
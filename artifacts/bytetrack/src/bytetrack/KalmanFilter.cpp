@@ -7,16 +7,6 @@ byte_track::KalmanFilter::KalmanFilter(const float& std_weight_position,
     std_weight_position_(std_weight_position),
     std_weight_velocity_(std_weight_velocity)
 {
-    constexpr size_t ndim = 4;
-    constexpr float dt = 1;
-
-    motion_mat_ = Eigen::MatrixXf::Identity(8, 8);
-    update_mat_ = Eigen::MatrixXf::Identity(4, 8);
-
-    for (size_t i = 0; i < ndim; i++)
-    {
-        motion_mat_(i, ndim + i) = dt;
-    }
 }
 
 void byte_track::KalmanFilter::initiate(StateMean &mean, StateCov &covariance, const DetectBox &measurement)
@@ -50,11 +40,14 @@ void byte_track::KalmanFilter::predict(StateMean &mean, StateCov &covariance)
     std(6) = 1e-5;
     std(7) = std_weight_velocity_ * mean(3);
 
-    StateMean tmp = std.array().square();
-    StateCov motion_cov = tmp.asDiagonal(); // should be scaled by form of dy
+    StateMean tmp = std.array().square(); // should be scaled by form of dy
 
-    mean = motion_mat_ * mean.transpose(); // motion_mat_ scale by dt
-    covariance = motion_mat_ * covariance * (motion_mat_.transpose()) + motion_cov;
+    // The motion matrix is identity with dt = 1 added at (i, i + 4), so instead of the 8x8 matrix
+    // products (which dominate the per-track cost) the velocity blocks are added to the positions.
+    mean.head<4>() += mean.tail<4>();
+    covariance.topRows<4>() += covariance.bottomRows<4>();
+    covariance.leftCols<4>() += covariance.rightCols<4>();
+    covariance.diagonal() += tmp.transpose();
 }
 
 void byte_track::KalmanFilter::update(StateMean &mean, StateCov &covariance, const DetectBox &measurement)
@@ -63,7 +56,8 @@ void byte_track::KalmanFilter::update(StateMean &mean, StateCov &covariance, con
     StateHCov projected_cov;
     project(projected_mean, projected_cov, mean, covariance);
 
-    Eigen::Matrix<float, 4, 8> B = (covariance * (update_mat_.transpose())).transpose();
+    // The update matrix selects the first 4 state components.
+    Eigen::Matrix<float, 4, 8> B = covariance.leftCols<4>().transpose();
     Eigen::Matrix<float, 8, 4> kalman_gain = (projected_cov.llt().solve(B)).transpose();
     Eigen::Matrix<float, 1, 4> innovation = measurement - projected_mean;
 
@@ -81,8 +75,8 @@ void byte_track::KalmanFilter::project(StateHMean &projected_mean, StateHCov &pr
            1e-1,
            std_weight_position_ * mean(3);
 
-    projected_mean = update_mat_ * mean.transpose();
-    projected_covariance = update_mat_ * covariance * (update_mat_.transpose());
+    projected_mean = mean.head<4>();
+    projected_covariance = covariance.topLeftCorner<4, 4>();
 
     Eigen::Matrix<float, 4, 4> diag = std.asDiagonal();
     projected_covariance += diag.array().square().matrix();
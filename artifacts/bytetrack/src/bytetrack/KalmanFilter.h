@@ -32,9 +32,6 @@ private:
     float std_weight_position_ = 0.0;
     float std_weight_velocity_ = 0.0;
 
-    Eigen::Matrix<float, 8, 8, Eigen::RowMajor> motion_mat_;
-    Eigen::Matrix<float, 4, 8, Eigen::RowMajor> update_mat_;
-
     void project(StateHMean &projected_mean, StateHCov &projected_covariance,
                  const StateMean& mean, const StateCov& covariance);
 };
@@ -2,6 +2,8 @@
 
 #include "channel_partner_client.h"
 
+#include <algorithm>
+
 #include <nx/network/http/http_client.h>
 #include <nx/network/http/rest/http_rest_client.h>
 
@@ -67,6 +69,11 @@ ChannelPartnerClient::~ChannelPartnerClient()
     pleaseStopSync();
 }
 
+void ChannelPartnerClient::setMaxConcurrentRequests(int value)
+{
+    m_maxConcurrentRequests = std::max(1, value);
+}
+
 void ChannelPartnerClient::bindSystemToOrganization(
     api::SystemRegistrationRequest data,
     nx::utils::MoveOnlyFunc<void(api::Result, api::SystemRegistrationResponse)> handler)
@@ -148,4 +155,97 @@ void ChannelPartnerClient::getAllOrganizationsUsers(
         std::move(handler));
 }
 
+void ChannelPartnerClient::getOrganizations(
+    std::vector<std::string> organizationIds,
+    nx::utils::MoveOnlyFunc<void(api::Result, std::vector<api::Organization>)> handler)
+{
+    requestAll<api::Organization>(
+        std::move(organizationIds), &ChannelPartnerClient::getOrganization, std::move(handler));
+}
+
+void ChannelPartnerClient::getSystemsUsers(
+    std::vector<std::string> systemIds,
+    nx::utils::MoveOnlyFunc<void(api::Result, std::vector<std::vector<api::User>>)> handler)
+{
+    requestAll<std::vector<api::User>>(
+        std::move(systemIds), &ChannelPartnerClient::getSystemUsers, std::move(handler));
+}
+
+void ChannelPartnerClient::getUsersSystems(
+    std::vector<std::string> emails,
+    nx::utils::MoveOnlyFunc<void(api::Result, std::vector<std::vector<api::SystemAllowance>>)>
+        handler)
+{
+    requestAll<std::vector<api::SystemAllowance>>(
+        std::move(emails), &ChannelPartnerClient::getUserSystems, std::move(handler));
+}
+
+template<typename Output>
+void ChannelPartnerClient::requestAll(
+    std::vector<std::string> keys,
+    RequestFunc<Output> request,
+    nx::utils::MoveOnlyFunc<void(api::Result, std::vector<Output>)> handler)
+{
+    // Accessed in the AIO thread only, since the request handlers are called there.
+    struct Context
+    {
+        std::vector<std::string> keys;
+        std::vector<Output> results;
+        std::size_t nextIndex = 0;
+        int requestsInProgress = 0;
+        api::Result result{nx::cloud::db::api::ResultCode::ok};
+        nx::utils::MoveOnlyFunc<void(api::Result, std::vector<Output>)> handler;
+        nx::utils::MoveOnlyFunc<void()> startRequests;
+    };
+
+    auto context = std::make_shared<Context>();
+    context->results.resize(keys.size());
+    context->keys = std::move(keys);
+    context->handler = std::move(handler);
+
+    context->startRequests =
+        [this, request, weakContext = std::weak_ptr<Context>(context)]()
+        {
+            auto context = weakContext.lock();
+            if (!context)
+                return;
+
+            if (context->result.code != nx::cloud::db::api::ResultCode::ok
+                || context->nextIndex == context->keys.size())
+            {
+                if (context->requestsInProgress == 0)
+                {
+                    auto handler = std::move(context->handler);
+                    auto results = context->result.code == nx::cloud::db::api::ResultCode::ok
+                        ? std::move(context->results)
+                        : std::vector<Output>();
+                    const auto result = std::move(context->result);
+                    handler(result, std::move(results));
+                }
+                return;
+            }
+
+            while (context->requestsInProgress < m_maxConcurrentRequests
+                && context->nextIndex < context->keys.size())
+            {
+                const auto index = context->nextIndex++;
+                ++context->requestsInProgress;
+                (this->*request)(
+                    context->keys[index],
+                    [context, index](api::Result result, Output output)
+                    {
+                        --context->requestsInProgress;
+                        if (result.code == nx::cloud::db::api::ResultCode::ok)
+                            context->results[index] = std::move(output);
+                        else if (context->result.code == nx::cloud::db::api::ResultCode::ok)
+                            context->result = std::move(result);
+
+                        context->startRequests();
+                    });
+            }
+        };
+
+    dispatch([context]() { context->startRequests(); });
+}
+
 } // namespace nx::cloud::cps
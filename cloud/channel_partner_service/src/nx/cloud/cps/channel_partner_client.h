@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <nx/cloud/db/api/result_code.h>
 #include <nx/network/http/generic_api_client.h>
@@ -67,9 +68,17 @@ class ChannelPartnerClient:
     using base_type = nx::network::http::GenericApiClient<ApiResultCodeDescriptor>;
 
 public:
+    static constexpr int kDefaultMaxConcurrentRequests = 8;
+
     ChannelPartnerClient(const nx::utils::Url& baseApiUrl);
     ~ChannelPartnerClient();
 
+    /**
+     * Limits the number of requests issued concurrently by the bulk methods (getOrganizations(),
+     * getSystemsUsers(), getUsersSystems()).
+     */
+    void setMaxConcurrentRequests(int value);
+
     void bindSystemToOrganization(
         api::SystemRegistrationRequest data,
         nx::utils::MoveOnlyFunc<void(api::Result, api::SystemRegistrationResponse)> handler);
@@ -110,6 +119,38 @@ public:
 
     void getAllOrganizationsUsers(
         nx::utils::MoveOnlyFunc<void(api::Result, api::GetUsersResponse)> handler);
+
+    /**
+     * The bulk methods request the independent items concurrently and report the results in the
+     * order of the input. The first failure stops issuing new requests, and is reported once the
+     * requests in progress have completed. The results are empty in this case.
+     */
+    void getOrganizations(
+        std::vector<std::string> organizationIds,
+        nx::utils::MoveOnlyFunc<void(api::Result, std::vector<api::Organization>)> handler);
+
+    void getSystemsUsers(
+        std::vector<std::string> systemIds,
+        nx::utils::MoveOnlyFunc<void(api::Result, std::vector<std::vector<api::User>>)> handler);
+
+    void getUsersSystems(
+        std::vector<std::string> emails,
+        nx::utils::MoveOnlyFunc<void(api::Result, std::vector<std::vector<api::SystemAllowance>>)>
+            handler);
+
+private:
+    template<typename Output>
+    using RequestFunc = void (ChannelPartnerClient::*)(
+        const std::string&, nx::utils::MoveOnlyFunc<void(api::Result, Output)>);
+
+    template<typename Output>
+    void requestAll(
+        std::vector<std::string> keys,
+        RequestFunc<Output> request,
+        nx::utils::MoveOnlyFunc<void(api::Result, std::vector<Output>)> handler);
+
+private:
+    int m_maxConcurrentRequests = kDefaultMaxConcurrentRequests;
 };
 
 } // namespace nx::cloud::cps
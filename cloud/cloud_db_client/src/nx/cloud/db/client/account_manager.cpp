@@ -43,8 +43,7 @@ void AccountManager::activateAccount(
 void AccountManager::getAccount(
     std::function<void(api::ResultCode, api::AccountData)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<api::AccountData>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::AccountData>(
         kAccountSelfPath,
         {}, //query
         std::move(completionHandler));
@@ -54,8 +53,7 @@ void AccountManager::getAccount(
     std::string accountEmail,
     std::function<void(api::ResultCode, api::AccountData)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<api::AccountData>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::AccountData>(
         nx::network::http::rest::substituteParameters(kAccountPathV0, {accountEmail}),
         {}, //query
         std::move(completionHandler));
@@ -70,8 +68,7 @@ void AccountManager::getAccountForSharing(
     if (accountRequest.nonce)
         query.addQueryItem("nonce", *accountRequest.nonce);
 
-    m_requestsExecutor->makeAsyncCall<api::AccountForSharing>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::AccountForSharing>(
         nx::network::http::rest::substituteParameters(kAccountForSharingPath, {accountEmail}),
         query,
         std::move(completionHandler));
@@ -153,8 +150,7 @@ void AccountManager::updateSecuritySettings(
 void AccountManager::getSecuritySettings(
     std::function<void(api::ResultCode, api::AccountSecuritySettings)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<api::AccountSecuritySettings>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::AccountSecuritySettings>(
         nx::network::http::rest::substituteParameters(
             kAccountSecuritySettingsPath, {"self"}).c_str(),
         {}, //query
@@ -5,12 +5,21 @@
 #include <chrono>
 #include <deque>
 #include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <nx/cloud/db/api/result_code.h>
 #include <nx/network/http/custom_headers.h>
 #include <nx/network/http/generic_api_client.h>
 #include <nx/network/url/url_parse_helper.h>
+#include <nx/utils/move_only_func.h>
 #include <nx/utils/std/cpp14.h>
+#include <nx/utils/std_string_utils.h>
+#include <nx/utils/thread/mutex.h>
 
 #include "data/types.h"
 
@@ -46,16 +55,263 @@ struct ResultCodeDescriptor
     }
 };
 
+/**
+ * Fetches the lifetime of the reply from the Cache-Control header. Zero if the reply must not be
+ * reused, std::nullopt if the header does not specify it.
+ */
+class ReplyLifetimeFetcher
+{
+public:
+    using type = std::optional<std::chrono::seconds>;
+
+    type operator()(const nx::network::http::Response& response) const
+    {
+        const auto cacheControl = nx::network::http::getHeaderValue(
+            response.headers, "Cache-Control");
+
+        type result;
+        nx::utils::splitNameValuePairs(
+            cacheControl, ',', '=',
+            [&result](const std::string_view& name, const std::string_view& value)
+            {
+                const auto directive = nx::utils::trim(name);
+                if (directive == "no-store" || directive == "no-cache")
+                    result = std::chrono::seconds::zero();
+                else if (directive == "max-age" && !result)
+                    result = std::chrono::seconds(nx::utils::stoi(value));
+            });
+        return result;
+    }
+};
+
 class ApiRequestsExecutor:
     public nx::network::http::GenericApiClient<ResultCodeDescriptor>
 {
     using base_type = nx::network::http::GenericApiClient<ResultCodeDescriptor>;
 
 public:
+    /** Lifetime of the shared replies which do not specify it in the Cache-Control header. */
+    static constexpr std::chrono::seconds kDefaultSharedReplyLifetime{3};
+
+    /** The lifetime specified by the server is limited, so the data is never too stale. */
+    static constexpr std::chrono::seconds kMaxSharedReplyLifetime{60};
+
     using base_type::base_type;
-    using base_type::makeAsyncCall;
+
+    /**
+     * Same as GenericApiClient::makeAsyncCall(). The requests other than GET may modify the data,
+     * so they drop the shared replies.
+     */
+    template<typename Output, typename... ResponseFetchers, typename InputData, typename Handler>
+    void makeAsyncCall(
+        const nx::network::http::Method& method,
+        const std::string& requestPath,
+        const nx::utils::UrlQuery& urlQuery,
+        InputData&& inputData,
+        Handler handler)
+    {
+        if (method != nx::network::http::Method::get)
+            clearSharedReplies();
+
+        base_type::template makeAsyncCall<Output, ResponseFetchers...>(
+            method, requestPath, urlQuery, std::forward<InputData>(inputData), std::move(handler));
+    }
+
+    template<typename Output, typename... ResponseFetchers, typename Handler>
+    void makeAsyncCall(
+        const nx::network::http::Method& method,
+        const std::string& requestPath,
+        const nx::utils::UrlQuery& urlQuery,
+        Handler handler)
+    {
+        if (method != nx::network::http::Method::get)
+            clearSharedReplies();
+
+        base_type::template makeAsyncCall<Output, ResponseFetchers...>(
+            method, requestPath, urlQuery, std::move(handler));
+    }
+
+    /**
+     * Makes a GET request which is shared by the callers: a request with the same path and query
+     * made while the previous one is in progress waits for its reply instead of being sent, and
+     * a successful reply is reused for the lifetime specified by the Cache-Control header, or
+     * for sharedReplyLifetime() if there is no such header. The handler is always invoked
+     * asynchronously within the AIO thread.
+     * Must be used only for the requests which do not modify the data.
+     */
+    template<typename Output, typename... ResponseFetchers, typename Handler>
+    void makeSharedAsyncCall(
+        const std::string& requestPath,
+        const nx::utils::UrlQuery& urlQuery,
+        Handler handler);
+
+    /** Zero disables reusing the replies without the Cache-Control header. */
+    void setSharedReplyLifetime(std::chrono::milliseconds lifetime)
+    {
+        NX_MUTEX_LOCKER lock(&m_sharedRequestsMutex);
+        m_sharedReplyLifetime = lifetime;
+    }
+
+    std::chrono::milliseconds sharedReplyLifetime() const
+    {
+        NX_MUTEX_LOCKER lock(&m_sharedRequestsMutex);
+        return m_sharedReplyLifetime;
+    }
+
+    /**
+     * Drops the replies saved for reuse. The requests which are in progress are not joined by the
+     * later callers, and their replies are not saved either: they may have been made with the
+     * previous credentials.
+     */
+    void clearSharedReplies()
+    {
+        NX_MUTEX_LOCKER lock(&m_sharedRequestsMutex);
+        m_sharedReplies.clear();
+        ++m_sharedRepliesGeneration;
+    }
+
+private:
+    struct BaseSharedReply
+    {
+        std::chrono::steady_clock::time_point expirationTime;
+
+        virtual ~BaseSharedReply() = default;
+    };
+
+    template<typename Reply>
+    struct SharedReply: BaseSharedReply
+    {
+        Reply reply;
+    };
+
+    struct BasePendingRequest
+    {
+        virtual ~BasePendingRequest() = default;
+    };
+
+    template<typename Handler>
+    struct PendingRequest: BasePendingRequest
+    {
+        std::vector<Handler> handlers;
+    };
+
+    mutable nx::Mutex m_sharedRequestsMutex;
+    std::chrono::milliseconds m_sharedReplyLifetime = kDefaultSharedReplyLifetime;
+    // Actual values have types SharedReply<T> and PendingRequest<T> where T depends on the
+    // template parameters of makeSharedAsyncCall().
+    std::map<std::string /*path?query*/, std::shared_ptr<const BaseSharedReply>> m_sharedReplies;
+    std::map<
+        std::pair<int /*generation*/, std::string /*path?query*/>,
+        std::unique_ptr<BasePendingRequest>> m_pendingRequests;
+    int m_sharedRepliesGeneration = 0;
 };
 
+template<typename Output, typename... ResponseFetchers, typename Handler>
+void ApiRequestsExecutor::makeSharedAsyncCall(
+    const std::string& requestPath,
+    const nx::utils::UrlQuery& urlQuery,
+    Handler handler)
+{
+    using Reply = std::tuple<api::ResultCode, Output, typename ResponseFetchers::type...>;
+    using SharedHandler = nx::utils::MoveOnlyFunc<
+        void(api::ResultCode, Output, typename ResponseFetchers::type...)>;
+
+    const auto key = nx::utils::buildString(
+        requestPath, '?', urlQuery.toString().toStdString());
+
+    static_assert(!std::is_void_v<Output>, "Only the requests with a reply can be shared");
+
+    std::pair<int, std::string> pendingKey;
+    bool isShared = true;
+    {
+        NX_MUTEX_LOCKER lock(&m_sharedRequestsMutex);
+        pendingKey = {m_sharedRepliesGeneration, key};
+
+        const auto now = std::chrono::steady_clock::now();
+        std::erase_if(
+            m_sharedReplies,
+            [now](const auto& item) { return item.second->expirationTime <= now; });
+
+        if (auto it = m_sharedReplies.find(key); it != m_sharedReplies.end())
+        {
+            if (auto cached = std::dynamic_pointer_cast<const SharedReply<Reply>>(it->second))
+            {
+                this->post(
+                    [cached = std::move(cached), handler = std::move(handler)]() mutable
+                    {
+                        std::apply(handler, cached->reply);
+                    });
+                return;
+            }
+        }
+
+        if (auto it = m_pendingRequests.find(pendingKey); it != m_pendingRequests.end())
+        {
+            if (auto pending = dynamic_cast<PendingRequest<SharedHandler>*>(it->second.get()))
+            {
+                pending->handlers.push_back(std::move(handler));
+                return;
+            }
+            isShared = false;
+        }
+        else
+        {
+            auto pending = std::make_unique<PendingRequest<SharedHandler>>();
+            pending->handlers.push_back(std::move(handler));
+            m_pendingRequests.emplace(pendingKey, std::move(pending));
+        }
+    }
+
+    if (!isShared)
+    {
+        // A request with the same path but different output type is in progress, which is not
+        // expected. It is not shared then.
+        base_type::template makeAsyncCall<Output, ResponseFetchers...>(
+            nx::network::http::Method::get, requestPath, urlQuery, std::move(handler));
+        return;
+    }
+
+    base_type::template makeAsyncCall<Output, ReplyLifetimeFetcher, ResponseFetchers...>(
+        nx::network::http::Method::get,
+        requestPath,
+        urlQuery,
+        [this, pendingKey](
+            api::ResultCode resultCode,
+            Output output,
+            std::optional<std::chrono::seconds> lifetime,
+            typename ResponseFetchers::type... fetched)
+        {
+            auto shared = std::make_shared<SharedReply<Reply>>();
+            shared->reply = Reply(resultCode, std::move(output), std::move(fetched)...);
+
+            std::vector<SharedHandler> handlers;
+            {
+                NX_MUTEX_LOCKER lock(&m_sharedRequestsMutex);
+
+                if (auto it = m_pendingRequests.find(pendingKey); it != m_pendingRequests.end())
+                {
+                    handlers = std::move(
+                        static_cast<PendingRequest<SharedHandler>*>(it->second.get())->handlers);
+                    m_pendingRequests.erase(it);
+                }
+
+                const std::chrono::milliseconds replyLifetime = lifetime
+                    ? std::min<std::chrono::milliseconds>(*lifetime, kMaxSharedReplyLifetime)
+                    : m_sharedReplyLifetime;
+                if (resultCode == api::ResultCode::ok
+                    && replyLifetime > std::chrono::milliseconds::zero()
+                    && pendingKey.first == m_sharedRepliesGeneration)
+                {
+                    shared->expirationTime = std::chrono::steady_clock::now() + replyLifetime;
+                    m_sharedReplies[pendingKey.second] = shared;
+                }
+            }
+
+            for (auto& handler: handlers)
+                std::apply(handler, shared->reply);
+        });
+}
+
 template<const char* name>
 class HttpHeaderFetcher
 {
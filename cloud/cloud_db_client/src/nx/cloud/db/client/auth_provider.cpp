@@ -170,8 +170,8 @@ void AuthProvider::getVmsServerTlsPublicKey(
 
     static constexpr char kExpiresHeader[] = "Expires";
 
-    m_requestsExecutor->makeAsyncCall<api::VmsServerCertificatePublicKey, HttpHeaderFetcher<kExpiresHeader>>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<
+        api::VmsServerCertificatePublicKey, HttpHeaderFetcher<kExpiresHeader>>(
         network::http::rest::substituteParameters(
             std::string(kAuthVmsServerCertificatePublicKey)
                 + "?valid=" + (isValid ? "1" : "0"),
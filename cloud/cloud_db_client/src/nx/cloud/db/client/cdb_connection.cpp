@@ -77,6 +77,8 @@ void Connection::bindToAioThread(
 void Connection::setCredentials(nx::network::http::Credentials credentials)
 {
     m_requestExecutor.httpClientOptions().setCredentials(credentials);
+    // The shared replies are specific to the user.
+    m_requestExecutor.clearSharedReplies();
 }
 
 void Connection::setProxyVia(
@@ -107,6 +109,7 @@ std::chrono::milliseconds Connection::requestTimeout() const
 void Connection::setAdditionalHeaders(nx::network::http::HttpHeaders headers)
 {
     m_requestExecutor.httpClientOptions().setAdditionalHeaders(std::move(headers));
+    m_requestExecutor.clearSharedReplies();
 }
 
 void Connection::ping(
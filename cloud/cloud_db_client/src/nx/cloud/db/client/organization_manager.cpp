@@ -20,8 +20,7 @@ void OrganizationManager::getSystemOffers(
     const std::string& organizationId,
     std::function<void(api::ResultCode, std::vector<api::SystemOffer>)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<std::vector<api::SystemOffer>>(
-        Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<std::vector<api::SystemOffer>>(
         rest::substituteParameters(kOrganizationSystemOwnershipOffers, {organizationId}),
         {}, //query
         std::move(completionHandler));
@@ -65,8 +65,7 @@ void SystemManager::getSystemsByEmail(
     for (const auto& [name, value]: filter.nameToValue)
         query.addQueryItem(name, value);
 
-    m_requestsExecutor->makeAsyncCall<api::SystemDataExList>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::SystemDataExList>(
         nx::network::http::rest::substituteParameters(kSystemsByEmailPath, {email}),
         query,
         std::move(completionHandler));
@@ -80,8 +79,7 @@ void SystemManager::getSystemsFiltered(
     for (const auto& [name, value]: filter.nameToValue)
         query.addQueryItem(name, value);
 
-    m_requestsExecutor->makeAsyncCall<api::SystemDataExList>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::SystemDataExList>(
         kSystemsPath,
         query,
         std::move(completionHandler));
@@ -91,8 +89,8 @@ void SystemManager::getSystem(
     const std::string& systemId,
     std::function<void(api::ResultCode, api::SystemDataEx)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<api::SystemDataEx, HttpHeaderFetcher<Qn::MERGE_ID_HEADER_NAME>>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<
+        api::SystemDataEx, HttpHeaderFetcher<Qn::MERGE_ID_HEADER_NAME>>(
         nx::network::http::rest::substituteParameters(kSystemPath, {systemId}),
         {}, //query
         [handler = std::move(completionHandler)](api::ResultCode result, api::SystemDataEx data, std::string mergeId){
@@ -111,8 +109,7 @@ void SystemManager::getSystems(
     for (const auto& systemId: systemIdList.systemIds)
         query.addQueryItem("systemId", systemId);
 
-    m_requestsExecutor->makeAsyncCall<api::SystemDataExList>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::SystemDataExList>(
         kSystemsPath,
         query,
         std::move(completionHandler));
@@ -147,8 +144,8 @@ void SystemManager::getCloudUsersOfSystemDeprecated(
     const std::string& systemId,
     std::function<void(api::ResultCode, api::SystemSharingExList, api::SystemSyncInfo)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<api::SystemSharingExList, HttpHeaderFetcher<Qn::MERGE_ID_HEADER_NAME>>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<
+        api::SystemSharingExList, HttpHeaderFetcher<Qn::MERGE_ID_HEADER_NAME>>(
         nx::network::http::rest::substituteParameters(kSystemUsersPath, {systemId}),
         {}, //query
         [completionHandler = std::move(completionHandler)](
@@ -180,8 +177,7 @@ void SystemManager::getAccessRoleList(
     nx::utils::UrlQuery query;
     query.addQueryItem("systemId", systemId);
 
-    m_requestsExecutor->makeAsyncCall<api::SystemAccessRoleList>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::SystemAccessRoleList>(
         deprecated::kSystemGetAccessRoleListPath,
         query,
         std::move(completionHandler));
@@ -227,8 +223,7 @@ void SystemManager::getSystemHealthHistory(
     const std::string& systemId,
     std::function<void(api::ResultCode, api::SystemHealthHistory)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<api::SystemHealthHistory>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::SystemHealthHistory>(
         nx::network::http::rest::substituteParameters(
             kSystemHealthHistoryPath, {systemId}),
         {}, //query
@@ -239,8 +234,7 @@ void SystemManager::getSystemDataSyncSettings(
     const std::string& systemId,
     std::function<void(api::ResultCode, api::DataSyncSettings)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<api::DataSyncSettings>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<api::DataSyncSettings>(
         nx::network::http::rest::substituteParameters(kSystemDataSyncSettingsPath, {systemId}),
         {}, //query
         std::move(completionHandler));
@@ -291,8 +285,8 @@ void SystemManager::getCloudUsersOfSystem(
     const std::string& systemId,
     std::function<void(api::ResultCode, api::SystemSharingExList, api::SystemSyncInfo)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<api::SystemSharingExList, HttpHeaderFetcher<Qn::MERGE_ID_HEADER_NAME>>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<
+        api::SystemSharingExList, HttpHeaderFetcher<Qn::MERGE_ID_HEADER_NAME>>(
         nx::network::http::rest::substituteParameters(kSystemUsersPathV2, {systemId}),
         {}, //query
         [completionHandler = std::move(completionHandler)](
@@ -385,8 +379,7 @@ void SystemManager::deleteSystemOffer(
 void SystemManager::getSystemOffers(
     std::function<void(api::ResultCode, std::vector<api::SystemOffer>)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<std::vector<api::SystemOffer>>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<std::vector<api::SystemOffer>>(
         kSystemOwnershipOffers,
         {}, //query
         std::move(completionHandler));
@@ -451,8 +444,7 @@ void SystemManager::getSystemAttributes(
     const std::string& systemId,
     std::function<void(api::ResultCode, std::vector<api::Attribute>)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<std::vector<api::Attribute>>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<std::vector<api::Attribute>>(
         nx::network::http::rest::substituteParameters(
             kSystemAttributesPath, {systemId}),
         {}, //query
@@ -491,8 +483,7 @@ void SystemManager::getUserAttributes(
     const std::string& email,
     std::function<void(api::ResultCode, std::vector<api::Attribute>)> completionHandler)
 {
-    m_requestsExecutor->makeAsyncCall<std::vector<api::Attribute>>(
-        nx::network::http::Method::get,
+    m_requestsExecutor->makeSharedAsyncCall<std::vector<api::Attribute>>(
         nx::network::http::rest::substituteParameters(
             kSystemUserAttributesPath, {systemId, email}),
         {}, //query
@@ -14,12 +14,19 @@ static constexpr auto kDefaultRequestTimeout = std::chrono::seconds(10);
 Oauth2Client::Oauth2Client(
     const nx::utils::Url& url,
     const nx::network::http::Credentials& credentials):
-    base_type(url, nx::network::ssl::kDefaultCertificateCheck)
+    base_type(url, nx::network::ssl::kDefaultCertificateCheck),
+    m_introspectionScope(url.toStdString() + "|" + credentials.username),
+    m_bearerToken(credentials.authToken.isBearerToken() ? credentials.authToken.value : "")
 {
     setHttpCredentials(credentials);
     setRequestTimeout(kDefaultRequestTimeout);
 }
 
+void Oauth2Client::setIntrospectionCache(TokenIntrospectionCache* cache)
+{
+    m_introspectionCache = cache;
+}
+
 void Oauth2Client::issueToken(
     const db::api::IssueTokenRequest& request,
     nx::utils::MoveOnlyFunc<void(db::api::ResultCode, db::api::IssueTokenResponse)> handler)
@@ -59,6 +66,38 @@ void Oauth2Client::issuePasswordResetCode(
 void Oauth2Client::introspectToken(
     const db::api::TokenIntrospectionRequest& request,
     nx::utils::MoveOnlyFunc<void(db::api::ResultCode, db::api::TokenIntrospectionResponse)> handler)
+{
+    if (!m_introspectionCache)
+        return introspectTokenUncached(request, std::move(handler));
+
+    // The result may be delivered by a fetch of another client, so it is passed to the thread of
+    // this client unless this client has been destroyed already.
+    m_introspectionCache->introspect(
+        m_introspectionScope,
+        request,
+        [this, request](TokenIntrospectionCache::Handler fetchHandler)
+        {
+            introspectTokenUncached(request, std::move(fetchHandler));
+        },
+        [this, sharedGuard = m_asyncOperationGuard.sharedGuard(), handler = std::move(handler)](
+            db::api::ResultCode resultCode, db::api::TokenIntrospectionResponse response) mutable
+        {
+            const auto lock = sharedGuard->lock();
+            if (!lock)
+                return;
+
+            post(
+                [handler = std::move(handler), resultCode, response = std::move(response)]()
+                    mutable
+                {
+                    handler(resultCode, std::move(response));
+                });
+        });
+}
+
+void Oauth2Client::introspectTokenUncached(
+    const db::api::TokenIntrospectionRequest& request,
+    nx::utils::MoveOnlyFunc<void(db::api::ResultCode, db::api::TokenIntrospectionResponse)> handler)
 {
     base_type::template makeAsyncCall<db::api::TokenIntrospectionResponse>(
         nx::network::http::Method::post,
@@ -70,6 +109,10 @@ void Oauth2Client::introspectToken(
 
 void Oauth2Client::logout(nx::utils::MoveOnlyFunc<void(db::api::ResultCode)> handler)
 {
+    // The token of this client is revoked by the logout.
+    if (m_introspectionCache && !m_bearerToken.empty())
+        m_introspectionCache->invalidate(m_bearerToken);
+
     base_type::template makeAsyncCall<void>(
         nx::network::http::Method::delete_,
         api::kOauthIntrospectPath,
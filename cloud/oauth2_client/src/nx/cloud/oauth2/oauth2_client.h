@@ -6,9 +6,11 @@
 #include <nx/cloud/db/client/async_http_requests_executor.h>
 #include <nx/cloud/db/client/data/oauth_data.h>
 #include <nx/network/http/generic_api_client.h>
+#include <nx/utils/async_operation_guard.h>
 #include <nx/utils/basic_factory.h>
 
 #include "api/data.h"
+#include "token_introspection_cache.h"
 
 namespace nx::cloud::utils {
 
@@ -102,6 +104,12 @@ public:
         const nx::utils::Url& url,
         const nx::network::http::Credentials& credentials);
 
+    /**
+     * The introspection results are shared via TokenIntrospectionCache::instance() by default.
+     * @param cache nullptr disables the caching. Must outlive the client.
+     */
+    void setIntrospectionCache(TokenIntrospectionCache* cache);
+
     void issueToken(
         const db::api::IssueTokenRequest& request,
         nx::utils::MoveOnlyFunc<void(db::api::ResultCode, db::api::IssueTokenResponse)>
@@ -160,6 +168,18 @@ public:
     void markSessionMfaVerified(
         const std::string& sessionId,
         nx::utils::MoveOnlyFunc<void(db::api::ResultCode)> handler) override;
+
+private:
+    void introspectTokenUncached(
+        const db::api::TokenIntrospectionRequest& request,
+        nx::utils::MoveOnlyFunc<void(db::api::ResultCode, db::api::TokenIntrospectionResponse)>
+            completionHandler);
+
+private:
+    const std::string m_introspectionScope;
+    const std::string m_bearerToken;
+    TokenIntrospectionCache* m_introspectionCache = &TokenIntrospectionCache::instance();
+    nx::utils::AsyncOperationGuard m_asyncOperationGuard;
 };
 
 using Oauth2ClientFactoryFunc = std::unique_ptr<AbstractOauth2Client>(
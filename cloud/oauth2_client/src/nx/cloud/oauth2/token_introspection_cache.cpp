@@ -0,0 +1,306 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "token_introspection_cache.h"
+
+#include <functional>
+#include <utility>
+
+#include <nx/utils/scope_guard.h>
+
+namespace nx::cloud::oauth2::client {
+
+using namespace std::chrono;
+
+/**
+ * Completes the fetch with its result, or with ResultCode::networkError if it is destroyed
+ * without being called. So the waiters do not depend on the client which does the fetch.
+ */
+class TokenIntrospectionCache::FetchHandler
+{
+public:
+    FetchHandler(
+        TokenIntrospectionCache* cache, std::string token, std::string key, std::uint64_t fetchId)
+        :
+        m_cache(cache),
+        m_token(std::move(token)),
+        m_key(std::move(key)),
+        m_fetchId(fetchId)
+    {
+    }
+
+    FetchHandler(FetchHandler&& other) noexcept:
+        m_cache(std::exchange(other.m_cache, nullptr)),
+        m_token(std::move(other.m_token)),
+        m_key(std::move(other.m_key)),
+        m_fetchId(other.m_fetchId)
+    {
+    }
+
+    FetchHandler(const FetchHandler&) = delete;
+    FetchHandler& operator=(const FetchHandler&) = delete;
+    FetchHandler& operator=(FetchHandler&&) = delete;
+
+    ~FetchHandler()
+    {
+        if (m_cache)
+            operator()(db::api::ResultCode::networkError, {});
+    }
+
+    void operator()(db::api::ResultCode resultCode, db::api::TokenIntrospectionResponse response)
+    {
+        if (auto cache = std::exchange(m_cache, nullptr))
+            cache->saveResult(m_token, m_key, m_fetchId, resultCode, std::move(response));
+    }
+
+private:
+    TokenIntrospectionCache* m_cache = nullptr;
+    std::string m_token;
+    std::string m_key;
+    std::uint64_t m_fetchId = 0;
+};
+
+TokenIntrospectionCache::TokenIntrospectionCache():
+    TokenIntrospectionCache(Settings())
+{
+}
+
+TokenIntrospectionCache::TokenIntrospectionCache(const Settings& settings):
+    m_settings(settings)
+{
+}
+
+void TokenIntrospectionCache::introspect(
+    const std::string& scope,
+    const db::api::TokenIntrospectionRequest& request,
+    Fetcher fetch,
+    Handler handler)
+{
+    const auto key = entryKey(scope, request);
+    const auto now = Clock::now();
+
+    std::vector<Handler> expiredWaiters;
+    auto expiredWaitersGuard = nx::utils::makeScopeGuard(
+        [&expiredWaiters]() { failWaiters(std::move(expiredWaiters)); });
+
+    auto& shard = this->shard(request.token);
+    NX_MUTEX_LOCKER lock(&shard.mutex);
+
+    if ((int) shard.entriesByToken.size() >= m_settings.maxTokenCount)
+        purge(&shard, &expiredWaiters);
+
+    auto& entries = shard.entriesByToken[request.token];
+    if (auto it = entries.find(key); it != entries.end())
+    {
+        Entry& entry = it->second;
+        if (!entry.isFetching && now < entry.validUntil)
+        {
+            const auto resultCode = entry.resultCode;
+            auto response = entry.response;
+            if (response.active)
+            {
+                response.expires_in = std::max(
+                    seconds::zero(), duration_cast<seconds>(entry.tokenExpiresAt - now));
+            }
+
+            lock.unlock();
+            handler(resultCode, std::move(response));
+            return;
+        }
+
+        if (entry.isFetching && now - entry.fetchStartedAt < m_settings.fetchTimeout)
+        {
+            entry.waiters.push_back(std::move(handler));
+            return;
+        }
+    }
+
+    Entry& entry = entries[key];
+    entry.isFetching = true;
+    entry.fetchId = ++shard.lastFetchId;
+    entry.fetchStartedAt = now;
+    entry.isCacheable = true;
+    entry.waiters.push_back(std::move(handler));
+    const auto fetchId = entry.fetchId;
+    lock.unlock();
+
+    fetch(FetchHandler(this, request.token, key, fetchId));
+}
+
+void TokenIntrospectionCache::invalidate(const std::string& token)
+{
+    auto& shard = this->shard(token);
+    NX_MUTEX_LOCKER lock(&shard.mutex);
+
+    auto tokenIt = shard.entriesByToken.find(token);
+    if (tokenIt == shard.entriesByToken.end())
+        return;
+
+    auto& entries = tokenIt->second;
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.isFetching)
+        {
+            it->second.isCacheable = false;
+            ++it;
+        }
+        else
+        {
+            it = entries.erase(it);
+        }
+    }
+
+    if (entries.empty())
+        shard.entriesByToken.erase(tokenIt);
+}
+
+void TokenIntrospectionCache::clear()
+{
+    for (auto& shard: m_shards)
+    {
+        std::vector<Handler> expiredWaiters;
+        {
+            NX_MUTEX_LOCKER lock(&shard.mutex);
+            for (auto& [token, entries]: shard.entriesByToken)
+            {
+                for (auto& [key, entry]: entries)
+                    entry.isCacheable = false;
+            }
+            purge(&shard, &expiredWaiters);
+        }
+        failWaiters(std::move(expiredWaiters));
+    }
+}
+
+TokenIntrospectionCache& TokenIntrospectionCache::instance()
+{
+    static TokenIntrospectionCache staticInstance;
+    return staticInstance;
+}
+
+TokenIntrospectionCache::Shard& TokenIntrospectionCache::shard(const std::string& token)
+{
+    return m_shards[std::hash<std::string>()(token) % kShardCount];
+}
+
+void TokenIntrospectionCache::purge(Shard* shard, std::vector<Handler>* expiredWaiters)
+{
+    const auto now = Clock::now();
+    const auto isStale =
+        [&](const Entry& entry)
+        {
+            if (entry.isFetching)
+                return now - entry.fetchStartedAt >= m_settings.fetchTimeout;
+            return !entry.isCacheable || entry.validUntil <= now;
+        };
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (auto tokenIt = shard->entriesByToken.begin();
+            tokenIt != shard->entriesByToken.end();)
+        {
+            auto& entries = tokenIt->second;
+            for (auto it = entries.begin(); it != entries.end();)
+            {
+                // The second pass drops all the results, the fetches in progress are kept to
+                // complete their waiters.
+                if (isStale(it->second) || (pass > 0 && !it->second.isFetching))
+                {
+                    for (auto& waiter: it->second.waiters)
+                        expiredWaiters->push_back(std::move(waiter));
+                    it = entries.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            if (entries.empty())
+                tokenIt = shard->entriesByToken.erase(tokenIt);
+            else
+                ++tokenIt;
+        }
+
+        if ((int) shard->entriesByToken.size() < m_settings.maxTokenCount)
+            return;
+    }
+}
+
+void TokenIntrospectionCache::saveResult(
+    const std::string& token,
+    const std::string& key,
+    std::uint64_t fetchId,
+    db::api::ResultCode resultCode,
+    db::api::TokenIntrospectionResponse response)
+{
+    milliseconds ttl = milliseconds::zero();
+    if (resultCode == db::api::ResultCode::ok && response.active)
+        ttl = std::min<milliseconds>(m_settings.maxTtl, response.expires_in);
+    else if (resultCode == db::api::ResultCode::ok
+        || resultCode == db::api::ResultCode::notAuthorized)
+    {
+        ttl = m_settings.negativeTtl; //< The token is unknown, expired or revoked.
+    }
+
+    std::vector<Handler> waiters;
+    {
+        auto& shard = this->shard(token);
+        NX_MUTEX_LOCKER lock(&shard.mutex);
+
+        auto tokenIt = shard.entriesByToken.find(token);
+        if (tokenIt != shard.entriesByToken.end())
+        {
+            auto& entries = tokenIt->second;
+            // The entry may have been purged and fetched again since this fetch was started.
+            if (auto it = entries.find(key); it != entries.end() && it->second.fetchId == fetchId)
+            {
+                Entry& entry = it->second;
+                waiters = std::move(entry.waiters);
+                entry.waiters.clear();
+
+                if (entry.isCacheable && ttl > milliseconds::zero())
+                {
+                    const auto now = Clock::now();
+                    entry.isFetching = false;
+                    entry.resultCode = resultCode;
+                    entry.response = response;
+                    entry.validUntil = now + ttl;
+                    entry.tokenExpiresAt = now + response.expires_in;
+                }
+                else
+                {
+                    entries.erase(it);
+                    if (entries.empty())
+                        shard.entriesByToken.erase(tokenIt);
+                }
+            }
+        }
+    }
+
+    for (auto& waiter: waiters)
+        waiter(resultCode, response);
+}
+
+void TokenIntrospectionCache::failWaiters(std::vector<Handler> waiters)
+{
+    for (auto& waiter: waiters)
+        waiter(db::api::ResultCode::networkError, {});
+}
+
+std::string TokenIntrospectionCache::entryKey(
+    const std::string& scope, const db::api::TokenIntrospectionRequest& request)
+{
+    std::string key = scope;
+    key += request.skip_non_shared ? "|1|" : "|0|";
+    if (request.system_ids)
+    {
+        for (const auto& systemId: *request.system_ids)
+        {
+            key += systemId;
+            key += ',';
+        }
+    }
+    return key;
+}
+
+} // namespace nx::cloud::oauth2::client
@@ -0,0 +1,143 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nx/cloud/db/api/oauth_data.h>
+#include <nx/cloud/db/api/result_code.h>
+#include <nx/utils/move_only_func.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::cloud::oauth2::client {
+
+/**
+ * Caches the token introspection results, so the services which get the same bearer token in
+ * every request do not ask the cloud each time.
+ * - The active tokens are cached until their expiration, but not longer than Settings::maxTtl, so
+ *   a revocation which has not been pushed via invalidate() is noticed in a bounded time.
+ * - The inactive and unknown tokens are cached for Settings::negativeTtl.
+ * - Concurrent introspections of the same token are merged into a single request. If the fetch
+ *   is dropped without a result (e.g. its client is stopped), all the merged introspections
+ *   complete with ResultCode::networkError.
+ * Network and server errors are never cached.
+ *
+ * The entries are split into shards by the token hash, each shard has its own mutex, so the
+ * lookups of different tokens do not contend.
+ */
+class TokenIntrospectionCache
+{
+public:
+    struct Settings
+    {
+        std::chrono::milliseconds maxTtl = std::chrono::minutes(1);
+        std::chrono::milliseconds negativeTtl = std::chrono::seconds(5);
+
+        /**
+         * A fetch which has not completed in this time is considered lost: the next
+         * introspection of the token starts a new one, and purging fails its waiters.
+         */
+        std::chrono::milliseconds fetchTimeout = std::chrono::seconds(30);
+
+        /** Per shard. When exceeded, the shard is purged. */
+        int maxTokenCount = 1024;
+    };
+
+    using Handler = nx::utils::MoveOnlyFunc<
+        void(db::api::ResultCode, db::api::TokenIntrospectionResponse)>;
+
+    /**
+     * Performs the actual introspection, the handler may be called in any thread. Destroying the
+     * handler without calling it fails the introspection.
+     */
+    using Fetcher = nx::utils::MoveOnlyFunc<void(Handler)>;
+
+    /** Must outlive the fetches started by it. */
+    TokenIntrospectionCache();
+    explicit TokenIntrospectionCache(const Settings& settings);
+
+    /**
+     * Calls the handler with the cached result or with the result of the fetch. The handler is
+     * called in the current thread if the result is cached, or in the thread of the fetcher
+     * handler otherwise.
+     * @param scope Identifies the introspecting party (e.g. the service url and the client id),
+     *     the results are not shared between different scopes.
+     */
+    void introspect(
+        const std::string& scope,
+        const db::api::TokenIntrospectionRequest& request,
+        Fetcher fetch,
+        Handler handler);
+
+    /**
+     * Forgets the results for the token, e.g. on logout or revocation. An introspection of the
+     * token which is in progress is completed, but its result is not cached.
+     */
+    void invalidate(const std::string& token);
+
+    void clear();
+
+    static TokenIntrospectionCache& instance();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    class FetchHandler;
+
+    struct Entry
+    {
+        bool isFetching = false;
+        std::uint64_t fetchId = 0;
+        Clock::time_point fetchStartedAt;
+        bool isCacheable = true;
+        std::vector<Handler> waiters;
+
+        db::api::ResultCode resultCode = db::api::ResultCode::ok;
+        db::api::TokenIntrospectionResponse response;
+        Clock::time_point validUntil;
+        Clock::time_point tokenExpiresAt;
+    };
+
+    /** The key is the scope and the request parameters other than the token. */
+    using TokenEntries = std::map<std::string, Entry>;
+
+    struct Shard
+    {
+        nx::Mutex mutex;
+        std::unordered_map<std::string, TokenEntries> entriesByToken;
+        std::uint64_t lastFetchId = 0;
+    };
+
+    static constexpr int kShardCount = 16;
+
+    Shard& shard(const std::string& token);
+    /**
+     * Drops the outdated results and the lost fetches. The waiters of the lost fetches are moved
+     * to expiredWaiters, to be failed when the shard is unlocked.
+     */
+    void purge(Shard* shard, std::vector<Handler>* expiredWaiters);
+
+    void saveResult(
+        const std::string& token,
+        const std::string& key,
+        std::uint64_t fetchId,
+        db::api::ResultCode resultCode,
+        db::api::TokenIntrospectionResponse response);
+
+    static void failWaiters(std::vector<Handler> waiters);
+
+    static std::string entryKey(
+        const std::string& scope, const db::api::TokenIntrospectionRequest& request);
+
+private:
+    const Settings m_settings;
+    std::array<Shard, kShardCount> m_shards;
+};
+
+} // namespace nx::cloud::oauth2::client
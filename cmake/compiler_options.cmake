@@ -72,6 +72,10 @@ if(developerBuild)
     add_definitions(-DNX_DEVELOPER_BUILD)
 endif()
 
+if(NOT withTraceEvents)
+    add_definitions(-DNX_TRACE_ENABLED=0)
+endif()
+
 # These definitions are specific for Windows headers.
 if(WINDOWS)
     add_definitions(
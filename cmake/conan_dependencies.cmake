@@ -20,6 +20,11 @@ list(APPEND _additional_conan_parameters "-o useClang=${use_clang}")
 
 list(APPEND _additional_conan_parameters "-o targetDevice=${targetDevice}")
 
+# Google Benchmark is needed only for nx_add_benchmark().
+set(with_benchmarks ${withBenchmarks})
+nx_to_python_compatible_bool(with_benchmarks)
+list(APPEND _additional_conan_parameters "-o withBenchmarks=${with_benchmarks}")
+
 if(NOT developerBuild)
     list(APPEND _additional_conan_parameters "-o installRuntimeDependencies=False")
 endif()
@@ -27,6 +27,8 @@ option(withMobileClient "Enable Mobile Client" ON)
 option(withDistributions "Enable distributions" ${_withDistributions})
 option(withDocumentation "Generate documentation" ${_withDocumentation})
 option(withTests "Enable unit tests" ON)
+option(withBenchmarks "Enable performance benchmarks" OFF)
+option(withTraceEvents "Compile in the NX_TRACE_* instrumentation" ON)
 option(withUnitTestsArchive "Enable unit tests archive" ${_withUnitTestsArchive})
 set(withRootTool "false") #< Required in the build_info.json.
 
@@ -13,6 +13,13 @@ set(testTempDirectory "${CMAKE_BINARY_DIR}" CACHE STRING "Temp directory for run
 add_custom_target(unit_tests)
 set_target_properties(unit_tests PROPERTIES FOLDER utils)
 
+if(withBenchmarks)
+    set(benchmarkResultsDirectory "${CMAKE_BINARY_DIR}/benchmark_results")
+    add_custom_target(benchmarks)
+    add_custom_target(run_benchmarks)
+    set_target_properties(benchmarks run_benchmarks PROPERTIES FOLDER utils)
+endif()
+
 function(nx_add_test target) # [NO_GTEST] [NO_QT] [NO_NX_UTILS] ...
     if(NOT withTests)
         message(FATAL_ERROR "Function nx_add_test can be used only with enabled withTests.")
@@ -93,6 +100,62 @@ function(nx_add_test target) # [NO_GTEST] [NO_QT] [NO_NX_UTILS] ...
     add_dependencies(unit_tests ${target})
 endfunction()
 
+# Adds a Google Benchmark executable. Sources are taken the same way as for nx_add_test. The
+# run_benchmarks target runs all the benchmarks and writes their results in JSON to
+# ${benchmarkResultsDirectory}/<target>.json, to be collected by CI and compared between builds.
+function(nx_add_benchmark target) # [NO_BENCHMARK_MAIN] ...
+    if(NOT withBenchmarks)
+        message(FATAL_ERROR
+            "Function nx_add_benchmark can be used only with enabled withBenchmarks.")
+    endif()
+
+    set(options NO_BENCHMARK_MAIN)
+    set(oneValueArgs FOLDER)
+    cmake_parse_arguments(NX_ADD_BENCHMARK "${options}"
+        "${oneValueArgs}" #[[multiValueArgs]] "" ${ARGN})
+
+    find_package(benchmark REQUIRED)
+
+    set_output_directories(RUNTIME "bin" LIBRARY "lib"
+        AFFECTED_VARIABLES_RESULT affected_variables)
+    nx_expose_variables_to_parent_scope(${affected_variables})
+
+    if(NX_ADD_BENCHMARK_NO_BENCHMARK_MAIN)
+        set(benchmark_library benchmark::benchmark)
+    else()
+        set(benchmark_library benchmark::benchmark_main)
+    endif()
+
+    if(NX_ADD_BENCHMARK_FOLDER)
+        set(folder "${NX_ADD_BENCHMARK_FOLDER}")
+    else()
+        set(folder "benchmarks")
+    endif()
+
+    nx_add_target(${target}
+        EXECUTABLE
+        NO_RC_FILE
+        NO_MOC
+        PRIVATE_LIBS
+            ${benchmark_library}
+        FOLDER ${folder}
+        ${NX_ADD_BENCHMARK_UNPARSED_ARGUMENTS}
+    )
+
+    add_custom_target(run_${target}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${benchmarkResultsDirectory}
+        COMMAND ${target}
+            --benchmark_out=${benchmarkResultsDirectory}/${target}.json
+            --benchmark_out_format=json
+        DEPENDS ${target}
+        USES_TERMINAL
+    )
+    set_target_properties(run_${target} PROPERTIES FOLDER utils)
+
+    add_dependencies(benchmarks ${target})
+    add_dependencies(run_benchmarks run_${target})
+endfunction()
+
 function(nx_add_server_plugin_test target) # [NO_GTEST] [NO_QT]
     if(MACOSX)
         set(CMAKE_INSTALL_RPATH
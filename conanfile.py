@@ -61,12 +61,14 @@ class NxOpenConan(ConanFile):
         "useClang": (True, False),
         "customization": "ANY",
         "installRuntimeDependencies": (True, False),
+        "withBenchmarks": (True, False),
     }
     default_options = {
         "targetDevice": None,
         "useClang": False,
         "customization": "metavms",
         "installRuntimeDependencies": True,
+        "withBenchmarks": False,
         "quick_start_guide:format": "pdf",
         "mobile_user_manual:format": "pdf",
     }
@@ -179,8 +181,11 @@ class NxOpenConan(ConanFile):
         self.requires("concurrentqueue/1.0.4" "#957c470e9abc81ff3850bbe39fc11135")
         self.requires("rapidjson/cci.20230929" "#624c0094d741e6a3749d2e44d834b96c")
         self.requires("zlib/1.2.13" "#df233e6bed99052f285331b9f54d9070")
+        self.requires("zstd/1.5.5" "#b87dc3b185caa4b122979ac4ae8ef7e8")
 
         if self.settings.os not in ("Android", "iOS"):
+            if self.options.withBenchmarks:
+                self.requires("benchmark/1.8.3" "#2b95dcd66432d8ea28c5ee0c4c5b8e3c")
             # Qt dependency.
             self.requires("icu/74.2" "#a0ffc2036da25e5dbe72dc941074a6c4")
             # FFmpeg dependencies.
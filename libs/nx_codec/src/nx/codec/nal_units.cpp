@@ -1,11 +1,131 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
 #include <nx/codec/nal_units.h>
+
+#include <bit>
+
 #include <nx/utils/bit_stream.h>
+#include <nx/utils/cpu_features.h>
 #include <nx/utils/log/log.h>
 
+#if defined(NX_AVX2_CODE_SUPPORTED)
+    #include <immintrin.h>
+#elif defined(NX_NEON_SUPPORTED)
+    #include <arm_neon.h>
+#endif
+
 namespace nx::media::nal {
 
+namespace {
+
+// The scanners look for the "00 00 <third>" byte sequence: 00 00 01 is a start code, 00 00 03 is
+// an emulation prevention sequence. Each SIMD scanner compares the blocks at the offsets 0, 1 and
+// 2, so it stops where less than a block and two bytes are left and returns the first match or
+// the position to continue with the scalar scanner.
+
+const uint8_t* findSequenceScalar(const uint8_t* data, const uint8_t* end, uint8_t third)
+{
+    // The third byte is not zero, so if data[2] is not zero the sequence can start neither at
+    // data + 1 nor at data + 2.
+    while (end - data >= 3)
+    {
+        if (data[2] == 0)
+            ++data;
+        else if (data[2] == third && data[1] == 0 && data[0] == 0)
+            return data;
+        else
+            data += 3;
+    }
+    return end;
+}
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+
+const uint8_t* findSequenceSse2(const uint8_t* data, const uint8_t* end, uint8_t third)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i thirdBytes = _mm_set1_epi8((char) third);
+    for (; end - data >= 16 + 2; data += 16)
+    {
+        const __m128i last = _mm_loadu_si128((const __m128i*) (data + 2));
+        const __m128i lastMatches = _mm_cmpeq_epi8(last, thirdBytes);
+        if (_mm_movemask_epi8(lastMatches) == 0)
+            continue;
+
+        const __m128i matches = _mm_and_si128(lastMatches, _mm_and_si128(
+            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) data), zero),
+            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (data + 1)), zero)));
+        if (const auto mask = (uint32_t) _mm_movemask_epi8(matches))
+            return data + std::countr_zero(mask);
+    }
+    return data;
+}
+
+NX_TARGET_AVX2 const uint8_t* findSequenceAvx2(
+    const uint8_t* data, const uint8_t* end, uint8_t third)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i thirdBytes = _mm256_set1_epi8((char) third);
+    for (; end - data >= 32 + 2; data += 32)
+    {
+        const __m256i last = _mm256_loadu_si256((const __m256i*) (data + 2));
+        const __m256i lastMatches = _mm256_cmpeq_epi8(last, thirdBytes);
+        if (_mm256_testz_si256(lastMatches, lastMatches))
+            continue;
+
+        const __m256i matches = _mm256_and_si256(lastMatches, _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) data), zero),
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (data + 1)), zero)));
+        if (const auto mask = (uint32_t) _mm256_movemask_epi8(matches))
+            return data + std::countr_zero(mask);
+    }
+    return data;
+}
+
+#elif defined(NX_NEON_SUPPORTED)
+
+const uint8_t* findSequenceNeon(const uint8_t* data, const uint8_t* end, uint8_t third)
+{
+    const uint8x16_t zero = vdupq_n_u8(0);
+    const uint8x16_t thirdBytes = vdupq_n_u8(third);
+    for (; end - data >= 16 + 2; data += 16)
+    {
+        const uint8x16_t lastMatches = vceqq_u8(vld1q_u8(data + 2), thirdBytes);
+        if (vmaxvq_u8(lastMatches) == 0)
+            continue;
+
+        const uint8x16_t matches = vandq_u8(lastMatches, vandq_u8(
+            vceqq_u8(vld1q_u8(data), zero), vceqq_u8(vld1q_u8(data + 1), zero)));
+
+        // Narrowing shift packs the byte mask into 4 bits per byte.
+        const uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+        if (mask != 0)
+            return data + std::countr_zero(mask) / 4;
+    }
+    return data;
+}
+
+#endif
+
+/**
+ * @return Pointer to the first "00 00 <third>" sequence, or end if there is none.
+ */
+const uint8_t* findSequence(const uint8_t* data, const uint8_t* end, uint8_t third)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        data = nx::utils::cpuSupportsAvx2()
+            ? findSequenceAvx2(data, end, third)
+            : findSequenceSse2(data, end, third);
+    #elif defined(NX_NEON_SUPPORTED)
+        data = findSequenceNeon(data, end, third);
+    #endif
+
+    return findSequenceScalar(data, end, third);
+}
+
+} // namespace
+
 void write_rbsp_trailing_bits(nx::utils::BitStreamWriter& writer)
 {
     writer.putBit(1);
@@ -27,39 +147,16 @@ void write_byte_align_bits(nx::utils::BitStreamWriter& writer)
 
 const uint8_t* findNextNAL(const uint8_t* buffer, const uint8_t* end)
 {
-    for (buffer += 2; buffer < end;)
-    {
-        if (*buffer > 1)
-            buffer += 3;
-        else if (*buffer == 0)
-            buffer ++;
-        else if (buffer[-2] == 0 && buffer[-1] == 0)    //*buffer == 1
-            return buffer+1;
-        else
-            buffer+=3;
-    }
-    return end;
+    const uint8_t* startCode = findSequence(buffer, end, /*third*/ 1);
+    return startCode == end ? end : startCode + kStartCode3B.size();
 }
 
 const uint8_t* findNALWithStartCode(const uint8_t* buffer, const uint8_t* end)
 {
-    const uint8_t* bufStart = buffer;
-    for (buffer += 2; buffer < end;)
-    {
-        if (*buffer > 1)
-            buffer += 3;
-        else if (*buffer == 0)
-            buffer ++;
-        else if (buffer[-2] == 0 && buffer[-1] == 0) {
-            if (buffer-3 >= bufStart && buffer[-3] == 0)
-                return buffer - 3;
-            else
-                return buffer-2;
-        }
-        else
-            buffer+=3;
-    }
-    return end;
+    const uint8_t* startCode = findSequence(buffer, end, /*third*/ 1);
+    if (startCode != end && startCode > buffer && startCode[-1] == 0)
+        return startCode - 1;
+    return startCode;
 }
 
 int encodeEpb(const uint8_t* srcBuffer, const uint8_t* srcEnd, uint8_t* dstBuffer, size_t dstBufferSize)
@@ -104,27 +201,28 @@ int decodeEpb(const uint8_t* srcBuffer, const uint8_t* srcEnd, uint8_t* dstBuffe
 {
     uint8_t* initDstBuffer = dstBuffer;
     const uint8_t* srcStart = srcBuffer;
-    for (srcBuffer += 3; srcBuffer < srcEnd;)
+    const uint8_t* sequence = findSequence(srcBuffer, srcEnd, /*third*/ 3);
+    while (srcEnd - sequence > 3)
     {
+        // Only "00 00 03" followed by a byte not greater than 3 is an emulation prevention.
+        srcBuffer = sequence + 3;
         if (*srcBuffer > 3)
         {
-            srcBuffer += 4;
+            sequence = findSequence(srcBuffer, srcEnd, /*third*/ 3);
+            continue;
         }
-        else if (srcBuffer[-3] == 0 && srcBuffer[-2] == 0  && srcBuffer[-1] == 3)
-        {
-            if (dstBufferSize < (size_t) (srcBuffer - srcStart))
-                return -1;
 
-            memcpy(dstBuffer, srcStart, srcBuffer - srcStart - 1);
-            dstBuffer += srcBuffer - srcStart - 1;
-            dstBufferSize -= srcBuffer - srcStart;
-            *dstBuffer++ = *srcBuffer++;
-            srcStart = srcBuffer;
-        }
-        else
-        {
-            srcBuffer++;
-        }
+        if (dstBufferSize < (size_t) (srcBuffer - srcStart))
+            return -1;
+
+        memcpy(dstBuffer, srcStart, srcBuffer - srcStart - 1);
+        dstBuffer += srcBuffer - srcStart - 1;
+        dstBufferSize -= srcBuffer - srcStart;
+        *dstBuffer++ = *srcBuffer;
+        srcStart = srcBuffer + 1;
+
+        // The copied byte may start the next sequence.
+        sequence = findSequence(srcBuffer, srcEnd, /*third*/ 3);
     }
 
     if (dstBufferSize < std::size_t(srcEnd - srcStart))
@@ -1,5 +1,9 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <chrono>
+#include <iostream>
+#include <random>
+
 #include <gtest/gtest.h>
 
 #include <nx/codec/h264/sequence_parameter_set.h>
@@ -276,3 +280,104 @@ TEST(NalUnits, convertStartCodesToSizes)
         ASSERT_EQ(converted[9], 0x05);
     }
 }
+
+namespace {
+
+/** Random payload with the emulation prevention bytes, like the slices of an IDR frame. */
+std::vector<uint8_t> makeFrame(size_t sliceSize, int sliceCount, std::mt19937* random)
+{
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> slice(sliceSize);
+    std::vector<uint8_t> encoded(sliceSize * 3 / 2);
+    for (int i = 0; i < sliceCount; ++i)
+    {
+        for (auto& byte: slice)
+        {
+            // Zeros are frequent in the real slices.
+            const auto value = (*random)();
+            byte = (value % 8 == 0) ? 0 : (uint8_t) (value >> 8);
+        }
+        const int size = nx::media::nal::encodeEpb(
+            slice.data(), slice.data() + slice.size(), encoded.data(), encoded.size());
+        frame.insert(frame.end(), nx::media::nal::kStartCode.begin(),
+            nx::media::nal::kStartCode.end());
+        frame.insert(frame.end(), encoded.begin(), encoded.begin() + size);
+    }
+    return frame;
+}
+
+} // namespace
+
+TEST(NalUnits, findStartCodeAtAnyOffset)
+{
+    // The start code is placed across the SIMD block boundaries as well.
+    for (size_t size = 3; size < 100; ++size)
+    {
+        for (size_t offset = 0; offset + 3 <= size; ++offset)
+        {
+            std::vector<uint8_t> data(size, 0xff);
+            data[offset] = 0;
+            data[offset + 1] = 0;
+            data[offset + 2] = 1;
+            const uint8_t* end = data.data() + size;
+
+            ASSERT_EQ(data.data() + offset + 3, nx::media::nal::findNextNAL(data.data(), end));
+            ASSERT_EQ(data.data() + offset,
+                nx::media::nal::findNALWithStartCode(data.data(), end));
+
+            data[offset + 2] = 2;
+            ASSERT_EQ(end, nx::media::nal::findNextNAL(data.data(), end));
+        }
+    }
+}
+
+TEST(NalUnits, decodeEncodedFrame)
+{
+    std::mt19937 random(7);
+    const auto frame = makeFrame(/*sliceSize*/ 10'000, /*sliceCount*/ 4, &random);
+
+    const auto nalUnits = nx::media::nal::findNalUnitsAnnexB(frame.data(), (int) frame.size());
+    ASSERT_EQ(4u, nalUnits.size());
+
+    std::vector<uint8_t> decoded(frame.size());
+    for (const auto& nalUnit: nalUnits)
+    {
+        const int size = nx::media::nal::decodeEpb(
+            nalUnit.data, nalUnit.data + nalUnit.size, decoded.data(), decoded.size());
+        ASSERT_LE(size, 10'000);
+        ASSERT_GE(size, 10'000 - 8); //< Trailing zeros are dropped by findNalUnitsAnnexB().
+    }
+}
+
+TEST(NalUnits, DISABLED_ScanIdrFrameBenchmark)
+{
+    // The size of a 4K H.264 IDR frame with the high quality.
+    std::mt19937 random(1);
+    const auto frame = makeFrame(/*sliceSize*/ 500'000, /*sliceCount*/ 4, &random);
+    std::vector<uint8_t> decoded(frame.size());
+    static constexpr int kIterations = 200;
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t nalUnitCount = 0;
+    for (int i = 0; i < kIterations; ++i)
+        nalUnitCount += nx::media::nal::findNalUnitsAnnexB(frame.data(), (int) frame.size()).size();
+    const auto scanned = std::chrono::steady_clock::now();
+    int decodedSize = 0;
+    for (int i = 0; i < kIterations; ++i)
+    {
+        decodedSize += nx::media::nal::decodeEpb(
+            frame.data(), frame.data() + frame.size(), decoded.data(), decoded.size());
+    }
+    const auto finished = std::chrono::steady_clock::now();
+
+    const auto throughput =
+        [&](auto duration)
+        {
+            const double seconds = std::chrono::duration<double>(duration).count();
+            return (double) frame.size() * kIterations / seconds / (1024 * 1024);
+        };
+    std::cout << "Frame size: " << frame.size() << " bytes, NAL units: " << nalUnitCount
+        << ", decoded: " << decodedSize << std::endl
+        << "findNalUnitsAnnexB: " << throughput(scanned - start) << " MB/s" << std::endl
+        << "decodeEpb: " << throughput(finished - scanned) << " MB/s" << std::endl;
+}
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <string_view>
+
 #include <QtCore/QByteArray>
 
 #include "binary_stream_fwd.h"
@@ -42,6 +44,20 @@ public:
         return size;
     }
 
+    /**
+     * Gives access to the input without copying it, so the input must outlive the target.
+     * @return False if there are less than size bytes left.
+     */
+    bool readView(int size, std::string_view* target)
+    {
+        if (size < 0 || size > m_data->size() - m_pos)
+            return false;
+
+        *target = std::string_view(m_data->constData() + m_pos, (std::size_t) size);
+        m_pos += size;
+        return true;
+    }
+
     const QByteArray &buffer() const { return *m_data; }
     int pos() const { return m_pos; }
 
@@ -23,9 +23,9 @@ namespace QnCompressedTime {
     }
 
     template<class T>
-    QByteArray serialized(const T &value, bool signedFormat) {
+    QByteArray serialized(const T &value, bool signedFormat, bool blockFormat = false) {
         QByteArray result;
-        QnCompressedTimeWriter<QByteArray> stream(&result, signedFormat);
+        QnCompressedTimeWriter<QByteArray> stream(&result, signedFormat, blockFormat);
         QnCompressedTime::serialize(value, &stream);
         return result;
     }
@@ -0,0 +1,99 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "compressed_time_block.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <QtCore/QtEndian>
+
+#include <nx/utils/log/assert.h>
+
+namespace QnCompressedTime {
+
+namespace {
+
+// A value at any bit offset is within 9 bytes, so the buffers are padded to read them as a
+// 64-bit word and the next byte without bounds checks.
+static constexpr int kPadding = 9;
+static constexpr int kMaxPackedSize = kBlockSize * 8;
+
+int packedSize(int bitWidth, int count)
+{
+    return (bitWidth * count + 7) / 8;
+}
+
+quint64 mask(int bitWidth)
+{
+    return bitWidth == 64 ? ~0ull : (1ull << bitWidth) - 1;
+}
+
+} // namespace
+
+void packBlock(const quint64* values, int count, QByteArray* output)
+{
+    NX_ASSERT(count > 0 && count <= kBlockSize);
+
+    const auto [min, max] = std::minmax_element(values, values + count);
+    const quint64 reference = *min;
+    const int bitWidth = (int) std::bit_width(*max - reference);
+
+    char header[kBlockHeaderSize];
+    qToLittleEndian(reference, header);
+    header[8] = (char) bitWidth;
+    output->append(header, kBlockHeaderSize);
+    if (bitWidth == 0)
+        return;
+
+    quint8 packed[kMaxPackedSize + kPadding] = {};
+    for (int i = 0; i < count; ++i)
+    {
+        const quint64 value = values[i] - reference;
+        const int bit = i * bitWidth;
+        quint8* const data = packed + bit / 8;
+        const int shift = bit % 8;
+
+        qToLittleEndian(qFromLittleEndian<quint64>(data) | (value << shift), data);
+        if (shift != 0)
+            data[8] |= (quint8) (value >> (64 - shift));
+    }
+    output->append((const char*) packed, packedSize(bitWidth, count));
+}
+
+int packedBlockSize(const char* header, int count)
+{
+    const int bitWidth = (quint8) header[8];
+    return bitWidth <= 64 ? packedSize(bitWidth, count) : -1;
+}
+
+void unpackBlock(const char* header, const char* packed, int count, quint64* values)
+{
+    NX_ASSERT(count > 0 && count <= kBlockSize);
+
+    const quint64 reference = qFromLittleEndian<quint64>(header);
+    const int bitWidth = (quint8) header[8];
+    if (bitWidth == 0)
+    {
+        std::fill(values, values + count, reference);
+        return;
+    }
+
+    quint8 data[kMaxPackedSize + kPadding] = {};
+    std::memcpy(data, packed, packedSize(bitWidth, count));
+
+    const quint64 valueMask = mask(bitWidth);
+    for (int i = 0; i < count; ++i)
+    {
+        const int bit = i * bitWidth;
+        const quint8* const word = data + bit / 8;
+        const int shift = bit % 8;
+
+        const quint64 low = qFromLittleEndian<quint64>(word) >> shift;
+        // Shifting by 64 is undefined, so the high part is shifted in two steps.
+        const quint64 high = ((quint64) word[8] << 1) << (63 - shift);
+        values[i] = reference + ((low | high) & valueMask);
+    }
+}
+
+} // namespace QnCompressedTime
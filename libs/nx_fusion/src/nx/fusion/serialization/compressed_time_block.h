@@ -0,0 +1,46 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QtGlobal>
+
+/**
+ * Block encoding of the compressed time format (QnCompressedTime::BLOCK_FORMAT). The values of a
+ * block are stored as the difference to the block minimum (frame of reference), bit-packed with
+ * the width of the largest difference. The block header is the minimum (8 bytes, little endian)
+ * and the bit width (1 byte). Unpacking does not depend on the previous values, so it is a
+ * branchless loop the compiler vectorizes.
+ */
+namespace QnCompressedTime {
+
+static constexpr int kBlockSize = 128;
+static constexpr int kBlockHeaderSize = 9;
+
+inline quint64 zigzagEncode(qint64 value)
+{
+    return ((quint64) value << 1) ^ (quint64) (value >> 63);
+}
+
+inline qint64 zigzagDecode(quint64 value)
+{
+    return (qint64) (value >> 1) ^ -(qint64) (value & 1);
+}
+
+/**
+ * Appends the header and the packed values to the output.
+ * @param count Number of values, at most kBlockSize.
+ */
+NX_FUSION_API void packBlock(const quint64* values, int count, QByteArray* output);
+
+/**
+ * @return Size of the packed values following the header, or -1 if the header is invalid.
+ */
+NX_FUSION_API int packedBlockSize(const char* header, int count);
+
+/**
+ * @param packed Exactly packedBlockSize(header, count) bytes.
+ */
+NX_FUSION_API void unpackBlock(const char* header, const char* packed, int count, quint64* values);
+
+} // namespace QnCompressedTime
@@ -44,6 +44,12 @@ namespace QnCompressedTimeDetail {
     void serialize_collection(const Collection &value, QnCompressedTimeWriter<Output> *stream) {
         stream->resetLastValue();
         stream->writeSizeToStream(static_cast<int>(value.size()));
+        if constexpr (std::is_same_v<typename Collection::value_type, QnTimePeriod>) {
+            if (stream->isBlockFormat()) {
+                stream->writeQnTimePeriods(boost::begin(value), boost::end(value));
+                return;
+            }
+        }
         for(auto pos = boost::begin(value); pos != boost::end(value); ++pos)
             serialize_collection_element(*pos, stream, typename QnCollection::collection_category<Collection>::type());
     }
@@ -89,6 +95,15 @@ namespace QnCompressedTimeDetail {
         if(size >= 0)
             QnCollection::reserve(*target, size);
 
+        if constexpr (std::is_same_v<value_type, QnTimePeriod>) {
+            if (stream->isBlockFormat()) {
+                return stream->readQnTimePeriods(size,
+                    [target](QnTimePeriod period) {
+                        QnCollection::insert(*target, boost::end(*target), std::move(period));
+                    });
+            }
+        }
+
         for(; size > 0; --size) {
             if(!deserialize_collection_element(stream, target, static_cast<const value_type *>(NULL), typename QnCollection::collection_category<Collection>::type()))
                 return false;
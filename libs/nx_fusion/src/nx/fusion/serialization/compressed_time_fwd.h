@@ -16,6 +16,9 @@ namespace QnCompressedTime
 {
     static const char SIGNED_FORMAT[3] = {'B', '2', 'S'};
     static const char UNSIGNED_FORMAT[3] = {'B', '2', 'U'};
+
+    /** Signed format with the time period collections encoded in blocks. */
+    static const char BLOCK_FORMAT[3] = {'B', '3', 'P'};
 }
 
 #define QN_FUSION_DECLARE_FUNCTIONS_compressed_time(TYPE, ... /* PREFIX */)              \
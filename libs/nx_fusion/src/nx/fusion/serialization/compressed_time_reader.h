@@ -4,7 +4,9 @@
 #define QN_COMPRESSED_TIME_READER_H
 
 #include <algorithm> /* For std::min. */
+#include <array>
 #include <cassert>
+#include <string_view>
 
 #include <QtCore/QVarLengthArray>
 #include <QtCore/QtEndian>
@@ -14,6 +16,7 @@
 #include <recording/time_period.h>
 
 #include "binary_stream.h"
+#include "compressed_time_block.h"
 #include "compressed_time_fwd.h"
 
 template<class Input>
@@ -26,7 +29,8 @@ public:
         char format[3];
         memset(format, 0, sizeof(format));
         m_stream.read(format, sizeof(format));
-        m_signed = memcmp(format, QnCompressedTime::SIGNED_FORMAT, sizeof(QnCompressedTime::SIGNED_FORMAT)) == 0;
+        m_block = memcmp(format, QnCompressedTime::BLOCK_FORMAT, sizeof(format)) == 0;
+        m_signed = m_block || memcmp(format, QnCompressedTime::SIGNED_FORMAT, sizeof(format)) == 0;
     }
 
     void resetLastValue() {
@@ -57,6 +61,36 @@ public:
         return true;
     }
 
+    bool isBlockFormat() const { return m_block; }
+
+    /**
+     * Reads the time periods written by QnCompressedTimeWriter::writeQnTimePeriods.
+     * @param handler Invoked with each period.
+     */
+    template<class Handler>
+    bool readQnTimePeriods(int count, Handler handler)
+    {
+        std::array<quint64, QnCompressedTime::kBlockSize> gaps;
+        std::array<quint64, QnCompressedTime::kBlockSize> durations;
+        while (count > 0)
+        {
+            const int blockCount = std::min(count, QnCompressedTime::kBlockSize);
+            if (!readBlock(blockCount, gaps.data()) || !readBlock(blockCount, durations.data()))
+                return false;
+
+            for (int i = 0; i < blockCount; ++i)
+            {
+                QnTimePeriod period;
+                period.startTimeMs = m_lastValue + QnCompressedTime::zigzagDecode(gaps[i]);
+                period.durationMs = QnCompressedTime::zigzagDecode(durations[i]);
+                m_lastValue = period.startTimeMs + period.durationMs;
+                handler(std::move(period));
+            }
+            count -= blockCount;
+        }
+        return true;
+    }
+
     bool readUuid(nx::Uuid* value)
     {
         char tmp[16];
@@ -85,6 +119,21 @@ private:
     }
 
 
+    bool readBlock(int count, quint64* values)
+    {
+        char header[QnCompressedTime::kBlockHeaderSize];
+        if (m_stream.read(header, sizeof(header)) != sizeof(header))
+            return false;
+
+        std::string_view packed;
+        const int size = QnCompressedTime::packedBlockSize(header, count);
+        if (size < 0 || !m_stream.readView(size, &packed))
+            return false;
+
+        QnCompressedTime::unpackBlock(header, packed.data(), count, values);
+        return true;
+    }
+
     int decodeValue(qint64& value)
     {
         quint8 tmp[8];
@@ -125,6 +174,7 @@ public:
 private:
     QnInputBinaryStream<Input> m_stream;
     bool m_signed;
+    bool m_block;
     qint64 m_lastValue;
 };
 
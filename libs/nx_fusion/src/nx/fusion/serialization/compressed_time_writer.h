@@ -3,23 +3,34 @@
 #ifndef QN_COMPRESSED_TIME_WRITER_H
 #define QN_COMPRESSED_TIME_WRITER_H
 
+#include <array>
+
 #include <QtCore/QtEndian>
 #include <QtCore/QtGlobal>
 
 #include <recording/time_period.h>
 
 #include "binary_stream.h"
+#include "compressed_time_block.h"
 #include "compressed_time_fwd.h"
 
 template<class Output>
 class QnCompressedTimeWriter {
 public:
-    QnCompressedTimeWriter(Output *data, bool signedFormat):
+    /**
+     * @param blockFormat Encode the time period collections in blocks, which is more compact
+     *     and faster to decode, but is not supported by the readers older than
+     *     QnCompressedTime::BLOCK_FORMAT. Implies signedFormat.
+     */
+    QnCompressedTimeWriter(Output *data, bool signedFormat, bool blockFormat = false):
         m_stream(data),
-        m_signed(signedFormat),
+        m_signed(signedFormat || blockFormat),
+        m_block(blockFormat),
         m_lastValue(0)
     {
-        if (m_signed)
+        if (m_block)
+            m_stream.write(QnCompressedTime::BLOCK_FORMAT, sizeof(QnCompressedTime::BLOCK_FORMAT));
+        else if (m_signed)
             m_stream.write(QnCompressedTime::SIGNED_FORMAT, sizeof(QnCompressedTime::SIGNED_FORMAT));
         else
             m_stream.write(QnCompressedTime::UNSIGNED_FORMAT, sizeof(QnCompressedTime::UNSIGNED_FORMAT));
@@ -44,6 +55,35 @@ public:
         m_lastValue = value.startTimeMs + value.durationMs;
     }
 
+    bool isBlockFormat() const { return m_block; }
+
+    /**
+     * Writes the time periods of a collection in blocks of QnCompressedTime::kBlockSize: the gaps
+     * between the periods, then their durations.
+     */
+    template<class Iterator>
+    void writeQnTimePeriods(Iterator begin, Iterator end)
+    {
+        std::array<quint64, QnCompressedTime::kBlockSize> gaps;
+        std::array<quint64, QnCompressedTime::kBlockSize> durations;
+        QByteArray block;
+        while (begin != end)
+        {
+            int count = 0;
+            for (; begin != end && count < QnCompressedTime::kBlockSize; ++begin, ++count)
+            {
+                gaps[count] = QnCompressedTime::zigzagEncode(begin->startTimeMs - m_lastValue);
+                durations[count] = QnCompressedTime::zigzagEncode(begin->durationMs);
+                m_lastValue = begin->startTimeMs + begin->durationMs;
+            }
+
+            block.clear();
+            QnCompressedTime::packBlock(gaps.data(), count, &block);
+            QnCompressedTime::packBlock(durations.data(), count, &block);
+            m_stream.write(block.data(), block.size());
+        }
+    }
+
     void writeUuid(const nx::Uuid& value)
     {
         const QByteArray tmp(value.toRfc4122());
@@ -122,6 +162,7 @@ private:
 private:
     QnOutputBinaryStream<Output> m_stream;
     bool m_signed;
+    bool m_block;
     qint64 m_lastValue;
 };
 
@@ -0,0 +1,136 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+#include <nx/fusion/fusion/fusion.h>
+#include <nx/utils/log/assert.h>
+
+#include "sql_functions.h"
+
+namespace QnSqlDetail {
+
+class PlaceholderMappingVisitor
+{
+public:
+    PlaceholderMappingVisitor(
+        const std::vector<std::string>& placeholders,
+        std::vector<std::vector<int>>* fieldPlaceholders)
+        :
+        m_placeholders(placeholders),
+        m_fieldPlaceholders(fieldPlaceholders)
+    {
+    }
+
+    template<class T, class Access>
+    bool operator()(const T&, const Access& access, const QnFusion::start_tag&) const
+    {
+        using namespace QnFusion;
+        m_fieldPlaceholders->resize(access(member_count));
+        return true;
+    }
+
+    template<class T, class Access>
+    bool operator()(const T&, const Access& access) const
+    {
+        using namespace QnFusion;
+
+        const std::string name = access(sql_placeholder_name).toStdString();
+        for (int i = 0; i < (int) m_placeholders.size(); ++i)
+        {
+            if (m_placeholders[i] == name)
+                (*m_fieldPlaceholders)[access(member_index)].push_back(i);
+        }
+        return true;
+    }
+
+private:
+    const std::vector<std::string>& m_placeholders;
+    std::vector<std::vector<int>>* m_fieldPlaceholders;
+};
+
+class RowSerializationVisitor
+{
+public:
+    RowSerializationVisitor(
+        const std::vector<std::vector<int>>& fieldPlaceholders, QVariant* values)
+        :
+        m_fieldPlaceholders(fieldPlaceholders),
+        m_values(values)
+    {
+    }
+
+    template<class T, class Access>
+    bool operator()(const T& value, const Access& access) const
+    {
+        using namespace QnFusion;
+
+        const auto& placeholders = m_fieldPlaceholders[access(member_index)];
+        if (placeholders.empty())
+            return true; //< Not bound: the field is not serialized at all.
+
+        QnSql::serialize_field(invoke(access(getter), value), &m_values[placeholders.front()]);
+        for (std::size_t i = 1; i < placeholders.size(); ++i)
+            m_values[placeholders[i]] = m_values[placeholders.front()];
+        return true;
+    }
+
+private:
+    const std::vector<std::vector<int>>& m_fieldPlaceholders;
+    QVariant* const m_values;
+};
+
+} // namespace QnSqlDetail
+
+namespace QnSql {
+
+/**
+ * Serializes the fields of a sql_record type straight to the values of the given placeholders,
+ * without the named binding of QnSql::bind. The placeholders are matched to the fields once. Is
+ * meant for inserting many rows with nx::sql::insertMany:
+ * <pre><code>
+ * const nx::sql::BulkInsertStatement statement(
+ *     "INSERT INTO event_log (timestamp, event_type) VALUES (:timestamp, :eventType)");
+ * nx::sql::insertMany(queryContext, statement, records,
+ *     QnSql::RowSerializer<EventLogRecord>(statement.placeholders()));
+ * </code></pre>
+ */
+template<class T>
+class RowSerializer
+{
+public:
+    /**
+     * @param placeholders Named placeholders (":name") of the row in the binding order.
+     */
+    RowSerializer(const std::vector<std::string>& placeholders):
+        m_valueCount((int) placeholders.size())
+    {
+        QnFusion::visit_members(
+            T(), QnSqlDetail::PlaceholderMappingVisitor(placeholders, &m_fieldPlaceholders));
+
+        int boundCount = 0;
+        for (const auto& fieldPlaceholders: m_fieldPlaceholders)
+            boundCount += (int) fieldPlaceholders.size();
+        NX_ASSERT(boundCount == m_valueCount, "Some placeholders do not match any field");
+    }
+
+    /**
+     * @param values Array of placeholders().size() values, in the order of the placeholders.
+     */
+    void operator()(const T& row, QVariant* values) const
+    {
+        QnFusion::visit_members(
+            row, QnSqlDetail::RowSerializationVisitor(m_fieldPlaceholders, values));
+    }
+
+private:
+    const int m_valueCount;
+    std::vector<std::vector<int>> m_fieldPlaceholders;
+};
+
+} // namespace QnSql
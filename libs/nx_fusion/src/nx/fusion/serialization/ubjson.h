@@ -6,12 +6,34 @@
 #include <optional>
 
 #include <nx/utils/buffer.h>
+#include <nx/utils/scope_guard.h>
 
 #include "serialization.h"
 #include "ubjson_fwd.h"
 #include "ubjson_reader.h"
 #include "ubjson_writer.h"
 
+namespace QnUbjsonDetail {
+    /**
+     * Scratch buffer that keeps its capacity between serializations in the same thread, so that
+     * a message does not go through a chain of reallocations while it grows.
+     */
+    struct ThreadBuffer
+    {
+        /** Larger buffers are freed after use to not pin the memory of a one-off huge message. */
+        static constexpr qsizetype kMaxKeptCapacity = 4 * 1024 * 1024;
+
+        QByteArray data;
+        bool inUse = false;
+    };
+
+    inline ThreadBuffer& threadBuffer()
+    {
+        thread_local ThreadBuffer buffer;
+        return buffer;
+    }
+} // namespace QnUbjsonDetail
+
 namespace QnUbjson {
     template<class T, class Output>
     void serialize(const T &value, QnUbjsonWriter<Output> *stream) {
@@ -60,12 +82,34 @@ namespace QnUbjson {
         QnUbjson::serialize(value, &stream);
     }
 
+    /**
+     * Serializes into the per-thread scratch buffer and returns an exactly sized copy of it.
+     */
     template<class T>
     QByteArray serialized(const T &value) {
-        QByteArray result;
-        QnUbjsonWriter<QByteArray> stream(&result);
+        auto& buffer = QnUbjsonDetail::threadBuffer();
+        if (buffer.inUse)
+        {
+            // Called from a serialization function.
+            QByteArray result;
+            QnUbjsonWriter<QByteArray> stream(&result);
+            QnUbjson::serialize(value, &stream);
+            return result;
+        }
+
+        buffer.inUse = true;
+        buffer.data.resize(0); //< Keeps the capacity.
+        auto guard = nx::utils::makeScopeGuard(
+            [&buffer]()
+            {
+                buffer.inUse = false;
+                if (buffer.data.capacity() > QnUbjsonDetail::ThreadBuffer::kMaxKeptCapacity)
+                    buffer.data = QByteArray();
+            });
+
+        QnUbjsonWriter<QByteArray> stream(&buffer.data);
         QnUbjson::serialize(value, &stream);
-        return result;
+        return QByteArray(buffer.data.constData(), buffer.data.size());
     }
 
     template<typename T>
@@ -85,6 +129,10 @@ namespace QnUbjson {
         return std::forward<Type>(defaultValue);
     }
 
+    /**
+     * Reads right from the referenced memory: neither the input nor the strings in it are copied
+     * into intermediate buffers.
+     */
     template<typename T>
     auto deserialized(const nx::ConstBufferRefType& value, T&& defaultValue = {}, bool* success = nullptr)
     {
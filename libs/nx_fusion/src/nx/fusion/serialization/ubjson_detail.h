@@ -3,6 +3,8 @@
 #ifndef QN_UBJSON_DETAIL_H
 #define QN_UBJSON_DETAIL_H
 
+#include <string_view>
+
 #include <QtCore/QtEndian>
 #include <QtCore/QtGlobal>
 
@@ -178,6 +180,11 @@ namespace QnUbjsonDetail {
             }
         }
 
+        /** The target refers to the input data, see QnInputBinaryStream::readView(). */
+        bool readBytes(int size, std::string_view* target) {
+            return m_stream.readView(size, target);
+        }
+
         bool skipBytes(int size) {
             return m_stream.skip(size) == size;
         }
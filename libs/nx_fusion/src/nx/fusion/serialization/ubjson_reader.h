@@ -5,6 +5,7 @@
 
 #include <algorithm> //< For std::min.
 #include <array>
+#include <string_view>
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
@@ -144,11 +145,12 @@ public:
     {
         NX_ASSERT(target);
 
-        QByteArray tmp;
-        if(!readUtf8String(&tmp))
+        // Decode right from the input, without an intermediate copy.
+        std::string_view view;
+        if (!readUtf8StringInternal(QnUbjson::Utf8StringMarker, &view))
             return false;
 
-        *target = QString::fromUtf8(tmp);
+        *target = QString::fromUtf8(view.data(), (qsizetype) view.size());
         return true;
     }
 
@@ -156,11 +158,12 @@ public:
     {
         NX_ASSERT(target);
 
-        QByteArray tmp;
-        if (!readUtf8String(&tmp))
+        // Decode right from the input, without an intermediate copy.
+        std::string_view view;
+        if (!readUtf8StringInternal(QnUbjson::Utf8StringMarker, &view))
             return false;
 
-        *target = tmp.toStdString();
+        target->assign(view);
         return true;
     }
 
@@ -427,7 +430,8 @@ private:
         return true;
     }
 
-    bool readUtf8StringInternal(QnUbjson::Marker expectedMarker, QByteArray *target)
+    template<class Target>
+    bool readUtf8StringInternal(QnUbjson::Marker expectedMarker, Target *target)
     {
         NX_ASSERT(target);
 
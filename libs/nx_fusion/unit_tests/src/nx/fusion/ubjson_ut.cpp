@@ -1,5 +1,8 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <chrono>
+#include <iostream>
+
 #include <gtest/gtest.h>
 
 #include <nx/fusion/model_functions.h>
@@ -47,6 +50,18 @@ struct BriefMockDataWithQJsonValue
 QN_FUSION_ADAPT_STRUCT_FUNCTIONS(
     BriefMockDataWithQJsonValue, (ubjson), BriefMockDataWithQJsonValue_Fields)
 
+/** Serializes the nested struct with QnUbjson::serialized() from inside of serialization. */
+struct TestStructWrapper
+{
+    TestStruct inner;
+};
+
+template<class Output>
+void serialize(const TestStructWrapper& value, QnUbjsonWriter<Output>* stream)
+{
+    QnUbjson::serialize(QnUbjson::serialized(value.inner), stream);
+}
+
 TEST(UbJsonTest, qint8)
 {
     const qint8 value = -128;
@@ -225,3 +240,86 @@ TEST(UbJsonTest, customStructVectorAncestorFromDescendant)
         ASSERT_DOUBLE_EQ(result[i].doubleData, testStructures[i].doubleData);
     }
 }
+
+TEST(UbJsonTest, serializedIsReentrant)
+{
+    const TestStructWrapper value{{1, "inner", 2.5}};
+    const QByteArray inner = QnUbjson::serialized(value.inner);
+
+    QByteArray expected;
+    QnUbjson::serialize(inner, &expected);
+    ASSERT_EQ(expected, QnUbjson::serialized(value));
+
+    // The thread buffer must be free again.
+    ASSERT_EQ(inner, QnUbjson::serialized(value.inner));
+}
+
+TEST(UbJsonTest, stringsAreReadFromRawData)
+{
+    const std::vector<std::string> value{
+        "", "ascii", "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82"};
+    const std::string data = QnUbjson::serialized(value).toStdString();
+
+    bool success = false;
+    const auto result = QnUbjson::deserialized<std::vector<std::string>>(
+        nx::ConstBufferRefType(data), {}, &success);
+    ASSERT_TRUE(success);
+    ASSERT_EQ(value, result);
+
+    const auto qStrings = QnUbjson::deserialized<std::vector<QString>>(
+        nx::ConstBufferRefType(data), {}, &success);
+    ASSERT_TRUE(success);
+    ASSERT_EQ(QString::fromStdString(value[2]), qStrings[2]);
+
+    for (std::size_t size = 0; size < data.size(); ++size)
+    {
+        QnUbjson::deserialized<std::vector<std::string>>(
+            nx::ConstBufferRefType(data.data(), size), {}, &success);
+        ASSERT_FALSE(success) << size;
+    }
+}
+
+TEST(UbJsonTest, DISABLED_serializationPerformance)
+{
+    static constexpr int kStructCount = 100;
+    static constexpr int kIterations = 100'000;
+
+    std::vector<TestStructEx> value;
+    for (int i = 0; i < kStructCount; ++i)
+    {
+        value.push_back(
+            {{i, QString("Some text data %1").arg(i), i * 0.5}, nx::Uuid::createUuid()});
+    }
+
+    const auto messageSize = QnUbjson::serialized(value).size();
+    const auto measure =
+        [&](auto serialize)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i)
+                ASSERT_EQ(messageSize, serialize().size());
+            const std::chrono::duration<double> duration =
+                std::chrono::steady_clock::now() - start;
+            std::cout << kIterations * messageSize / duration.count() / (1024 * 1024) << " MB/s, ";
+        };
+
+    std::cout << messageSize << " bytes. Growing buffer: ";
+    measure(
+        [&value]()
+        {
+            QByteArray result;
+            QnUbjsonWriter<QByteArray> stream(&result);
+            QnUbjson::serialize(value, &stream);
+            return result;
+        });
+    std::cout << "thread buffer: ";
+    measure([&value]() { return QnUbjson::serialized(value); });
+
+    const QByteArray data = QnUbjson::serialized(value);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i)
+        ASSERT_EQ(value.size(), QnUbjson::deserialized<std::vector<TestStruct>>(data).size());
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    std::cout << "deserialization: "
+        << kIterations * messageSize / duration.count() / (1024 * 1024) << " MB/s" << std::endl;
+}
@@ -184,23 +184,28 @@ void OutgoingProcessor::send(Request request, std::string serializedRequest) con
         "Request: `%1`, serialized: `%2`", nx::reflect::json::serialize(request), serializedRequest);
     if (serializedRequest.empty())
         serializedRequest = nx::reflect::json::serialize(request);
-    m_sendFunc(std::move(serializedRequest));
+    m_sendFunc(std::move(serializedRequest), /*isNotification*/ !request.id);
 }
 
 void OutgoingProcessor::send(std::vector<Request> requests) const
 {
-    m_sendFunc(nx::reflect::json::serialize(requests));
+    m_sendFunc(nx::reflect::json::serialize(requests), /*isNotification*/ false);
 }
 
 void OutgoingProcessor::onResponse(rapidjson::Document data)
 {
-    if (data.IsArray())
+    onResponse(std::make_shared<rapidjson::Document>(std::move(data)));
+}
+
+void OutgoingProcessor::onResponse(std::shared_ptr<rapidjson::Document> data)
+{
+    if (data->IsArray())
     {
         onArrayResponse(std::move(data));
         return;
     }
 
-    Response response{.document = std::make_shared<rapidjson::Document>(std::move(data))};
+    Response response{.document = std::move(data)};
     if (!response.deserialize(*response.document))
     {
         NX_DEBUG(this,
@@ -247,12 +252,11 @@ void OutgoingProcessor::onResponse(rapidjson::Document data)
         nx::reflect::json_detail::getStringRepresentation(*response.document));
 }
 
-void OutgoingProcessor::onArrayResponse(rapidjson::Document list)
+void OutgoingProcessor::onArrayResponse(std::shared_ptr<rapidjson::Document> holder)
 {
     std::set<Key> batchResponseKeys;
     std::unordered_map<Id, Response> idResponses;
     std::vector<Response> nullResponses;
-    auto holder{std::make_shared<rapidjson::Document>(std::move(list))};
     for (int i = 0; i < (int) holder->Size(); ++i)
     {
         Response response{.document = holder};
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -20,7 +21,7 @@ class OutgoingProcessor
 {
 public:
     using Id = std::variant<QString, int>;
-    using SendFunc = nx::utils::MoveOnlyFunc<void(std::string)>;
+    using SendFunc = nx::utils::MoveOnlyFunc<void(std::string, bool /*isNotification*/)>;
     OutgoingProcessor(SendFunc sendFunc): m_sendFunc(std::move(sendFunc)) {}
     ~OutgoingProcessor() { clear(SystemError::interrupted); }
 
@@ -33,11 +34,12 @@ public:
     void processBatchRequest(std::vector<Request> jsonRpcRequests, BatchResponseHandler handler);
 
     void onResponse(rapidjson::Document data);
+    void onResponse(std::shared_ptr<rapidjson::Document> data);
 
 private:
     void send(Request request, std::string serializedRequest) const;
     void send(std::vector<Request> jsonRpcRequests) const;
-    void onArrayResponse(rapidjson::Document list);
+    void onArrayResponse(std::shared_ptr<rapidjson::Document> list);
 
 private:
     using Key = size_t;
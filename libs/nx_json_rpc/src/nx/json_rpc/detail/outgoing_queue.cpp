@@ -0,0 +1,52 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "outgoing_queue.h"
+
+namespace nx::json_rpc::detail {
+
+void OutgoingQueue::push(std::string message, bool isNotification)
+{
+    m_messages.push_back({std::move(message), isNotification});
+}
+
+void OutgoingQueue::push(std::shared_ptr<const nx::network::websocket::SharedMessage> message)
+{
+    m_messages.push_back({.shared = std::move(message)});
+}
+
+std::shared_ptr<const nx::network::websocket::SharedMessage> OutgoingQueue::popShared()
+{
+    if (m_messages.empty() || !m_messages.front().shared)
+        return nullptr;
+
+    auto message = std::move(m_messages.front().shared);
+    m_messages.pop_front();
+    return message;
+}
+
+std::optional<std::string> OutgoingQueue::pop()
+{
+    if (m_messages.empty() || m_messages.front().shared)
+        return std::nullopt;
+
+    auto message = std::move(m_messages.front());
+    m_messages.pop_front();
+    if (m_maxBatchSize <= 1 || !message.isNotification
+        || m_messages.empty() || !m_messages.front().isNotification)
+    {
+        return std::move(message.data);
+    }
+
+    std::string batch = "[" + std::move(message.data);
+    for (int i = 1; i < m_maxBatchSize
+        && !m_messages.empty() && m_messages.front().isNotification; ++i)
+    {
+        batch += ',';
+        batch += m_messages.front().data;
+        m_messages.pop_front();
+    }
+    batch += ']';
+    return batch;
+}
+
+} // namespace nx::json_rpc::detail
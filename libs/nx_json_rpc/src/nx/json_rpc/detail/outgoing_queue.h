@@ -0,0 +1,70 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace nx::network::websocket { struct SharedMessage; }
+
+namespace nx::json_rpc::detail {
+
+/*
+ * Class for internal usage by WebSocketConnection.
+ * Messages waiting for the previous frame to be sent. If enabled, the notifications queued one
+ * after another are sent as a single batch frame, so that a burst of subscription updates costs
+ * one frame. Order of the messages is preserved.
+ */
+class OutgoingQueue
+{
+public:
+    /**
+     * @param maxBatchSize Maximum number of the notifications sent in one frame. 1 disables the
+     *     coalescing, so every message is sent in its own frame.
+     */
+    OutgoingQueue(int maxBatchSize = 1): m_maxBatchSize(maxBatchSize) {}
+
+    void setMaxBatchSize(int value) { m_maxBatchSize = value; }
+
+    /**
+     * @param isNotification Whether the message is a single request without id. Only such
+     *     messages are coalesced.
+     */
+    void push(std::string message, bool isNotification);
+
+    /**
+     * Queues the message serialized once for many connections. It is sent as is, so it is never
+     * coalesced with the other ones.
+     */
+    void push(std::shared_ptr<const nx::network::websocket::SharedMessage> message);
+
+    /**
+     * @return The next message if it is a shared one, nullptr otherwise. Must be checked before
+     *     pop().
+     */
+    std::shared_ptr<const nx::network::websocket::SharedMessage> popShared();
+
+    /**
+     * @return The next frame to send, std::nullopt if the queue is empty or the next message is
+     *     a shared one.
+     */
+    std::optional<std::string> pop();
+
+    bool empty() const { return m_messages.empty(); }
+    void clear() { m_messages.clear(); }
+
+private:
+    struct Message
+    {
+        std::string data;
+        bool isNotification = false;
+        std::shared_ptr<const nx::network::websocket::SharedMessage> shared;
+    };
+
+    int m_maxBatchSize = 1;
+    std::deque<Message> m_messages;
+};
+
+} // namespace nx::json_rpc::detail
@@ -0,0 +1,73 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "parse_arena.h"
+
+namespace nx::json_rpc::detail {
+
+ParseArena::Arena::Arena(std::size_t size):
+    buffer(new char[size]),
+    allocator(buffer.get(), size)
+{
+}
+
+ParseArena::Pool::Pool(std::size_t arenaSize, int maxPooledArenas):
+    arenaSize(arenaSize),
+    maxPooledArenas(maxPooledArenas)
+{
+}
+
+std::unique_ptr<ParseArena::Arena> ParseArena::Pool::take()
+{
+    {
+        NX_MUTEX_LOCKER lock(&mutex);
+        if (!arenas.empty())
+        {
+            auto arena = std::move(arenas.back());
+            arenas.pop_back();
+            return arena;
+        }
+    }
+
+    return std::make_unique<Arena>(arenaSize);
+}
+
+void ParseArena::Pool::put(std::unique_ptr<Arena> arena)
+{
+    // Frees the chunks allocated on top of the arena buffer.
+    arena->allocator.Clear();
+
+    NX_MUTEX_LOCKER lock(&mutex);
+    if ((int) arenas.size() < maxPooledArenas)
+        arenas.push_back(std::move(arena));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+ParseArena::ParseArena(std::size_t arenaSize, int maxPooledArenas):
+    m_pool(std::make_shared<Pool>(arenaSize, maxPooledArenas))
+{
+}
+
+std::shared_ptr<rapidjson::Document> ParseArena::parse(std::string_view data)
+{
+    auto arena = m_pool->take();
+    auto document = std::make_unique<rapidjson::Document>(&arena->allocator);
+    document->Parse(data.data(), data.size());
+
+    // The document refers to the arena allocator, so the arena is released only after it.
+    return std::shared_ptr<rapidjson::Document>(
+        document.release(),
+        [pool = m_pool, arena = arena.release()](rapidjson::Document* document)
+        {
+            delete document;
+            pool->put(std::unique_ptr<Arena>(arena));
+        });
+}
+
+int ParseArena::pooledArenaCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_pool->mutex);
+    return (int) m_pool->arenas.size();
+}
+
+} // namespace nx::json_rpc::detail
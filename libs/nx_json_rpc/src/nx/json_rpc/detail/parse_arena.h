@@ -0,0 +1,62 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::json_rpc::detail {
+
+/*
+ * Class for internal usage by WebSocketConnection.
+ * Pool of the memory arenas to parse the incoming messages in. A parsed document returns its
+ * arena to the pool when the last reference to it is dropped, so parsing of the messages that fit
+ * into the arena does not allocate. Documents may outlive the pool.
+ */
+class ParseArena
+{
+public:
+    static constexpr std::size_t kDefaultArenaSize = 16 * 1024;
+    static constexpr int kDefaultMaxPooledArenas = 2;
+
+    ParseArena(
+        std::size_t arenaSize = kDefaultArenaSize,
+        int maxPooledArenas = kDefaultMaxPooledArenas);
+
+    /**
+     * @return Parsed document. The parse error is reported with rapidjson::Document::HasParseError.
+     */
+    std::shared_ptr<rapidjson::Document> parse(std::string_view data);
+
+    int pooledArenaCount() const;
+
+private:
+    struct Arena
+    {
+        std::unique_ptr<char[]> buffer;
+        rapidjson::Document::AllocatorType allocator;
+
+        Arena(std::size_t size);
+    };
+
+    struct Pool
+    {
+        const std::size_t arenaSize;
+        const int maxPooledArenas;
+        mutable nx::Mutex mutex;
+        std::vector<std::unique_ptr<Arena>> arenas;
+
+        Pool(std::size_t arenaSize, int maxPooledArenas);
+        std::unique_ptr<Arena> take();
+        void put(std::unique_ptr<Arena> arena);
+    };
+
+    std::shared_ptr<Pool> m_pool;
+};
+
+} // namespace nx::json_rpc::detail
@@ -28,12 +28,25 @@ static QString idWithMethod(const Request& request)
         "request %1 with method %2", nx::reflect::json::serialize(request.id), request.method);
 }
 
+static std::string serializeBatchResponse(const std::vector<Response>& responses)
+{
+    // Nothing is sent back for a batch of notifications.
+    return responses.empty() ? std::string() : nx::reflect::json::serialize(responses);
+}
+
 void IncomingProcessor::processRequest(
     rapidjson::Document data, nx::utils::MoveOnlyFunc<void(std::string)> handler)
 {
-    if (data.IsArray())
+    processRequest(std::make_shared<rapidjson::Document>(std::move(data)), std::move(handler));
+}
+
+void IncomingProcessor::processRequest(
+    std::shared_ptr<rapidjson::Document> holder,
+    nx::utils::MoveOnlyFunc<void(std::string)> handler)
+{
+    if (holder->IsArray())
     {
-        if (data.Empty())
+        if (holder->Empty())
         {
             NX_DEBUG(this, "Empty batch request received");
             return sendResponse(
@@ -42,10 +55,9 @@ void IncomingProcessor::processRequest(
                 handler);
         }
 
-        return processBatchRequest(std::move(data), std::move(handler));
+        return processBatchRequest(std::move(holder), std::move(handler));
     }
 
-    auto holder = std::make_shared<rapidjson::Document>(std::move(data));
     auto requestOrError = deserialize(*holder, holder);
     if (std::holds_alternative<Response>(requestOrError))
         return sendResponse(std::get<Response>(std::move(requestOrError)), handler);
@@ -73,12 +85,12 @@ void IncomingProcessor::processRequest(
 }
 
 void IncomingProcessor::processBatchRequest(
-    rapidjson::Document list, nx::utils::MoveOnlyFunc<void(std::string)> handler)
+    std::shared_ptr<rapidjson::Document> holder,
+    nx::utils::MoveOnlyFunc<void(std::string)> handler)
 {
     std::vector<Response> responses;
     std::unordered_map<Request*, std::unique_ptr<Request>> requests;
     std::vector<Request*> requestPtrs;
-    auto holder = std::make_shared<rapidjson::Document>(std::move(list));
     for (auto it = holder->Begin(); it != holder->End(); ++it)
     {
         auto& item = *it;
@@ -107,7 +119,7 @@ void IncomingProcessor::processBatchRequest(
 
     if (requests.empty())
     {
-        auto serialized{nx::reflect::json::serialize(responses)};
+        auto serialized{serializeBatchResponse(responses)};
         NX_DEBUG(this, "No valid request in batch, responses %1", serialized);
         handler(std::move(serialized));
         return;
@@ -155,7 +167,7 @@ void IncomingProcessor::onBatchResponse(
         m_batchRequests.erase(it);
 
         NX_DEBUG(this, "End of %1", batchRequest);
-        handler(nx::reflect::json::serialize(responses));
+        handler(serializeBatchResponse(responses));
     }
 }
 
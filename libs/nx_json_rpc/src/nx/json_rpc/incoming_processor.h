@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -21,6 +22,14 @@ public:
     void processRequest(
         rapidjson::Document data, nx::utils::MoveOnlyFunc<void(std::string)> handler);
 
+    /**
+     * @param handler Receives the serialized response. Empty string means that there is nothing
+     *     to send, e.g., for a notification or a batch of notifications.
+     */
+    void processRequest(
+        std::shared_ptr<rapidjson::Document> data,
+        nx::utils::MoveOnlyFunc<void(std::string)> handler);
+
 private:
     struct BatchRequest
     {
@@ -32,7 +41,8 @@ private:
     void onBatchResponse(BatchRequest* batchRequest, Request* request, Response response);
 
     void processBatchRequest(
-        rapidjson::Document list, nx::utils::MoveOnlyFunc<void(std::string)> handler);
+        std::shared_ptr<rapidjson::Document> list,
+        nx::utils::MoveOnlyFunc<void(std::string)> handler);
 
     void sendResponse(
         Response response, const nx::utils::MoveOnlyFunc<void(std::string)>& handler);
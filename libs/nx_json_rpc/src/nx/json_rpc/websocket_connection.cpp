@@ -2,9 +2,13 @@
 
 #include "websocket_connection.h"
 
+#include <algorithm>
+
 #include <nx/network/websocket/websocket.h>
 
 #include "detail/outgoing_processor.h"
+#include "detail/outgoing_queue.h"
+#include "detail/parse_arena.h"
 #include "incoming_processor.h"
 
 namespace nx::json_rpc {
@@ -57,6 +61,8 @@ WebSocketConnection::WebSocketConnection(
     std::unique_ptr<nx::network::websocket::WebSocket> webSocket, OnDone onDone)
     :
     m_onDone(std::move(onDone)),
+    m_parseArena(std::make_unique<ParseArena>()),
+    m_outgoingQueue(std::make_unique<OutgoingQueue>()),
     m_socket(std::move(webSocket))
 {
     base_type::bindToAioThread(m_socket->getAioThread());
@@ -64,15 +70,27 @@ WebSocketConnection::WebSocketConnection(
         m_address = socket->getForeignAddress();
 }
 
+void WebSocketConnection::setMaxConcurrentRequests(int value)
+{
+    NX_ASSERT(value > 0);
+    m_maxConcurrentRequests = std::max(value, 1);
+}
+
+void WebSocketConnection::setMaxNotificationBatchSize(int value)
+{
+    NX_ASSERT(value > 0);
+    m_outgoingQueue->setMaxBatchSize(std::max(value, 1));
+}
+
 void WebSocketConnection::start(
     std::weak_ptr<WebSocketConnection> self, RequestHandler requestHandler)
 {
     m_self = std::move(self);
     m_outgoingProcessor = std::make_unique<OutgoingProcessor>(
-        [self = m_self](auto value)
+        [self = m_self](auto value, bool isNotification)
         {
             if (auto lock = self.lock())
-                lock->send(std::move(value));
+                lock->send(std::move(value), isNotification);
         });
     if (requestHandler)
     {
@@ -114,8 +132,9 @@ void WebSocketConnection::stopWhileInAioThread()
 
     m_guards.clear();
     m_socket->pleaseStopSync();
-    std::queue<rapidjson::Document> empty;
+    decltype(m_queuedRequests) empty;
     m_queuedRequests.swap(empty);
+    m_outgoingQueue->clear();
 }
 
 void WebSocketConnection::send(
@@ -151,6 +170,21 @@ void WebSocketConnection::send(
         });
 }
 
+void WebSocketConnection::send(
+    std::shared_ptr<const nx::network::websocket::SharedMessage> notification)
+{
+    dispatch(
+        [self = m_self, notification = std::move(notification)]() mutable
+        {
+            if (auto lock = self.lock())
+            {
+                lock->m_outgoingQueue->push(std::move(notification));
+                if (!lock->m_sendInProgress)
+                    lock->sendNextFrame();
+            }
+        });
+}
+
 void WebSocketConnection::readNextMessage()
 {
     auto buffer = std::make_unique<nx::Buffer>();
@@ -181,18 +215,17 @@ void WebSocketConnection::readNextMessage()
 void WebSocketConnection::readHandler(const nx::Buffer& buffer)
 {
     logMessage("receive from", m_address, buffer);
-    rapidjson::Document data;
-    data.Parse(buffer.data(), buffer.size());
-    if (data.HasParseError())
+    auto data = m_parseArena->parse(std::string_view(buffer.data(), buffer.size()));
+    if (data->HasParseError())
     {
         auto r{nx::reflect::json::serialize(Response::makeError(std::nullptr_t{},
-            Error::parseError, nx::reflect::json_detail::parseErrorToString(data)))};
+            Error::parseError, nx::reflect::json_detail::parseErrorToString(*data)))};
         NX_DEBUG(this, "Error processing received message: " + r);
         send(std::move(r));
         return;
     }
 
-    if (auto [isResponse_, errorResponse] = isResponse(data); errorResponse)
+    if (auto [isResponse_, errorResponse] = isResponse(*data); errorResponse)
     {
         auto r{nx::reflect::json::serialize(*errorResponse)};
         NX_DEBUG(this, "Error processing received message: " + r);
@@ -207,49 +240,84 @@ void WebSocketConnection::readHandler(const nx::Buffer& buffer)
     }
 }
 
-void WebSocketConnection::processRequest(rapidjson::Document data)
+void WebSocketConnection::processRequest(std::shared_ptr<rapidjson::Document> data)
 {
     m_queuedRequests.push(std::move(data));
-    if (m_queuedRequests.size() == 1)
-        processQueuedRequest();
+    processQueuedRequests();
 }
 
-void WebSocketConnection::processQueuedRequest()
+void WebSocketConnection::processQueuedRequests()
 {
-    m_incomingProcessor->processRequest(std::move(m_queuedRequests.front()),
-        [self = m_self](std::string response)
-        {
-            if (auto lock = self.lock())
+    while (!m_queuedRequests.empty() && m_requestsInProgress < m_maxConcurrentRequests)
+    {
+        auto data = std::move(m_queuedRequests.front());
+        m_queuedRequests.pop();
+        ++m_requestsInProgress;
+        m_incomingProcessor->processRequest(std::move(data),
+            [self = m_self](std::string response)
             {
-                if (!response.empty())
-                    lock->send(std::move(response));
-                lock->m_queuedRequests.pop();
-                if (!lock->m_queuedRequests.empty())
-                    lock->processQueuedRequest();
-            }
-        });
+                if (auto lock = self.lock())
+                {
+                    if (!response.empty())
+                        lock->send(std::move(response));
+                    --lock->m_requestsInProgress;
+                    lock->processQueuedRequests();
+                }
+            });
+    }
+}
+
+void WebSocketConnection::send(std::string data, bool isNotification)
+{
+    m_outgoingQueue->push(std::move(data), isNotification);
+    if (!m_sendInProgress)
+        sendNextFrame();
 }
 
-void WebSocketConnection::send(std::string data)
+void WebSocketConnection::sendNextFrame()
 {
-    auto buffer = std::make_unique<nx::Buffer>(std::move(data));
+    if (auto shared = m_outgoingQueue->popShared())
+    {
+        m_sendInProgress = true;
+        logMessage("send to", m_address, shared->payload);
+        m_socket->sendAsync(std::move(shared),
+            [self = m_self](auto errorCode, auto /*bytesTransferred*/)
+            {
+                if (auto lock = self.lock())
+                    lock->onFrameSent(errorCode);
+            });
+        return;
+    }
+
+    // Messages queued while the previous frame is being sent go in the next one, so the
+    // notifications between them are coalesced into a batch.
+    auto frame = m_outgoingQueue->pop();
+    m_sendInProgress = (bool) frame;
+    if (!frame)
+        return;
+
+    auto buffer = std::make_unique<nx::Buffer>(std::move(*frame));
     auto bufferPtr = buffer.get();
     logMessage("send to", m_address, *bufferPtr);
     m_socket->sendAsync(bufferPtr,
         [self = m_self, buffer = std::move(buffer)](auto errorCode, auto /*bytesTransferred*/)
         {
-            if (errorCode == SystemError::noError)
-                return;
-
             if (auto lock = self.lock())
-            {
-                NX_DEBUG(lock.get(), "Failed to send message with error code %1", errorCode);
-                lock->m_outgoingProcessor->clear(errorCode);
-                nx::utils::moveAndCallOptional(lock->m_onDone, errorCode, lock.get());
-            }
+                lock->onFrameSent(errorCode);
         });
 }
 
+void WebSocketConnection::onFrameSent(SystemError::ErrorCode errorCode)
+{
+    if (errorCode == SystemError::noError)
+        return sendNextFrame();
+
+    NX_DEBUG(this, "Failed to send message with error code %1", errorCode);
+    m_outgoingQueue->clear();
+    m_outgoingProcessor->clear(errorCode);
+    nx::utils::moveAndCallOptional(m_onDone, errorCode, this);
+}
+
 void WebSocketConnection::addGuard(const QString& id, nx::utils::Guard guard)
 {
     if (!NX_ASSERT(guard))
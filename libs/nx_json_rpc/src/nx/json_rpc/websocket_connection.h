@@ -10,12 +10,19 @@
 
 #include "messages.h"
 
-namespace nx::network::websocket { class WebSocket; }
+namespace nx::network::websocket {
+class WebSocket;
+struct SharedMessage;
+} // namespace nx::network::websocket
 
 namespace nx::json_rpc {
 
 class IncomingProcessor;
-namespace detail { class OutgoingProcessor; }
+namespace detail {
+class OutgoingProcessor;
+class OutgoingQueue;
+class ParseArena;
+} // namespace detail
 
 class NX_JSON_RPC_API WebSocketConnection: public nx::network::aio::BasicPollable
 {
@@ -30,6 +37,22 @@ public:
     virtual ~WebSocketConnection() override;
     virtual void bindToAioThread(nx::network::aio::AbstractAioThread* aioThread) override;
 
+    /**
+     * Number of the incoming requests handled concurrently. The responses are sent as soon as
+     * they are ready, so they can go out of order, and the peer matches them by id. The default
+     * value 1 handles the requests one by one in the order of arrival.
+     * NOTE: Must be invoked before start.
+     */
+    void setMaxConcurrentRequests(int value);
+
+    /**
+     * Maximum number of the notifications queued back to back which are sent as a single batch
+     * frame (a JSON array). The peer must accept the batches then. The default value 1 sends
+     * every message in its own frame.
+     * NOTE: Must be invoked before start.
+     */
+    void setMaxNotificationBatchSize(int value);
+
     void start(std::weak_ptr<WebSocketConnection> self, RequestHandler requestHandler = {});
     void send(
         Request request,
@@ -41,6 +64,12 @@ public:
     void send(std::vector<Request> jsonRpcRequests,
         BatchResponseHandler handler = nullptr);
 
+    /**
+     * Sends the notification serialized once for many connections, see
+     * WebSocketConnections::broadcast().
+     */
+    void send(std::shared_ptr<const nx::network::websocket::SharedMessage> notification);
+
     void addGuard(const QString& id, nx::utils::Guard guard);
     void removeGuard(const QString& id);
 
@@ -48,9 +77,11 @@ private:
     virtual void stopWhileInAioThread() override;
     void readNextMessage();
     void readHandler(const nx::Buffer& buffer);
-    void processRequest(rapidjson::Document data);
-    void processQueuedRequest();
-    void send(std::string data);
+    void processRequest(std::shared_ptr<rapidjson::Document> data);
+    void processQueuedRequests();
+    void send(std::string data, bool isNotification = false);
+    void sendNextFrame();
+    void onFrameSent(SystemError::ErrorCode errorCode);
 
 private:
     std::weak_ptr<WebSocketConnection> m_self;
@@ -58,7 +89,12 @@ private:
     nx::network::SocketAddress m_address;
     std::unique_ptr<IncomingProcessor> m_incomingProcessor;
     std::unique_ptr<detail::OutgoingProcessor> m_outgoingProcessor;
-    std::queue<rapidjson::Document> m_queuedRequests;
+    std::unique_ptr<detail::ParseArena> m_parseArena;
+    std::queue<std::shared_ptr<rapidjson::Document>> m_queuedRequests;
+    int m_maxConcurrentRequests = 1;
+    int m_requestsInProgress = 0;
+    std::unique_ptr<detail::OutgoingQueue> m_outgoingQueue;
+    bool m_sendInProgress = false;
     std::unique_ptr<nx::network::websocket::WebSocket> m_socket;
     std::unordered_map<QString, nx::utils::Guard> m_guards;
 };
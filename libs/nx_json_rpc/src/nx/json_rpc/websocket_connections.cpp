@@ -119,6 +119,7 @@ void WebSocketConnections::removeConnection(WebSocketConnection* connection)
         NX_MUTEX_LOCKER lock(&m_mutex);
         if (auto it = m_connections.find(connection); it != m_connections.end())
         {
+            unsubscribeAll(it->second, connection);
             holder = std::move(it->second);
             m_connections.erase(it);
         }
@@ -144,12 +145,110 @@ std::size_t WebSocketConnections::count() const
     return m_connections.size();
 }
 
+void WebSocketConnections::setSubjectGroup(
+    WebSocketConnection* connection, std::string subjectGroup)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (auto it = m_connections.find(connection); it != m_connections.end())
+        it->second.subjectGroup = std::move(subjectGroup);
+}
+
+void WebSocketConnections::subscribe(WebSocketConnection* connection, const std::string& topic)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (auto it = m_connections.find(connection); it != m_connections.end())
+    {
+        it->second.topics.insert(topic);
+        m_subscribers[topic].insert(connection);
+    }
+}
+
+void WebSocketConnections::unsubscribe(WebSocketConnection* connection, const std::string& topic)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (auto it = m_connections.find(connection); it != m_connections.end())
+        it->second.topics.erase(topic);
+
+    if (auto it = m_subscribers.find(topic); it != m_subscribers.end())
+    {
+        it->second.erase(connection);
+        if (it->second.empty())
+            m_subscribers.erase(it);
+    }
+}
+
+void WebSocketConnections::unsubscribeAll(
+    const Connection& connection, WebSocketConnection* connectionPtr)
+{
+    for (const auto& topic: connection.topics)
+    {
+        if (auto it = m_subscribers.find(topic); it != m_subscribers.end())
+        {
+            it->second.erase(connectionPtr);
+            if (it->second.empty())
+                m_subscribers.erase(it);
+        }
+    }
+}
+
+WebSocketConnections::SubscribersByGroup WebSocketConnections::subscribersByGroup(
+    const std::string& topic) const
+{
+    SubscribersByGroup result;
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    auto subscribers = m_subscribers.find(topic);
+    if (subscribers == m_subscribers.end())
+        return result;
+
+    for (auto connection: subscribers->second)
+    {
+        if (auto it = m_connections.find(connection); it != m_connections.end())
+            result[it->second.subjectGroup].push_back(it->second.connection);
+    }
+    return result;
+}
+
+void WebSocketConnections::broadcast(const std::string& topic, NotificationFilter filter)
+{
+    for (const auto& [subjectGroup, connections]: subscribersByGroup(topic))
+    {
+        const auto notification = filter(subjectGroup);
+        if (!notification)
+            continue;
+
+        NX_VERBOSE(this, "Broadcast %1 of %2 to %3 connection(s) of group `%4`",
+            notification->method, topic, connections.size(), subjectGroup);
+        const auto message = nx::network::websocket::SharedMessage::create(
+            nx::reflect::json::serialize(*notification), nx::network::websocket::FrameType::text);
+        for (const auto& connection: connections)
+            connection->send(message);
+    }
+}
+
+void WebSocketConnections::broadcast(const std::string& topic, Request notification)
+{
+    const auto subscribers = subscribersByGroup(topic);
+    if (subscribers.empty())
+        return;
+
+    NX_VERBOSE(this, "Broadcast %1 of %2 to %3 group(s)",
+        notification.method, topic, subscribers.size());
+    const auto message = nx::network::websocket::SharedMessage::create(
+        nx::reflect::json::serialize(notification), nx::network::websocket::FrameType::text);
+    for (const auto& [_, connections]: subscribers)
+    {
+        for (const auto& connection: connections)
+            connection->send(message);
+    }
+}
+
 void WebSocketConnections::clear()
 {
     std::unordered_map<WebSocketConnection*, Connection> connections;
     {
         NX_MUTEX_LOCKER lock(&m_mutex);
         m_connections.swap(connections);
+        m_subscribers.clear();
     }
     for (auto& [_, connection]: connections)
         connection.stop();
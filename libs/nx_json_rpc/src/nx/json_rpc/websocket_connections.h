@@ -4,8 +4,13 @@
 
 #include <any>
 #include <list>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <nx/utils/move_only_func.h>
@@ -53,12 +58,42 @@ public:
 
     std::size_t count() const;
 
+    /**
+     * Connections of the same subject group have the same access rights, e.g. the users of the
+     * same permission groups, so a notification filtered for the group suits all of them. A
+     * connection is in the empty group until this is called.
+     */
+    void setSubjectGroup(WebSocketConnection* connection, std::string subjectGroup);
+
+    void subscribe(WebSocketConnection* connection, const std::string& topic);
+    void unsubscribe(WebSocketConnection* connection, const std::string& topic);
+
+    /**
+     * Produces the notification the subject group is allowed to see, std::nullopt to send
+     * nothing to the group.
+     */
+    using NotificationFilter =
+        nx::utils::MoveOnlyFunc<std::optional<Request>(const std::string& subjectGroup)>;
+
+    /**
+     * Sends the notification to all subscribers of the topic. The filter is called and the
+     * notification is serialized into a websocket frame, both plain and compressed, once per
+     * subject group. Every subscriber of the group is queued the same frame.
+     * NOTE: The filter is called without the internal mutex locked.
+     */
+    void broadcast(const std::string& topic, NotificationFilter filter);
+
+    /** Sends the same notification to all subscribers of the topic. */
+    void broadcast(const std::string& topic, Request notification);
+
 private:
     struct Connection
     {
         std::shared_ptr<WebSocketConnection> connection;
         std::vector<nx::utils::Guard> guards;
         std::list<std::thread> threads;
+        std::string subjectGroup;
+        std::set<std::string> topics;
 
         void stop();
     };
@@ -69,10 +104,17 @@ private:
         std::unique_ptr<Executor> executor,
         nx::utils::MoveOnlyFunc<void(Response)> handler);
 
+    void unsubscribeAll(const Connection& connection, WebSocketConnection* connectionPtr);
+
+    using SubscribersByGroup =
+        std::map<std::string, std::vector<std::shared_ptr<WebSocketConnection>>>;
+    SubscribersByGroup subscribersByGroup(const std::string& topic) const;
+
 private:
     mutable nx::Mutex m_mutex;
     std::vector<std::unique_ptr<ExecutorCreator>> m_executorCreators;
     std::unordered_map<WebSocketConnection*, Connection> m_connections;
+    std::unordered_map<std::string, std::unordered_set<WebSocketConnection*>> m_subscribers;
 };
 
 } // namespace nx::json_rpc
@@ -18,7 +18,7 @@ TEST(OutgoingProcessor, batchRequest)
     auto responseJson{nx::json::serialized(responses, /*stripDefault*/ false)};
 
     detail::OutgoingProcessor processor(
-        [](auto value)
+        [](auto value, bool /*isNotification*/)
         {
             ASSERT_EQ(value,
                 "[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"method1\",\"params\":{}},"
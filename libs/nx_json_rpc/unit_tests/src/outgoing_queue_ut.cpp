@@ -0,0 +1,67 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/json_rpc/detail/outgoing_queue.h>
+#include <nx/network/websocket/websocket_serializer.h>
+
+namespace nx::json_rpc::test {
+
+TEST(OutgoingQueue, notifications_are_not_coalesced_by_default)
+{
+    detail::OutgoingQueue queue;
+    queue.push("{\"method\":\"a\"}", /*isNotification*/ true);
+    queue.push("{\"method\":\"b\"}", /*isNotification*/ true);
+
+    ASSERT_EQ("{\"method\":\"a\"}", queue.pop());
+    ASSERT_EQ("{\"method\":\"b\"}", queue.pop());
+    ASSERT_EQ(std::nullopt, queue.pop());
+}
+
+TEST(OutgoingQueue, consecutive_notifications_are_coalesced)
+{
+    detail::OutgoingQueue queue(/*maxBatchSize*/ 100);
+    queue.push("{\"id\":1}", /*isNotification*/ false);
+    queue.push("{\"method\":\"a\"}", /*isNotification*/ true);
+    queue.push("{\"method\":\"b\"}", /*isNotification*/ true);
+    queue.push("{\"id\":2}", /*isNotification*/ false);
+    queue.push("{\"method\":\"c\"}", /*isNotification*/ true);
+
+    ASSERT_EQ("{\"id\":1}", queue.pop());
+    ASSERT_EQ("[{\"method\":\"a\"},{\"method\":\"b\"}]", queue.pop());
+    ASSERT_EQ("{\"id\":2}", queue.pop());
+    ASSERT_EQ("{\"method\":\"c\"}", queue.pop());
+    ASSERT_EQ(std::nullopt, queue.pop());
+}
+
+TEST(OutgoingQueue, batch_size_is_limited)
+{
+    detail::OutgoingQueue queue(/*maxBatchSize*/ 2);
+    for (const char* method: {"a", "b", "c"})
+        queue.push(std::string("{\"method\":\"") + method + "\"}", /*isNotification*/ true);
+
+    ASSERT_EQ("[{\"method\":\"a\"},{\"method\":\"b\"}]", queue.pop());
+    ASSERT_EQ("{\"method\":\"c\"}", queue.pop());
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(OutgoingQueue, shared_messages_are_not_coalesced)
+{
+    using namespace nx::network::websocket;
+    const auto shared = SharedMessage::create("{\"method\":\"b\"}", FrameType::text);
+
+    detail::OutgoingQueue queue(/*maxBatchSize*/ 100);
+    queue.push("{\"method\":\"a\"}", /*isNotification*/ true);
+    queue.push(shared);
+    queue.push("{\"method\":\"c\"}", /*isNotification*/ true);
+
+    ASSERT_EQ(nullptr, queue.popShared());
+    ASSERT_EQ("{\"method\":\"a\"}", queue.pop());
+    ASSERT_EQ(std::nullopt, queue.pop());
+    ASSERT_EQ(shared, queue.popShared());
+    ASSERT_EQ(nullptr, queue.popShared());
+    ASSERT_EQ("{\"method\":\"c\"}", queue.pop());
+    ASSERT_TRUE(queue.empty());
+}
+
+} // namespace nx::json_rpc::test
@@ -0,0 +1,50 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <nx/json_rpc/detail/parse_arena.h>
+
+namespace nx::json_rpc::test {
+
+TEST(ParseArena, arena_is_reused_after_document_is_released)
+{
+    detail::ParseArena arena(/*arenaSize*/ 1024, /*maxPooledArenas*/ 1);
+    ASSERT_EQ(0, arena.pooledArenaCount());
+
+    auto first = arena.parse(R"({"jsonrpc":"2.0","method":"a","params":{"x":1}})");
+    ASSERT_FALSE(first->HasParseError());
+    ASSERT_EQ(std::string("a"), (*first)["method"].GetString());
+
+    // Larger than the arena, so more chunks are allocated on top of it.
+    auto second = arena.parse("[" + std::string(4096, ' ') + R"("b", "c"])");
+    ASSERT_FALSE(second->HasParseError());
+    ASSERT_EQ(2, (int) second->Size());
+
+    first.reset();
+    second.reset();
+    ASSERT_EQ(1, arena.pooledArenaCount());
+
+    auto third = arena.parse(R"({"method":"d"})");
+    ASSERT_EQ(0, arena.pooledArenaCount());
+    ASSERT_EQ(std::string("d"), (*third)["method"].GetString());
+}
+
+TEST(ParseArena, document_outlives_arena)
+{
+    std::shared_ptr<rapidjson::Document> document;
+    {
+        detail::ParseArena arena;
+        document = arena.parse(R"({"method":"a"})");
+    }
+    ASSERT_EQ(std::string("a"), (*document)["method"].GetString());
+}
+
+TEST(ParseArena, parse_error_is_reported)
+{
+    detail::ParseArena arena;
+    ASSERT_TRUE(arena.parse("{\"method\":")->HasParseError());
+}
+
+} // namespace nx::json_rpc::test
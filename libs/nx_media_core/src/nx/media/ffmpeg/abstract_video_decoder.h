@@ -18,6 +18,18 @@ struct DecoderConfig
     MultiThreadDecodePolicy mtDecodePolicy = MultiThreadDecodePolicy::autoDetect;
     bool forceGrayscaleDecoding = false; //< Force grayscale decoding if true. Don't change current value if false.
     bool forceRgbaFormat = false; //< Forces YUV -> RGB conversion on decoder thread.
+
+    /**
+     * Decodes the key frames only, without the loop filter: the mode for the thumbnails and
+     * previews, which do not need the exact picture.
+     */
+    bool keyFramesOnly = false;
+
+    /**
+     * If positive, the codecs which support the reduced resolution decoding (e.g. MJPEG) output
+     * the smallest picture, the larger side of which is not less than this value.
+     */
+    int minOutputSize = 0;
 };
 
 //!Abstract interface. Every video decoder MUST implement this interface.
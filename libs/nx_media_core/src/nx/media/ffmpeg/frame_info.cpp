@@ -90,23 +90,24 @@ bool CLVideoDecoderOutput::isEmpty() const
         (m_memoryType == MemoryType::VideoMemory && !m_surface);
 }
 
-static bool convertImageFormat(
-    int width,
-    int height,
+static bool scaleImage(
+    const QSize& sourceSize,
     const uint8_t* const sourceSlice[],
     const int sourceStride[],
     AVPixelFormat sourceFormat,
+    const QSize& targetSize,
     uint8_t* const targetSlice[],
     const int targetStride[],
     AVPixelFormat targetFormat,
     const nx::log::Tag& logTag)
 {
     if (const auto context = sws_getContext(
-        width, height, sourceFormat,
-        width, height, targetFormat,
+        sourceSize.width(), sourceSize.height(), sourceFormat,
+        targetSize.width(), targetSize.height(), targetFormat,
         SWS_BILINEAR, /*srcFilter*/ nullptr, /*dstFilter*/ nullptr, /*param*/nullptr))
     {
-        sws_scale(context, sourceSlice, sourceStride, 0, height, targetSlice, targetStride);
+        sws_scale(context, sourceSlice, sourceStride, 0, sourceSize.height(),
+            targetSlice, targetStride);
         sws_freeContext(context);
         return true;
     }
@@ -116,6 +117,21 @@ static bool convertImageFormat(
     return false;
 }
 
+static bool convertImageFormat(
+    int width,
+    int height,
+    const uint8_t* const sourceSlice[],
+    const int sourceStride[],
+    AVPixelFormat sourceFormat,
+    uint8_t* const targetSlice[],
+    const int targetStride[],
+    AVPixelFormat targetFormat,
+    const nx::log::Tag& logTag)
+{
+    return scaleImage(QSize(width, height), sourceSlice, sourceStride, sourceFormat,
+        QSize(width, height), targetSlice, targetStride, targetFormat, logTag);
+}
+
 void CLVideoDecoderOutput::attachVideoSurface(std::unique_ptr<AbstractVideoSurface> surface)
 {
     m_memoryType = MemoryType::VideoMemory;
@@ -403,19 +419,24 @@ QByteArray CLVideoDecoderOutput::rawData() const
 
 QImage CLVideoDecoderOutput::toImage() const
 {
-    if (width == 0 || height == 0)
+    return toImage(size());
+}
+
+QImage CLVideoDecoderOutput::toImage(const QSize& targetSize) const
+{
+    if (width == 0 || height == 0 || targetSize.isEmpty())
         return {};
 
-    CLVideoDecoderOutput target(width, height, AV_PIX_FMT_RGB32);
+    CLVideoDecoderOutput target(targetSize.width(), targetSize.height(), AV_PIX_FMT_RGB32);
 
-    if (!convertImageFormat(width, height, data, linesize, static_cast<AVPixelFormat>(format),
-        target.data, target.linesize, AV_PIX_FMT_RGB32, /*logTag*/ this))
+    if (!scaleImage(size(), data, linesize, static_cast<AVPixelFormat>(format),
+        targetSize, target.data, target.linesize, AV_PIX_FMT_RGB32, /*logTag*/ this))
     {
         return {};
     }
 
-    QImage result(target.data[0], width, height, target.linesize[0], QImage::Format_RGB32,
-        av_free, target.data[0]);
+    QImage result(target.data[0], targetSize.width(), targetSize.height(), target.linesize[0],
+        QImage::Format_RGB32, av_free, target.data[0]);
 
     target.data[0] = nullptr;
 
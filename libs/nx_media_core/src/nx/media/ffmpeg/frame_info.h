@@ -69,6 +69,12 @@ public:
     AbstractVideoSurface* getVideoSurface() const { return m_surface.get(); }
 
     QImage toImage() const;
+
+    /**
+     * Converts the frame to the RGB image of the given size: the scaling is done in the same pass
+     * as the color conversion.
+     */
+    QImage toImage(const QSize& targetSize) const;
     CLVideoDecoderOutputPtr toSystemMemory();
 
     /**
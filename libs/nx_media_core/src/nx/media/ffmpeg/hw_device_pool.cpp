@@ -0,0 +1,59 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "hw_device_pool.h"
+
+#include <nx/media/ffmpeg/ffmpeg_utils.h>
+#include <nx/utils/log/log.h>
+
+namespace nx::media::ffmpeg {
+
+HwDevicePool::~HwDevicePool()
+{
+    clear();
+}
+
+AVBufferRef* HwDevicePool::acquire(AVHWDeviceType type, const std::string& device)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    auto& entry = m_devices[{type, device}];
+    if (entry.context)
+        return av_buffer_ref(entry.context);
+
+    const auto now = std::chrono::steady_clock::now();
+    if (entry.failureTime != std::chrono::steady_clock::time_point()
+        && now - entry.failureTime < kRetryTimeout)
+    {
+        return nullptr;
+    }
+
+    const int status = av_hwdevice_ctx_create(
+        &entry.context, type, device.empty() ? nullptr : device.c_str(), nullptr, 0);
+    if (status < 0)
+    {
+        NX_DEBUG(this, "Failed to create HW device %1 (%2): %3",
+            av_hwdevice_get_type_name(type), device, avErrorToString(status));
+        entry.context = nullptr;
+        entry.failureTime = now;
+        return nullptr;
+    }
+
+    NX_DEBUG(this, "Created HW device %1 (%2)", av_hwdevice_get_type_name(type), device);
+    return av_buffer_ref(entry.context);
+}
+
+void HwDevicePool::clear()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    for (auto& [key, entry]: m_devices)
+        av_buffer_unref(&entry.context);
+    m_devices.clear();
+}
+
+HwDevicePool& HwDevicePool::instance()
+{
+    // Never destroyed: the decoders owned by the other static objects may use it until the exit.
+    static const auto pool = new HwDevicePool();
+    return *pool;
+}
+
+} // namespace nx::media::ffmpeg
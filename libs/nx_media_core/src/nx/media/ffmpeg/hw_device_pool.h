@@ -0,0 +1,59 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <nx/utils/thread/mutex.h>
+
+extern "C" {
+#include <libavutil/hwcontext.h>
+} // extern "C"
+
+namespace nx::media::ffmpeg {
+
+/**
+ * Process-wide pool of the FFmpeg hardware device contexts. Opening a device is expensive, and the
+ * decoders and encoders that share a device context can pass the frames to each other without
+ * copying them to the system memory. A device that failed to open is not probed again during
+ * kRetryTimeout, so the sessions on a host without the GPU fall back to the software quickly.
+ */
+class NX_MEDIA_CORE_API HwDevicePool
+{
+public:
+    static constexpr std::chrono::minutes kRetryTimeout{1};
+
+    HwDevicePool() = default;
+    ~HwDevicePool();
+
+    HwDevicePool(const HwDevicePool&) = delete;
+    HwDevicePool& operator=(const HwDevicePool&) = delete;
+
+    /**
+     * @param device Device name in the av_hwdevice_ctx_create() format, the default device if
+     *     empty.
+     * @return New reference to the device context, to be released with av_buffer_unref(). Null if
+     *     the device is not available.
+     */
+    AVBufferRef* acquire(AVHWDeviceType type, const std::string& device = {});
+
+    /** Releases the pooled devices and forgets the failed ones. */
+    void clear();
+
+    static HwDevicePool& instance();
+
+private:
+    struct Device
+    {
+        AVBufferRef* context = nullptr;
+        std::chrono::steady_clock::time_point failureTime;
+    };
+
+    nx::Mutex m_mutex;
+    std::map<std::pair<AVHWDeviceType, std::string>, Device> m_devices;
+};
+
+} // namespace nx::media::ffmpeg
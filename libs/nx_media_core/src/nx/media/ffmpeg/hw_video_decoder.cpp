@@ -3,6 +3,7 @@
 #include "hw_video_decoder.h"
 
 #include <nx/media/ffmpeg/ffmpeg_utils.h>
+#include <nx/media/ffmpeg/hw_device_pool.h>
 #include <nx/metric/metrics_storage.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/scope_guard.h>
@@ -197,17 +198,25 @@ bool HwVideoDecoder::initializeHardware(const QnConstCompressedVideoDataPtr& dat
             return false;
         }
     }
-    else
+    else if (m_options)
     {
         const char* hwDevice = m_device.empty() ? nullptr : m_device.c_str();
-        AVDictionary* options = m_options ? m_options->get() : nullptr;
-        if ((status = av_hwdevice_ctx_create(&m_hwDeviceContext, m_type, hwDevice, options, 0)) < 0)
+        if ((status = av_hwdevice_ctx_create(
+            &m_hwDeviceContext, m_type, hwDevice, m_options->get(), 0)) < 0)
         {
             NX_DEBUG(this, "Failed to create HW device context %1", avErrorToString(status));
             return false;
         }
         m_decoderContext->hw_device_ctx = av_buffer_ref(m_hwDeviceContext);
     }
+    else
+    {
+        // The device is shared with the other decoders and with the hardware encoders.
+        m_hwDeviceContext = HwDevicePool::instance().acquire(m_type, m_device);
+        if (!m_hwDeviceContext)
+            return false;
+        m_decoderContext->hw_device_ctx = av_buffer_ref(m_hwDeviceContext);
+    }
 
     if ((status = avcodec_open2(m_decoderContext, decoder, NULL)) < 0)
     {
@@ -287,7 +296,18 @@ int64_t HwVideoDecoder::frameNum() const
     if (!m_decoderContext)
         return 0;
 
-    return std::max<int64_t>(0, m_decoderContext->frame_num - 1);
+    return std::max<int64_t>(0, m_decoderContext->frame_num - 1 - m_frameNumOffset);
+}
+
+bool HwVideoDecoder::flush()
+{
+    if (!m_decoderContext)
+        return false;
+
+    avcodec_flush_buffers(m_decoderContext);
+    m_frameNumOffset = m_decoderContext->frame_num;
+    m_lastDecodeResult = 0;
+    return true;
 }
 
 bool HwVideoDecoder::resetDecoder(const QnConstCompressedVideoDataPtr& data)
@@ -300,6 +320,7 @@ bool HwVideoDecoder::resetDecoder(const QnConstCompressedVideoDataPtr& data)
 
     m_targetPixelFormat = AV_PIX_FMT_NONE;
     m_lastDecodeResult = 0;
+    m_frameNumOffset = 0;
 
     if (data)
         return initialize(data);
@@ -45,8 +45,16 @@ public:
 
     AVPixelFormat getPixelFormat() { return m_targetPixelFormat; }
 
+    /** Number of the frame decoded last, counted from the last flush(). */
     int64_t frameNum() const;
 
+    /**
+     * Discards the buffered frames and the end of stream state, keeping the hardware session, so
+     * the decoder can take a new stream of the same codec.
+     * @return False if the decoder is not initialized.
+     */
+    bool flush();
+
 private:
     bool initialize(const QnConstCompressedVideoDataPtr& frame);
     bool initializeHardware(const QnConstCompressedVideoDataPtr& frame);
@@ -64,6 +72,7 @@ private:
     std::unique_ptr<AvOptions> m_options = nullptr;
     nx::metric::Storage* m_metrics = nullptr;
     quint32 m_lastChannel = 0;
+    int64_t m_frameNumOffset = 0;
 };
 
 } // namespace nx::media::ffmpeg
@@ -0,0 +1,95 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "video_frame_pool.h"
+
+#include <vector>
+
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::media::ffmpeg {
+
+struct VideoFramePool::Data
+{
+    const int maxFreeFrames;
+    mutable nx::Mutex mutex;
+    std::vector<std::unique_ptr<CLVideoDecoderOutput>> freeFrames;
+
+    Data(int maxFreeFrames): maxFreeFrames(maxFreeFrames) {}
+
+    void release(CLVideoDecoderOutput* frame)
+    {
+        std::unique_ptr<CLVideoDecoderOutput> holder(frame);
+
+        // The frame could be turned into a view or a video memory frame by its last user.
+        if (frame->isExternalData() || !frame->data[0] || frame->buf[0]
+            || frame->memoryType() != MemoryType::SystemMemory)
+        {
+            return;
+        }
+
+        NX_MUTEX_LOCKER lock(&mutex);
+        if ((int) freeFrames.size() < maxFreeFrames)
+            freeFrames.push_back(std::move(holder));
+    }
+};
+
+VideoFramePool::VideoFramePool(int maxFreeFrames):
+    m_data(std::make_shared<Data>(maxFreeFrames))
+{
+}
+
+VideoFramePool::~VideoFramePool() = default;
+
+CLVideoDecoderOutputPtr VideoFramePool::get(int width, int height, AVPixelFormat format)
+{
+    std::unique_ptr<CLVideoDecoderOutput> frame;
+    {
+        NX_MUTEX_LOCKER lock(&m_data->mutex);
+        auto& freeFrames = m_data->freeFrames;
+        while (!freeFrames.empty() && !frame)
+        {
+            frame = std::move(freeFrames.back());
+            freeFrames.pop_back();
+
+            // The frames of the other size are left from the previous stream parameters.
+            if (frame->width != width || frame->height != height || frame->format != format)
+                frame.reset();
+        }
+    }
+
+    if (frame)
+    {
+        frame->pict_type = AV_PICTURE_TYPE_NONE;
+        frame->scaleFactor = 1;
+    }
+    else
+    {
+        frame = std::make_unique<CLVideoDecoderOutput>();
+        if (!frame->reallocate(width, height, format))
+            return CLVideoDecoderOutputPtr();
+    }
+
+    return CLVideoDecoderOutputPtr(frame.release(),
+        [data = std::weak_ptr<Data>(m_data)](CLVideoDecoderOutput* frame)
+        {
+            if (const auto pool = data.lock())
+                pool->release(frame);
+            else
+                delete frame;
+        });
+}
+
+int VideoFramePool::freeFrameCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_data->mutex);
+    return (int) m_data->freeFrames.size();
+}
+
+void VideoFramePool::clear()
+{
+    std::vector<std::unique_ptr<CLVideoDecoderOutput>> freeFrames;
+    NX_MUTEX_LOCKER lock(&m_data->mutex);
+    std::swap(freeFrames, m_data->freeFrames);
+}
+
+} // namespace nx::media::ffmpeg
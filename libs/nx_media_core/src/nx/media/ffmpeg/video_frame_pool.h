@@ -0,0 +1,49 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <memory>
+
+#include <nx/media/ffmpeg/frame_info.h>
+
+namespace nx::media::ffmpeg {
+
+/**
+ * Recycles the system memory frames of the video filters, which produce a new frame for each
+ * input one. Allocating a frame of several megabytes maps the new pages which are faulted in on
+ * the first write, so reusing the frames of the same size and format saves the allocation and
+ * the page faults on each frame. A frame returns to the pool when its last reference is released,
+ * possibly in another thread or after the pool is destroyed.
+ */
+class NX_MEDIA_CORE_API VideoFramePool
+{
+public:
+    explicit VideoFramePool(int maxFreeFrames = 4);
+    ~VideoFramePool();
+
+    VideoFramePool(const VideoFramePool&) = delete;
+    VideoFramePool& operator=(const VideoFramePool&) = delete;
+
+    /**
+     * @return Frame with the allocated but uninitialized pixel data. The frame fields other than
+     *     the size and the format are to be set by the caller, e.g. with assignMiscData(). Null if
+     *     the frame can not be allocated.
+     */
+    CLVideoDecoderOutputPtr get(int width, int height, AVPixelFormat format);
+
+    CLVideoDecoderOutputPtr get(const QSize& size, AVPixelFormat format)
+    {
+        return get(size.width(), size.height(), format);
+    }
+
+    /** Number of the frames which are ready to be reused. */
+    int freeFrameCount() const;
+
+    void clear();
+
+private:
+    struct Data;
+    std::shared_ptr<Data> m_data;
+};
+
+} // namespace nx::media::ffmpeg
@@ -6,6 +6,7 @@
 #include <QtCore/QtEndian>
 #include <QtGui/QRegion>
 
+#include <nx/media/motion_mask.h>
 #include <nx/utils/log/assert.h>
 
 static const QRect kMaxGridRect(0, 0, Qn::kMotionGridWidth, Qn::kMotionGridHeight);
@@ -49,62 +50,9 @@ QnMetaDataV1Ptr QnMetaDataV1::fromLightData(const QnMetaDataV1Light& lightData)
     return result;
 }
 
-#if defined(NX_SSE2_SUPPORTED)
-inline bool sse4_attribute mathImage_sse41(const __m128i* data, const __m128i* mask, int maskStart, int maskEnd)
-{
-    for (int i = maskStart; i <= maskEnd; ++i)
-    {
-        if (_mm_testz_si128_sse4(mask[i], data[i]) == 0) /* SSE4. */
-            return true;
-    }
-    return false;
-}
-
-inline bool mathImage_sse2(const __m128i* data, const __m128i* mask, int maskStart, int maskEnd)
-{
-    static const __m128i zerroValue = _mm_setr_epi32(0, 0, 0, 0);
-    for (int i = maskStart; i <= maskEnd; ++i)
-    {
-        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(mask[i], data[i]), zerroValue)) != 0xffff) /* SSE2. */
-            return true;
-    }
-    return false;
-}
-#endif //__i386
-
-inline bool mathImage_cpu(const quint64* data, const simd128i* mask, int maskStart, int maskEnd)
-{
-    uint64_t* curPtr = (uint64_t*) data;
-    curPtr += maskStart*2;
-    uint64_t* maskPtr = (uint64_t*) mask;
-    maskPtr += maskStart*2;
-
-    for (int i = maskStart; i <= maskEnd; ++i)
-    {
-        if (*curPtr++ & *maskPtr++)
-            return true;
-        if (*curPtr++ & *maskPtr++)
-            return true;
-    }
-    return false;
-}
-
 bool QnMetaDataV1::matchImage(const quint64* data, const simd128i* mask, int maskStart, int maskEnd)
 {
-    if (uintptr_t (data) % 16)
-        return mathImage_cpu(data, mask, maskStart, maskEnd);
-
-    #if defined(NX_SSE2_SUPPORTED)
-        if (useSSE41())
-            return mathImage_sse41((const simd128i*) data, mask, maskStart, maskEnd);
-        else
-            return mathImage_sse2((const simd128i*) data, mask, maskStart, maskEnd);
-    #elif defined(__arm__) && defined(__ARM_NEON)
-        // TODO: ARM.
-        return mathImage_cpu(data, mask, maskStart, maskEnd);
-    #else
-        return mathImage_cpu(data, mask, maskStart, maskEnd);
-    #endif
+    return nx::media::motion_mask::intersects(data, mask, maskStart, maskEnd);
 }
 
 void QnMetaDataV1::assign(const QnMetaDataV1* other)
@@ -149,65 +97,7 @@ void QnMetaDataV1::addMotion(QnMetaDataV1Ptr data)
 
 void QnMetaDataV1::removeMotion(const simd128i* image)
 {
-    const int endIndex = Qn::kMotionGridWidth*Qn::kMotionGridHeight / 128 - 1;
-#if defined(NX_SSE2_SUPPORTED)
-    __m128i* dst = (__m128i*) m_data.data();
-    __m128i* src = (__m128i*) image;
-    for (int i = 0; i <= endIndex; ++i)
-    {
-        *dst = _mm_andnot_si128(*src, *dst); /* SSE2. */
-        dst++;
-        src++;
-    }
-#else
-    // remove without SIMD
-    int64_t* dst = (int64_t*) m_data.data();
-    int64_t* src = (int64_t*) image;
-    for (int i = 0; i <= endIndex; ++i)
-    {
-        *dst &= ~(*src);
-        ++dst;
-        ++src;
-        *dst &= ~(*src);
-        ++dst;
-        ++src;
-    }
-#endif
-}
-
-#if defined(NX_SSE2_SUPPORTED)
-inline bool metadataIsEmpty_sse2(__m128i* src)
-{
-    static const __m128i zerroValue = _mm_setr_epi32(0, 0, 0, 0); /* SSE2. */
-    for (int i = 0; i < Qn::kMotionGridWidth*Qn::kMotionGridHeight/128; ++i)
-    {
-        if (_mm_movemask_epi8(_mm_cmpeq_epi32(src[i], zerroValue)) != 0xffff) /* SSE2. */
-            return false;
-    }
-    return true;
-}
-
-inline bool sse4_attribute metadataIsEmpty_sse41(__m128i* src)
-{
-    static const __m128i ff_mask = _mm_setr_epi32(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff); /* SSE2. */
-    for (int i = 0; i < Qn::kMotionGridWidth*Qn::kMotionGridHeight/128; ++i)
-    {
-        if (_mm_testz_si128_sse4(src[i], ff_mask) == 0) /* SSE4. */
-            return false;
-    }
-    return true;
-}
-#endif
-
-inline bool metadataIsEmpty_cpu(const char* data)
-{
-    const quint32* curPtr = (const quint32*) data;
-    for (size_t i = 0; i < Qn::kMotionGridWidth*Qn::kMotionGridHeight/sizeof(quint32)/CHAR_BIT; ++i)
-    {
-        if (*curPtr++)
-            return false;
-    }
-    return true;
+    nx::media::motion_mask::subtract(m_data.data(), image);
 }
 
 void QnMetaDataV1Light::doMarshalling()
@@ -218,17 +108,7 @@ void QnMetaDataV1Light::doMarshalling()
 
 bool QnMetaDataV1::isEmpty() const
 {
-    #if defined(NX_SSE2_SUPPORTED)
-        if (useSSE41())
-            return metadataIsEmpty_sse41((__m128i*) m_data.data());
-        else
-            return metadataIsEmpty_sse2((__m128i*) m_data.data());
-    #elif defined(__arm__) && defined(__ARM_NEON)
-        // TODO: ARM.
-        return metadataIsEmpty_cpu(m_data.data());
-    #else
-        return metadataIsEmpty_cpu(m_data.data());
-    #endif
+    return nx::media::motion_mask::isEmpty(m_data.data());
 }
 
 void QnMetaDataV1::assign( const void* data, qint64 timestamp, qint64 duration )
@@ -253,28 +133,7 @@ void QnMetaDataV1::addMotion(const quint8* image, qint64 timestamp)
 
 void QnMetaDataV1::addMotion(quint64* dst64, const quint64* src64)
 {
-#if defined(NX_SSE2_SUPPORTED)
-
-    if ((uintptr_t (dst64) % 16 == 0) && (uintptr_t (src64) % 16 == 0))
-    {
-        __m128i* dst = (__m128i*) dst64;
-        __m128i* src = (__m128i*) src64;
-        for (int i = 0; i < Qn::kMotionGridWidth*Qn::kMotionGridHeight / 128; ++i)
-        {
-            *dst = _mm_or_si128(*dst, *src); /* SSE2. */
-            dst++;
-            src++;
-
-        }
-        return;
-    }
-#endif
-    // add without SIMD
-    for (int i = 0; i < Qn::kMotionGridWidth*Qn::kMotionGridHeight / 128; ++i)
-    {
-        *dst64++ |= *src64++;
-        *dst64++ |= *src64++;
-    }
+    nx::media::motion_mask::unite(dst64, src64);
 }
 
 void QnMetaDataV1::addMotion(char* dst, const char* src)
@@ -347,28 +206,7 @@ void QnMetaDataV1::addMotion(char* buffer, const QRect& rect)
 
 QRect QnMetaDataV1::boundingBox(const char* data)
 {
-    int left = Qn::kMotionGridWidth;
-    int right = 0;
-    int top = Qn::kMotionGridHeight;
-    int bottom = 0;
-    bool hasData = false;
-    for (int y = 0; y < Qn::kMotionGridHeight; ++y)
-    {
-        for (int x = 0; x < Qn::kMotionGridWidth; ++x)
-        {
-            if (isMotionAt(x, y, data))
-            {
-                left = std::min(left, x);
-                right = std::max(right, x);
-                top = std::min(top, y);
-                bottom = std::max(bottom, y);
-                hasData = true;
-            }
-        }
-    }
-    if (!hasData)
-        return QRect();
-    return QRect(left, top, right - left + 1, bottom - top + 1);
+    return nx::media::motion_mask::boundingBox(data);
 }
 
 bool QnMetaDataV1::isMotionAt(int x, int y, const char* mask)
@@ -0,0 +1,398 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "motion_mask.h"
+
+#include <bit>
+#include <cstring>
+
+#include <QtCore/QtEndian>
+
+#include <nx/utils/cpu_features.h>
+#include <nx/utils/log/assert.h>
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+    #include <immintrin.h>
+#elif defined(NX_NEON_SUPPORTED)
+    #include <arm_neon.h>
+#endif
+
+namespace nx::media::motion_mask {
+
+namespace {
+
+static constexpr int kWordCount = kGridSizeBytes / sizeof(quint64);
+
+quint64 loadWord(const quint8* data, int index)
+{
+    quint64 result;
+    std::memcpy(&result, data + index * sizeof(quint64), sizeof(result));
+    return result;
+}
+
+/** @return The column with the top row in the most significant bit. */
+quint32 column(const quint8* grid, int x)
+{
+    return qFromBigEndian<quint32>(grid + x * sizeof(quint32));
+}
+
+#if !defined(NX_AVX2_CODE_SUPPORTED) && !defined(NX_NEON_SUPPORTED)
+
+void storeWord(quint8* data, int index, quint64 value)
+{
+    std::memcpy(data + index * sizeof(quint64), &value, sizeof(value));
+}
+
+bool intersectsScalar(const quint8* grid, const quint8* mask, int firstBlock, int lastBlock)
+{
+    for (int i = firstBlock * 2; i < (lastBlock + 1) * 2; ++i)
+    {
+        if (loadWord(grid, i) & loadWord(mask, i))
+            return true;
+    }
+    return false;
+}
+
+void uniteScalar(quint8* target, const quint8* source)
+{
+    for (int i = 0; i < kWordCount; ++i)
+        storeWord(target, i, loadWord(target, i) | loadWord(source, i));
+}
+
+void subtractScalar(quint8* grid, const quint8* mask)
+{
+    for (int i = 0; i < kWordCount; ++i)
+        storeWord(grid, i, loadWord(grid, i) & ~loadWord(mask, i));
+}
+
+bool isEmptyScalar(const quint8* grid)
+{
+    quint64 result = 0;
+    for (int i = 0; i < kWordCount; ++i)
+        result |= loadWord(grid, i);
+    return result == 0;
+}
+
+#endif
+
+int cellCountScalar(const quint8* grid, const quint8* mask)
+{
+    int result = 0;
+    for (int i = 0; i < kWordCount; ++i)
+        result += std::popcount(loadWord(grid, i) & (mask ? loadWord(mask, i) : ~0ULL));
+    return result;
+}
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+
+// The grid is 5 AVX2 vectors and one SSE block.
+static constexpr int kAvx2Size = kGridSizeBytes / 32 * 32;
+
+NX_TARGET_AVX2 bool intersectsAvx2(
+    const quint8* grid, const quint8* mask, int firstBlock, int lastBlock)
+{
+    int offset = firstBlock * kBlockSizeBytes;
+    const int end = (lastBlock + 1) * kBlockSizeBytes;
+    for (; offset + 32 <= end; offset += 32)
+    {
+        const __m256i data = _mm256_loadu_si256((const __m256i*) (grid + offset));
+        if (!_mm256_testz_si256(data, _mm256_loadu_si256((const __m256i*) (mask + offset))))
+            return true;
+    }
+    if (offset < end)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i*) (grid + offset));
+        return !_mm_testz_si128(data, _mm_loadu_si128((const __m128i*) (mask + offset)));
+    }
+    return false;
+}
+
+NX_TARGET_AVX2 void uniteAvx2(quint8* target, const quint8* source)
+{
+    for (int offset = 0; offset < kAvx2Size; offset += 32)
+    {
+        const __m256i data = _mm256_loadu_si256((const __m256i*) (target + offset));
+        _mm256_storeu_si256((__m256i*) (target + offset), _mm256_or_si256(
+            data, _mm256_loadu_si256((const __m256i*) (source + offset))));
+    }
+    const __m128i data = _mm_loadu_si128((const __m128i*) (target + kAvx2Size));
+    _mm_storeu_si128((__m128i*) (target + kAvx2Size),
+        _mm_or_si128(data, _mm_loadu_si128((const __m128i*) (source + kAvx2Size))));
+}
+
+NX_TARGET_AVX2 void subtractAvx2(quint8* grid, const quint8* mask)
+{
+    for (int offset = 0; offset < kAvx2Size; offset += 32)
+    {
+        const __m256i data = _mm256_loadu_si256((const __m256i*) (grid + offset));
+        _mm256_storeu_si256((__m256i*) (grid + offset), _mm256_andnot_si256(
+            _mm256_loadu_si256((const __m256i*) (mask + offset)), data));
+    }
+    const __m128i data = _mm_loadu_si128((const __m128i*) (grid + kAvx2Size));
+    _mm_storeu_si128((__m128i*) (grid + kAvx2Size),
+        _mm_andnot_si128(_mm_loadu_si128((const __m128i*) (mask + kAvx2Size)), data));
+}
+
+NX_TARGET_AVX2 bool isEmptyAvx2(const quint8* grid)
+{
+    __m256i vectors = _mm256_setzero_si256();
+    for (int offset = 0; offset < kAvx2Size; offset += 32)
+        vectors = _mm256_or_si256(vectors, _mm256_loadu_si256((const __m256i*) (grid + offset)));
+    const __m128i result = _mm_or_si128(
+        _mm_or_si128(_mm256_castsi256_si128(vectors), _mm256_extracti128_si256(vectors, 1)),
+        _mm_loadu_si128((const __m128i*) (grid + kAvx2Size)));
+    return _mm_testz_si128(result, result);
+}
+
+/** Counts the bits of each byte with a nibble lookup and sums them to the 64-bit lanes. */
+NX_TARGET_AVX2 inline __m256i popcountAvx2(__m256i value)
+{
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibbles = _mm256_set1_epi8(0x0f);
+    const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(value, lowNibbles));
+    const __m256i high = _mm256_shuffle_epi8(
+        lookup, _mm256_and_si256(_mm256_srli_epi16(value, 4), lowNibbles));
+    return _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256());
+}
+
+NX_TARGET_AVX2 inline __m256i loadMaskedAvx2(const quint8* grid, const quint8* mask, int offset)
+{
+    const __m256i data = _mm256_loadu_si256((const __m256i*) (grid + offset));
+    return mask
+        ? _mm256_and_si256(data, _mm256_loadu_si256((const __m256i*) (mask + offset)))
+        : data;
+}
+
+NX_TARGET_AVX2 int cellCountAvx2(const quint8* grid, const quint8* mask)
+{
+    __m128i tail = _mm_loadu_si128((const __m128i*) (grid + kAvx2Size));
+    if (mask)
+        tail = _mm_and_si128(tail, _mm_loadu_si128((const __m128i*) (mask + kAvx2Size)));
+    __m256i sums = popcountAvx2(
+        _mm256_inserti128_si256(_mm256_castsi128_si256(tail), _mm_setzero_si128(), 1));
+    for (int offset = 0; offset < kAvx2Size; offset += 32)
+        sums = _mm256_add_epi64(sums, popcountAvx2(loadMaskedAvx2(grid, mask, offset)));
+
+    const __m128i sum = _mm_add_epi64(
+        _mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    return (int) (_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+}
+
+bool intersectsSse2(const quint8* grid, const quint8* mask, int firstBlock, int lastBlock)
+{
+    for (int i = firstBlock; i <= lastBlock; ++i)
+    {
+        const __m128i data = _mm_and_si128(
+            _mm_loadu_si128((const __m128i*) (grid + i * kBlockSizeBytes)),
+            _mm_loadu_si128((const __m128i*) (mask + i * kBlockSizeBytes)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_setzero_si128())) != 0xffff)
+            return true;
+    }
+    return false;
+}
+
+void uniteSse2(quint8* target, const quint8* source)
+{
+    for (int offset = 0; offset < kGridSizeBytes; offset += kBlockSizeBytes)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i*) (target + offset));
+        _mm_storeu_si128((__m128i*) (target + offset),
+            _mm_or_si128(data, _mm_loadu_si128((const __m128i*) (source + offset))));
+    }
+}
+
+void subtractSse2(quint8* grid, const quint8* mask)
+{
+    for (int offset = 0; offset < kGridSizeBytes; offset += kBlockSizeBytes)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i*) (grid + offset));
+        _mm_storeu_si128((__m128i*) (grid + offset),
+            _mm_andnot_si128(_mm_loadu_si128((const __m128i*) (mask + offset)), data));
+    }
+}
+
+bool isEmptySse2(const quint8* grid)
+{
+    __m128i result = _mm_setzero_si128();
+    for (int offset = 0; offset < kGridSizeBytes; offset += kBlockSizeBytes)
+        result = _mm_or_si128(result, _mm_loadu_si128((const __m128i*) (grid + offset)));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(result, _mm_setzero_si128())) == 0xffff;
+}
+
+#elif defined(NX_NEON_SUPPORTED)
+
+bool intersectsNeon(const quint8* grid, const quint8* mask, int firstBlock, int lastBlock)
+{
+    for (int i = firstBlock; i <= lastBlock; ++i)
+    {
+        const uint8x16_t data = vandq_u8(
+            vld1q_u8(grid + i * kBlockSizeBytes), vld1q_u8(mask + i * kBlockSizeBytes));
+        if (vmaxvq_u32(vreinterpretq_u32_u8(data)) != 0)
+            return true;
+    }
+    return false;
+}
+
+void uniteNeon(quint8* target, const quint8* source)
+{
+    for (int offset = 0; offset < kGridSizeBytes; offset += kBlockSizeBytes)
+        vst1q_u8(target + offset, vorrq_u8(vld1q_u8(target + offset), vld1q_u8(source + offset)));
+}
+
+void subtractNeon(quint8* grid, const quint8* mask)
+{
+    for (int offset = 0; offset < kGridSizeBytes; offset += kBlockSizeBytes)
+        vst1q_u8(grid + offset, vbicq_u8(vld1q_u8(grid + offset), vld1q_u8(mask + offset)));
+}
+
+bool isEmptyNeon(const quint8* grid)
+{
+    uint8x16_t result = vdupq_n_u8(0);
+    for (int offset = 0; offset < kGridSizeBytes; offset += kBlockSizeBytes)
+        result = vorrq_u8(result, vld1q_u8(grid + offset));
+    return vmaxvq_u32(vreinterpretq_u32_u8(result)) == 0;
+}
+
+int cellCountNeon(const quint8* grid, const quint8* mask)
+{
+    int result = 0;
+    for (int offset = 0; offset < kGridSizeBytes; offset += kBlockSizeBytes)
+    {
+        uint8x16_t data = vld1q_u8(grid + offset);
+        if (mask)
+            data = vandq_u8(data, vld1q_u8(mask + offset));
+        // At most 128 bits per block, the byte sum does not overflow.
+        result += vaddvq_u8(vcntq_u8(data));
+    }
+    return result;
+}
+
+#endif
+
+int cellCount(const quint8* grid, const quint8* mask)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (nx::utils::cpuSupportsAvx2())
+            return cellCountAvx2(grid, mask);
+    #elif defined(NX_NEON_SUPPORTED)
+        return cellCountNeon(grid, mask);
+    #endif
+    return cellCountScalar(grid, mask);
+}
+
+} // namespace
+
+bool intersects(const void* grid, const void* mask, int firstBlock, int lastBlock)
+{
+    NX_ASSERT(firstBlock >= 0 && lastBlock < kBlockCount);
+
+    const auto gridData = (const quint8*) grid;
+    const auto maskData = (const quint8*) mask;
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (nx::utils::cpuSupportsAvx2())
+            return intersectsAvx2(gridData, maskData, firstBlock, lastBlock);
+        return intersectsSse2(gridData, maskData, firstBlock, lastBlock);
+    #elif defined(NX_NEON_SUPPORTED)
+        return intersectsNeon(gridData, maskData, firstBlock, lastBlock);
+    #else
+        return intersectsScalar(gridData, maskData, firstBlock, lastBlock);
+    #endif
+}
+
+void unite(void* target, const void* source)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (nx::utils::cpuSupportsAvx2())
+            return uniteAvx2((quint8*) target, (const quint8*) source);
+        uniteSse2((quint8*) target, (const quint8*) source);
+    #elif defined(NX_NEON_SUPPORTED)
+        uniteNeon((quint8*) target, (const quint8*) source);
+    #else
+        uniteScalar((quint8*) target, (const quint8*) source);
+    #endif
+}
+
+void subtract(void* grid, const void* mask)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (nx::utils::cpuSupportsAvx2())
+            return subtractAvx2((quint8*) grid, (const quint8*) mask);
+        subtractSse2((quint8*) grid, (const quint8*) mask);
+    #elif defined(NX_NEON_SUPPORTED)
+        subtractNeon((quint8*) grid, (const quint8*) mask);
+    #else
+        subtractScalar((quint8*) grid, (const quint8*) mask);
+    #endif
+}
+
+bool isEmpty(const void* grid)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (nx::utils::cpuSupportsAvx2())
+            return isEmptyAvx2((const quint8*) grid);
+        return isEmptySse2((const quint8*) grid);
+    #elif defined(NX_NEON_SUPPORTED)
+        return isEmptyNeon((const quint8*) grid);
+    #else
+        return isEmptyScalar((const quint8*) grid);
+    #endif
+}
+
+int cellCount(const void* grid)
+{
+    return cellCount((const quint8*) grid, /*mask*/ nullptr);
+}
+
+int intersectionCellCount(const void* grid, const void* mask)
+{
+    return cellCount((const quint8*) grid, (const quint8*) mask);
+}
+
+QRect boundingBox(const void* grid)
+{
+    const auto data = (const quint8*) grid;
+    int left = -1;
+    int right = -1;
+    quint32 rows = 0;
+    for (int x = 0; x < Qn::kMotionGridWidth; ++x)
+    {
+        if (const quint32 value = column(data, x))
+        {
+            if (left < 0)
+                left = x;
+            right = x;
+            rows |= value;
+        }
+    }
+    if (left < 0)
+        return QRect();
+
+    const int top = std::countl_zero(rows);
+    const int bottom = Qn::kMotionGridHeight - 1 - std::countr_zero(rows);
+    return QRect(left, top, right - left + 1, bottom - top + 1);
+}
+
+void downscale(const void* grid, int factor, quint8* cells)
+{
+    if (!NX_ASSERT(factor == 1 || factor == 2 || factor == 4, "Unsupported factor %1", factor))
+        return;
+
+    const auto data = (const quint8*) grid;
+    const int width = Qn::kMotionGridWidth / factor;
+    const int height = Qn::kMotionGridHeight / factor;
+    const quint32 cellMask = (1U << factor) - 1;
+    for (int x = 0; x < width; ++x)
+    {
+        quint32 value = 0;
+        for (int i = 0; i < factor; ++i)
+            value |= column(data, x * factor + i);
+        for (int y = 0; y < height; ++y)
+        {
+            const int shift = Qn::kMotionGridHeight - (y + 1) * factor;
+            cells[y * width + x] = (value >> shift) & cellMask ? 1 : 0;
+        }
+    }
+}
+
+} // namespace nx::media::motion_mask
@@ -0,0 +1,53 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <QtCore/QRect>
+
+#include <nx/media/motion_detection.h>
+
+/**
+ * Operations over the motion grid bitmasks, the data of QnMetaDataV1. The grid is stored column
+ * by column, each column is a big-endian 32-bit word with the top row in the most significant
+ * bit. The grid is processed in the 128-bit blocks, the same units the mask ranges of
+ * QnMetaDataV1::createMask() are measured in. The grids may be unaligned. The AVX2 or NEON
+ * implementation is selected at runtime when available.
+ */
+namespace nx::media::motion_mask {
+
+static constexpr int kGridSizeBytes = Qn::kMotionGridWidth * Qn::kMotionGridHeight / 8;
+static constexpr int kBlockSizeBytes = 16;
+static constexpr int kBlockCount = kGridSizeBytes / kBlockSizeBytes;
+static_assert(kGridSizeBytes % kBlockSizeBytes == 0);
+
+/** @return True if the grid and the mask share a cell within the blocks [firstBlock, lastBlock]. */
+NX_MEDIA_CORE_API bool intersects(
+    const void* grid, const void* mask, int firstBlock = 0, int lastBlock = kBlockCount - 1);
+
+/** Adds the cells of the source grid to the target one. */
+NX_MEDIA_CORE_API void unite(void* target, const void* source);
+
+/** Removes the cells set in the mask from the grid. */
+NX_MEDIA_CORE_API void subtract(void* grid, const void* mask);
+
+NX_MEDIA_CORE_API bool isEmpty(const void* grid);
+
+/** @return Number of the cells set in the grid. */
+NX_MEDIA_CORE_API int cellCount(const void* grid);
+
+/** @return Number of the cells set both in the grid and in the mask. */
+NX_MEDIA_CORE_API int intersectionCellCount(const void* grid, const void* mask);
+
+/** @return Bounding rectangle of the set cells in the grid coordinates, null if there are none. */
+NX_MEDIA_CORE_API QRect boundingBox(const void* grid);
+
+/**
+ * Downscales the grid for the previews: each output cell is set to 1 if any cell of the
+ * corresponding factor x factor square is set, and to 0 otherwise.
+ * @param factor 1, 2 or 4, the divisors of both grid dimensions.
+ * @param cells Receives (kMotionGridWidth / factor) * (kMotionGridHeight / factor) bytes, row by
+ *     row.
+ */
+NX_MEDIA_CORE_API void downscale(const void* grid, int factor, quint8* cells);
+
+} // namespace nx::media::motion_mask
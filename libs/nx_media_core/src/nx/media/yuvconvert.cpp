@@ -11,8 +11,15 @@
 
     #include <QtCore/QtGlobal>
 
+    #include <nx/utils/cpu_features.h>
     #include <nx/utils/math/math.h>
 
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        #include <immintrin.h>
+    #elif defined(NX_NEON_SUPPORTED)
+        #include <arm_neon.h>
+    #endif
+
 const __m128i  sse_00ffw_intrs = _mm_setr_epi32(0x00ff00ff, 0x00ff00ff, 0x00ff00ff, 0x00ff00ff);
 const __m128i  sse_0010_intrs  = _mm_setr_epi32(0x00100010, 0x00100010, 0x00100010, 0x00100010);
 const __m128i  sse_0080_intrs  = _mm_setr_epi32(0x00800080, 0x00800080, 0x00800080, 0x00800080);
@@ -24,6 +31,360 @@ const __m128i  sse_rv_coeff_intrs  = _mm_setr_epi32(0x33123312, 0x33123312, 0x33
 const __m128i  sse_gu_coeff_intrs  = _mm_setr_epi32(0xf37df37d, 0xf37df37d, 0xf37df37d, 0xf37df37d);
 const __m128i  sse_gv_coeff_intrs  = _mm_setr_epi32(0xe5fce5fc, 0xe5fce5fc, 0xe5fce5fc, 0xe5fce5fc);
 
+namespace {
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+
+/**
+ * Converts 32 pixels of a line. Within the 128-bit lanes the bytes are unpacked to the pixels
+ * 0-7 and 16-23 ([0] of the chroma terms) and 8-15 and 24-31 ([1]).
+ * The arithmetic is the same as in the SSE version, so the results are identical.
+ */
+NX_TARGET_AVX2 inline void yuvToBgraAvx2(
+    const quint8* py, const __m256i* rv, const __m256i* guv, const __m256i* bu,
+    __m256i alpha, quint8* dst)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i y = _mm256_loadu_si256((const __m256i*) py);
+    __m256i y0 = _mm256_sub_epi16(_mm256_unpacklo_epi8(y, zero), _mm256_set1_epi16(0x10));
+    __m256i y1 = _mm256_sub_epi16(_mm256_unpackhi_epi8(y, zero), _mm256_set1_epi16(0x10));
+    y0 = _mm256_mulhi_epi16(_mm256_slli_epi16(y0, 3), _mm256_set1_epi16(0x253f));
+    y1 = _mm256_mulhi_epi16(_mm256_slli_epi16(y1, 3), _mm256_set1_epi16(0x253f));
+
+    const __m256i r = _mm256_packus_epi16(
+        _mm256_add_epi16(y0, rv[0]), _mm256_add_epi16(y1, rv[1]));
+    const __m256i g = _mm256_packus_epi16(
+        _mm256_add_epi16(y0, guv[0]), _mm256_add_epi16(y1, guv[1]));
+    const __m256i b = _mm256_packus_epi16(
+        _mm256_add_epi16(y0, bu[0]), _mm256_add_epi16(y1, bu[1]));
+
+    const __m256i bg0 = _mm256_unpacklo_epi8(b, g);
+    const __m256i ra0 = _mm256_unpacklo_epi8(r, alpha);
+    const __m256i bg1 = _mm256_unpackhi_epi8(b, g);
+    const __m256i ra1 = _mm256_unpackhi_epi8(r, alpha);
+
+    const __m256i p0 = _mm256_unpacklo_epi16(bg0, ra0); //< Pixels 0-3 and 16-19.
+    const __m256i p1 = _mm256_unpackhi_epi16(bg0, ra0); //< Pixels 4-7 and 20-23.
+    const __m256i p2 = _mm256_unpacklo_epi16(bg1, ra1); //< Pixels 8-11 and 24-27.
+    const __m256i p3 = _mm256_unpackhi_epi16(bg1, ra1); //< Pixels 12-15 and 28-31.
+
+    __m256i* out = (__m256i*) dst;
+    _mm256_storeu_si256(out, _mm256_permute2x128_si256(p0, p1, 0x20));
+    _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(p2, p3, 0x20));
+    _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(p0, p1, 0x31));
+    _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+}
+
+/**
+ * @return Number of the converted columns, a multiple of 32. The rest is converted by the SSE
+ * version.
+ */
+NX_TARGET_AVX2 unsigned int yuv420ToBgraAvx2(
+    unsigned char* dst, const unsigned char* py, const unsigned char* pu,
+    const unsigned char* pv, unsigned int width, unsigned int height, unsigned int dstStride,
+    unsigned int yStride, unsigned int uvStride, quint8 alpha)
+{
+    const unsigned int columns = qPower2Ceil(width, 16) / 32 * 32;
+    const __m256i alphaVector = _mm256_set1_epi8((char) alpha);
+
+    for (unsigned int y = 0; y < height / 2; ++y)
+    {
+        for (unsigned int x = 0; x < columns; x += 32)
+        {
+            __m256i u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (pu + x / 2)));
+            __m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (pv + x / 2)));
+            u = _mm256_slli_epi16(_mm256_sub_epi16(u, _mm256_set1_epi16(0x80)), 3);
+            v = _mm256_slli_epi16(_mm256_sub_epi16(v, _mm256_set1_epi16(0x80)), 3);
+
+            const __m256i bu = _mm256_mulhi_epi16(u, _mm256_set1_epi16(0x4093));
+            const __m256i rv = _mm256_mulhi_epi16(v, _mm256_set1_epi16(0x3312));
+            const __m256i guv = _mm256_add_epi16(
+                _mm256_mulhi_epi16(u, _mm256_set1_epi16((short) 0xf37d)),
+                _mm256_mulhi_epi16(v, _mm256_set1_epi16((short) 0xe5fc)));
+
+            // Each chroma sample is used for two adjacent pixels.
+            const __m256i buPixels[] = {
+                _mm256_unpacklo_epi16(bu, bu), _mm256_unpackhi_epi16(bu, bu)};
+            const __m256i rvPixels[] = {
+                _mm256_unpacklo_epi16(rv, rv), _mm256_unpackhi_epi16(rv, rv)};
+            const __m256i guvPixels[] = {
+                _mm256_unpacklo_epi16(guv, guv), _mm256_unpackhi_epi16(guv, guv)};
+
+            yuvToBgraAvx2(py + x, rvPixels, guvPixels, buPixels, alphaVector, dst + x * 4);
+            yuvToBgraAvx2(py + yStride + x, rvPixels, guvPixels, buPixels, alphaVector,
+                dst + dstStride + x * 4);
+        }
+        py += yStride * 2;
+        pu += uvStride;
+        pv += uvStride;
+        dst += dstStride * 2;
+    }
+    return columns;
+}
+
+/** Loads 16 pixels as the 14-bit channel values (value << 6), the same as the SSE version. */
+NX_TARGET_AVX2 inline void loadBgraAvx2(const quint8* line, __m256i* b, __m256i* g, __m256i* r)
+{
+    const __m256i mask = _mm256_set1_epi32(0x00003fc0);
+    const __m256i p0 = _mm256_loadu_si256((const __m256i*) line);
+    const __m256i p1 = _mm256_loadu_si256((const __m256i*) line + 1);
+
+    // Packing works within the 128-bit lanes, the permutation restores the pixel order.
+    *b = _mm256_permute4x64_epi64(_mm256_packs_epi32(
+        _mm256_and_si256(_mm256_slli_epi32(p0, 6), mask),
+        _mm256_and_si256(_mm256_slli_epi32(p1, 6), mask)), 0xd8);
+    *g = _mm256_permute4x64_epi64(_mm256_packs_epi32(
+        _mm256_and_si256(_mm256_srli_epi32(p0, 2), mask),
+        _mm256_and_si256(_mm256_srli_epi32(p1, 2), mask)), 0xd8);
+    *r = _mm256_permute4x64_epi64(_mm256_packs_epi32(
+        _mm256_and_si256(_mm256_srli_epi32(p0, 10), mask),
+        _mm256_and_si256(_mm256_srli_epi32(p1, 10), mask)), 0xd8);
+}
+
+NX_TARGET_AVX2 inline void storeLumaAvx2(__m256i b, __m256i g, __m256i r, quint8* dst)
+{
+    static constexpr int K = 32768;
+    __m256i y = _mm256_add_epi16(
+        _mm256_mulhi_epi16(b, _mm256_set1_epi16((short) (0.098 * K))),
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(g, _mm256_set1_epi16((short) (0.504 * K))),
+            _mm256_mulhi_epi16(r, _mm256_set1_epi16((short) (0.257 * K)))));
+    y = _mm256_srli_epi16(_mm256_add_epi16(y, _mm256_set1_epi16(0x0210)), 5);
+    y = _mm256_permute4x64_epi64(_mm256_packus_epi16(y, y), 0x08);
+    _mm_storeu_si128((__m128i*) dst, _mm256_castsi256_si128(y));
+}
+
+/**
+ * @return Number of the converted columns, a multiple of 16. The rest is converted by the SSE
+ * version.
+ */
+NX_TARGET_AVX2 int bgraToYv12Avx2(
+    const quint8* rgba, int xStride, quint8* y, quint8* u, quint8* v, int yStride,
+    int uvStride, int width, int height, bool flip)
+{
+    static constexpr int K = 32768;
+    const int columns = (int) qPower2Ceil((unsigned int) width, 8) / 16 * 16;
+
+    // V in the first half of each 128-bit lane, U in the second one.
+    const __m256i uvRCoeff = _mm256_setr_epi16(
+        (short) (0.439 * K), (short) (0.439 * K), (short) (0.439 * K), (short) (0.439 * K),
+        (short) (-0.148 * K), (short) (-0.148 * K), (short) (-0.148 * K), (short) (-0.148 * K),
+        (short) (0.439 * K), (short) (0.439 * K), (short) (0.439 * K), (short) (0.439 * K),
+        (short) (-0.148 * K), (short) (-0.148 * K), (short) (-0.148 * K), (short) (-0.148 * K));
+    const __m256i uvGCoeff = _mm256_setr_epi16(
+        (short) (-0.368 * K), (short) (-0.368 * K), (short) (-0.368 * K), (short) (-0.368 * K),
+        (short) (-0.291 * K), (short) (-0.291 * K), (short) (-0.291 * K), (short) (-0.291 * K),
+        (short) (-0.368 * K), (short) (-0.368 * K), (short) (-0.368 * K), (short) (-0.368 * K),
+        (short) (-0.291 * K), (short) (-0.291 * K), (short) (-0.291 * K), (short) (-0.291 * K));
+    const __m256i uvBCoeff = _mm256_setr_epi16(
+        (short) (-0.071 * K), (short) (-0.071 * K), (short) (-0.071 * K), (short) (-0.071 * K),
+        (short) (0.439 * K), (short) (0.439 * K), (short) (0.439 * K), (short) (0.439 * K),
+        (short) (-0.071 * K), (short) (-0.071 * K), (short) (-0.071 * K), (short) (-0.071 * K),
+        (short) (0.439 * K), (short) (0.439 * K), (short) (0.439 * K), (short) (0.439 * K));
+    const __m256i ones = _mm256_set1_epi16(1);
+
+    if (flip)
+    {
+        y += yStride * (height - 1);
+        u += uvStride * (height / 2 - 1);
+        v += uvStride * (height / 2 - 1);
+        yStride = -yStride;
+        uvStride = -uvStride;
+    }
+
+    for (int yLine = 0; yLine < height / 2; ++yLine)
+    {
+        for (int x = 0; x < columns; x += 16)
+        {
+            __m256i b0, g0, r0, b1, g1, r1;
+            loadBgraAvx2(rgba + x * 4, &b0, &g0, &r0);
+            loadBgraAvx2(rgba + xStride + x * 4, &b1, &g1, &r1);
+            storeLumaAvx2(b0, g0, r0, y + x);
+            storeLumaAvx2(b1, g1, r1, y + yStride + x);
+
+            // Sums of the horizontal pairs of the vertical averages.
+            const __m256i bAvg = _mm256_madd_epi16(_mm256_avg_epu16(b0, b1), ones);
+            const __m256i gAvg = _mm256_madd_epi16(_mm256_avg_epu16(g0, g1), ones);
+            const __m256i rAvg = _mm256_madd_epi16(_mm256_avg_epu16(r0, r1), ones);
+
+            __m256i uv = _mm256_set1_epi16(0x2020);
+            uv = _mm256_add_epi16(uv,
+                _mm256_mulhi_epi16(_mm256_packs_epi32(rAvg, rAvg), uvRCoeff));
+            uv = _mm256_add_epi16(uv,
+                _mm256_mulhi_epi16(_mm256_packs_epi32(gAvg, gAvg), uvGCoeff));
+            uv = _mm256_add_epi16(uv,
+                _mm256_mulhi_epi16(_mm256_packs_epi32(bAvg, bAvg), uvBCoeff));
+            uv = _mm256_packus_epi16(_mm256_srli_epi16(uv, 6), _mm256_setzero_si256());
+
+            // Each lane holds 4 V samples followed by 4 U samples.
+            const __m128i low = _mm256_castsi256_si128(uv);
+            const __m128i high = _mm256_extracti128_si256(uv, 1);
+            quint32* dstV = (quint32*) (v + x / 2);
+            quint32* dstU = (quint32*) (u + x / 2);
+            dstV[0] = _mm_cvtsi128_si32(low);
+            dstV[1] = _mm_cvtsi128_si32(high);
+            dstU[0] = _mm_cvtsi128_si32(_mm_srli_epi64(low, 32));
+            dstU[1] = _mm_cvtsi128_si32(_mm_srli_epi64(high, 32));
+        }
+        u += uvStride;
+        v += uvStride;
+        y += yStride * 2;
+        rgba += xStride * 2;
+    }
+    return columns;
+}
+
+#elif defined(NX_NEON_SUPPORTED)
+
+// vqdmulh(a, c) is (2 * a * c) >> 16, so vqdmulh(a, c) == _mm_mulhi_epi16(a * 2, c). The
+// operands are pre-scaled by the half of the SSE shift to get the results identical to the SSE
+// version.
+
+/** Converts 16 pixels of a line. The chroma terms are for the pixels 0-7 ([0]) and 8-15 ([1]). */
+inline void yuvToBgraNeon(
+    const quint8* py, const int16x8_t* rv, const int16x8_t* guv, const int16x8_t* bu,
+    uint8x16_t alpha, quint8* dst)
+{
+    const uint8x16_t y = vld1q_u8(py);
+    const int16x8_t yCoeff = vdupq_n_s16(0x253f);
+    const int16x8_t y0 = vqdmulhq_s16(vshlq_n_s16(vsubq_s16(
+        vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))), vdupq_n_s16(0x10)), 2), yCoeff);
+    const int16x8_t y1 = vqdmulhq_s16(vshlq_n_s16(vsubq_s16(
+        vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))), vdupq_n_s16(0x10)), 2), yCoeff);
+
+    uint8x16x4_t bgra;
+    bgra.val[0] = vcombine_u8(
+        vqmovun_s16(vaddq_s16(y0, bu[0])), vqmovun_s16(vaddq_s16(y1, bu[1])));
+    bgra.val[1] = vcombine_u8(
+        vqmovun_s16(vaddq_s16(y0, guv[0])), vqmovun_s16(vaddq_s16(y1, guv[1])));
+    bgra.val[2] = vcombine_u8(
+        vqmovun_s16(vaddq_s16(y0, rv[0])), vqmovun_s16(vaddq_s16(y1, rv[1])));
+    bgra.val[3] = alpha;
+    vst4q_u8(dst, bgra);
+}
+
+void yuv420ToBgraNeon(
+    unsigned char* dst, const unsigned char* py, const unsigned char* pu,
+    const unsigned char* pv, unsigned int width, unsigned int height, unsigned int dstStride,
+    unsigned int yStride, unsigned int uvStride, quint8 alpha)
+{
+    const unsigned int columns = qPower2Ceil(width, 16);
+    const uint8x16_t alphaVector = vdupq_n_u8(alpha);
+
+    for (unsigned int y = 0; y < height / 2; ++y)
+    {
+        for (unsigned int x = 0; x < columns; x += 16)
+        {
+            const int16x8_t u = vshlq_n_s16(vsubq_s16(
+                vreinterpretq_s16_u16(vmovl_u8(vld1_u8(pu + x / 2))), vdupq_n_s16(0x80)), 2);
+            const int16x8_t v = vshlq_n_s16(vsubq_s16(
+                vreinterpretq_s16_u16(vmovl_u8(vld1_u8(pv + x / 2))), vdupq_n_s16(0x80)), 2);
+
+            const int16x8_t bu = vqdmulhq_s16(u, vdupq_n_s16(0x4093));
+            const int16x8_t rv = vqdmulhq_s16(v, vdupq_n_s16(0x3312));
+            const int16x8_t guv = vaddq_s16(
+                vqdmulhq_s16(u, vdupq_n_s16((int16_t) 0xf37d)),
+                vqdmulhq_s16(v, vdupq_n_s16((int16_t) 0xe5fc)));
+
+            // Each chroma sample is used for two adjacent pixels.
+            const int16x8_t buPixels[] = {vzip1q_s16(bu, bu), vzip2q_s16(bu, bu)};
+            const int16x8_t rvPixels[] = {vzip1q_s16(rv, rv), vzip2q_s16(rv, rv)};
+            const int16x8_t guvPixels[] = {vzip1q_s16(guv, guv), vzip2q_s16(guv, guv)};
+
+            yuvToBgraNeon(py + x, rvPixels, guvPixels, buPixels, alphaVector, dst + x * 4);
+            yuvToBgraNeon(py + yStride + x, rvPixels, guvPixels, buPixels, alphaVector,
+                dst + dstStride + x * 4);
+        }
+        py += yStride * 2;
+        pu += uvStride;
+        pv += uvStride;
+        dst += dstStride * 2;
+    }
+}
+
+inline uint8x8_t lumaNeon(uint8x8x4_t pixels)
+{
+    static constexpr int K = 32768;
+    // The channels are scaled by 32 instead of 64 of the SSE version, see vqdmulh above.
+    const int16x8_t b = vreinterpretq_s16_u16(vshll_n_u8(pixels.val[0], 5));
+    const int16x8_t g = vreinterpretq_s16_u16(vshll_n_u8(pixels.val[1], 5));
+    const int16x8_t r = vreinterpretq_s16_u16(vshll_n_u8(pixels.val[2], 5));
+    const int16x8_t y = vaddq_s16(
+        vqdmulhq_s16(b, vdupq_n_s16((int16_t) (0.098 * K))),
+        vaddq_s16(
+            vqdmulhq_s16(g, vdupq_n_s16((int16_t) (0.504 * K))),
+            vqdmulhq_s16(r, vdupq_n_s16((int16_t) (0.257 * K)))));
+    return vqmovun_s16(vreinterpretq_s16_u16(vshrq_n_u16(
+        vreinterpretq_u16_s16(vaddq_s16(y, vdupq_n_s16(0x0210))), 5)));
+}
+
+/**
+ * The sums of 2x2 pixel blocks scaled by 16: the SSE version averages the values scaled by 64
+ * and sums the pairs, and vqdmulh doubles.
+ */
+inline int16x8_t blockSumsNeon(uint8x8_t line0, uint8x8_t line1)
+{
+    const uint16x8_t columns = vaddl_u8(line0, line1);
+    const uint16x4_t sums = vshl_n_u16(vpadd_u16(vget_low_u16(columns), vget_high_u16(columns)), 4);
+    return vreinterpretq_s16_u16(vcombine_u16(sums, sums));
+}
+
+void bgraToYv12Neon(
+    const quint8* rgba, int xStride, quint8* y, quint8* u, quint8* v, int yStride,
+    int uvStride, int width, int height, bool flip)
+{
+    static constexpr int K = 32768;
+    const int columns = (int) qPower2Ceil((unsigned int) width, 8);
+
+    // V in the first half, U in the second one.
+    const int16x8_t uvRCoeff = vcombine_s16(
+        vdup_n_s16((int16_t) (0.439 * K)), vdup_n_s16((int16_t) (-0.148 * K)));
+    const int16x8_t uvGCoeff = vcombine_s16(
+        vdup_n_s16((int16_t) (-0.368 * K)), vdup_n_s16((int16_t) (-0.291 * K)));
+    const int16x8_t uvBCoeff = vcombine_s16(
+        vdup_n_s16((int16_t) (-0.071 * K)), vdup_n_s16((int16_t) (0.439 * K)));
+
+    if (flip)
+    {
+        y += yStride * (height - 1);
+        u += uvStride * (height / 2 - 1);
+        v += uvStride * (height / 2 - 1);
+        yStride = -yStride;
+        uvStride = -uvStride;
+    }
+
+    for (int yLine = 0; yLine < height / 2; ++yLine)
+    {
+        for (int x = 0; x < columns; x += 8)
+        {
+            const uint8x8x4_t line0 = vld4_u8(rgba + x * 4);
+            const uint8x8x4_t line1 = vld4_u8(rgba + xStride + x * 4);
+            vst1_u8(y + x, lumaNeon(line0));
+            vst1_u8(y + yStride + x, lumaNeon(line1));
+
+            int16x8_t uv = vdupq_n_s16(0x2020);
+            uv = vaddq_s16(uv, vqdmulhq_s16(
+                blockSumsNeon(line0.val[2], line1.val[2]), uvRCoeff));
+            uv = vaddq_s16(uv, vqdmulhq_s16(
+                blockSumsNeon(line0.val[1], line1.val[1]), uvGCoeff));
+            uv = vaddq_s16(uv, vqdmulhq_s16(
+                blockSumsNeon(line0.val[0], line1.val[0]), uvBCoeff));
+            const uint32x2_t vu = vreinterpret_u32_u8(vqmovun_s16(vreinterpretq_s16_u16(
+                vshrq_n_u16(vreinterpretq_u16_s16(uv), 6))));
+            vst1_lane_u32((uint32_t*) (v + x / 2), vu, 0);
+            vst1_lane_u32((uint32_t*) (u + x / 2), vu, 1);
+        }
+        u += uvStride;
+        v += uvStride;
+        y += yStride * 2;
+        rgba += xStride * 2;
+    }
+}
+
+#endif
+
+} // namespace
+
 void yuv444_argb32_simd_intr(unsigned char * dst, const unsigned char * py,
                             const unsigned char * pu, const unsigned char * pv,
                             const unsigned int width, const unsigned int height,
@@ -167,7 +528,7 @@ void yuv422_argb32_simd_intr(unsigned char * dst, const unsigned char * py,
     }
 }
 
-void yuv420_argb32_simd_intr(unsigned char * dst, const unsigned char * py,
+static void yuv420ToBgraSse(unsigned char * dst, const unsigned char * py,
                             const unsigned char * pu, const unsigned char * pv,
                             const unsigned int width, const unsigned int height,
                             const unsigned int dst_stride, const unsigned int y_stride,
@@ -277,7 +638,38 @@ void yuv420_argb32_simd_intr(unsigned char * dst, const unsigned char * py,
     }
 }
 
-void bgra_to_yv12_simd_intr(const quint8* rgba, int xStride, quint8* y, quint8* u, quint8* v, int yStride, int uvStride, int width, int height, bool flip)
+void yuv420_argb32_simd_intr(unsigned char * dst, const unsigned char * py,
+                            const unsigned char * pu, const unsigned char * pv,
+                            const unsigned int width, const unsigned int height,
+                            const unsigned int dst_stride, const unsigned int y_stride,
+                            const unsigned int uv_stride, quint8 alpha)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (nx::utils::cpuSupportsAvx2())
+        {
+            NX_ASSERT(qPower2Ceil(width, 16) <= y_stride);
+            NX_ASSERT(qPower2Ceil(width * 4, 64) <= dst_stride);
+            const unsigned int columns = yuv420ToBgraAvx2(
+                dst, py, pu, pv, width, height, dst_stride, y_stride, uv_stride, alpha);
+            if (columns < width)
+            {
+                yuv420ToBgraSse(dst + columns * 4, py + columns, pu + columns / 2,
+                    pv + columns / 2, width - columns, height, dst_stride, y_stride, uv_stride,
+                    alpha);
+            }
+            return;
+        }
+    #elif defined(NX_NEON_SUPPORTED)
+        NX_ASSERT(qPower2Ceil(width, 16) <= y_stride);
+        NX_ASSERT(qPower2Ceil(width * 4, 64) <= dst_stride);
+        yuv420ToBgraNeon(dst, py, pu, pv, width, height, dst_stride, y_stride, uv_stride, alpha);
+        return;
+    #endif
+
+    yuv420ToBgraSse(dst, py, pu, pv, width, height, dst_stride, y_stride, uv_stride, alpha);
+}
+
+static void bgraToYv12Sse(const quint8* rgba, int xStride, quint8* y, quint8* u, quint8* v, int yStride, int uvStride, int width, int height, bool flip)
 {
     // This NX_ASSERT does not work in layout background setup.
     // NX_ASSERT( qPower2Ceil((unsigned int)width, 8) == (unsigned int)width );
@@ -363,6 +755,28 @@ void bgra_to_yv12_simd_intr(const quint8* rgba, int xStride, quint8* y, quint8*
     }
 }
 
+void bgra_to_yv12_simd_intr(const quint8* rgba, int xStride, quint8* y, quint8* u, quint8* v, int yStride, int uvStride, int width, int height, bool flip)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (nx::utils::cpuSupportsAvx2())
+        {
+            const int columns = bgraToYv12Avx2(
+                rgba, xStride, y, u, v, yStride, uvStride, width, height, flip);
+            if (columns < width)
+            {
+                bgraToYv12Sse(rgba + columns * 4, xStride, y + columns, u + columns / 2,
+                    v + columns / 2, yStride, uvStride, width - columns, height, flip);
+            }
+            return;
+        }
+    #elif defined(NX_NEON_SUPPORTED)
+        bgraToYv12Neon(rgba, xStride, y, u, v, yStride, uvStride, width, height, flip);
+        return;
+    #endif
+
+    bgraToYv12Sse(rgba, xStride, y, u, v, yStride, uvStride, width, height, flip);
+}
+
 void bgra_to_yva12_simd_intr(
     const quint8* rgba, int xStride,
     quint8* y, quint8* u, quint8* v, quint8* a,
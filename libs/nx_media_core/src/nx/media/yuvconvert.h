@@ -7,8 +7,9 @@
 
 static const unsigned int X_STRIDE_FOR_SSE_CONVERT_UTILS = 32;
 
-// All the following functions use SSE on x86, but have stub implementations for ARMs, thus, can be
-// compiled on any platform but should be called only on x64.
+// All the following functions use SSE on x86 and SSE emulated via NEON on ARMs, and have stub
+// implementations for other CPUs. yuv420_argb32_simd_intr() and bgra_to_yv12_simd_intr() use AVX2
+// if the CPU supports it and native NEON on ARM64.
 
 /** ATTENTION: Despite its name, this function actually converts to BGRA. */
 NX_MEDIA_CORE_API void yuv444_argb32_simd_intr(unsigned char * dst, const unsigned char * py,
@@ -0,0 +1,258 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/media/meta_data_packet.h>
+#include <nx/media/motion_mask.h>
+
+namespace nx::media::motion_mask::test {
+
+namespace {
+
+static constexpr int kWidth = Qn::kMotionGridWidth;
+static constexpr int kHeight = Qn::kMotionGridHeight;
+
+/** The grid at an offset of the buffer, to check the unaligned access. */
+class Grid
+{
+public:
+    Grid(int offset = 0): m_offset(offset) {}
+
+    quint8* data() { return m_buffer.data() + m_offset; }
+    const quint8* data() const { return m_buffer.data() + m_offset; }
+
+    bool at(int x, int y) const
+    {
+        return QnMetaDataV1::isMotionAt(x, y, (const char*) data());
+    }
+
+    void set(int x, int y, bool value)
+    {
+        quint8& byte = data()[(x * kHeight + y) / 8];
+        const quint8 bit = 0x80 >> (y & 7);
+        byte = value ? (byte | bit) : (byte & ~bit);
+    }
+
+    void fill(std::mt19937* random, int percent)
+    {
+        for (int x = 0; x < kWidth; ++x)
+        {
+            for (int y = 0; y < kHeight; ++y)
+                set(x, y, (int) ((*random)() % 100) < percent);
+        }
+    }
+
+private:
+    int m_offset = 0;
+    std::array<quint8, kGridSizeBytes + 16> m_buffer{};
+};
+
+int blockOf(int x, int y)
+{
+    return (x * kHeight + y) / (kBlockSizeBytes * 8);
+}
+
+} // namespace
+
+TEST(MotionMask, intersects)
+{
+    std::mt19937 random(1);
+    for (int offset: {0, 1, 3, 8})
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            Grid grid(offset);
+            Grid mask(offset / 2);
+            grid.fill(&random, /*percent*/ 3);
+            mask.fill(&random, /*percent*/ 3);
+            const int firstBlock = random() % kBlockCount;
+            const int lastBlock = firstBlock + random() % (kBlockCount - firstBlock);
+
+            bool expected = false;
+            for (int x = 0; x < kWidth; ++x)
+            {
+                for (int y = 0; y < kHeight; ++y)
+                {
+                    const int block = blockOf(x, y);
+                    if (block >= firstBlock && block <= lastBlock && grid.at(x, y)
+                        && mask.at(x, y))
+                    {
+                        expected = true;
+                    }
+                }
+            }
+            ASSERT_EQ(expected, intersects(grid.data(), mask.data(), firstBlock, lastBlock))
+                << offset << " " << firstBlock << " " << lastBlock;
+        }
+    }
+
+    // The empty range created for an empty region.
+    Grid full;
+    full.fill(&random, /*percent*/ 100);
+    ASSERT_FALSE(intersects(full.data(), full.data(), kBlockCount - 1, 0));
+}
+
+TEST(MotionMask, uniteAndSubtract)
+{
+    std::mt19937 random(2);
+    for (int offset: {0, 5})
+    {
+        Grid first(offset);
+        Grid second;
+        first.fill(&random, /*percent*/ 30);
+        second.fill(&random, /*percent*/ 30);
+
+        Grid united(offset);
+        std::copy(first.data(), first.data() + kGridSizeBytes, united.data());
+        unite(united.data(), second.data());
+
+        Grid subtracted(offset);
+        std::copy(first.data(), first.data() + kGridSizeBytes, subtracted.data());
+        subtract(subtracted.data(), second.data());
+
+        for (int x = 0; x < kWidth; ++x)
+        {
+            for (int y = 0; y < kHeight; ++y)
+            {
+                ASSERT_EQ(first.at(x, y) || second.at(x, y), united.at(x, y));
+                ASSERT_EQ(first.at(x, y) && !second.at(x, y), subtracted.at(x, y));
+            }
+        }
+    }
+}
+
+TEST(MotionMask, isEmpty)
+{
+    Grid grid(3);
+    ASSERT_TRUE(isEmpty(grid.data()));
+    for (int x = 0; x < kWidth; ++x)
+    {
+        for (int y = 0; y < kHeight; ++y)
+        {
+            grid.set(x, y, true);
+            ASSERT_FALSE(isEmpty(grid.data())) << x << " " << y;
+            grid.set(x, y, false);
+        }
+    }
+}
+
+TEST(MotionMask, cellCount)
+{
+    std::mt19937 random(3);
+    for (int percent: {0, 10, 50, 100})
+    {
+        Grid grid(1);
+        Grid mask;
+        grid.fill(&random, percent);
+        mask.fill(&random, /*percent*/ 50);
+
+        int expected = 0;
+        int expectedIntersection = 0;
+        for (int x = 0; x < kWidth; ++x)
+        {
+            for (int y = 0; y < kHeight; ++y)
+            {
+                expected += grid.at(x, y) ? 1 : 0;
+                expectedIntersection += grid.at(x, y) && mask.at(x, y) ? 1 : 0;
+            }
+        }
+        ASSERT_EQ(expected, cellCount(grid.data()));
+        ASSERT_EQ(expectedIntersection, intersectionCellCount(grid.data(), mask.data()));
+    }
+}
+
+TEST(MotionMask, boundingBox)
+{
+    Grid grid;
+    ASSERT_TRUE(boundingBox(grid.data()).isNull());
+
+    std::mt19937 random(4);
+    for (int i = 0; i < 100; ++i)
+    {
+        Grid grid(i % 4);
+        QRect expected;
+        for (int j = 0; j < 1 + i % 5; ++j)
+        {
+            const int x = random() % kWidth;
+            const int y = random() % kHeight;
+            grid.set(x, y, true);
+            expected = expected.united(QRect(x, y, 1, 1));
+        }
+        ASSERT_EQ(expected, boundingBox(grid.data()));
+        ASSERT_EQ(expected, QnMetaDataV1::boundingBox((const char*) grid.data()));
+    }
+}
+
+TEST(MotionMask, downscale)
+{
+    std::mt19937 random(5);
+    Grid grid;
+    grid.fill(&random, /*percent*/ 5);
+    for (int factor: {1, 2, 4})
+    {
+        const int width = kWidth / factor;
+        const int height = kHeight / factor;
+        std::vector<quint8> cells(width * height, 0xff);
+        downscale(grid.data(), factor, cells.data());
+
+        for (int x = 0; x < width; ++x)
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                bool expected = false;
+                for (int i = 0; i < factor * factor; ++i)
+                    expected |= grid.at(x * factor + i % factor, y * factor + i / factor);
+                ASSERT_EQ(expected ? 1 : 0, cells[y * width + x]) << factor;
+            }
+        }
+    }
+}
+
+TEST(MotionMask, DISABLED_performance)
+{
+    static constexpr std::chrono::milliseconds kDuration(500);
+
+    const auto measure =
+        [](auto func)
+        {
+            int iterations = 0;
+            const auto start = std::chrono::steady_clock::now();
+            std::chrono::duration<double> duration{};
+            do
+            {
+                for (int i = 0; i < 1000; ++i)
+                    func();
+                iterations += 1000;
+                duration = std::chrono::steady_clock::now() - start;
+            } while (duration < kDuration);
+            return iterations / duration.count() / 1'000'000;
+        };
+
+    std::mt19937 random(6);
+    std::vector<Grid> grids(1024);
+    for (auto& grid: grids)
+        grid.fill(&random, /*percent*/ 1);
+    Grid mask;
+    mask.set(kWidth - 1, kHeight - 1, true);
+    Grid target;
+
+    size_t index = 0;
+    int result = 0;
+    const auto next = [&]() -> const Grid& { return grids[index++ % grids.size()]; };
+    std::cout << "intersects: "
+        << measure([&]() { result += intersects(next().data(), mask.data()); })
+        << " M/s, unite: " << measure([&]() { unite(target.data(), next().data()); })
+        << " M/s, cellCount: " << measure([&]() { result += cellCount(next().data()); })
+        << " M/s, boundingBox: "
+        << measure([&]() { result += boundingBox(next().data()).width(); })
+        << " M/s" << std::endl;
+    ASSERT_GE(result, 0);
+}
+
+} // namespace nx::media::motion_mask::test
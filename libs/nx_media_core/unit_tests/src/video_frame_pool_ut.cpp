@@ -0,0 +1,66 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/media/ffmpeg/video_frame_pool.h>
+
+namespace nx::media::ffmpeg::test {
+
+TEST(VideoFramePool, reusesReleasedFrames)
+{
+    VideoFramePool pool(/*maxFreeFrames*/ 2);
+    auto frame = pool.get(QSize(320, 240), AV_PIX_FMT_YUV420P);
+    ASSERT_TRUE((bool) frame);
+    ASSERT_EQ(QSize(320, 240), frame->size());
+    ASSERT_EQ(AV_PIX_FMT_YUV420P, frame->format);
+    const auto data = frame->data[0];
+
+    frame.reset();
+    ASSERT_EQ(1, pool.freeFrameCount());
+    frame = pool.get(QSize(320, 240), AV_PIX_FMT_YUV420P);
+    ASSERT_EQ(data, frame->data[0]);
+    ASSERT_EQ(0, pool.freeFrameCount());
+
+    // The frames of the other parameters are dropped.
+    frame.reset();
+    frame = pool.get(QSize(640, 480), AV_PIX_FMT_YUV420P);
+    ASSERT_EQ(QSize(640, 480), frame->size());
+    ASSERT_EQ(0, pool.freeFrameCount());
+}
+
+TEST(VideoFramePool, limitsFreeFrames)
+{
+    VideoFramePool pool(/*maxFreeFrames*/ 2);
+    std::vector<CLVideoDecoderOutputPtr> frames;
+    for (int i = 0; i < 4; ++i)
+        frames.push_back(pool.get(QSize(64, 64), AV_PIX_FMT_YUV420P));
+    frames.clear();
+    ASSERT_EQ(2, pool.freeFrameCount());
+
+    pool.clear();
+    ASSERT_EQ(0, pool.freeFrameCount());
+}
+
+TEST(VideoFramePool, skipsChangedFrames)
+{
+    VideoFramePool pool;
+    auto frame = pool.get(QSize(64, 64), AV_PIX_FMT_YUV420P);
+    frame->setUseExternalData(true);
+    frame.reset();
+    ASSERT_EQ(0, pool.freeFrameCount());
+}
+
+TEST(VideoFramePool, outlivesPool)
+{
+    CLVideoDecoderOutputPtr frame;
+    {
+        VideoFramePool pool;
+        frame = pool.get(QSize(64, 64), AV_PIX_FMT_NV12);
+    }
+    ASSERT_EQ(QSize(64, 64), frame->size());
+    frame.reset();
+}
+
+} // namespace nx::media::ffmpeg::test
@@ -0,0 +1,214 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/media/yuvconvert.h>
+
+namespace nx::media::test {
+
+namespace {
+
+unsigned int alignUp(unsigned int value, unsigned int step)
+{
+    return (value + step - 1) / step * step;
+}
+
+int clamp(double value)
+{
+    return std::clamp((int) std::lround(value), 0, 255);
+}
+
+/** Planes with the strides required by the conversion functions, padded for the over-reads. */
+struct Yuv420Image
+{
+    Yuv420Image(unsigned int width, unsigned int height, std::mt19937* random = nullptr):
+        width(width),
+        height(height),
+        yStride(alignUp(width, 32)),
+        uvStride(yStride / 2),
+        y(yStride * height + 32),
+        u(uvStride * height / 2 + 32),
+        v(uvStride * height / 2 + 32)
+    {
+        if (!random)
+            return;
+        for (auto* plane: {&y, &u, &v})
+            std::generate(plane->begin(), plane->end(), [&]() { return (quint8) (*random)(); });
+    }
+
+    unsigned int width;
+    unsigned int height;
+    unsigned int yStride;
+    unsigned int uvStride;
+    std::vector<quint8> y;
+    std::vector<quint8> u;
+    std::vector<quint8> v;
+};
+
+struct BgraImage
+{
+    BgraImage(unsigned int width, unsigned int height, std::mt19937* random = nullptr):
+        width(width),
+        height(height),
+        stride(alignUp(width * 4, 64)),
+        data(stride * height + 64)
+    {
+        if (random)
+            std::generate(data.begin(), data.end(), [&]() { return (quint8) (*random)(); });
+    }
+
+    const quint8* pixel(unsigned int x, unsigned int y) const
+    {
+        return data.data() + y * stride + x * 4;
+    }
+
+    unsigned int width;
+    unsigned int height;
+    unsigned int stride;
+    std::vector<quint8> data;
+};
+
+void yuv420ToBgra(const Yuv420Image& source, BgraImage* target, quint8 alpha)
+{
+    yuv420_argb32_simd_intr(target->data.data(), source.y.data(), source.u.data(),
+        source.v.data(), source.width, source.height, target->stride, source.yStride,
+        source.uvStride, alpha);
+}
+
+void bgraToYuv420(const BgraImage& source, Yuv420Image* target, bool flip)
+{
+    bgra_to_yv12_simd_intr(source.data.data(), source.stride, target->y.data(),
+        target->u.data(), target->v.data(), target->yStride, target->uvStride, source.width,
+        source.height, flip);
+}
+
+} // namespace
+
+// The conversions are in the fixed point with truncation, so they are checked against the BT.601
+// formulas with a tolerance. The widths cover the vector blocks of all the kernels and the tails.
+static const std::vector<unsigned int> kWidths = {16, 24, 40, 48, 64, 72, 100, 360};
+static constexpr int kTolerance = 4;
+
+TEST(YuvConvert, yuv420ToBgra)
+{
+    std::mt19937 random(1);
+    for (const unsigned int width: kWidths)
+    {
+        const Yuv420Image source(width, /*height*/ 6, &random);
+        BgraImage target(width, /*height*/ 6);
+        yuv420ToBgra(source, &target, /*alpha*/ 0x80);
+
+        for (unsigned int y = 0; y < source.height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                const double luma = 1.164 * (source.y[y * source.yStride + x] - 16);
+                const int u = source.u[y / 2 * source.uvStride + x / 2] - 128;
+                const int v = source.v[y / 2 * source.uvStride + x / 2] - 128;
+                const int expected[] = {
+                    clamp(luma + 2.018 * u), clamp(luma - 0.391 * u - 0.813 * v),
+                    clamp(luma + 1.596 * v)};
+
+                const quint8* pixel = target.pixel(x, y);
+                for (int i = 0; i < 3; ++i)
+                    ASSERT_NEAR(expected[i], pixel[i], kTolerance) << width << " " << x << " " << i;
+                ASSERT_EQ(0x80, pixel[3]);
+            }
+        }
+    }
+}
+
+TEST(YuvConvert, bgraToYuv420)
+{
+    std::mt19937 random(2);
+    for (const bool flip: {false, true})
+    {
+        for (const unsigned int width: kWidths)
+        {
+            const BgraImage source(width, /*height*/ 6, &random);
+            Yuv420Image target(width, /*height*/ 6);
+            bgraToYuv420(source, &target, flip);
+
+            const auto targetLine =
+                [&](unsigned int y, unsigned int height)
+                {
+                    return flip ? height - 1 - y : y;
+                };
+
+            for (unsigned int y = 0; y < source.height; ++y)
+            {
+                for (unsigned int x = 0; x < width; ++x)
+                {
+                    const quint8* p = source.pixel(x, y);
+                    const double luma = 0.257 * p[2] + 0.504 * p[1] + 0.098 * p[0] + 16;
+                    ASSERT_NEAR(clamp(luma),
+                        target.y[targetLine(y, source.height) * target.yStride + x], kTolerance)
+                        << width << " " << x;
+                }
+            }
+
+            for (unsigned int y = 0; y < source.height / 2; ++y)
+            {
+                for (unsigned int x = 0; x < width / 2; ++x)
+                {
+                    double b = 0, g = 0, r = 0;
+                    for (const auto [dx, dy]: {std::pair{0, 0}, {1, 0}, {0, 1}, {1, 1}})
+                    {
+                        const quint8* p = source.pixel(x * 2 + dx, y * 2 + dy);
+                        b += p[0] / 4.0;
+                        g += p[1] / 4.0;
+                        r += p[2] / 4.0;
+                    }
+                    const int offset = targetLine(y, source.height / 2) * target.uvStride + x;
+                    ASSERT_NEAR(clamp(-0.148 * r - 0.291 * g + 0.439 * b + 128),
+                        target.u[offset], kTolerance) << width << " " << x;
+                    ASSERT_NEAR(clamp(0.439 * r - 0.368 * g - 0.071 * b + 128),
+                        target.v[offset], kTolerance) << width << " " << x;
+                }
+            }
+        }
+    }
+}
+
+TEST(YuvConvert, DISABLED_performance)
+{
+    static constexpr std::chrono::milliseconds kDuration(500);
+    static const std::vector<std::pair<unsigned int, unsigned int>> kResolutions = {
+        {320, 240}, {640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+
+    const auto measure =
+        [](unsigned int width, unsigned int height, auto func)
+        {
+            int iterations = 0;
+            const auto start = std::chrono::steady_clock::now();
+            std::chrono::duration<double> duration{};
+            do
+            {
+                func();
+                ++iterations;
+                duration = std::chrono::steady_clock::now() - start;
+            } while (duration < kDuration);
+            return (double) width * height * iterations / duration.count() / 1'000'000;
+        };
+
+    std::mt19937 random(3);
+    for (const auto& [width, height]: kResolutions)
+    {
+        Yuv420Image yuv(width, height, &random);
+        BgraImage bgra(width, height, &random);
+        std::cout << width << "x" << height << ": yuv420 -> bgra "
+            << measure(width, height, [&]() { yuv420ToBgra(yuv, &bgra, 0xff); })
+            << " Mpix/s, bgra -> yuv420 "
+            << measure(width, height, [&]() { bgraToYuv420(bgra, &yuv, false); })
+            << " Mpix/s" << std::endl;
+    }
+}
+
+} // namespace nx::media::test
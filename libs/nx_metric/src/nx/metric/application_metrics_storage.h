@@ -9,7 +9,7 @@ namespace nx::metric {
 
 struct ApplicationMetricsStorage: ParameterSet
 {
-    NX_METRICS_ADD(std::atomic<qint64>, totalServerRequests, "Total number of requests to server");
+    NX_METRICS_ADD(ShardedCounter, totalServerRequests, "Total number of requests to server");
 };
 
 } // namespace nx::metric::
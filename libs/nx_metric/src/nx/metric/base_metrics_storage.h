@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cmath>
+#include <type_traits>
 #include <vector>
 
 #include <QtCore/QJsonObject>
@@ -9,6 +11,8 @@
 #include <QtCore/QString>
 #include <QtCore/QVariant>
 
+#include <nx/metric/sharded_counter.h>
+
 namespace nx::metric {
 
 /*
@@ -38,6 +42,18 @@ struct ParameterSet
         return result;
     }
 
+    /**
+     * @return The parameters in the Prometheus text exposition format, named
+     *     <prefix>_<param>, or <prefix>_<set>_<param> for the nested parameter sets. Map entries
+     *     are labeled with their keys.
+     */
+    QString toPrometheus(const QString& prefix = "nx") const
+    {
+        QString result;
+        appendPrometheus(prefix, &result);
+        return result;
+    }
+
 protected:
     struct BaseParam
     {
@@ -51,6 +67,7 @@ protected:
         virtual ~BaseParam() = default;
 
         virtual QJsonValue toJson(bool brief) const = 0;
+        virtual void toPrometheus(const QString& prefix, QString* out) const = 0;
         const QString& name() const { return m_name; }
         const QString& description() const { return m_description; }
     private:
@@ -79,15 +96,99 @@ protected:
             {
                 return m_value.toJson(brief);
             }
+            else if constexpr(std::is_invocable_v<const T&>)
+            {
+                // The value is provided on demand, e.g. by an object that counts it itself.
+                return m_value ? QJsonValue(m_value()) : QJsonValue();
+            }
             else
             {
                 return QJsonValue(m_value);
             }
         }
+
+        virtual void toPrometheus(const QString& prefix, QString* out) const override
+        {
+            const QString metric = prefix + '_' + name();
+            if constexpr(std::is_base_of<ParameterSet, T>::value)
+            {
+                m_value.appendPrometheus(metric, out);
+            }
+            else if constexpr(isMap<T>::value)
+            {
+                appendPrometheusHeader(metric, description(), "untyped", out);
+                for (auto itr = m_value.begin(); itr != m_value.end(); ++itr)
+                {
+                    appendPrometheusSample(
+                        metric + "{key=\"" + escapePrometheusLabel(itr.key()) + "\"}",
+                        QJsonValue(itr.value()),
+                        out);
+                }
+            }
+            else
+            {
+                const QJsonValue value = toJson(/*brief*/ true);
+                if (!value.isBool() && !value.isDouble())
+                    return;
+
+                appendPrometheusHeader(metric, description(), prometheusType(), out);
+                appendPrometheusSample(metric, value, out);
+            }
+        }
+
+    private:
+        static const char* prometheusType()
+        {
+            if constexpr(std::is_same_v<T, ShardedCounter>)
+                return "counter";
+            else if constexpr(std::is_same_v<T, ShardedGauge>)
+                return "gauge";
+            else
+                return "untyped";
+        }
+
     private:
         T  m_value{};
     };
 
+private:
+    void appendPrometheus(const QString& prefix, QString* out) const
+    {
+        for (const auto& param: m_params)
+            param->toPrometheus(prefix, out);
+    }
+
+    static void appendPrometheusHeader(
+        const QString& metric, const QString& description, const char* type, QString* out)
+    {
+        QString help = description;
+        help.replace('\\', "\\\\").replace('\n', "\\n");
+        *out += "# HELP " + metric + ' ' + help + '\n';
+        *out += "# TYPE " + metric + ' ' + type + '\n';
+    }
+
+    static void appendPrometheusSample(const QString& metric, const QJsonValue& value, QString* out)
+    {
+        QString text;
+        if (value.isBool())
+            text = value.toBool() ? "1" : "0";
+        else if (const double number = value.toDouble();
+            std::trunc(number) == number && std::abs(number) < 1e18)
+        {
+            text = QString::number(value.toInteger());
+        }
+        else
+        {
+            text = QString::number(number, 'g', 17);
+        }
+        *out += metric + ' ' + text + '\n';
+    }
+
+    static QString escapePrometheusLabel(QString value)
+    {
+        return value.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
+    }
+
 private:
     std::vector<BaseParam*> m_params;
 };
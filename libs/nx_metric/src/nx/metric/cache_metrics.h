@@ -0,0 +1,54 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <functional>
+
+#include <nx/metric/base_metrics_storage.h>
+
+namespace nx::metric {
+
+/**
+ * Metrics of a cache that provides CacheStatistics (e.g., nx::utils::ConcurrentLruCache or
+ * nx::utils::ConcurrentTimeOutCache). The values are read from the cache when the metrics are
+ * requested, so the cache does not pay for updating them.
+ */
+struct CacheMetrics: ParameterSet
+{
+    using Provider = std::function<qint64()>;
+
+    NX_METRICS_ADD(Provider, hits, "Number of lookups that found the element");
+    NX_METRICS_ADD(Provider, misses, "Number of lookups that did not find the element");
+    NX_METRICS_ADD(Provider, evictions,
+        "Number of elements removed by the cache to free space or because they expired");
+    NX_METRICS_ADD(Provider, size, "Number of elements in the cache");
+
+    /**
+     * The cache MUST outlive the metrics or be unbound with unbind() first.
+     */
+    template<typename Cache>
+    void bind(const Cache* cache)
+    {
+        const auto provider =
+            [cache](auto field) -> Provider
+            {
+                return [cache, field]() { return (qint64) (cache->statistics().*field); };
+            };
+
+        using Statistics = decltype(cache->statistics());
+        hits() = provider(&Statistics::hits);
+        misses() = provider(&Statistics::misses);
+        evictions() = provider(&Statistics::evictions);
+        size() = provider(&Statistics::size);
+    }
+
+    void unbind()
+    {
+        hits() = nullptr;
+        misses() = nullptr;
+        evictions() = nullptr;
+        size() = nullptr;
+    }
+};
+
+} // namespace nx::metric
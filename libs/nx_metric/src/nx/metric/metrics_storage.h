@@ -10,19 +10,19 @@ struct Storage: ParameterSet
 {
     struct TcpConnections: ParameterSet
     {
-        NX_METRICS_ADD(std::atomic_int, outgoing,
+        NX_METRICS_ADD(ShardedGauge, outgoing,
             "Total amount of opened outgoing TCP connections with any type");
-        NX_METRICS_ADD(std::atomic_int, total,
+        NX_METRICS_ADD(ShardedGauge, total,
             "Total amount of opened incoming TCP connections with any type");
-        NX_METRICS_ADD(std::atomic_int, rtsp,
+        NX_METRICS_ADD(ShardedGauge, rtsp,
             "Amount of opened RTSP connections");
-        NX_METRICS_ADD(std::atomic_int, hls,
+        NX_METRICS_ADD(ShardedGauge, hls,
             "Amount of opened HLS connections");
-        NX_METRICS_ADD(std::atomic_int, progressiveDownloading,
+        NX_METRICS_ADD(ShardedGauge, progressiveDownloading,
             "Amount of opened progressive downloading connections");
-        NX_METRICS_ADD(std::atomic_int, p2p,
+        NX_METRICS_ADD(ShardedGauge, p2p,
             "Amount of opened p2p connections");
-        NX_METRICS_ADD(std::atomic<qint64>, totalBytesSent, "Total tcp bytes sent");
+        NX_METRICS_ADD(ShardedCounter, totalBytesSent, "Total tcp bytes sent");
     };
     NX_METRICS_ADD(TcpConnections, tcpConnections, "Opened TCP connections");
 
@@ -31,13 +31,13 @@ struct Storage: ParameterSet
     NX_METRICS_ADD(std::atomic_int, progressiveDownloadingTranscoders,
         "Amount of opened progressive downloading connections with transcoding");
     NX_METRICS_ADD(std::atomic_int, decoders, "Amount of video decoders");
-    NX_METRICS_ADD(std::atomic<qint64>, encodedPixels, "Amount of encoded video pixels");
-    NX_METRICS_ADD(std::atomic<qint64>, decodedPixels, "Amount of decoded video pixels");
+    NX_METRICS_ADD(ShardedCounter, encodedPixels, "Amount of encoded video pixels");
+    NX_METRICS_ADD(ShardedCounter, decodedPixels, "Amount of decoded video pixels");
     NX_METRICS_ADD(std::atomic_int, offlineStatus,
         "How many times resources have switched to the offline state");
     NX_METRICS_ADD(std::atomic<qint64>, ruleActions, "The number if executed rules actions");
     NX_METRICS_ADD(std::atomic<qint64>, thumbnails, "Amount of requested thumbnails");
-    NX_METRICS_ADD(std::atomic<qint64>, apiCalls, "Amount of requested API calls");
+    NX_METRICS_ADD(ShardedCounter, apiCalls, "Amount of requested API calls");
     NX_METRICS_ADD(std::atomic<qint64>, primaryStreams, "Amount of primary streams");
     NX_METRICS_ADD(std::atomic<qint64>, secondaryStreams, "Amount of secondary streams");
 
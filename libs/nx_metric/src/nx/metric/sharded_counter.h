@@ -0,0 +1,98 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include <QtCore/QtGlobal>
+
+namespace nx::metric {
+
+namespace detail {
+
+/**
+ * Value split into shards, each in its own cache line. A thread updates only its own shard, so
+ * threads updating the value concurrently do not bounce the cache line between CPUs. The shards
+ * are summed on read, which makes reading slower, but the metrics are read rarely.
+ */
+class ShardedValue
+{
+public:
+    static constexpr int kShardCount = 16;
+
+    ShardedValue() = default;
+    ShardedValue(const ShardedValue&) = delete;
+    ShardedValue& operator=(const ShardedValue&) = delete;
+
+    qint64 load() const
+    {
+        qint64 result = 0;
+        for (const auto& shard: m_shards)
+            result += shard.value.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    operator qint64() const { return load(); }
+
+protected:
+    void add(qint64 value)
+    {
+        m_shards[shardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+private:
+    /** Threads are assigned to the shards in turn, so the first kShardCount ones never share. */
+    static int shardIndex()
+    {
+        static std::atomic<int> nextIndex{0};
+        thread_local const int index =
+            nextIndex.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+        return index;
+    }
+
+private:
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    struct alignas(kCacheLineSize) Shard
+    {
+        std::atomic<qint64> value{0};
+    };
+
+    std::array<Shard, kShardCount> m_shards;
+};
+
+} // namespace detail
+
+/**
+ * Monotonic counter for the values that are updated from many threads, e.g. on every packet.
+ * Unlike std::atomic, the update operations do not return the new value.
+ */
+class ShardedCounter: public detail::ShardedValue
+{
+public:
+    void operator++(int) { add(1); }
+    void operator++() { add(1); }
+    void operator+=(qint64 value) { add(value); }
+    void fetch_add(qint64 value) { add(value); }
+};
+
+/**
+ * Value that goes up and down, e.g. the number of connections, which may be opened and closed in
+ * different threads.
+ */
+class ShardedGauge: public detail::ShardedValue
+{
+public:
+    void operator++(int) { add(1); }
+    void operator++() { add(1); }
+    void operator--(int) { add(-1); }
+    void operator--() { add(-1); }
+    void operator+=(qint64 value) { add(value); }
+    void operator-=(qint64 value) { add(-value); }
+    void fetch_add(qint64 value) { add(value); }
+    void fetch_sub(qint64 value) { add(-value); }
+};
+
+} // namespace nx::metric
@@ -0,0 +1,142 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "sampling_profiler.h"
+
+#include <QtCore/QRegularExpression>
+
+#if defined(Q_OS_WIN)
+    #include <nx/monitoring/sampling_profiler_win.h>
+    using ProfilerImplementation = nx::monitoring::WindowsSamplingProfiler;
+#elif defined(Q_OS_LINUX)
+    #include <nx/monitoring/sampling_profiler_linux.h>
+    using ProfilerImplementation = nx::monitoring::LinuxSamplingProfiler;
+#else
+    using ProfilerImplementation = nx::monitoring::SamplingProfiler;
+#endif
+
+namespace nx::monitoring {
+
+namespace {
+
+/** The folded format uses ';' as the frame separator and a line per stack. */
+QByteArray toFoldedName(QString name)
+{
+    name.replace(';', ':');
+    name.replace('\n', ' ');
+    return name.toUtf8();
+}
+
+} // namespace
+
+bool SamplingProfiler::start(const Settings& /*settings*/)
+{
+    return false;
+}
+
+bool SamplingProfiler::isRunning() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_running;
+}
+
+QByteArray SamplingProfiler::foldedStacks() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    QByteArray result;
+    for (auto it = m_sampleCountByStack.cbegin(); it != m_sampleCountByStack.cend(); ++it)
+    {
+        result += toFoldedName(it.key().threadName);
+        for (auto frame = it.key().frames.crbegin(); frame != it.key().frames.crend(); ++frame)
+        {
+            auto name = m_symbolNameCache.find(*frame);
+            if (name == m_symbolNameCache.end())
+                name = m_symbolNameCache.insert(*frame, symbolName(*frame));
+
+            result += ';' + toFoldedName(*name);
+        }
+        result += ' ' + QByteArray::number(it.value()) + '\n';
+    }
+
+    if (m_droppedSampleCount > 0)
+        result += "[dropped] " + QByteArray::number(m_droppedSampleCount) + '\n';
+
+    return result;
+}
+
+int SamplingProfiler::sampleCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_sampleCount;
+}
+
+void SamplingProfiler::reset()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_sampleCountByStack.clear();
+    m_sampleCount = 0;
+    m_droppedSampleCount = 0;
+}
+
+std::map<QString, std::chrono::microseconds> SamplingProfiler::cpuTimeByThreadName(
+    const std::vector<ThreadCpuTime>& threadTimes)
+{
+    static const QRegularExpression kTrailingNumber("[\\s_#-]*\\d+$");
+
+    std::map<QString, std::chrono::microseconds> result;
+    for (const ThreadCpuTime& thread: threadTimes)
+    {
+        QString name = thread.name;
+        name.remove(kTrailingNumber);
+        result[name] += thread.cpuTime;
+    }
+    return result;
+}
+
+std::unique_ptr<SamplingProfiler> SamplingProfiler::createForCurrentPlatform()
+{
+    return std::make_unique<ProfilerImplementation>();
+}
+
+void SamplingProfiler::addSample(const QString& threadName, const quintptr* frames, int frameCount)
+{
+    Stack stack{threadName, std::vector<quintptr>(frames, frames + frameCount)};
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    ++m_sampleCount;
+
+    if (const auto it = m_sampleCountByStack.find(stack); it != m_sampleCountByStack.end())
+    {
+        ++*it;
+        return;
+    }
+
+    if (m_sampleCountByStack.size() >= m_settings.maxDistinctStacks)
+    {
+        ++m_droppedSampleCount;
+        return;
+    }
+
+    m_sampleCountByStack.insert(std::move(stack), 1);
+}
+
+QString SamplingProfiler::symbolName(quintptr address) const
+{
+    return QString("0x%1").arg(address, 0, 16);
+}
+
+SamplingProfiler::Settings SamplingProfiler::settings() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_settings;
+}
+
+void SamplingProfiler::setRunning(bool running, const Settings& settings)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_running = running;
+    if (running)
+        m_settings = settings;
+}
+
+} // namespace nx::monitoring
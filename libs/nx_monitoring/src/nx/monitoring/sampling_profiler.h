@@ -0,0 +1,128 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::monitoring {
+
+/**
+ * In-process sampling profiler, cheap enough to be kept running in production. Periodically
+ * samples the stacks of the threads which consume CPU and aggregates them into flame graph data.
+ * Also reports the CPU time consumed by each thread of the process, which does not need the
+ * sampling to be started.
+ */
+class NX_MONITORING_API SamplingProfiler
+{
+public:
+    struct Settings
+    {
+        /**
+         * Samples per second of CPU time of a thread. The default one is low enough to keep the
+         * overhead negligible, and does not run in lockstep with the timers of the application.
+         */
+        int samplingFrequencyHz = 49;
+
+        /** Deeper frames are cut off. */
+        int maxStackDepth = 64;
+
+        /** Samples of the new distinct stacks are only counted when this limit is reached. */
+        int maxDistinctStacks = 20000;
+    };
+
+    struct ThreadCpuTime
+    {
+        quint64 threadId = 0;
+        QString name;
+        std::chrono::microseconds cpuTime{0}; //< Both user and kernel time.
+    };
+
+    SamplingProfiler() = default;
+    virtual ~SamplingProfiler() = default;
+
+    /**
+     * Starts sampling in a dedicated thread, the previously collected samples are kept.
+     * @return False if the stack sampling is not supported on the platform or is not permitted.
+     */
+    virtual bool start(const Settings& settings = Settings());
+
+    virtual void stop() {}
+
+    bool isRunning() const;
+
+    /**
+     * @return The stacks sampled since the start or the last reset, in the folded format used by
+     *     the flame graph tools (flamegraph.pl, speedscope, etc.): a line per distinct stack,
+     *     `threadName;outermostFrame;...;innermostFrame sampleCount`.
+     */
+    QByteArray foldedStacks() const;
+
+    int sampleCount() const;
+    void reset();
+
+    /** @return CPU time consumed by each thread of the process since the thread has started. */
+    virtual std::vector<ThreadCpuTime> threadCpuTimes() const { return {}; }
+
+    /**
+     * Sums the CPU time of the threads with the same name, ignoring the trailing numbers, so the
+     * threads of a pool (e.g. "AioThread-1", "AioThread-2") are reported together.
+     */
+    static std::map<QString, std::chrono::microseconds> cpuTimeByThreadName(
+        const std::vector<ThreadCpuTime>& threadTimes);
+
+    /**
+     * @return Profiler of the current platform. The full stacks are sampled on Linux only, on
+     * Windows only the innermost frames are sampled, on the other platforms nothing is sampled.
+     */
+    static std::unique_ptr<SamplingProfiler> createForCurrentPlatform();
+
+protected:
+    /**
+     * Called by the platform implementation from its sampling thread.
+     * @param frames Return addresses, the innermost frame first.
+     */
+    void addSample(const QString& threadName, const quintptr* frames, int frameCount);
+
+    /** @return Human-readable name of the function containing the address. */
+    virtual QString symbolName(quintptr address) const;
+
+    Settings settings() const;
+    void setRunning(bool running, const Settings& settings = Settings());
+
+private:
+    struct Stack
+    {
+        QString threadName;
+        std::vector<quintptr> frames;
+
+        bool operator==(const Stack& other) const
+        {
+            return threadName == other.threadName && frames == other.frames;
+        }
+
+        friend size_t qHash(const Stack& stack, size_t seed = 0)
+        {
+            return qHashRange(
+                stack.frames.begin(), stack.frames.end(), qHash(stack.threadName, seed));
+        }
+    };
+
+    mutable nx::Mutex m_mutex;
+    Settings m_settings;
+    bool m_running = false;
+    QHash<Stack, int> m_sampleCountByStack;
+    int m_sampleCount = 0;
+    int m_droppedSampleCount = 0;
+    mutable QHash<quintptr, QString> m_symbolNameCache;
+};
+
+} // namespace nx::monitoring
@@ -0,0 +1,371 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "sampling_profiler_linux.h"
+
+#include <cstring>
+#include <set>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <nx/utils/log/log.h>
+#include <nx/utils/system_error.h>
+#include <nx/utils/thread/thread_util.h>
+
+namespace nx::monitoring {
+
+namespace {
+
+using namespace std::chrono;
+
+static constexpr milliseconds kReadInterval = 100ms;
+static constexpr milliseconds kThreadListUpdateInterval = 1s;
+
+/** Must be a power of 2. Enough for several seconds of samples at the default frequency. */
+static constexpr size_t kDataPageCount = 8;
+
+size_t pageSize()
+{
+    static const size_t size = (size_t) sysconf(_SC_PAGESIZE);
+    return size;
+}
+
+size_t bufferSize()
+{
+    // The first page is the header of the ring buffer.
+    return (1 + kDataPageCount) * pageSize();
+}
+
+int openPerfEvent(pid_t threadId, const SamplingProfiler::Settings& settings)
+{
+    perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_SOFTWARE;
+    attributes.config = PERF_COUNT_SW_TASK_CLOCK; //< Ticks only while the thread is running.
+    attributes.freq = 1;
+    attributes.sample_freq = (uint64_t) settings.samplingFrequencyHz;
+    attributes.sample_type = PERF_SAMPLE_TID | PERF_SAMPLE_CALLCHAIN;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.exclude_callchain_kernel = 1;
+    attributes.wakeup_events = 1;
+
+    return (int) syscall(
+        __NR_perf_event_open, &attributes, threadId, /*cpu*/ -1, /*groupFd*/ -1,
+        PERF_FLAG_FD_CLOEXEC);
+}
+
+pid_t currentThreadId()
+{
+    return (pid_t) syscall(SYS_gettid);
+}
+
+std::set<pid_t> threadIds()
+{
+    std::set<pid_t> result;
+    const auto entries = QDir("/proc/self/task").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& entry: entries)
+    {
+        bool ok = false;
+        const pid_t id = (pid_t) entry.toInt(&ok);
+        if (ok)
+            result.insert(id);
+    }
+    return result;
+}
+
+QString threadName(pid_t threadId)
+{
+    QFile file(QString("/proc/self/task/%1/comm").arg(threadId));
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+
+    return QString::fromUtf8(file.readAll()).trimmed();
+}
+
+/** Copies the data from the ring buffer, which may wrap around its end. */
+void copyFromRingBuffer(const char* data, size_t dataSize, uint64_t offset, void* target,
+    size_t size)
+{
+    const size_t start = (size_t) (offset & (dataSize - 1));
+    const size_t firstPartSize = std::min(size, dataSize - start);
+    memcpy(target, data + start, firstPartSize);
+    memcpy((char*) target + firstPartSize, data, size - firstPartSize);
+}
+
+} // namespace
+
+LinuxSamplingProfiler::~LinuxSamplingProfiler()
+{
+    stop();
+}
+
+bool LinuxSamplingProfiler::start(const Settings& settings)
+{
+    if (isRunning())
+        return true;
+
+    // Check that the sampling is permitted before starting the thread.
+    const int fd = openPerfEvent(currentThreadId(), settings);
+    if (fd < 0)
+    {
+        NX_WARNING(this, "Unable to start sampling, perf_event_open() failed: %1. Check "
+            "/proc/sys/kernel/perf_event_paranoid.", SystemError::getLastOSErrorText());
+        return false;
+    }
+    ::close(fd);
+
+    NX_INFO(this, "Starting sampling at %1 Hz", settings.samplingFrequencyHz);
+    m_needStop = false;
+    setRunning(true, settings);
+    m_thread = std::thread([this, settings]() { run(settings); });
+    return true;
+}
+
+void LinuxSamplingProfiler::stop()
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_threadMutex);
+        m_needStop = true;
+        m_threadCondition.wakeAll();
+    }
+
+    if (!m_thread.joinable())
+        return;
+
+    m_thread.join();
+    setRunning(false);
+    NX_INFO(this, "Sampling is stopped, %1 samples collected", sampleCount());
+}
+
+std::vector<SamplingProfiler::ThreadCpuTime> LinuxSamplingProfiler::threadCpuTimes() const
+{
+    static const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+
+    std::vector<ThreadCpuTime> result;
+    for (const pid_t threadId: threadIds())
+    {
+        QFile file(QString("/proc/self/task/%1/stat").arg(threadId));
+        if (!file.open(QIODevice::ReadOnly))
+            continue; //< The thread has exited.
+
+        // The thread name in the 2nd field may contain spaces and parentheses, the fields after
+        // it start from the state.
+        const QByteArray stat = file.readAll();
+        const int nameEnd = stat.lastIndexOf(')');
+        if (nameEnd < 0)
+            continue;
+
+        const QList<QByteArray> fields = stat.mid(nameEnd + 2).split(' ');
+        static constexpr int kUserTimeIndex = 11; //< utime, the 14th field.
+        static constexpr int kSystemTimeIndex = 12; //< stime, the 15th field.
+        if (fields.size() <= kSystemTimeIndex)
+            continue;
+
+        const quint64 ticks =
+            fields[kUserTimeIndex].toULongLong() + fields[kSystemTimeIndex].toULongLong();
+        result.push_back({
+            (quint64) threadId,
+            threadName(threadId),
+            microseconds(ticks * 1'000'000 / (quint64) ticksPerSecond)});
+    }
+    return result;
+}
+
+QString LinuxSamplingProfiler::symbolName(quintptr address) const
+{
+    Dl_info info;
+    if (dladdr((void*) address, &info) == 0)
+        return base_type::symbolName(address);
+
+    if (info.dli_sname)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        const QString name = QString::fromUtf8(status == 0 ? demangled : info.dli_sname);
+        free(demangled);
+        return name;
+    }
+
+    // Not exported symbol, the module offset can be resolved offline with addr2line.
+    if (info.dli_fname)
+    {
+        return QString("%1+0x%2").arg(QFileInfo(info.dli_fname).fileName())
+            .arg(address - (quintptr) info.dli_fbase, 0, 16);
+    }
+
+    return base_type::symbolName(address);
+}
+
+void LinuxSamplingProfiler::run(Settings settings)
+{
+    nx::utils::setCurrentThreadName("SamplingProfiler");
+    m_samplingThreadId = currentThreadId();
+
+    auto lastThreadListUpdate = steady_clock::now();
+    updateThreadEvents(settings);
+
+    NX_MUTEX_LOCKER lock(&m_threadMutex);
+    while (!m_needStop)
+    {
+        m_threadCondition.wait(lock.mutex(), kReadInterval);
+        if (m_needStop)
+            break;
+
+        lock.unlock();
+        for (auto& [threadId, event]: m_eventsByThreadId)
+            readSamples(&event, settings);
+
+        if (steady_clock::now() - lastThreadListUpdate >= kThreadListUpdateInterval)
+        {
+            updateThreadEvents(settings);
+            lastThreadListUpdate = steady_clock::now();
+        }
+        lock.relock();
+    }
+    lock.unlock();
+
+    for (auto& [threadId, event]: m_eventsByThreadId)
+    {
+        readSamples(&event, settings);
+        closeThreadEvent(&event);
+    }
+    m_eventsByThreadId.clear();
+}
+
+void LinuxSamplingProfiler::updateThreadEvents(const Settings& settings)
+{
+    const std::set<pid_t> currentThreadIds = threadIds();
+
+    for (auto it = m_eventsByThreadId.begin(); it != m_eventsByThreadId.end();)
+    {
+        if (currentThreadIds.count(it->first))
+        {
+            // The threads are often named after they are started.
+            it->second.threadName = threadName(it->first);
+            ++it;
+            continue;
+        }
+
+        readSamples(&it->second, settings);
+        closeThreadEvent(&it->second);
+        it = m_eventsByThreadId.erase(it);
+    }
+
+    for (const pid_t threadId: currentThreadIds)
+    {
+        if (threadId != m_samplingThreadId && !m_eventsByThreadId.count(threadId))
+            openThreadEvent(threadId, settings);
+    }
+}
+
+bool LinuxSamplingProfiler::openThreadEvent(pid_t threadId, const Settings& settings)
+{
+    const int fd = openPerfEvent(threadId, settings);
+    if (fd < 0)
+    {
+        NX_VERBOSE(this, "Unable to sample thread %1: %2",
+            threadId, SystemError::getLastOSErrorText());
+        return false; //< The thread may have exited already.
+    }
+
+    void* buffer = mmap(nullptr, bufferSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (buffer == MAP_FAILED)
+    {
+        NX_DEBUG(this, "Unable to map the sample buffer of thread %1: %2",
+            threadId, SystemError::getLastOSErrorText());
+        ::close(fd);
+        return false;
+    }
+
+    m_eventsByThreadId[threadId] = ThreadEvent{fd, buffer, threadName(threadId)};
+    return true;
+}
+
+void LinuxSamplingProfiler::closeThreadEvent(ThreadEvent* event)
+{
+    if (event->buffer)
+        munmap(event->buffer, bufferSize());
+    if (event->fd >= 0)
+        ::close(event->fd);
+
+    event->buffer = nullptr;
+    event->fd = -1;
+}
+
+void LinuxSamplingProfiler::readSamples(ThreadEvent* event, const Settings& settings)
+{
+    auto header = (perf_event_mmap_page*) event->buffer;
+    const char* data = (const char*) event->buffer + pageSize();
+    const size_t dataSize = kDataPageCount * pageSize();
+
+    const uint64_t head = __atomic_load_n(&header->data_head, __ATOMIC_ACQUIRE);
+    uint64_t tail = header->data_tail;
+
+    std::vector<char> record;
+    std::vector<quintptr> frames;
+    frames.reserve((size_t) settings.maxStackDepth);
+
+    while (tail < head)
+    {
+        perf_event_header recordHeader;
+        copyFromRingBuffer(data, dataSize, tail, &recordHeader, sizeof(recordHeader));
+        if (recordHeader.size < sizeof(recordHeader) || tail + recordHeader.size > head)
+        {
+            NX_DEBUG(this, "Corrupted sample record of thread %1", event->threadName);
+            tail = head;
+            break;
+        }
+
+        if (recordHeader.type == PERF_RECORD_SAMPLE)
+        {
+            record.resize(recordHeader.size);
+            copyFromRingBuffer(data, dataSize, tail, record.data(), record.size());
+
+            // The layout follows the sample type: u32 pid, u32 tid, u64 nr, u64 ips[nr].
+            const char* sample = record.data() + sizeof(recordHeader) + 2 * sizeof(uint32_t);
+            const char* const end = record.data() + record.size();
+
+            uint64_t ipCount = 0;
+            if (sample + sizeof(ipCount) <= end)
+            {
+                memcpy(&ipCount, sample, sizeof(ipCount));
+                sample += sizeof(ipCount);
+            }
+
+            frames.clear();
+            bool isInnermostFrame = true;
+            for (uint64_t i = 0; i < ipCount && sample + sizeof(uint64_t) <= end
+                && (int) frames.size() < settings.maxStackDepth; ++i, sample += sizeof(uint64_t))
+            {
+                uint64_t ip = 0;
+                memcpy(&ip, sample, sizeof(ip));
+                if (ip >= PERF_CONTEXT_MAX)
+                    continue; //< A context marker, not an address.
+
+                // The return addresses point after the call, which may already be the next
+                // function.
+                frames.push_back((quintptr) (isInnermostFrame ? ip : ip - 1));
+                isInnermostFrame = false;
+            }
+
+            if (!frames.empty())
+                addSample(event->threadName, frames.data(), (int) frames.size());
+        }
+
+        tail += recordHeader.size;
+    }
+
+    __atomic_store_n(&header->data_tail, tail, __ATOMIC_RELEASE);
+}
+
+} // namespace nx::monitoring
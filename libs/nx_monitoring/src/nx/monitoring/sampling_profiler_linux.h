@@ -0,0 +1,63 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <thread>
+
+#include <sys/types.h>
+
+#include "sampling_profiler.h"
+
+namespace nx::monitoring {
+
+/**
+ * Samples the threads via perf_event_open(): each thread gets a task clock event, so only the
+ * threads which consume CPU are sampled, and the kernel writes the user-space call chains to a
+ * ring buffer which is read periodically. The call chains are collected via the frame pointers,
+ * so the code built without them produces shorter stacks. The sampling is not permitted if
+ * /proc/sys/kernel/perf_event_paranoid is greater than 2.
+ */
+class NX_MONITORING_API LinuxSamplingProfiler: public SamplingProfiler
+{
+    using base_type = SamplingProfiler;
+
+public:
+    LinuxSamplingProfiler() = default;
+    virtual ~LinuxSamplingProfiler() override;
+
+    virtual bool start(const Settings& settings = Settings()) override;
+    virtual void stop() override;
+
+    virtual std::vector<ThreadCpuTime> threadCpuTimes() const override;
+
+protected:
+    virtual QString symbolName(quintptr address) const override;
+
+private:
+    struct ThreadEvent
+    {
+        int fd = -1;
+        void* buffer = nullptr;
+        QString threadName;
+    };
+
+    void run(Settings settings);
+    void updateThreadEvents(const Settings& settings);
+    bool openThreadEvent(pid_t threadId, const Settings& settings);
+    void closeThreadEvent(ThreadEvent* event);
+    void readSamples(ThreadEvent* event, const Settings& settings);
+
+private:
+    nx::Mutex m_threadMutex;
+    nx::WaitCondition m_threadCondition;
+    bool m_needStop = false;
+    std::thread m_thread;
+
+    // Accessed from the sampling thread only.
+    std::map<pid_t, ThreadEvent> m_eventsByThreadId;
+    pid_t m_samplingThreadId = 0;
+};
+
+} // namespace nx::monitoring
@@ -0,0 +1,234 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "sampling_profiler_win.h"
+
+#include <windows.h>
+#include <tlhelp32.h>
+#include <dbghelp.h>
+
+#include <nx/utils/log/log.h>
+#include <nx/utils/scope_guard.h>
+#include <nx/utils/system_error.h>
+#include <nx/utils/thread/thread_util.h>
+
+namespace nx::monitoring {
+
+namespace {
+
+using namespace std::chrono;
+
+std::vector<DWORD> threadIds()
+{
+    std::vector<DWORD> result;
+    const HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE)
+        return result;
+
+    const auto snapshotGuard = nx::utils::makeScopeGuard([snapshot]() { CloseHandle(snapshot); });
+
+    const DWORD processId = GetCurrentProcessId();
+    THREADENTRY32 entry;
+    entry.dwSize = sizeof(entry);
+    for (BOOL found = Thread32First(snapshot, &entry); found;
+        found = Thread32Next(snapshot, &entry))
+    {
+        if (entry.th32OwnerProcessID == processId)
+            result.push_back(entry.th32ThreadID);
+    }
+    return result;
+}
+
+microseconds threadCpuTime(HANDLE thread)
+{
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(thread, &creationTime, &exitTime, &kernelTime, &userTime))
+        return microseconds::zero();
+
+    const auto toUint64 =
+        [](const FILETIME& time)
+        {
+            return ((quint64) time.dwHighDateTime << 32) | time.dwLowDateTime;
+        };
+
+    // FILETIME is in 100 ns units.
+    return microseconds((toUint64(kernelTime) + toUint64(userTime)) / 10);
+}
+
+QString threadName(HANDLE thread)
+{
+    // GetThreadDescription() is available since Windows 10 1607.
+    using GetThreadDescriptionFunction = HRESULT (WINAPI*)(HANDLE, PWSTR*);
+    static const auto getThreadDescription = (GetThreadDescriptionFunction) GetProcAddress(
+        GetModuleHandleW(L"kernel32.dll"), "GetThreadDescription");
+    if (!getThreadDescription)
+        return QString();
+
+    PWSTR description = nullptr;
+    if (FAILED(getThreadDescription(thread, &description)))
+        return QString();
+
+    const QString name = QString::fromWCharArray(description);
+    LocalFree(description);
+    return name;
+}
+
+} // namespace
+
+WindowsSamplingProfiler::WindowsSamplingProfiler() = default;
+
+WindowsSamplingProfiler::~WindowsSamplingProfiler()
+{
+    stop();
+
+    NX_MUTEX_LOCKER lock(&m_symbolMutex);
+    if (m_symbolsInitialized)
+        SymCleanup(GetCurrentProcess());
+}
+
+bool WindowsSamplingProfiler::start(const Settings& settings)
+{
+    if (isRunning())
+        return true;
+
+    NX_INFO(this, "Starting sampling at %1 Hz", settings.samplingFrequencyHz);
+    m_needStop = false;
+    setRunning(true, settings);
+    m_thread = std::thread([this, settings]() { run(settings); });
+    return true;
+}
+
+void WindowsSamplingProfiler::stop()
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_threadMutex);
+        m_needStop = true;
+        m_threadCondition.wakeAll();
+    }
+
+    if (!m_thread.joinable())
+        return;
+
+    m_thread.join();
+    setRunning(false);
+    NX_INFO(this, "Sampling is stopped, %1 samples collected", sampleCount());
+}
+
+std::vector<SamplingProfiler::ThreadCpuTime> WindowsSamplingProfiler::threadCpuTimes() const
+{
+    std::vector<ThreadCpuTime> result;
+    for (const DWORD threadId: threadIds())
+    {
+        const HANDLE thread = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, threadId);
+        if (!thread)
+            continue; //< The thread has exited.
+
+        result.push_back({threadId, threadName(thread), threadCpuTime(thread)});
+        CloseHandle(thread);
+    }
+    return result;
+}
+
+QString WindowsSamplingProfiler::symbolName(quintptr address) const
+{
+    NX_MUTEX_LOCKER lock(&m_symbolMutex);
+
+    const HANDLE process = GetCurrentProcess();
+    if (!m_symbolsInitialized)
+    {
+        SymSetOptions(SymGetOptions() | SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS);
+        const_cast<WindowsSamplingProfiler*>(this)->m_symbolsInitialized =
+            SymInitialize(process, nullptr, TRUE);
+        if (!m_symbolsInitialized)
+            return base_type::symbolName(address);
+    }
+
+    char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+    auto symbol = (SYMBOL_INFO*) buffer;
+    symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+    symbol->MaxNameLen = MAX_SYM_NAME;
+
+    DWORD64 displacement = 0;
+    if (!SymFromAddr(process, (DWORD64) address, &displacement, symbol))
+        return base_type::symbolName(address);
+
+    return QString::fromLatin1(symbol->Name, (int) symbol->NameLen);
+}
+
+void WindowsSamplingProfiler::run(Settings settings)
+{
+    nx::utils::setCurrentThreadName("SamplingProfiler");
+    m_samplingThreadId = GetCurrentThreadId();
+
+    // The threads are checked more often than the sampling frequency, because only the threads
+    // which have been running since the previous check are sampled.
+    const auto interval = milliseconds(1000 / std::max(1, settings.samplingFrequencyHz));
+
+    NX_MUTEX_LOCKER lock(&m_threadMutex);
+    while (!m_needStop)
+    {
+        m_threadCondition.wait(lock.mutex(), interval);
+        if (m_needStop)
+            break;
+
+        lock.unlock();
+        sampleThreads();
+        lock.relock();
+    }
+
+    m_lastCpuTimeByThreadId.clear();
+}
+
+void WindowsSamplingProfiler::sampleThreads()
+{
+    std::map<quint64, microseconds> cpuTimeByThreadId;
+    for (const DWORD threadId: threadIds())
+    {
+        if (threadId == m_samplingThreadId)
+            continue;
+
+        const HANDLE thread = OpenThread(
+            THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_LIMITED_INFORMATION,
+            FALSE, threadId);
+        if (!thread)
+            continue;
+
+        const auto threadGuard = nx::utils::makeScopeGuard([thread]() { CloseHandle(thread); });
+
+        const microseconds cpuTime = threadCpuTime(thread);
+        cpuTimeByThreadId[threadId] = cpuTime;
+
+        const auto lastCpuTime = m_lastCpuTimeByThreadId.find(threadId);
+        if (lastCpuTime == m_lastCpuTimeByThreadId.end() || lastCpuTime->second == cpuTime)
+            continue; //< The thread has not been running.
+
+        if (SuspendThread(thread) == (DWORD) -1)
+            continue;
+
+        CONTEXT context;
+        memset(&context, 0, sizeof(context));
+        context.ContextFlags = CONTEXT_CONTROL;
+        const bool contextReceived = GetThreadContext(thread, &context);
+        ResumeThread(thread);
+
+        if (!contextReceived)
+        {
+            NX_VERBOSE(this, "Unable to get the context of thread %1: %2",
+                threadId, SystemError::getLastOSErrorText());
+            continue;
+        }
+
+        #if defined(_M_X64)
+            const quintptr frame = (quintptr) context.Rip;
+        #elif defined(_M_ARM64)
+            const quintptr frame = (quintptr) context.Pc;
+        #else
+            const quintptr frame = (quintptr) context.Eip;
+        #endif
+
+        addSample(threadName(thread), &frame, 1);
+    }
+
+    m_lastCpuTimeByThreadId = std::move(cpuTimeByThreadId);
+}
+
+} // namespace nx::monitoring
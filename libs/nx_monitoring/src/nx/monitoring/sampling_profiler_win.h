@@ -0,0 +1,53 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <map>
+#include <thread>
+
+#include "sampling_profiler.h"
+
+namespace nx::monitoring {
+
+/**
+ * Samples the threads by suspending them for a moment and reading the instruction pointer. Only
+ * the threads which have consumed CPU time since the previous sample are suspended. The stacks
+ * are not unwound, because walking the stack of a suspended thread may deadlock on the loader or
+ * heap locks it holds, so the flame graph has a single frame per thread. The full call stacks
+ * need ETW, which requires administrative rights and a system-wide kernel session.
+ */
+class NX_MONITORING_API WindowsSamplingProfiler: public SamplingProfiler
+{
+    using base_type = SamplingProfiler;
+
+public:
+    WindowsSamplingProfiler();
+    virtual ~WindowsSamplingProfiler() override;
+
+    virtual bool start(const Settings& settings = Settings()) override;
+    virtual void stop() override;
+
+    virtual std::vector<ThreadCpuTime> threadCpuTimes() const override;
+
+protected:
+    virtual QString symbolName(quintptr address) const override;
+
+private:
+    void run(Settings settings);
+    void sampleThreads();
+
+private:
+    nx::Mutex m_threadMutex;
+    nx::WaitCondition m_threadCondition;
+    bool m_needStop = false;
+    std::thread m_thread;
+
+    // Accessed from the sampling thread only.
+    std::map<quint64, std::chrono::microseconds> m_lastCpuTimeByThreadId;
+    quint64 m_samplingThreadId = 0;
+
+    mutable nx::Mutex m_symbolMutex; //< DbgHelp functions are not thread-safe.
+    bool m_symbolsInitialized = false;
+};
+
+} // namespace nx::monitoring
@@ -0,0 +1,194 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <csignal>
+#include <iostream>
+
+#include <QtCore/QCoreApplication>
+
+#include <nx/network/cloud/cloud_connect_controller.h>
+#include <nx/network/cloud/mediator_connector.h>
+#include <nx/network/cloud/speed_test/benchmark/benchmark_client.h>
+#include <nx/network/cloud/speed_test/benchmark/benchmark_server.h>
+#include <nx/network/socket_global.h>
+#include <nx/network/ssl/certificate.h>
+#include <nx/reflect/string_conversion.h>
+#include <nx/utils/argument_parser.h>
+#include <nx/utils/log/log_initializer.h>
+#include <nx/utils/std/future.h>
+#include <nx/utils/timer_manager.h>
+
+using namespace nx::network;
+using namespace nx::network::cloud::speed_test::benchmark;
+
+static nx::utils::promise<void> stopPromise;
+
+static void printHelp(std::ostream* output)
+{
+    (*output) <<
+        "Measures the throughput, round trip time and connection setup time of a transport."
+            << std::endl <<
+        std::endl <<
+        "Usage:" << std::endl <<
+        "  nx_network_benchmark server [options]" << std::endl <<
+        "  nx_network_benchmark client --server={endpoint} [options]" << std::endl <<
+        std::endl <<
+        "Common options:" << std::endl <<
+        "  --transport={tcp|ssl|udt|relay|httpTunnel}  By default, tcp" << std::endl <<
+        std::endl <<
+        "Server options:" << std::endl <<
+        "  --endpoint={endpoint}            The local endpoint to listen on. By default,"
+            << std::endl <<
+        "                                   0.0.0.0:0" << std::endl <<
+        "  --cloud-system-id={id}           The system to listen on for relay" << std::endl <<
+        "  --cloud-auth-key={key}           The cloud authentication key of the system"
+            << std::endl <<
+        std::endl <<
+        "Client options:" << std::endl <<
+        "  --server={endpoint}              The server endpoint. The system id for relay"
+            << std::endl <<
+        "  --payload-size={bytes}           The size of a message. By default, 4096"
+            << std::endl <<
+        "  --concurrency={count}            The number of connections. By default, 1"
+            << std::endl <<
+        "  --messages-in-flight={count}     The messages sent over a connection without "
+            "waiting" << std::endl <<
+        "                                   for the echo. By default, 1" << std::endl <<
+        "  --duration={duration}            By default, 10s" << std::endl <<
+        "  --connect-timeout={duration}     By default, 10s" << std::endl <<
+        std::endl <<
+        "Cloud connect options:" << std::endl;
+    cloud::CloudConnectController::printArgumentsHelp(output);
+    (*output) <<
+        "  Use --cloud-connect-enable-proxy-only for the client to benchmark the relay only."
+            << std::endl;
+}
+
+static std::optional<Transport> transport(const nx::ArgumentParser& arguments)
+{
+    const auto value = arguments.get<std::string>("transport");
+    if (!value)
+        return Transport::tcp;
+
+    bool ok = false;
+    const auto result = nx::reflect::fromString<Transport>(*value, &ok);
+    if (!ok)
+        return std::nullopt;
+    return result;
+}
+
+static int runServer(const nx::ArgumentParser& arguments, Transport transport)
+{
+    if (transport == Transport::ssl)
+        ssl::useRandomCertificate("nx_network_benchmark");
+
+    if (transport == Transport::relay)
+    {
+        const auto systemId = arguments.get<std::string>("cloud-system-id");
+        const auto authKey = arguments.get<std::string>("cloud-auth-key");
+        if (!systemId || !authKey)
+        {
+            std::cerr << "--cloud-system-id and --cloud-auth-key are required for relay"
+                << std::endl;
+            return 1;
+        }
+
+        SocketGlobals::cloud().mediatorConnector().setSystemCredentials(
+            nx::hpm::api::SystemCredentials(*systemId, "benchmark", *authKey));
+    }
+
+    BenchmarkServer server(transport);
+    if (!server.listen(SocketAddress(
+        arguments.get<std::string>("endpoint").value_or(SocketAddress::anyAddress.toString()))))
+    {
+        std::cerr << "Failed to listen. " << SystemError::getLastOSErrorText() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Listening on " << server.address().toString() << " over "
+        << nx::reflect::toString(transport) << ". Press Ctrl+C to stop." << std::endl;
+
+    stopPromise.get_future().wait();
+
+    std::cout << "Connections accepted: " << server.echoServer().totalConnectionsAccepted()
+        << ", bytes echoed: " << server.echoServer().totalBytesEchoed() << std::endl;
+    return 0;
+}
+
+static int runClient(const nx::ArgumentParser& arguments, Transport transport)
+{
+    BenchmarkSettings settings;
+    settings.transport = transport;
+
+    const auto server = arguments.get<std::string>("server");
+    if (!server)
+    {
+        std::cerr << "--server is required" << std::endl;
+        return 1;
+    }
+    settings.serverAddress = SocketAddress(*server);
+
+    settings.payloadSize = arguments.get<int>("payload-size").value_or(settings.payloadSize);
+    settings.concurrency = arguments.get<int>("concurrency").value_or(settings.concurrency);
+    settings.messagesInFlight =
+        arguments.get<int>("messages-in-flight").value_or(settings.messagesInFlight);
+    if (const auto value = arguments.get<std::string>("duration"))
+        settings.duration = nx::utils::parseTimerDuration(*value, settings.duration);
+    if (const auto value = arguments.get<std::string>("connect-timeout"))
+        settings.connectTimeout = nx::utils::parseTimerDuration(*value, settings.connectTimeout);
+
+    if (settings.payloadSize == 0 || settings.concurrency <= 0 || settings.messagesInFlight <= 0)
+    {
+        std::cerr << "--payload-size, --concurrency and --messages-in-flight must be positive"
+            << std::endl;
+        return 1;
+    }
+
+    BenchmarkClient client(settings);
+    nx::utils::promise<BenchmarkResult> done;
+    client.start([&done](BenchmarkResult result) { done.set_value(std::move(result)); });
+
+    const auto result = done.get_future().get();
+    std::cout << result.toString() << std::endl;
+
+    return result.connectionsEstablished > 0 ? 0 : 1;
+}
+
+int main(int argc, const char* argv[])
+{
+    QCoreApplication app(argc, (char**) argv); //< Required for loading TLS plugins in Qt6.
+
+    const nx::ArgumentParser arguments(argc, argv);
+    const auto mode = arguments.getPositionalArgs();
+    if (arguments.contains("help") || arguments.contains("h") || mode.empty())
+    {
+        printHelp(&std::cout);
+        return mode.empty() ? 1 : 0;
+    }
+
+    const auto selectedTransport = transport(arguments);
+    if (!selectedTransport)
+    {
+        std::cerr << "Unknown transport" << std::endl;
+        return 1;
+    }
+
+    nx::log::initializeGlobally(arguments);
+    SocketGlobals::InitGuard socketGlobals(arguments);
+
+    std::signal(
+        SIGINT,
+        [](int)
+        {
+            std::signal(SIGINT, SIG_DFL); //< The second Ctrl+C terminates the process.
+            stopPromise.set_value();
+        });
+
+    const auto command = mode.front().toStdString();
+    if (command == "server")
+        return runServer(arguments, *selectedTransport);
+    if (command == "client")
+        return runClient(arguments, *selectedTransport);
+
+    printHelp(&std::cerr);
+    return 1;
+}
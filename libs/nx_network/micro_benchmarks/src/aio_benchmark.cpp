@@ -0,0 +1,69 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <benchmark/benchmark.h>
+
+#include <nx/network/aio/basic_pollable.h>
+#include <nx/network/aio/timer.h>
+#include <nx/utils/std/future.h>
+
+namespace nx::network::aio::test {
+
+/**
+ * Posts state.range(0) calls to the same AIO thread and waits for the last one.
+ */
+static void Aio_post(benchmark::State& state)
+{
+    const int count = (int) state.range(0);
+
+    BasicPollable pollable;
+    for (auto _: state)
+    {
+        nx::utils::promise<void> done;
+        int executed = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            pollable.post(
+                [&executed, &done, count]()
+                {
+                    if (++executed == count)
+                        done.set_value();
+                });
+        }
+        done.get_future().wait();
+    }
+    pollable.pleaseStopSync();
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(Aio_post)->Arg(10'000)->UseRealTime();
+
+/**
+ * Restarts a zero timeout timer state.range(0) times from its own handler.
+ */
+static void Aio_timer(benchmark::State& state)
+{
+    const int count = (int) state.range(0);
+
+    Timer timer;
+    for (auto _: state)
+    {
+        nx::utils::promise<void> done;
+        int remaining = count;
+        nx::utils::MoveOnlyFunc<void()> onTimer =
+            [&]()
+            {
+                if (--remaining == 0)
+                    done.set_value();
+                else
+                    timer.start(std::chrono::milliseconds::zero(), [&]() { onTimer(); });
+            };
+        timer.start(std::chrono::milliseconds::zero(), [&]() { onTimer(); });
+        done.get_future().wait();
+    }
+    timer.pleaseStopSync();
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(Aio_timer)->Arg(10'000)->UseRealTime();
+
+} // namespace nx::network::aio::test
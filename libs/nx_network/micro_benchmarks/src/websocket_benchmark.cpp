@@ -0,0 +1,76 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <benchmark/benchmark.h>
+
+#include <nx/network/websocket/websocket_parser.h>
+#include <nx/network/websocket/websocket_serializer.h>
+
+namespace nx::network::websocket::test {
+
+/**
+ * A client masks every payload byte of the frames it sends, and the server unmasks them.
+ */
+static void Websocket_prepareMaskedMessage(benchmark::State& state)
+{
+    const nx::Buffer payload((std::size_t) state.range(0), 'x');
+
+    Serializer serializer(/*masked*/ true, /*mask*/ 0x12345678);
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(
+            serializer.prepareMessage(payload, FrameType::binary, CompressionType::none));
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(Websocket_prepareMaskedMessage)->Arg(128)->Arg(64 * 1024);
+
+static void Websocket_parseMaskedMessage(benchmark::State& state)
+{
+    const nx::Buffer payload((std::size_t) state.range(0), 'x');
+
+    Serializer serializer(/*masked*/ true, /*mask*/ 0x12345678);
+    const nx::Buffer message =
+        serializer.prepareMessage(payload, FrameType::binary, CompressionType::none);
+
+    std::size_t receivedBytes = 0;
+    Parser parser(
+        Role::server,
+        [&receivedBytes](FrameType /*type*/, nx::Buffer&& frame, bool /*fin*/)
+        {
+            receivedBytes += frame.size();
+        });
+
+    for (auto _: state)
+    {
+        nx::Buffer data = message;
+        parser.consume(data);
+    }
+    benchmark::DoNotOptimize(receivedBytes);
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+BENCHMARK(Websocket_parseMaskedMessage)->Arg(128)->Arg(64 * 1024);
+
+static void Websocket_deflateRoundTrip(benchmark::State& state)
+{
+    const nx::Buffer message(
+        R"({"jsonrpc":"2.0","method":"update","params":{"id":"6f1dbd5a","status":"Online"}})");
+
+    Serializer serializer(/*masked*/ false);
+    Parser parser(
+        Role::client,
+        [](FrameType /*type*/, nx::Buffer&& frame, bool /*fin*/)
+        {
+            benchmark::DoNotOptimize(frame);
+        });
+
+    for (auto _: state)
+    {
+        auto frame = serializer.prepareMessage(
+            message, FrameType::text, CompressionType::perMessageDeflate);
+        parser.consume(frame);
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+BENCHMARK(Websocket_deflateRoundTrip);
+
+} // namespace nx::network::websocket::test
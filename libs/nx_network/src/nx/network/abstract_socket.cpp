@@ -54,6 +54,59 @@ int AbstractCommunicatingSocket::send(const nx::Buffer& data)
     return send(data.data(), data.size());
 }
 
+int AbstractCommunicatingSocket::sendGathered(
+    const std::string_view* buffers, std::size_t bufferCount)
+{
+    for (std::size_t i = 0; i < bufferCount; ++i)
+    {
+        if (!buffers[i].empty())
+            return send(buffers[i].data(), buffers[i].size());
+    }
+
+    return 0;
+}
+
+void AbstractCommunicatingSocket::sendGatheredAsync(
+    std::vector<const nx::Buffer*> buffers,
+    IoCompletionHandler handler)
+{
+    std::size_t totalSize = 0;
+    for (const auto& buffer: buffers)
+        totalSize += buffer->size();
+
+    auto data = std::make_unique<nx::Buffer>();
+    data->reserve(totalSize);
+    for (const auto& buffer: buffers)
+        data->append(buffer->data(), buffer->size());
+
+    const auto dataPtr = data.get();
+    sendAsync(
+        dataPtr,
+        [data = std::move(data), handler = std::move(handler)](
+            SystemError::ErrorCode resultCode, std::size_t bytesSent) mutable
+        {
+            data.reset();
+            handler(resultCode, bytesSent);
+        });
+}
+
+void AbstractCommunicatingSocket::sendGatheredAsync(
+    const nx::BufferChain* chain,
+    IoCompletionHandler handler)
+{
+    auto data = std::make_unique<nx::Buffer>(chain->toBuffer());
+
+    const auto dataPtr = data.get();
+    sendAsync(
+        dataPtr,
+        [data = std::move(data), handler = std::move(handler)](
+            SystemError::ErrorCode resultCode, std::size_t bytesSent) mutable
+        {
+            data.reset();
+            handler(resultCode, bytesSent);
+        });
+}
+
 std::string AbstractCommunicatingSocket::getForeignHostName() const
 {
     return getForeignAddress().address.toString();
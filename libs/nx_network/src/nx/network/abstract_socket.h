@@ -7,10 +7,13 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <nx/network/async_stoppable.h>
 #include <nx/utils/buffer.h>
 #include <nx/utils/move_only_func.h>
+#include <nx/utils/shared_buffer.h>
 #include <nx/utils/system_error.h>
 
 #include "aio/event_type.h"
@@ -338,6 +341,15 @@ public:
     virtual int send(const void* buffer, std::size_t bufferLen) = 0;
     int send(const nx::Buffer& data);
 
+    /**
+     * Gathering version of send(): writes data from several buffers in order.
+     * Partial write semantics are the same as of send().
+     * Default implementation sends the first non-empty buffer only. Implementations backed by an
+     * OS socket write all buffers with a single system call.
+     * @return number of bytes sent. -1 if failed to send something.
+     */
+    virtual int sendGathered(const std::string_view* buffers, std::size_t bufferCount);
+
     /**
      * @returns Host address/port of remote host socket has been connected to.
      * NOTE: If AbstractCommunicatingSocket::connect() has not been called yet,
@@ -389,6 +401,28 @@ public:
         const nx::Buffer* buffer,
         IoCompletionHandler handler) = 0;
 
+    /**
+     * Asynchronously writes all bytes from the given buffers in order as if they were a single
+     * buffer. Allows sending e.g. a header and a payload without concatenating them.
+     * @param buffers Calling party MUST guarantee that every buffer is alive until send completion.
+     * @param handler Same as in AbstractCommunicatingSocket::sendAsync. bytesWritten is the total
+     * number of bytes written from all buffers.
+     * Default implementation copies the buffers to a single one and invokes sendAsync.
+     */
+    virtual void sendGatheredAsync(
+        std::vector<const nx::Buffer*> buffers,
+        IoCompletionHandler handler);
+
+    /**
+     * Asynchronously writes all bytes of the chain. Same as the overload above, but the slices
+     * are passed to the gathering send call without copying them to separate buffers.
+     * @param chain Calling party MUST guarantee that chain is alive until send completion.
+     * Default implementation copies the chain to a single buffer and invokes sendAsync.
+     */
+    virtual void sendGatheredAsync(
+        const nx::BufferChain* chain,
+        IoCompletionHandler handler);
+
     /**
      * Register timer on this socket.
      * @param handler functor to be called
@@ -452,6 +486,9 @@ struct NX_NETWORK_API StreamSocketInfo
 {
     /** Round-trip time smoothed variation, millis. */
     unsigned int rttVar = 0;
+
+    /** true if TLS records of the connection are encrypted by the kernel. */
+    bool isTlsOffloaded = false;
 };
 
 /**
@@ -603,6 +640,24 @@ protected:
 
 static constexpr char BROADCAST_ADDRESS[] = "255.255.255.255";
 
+/**
+ * Datagram for batched I/O of AbstractDatagramSocket.
+ */
+struct Datagram
+{
+    /** Source address of a received datagram or destination address of a sent one. */
+    SocketAddress address;
+    nx::Buffer data;
+    /**
+     * If non-zero, data consists of several datagrams of this size (the last one may be
+     * shorter). When sending, the datagrams are split by the kernel (UDP GSO) or by the socket.
+     * When receiving, it is reported if the kernel has coalesced datagrams (UDP GRO).
+     */
+    std::size_t segmentSize = 0;
+    /** The received datagram did not fit into the buffer and has been truncated. */
+    bool truncated = false;
+};
+
 /**
  * Interface for connectionless socket. In this case AbstractCommunicatingSocket::connect() just
  * remembers the remote address to use with AbstractCommunicatingSocket::send().
@@ -690,6 +745,35 @@ public:
      */
     virtual SocketAddress lastDatagramSourceAddress() const = 0;
 
+    /**
+     * Reads the datagrams already queued in the socket. Never blocks. Up to datagrams->size()
+     * datagrams are read with as few system calls as possible (recvmmsg on Linux).
+     * Every datagram is read into the buffer up to its capacity(), and the buffer is resized to
+     * the datagram size.
+     * @return Number of datagrams read, 0 if there are none (the last error is set to
+     * SystemError::wouldBlock then), -1 in case of an error.
+     */
+    virtual int recvMultipleFrom(std::vector<Datagram>* datagrams) = 0;
+
+    /**
+     * Sends the datagrams with as few system calls as possible (sendmmsg on Linux).
+     * The destinations must be IP addresses.
+     * @return Number of datagrams sent. It is less than datagrams.size() if the socket send
+     * buffer is full in the non-blocking mode or sending the next datagram has failed.
+     * -1 if the first datagram could not be sent.
+     */
+    virtual int sendMultipleTo(const std::vector<Datagram>& datagrams) = 0;
+
+    /**
+     * Enables coalescing of received datagrams by the kernel (UDP GRO, Linux only).
+     * After it, a datagram received with recvMultipleFrom can have Datagram::segmentSize
+     * and the buffers have to be large enough to hold the coalesced datagrams.
+     * All other reading functions receive the coalesced data as a single datagram, so this must
+     * not be enabled for sockets read with them.
+     * @return false if not supported.
+     */
+    virtual bool setReceiveOffload(bool enabled) = 0;
+
     /**
      * Checks, whether data is available for reading in non-blocking mode.
      * Does not block for timeout, returns immediately.
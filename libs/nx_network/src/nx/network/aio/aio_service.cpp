@@ -3,6 +3,7 @@
 #include "aio_service.h"
 
 #include <atomic>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <thread>
@@ -21,6 +22,38 @@
 
 namespace nx::network::aio {
 
+/** Busy ratio difference below which threads are considered to be loaded equally. */
+static constexpr double kSignificantLoadDifference = 0.05;
+
+static double averageBusyRatioPerSocket(const std::vector<AioThreadLoad>& loads)
+{
+    double busyRatio = 0;
+    std::size_t socketCount = 0;
+    for (const auto& load: loads)
+    {
+        busyRatio += load.busyRatio;
+        socketCount += load.socketCount;
+    }
+
+    return socketCount > 0 ? busyRatio / socketCount : 0;
+}
+
+/**
+ * Estimates the busy ratio of a thread including the sockets added after the last measurement,
+ * so that a thread which has just been found the least loaded does not receive all new sockets
+ * until the next measurement.
+ */
+static double loadScore(const AioThreadLoad& load, double costPerSocket)
+{
+    const double costPerQueuedCall = load.eventsPerSecond > 0
+        ? load.busyRatio / load.eventsPerSecond
+        : 0;
+
+    return load.busyRatio
+        + load.newSocketCount * costPerSocket
+        + load.queueDepth * costPerQueuedCall;
+}
+
 AIOService::~AIOService()
 {
     pleaseStopSync();
@@ -158,19 +191,39 @@ void AIOService::initializeAioThreadPool(unsigned int threadCount)
 
 AbstractAioThread* AIOService::findLeastUsedAioThread() const
 {
-    aio::AioThread* threadToUse = nullptr;
+    const auto loads = aioThreadsLoad();
+    const double costPerSocket = averageBusyRatioPerSocket(loads);
 
-    for (auto
-        threadIter = m_aioThreadPool.cbegin();
-        threadIter != m_aioThreadPool.cend();
-        ++threadIter)
+    std::optional<std::size_t> bestIndex;
+    double bestScore = 0;
+    for (std::size_t i = 0; i < loads.size(); ++i)
     {
-        if (threadToUse && threadToUse->socketsHandled() < (*threadIter)->socketsHandled())
-            continue;
-        threadToUse = threadIter->get();
+        const double score = loadScore(loads[i], costPerSocket);
+        if (bestIndex)
+        {
+            const auto& best = loads[*bestIndex];
+            const bool isSimilarLoad = std::abs(score - bestScore) < kSignificantLoadDifference;
+            if ((!isSimilarLoad && score > bestScore)
+                || (isSimilarLoad && best.socketCount < loads[i].socketCount))
+            {
+                continue;
+            }
+        }
+
+        bestIndex = i;
+        bestScore = score;
     }
 
-    return threadToUse;
+    return bestIndex ? m_aioThreadPool[*bestIndex].get() : nullptr;
+}
+
+std::vector<AioThreadLoad> AIOService::aioThreadsLoad() const
+{
+    std::vector<AioThreadLoad> result;
+    result.reserve(m_aioThreadPool.size());
+    for (const auto& aioThread: m_aioThreadPool)
+        result.push_back(aioThread->load());
+    return result;
 }
 
 std::vector<int> AIOService::aioThreadsQueueSize() const
@@ -187,4 +240,12 @@ std::vector<int> AIOService::aioThreadsQueueSize() const
     return result;
 }
 
+std::uint64_t AIOService::postedCallContentionCount() const
+{
+    std::uint64_t result = 0;
+    for (const auto& aioThread: m_aioThreadPool)
+        result += aioThread->taskQueue().postedCallContentionCount();
+    return result;
+}
+
 } // namespace nx::network::aio
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <optional>
 
@@ -108,10 +109,22 @@ public:
     std::vector<AbstractAioThread*> getAllAioThreads() const;
     bool isInAnyAioThread() const;
 
+    /**
+     * @return The thread with the lowest load (see AioThreadLoad). Threads with a similar load
+     *     are compared by the number of sockets handled.
+     */
     AbstractAioThread* findLeastUsedAioThread() const;
 
+    std::vector<AioThreadLoad> aioThreadsLoad() const;
+
     std::vector<int> aioThreadsQueueSize() const;
 
+    /**
+     * @return Number of times a call posted from some thread had to retry being queued due to
+     *     a concurrent post from another thread, summed over all AIO threads.
+     */
+    std::uint64_t postedCallContentionCount() const;
+
 private:
     void initializeAioThreadPool(unsigned int threadCount);
 
@@ -7,14 +7,19 @@
 #include <nx/utils/std/algorithm.h>
 #include <nx/utils/std/cpp14.h>
 #include <nx/utils/time.h>
+#include <nx/utils/trace/trace.h>
 
 namespace nx::network::aio::detail {
 
 static constexpr int kAbnormalProcessTimeFactor = 1000;
 static constexpr auto kAbnormalProcessTimeDetectionPeriod = std::chrono::seconds(20);
 
-AioTaskQueue::AioTaskQueue(AbstractPollSet* pollSet):
+AioTaskQueue::AioTaskQueue(
+    AbstractPollSet* pollSet,
+    std::chrono::milliseconds timerGranularity)
+    :
     m_pollSet(pollSet),
+    m_periodicTasks(timerGranularity),
     m_abnormalProcessingTimeDetector(
         kAbnormalProcessTimeFactor,
         kAbnormalProcessTimeDetectionPeriod,
@@ -27,6 +32,14 @@ AioTaskQueue::AioTaskQueue(AbstractPollSet* pollSet):
 
 void AioTaskQueue::addTask(SocketAddRemoveTask task)
 {
+    if (task.type == TaskType::tCallFunc)
+    {
+        NX_ASSERT(task.postHandler);
+        ++m_postedCallCount;
+        m_newPostedCalls.push(std::move(task));
+        return;
+    }
+
     NX_MUTEX_LOCKER lock(&m_mutex);
     addTask(lock, std::move(task));
 }
@@ -112,25 +125,27 @@ qint64 AioTaskQueue::nextPeriodicEventClock() const
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
 
-    return m_periodicTasksByClock.empty()
-        ? 0
-        : m_periodicTasksByClock.cbegin()->first;
+    return m_periodicTasks.nextEventClock();
 }
 
 std::size_t AioTaskQueue::periodicTasksCount() const
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
 
-    return m_periodicTasksByClock.size();
+    return m_periodicTasks.size();
 }
 
 void AioTaskQueue::clear()
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
 
+    takeNewPostedCalls(lock);
+    m_postedCallCount = 0;
     auto postedCalls = std::exchange(m_postedCalls, {});
     auto pollSetModificationQueue = std::exchange(m_pollSetModificationQueue, {});
-    auto periodicTasksByClock = std::exchange(m_periodicTasksByClock, {});
+    auto periodicTasks = m_periodicTasks.takeAllValues();
+    for (auto& task: periodicTasks)
+        task.data->periodicTask = nullptr;
 
     lock.unlock();
 
@@ -141,9 +156,9 @@ bool AioTaskQueue::empty() const
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
 
-    return m_postedCalls.empty()
+    return m_postedCallCount == 0
         && m_pollSetModificationQueue.empty()
-        && m_periodicTasksByClock.empty();
+        && m_periodicTasks.empty();
 }
 
 void AioTaskQueue::processPollSetModificationQueue(TaskType taskFilter)
@@ -154,6 +169,9 @@ void AioTaskQueue::processPollSetModificationQueue(TaskType taskFilter)
 
     NX_MUTEX_LOCKER lock(&m_mutex);
 
+    if (taskFilter == TaskType::tAll || taskFilter == TaskType::tCallFunc)
+        takeNewPostedCalls(lock);
+
     for (typename std::deque<SocketAddRemoveTask>::iterator
         it = m_pollSetModificationQueue.begin();
         it != m_pollSetModificationQueue.end();
@@ -258,7 +276,11 @@ void AioTaskQueue::processSocketEvents(const qint64 curClock)
 
         //eventTriggered is allowed to call stopMonitoring which can remove socket from pollset
         callAndReportAbnormalProcessingTime(
-            [&]() { handlingData->eventHandler->eventTriggered(socket, sockEventType); },
+            [&]()
+            {
+                NX_TRACE_CATEGORY_SCOPE("aio", "socket event");
+                handlingData->eventHandler->eventTriggered(socket, sockEventType);
+            },
             "socket event");
 
         // Updating the socket periodic task (it's guaranteed that there is a periodic task for the
@@ -325,6 +347,7 @@ bool AioTaskQueue::processPeriodicTasks(const qint64 curClock)
             callAndReportAbnormalProcessingTime(
                 [&]()
                 {
+                    NX_TRACE_CATEGORY_SCOPE("aio", "timer");
                     handlingData->eventHandler->eventTriggered(
                         periodicTaskData->socket,
                         static_cast<aio::EventType>(periodicTaskData->eventType | aio::etTimedOut));
@@ -355,9 +378,16 @@ void AioTaskQueue::processPostedCalls()
     while (!m_postedCalls.empty())
     {
         auto postHandler = std::move(m_postedCalls.begin()->postHandler);
+        if (!postHandler)
+        {
+            m_postedCalls.pop_front(); //< The call has been cancelled.
+            continue;
+        }
+
         NX_ASSERT(!m_postedCalls.front().socket ||
             m_postedCalls.front().socket->isInSelfAioThread());
-        m_postedCalls.erase(m_postedCalls.begin());
+        m_postedCalls.pop_front();
+        --m_postedCallCount;
 
         // NOTE: User handler may cancel some calls, so m_postedCalls may change.
         // But, new calls cannot be added there (they are added via m_pollSetModificationQueue).
@@ -365,7 +395,11 @@ void AioTaskQueue::processPostedCalls()
         nx::Unlocker<nx::Mutex> unlock(&lock);
 
         callAndReportAbnormalProcessingTime(
-            [&]() { postHandler(); },
+            [&]()
+            {
+                NX_TRACE_CATEGORY_SCOPE("aio", "post");
+                postHandler();
+            },
             "post");
 
         // Destroying user callback with no lock since it can produce recursive call to this object.
@@ -392,9 +426,22 @@ std::vector<SocketAddRemoveTask> AioTaskQueue::cancelPostedCalls(
 
 std::size_t AioTaskQueue::postedCallCount() const
 {
-    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_postedCallCount;
+}
 
-    return m_postedCalls.size();
+std::uint64_t AioTaskQueue::postedCallContentionCount() const
+{
+    return m_newPostedCalls.contentionCount();
+}
+
+std::uint64_t AioTaskQueue::handledEventCount() const
+{
+    return m_handledEventCount.load(std::memory_order_relaxed);
+}
+
+std::chrono::microseconds AioTaskQueue::handlerTime() const
+{
+    return std::chrono::microseconds(m_handlerTimeUs.load(std::memory_order_relaxed));
 }
 
 qint64 AioTaskQueue::getMonotonicTime()
@@ -421,6 +468,12 @@ void AioTaskQueue::addTask(
     }
 }
 
+void AioTaskQueue::takeNewPostedCalls(const nx::Locker<nx::Mutex>&)
+{
+    while (auto task = m_newPostedCalls.pop())
+        m_postedCalls.push_back(std::move(*task));
+}
+
 bool AioTaskQueue::taskExists(
     const nx::Locker<nx::Mutex>&,
     Pollable* sock,
@@ -584,6 +637,7 @@ void AioTaskQueue::processCallFuncTask(
 {
     NX_ASSERT(task.postHandler);
     NX_ASSERT(!task.taskCompletionEvent && !task.taskCompletionHandler);
+    ++m_postedCallCount;
     m_postedCalls.push_back(std::move(task));
 
     // This task differs from every else in a way that it is not processed here,
@@ -619,6 +673,7 @@ void AioTaskQueue::addSocketToPollset(
             socket->impl()->monitoredEvents[eventType].isUsed = false;
             socket->impl()->monitoredEvents[eventType].timeout = std::nullopt;
 
+            ++m_postedCallCount;
             m_postedCalls.push_back(
                 PostAsyncCallTask(
                     socket,
@@ -673,7 +728,7 @@ void AioTaskQueue::addPeriodicTask(
     aio::EventType eventType)
 {
     handlingData->nextTimeoutClock = taskClock;
-    m_periodicTasksByClock.emplace(
+    handlingData->periodicTask = m_periodicTasks.add(
         taskClock,
         PeriodicTaskData(handlingData, _socket, eventType));
 }
@@ -682,13 +737,9 @@ std::optional<PeriodicTaskData> AioTaskQueue::takeNextExpiredPeriodicTask(qint64
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
 
-    // Taking task from queue.
-    auto it = m_periodicTasksByClock.begin();
-    if (it == m_periodicTasksByClock.end() || it->first > curClock)
-        return std::nullopt;
-
-    auto periodicTaskData = std::move(it->second);
-    m_periodicTasksByClock.erase(it);
+    auto periodicTaskData = m_periodicTasks.takeNextExpired(curClock);
+    if (periodicTaskData)
+        periodicTaskData->data->periodicTask = nullptr;
 
     return periodicTaskData;
 }
@@ -700,41 +751,26 @@ void AioTaskQueue::replacePeriodicTask(
     Pollable* socket,
     aio::EventType eventType)
 {
-    for (auto it = m_periodicTasksByClock.lower_bound(handlingData->nextTimeoutClock);
-        it != m_periodicTasksByClock.end() && it->first == handlingData->nextTimeoutClock;
-        ++it)
-    {
-        if (it->second.socket == socket)
-        {
-            m_periodicTasksByClock.erase(it);
-            addPeriodicTask(
-                lock, newClock, handlingData, socket, eventType);
-            break;
-        }
-    }
+    if (!handlingData->periodicTask)
+        return;
+
+    m_periodicTasks.remove(std::exchange(handlingData->periodicTask, nullptr));
+    addPeriodicTask(lock, newClock, handlingData, socket, eventType);
 }
 
 void AioTaskQueue::cancelPeriodicTask(
     const nx::Locker<nx::Mutex>& /*lock*/,
     AioEventHandlingData* handlingData,
-    aio::EventType eventType)
+    aio::EventType /*eventType*/)
 {
-    for (auto it = m_periodicTasksByClock.lower_bound(handlingData->nextTimeoutClock);
-        it != m_periodicTasksByClock.end() && it->first == handlingData->nextTimeoutClock;
-        ++it)
-    {
-        if (it->second.data.get() == handlingData && it->second.eventType == eventType)
-        {
-            m_periodicTasksByClock.erase(it);
-            return;
-        }
-    }
+    if (handlingData->periodicTask)
+        m_periodicTasks.remove(std::exchange(handlingData->periodicTask, nullptr));
 }
 
 //-------------------------------------------------------------------------------------------------
 
 std::vector<SocketAddRemoveTask> AioTaskQueue::cancelPostedCalls(
-    const nx::Locker<nx::Mutex>& /*lock*/,
+    const nx::Locker<nx::Mutex>& lock,
     SocketSequence socketSequence)
 {
     std::vector<SocketAddRemoveTask> elementsToRemove;
@@ -758,17 +794,20 @@ std::vector<SocketAddRemoveTask> AioTaskQueue::cancelPostedCalls(
         tasksToRemoveRangeStart,
         m_pollSetModificationQueue.end());
 
-    const auto postedCallsRemoveRangeStart = nx::utils::move_if(
-        m_postedCalls.begin(),
-        m_postedCalls.end(),
-        std::back_inserter(elementsToRemove),
-        [socketSequence](const SocketAddRemoveTask& val)
-        {
-            return val.socketSequence == socketSequence;
-        });
-    m_postedCalls.erase(
-        postedCallsRemoveRangeStart,
-        m_postedCalls.end());
+    // Calls posted after the last processPollSetModificationQueue() are still in the lock-free
+    // queue. This method is called in the AIO thread only, so it is safe to take them here.
+    takeNewPostedCalls(lock);
+
+    // Leaving tombstones instead of erasing the calls from the middle of the queue.
+    for (auto& postedCall: m_postedCalls)
+    {
+        if (!postedCall.postHandler || postedCall.socketSequence != socketSequence)
+            continue;
+
+        elementsToRemove.push_back(std::move(postedCall));
+        postedCall.postHandler = nullptr;
+        --m_postedCallCount;
+    }
 
     return elementsToRemove;
 }
@@ -781,7 +820,11 @@ void AioTaskQueue::callAndReportAbnormalProcessingTime(
     nx::utils::BasicElapsedTimer<std::chrono::microseconds> timer(
         nx::utils::ElapsedTimerState::started);
     func();
-    m_abnormalProcessingTimeDetector.add(timer.elapsed(), description);
+    const auto elapsed = timer.elapsed();
+
+    m_handledEventCount.fetch_add(1, std::memory_order_relaxed);
+    m_handlerTimeUs.fetch_add(elapsed.count(), std::memory_order_relaxed);
+    m_abnormalProcessingTimeDetector.add(elapsed, description);
 }
 
 void AioTaskQueue::reportAbnormalProcessingTime(
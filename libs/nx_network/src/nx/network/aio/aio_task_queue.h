@@ -14,6 +14,8 @@
 #include "../detail/socket_sequence.h"
 #include "abstract_pollset.h"
 #include "aio_event_handler.h"
+#include "detail/mpsc_queue.h"
+#include "detail/timing_wheel.h"
 #include "pollable.h"
 
 namespace nx::network::aio::detail {
@@ -47,6 +49,8 @@ public:
     qint64 updatedPeriodicTaskClock = 0;
     /** Clock when timer will be triggered. 0 - no clock. */
     qint64 nextTimeoutClock = 0;
+    /** The periodic task scheduled for nextTimeoutClock. */
+    TimingWheelBase::Handle periodicTask = nullptr;
 
     AioEventHandlingData(AIOEventHandler* _eventHandler):
         eventHandler(_eventHandler)
@@ -170,11 +174,21 @@ public:
 class NX_NETWORK_API AioTaskQueue
 {
 public:
-    AioTaskQueue(AbstractPollSet* pollSet);
+    /**
+     * @param timerGranularity Tick of the timing wheel keeping the periodic tasks. A periodic task
+     *     is triggered up to timerGranularity - 1 milliseconds later than scheduled.
+     */
+    AioTaskQueue(
+        AbstractPollSet* pollSet,
+        std::chrono::milliseconds timerGranularity = std::chrono::milliseconds(1));
 
     //---------------------------------------------------------------------------------------------
     // Methods that are called within any thread.
 
+    /**
+     * NOTE: Posted calls (TaskType::tCallFunc) are pushed to a lock-free queue. Other tasks are
+     * serialized with the queue mutex.
+     */
     void addTask(SocketAddRemoveTask task);
 
     bool taskExists(
@@ -253,6 +267,22 @@ public:
 
     std::size_t postedCallCount() const;
 
+    /**
+     * @return Total number of times a posted call had to retry being appended to the queue
+     *     because of a concurrent post from another thread.
+     */
+    std::uint64_t postedCallContentionCount() const;
+
+    /**
+     * @return Total number of socket events, timers and posted calls handled so far.
+     */
+    std::uint64_t handledEventCount() const;
+
+    /**
+     * @return Total time spent in the handlers counted by handledEventCount().
+     */
+    std::chrono::microseconds handlerTime() const;
+
     //---------------------------------------------------------------------------------------------
 
     /**
@@ -263,24 +293,34 @@ public:
 
 private:
     AbstractPollSet* m_pollSet = nullptr;
+    /** Calls posted from any thread that have not been moved to m_postedCalls yet. */
+    MpscQueue<SocketAddRemoveTask> m_newPostedCalls;
     // TODO #akolesnikov: Use cyclic array here to minimize allocations.
     /**
      * NOTE: This variable can be accessed within aio thread only.
+     * Cancelled calls are left in the queue as tombstones (with an empty postHandler) and are
+     * skipped by processPostedCalls().
      */
     std::deque<SocketAddRemoveTask> m_postedCalls;
+    /** Calls in m_newPostedCalls and m_postedCalls that are neither called nor cancelled. */
+    std::atomic<std::size_t> m_postedCallCount = 0;
     std::deque<SocketAddRemoveTask> m_pollSetModificationQueue;
-    // TODO: #akolesnikov Get rid of map here to avoid undesired allocations.
-    std::multimap<qint64, PeriodicTaskData> m_periodicTasksByClock;
+    TimingWheel<PeriodicTaskData> m_periodicTasks;
     mutable nx::Mutex m_mutex;
     nx::utils::math::AbnormalValueDetector<
         std::chrono::microseconds, int, const char*> m_abnormalProcessingTimeDetector;
     std::atomic<std::size_t> m_newReadMonitorTaskCount = 0;
     std::atomic<std::size_t> m_newWriteMonitorTaskCount = 0;
+    std::atomic<std::uint64_t> m_handledEventCount = 0;
+    std::atomic<std::int64_t> m_handlerTimeUs = 0;
 
     void addTask(
         const nx::Locker<nx::Mutex>&,
         SocketAddRemoveTask task);
 
+    /** Moves calls from m_newPostedCalls to m_postedCalls. Must be called in the AIO thread. */
+    void takeNewPostedCalls(const nx::Locker<nx::Mutex>&);
+
     bool taskExists(
         const nx::Locker<nx::Mutex>&,
         Pollable* sock,
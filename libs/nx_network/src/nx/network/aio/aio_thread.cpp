@@ -2,15 +2,21 @@
 
 #include "aio_thread.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 #include <nx/utils/log/log.h>
 #include <nx/utils/std/cpp14.h>
 
+#include "../nx_network_ini.h"
 #include "aio_task_queue.h"
 #include "pollset_factory.h"
 
+static constexpr qint64 kLoadMeasurementPeriodMs = 1000;
+/** Weight of the latest measurement in the smoothed load values. */
+static constexpr double kLoadSmoothingFactor = 0.3;
+
 // TODO: #akolesnikov Memory order semantic used with std::atomic.
 // TODO: #akolesnikov Move task queues to socket for optimization.
 
@@ -18,7 +24,9 @@ namespace nx::network::aio {
 
 AioThread::AioThread(std::unique_ptr<AbstractPollSet> pollSet):
     m_pollSet(pollSet ? std::move(pollSet) : PollSetFactory::instance()->create()),
-    m_taskQueue(std::make_unique<detail::AioTaskQueue>(m_pollSet.get()))
+    m_taskQueue(std::make_unique<detail::AioTaskQueue>(
+        m_pollSet.get(),
+        std::chrono::milliseconds(ini().aioTimerGranularityMs)))
 {
     setObjectName("AioThread");
 }
@@ -166,6 +174,22 @@ size_t AioThread::socketsHandled() const
         + m_taskQueue->newWriteMonitorTaskCount();
 }
 
+AioThreadLoad AioThread::load() const
+{
+    AioThreadLoad result;
+    result.eventsPerSecond = m_eventsPerSecond.load(std::memory_order_relaxed);
+    result.busyRatio = m_busyRatio.load(std::memory_order_relaxed);
+    result.queueDepth = m_taskQueue->postedCallCount();
+    result.socketCount = socketsHandled();
+
+    const auto socketCountAtLoadSample =
+        m_socketCountAtLoadSample.load(std::memory_order_relaxed);
+    if (result.socketCount > socketCountAtLoadSample)
+        result.newSocketCount = result.socketCount - socketCountAtLoadSample;
+
+    return result;
+}
+
 bool AioThread::isSocketBeingMonitored(Pollable* sock) const
 {
     for (const auto& monitoringContext: sock->impl()->monitoredEvents)
@@ -219,8 +243,14 @@ void AioThread::run()
             ? aio::kInfiniteTimeout    //no periodic task
             : (nextPeriodicEventClock < curClock ? 0 : nextPeriodicEventClock - curClock);
 
+        // Waking up at least once per load measurement period to keep the load values actual.
+        const int millisToTheNextLoadMeasurement = updateLoadStatistics(curClock);
+
         //if there are posted calls, just checking sockets state in non-blocking mode
-        const int pollTimeout = (m_taskQueue->postedCallCount() == 0) ? millisToTheNextPeriodicEvent : 0;
+        int pollTimeout = (m_taskQueue->postedCallCount() == 0) ? millisToTheNextPeriodicEvent : 0;
+        if (pollTimeout == aio::kInfiniteTimeout || pollTimeout > millisToTheNextLoadMeasurement)
+            pollTimeout = millisToTheNextLoadMeasurement;
+
         const int triggeredSocketCount = m_pollSet->poll(pollTimeout);
 
         if (needToStop())
@@ -288,6 +318,39 @@ bool AioThread::getSocketTimeout(
     return true;
 }
 
+int AioThread::updateLoadStatistics(qint64 curClock)
+{
+    const qint64 elapsedMs = curClock - m_lastLoadSample.clock;
+    if (elapsedMs < kLoadMeasurementPeriodMs)
+        return (int) (kLoadMeasurementPeriodMs - elapsedMs);
+
+    LoadSample sample;
+    sample.clock = curClock;
+    sample.handledEventCount = m_taskQueue->handledEventCount();
+    sample.handlerTime = m_taskQueue->handlerTime();
+
+    if (m_lastLoadSample.clock > 0)
+    {
+        const double eventsPerSecond =
+            (sample.handledEventCount - m_lastLoadSample.handledEventCount) * 1000.0 / elapsedMs;
+        const double busyRatio = std::min(1.0,
+            (sample.handlerTime - m_lastLoadSample.handlerTime).count() / (elapsedMs * 1000.0));
+
+        const auto smooth =
+            [](const std::atomic<double>& value, double measured)
+            {
+                return value.load(std::memory_order_relaxed) * (1 - kLoadSmoothingFactor)
+                    + measured * kLoadSmoothingFactor;
+            };
+        m_eventsPerSecond.store(smooth(m_eventsPerSecond, eventsPerSecond));
+        m_busyRatio.store(smooth(m_busyRatio, busyRatio));
+    }
+
+    m_socketCountAtLoadSample = socketsHandled();
+    m_lastLoadSample = sample;
+    return (int) kLoadMeasurementPeriodMs;
+}
+
 void AioThread::stopMonitoringInternal(Pollable* sock, aio::EventType eventType)
 {
     // Checking queue for reverse task for sock.
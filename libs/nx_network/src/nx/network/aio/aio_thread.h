@@ -3,6 +3,8 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
 
@@ -18,6 +20,26 @@ namespace nx::network::aio {
 
 namespace detail { class AioTaskQueue; }
 
+/**
+ * Load of an AIO thread. Rates are smoothed over several recent measurement periods.
+ */
+struct AioThreadLoad
+{
+    /** Socket events, timers and posted calls handled per second. */
+    double eventsPerSecond = 0;
+
+    /** Share of the time spent in event handlers. In range [0; 1]. */
+    double busyRatio = 0;
+
+    /** Number of posted calls waiting to be invoked. */
+    std::size_t queueDepth = 0;
+
+    std::size_t socketCount = 0;
+
+    /** Sockets added since the last measurement, not yet reflected in the rates. */
+    std::size_t newSocketCount = 0;
+};
+
 class NX_NETWORK_API AbstractAioThread:
     public nx::utils::Thread
 {
@@ -96,6 +118,8 @@ public:
      */
     size_t socketsHandled() const;
 
+    AioThreadLoad load() const;
+
     virtual bool isSocketBeingMonitored(Pollable* sock) const override;
 
     const detail::AioTaskQueue& taskQueue() const;
@@ -107,6 +131,19 @@ private:
     std::unique_ptr<AbstractPollSet> m_pollSet;
     std::unique_ptr<detail::AioTaskQueue> m_taskQueue;
     std::atomic<int> m_processingPostedCalls{0};
+
+    struct LoadSample
+    {
+        qint64 clock = 0;
+        std::uint64_t handledEventCount = 0;
+        std::chrono::microseconds handlerTime{0};
+    };
+
+    /** Accessed within the AIO thread only. */
+    LoadSample m_lastLoadSample;
+    std::atomic<double> m_eventsPerSecond{0};
+    std::atomic<double> m_busyRatio{0};
+    std::atomic<std::size_t> m_socketCountAtLoadSample{0};
     // TODO: #akolesnikov This mutex seem to be redundant after introduction of detail::AioTaskQueue.
     mutable nx::Mutex m_mutex;
 
@@ -116,6 +153,11 @@ private:
         std::chrono::milliseconds* timeout);
 
     void stopMonitoringInternal(Pollable* sock, aio::EventType eventType);
+
+    /**
+     * @return Milliseconds to the next load measurement.
+     */
+    int updateLoadStatistics(qint64 curClock);
 };
 
 } // namespace nx::network::aio
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <optional>
 
 #include <nx/utils/move_only_func.h>
@@ -22,6 +24,7 @@ namespace nx::network::aio {
  * Supports:
  * - Inactivity timeout.
  * - Limit on size of data waiting to be written.
+ * - Counting bytes transferred in each direction.
  *
  * Example of usage:
  * @code {*.cpp}
@@ -42,6 +45,20 @@ public:
     virtual void setMaxSendQueueSizeBytes(std::size_t maxSendQueueSizeBytes) = 0;
     virtual void setInactivityTimeout(std::chrono::milliseconds) = 0;
     virtual void start(nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> doneHandler) = 0;
+
+    /**
+     * @return Bytes written to the right channel. Can be called from any thread.
+     */
+    std::uint64_t leftToRightBytes() const { return m_leftToRightBytes; }
+
+    /**
+     * @return Bytes written to the left channel. Can be called from any thread.
+     */
+    std::uint64_t rightToLeftBytes() const { return m_rightToLeftBytes; }
+
+protected:
+    std::atomic<std::uint64_t> m_leftToRightBytes{0};
+    std::atomic<std::uint64_t> m_rightToLeftBytes{0};
 };
 
 /**
@@ -63,8 +80,10 @@ public:
         m_leftChannel = std::move(leftChannel);
         m_rightChannel = std::move(rightChannel);
 
-        initializeOneWayChannel(&m_leftToRight, *m_leftChannel, *m_rightChannel);
-        initializeOneWayChannel(&m_rightToLeft, *m_rightChannel, *m_leftChannel);
+        initializeOneWayChannel(
+            &m_leftToRight, *m_leftChannel, *m_rightChannel, &m_leftToRightBytes);
+        initializeOneWayChannel(
+            &m_rightToLeft, *m_rightChannel, *m_leftChannel, &m_rightToLeftBytes);
 
         bindToAioThread(getAioThread());
     }
@@ -157,7 +176,8 @@ private:
     void initializeOneWayChannel(
         std::unique_ptr<detail::AsyncChannelUnidirectionalBridgeImpl<Source*, Destination*>>* channel,
         Source& source,
-        Destination& destination)
+        Destination& destination,
+        std::atomic<std::uint64_t>* bytesTransferred)
     {
         *channel =
             std::make_unique<detail::AsyncChannelUnidirectionalBridgeImpl<Source*, Destination*>>(
@@ -166,6 +186,8 @@ private:
         (*channel)->setReadBufferSize(AsyncChannelBridge::kDefaultReadBufferSize);
         (*channel)->setMaxSendQueueSizeBytes(AsyncChannelBridge::kDefaultMaxSendQueueSizeBytes);
         (*channel)->setOnSomeActivity([this]() { onSomeActivity(); });
+        (*channel)->setOnDataSent(
+            [bytesTransferred](std::size_t bytes) { *bytesTransferred += bytes; });
     }
 
     void handleChannelClosure(
@@ -2,11 +2,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <exception>
 #include <functional>
+#include <optional>
 #include <queue>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include <QtCore/QThread>
 
@@ -293,8 +298,76 @@ public:
         NX_ASSERT(buf->size() > 0);
         NX_CRITICAL(!m_asyncSendIssued.exchange(true));
 
-        m_sendBuffer = buf;
+        m_sendBuffers.clear();
+        m_sendBuffers.push_back(std::string_view(buf->data(), buf->size()));
+        m_sendFileRegion = std::nullopt;
+        startSending(std::move(handler));
+    }
+
+    /**
+     * Sends the buffers in order as a single piece of data. No copying is done, data is passed
+     * to the socket with a gathering send call.
+     */
+    void sendGatheredAsync(
+        std::vector<const nx::Buffer*> buffers,
+        IoCompletionHandler handler)
+    {
+        std::vector<std::string_view> views;
+        views.reserve(buffers.size());
+        for (const auto& buffer: buffers)
+            views.push_back(std::string_view(buffer->data(), buffer->size()));
+
+        sendGatheredAsync(std::move(views), std::move(handler));
+    }
+
+    /**
+     * Same as above, but the data can be any part of a buffer, e.g., a nx::BufferChain slice.
+     */
+    void sendGatheredAsync(
+        std::vector<std::string_view> buffers,
+        IoCompletionHandler handler)
+    {
+        if (this->m_socket->impl()->terminated.load(std::memory_order_relaxed) > 0)
+            return;
+
+        NX_ASSERT(isNonBlockingMode());
+        NX_CRITICAL(!m_asyncSendIssued.exchange(true));
+
+        m_sendBuffers = std::move(buffers);
+        m_sendBuffers.erase(
+            std::remove_if(
+                m_sendBuffers.begin(), m_sendBuffers.end(),
+                [](const std::string_view& buffer) { return buffer.empty(); }),
+            m_sendBuffers.end());
+        NX_ASSERT(!m_sendBuffers.empty());
+        m_sendFileRegion = std::nullopt;
+
+        startSending(std::move(handler));
+    }
+
+    /**
+     * Transmits the file region to the socket without copying the data to the user space.
+     * Available only if the socket supports sendFile(const FileRegion&).
+     */
+    void sendFileAsync(const FileRegion& region, IoCompletionHandler handler)
+    {
+        if (this->m_socket->impl()->terminated.load(std::memory_order_relaxed) > 0)
+            return;
+
+        NX_ASSERT(isNonBlockingMode());
+        NX_ASSERT(region.size > 0);
+        NX_CRITICAL(!m_asyncSendIssued.exchange(true));
+
+        m_sendBuffers.clear();
+        m_sendFileRegion = region;
+        startSending(std::move(handler));
+    }
+
+    void startSending(IoCompletionHandler handler)
+    {
         m_sendHandler = std::move(handler);
+        m_sendBufferIndex = 0;
+        m_sendBufferOffset = 0;
         m_sendBufPos = 0;
 
         this->dispatch(
@@ -393,7 +466,14 @@ private:
     size_t m_recvAsyncCallCounter = 0;
 
     IoCompletionHandler m_sendHandler;
-    const nx::Buffer* m_sendBuffer = nullptr;
+    std::vector<std::string_view> m_sendBuffers;
+    /** Index of the first buffer in m_sendBuffers that has not been sent completely. */
+    std::size_t m_sendBufferIndex = 0;
+    /** Number of bytes of m_sendBuffers[m_sendBufferIndex] that have already been sent. */
+    std::size_t m_sendBufferOffset = 0;
+    /** The remaining part of the file being sent by sendFileAsync. */
+    std::optional<FileRegion> m_sendFileRegion;
+    /** Total number of bytes sent. */
     std::size_t m_sendBufPos = 0;
 
     /**
@@ -403,6 +483,8 @@ private:
      * in the socket's send buffer.
      */
     std::size_t m_maxSendDataSize = 128*1024;
+    /** Maximum number of buffers passed to a single gathering send call. */
+    static constexpr std::size_t kMaxGatheredBufferCount = 16;
     bool m_maxSendDataSizeSet = false;
 
     nx::utils::MoveOnlyFunc<void()> m_timerHandler;
@@ -629,13 +711,9 @@ private:
                     return;
                 }
 
-                std::size_t dataToSend = std::min<std::size_t>(
-                    m_sendBuffer->size() - m_sendBufPos,
-                    m_maxSendDataSize);
-
-                const int bytesWritten = this->m_socket->send(
-                    m_sendBuffer->data() + m_sendBufPos,
-                    dataToSend);
+                const int bytesWritten = m_sendFileRegion
+                    ? sendSomeFileData()
+                    : sendSomeBufferedData();
                 if (bytesWritten == -1)
                 {
                     const auto lastError = SystemError::getLastOSErrorCode();
@@ -653,8 +731,8 @@ private:
                 }
                 else
                 {
-                    m_sendBufPos += bytesWritten;
-                    if (m_sendBufPos == m_sendBuffer->size())
+                    skipSentData(bytesWritten);
+                    if (isAllDataSent())
                         reportSendCompletion(SystemError::noError, m_sendBufPos);
                 }
             }
@@ -674,6 +752,84 @@ private:
         }
     }
 
+    /**
+     * Passes not more than m_maxSendDataSize bytes of the remaining data to the socket.
+     * If the remaining data spans several buffers, they are sent with a single gathering call.
+     */
+    int sendSomeBufferedData()
+    {
+        std::array<std::string_view, kMaxGatheredBufferCount> chunks;
+        std::size_t chunkCount = 0;
+        std::size_t dataToSend = 0;
+        for (std::size_t i = m_sendBufferIndex;
+            i < m_sendBuffers.size() && chunkCount < chunks.size() && dataToSend < m_maxSendDataSize;
+            ++i)
+        {
+            const std::size_t offset = i == m_sendBufferIndex ? m_sendBufferOffset : 0;
+            const std::size_t size = std::min<std::size_t>(
+                m_sendBuffers[i].size() - offset,
+                m_maxSendDataSize - dataToSend);
+
+            chunks[chunkCount++] = m_sendBuffers[i].substr(offset, size);
+            dataToSend += size;
+        }
+
+        if (chunkCount == 1)
+            return this->m_socket->send(chunks[0].data(), chunks[0].size());
+
+        return this->m_socket->sendGathered(chunks.data(), chunkCount);
+    }
+
+    int sendSomeFileData()
+    {
+        if constexpr (requires(SocketType* socket) { socket->sendFile(FileRegion()); })
+        {
+            FileRegion chunk = *m_sendFileRegion;
+            chunk.size = std::min<std::uint64_t>(chunk.size, m_maxSendDataSize);
+            return this->m_socket->sendFile(chunk);
+        }
+        else
+        {
+            NX_ASSERT(false, "The socket does not support sending files");
+            SystemError::setLastErrorCode(SystemError::notImplemented);
+            return -1;
+        }
+    }
+
+    void skipSentData(std::size_t bytesSent)
+    {
+        m_sendBufPos += bytesSent;
+
+        if (m_sendFileRegion)
+        {
+            m_sendFileRegion->offset += bytesSent;
+            m_sendFileRegion->size -= bytesSent;
+            return;
+        }
+
+        while (bytesSent > 0)
+        {
+            const std::size_t bytesLeftInBuffer =
+                m_sendBuffers[m_sendBufferIndex].size() - m_sendBufferOffset;
+            if (bytesSent < bytesLeftInBuffer)
+            {
+                m_sendBufferOffset += bytesSent;
+                return;
+            }
+
+            bytesSent -= bytesLeftInBuffer;
+            ++m_sendBufferIndex;
+            m_sendBufferOffset = 0;
+        }
+    }
+
+    bool isAllDataSent() const
+    {
+        return m_sendFileRegion
+            ? m_sendFileRegion->size == 0
+            : m_sendBufferIndex == m_sendBuffers.size();
+    }
+
     void reportConnectCompletion(SystemError::ErrorCode errorCode)
     {
         reportConnectOrSendCompletion(m_connectHandler, errorCode);
@@ -682,7 +838,10 @@ private:
     void reportSendCompletion(
         SystemError::ErrorCode errorCode, size_t bytesSent)
     {
-        m_sendBuffer = nullptr;
+        m_sendBuffers.clear();
+        m_sendFileRegion = std::nullopt;
+        m_sendBufferIndex = 0;
+        m_sendBufferOffset = 0;
         m_sendBufPos = 0;
 
         reportConnectOrSendCompletion(m_sendHandler, errorCode, bytesSent);
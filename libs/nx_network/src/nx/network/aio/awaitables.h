@@ -0,0 +1,204 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <nx/network/abstract_socket.h>
+#include <nx/utils/coro/task_utils.h>
+
+#include "timer.h"
+
+/**
+ * Awaitable adapters of the callback-style asynchronous operations for nx::coro tasks:
+ * @code{.cpp}
+ * nx::coro::Task<> echo(AbstractStreamSocket* socket)
+ * {
+ *     nx::Buffer buffer;
+ *     buffer.reserve(4096);
+ *     for (;;)
+ *     {
+ *         const auto [resultCode, bytesRead] = co_await aio::readSome(socket, &buffer);
+ *         if (resultCode != SystemError::noError || bytesRead == 0)
+ *             co_return;
+ *         co_await aio::send(socket, &buffer);
+ *         buffer.clear();
+ *     }
+ * }
+ * @endcode
+ *
+ * The awaiter lives in the coroutine frame and the completion handler passed to the operation
+ * only refers to it, so awaiting an operation allocates nothing in addition to the operation
+ * itself. The coroutine is resumed in the completion handler, i.e., in the AIO thread of the
+ * socket (timer).
+ *
+ * Cancellation: if the operation is cancelled (e.g., by AbstractSocket::pleaseStopSync), its
+ * completion handler is destroyed without being invoked. Then the awaiting coroutine is resumed
+ * by the handler destructor and the awaiting expression throws nx::coro::TaskCancelException.
+ * The exception is also thrown if the cancel condition of the task (nx::coro::cancelIf) holds
+ * when the operation completes.
+ * The task MUST NOT be destroyed while an operation it awaits is still in progress: the same rule
+ * as for any object referenced from a completion handler.
+ */
+namespace nx::network::aio {
+
+struct IoResult
+{
+    SystemError::ErrorCode resultCode = SystemError::noError;
+    std::size_t bytesTransferred = 0;
+
+    IoResult(SystemError::ErrorCode resultCode, std::size_t bytesTransferred):
+        resultCode(resultCode),
+        bytesTransferred(bytesTransferred)
+    {
+    }
+
+    bool ok() const { return resultCode == SystemError::noError; }
+};
+
+namespace detail {
+
+/**
+ * Awaiter of an operation started by Initiate(Completion). Result is constructed from the
+ * arguments of the operation completion handler.
+ */
+template<typename Result, typename Initiate>
+class AsyncOperationAwaiter
+{
+    using Storage = std::conditional_t<std::is_void_v<Result>, std::monostate, Result>;
+
+public:
+    /** Completion handler that resumes the awaiting coroutine. */
+    class Completion
+    {
+    public:
+        explicit Completion(AsyncOperationAwaiter* awaiter): m_awaiter(awaiter) {}
+
+        Completion(Completion&& other) noexcept:
+            m_awaiter(std::exchange(other.m_awaiter, nullptr))
+        {
+        }
+
+        Completion& operator=(Completion&&) = delete;
+
+        ~Completion()
+        {
+            // Destroyed without being invoked: the operation has been cancelled.
+            if (m_awaiter)
+                std::exchange(m_awaiter, nullptr)->m_coroutine.resume();
+        }
+
+        template<typename... Args>
+        void operator()(Args&&... args)
+        {
+            auto awaiter = std::exchange(m_awaiter, nullptr);
+            awaiter->m_result.emplace(std::forward<Args>(args)...);
+            awaiter->m_coroutine.resume();
+        }
+
+    private:
+        AsyncOperationAwaiter* m_awaiter = nullptr;
+    };
+
+    AsyncOperationAwaiter(Initiate initiate): m_initiate(std::move(initiate)) {}
+
+    AsyncOperationAwaiter(const AsyncOperationAwaiter&) = delete;
+    AsyncOperationAwaiter& operator=(const AsyncOperationAwaiter&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        m_coroutine = h;
+        m_initiate(Completion(this));
+    }
+
+    Result await_resume()
+    {
+        if (!m_result || nx::coro::isCancelRequested(m_coroutine))
+            throw nx::coro::TaskCancelException();
+
+        if constexpr (!std::is_void_v<Result>)
+            return std::move(*m_result);
+    }
+
+private:
+    Initiate m_initiate;
+    std::coroutine_handle<> m_coroutine;
+    std::optional<Storage> m_result;
+};
+
+template<typename Result, typename Initiate>
+AsyncOperationAwaiter<Result, Initiate> makeAwaiter(Initiate initiate)
+{
+    return AsyncOperationAwaiter<Result, Initiate>(std::move(initiate));
+}
+
+} // namespace detail
+
+/**
+ * Awaitable version of AbstractCommunicatingSocket::connectAsync.
+ * @return The connection result code.
+ */
+[[nodiscard]] inline auto connect(AbstractCommunicatingSocket* socket, SocketAddress address)
+{
+    return detail::makeAwaiter<SystemError::ErrorCode>(
+        [socket, address = std::move(address)](auto completion)
+        {
+            socket->connectAsync(address, std::move(completion));
+        });
+}
+
+/** Awaitable version of AbstractCommunicatingSocket::readSomeAsync. */
+[[nodiscard]] inline auto readSome(AbstractCommunicatingSocket* socket, nx::Buffer* buffer)
+{
+    return detail::makeAwaiter<IoResult>(
+        [socket, buffer](auto completion)
+        {
+            socket->readSomeAsync(buffer, std::move(completion));
+        });
+}
+
+/** Awaitable version of AbstractCommunicatingSocket::readAsyncAtLeast. */
+[[nodiscard]] inline auto readAtLeast(
+    AbstractCommunicatingSocket* socket, nx::Buffer* buffer, std::size_t minimalSize)
+{
+    return detail::makeAwaiter<IoResult>(
+        [socket, buffer, minimalSize](auto completion)
+        {
+            socket->readAsyncAtLeast(buffer, minimalSize, std::move(completion));
+        });
+}
+
+/**
+ * Awaitable version of AbstractCommunicatingSocket::sendAsync.
+ * The buffer MUST stay alive until the awaiting expression completes.
+ */
+[[nodiscard]] inline auto send(AbstractCommunicatingSocket* socket, const nx::Buffer* buffer)
+{
+    return detail::makeAwaiter<IoResult>(
+        [socket, buffer](auto completion)
+        {
+            socket->sendAsync(buffer, std::move(completion));
+        });
+}
+
+/**
+ * Resumes the coroutine in the timer AIO thread after the given timeout. Overwrites the timer
+ * if it has already been started.
+ */
+[[nodiscard]] inline auto sleep(Timer* timer, std::chrono::milliseconds timeout)
+{
+    return detail::makeAwaiter<void>(
+        [timer, timeout](auto completion)
+        {
+            timer->start(timeout, std::move(completion));
+        });
+}
+
+} // namespace nx::network::aio
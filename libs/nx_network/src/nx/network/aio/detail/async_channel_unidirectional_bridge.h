@@ -75,6 +75,8 @@ public:
     virtual void setMaxSendQueueSizeBytes(std::size_t maxSendQueueSizeBytes) = 0;
     virtual void start(nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> doneHandler) = 0;
     virtual void setOnSomeActivity(nx::utils::MoveOnlyFunc<void()> handler) = 0;
+    /** The handler receives the size of every chunk written to the destination. */
+    virtual void setOnDataSent(nx::utils::MoveOnlyFunc<void(std::size_t)> handler) = 0;
     virtual bool isSendQueueEmpty() const = 0;
 };
 
@@ -138,6 +140,11 @@ public:
         m_onSomeActivityHander = std::move(handler);
     }
 
+    virtual void setOnDataSent(nx::utils::MoveOnlyFunc<void(std::size_t)> handler) override
+    {
+        m_onDataSentHandler = std::move(handler);
+    }
+
     virtual bool isSendQueueEmpty() const override
     {
         return m_sendQueue.empty();
@@ -170,6 +177,7 @@ private:
     SystemError::ErrorCode m_sourceClosureReason;
     nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> m_onDoneHandler;
     nx::utils::MoveOnlyFunc<void()> m_onSomeActivityHander;
+    nx::utils::MoveOnlyFunc<void(std::size_t)> m_onDataSentHandler;
 
     void scheduleRead()
     {
@@ -244,6 +252,9 @@ private:
         if (sysErrorCode != SystemError::noError)
             return reportFailure(sysErrorCode);
 
+        if (m_onDataSentHandler)
+            m_onDataSentHandler(m_sendQueue.front().size());
+
         m_sendQueue.pop_front();
         if (!m_isSourceOpened && m_sendQueue.empty())
             return reportFailure(m_sourceClosureReason);
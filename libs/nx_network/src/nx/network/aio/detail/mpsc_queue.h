@@ -0,0 +1,116 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace nx::network::aio::detail {
+
+/**
+ * Linked lock-free multiple producer / single consumer queue (D. Vyukov's algorithm).
+ * push() may be called from any thread concurrently. pop() must be called by a single thread at
+ * a time.
+ * The number of failed attempts to append an element due to a concurrent push is counted, so
+ * that the producer contention can be monitored.
+ */
+template<typename Value>
+class MpscQueue
+{
+public:
+    MpscQueue():
+        m_head(&m_stub),
+        m_tail(&m_stub)
+    {
+    }
+
+    ~MpscQueue()
+    {
+        while (pop()) {}
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(Value value)
+    {
+        pushNode(new Node(std::move(value)));
+    }
+
+    /**
+     * @return Nothing if the queue is empty or if the only element is still being pushed by
+     * another thread. In the latter case, the element becomes available right after the push is
+     * complete.
+     */
+    std::optional<Value> pop()
+    {
+        NodeBase* head = m_head;
+        NodeBase* next = head->next.load(std::memory_order_acquire);
+        if (head == &m_stub)
+        {
+            if (!next)
+                return std::nullopt;
+            m_head = head = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (!next)
+        {
+            if (head != m_tail.load(std::memory_order_acquire))
+                return std::nullopt; //< A producer has not linked its element yet.
+
+            // head is the last element. Moving the stub behind it so that it can be taken.
+            pushNode(&m_stub);
+            next = head->next.load(std::memory_order_acquire);
+            if (!next)
+                return std::nullopt;
+        }
+
+        m_head = next;
+        std::unique_ptr<Node> node(static_cast<Node*>(head));
+        return std::move(node->value);
+    }
+
+    std::uint64_t contentionCount() const
+    {
+        return m_contentionCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct NodeBase
+    {
+        std::atomic<NodeBase*> next{nullptr};
+    };
+
+    struct Node: NodeBase
+    {
+        Value value;
+
+        Node(Value value): value(std::move(value)) {}
+    };
+
+    NodeBase m_stub;
+    /** Accessed by the consumer only. */
+    NodeBase* m_head = nullptr;
+    std::atomic<NodeBase*> m_tail;
+    std::atomic<std::uint64_t> m_contentionCount{0};
+
+    void pushNode(NodeBase* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        NodeBase* prev = m_tail.load(std::memory_order_relaxed);
+        while (!m_tail.compare_exchange_strong(
+            prev, node, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            m_contentionCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        prev->next.store(node, std::memory_order_release);
+    }
+};
+
+} // namespace nx::network::aio::detail
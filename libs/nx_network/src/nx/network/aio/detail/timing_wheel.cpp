@@ -0,0 +1,268 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "timing_wheel.h"
+
+#include <algorithm>
+#include <bit>
+
+#include <nx/utils/log/assert.h>
+
+namespace nx::network::aio::detail {
+
+static constexpr std::int64_t kSlotMask = TimingWheelBase::kSlotCount - 1;
+static constexpr std::int64_t kMaxDelta =
+    std::int64_t(1) << (TimingWheelBase::kSlotBits * TimingWheelBase::kLevelCount);
+
+static void initSentinel(TimingWheelBase::Node* head)
+{
+    head->prev = head;
+    head->next = head;
+}
+
+TimingWheelBase::TimingWheelBase(std::chrono::milliseconds tickGranularity):
+    m_tickGranularity(std::max(tickGranularity, std::chrono::milliseconds(1)))
+{
+    for (auto& level: m_levels)
+    {
+        for (auto& slot: level.slots)
+            initSentinel(&slot.head);
+    }
+    initSentinel(&m_expired);
+}
+
+TimingWheelBase::~TimingWheelBase()
+{
+    NX_ASSERT(m_size == 0, "Nodes must be freed by TimingWheel");
+}
+
+std::int64_t TimingWheelBase::nextEventClock() const
+{
+    if (m_expiredCount > 0)
+        return m_expired.next->clock;
+
+    const auto tick = nextEventTick();
+    return tick ? *tick * m_tickGranularity.count() : 0;
+}
+
+void TimingWheelBase::link(Node* node, std::int64_t clock)
+{
+    const auto granularity = m_tickGranularity.count();
+
+    node->clock = clock;
+    // Rounding up so that the node never expires before its clock.
+    node->tick = clock >= 0 ? (clock + granularity - 1) / granularity : clock / granularity;
+    place(node);
+    ++m_size;
+}
+
+void TimingWheelBase::unlink(Node* node)
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+
+    if (node->level == kLevelCount)
+    {
+        --m_expiredCount;
+    }
+    else
+    {
+        const auto& head = m_levels[node->level].slots[node->slot].head;
+        if (head.next == &head)
+            setSlotNonEmpty(node->level, node->slot, false);
+    }
+
+    node->prev = nullptr;
+    node->next = nullptr;
+    --m_size;
+}
+
+TimingWheelBase::Node* TimingWheelBase::takeNextExpired(std::int64_t curClock)
+{
+    advanceTo(curClock / m_tickGranularity.count());
+
+    if (m_expiredCount == 0)
+        return nullptr;
+
+    auto node = m_expired.next;
+    unlink(node);
+    return node;
+}
+
+TimingWheelBase::Node* TimingWheelBase::takeAll()
+{
+    Node* result = nullptr;
+    const auto takeList =
+        [&result](Node* head)
+        {
+            while (head->next != head)
+            {
+                auto node = head->prev;
+                node->prev->next = head;
+                head->prev = node->prev;
+                node->prev = nullptr;
+                node->next = std::exchange(result, node);
+            }
+        };
+
+    for (auto& level: m_levels)
+    {
+        for (auto& slot: level.slots)
+            takeList(&slot.head);
+        level.nonEmptySlots.fill(0);
+    }
+    takeList(&m_expired);
+
+    m_size = 0;
+    m_expiredCount = 0;
+    return result;
+}
+
+void TimingWheelBase::place(Node* node)
+{
+    const auto delta = node->tick - m_currentTick;
+    if (delta <= 0)
+    {
+        node->level = kLevelCount;
+        pushBack(&m_expired, node);
+        ++m_expiredCount;
+        return;
+    }
+
+    int level = 0;
+    while (level < kLevelCount - 1 && delta >= (std::int64_t(1) << (kSlotBits * (level + 1))))
+        ++level;
+
+    // The nodes that are too far are put to the farthest slot and are placed again from there.
+    const auto positionTick = delta < kMaxDelta ? node->tick : m_currentTick + kMaxDelta - 1;
+
+    node->level = level;
+    node->slot = (int) ((positionTick >> (kSlotBits * level)) & kSlotMask);
+    pushBack(&m_levels[level].slots[node->slot].head, node);
+    setSlotNonEmpty(level, node->slot, true);
+}
+
+void TimingWheelBase::pushBack(Node* head, Node* node)
+{
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+void TimingWheelBase::advanceTo(std::int64_t tick)
+{
+    if (tick <= m_currentTick)
+        return;
+
+    // Jumping from one non-empty slot to another instead of walking through every tick. So, the
+    // cost does not depend on the time passed since the previous call.
+    for (;;)
+    {
+        const auto nextTick = nextEventTick();
+        if (!nextTick || *nextTick > tick)
+        {
+            m_currentTick = tick;
+            return;
+        }
+
+        m_currentTick = *nextTick;
+
+        // The upper levels first since their nodes can be moved to the lower level slots
+        // processed in the same tick.
+        for (int level = kLevelCount - 1; level > 0; --level)
+        {
+            const auto levelTickMask = (std::int64_t(1) << (kSlotBits * level)) - 1;
+            if ((m_currentTick & levelTickMask) == 0)
+                cascade(level, (int) ((m_currentTick >> (kSlotBits * level)) & kSlotMask));
+        }
+
+        moveToExpired(0, (int) (m_currentTick & kSlotMask));
+    }
+}
+
+std::optional<std::int64_t> TimingWheelBase::nextEventTick() const
+{
+    std::optional<std::int64_t> result;
+    for (int level = 0; level < kLevelCount; ++level)
+    {
+        const auto levelPosition = m_currentTick >> (kSlotBits * level);
+        const auto slot = nextNonEmptySlot(level, (int) (levelPosition & kSlotMask));
+        if (!slot)
+            continue;
+
+        // The slot is processed when the level position reaches it next time.
+        auto slotPosition = (levelPosition & ~kSlotMask) | *slot;
+        if (slotPosition <= levelPosition)
+            slotPosition += kSlotCount;
+
+        const auto slotTick = slotPosition << (kSlotBits * level);
+        if (!result || slotTick < *result)
+            result = slotTick;
+    }
+
+    return result;
+}
+
+void TimingWheelBase::cascade(int level, int slot)
+{
+    auto& head = m_levels[level].slots[slot].head;
+    auto node = head.next;
+    initSentinel(&head);
+    setSlotNonEmpty(level, slot, false);
+
+    while (node != &head)
+        place(std::exchange(node, node->next));
+}
+
+void TimingWheelBase::moveToExpired(int level, int slot)
+{
+    auto& head = m_levels[level].slots[slot].head;
+    while (head.next != &head)
+    {
+        auto node = head.next;
+        head.next = node->next;
+        node->next->prev = &head;
+
+        node->level = kLevelCount;
+        pushBack(&m_expired, node);
+        ++m_expiredCount;
+    }
+    setSlotNonEmpty(level, slot, false);
+}
+
+std::optional<int> TimingWheelBase::nextNonEmptySlot(int level, int afterSlot) const
+{
+    if (auto slot = findNonEmptySlot(level, afterSlot + 1, kSlotCount))
+        return slot;
+    return findNonEmptySlot(level, 0, afterSlot + 1);
+}
+
+std::optional<int> TimingWheelBase::findNonEmptySlot(int level, int from, int to) const
+{
+    const auto& nonEmptySlots = m_levels[level].nonEmptySlots;
+    for (int i = from; i < to; i = (i / 64 + 1) * 64)
+    {
+        const auto bits = nonEmptySlots[i / 64] >> (i % 64);
+        if (bits != 0)
+        {
+            const int slot = i + std::countr_zero(bits);
+            if (slot < to)
+                return slot;
+            return std::nullopt;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void TimingWheelBase::setSlotNonEmpty(int level, int slot, bool value)
+{
+    auto& word = m_levels[level].nonEmptySlots[slot / 64];
+    const auto bit = std::uint64_t(1) << (slot % 64);
+    if (value)
+        word |= bit;
+    else
+        word &= ~bit;
+}
+
+} // namespace nx::network::aio::detail
@@ -0,0 +1,224 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace nx::network::aio::detail {
+
+/**
+ * Type-independent part of TimingWheel. Elements are linked into intrusive lists, so an element
+ * is added and removed in O(1) without allocating memory.
+ */
+class NX_NETWORK_API TimingWheelBase
+{
+public:
+    struct Node
+    {
+        Node* prev = nullptr;
+        Node* next = nullptr;
+        std::int64_t clock = 0;
+        /** The tick by which the node expires. */
+        std::int64_t tick = 0;
+        /** kLevelCount stands for the list of expired nodes. */
+        int level = 0;
+        int slot = 0;
+    };
+
+    using Handle = Node*;
+
+    static constexpr int kSlotBits = 8;
+    static constexpr int kSlotCount = 1 << kSlotBits;
+    static constexpr int kLevelCount = 4;
+
+    TimingWheelBase(std::chrono::milliseconds tickGranularity);
+    ~TimingWheelBase();
+
+    TimingWheelBase(const TimingWheelBase&) = delete;
+    TimingWheelBase& operator=(const TimingWheelBase&) = delete;
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * @return The clock by which the wheel has to be processed next. It is not later than the
+     * earliest element clock, but may be earlier for elements expiring more than kSlotCount ticks
+     * later (they are moved closer at that clock). 0 if the wheel is empty.
+     */
+    std::int64_t nextEventClock() const;
+
+    std::chrono::milliseconds tickGranularity() const { return m_tickGranularity; }
+
+protected:
+    void link(Node* node, std::int64_t clock);
+    void unlink(Node* node);
+
+    /**
+     * @return A node that has expired by the curClock or null.
+     * The node is unlinked from the wheel.
+     */
+    Node* takeNextExpired(std::int64_t curClock);
+
+    /**
+     * @return All nodes linked via Node::next (null-terminated). The wheel is empty after that.
+     */
+    Node* takeAll();
+
+private:
+    struct Slot
+    {
+        /** Circular list sentinel. */
+        Node head;
+    };
+
+    struct Level
+    {
+        std::array<Slot, kSlotCount> slots;
+        std::array<std::uint64_t, kSlotCount / 64> nonEmptySlots{};
+    };
+
+    const std::chrono::milliseconds m_tickGranularity;
+    /** All ticks up to this one (inclusive) have been processed. */
+    std::int64_t m_currentTick = 0;
+    std::array<Level, kLevelCount> m_levels;
+    /** Nodes that expired by m_currentTick. */
+    Node m_expired;
+    std::size_t m_size = 0;
+    std::size_t m_expiredCount = 0;
+
+    void place(Node* node);
+    void pushBack(Node* head, Node* node);
+    void advanceTo(std::int64_t tick);
+    std::optional<std::int64_t> nextEventTick() const;
+    void cascade(int level, int slot);
+    void moveToExpired(int level, int slot);
+    std::optional<int> nextNonEmptySlot(int level, int afterSlot) const;
+    std::optional<int> findNonEmptySlot(int level, int from, int to) const;
+    void setSlotNonEmpty(int level, int slot, bool value);
+};
+
+/**
+ * Hierarchical timing wheel (G. Varghese, T. Lauck). Keeps values associated with clocks
+ * (milliseconds) and provides the ones that have expired.
+ * Adding and removing an element is O(1) while the multimap keyed by clock it replaces costs
+ * O(log n) for both. The elements expire in the order of ticks. The elements expiring in the
+ * same tick are provided in the order they have been added.
+ * An element never expires earlier than its clock and expires not later than tickGranularity - 1
+ * milliseconds after it.
+ * NOTE: Not thread-safe.
+ */
+template<typename Value>
+class TimingWheel:
+    public TimingWheelBase
+{
+public:
+    using Handle = TimingWheelBase::Handle;
+
+    TimingWheel(std::chrono::milliseconds tickGranularity = std::chrono::milliseconds(1)):
+        TimingWheelBase(tickGranularity)
+    {
+    }
+
+    ~TimingWheel()
+    {
+        deleteNodes(takeAll());
+        deleteNodes(std::exchange(m_freeNodes, nullptr));
+    }
+
+    /**
+     * @return Handle that can be used to remove the element until it is taken by
+     * takeNextExpired() or removed.
+     */
+    Handle add(std::int64_t clock, Value value)
+    {
+        auto node = m_freeNodes;
+        if (node)
+        {
+            m_freeNodes = static_cast<ValueNode*>(node->next);
+            --m_freeNodeCount;
+            node->value = std::move(value);
+        }
+        else
+        {
+            node = new ValueNode(std::move(value));
+        }
+
+        link(node, clock);
+        return node;
+    }
+
+    void remove(Handle handle)
+    {
+        unlink(handle);
+        release(static_cast<ValueNode*>(handle));
+    }
+
+    std::optional<Value> takeNextExpired(std::int64_t curClock)
+    {
+        auto node = static_cast<ValueNode*>(TimingWheelBase::takeNextExpired(curClock));
+        if (!node)
+            return std::nullopt;
+
+        std::optional<Value> value(std::move(node->value));
+        release(node);
+        return value;
+    }
+
+    /**
+     * Removes all elements. So, the values can be destroyed outside of a lock protecting the wheel.
+     */
+    std::vector<Value> takeAllValues()
+    {
+        std::vector<Value> values;
+        values.reserve(size());
+        for (auto node = takeAll(); node != nullptr;)
+        {
+            auto valueNode = static_cast<ValueNode*>(node);
+            node = node->next;
+            values.push_back(std::move(valueNode->value));
+            release(valueNode);
+        }
+        return values;
+    }
+
+private:
+    struct ValueNode: Node
+    {
+        Value value;
+
+        ValueNode(Value value): value(std::move(value)) {}
+    };
+
+    /** Nodes are reused to avoid an allocation per timer re-arm. */
+    static constexpr std::size_t kMaxFreeNodeCount = 1024;
+
+    ValueNode* m_freeNodes = nullptr;
+    std::size_t m_freeNodeCount = 0;
+
+    void release(ValueNode* node)
+    {
+        if (m_freeNodeCount >= kMaxFreeNodeCount)
+        {
+            delete node;
+            return;
+        }
+
+        node->value = Value();
+        node->next = m_freeNodes;
+        m_freeNodes = node;
+        ++m_freeNodeCount;
+    }
+
+    static void deleteNodes(Node* node)
+    {
+        while (node)
+            delete static_cast<ValueNode*>(std::exchange(node, node->next));
+    }
+};
+
+} // namespace nx::network::aio::detail
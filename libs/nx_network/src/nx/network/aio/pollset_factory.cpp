@@ -2,12 +2,19 @@
 
 #include "pollset_factory.h"
 
+#include <nx/utils/log/log.h>
 #include <nx/utils/std/cpp14.h>
 
+#include "../nx_network_ini.h"
 #include "pollset.h"
 #include "pollset_wrapper.h"
 #include "unified_pollset.h"
 
+#if defined(__linux__) && !defined(__ANDROID__)
+    #include "pollset_io_uring_linux.h"
+    #define NX_NETWORK_IO_URING_POLLSET
+#endif
+
 namespace nx {
 namespace network {
 namespace aio {
@@ -15,7 +22,8 @@ namespace aio {
 PollSetFactory* s_instance = nullptr;
 
 PollSetFactory::PollSetFactory():
-    m_udtEnabled(true)
+    m_udtEnabled(true),
+    m_ioUringEnabled(ini().useIoUringPollSet)
 {
     if (s_instance)
         NX_ERROR(this, "Singleton is created more than once.");
@@ -33,8 +41,17 @@ std::unique_ptr<AbstractPollSet> PollSetFactory::create()
 {
     if (m_udtEnabled)
         return std::make_unique<PollSetWrapper<UnifiedPollSet>>();
-    else
-        return std::make_unique<PollSetWrapper<PollSet>>();
+
+#if defined(NX_NETWORK_IO_URING_POLLSET)
+    if (m_ioUringEnabled)
+    {
+        if (auto pollSet = std::make_unique<IoUringPollSet>(); pollSet->isValid())
+            return pollSet;
+        NX_DEBUG(this, "io_uring is not supported by the system. Falling back to epoll");
+    }
+#endif
+
+    return std::make_unique<PollSetWrapper<PollSet>>();
 }
 
 void PollSetFactory::enableUdt()
@@ -47,6 +64,16 @@ void PollSetFactory::disableUdt()
     m_udtEnabled = false;
 }
 
+void PollSetFactory::enableIoUring()
+{
+    m_ioUringEnabled = true;
+}
+
+void PollSetFactory::disableIoUring()
+{
+    m_ioUringEnabled = false;
+}
+
 PollSetFactory* PollSetFactory::instance()
 {
     return s_instance;
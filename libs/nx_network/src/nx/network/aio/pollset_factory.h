@@ -21,10 +21,18 @@ public:
     void enableUdt();
     void disableUdt();
 
+    /**
+     * Makes create() return io_uring-based poll set when UDT is disabled and the kernel supports
+     * io_uring. Otherwise, the epoll-based PollSet is used. Has effect on Linux only.
+     */
+    void enableIoUring();
+    void disableIoUring();
+
     static PollSetFactory* instance();
 
 private:
     bool m_udtEnabled;
+    bool m_ioUringEnabled;
 };
 
 } // namespace aio
@@ -0,0 +1,557 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "pollset_io_uring_linux.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <nx/utils/log/log.h>
+#include <nx/utils/system_error.h>
+
+#include "pollable.h"
+
+namespace nx::network::aio {
+
+namespace io_uring_detail {
+
+static constexpr unsigned kCompletionQueueSize = 16 * 1024;
+
+/** User data values below this one are never used as subscription ids. */
+static constexpr std::uint64_t kInterruptUserData = 1;
+static constexpr std::uint64_t kTimeoutUserData = 2;
+static constexpr std::uint64_t kServiceUserData = 3;
+static constexpr std::uint64_t kFirstSubscriptionId = 16;
+
+static int ioUringSetup(unsigned entries, io_uring_params* params)
+{
+    return (int) syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return (int) syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0);
+}
+
+/**
+ * Minimal io_uring ring management built on raw syscalls, so that no liburing dependency is
+ * needed. Used by a single thread only.
+ */
+class Ring
+{
+public:
+    Ring(unsigned submissionQueueSize)
+    {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = kCompletionQueueSize;
+
+        m_fd = ioUringSetup(submissionQueueSize, &params);
+        if (m_fd < 0)
+            return;
+
+        if (!(params.features & IORING_FEAT_NODROP) || !mapQueues(params))
+            close();
+    }
+
+    ~Ring()
+    {
+        close();
+    }
+
+    bool isValid() const { return m_fd >= 0; }
+
+    unsigned freeSqeCount() const
+    {
+        const unsigned used = m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        return used >= m_sqEntryCount ? 0 : m_sqEntryCount - used;
+    }
+
+    /**
+     * @return Zeroed submission queue entry. The queue must not be full.
+     */
+    io_uring_sqe* allocateSqe()
+    {
+        const unsigned index = m_sqLocalTail & *m_sqRingMask;
+        m_sqArray[index] = index;
+        ++m_sqLocalTail;
+
+        io_uring_sqe* sqe = &m_sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    /**
+     * Submits all queued entries and waits for at least minComplete completions.
+     * @return -1 on error with errno set.
+     */
+    int enter(unsigned minComplete)
+    {
+        __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+        const unsigned toSubmit = m_sqLocalTail - m_sqSubmittedTail;
+
+        if (toSubmit == 0 && minComplete == 0 && !hasOverflownCompletions())
+            return 0;
+
+        const int result = ioUringEnter(m_fd, toSubmit, minComplete, IORING_ENTER_GETEVENTS);
+        if (result > 0)
+            m_sqSubmittedTail += (unsigned) result;
+        return result < 0 ? -1 : 0;
+    }
+
+    /**
+     * Queues IORING_OP_TIMEOUT which completes either after millisToWait or after any other
+     * single completion, so that it never outlives the wait it was queued for.
+     */
+    void queueTimeout(io_uring_sqe* sqe, int millisToWait, std::uint64_t userData)
+    {
+        // The kernel reads the value when the request is submitted by the following enter().
+        m_timeout.tv_sec = millisToWait / 1000;
+        m_timeout.tv_nsec = (millisToWait % 1000) * 1000000LL;
+
+        sqe->opcode = IORING_OP_TIMEOUT;
+        sqe->fd = -1;
+        sqe->addr = reinterpret_cast<std::uint64_t>(&m_timeout);
+        sqe->len = 1;
+        sqe->off = 1;
+        sqe->user_data = userData;
+    }
+
+    template<typename Func>
+    void forEachCompletion(Func func)
+    {
+        unsigned head = *m_cqHead;
+        const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head)
+        {
+            const io_uring_cqe& cqe = m_cqes[head & *m_cqRingMask];
+            func(cqe.user_data, cqe.res);
+        }
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    }
+
+private:
+    int m_fd = -1;
+
+    void* m_sqRing = MAP_FAILED;
+    size_t m_sqRingSize = 0;
+    void* m_cqRing = MAP_FAILED;
+    size_t m_cqRingSize = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    size_t m_sqesSize = 0;
+
+    unsigned* m_sqHead = nullptr;
+    unsigned* m_sqTail = nullptr;
+    unsigned* m_sqRingMask = nullptr;
+    unsigned* m_sqFlags = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned m_sqEntryCount = 0;
+    unsigned m_sqLocalTail = 0;
+    unsigned m_sqSubmittedTail = 0;
+
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned* m_cqRingMask = nullptr;
+    io_uring_cqe* m_cqes = nullptr;
+
+    __kernel_timespec m_timeout;
+
+    bool mapQueues(const io_uring_params& params)
+    {
+        m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool isSingleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (isSingleMmap)
+            m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+        m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        if (m_sqRing == MAP_FAILED)
+            return false;
+
+        if (isSingleMmap)
+        {
+            m_cqRing = m_sqRing;
+        }
+        else
+        {
+            m_cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+            if (m_cqRing == MAP_FAILED)
+                return false;
+        }
+
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED)
+            return false;
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(m_sqRing);
+        m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sqRingMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sqFlags = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+        m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_sqEntryCount = params.sq_entries;
+        m_sqLocalTail = m_sqSubmittedTail = *m_sqTail;
+
+        auto* cq = static_cast<char*>(m_cqRing);
+        m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cqRingMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        return true;
+    }
+
+    bool hasOverflownCompletions() const
+    {
+        #if defined(IORING_SQ_CQ_OVERFLOW)
+            return __atomic_load_n(m_sqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW;
+        #else
+            return false;
+        #endif
+    }
+
+    void close()
+    {
+        if (m_sqes)
+            munmap(m_sqes, m_sqesSize);
+        if (m_cqRing != MAP_FAILED && m_cqRing != m_sqRing)
+            munmap(m_cqRing, m_cqRingSize);
+        if (m_sqRing != MAP_FAILED)
+            munmap(m_sqRing, m_sqRingSize);
+        m_sqes = nullptr;
+        m_cqRing = m_sqRing = MAP_FAILED;
+
+        if (m_fd >= 0)
+            ::close(m_fd);
+        m_fd = -1;
+    }
+};
+
+static unsigned pollMask(EventType eventType)
+{
+    return eventType == etRead ? (POLLIN | POLLRDHUP) : POLLOUT;
+}
+
+static size_t subscriptionIndex(EventType eventType)
+{
+    return eventType == etRead ? 0 : 1;
+}
+
+/**
+ * Converts poll(2) result to the event reported the same way PollSet reports epoll events.
+ */
+static EventType toEventType(EventType subscribedEventType, int pollResult)
+{
+    if (pollResult < 0 || (pollResult & POLLERR))
+        return etError;
+
+    // Reporting connection closure as an error when writing data to provide behavior similar
+    // to recv/send functions: recv returns (ok, 0 bytes) while send reports an error.
+    if (subscribedEventType == etWrite && (pollResult & (POLLHUP | POLLRDHUP)))
+        return etError;
+
+    return subscribedEventType;
+}
+
+} using namespace io_uring_detail;
+
+//-------------------------------------------------------------------------------------------------
+// IoUringPollSet::Iterator.
+
+class IoUringPollSet::Iterator:
+    public AbstractPollSetIterator
+{
+public:
+    Iterator(const IoUringPollSet* pollSet): m_pollSet(pollSet) {}
+
+    virtual bool next() override
+    {
+        // Skipping events of the subscriptions removed after poll() has returned.
+        for (++m_index; m_index < m_pollSet->m_events.size(); ++m_index)
+        {
+            if (m_pollSet->isSubscribed(m_pollSet->m_events[m_index].subscriptionId))
+                return true;
+        }
+        return false;
+    }
+
+    virtual Pollable* socket() override
+    {
+        return m_pollSet->m_events[m_index].socket;
+    }
+
+    virtual const Pollable* socket() const override
+    {
+        return m_pollSet->m_events[m_index].socket;
+    }
+
+    virtual aio::EventType eventReceived() const override
+    {
+        return m_pollSet->m_events[m_index].eventType;
+    }
+
+private:
+    const IoUringPollSet* m_pollSet = nullptr;
+    size_t m_index = (size_t) -1;
+};
+
+//-------------------------------------------------------------------------------------------------
+// IoUringPollSet.
+
+IoUringPollSet::IoUringPollSet(unsigned submissionQueueSize):
+    m_ring(std::make_unique<Ring>(submissionQueueSize)),
+    m_eventFd(eventfd(0, EFD_NONBLOCK)),
+    m_lastSubscriptionId(kFirstSubscriptionId)
+{
+    if (isValid())
+        armInterrupt();
+}
+
+IoUringPollSet::~IoUringPollSet()
+{
+    // Closing the ring cancels all pending requests.
+    m_ring.reset();
+
+    if (m_eventFd >= 0)
+        close(m_eventFd);
+}
+
+bool IoUringPollSet::isValid() const
+{
+    return m_ring->isValid() && m_eventFd >= 0;
+}
+
+void IoUringPollSet::interrupt()
+{
+    uint64_t val = 1;
+    if (write(m_eventFd, &val, sizeof(val)) != sizeof(val))
+        NX_DEBUG(this, "Failed to signal eventfd. %1", SystemError::getLastOSErrorText());
+}
+
+bool IoUringPollSet::add(Pollable* const sock, EventType eventType, void* userData)
+{
+    auto& socketSubscriptions = m_sockets[sock];
+    std::uint64_t& id = socketSubscriptions[subscriptionIndex(eventType)];
+    if (id != 0)
+    {
+        // Event eventType is already monitored on the socket.
+        m_subscriptions[id].userData = userData;
+        return true;
+    }
+
+    id = ++m_lastSubscriptionId;
+    auto& subscription = m_subscriptions[id];
+    subscription.socket = sock;
+    subscription.eventType = eventType;
+    subscription.userData = userData;
+    armSubscription(id, &subscription);
+    return true;
+}
+
+void IoUringPollSet::remove(Pollable* const sock, EventType eventType)
+{
+    auto socketIt = m_sockets.find(sock);
+    if (socketIt == m_sockets.end())
+        return;
+
+    std::uint64_t& id = socketIt->second[subscriptionIndex(eventType)];
+    if (id == 0)
+        return;
+
+    auto subscriptionIt = m_subscriptions.find(id);
+    if (subscriptionIt->second.isArmed)
+    {
+        io_uring_sqe* sqe = allocateSqe();
+        sqe->opcode = IORING_OP_POLL_REMOVE;
+        sqe->fd = -1;
+        sqe->addr = id;
+        sqe->user_data = kServiceUserData;
+    }
+    // Completions of the removed subscription are ignored since its id is not found anymore.
+    m_subscriptions.erase(subscriptionIt);
+    id = 0;
+
+    if (socketIt->second[0] == 0 && socketIt->second[1] == 0)
+        m_sockets.erase(socketIt);
+}
+
+size_t IoUringPollSet::size() const
+{
+    return m_sockets.size();
+}
+
+int IoUringPollSet::poll(int millisToWait)
+{
+    m_events.clear();
+    m_isPolling = true;
+
+    rearmReportedSubscriptions();
+
+    // The interrupt and the timeout requests are queued last and must not be followed by
+    // draining completions: it could take the interrupt completion or the timeout could expire
+    // before the wait starts. So the space for them is made here, the events drained are
+    // reported by this call.
+    if (m_ring->freeSqeCount() < 2)
+        drainCompletions();
+    if (!m_isInterruptArmed)
+        armInterrupt();
+
+    unsigned minComplete = 0;
+    if (millisToWait != 0 && m_events.empty() && !m_isInterrupted)
+    {
+        minComplete = 1;
+        if (millisToWait > 0)
+            queueTimeout(millisToWait);
+    }
+
+    const int result = m_ring->enter(minComplete);
+    // Harvesting even on error: the ring may contain completions posted before the error.
+    harvestCompletions();
+    m_isPolling = false;
+    m_isInterrupted = false;
+    if (result < 0 && m_events.empty())
+        return -1;
+
+    return (int) m_events.size();
+}
+
+std::unique_ptr<AbstractPollSetIterator> IoUringPollSet::getSocketEventsIterator()
+{
+    return std::make_unique<Iterator>(this);
+}
+
+bool IoUringPollSet::isSupported()
+{
+    static const bool result = Ring(kDefaultSubmissionQueueSize).isValid();
+    return result;
+}
+
+io_uring_sqe* IoUringPollSet::allocateSqe()
+{
+    if (m_ring->freeSqeCount() == 0)
+        drainCompletions();
+
+    return m_ring->allocateSqe();
+}
+
+void IoUringPollSet::drainCompletions()
+{
+    // Submitting queued requests and draining completions to keep the completion queue from
+    // overflowing when the set is modified many times between poll() calls. Drained events are
+    // not lost: they are reported if poll() is running, and their subscriptions are re-armed by
+    // the next poll() call anyway.
+    m_ring->enter(/*minComplete*/ 0);
+    m_ring->forEachCompletion(
+        [this](std::uint64_t userData, int result)
+        {
+            processCompletion(userData, result, /*reportEvent*/ m_isPolling);
+        });
+}
+
+void IoUringPollSet::armSubscription(std::uint64_t id, Subscription* subscription)
+{
+    io_uring_sqe* sqe = allocateSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = subscription->socket->handle();
+    sqe->poll32_events = pollMask(subscription->eventType);
+    sqe->user_data = id;
+    subscription->isArmed = true;
+}
+
+void IoUringPollSet::armInterrupt()
+{
+    io_uring_sqe* sqe = allocateSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = m_eventFd;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = kInterruptUserData;
+    m_isInterruptArmed = true;
+}
+
+void IoUringPollSet::rearmReportedSubscriptions()
+{
+    // Arming may drain completions, which adds subscriptions to m_subscriptionsToRearm. They are
+    // left for the next poll() call: their events are reported by the current one.
+    std::vector<std::uint64_t> subscriptionsToRearm;
+    subscriptionsToRearm.swap(m_subscriptionsToRearm);
+
+    for (const auto id: subscriptionsToRearm)
+    {
+        auto it = m_subscriptions.find(id);
+        if (it != m_subscriptions.end() && !it->second.isArmed)
+            armSubscription(id, &it->second);
+    }
+}
+
+void IoUringPollSet::queueTimeout(int millisToWait)
+{
+    m_ring->queueTimeout(allocateSqe(), millisToWait, kTimeoutUserData);
+}
+
+void IoUringPollSet::harvestCompletions()
+{
+    m_ring->forEachCompletion(
+        [this](std::uint64_t userData, int result)
+        {
+            processCompletion(userData, result, /*reportEvent*/ true);
+        });
+}
+
+void IoUringPollSet::processCompletion(std::uint64_t userData, int result, bool reportEvent)
+{
+    if (userData == kInterruptUserData)
+    {
+        uint64_t val = 0;
+        if (read(m_eventFd, &val, sizeof(val)) == -1)
+            NX_VERBOSE(this, "Failed to read eventfd. %1", SystemError::getLastOSErrorText());
+        m_isInterruptArmed = false;
+        m_isInterrupted = true;
+        return;
+    }
+
+    if (userData < kFirstSubscriptionId || result == -ECANCELED)
+        return;
+
+    auto it = m_subscriptions.find(userData);
+    if (it == m_subscriptions.end())
+        return; //< The subscription has been removed.
+
+    Subscription& subscription = it->second;
+    subscription.isArmed = false;
+    m_subscriptionsToRearm.push_back(userData);
+    if (!reportEvent)
+        return;
+
+    const auto eventType = toEventType(subscription.eventType, result);
+    if (eventType == etError)
+    {
+        // Reporting an error on a socket once like PollSet does.
+        for (const auto& event: m_events)
+        {
+            if (event.socket == subscription.socket && event.eventType == etError)
+                return;
+        }
+    }
+
+    m_events.push_back({userData, subscription.socket, eventType});
+}
+
+bool IoUringPollSet::isSubscribed(std::uint64_t subscriptionId) const
+{
+    return m_subscriptions.find(subscriptionId) != m_subscriptions.end();
+}
+
+} // namespace nx::network::aio
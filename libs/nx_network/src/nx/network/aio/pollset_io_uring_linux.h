@@ -0,0 +1,106 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_pollset.h"
+
+struct io_uring_sqe;
+
+namespace nx::network::aio {
+
+namespace io_uring_detail { class Ring; }
+
+/**
+ * Linux io_uring-based poll set.
+ * Every (socket, event type) pair is monitored by a separate one-shot IORING_OP_POLL_ADD request.
+ * A reported request is re-armed by the next poll() call, which gives the same level-triggered
+ * semantics as the epoll-based PollSet. All registrations, removals and re-arms accumulated since
+ * the previous poll() call are submitted to the kernel with the same io_uring_enter call that
+ * waits for completions, so a loop iteration of AioThread costs a single syscall.
+ *
+ * Requires Linux 5.5+ (IORING_FEAT_NODROP). isValid() returns false on older kernels or when
+ * io_uring is disabled by the system, so the caller can fall back to PollSet.
+ * NOTE: This class is not thread-safe except for interrupt().
+ */
+class NX_NETWORK_API IoUringPollSet:
+    public AbstractPollSet
+{
+public:
+    static constexpr unsigned kDefaultSubmissionQueueSize = 1024;
+
+    /**
+     * @param submissionQueueSize Rounded up to a power of two by the kernel. The set works with
+     * any number of subscriptions, a small queue only makes the requests submitted more often.
+     */
+    explicit IoUringPollSet(unsigned submissionQueueSize = kDefaultSubmissionQueueSize);
+    virtual ~IoUringPollSet() override;
+
+    IoUringPollSet(const IoUringPollSet&) = delete;
+    IoUringPollSet& operator=(const IoUringPollSet&) = delete;
+
+    virtual bool isValid() const override;
+    virtual void interrupt() override;
+    virtual bool add(Pollable* const sock, EventType eventType, void* userData = nullptr) override;
+    virtual void remove(Pollable* const sock, EventType eventType) override;
+    virtual size_t size() const override;
+    virtual int poll(int millisToWait = kInfiniteTimeout) override;
+    virtual std::unique_ptr<AbstractPollSetIterator> getSocketEventsIterator() override;
+
+    /**
+     * @return true if the running kernel provides everything this class needs.
+     */
+    static bool isSupported();
+
+private:
+    class Iterator;
+
+    struct Subscription
+    {
+        Pollable* socket = nullptr;
+        EventType eventType = etNone;
+        void* userData = nullptr;
+        /** true while the poll request is known to the kernel and has not completed yet. */
+        bool isArmed = false;
+    };
+
+    struct Event
+    {
+        std::uint64_t subscriptionId = 0;
+        Pollable* socket = nullptr;
+        EventType eventType = etNone;
+    };
+
+    /** Subscription ids of the read and write events of a socket. 0 means "not subscribed". */
+    using SocketSubscriptions = std::array<std::uint64_t, 2>;
+
+    std::unique_ptr<io_uring_detail::Ring> m_ring;
+    int m_eventFd = -1;
+    bool m_isInterruptArmed = false;
+    /** The interrupt completion has been taken since the last poll() call returned. */
+    bool m_isInterrupted = false;
+    /** Set while poll() runs, so that the events of the drained completions are reported. */
+    bool m_isPolling = false;
+    std::uint64_t m_lastSubscriptionId = 0;
+    std::unordered_map<std::uint64_t, Subscription> m_subscriptions;
+    std::unordered_map<Pollable*, SocketSubscriptions> m_sockets;
+    std::vector<std::uint64_t> m_subscriptionsToRearm;
+    std::vector<Event> m_events;
+
+    io_uring_sqe* allocateSqe();
+    void drainCompletions();
+    void armSubscription(std::uint64_t id, Subscription* subscription);
+    void armInterrupt();
+    void rearmReportedSubscriptions();
+    void queueTimeout(int millisToWait);
+    void harvestCompletions();
+    void processCompletion(std::uint64_t userData, int result, bool reportEvent);
+    bool isSubscribed(std::uint64_t subscriptionId) const;
+};
+
+} // namespace nx::network::aio
@@ -0,0 +1,372 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "splice_channel_bridge_linux.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nx/network/common_socket_impl.h>
+#include <nx/network/system_socket.h>
+#include <nx/utils/log/log.h>
+
+#include "aio_event_handler.h"
+#include "aio_thread.h"
+
+namespace nx::network::aio {
+
+static constexpr unsigned int kSpliceFlags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+
+static bool isAgain(SystemError::ErrorCode errorCode)
+{
+    return errorCode == SystemError::wouldBlock
+        || errorCode == SystemError::again
+        || errorCode == SystemError::interrupted;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class SpliceChannelBridge::Pump:
+    public AIOEventHandler
+{
+public:
+    TCPSocket* const source;
+    TCPSocket* const destination;
+    std::atomic<std::uint64_t>* const bytesTransferred;
+    std::size_t pipeCapacity = 0;
+    std::size_t bytesInPipe = 0;
+    bool isSourceOpened = true;
+    bool isClosed = false;
+    int readPipe = -1;
+    int writePipe = -1;
+
+    Pump(
+        SpliceChannelBridge* bridge,
+        TCPSocket* source,
+        TCPSocket* destination,
+        std::atomic<std::uint64_t>* bytesTransferred)
+        :
+        source(source),
+        destination(destination),
+        bytesTransferred(bytesTransferred),
+        m_bridge(bridge)
+    {
+    }
+
+    virtual ~Pump() override
+    {
+        if (readPipe >= 0)
+            ::close(readPipe);
+        if (writePipe >= 0)
+            ::close(writePipe);
+    }
+
+    bool openPipe(std::size_t capacity)
+    {
+        int fds[2];
+        if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) != 0)
+            return false;
+
+        readPipe = fds[0];
+        writePipe = fds[1];
+        setPipeCapacity(capacity);
+        return pipeCapacity > 0;
+    }
+
+    void setPipeCapacity(std::size_t capacity)
+    {
+        // The kernel rounds the capacity up to the power of 2 pages. The request fails if it is
+        // above /proc/sys/fs/pipe-max-size for an unprivileged process. The current capacity is
+        // kept then.
+        if (::fcntl(writePipe, F_SETPIPE_SZ, (int) capacity) < 0)
+        {
+            NX_DEBUG(m_bridge, "Failed to set pipe capacity to %1. %2",
+                capacity, SystemError::getLastOSErrorText());
+        }
+
+        const int actualCapacity = ::fcntl(writePipe, F_GETPIPE_SZ);
+        pipeCapacity = actualCapacity > 0 ? (std::size_t) actualCapacity : 0;
+    }
+
+    /**
+     * The source is polled only while the pipe is empty. A partially filled pipe may not accept
+     * more data from the socket even though the socket is readable. Polling the source then
+     * would result in a busy loop. The source is read again after the pipe is drained.
+     */
+    void updateMonitoring()
+    {
+        const bool needRead = isSourceOpened && bytesInPipe == 0;
+        const bool needWrite = bytesInPipe > 0;
+
+        if (needRead != m_isReadMonitored)
+        {
+            if (needRead)
+                aioThread()->startMonitoring(source, aio::etRead, this);
+            else
+                aioThread()->stopMonitoring(source, aio::etRead);
+            m_isReadMonitored = needRead;
+        }
+
+        if (needWrite != m_isWriteMonitored)
+        {
+            if (needWrite)
+                aioThread()->startMonitoring(destination, aio::etWrite, this);
+            else
+                aioThread()->stopMonitoring(destination, aio::etWrite);
+            m_isWriteMonitored = needWrite;
+        }
+    }
+
+    void stopMonitoring()
+    {
+        if (m_isReadMonitored)
+            aioThread()->stopMonitoring(source, aio::etRead);
+        if (m_isWriteMonitored)
+            aioThread()->stopMonitoring(destination, aio::etWrite);
+        m_isReadMonitored = false;
+        m_isWriteMonitored = false;
+    }
+
+    virtual void eventTriggered(Pollable* /*sock*/, aio::EventType /*eventType*/) override
+    {
+        // Errors are reported by splice().
+        m_bridge->pump(this);
+    }
+
+private:
+    SpliceChannelBridge* const m_bridge;
+    bool m_isReadMonitored = false;
+    bool m_isWriteMonitored = false;
+
+    AioThread* aioThread() const
+    {
+        return source->impl()->aioThread->load();
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+
+std::unique_ptr<SpliceChannelBridge> SpliceChannelBridge::create(
+    std::unique_ptr<AbstractStreamSocket>* leftChannel,
+    std::unique_ptr<AbstractStreamSocket>* rightChannel)
+{
+    auto leftSocket = dynamic_cast<TCPSocket*>(leftChannel->get());
+    auto rightSocket = dynamic_cast<TCPSocket*>(rightChannel->get());
+    if (!leftSocket || !rightSocket)
+        return nullptr;
+
+    for (const auto socket: {leftSocket, rightSocket})
+    {
+        bool isNonBlocking = false;
+        if (!socket->getNonBlockingMode(&isNonBlocking) || !isNonBlocking)
+            return nullptr;
+    }
+
+    std::unique_ptr<SpliceChannelBridge> bridge(new SpliceChannelBridge());
+    bridge->m_leftToRight = std::make_unique<Pump>(
+        bridge.get(), leftSocket, rightSocket, &bridge->m_leftToRightBytes);
+    bridge->m_rightToLeft = std::make_unique<Pump>(
+        bridge.get(), rightSocket, leftSocket, &bridge->m_rightToLeftBytes);
+
+    if (!bridge->m_leftToRight->openPipe(kDefaultMaxSendQueueSizeBytes) ||
+        !bridge->m_rightToLeft->openPipe(kDefaultMaxSendQueueSizeBytes))
+    {
+        NX_DEBUG(typeid(SpliceChannelBridge), "Failed to create pipe. %1",
+            SystemError::getLastOSErrorText());
+        return nullptr;
+    }
+
+    bridge->m_leftChannel = std::move(*leftChannel);
+    bridge->m_rightChannel = std::move(*rightChannel);
+    bridge->bindToAioThread(bridge->m_leftChannel->getAioThread());
+
+    return bridge;
+}
+
+SpliceChannelBridge::SpliceChannelBridge() = default;
+
+SpliceChannelBridge::~SpliceChannelBridge()
+{
+    if (isInSelfAioThread())
+        stopWhileInAioThread();
+}
+
+void SpliceChannelBridge::bindToAioThread(aio::AbstractAioThread* aioThread)
+{
+    base_type::bindToAioThread(aioThread);
+
+    if (m_leftChannel)
+        m_leftChannel->bindToAioThread(aioThread);
+    if (m_rightChannel)
+        m_rightChannel->bindToAioThread(aioThread);
+    m_timer.bindToAioThread(aioThread);
+}
+
+void SpliceChannelBridge::setReadBufferSize(std::size_t readBufferSize)
+{
+    m_readBufferSize = readBufferSize;
+}
+
+void SpliceChannelBridge::setMaxSendQueueSizeBytes(std::size_t maxSendQueueSizeBytes)
+{
+    m_leftToRight->setPipeCapacity(maxSendQueueSizeBytes);
+    m_rightToLeft->setPipeCapacity(maxSendQueueSizeBytes);
+}
+
+void SpliceChannelBridge::setInactivityTimeout(std::chrono::milliseconds timeout)
+{
+    m_inactivityTimeout = timeout;
+}
+
+void SpliceChannelBridge::start(
+    nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> doneHandler)
+{
+    m_onDoneHandler = std::move(doneHandler);
+    post(
+        [this]()
+        {
+            m_leftToRight->updateMonitoring();
+            m_rightToLeft->updateMonitoring();
+            startInactivityTimerIfNeeded();
+        });
+}
+
+void SpliceChannelBridge::stopWhileInAioThread()
+{
+    m_timer.pleaseStopSync();
+    stopMonitoring();
+    m_leftToRight.reset();
+    m_rightToLeft.reset();
+
+    if (m_leftChannel)
+    {
+        m_leftChannel->pleaseStopSync();
+        m_leftChannel = nullptr;
+    }
+    if (m_rightChannel)
+    {
+        m_rightChannel->pleaseStopSync();
+        m_rightChannel = nullptr;
+    }
+}
+
+void SpliceChannelBridge::pump(Pump* pump)
+{
+    bool someActivity = false;
+    for (;;)
+    {
+        bool progressed = false;
+
+        if (pump->isSourceOpened && pump->bytesInPipe < pump->pipeCapacity)
+        {
+            const auto bytesRead = ::splice(
+                pump->source->handle(), nullptr, pump->writePipe, nullptr,
+                std::min(m_readBufferSize, pump->pipeCapacity - pump->bytesInPipe),
+                kSpliceFlags);
+            if (bytesRead > 0)
+            {
+                pump->bytesInPipe += (std::size_t) bytesRead;
+                progressed = true;
+            }
+            else if (bytesRead == 0)
+            {
+                pump->isSourceOpened = false;
+                progressed = true;
+            }
+            else if (const auto errorCode = SystemError::getLastOSErrorCode(); !isAgain(errorCode))
+            {
+                return handleChannelClosure(pump, errorCode);
+            }
+        }
+
+        if (pump->bytesInPipe > 0)
+        {
+            const auto bytesWritten = ::splice(
+                pump->readPipe, nullptr, pump->destination->handle(), nullptr,
+                pump->bytesInPipe,
+                kSpliceFlags);
+            if (bytesWritten > 0)
+            {
+                pump->bytesInPipe -= (std::size_t) bytesWritten;
+                *pump->bytesTransferred += (std::uint64_t) bytesWritten;
+                progressed = true;
+            }
+            else if (const auto errorCode = SystemError::getLastOSErrorCode();
+                bytesWritten < 0 && !isAgain(errorCode))
+            {
+                return handleChannelClosure(pump, errorCode);
+            }
+        }
+
+        if (!progressed)
+            break;
+        someActivity = true;
+    }
+
+    if (someActivity)
+        m_prevActivityTime = std::chrono::steady_clock::now();
+
+    if (!pump->isSourceOpened && pump->bytesInPipe == 0)
+        return handleChannelClosure(pump, SystemError::noError);
+
+    pump->updateMonitoring();
+}
+
+void SpliceChannelBridge::handleChannelClosure(Pump* pump, SystemError::ErrorCode reason)
+{
+    NX_VERBOSE(this, "Channel closed. %1", SystemError::toString(reason));
+
+    pump->stopMonitoring();
+    pump->isClosed = true;
+
+    const auto theOtherPump =
+        pump == m_leftToRight.get() ? m_rightToLeft.get() : m_leftToRight.get();
+
+    // Same as AsyncChannelBridgeImpl: the other direction is given a chance to deliver the data
+    // it has already read.
+    ++m_closedChannelCount;
+    if (m_closedChannelCount < 2 && theOtherPump->bytesInPipe > 0)
+        return;
+
+    reportFailure(reason);
+}
+
+void SpliceChannelBridge::startInactivityTimerIfNeeded()
+{
+    if (!m_inactivityTimeout)
+        return;
+
+    m_prevActivityTime = std::chrono::steady_clock::now();
+    m_timer.start(*m_inactivityTimeout, [this]() { onInactivityTimer(); });
+}
+
+void SpliceChannelBridge::onInactivityTimer()
+{
+    using namespace std::chrono;
+
+    const auto timeSincePrevActivity = steady_clock::now() - m_prevActivityTime;
+    if (timeSincePrevActivity >= *m_inactivityTimeout)
+        return reportFailure(SystemError::timedOut);
+
+    m_timer.start(
+        duration_cast<milliseconds>(*m_inactivityTimeout - timeSincePrevActivity),
+        [this]() { onInactivityTimer(); });
+}
+
+void SpliceChannelBridge::reportFailure(SystemError::ErrorCode sysErrorCode)
+{
+    stopMonitoring();
+    m_timer.cancelSync();
+
+    if (m_onDoneHandler)
+        nx::utils::swapAndCall(m_onDoneHandler, sysErrorCode);
+}
+
+void SpliceChannelBridge::stopMonitoring()
+{
+    if (m_leftToRight)
+        m_leftToRight->stopMonitoring();
+    if (m_rightToLeft)
+        m_rightToLeft->stopMonitoring();
+}
+
+} // namespace nx::network::aio
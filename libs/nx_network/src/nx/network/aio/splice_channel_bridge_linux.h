@@ -0,0 +1,74 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+#include "async_channel_bridge.h"
+#include "timer.h"
+
+namespace nx::network { class AbstractStreamSocket; }
+
+namespace nx::network::aio {
+
+/**
+ * Bridge between two plain TCP sockets that moves data with splice(2) through a pipe per
+ * direction. So, the data is not copied to the user space and back.
+ * AsyncChannelBridge behavior applies. setReadBufferSize() limits the size of a single splice()
+ * call, setMaxSendQueueSizeBytes() sets the pipe capacity.
+ * The sockets are polled directly by the AIO thread. So, no asynchronous operation must be
+ * running on them when the bridge is created.
+ */
+class NX_NETWORK_API SpliceChannelBridge:
+    public AsyncChannelBridge
+{
+    using base_type = AsyncChannelBridge;
+
+public:
+    /**
+     * @return The bridge if both sockets are plain TCP sockets in the non-blocking mode and the
+     * pipes have been created. Otherwise, null and the sockets are left intact.
+     */
+    static std::unique_ptr<SpliceChannelBridge> create(
+        std::unique_ptr<AbstractStreamSocket>* leftChannel,
+        std::unique_ptr<AbstractStreamSocket>* rightChannel);
+
+    virtual ~SpliceChannelBridge() override;
+
+    virtual void bindToAioThread(aio::AbstractAioThread* aioThread) override;
+
+    virtual void setReadBufferSize(std::size_t readBufferSize) override;
+    virtual void setMaxSendQueueSizeBytes(std::size_t maxSendQueueSizeBytes) override;
+    virtual void setInactivityTimeout(std::chrono::milliseconds timeout) override;
+    virtual void start(nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> doneHandler) override;
+
+protected:
+    virtual void stopWhileInAioThread() override;
+
+private:
+    class Pump;
+
+    SpliceChannelBridge();
+
+    std::unique_ptr<AbstractStreamSocket> m_leftChannel;
+    std::unique_ptr<AbstractStreamSocket> m_rightChannel;
+    std::unique_ptr<Pump> m_leftToRight;
+    std::unique_ptr<Pump> m_rightToLeft;
+    std::size_t m_readBufferSize = kDefaultReadBufferSize;
+    nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> m_onDoneHandler;
+    int m_closedChannelCount = 0;
+    std::optional<std::chrono::milliseconds> m_inactivityTimeout;
+    aio::Timer m_timer;
+    std::chrono::steady_clock::time_point m_prevActivityTime;
+
+    void pump(Pump* pump);
+    void handleChannelClosure(Pump* pump, SystemError::ErrorCode reason);
+    void startInactivityTimerIfNeeded();
+    void onInactivityTimer();
+    void reportFailure(SystemError::ErrorCode sysErrorCode);
+    void stopMonitoring();
+};
+
+} // namespace nx::network::aio
@@ -2,6 +2,7 @@
 
 #include "stream_transforming_async_channel.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include <nx/utils/log/log.h>
@@ -320,6 +321,14 @@ int StreamTransformingAsyncChannel::readRawDataFromCache(
     return (int)bytesRead;
 }
 
+bool StreamTransformingAsyncChannel::isSendQueueEmpty() const
+{
+    return m_rawWriteQueue.empty()
+        && std::none_of(
+            m_userTaskQueue.begin(), m_userTaskQueue.end(),
+            [](const auto& task) { return task->type == detail::UserTaskType::write; });
+}
+
 void StreamTransformingAsyncChannel::pause()
 {
     m_pauseLevel++;
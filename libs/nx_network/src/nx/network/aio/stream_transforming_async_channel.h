@@ -56,6 +56,13 @@ public:
 
     int readRawDataFromCache(void* data, size_t count);
 
+    /**
+     * @return true if there is no user data waiting to be converted and no converted data
+     * waiting to be sent through the raw channel.
+     * NOTE: Must be called within the object's AIO thread.
+     */
+    bool isSendQueueEmpty() const;
+
     /**
      * Stops handing of any I/O events from the wrapped channel until the
      * corresponding resume() call. Recursive calling is supported.
@@ -5,6 +5,8 @@
 #include <nx/network/socket_global.h>
 #include <nx/utils/move_only_func.h>
 
+#include "connect_history.h"
+
 namespace nx::network::cloud {
 
 AnyAccessibleAddressConnector::AnyAccessibleAddressConnector(
@@ -23,12 +25,28 @@ void AnyAccessibleAddressConnector::bindToAioThread(aio::AbstractAioThread* aioT
     base_type::bindToAioThread(aioThread);
 
     m_timer.bindToAioThread(aioThread);
+    m_nextAttemptTimer.bindToAioThread(aioThread);
+
+    for (auto& attempt: m_attempts)
+    {
+        if (attempt.directConnection)
+            attempt.directConnection->bindToAioThread(aioThread);
+        if (attempt.cloudConnector)
+            attempt.cloudConnector->bindToAioThread(aioThread);
+    }
+}
 
-    for (auto& connection: m_directConnections)
-        connection->bindToAioThread(aioThread);
+void AnyAccessibleAddressConnector::setConnectAttemptDelay(std::chrono::milliseconds delay)
+{
+    m_connectAttemptDelay = delay;
+}
 
-    for (auto& connector: m_cloudConnectors)
-        connector->bindToAioThread(aioThread);
+void AnyAccessibleAddressConnector::setConnectHistory(
+    ConnectHistory* history,
+    std::string target)
+{
+    m_connectHistory = history;
+    m_target = std::move(target);
 }
 
 void AnyAccessibleAddressConnector::connectAsync(
@@ -45,19 +63,26 @@ void AnyAccessibleAddressConnector::connectAsync(
     dispatch(
         [this]()
         {
-            m_awaitedConnectOperationCount = 0;
-            m_directConnections.clear();
-            m_cloudConnectors.clear();
+            m_attempts.clear();
+            m_nextEntryIndex = 0;
+            m_lastErrorCode = SystemError::invalidData;
+            m_connectStartTime = std::chrono::steady_clock::now();
 
-            for (const auto& entry: m_entries)
-                connectToEntryAsync(entry);
+            if (m_connectHistory)
+            {
+                m_connectHistory->sort(m_target, &m_entries);
+                NX_VERBOSE(this, "Entries of %1 ordered by history: %2",
+                    m_target, containerString(m_entries));
+            }
 
-            if (m_awaitedConnectOperationCount == 0)
+            startNextAttempts();
+
+            if (m_attempts.empty())
             {
                 return post(
                     [this]()
                     {
-                        cleanUpAndReportResult(SystemError::invalidData, std::nullopt, nullptr);
+                        cleanUpAndReportResult(m_lastErrorCode, std::nullopt, nullptr);
                     });
             }
 
@@ -77,14 +102,15 @@ void AnyAccessibleAddressConnector::stopWhileInAioThread()
     base_type::stopWhileInAioThread();
 
     m_timer.pleaseStopSync();
-    m_directConnections.clear();
-    m_cloudConnectors.clear();
+    m_nextAttemptTimer.pleaseStopSync();
 
-    if (m_awaitedConnectOperationCount > 0)
+    if (!m_attempts.empty())
     {
         NX_VERBOSE(this, "Interrupting ongoing %1 connection(s) to %2",
-            m_awaitedConnectOperationCount, containerString(m_entries));
+            m_attempts.size(), containerString(m_entries));
     }
+
+    m_attempts.clear();
 }
 
 std::unique_ptr<AbstractStreamSocket> AnyAccessibleAddressConnector::createTcpSocket(int ipVersion)
@@ -92,50 +118,77 @@ std::unique_ptr<AbstractStreamSocket> AnyAccessibleAddressConnector::createTcpSo
     return std::make_unique<TCPSocket>(ipVersion);
 }
 
-void AnyAccessibleAddressConnector::connectToEntryAsync(const AddressEntry& dnsEntry)
+void AnyAccessibleAddressConnector::startNextAttempts()
 {
-    using namespace std::placeholders;
+    m_nextAttemptTimer.cancelSync();
+
+    while (m_nextEntryIndex < m_entries.size())
+    {
+        const bool started = connectToEntryAsync(m_entries[m_nextEntryIndex++]);
+        if (started && m_connectAttemptDelay > std::chrono::milliseconds::zero())
+            break;
+    }
+
+    if (!m_attempts.empty() && m_nextEntryIndex < m_entries.size())
+        m_nextAttemptTimer.start(m_connectAttemptDelay, [this]() { startNextAttempts(); });
+}
+
+bool AnyAccessibleAddressConnector::connectToEntryAsync(const AddressEntry& dnsEntry)
+{
+    auto attemptIter = m_attempts.insert(
+        m_attempts.end(),
+        Attempt{dnsEntry, std::chrono::steady_clock::now(), nullptr, nullptr});
 
     switch (dnsEntry.type)
     {
         case AddressType::direct:
-        {
-            SocketAddress endpoint;
-            endpoint.address = std::move(dnsEntry.host);
-            for (const auto& attr: dnsEntry.attributes)
-            {
-                if (attr.type == AddressAttributeType::port)
-                    endpoint.port = static_cast<quint16>(attr.value);
-            }
-
-            if (establishDirectConnection(std::move(endpoint)))
-                ++m_awaitedConnectOperationCount;
+            if (establishDirectConnection(attemptIter))
+                return true;
             break;
-        }
 
         case AddressType::cloud:
         case AddressType::unknown:  //< If peer is unknown, trying to establish cloud connect.
-        {
-            establishCloudConnection(dnsEntry);
-            ++m_awaitedConnectOperationCount;
-            break;
-        }
+            establishCloudConnection(attemptIter);
+            return true;
 
         default:
             NX_ASSERT(false);
             break;
     }
+
+    m_attempts.erase(attemptIter);
+    return false;
+}
+
+std::chrono::milliseconds AnyAccessibleAddressConnector::attemptTimeout() const
+{
+    using namespace std::chrono;
+
+    if (m_timeout == milliseconds::zero())
+        return m_timeout;
+
+    // The attempts started later must not exceed the timeout of the whole operation.
+    const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - m_connectStartTime);
+    return std::max(m_timeout - elapsed, milliseconds(1));
 }
 
-bool AnyAccessibleAddressConnector::establishDirectConnection(const SocketAddress& endpoint)
+bool AnyAccessibleAddressConnector::establishDirectConnection(Attempts::iterator attemptIter)
 {
     using namespace std::placeholders;
 
+    SocketAddress endpoint;
+    endpoint.address = attemptIter->entry.host;
+    for (const auto& attr: attemptIter->entry.attributes)
+    {
+        if (attr.type == AddressAttributeType::port)
+            endpoint.port = static_cast<quint16>(attr.value);
+    }
+
     NX_VERBOSE(this, "Trying direct connection to %1", endpoint);
 
     auto tcpSocket = createTcpSocket(m_ipVersion);
     tcpSocket->bindToAioThread(getAioThread());
-    if (!tcpSocket->setNonBlockingMode(true) || !tcpSocket->setSendTimeout(m_timeout))
+    if (!tcpSocket->setNonBlockingMode(true) || !tcpSocket->setSendTimeout(attemptTimeout()))
     {
         NX_VERBOSE(this, "Failed to configure socket for %1. %2",
             endpoint, SystemError::getLastOSErrorText());
@@ -143,59 +196,66 @@ bool AnyAccessibleAddressConnector::establishDirectConnection(const SocketAddres
     }
 
     auto tpcSocketPtr = tcpSocket.get();
-    m_directConnections.push_back(std::move(tcpSocket));
+    attemptIter->directConnection = std::move(tcpSocket);
 
     tpcSocketPtr->connectAsync(
         endpoint,
-        std::bind(&AnyAccessibleAddressConnector::onDirectConnectDone, this,
-            _1, --m_directConnections.end()));
+        std::bind(&AnyAccessibleAddressConnector::onDirectConnectDone, this, _1, attemptIter));
     return true;
 }
 
 void AnyAccessibleAddressConnector::onDirectConnectDone(
     SystemError::ErrorCode sysErrorCode,
-    std::list<std::unique_ptr<AbstractStreamSocket>>::iterator directConnectionIter)
+    Attempts::iterator attemptIter)
 {
-    auto tcpSocket = std::move(*directConnectionIter);
-    m_directConnections.erase(directConnectionIter);
+    auto attempt = std::move(*attemptIter);
+    m_attempts.erase(attemptIter);
+
+    auto tcpSocket = std::move(attempt.directConnection);
     if (sysErrorCode != SystemError::noError)
         tcpSocket.reset();
     else
         tcpSocket->cancelIOSync(aio::etNone);
 
-    onConnectDone(sysErrorCode, AddressType::direct, std::nullopt, std::move(tcpSocket));
+    onConnectDone(sysErrorCode, attempt, AddressType::direct, std::nullopt, std::move(tcpSocket));
 }
 
 void AnyAccessibleAddressConnector::onConnectDone(
     SystemError::ErrorCode sysErrorCode,
+    const Attempt& attempt,
     AddressType addressType,
     std::optional<TunnelAttributes> cloudTunnelAttributes,
     std::unique_ptr<AbstractStreamSocket> connection)
 {
-    NX_VERBOSE(this, "Connection completed with result %1, type %2",
-        SystemError::toString(sysErrorCode), addressType);
+    NX_VERBOSE(this, "Connection to %1 completed with result %2, type %3",
+        attempt.entry, SystemError::toString(sysErrorCode), addressType);
 
-    if (sysErrorCode == SystemError::noError)
-    {
-        if (!cloudTunnelAttributes)
-            cloudTunnelAttributes = TunnelAttributes();
-        cloudTunnelAttributes->addressType = addressType;
-    }
-    else
+    saveResultToHistory(sysErrorCode, attempt);
+
+    if (sysErrorCode != SystemError::noError)
     {
         NX_ASSERT(!connection);
-    }
+        m_lastErrorCode = sysErrorCode;
 
-    --m_awaitedConnectOperationCount;
-    if (m_awaitedConnectOperationCount > 0 && sysErrorCode != SystemError::noError)
-    {
-        NX_VERBOSE(this, "Waiting for another %1 connections to complete...",
-            m_awaitedConnectOperationCount);
-        return; //< Waiting for other operations to finish.
+        // Not waiting for the connect attempt delay to try the next entry.
+        if (m_nextEntryIndex < m_entries.size())
+            startNextAttempts();
+
+        if (!m_attempts.empty())
+        {
+            NX_VERBOSE(this, "Waiting for another %1 connections to complete...",
+                m_attempts.size());
+            return; //< Waiting for other operations to finish.
+        }
+
+        return cleanUpAndReportResult(sysErrorCode, std::nullopt, nullptr);
     }
 
-    if (connection)
-        m_socketAttributes.applyTo(connection.get());
+    if (!cloudTunnelAttributes)
+        cloudTunnelAttributes = TunnelAttributes();
+    cloudTunnelAttributes->addressType = addressType;
+
+    m_socketAttributes.applyTo(connection.get());
 
     cleanUpAndReportResult(
         sysErrorCode,
@@ -203,37 +263,62 @@ void AnyAccessibleAddressConnector::onConnectDone(
         std::move(connection));
 }
 
-void AnyAccessibleAddressConnector::establishCloudConnection(const AddressEntry& dnsEntry)
+void AnyAccessibleAddressConnector::saveResultToHistory(
+    SystemError::ErrorCode sysErrorCode,
+    const Attempt& attempt)
+{
+    using namespace std::chrono;
+
+    if (!m_connectHistory)
+        return;
+
+    if (sysErrorCode == SystemError::noError)
+    {
+        m_connectHistory->saveSuccess(
+            m_target,
+            attempt.entry,
+            duration_cast<milliseconds>(steady_clock::now() - attempt.startTime));
+    }
+    else
+    {
+        m_connectHistory->saveFailure(m_target, attempt.entry);
+    }
+}
+
+void AnyAccessibleAddressConnector::establishCloudConnection(Attempts::iterator attemptIter)
 {
     using namespace std::placeholders;
 
-    NX_VERBOSE(this, "Trying cloud connection to %1", dnsEntry.host);
+    NX_VERBOSE(this, "Trying cloud connection to %1", attemptIter->entry.host);
 
     auto cloudConnector = std::make_unique<CloudAddressConnector>(
-        dnsEntry,
-        m_timeout,
+        attemptIter->entry,
+        attemptTimeout(),
         m_socketAttributes);
     cloudConnector->bindToAioThread(getAioThread());
     auto cloudConnectorPtr = cloudConnector.get();
-    m_cloudConnectors.push_back(std::move(cloudConnector));
+    attemptIter->cloudConnector = std::move(cloudConnector);
 
     cloudConnectorPtr->connectAsync(
         std::bind(&AnyAccessibleAddressConnector::onCloudConnectDone, this,
-            _1, _2, _3, --m_cloudConnectors.end()));
+            _1, _2, _3, attemptIter));
 }
 
 void AnyAccessibleAddressConnector::onCloudConnectDone(
     SystemError::ErrorCode sysErrorCode,
     TunnelAttributes cloudTunnelAttributes,
     std::unique_ptr<AbstractStreamSocket> connection,
-    std::list<std::unique_ptr<CloudAddressConnector>>::iterator connectorIter)
+    Attempts::iterator attemptIter)
 {
     NX_ASSERT(isInSelfAioThread());
 
-    m_cloudConnectors.erase(connectorIter);
+    auto attempt = std::move(*attemptIter);
+    m_attempts.erase(attemptIter);
+    attempt.cloudConnector.reset();
 
     onConnectDone(
         sysErrorCode,
+        attempt,
         AddressType::cloud,
         std::move(cloudTunnelAttributes),
         std::move(connection));
@@ -257,9 +342,8 @@ void AnyAccessibleAddressConnector::cleanUpAndReportResult(
     NX_ASSERT(isInSelfAioThread());
 
     m_timer.cancelSync();
-    m_directConnections.clear();
-    m_cloudConnectors.clear();
-    m_awaitedConnectOperationCount = 0;
+    m_nextAttemptTimer.cancelSync();
+    m_attempts.clear();
 
     nx::utils::swapAndCall(
         m_handler,
@@ -6,6 +6,7 @@
 #include <deque>
 #include <list>
 #include <optional>
+#include <string>
 
 #include <nx/network/address_resolver.h>
 #include <nx/network/aio/basic_pollable.h>
@@ -19,8 +20,13 @@
 
 namespace nx::network::cloud {
 
+class ConnectHistory;
+
 /**
  * Connects to any accessible address from the address list provided.
+ * The connections are raced: the next entry is tried if the previous attempts have not completed
+ * within the connect attempt delay or as soon as all of them have failed. The first established
+ * connection is reported, the others are cancelled.
  */
 class NX_NETWORK_API AnyAccessibleAddressConnector:
     public aio::BasicPollable
@@ -33,12 +39,29 @@ public:
         std::optional<TunnelAttributes> /*cloudTunnelAttributes*/,
         std::unique_ptr<AbstractStreamSocket>)>;
 
+    /** Same as the Connection Attempt Delay recommended by RFC 8305. */
+    static constexpr std::chrono::milliseconds kDefaultConnectAttemptDelay =
+        std::chrono::milliseconds(250);
+
     AnyAccessibleAddressConnector(
         int ipVersion,
         std::deque<AddressEntry> entries);
 
     virtual void bindToAioThread(aio::AbstractAioThread* aioThread) override;
 
+    /**
+     * @param delay Zero means connecting to all entries at once.
+     * Must be called before connectAsync.
+     */
+    void setConnectAttemptDelay(std::chrono::milliseconds delay);
+
+    /**
+     * The entries are tried in the order suggested by the history. The results are saved to it.
+     * @param target The history key. E.g., the name the entries have been resolved from.
+     * Must be called before connectAsync.
+     */
+    void setConnectHistory(ConnectHistory* history, std::string target);
+
     /**
      * @param timeout Zero means no timeout.
      */
@@ -53,44 +76,69 @@ protected:
     virtual std::unique_ptr<AbstractStreamSocket> createTcpSocket(int ipVersion);
 
 private:
+    struct Attempt
+    {
+        AddressEntry entry;
+        std::chrono::steady_clock::time_point startTime;
+        std::unique_ptr<AbstractStreamSocket> directConnection;
+        std::unique_ptr<CloudAddressConnector> cloudConnector;
+    };
+
+    using Attempts = std::list<Attempt>;
+
     const int m_ipVersion;
     std::deque<AddressEntry> m_entries;
+    std::size_t m_nextEntryIndex = 0;
     std::chrono::milliseconds m_timeout;
+    std::chrono::steady_clock::time_point m_connectStartTime;
+    std::chrono::milliseconds m_connectAttemptDelay = kDefaultConnectAttemptDelay;
+    ConnectHistory* m_connectHistory = nullptr;
+    std::string m_target;
     StreamSocketAttributes m_socketAttributes;
     ConnectHandler m_handler;
     aio::Timer m_timer;
-    int m_awaitedConnectOperationCount = 0;
-    std::list<std::unique_ptr<AbstractStreamSocket>> m_directConnections;
-    std::list<std::unique_ptr<CloudAddressConnector>> m_cloudConnectors;
+    aio::Timer m_nextAttemptTimer;
+    Attempts m_attempts;
+    SystemError::ErrorCode m_lastErrorCode = SystemError::invalidData;
 
-    void connectToEntryAsync(const AddressEntry& dnsEntry);
+    void startNextAttempts();
+
+    /**
+     * @return false if the connection could not be started.
+     */
+    bool connectToEntryAsync(const AddressEntry& dnsEntry);
+
+    std::chrono::milliseconds attemptTimeout() const;
 
     void onTimeout();
 
-    bool establishDirectConnection(const SocketAddress& endpoint);
+    bool establishDirectConnection(Attempts::iterator attemptIter);
 
     void onDirectConnectDone(
         SystemError::ErrorCode sysErrorCode,
-        std::list<std::unique_ptr<AbstractStreamSocket>>::iterator directConnectionIter);
+        Attempts::iterator attemptIter);
 
     void onConnectDone(
         SystemError::ErrorCode sysErrorCode,
+        const Attempt& attempt,
         AddressType addressType,
         std::optional<TunnelAttributes> cloudTunnelAttributes,
         std::unique_ptr<AbstractStreamSocket> connection);
 
+    void saveResultToHistory(SystemError::ErrorCode sysErrorCode, const Attempt& attempt);
+
     void cleanUpAndReportResult(
         SystemError::ErrorCode sysErrorCode,
         std::optional<TunnelAttributes> cloudTunnelAttributes,
         std::unique_ptr<AbstractStreamSocket> connection);
 
-    void establishCloudConnection(const AddressEntry& dnsEntry);
+    void establishCloudConnection(Attempts::iterator attemptIter);
 
     void onCloudConnectDone(
         SystemError::ErrorCode sysErrorCode,
         TunnelAttributes cloudTunnelAttributes,
         std::unique_ptr<AbstractStreamSocket> connection,
-        std::list<std::unique_ptr<CloudAddressConnector>>::iterator connectorIter);
+        Attempts::iterator attemptIter);
 };
 
 } // namespace nx::network::cloud
@@ -15,6 +15,7 @@
 #include <nx/utils/timer_manager.h>
 
 #include "cloud_connect_settings.h"
+#include "connect_history.h"
 #include "mediator_address_publisher.h"
 #include "mediator_connector.h"
 #include "mediator/api/mediator_api_client.h"
@@ -35,6 +36,7 @@ struct CloudConnectControllerImpl
     hpm::api::MediatorConnector mediatorConnector;
     MediatorAddressPublisher addressPublisher;
     OutgoingTunnelPool outgoingTunnelPool;
+    ConnectHistory connectHistory;
 
     CloudConnectControllerImpl(
         const std::string& customCloudHost,
@@ -112,6 +114,11 @@ CloudConnectSettings& CloudConnectController::settings()
     return m_impl->settings;
 }
 
+ConnectHistory& CloudConnectController::connectHistory()
+{
+    return m_impl->connectHistory;
+}
+
 void CloudConnectController::reinitialize()
 {
     auto cloudHost = m_impl->cloudHost;
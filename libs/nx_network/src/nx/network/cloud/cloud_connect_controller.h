@@ -13,6 +13,7 @@ namespace nx::network::aio { class AIOService; }
 
 namespace nx::network::cloud {
 
+class ConnectHistory;
 class MediatorAddressPublisher;
 class OutgoingTunnelPool;
 class CloudConnectSettings;
@@ -35,6 +36,7 @@ public:
     MediatorAddressPublisher& addressPublisher();
     OutgoingTunnelPool& outgoingTunnelPool();
     CloudConnectSettings& settings();
+    ConnectHistory& connectHistory();
 
     /**
      * Deletes all objects and creates them.
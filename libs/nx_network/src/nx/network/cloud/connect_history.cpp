@@ -0,0 +1,90 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "connect_history.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace nx::network::cloud {
+
+ConnectHistory::ConnectHistory(std::size_t maxTargetCount):
+    m_targets(maxTargetCount)
+{
+}
+
+void ConnectHistory::saveSuccess(
+    const std::string& target,
+    const AddressEntry& entry,
+    std::chrono::milliseconds connectTime)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    if (!m_targets.contains(target))
+        m_targets.put(target, TargetStatistics());
+
+    auto& statistics = m_targets.getValue(target)->get()[entry.toString()];
+    statistics.lastSuccessTime = std::chrono::steady_clock::now();
+    statistics.connectTime = connectTime;
+    statistics.consecutiveFailures = 0;
+}
+
+void ConnectHistory::saveFailure(const std::string& target, const AddressEntry& entry)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    if (!m_targets.contains(target))
+        m_targets.put(target, TargetStatistics());
+
+    auto& statistics = m_targets.getValue(target)->get()[entry.toString()];
+    statistics.lastSuccessTime = std::nullopt;
+    ++statistics.consecutiveFailures;
+}
+
+void ConnectHistory::sort(const std::string& target, std::deque<AddressEntry>* entries)
+{
+    using namespace std::chrono;
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    const auto targetStatistics = m_targets.getValue(target);
+    if (!targetStatistics)
+        return;
+
+    const auto now = steady_clock::now();
+
+    // The smaller key goes first.
+    const auto key =
+        [&targetStatistics, now](const AddressEntry& entry)
+        {
+            const auto& statistics = targetStatistics->get();
+            const auto it = statistics.find(entry.toString());
+            if (it == statistics.end())
+                return std::make_tuple(1, 0, milliseconds::zero());
+
+            if (it->second.lastSuccessTime
+                && now - *it->second.lastSuccessTime < kSuccessExpirationPeriod)
+            {
+                return std::make_tuple(0, 0, it->second.connectTime);
+            }
+
+            if (it->second.consecutiveFailures == 0)
+                return std::make_tuple(1, 0, milliseconds::zero());
+
+            return std::make_tuple(2, it->second.consecutiveFailures, milliseconds::zero());
+        };
+
+    std::stable_sort(
+        entries->begin(), entries->end(),
+        [&key](const AddressEntry& left, const AddressEntry& right)
+        {
+            return key(left) < key(right);
+        });
+}
+
+void ConnectHistory::clear()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_targets.clear();
+}
+
+} // namespace nx::network::cloud
@@ -0,0 +1,62 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+
+#include <nx/network/resolve/address_entry.h>
+#include <nx/utils/data_structures/lru_cache.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::network::cloud {
+
+/**
+ * Remembers the results of connecting to the address entries of each target (a host name or a
+ * system id). Used to try the entry that worked last time first.
+ * Thread-safe.
+ */
+class NX_NETWORK_API ConnectHistory
+{
+public:
+    static constexpr std::size_t kDefaultMaxTargetCount = 1024;
+
+    /** A success older than this is not preferred over the entries with no history. */
+    static constexpr std::chrono::hours kSuccessExpirationPeriod = std::chrono::hours(1);
+
+    ConnectHistory(std::size_t maxTargetCount = kDefaultMaxTargetCount);
+
+    void saveSuccess(
+        const std::string& target,
+        const AddressEntry& entry,
+        std::chrono::milliseconds connectTime);
+
+    void saveFailure(const std::string& target, const AddressEntry& entry);
+
+    /**
+     * Orders the entries as follows: the ones that have recently been connected to (the faster
+     * one goes first), the ones with no history, the ones that have failed (the fewer
+     * consecutive failures, the earlier). The original order of the equal entries is preserved.
+     */
+    void sort(const std::string& target, std::deque<AddressEntry>* entries);
+
+    void clear();
+
+private:
+    struct EntryStatistics
+    {
+        std::optional<std::chrono::steady_clock::time_point> lastSuccessTime;
+        std::chrono::milliseconds connectTime = std::chrono::milliseconds::zero();
+        int consecutiveFailures = 0;
+    };
+
+    using TargetStatistics = std::map<std::string /*entry*/, EntryStatistics>;
+
+    nx::Mutex m_mutex;
+    nx::utils::LruCache<std::string /*target*/, TargetStatistics> m_targets;
+};
+
+} // namespace nx::network::cloud
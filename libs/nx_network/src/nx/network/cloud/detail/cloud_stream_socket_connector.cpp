@@ -3,6 +3,8 @@
 #include "cloud_stream_socket_connector.h"
 
 #include <nx/network/address_resolver.h>
+#include <nx/network/cloud/cloud_connect_controller.h>
+#include <nx/network/cloud/connect_history.h>
 #include <nx/network/socket_global.h>
 #include <nx/utils/log/log.h>
 
@@ -91,6 +93,8 @@ void CloudStreamSocketConnector::connectToEntriesAsync(
     m_multipleAddressConnector = std::make_unique<AnyAccessibleAddressConnector>(
         m_ipVersion,
         std::move(dnsEntries));
+    m_multipleAddressConnector->setConnectHistory(
+        &SocketGlobals::cloud().connectHistory(), m_addr.address.toString());
     addDependant(m_multipleAddressConnector.get(), [this]() { m_multipleAddressConnector.reset(); });
     m_multipleAddressConnector->connectAsync(
         m_timeout,
@@ -0,0 +1,440 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "benchmark_client.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+#include <nx/network/aio/aio_service.h>
+#include <nx/network/aio/basic_pollable.h>
+#include <nx/network/aio/timer.h>
+#include <nx/network/cloud/cloud_stream_socket.h>
+#include <nx/network/http/http_types.h>
+#include <nx/network/http/tunneling/client.h>
+#include <nx/network/socket_factory.h>
+#include <nx/network/socket_global.h>
+#include <nx/network/ssl/context.h>
+#include <nx/network/ssl/ssl_stream_socket.h>
+#include <nx/network/system_socket.h>
+#include <nx/network/udt/udt_socket.h>
+#include <nx/network/url/url_builder.h>
+#include <nx/utils/log/log.h>
+#include <nx/utils/random.h>
+
+namespace nx::network::cloud::speed_test::benchmark {
+
+using namespace std::chrono;
+
+static constexpr std::size_t kReadBufferSize = 64 * 1024;
+
+/** Nearest-rank percentile of the sorted samples. */
+static microseconds percentile(const std::vector<microseconds>& sortedSamples, double value)
+{
+    const auto rank = (std::size_t) std::ceil(value * sortedSamples.size());
+    return sortedSamples[std::clamp<std::size_t>(rank, 1, sortedSamples.size()) - 1];
+}
+
+LatencyStatistics LatencyStatistics::calculate(std::vector<microseconds>* samples)
+{
+    LatencyStatistics result;
+    if (samples->empty())
+        return result;
+
+    std::sort(samples->begin(), samples->end());
+
+    result.count = samples->size();
+    result.min = samples->front();
+    result.p50 = percentile(*samples, 0.5);
+    result.p90 = percentile(*samples, 0.9);
+    result.p99 = percentile(*samples, 0.99);
+    result.max = samples->back();
+    return result;
+}
+
+std::string LatencyStatistics::toString() const
+{
+    return nx::format("count %1, min %2, p50 %3, p90 %4, p99 %5, max %6")
+        .args(count, min, p50, p90, p99, max).toStdString();
+}
+
+double BenchmarkResult::throughputBitsPerSecond() const
+{
+    if (duration <= milliseconds::zero())
+        return 0;
+
+    return bytesReceived * 8.0 * 1000 / duration.count();
+}
+
+std::string BenchmarkResult::toString() const
+{
+    return nx::format(
+        "connections: %1 established, %2 failed (%3)\n"
+        "connect time: %4\n"
+        "round trip time: %5\n"
+        "bytes sent: %6, bytes received: %7, duration: %8\n"
+        "throughput: %9 Mbps")
+        .args(
+            connectionsEstablished, connectionsFailed, SystemError::toString(lastErrorCode),
+            connectTime, roundTripTime,
+            bytesSent, bytesReceived, duration,
+            throughputBitsPerSecond() / 1'000'000).toStdString();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+struct BenchmarkClient::ConnectionResult
+{
+    SystemError::ErrorCode resultCode = SystemError::noError;
+    std::optional<microseconds> connectTime;
+    std::vector<microseconds> roundTripTimes;
+    std::uint64_t bytesSent = 0;
+    std::uint64_t bytesReceived = 0;
+};
+
+class BenchmarkClient::Connection:
+    public aio::BasicPollable
+{
+    using base_type = aio::BasicPollable;
+
+public:
+    using DoneHandler = nx::utils::MoveOnlyFunc<void(ConnectionResult)>;
+
+    Connection(const BenchmarkSettings& settings):
+        m_settings(settings),
+        m_payload(nx::utils::random::generate<nx::Buffer>((int) settings.payloadSize))
+    {
+        bindToAioThread(getAioThread());
+    }
+
+    ~Connection()
+    {
+        pleaseStopSync();
+    }
+
+    virtual void bindToAioThread(aio::AbstractAioThread* aioThread) override
+    {
+        base_type::bindToAioThread(aioThread);
+
+        m_timer.bindToAioThread(aioThread);
+        if (m_tunnelingClient)
+            m_tunnelingClient->bindToAioThread(aioThread);
+        if (m_socket)
+            m_socket->bindToAioThread(aioThread);
+    }
+
+    /**
+     * @param deadline The connection is completed with SystemError::timedOut if it has not been
+     * established by then. Otherwise, it is completed successfully.
+     */
+    void start(steady_clock::time_point deadline, DoneHandler handler)
+    {
+        dispatch(
+            [this, deadline, handler = std::move(handler)]() mutable
+            {
+                m_handler = std::move(handler);
+                m_timer.start(
+                    std::max(
+                        duration_cast<milliseconds>(deadline - steady_clock::now()),
+                        milliseconds::zero()),
+                    [this]() { done(m_isConnected ? SystemError::noError : SystemError::timedOut); });
+                connect();
+            });
+    }
+
+protected:
+    virtual void stopWhileInAioThread() override
+    {
+        base_type::stopWhileInAioThread();
+
+        m_timer.pleaseStopSync();
+        m_tunnelingClient.reset();
+        m_socket.reset();
+    }
+
+private:
+    const BenchmarkSettings& m_settings;
+    const nx::Buffer m_payload;
+    DoneHandler m_handler;
+    aio::Timer m_timer;
+    std::unique_ptr<http::tunneling::Client> m_tunnelingClient;
+    std::unique_ptr<AbstractStreamSocket> m_socket;
+    steady_clock::time_point m_connectStartTime;
+    bool m_isConnected = false;
+    bool m_isDone = false;
+    nx::Buffer m_readBuffer;
+    int m_messagesToSend = 0;
+    bool m_isSending = false;
+    std::deque<steady_clock::time_point> m_sendTimes;
+    std::size_t m_bytesOfCurrentEcho = 0;
+    ConnectionResult m_result;
+
+    void connect()
+    {
+        m_connectStartTime = steady_clock::now();
+
+        if (m_settings.transport == Transport::httpTunnel)
+            return openTunnel();
+
+        m_socket = createSocket();
+        m_socket->bindToAioThread(getAioThread());
+        if (!m_socket->setNonBlockingMode(true) ||
+            !m_socket->setSendTimeout(m_settings.connectTimeout))
+        {
+            return done(SystemError::getLastOSErrorCode());
+        }
+
+        m_socket->connectAsync(
+            m_settings.serverAddress,
+            [this](SystemError::ErrorCode resultCode)
+            {
+                if (resultCode != SystemError::noError || m_settings.transport != Transport::ssl)
+                    return onConnected(resultCode);
+
+                // Measuring the TLS handshake as a part of the connection setup.
+                static_cast<AbstractEncryptedStreamSocket*>(m_socket.get())->handshakeAsync(
+                    [this](SystemError::ErrorCode resultCode) { onConnected(resultCode); });
+            });
+    }
+
+    std::unique_ptr<AbstractStreamSocket> createSocket()
+    {
+        const auto ipVersion = SocketFactory::tcpClientIpVersion();
+
+        switch (m_settings.transport)
+        {
+            case Transport::ssl:
+                return std::make_unique<ssl::ClientStreamSocket>(
+                    ssl::Context::instance(),
+                    std::make_unique<TCPSocket>(ipVersion),
+                    ssl::kAcceptAnyCertificateCallback);
+
+            case Transport::udt:
+                return std::make_unique<UdtStreamSocket>(ipVersion);
+
+            case Transport::relay:
+                return std::make_unique<CloudStreamSocket>(ipVersion);
+
+            case Transport::tcp:
+            case Transport::httpTunnel:
+                break;
+        }
+
+        return std::make_unique<TCPSocket>(ipVersion);
+    }
+
+    void openTunnel()
+    {
+        m_tunnelingClient = std::make_unique<http::tunneling::Client>(
+            url::Builder().setScheme(http::kUrlSchemeName)
+                .setEndpoint(m_settings.serverAddress).setPath(kHttpTunnelPath).toUrl());
+        m_tunnelingClient->bindToAioThread(getAioThread());
+        m_tunnelingClient->setTimeout(m_settings.connectTimeout);
+        m_tunnelingClient->openTunnel(
+            [this](http::tunneling::OpenTunnelResult result)
+            {
+                if (m_isDone)
+                    return;
+
+                if (!result.ok())
+                {
+                    NX_DEBUG(this, "Failed to open tunnel to %1. %2",
+                        m_settings.serverAddress, result.toString());
+                    return done(result.sysError != SystemError::noError
+                        ? result.sysError
+                        : SystemError::connectionRefused);
+                }
+
+                m_socket = std::move(result.connection);
+                m_socket->bindToAioThread(getAioThread());
+                onConnected(SystemError::noError);
+            });
+    }
+
+    void onConnected(SystemError::ErrorCode resultCode)
+    {
+        if (resultCode != SystemError::noError)
+        {
+            NX_DEBUG(this, "Failed to connect to %1 over %2. %3",
+                m_settings.serverAddress, m_settings.transport, SystemError::toString(resultCode));
+            return done(resultCode);
+        }
+
+        m_result.connectTime = duration_cast<microseconds>(steady_clock::now() - m_connectStartTime);
+        m_isConnected = true;
+
+        // The benchmark deadline limits the I/O.
+        if (!m_socket->setSendTimeout(0) || !m_socket->setRecvTimeout(0))
+            return done(SystemError::getLastOSErrorCode());
+
+        m_messagesToSend = m_settings.messagesInFlight;
+        sendNextMessage();
+        readNext();
+    }
+
+    void sendNextMessage()
+    {
+        if (m_isSending || m_messagesToSend == 0)
+            return;
+
+        m_isSending = true;
+        --m_messagesToSend;
+        m_sendTimes.push_back(steady_clock::now());
+        m_socket->sendAsync(
+            &m_payload,
+            [this](SystemError::ErrorCode resultCode, std::size_t bytesSent)
+            {
+                m_isSending = false;
+                if (resultCode != SystemError::noError)
+                    return done(resultCode);
+
+                m_result.bytesSent += bytesSent;
+                sendNextMessage();
+            });
+    }
+
+    void readNext()
+    {
+        m_readBuffer.clear();
+        m_readBuffer.reserve(kReadBufferSize);
+        m_socket->readSomeAsync(
+            &m_readBuffer,
+            [this](SystemError::ErrorCode resultCode, std::size_t bytesRead)
+            {
+                if (resultCode != SystemError::noError)
+                    return done(resultCode);
+                if (bytesRead == 0)
+                    return done(SystemError::connectionReset);
+
+                onBytesRead(bytesRead);
+            });
+    }
+
+    void onBytesRead(std::size_t bytesRead)
+    {
+        const auto now = steady_clock::now();
+
+        m_result.bytesReceived += bytesRead;
+        m_bytesOfCurrentEcho += bytesRead;
+        while (m_bytesOfCurrentEcho >= m_payload.size() && !m_sendTimes.empty())
+        {
+            m_result.roundTripTimes.push_back(
+                duration_cast<microseconds>(now - m_sendTimes.front()));
+            m_sendTimes.pop_front();
+            m_bytesOfCurrentEcho -= m_payload.size();
+            ++m_messagesToSend;
+        }
+
+        sendNextMessage();
+        readNext();
+    }
+
+    void done(SystemError::ErrorCode resultCode)
+    {
+        if (m_isDone)
+            return;
+        m_isDone = true;
+
+        m_timer.cancelSync();
+        if (m_socket)
+            m_socket->cancelIOSync(aio::etNone);
+
+        m_result.resultCode = resultCode;
+        if (m_handler)
+            nx::utils::swapAndCall(m_handler, std::move(m_result));
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+
+BenchmarkClient::BenchmarkClient(BenchmarkSettings settings):
+    m_settings(std::move(settings))
+{
+}
+
+BenchmarkClient::~BenchmarkClient()
+{
+    stop();
+}
+
+void BenchmarkClient::start(BenchmarkCompletionHandler handler)
+{
+    NX_DEBUG(this, "Starting %1 connection(s) to %2 over %3 for %4. Payload %5 bytes, "
+        "%6 message(s) in flight",
+        m_settings.concurrency, m_settings.serverAddress, m_settings.transport,
+        m_settings.duration, m_settings.payloadSize, m_settings.messagesInFlight);
+
+    NX_ASSERT(m_settings.concurrency > 0 && m_settings.messagesInFlight > 0);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    m_handler = std::move(handler);
+    m_startTime = steady_clock::now();
+    m_connectionsInProgress = m_settings.concurrency;
+
+    for (int i = 0; i < m_settings.concurrency; ++i)
+    {
+        auto connection = std::make_unique<Connection>(m_settings);
+        connection->bindToAioThread(SocketGlobals::aioService().getRandomAioThread());
+        connection->start(
+            m_startTime + m_settings.duration,
+            [this](ConnectionResult result) { onConnectionDone(std::move(result)); });
+        m_connections.push_back(std::move(connection));
+    }
+}
+
+void BenchmarkClient::stop()
+{
+    decltype(m_connections) connections;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_handler = nullptr;
+        connections = std::move(m_connections);
+        m_connections.clear();
+    }
+
+    // Each connection waits for its completion handler to return.
+    connections.clear();
+}
+
+void BenchmarkClient::onConnectionDone(ConnectionResult connectionResult)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    if (connectionResult.connectTime)
+    {
+        ++m_result.connectionsEstablished;
+        m_connectTimes.push_back(*connectionResult.connectTime);
+    }
+
+    if (connectionResult.resultCode != SystemError::noError)
+    {
+        if (!connectionResult.connectTime)
+            ++m_result.connectionsFailed;
+        m_result.lastErrorCode = connectionResult.resultCode;
+    }
+
+    m_roundTripTimes.insert(
+        m_roundTripTimes.end(),
+        connectionResult.roundTripTimes.begin(), connectionResult.roundTripTimes.end());
+    m_result.bytesSent += connectionResult.bytesSent;
+    m_result.bytesReceived += connectionResult.bytesReceived;
+
+    if (--m_connectionsInProgress > 0)
+        return;
+
+    m_result.duration = duration_cast<milliseconds>(steady_clock::now() - m_startTime);
+    m_result.connectTime = LatencyStatistics::calculate(&m_connectTimes);
+    m_result.roundTripTime = LatencyStatistics::calculate(&m_roundTripTimes);
+
+    NX_DEBUG(this, "Benchmark completed.\n%1", m_result.toString());
+
+    auto handler = std::exchange(m_handler, nullptr);
+    auto result = std::move(m_result);
+    lock.unlock();
+
+    if (handler)
+        handler(std::move(result));
+}
+
+} // namespace nx::network::cloud::speed_test::benchmark
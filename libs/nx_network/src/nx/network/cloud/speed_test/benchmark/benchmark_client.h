@@ -0,0 +1,128 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <nx/network/socket_common.h>
+#include <nx/utils/move_only_func.h>
+#include <nx/utils/system_error.h>
+#include <nx/utils/thread/mutex.h>
+
+#include "transport.h"
+
+namespace nx::network::cloud::speed_test::benchmark {
+
+struct NX_NETWORK_API BenchmarkSettings
+{
+    Transport transport = Transport::tcp;
+
+    /**
+     * The BenchmarkServer address. The host name is the system cloud address for
+     * Transport::relay.
+     */
+    SocketAddress serverAddress;
+
+    /** The size of each message echoed by the server. */
+    std::size_t payloadSize = 4 * 1024;
+
+    /** The number of connections running simultaneously. */
+    int concurrency = 1;
+
+    /**
+     * The number of messages sent over a connection without waiting for the echo. 1 gives the
+     * pure round trip time, larger values saturate the link.
+     */
+    int messagesInFlight = 1;
+
+    std::chrono::milliseconds duration = std::chrono::seconds(10);
+    std::chrono::milliseconds connectTimeout = std::chrono::seconds(10);
+};
+
+struct NX_NETWORK_API LatencyStatistics
+{
+    std::size_t count = 0;
+    std::chrono::microseconds min{0};
+    std::chrono::microseconds p50{0};
+    std::chrono::microseconds p90{0};
+    std::chrono::microseconds p99{0};
+    std::chrono::microseconds max{0};
+
+    /**
+     * NOTE: The samples are reordered.
+     */
+    static LatencyStatistics calculate(std::vector<std::chrono::microseconds>* samples);
+
+    std::string toString() const;
+};
+
+struct NX_NETWORK_API BenchmarkResult
+{
+    int connectionsEstablished = 0;
+    int connectionsFailed = 0;
+    /** The error of the last failed connection. */
+    SystemError::ErrorCode lastErrorCode = SystemError::noError;
+
+    /** From starting a connection to being ready to send data. Includes handshakes, if any. */
+    LatencyStatistics connectTime;
+    LatencyStatistics roundTripTime;
+
+    std::uint64_t bytesSent = 0;
+    std::uint64_t bytesReceived = 0;
+    std::chrono::milliseconds duration{0};
+
+    /** Echoed payload per second. The traffic in each direction is the same. */
+    double throughputBitsPerSecond() const;
+
+    std::string toString() const;
+};
+
+using BenchmarkCompletionHandler = nx::utils::MoveOnlyFunc<void(BenchmarkResult)>;
+
+/**
+ * The client side of the benchmark. Opens BenchmarkSettings::concurrency connections to
+ * BenchmarkServer and keeps sending messages over each one for BenchmarkSettings::duration.
+ * The round trip time of a message is measured from starting to send it to receiving its echo.
+ * The connections are spread over the AIO threads.
+ * Thread-safe. Must be stopped or destroyed outside of an AIO thread.
+ */
+class NX_NETWORK_API BenchmarkClient
+{
+public:
+    BenchmarkClient(BenchmarkSettings settings);
+    ~BenchmarkClient();
+
+    BenchmarkClient(const BenchmarkClient&) = delete;
+    BenchmarkClient& operator=(const BenchmarkClient&) = delete;
+
+    /**
+     * @param handler Invoked in an AIO thread after all connections have completed.
+     */
+    void start(BenchmarkCompletionHandler handler);
+
+    /**
+     * Interrupts the benchmark. The handler is not invoked after this call returns.
+     */
+    void stop();
+
+private:
+    class Connection;
+    struct ConnectionResult;
+
+    const BenchmarkSettings m_settings;
+    nx::Mutex m_mutex;
+    BenchmarkCompletionHandler m_handler;
+    std::vector<std::unique_ptr<Connection>> m_connections;
+    int m_connectionsInProgress = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::vector<std::chrono::microseconds> m_connectTimes;
+    std::vector<std::chrono::microseconds> m_roundTripTimes;
+    BenchmarkResult m_result;
+
+    void onConnectionDone(ConnectionResult connectionResult);
+};
+
+} // namespace nx::network::cloud::speed_test::benchmark
@@ -0,0 +1,121 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "benchmark_server.h"
+
+#include <nx/network/cloud/cloud_connect_controller.h>
+#include <nx/network/cloud/cloud_server_socket.h>
+#include <nx/network/http/test_http_server.h>
+#include <nx/network/http/tunneling/server.h>
+#include <nx/network/socket_factory.h>
+#include <nx/network/socket_global.h>
+#include <nx/network/ssl/context.h>
+#include <nx/network/system_socket.h>
+#include <nx/network/udt/udt_socket.h>
+#include <nx/utils/log/log.h>
+
+namespace nx::network::cloud::speed_test::benchmark {
+
+BenchmarkServer::BenchmarkServer(Transport transport):
+    m_transport(transport)
+{
+}
+
+BenchmarkServer::~BenchmarkServer()
+{
+    stop();
+}
+
+bool BenchmarkServer::listen(const SocketAddress& endpoint)
+{
+    if (m_transport == Transport::httpTunnel)
+        return listenHttpTunnel(endpoint);
+
+    auto acceptor = createAcceptor();
+    if (!acceptor->setNonBlockingMode(true) ||
+        !acceptor->setReuseAddrFlag(true) ||
+        !acceptor->bind(m_transport == Transport::relay ? SocketAddress::anyAddress : endpoint) ||
+        !acceptor->listen())
+    {
+        NX_DEBUG(this, "Failed to listen on %1 over %2. %3",
+            endpoint, m_transport, SystemError::getLastOSErrorText());
+        return false;
+    }
+
+    m_address = acceptor->getLocalAddress();
+    NX_INFO(this, "Listening on %1 over %2", m_address, m_transport);
+
+    m_echoServer.start(std::move(acceptor));
+    return true;
+}
+
+SocketAddress BenchmarkServer::address() const
+{
+    return m_address;
+}
+
+void BenchmarkServer::stop()
+{
+    // The HTTP server goes first so that no new tunnels are reported to the echo server.
+    m_httpServer.reset();
+    m_tunnelingServer.reset();
+    m_echoServer.stop();
+}
+
+const EchoServer& BenchmarkServer::echoServer() const
+{
+    return m_echoServer;
+}
+
+bool BenchmarkServer::listenHttpTunnel(const SocketAddress& endpoint)
+{
+    m_httpServer = std::make_unique<http::TestHttpServer>();
+    m_tunnelingServer = std::make_unique<http::tunneling::Server<>>(
+        [this](std::unique_ptr<AbstractStreamSocket> connection)
+        {
+            m_echoServer.serve(std::move(connection));
+        },
+        nullptr);
+    m_tunnelingServer->registerRequestHandlers(
+        kHttpTunnelPath,
+        &m_httpServer->httpMessageDispatcher());
+
+    if (!m_httpServer->bindAndListen(endpoint))
+    {
+        NX_DEBUG(this, "Failed to listen on %1 over %2. %3",
+            endpoint, m_transport, SystemError::getLastOSErrorText());
+        return false;
+    }
+
+    m_address = m_httpServer->serverAddress();
+    NX_INFO(this, "Listening on %1 over %2", m_address, m_transport);
+    return true;
+}
+
+std::unique_ptr<AbstractStreamServerSocket> BenchmarkServer::createAcceptor()
+{
+    const auto ipVersion = SocketFactory::tcpServerIpVersion();
+
+    switch (m_transport)
+    {
+        case Transport::ssl:
+            return SocketFactory::createSslAdapter(
+                std::make_unique<TCPServerSocket>(ipVersion),
+                ssl::Context::instance(),
+                ssl::EncryptionUse::always);
+
+        case Transport::udt:
+            return std::make_unique<UdtStreamServerSocket>(ipVersion);
+
+        case Transport::relay:
+            return std::make_unique<CloudServerSocket>(
+                &SocketGlobals::cloud().mediatorConnector());
+
+        case Transport::tcp:
+        case Transport::httpTunnel:
+            break;
+    }
+
+    return std::make_unique<TCPServerSocket>(ipVersion);
+}
+
+} // namespace nx::network::cloud::speed_test::benchmark
@@ -0,0 +1,54 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <memory>
+
+#include <nx/network/socket_common.h>
+
+#include "echo_server.h"
+#include "transport.h"
+
+namespace nx::network::http { class TestHttpServer; }
+namespace nx::network::http::tunneling { template<typename...> class Server; }
+
+namespace nx::network::cloud::speed_test::benchmark {
+
+/**
+ * The server side of the benchmark: EchoServer listening on the given transport.
+ * Thread-safe. Must be stopped or destroyed outside of an AIO thread.
+ */
+class NX_NETWORK_API BenchmarkServer
+{
+public:
+    BenchmarkServer(Transport transport);
+    ~BenchmarkServer();
+
+    /**
+     * @param endpoint The local endpoint to listen on. Ignored for Transport::relay: the server
+     * listens on the cloud address of the system which credentials have been provided to
+     * SocketGlobals::cloud().mediatorConnector().
+     */
+    bool listen(const SocketAddress& endpoint);
+
+    /**
+     * @return The address for the client to connect to.
+     */
+    SocketAddress address() const;
+
+    void stop();
+
+    const EchoServer& echoServer() const;
+
+private:
+    const Transport m_transport;
+    EchoServer m_echoServer;
+    std::unique_ptr<http::TestHttpServer> m_httpServer;
+    std::unique_ptr<http::tunneling::Server<>> m_tunnelingServer;
+    SocketAddress m_address;
+
+    bool listenHttpTunnel(const SocketAddress& endpoint);
+    std::unique_ptr<AbstractStreamServerSocket> createAcceptor();
+};
+
+} // namespace nx::network::cloud::speed_test::benchmark
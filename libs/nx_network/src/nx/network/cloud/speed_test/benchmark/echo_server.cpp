@@ -0,0 +1,172 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "echo_server.h"
+
+#include <nx/network/aio/aio_service.h>
+#include <nx/network/socket_global.h>
+#include <nx/utils/log/log.h>
+
+namespace nx::network::cloud::speed_test::benchmark {
+
+EchoServer::EchoServer(std::size_t readBufferSize):
+    m_readBufferSize(readBufferSize)
+{
+}
+
+EchoServer::~EchoServer()
+{
+    stop();
+}
+
+void EchoServer::start(std::unique_ptr<AbstractStreamServerSocket> acceptor)
+{
+    NX_DEBUG(this, "Accepting connections on %1", acceptor->getLocalAddress());
+
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_acceptor = std::move(acceptor);
+    }
+
+    acceptNext();
+}
+
+void EchoServer::serve(std::unique_ptr<AbstractStreamSocket> connection)
+{
+    connection->bindToAioThread(SocketGlobals::aioService().getRandomAioThread());
+    if (!connection->setNonBlockingMode(true) || !connection->setRecvTimeout(0))
+    {
+        NX_DEBUG(this, "Failed to configure connection from %1. %2",
+            connection->getForeignAddress(), SystemError::getLastOSErrorText());
+        return;
+    }
+
+    NX_VERBOSE(this, "Serving connection from %1", connection->getForeignAddress());
+
+    ++m_totalConnectionsAccepted;
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    if (m_stopped)
+        return;
+
+    auto it = m_connections.insert(m_connections.end(), Connection{std::move(connection), {}});
+    readNext(it);
+}
+
+void EchoServer::stop()
+{
+    std::unique_ptr<AbstractStreamServerSocket> acceptor;
+    Connections connections;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_stopped = true;
+        acceptor = std::move(m_acceptor);
+        connections = std::move(m_connections);
+        m_connections.clear();
+    }
+
+    if (acceptor)
+        acceptor->pleaseStopSync();
+
+    for (auto& connection: connections)
+        connection.socket->pleaseStopSync();
+}
+
+std::size_t EchoServer::connectionCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_connections.size();
+}
+
+std::uint64_t EchoServer::totalConnectionsAccepted() const
+{
+    return m_totalConnectionsAccepted;
+}
+
+std::uint64_t EchoServer::totalBytesEchoed() const
+{
+    return m_totalBytesEchoed;
+}
+
+void EchoServer::acceptNext()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    if (m_acceptor)
+    {
+        m_acceptor->acceptAsync(
+            [this](auto&&... args) { onAccepted(std::forward<decltype(args)>(args)...); });
+    }
+}
+
+void EchoServer::onAccepted(
+    SystemError::ErrorCode resultCode,
+    std::unique_ptr<AbstractStreamSocket> connection)
+{
+    if (resultCode == SystemError::noError)
+        serve(std::move(connection));
+    else
+        NX_DEBUG(this, "Accept failed. %1", SystemError::toString(resultCode));
+
+    acceptNext();
+}
+
+void EchoServer::readNext(Connections::iterator connection)
+{
+    connection->buffer.clear();
+    connection->buffer.reserve(m_readBufferSize);
+    connection->socket->readSomeAsync(
+        &connection->buffer,
+        [this, connection](SystemError::ErrorCode resultCode, std::size_t bytesRead)
+        {
+            onBytesRead(connection, resultCode, bytesRead);
+        });
+}
+
+void EchoServer::onBytesRead(
+    Connections::iterator connection,
+    SystemError::ErrorCode resultCode,
+    std::size_t bytesRead)
+{
+    if (resultCode != SystemError::noError || bytesRead == 0)
+        return closeConnection(connection, resultCode);
+
+    connection->socket->sendAsync(
+        &connection->buffer,
+        [this, connection](SystemError::ErrorCode resultCode, std::size_t bytesSent)
+        {
+            onBytesSent(connection, resultCode, bytesSent);
+        });
+}
+
+void EchoServer::onBytesSent(
+    Connections::iterator connection,
+    SystemError::ErrorCode resultCode,
+    std::size_t bytesSent)
+{
+    if (resultCode != SystemError::noError)
+        return closeConnection(connection, resultCode);
+
+    m_totalBytesEchoed += bytesSent;
+    readNext(connection);
+}
+
+void EchoServer::closeConnection(Connections::iterator connection, SystemError::ErrorCode reason)
+{
+    NX_VERBOSE(this, "Connection from %1 closed. %2",
+        connection->socket->getForeignAddress(), SystemError::toString(reason));
+
+    std::unique_ptr<AbstractStreamSocket> socket;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        if (m_stopped)
+            return; //< stop() owns the connection now.
+
+        socket = std::move(connection->socket);
+        m_connections.erase(connection);
+    }
+
+    // Deleting the socket in its own completion handler is allowed.
+}
+
+} // namespace nx::network::cloud::speed_test::benchmark
@@ -0,0 +1,86 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+
+#include <nx/network/abstract_socket.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::network::cloud::speed_test::benchmark {
+
+/**
+ * Sends everything received back to the same connection. So, the benchmark client can measure
+ * the round trip time and the throughput over any stream transport.
+ * Every connection is served in its own AIO thread.
+ * Thread-safe. Must be stopped or destroyed outside of an AIO thread.
+ */
+class NX_NETWORK_API EchoServer
+{
+public:
+    static constexpr std::size_t kDefaultReadBufferSize = 64 * 1024;
+
+    EchoServer(std::size_t readBufferSize = kDefaultReadBufferSize);
+    ~EchoServer();
+
+    EchoServer(const EchoServer&) = delete;
+    EchoServer& operator=(const EchoServer&) = delete;
+
+    /**
+     * Starts accepting connections.
+     * @param acceptor Must be listening already.
+     */
+    void start(std::unique_ptr<AbstractStreamServerSocket> acceptor);
+
+    /**
+     * Serves the connection accepted elsewhere. E.g., an HTTP tunnel.
+     */
+    void serve(std::unique_ptr<AbstractStreamSocket> connection);
+
+    void stop();
+
+    std::size_t connectionCount() const;
+    std::uint64_t totalConnectionsAccepted() const;
+    std::uint64_t totalBytesEchoed() const;
+
+private:
+    struct Connection
+    {
+        std::unique_ptr<AbstractStreamSocket> socket;
+        nx::Buffer buffer;
+    };
+
+    using Connections = std::list<Connection>;
+
+    const std::size_t m_readBufferSize;
+    mutable nx::Mutex m_mutex;
+    bool m_stopped = false;
+    std::unique_ptr<AbstractStreamServerSocket> m_acceptor;
+    Connections m_connections;
+    std::atomic<std::uint64_t> m_totalConnectionsAccepted{0};
+    std::atomic<std::uint64_t> m_totalBytesEchoed{0};
+
+    void acceptNext();
+
+    void onAccepted(
+        SystemError::ErrorCode resultCode,
+        std::unique_ptr<AbstractStreamSocket> connection);
+
+    void readNext(Connections::iterator connection);
+
+    void onBytesRead(
+        Connections::iterator connection,
+        SystemError::ErrorCode resultCode,
+        std::size_t bytesRead);
+
+    void onBytesSent(
+        Connections::iterator connection,
+        SystemError::ErrorCode resultCode,
+        std::size_t bytesSent);
+
+    void closeConnection(Connections::iterator connection, SystemError::ErrorCode reason);
+};
+
+} // namespace nx::network::cloud::speed_test::benchmark
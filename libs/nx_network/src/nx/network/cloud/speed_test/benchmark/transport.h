@@ -0,0 +1,21 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <nx/reflect/enum_instrument.h>
+
+namespace nx::network::cloud::speed_test::benchmark {
+
+NX_REFLECTION_ENUM_CLASS(Transport,
+    tcp,
+    ssl,
+    udt,
+    /** Cloud connection to a system via the traffic relay. */
+    relay,
+    /** nx::network::http::tunneling over plain TCP. */
+    httpTunnel
+);
+
+static constexpr char kHttpTunnelPath[] = "/benchmark/tunnel";
+
+} // namespace nx::network::cloud::speed_test::benchmark
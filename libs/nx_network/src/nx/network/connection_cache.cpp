@@ -2,14 +2,19 @@
 
 #include "connection_cache.h"
 
+#include <algorithm>
 #include <atomic>
-#include <limits>
+#include <list>
+#include <optional>
+#include <unordered_map>
 
 #include <nx/network/abstract_socket.h>
 #include <nx/network/aio/basic_pollable.h>
-#include <nx/utils/data_structures/time_out_cache.h>
+#include <nx/network/aio/timer.h>
+#include <nx/utils/async_operation_guard.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/thread/mutex.h>
+#include <nx/utils/time.h>
 
 using namespace nx::network;
 
@@ -24,60 +29,279 @@ public:
 
 } // namespace std
 
-class ConnectionCache::Private
+size_t std::hash<nx::network::ConnectionCache::ConnectionInfo>::operator()(
+    const nx::network::ConnectionCache::ConnectionInfo& info) const
+{
+    const size_t isTls = info.isTls ? 1 : 0;
+    return std::hash<SocketAddress>{}(info.addr) ^ isTls;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class ConnectionCache::Private:
+    public nx::network::aio::BasicPollable
 {
 public:
     Private(
         std::chrono::milliseconds expirationPeriod,
-        std::size_t maxSize)
+        std::size_t maxConnectionsPerEndpoint)
         :
-        cache(expirationPeriod, maxSize),
-        size(0),
-        pollableContext(cache, size)
+        m_expirationPeriod(expirationPeriod),
+        m_maxConnectionsPerEndpoint(std::max<std::size_t>(maxConnectionsPerEndpoint, 1))
+    {
+        m_timer.bindToAioThread(getAioThread());
+    }
+
+    void put(
+        ConnectionInfo info,
+        std::unique_ptr<AbstractStreamSocket> socket,
+        std::chrono::microseconds connectDuration)
+    {
+        // The socket may be put from within its own completion handler. So, letting its aio
+        // thread complete processing the socket before binding it to another thread.
+        auto socketPtr = socket.get();
+        socketPtr->post(
+            [this, sharedGuard = m_asyncOperationGuard.sharedGuard(), info = std::move(info),
+                socket = std::move(socket), connectDuration]() mutable
+            {
+                const auto lock = sharedGuard->lock();
+                if (!lock)
+                    return;
+
+                dispatch(
+                    [this, info = std::move(info), socket = std::move(socket),
+                        connectDuration]() mutable
+                    {
+                        saveConnection(info, std::move(socket), connectDuration);
+                    });
+            });
+    }
+
+    void take(
+        const ConnectionInfo& info,
+        nx::utils::MoveOnlyFunc<void(std::unique_ptr<AbstractStreamSocket>)> handler)
+    {
+        dispatch(
+            [this, info, handler = std::move(handler)]() mutable
+            {
+                handler(takeConnection(info));
+            });
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    Statistics statistics() const
     {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_statistics;
     }
 
-    class PollableContext: public nx::network::aio::BasicPollable
+protected:
+    virtual void stopWhileInAioThread() override
     {
-    public:
-        PollableContext(
-            nx::utils::TimeOutCache<ConnectionInfo, std::unique_ptr<AbstractStreamSocket>>& cache,
-            std::atomic<size_t>& size)
-            :
-            m_cache(cache),
-            m_size(size)
+        BasicPollable::stopWhileInAioThread();
+
+        m_asyncOperationGuard.reset();
+        m_timer.pleaseStopSync();
+        m_endpoints.clear();
+        m_size = 0;
+    }
+
+private:
+    struct Connection
+    {
+        std::unique_ptr<AbstractStreamSocket> socket;
+        std::chrono::steady_clock::time_point idleSince;
+        nx::Buffer readBuffer;
+    };
+
+    struct Endpoint
+    {
+        /** Ordered by Connection::idleSince. */
+        std::list<Connection> connections;
+        std::chrono::microseconds averageConnectDuration = std::chrono::microseconds::zero();
+    };
+
+    const std::chrono::milliseconds m_expirationPeriod;
+    const std::size_t m_maxConnectionsPerEndpoint;
+    std::unordered_map<ConnectionInfo, Endpoint> m_endpoints;
+    std::atomic<std::size_t> m_size = 0;
+    nx::network::aio::Timer m_timer;
+    bool m_isTimerStarted = false;
+    mutable nx::Mutex m_mutex;
+    Statistics m_statistics;
+    nx::utils::AsyncOperationGuard m_asyncOperationGuard;
+
+    void saveConnection(
+        const ConnectionInfo& info,
+        std::unique_ptr<AbstractStreamSocket> socket,
+        std::chrono::microseconds connectDuration)
+    {
+        auto& endpoint = m_endpoints[info];
+        if (connectDuration > std::chrono::microseconds::zero())
         {
+            endpoint.averageConnectDuration =
+                endpoint.averageConnectDuration == std::chrono::microseconds::zero()
+                ? connectDuration
+                : (endpoint.averageConnectDuration * 7 + connectDuration) / 8;
         }
 
-    protected:
-        virtual void stopWhileInAioThread() override
+        while (endpoint.connections.size() >= m_maxConnectionsPerEndpoint)
         {
-            BasicPollable::stopWhileInAioThread();
-            m_cache.clear();
-            m_size = 0;
+            NX_VERBOSE(this, "Closing idle connection to %1 due to the limit of %2",
+                info.addr, m_maxConnectionsPerEndpoint);
+            endpoint.connections.pop_front();
+            --m_size;
+            updateStatistics([](auto& statistics) { ++statistics.evictedConnections; });
         }
 
-    private:
-        nx::utils::TimeOutCache<ConnectionInfo, std::unique_ptr<AbstractStreamSocket>>& m_cache;
-        std::atomic<size_t>& m_size;
-    };
+        socket->bindToAioThread(getAioThread());
+        auto& connection = endpoint.connections.emplace_back();
+        connection.socket = std::move(socket);
+        connection.idleSince = nx::utils::monotonicTime();
+        ++m_size;
+
+        startMonitoring(info, &connection);
+        startExpirationTimerIfNeeded();
+    }
+
+    std::unique_ptr<AbstractStreamSocket> takeConnection(const ConnectionInfo& info)
+    {
+        updateStatistics([](auto& statistics) { ++statistics.lookups; });
+
+        auto it = m_endpoints.find(info);
+        if (it == m_endpoints.end())
+            return nullptr;
+
+        // The timer may not have removed the expired connections yet.
+        removeExpiredConnections(&it->second, nx::utils::monotonicTime());
+
+        auto& connections = it->second.connections;
+        if (connections.empty())
+            return nullptr;
+
+        auto socket = std::move(connections.back().socket);
+        connections.pop_back();
+        --m_size;
+
+        socket->cancelRead();
+
+        updateStatistics(
+            [savedConnectTime = it->second.averageConnectDuration](auto& statistics)
+            {
+                ++statistics.hits;
+                statistics.savedConnectTime += savedConnectTime;
+            });
+
+        return socket;
+    }
+
+    void startMonitoring(const ConnectionInfo& info, Connection* connection)
+    {
+        connection->readBuffer.reserve(1);
+        connection->socket->readSomeAsync(
+            &connection->readBuffer,
+            [this, info, socket = connection->socket.get()](
+                SystemError::ErrorCode result, std::size_t bytesRead)
+            {
+                // Unexpected read or connection closed. Remove connection from the cache.
+                if (result != SystemError::noError)
+                    NX_DEBUG(this, "Connection closed due to an error: %1", result);
+                else if (bytesRead > 0)
+                    NX_DEBUG(this, "Unexpected read from server.");
+                else
+                    NX_VERBOSE(this, "Connection is closed by %1", info.addr);
+
+                removeConnection(info, socket);
+            });
+    }
+
+    void removeConnection(const ConnectionInfo& info, AbstractStreamSocket* socket)
+    {
+        auto it = m_endpoints.find(info);
+        if (it == m_endpoints.end())
+            return;
+
+        auto& connections = it->second.connections;
+        auto connectionIt = std::find_if(connections.begin(), connections.end(),
+            [socket](const auto& connection) { return connection.socket.get() == socket; });
+        if (connectionIt == connections.end())
+            return;
+
+        connections.erase(connectionIt);
+        --m_size;
+        updateStatistics([](auto& statistics) { ++statistics.connectionsClosedByPeer; });
+    }
+
+    void removeExpiredConnections(
+        Endpoint* endpoint,
+        std::chrono::steady_clock::time_point now)
+    {
+        auto& connections = endpoint->connections;
+        while (!connections.empty() && connections.front().idleSince + m_expirationPeriod <= now)
+        {
+            connections.pop_front();
+            --m_size;
+            updateStatistics([](auto& statistics) { ++statistics.expiredConnections; });
+        }
+    }
+
+    void startExpirationTimerIfNeeded()
+    {
+        if (m_isTimerStarted)
+            return;
+
+        std::optional<std::chrono::steady_clock::time_point> earliestIdleSince;
+        for (const auto& [info, endpoint]: m_endpoints)
+        {
+            if (!endpoint.connections.empty()
+                && (!earliestIdleSince || endpoint.connections.front().idleSince < *earliestIdleSince))
+            {
+                earliestIdleSince = endpoint.connections.front().idleSince;
+            }
+        }
+
+        if (!earliestIdleSince)
+            return;
 
-    nx::utils::TimeOutCache<ConnectionInfo, std::unique_ptr<AbstractStreamSocket>> cache;
-    std::atomic<size_t> size;
-    PollableContext pollableContext;
+        const auto timeout = std::max(
+            std::chrono::ceil<std::chrono::milliseconds>(
+                *earliestIdleSince + m_expirationPeriod - nx::utils::monotonicTime()),
+            std::chrono::milliseconds(1));
+
+        m_isTimerStarted = true;
+        m_timer.start(timeout, [this]() { onExpirationTimer(); });
+    }
+
+    void onExpirationTimer()
+    {
+        m_isTimerStarted = false;
+
+        const auto now = nx::utils::monotonicTime();
+        for (auto& [info, endpoint]: m_endpoints)
+            removeExpiredConnections(&endpoint, now);
+
+        startExpirationTimerIfNeeded();
+    }
+
+    template<typename Func>
+    void updateStatistics(Func func)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        func(m_statistics);
+    }
 };
 
-size_t std::hash<nx::network::ConnectionCache::ConnectionInfo>::operator()(
-    const nx::network::ConnectionCache::ConnectionInfo& info) const
-{
-    const size_t isTls = info.isTls ? 1 : 0;
-    return std::hash<SocketAddress>{}(info.addr) ^ isTls;
-}
+//-------------------------------------------------------------------------------------------------
 
 ConnectionCache::ConnectionCache(
-    std::chrono::milliseconds expirationPeriod /*= kDefaultExpirationPeriod*/)
+    std::chrono::milliseconds expirationPeriod /*= kDefaultExpirationPeriod*/,
+    std::size_t maxConnectionsPerEndpoint /*= kDefaultMaxConnectionsPerEndpoint*/)
     :
-    d(std::make_unique<Private>(expirationPeriod, std::numeric_limits<size_t>::max()))
+    d(std::make_unique<Private>(expirationPeriod, maxConnectionsPerEndpoint))
 {
 }
 
@@ -85,7 +309,7 @@ ConnectionCache::~ConnectionCache() noexcept
 {
     if (d)
     {
-        d->pollableContext.pleaseStopSync();
+        d->pleaseStopSync();
     }
 }
 
@@ -96,71 +320,33 @@ ConnectionCache& ConnectionCache::operator=(ConnectionCache&& rhs) noexcept
     if (this != &rhs)
     {
         if (d)
-            d->pollableContext.pleaseStopSync();
+            d->pleaseStopSync();
         d = std::move(rhs.d);
     }
     return *this;
 }
 
-void ConnectionCache::put(ConnectionInfo addr, std::unique_ptr<AbstractStreamSocket> socket)
+void ConnectionCache::put(
+    ConnectionInfo addr,
+    std::unique_ptr<AbstractStreamSocket> socket,
+    std::chrono::microseconds connectDuration)
 {
-    d->pollableContext.dispatch(
-        [this, addr, socket = std::move(socket)]() mutable
-        {
-            socket->bindToAioThread(d->pollableContext.getAioThread());
-            startMonitoringConnection(addr, socket.get());
-            d->cache.put(std::move(addr), std::move(socket));
-            ++d->size;
-        });
+    d->put(std::move(addr), std::move(socket), connectDuration);
 }
 
 void ConnectionCache::take(
     const ConnectionInfo& info,
     nx::utils::MoveOnlyFunc<void(std::unique_ptr<AbstractStreamSocket>)> handler)
 {
-    d->pollableContext.dispatch(
-        [this, info, handler = std::move(handler)]() mutable
-        {
-            auto result = d->cache.getValue(info);
-            if (result.has_value())
-            {
-                auto conn = std::move(result.value().get());
-                d->cache.erase(info);
-                --d->size;
-                conn->cancelRead();
-                handler(std::move(conn));
-            }
-            else
-            {
-                handler(nullptr);
-            }
-        });
+    d->take(info, std::move(handler));
 }
 
 size_t ConnectionCache::size() const
 {
-    return d->size;
+    return d->size();
 }
 
-void ConnectionCache::startMonitoringConnection(
-    const ConnectionInfo& addr,
-    AbstractStreamSocket* conn)
+ConnectionCache::Statistics ConnectionCache::statistics() const
 {
-    auto buf = std::make_unique<nx::Buffer>();
-    buf->reserve(1);
-    auto bufPtr = buf.get();
-
-    conn->readSomeAsync(
-        bufPtr,
-        [this, buf = std::move(buf), addr](
-            SystemError::ErrorCode result, std::size_t bytesRead)
-        {
-            // Unexpected read or connection closed. Remove connection from the cache.
-            if (result != SystemError::noError)
-                NX_DEBUG(this, "Connection closed due to an error: %1", result);
-            else if (bytesRead > 0)
-                NX_DEBUG(this, "Unexpected read from server.");
-
-            take(addr, [](auto&&...) {});
-        });
+    return d->statistics();
 }
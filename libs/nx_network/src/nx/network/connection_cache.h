@@ -13,7 +13,14 @@
 namespace nx::network {
 
 /**
- * Keeps opened connections associated with addresses.
+ * Keeps opened idle connections associated with addresses.
+ * Up to maxConnectionsPerEndpoint connections are kept per address. The ones that have been idle
+ * for longer are closed first when the limit is reached.
+ * Idle connections are monitored, so that a connection closed by the peer (or one the peer
+ * sends unexpected data to) is removed from the cache right away.
+ * NOTE: A connection is given away regardless of the way the peer certificate has been verified.
+ * So, a cache MUST be shared only by users that verify certificates in the same way.
+ * NOTE: Thread-safe.
  */
 class NX_NETWORK_API ConnectionCache
 {
@@ -22,9 +29,30 @@ public:
      * Connections will be deleted from the cache after this period of inactivity.
      */
     static constexpr std::chrono::milliseconds kDefaultExpirationPeriod = std::chrono::minutes(1);
+    static constexpr std::size_t kDefaultMaxConnectionsPerEndpoint = 8;
+
+    struct Statistics
+    {
+        /** The number of take() calls. */
+        std::size_t lookups = 0;
+        /** The number of take() calls that provided a connection. */
+        std::size_t hits = 0;
+        std::size_t expiredConnections = 0;
+        std::size_t connectionsClosedByPeer = 0;
+        /** The connections closed because of the per-endpoint limit. */
+        std::size_t evictedConnections = 0;
+        /**
+         * The sum of connect durations saved by reusing connections. It is estimated with the
+         * average connect duration reported with put() for the endpoint.
+         */
+        std::chrono::microseconds savedConnectTime = std::chrono::microseconds::zero();
+
+        double reuseRate() const { return lookups > 0 ? (double) hits / lookups : 0.0; }
+    };
 
     explicit ConnectionCache(
-        std::chrono::milliseconds expirationPeriod = kDefaultExpirationPeriod);
+        std::chrono::milliseconds expirationPeriod = kDefaultExpirationPeriod,
+        std::size_t maxConnectionsPerEndpoint = kDefaultMaxConnectionsPerEndpoint);
 
     ~ConnectionCache() noexcept;
 
@@ -43,13 +71,19 @@ public:
      * Puts opened connection into the cache.
      * @param addr Address of connected peer and its TLS status.
      * @param socket Socket associated with an opened connection.
+     * @param connectDuration The time it took to establish the connection. Zero if unknown
+     *     (e.g., the connection has been taken from the cache).
      */
-    void put(ConnectionInfo addr, std::unique_ptr<AbstractStreamSocket> socket);
+    void put(
+        ConnectionInfo addr,
+        std::unique_ptr<AbstractStreamSocket> socket,
+        std::chrono::microseconds connectDuration = std::chrono::microseconds::zero());
 
     /**
-     * Gets an opened connection from the cache if exists.
+     * Gets an opened connection from the cache if exists. The most recently used one is provided.
      * @param info Address of a peer and its TLS status.
      * @param handler Callback function that is called when the cache lookup completes.
+     *     It is invoked within the cache's aio thread with the socket bound to it.
      */
     void take(
         const ConnectionInfo& info,
@@ -61,8 +95,7 @@ public:
      */
     size_t size() const;
 
-private:
-    void startMonitoringConnection(const ConnectionInfo& addr, AbstractStreamSocket* conn);
+    Statistics statistics() const;
 
 private:
     class Private;
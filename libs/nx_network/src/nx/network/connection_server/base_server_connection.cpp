@@ -2,6 +2,9 @@
 
 #include "base_server_connection.h"
 
+#include <nx/network/ssl/ssl_stream_socket.h>
+#include <nx/network/system_socket.h>
+
 namespace nx::network::server {
 
 BaseServerConnection::BaseServerConnection(
@@ -90,6 +93,49 @@ void BaseServerConnection::sendBufAsync(const nx::Buffer* buf)
         });
 }
 
+void BaseServerConnection::sendFileAsync(const FileRegion& region)
+{
+    NX_ASSERT(isSendFileAvailable());
+
+    dispatch(
+        [this, region]()
+        {
+            m_isSendingData = true;
+            if (m_inactivityTimeout)
+                removeInactivityTimer();
+
+            if (auto tcpSocket = dynamic_cast<TCPSocket*>(m_streamSocket.get()))
+            {
+                tcpSocket->sendFileAsync(
+                    region,
+                    [this](auto&&... args) { onBytesSent(std::move(args)...); });
+            }
+            else if (auto sslSocket = dynamic_cast<ssl::StreamSocket*>(m_streamSocket.get()))
+            {
+                sslSocket->sendFileAsync(
+                    region,
+                    [this](auto&&... args) { onBytesSent(std::move(args)...); });
+            }
+            else
+            {
+                post([this]() { onBytesSent(SystemError::notConnected, (std::size_t) -1); });
+            }
+            m_bytesToSend = (std::size_t) region.size;
+        });
+}
+
+bool BaseServerConnection::isSendFileAvailable() const
+{
+    if (!TCPSocket::isSendFileSupported())
+        return false;
+
+    if (dynamic_cast<TCPSocket*>(m_streamSocket.get()))
+        return true;
+
+    auto sslSocket = dynamic_cast<ssl::StreamSocket*>(m_streamSocket.get());
+    return sslSocket && sslSocket->isSendFileAvailable();
+}
+
 void BaseServerConnection::cancelRead()
 {
     executeInAioThreadSync([this]() { stopReadingConnection(); });
@@ -62,6 +62,20 @@ public:
      */
     void sendBufAsync(const nx::Buffer* buf);
 
+    /**
+     * Transmits the file region directly from the file to the socket.
+     * Can be used only if BaseServerConnection::isSendFileAvailable() returns true.
+     * @param region The file must remain opened until send completion.
+     */
+    void sendFileAsync(const FileRegion& region);
+
+    /**
+     * @return true if the connection is served by a plain TCP socket or by an SSL socket with
+     * the kernel TLS enabled, so that files can be transmitted without copying them to the user
+     * space.
+     */
+    bool isSendFileAvailable() const;
+
     /**
      * See AbstractAsyncChannel::cancelRead.
      */
@@ -114,6 +114,18 @@ public:
         addNewTaskToQueue(std::move(newTask));
     }
 
+    /**
+     * Queues transmission of the file region. It is sent directly from the file to the socket.
+     * Can be used only if BaseServerConnection::isSendFileAvailable() returns true.
+     */
+    void sendFile(
+        const FileRegion& region,
+        nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> handler)
+    {
+        auto newTask = std::make_unique<SendTask>(region, std::move(handler));
+        addNewTaskToQueue(std::move(newTask));
+    }
+
     /**
      * Implements the same behavior as AbstractMsgBodySource::sendAsync.
      */
@@ -219,6 +231,12 @@ private:
         {
         }
 
+        SendTask(const FileRegion& fileRegion, SendHandler handler):
+            fileRegion(fileRegion),
+            handler(std::move(handler))
+        {
+        }
+
         SendTask(SendTask&& /*right*/) = default;
 
         SendTask(const SendTask&) = delete;
@@ -227,6 +245,7 @@ private:
         std::optional<Message> msg;
         std::optional<nx::Buffer> buf;
         std::optional<const nx::Buffer*> userBuf;
+        std::optional<FileRegion> fileRegion;
         SendHandler handler;
         bool asyncSendIssued = false;
     };
@@ -406,6 +425,12 @@ private:
             m_serializerState = SerializerState::done;
             base_type::sendBufAsync(*task.userBuf);
         }
+        else if (task.fileRegion)
+        {
+            NX_ASSERT(m_writeBuffer.empty());
+            m_serializerState = SerializerState::done;
+            base_type::sendFileAsync(*task.fileRegion);
+        }
     }
 
     void serializeMessage()
@@ -304,6 +304,17 @@ public:
         return m_serverSocket->getLocalAddress();
     }
 
+    /**
+     * Same as StreamSocketServer::address, but returns std::nullopt if there is no server
+     * socket (e.g., a custom acceptor is used or the server has been stopped).
+     */
+    std::optional<SocketAddress> boundAddress() const
+    {
+        if (!m_serverSocket)
+            return std::nullopt;
+        return m_serverSocket->getLocalAddress();
+    }
+
     void start()
     {
         using namespace std::placeholders;
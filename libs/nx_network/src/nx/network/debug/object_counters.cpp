@@ -10,6 +10,7 @@ std::string ObjectCounters::toJson() const
     values.emplace("tcpSocketCount", tcpSocketCount);
     values.emplace("udpSocketCount", udpSocketCount);
     values.emplace("sslSocketCount", sslSocketCount);
+    values.emplace("kernelTlsSocketCount", kernelTlsSocketCount);
     values.emplace("stunClientConnectionCount", stunClientConnectionCount);
     values.emplace("stunOverHttpClientConnectionCount", stunOverHttpClientConnectionCount);
     values.emplace("stunServerConnectionCount", stunServerConnectionCount);
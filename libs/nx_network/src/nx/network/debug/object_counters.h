@@ -18,6 +18,7 @@ public:
     std::atomic<int> tcpSocketCount{0};
     std::atomic<int> udpSocketCount{0};
     std::atomic<int> sslSocketCount{0};
+    std::atomic<int> kernelTlsSocketCount{0};
     std::atomic<int> stunClientConnectionCount{0};
     std::atomic<int> stunOverHttpClientConnectionCount{0};
     std::atomic<int> stunServerConnectionCount{0};
@@ -31,11 +31,10 @@ namespace network {
 // class DnsResolver::ResolveTask
 
 DnsResolver::ResolveTask::ResolveTask(
-    std::string hostAddress, Handler handler, RequestId requestId,
+    std::string hostAddress, RequestId requestId,
     size_t sequence, int ipVersion)
 :
     hostAddress(std::move(hostAddress)),
-    completionHandler(std::move(handler)),
     requestId(requestId),
     sequence(sequence),
     ipVersion(ipVersion)
@@ -46,14 +45,10 @@ DnsResolver::ResolveTask::ResolveTask(
 //-------------------------------------------------------------------------------------------------
 // class DnsResolver
 
-static constexpr auto kResolveCacheValueLifetime = std::chrono::minutes(1);
 static constexpr int kResolveCacheMaxSize = 1000;
 
 DnsResolver::DnsResolver(int resolveThreadCount):
-    m_resolveCache(
-        kResolveCacheValueLifetime,
-        kResolveCacheMaxSize,
-        /*do not prolong value lifetime on usage*/ false)
+    m_resolveCache(kResolveCacheMaxSize)
 {
     auto predefinedHostResolver = std::make_unique<PredefinedHostResolver>();
     m_predefinedHostResolver = predefinedHostResolver.get();
@@ -105,23 +100,62 @@ void DnsResolver::setResolveTimeout(std::chrono::milliseconds value)
     m_resolveTimeout = value;
 }
 
+std::chrono::milliseconds DnsResolver::staleCacheTimeout() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_staleCacheTimeout;
+}
+
+void DnsResolver::setStaleCacheTimeout(std::chrono::milliseconds value)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_staleCacheTimeout = value;
+}
+
 void DnsResolver::resolveAsync(
     const std::string& hostname, Handler handler, int ipVersion, RequestId requestId)
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
 
-    if (auto val = m_resolveCache.getValue(std::make_tuple(ipVersion, hostname)); val)
+    const auto key = std::make_tuple(ipVersion, hostname);
+    if (auto val = m_resolveCache.getValue(key); val)
     {
-        m_cachedResults.push({std::move(handler), *val});
-        return;
+        const CacheEntry& entry = val->get();
+        const auto now = nx::utils::monotonicTime();
+        const auto staleCacheTimeout = entry.resultCode == SystemError::noError
+            ? m_staleCacheTimeout
+            : std::chrono::milliseconds::zero();
+
+        if (now < entry.expirationTime + staleCacheTimeout)
+        {
+            if (now >= entry.expirationTime)
+            {
+                NX_VERBOSE(this, "Reporting stale value for %1 while refreshing it", hostname);
+                startResolve(lock, key, /*handler*/ nullptr, /*requestId*/ nullptr);
+            }
+
+            m_cachedResults.push({std::move(handler), entry.resultCode, entry.addresses});
+            return;
+        }
     }
 
-    const auto seq = ++m_currentSequence;
-    m_tasks.emplace(seq, ResolveTask(
-        hostname, std::move(handler), requestId, seq, ipVersion));
-    m_taskQueue.push_back(seq);
+    startResolve(lock, key, std::move(handler), requestId);
+}
 
-    m_cond.wakeAll();
+void DnsResolver::prefetch(const std::vector<std::string>& hostnames, int ipVersion)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    const auto now = nx::utils::monotonicTime();
+    for (const auto& hostname: hostnames)
+    {
+        const auto key = std::make_tuple(ipVersion, hostname);
+        if (auto val = m_resolveCache.getValue(key); val && now < val->get().expirationTime)
+            continue;
+
+        NX_VERBOSE(this, "Prefetching %1", hostname);
+        startResolve(lock, key, /*handler*/ nullptr, /*requestId*/ nullptr);
+    }
 }
 
 SystemError::ErrorCode DnsResolver::resolveSync(
@@ -132,6 +166,7 @@ SystemError::ErrorCode DnsResolver::resolveSync(
     if (m_blockedHosts.count(hostname) > 0)
         return SystemError::hostNotFound;
 
+    std::optional<std::chrono::milliseconds> negativeTtl;
     for (const auto& resolver: m_resolversByPriority)
     {
         ResolveResult localResolveResult;
@@ -143,8 +178,16 @@ SystemError::ErrorCode DnsResolver::resolveSync(
             *resolveResult = std::move(localResolveResult);
             return resultCode;
         }
+
+        if (resultCode == SystemError::hostNotFound && localResolveResult.ttl)
+        {
+            negativeTtl = negativeTtl
+                ? std::min(*negativeTtl, *localResolveResult.ttl)
+                : *localResolveResult.ttl;
+        }
     }
 
+    resolveResult->ttl = negativeTtl;
     return SystemError::hostNotFound;
 }
 
@@ -155,28 +198,40 @@ void DnsResolver::addEtcHost(const std::string& name, std::vector<HostAddress> a
         entries.push_back({ AddressType::direct, address });
 
     m_predefinedHostResolver->replaceMapping(name, std::move(entries));
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    removeFromCache(lock, name);
 }
 
 void DnsResolver::removeEtcHost(const std::string& name)
 {
     m_predefinedHostResolver->removeMapping(name);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    removeFromCache(lock, name);
 }
 
 void DnsResolver::blockHost(const std::string& hostname)
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
     m_blockedHosts.insert(hostname);
+    removeFromCache(lock, hostname);
 }
 
 void DnsResolver::unblockHost(const std::string& hostname)
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
     m_blockedHosts.erase(hostname);
+    removeFromCache(lock, hostname);
 }
 
 void DnsResolver::registerResolver(std::unique_ptr<AbstractResolver> resolver, int priority)
 {
     m_resolversByPriority.emplace(priority, std::move(resolver));
+
+    // The new resolver may resolve names differently.
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_resolveCache.clear();
 }
 
 int DnsResolver::minRegisteredResolverPriority() const
@@ -216,6 +271,7 @@ void DnsResolver::resolveThreadMain()
             continue; //< E.g., the task was cancelled.
 
         ResolveTask task = std::move(taskIter->second);
+        m_tasks.erase(taskIter);
         lock.unlock();
         {
             SystemError::ErrorCode resultCode = SystemError::noError;
@@ -232,27 +288,23 @@ void DnsResolver::resolveThreadMain()
             lock.relock();
 
             if (task.requestId)
-            {
-                if (!m_tasks.contains(task.sequence))
-                    continue; //< The task has been cancelled.
-
                 m_runningTaskRequestIds.insert(task.requestId);
-                m_tasks.erase(task.sequence);
-            }
 
-            if (resolveResult.ttl)
+            const auto key = std::make_tuple(task.ipVersion, task.hostAddress);
+            saveToCache(lock, key, resultCode, resolvedAddresses, resolveResult.ttl);
+
+            std::vector<Handler> handlers;
+            if (auto it = m_resolvesInProgress.find(key); it != m_resolvesInProgress.end())
             {
-                // Caching the result.
-                // TODO: #akolesnikov Ignoring the ttl value for now for simplicity.
-                m_resolveCache.put(
-                    std::make_tuple(task.ipVersion, task.hostAddress),
-                    resolvedAddresses);
+                handlers = std::move(it->second);
+                m_resolvesInProgress.erase(it);
             }
 
             // Unlocking the mutex before completion handler invocation.
             lock.unlock();
 
-            task.completionHandler(resultCode, std::move(resolvedAddresses));
+            for (auto& handler: handlers)
+                handler(resultCode, resolvedAddresses);
         }
         lock.relock();
 
@@ -275,9 +327,7 @@ void DnsResolver::reportCachedResultThreadMain()
         if (!val)
             continue;
 
-        auto& handler = std::get<0>(*val);
-        auto& entries = std::get<1>(*val);
-        handler(SystemError::noError, std::move(entries));
+        val->handler(val->resultCode, std::move(val->addresses));
     }
 
     NX_VERBOSE(this, "%1. Exiting", __func__);
@@ -288,5 +338,67 @@ bool DnsResolver::isExpired(const ResolveTask& task) const
     return nx::utils::monotonicTime() >= task.creationTime + m_resolveTimeout;
 }
 
+void DnsResolver::startResolve(
+    const nx::Locker<nx::Mutex>& /*lock*/,
+    const ResolveKey& key,
+    Handler handler,
+    RequestId requestId)
+{
+    auto [it, isNewResolve] = m_resolvesInProgress.try_emplace(key);
+    if (handler)
+        it->second.push_back(std::move(handler));
+
+    if (!isNewResolve)
+    {
+        NX_VERBOSE(this, "Resolve of %1 is already in progress", std::get<1>(key));
+        return;
+    }
+
+    const auto seq = ++m_currentSequence;
+    m_tasks.emplace(seq, ResolveTask(
+        std::get<1>(key), requestId, seq, std::get<0>(key)));
+    m_taskQueue.push_back(seq);
+
+    m_cond.wakeAll();
+}
+
+void DnsResolver::saveToCache(
+    const nx::Locker<nx::Mutex>& /*lock*/,
+    const ResolveKey& key,
+    SystemError::ErrorCode resultCode,
+    const std::deque<HostAddress>& addresses,
+    std::optional<std::chrono::milliseconds> ttl)
+{
+    if (!ttl)
+        return;
+
+    const auto now = nx::utils::monotonicTime();
+
+    if (resultCode != SystemError::noError)
+    {
+        // Failed refresh does not replace the stale value. It is reported until the stale cache
+        // timeout passes as if the resolve has not completed yet.
+        if (auto val = m_resolveCache.getValue(key);
+            val && val->get().resultCode == SystemError::noError &&
+            now < val->get().expirationTime + m_staleCacheTimeout)
+        {
+            return;
+        }
+    }
+
+    m_resolveCache.put(key, CacheEntry{
+        .resultCode = resultCode,
+        .addresses = addresses,
+        .expirationTime = now + *ttl});
+}
+
+void DnsResolver::removeFromCache(
+    const nx::Locker<nx::Mutex>& /*lock*/,
+    const std::string& hostname)
+{
+    for (const int ipVersion: {AF_INET, AF_INET6})
+        m_resolveCache.erase(std::make_tuple(ipVersion, hostname));
+}
+
 } // namespace network
 } // namespace nx
@@ -6,13 +6,15 @@
 #include <chrono>
 #include <deque>
 #include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
-#include <nx/utils/data_structures/time_out_cache.h>
+#include <nx/utils/data_structures/lru_cache.h>
 #include <nx/utils/move_only_func.h>
 #include <nx/utils/singleton.h>
 #include <nx/utils/system_error.h>
@@ -29,7 +31,16 @@ namespace network {
 class PredefinedHostResolver;
 
 static constexpr auto kDefaultDnsResolveTimeout = std::chrono::seconds(15);
-
+static constexpr auto kDefaultDnsStaleCacheTimeout = std::chrono::minutes(1);
+
+/**
+ * Resolves hostnames using the registered resolvers in a thread pool.
+ * Results are cached for the TTL reported by the resolver (see ResolveResult::ttl). This
+ * includes failures (negative caching). After the TTL expires, a successful result is still
+ * reported during the stale cache timeout while the name is re-resolved in the background. So,
+ * a slow DNS server does not delay the resolve of a popular name.
+ * Concurrent resolves of the same name are coalesced into a single resolve.
+ */
 class NX_NETWORK_API DnsResolver
 {
 public:
@@ -46,6 +57,15 @@ public:
     std::chrono::milliseconds resolveTimeout() const;
     void setResolveTimeout(std::chrono::milliseconds value);
 
+    std::chrono::milliseconds staleCacheTimeout() const;
+
+    /**
+     * @param value Period after the cached value expiration during which the value is still
+     * reported while it is being refreshed in the background. 0 disables reporting stale values.
+     * By default, kDefaultDnsStaleCacheTimeout.
+     */
+    void setStaleCacheTimeout(std::chrono::milliseconds value);
+
     // TODO: #akolesnikov Use internal sequence instead of RequestId.
 
     /**
@@ -56,6 +76,16 @@ public:
      */
     void resolveAsync(const std::string& hostname, Handler handler, int ipVersion, RequestId requestId);
 
+    /**
+     * Resolves the names in the background so that the subsequent resolveAsync calls are served
+     * from the cache. E.g., for the well-known hostnames at startup.
+     */
+    void prefetch(const std::vector<std::string>& hostnames, int ipVersion = AF_INET);
+
+    /**
+     * Does not use the cache.
+     * @param resolveResult ttl is set on failure if the failure can be cached.
+     */
     SystemError::ErrorCode resolveSync(
         const std::string& hostname,
         int ipVersion,
@@ -88,17 +118,32 @@ private:
     {
     public:
         std::string hostAddress;
-        Handler completionHandler;
         RequestId requestId = nullptr;
         size_t sequence = 0;
         int ipVersion = AF_INET;
         std::chrono::steady_clock::time_point creationTime;
 
         ResolveTask(
-            std::string hostAddress, Handler handler, RequestId requestId,
+            std::string hostAddress, RequestId requestId,
             size_t sequence, int ipVersion);
     };
 
+    using ResolveKey = std::tuple<int /*ipVersion*/, std::string /*hostname*/>;
+
+    struct CacheEntry
+    {
+        SystemError::ErrorCode resultCode = SystemError::noError;
+        std::deque<HostAddress> addresses;
+        std::chrono::steady_clock::time_point expirationTime;
+    };
+
+    struct CachedResult
+    {
+        Handler handler;
+        SystemError::ErrorCode resultCode = SystemError::noError;
+        std::deque<HostAddress> addresses;
+    };
+
     bool m_terminated = false;
     mutable nx::Mutex m_mutex;
     mutable nx::WaitCondition m_cond;
@@ -108,20 +153,38 @@ private:
     std::unordered_set<RequestId> m_runningTaskRequestIds;
     size_t m_currentSequence = 0;
     std::chrono::milliseconds m_resolveTimeout = kDefaultDnsResolveTimeout;
+    std::chrono::milliseconds m_staleCacheTimeout = kDefaultDnsStaleCacheTimeout;
     PredefinedHostResolver* m_predefinedHostResolver = nullptr;
     std::multimap<int, std::unique_ptr<AbstractResolver>, std::greater<int>> m_resolversByPriority;
     std::set<std::string> m_blockedHosts;
 
-    nx::utils::SyncQueue<std::tuple<Handler, std::deque<HostAddress>>> m_cachedResults;
+    nx::utils::SyncQueue<CachedResult> m_cachedResults;
     std::thread m_reportCachedResultThread;
 
-    nx::utils::TimeOutCache<
-        std::tuple<int /*ipVersion*/, std::string /*hostname*/>,
-        std::deque<HostAddress>,
-        std::map
-    > m_resolveCache;
+    nx::utils::LruCache<ResolveKey, CacheEntry, std::map> m_resolveCache;
+    /** Handlers waiting for the resolve in progress. */
+    std::map<ResolveKey, std::vector<Handler>> m_resolvesInProgress;
 
     bool isExpired(const ResolveTask& task) const;
+
+    /**
+     * Starts resolving the name unless it is being resolved already.
+     * @param handler Can be null. E.g., the cached value refresh.
+     */
+    void startResolve(
+        const nx::Locker<nx::Mutex>& lock,
+        const ResolveKey& key,
+        Handler handler,
+        RequestId requestId);
+
+    void saveToCache(
+        const nx::Locker<nx::Mutex>& lock,
+        const ResolveKey& key,
+        SystemError::ErrorCode resultCode,
+        const std::deque<HostAddress>& addresses,
+        std::optional<std::chrono::milliseconds> ttl);
+
+    void removeFromCache(const nx::Locker<nx::Mutex>& lock, const std::string& hostname);
 };
 
 } // namespace network
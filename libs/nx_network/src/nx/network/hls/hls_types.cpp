@@ -22,7 +22,49 @@ QString timeZoneOffsetString(QDateTime dt1)
     return QString("%1%2:%3").arg(sign).arg(hours, 2, 10, QChar('0')).arg(minutes, 2, 10, QChar('0'));
 }
 
+std::string Chunk::toString() const
+{
+    std::string chunkStr;
+    if (discontinuity)
+        chunkStr += "#EXT-X-DISCONTINUITY\r\n";
+    // Generating string 2010-02-19T14:54:23.031+08:00, since QDateTime::setTimeSpec()
+    //   and QDateTime::toString(Qt::ISODate) do not provide expected result.
+    if (programDateTime)
+    {
+        QString dateTime = programDateTime->toString(Qt::ISODateWithMs);
+        dateTime += timeZoneOffsetString(*programDateTime);
+        NX_VERBOSE(this, "ProgramDateTime: converting date to ISO string. source value=%1, result=%2",
+            programDateTime->toMSecsSinceEpoch(), dateTime);
+
+        chunkStr += "#EXT-X-PROGRAM-DATE-TIME:";
+        chunkStr += dateTime.toStdString(); //< data/time.
+        chunkStr += "\r\n";
+    }
+    chunkStr += "#EXTINF:" + std::to_string(duration) + ",\r\n";
+
+    // NOTE: Reporting only path if host not specified.
+    chunkStr += url.host().isEmpty()
+        ? url.path().toStdString() + "?" + url.query(QUrl::FullyEncoded).toStdString()
+        : url.toString(QUrl::FullyEncoded).toStdString();
+    chunkStr += "\r\n";
+    return chunkStr;
+}
+
+//-------------------------------------------------------------------------------------------------
+
 std::string Playlist::toString() const
+{
+    std::string playlistStr = headerToString();
+    for (const auto& chunk: chunks)
+        playlistStr += chunk.toString();
+
+    if (closed)
+        playlistStr += "#EXT-X-ENDLIST\r\n";
+
+    return playlistStr;
+}
+
+std::string Playlist::headerToString() const
 {
     int targetDuration = 0;
     for (const auto& chunk: chunks)
@@ -44,36 +86,6 @@ std::string Playlist::toString() const
         playlistStr += "\r\n";
     }
     playlistStr += "\r\n";
-
-    for (const auto& chunk: chunks)
-    {
-        if (chunk.discontinuity)
-            playlistStr += "#EXT-X-DISCONTINUITY\r\n";
-        // Generating string 2010-02-19T14:54:23.031+08:00, since QDateTime::setTimeSpec()
-        //   and QDateTime::toString(Qt::ISODate) do not provide expected result.
-        if (chunk.programDateTime)
-        {
-            QString dateTime = chunk.programDateTime->toString(Qt::ISODateWithMs);
-            dateTime += timeZoneOffsetString(*chunk.programDateTime);
-            NX_VERBOSE(this, "ProgramDateTime: converting date to ISO string. source value=%1, result=%2",
-                chunk.programDateTime->toMSecsSinceEpoch(), dateTime);
-
-            playlistStr += "#EXT-X-PROGRAM-DATE-TIME:";
-            playlistStr += dateTime.toStdString(); //< data/time.
-            playlistStr += "\r\n";
-        }
-        playlistStr += "#EXTINF:" + std::to_string(chunk.duration) + ",\r\n";
-
-        // NOTE: Reporting only path if host not specified.
-        playlistStr += chunk.url.host().isEmpty()
-            ? chunk.url.path().toStdString() + "?" + chunk.url.query(QUrl::FullyEncoded).toStdString()
-            : chunk.url.toString(QUrl::FullyEncoded).toStdString();
-        playlistStr += "\r\n";
-    }
-
-    if (closed)
-        playlistStr += "#EXT-X-ENDLIST\r\n";
-
     return playlistStr;
 }
 
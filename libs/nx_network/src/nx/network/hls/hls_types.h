@@ -21,6 +21,9 @@ public:
     bool discontinuity = false;
     /** #EXT-X-PROGRAM-DATE-TIME tag. */
     std::optional<QDateTime> programDateTime;
+
+    /** @return The tags and the URL of the chunk as they appear in the playlist. */
+    std::string toString() const;
 };
 
 class NX_NETWORK_API Playlist
@@ -32,6 +35,9 @@ public:
     std::optional<bool> allowCache;
 
     std::string toString() const;
+
+    /** @return The tags preceding the chunks. The target duration is taken from the chunks. */
+    std::string headerToString() const;
 };
 
 class NX_NETWORK_API VariantPlaylistData
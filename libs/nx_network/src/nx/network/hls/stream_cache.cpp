@@ -0,0 +1,228 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "stream_cache.h"
+
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <nx/utils/log/log.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::network::hls {
+
+struct StreamCache::Private: std::enable_shared_from_this<Private>
+{
+    struct SegmentContext
+    {
+        Segment data;
+        std::vector<SegmentHandler> handlers;
+        bool loading = false;
+    };
+
+    using LoadList = std::vector<std::pair<unsigned int, Chunk>>;
+
+    SegmentLoader loader;
+    const Settings settings;
+
+    mutable nx::Mutex mutex;
+    Playlist playlist;
+    std::deque<std::string> serializedChunks;
+    mutable std::shared_ptr<const std::string> serializedPlaylist;
+    std::map<unsigned int, SegmentContext> segments;
+    mutable Statistics statistics;
+
+    Private(SegmentLoader loader, Settings settings):
+        loader(std::move(loader)),
+        settings(std::move(settings))
+    {
+    }
+
+    bool contains(unsigned int mediaSequence) const
+    {
+        return mediaSequence >= playlist.mediaSequence
+            && mediaSequence - playlist.mediaSequence < playlist.chunks.size();
+    }
+
+    const Chunk& chunk(unsigned int mediaSequence) const
+    {
+        return playlist.chunks[mediaSequence - playlist.mediaSequence];
+    }
+
+    void prefetch(unsigned int mediaSequence, LoadList* loads)
+    {
+        if (!settings.prefetchNextSegment || !contains(mediaSequence))
+            return;
+
+        auto& segment = segments[mediaSequence];
+        if (segment.data || segment.loading)
+            return;
+
+        segment.loading = true;
+        ++statistics.segmentPrefetches;
+        loads->emplace_back(mediaSequence, chunk(mediaSequence));
+    }
+
+    void load(LoadList loads)
+    {
+        for (auto& [mediaSequence, chunk]: loads)
+        {
+            NX_VERBOSE(this, "Loading segment %1: %2", mediaSequence, chunk.url);
+            loader(
+                chunk,
+                [weakThis = weak_from_this(), mediaSequence = mediaSequence](Segment segment)
+                {
+                    if (const auto d = weakThis.lock())
+                        d->onSegmentLoaded(mediaSequence, std::move(segment));
+                });
+        }
+    }
+
+    void onSegmentLoaded(unsigned int mediaSequence, Segment segment)
+    {
+        NX_MUTEX_LOCKER lock(&mutex);
+        const auto it = segments.find(mediaSequence);
+        if (it == segments.end())
+            return;
+
+        auto handlers = std::exchange(it->second.handlers, {});
+        // A failed load is retried by the next request. The segment of the chunk removed from
+        // the playlist while loading is only given to the viewers waiting for it.
+        if (segment && contains(mediaSequence))
+        {
+            it->second.data = segment;
+            it->second.loading = false;
+        }
+        else
+        {
+            NX_VERBOSE(this, "Segment %1 is not kept, loaded: %2", mediaSequence, (bool) segment);
+            segments.erase(it);
+        }
+        lock.unlock();
+
+        for (auto& handler: handlers)
+            handler(segment);
+    }
+};
+
+StreamCache::StreamCache(SegmentLoader loader, Settings settings):
+    d(std::make_shared<Private>(std::move(loader), std::move(settings)))
+{
+}
+
+StreamCache::~StreamCache()
+{
+    std::vector<SegmentHandler> handlers;
+    {
+        NX_MUTEX_LOCKER lock(&d->mutex);
+        for (auto& [mediaSequence, segment]: d->segments)
+        {
+            for (auto& handler: segment.handlers)
+                handlers.push_back(std::move(handler));
+        }
+        d->segments.clear();
+    }
+
+    for (auto& handler: handlers)
+        handler(nullptr);
+}
+
+unsigned int StreamCache::addChunk(Chunk chunk)
+{
+    NX_MUTEX_LOCKER lock(&d->mutex);
+    d->serializedChunks.push_back(chunk.toString());
+    d->playlist.chunks.push_back(std::move(chunk));
+    const unsigned int mediaSequence =
+        d->playlist.mediaSequence + (unsigned int) d->playlist.chunks.size() - 1;
+
+    while (d->settings.maxChunkCount > 0
+        && (int) d->playlist.chunks.size() > d->settings.maxChunkCount)
+    {
+        const auto it = d->segments.find(d->playlist.mediaSequence);
+        if (it != d->segments.end() && !it->second.loading)
+            d->segments.erase(it);
+
+        d->playlist.chunks.erase(d->playlist.chunks.begin());
+        d->serializedChunks.pop_front();
+        ++d->playlist.mediaSequence;
+    }
+    d->serializedPlaylist.reset();
+
+    // The viewers that requested the previous segment are going to request this one.
+    Private::LoadList loads;
+    if (mediaSequence > 0 && d->segments.contains(mediaSequence - 1))
+        d->prefetch(mediaSequence, &loads);
+    lock.unlock();
+
+    d->load(std::move(loads));
+    return mediaSequence;
+}
+
+void StreamCache::close()
+{
+    NX_MUTEX_LOCKER lock(&d->mutex);
+    d->playlist.closed = true;
+    d->serializedPlaylist.reset();
+}
+
+std::shared_ptr<const std::string> StreamCache::playlist() const
+{
+    NX_MUTEX_LOCKER lock(&d->mutex);
+    if (d->serializedPlaylist)
+        return d->serializedPlaylist;
+
+    std::string serialized = d->playlist.headerToString();
+    for (const auto& chunk: d->serializedChunks)
+        serialized += chunk;
+    if (d->playlist.closed)
+        serialized += "#EXT-X-ENDLIST\r\n";
+
+    ++d->statistics.playlistsGenerated;
+    d->serializedPlaylist = std::make_shared<const std::string>(std::move(serialized));
+    return d->serializedPlaylist;
+}
+
+void StreamCache::getSegment(unsigned int mediaSequence, SegmentHandler handler)
+{
+    NX_MUTEX_LOCKER lock(&d->mutex);
+    if (!d->contains(mediaSequence))
+    {
+        lock.unlock();
+        NX_VERBOSE(this, "Segment %1 is not in the playlist", mediaSequence);
+        return handler(nullptr);
+    }
+
+    Segment data;
+    Private::LoadList loads;
+    auto& segment = d->segments[mediaSequence];
+    if (segment.data)
+    {
+        ++d->statistics.segmentHits;
+        data = segment.data;
+    }
+    else
+    {
+        segment.handlers.push_back(std::move(handler));
+        if (!segment.loading)
+        {
+            segment.loading = true;
+            ++d->statistics.segmentLoads;
+            loads.emplace_back(mediaSequence, d->chunk(mediaSequence));
+        }
+    }
+    d->prefetch(mediaSequence + 1, &loads);
+    lock.unlock();
+
+    if (data)
+        handler(std::move(data));
+    d->load(std::move(loads));
+}
+
+StreamCache::Statistics StreamCache::statistics() const
+{
+    NX_MUTEX_LOCKER lock(&d->mutex);
+    return d->statistics;
+}
+
+} // namespace nx::network::hls
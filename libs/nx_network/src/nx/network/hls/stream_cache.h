@@ -0,0 +1,90 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <nx/utils/buffer.h>
+#include <nx/utils/move_only_func.h>
+
+#include "hls_types.h"
+
+namespace nx::network::hls {
+
+/**
+ * Playlist and segments of a single stream, shared by all its viewers.
+ *
+ * The chunks are appended to the playlist as they are closed, and the serialized playlist is
+ * kept until the next change, so a viewer's poll costs neither an archive lookup nor playlist
+ * generation. A segment is loaded once and shared by the viewers that request it, including the
+ * ones requesting it while it is being loaded. The segment following a requested one is loaded in
+ * advance, so a viewer following the playlist does not wait for remuxing.
+ *
+ * The methods are thread-safe. The segment handlers are called without any lock held.
+ */
+class NX_NETWORK_API StreamCache
+{
+public:
+    struct Settings
+    {
+        /** Chunks kept in the playlist of a live stream. 0 keeps all the chunks. */
+        int maxChunkCount = 0;
+
+        /** Whether the segment following the requested one is loaded in advance. */
+        bool prefetchNextSegment = true;
+    };
+
+    struct Statistics
+    {
+        int64_t playlistsGenerated = 0;
+        int64_t segmentHits = 0;
+        int64_t segmentLoads = 0;
+        int64_t segmentPrefetches = 0;
+    };
+
+    using Segment = std::shared_ptr<const nx::Buffer>;
+
+    /** Receives nullptr if the segment could not be loaded. */
+    using SegmentHandler = nx::utils::MoveOnlyFunc<void(Segment)>;
+
+    /**
+     * Loads the segment of the chunk, e.g. reads and remuxes the archive. The handler can be
+     * invoked in any thread, also after the cache is destroyed.
+     */
+    using SegmentLoader = nx::utils::MoveOnlyFunc<void(const Chunk& chunk, SegmentHandler)>;
+
+    StreamCache(SegmentLoader loader, Settings settings);
+    ~StreamCache();
+
+    StreamCache(const StreamCache&) = delete;
+    StreamCache& operator=(const StreamCache&) = delete;
+
+    /**
+     * Appends the closed chunk to the playlist. The chunks beyond Settings::maxChunkCount are
+     * removed from the playlist along with their segments.
+     * @return Media sequence number of the chunk.
+     */
+    unsigned int addChunk(Chunk chunk);
+
+    /** Marks the playlist as closed, it is not appended anymore. */
+    void close();
+
+    /** @return The serialized playlist. It is generated once per change of the playlist. */
+    std::shared_ptr<const std::string> playlist() const;
+
+    /**
+     * Invokes the handler with the segment of the chunk with the media sequence number, or with
+     * nullptr if there is no such chunk in the playlist. The handler is invoked within the call if
+     * the segment is loaded already.
+     */
+    void getSegment(unsigned int mediaSequence, SegmentHandler handler);
+
+    Statistics statistics() const;
+
+private:
+    struct Private;
+    std::shared_ptr<Private> d;
+};
+
+} // namespace nx::network::hls
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <nx/network/aio/basic_pollable.h>
+#include <nx/network/socket_common.h>
 #include <nx/utils/buffer.h>
 #include <nx/utils/move_only_func.h>
 #include <nx/utils/system_error.h>
@@ -48,6 +49,16 @@ public:
      * NOTE: End-of-data is signalled with (SystemError::noError, {empty buffer}).
      */
     virtual void readAsync(CompletionHandler completionHandler) = 0;
+
+    /**
+     * Switches the source to the zero-copy mode if the whole body is a part of a regular file.
+     * In this mode the caller transmits the returned file region directly to the connection
+     * (e.g., with sendfile) instead of calling readAsync. readAsync reports end-of-data afterwards.
+     * @return std::nullopt if the mode is not supported (the default).
+     * NOTE: Can be invoked only before the first readAsync call.
+     * NOTE: The file region remains valid while this object is alive.
+     */
+    virtual std::optional<FileRegion> takeFileRegion() { return std::nullopt; }
 };
 
 //-------------------------------------------------------------------------------------------------
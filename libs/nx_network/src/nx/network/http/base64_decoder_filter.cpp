@@ -2,13 +2,16 @@
 
 #include "base64_decoder_filter.h"
 
-#include <nx/utils/string.h>
-
 namespace nx::network::http {
 
 bool Base64DecoderFilter::processData(const nx::ConstBufferRefType& data)
 {
-    return m_nextFilter->processData(nx::utils::fromBase64(data));
+    m_decoded.clear();
+    m_decoder.decode(data, &m_decoded);
+    if (m_decoded.empty())
+        return true;
+
+    return m_nextFilter->processData(std::string_view(m_decoded));
 }
 
 size_t Base64DecoderFilter::flush()
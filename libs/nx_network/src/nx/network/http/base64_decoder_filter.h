@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <nx/utils/base64.h>
 #include <nx/utils/byte_stream/abstract_byte_stream_filter.h>
 
 namespace nx::network::http {
@@ -9,7 +10,8 @@ namespace nx::network::http {
 /**
  * Input: base64 string
  * Output: decoded string
- * NOTE: Currently, all source buffers are decoded independently.
+ * The source buffers may be split at arbitrary positions: the incomplete 4-character quantum is
+ * held until the next buffer.
  */
 class NX_NETWORK_API Base64DecoderFilter:
     public nx::utils::bstream::AbstractByteStreamFilter
@@ -17,6 +19,10 @@ class NX_NETWORK_API Base64DecoderFilter:
 public:
     virtual bool processData(const nx::ConstBufferRefType& data) override;
     virtual size_t flush() override;
+
+private:
+    nx::utils::Base64Decoder m_decoder;
+    std::string m_decoded;
 };
 
 } // namespace nx::network::http
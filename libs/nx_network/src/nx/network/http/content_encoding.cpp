@@ -0,0 +1,66 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "content_encoding.h"
+
+#include <nx/network/nx_network_ini.h>
+#include <nx/utils/gzip/gzip_compressor.h>
+#include <nx/utils/gzip/gzip_uncompressor.h>
+#include <nx/utils/zstd/zstd_compressor.h>
+#include <nx/utils/zstd/zstd_uncompressor.h>
+
+namespace nx::network::http {
+
+std::unique_ptr<nx::utils::bstream::AbstractByteStreamFilter>
+    createContentDecoder(const std::string_view& encodingName)
+{
+    if (encodingName == kGzipContentEncoding || encodingName == kDeflateContentEncoding)
+        return std::make_unique<nx::utils::bstream::gzip::Uncompressor>();
+    if (encodingName == kZstdContentEncoding)
+        return std::make_unique<nx::utils::bstream::zstd::Uncompressor>();
+    return nullptr;
+}
+
+std::string selectContentEncoding(const header::AcceptEncodingHeader& acceptEncoding)
+{
+    // Only the explicitly listed zstd is selected, the "*" does not count.
+    if (const auto it = acceptEncoding.allEncodings().find(kZstdContentEncoding);
+        it != acceptEncoding.allEncodings().end() && it->second > 0.0)
+    {
+        return kZstdContentEncoding;
+    }
+
+    if (acceptEncoding.encodingIsAllowed(header::IDENTITY_CODING))
+        return header::IDENTITY_CODING;
+
+    if (acceptEncoding.encodingIsAllowed(kGzipContentEncoding))
+        return kGzipContentEncoding;
+
+    return std::string();
+}
+
+std::optional<nx::Buffer> encodeMessageBody(
+    const std::string_view& encodingName,
+    const nx::Buffer& messageBody)
+{
+    if (encodingName == header::IDENTITY_CODING)
+        return messageBody;
+
+    if (encodingName == kGzipContentEncoding)
+    {
+        return nx::utils::bstream::gzip::Compressor::compressData(
+            messageBody, /*addCrcAndSize*/ true, ini().gzipCompressionLevel);
+    }
+
+    if (encodingName == kZstdContentEncoding)
+    {
+        auto result = nx::utils::bstream::zstd::Compressor::compressData(
+            messageBody, ini().zstdCompressionLevel);
+        if (result.empty() && !messageBody.empty())
+            return std::nullopt;
+        return result;
+    }
+
+    return std::nullopt;
+}
+
+} // namespace nx::network::http
@@ -0,0 +1,48 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <nx/utils/byte_stream/abstract_byte_stream_filter.h>
+
+#include "http_types.h"
+
+namespace nx::network::http {
+
+static constexpr char kZstdContentEncoding[] = "zstd";
+static constexpr char kGzipContentEncoding[] = "gzip";
+static constexpr char kDeflateContentEncoding[] = "deflate";
+
+/**
+ * Accept-Encoding value listing the content encodings that createContentDecoder() supports.
+ */
+static constexpr char kSupportedContentEncodings[] = "zstd, gzip";
+
+/**
+ * @return nullptr if the encoding is not supported.
+ */
+NX_NETWORK_API std::unique_ptr<nx::utils::bstream::AbstractByteStreamFilter>
+    createContentDecoder(const std::string_view& encodingName);
+
+/**
+ * Selects the encoding of a response message body. zstd is selected if explicitly accepted.
+ * Otherwise, "identity" is preferred to gzip. Compressing with zstd is several times cheaper
+ * than with gzip, so it pays off even for the local connections.
+ * @return Empty string if none of the supported encodings is acceptable.
+ */
+NX_NETWORK_API std::string selectContentEncoding(
+    const header::AcceptEncodingHeader& acceptEncoding);
+
+/**
+ * Encodes the whole message body with the level from nx_network.ini.
+ * @return std::nullopt if the encoding is not supported or the encoding failed.
+ */
+NX_NETWORK_API std::optional<nx::Buffer> encodeMessageBody(
+    const std::string_view& encodingName,
+    const nx::Buffer& messageBody);
+
+} // namespace nx::network::http
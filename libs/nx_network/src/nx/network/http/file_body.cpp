@@ -67,6 +67,7 @@ void FileBody::readAsync(CompletionHandler completionHandler)
             });
     }
 
+    m_readStarted = true;
     m_readBuf->reserve(m_readBuf->size() + m_readSize);
 
     m_file->readAsync(
@@ -89,11 +90,30 @@ void FileBody::readAsync(CompletionHandler completionHandler)
         });
 }
 
+std::optional<FileRegion> FileBody::takeFileRegion()
+{
+    if (!m_zeroCopyEnabled || m_readStarted || m_done)
+        return std::nullopt;
+
+    const auto fd = m_file->nativeDescriptor();
+    if (!fd)
+        return std::nullopt;
+
+    // The data is going to be sent by the caller.
+    m_done = true;
+    return FileRegion{*fd, 0, (std::uint64_t) m_fileStat.st_size};
+}
+
 void FileBody::setReadSize(std::size_t readSize)
 {
     m_readSize = readSize;
 }
 
+void FileBody::setZeroCopyEnabled(bool enabled)
+{
+    m_zeroCopyEnabled = enabled;
+}
+
 void FileBody::stopWhileInAioThread()
 {
     base_type::stopWhileInAioThread();
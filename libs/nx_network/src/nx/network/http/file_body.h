@@ -37,11 +37,22 @@ public:
     virtual std::optional<uint64_t> contentLength() const override;
     virtual void readAsync(CompletionHandler completionHandler) override;
 
+    /**
+     * @return The whole file if the zero-copy mode is enabled and the file is a regular OS file.
+     */
+    virtual std::optional<FileRegion> takeFileRegion() override;
+
     /**
      * By default, the read size is kDefaultReadSize.
      */
     void setReadSize(std::size_t readSize);
 
+    /**
+     * Enables FileBody::takeFileRegion. Enabled by default.
+     * NOTE: In the zero-copy mode, the file is read within the connection's AIO thread.
+     */
+    void setZeroCopyEnabled(bool enabled);
+
 private:
     virtual void stopWhileInAioThread() override;
 
@@ -51,6 +62,8 @@ private:
     std::unique_ptr<nx::utils::fs::File> m_file;
     nx::utils::fs::FileStat m_fileStat;
     bool m_done = false;
+    bool m_readStarted = false;
+    bool m_zeroCopyEnabled = true;
     nx::utils::AsyncOperationGuard m_guard;
     std::size_t m_readSize = kDefaultReadSize;
     std::unique_ptr<nx::Buffer> m_readBuf;
@@ -7,6 +7,7 @@
 #include <tuple>
 
 #include <nx/network/aio/basic_pollable.h>
+#include <nx/network/connection_cache.h>
 #include <nx/network/url/url_builder.h>
 #include <nx/utils/datetime.h>
 #include <nx/utils/thread/mutex.h>
@@ -78,6 +79,9 @@ public:
 
     /**
      * Full set of HTTP client options that are set on every request.
+     * By default, the keep-alive connections are reused by subsequent requests via the client's
+     * own ConnectionCache (see connectionCache()). Use
+     * httpClientOptions().setConnectionCache(nullptr) to use a new connection for every request.
      */
     ClientOptions& httpClientOptions() { return this->m_clientOptions; }
     const ClientOptions& httpClientOptions() const { return this->m_clientOptions; }
@@ -99,6 +103,8 @@ public:
      */
     std::chrono::milliseconds lastResponseTime() const { return this->m_lastResponseTime; }
 
+    const ConnectionCache& connectionCache() const { return this->m_connectionCache; }
+
     /**
      * Take the HTTP headers from the most recent response received by the client.
      */
@@ -187,6 +193,8 @@ private:
     std::optional<std::chrono::milliseconds> m_requestTimeout;
     unsigned int m_numRetries = 1;
     std::optional<nx::utils::MoveOnlyFunc<bool(ResultType)>> m_isRequestSucceeded;
+    // The cache is not shared with other clients since they may verify certificates differently.
+    ConnectionCache m_connectionCache;
     ClientOptions m_clientOptions;
     bool m_cacheEnabled = false;
     // Actual value has type CacheEntry<T> where T is passed via OutputData template parameter.
@@ -265,6 +273,7 @@ GenericApiClient<ApiResultCodeDescriptor, Base>::GenericApiClient(
     m_baseApiUrl(baseApiUrl),
     m_adapterFunc(std::move(adapterFunc))
 {
+    m_clientOptions.setConnectionCache(&m_connectionCache);
 }
 
 template<HasResultCodeT ApiResultCodeDescriptor, typename Base>
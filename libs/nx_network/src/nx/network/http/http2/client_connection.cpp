@@ -0,0 +1,383 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "client_connection.h"
+
+#include <charconv>
+
+#include <nx/network/http/http_status.h>
+#include <nx/network/ssl/ssl_stream_socket.h>
+#include <nx/utils/log/log.h>
+#include <nx/utils/string.h>
+
+namespace nx::network::http::http2 {
+
+static constexpr std::size_t kReadBufferCapacity = 16 * 1024;
+
+ClientConnection::ClientConnection(
+    std::unique_ptr<AbstractStreamSocket> socket,
+    SessionSettings settings)
+    :
+    Session(Role::client, settings),
+    m_socket(std::move(socket))
+{
+    bindToAioThread(m_socket->getAioThread());
+    m_readBuffer.reserve(kReadBufferCapacity);
+}
+
+ClientConnection::~ClientConnection()
+{
+    pleaseStopSync();
+}
+
+void ClientConnection::bindToAioThread(aio::AbstractAioThread* aioThread)
+{
+    base_type::bindToAioThread(aioThread);
+
+    if (m_socket)
+        m_socket->bindToAioThread(aioThread);
+}
+
+void ClientConnection::connectAsync(
+    const SocketAddress& endpoint,
+    nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> handler)
+{
+    m_remoteEndpoint = endpoint;
+
+    auto sslSocket = dynamic_cast<ssl::StreamSocket*>(m_socket.get());
+    if (!sslSocket)
+    {
+        NX_DEBUG(this, "HTTP/2 is used only over SSL connections. Endpoint %1", endpoint);
+        return post(
+            [handler = std::move(handler)]() mutable { handler(SystemError::notImplemented); });
+    }
+
+    sslSocket->setAlpnProtocols({"h2"});
+    m_socket->connectAsync(
+        endpoint,
+        [this, handler = std::move(handler)](SystemError::ErrorCode resultCode) mutable
+        {
+            onConnected(resultCode, std::move(handler));
+        });
+}
+
+std::uint32_t ClientConnection::sendRequest(const Request& request, RequestHandlers handlers)
+{
+    NX_ASSERT(isInSelfAioThread());
+
+    if (!m_isConnected || !canStartStream())
+        return 0;
+
+    const bool hasBody = !request.messageBody.empty();
+    const auto streamId = startStream(buildRequestHeaders(request), /*endStream*/ !hasBody);
+    if (streamId == 0)
+        return 0;
+
+    NX_VERBOSE(this, "Sending request %1 to %2 on stream %3",
+        request.requestLine, m_remoteEndpoint, streamId);
+
+    m_requests[streamId].handlers = std::move(handlers);
+    if (hasBody)
+        submitData(streamId, request.messageBody, /*endStream*/ true);
+
+    return streamId;
+}
+
+void ClientConnection::cancelRequest(std::uint32_t streamId)
+{
+    NX_ASSERT(isInSelfAioThread());
+
+    if (m_requests.erase(streamId) > 0)
+        resetStream(streamId, ErrorCode::cancel);
+}
+
+const SocketAddress& ClientConnection::remoteEndpoint() const
+{
+    return m_remoteEndpoint;
+}
+
+void ClientConnection::stopWhileInAioThread()
+{
+    m_socket.reset();
+    m_requests.clear();
+    m_sendQueue.clear();
+}
+
+void ClientConnection::onStreamHeaders(
+    std::uint32_t streamId, HeaderList headers, bool endStream)
+{
+    auto it = m_requests.find(streamId);
+    if (it == m_requests.end())
+        return;
+
+    if (it->second.isResponseReceived)
+    {
+        // Trailers.
+        if (endStream)
+            reportDone(streamId, SystemError::noError);
+        return;
+    }
+
+    auto response = buildResponse(std::move(headers));
+    if (!response)
+    {
+        NX_DEBUG(this, "Received invalid response from %1 on stream %2",
+            m_remoteEndpoint, streamId);
+        resetStream(streamId, ErrorCode::protocolError);
+        reportDone(streamId, SystemError::invalidData);
+        return;
+    }
+
+    // Skipping informational responses (e.g., 100 Continue). The final one follows.
+    if (response->statusLine.statusCode < StatusCode::ok && !endStream)
+        return;
+
+    it->second.isResponseReceived = true;
+    if (it->second.handlers.onResponse)
+    {
+        nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+        it->second.handlers.onResponse(std::move(*response));
+        if (watcher.interrupted())
+            return;
+    }
+
+    if (endStream)
+        reportDone(streamId, SystemError::noError);
+}
+
+void ClientConnection::onStreamData(std::uint32_t streamId, nx::Buffer data, bool endStream)
+{
+    auto it = m_requests.find(streamId);
+    if (it == m_requests.end())
+        return;
+
+    if (!it->second.isResponseReceived)
+    {
+        NX_DEBUG(this, "Received DATA before the response header from %1 on stream %2",
+            m_remoteEndpoint, streamId);
+        resetStream(streamId, ErrorCode::protocolError);
+        reportDone(streamId, SystemError::invalidData);
+        return;
+    }
+
+    if (!data.empty() && it->second.handlers.onSomeBodyAvailable)
+    {
+        nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+        it->second.handlers.onSomeBodyAvailable(std::move(data));
+        if (watcher.interrupted())
+            return;
+    }
+
+    if (endStream)
+        reportDone(streamId, SystemError::noError);
+}
+
+void ClientConnection::onStreamReset(std::uint32_t streamId, ErrorCode errorCode)
+{
+    NX_DEBUG(this, "Stream %1 to %2 is reset with %3",
+        streamId, m_remoteEndpoint, toString(errorCode));
+
+    reportDone(
+        streamId,
+        m_closeReason != SystemError::noError ? m_closeReason : SystemError::connectionReset);
+}
+
+void ClientConnection::onTerminated(ErrorCode errorCode)
+{
+    NX_DEBUG(this, "Session with %1 is terminated with %2", m_remoteEndpoint, toString(errorCode));
+
+    if (m_sendQueue.empty())
+        post([this]() { closeConnection(SystemError::connectionReset); });
+}
+
+void ClientConnection::sendBytes(nx::Buffer data)
+{
+    if (!m_socket)
+        return;
+
+    m_sendQueue.push_back(std::move(data));
+    if (m_sendQueue.size() == 1)
+        sendNext();
+}
+
+void ClientConnection::onConnected(
+    SystemError::ErrorCode resultCode,
+    nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> handler)
+{
+    if (resultCode == SystemError::noError)
+    {
+        const auto protocol = static_cast<ssl::StreamSocket*>(m_socket.get())->alpnProtocol();
+        if (protocol != "h2")
+        {
+            NX_DEBUG(this, "%1 does not support HTTP/2. Negotiated protocol: \"%2\"",
+                m_remoteEndpoint, protocol);
+            resultCode = SystemError::notImplemented;
+        }
+        else if (!m_socket->setRecvTimeout(kNoTimeout))
+        {
+            resultCode = SystemError::getLastOSErrorCode();
+        }
+    }
+
+    if (resultCode != SystemError::noError)
+    {
+        NX_DEBUG(this, "Failed to establish HTTP/2 connection to %1. %2",
+            m_remoteEndpoint, SystemError::toString(resultCode));
+        return handler(resultCode);
+    }
+
+    NX_VERBOSE(this, "HTTP/2 connection to %1 is established", m_remoteEndpoint);
+
+    m_isConnected = true;
+    start();
+    readMore();
+    handler(SystemError::noError);
+}
+
+void ClientConnection::readMore()
+{
+    m_socket->readSomeAsync(
+        &m_readBuffer,
+        [this](auto&&... args) { onBytesRead(std::move(args)...); });
+}
+
+void ClientConnection::onBytesRead(SystemError::ErrorCode resultCode, std::size_t bytesRead)
+{
+    if (resultCode != SystemError::noError || bytesRead == 0)
+    {
+        return closeConnection(
+            resultCode != SystemError::noError ? resultCode : SystemError::connectionReset);
+    }
+
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    processReceivedData(m_readBuffer.data(), m_readBuffer.size());
+    if (watcher.interrupted())
+        return;
+
+    m_readBuffer.resize(0);
+    if (m_socket && !isTerminated())
+        readMore();
+}
+
+void ClientConnection::sendNext()
+{
+    m_socket->sendAsync(
+        &m_sendQueue.front(),
+        [this](auto&&... args) { onSendCompleted(std::move(args)...); });
+}
+
+void ClientConnection::onSendCompleted(SystemError::ErrorCode resultCode, std::size_t bytesSent)
+{
+    if (resultCode != SystemError::noError)
+        return closeConnection(resultCode);
+
+    m_sendQueue.pop_front();
+
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    onBytesSent(bytesSent);
+    if (watcher.interrupted() || !m_socket)
+        return;
+
+    if (!m_sendQueue.empty())
+        sendNext();
+    else if (isTerminated())
+        closeConnection(SystemError::connectionReset);
+}
+
+void ClientConnection::closeConnection(SystemError::ErrorCode reason)
+{
+    if (!m_socket)
+        return;
+
+    NX_VERBOSE(this, "Connection to %1 is closed. %2",
+        m_remoteEndpoint, SystemError::toString(reason));
+
+    m_closeReason = reason;
+    m_socket.reset();
+    m_sendQueue.clear();
+    if (!isTerminated())
+        terminate(ErrorCode::cancel);
+}
+
+std::optional<Response> ClientConnection::buildResponse(HeaderList headers)
+{
+    Response response;
+    // Presenting the response as an HTTP/1.1 one, so that it is processed as usual.
+    response.statusLine.version = http_1_1;
+
+    bool isStatusFound = false;
+    for (auto& field: headers)
+    {
+        if (field.name == ":status")
+        {
+            int statusCode = 0;
+            const auto end = field.value.data() + field.value.size();
+            if (std::from_chars(field.value.data(), end, statusCode).ptr != end)
+                return std::nullopt;
+
+            response.statusLine.statusCode = static_cast<StatusCode::Value>(statusCode);
+            isStatusFound = true;
+            continue;
+        }
+
+        if (field.name.starts_with(':'))
+            return std::nullopt;
+
+        response.headers.emplace(std::move(field.name), std::move(field.value));
+    }
+
+    if (!isStatusFound)
+        return std::nullopt;
+
+    response.statusLine.reasonPhrase = StatusCode::toString(response.statusLine.statusCode);
+    return response;
+}
+
+HeaderList ClientConnection::buildRequestHeaders(const Request& request)
+{
+    auto authority = getHeaderValue(request.headers, "Host");
+    if (authority.empty())
+        authority = m_remoteEndpoint.toString();
+
+    const auto path = request.requestLine.encodeUrl(request.requestLine.url);
+
+    HeaderList headers;
+    headers.reserve(request.headers.size() + 4);
+    headers.push_back({":method", request.requestLine.method.toString()});
+    headers.push_back({":scheme", kSecureUrlSchemeName});
+    headers.push_back({":authority", std::move(authority)});
+    headers.push_back({":path", path.empty() ? "/" : path});
+
+    for (const auto& [name, value]: request.headers)
+    {
+        auto lowerCaseName = nx::utils::toLower(name);
+        if (lowerCaseName == "host" || isConnectionSpecificHeader(lowerCaseName))
+            continue;
+
+        // RFC 7540, 8.1.2.2: TE may be present only with the "trailers" value.
+        if (lowerCaseName == "te" && value != "trailers")
+            continue;
+
+        headers.push_back({std::move(lowerCaseName), value});
+    }
+
+    return headers;
+}
+
+bool ClientConnection::reportDone(std::uint32_t streamId, SystemError::ErrorCode resultCode)
+{
+    auto it = m_requests.find(streamId);
+    if (it == m_requests.end())
+        return true;
+
+    auto handler = std::move(it->second.handlers.onDone);
+    m_requests.erase(it);
+
+    if (!handler)
+        return true;
+
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    handler(resultCode);
+    return !watcher.interrupted();
+}
+
+} // namespace nx::network::http::http2
@@ -0,0 +1,123 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <nx/network/abstract_socket.h>
+#include <nx/network/aio/basic_pollable.h>
+#include <nx/network/http/http_types.h>
+#include <nx/utils/interruption_flag.h>
+#include <nx/utils/move_only_func.h>
+
+#include "session.h"
+
+namespace nx::network::http::http2 {
+
+/**
+ * Client side of an HTTP/2 connection over TLS. Many requests can be sent concurrently,
+ * each on its own stream.
+ * The connection is established with ALPN. If the server does not agree on "h2", then
+ * the connection fails with SystemError::notImplemented, so that the caller can fall back
+ * to HTTP/1.1.
+ *
+ * Responses are presented as HTTP/1.1 ones. Response trailers are ignored.
+ * NOTE: All methods except the constructor and pleaseStop* MUST be invoked within the aio thread
+ * of the object. All handlers are invoked within it too.
+ */
+class NX_NETWORK_API ClientConnection:
+    public aio::BasicPollable,
+    public Session
+{
+    using base_type = aio::BasicPollable;
+
+public:
+    struct RequestHandlers
+    {
+        nx::utils::MoveOnlyFunc<void(Response /*response*/)> onResponse;
+        nx::utils::MoveOnlyFunc<void(nx::Buffer /*data*/)> onSomeBodyAvailable;
+
+        /**
+         * The last event reported on the request. SystemError::noError if the whole response has
+         * been received.
+         */
+        nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode /*resultCode*/)> onDone;
+    };
+
+    /**
+     * @param socket MUST be a not connected ssl::StreamSocket.
+     */
+    ClientConnection(std::unique_ptr<AbstractStreamSocket> socket, SessionSettings settings = {});
+    ~ClientConnection();
+
+    virtual void bindToAioThread(aio::AbstractAioThread* aioThread) override;
+
+    void connectAsync(
+        const SocketAddress& endpoint,
+        nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> handler);
+
+    /**
+     * Sends the request on a new stream. The whole request body is taken from
+     * request.messageBody.
+     * @return The stream id. 0 if the request cannot be sent (see Session::canStartStream()).
+     * In that case, no handler is invoked.
+     */
+    std::uint32_t sendRequest(const Request& request, RequestHandlers handlers);
+
+    /**
+     * Resets the stream. No handlers are invoked for the request after this call.
+     */
+    void cancelRequest(std::uint32_t streamId);
+
+    const SocketAddress& remoteEndpoint() const;
+
+protected:
+    virtual void stopWhileInAioThread() override;
+
+    virtual void onStreamHeaders(
+        std::uint32_t streamId, HeaderList headers, bool endStream) override;
+    virtual void onStreamData(std::uint32_t streamId, nx::Buffer data, bool endStream) override;
+    virtual void onStreamReset(std::uint32_t streamId, ErrorCode errorCode) override;
+    virtual void onTerminated(ErrorCode errorCode) override;
+    virtual void sendBytes(nx::Buffer data) override;
+
+private:
+    struct PendingRequest
+    {
+        RequestHandlers handlers;
+        bool isResponseReceived = false;
+    };
+
+    std::unique_ptr<AbstractStreamSocket> m_socket;
+    SocketAddress m_remoteEndpoint;
+    std::map<std::uint32_t, PendingRequest> m_requests;
+    nx::Buffer m_readBuffer;
+    std::deque<nx::Buffer> m_sendQueue;
+    bool m_isConnected = false;
+    SystemError::ErrorCode m_closeReason = SystemError::noError;
+    nx::utils::InterruptionFlag m_destructionFlag;
+
+    void onConnected(
+        SystemError::ErrorCode resultCode,
+        nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode)> handler);
+
+    void readMore();
+    void onBytesRead(SystemError::ErrorCode resultCode, std::size_t bytesRead);
+    void sendNext();
+    void onSendCompleted(SystemError::ErrorCode resultCode, std::size_t bytesSent);
+    void closeConnection(SystemError::ErrorCode reason);
+
+    std::optional<Response> buildResponse(HeaderList headers);
+    HeaderList buildRequestHeaders(const Request& request);
+
+    /**
+     * @return false if this object has been destroyed by the handler.
+     */
+    bool reportDone(std::uint32_t streamId, SystemError::ErrorCode resultCode);
+};
+
+} // namespace nx::network::http::http2
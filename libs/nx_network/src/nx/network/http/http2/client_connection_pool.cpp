@@ -0,0 +1,157 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "client_connection_pool.h"
+
+#include <nx/utils/log/log.h>
+
+namespace nx::network::http::http2 {
+
+ClientConnectionPool::ClientConnectionPool(
+    ssl::AdapterFunc adapterFunc,
+    SessionSettings settings)
+    :
+    m_adapterFunc(std::move(adapterFunc)),
+    m_settings(settings)
+{
+}
+
+ClientConnectionPool::~ClientConnectionPool()
+{
+    decltype(m_connections) connections;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        connections = std::exchange(m_connections, {});
+    }
+
+    for (auto& [key, entry]: connections)
+        entry.connection->pleaseStopSync();
+}
+
+bool ClientConnectionPool::isHttp2Expected(const SocketAddress& endpoint) const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto it = m_http1OnlyEndpoints.find(endpoint);
+    if (it == m_http1OnlyEndpoints.end())
+        return true;
+
+    if (it->second > std::chrono::steady_clock::now())
+        return false;
+
+    m_http1OnlyEndpoints.erase(it);
+    return true;
+}
+
+void ClientConnectionPool::getConnection(
+    const SocketAddress& endpoint,
+    aio::AbstractAioThread* aioThread,
+    ConnectHandler handler)
+{
+    const Key key(endpoint, aioThread);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto& entry = m_connections[key];
+    if (entry.isConnected)
+    {
+        auto connection = entry.connection;
+        lock.unlock();
+        return provideEstablishedConnection(key, std::move(connection), std::move(handler));
+    }
+
+    entry.pendingHandlers.push_back(std::move(handler));
+    if (entry.connection)
+        return; //< Already connecting.
+
+    entry.connection = createConnection(key);
+    entry.connection->connectAsync(
+        endpoint,
+        [this, key, connection = entry.connection.get()](SystemError::ErrorCode resultCode)
+        {
+            onConnected(key, connection, resultCode);
+        });
+}
+
+std::shared_ptr<ClientConnection> ClientConnectionPool::createConnection(const Key& key)
+{
+    const auto& [endpoint, aioThread] = key;
+
+    const int ipVersion = endpoint.address.isPureIpV6()
+        ? AF_INET6
+        : SocketFactory::tcpClientIpVersion();
+
+    auto socket = SocketFactory::createStreamSocket(
+        m_adapterFunc, /*sslRequired*/ true, NatTraversalSupport::enabled, ipVersion);
+    socket->bindToAioThread(aioThread);
+    if (!socket->setNonBlockingMode(true) || !socket->setSendTimeout(kSendTimeout))
+    {
+        NX_DEBUG(this, "Error configuring connection to %1. %2",
+            endpoint, SystemError::getLastOSErrorText());
+    }
+
+    NX_VERBOSE(this, "Establishing HTTP/2 connection to %1", endpoint);
+
+    return std::make_shared<ClientConnection>(std::move(socket), m_settings);
+}
+
+void ClientConnectionPool::provideEstablishedConnection(
+    const Key& key,
+    std::shared_ptr<ClientConnection> connection,
+    ConnectHandler handler)
+{
+    auto connectionPtr = connection.get();
+    connectionPtr->dispatch(
+        [this, key, connection = std::move(connection), handler = std::move(handler)]() mutable
+        {
+            if (connection->canStartStream())
+                return handler(SystemError::noError, std::move(connection));
+
+            // The connection is closed, GOAWAY has been received or the stream limit is reached.
+            // The connection is left to the requests already using it.
+            {
+                NX_MUTEX_LOCKER lock(&m_mutex);
+                auto it = m_connections.find(key);
+                if (it != m_connections.end() && it->second.connection == connection)
+                    m_connections.erase(it);
+            }
+
+            getConnection(key.first, key.second, std::move(handler));
+        });
+}
+
+void ClientConnectionPool::onConnected(
+    const Key& key,
+    ClientConnection* connection,
+    SystemError::ErrorCode resultCode)
+{
+    std::shared_ptr<ClientConnection> sharedConnection;
+    std::vector<ConnectHandler> handlers;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+
+        auto it = m_connections.find(key);
+        if (it == m_connections.end() || it->second.connection.get() != connection)
+            return;
+
+        handlers = std::exchange(it->second.pendingHandlers, {});
+        if (resultCode == SystemError::noError)
+        {
+            it->second.isConnected = true;
+            sharedConnection = it->second.connection;
+        }
+        else
+        {
+            m_connections.erase(it);
+            if (resultCode == SystemError::notImplemented)
+            {
+                m_http1OnlyEndpoints[key.first] =
+                    std::chrono::steady_clock::now() + kHttp1OnlyPeriod;
+            }
+        }
+    }
+
+    for (auto& handler: handlers)
+        handler(resultCode, sharedConnection);
+}
+
+} // namespace nx::network::http::http2
@@ -0,0 +1,94 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <nx/network/socket_factory.h>
+#include <nx/utils/move_only_func.h>
+#include <nx/utils/thread/mutex.h>
+
+#include "client_connection.h"
+
+namespace nx::network::http::http2 {
+
+/**
+ * Shares HTTP/2 connections between http::AsyncClient instances, so that concurrent requests
+ * to the same server are multiplexed over a single TLS connection.
+ * A connection is established per remote endpoint and aio thread, so that a client uses
+ * the connection within its own aio thread.
+ * The endpoints that do not support HTTP/2 are remembered for kHttp1OnlyPeriod. HTTP/1.1 is used
+ * for them without trying to establish an HTTP/2 connection.
+ *
+ * NOTE: The server certificate is verified with the adapterFunc given to the pool. The one given
+ * to the AsyncClient is not used for HTTP/2 connections.
+ * NOTE: MUST outlive every AsyncClient using it.
+ * NOTE: Thread-safe.
+ */
+class NX_NETWORK_API ClientConnectionPool
+{
+public:
+    using ConnectHandler = nx::utils::MoveOnlyFunc<void(
+        SystemError::ErrorCode /*resultCode*/,
+        std::shared_ptr<ClientConnection> /*connection*/)>;
+
+    static constexpr std::chrono::minutes kHttp1OnlyPeriod = std::chrono::minutes(10);
+    static constexpr std::chrono::seconds kSendTimeout = std::chrono::seconds(20);
+
+    ClientConnectionPool(
+        ssl::AdapterFunc adapterFunc = ssl::kDefaultCertificateCheck,
+        SessionSettings settings = {});
+    ~ClientConnectionPool();
+
+    ClientConnectionPool(const ClientConnectionPool&) = delete;
+    ClientConnectionPool& operator=(const ClientConnectionPool&) = delete;
+
+    /**
+     * @return false if the endpoint has recently failed to negotiate HTTP/2.
+     */
+    bool isHttp2Expected(const SocketAddress& endpoint) const;
+
+    /**
+     * Provides a connection to the endpoint bound to aioThread. A new connection is established
+     * if there is no one that can start a new stream. The handler is invoked within aioThread.
+     * SystemError::notImplemented is reported if the endpoint does not support HTTP/2.
+     */
+    void getConnection(
+        const SocketAddress& endpoint,
+        aio::AbstractAioThread* aioThread,
+        ConnectHandler handler);
+
+private:
+    using Key = std::pair<SocketAddress, aio::AbstractAioThread*>;
+
+    struct Entry
+    {
+        std::shared_ptr<ClientConnection> connection;
+        bool isConnected = false;
+        std::vector<ConnectHandler> pendingHandlers;
+    };
+
+    const ssl::AdapterFunc m_adapterFunc;
+    const SessionSettings m_settings;
+    mutable nx::Mutex m_mutex;
+    std::map<Key, Entry> m_connections;
+    mutable std::map<SocketAddress, std::chrono::steady_clock::time_point> m_http1OnlyEndpoints;
+
+    std::shared_ptr<ClientConnection> createConnection(const Key& key);
+
+    void provideEstablishedConnection(
+        const Key& key,
+        std::shared_ptr<ClientConnection> connection,
+        ConnectHandler handler);
+
+    void onConnected(
+        const Key& key,
+        ClientConnection* connection,
+        SystemError::ErrorCode resultCode);
+};
+
+} // namespace nx::network::http::http2
@@ -0,0 +1,136 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "frame.h"
+
+namespace nx::network::http::http2 {
+
+const char* toString(ErrorCode errorCode)
+{
+    switch (errorCode)
+    {
+        case ErrorCode::noError: return "NO_ERROR";
+        case ErrorCode::protocolError: return "PROTOCOL_ERROR";
+        case ErrorCode::internalError: return "INTERNAL_ERROR";
+        case ErrorCode::flowControlError: return "FLOW_CONTROL_ERROR";
+        case ErrorCode::settingsTimeout: return "SETTINGS_TIMEOUT";
+        case ErrorCode::streamClosed: return "STREAM_CLOSED";
+        case ErrorCode::frameSizeError: return "FRAME_SIZE_ERROR";
+        case ErrorCode::refusedStream: return "REFUSED_STREAM";
+        case ErrorCode::cancel: return "CANCEL";
+        case ErrorCode::compressionError: return "COMPRESSION_ERROR";
+        case ErrorCode::connectError: return "CONNECT_ERROR";
+        case ErrorCode::enhanceYourCalm: return "ENHANCE_YOUR_CALM";
+        case ErrorCode::inadequateSecurity: return "INADEQUATE_SECURITY";
+        case ErrorCode::http11Required: return "HTTP_1_1_REQUIRED";
+    }
+
+    return "UNKNOWN";
+}
+
+//-------------------------------------------------------------------------------------------------
+// FrameReader.
+
+void FrameReader::setMaxFrameSize(std::uint32_t size)
+{
+    m_maxFrameSize = size;
+}
+
+void FrameReader::feed(const char* data, std::size_t size)
+{
+    if (m_offset > 0 && m_offset == m_buffer.size())
+    {
+        m_buffer.resize(0);
+        m_offset = 0;
+    }
+
+    m_buffer.append(data, size);
+}
+
+std::optional<Frame> FrameReader::read()
+{
+    if (m_frameTooLarge || m_buffer.size() - m_offset < kFrameHeaderSize)
+        return std::nullopt;
+
+    const char* header = m_buffer.data() + m_offset;
+    const std::uint32_t length =
+        ((std::uint32_t) (std::uint8_t) header[0] << 16) |
+        ((std::uint32_t) (std::uint8_t) header[1] << 8) |
+        (std::uint32_t) (std::uint8_t) header[2];
+    if (length > m_maxFrameSize)
+    {
+        m_frameTooLarge = true;
+        return std::nullopt;
+    }
+
+    if (m_buffer.size() - m_offset < kFrameHeaderSize + length)
+        return std::nullopt;
+
+    Frame frame;
+    frame.type = (FrameType) header[3];
+    frame.flags = (std::uint8_t) header[4];
+    frame.streamId = readUint32(header + 5) & kMaxWindowSize; //< The reserved bit is ignored.
+    frame.payload.append(header + kFrameHeaderSize, length);
+    m_offset += kFrameHeaderSize + length;
+
+    // Not letting the consumed data accumulate when the peer sends frames continuously.
+    if (m_offset >= kDefaultMaxFrameSize)
+    {
+        m_buffer.erase(0, m_offset);
+        m_offset = 0;
+    }
+
+    return frame;
+}
+
+bool FrameReader::frameTooLarge() const
+{
+    return m_frameTooLarge;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void serializeFrame(
+    FrameType type,
+    std::uint8_t flags,
+    std::uint32_t streamId,
+    std::string_view payload,
+    nx::Buffer* out)
+{
+    const auto length = (std::uint32_t) payload.size();
+    *out += (char) (length >> 16);
+    *out += (char) (length >> 8);
+    *out += (char) length;
+    *out += (char) type;
+    *out += (char) flags;
+    appendUint32(streamId & kMaxWindowSize, out);
+    out->append(payload.data(), payload.size());
+}
+
+void appendUint16(std::uint16_t value, nx::Buffer* out)
+{
+    *out += (char) (value >> 8);
+    *out += (char) value;
+}
+
+void appendUint32(std::uint32_t value, nx::Buffer* out)
+{
+    *out += (char) (value >> 24);
+    *out += (char) (value >> 16);
+    *out += (char) (value >> 8);
+    *out += (char) value;
+}
+
+std::uint16_t readUint16(const char* data)
+{
+    return ((std::uint16_t) (std::uint8_t) data[0] << 8) | (std::uint8_t) data[1];
+}
+
+std::uint32_t readUint32(const char* data)
+{
+    return ((std::uint32_t) (std::uint8_t) data[0] << 24)
+        | ((std::uint32_t) (std::uint8_t) data[1] << 16)
+        | ((std::uint32_t) (std::uint8_t) data[2] << 8)
+        | (std::uint32_t) (std::uint8_t) data[3];
+}
+
+} // namespace nx::network::http::http2
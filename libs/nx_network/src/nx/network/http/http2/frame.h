@@ -0,0 +1,136 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <nx/utils/buffer.h>
+
+namespace nx::network::http::http2 {
+
+/** RFC 7540, 3.5. Sent by the client before anything else. */
+static constexpr std::string_view kConnectionPreface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+static constexpr std::size_t kFrameHeaderSize = 9;
+static constexpr std::uint32_t kDefaultMaxFrameSize = 16 * 1024;
+static constexpr std::uint32_t kMaxAllowedFrameSize = (1 << 24) - 1;
+static constexpr std::uint32_t kDefaultInitialWindowSize = 64 * 1024 - 1;
+static constexpr std::uint32_t kMaxWindowSize = 0x7fffffff;
+
+/** RFC 7540, 6. */
+enum class FrameType: std::uint8_t
+{
+    data = 0x0,
+    headers = 0x1,
+    priority = 0x2,
+    rstStream = 0x3,
+    settings = 0x4,
+    pushPromise = 0x5,
+    ping = 0x6,
+    goAway = 0x7,
+    windowUpdate = 0x8,
+    continuation = 0x9,
+};
+
+namespace FrameFlag {
+
+static constexpr std::uint8_t endStream = 0x1;
+static constexpr std::uint8_t ack = 0x1;
+static constexpr std::uint8_t endHeaders = 0x4;
+static constexpr std::uint8_t padded = 0x8;
+static constexpr std::uint8_t priority = 0x20;
+
+} // namespace FrameFlag
+
+/** RFC 7540, 7. */
+enum class ErrorCode: std::uint32_t
+{
+    noError = 0x0,
+    protocolError = 0x1,
+    internalError = 0x2,
+    flowControlError = 0x3,
+    settingsTimeout = 0x4,
+    streamClosed = 0x5,
+    frameSizeError = 0x6,
+    refusedStream = 0x7,
+    cancel = 0x8,
+    compressionError = 0x9,
+    connectError = 0xa,
+    enhanceYourCalm = 0xb,
+    inadequateSecurity = 0xc,
+    http11Required = 0xd,
+};
+
+NX_NETWORK_API const char* toString(ErrorCode errorCode);
+
+/** RFC 7540, 6.5.2. */
+enum class SettingId: std::uint16_t
+{
+    headerTableSize = 0x1,
+    enablePush = 0x2,
+    maxConcurrentStreams = 0x3,
+    initialWindowSize = 0x4,
+    maxFrameSize = 0x5,
+    maxHeaderListSize = 0x6,
+};
+
+struct Frame
+{
+    FrameType type = FrameType::data;
+    std::uint8_t flags = 0;
+    std::uint32_t streamId = 0;
+    nx::Buffer payload;
+
+    bool hasFlag(std::uint8_t flag) const { return (flags & flag) != 0; }
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Splits the incoming byte stream into frames.
+ */
+class NX_NETWORK_API FrameReader
+{
+public:
+    /**
+     * The SETTINGS_MAX_FRAME_SIZE value sent to the peer.
+     */
+    void setMaxFrameSize(std::uint32_t size);
+
+    void feed(const char* data, std::size_t size);
+
+    /**
+     * @return A complete frame or nothing if more data is needed. If the frame being read is
+     * larger than maxFrameSize, nothing is returned and frameTooLarge() becomes true.
+     */
+    std::optional<Frame> read();
+
+    bool frameTooLarge() const;
+
+private:
+    nx::Buffer m_buffer;
+    std::size_t m_offset = 0;
+    std::uint32_t m_maxFrameSize = kDefaultMaxFrameSize;
+    bool m_frameTooLarge = false;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Appends the frame header (RFC 7540, 4.1) followed by the payload to out.
+ */
+NX_NETWORK_API void serializeFrame(
+    FrameType type,
+    std::uint8_t flags,
+    std::uint32_t streamId,
+    std::string_view payload,
+    nx::Buffer* out);
+
+NX_NETWORK_API void appendUint16(std::uint16_t value, nx::Buffer* out);
+NX_NETWORK_API void appendUint32(std::uint32_t value, nx::Buffer* out);
+NX_NETWORK_API std::uint16_t readUint16(const char* data);
+NX_NETWORK_API std::uint32_t readUint32(const char* data);
+
+} // namespace nx::network::http::http2
@@ -0,0 +1,810 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "hpack.h"
+
+#include <algorithm>
+#include <array>
+
+namespace nx::network::http::http2 {
+
+namespace {
+
+/** RFC 7541, Appendix A. */
+static const std::array<HeaderField, 61> kStaticTable = {{
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+}};
+
+struct HuffmanCode
+{
+    std::uint32_t code;
+    int length;
+};
+
+/** RFC 7541, Appendix B. The last entry is EOS. */
+static const std::array<HuffmanCode, 257> kHuffmanCodes = {{
+    {0x1ff8, 13},
+    {0x7fffd8, 23},
+    {0xfffffe2, 28},
+    {0xfffffe3, 28},
+    {0xfffffe4, 28},
+    {0xfffffe5, 28},
+    {0xfffffe6, 28},
+    {0xfffffe7, 28},
+    {0xfffffe8, 28},
+    {0xffffea, 24},
+    {0x3ffffffc, 30},
+    {0xfffffe9, 28},
+    {0xfffffea, 28},
+    {0x3ffffffd, 30},
+    {0xfffffeb, 28},
+    {0xfffffec, 28},
+    {0xfffffed, 28},
+    {0xfffffee, 28},
+    {0xfffffef, 28},
+    {0xffffff0, 28},
+    {0xffffff1, 28},
+    {0xffffff2, 28},
+    {0x3ffffffe, 30},
+    {0xffffff3, 28},
+    {0xffffff4, 28},
+    {0xffffff5, 28},
+    {0xffffff6, 28},
+    {0xffffff7, 28},
+    {0xffffff8, 28},
+    {0xffffff9, 28},
+    {0xffffffa, 28},
+    {0xffffffb, 28},
+    {0x14, 6},
+    {0x3f8, 10},
+    {0x3f9, 10},
+    {0xffa, 12},
+    {0x1ff9, 13},
+    {0x15, 6},
+    {0xf8, 8},
+    {0x7fa, 11},
+    {0x3fa, 10},
+    {0x3fb, 10},
+    {0xf9, 8},
+    {0x7fb, 11},
+    {0xfa, 8},
+    {0x16, 6},
+    {0x17, 6},
+    {0x18, 6},
+    {0x0, 5},
+    {0x1, 5},
+    {0x2, 5},
+    {0x19, 6},
+    {0x1a, 6},
+    {0x1b, 6},
+    {0x1c, 6},
+    {0x1d, 6},
+    {0x1e, 6},
+    {0x1f, 6},
+    {0x5c, 7},
+    {0xfb, 8},
+    {0x7ffc, 15},
+    {0x20, 6},
+    {0xffb, 12},
+    {0x3fc, 10},
+    {0x1ffa, 13},
+    {0x21, 6},
+    {0x5d, 7},
+    {0x5e, 7},
+    {0x5f, 7},
+    {0x60, 7},
+    {0x61, 7},
+    {0x62, 7},
+    {0x63, 7},
+    {0x64, 7},
+    {0x65, 7},
+    {0x66, 7},
+    {0x67, 7},
+    {0x68, 7},
+    {0x69, 7},
+    {0x6a, 7},
+    {0x6b, 7},
+    {0x6c, 7},
+    {0x6d, 7},
+    {0x6e, 7},
+    {0x6f, 7},
+    {0x70, 7},
+    {0x71, 7},
+    {0x72, 7},
+    {0xfc, 8},
+    {0x73, 7},
+    {0xfd, 8},
+    {0x1ffb, 13},
+    {0x7fff0, 19},
+    {0x1ffc, 13},
+    {0x3ffc, 14},
+    {0x22, 6},
+    {0x7ffd, 15},
+    {0x3, 5},
+    {0x23, 6},
+    {0x4, 5},
+    {0x24, 6},
+    {0x5, 5},
+    {0x25, 6},
+    {0x26, 6},
+    {0x27, 6},
+    {0x6, 5},
+    {0x74, 7},
+    {0x75, 7},
+    {0x28, 6},
+    {0x29, 6},
+    {0x2a, 6},
+    {0x7, 5},
+    {0x2b, 6},
+    {0x76, 7},
+    {0x2c, 6},
+    {0x8, 5},
+    {0x9, 5},
+    {0x2d, 6},
+    {0x77, 7},
+    {0x78, 7},
+    {0x79, 7},
+    {0x7a, 7},
+    {0x7b, 7},
+    {0x7ffe, 15},
+    {0x7fc, 11},
+    {0x3ffd, 14},
+    {0x1ffd, 13},
+    {0xffffffc, 28},
+    {0xfffe6, 20},
+    {0x3fffd2, 22},
+    {0xfffe7, 20},
+    {0xfffe8, 20},
+    {0x3fffd3, 22},
+    {0x3fffd4, 22},
+    {0x3fffd5, 22},
+    {0x7fffd9, 23},
+    {0x3fffd6, 22},
+    {0x7fffda, 23},
+    {0x7fffdb, 23},
+    {0x7fffdc, 23},
+    {0x7fffdd, 23},
+    {0x7fffde, 23},
+    {0xffffeb, 24},
+    {0x7fffdf, 23},
+    {0xffffec, 24},
+    {0xffffed, 24},
+    {0x3fffd7, 22},
+    {0x7fffe0, 23},
+    {0xffffee, 24},
+    {0x7fffe1, 23},
+    {0x7fffe2, 23},
+    {0x7fffe3, 23},
+    {0x7fffe4, 23},
+    {0x1fffdc, 21},
+    {0x3fffd8, 22},
+    {0x7fffe5, 23},
+    {0x3fffd9, 22},
+    {0x7fffe6, 23},
+    {0x7fffe7, 23},
+    {0xffffef, 24},
+    {0x3fffda, 22},
+    {0x1fffdd, 21},
+    {0xfffe9, 20},
+    {0x3fffdb, 22},
+    {0x3fffdc, 22},
+    {0x7fffe8, 23},
+    {0x7fffe9, 23},
+    {0x1fffde, 21},
+    {0x7fffea, 23},
+    {0x3fffdd, 22},
+    {0x3fffde, 22},
+    {0xfffff0, 24},
+    {0x1fffdf, 21},
+    {0x3fffdf, 22},
+    {0x7fffeb, 23},
+    {0x7fffec, 23},
+    {0x1fffe0, 21},
+    {0x1fffe1, 21},
+    {0x3fffe0, 22},
+    {0x1fffe2, 21},
+    {0x7fffed, 23},
+    {0x3fffe1, 22},
+    {0x7fffee, 23},
+    {0x7fffef, 23},
+    {0xfffea, 20},
+    {0x3fffe2, 22},
+    {0x3fffe3, 22},
+    {0x3fffe4, 22},
+    {0x7ffff0, 23},
+    {0x3fffe5, 22},
+    {0x3fffe6, 22},
+    {0x7ffff1, 23},
+    {0x3ffffe0, 26},
+    {0x3ffffe1, 26},
+    {0xfffeb, 20},
+    {0x7fff1, 19},
+    {0x3fffe7, 22},
+    {0x7ffff2, 23},
+    {0x3fffe8, 22},
+    {0x1ffffec, 25},
+    {0x3ffffe2, 26},
+    {0x3ffffe3, 26},
+    {0x3ffffe4, 26},
+    {0x7ffffde, 27},
+    {0x7ffffdf, 27},
+    {0x3ffffe5, 26},
+    {0xfffff1, 24},
+    {0x1ffffed, 25},
+    {0x7fff2, 19},
+    {0x1fffe3, 21},
+    {0x3ffffe6, 26},
+    {0x7ffffe0, 27},
+    {0x7ffffe1, 27},
+    {0x3ffffe7, 26},
+    {0x7ffffe2, 27},
+    {0xfffff2, 24},
+    {0x1fffe4, 21},
+    {0x1fffe5, 21},
+    {0x3ffffe8, 26},
+    {0x3ffffe9, 26},
+    {0xffffffd, 28},
+    {0x7ffffe3, 27},
+    {0x7ffffe4, 27},
+    {0x7ffffe5, 27},
+    {0xfffec, 20},
+    {0xfffff3, 24},
+    {0xfffed, 20},
+    {0x1fffe6, 21},
+    {0x3fffe9, 22},
+    {0x1fffe7, 21},
+    {0x1fffe8, 21},
+    {0x7ffff3, 23},
+    {0x3fffea, 22},
+    {0x3fffeb, 22},
+    {0x1ffffee, 25},
+    {0x1ffffef, 25},
+    {0xfffff4, 24},
+    {0xfffff5, 24},
+    {0x3ffffea, 26},
+    {0x7ffff4, 23},
+    {0x3ffffeb, 26},
+    {0x7ffffe6, 27},
+    {0x3ffffec, 26},
+    {0x3ffffed, 26},
+    {0x7ffffe7, 27},
+    {0x7ffffe8, 27},
+    {0x7ffffe9, 27},
+    {0x7ffffea, 27},
+    {0x7ffffeb, 27},
+    {0xffffffe, 28},
+    {0x7ffffec, 27},
+    {0x7ffffed, 27},
+    {0x7ffffee, 27},
+    {0x7ffffef, 27},
+    {0x7fffff0, 27},
+    {0x3ffffee, 26},
+    {0x3fffffff, 30},
+}};
+
+static constexpr int kEos = 256;
+
+class HuffmanDecodingTree
+{
+public:
+    struct Node
+    {
+        std::array<int, 2> children{-1, -1};
+        int symbol = -1;
+    };
+
+    HuffmanDecodingTree()
+    {
+        m_nodes.emplace_back();
+        for (int symbol = 0; symbol < (int) kHuffmanCodes.size(); ++symbol)
+        {
+            const auto& code = kHuffmanCodes[symbol];
+            int node = 0;
+            for (int i = code.length - 1; i >= 0; --i)
+            {
+                const int bit = (code.code >> i) & 1;
+                if (m_nodes[node].children[bit] < 0)
+                {
+                    m_nodes[node].children[bit] = (int) m_nodes.size();
+                    m_nodes.emplace_back();
+                }
+                node = m_nodes[node].children[bit];
+            }
+            m_nodes[node].symbol = symbol;
+        }
+    }
+
+    const Node& node(int index) const { return m_nodes[index]; }
+
+private:
+    std::vector<Node> m_nodes;
+};
+
+const HuffmanDecodingTree& huffmanDecodingTree()
+{
+    static const HuffmanDecodingTree tree;
+    return tree;
+}
+
+/** RFC 7541, 5.1. */
+void encodeInteger(
+    std::uint64_t value, int prefixBits, std::uint8_t firstByteFlags, nx::Buffer* out)
+{
+    const std::uint64_t maxPrefixValue = (1U << prefixBits) - 1;
+    if (value < maxPrefixValue)
+    {
+        *out += (char) (firstByteFlags | value);
+        return;
+    }
+
+    *out += (char) (firstByteFlags | maxPrefixValue);
+    value -= maxPrefixValue;
+    for (; value >= 128; value /= 128)
+        *out += (char) (value % 128 + 128);
+    *out += (char) value;
+}
+
+bool decodeInteger(std::string_view* data, int prefixBits, std::uint64_t* value)
+{
+    if (data->empty())
+        return false;
+
+    const std::uint64_t maxPrefixValue = (1U << prefixBits) - 1;
+    *value = (std::uint8_t) data->front() & maxPrefixValue;
+    data->remove_prefix(1);
+    if (*value < maxPrefixValue)
+        return true;
+
+    for (int shift = 0; !data->empty() && shift <= 56; shift += 7)
+    {
+        const std::uint8_t byte = (std::uint8_t) data->front();
+        data->remove_prefix(1);
+        *value += (std::uint64_t) (byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+/** RFC 7541, 5.2. */
+void encodeString(std::string_view str, nx::Buffer* out)
+{
+    const auto huffmanSize = huffman::encodedSize(str);
+    if (huffmanSize < str.size())
+    {
+        encodeInteger(huffmanSize, 7, 0x80, out);
+        huffman::encode(str, out);
+    }
+    else
+    {
+        encodeInteger(str.size(), 7, 0, out);
+        out->append(str.data(), str.size());
+    }
+}
+
+bool decodeString(std::string_view* data, std::string* str)
+{
+    if (data->empty())
+        return false;
+
+    const bool isHuffmanEncoded = (data->front() & 0x80) != 0;
+    std::uint64_t length = 0;
+    if (!decodeInteger(data, 7, &length) || length > data->size())
+        return false;
+
+    const auto encoded = data->substr(0, length);
+    data->remove_prefix(length);
+
+    str->clear();
+    if (isHuffmanEncoded)
+        return huffman::decode(encoded, str);
+
+    str->assign(encoded);
+    return true;
+}
+
+bool isSensitive(const std::string& name)
+{
+    return name == "authorization" || name == "proxy-authorization" || name == "set-cookie";
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+// HpackDynamicTable.
+
+HpackDynamicTable::HpackDynamicTable(std::size_t maxSize):
+    m_maxSize(maxSize)
+{
+}
+
+const HeaderField* HpackDynamicTable::get(std::size_t index) const
+{
+    return index < m_entries.size() ? &m_entries[index] : nullptr;
+}
+
+std::size_t HpackDynamicTable::find(const HeaderField& field, bool* isNameOnly) const
+{
+    std::size_t nameIndex = 0;
+    for (std::size_t i = 0; i < kStaticTable.size(); ++i)
+    {
+        if (kStaticTable[i].name != field.name)
+            continue;
+        if (kStaticTable[i].value == field.value)
+        {
+            *isNameOnly = false;
+            return i + 1;
+        }
+        if (nameIndex == 0)
+            nameIndex = i + 1;
+    }
+
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].name != field.name)
+            continue;
+        if (m_entries[i].value == field.value)
+        {
+            *isNameOnly = false;
+            return kStaticTable.size() + i + 1;
+        }
+        if (nameIndex == 0)
+            nameIndex = kStaticTable.size() + i + 1;
+    }
+
+    *isNameOnly = true;
+    return nameIndex;
+}
+
+void HpackDynamicTable::add(HeaderField field)
+{
+    const auto size = entrySize(field);
+    if (size > m_maxSize)
+    {
+        // RFC 7541, 4.4: An attempt to add an entry larger than the table empties the table.
+        evict(0);
+        return;
+    }
+
+    evict(m_maxSize - size);
+    m_entries.push_front(std::move(field));
+    m_size += size;
+}
+
+void HpackDynamicTable::setMaxSize(std::size_t size)
+{
+    m_maxSize = size;
+    evict(m_maxSize);
+}
+
+std::size_t HpackDynamicTable::maxSize() const
+{
+    return m_maxSize;
+}
+
+std::size_t HpackDynamicTable::size() const
+{
+    return m_size;
+}
+
+std::size_t HpackDynamicTable::entryCount() const
+{
+    return m_entries.size();
+}
+
+std::size_t HpackDynamicTable::entrySize(const HeaderField& field)
+{
+    static constexpr std::size_t kEntryOverhead = 32;
+    return field.name.size() + field.value.size() + kEntryOverhead;
+}
+
+void HpackDynamicTable::evict(std::size_t sizeToFit)
+{
+    while (m_size > sizeToFit)
+    {
+        m_size -= entrySize(m_entries.back());
+        m_entries.pop_back();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// HpackDecoder.
+
+HpackDecoder::HpackDecoder(std::size_t maxTableSize):
+    m_dynamicTable(maxTableSize),
+    m_maxTableSizeLimit(maxTableSize)
+{
+}
+
+bool HpackDecoder::decode(std::string_view block, HeaderList* headers)
+{
+    std::size_t headerListSize = 0;
+    bool isFieldDecoded = false;
+
+    while (!block.empty())
+    {
+        const auto firstByte = (std::uint8_t) block.front();
+        std::uint64_t index = 0;
+        HeaderField field;
+
+        if (firstByte & 0x80)
+        {
+            // Indexed header field.
+            if (!decodeInteger(&block, 7, &index) || !getIndexed(index, &field))
+                return false;
+        }
+        else if ((firstByte & 0xe0) == 0x20)
+        {
+            // Dynamic table size update. Allowed only before the first field of the block.
+            std::uint64_t size = 0;
+            if (isFieldDecoded || !decodeInteger(&block, 5, &size) || size > m_maxTableSizeLimit)
+                return false;
+            m_dynamicTable.setMaxSize(size);
+            continue;
+        }
+        else
+        {
+            // A literal field. With incremental indexing, without indexing or never indexed.
+            const bool isIndexingRequired = (firstByte & 0xc0) == 0x40;
+            if (!decodeInteger(&block, isIndexingRequired ? 6 : 4, &index))
+                return false;
+
+            if (index != 0)
+            {
+                if (!getIndexed(index, &field))
+                    return false;
+            }
+            else if (!decodeString(&block, &field.name))
+            {
+                return false;
+            }
+
+            if (!decodeString(&block, &field.value))
+                return false;
+
+            if (isIndexingRequired)
+                m_dynamicTable.add(field);
+        }
+
+        isFieldDecoded = true;
+        headerListSize += HpackDynamicTable::entrySize(field);
+        if (headerListSize > m_maxHeaderListSize)
+            return false;
+        headers->push_back(std::move(field));
+    }
+
+    return true;
+}
+
+void HpackDecoder::setMaxTableSizeLimit(std::size_t size)
+{
+    m_maxTableSizeLimit = size;
+    if (m_dynamicTable.maxSize() > size)
+        m_dynamicTable.setMaxSize(size);
+}
+
+void HpackDecoder::setMaxHeaderListSize(std::size_t size)
+{
+    m_maxHeaderListSize = size;
+}
+
+const HpackDynamicTable& HpackDecoder::dynamicTable() const
+{
+    return m_dynamicTable;
+}
+
+bool HpackDecoder::getIndexed(std::size_t index, HeaderField* field) const
+{
+    if (index == 0)
+        return false;
+
+    if (index <= kStaticTable.size())
+    {
+        field->name = kStaticTable[index - 1].name;
+        field->value = kStaticTable[index - 1].value;
+        return true;
+    }
+
+    const auto entry = m_dynamicTable.get(index - kStaticTable.size() - 1);
+    if (!entry)
+        return false;
+
+    *field = *entry;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// HpackEncoder.
+
+HpackEncoder::HpackEncoder(std::size_t maxTableSize):
+    m_dynamicTable(maxTableSize),
+    m_minTableSizeSinceLastBlock(maxTableSize)
+{
+}
+
+void HpackEncoder::encode(const HeaderList& headers, nx::Buffer* block)
+{
+    if (m_pendingTableSizeUpdate)
+    {
+        // RFC 7541, 4.2: The smallest size the table has been set to is signalled first.
+        if (m_minTableSizeSinceLastBlock < *m_pendingTableSizeUpdate)
+            encodeInteger(m_minTableSizeSinceLastBlock, 5, 0x20, block);
+        encodeInteger(*m_pendingTableSizeUpdate, 5, 0x20, block);
+
+        m_minTableSizeSinceLastBlock = *m_pendingTableSizeUpdate;
+        m_pendingTableSizeUpdate = std::nullopt;
+    }
+
+    for (const auto& field: headers)
+        encodeField(field, block);
+}
+
+void HpackEncoder::setMaxTableSize(std::size_t size)
+{
+    m_dynamicTable.setMaxSize(size);
+    m_minTableSizeSinceLastBlock = std::min(m_minTableSizeSinceLastBlock, size);
+    m_pendingTableSizeUpdate = size;
+}
+
+const HpackDynamicTable& HpackEncoder::dynamicTable() const
+{
+    return m_dynamicTable;
+}
+
+void HpackEncoder::encodeField(const HeaderField& field, nx::Buffer* block)
+{
+    bool isNameOnly = false;
+    const auto index = m_dynamicTable.find(field, &isNameOnly);
+    if (index != 0 && !isNameOnly)
+    {
+        encodeInteger(index, 7, 0x80, block);
+        return;
+    }
+
+    const bool isIndexingAllowed = !isSensitive(field.name)
+        && HpackDynamicTable::entrySize(field) <= m_dynamicTable.maxSize() / 2;
+
+    if (isIndexingAllowed)
+        encodeInteger(index, 6, 0x40, block);
+    else if (isSensitive(field.name))
+        encodeInteger(index, 4, 0x10, block); //< Never indexed.
+    else
+        encodeInteger(index, 4, 0x00, block); //< Without indexing.
+
+    if (index == 0)
+        encodeString(field.name, block);
+    encodeString(field.value, block);
+
+    if (isIndexingAllowed)
+        m_dynamicTable.add(field);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+namespace huffman {
+
+bool decode(std::string_view data, std::string* out)
+{
+    const auto& tree = huffmanDecodingTree();
+
+    int node = 0;
+    int bitsSinceLastSymbol = 0;
+    bool isPaddingOfOnes = true;
+    for (const char ch: data)
+    {
+        for (int i = 7; i >= 0; --i)
+        {
+            const int bit = ((std::uint8_t) ch >> i) & 1;
+            node = tree.node(node).children[bit];
+            if (node < 0)
+                return false;
+
+            ++bitsSinceLastSymbol;
+            isPaddingOfOnes = isPaddingOfOnes && bit == 1;
+
+            const int symbol = tree.node(node).symbol;
+            if (symbol < 0)
+                continue;
+            if (symbol == kEos)
+                return false;
+
+            *out += (char) symbol;
+            node = 0;
+            bitsSinceLastSymbol = 0;
+            isPaddingOfOnes = true;
+        }
+    }
+
+    // RFC 7541, 5.2: The padding is the most significant bits of EOS and is shorter than 8 bits.
+    return bitsSinceLastSymbol < 8 && isPaddingOfOnes;
+}
+
+void encode(std::string_view data, nx::Buffer* out)
+{
+    std::uint64_t bits = 0;
+    int bitCount = 0;
+    for (const char ch: data)
+    {
+        const auto& code = kHuffmanCodes[(std::uint8_t) ch];
+        bits = (bits << code.length) | code.code;
+        bitCount += code.length;
+        for (; bitCount >= 8; bitCount -= 8)
+            *out += (char) (bits >> (bitCount - 8));
+        bits &= (1U << bitCount) - 1;
+    }
+
+    if (bitCount > 0)
+        *out += (char) ((bits << (8 - bitCount)) | (0xff >> bitCount));
+}
+
+std::size_t encodedSize(std::string_view data)
+{
+    std::size_t bitCount = 0;
+    for (const char ch: data)
+        bitCount += kHuffmanCodes[(std::uint8_t) ch].length;
+    return (bitCount + 7) / 8;
+}
+
+} // namespace huffman
+
+} // namespace nx::network::http::http2
@@ -0,0 +1,170 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nx/utils/buffer.h>
+
+namespace nx::network::http::http2 {
+
+/**
+ * Header field as it is transferred by HTTP/2. The name is in lower case. Pseudo-header fields
+ * (:method, :path, :status, etc) are included.
+ */
+struct HeaderField
+{
+    std::string name;
+    std::string value;
+
+    bool operator==(const HeaderField& right) const = default;
+};
+
+using HeaderList = std::vector<HeaderField>;
+
+static constexpr std::size_t kDefaultHeaderTableSize = 4096;
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * The dynamic table of HPACK (RFC 7541, 2.3.2). Shared by the encoder and the decoder.
+ */
+class NX_NETWORK_API HpackDynamicTable
+{
+public:
+    HpackDynamicTable(std::size_t maxSize = kDefaultHeaderTableSize);
+
+    /**
+     * @param index Counted from 0, the newest entry first.
+     */
+    const HeaderField* get(std::size_t index) const;
+
+    /**
+     * @return Index in the address space of HPACK (the static table entries go first) or 0.
+     * If there is no exact match, the index of an entry with the same name is reported with
+     * isNameOnly set.
+     */
+    std::size_t find(const HeaderField& field, bool* isNameOnly) const;
+
+    void add(HeaderField field);
+
+    /**
+     * Evicts the oldest entries until the table fits the new size.
+     */
+    void setMaxSize(std::size_t size);
+
+    std::size_t maxSize() const;
+    std::size_t size() const;
+    std::size_t entryCount() const;
+
+    /**
+     * The size of an entry as defined by RFC 7541, 4.1.
+     */
+    static std::size_t entrySize(const HeaderField& field);
+
+private:
+    std::deque<HeaderField> m_entries;
+    std::size_t m_maxSize = kDefaultHeaderTableSize;
+    std::size_t m_size = 0;
+
+    void evict(std::size_t sizeToFit);
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Decodes header blocks received by an HTTP/2 connection. There is one decoder per connection
+ * since the dynamic table is updated by every header block.
+ */
+class NX_NETWORK_API HpackDecoder
+{
+public:
+    static constexpr std::size_t kDefaultMaxHeaderListSize = 64 * 1024;
+
+    HpackDecoder(std::size_t maxTableSize = kDefaultHeaderTableSize);
+
+    /**
+     * Decodes a complete header block (the payload of HEADERS and CONTINUATION frames).
+     * @return false if the block is malformed or the decoded header list is larger than
+     * maxHeaderListSize. That is a connection error (COMPRESSION_ERROR) since the dynamic table
+     * state is unknown from now on.
+     */
+    bool decode(std::string_view block, HeaderList* headers);
+
+    /**
+     * The upper limit of the dynamic table size the encoder on the other side may choose.
+     * This is the SETTINGS_HEADER_TABLE_SIZE value sent to the peer.
+     */
+    void setMaxTableSizeLimit(std::size_t size);
+
+    /**
+     * The SETTINGS_MAX_HEADER_LIST_SIZE value sent to the peer. The size is calculated as the
+     * sum of HpackDynamicTable::entrySize of all fields.
+     */
+    void setMaxHeaderListSize(std::size_t size);
+
+    const HpackDynamicTable& dynamicTable() const;
+
+private:
+    HpackDynamicTable m_dynamicTable;
+    std::size_t m_maxTableSizeLimit = kDefaultHeaderTableSize;
+    std::size_t m_maxHeaderListSize = kDefaultMaxHeaderListSize;
+
+    bool getIndexed(std::size_t index, HeaderField* field) const;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Encodes header blocks sent by an HTTP/2 connection.
+ * Fields are added to the dynamic table unless they are sensitive (e.g., Authorization) or too
+ * large. Strings are Huffman-encoded if that makes them shorter.
+ */
+class NX_NETWORK_API HpackEncoder
+{
+public:
+    HpackEncoder(std::size_t maxTableSize = kDefaultHeaderTableSize);
+
+    /**
+     * Encodes the fields and appends the result to block.
+     */
+    void encode(const HeaderList& headers, nx::Buffer* block);
+
+    /**
+     * Applies SETTINGS_HEADER_TABLE_SIZE received from the peer. The change is signalled to
+     * the peer at the beginning of the next header block.
+     */
+    void setMaxTableSize(std::size_t size);
+
+    const HpackDynamicTable& dynamicTable() const;
+
+private:
+    HpackDynamicTable m_dynamicTable;
+    std::optional<std::size_t> m_pendingTableSizeUpdate;
+    std::size_t m_minTableSizeSinceLastBlock = kDefaultHeaderTableSize;
+
+    void encodeField(const HeaderField& field, nx::Buffer* block);
+};
+
+//-------------------------------------------------------------------------------------------------
+
+namespace huffman {
+
+/**
+ * Decodes a string encoded with the HPACK Huffman code (RFC 7541, 5.2).
+ * @return false if the input is malformed (e.g., contains EOS or invalid padding).
+ */
+NX_NETWORK_API bool decode(std::string_view data, std::string* out);
+
+NX_NETWORK_API void encode(std::string_view data, nx::Buffer* out);
+
+NX_NETWORK_API std::size_t encodedSize(std::string_view data);
+
+} // namespace huffman
+
+} // namespace nx::network::http::http2
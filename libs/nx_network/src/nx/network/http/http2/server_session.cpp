@@ -0,0 +1,402 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "server_session.h"
+
+#include <algorithm>
+
+#include <nx/network/http/server/http_server_connection.h>
+#include <nx/utils/string.h>
+
+namespace nx::network::http::http2 {
+
+ServerSession::ServerSession(
+    HttpServerConnection* connection,
+    AbstractRequestHandler* requestHandler,
+    SessionSettings settings)
+    :
+    Session(Role::server, settings),
+    m_connection(connection),
+    m_requestHandler(requestHandler)
+{
+    bindToAioThread(connection->getAioThread());
+}
+
+ServerSession::~ServerSession()
+{
+    pleaseStopSync();
+}
+
+void ServerSession::bindToAioThread(aio::AbstractAioThread* aioThread)
+{
+    base_type::bindToAioThread(aioThread);
+
+    for (auto& [streamId, stream]: m_streams)
+    {
+        if (stream.responseBody)
+            stream.responseBody->bindToAioThread(aioThread);
+    }
+}
+
+void ServerSession::processReceivedData(const nx::Buffer& data)
+{
+    Session::processReceivedData(data.data(), data.size());
+}
+
+void ServerSession::onConnectionClosed(SystemError::ErrorCode reason)
+{
+    m_closeReason = reason;
+    terminate(ErrorCode::cancel);
+    m_streams.clear();
+}
+
+void ServerSession::stopWhileInAioThread()
+{
+    base_type::stopWhileInAioThread();
+
+    for (auto& [streamId, stream]: m_streams)
+    {
+        if (stream.requestBodyWriter)
+            stream.requestBodyWriter->writeEof(SystemError::interrupted);
+    }
+    m_streams.clear();
+}
+
+void ServerSession::onStreamHeaders(
+    std::uint32_t streamId, HeaderList headers, bool endStream)
+{
+    if (auto it = m_streams.find(streamId); it != m_streams.end())
+    {
+        // Trailers. Not passed to the handler, same as with HTTP/1.1 chunked encoding.
+        if (endStream)
+            onStreamData(streamId, nx::Buffer(), endStream);
+        return;
+    }
+
+    auto request = buildRequest(std::move(headers));
+    if (!request)
+    {
+        NX_DEBUG(this, "Malformed request on stream %1 from %2",
+            streamId, m_connection->getForeignAddress());
+        return resetStream(streamId, ErrorCode::protocolError);
+    }
+
+    processRequest(streamId, std::move(*request), endStream);
+}
+
+void ServerSession::onStreamData(std::uint32_t streamId, nx::Buffer data, bool endStream)
+{
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end() || !it->second.requestBodyWriter)
+        return;
+
+    // The stream is forgotten before EOF is reported since the handler may destroy the body or
+    // the whole connection on EOF.
+    auto writer = it->second.requestBodyWriter;
+    if (endStream)
+    {
+        it->second.requestBodyWriter = nullptr;
+        eraseStreamIfDone(streamId);
+    }
+
+    if (!data.empty())
+        writer->writeBodyData(std::move(data));
+    if (endStream)
+        writer->writeEof(SystemError::noError);
+}
+
+void ServerSession::onStreamReset(std::uint32_t streamId, ErrorCode errorCode)
+{
+    NX_VERBOSE(this, "Stream %1 from %2 is reset with %3",
+        streamId, m_connection->getForeignAddress(), toString(errorCode));
+
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end())
+        return;
+
+    auto writer = std::move(it->second.requestBodyWriter);
+    m_streams.erase(it);
+
+    if (writer)
+        writer->writeEof(m_closeReason);
+}
+
+void ServerSession::onStreamWritable(std::uint32_t streamId)
+{
+    readMoreResponseBody(streamId);
+}
+
+void ServerSession::onTerminated(ErrorCode errorCode)
+{
+    NX_DEBUG(this, "Session with %1 is terminated with %2",
+        m_connection->getForeignAddress(), toString(errorCode));
+
+    if (!hasUnsentData())
+        post([this]() { m_connection->closeConnection(SystemError::noError); });
+}
+
+void ServerSession::sendBytes(nx::Buffer data)
+{
+    const auto size = data.size();
+    m_connection->sendData(
+        std::move(data),
+        [this, size](SystemError::ErrorCode resultCode)
+        {
+            if (resultCode != SystemError::noError)
+                return; //< The connection is closed.
+
+            onBytesSent(size);
+            if (isTerminated() && !hasUnsentData())
+                m_connection->closeConnection(SystemError::noError);
+        });
+}
+
+std::optional<Request> ServerSession::buildRequest(HeaderList headers)
+{
+    Request request;
+    // Presenting the request as an HTTP/1.1 one, so that it is processed as usual.
+    request.requestLine.version = http_1_1;
+
+    std::string path;
+    std::string authority;
+    std::string cookie;
+    for (auto& field: headers)
+    {
+        if (field.name.starts_with(':'))
+        {
+            if (field.name == ":method")
+                request.requestLine.method = field.value;
+            else if (field.name == ":path")
+                path = std::move(field.value);
+            else if (field.name == ":authority")
+                authority = std::move(field.value);
+            else if (field.name != ":scheme")
+                return std::nullopt;
+            continue;
+        }
+
+        if (isConnectionSpecificHeader(field.name))
+            return std::nullopt;
+
+        // RFC 7540, 8.1.2.5: Cookie may be split into multiple fields.
+        if (field.name == "cookie")
+        {
+            cookie += (cookie.empty() ? "" : "; ") + field.value;
+            continue;
+        }
+
+        request.headers.emplace(std::move(field.name), std::move(field.value));
+    }
+
+    // CONNECT is not supported since it requires the stream to be used as a tunnel.
+    if (request.requestLine.method.toString().empty() || path.empty()
+        || request.requestLine.method == Method::connect)
+    {
+        return std::nullopt;
+    }
+
+    request.requestLine.url = nx::utils::Url(path);
+    if (!authority.empty() && !request.headers.contains("Host"))
+        request.headers.emplace("Host", std::move(authority));
+    if (!cookie.empty())
+        request.headers.emplace("Cookie", std::move(cookie));
+
+    return request;
+}
+
+void ServerSession::processRequest(std::uint32_t streamId, Request request, bool endStream)
+{
+    NX_VERBOSE(this, "Processing request %1 received from %2 on stream %3",
+        request.requestLine, m_connection->getForeignAddress(), streamId);
+
+    m_connection->extractClientEndpoint(request.headers);
+
+    auto& stream = m_streams[streamId];
+    stream.requestLine = request.requestLine;
+    stream.requestReceivedTime = clock_type::now();
+
+    std::optional<uint64_t> contentLength;
+    if (auto it = request.headers.find("Content-Length"); it != request.headers.end())
+        contentLength = nx::utils::stoull(it->second);
+
+    auto body = std::make_unique<WritableMessageBody>(
+        getHeaderValue(request.headers, "Content-Type"),
+        contentLength);
+    if (endStream)
+        body->writeEof();
+    else
+        stream.requestBodyWriter = body->writer();
+
+    auto sendResponseFunc =
+        [weakThis = weak_from_this(), streamId](RequestResult result) mutable
+        {
+            auto strongThis = weakThis.lock();
+            if (!strongThis)
+                return;
+
+            auto session = strongThis.get();
+            session->post(
+                [session, strongThis = std::move(strongThis), streamId,
+                    result = std::move(result)]() mutable
+                {
+                    session->sendResponse(streamId, std::move(result));
+                });
+        };
+
+    if (!m_requestHandler)
+        return sendResponseFunc(RequestResult(StatusCode::notFound));
+
+    m_requestHandler->serve(
+        RequestContext(
+            m_connection->attrs(),
+            /*connection*/ {},
+            m_connection->lastRequestSource(),
+            {},
+            std::move(request),
+            std::move(body)),
+        std::move(sendResponseFunc));
+}
+
+void ServerSession::sendResponse(std::uint32_t streamId, RequestResult result)
+{
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end() || isTerminated())
+        return; //< The stream has been reset.
+
+    auto& stream = it->second;
+
+    if (result.statusCode == StatusCode::switchingProtocols)
+    {
+        NX_DEBUG(this, "Protocol upgrade requested by %1 is not supported over HTTP/2",
+            stream.requestLine);
+        resetStream(streamId, ErrorCode::http11Required);
+        m_streams.erase(streamId);
+        return;
+    }
+
+    if (result.connectionEvents.onResponseHasBeenSent)
+    {
+        NX_DEBUG(this, "Connection events of %1 are not supported over HTTP/2. Ignoring",
+            stream.requestLine);
+    }
+
+    Response response;
+    response.statusLine.version = http_1_1;
+    response.statusLine.statusCode = result.statusCode;
+    response.headers = std::move(result.headers);
+
+    HttpServerConnection::RequestDescriptor descriptor;
+    descriptor.requestLine = stream.requestLine;
+    m_connection->addResponseHeaders(descriptor, &response, result.body.get());
+
+    NX_VERBOSE(this, "%1 - \"%2\" %3 on stream %4",
+        m_connection->getForeignAddress().address, stream.requestLine.toString(),
+        result.statusCode, streamId);
+
+    if (nx::utils::contains(getHeaderValue(response.headers, "Transfer-Encoding"), "chunked"))
+        stream.chunkedBodyParser = ChunkedStreamParser();
+
+    if (result.body && (stream.requestLine.method == Method::head
+        || result.body->contentLength() == 0
+        || !StatusCode::isMessageBodyAllowed(result.statusCode)))
+    {
+        result.body.reset();
+    }
+
+    stream.isResponseSent = !result.body;
+    submitHeaders(streamId, buildResponseHeaders(response), /*endStream*/ !result.body);
+
+    if (m_connection->m_responseSentHandler)
+    {
+        m_connection->m_responseSentHandler(std::chrono::duration_cast<std::chrono::microseconds>(
+            clock_type::now() - stream.requestReceivedTime));
+    }
+
+    if (!result.body)
+        return eraseStreamIfDone(streamId);
+
+    stream.responseBody = std::move(result.body);
+    stream.responseBody->bindToAioThread(getAioThread());
+    readMoreResponseBody(streamId);
+}
+
+HeaderList ServerSession::buildResponseHeaders(const Response& response)
+{
+    HeaderList headers;
+    headers.reserve(response.headers.size() + 1);
+    headers.push_back({":status", std::to_string(response.statusLine.statusCode)});
+
+    for (const auto& [name, value]: response.headers)
+    {
+        auto lowerCaseName = nx::utils::toLower(name);
+        if (!isConnectionSpecificHeader(lowerCaseName))
+            headers.push_back({std::move(lowerCaseName), value});
+    }
+
+    return headers;
+}
+
+void ServerSession::readMoreResponseBody(std::uint32_t streamId)
+{
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end() || !it->second.responseBody)
+        return;
+
+    it->second.responseBody->readAsync(
+        [this, streamId](SystemError::ErrorCode resultCode, nx::Buffer data)
+        {
+            onSomeResponseBodyRead(streamId, resultCode, std::move(data));
+        });
+}
+
+void ServerSession::onSomeResponseBodyRead(
+    std::uint32_t streamId, SystemError::ErrorCode resultCode, nx::Buffer data)
+{
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end())
+        return;
+
+    auto& stream = it->second;
+
+    if (resultCode != SystemError::noError)
+    {
+        NX_DEBUG(this, "Error fetching message body of %1 to send. %2",
+            stream.requestLine, SystemError::toString(resultCode));
+        resetStream(streamId, ErrorCode::internalError);
+        m_streams.erase(it);
+        return;
+    }
+
+    bool isEof = data.empty();
+    if (stream.chunkedBodyParser)
+    {
+        // The chunked encoding does not exist in HTTP/2, sending the chunk contents only.
+        nx::Buffer decoded;
+        stream.chunkedBodyParser->parse(
+            data, [&decoded](const auto& chunk) { decoded.append(chunk.data(), chunk.size()); });
+        isEof = isEof || stream.chunkedBodyParser->eof();
+        data = std::move(decoded);
+
+        if (data.empty() && !isEof)
+            return readMoreResponseBody(streamId);
+    }
+
+    if (isEof)
+    {
+        stream.isResponseSent = true;
+        stream.responseBody.reset();
+        submitData(streamId, std::move(data), /*endStream*/ true);
+        return eraseStreamIfDone(streamId);
+    }
+
+    // onStreamWritable() is reported when the data is sent.
+    submitData(streamId, std::move(data), /*endStream*/ false);
+}
+
+void ServerSession::eraseStreamIfDone(std::uint32_t streamId)
+{
+    auto it = m_streams.find(streamId);
+    if (it != m_streams.end() && it->second.isResponseSent && !it->second.requestBodyWriter)
+        m_streams.erase(it);
+}
+
+} // namespace nx::network::http::http2
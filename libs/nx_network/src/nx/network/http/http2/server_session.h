@@ -0,0 +1,102 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+
+#include <nx/network/aio/basic_pollable.h>
+#include <nx/network/http/chunked_stream_parser.h>
+#include <nx/network/http/server/abstract_http_request_handler.h>
+#include <nx/network/http/writable_message_body.h>
+
+#include "session.h"
+
+namespace nx::network::http { class HttpServerConnection; }
+
+namespace nx::network::http::http2 {
+
+/**
+ * Serves HTTP/2 streams received by an HttpServerConnection. Every stream is converted to
+ * http::Request and is passed to the same AbstractRequestHandler the connection uses for HTTP/1.x.
+ * So, the handlers work unchanged. The request body is delivered with WritableMessageBody,
+ * the response body read from AbstractMsgBodySource is sent as the peer's flow-control window
+ * allows.
+ *
+ * The requests are presented to the handlers as HTTP/1.1 ones. RequestContext::conn is empty
+ * since the connection is shared by many requests and cannot be taken by a handler. So,
+ * tunneling and protocol upgrade are not available over HTTP/2.
+ *
+ * Bound to the aio thread of the connection. Instantiated and driven by HttpServerConnection.
+ */
+class NX_NETWORK_API ServerSession:
+    public aio::BasicPollable,
+    public Session,
+    public std::enable_shared_from_this<ServerSession>
+{
+    using base_type = aio::BasicPollable;
+
+public:
+    ServerSession(
+        HttpServerConnection* connection,
+        AbstractRequestHandler* requestHandler,
+        SessionSettings settings = {});
+    ~ServerSession();
+
+    virtual void bindToAioThread(aio::AbstractAioThread* aioThread) override;
+
+    void processReceivedData(const nx::Buffer& data);
+
+    /**
+     * Must be invoked when the connection is closed. Every request being processed is aborted.
+     */
+    void onConnectionClosed(SystemError::ErrorCode reason);
+
+protected:
+    virtual void stopWhileInAioThread() override;
+
+    virtual void onStreamHeaders(
+        std::uint32_t streamId, HeaderList headers, bool endStream) override;
+    virtual void onStreamData(std::uint32_t streamId, nx::Buffer data, bool endStream) override;
+    virtual void onStreamReset(std::uint32_t streamId, ErrorCode errorCode) override;
+    virtual void onStreamWritable(std::uint32_t streamId) override;
+    virtual void onTerminated(ErrorCode errorCode) override;
+    virtual void sendBytes(nx::Buffer data) override;
+
+private:
+    using clock_type = std::chrono::steady_clock;
+
+    struct Stream
+    {
+        RequestLine requestLine;
+        clock_type::time_point requestReceivedTime;
+        std::shared_ptr<MessageBodyWriter> requestBodyWriter;
+        std::unique_ptr<AbstractMsgBodySource> responseBody;
+        std::optional<ChunkedStreamParser> chunkedBodyParser;
+        bool isResponseSent = false;
+    };
+
+    HttpServerConnection* m_connection = nullptr;
+    AbstractRequestHandler* m_requestHandler = nullptr;
+    std::map<std::uint32_t, Stream> m_streams;
+    SystemError::ErrorCode m_closeReason = SystemError::connectionReset;
+
+    /**
+     * @return Nothing if the header list is not a valid request.
+     */
+    std::optional<Request> buildRequest(HeaderList headers);
+
+    void processRequest(std::uint32_t streamId, Request request, bool endStream);
+    void sendResponse(std::uint32_t streamId, RequestResult result);
+    HeaderList buildResponseHeaders(const Response& response);
+    void readMoreResponseBody(std::uint32_t streamId);
+
+    void onSomeResponseBodyRead(
+        std::uint32_t streamId, SystemError::ErrorCode resultCode, nx::Buffer data);
+
+    void eraseStreamIfDone(std::uint32_t streamId);
+};
+
+} // namespace nx::network::http::http2
@@ -0,0 +1,869 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "session.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <nx/utils/log/log.h>
+
+namespace nx::network::http::http2 {
+
+Session::Session(Role role, SessionSettings settings):
+    m_role(role),
+    m_settings(settings),
+    m_connectionWindowSize(std::min<std::int64_t>(
+        (std::int64_t) settings.initialWindowSize
+            * std::max<std::uint32_t>(1, settings.maxConcurrentStreams / 4),
+        kMaxWindowSize)),
+    m_nextStreamId(role == Role::client ? 1 : 2)
+{
+    m_frameReader.setMaxFrameSize(m_settings.maxFrameSize);
+    m_decoder.setMaxHeaderListSize(m_settings.maxHeaderListSize);
+}
+
+Session::~Session() = default;
+
+void Session::start()
+{
+    if (m_role == Role::client)
+        m_sendBuffer.append(kConnectionPreface);
+
+    nx::Buffer settings;
+    const auto addSetting =
+        [&settings](SettingId id, std::uint32_t value)
+        {
+            appendUint16((std::uint16_t) id, &settings);
+            appendUint32(value, &settings);
+        };
+
+    addSetting(SettingId::maxConcurrentStreams, m_settings.maxConcurrentStreams);
+    addSetting(SettingId::initialWindowSize, m_settings.initialWindowSize);
+    addSetting(SettingId::maxFrameSize, m_settings.maxFrameSize);
+    addSetting(SettingId::maxHeaderListSize, m_settings.maxHeaderListSize);
+    if (m_role == Role::client)
+        addSetting(SettingId::enablePush, 0);
+    enqueueFrame(FrameType::settings, 0, 0, settings);
+
+    // The connection window cannot be changed with SETTINGS.
+    m_connectionReceiveWindow = m_connectionWindowSize;
+    if (m_connectionWindowSize > kDefaultInitialWindowSize)
+    {
+        nx::Buffer increment;
+        appendUint32(m_connectionWindowSize - kDefaultInitialWindowSize, &increment);
+        enqueueFrame(FrameType::windowUpdate, 0, 0, increment);
+    }
+
+    flush();
+}
+
+void Session::processReceivedData(const char* data, std::size_t size)
+{
+    if (m_isTerminated)
+        return;
+
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+
+    if (m_role == Role::server && !processPreface(&data, &size))
+        return;
+
+    m_frameReader.feed(data, size);
+    while (!m_isTerminated)
+    {
+        auto frame = m_frameReader.read();
+        if (!frame)
+        {
+            if (m_frameReader.frameTooLarge())
+                failConnection(ErrorCode::frameSizeError, "Frame is too large");
+            break;
+        }
+
+        processFrame(std::move(*frame));
+        if (watcher.interrupted())
+            return;
+    }
+
+    if (!m_isTerminated)
+        flush();
+}
+
+void Session::onBytesSent(std::size_t size)
+{
+    NX_ASSERT(size <= m_unsentBytes, nx::format("%1 > %2", size, m_unsentBytes));
+    m_unsentBytes -= std::min(size, m_unsentBytes);
+
+    if (!m_isTerminated)
+        sendPendingData();
+}
+
+std::uint32_t Session::startStream(const HeaderList& headers, bool endStream)
+{
+    NX_ASSERT(m_role == Role::client);
+
+    if (!canStartStream())
+        return 0;
+
+    const auto streamId = m_nextStreamId;
+    m_nextStreamId += 2;
+
+    auto& stream = m_streams[streamId];
+    stream.sendWindow = m_peerSettings.initialWindowSize;
+    stream.receiveWindow = m_settings.initialWindowSize;
+    stream.isLocalClosed = endStream;
+
+    sendHeaderBlock(streamId, headers, endStream);
+    flush();
+    return streamId;
+}
+
+void Session::submitHeaders(std::uint32_t streamId, const HeaderList& headers, bool endStream)
+{
+    if (m_isTerminated)
+        return;
+
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end() || !NX_ASSERT(!it->second.isLocalClosed))
+        return;
+
+    sendHeaderBlock(streamId, headers, endStream);
+    if (endStream)
+    {
+        it->second.isLocalClosed = true;
+        eraseStreamIfClosed(streamId);
+    }
+
+    flush();
+}
+
+void Session::submitData(std::uint32_t streamId, nx::Buffer data, bool endStream)
+{
+    if (m_isTerminated)
+        return;
+
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end() || !NX_ASSERT(!it->second.isLocalClosed))
+        return;
+
+    auto& stream = it->second;
+    stream.pendingData.append(data.data(), data.size());
+    stream.isEndStreamPending = stream.isEndStreamPending || endStream;
+    stream.isWritableReportPending = !stream.isEndStreamPending;
+
+    sendPendingData();
+}
+
+void Session::resetStream(std::uint32_t streamId, ErrorCode errorCode)
+{
+    if (m_isTerminated || m_streams.erase(streamId) == 0)
+        return;
+
+    nx::Buffer payload;
+    appendUint32((std::uint32_t) errorCode, &payload);
+    enqueueFrame(FrameType::rstStream, 0, streamId, payload);
+    flush();
+
+    terminateIfDone();
+}
+
+void Session::goAway(ErrorCode errorCode)
+{
+    if (m_isTerminated || m_isGoAwaySent)
+        return;
+
+    sendGoAway(errorCode);
+    flush();
+
+    terminateIfDone();
+}
+
+void Session::terminate(ErrorCode errorCode)
+{
+    if (m_isTerminated)
+        return;
+
+    m_isTerminated = true;
+    m_sendBuffer.clear();
+
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    for (const auto& [streamId, stream]: std::exchange(m_streams, {}))
+    {
+        onStreamReset(streamId, errorCode);
+        if (watcher.interrupted())
+            return;
+    }
+}
+
+bool Session::isTerminated() const
+{
+    return m_isTerminated;
+}
+
+bool Session::canStartStream() const
+{
+    return !m_isTerminated
+        && !m_isGoAwayReceived
+        && !m_isGoAwaySent
+        && m_nextStreamId <= kMaxWindowSize
+        && m_streams.size() < m_peerSettings.maxConcurrentStreams;
+}
+
+std::size_t Session::streamCount() const
+{
+    return m_streams.size();
+}
+
+bool Session::hasUnsentData() const
+{
+    return m_unsentBytes > 0 || !m_sendBuffer.empty();
+}
+
+bool Session::processPreface(const char** data, std::size_t* size)
+{
+    if (m_prefaceBytesReceived == kConnectionPreface.size())
+        return true;
+
+    const auto bytesToCompare =
+        std::min(*size, kConnectionPreface.size() - m_prefaceBytesReceived);
+    if (std::string_view(*data, bytesToCompare) !=
+        kConnectionPreface.substr(m_prefaceBytesReceived, bytesToCompare))
+    {
+        return failConnection(ErrorCode::protocolError, "Invalid connection preface");
+    }
+
+    m_prefaceBytesReceived += bytesToCompare;
+    *data += bytesToCompare;
+    *size -= bytesToCompare;
+    return true;
+}
+
+bool Session::processFrame(Frame frame)
+{
+    if (m_headerBlock && frame.type != FrameType::continuation)
+        return failConnection(ErrorCode::protocolError, "CONTINUATION expected");
+
+    if (!m_isSettingsReceived && frame.type != FrameType::settings)
+        return failConnection(ErrorCode::protocolError, "SETTINGS expected");
+
+    switch (frame.type)
+    {
+        case FrameType::data:
+            return processData(frame);
+
+        case FrameType::headers:
+            return processHeaders(frame);
+
+        case FrameType::priority:
+            if (frame.streamId == 0)
+                return failConnection(ErrorCode::protocolError, "PRIORITY on stream 0");
+            if (frame.payload.size() != 5)
+                return failStream(frame.streamId, ErrorCode::frameSizeError, "Invalid PRIORITY");
+            return true;
+
+        case FrameType::rstStream:
+            return processRstStream(frame);
+
+        case FrameType::settings:
+            return processSettings(frame);
+
+        case FrameType::pushPromise:
+            // The client disables server push, the server never receives PUSH_PROMISE.
+            return failConnection(ErrorCode::protocolError, "Unexpected PUSH_PROMISE");
+
+        case FrameType::ping:
+            return processPing(frame);
+
+        case FrameType::goAway:
+            return processGoAway(frame);
+
+        case FrameType::windowUpdate:
+            return processWindowUpdate(frame);
+
+        case FrameType::continuation:
+            return processContinuation(frame);
+    }
+
+    // RFC 7540, 4.1: Frames of unknown types are ignored.
+    return true;
+}
+
+bool Session::processData(Frame& frame)
+{
+    if (frame.streamId == 0)
+        return failConnection(ErrorCode::protocolError, "DATA on stream 0");
+
+    // The padding is subject to the flow control too.
+    const auto flowControlledSize = (std::int64_t) frame.payload.size();
+    if (flowControlledSize > m_connectionReceiveWindow)
+        return failConnection(ErrorCode::flowControlError, "Connection window exceeded");
+    m_connectionReceiveWindow -= flowControlledSize;
+    replenishReceiveWindow(0);
+
+    if (!stripPadding(&frame))
+        return failConnection(ErrorCode::protocolError, "Invalid DATA padding");
+
+    auto it = m_streams.find(frame.streamId);
+    if (it == m_streams.end() || it->second.isRemoteClosed)
+    {
+        if (isIdle(frame.streamId))
+            return failConnection(ErrorCode::protocolError, "DATA on idle stream");
+        return failStream(frame.streamId, ErrorCode::streamClosed, "DATA on closed stream");
+    }
+
+    auto& stream = it->second;
+    if (flowControlledSize > stream.receiveWindow)
+        return failStream(frame.streamId, ErrorCode::flowControlError, "Stream window exceeded");
+    stream.receiveWindow -= flowControlledSize;
+
+    const bool endStream = frame.hasFlag(FrameFlag::endStream);
+    if (endStream)
+        stream.isRemoteClosed = true;
+    else
+        replenishReceiveWindow(frame.streamId);
+
+    if (frame.payload.empty() && !endStream)
+        return true;
+
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    onStreamData(frame.streamId, std::move(frame.payload), endStream);
+    if (watcher.interrupted())
+        return false;
+
+    if (endStream)
+        eraseStreamIfClosed(frame.streamId);
+    return !m_isTerminated;
+}
+
+bool Session::processHeaders(Frame& frame)
+{
+    if (frame.streamId == 0)
+        return failConnection(ErrorCode::protocolError, "HEADERS on stream 0");
+
+    if (!stripPadding(&frame))
+        return failConnection(ErrorCode::protocolError, "Invalid HEADERS padding");
+
+    if (frame.hasFlag(FrameFlag::priority))
+    {
+        static constexpr std::size_t kPrioritySize = 5;
+        if (frame.payload.size() < kPrioritySize)
+            return failConnection(ErrorCode::frameSizeError, "Invalid HEADERS priority");
+        frame.payload.erase(0, kPrioritySize);
+    }
+
+    m_headerBlock = HeaderBlock{
+        frame.streamId, frame.hasFlag(FrameFlag::endStream), std::move(frame.payload)};
+
+    if (!frame.hasFlag(FrameFlag::endHeaders))
+        return true;
+
+    return processHeaderBlock();
+}
+
+bool Session::processContinuation(Frame& frame)
+{
+    if (!m_headerBlock || m_headerBlock->streamId != frame.streamId)
+        return failConnection(ErrorCode::protocolError, "Unexpected CONTINUATION");
+
+    m_headerBlock->data.append(frame.payload.data(), frame.payload.size());
+    // An encoded block is never larger than the header list it represents.
+    if (m_headerBlock->data.size() > m_settings.maxHeaderListSize)
+        return failConnection(ErrorCode::enhanceYourCalm, "Header block is too large");
+
+    if (!frame.hasFlag(FrameFlag::endHeaders))
+        return true;
+
+    return processHeaderBlock();
+}
+
+bool Session::processHeaderBlock()
+{
+    const auto block = std::exchange(m_headerBlock, std::nullopt);
+
+    // The block is decoded even if the stream is rejected to keep the dynamic table in sync.
+    HeaderList headers;
+    if (!m_decoder.decode(block->data, &headers))
+        return failConnection(ErrorCode::compressionError, "Invalid header block");
+
+    const auto streamId = block->streamId;
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end())
+    {
+        if (!isIdle(streamId))
+            return failStream(streamId, ErrorCode::streamClosed, "HEADERS on closed stream");
+        if (m_role == Role::client)
+            return failConnection(ErrorCode::protocolError, "HEADERS on idle stream");
+
+        m_lastPeerStreamId = streamId;
+        if (m_isGoAwaySent)
+            return true; //< RFC 7540, 6.8: Streams initiated after GOAWAY are ignored.
+
+        if (peerInitiatedStreamCount() >= m_settings.maxConcurrentStreams)
+            return failStream(streamId, ErrorCode::refusedStream, "Too many streams");
+
+        it = m_streams.emplace(streamId, Stream()).first;
+        it->second.sendWindow = m_peerSettings.initialWindowSize;
+        it->second.receiveWindow = m_settings.initialWindowSize;
+    }
+    else if (it->second.isRemoteClosed)
+    {
+        return failStream(streamId, ErrorCode::streamClosed, "HEADERS on closed stream");
+    }
+
+    if (block->endStream)
+        it->second.isRemoteClosed = true;
+
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    onStreamHeaders(streamId, std::move(headers), block->endStream);
+    if (watcher.interrupted())
+        return false;
+
+    if (block->endStream)
+        eraseStreamIfClosed(streamId);
+    return !m_isTerminated;
+}
+
+bool Session::processRstStream(const Frame& frame)
+{
+    if (frame.streamId == 0)
+        return failConnection(ErrorCode::protocolError, "RST_STREAM on stream 0");
+    if (frame.payload.size() != 4)
+        return failConnection(ErrorCode::frameSizeError, "Invalid RST_STREAM");
+    if (isIdle(frame.streamId))
+        return failConnection(ErrorCode::protocolError, "RST_STREAM on idle stream");
+
+    if (m_streams.erase(frame.streamId) == 0)
+        return true;
+
+    const auto errorCode = (ErrorCode) readUint32(frame.payload.data());
+    NX_VERBOSE(this, "Stream %1 is reset by the peer with %2",
+        frame.streamId, toString(errorCode));
+
+    if (!reportStreamReset(frame.streamId, errorCode))
+        return false;
+
+    terminateIfDone();
+    return !m_isTerminated;
+}
+
+bool Session::processSettings(const Frame& frame)
+{
+    static constexpr std::size_t kSettingSize = 6;
+
+    if (frame.streamId != 0)
+        return failConnection(ErrorCode::protocolError, "SETTINGS on a stream");
+
+    if (frame.hasFlag(FrameFlag::ack))
+    {
+        if (!frame.payload.empty())
+            return failConnection(ErrorCode::frameSizeError, "Invalid SETTINGS ACK");
+        return true;
+    }
+
+    if (frame.payload.size() % kSettingSize != 0)
+        return failConnection(ErrorCode::frameSizeError, "Invalid SETTINGS");
+
+    m_isSettingsReceived = true;
+
+    for (std::size_t pos = 0; pos < frame.payload.size(); pos += kSettingSize)
+    {
+        const auto id = (SettingId) readUint16(frame.payload.data() + pos);
+        const auto value = readUint32(frame.payload.data() + pos + 2);
+
+        switch (id)
+        {
+            case SettingId::headerTableSize:
+            {
+                // The encoder may use any table size up to the one announced by the peer.
+                const auto size = std::min<std::size_t>(value, kDefaultHeaderTableSize);
+                if (size != m_encoder.dynamicTable().maxSize())
+                    m_encoder.setMaxTableSize(size);
+                break;
+            }
+
+            case SettingId::enablePush:
+                if (value > 1)
+                    return failConnection(ErrorCode::protocolError, "Invalid ENABLE_PUSH");
+                break;
+
+            case SettingId::maxConcurrentStreams:
+                m_peerSettings.maxConcurrentStreams = value;
+                break;
+
+            case SettingId::initialWindowSize:
+            {
+                if (value > kMaxWindowSize)
+                    return failConnection(ErrorCode::flowControlError, "Invalid window size");
+
+                // RFC 7540, 6.9.2: The change affects the windows of all open streams.
+                const std::int64_t delta =
+                    (std::int64_t) value - m_peerSettings.initialWindowSize;
+                for (auto& [streamId, stream]: m_streams)
+                {
+                    stream.sendWindow += delta;
+                    if (stream.sendWindow > kMaxWindowSize)
+                        return failConnection(ErrorCode::flowControlError, "Window overflow");
+                }
+                m_peerSettings.initialWindowSize = value;
+                break;
+            }
+
+            case SettingId::maxFrameSize:
+                if (value < kDefaultMaxFrameSize || value > kMaxAllowedFrameSize)
+                    return failConnection(ErrorCode::protocolError, "Invalid MAX_FRAME_SIZE");
+                m_peerSettings.maxFrameSize = value;
+                break;
+
+            default:
+                // MAX_HEADER_LIST_SIZE is advisory. Unknown settings are ignored.
+                break;
+        }
+    }
+
+    enqueueFrame(FrameType::settings, FrameFlag::ack, 0, {});
+    return sendPendingData();
+}
+
+bool Session::processPing(const Frame& frame)
+{
+    if (frame.streamId != 0)
+        return failConnection(ErrorCode::protocolError, "PING on a stream");
+    if (frame.payload.size() != 8)
+        return failConnection(ErrorCode::frameSizeError, "Invalid PING");
+
+    if (!frame.hasFlag(FrameFlag::ack))
+        enqueueFrame(FrameType::ping, FrameFlag::ack, 0, frame.payload);
+    return true;
+}
+
+bool Session::processGoAway(const Frame& frame)
+{
+    if (frame.streamId != 0)
+        return failConnection(ErrorCode::protocolError, "GOAWAY on a stream");
+    if (frame.payload.size() < 8)
+        return failConnection(ErrorCode::frameSizeError, "Invalid GOAWAY");
+
+    const auto lastStreamId = readUint32(frame.payload.data()) & kMaxWindowSize;
+    const auto errorCode = (ErrorCode) readUint32(frame.payload.data() + 4);
+    NX_DEBUG(this, "GOAWAY received. Last stream %1, error %2", lastStreamId, toString(errorCode));
+
+    m_isGoAwayReceived = true;
+
+    // The streams started by this side after lastStreamId have not been processed by the peer.
+    std::vector<std::uint32_t> refusedStreams;
+    for (const auto& [streamId, stream]: m_streams)
+    {
+        if (!isPeerInitiated(streamId) && streamId > lastStreamId)
+            refusedStreams.push_back(streamId);
+    }
+
+    for (const auto streamId: refusedStreams)
+    {
+        m_streams.erase(streamId);
+        if (!reportStreamReset(streamId, ErrorCode::refusedStream))
+            return false;
+    }
+
+    terminateIfDone();
+    return !m_isTerminated;
+}
+
+bool Session::processWindowUpdate(const Frame& frame)
+{
+    if (frame.payload.size() != 4)
+        return failConnection(ErrorCode::frameSizeError, "Invalid WINDOW_UPDATE");
+
+    const std::int64_t increment = readUint32(frame.payload.data()) & kMaxWindowSize;
+
+    if (frame.streamId == 0)
+    {
+        if (increment == 0)
+            return failConnection(ErrorCode::protocolError, "Zero WINDOW_UPDATE");
+        m_connectionSendWindow += increment;
+        if (m_connectionSendWindow > kMaxWindowSize)
+            return failConnection(ErrorCode::flowControlError, "Connection window overflow");
+    }
+    else
+    {
+        auto it = m_streams.find(frame.streamId);
+        if (it == m_streams.end())
+        {
+            if (isIdle(frame.streamId))
+                return failConnection(ErrorCode::protocolError, "WINDOW_UPDATE on idle stream");
+            return true;
+        }
+
+        if (increment == 0)
+            return failStream(frame.streamId, ErrorCode::protocolError, "Zero WINDOW_UPDATE");
+        it->second.sendWindow += increment;
+        if (it->second.sendWindow > kMaxWindowSize)
+            return failStream(frame.streamId, ErrorCode::flowControlError, "Window overflow");
+    }
+
+    return sendPendingData();
+}
+
+bool Session::stripPadding(Frame* frame)
+{
+    if (!frame->hasFlag(FrameFlag::padded))
+        return true;
+
+    if (frame->payload.empty())
+        return false;
+
+    const std::size_t paddingLength = (std::uint8_t) frame->payload[0];
+    if (paddingLength >= frame->payload.size())
+        return false;
+
+    frame->payload.erase(0, 1);
+    frame->payload.resize(frame->payload.size() - paddingLength);
+    return true;
+}
+
+bool Session::isIdle(std::uint32_t streamId) const
+{
+    return isPeerInitiated(streamId)
+        ? streamId > m_lastPeerStreamId
+        : streamId >= m_nextStreamId;
+}
+
+bool Session::isPeerInitiated(std::uint32_t streamId) const
+{
+    // Clients use odd stream ids.
+    return (m_role == Role::server) == ((streamId & 1) == 1);
+}
+
+std::size_t Session::peerInitiatedStreamCount() const
+{
+    return std::count_if(
+        m_streams.begin(), m_streams.end(),
+        [this](const auto& value) { return isPeerInitiated(value.first); });
+}
+
+void Session::replenishReceiveWindow(std::uint32_t streamId)
+{
+    std::int64_t* window = &m_connectionReceiveWindow;
+    std::int64_t windowSize = m_connectionWindowSize;
+    if (streamId != 0)
+    {
+        auto it = m_streams.find(streamId);
+        if (it == m_streams.end())
+            return;
+        window = &it->second.receiveWindow;
+        windowSize = m_settings.initialWindowSize;
+    }
+
+    // Not sending WINDOW_UPDATE for every frame.
+    const auto consumed = windowSize - *window;
+    if (consumed < windowSize / 2)
+        return;
+
+    *window = windowSize;
+    nx::Buffer increment;
+    appendUint32((std::uint32_t) consumed, &increment);
+    enqueueFrame(FrameType::windowUpdate, 0, streamId, increment);
+}
+
+void Session::eraseStreamIfClosed(std::uint32_t streamId)
+{
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end() || !it->second.isLocalClosed || !it->second.isRemoteClosed)
+        return;
+
+    m_streams.erase(it);
+    terminateIfDone();
+}
+
+bool Session::sendPendingData()
+{
+    const auto hasDataToSend =
+        [this](const Stream& stream)
+        {
+            if (stream.pendingData.empty())
+                return stream.isEndStreamPending;
+            return stream.sendWindow > 0 && m_connectionSendWindow > 0;
+        };
+
+    std::vector<std::uint32_t> writableStreams;
+    std::vector<std::uint32_t> closedStreams;
+    while (!m_streams.empty() && m_unsentBytes + m_sendBuffer.size() < kMaxUnsentBytes)
+    {
+        // Round-robin, starting with the stream following the last one served.
+        auto it = m_streams.upper_bound(m_lastSentDataStreamId);
+        std::size_t streamsChecked = 0;
+        for (; streamsChecked < m_streams.size(); ++streamsChecked, ++it)
+        {
+            if (it == m_streams.end())
+                it = m_streams.begin();
+            if (hasDataToSend(it->second))
+                break;
+        }
+        if (streamsChecked == m_streams.size())
+            break;
+
+        auto& [streamId, stream] = *it;
+        const auto size = std::min<std::int64_t>({
+            (std::int64_t) stream.pendingData.size(),
+            stream.sendWindow,
+            m_connectionSendWindow,
+            (std::int64_t) m_peerSettings.maxFrameSize});
+        const bool endStream =
+            stream.isEndStreamPending && size == (std::int64_t) stream.pendingData.size();
+
+        enqueueFrame(
+            FrameType::data,
+            endStream ? FrameFlag::endStream : 0,
+            streamId,
+            std::string_view(stream.pendingData.data(), size));
+        stream.pendingData.erase(0, size);
+        stream.sendWindow -= size;
+        m_connectionSendWindow -= size;
+        m_lastSentDataStreamId = streamId;
+
+        if (endStream)
+        {
+            stream.isEndStreamPending = false;
+            stream.isLocalClosed = true;
+            closedStreams.push_back(streamId);
+        }
+        else if (stream.pendingData.empty() && stream.isWritableReportPending)
+        {
+            stream.isWritableReportPending = false;
+            writableStreams.push_back(streamId);
+        }
+    }
+
+    flush();
+
+    for (const auto streamId: closedStreams)
+        eraseStreamIfClosed(streamId);
+
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    for (const auto streamId: writableStreams)
+    {
+        if (m_isTerminated)
+            return false;
+        if (!m_streams.contains(streamId))
+            continue;
+
+        onStreamWritable(streamId);
+        if (watcher.interrupted())
+            return false;
+    }
+
+    return !m_isTerminated;
+}
+
+void Session::sendHeaderBlock(
+    std::uint32_t streamId, const HeaderList& headers, bool endStream)
+{
+    nx::Buffer block;
+    m_encoder.encode(headers, &block);
+
+    std::string_view remaining = block;
+    auto type = FrameType::headers;
+    do
+    {
+        const auto fragment = remaining.substr(0, m_peerSettings.maxFrameSize);
+        remaining.remove_prefix(fragment.size());
+
+        std::uint8_t flags = remaining.empty() ? FrameFlag::endHeaders : 0;
+        if (type == FrameType::headers && endStream)
+            flags |= FrameFlag::endStream;
+
+        enqueueFrame(type, flags, streamId, fragment);
+        type = FrameType::continuation;
+    }
+    while (!remaining.empty());
+}
+
+void Session::sendGoAway(ErrorCode errorCode)
+{
+    nx::Buffer payload;
+    appendUint32(m_lastPeerStreamId, &payload);
+    appendUint32((std::uint32_t) errorCode, &payload);
+    enqueueFrame(FrameType::goAway, 0, 0, payload);
+    m_isGoAwaySent = true;
+}
+
+void Session::enqueueFrame(
+    FrameType type, std::uint8_t flags, std::uint32_t streamId, std::string_view payload)
+{
+    serializeFrame(type, flags, streamId, payload, &m_sendBuffer);
+}
+
+void Session::flush()
+{
+    if (m_sendBuffer.empty())
+        return;
+
+    m_unsentBytes += m_sendBuffer.size();
+    sendBytes(std::exchange(m_sendBuffer, nx::Buffer()));
+}
+
+bool Session::failConnection(ErrorCode errorCode, const char* reason)
+{
+    NX_DEBUG(this, "Connection error %1: %2", toString(errorCode), reason);
+
+    sendGoAway(errorCode);
+    flush();
+
+    m_isTerminated = true;
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    for (const auto& [streamId, stream]: std::exchange(m_streams, {}))
+    {
+        onStreamReset(streamId, errorCode);
+        if (watcher.interrupted())
+            return false;
+    }
+
+    onTerminated(errorCode);
+    return false;
+}
+
+bool Session::failStream(std::uint32_t streamId, ErrorCode errorCode, const char* reason)
+{
+    NX_DEBUG(this, "Stream %1 error %2: %3", streamId, toString(errorCode), reason);
+
+    nx::Buffer payload;
+    appendUint32((std::uint32_t) errorCode, &payload);
+    enqueueFrame(FrameType::rstStream, 0, streamId, payload);
+
+    if (m_streams.erase(streamId) == 0)
+        return true;
+
+    if (!reportStreamReset(streamId, errorCode))
+        return false;
+
+    terminateIfDone();
+    return !m_isTerminated;
+}
+
+void Session::terminateIfDone()
+{
+    if (m_isTerminated || !(m_isGoAwayReceived || m_isGoAwaySent) || !m_streams.empty())
+        return;
+
+    NX_DEBUG(this, "All streams are done after GOAWAY");
+
+    flush();
+    m_isTerminated = true;
+    onTerminated(ErrorCode::noError);
+}
+
+bool Session::reportStreamReset(std::uint32_t streamId, ErrorCode errorCode)
+{
+    nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+    onStreamReset(streamId, errorCode);
+    return !watcher.interrupted();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool isConnectionSpecificHeader(std::string_view name)
+{
+    static constexpr std::string_view kHeaders[] = {
+        "connection", "keep-alive", "proxy-connection", "transfer-encoding", "upgrade"};
+
+    return std::find(std::begin(kHeaders), std::end(kHeaders), name) != std::end(kHeaders);
+}
+
+} // namespace nx::network::http::http2
@@ -0,0 +1,258 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nx/utils/buffer.h>
+#include <nx/utils/interruption_flag.h>
+
+#include "frame.h"
+#include "hpack.h"
+
+namespace nx::network::http::http2 {
+
+/**
+ * The settings this side of the connection announces to the peer.
+ */
+struct SessionSettings
+{
+    /** The number of concurrent streams the peer may open. */
+    std::uint32_t maxConcurrentStreams = 100;
+
+    /**
+     * The receive window of each stream. The connection receive window is the same multiplied
+     * by maxConcurrentStreams / 4, so that a few streams can receive at full speed simultaneously.
+     */
+    std::uint32_t initialWindowSize = 1024 * 1024;
+
+    std::uint32_t maxFrameSize = kDefaultMaxFrameSize;
+    std::uint32_t maxHeaderListSize = HpackDecoder::kDefaultMaxHeaderListSize;
+};
+
+/**
+ * HTTP/2 (RFC 7540) framing layer shared by the client and the server: the connection preface,
+ * SETTINGS, PING, GOAWAY, header block assembly with HPACK, flow control in both directions and
+ * stream life cycle. Knows nothing about the transport and the HTTP semantics.
+ * Received bytes are passed to processReceivedData(). Bytes to send are reported with sendBytes().
+ * The transport MUST report every sent chunk with onBytesSent() since the amount of unsent data
+ * is limited.
+ *
+ * The received data is delivered to the stream handlers immediately, so the receive windows
+ * are replenished as soon as the data is received. The sending side honors the peer's windows.
+ *
+ * Server push is not supported. PRIORITY is ignored.
+ * NOTE: Not thread-safe.
+ */
+class NX_NETWORK_API Session
+{
+public:
+    enum class Role
+    {
+        client,
+        server,
+    };
+
+    /** The limit of the data passed to sendBytes() but not reported with onBytesSent(). */
+    static constexpr std::size_t kMaxUnsentBytes = 256 * 1024;
+
+    Session(Role role, SessionSettings settings = {});
+    virtual ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    /**
+     * Sends the connection preface (the client) and SETTINGS.
+     */
+    void start();
+
+    void processReceivedData(const char* data, std::size_t size);
+
+    void onBytesSent(std::size_t size);
+
+    /**
+     * Opens a new stream by sending the request headers. Client only.
+     * @return The stream id. 0 if no more streams can be started (see canStartStream()).
+     */
+    std::uint32_t startStream(const HeaderList& headers, bool endStream);
+
+    /**
+     * Sends HEADERS on the stream. The server uses it to send the response header.
+     */
+    void submitHeaders(std::uint32_t streamId, const HeaderList& headers, bool endStream);
+
+    /**
+     * Queues the data to be sent on the stream. The data is sent as the peer's flow-control
+     * windows allow. onStreamWritable() is reported when all of the data has been sent.
+     */
+    void submitData(std::uint32_t streamId, nx::Buffer data, bool endStream);
+
+    /**
+     * Sends RST_STREAM. The stream is forgotten immediately, no events are reported for it.
+     */
+    void resetStream(std::uint32_t streamId, ErrorCode errorCode);
+
+    /**
+     * Sends GOAWAY. The streams already started by the peer are still processed.
+     * The session becomes terminated when there are no streams left.
+     */
+    void goAway(ErrorCode errorCode);
+
+    /**
+     * Terminates the session because of the transport failure. Every open stream is reported
+     * with onStreamReset().
+     */
+    void terminate(ErrorCode errorCode);
+
+    bool isTerminated() const;
+
+    /**
+     * @return true if a new stream can be started: the session is not terminated, GOAWAY has not
+     * been received and the peer's limit on concurrent streams is not reached.
+     */
+    bool canStartStream() const;
+
+    std::size_t streamCount() const;
+
+    bool hasUnsentData() const;
+
+protected:
+    /**
+     * HEADERS received on the stream: a request, a response or trailers.
+     */
+    virtual void onStreamHeaders(std::uint32_t streamId, HeaderList headers, bool endStream) = 0;
+
+    virtual void onStreamData(std::uint32_t streamId, nx::Buffer data, bool endStream) = 0;
+
+    /**
+     * The stream has been reset by the peer or because of the connection failure.
+     * No events are reported on the stream after this.
+     */
+    virtual void onStreamReset(std::uint32_t streamId, ErrorCode errorCode) = 0;
+
+    /**
+     * All data submitted on the stream has been sent.
+     */
+    virtual void onStreamWritable(std::uint32_t /*streamId*/) {}
+
+    /**
+     * The session is terminated. The transport can be closed once every byte passed to
+     * sendBytes() is sent.
+     */
+    virtual void onTerminated(ErrorCode errorCode) = 0;
+
+    virtual void sendBytes(nx::Buffer data) = 0;
+
+private:
+    struct Stream
+    {
+        std::int64_t sendWindow = 0;
+        std::int64_t receiveWindow = 0;
+        nx::Buffer pendingData;
+        bool isEndStreamPending = false;
+        bool isLocalClosed = false;
+        bool isRemoteClosed = false;
+        bool isWritableReportPending = false;
+    };
+
+    struct HeaderBlock
+    {
+        std::uint32_t streamId = 0;
+        bool endStream = false;
+        nx::Buffer data;
+    };
+
+    struct PeerSettings
+    {
+        std::uint32_t maxConcurrentStreams = std::numeric_limits<std::uint32_t>::max();
+        std::uint32_t initialWindowSize = kDefaultInitialWindowSize;
+        std::uint32_t maxFrameSize = kDefaultMaxFrameSize;
+    };
+
+    const Role m_role;
+    const SessionSettings m_settings;
+    const std::int64_t m_connectionWindowSize;
+    PeerSettings m_peerSettings;
+    FrameReader m_frameReader;
+    HpackEncoder m_encoder;
+    HpackDecoder m_decoder;
+    std::size_t m_prefaceBytesReceived = 0;
+    bool m_isSettingsReceived = false;
+    std::optional<HeaderBlock> m_headerBlock;
+    std::map<std::uint32_t, Stream> m_streams;
+    std::uint32_t m_nextStreamId = 0;
+    std::uint32_t m_lastPeerStreamId = 0;
+    std::int64_t m_connectionSendWindow = kDefaultInitialWindowSize;
+    std::int64_t m_connectionReceiveWindow = kDefaultInitialWindowSize;
+    bool m_isGoAwayReceived = false;
+    bool m_isGoAwaySent = false;
+    bool m_isTerminated = false;
+    nx::Buffer m_sendBuffer;
+    std::size_t m_unsentBytes = 0;
+    std::uint32_t m_lastSentDataStreamId = 0;
+    nx::utils::InterruptionFlag m_destructionFlag;
+
+    bool processPreface(const char** data, std::size_t* size);
+    bool processFrame(Frame frame);
+    bool processData(Frame& frame);
+    bool processHeaders(Frame& frame);
+    bool processContinuation(Frame& frame);
+    bool processHeaderBlock();
+    bool processRstStream(const Frame& frame);
+    bool processSettings(const Frame& frame);
+    bool processPing(const Frame& frame);
+    bool processGoAway(const Frame& frame);
+    bool processWindowUpdate(const Frame& frame);
+
+    bool stripPadding(Frame* frame);
+    bool isIdle(std::uint32_t streamId) const;
+    bool isPeerInitiated(std::uint32_t streamId) const;
+    std::size_t peerInitiatedStreamCount() const;
+
+    void replenishReceiveWindow(std::uint32_t streamId);
+    void eraseStreamIfClosed(std::uint32_t streamId);
+
+    /**
+     * @return false if interrupted.
+     */
+    bool sendPendingData();
+    void sendHeaderBlock(std::uint32_t streamId, const HeaderList& headers, bool endStream);
+    void sendGoAway(ErrorCode errorCode);
+    void enqueueFrame(
+        FrameType type, std::uint8_t flags, std::uint32_t streamId, std::string_view payload);
+    void flush();
+
+    /**
+     * Sends GOAWAY and terminates the session.
+     * @return Always false to be used to stop the processing.
+     */
+    bool failConnection(ErrorCode errorCode, const char* reason);
+
+    /**
+     * Resets the stream and tells about that to the peer.
+     * @return Always true since the connection stays alive.
+     */
+    bool failStream(std::uint32_t streamId, ErrorCode errorCode, const char* reason);
+
+    void terminateIfDone();
+
+    /**
+     * @return false if the session has been destroyed or terminated from within a handler.
+     */
+    bool reportStreamReset(std::uint32_t streamId, ErrorCode errorCode);
+};
+
+/**
+ * RFC 7540, 8.1.2.2: These headers are not allowed in HTTP/2.
+ * @param name Lower-case header name.
+ */
+NX_NETWORK_API bool isConnectionSpecificHeader(std::string_view name);
+
+} // namespace nx::network::http::http2
@@ -17,8 +17,10 @@
 #include "auth_cache.h"
 #include "auth_tools.h"
 #include "buffer_source.h"
+#include "content_encoding.h"
 #include "custom_headers.h"
 #include "http_client_message_body_source.h"
+#include "http2/client_connection_pool.h"
 #include "nonce_cache.h"
 
 namespace {
@@ -225,6 +227,26 @@ const Credentials& ClientOptions::credentials() const
     return m_credentials;
 }
 
+void ClientOptions::setHttp2ConnectionPool(http2::ClientConnectionPool* pool)
+{
+    m_http2ConnectionPool = pool;
+}
+
+http2::ClientConnectionPool* ClientOptions::http2ConnectionPool() const
+{
+    return m_http2ConnectionPool;
+}
+
+void ClientOptions::setConnectionCache(ConnectionCache* cache)
+{
+    m_connectionCache = cache;
+}
+
+ConnectionCache* ClientOptions::connectionCache() const
+{
+    return m_connectionCache;
+}
+
 void ClientOptions::assignOptions(const ClientOptions& other)
 {
     *this = other;
@@ -239,6 +261,7 @@ AsyncClient::AsyncClient(ssl::AdapterFunc adapterFunc): m_adapterFunc(std::move(
     ++SocketGlobals::instance().debugCounters().httpClientConnectionCount;
     if (!NX_ASSERT(m_adapterFunc))
         m_adapterFunc = ssl::kDefaultCertificateCheck;
+    m_http2Timer.bindToAioThread(getAioThread());
 }
 
 AsyncClient::AsyncClient(
@@ -257,6 +280,10 @@ AsyncClient::AsyncClient(
 AsyncClient::~AsyncClient()
 {
     NX_VERBOSE(this, "Deleting the instance...");
+    // The HTTP/2 connection is shared, so it may outlive this object.
+    cancelHttp2Request();
+    if (isInSelfAioThread())
+        putConnectionToCacheIfPossible();
     --SocketGlobals::instance().debugCounters().httpClientConnectionCount;
     SocketGlobals::instance().allocationAnalyzer().recordObjectDestruction(this);
 }
@@ -302,6 +329,11 @@ void AsyncClient::bindToAioThread(nx::network::aio::AbstractAioThread* aioThread
         m_messagePipeline->bindToAioThread(aioThread);
     if (m_requestBody)
         m_requestBody->bindToAioThread(aioThread);
+    m_http2Timer.bindToAioThread(aioThread);
+
+    // HTTP/2 connections are shared per aio thread.
+    if (m_http2Connection && m_http2Connection->getAioThread() != aioThread)
+        m_http2Connection.reset();
 }
 
 bool AsyncClient::failed() const
@@ -656,6 +688,9 @@ std::unique_ptr<AbstractMsgBodySource> AsyncClient::takeResponseBodySource()
     NX_VERBOSE(this, "Connection to %1 is taken as response body source",
         m_contentLocationUrl);
 
+    if (!NX_ASSERT(m_messagePipeline, "Not supported for HTTP/2 requests"))
+        return nullptr;
+
     m_state = State::sDone;
 
     // Removing this from "connection closed" event receivers.
@@ -678,11 +713,22 @@ const nx::utils::Url& AsyncClient::contentLocationUrl() const
 
 quint64 AsyncClient::bytesRead() const
 {
+    if (!m_messagePipeline)
+        return m_http2BytesRead;
+
     return m_messagePipeline->totalBytesReceived();
 }
 
 void AsyncClient::stopWhileInAioThread()
 {
+    putConnectionToCacheIfPossible();
+    m_connectionCacheGuard.reset();
+
+    m_http2OperationGuard.reset();
+    cancelHttp2Request();
+    m_http2Connection.reset();
+    m_http2Timer.pleaseStopSync();
+
     m_socket.reset();
     m_messagePipeline.reset();
     m_requestBody.reset();
@@ -704,6 +750,11 @@ void AsyncClient::asyncConnectDone(SystemError::ErrorCode errorCode)
 
     if (errorCode == SystemError::noError)
     {
+        m_connectDuration = m_isConnectionFromCache
+            ? std::chrono::microseconds::zero()
+            : std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_connectStartTime);
+
         NX_VERBOSE(this, "Sending request \"%1\" with body of %2 bytes to %3",
             m_request.requestLine, m_request.messageBody.size(), m_contentLocationUrl);
 
@@ -722,6 +773,7 @@ void AsyncClient::asyncConnectDone(SystemError::ErrorCode errorCode)
 void AsyncClient::sendRequest()
 {
     m_state = State::sSendingRequest;
+    m_isConnectionCacheable = false;
 
     Message msg(MessageType::request);
     *msg.request = m_request;
@@ -897,6 +949,9 @@ void AsyncClient::onMessageEnd()
     }
 
     m_state = State::sDone;
+    m_isConnectionCacheable = m_isPersistentConnection
+        && m_request.requestLine.method != Method::connect
+        && m_response.response->statusLine.statusCode != StatusCode::switchingProtocols;
 
     const auto handlerInvokationResult = emitDone();
     if (handlerInvokationResult != Result::proceed)
@@ -914,6 +969,7 @@ void AsyncClient::onConnectionClosed(SystemError::ErrorCode errorCode)
         toString(m_state), m_contentLocationUrl, SystemError::toString(errorCode));
 
     m_lastSysErrorCode = errorCode;
+    m_isConnectionCacheable = false;
 
     if (m_state == State::sDone)
         return;
@@ -957,7 +1013,11 @@ int AsyncClient::totalRequestsSent() const
 
 void AsyncClient::initiateHttpMessageDelivery()
 {
-    const auto connectionReusePolicy = getConnectionReusePolicy();
+    auto connectionReusePolicy = getConnectionReusePolicy();
+    const bool useHttp2 = isHttp2Applicable(connectionReusePolicy);
+    if (useHttp2)
+        connectionReusePolicy = ConnectionReusePolicy::noReuse;
+
     if (connectionReusePolicy == ConnectionReusePolicy::noReuse)
     {
         m_lastReportedMessageNumber = -1;
@@ -974,30 +1034,41 @@ void AsyncClient::initiateHttpMessageDelivery()
     m_state = State::sInit;
 
     dispatch(
-        [this, connectionReusePolicy]()
+        [this, connectionReusePolicy, useHttp2]()
         {
-            switch (connectionReusePolicy)
-            {
-                case ConnectionReusePolicy::establishedPipeline:
-                    NX_VERBOSE(this, "Sending request %1 (url %2) via reused connection",
-                        m_request.requestLine, m_contentLocationUrl);
-
-                    m_remoteEndpointWithProtocol = endpointWithProtocol(m_contentLocationUrl);
-                    sendRequest();
-                    break;
-
-                case ConnectionReusePolicy::rawConnection:
-                    sendRequestOverExternalConnection();
-                    break;
-
-                case ConnectionReusePolicy::noReuse:
-                    m_messagePipeline.reset();
-                    initiateTcpConnection();
-                    break;
-            }
+            cancelHttp2Request();
+
+            if (useHttp2)
+                initiateHttp2Request();
+            else
+                deliverOverHttp1(connectionReusePolicy);
         });
 }
 
+void AsyncClient::deliverOverHttp1(ConnectionReusePolicy connectionReusePolicy)
+{
+    switch (connectionReusePolicy)
+    {
+        case ConnectionReusePolicy::establishedPipeline:
+            NX_VERBOSE(this, "Sending request %1 (url %2) via reused connection",
+                m_request.requestLine, m_contentLocationUrl);
+
+            m_remoteEndpointWithProtocol = endpointWithProtocol(m_contentLocationUrl);
+            sendRequest();
+            break;
+
+        case ConnectionReusePolicy::rawConnection:
+            sendRequestOverExternalConnection();
+            break;
+
+        case ConnectionReusePolicy::noReuse:
+            putConnectionToCacheIfPossible();
+            m_messagePipeline.reset();
+            initiateTcpConnection();
+            break;
+    }
+}
+
 AsyncClient::ConnectionReusePolicy AsyncClient::getConnectionReusePolicy() const
 {
     if (m_messagePipeline
@@ -1069,6 +1140,71 @@ void AsyncClient::initiateTcpConnection()
     if (remoteAddress.port == 0)
         remoteAddress.port = nx::network::http::defaultPort(isSecureConnection);
 
+    m_isConnectionFromCache = false;
+    m_connectionInfo.reset();
+    if (connectionCache() && !proxyEndpoint())
+    {
+        m_connectionInfo.emplace(
+            ConnectionCache::ConnectionInfo{remoteAddress, isSecureConnection});
+
+        m_state = State::sWaitingConnectToHost;
+        connectionCache()->take(
+            *m_connectionInfo,
+            [this, sharedGuard = m_connectionCacheGuard.sharedGuard(),
+                lookupSequence = ++m_connectionCacheLookupSequence,
+                remoteAddress, isSecureConnection](
+                    std::unique_ptr<AbstractStreamSocket> connection) mutable
+            {
+                // The handler is invoked within the cache's aio thread.
+                const auto lock = sharedGuard->lock();
+                if (!lock)
+                    return;
+
+                post(
+                    [this, lookupSequence, remoteAddress, isSecureConnection,
+                        connection = std::move(connection)]() mutable
+                    {
+                        onCachedConnectionLookupDone(
+                            lookupSequence, remoteAddress, isSecureConnection,
+                            std::move(connection));
+                    });
+            });
+        return;
+    }
+
+    connectToRemoteAddress(remoteAddress, isSecureConnection);
+}
+
+void AsyncClient::onCachedConnectionLookupDone(
+    int lookupSequence,
+    const SocketAddress& remoteAddress,
+    bool isSecureConnection,
+    std::unique_ptr<AbstractStreamSocket> connection)
+{
+    if (lookupSequence != m_connectionCacheLookupSequence)
+        return; //< The request has been replaced.
+
+    if (connection)
+    {
+        connection->bindToAioThread(getAioThread());
+        if (configureSocket(connection.get()))
+        {
+            NX_VERBOSE(this, "Using cached connection to %1. url %2",
+                remoteAddress, m_contentLocationUrl);
+
+            m_socket = std::move(connection);
+            m_isConnectionFromCache = true;
+            return asyncConnectDone(SystemError::noError);
+        }
+    }
+
+    connectToRemoteAddress(remoteAddress, isSecureConnection);
+}
+
+void AsyncClient::connectToRemoteAddress(
+    const SocketAddress& remoteAddress,
+    bool isSecureConnection)
+{
     const int ipVersion =
         (bool) HostAddress(m_contentLocationUrl.host().toStdString()).isPureIpV6()
         ? AF_INET6
@@ -1094,16 +1230,235 @@ void AsyncClient::initiateTcpConnection()
         return post([this, err = SystemError::getLastOSErrorCode()]() { asyncConnectDone(err); });
 
     m_state = State::sWaitingConnectToHost;
+    m_connectStartTime = std::chrono::steady_clock::now();
 
     m_socket->connectAsync(
         remoteAddress,
         [this](auto result) { asyncConnectDone(result); });
 }
 
+bool AsyncClient::isHttp2Applicable(ConnectionReusePolicy connectionReusePolicy) const
+{
+    if (!http2ConnectionPool()
+        || connectionReusePolicy == ConnectionReusePolicy::rawConnection
+        || proxyEndpoint()
+        || m_contentLocationUrl.scheme() != kSecureUrlSchemeName)
+    {
+        return false;
+    }
+
+    // These requests turn the connection into a tunnel.
+    if (m_request.requestLine.method == Method::connect
+        || m_request.headers.find("Upgrade") != m_request.headers.end())
+    {
+        return false;
+    }
+
+    return http2ConnectionPool()->isHttp2Expected(http2Endpoint());
+}
+
+SocketAddress AsyncClient::http2Endpoint() const
+{
+    auto endpoint = nx::network::url::getEndpoint(m_contentLocationUrl);
+    if (endpoint.port == 0)
+        endpoint.port = nx::network::http::defaultPort(/*isSecure*/ true);
+    return endpoint;
+}
+
+void AsyncClient::initiateHttp2Request()
+{
+    putConnectionToCacheIfPossible();
+    m_messagePipeline.reset();
+    m_socket.reset();
+
+    m_state = State::sWaitingConnectToHost;
+
+    if (m_http2Connection && m_http2Connection->canStartStream()
+        && m_http2Connection->remoteEndpoint() == http2Endpoint())
+    {
+        return sendHttp2Request();
+    }
+
+    m_http2Connection.reset();
+    http2ConnectionPool()->getConnection(
+        http2Endpoint(),
+        getAioThread(),
+        [this, sharedGuard = m_http2OperationGuard.sharedGuard(),
+            attemptSequence = m_http2AttemptSequence](
+                SystemError::ErrorCode resultCode,
+                std::shared_ptr<http2::ClientConnection> connection)
+        {
+            if (!sharedGuard->lock())
+                return;
+
+            onHttp2ConnectionReady(attemptSequence, resultCode, std::move(connection));
+        });
+}
+
+void AsyncClient::onHttp2ConnectionReady(
+    int attemptSequence,
+    SystemError::ErrorCode resultCode,
+    std::shared_ptr<http2::ClientConnection> connection)
+{
+    if (attemptSequence != m_http2AttemptSequence)
+        return; //< The request has been cancelled or replaced.
+
+    if (resultCode == SystemError::notImplemented)
+    {
+        NX_VERBOSE(this, "%1 does not support HTTP/2. Falling back to HTTP/1.1",
+            m_contentLocationUrl);
+        return deliverOverHttp1(ConnectionReusePolicy::noReuse);
+    }
+
+    if (resultCode != SystemError::noError)
+    {
+        NX_DEBUG(this, "Failed to establish HTTP/2 connection to %1. %2",
+            m_contentLocationUrl, SystemError::toString(resultCode));
+        return reportConnectionFailure(resultCode);
+    }
+
+    m_http2Connection = std::move(connection);
+    sendHttp2Request();
+}
+
+void AsyncClient::sendHttp2Request()
+{
+    m_state = State::sSendingRequest;
+
+    http2::ClientConnection::RequestHandlers handlers;
+    handlers.onResponse =
+        [this](Response response) { onHttp2Response(std::move(response)); };
+    handlers.onSomeBodyAvailable =
+        [this](nx::Buffer buffer) { onHttp2MessageBody(std::move(buffer)); };
+    handlers.onDone =
+        [this](SystemError::ErrorCode resultCode) { onHttp2RequestDone(resultCode); };
+
+    m_http2BytesRead = 0;
+    m_http2StreamId = m_http2Connection->sendRequest(m_request, std::move(handlers));
+    if (m_http2StreamId == 0)
+    {
+        NX_DEBUG(this, "Failed to start HTTP/2 stream to %1", m_contentLocationUrl);
+        m_http2Connection.reset();
+        return post(
+            [this, attemptSequence = m_http2AttemptSequence]()
+            {
+                if (attemptSequence == m_http2AttemptSequence)
+                    reportConnectionFailure(SystemError::connectionReset);
+            });
+    }
+
+    NX_VERBOSE(this, "Request has been sent to %1 over HTTP/2. %2",
+        m_contentLocationUrl,
+        logTraffic() ? request().toString() : request().requestLine.toString());
+
+    ++m_totalRequestsSentViaCurrentConnection;
+    ++m_totalRequestsSent;
+
+    m_state = State::sReceivingResponse;
+    restartHttp2Timer(timeouts().responseReadTimeout);
+
+    emitRequestHasBeenSent(m_authorizationTried);
+}
+
+void AsyncClient::onHttp2Response(Response response)
+{
+    m_response = Message(MessageType::response);
+    *m_response.response = std::move(response);
+
+    if (isMalformed(*m_response.response))
+    {
+        cancelHttp2Request();
+        m_state = State::sFailed;
+        emitDone();
+        return;
+    }
+
+    NX_VERBOSE(this, "Response headers from %1 has been successfully read: %2",
+        m_contentLocationUrl,
+        nx::utils::trim(
+            logTraffic()
+                ? m_response.response->toString()
+                : m_response.response->statusLine.toString(),
+            "\r\n"));
+
+    if (repeatRequestIfNeeded(*m_response.response))
+        return;
+
+    m_state = State::sResponseReceived;
+    restartHttp2Timer(timeouts().messageBodyReadTimeout);
+    if (emitResponseReceived() != Result::proceed)
+        return;
+
+    if (m_state == State::sResponseReceived)
+        m_state = State::sReadingMessageBody;
+}
+
+void AsyncClient::onHttp2MessageBody(nx::Buffer buffer)
+{
+    NX_VERBOSE(this, "%1 message body bytes have been received from %2",
+        buffer.size(), m_contentLocationUrl);
+
+    m_http2BytesRead += buffer.size();
+    m_responseMessageBody += std::move(buffer);
+    restartHttp2Timer(timeouts().messageBodyReadTimeout);
+
+    emitSomeMessageBodyAvailable();
+}
+
+void AsyncClient::onHttp2RequestDone(SystemError::ErrorCode resultCode)
+{
+    NX_VERBOSE(this, "HTTP/2 request to %1 completed. %2",
+        m_contentLocationUrl, SystemError::toString(resultCode));
+
+    m_http2StreamId = 0;
+    m_http2Timer.cancelSync();
+
+    m_lastSysErrorCode = resultCode;
+    m_state = resultCode == SystemError::noError && m_response.type == MessageType::response
+        ? State::sDone
+        : State::sFailed;
+
+    emitDone();
+}
+
+void AsyncClient::restartHttp2Timer(std::chrono::milliseconds timeout)
+{
+    m_http2Timer.cancelSync();
+    if (timeout == std::chrono::milliseconds::zero())
+        return;
+
+    m_http2Timer.start(timeout, [this]() { onHttp2Timeout(); });
+}
+
+void AsyncClient::onHttp2Timeout()
+{
+    NX_DEBUG(this, "HTTP/2 request to %1 timed out in state %2",
+        m_contentLocationUrl, toString(m_state));
+
+    cancelHttp2Request();
+
+    m_lastSysErrorCode = SystemError::timedOut;
+    m_state = State::sFailed;
+    emitDone();
+}
+
+void AsyncClient::cancelHttp2Request()
+{
+    ++m_http2AttemptSequence;
+    m_http2Timer.cancelSync();
+
+    if (m_http2Connection && m_http2StreamId != 0)
+        m_http2Connection->cancelRequest(std::exchange(m_http2StreamId, 0));
+}
+
 void AsyncClient::stopReading()
 {
     NX_ASSERT(isInSelfAioThread());
 
+    // The response body of an HTTP/2 request is delivered as it arrives.
+    if (!NX_ASSERT(m_messagePipeline, "Not supported for HTTP/2 requests"))
+        return;
+
     m_messagePipeline->stopReadingConnection();
     m_readingCeased = true;
 }
@@ -1300,7 +1655,7 @@ void AsyncClient::prepareRequestHeaders(
             {
                 http::insertOrReplaceHeader(
                     &m_request.headers,
-                    HttpHeader("Accept-Encoding", "gzip"));
+                    HttpHeader("Accept-Encoding", kSupportedContentEncodings));
             }
         }
 
@@ -1427,14 +1782,32 @@ void AsyncClient::setCustomRequestPrepareFunc(CustomRequestPrepareFunc func)
     m_customRequestPrepareFunc = std::move(func);
 }
 
+void AsyncClient::putConnectionToCacheIfPossible()
+{
+    if (!m_isConnectionCacheable || !m_connectionInfo || !m_messagePipeline || !connectionCache())
+        return;
+
+    m_isConnectionCacheable = false;
+
+    auto connection = m_messagePipeline->takeSocket();
+    m_messagePipeline.reset();
+    if (!connection)
+        return;
+
+    NX_VERBOSE(this, "Passing connection to %1 to the cache", m_connectionInfo->addr);
+
+    connectionCache()->put(*m_connectionInfo, std::move(connection), m_connectDuration);
+}
+
 bool AsyncClient::reconnectIfAppropriate()
 {
     // Reconnecting only if persistent connection has been closed by the remote side during
     // the inactivity interval (the period between two requests).
     // Checking that at least one response was successfully received through the connection.
 
+    // A connection from the cache might also have been closed before it was removed from there.
     if ((m_state == State::sSendingRequest || m_state == State::sReceivingResponse) &&
-        m_messageReceivedThroughTheCurrentConnectionCount > 0)
+        (m_messageReceivedThroughTheCurrentConnectionCount > 0 || m_isConnectionFromCache))
     {
         m_messagePipeline.reset();
         initiateHttpMessageDelivery();
@@ -1686,7 +2059,7 @@ AsyncClient::Result AsyncClient::invokeHandler(
     if (m_requestSequence != requestSequenceBak)
         return Result::newRequestScheduled;
 
-    if (!m_socket && !m_messagePipeline)
+    if (!m_socket && !m_messagePipeline && !m_http2Connection)
         return Result::cancelled;
 
     return Result::proceed;
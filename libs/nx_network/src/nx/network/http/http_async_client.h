@@ -10,7 +10,9 @@
 #include <nx/network/abstract_socket.h>
 #include <nx/network/aio/basic_pollable.h>
 #include <nx/network/aio/timer.h>
+#include <nx/network/connection_cache.h>
 #include <nx/reflect/enum_instrument.h>
+#include <nx/utils/async_operation_guard.h>
 #include <nx/utils/interruption_flag.h>
 #include <nx/utils/move_only_func.h>
 #include <nx/utils/url.h>
@@ -21,6 +23,13 @@
 #include "server/abstract_authentication_manager.h"
 #include "server/http_server_connection.h"
 
+namespace nx::network::http::http2 {
+
+class ClientConnection;
+class ClientConnectionPool;
+
+} // namespace nx::network::http::http2
+
 namespace nx::network::http {
 
 /**
@@ -118,6 +127,28 @@ public:
     void setCredentials(const Credentials& credentials);
     const Credentials& credentials() const;
 
+    /**
+     * Enables HTTP/2 for https requests that do not use a proxy. Concurrent requests to the same
+     * server are multiplexed over a connection from the pool. If the server does not support
+     * HTTP/2, then HTTP/1.1 is used.
+     * NOTE: The pool MUST outlive the client. nullptr (the default) disables HTTP/2.
+     * NOTE: CONNECT, protocol upgrade, AsyncClient::takeResponseBodySource() and
+     * AsyncClient::stopReading() are not available for HTTP/2 requests.
+     */
+    void setHttp2ConnectionPool(http2::ClientConnectionPool* pool);
+    http2::ClientConnectionPool* http2ConnectionPool() const;
+
+    /**
+     * Enables reusing idle keep-alive connections between clients for requests that do not use
+     * a proxy. A connection is taken from the cache before connecting. A persistent connection
+     * is passed to the cache when the client is stopped or switches to another server after
+     * the response has been completely read.
+     * NOTE: The cache MUST outlive the client and MUST be shared only by clients with the same
+     * certificate verification (see ConnectionCache). nullptr (the default) disables the reuse.
+     */
+    void setConnectionCache(ConnectionCache* cache);
+    ConnectionCache* connectionCache() const;
+
     void assignOptions(const ClientOptions& other);
 
 private:
@@ -135,6 +166,8 @@ private:
     HttpHeaders m_additionalHeaders;
     bool m_precalculatedAuthorizationDisabled = false;
     int m_maxNumberOfRedirects = 5;
+    http2::ClientConnectionPool* m_http2ConnectionPool = nullptr;
+    ConnectionCache* m_connectionCache = nullptr;
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -453,6 +486,19 @@ private:
     int m_closeHandlerId = -1;
     ssl::AdapterFunc m_adapterFunc;
     std::optional<KeepAliveOptions> m_keepAliveOptions;
+    std::shared_ptr<http2::ClientConnection> m_http2Connection;
+    std::uint32_t m_http2StreamId = 0;
+    int m_http2AttemptSequence = 0;
+    quint64 m_http2BytesRead = 0;
+    nx::network::aio::Timer m_http2Timer;
+    nx::utils::AsyncOperationGuard m_http2OperationGuard;
+    std::optional<ConnectionCache::ConnectionInfo> m_connectionInfo;
+    bool m_isConnectionFromCache = false;
+    bool m_isConnectionCacheable = false;
+    std::chrono::steady_clock::time_point m_connectStartTime;
+    std::chrono::microseconds m_connectDuration = std::chrono::microseconds::zero();
+    int m_connectionCacheLookupSequence = 0;
+    nx::utils::AsyncOperationGuard m_connectionCacheGuard;
 
     virtual void stopWhileInAioThread() override;
 
@@ -473,6 +519,13 @@ private:
     void sendRequestOverExternalConnection();
     bool configureSocket(AbstractStreamSocket* connection);
     void initiateTcpConnection();
+    void connectToRemoteAddress(const SocketAddress& remoteAddress, bool isSecureConnection);
+    void onCachedConnectionLookupDone(
+        int lookupSequence,
+        const SocketAddress& remoteAddress,
+        bool isSecureConnection,
+        std::unique_ptr<AbstractStreamSocket> connection);
+    void putConnectionToCacheIfPossible();
     bool isMalformed(const nx::network::http::Response& response) const;
     bool repeatRequestIfNeeded(const Response& response);
     bool sendRequestToNewLocation(const Response& response);
@@ -483,6 +536,22 @@ private:
     void addBodyToRequest();
     bool isIgnoringCurrentMessage() const;
 
+    void deliverOverHttp1(ConnectionReusePolicy connectionReusePolicy);
+    bool isHttp2Applicable(ConnectionReusePolicy connectionReusePolicy) const;
+    SocketAddress http2Endpoint() const;
+    void initiateHttp2Request();
+    void onHttp2ConnectionReady(
+        int attemptSequence,
+        SystemError::ErrorCode resultCode,
+        std::shared_ptr<http2::ClientConnection> connection);
+    void sendHttp2Request();
+    void onHttp2Response(Response response);
+    void onHttp2MessageBody(nx::Buffer buffer);
+    void onHttp2RequestDone(SystemError::ErrorCode resultCode);
+    void restartHttp2Timer(std::chrono::milliseconds timeout);
+    void onHttp2Timeout();
+    void cancelHttp2Request();
+
     /**
      * @return true, if connected.
      */
@@ -0,0 +1,37 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <nx/network/aio/awaitables.h>
+
+#include "http_async_client.h"
+
+namespace nx::network::http {
+
+/**
+ * Awaitable version of AsyncClient::doRequest. The coroutine is resumed in the client AIO thread
+ * when the request is done; then the result is available via client->failed(),
+ * client->response() and the other AsyncClient methods:
+ * @code{.cpp}
+ * co_await http::doRequest(client.get(), http::Method::get, url);
+ * if (client->failed())
+ *     co_return std::nullopt;
+ * co_return client->fetchMessageBodyBuffer();
+ * @endcode
+ * See nx/network/aio/awaitables.h for the cancellation rules.
+ */
+[[nodiscard]] inline auto doRequest(AsyncClient* client, Method method, nx::utils::Url url)
+{
+    return aio::detail::makeAwaiter<void>(
+        [client, method = std::move(method), url = std::move(url)](auto completion)
+        {
+            client->doRequest(method, url, std::move(completion));
+        });
+}
+
+[[nodiscard]] inline auto doGet(AsyncClient* client, nx::utils::Url url)
+{
+    return doRequest(client, Method::get, std::move(url));
+}
+
+} // namespace nx::network::http
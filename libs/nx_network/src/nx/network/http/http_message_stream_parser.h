@@ -16,6 +16,8 @@ class NX_NETWORK_API HttpMessageStreamParser:
     public nx::utils::bstream::AbstractByteStreamFilter
 {
 public:
+    using nx::utils::bstream::AbstractByteStreamFilter::processData;
+
     virtual bool processData( const nx::ConstBufferRefType& data ) override;
     virtual size_t flush() override;
 
@@ -0,0 +1,327 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "http_message_view.h"
+
+#include <algorithm>
+#include <charconv>
+#include <functional>
+
+#include <nx/utils/std_string_utils.h>
+
+namespace nx::network::http {
+
+static constexpr std::size_t kTypicalHeaderCount = 32;
+
+namespace {
+
+std::string_view trimWhitespace(std::string_view str)
+{
+    const auto isWhitespace = [](char ch) { return ch == ' ' || ch == '\t'; };
+
+    while (!str.empty() && isWhitespace(str.front()))
+        str.remove_prefix(1);
+    while (!str.empty() && isWhitespace(str.back()))
+        str.remove_suffix(1);
+    return str;
+}
+
+bool isEqualCaseInsensitive(const std::string_view& left, const std::string_view& right)
+{
+    return left.size() == right.size() && nx::utils::stricmp(left, right) == 0;
+}
+
+} // namespace
+
+MessageView::MessageView()
+{
+    m_headers.reserve(kTypicalHeaderCount);
+}
+
+MessageView::ParseResult MessageView::parse(
+    const ConstBufferRefType& data,
+    std::size_t* bytesProcessed)
+{
+    clear();
+    *bytesProcessed = 0;
+
+    std::size_t pos = 0;
+    while (pos < data.size() && (data[pos] == '\r' || data[pos] == '\n'))
+        ++pos;
+
+    for (bool isStartLine = true;; isStartLine = false)
+    {
+        const auto lineEnd = data.find('\n', pos);
+        if (lineEnd == std::string_view::npos)
+        {
+            clear();
+            return ParseResult::needMoreData;
+        }
+
+        auto line = data.substr(pos, lineEnd - pos);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        pos = lineEnd + 1;
+
+        if (isStartLine)
+        {
+            if (!parseStartLine(line))
+                break;
+            continue;
+        }
+
+        if (line.empty())
+        {
+            m_source = data.substr(0, pos);
+            *bytesProcessed = pos;
+            return ParseResult::done;
+        }
+
+        if (!parseHeaderLine(line))
+            break;
+    }
+
+    clear();
+    return ParseResult::failed;
+}
+
+void MessageView::clear()
+{
+    m_type = MessageType::none;
+    m_source = {};
+    m_startLine = {};
+    m_method = {};
+    m_requestTarget = {};
+    m_version = {};
+    m_statusCode = StatusCode::undefined;
+    m_reasonPhrase = {};
+    m_headers.clear();
+    m_changedStrings.clear();
+}
+
+MessageType::Value MessageView::type() const
+{
+    return m_type;
+}
+
+std::string_view MessageView::startLine() const
+{
+    return m_startLine;
+}
+
+std::string_view MessageView::method() const
+{
+    return m_method;
+}
+
+std::string_view MessageView::requestTarget() const
+{
+    return m_requestTarget;
+}
+
+std::string_view MessageView::version() const
+{
+    return m_version;
+}
+
+StatusCode::Value MessageView::statusCode() const
+{
+    return m_statusCode;
+}
+
+std::string_view MessageView::reasonPhrase() const
+{
+    return m_reasonPhrase;
+}
+
+const std::vector<HeaderView>& MessageView::headers() const
+{
+    return m_headers;
+}
+
+std::optional<std::string_view> MessageView::header(const std::string_view& name) const
+{
+    for (const auto& header: m_headers)
+    {
+        if (isEqualCaseInsensitive(header.name, name))
+            return header.value;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::uint64_t> MessageView::contentLength() const
+{
+    const auto value = header("Content-Length");
+    if (!value)
+        return std::nullopt;
+
+    std::uint64_t result = 0;
+    const auto end = value->data() + value->size();
+    const auto [ptr, errorCode] = std::from_chars(value->data(), end, result);
+    if (errorCode != std::errc() || ptr != end || value->empty())
+        return std::nullopt;
+
+    return result;
+}
+
+void MessageView::setHeader(const std::string_view& name, const std::string_view& value)
+{
+    auto it = std::find_if(m_headers.begin(), m_headers.end(),
+        [&name](const auto& header) { return isEqualCaseInsensitive(header.name, name); });
+    if (it == m_headers.end())
+    {
+        m_headers.push_back({saveString(name), saveString(value)});
+        return;
+    }
+
+    it->value = saveString(value);
+    m_headers.erase(
+        std::remove_if(std::next(it), m_headers.end(),
+            [&name](const auto& header) { return isEqualCaseInsensitive(header.name, name); }),
+        m_headers.end());
+}
+
+std::size_t MessageView::removeHeader(const std::string_view& name)
+{
+    const auto sizeBefore = m_headers.size();
+    m_headers.erase(
+        std::remove_if(m_headers.begin(), m_headers.end(),
+            [&name](const auto& header) { return isEqualCaseInsensitive(header.name, name); }),
+        m_headers.end());
+    return sizeBefore - m_headers.size();
+}
+
+void MessageView::detach()
+{
+    if (m_source.empty() || m_source.data() == m_ownedSource.data())
+        return;
+
+    m_ownedSource.assign(m_source.data(), m_source.size());
+
+    const auto sourceBegin = m_source.data();
+    const auto sourceEnd = sourceBegin + m_source.size();
+    const auto rebase =
+        [this, sourceBegin, sourceEnd](std::string_view* view)
+        {
+            if (std::less_equal<const char*>()(sourceBegin, view->data())
+                && std::less_equal<const char*>()(view->data() + view->size(), sourceEnd))
+            {
+                *view = std::string_view(
+                    m_ownedSource.data() + (view->data() - sourceBegin), view->size());
+            }
+        };
+
+    rebase(&m_source);
+    rebase(&m_startLine);
+    rebase(&m_method);
+    rebase(&m_requestTarget);
+    rebase(&m_version);
+    rebase(&m_reasonPhrase);
+    for (auto& header: m_headers)
+    {
+        rebase(&header.name);
+        rebase(&header.value);
+    }
+}
+
+void MessageView::serialize(nx::Buffer* dstBuffer) const
+{
+    dstBuffer->append(m_startLine);
+    dstBuffer->append("\r\n");
+    for (const auto& header: m_headers)
+    {
+        dstBuffer->append(header.name);
+        dstBuffer->append(": ");
+        dstBuffer->append(header.value);
+        dstBuffer->append("\r\n");
+    }
+    dstBuffer->append("\r\n");
+}
+
+Message MessageView::toMessage() const
+{
+    Message message(m_type);
+    if (m_type == MessageType::request)
+    {
+        message.request->requestLine.parse(m_startLine);
+    }
+    else if (m_type == MessageType::response)
+    {
+        auto& statusLine = message.response->statusLine;
+        statusLine.version.parse(m_version);
+        statusLine.statusCode = m_statusCode;
+        statusLine.reasonPhrase = m_reasonPhrase;
+    }
+    else
+    {
+        return message;
+    }
+
+    auto& headers = message.headers();
+    for (const auto& header: m_headers)
+        headers.emplace(header.name, header.value);
+
+    return message;
+}
+
+bool MessageView::parseStartLine(const std::string_view& line)
+{
+    const auto firstSpace = line.find(' ');
+    if (firstSpace == std::string_view::npos || firstSpace == 0)
+        return false;
+
+    m_startLine = line;
+    const auto firstToken = line.substr(0, firstSpace);
+    const auto rest = line.substr(firstSpace + 1);
+
+    if (firstToken.find('/') != std::string_view::npos)
+    {
+        // Status line: HTTP-version SP status-code SP [reason-phrase].
+        m_type = MessageType::response;
+        m_version = firstToken;
+
+        const auto statusCodeStr = rest.substr(0, rest.find(' '));
+        int statusCode = 0;
+        const auto end = statusCodeStr.data() + statusCodeStr.size();
+        const auto [ptr, errorCode] = std::from_chars(statusCodeStr.data(), end, statusCode);
+        if (statusCodeStr.empty() || errorCode != std::errc() || ptr != end)
+            return false;
+
+        m_statusCode = static_cast<StatusCode::Value>(statusCode);
+        if (statusCodeStr.size() < rest.size())
+            m_reasonPhrase = rest.substr(statusCodeStr.size() + 1);
+        return true;
+    }
+
+    // Request line: method SP request-target SP HTTP-version.
+    const auto secondSpace = rest.find(' ');
+    if (secondSpace == std::string_view::npos || secondSpace == 0)
+        return false;
+
+    m_type = MessageType::request;
+    m_method = firstToken;
+    m_requestTarget = rest.substr(0, secondSpace);
+    m_version = rest.substr(secondSpace + 1);
+    return m_version.find('/') != std::string_view::npos;
+}
+
+bool MessageView::parseHeaderLine(const std::string_view& line)
+{
+    const auto separatorPos = line.find(':');
+    if (separatorPos == std::string_view::npos)
+        return false;
+
+    const auto name = trimWhitespace(line.substr(0, separatorPos));
+    if (name.empty())
+        return false;
+
+    m_headers.push_back({name, trimWhitespace(line.substr(separatorPos + 1))});
+    return true;
+}
+
+std::string_view MessageView::saveString(const std::string_view& str)
+{
+    return m_changedStrings.emplace_back(str);
+}
+
+} // namespace nx::network::http
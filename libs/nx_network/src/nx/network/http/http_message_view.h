@@ -0,0 +1,132 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nx/utils/buffer.h>
+
+#include "http_types.h"
+
+namespace nx::network::http {
+
+struct HeaderView
+{
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * HTTP message header (start line and header fields) that refers to the buffer it has been
+ * parsed from instead of copying every header name and value as HttpStreamReader does.
+ * Parsing allocates nothing once the header vector has grown to the typical header count,
+ * so the same MessageView should be reused for subsequent messages of a connection.
+ *
+ * Headers changed with setHeader() are the only ones stored in the MessageView itself.
+ * The rest still refer to the source buffer, so the source buffer MUST NOT be modified while
+ * the MessageView is used. Call detach() before the buffer is reused (e.g., before handing
+ * the message over to an asynchronous handler) or toMessage() to get a regular http::Message.
+ *
+ * Only the header is parsed. The message body (if any) starts right after the bytes processed.
+ * NOTE: Lines may be terminated with CRLF or LF.
+ * NOTE: Not thread-safe.
+ */
+class NX_NETWORK_API MessageView
+{
+public:
+    enum class ParseResult
+    {
+        /** The empty line terminating the header has not been found yet. */
+        needMoreData,
+        done,
+        failed,
+    };
+
+    MessageView();
+
+    /**
+     * Parses the message header from the beginning of data. Empty lines before the start line
+     * are skipped.
+     * If ParseResult::needMoreData is returned, the call should be repeated later with more data
+     * (data is parsed from the beginning every time).
+     * @param bytesProcessed Set to the header size (including the terminating empty line)
+     *     on ParseResult::done. Set to 0 otherwise.
+     */
+    ParseResult parse(const ConstBufferRefType& data, std::size_t* bytesProcessed);
+
+    void clear();
+
+    MessageType::Value type() const;
+
+    /** Request or status line without the line ending. */
+    std::string_view startLine() const;
+
+    std::string_view method() const;
+    std::string_view requestTarget() const;
+    std::string_view version() const;
+    StatusCode::Value statusCode() const;
+    std::string_view reasonPhrase() const;
+
+    const std::vector<HeaderView>& headers() const;
+
+    /**
+     * @return The value of the first header named name (case-insensitive).
+     */
+    std::optional<std::string_view> header(const std::string_view& name) const;
+
+    /**
+     * @return Content-Length header value. std::nullopt if not present or invalid.
+     */
+    std::optional<std::uint64_t> contentLength() const;
+
+    /**
+     * Replaces all headers named name with a single one or adds a new one.
+     * The new name and value are the only strings copied.
+     */
+    void setHeader(const std::string_view& name, const std::string_view& value);
+
+    /**
+     * @return The number of headers removed.
+     */
+    std::size_t removeHeader(const std::string_view& name);
+
+    /**
+     * Copies the whole header to a single internal buffer, so that the source buffer
+     * is not referred to anymore.
+     */
+    void detach();
+
+    /**
+     * Appends the header (including the terminating empty line) to dstBuffer
+     * with all changes applied.
+     */
+    void serialize(nx::Buffer* dstBuffer) const;
+
+    Message toMessage() const;
+
+private:
+    MessageType::Value m_type = MessageType::none;
+    std::string_view m_source;
+    std::string_view m_startLine;
+    std::string_view m_method;
+    std::string_view m_requestTarget;
+    std::string_view m_version;
+    StatusCode::Value m_statusCode = StatusCode::undefined;
+    std::string_view m_reasonPhrase;
+    std::vector<HeaderView> m_headers;
+
+    std::string m_ownedSource;
+    // std::deque does not move its elements on insertion, so the views stay valid.
+    std::deque<std::string> m_changedStrings;
+
+    bool parseStartLine(const std::string_view& line);
+    bool parseHeaderLine(const std::string_view& line);
+    std::string_view saveString(const std::string_view& str);
+};
+
+} // namespace nx::network::http
@@ -5,11 +5,12 @@
 #include <algorithm>
 
 #include <nx/utils/byte_stream/custom_output_stream.h>
-#include <nx/utils/gzip/gzip_uncompressor.h>
 #include <nx/utils/log/assert.h>
 #include <nx/utils/log/log_main.h>
 #include <nx/utils/std/cpp14.h>
 
+#include "content_encoding.h"
+
 namespace nx::network::http {
 
 bool HttpStreamReader::parseBytes(
@@ -448,9 +449,7 @@ size_t HttpStreamReader::readIdentityStream(
 std::unique_ptr<nx::utils::bstream::AbstractByteStreamFilter>
     HttpStreamReader::createContentDecoder(const std::string& encodingName)
 {
-    if (encodingName == "gzip" || encodingName == "deflate")
-        return std::make_unique<nx::utils::bstream::gzip::Uncompressor>();
-    return nullptr;
+    return http::createContentDecoder(encodingName);
 }
 
 void HttpStreamReader::resetStateInternal()
@@ -0,0 +1,226 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "multipart_fan_out.h"
+
+#include <set>
+
+#include <nx/utils/byte_stream/custom_output_stream.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::network::http {
+
+struct MultipartFanOutState
+{
+    mutable nx::Mutex mutex;
+    std::set<MultipartFanOutBodySource*> subscribers;
+    std::shared_ptr<const nx::Buffer> lastPart;
+    std::shared_ptr<const nx::Buffer> epilogue;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+MultipartFanOutBodySource::MultipartFanOutBodySource(
+    std::shared_ptr<MultipartFanOutState> state,
+    std::string mimeType)
+    :
+    m_state(std::move(state)),
+    m_mimeType(std::move(mimeType))
+{
+}
+
+MultipartFanOutBodySource::~MultipartFanOutBodySource()
+{
+    unsubscribe();
+}
+
+void MultipartFanOutBodySource::stopWhileInAioThread()
+{
+    base_type::stopWhileInAioThread();
+
+    unsubscribe();
+    m_readHandler = nullptr;
+}
+
+std::string MultipartFanOutBodySource::mimeType() const
+{
+    return m_mimeType;
+}
+
+std::optional<uint64_t> MultipartFanOutBodySource::contentLength() const
+{
+    return std::nullopt;
+}
+
+void MultipartFanOutBodySource::readAsync(CompletionHandler completionHandler)
+{
+    dispatch(
+        [this, completionHandler = std::move(completionHandler)]() mutable
+        {
+            NX_ASSERT(!m_readHandler);
+
+            m_readHandler = std::move(completionHandler);
+            deliverIfReady();
+        });
+}
+
+void MultipartFanOutBodySource::cancelRead()
+{
+    executeInAioThreadSync(
+        [this]()
+        {
+            m_readHandler = nullptr;
+        });
+}
+
+int MultipartFanOutBodySource::skippedPartCount() const
+{
+    return m_skippedPartCount.load();
+}
+
+void MultipartFanOutBodySource::publish(std::shared_ptr<const nx::Buffer> data, bool isEpilogue)
+{
+    // The state mutex is locked, so unsubscribe() waits for this call and the posted call is
+    // cancelled when this object is stopped.
+    post(
+        [this, data = std::move(data), isEpilogue]() mutable
+        {
+            onPublished(std::move(data), isEpilogue);
+        });
+}
+
+void MultipartFanOutBodySource::onPublished(
+    std::shared_ptr<const nx::Buffer> data, bool isEpilogue)
+{
+    if (isEpilogue)
+    {
+        m_epilogue = std::move(data);
+    }
+    else
+    {
+        if (m_pendingPart)
+            ++m_skippedPartCount;
+        m_pendingPart = std::move(data);
+    }
+
+    deliverIfReady();
+}
+
+void MultipartFanOutBodySource::deliverIfReady()
+{
+    if (!m_readHandler)
+        return;
+
+    // The part is copied only when the client is ready to send it, so the skipped parts are not
+    // copied at all.
+    nx::Buffer data;
+    if (m_pendingPart)
+    {
+        data = std::string_view(*std::exchange(m_pendingPart, nullptr));
+    }
+    else if (m_epilogue)
+    {
+        data = std::string_view(*std::exchange(m_epilogue, nullptr));
+        m_epilogueDelivered = true;
+    }
+    else if (!m_epilogueDelivered)
+    {
+        return;
+    }
+    // Otherwise, the empty buffer signals the end of data.
+
+    nx::utils::swapAndCall(m_readHandler, SystemError::noError, std::move(data));
+}
+
+void MultipartFanOutBodySource::unsubscribe()
+{
+    NX_MUTEX_LOCKER lock(&m_state->mutex);
+    m_state->subscribers.erase(this);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+MultipartFanOut::MultipartFanOut(std::string boundary):
+    m_state(std::make_shared<MultipartFanOutState>()),
+    m_serializer(
+        std::move(boundary),
+        nx::utils::bstream::makeCustomOutputStream(
+            [this](const auto& data) { m_serializedData += data; }))
+{
+}
+
+MultipartFanOut::~MultipartFanOut()
+{
+    if (!eof())
+        writeEpilogue();
+}
+
+std::string MultipartFanOut::contentType() const
+{
+    return m_serializer.contentType();
+}
+
+std::unique_ptr<MultipartFanOutBodySource> MultipartFanOut::subscribe()
+{
+    std::unique_ptr<MultipartFanOutBodySource> subscriber(
+        new MultipartFanOutBodySource(m_state, contentType()));
+
+    NX_MUTEX_LOCKER lock(&m_state->mutex);
+
+    if (m_state->lastPart)
+        subscriber->publish(m_state->lastPart, /*isEpilogue*/ false);
+    if (m_state->epilogue)
+        subscriber->publish(m_state->epilogue, /*isEpilogue*/ true);
+    else
+        m_state->subscribers.insert(subscriber.get());
+
+    return subscriber;
+}
+
+std::size_t MultipartFanOut::subscriberCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_state->mutex);
+    return m_state->subscribers.size();
+}
+
+void MultipartFanOut::writeBodyPart(
+    const std::string& contentType,
+    const nx::network::http::HttpHeaders& headers,
+    nx::Buffer data)
+{
+    m_serializer.writeBodyPart(contentType, headers, std::move(data));
+    publish(/*isEpilogue*/ false);
+}
+
+void MultipartFanOut::writeEpilogue()
+{
+    m_serializer.writeEpilogue();
+    publish(/*isEpilogue*/ true);
+}
+
+bool MultipartFanOut::eof() const
+{
+    NX_MUTEX_LOCKER lock(&m_state->mutex);
+    return m_state->epilogue != nullptr;
+}
+
+void MultipartFanOut::publish(bool isEpilogue)
+{
+    auto data = std::make_shared<const nx::Buffer>(std::exchange(m_serializedData, {}));
+
+    NX_MUTEX_LOCKER lock(&m_state->mutex);
+
+    for (auto subscriber: m_state->subscribers)
+        subscriber->publish(data, isEpilogue);
+
+    if (isEpilogue)
+    {
+        m_state->epilogue = std::move(data);
+        m_state->subscribers.clear();
+    }
+    else
+    {
+        m_state->lastPart = std::move(data);
+    }
+}
+
+} // namespace nx::network::http
@@ -0,0 +1,125 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "abstract_msg_body_source.h"
+#include "multipart_body_serializer.h"
+
+namespace nx::network::http {
+
+struct MultipartFanOutState;
+
+/**
+ * Message body of a single client of MultipartFanOut.
+ * Holds at most one serialized part waiting to be read. If a newer part is published before the
+ * client has read the previous one, the previous one is skipped. So, a slow client receives fewer
+ * parts (frames) instead of delaying the others or accumulating data.
+ */
+class NX_NETWORK_API MultipartFanOutBodySource:
+    public AbstractMsgBodySource
+{
+    using base_type = AbstractMsgBodySource;
+
+public:
+    ~MultipartFanOutBodySource();
+
+    virtual void stopWhileInAioThread() override;
+
+    virtual std::string mimeType() const override;
+    virtual std::optional<uint64_t> contentLength() const override;
+
+    virtual void readAsync(CompletionHandler completionHandler) override;
+
+    virtual void cancelRead() override;
+
+    /**
+     * @return The number of parts replaced by the newer ones before being read.
+     */
+    int skippedPartCount() const;
+
+private:
+    friend class MultipartFanOut;
+
+    const std::shared_ptr<MultipartFanOutState> m_state;
+    const std::string m_mimeType;
+    std::shared_ptr<const nx::Buffer> m_pendingPart;
+    std::shared_ptr<const nx::Buffer> m_epilogue;
+    bool m_epilogueDelivered = false;
+    CompletionHandler m_readHandler;
+    std::atomic<int> m_skippedPartCount{0};
+
+    MultipartFanOutBodySource(std::shared_ptr<MultipartFanOutState> state, std::string mimeType);
+
+    /**
+     * Can be called from any thread with MultipartFanOutState::mutex locked.
+     */
+    void publish(std::shared_ptr<const nx::Buffer> data, bool isEpilogue);
+
+    void onPublished(std::shared_ptr<const nx::Buffer> data, bool isEpilogue);
+    void deliverIfReady();
+    void unsubscribe();
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Streams the same HTTP multipart message body (e.g., MJPEG) to many clients.
+ * Unlike MultipartMessageBodySource per client, each part is serialized once, and the serialized
+ * part is shared by all clients until they have sent it. A client that subscribes in the middle of
+ * the stream starts with the most recent part.
+ * NOTE: MultipartFanOut::writeBodyPart and MultipartFanOut::writeEpilogue must not be called
+ * concurrently. Other methods are thread-safe.
+ */
+class NX_NETWORK_API MultipartFanOut
+{
+public:
+    /**
+     * @param boundary Does not contain -- neither in the beginning nor in the end.
+     */
+    MultipartFanOut(std::string boundary);
+
+    /**
+     * Ends the message body of the clients that are still subscribed.
+     */
+    ~MultipartFanOut();
+
+    MultipartFanOut(const MultipartFanOut&) = delete;
+    MultipartFanOut& operator=(const MultipartFanOut&) = delete;
+
+    std::string contentType() const;
+
+    /**
+     * @return Message body to be sent to a new client. The client is unsubscribed when the body
+     * is stopped or destroyed. The body can outlive this object.
+     */
+    std::unique_ptr<MultipartFanOutBodySource> subscribe();
+
+    std::size_t subscriberCount() const;
+
+    /**
+     * Serializes the part (see MultipartBodySerializer::writeBodyPart) and publishes it to all
+     * subscribers.
+     */
+    void writeBodyPart(
+        const std::string& contentType,
+        const nx::network::http::HttpHeaders& headers,
+        nx::Buffer data);
+
+    /** Signal end of multipart body to all subscribers. */
+    void writeEpilogue();
+
+    bool eof() const;
+
+private:
+    std::shared_ptr<MultipartFanOutState> m_state;
+    nx::Buffer m_serializedData;
+    MultipartBodySerializer m_serializer;
+
+    void publish(bool isEpilogue);
+};
+
+} // namespace nx::network::http
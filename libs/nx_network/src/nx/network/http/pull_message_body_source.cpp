@@ -0,0 +1,82 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "pull_message_body_source.h"
+
+#include <nx/utils/log/assert.h>
+
+namespace nx::network::http {
+
+PullMessageBodySource::PullMessageBodySource(std::string mimeType, ReadFunc readFunc):
+    m_mimeType(std::move(mimeType)),
+    m_readFunc(std::move(readFunc))
+{
+}
+
+std::string PullMessageBodySource::mimeType() const
+{
+    return m_mimeType;
+}
+
+std::optional<uint64_t> PullMessageBodySource::contentLength() const
+{
+    return std::nullopt;
+}
+
+void PullMessageBodySource::readAsync(CompletionHandler completionHandler)
+{
+    dispatch(
+        [this, completionHandler = std::move(completionHandler)]() mutable
+        {
+            NX_ASSERT(!m_completionHandler);
+
+            if (m_eof || !m_readFunc)
+            {
+                return post(
+                    [completionHandler = std::move(completionHandler)]()
+                    {
+                        completionHandler(SystemError::noError, nx::Buffer());
+                    });
+            }
+
+            m_completionHandler = std::move(completionHandler);
+            m_readFunc(
+                [this, sharedGuard = m_asyncOperationGuard.sharedGuard()](
+                    SystemError::ErrorCode resultCode, nx::Buffer data) mutable
+                {
+                    const auto lock = sharedGuard->lock();
+                    if (!lock)
+                        return;
+
+                    post(
+                        [this, resultCode, data = std::move(data)]() mutable
+                        {
+                            onDataProduced(resultCode, std::move(data));
+                        });
+                });
+        });
+}
+
+void PullMessageBodySource::stopWhileInAioThread()
+{
+    // Terminating the guard first, so that the producer cannot post after the posted calls
+    // have been cancelled.
+    m_asyncOperationGuard->terminate();
+    base_type::stopWhileInAioThread();
+
+    m_completionHandler = nullptr;
+    m_readFunc = nullptr;
+}
+
+void PullMessageBodySource::onDataProduced(SystemError::ErrorCode resultCode, nx::Buffer data)
+{
+    if (resultCode != SystemError::noError || data.empty())
+    {
+        m_eof = true;
+        m_readFunc = nullptr; //< Releasing the producer as soon as possible.
+    }
+
+    if (m_completionHandler)
+        nx::utils::swapAndCall(m_completionHandler, resultCode, std::move(data));
+}
+
+} // namespace nx::network::http
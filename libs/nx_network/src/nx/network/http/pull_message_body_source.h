@@ -0,0 +1,71 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <string>
+
+#include <nx/utils/async_operation_guard.h>
+
+#include "abstract_msg_body_source.h"
+
+namespace nx::network::http {
+
+/**
+ * Message body source that asks the producer for the next portion of data only when the previous
+ * one has been taken by the reader. This way a slow receiver throttles the producer (e.g., a DB
+ * cursor) instead of the data being accumulated in memory.
+ * The body has no Content-Length, so it is to be sent with the chunked encoding. E.g.,
+ * streaming a query result (nx::sql::StreamingCursor) as the response body:
+ * <pre><code>
+ * std::make_unique<ChunkedBodySource>(std::make_unique<PullMessageBodySource>(
+ *     "application/json",
+ *     [cursor = std::move(cursor)](auto handler) mutable
+ *     {
+ *         cursor->readNextBatch(
+ *             [handler = std::move(handler)](auto resultCode, auto records) mutable
+ *             {
+ *                 handler(resultCode == nx::sql::DBResultCode::ok
+ *                     || resultCode == nx::sql::DBResultCode::endOfData
+ *                         ? SystemError::noError : SystemError::ioError,
+ *                     serialize(records));
+ *             });
+ *     }));
+ * </code></pre>
+ */
+class NX_NETWORK_API PullMessageBodySource:
+    public AbstractMsgBodySource
+{
+    using base_type = AbstractMsgBodySource;
+
+public:
+    /**
+     * Produces the next portion of data. The handler can be invoked in any thread, but exactly
+     * once. Empty buffer signals the end of data.
+     */
+    using ReadFunc = nx::utils::MoveOnlyFunc<void(CompletionHandler)>;
+
+    PullMessageBodySource(std::string mimeType, ReadFunc readFunc);
+
+    virtual std::string mimeType() const override;
+    virtual std::optional<uint64_t> contentLength() const override;
+
+    /**
+     * NOTE: The completion handler is always invoked within this object's AIO thread.
+     */
+    virtual void readAsync(CompletionHandler completionHandler) override;
+
+protected:
+    virtual void stopWhileInAioThread() override;
+
+private:
+    void onDataProduced(SystemError::ErrorCode resultCode, nx::Buffer data);
+
+private:
+    const std::string m_mimeType;
+    ReadFunc m_readFunc;
+    CompletionHandler m_completionHandler;
+    bool m_eof = false;
+    nx::utils::AsyncOperationGuard m_asyncOperationGuard;
+};
+
+} // namespace nx::network::http
@@ -18,6 +18,7 @@ HttpStatistics AggregateStatisticsProvider::httpStatistics() const
     auto stats = m_statsProvider.httpStatistics();
     stats.statuses = m_dispatcher.statusCodesReported();
     stats.requests = m_dispatcher.requestPathStatistics();
+    stats.routes = m_dispatcher.routeStatistics();
     return stats;
 }
 
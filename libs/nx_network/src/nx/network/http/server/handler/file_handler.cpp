@@ -54,6 +54,11 @@ void FileDownloader::processRequest(
         [this](auto&&... args) { onStatCompletion(std::forward<decltype(args)>(args)...); });
 }
 
+void FileDownloader::setZeroCopyEnabled(bool enabled)
+{
+    m_zeroCopyEnabled = enabled;
+}
+
 std::tuple<StatusCode::Value, std::string> FileDownloader::composeFilePath(
     const std::string_view& requestPath)
 {
@@ -105,6 +110,7 @@ void FileDownloader::onOpenFileCompletion(SystemError::ErrorCode resultCode)
         std::exchange(m_file, nullptr),
         m_fileStat);
     body->setReadSize(m_fileReadSize);
+    body->setZeroCopyEnabled(m_zeroCopyEnabled);
 
     RequestResult result(StatusCode::ok);
     result.body = std::move(body);
@@ -33,6 +33,11 @@ public:
         RequestContext requestContext,
         RequestProcessedHandler completionHandler) override;
 
+    /**
+     * See FileBody::setZeroCopyEnabled. Enabled by default.
+     */
+    void setZeroCopyEnabled(bool enabled);
+
 protected:
     std::tuple<StatusCode::Value, std::string> composeFilePath(
         const std::string_view& requestPath);
@@ -46,6 +51,7 @@ private:
     std::unique_ptr<nx::utils::fs::File> m_file;
     RequestProcessedHandler m_completionHandler;
     std::size_t m_fileReadSize = FileBody::kDefaultReadSize;
+    bool m_zeroCopyEnabled = true;
 
     void onStatCompletion(
         SystemError::ErrorCode resultCode,
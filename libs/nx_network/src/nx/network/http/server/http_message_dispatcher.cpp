@@ -97,12 +97,48 @@ std::map<std::string, server::RequestStatistics>
     return stats;
 }
 
+std::map<std::string, server::RouteStatistics> AbstractMessageDispatcher::routeStatistics() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    std::map<std::string, server::RouteStatistics> stats;
+    for (const auto& [route, calculator]: m_routes)
+        stats.emplace(route, calculator->routeStatistics());
+
+    return stats;
+}
+
 void AbstractMessageDispatcher::setLinger(
     std::optional<std::chrono::milliseconds> timeout)
 {
     m_linger = timeout;
 }
 
+void AbstractMessageDispatcher::addRoute(
+    const Method& method,
+    const std::string_view& path,
+    std::shared_ptr<server::RouteStatisticsCalculator> routeStatistics)
+{
+    const auto methodStr = method == Method(kAnyMethod) ? std::string("*") : method.toString();
+    const auto pathStr = path == kAnyPath ? std::string("*") : std::string(path);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_routes[methodStr + " " + pathStr] = std::move(routeStatistics);
+}
+
+void AbstractMessageDispatcher::clearRoutes()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_routes.clear();
+}
+
+std::uint64_t AbstractMessageDispatcher::requestBodySize(const RequestContext& requestContext)
+{
+    if (requestContext.body)
+        return requestContext.body->contentLength().value_or(0);
+    return requestContext.request.messageBody.size();
+}
+
 void AbstractMessageDispatcher::recordDispatchFailure() const
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
@@ -120,6 +120,10 @@ public:
         auto statisticsKey = requestContext.request.requestLine.method.toString() + " " +
             handlerContext->pathTemplate;
 
+        auto routeStatistics = std::move(handlerContext->routeStatistics);
+        if (routeStatistics)
+            routeStatistics->requestStarted(requestBodySize(requestContext));
+
         // NOTE: Cannot capture scoped increment in lambda since the capture variable
         // destruction order is unspecified.
         m_runningRequestCounter->increment();
@@ -134,14 +138,20 @@ public:
             std::move(requestContext),
             [this, handler = std::move(handlerContext->handler), seq,
                 completionFunc = std::move(completionFunc), counter = m_runningRequestCounter,
-                requestProcessStartTime, statisticsKey = std::move(statisticsKey)](
+                requestProcessStartTime, statisticsKey = std::move(statisticsKey),
+                routeStatistics = std::move(routeStatistics)](
                     RequestResult result) mutable
             {
                 using namespace std::chrono;
-                recordStatistics(
-                    result,
-                    statisticsKey,
-                    duration_cast<microseconds>(steady_clock::now() - requestProcessStartTime));
+                const auto processingTime =
+                    duration_cast<microseconds>(steady_clock::now() - requestProcessStartTime);
+                recordStatistics(result, statisticsKey, processingTime);
+                if (routeStatistics)
+                {
+                    routeStatistics->requestCompleted(
+                        processingTime,
+                        result.body ? result.body->contentLength() : std::nullopt);
+                }
 
                 m_activeRequests.erase(seq);
 
@@ -168,6 +178,12 @@ public:
     // included to avoid empty values in statistics reports.
     std::map<std::string, server::RequestStatistics> requestPathStatistics() const;
 
+    /**
+     * @return Statistics of every handler registration accumulated since the registration.
+     * The key is "{method} {path}" as registered. "*" stands for any method or path.
+     */
+    std::map<std::string, server::RouteStatistics> routeStatistics() const;
+
     static constexpr auto kDefaultLinger = std::chrono::seconds(17);
 
     /**
@@ -182,11 +198,23 @@ protected:
     {
         std::unique_ptr<RequestHandlerWithContext> handler;
         std::string pathTemplate;
+        std::shared_ptr<server::RouteStatisticsCalculator> routeStatistics;
     };
 
 protected:
     virtual void applyModRewrite(nx::utils::Url* url) const = 0;
 
+    /**
+     * Makes the statistics of the handler registration available through routeStatistics().
+     * The descendant provides the same calculator in each HandlerContext of the registration.
+     */
+    void addRoute(
+        const Method& method,
+        const std::string_view& path,
+        std::shared_ptr<server::RouteStatisticsCalculator> routeStatistics);
+
+    void clearRoutes();
+
     /**
      * @return HTTP message handler functor that corresponds to the given HTTP method and path.
      */
@@ -195,6 +223,8 @@ protected:
         const std::string& path) const = 0;
 
 private:
+    static std::uint64_t requestBodySize(const RequestContext& requestContext);
+
     void recordDispatchFailure() const;
     void recordStatistics(
         const RequestResult& result,
@@ -215,6 +245,8 @@ private:
         std::string, server::RequestStatisticsCalculator
     > m_requestPathStatsCalculators;
 
+    std::map<std::string, std::shared_ptr<server::RouteStatisticsCalculator>> m_routes;
+
     mutable nx::utils::PartitionedConcurrentHashMap<int /*sequence*/, std::string> m_activeRequests;
     mutable std::atomic<int> m_requestSeq{0};
     std::optional<std::chrono::milliseconds> m_linger = kDefaultLinger;
@@ -253,7 +285,10 @@ public:
         const Method& method = kAnyMethod) override
     {
         NX_ASSERT(factoryFunc);
-        auto handlerFactory = HandlerFactory{std::move(factoryFunc)};
+        auto handlerFactory = HandlerFactory{
+            std::move(factoryFunc),
+            std::make_shared<server::RouteStatisticsCalculator>()};
+        auto routeStatistics = handlerFactory.routeStatistics;
 
         PathMatchContext& pathMatchContext = m_factories[method];
         if (path == kAnyPath)
@@ -261,10 +296,14 @@ public:
             if (pathMatchContext.defaultHandlerFactory)
                 return false;
             pathMatchContext.defaultHandlerFactory = std::move(handlerFactory);
-            return true;
+        }
+        else if (!pathMatchContext.pathToFactory.add(path, std::move(handlerFactory)))
+        {
+            return false;
         }
 
-        return pathMatchContext.pathToFactory.add(path, std::move(handlerFactory));
+        addRoute(method, path, std::move(routeStatistics));
+        return true;
     }
 
     template<typename RequestHandlerType>
@@ -288,6 +327,7 @@ public:
     {
         m_factories.clear();
         m_rewritePrefixes.clear();
+        clearRoutes();
     }
 
 private:
@@ -296,6 +336,7 @@ private:
     struct HandlerFactory
     {
         FactoryFunc func;
+        std::shared_ptr<server::RouteStatisticsCalculator> routeStatistics;
 
         operator bool() const { return static_cast<bool>(func); }
 
@@ -305,7 +346,8 @@ private:
         {
             HandlerContext handlerContext{
                 func(),
-                std::move(pathTemplate)
+                std::move(pathTemplate),
+                routeStatistics
             };
             handlerContext.handler->setRequestPathParams(std::move(pathParams));
             return handlerContext;
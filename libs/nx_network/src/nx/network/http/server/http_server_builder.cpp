@@ -155,6 +155,15 @@ bool Builder::applySettings(
             });
     }
 
+    if (ctx->settings.http2Enabled)
+    {
+        ctx->server->forEachListener(
+            [](nx::network::http::HttpStreamSocketServer* server)
+            {
+                server->setHttp2Enabled(true);
+            });
+    }
+
     ctx->server->setTcpBackLogSize(ctx->settings.tcpBacklogSize);
     ctx->server->setExtraSuccessResponseHeaders(ctx->settings.extraSuccessResponseHeaders);
 
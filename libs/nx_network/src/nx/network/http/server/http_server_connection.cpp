@@ -5,10 +5,14 @@
 #include <atomic>
 #include <memory>
 
+#include <QtCore/QJsonObject>
+
 #include <nx/network/aio/async_channel_bridge.h>
+#include <nx/network/http/http2/server_session.h>
 #include <nx/network/socket_global.h>
 #include <nx/network/url/url_builder.h>
 #include <nx/utils/datetime.h>
+#include <nx/utils/trace/trace.h>
 
 #include "http_message_dispatcher.h"
 #include "http_stream_socket_server.h"
@@ -17,6 +21,15 @@ namespace nx::network::http {
 
 static std::atomic<std::uint64_t> sConnectionId{0};
 
+/**
+ * Identifies the request's span in the trace. Pipelined requests of a connection overlap, so the
+ * connection id alone is not enough.
+ */
+static std::int64_t requestTraceId(std::uint64_t connectionId, std::int64_t sequence)
+{
+    return static_cast<std::int64_t>(connectionId << 24) ^ sequence;
+}
+
 HttpServerConnection::HttpServerConnection(
     std::unique_ptr<AbstractStreamSocket> sock,
     nx::network::http::AbstractRequestHandler* requestHandler,
@@ -79,6 +92,11 @@ void HttpServerConnection::setPersistentConnectionEnabled(bool value)
     m_persistentConnectionEnabled = value;
 }
 
+void HttpServerConnection::setHttp2Enabled(bool value)
+{
+    m_isHttp2Enabled = value;
+}
+
 void HttpServerConnection::setExtraSuccessResponseHeaders(HttpHeaders responseHeaders)
 {
     m_extraSuccessResponseHeaders = std::move(responseHeaders);
@@ -90,6 +108,84 @@ void HttpServerConnection::setOnResponseSent(
     m_responseSentHandler = std::move(handler);
 }
 
+void HttpServerConnection::bytesReceived(const nx::Buffer& buffer)
+{
+    if (m_http2Session)
+    {
+        // The end of the stream is reported with the connection closure.
+        if (!buffer.empty())
+            m_http2Session->processReceivedData(buffer);
+        return;
+    }
+
+    if (!m_isHttp2Enabled || m_isProtocolDetected)
+        return base_type::bytesReceived(buffer);
+
+    detectProtocol(buffer);
+}
+
+void HttpServerConnection::detectProtocol(const nx::Buffer& buffer)
+{
+    using namespace http2;
+
+    if (buffer.empty())
+    {
+        // The connection has been closed before the protocol could be detected.
+        m_isProtocolDetected = true;
+        if (!m_protocolDetectionBuffer.empty())
+        {
+            nx::utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+            base_type::bytesReceived(std::exchange(m_protocolDetectionBuffer, nx::Buffer()));
+            if (watcher.interrupted())
+                return;
+        }
+        return base_type::bytesReceived(buffer); //< Reporting the end of the stream.
+    }
+
+    std::string_view data = buffer;
+    if (!m_protocolDetectionBuffer.empty())
+    {
+        m_protocolDetectionBuffer.append(buffer.data(), buffer.size());
+        data = m_protocolDetectionBuffer;
+    }
+
+    const auto bytesToCompare = std::min(data.size(), kConnectionPreface.size());
+    if (data.substr(0, bytesToCompare) == kConnectionPreface.substr(0, bytesToCompare))
+    {
+        if (bytesToCompare < kConnectionPreface.size())
+        {
+            // Waiting for the rest of the preface.
+            if (m_protocolDetectionBuffer.empty())
+                m_protocolDetectionBuffer = buffer;
+            return;
+        }
+
+        m_isProtocolDetected = true;
+        startHttp2Session();
+        if (m_protocolDetectionBuffer.empty())
+            return m_http2Session->processReceivedData(buffer);
+
+        const auto bufferedData = std::exchange(m_protocolDetectionBuffer, nx::Buffer());
+        m_http2Session->processReceivedData(bufferedData);
+        return;
+    }
+
+    m_isProtocolDetected = true;
+    if (m_protocolDetectionBuffer.empty())
+        return base_type::bytesReceived(buffer);
+
+    // The beginning of an HTTP/1.x request (e.g., "P" of "POST") has been held back.
+    base_type::bytesReceived(std::exchange(m_protocolDetectionBuffer, nx::Buffer()));
+}
+
+void HttpServerConnection::startHttp2Session()
+{
+    NX_VERBOSE(this, "Switching connection from %1 to HTTP/2", getForeignAddress());
+
+    m_http2Session = std::make_shared<http2::ServerSession>(this, m_requestHandler);
+    m_http2Session->start();
+}
+
 void HttpServerConnection::processMessage(
     nx::network::http::Message requestMessage)
 {
@@ -208,6 +304,7 @@ void HttpServerConnection::stopWhileInAioThread()
 
     m_currentMsgBody.reset();
     m_bridge.reset();
+    m_http2Session.reset();
 }
 
 std::unique_ptr<HttpServerConnection::RequestAuthContext>
@@ -218,6 +315,10 @@ std::unique_ptr<HttpServerConnection::RequestAuthContext>
     requestContext->requestReceivedTime = clock_type::now();
     requestContext->descriptor.sequence = ++m_lastRequestSequence;
     requestContext->descriptor.requestLine = request.requestLine;
+    NX_TRACE_CATEGORY_BEGIN_ASYNC("http", "request",
+        requestTraceId(m_attrs.id, requestContext->descriptor.sequence)).args({
+            {"method", QString::fromStdString(request.requestLine.method.toString())},
+            {"path", request.requestLine.url.path()}});
     requestContext->descriptor.protocolToUpgradeTo =
         nx::network::http::getHeaderValue(request.headers, "Upgrade");
     requestContext->request = std::move(request);
@@ -353,6 +454,10 @@ void HttpServerConnection::prepareAndSendResponse(
             responseContentLengthStr,
             requestProcessedIn.count());
 
+    NX_TRACE_CATEGORY_END_ASYNC("http", "request",
+        requestTraceId(m_attrs.id, requestDescriptor.sequence)).args({
+            {"status", (int) responseMessageContext->msg.response->statusLine.statusCode}});
+
     addResponseHeaders(
         requestDescriptor,
         responseMessageContext->msg.response,
@@ -501,6 +606,9 @@ void HttpServerConnection::responseSent(const time_point& requestReceivedTime)
         return;
     }
 
+    if (sendMessageBodyFromFile())
+        return;
+
     readMoreMessageBodyData();
 }
 
@@ -578,6 +686,40 @@ void HttpServerConnection::readMoreMessageBodyData()
         [this](auto&&... args) { someMsgBodyRead(std::forward<decltype(args)>(args)...); });
 }
 
+bool HttpServerConnection::sendMessageBodyFromFile()
+{
+    if (m_chunkedBodyParser || !isSendFileAvailable())
+        return false;
+
+    const auto fileRegion = m_currentMsgBody->takeFileRegion();
+    if (!fileRegion)
+        return false;
+
+    if (fileRegion->size == 0)
+    {
+        fullMessageHasBeenSent();
+        return true;
+    }
+
+    NX_VERBOSE(this, "Sending %1 bytes of message body directly from file", fileRegion->size);
+
+    sendFile(
+        *fileRegion,
+        [this](SystemError::ErrorCode sendResult)
+        {
+            if (sendResult != SystemError::noError)
+            {
+                NX_VERBOSE(this, "Failed to send message body. %1",
+                    SystemError::toString(sendResult));
+                return;
+            }
+
+            fullMessageHasBeenSent();
+        });
+
+    return true;
+}
+
 void HttpServerConnection::fullMessageHasBeenSent()
 {
     NX_VERBOSE(this, "Complete response message has been sent");
@@ -718,6 +860,9 @@ void HttpServerConnection::cleanUpOnConnectionClosure(
     m_currentMsgBody.reset();
 
     m_responseQueue.clear();
+
+    if (m_http2Session)
+        m_http2Session->onConnectionClosed(reason);
 }
 
 } // namespace nx::network::http
@@ -17,6 +17,7 @@
 #include "request_processing_types.h"
 
 namespace nx::network::aio { class AsyncChannelBridge; }
+namespace nx::network::http::http2 { class ServerSession; }
 namespace nx::utils::stree { class AttributeDictionary; }
 
 namespace nx::network::http {
@@ -97,6 +98,14 @@ public:
      */
     void setPersistentConnectionEnabled(bool value);
 
+    /**
+     * Enables serving HTTP/2 (RFC 7540) on the connection. The protocol is detected by the
+     * connection preface sent by the client first. That works both with TLS (the client has
+     * selected "h2" with ALPN) and with cleartext HTTP/2 with prior knowledge.
+     * Disabled by default. MUST be invoked before the connection starts reading.
+     */
+    void setHttp2Enabled(bool value);
+
     /**
      * Set some HTTP headers to be sent in every response.
      */
@@ -128,6 +137,7 @@ public:
     const ConnectionAttrs& attrs() const;
 
 protected:
+    virtual void bytesReceived(const nx::Buffer& buffer) override;
     virtual void processMessage(nx::network::http::Message request) override;
     virtual void processSomeMessageBody(nx::Buffer buffer) override;
     virtual void processMessageEnd() override;
@@ -135,6 +145,8 @@ protected:
     virtual void stopWhileInAioThread() override;
 
 private:
+    friend class http2::ServerSession;
+
     using clock_type = std::chrono::steady_clock;
     using time_point = clock_type::time_point;
 
@@ -197,8 +209,15 @@ private:
     int m_closeHandlerSubscriptionId = -1;
     std::optional<SystemError::ErrorCode> m_markedForClosure;
     std::unique_ptr<aio::AsyncChannelBridge> m_bridge;
+    bool m_isHttp2Enabled = false;
+    bool m_isProtocolDetected = false;
+    nx::Buffer m_protocolDetectionBuffer;
+    std::shared_ptr<http2::ServerSession> m_http2Session;
     nx::utils::InterruptionFlag m_destructionFlag;
 
+    void detectProtocol(const nx::Buffer& buffer);
+    void startHttp2Session();
+
     void extractClientEndpoint(const HttpHeaders& headers);
     void extractClientEndpointFromXForwardedHeader(const HttpHeaders& headers);
     void extractClientEndpointFromForwardedHeader(const HttpHeaders& headers);
@@ -236,6 +255,12 @@ private:
     void responseSent(const time_point& requestReceivedTime);
     void someMsgBodyRead(SystemError::ErrorCode, nx::Buffer buf);
     void readMoreMessageBodyData();
+
+    /**
+     * Sends the message body directly from a file to the socket if both support that.
+     * @return false if the body has to be read with AbstractMsgBodySource::readAsync.
+     */
+    bool sendMessageBodyFromFile();
     void fullMessageHasBeenSent();
     void checkForConnectionPersistency(const Request& request);
     void closeConnectionAfterReceivingCompleteRequest(SystemError::ErrorCode reason);
@@ -2,10 +2,28 @@
 
 #include "http_statistics.h"
 
+#include <algorithm>
+#include <array>
 #include <iomanip>
+#include <sstream>
 
 namespace nx::network::http::server {
 
+static constexpr std::array<double, 3> kPercentiles = {0.5, 0.95, 0.99};
+
+static std::string percentileKey(double percentile)
+{
+    std::ostringstream ss;
+    ss << std::setprecision(2) << std::fixed << percentile * 100;
+    auto k = ss.str();
+
+    while (k.back() == '0') //< Drop trailing zeros after the decimal.
+        k.pop_back();
+    while (k.back() == '.') //< If all decimals points were 0, then drop the decimal.
+        k.pop_back();
+
+    return k;
+}
 
 //-------------------------------------------------------------------------------------------------
 // RequestStatisticsCalculator
@@ -13,8 +31,7 @@ namespace nx::network::http::server {
 RequestStatisticsCalculator::RequestStatisticsCalculator():
     m_averageRequestProcessingTime(std::chrono::minutes(1))
 {
-    static constexpr std::array<double, 3> percentiles = {0.5, 0.95, 0.99};
-    for (const auto& p: percentiles)
+    for (const auto& p: kPercentiles)
     {
         m_requestProcessingTimePercentiles.emplace(
             p,
@@ -39,20 +56,48 @@ RequestStatistics RequestStatisticsCalculator::requestStatistics() const
     stats.maxRequestProcessingTimeUsec = m_maxRequestProcessingTime.getMaxPerLastPeriod();
 
     for (const auto& [key, calculator]: m_requestProcessingTimePercentiles)
-    {
-        std::ostringstream ss;
-        ss << std::setprecision(2) << std::fixed << key * 100;
-        auto k = ss.str();
+        stats.requestProcessingTimePercentilesUsec[percentileKey(key)] = calculator.get();
+
+    stats.requestsServedPerMinute = m_requestsServedPerMinute.getSumPerLastPeriod();
 
-        while (k.back() == '0') //< Drop trailing zeros after the decimal.
-            k.pop_back();
-        while (k.back() == '.') //< If all decimals points were 0, then drop the decimal.
-            k.pop_back();
+    return stats;
+}
 
-        stats.requestProcessingTimePercentilesUsec[std::move(k)] = calculator.get();
-    }
+//-------------------------------------------------------------------------------------------------
+// RouteStatisticsCalculator
 
-    stats.requestsServedPerMinute = m_requestsServedPerMinute.getSumPerLastPeriod();
+void RouteStatisticsCalculator::requestStarted(std::uint64_t requestBytes)
+{
+    m_requestsInFlight.fetch_add(1, std::memory_order_relaxed);
+    m_requestBytes.fetch_add(requestBytes, std::memory_order_relaxed);
+}
+
+void RouteStatisticsCalculator::requestCompleted(
+    std::chrono::microseconds duration,
+    std::optional<std::uint64_t> responseBytes)
+{
+    m_requestProcessingTime.add((std::uint64_t) std::max<std::int64_t>(duration.count(), 0));
+    if (responseBytes)
+        m_responseBytes.fetch_add(*responseBytes, std::memory_order_relaxed);
+    m_requestCount.fetch_add(1, std::memory_order_relaxed);
+    m_requestsInFlight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+RouteStatistics RouteStatisticsCalculator::routeStatistics() const
+{
+    RouteStatistics stats;
+    stats.requestCount = m_requestCount.load(std::memory_order_relaxed);
+    stats.requestsInFlight = m_requestsInFlight.load(std::memory_order_relaxed);
+    stats.requestBytes = m_requestBytes.load(std::memory_order_relaxed);
+    stats.responseBytes = m_responseBytes.load(std::memory_order_relaxed);
+    stats.maxRequestProcessingTimeUsec =
+        std::chrono::microseconds(m_requestProcessingTime.max());
+
+    for (const auto& p: kPercentiles)
+    {
+        stats.requestProcessingTimePercentilesUsec[percentileKey(p)] =
+            std::chrono::microseconds(m_requestProcessingTime.percentile(p));
+    }
 
     return stats;
 }
@@ -101,12 +146,35 @@ HttpStatistics SummingStatisticsProvider::httpStatistics() const
 
         accumulatedStats.requestsServedPerMinute += httpStats.requestsServedPerMinute;
 
+        accumulatedStats.listeners.insert(
+            accumulatedStats.listeners.end(),
+            httpStats.listeners.begin(), httpStats.listeners.end());
+
         for (const auto& [key, value]: httpStats.requestProcessingTimePercentilesUsec)
         {
             auto& percentile = accumulatedStats.requestProcessingTimePercentilesUsec[key];
             percentile = std::max(percentile, value);
         }
 
+        for (const auto& [route, stats]: httpStats.routes)
+        {
+            auto& accumulatedRouteStats = accumulatedStats.routes[route];
+            accumulatedRouteStats.requestCount += stats.requestCount;
+            accumulatedRouteStats.requestsInFlight += stats.requestsInFlight;
+            accumulatedRouteStats.requestBytes += stats.requestBytes;
+            accumulatedRouteStats.responseBytes += stats.responseBytes;
+            accumulatedRouteStats.maxRequestProcessingTimeUsec = std::max(
+                accumulatedRouteStats.maxRequestProcessingTimeUsec,
+                stats.maxRequestProcessingTimeUsec);
+
+            // Percentiles cannot be merged precisely. The worst value is reported.
+            for (const auto& [key, value]: stats.requestProcessingTimePercentilesUsec)
+            {
+                auto& percentile = accumulatedRouteStats.requestProcessingTimePercentilesUsec[key];
+                percentile = std::max(percentile, value);
+            }
+        }
+
         for (const auto& [path, stats]: httpStats.requests)
         {
             auto& accumulatedPathStats = accumulatedStats.requests[path];
@@ -2,9 +2,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include <nx/network/connection_server/server_statistics.h>
 #include <nx/reflect/instrument.h>
 #include <nx/utils/math/average_per_period.h>
+#include <nx/utils/math/log_linear_histogram.h>
 #include <nx/utils/math/max_per_period.h>
 #include <nx/utils/math/percentile_per_period.h>
 
@@ -28,6 +35,55 @@ NX_REFLECTION_INSTRUMENT(RequestStatistics, RequestStatistics_server_Fields)
 
 //-------------------------------------------------------------------------------------------------
 
+/**
+ * Statistics of a single request handler registration (see AbstractMessageDispatcher).
+ * Unlike RequestStatistics, the values are accumulated since the registration.
+ */
+struct NX_NETWORK_API RouteStatistics
+{
+    std::uint64_t requestCount = 0;
+    int requestsInFlight = 0;
+    std::uint64_t requestBytes = 0;
+
+    /** Only the response bodies of a known length are counted. */
+    std::uint64_t responseBytes = 0;
+
+    std::chrono::microseconds maxRequestProcessingTimeUsec{0};
+    std::map<std::string /* percent */, std::chrono::microseconds> requestProcessingTimePercentilesUsec;
+};
+
+#define RouteStatistics_server_Fields\
+    (requestCount)\
+    (requestsInFlight)\
+    (requestBytes)\
+    (responseBytes)\
+    (maxRequestProcessingTimeUsec)\
+    (requestProcessingTimePercentilesUsec)
+
+NX_REFLECTION_INSTRUMENT(RouteStatistics, RouteStatistics_server_Fields)
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Statistics of a single listening socket. There can be multiple listening sockets per endpoint
+ * if they are sharded with the "reuse port" flag.
+ */
+struct NX_NETWORK_API ListenerStatistics
+{
+    std::string endpoint;
+    int connectionCount = 0;
+    int connectionsAcceptedPerMinute = 0;
+};
+
+#define ListenerStatistics_server_Fields\
+    (endpoint)\
+    (connectionCount)\
+    (connectionsAcceptedPerMinute)
+
+NX_REFLECTION_INSTRUMENT(ListenerStatistics, ListenerStatistics_server_Fields)
+
+//-------------------------------------------------------------------------------------------------
+
 struct NX_NETWORK_API HttpStatistics:
     public network::server::Statistics,
     public RequestStatistics
@@ -36,6 +92,8 @@ struct NX_NETWORK_API HttpStatistics:
 
     std::map<int /*HTTP status code*/, int /*count*/> statuses;
     std::map<std::string /*requestPathTemplate*/, RequestStatistics> requests;
+    std::map<std::string /*method and path of the registration*/, RouteStatistics> routes;
+    std::vector<ListenerStatistics> listeners;
 
     using network::server::Statistics::operator=;
     using RequestStatistics::operator=;
@@ -44,7 +102,7 @@ struct NX_NETWORK_API HttpStatistics:
 #define HttpStatistics_server_Fields\
     Statistics_server_Fields\
     RequestStatistics_server_Fields\
-    (statuses)(requests)
+    (statuses)(requests)(routes)(listeners)
 
 NX_REFLECTION_INSTRUMENT(HttpStatistics, HttpStatistics_server_Fields)
 
@@ -83,6 +141,31 @@ private:
     nx::utils::math::SumPerMinute<int> m_requestsServedPerMinute;
 };
 
+//-------------------------------------------------------------------------------------------------
+// RouteStatisticsCalculator
+
+/**
+ * Lock-free. So, it is updated by every request without contention between the AIO threads.
+ */
+class NX_NETWORK_API RouteStatisticsCalculator
+{
+public:
+    void requestStarted(std::uint64_t requestBytes);
+
+    void requestCompleted(
+        std::chrono::microseconds duration,
+        std::optional<std::uint64_t> responseBytes);
+
+    RouteStatistics routeStatistics() const;
+
+private:
+    std::atomic<std::uint64_t> m_requestCount{0};
+    std::atomic<int> m_requestsInFlight{0};
+    std::atomic<std::uint64_t> m_requestBytes{0};
+    std::atomic<std::uint64_t> m_responseBytes{0};
+    nx::utils::math::LogLinearHistogram m_requestProcessingTime;
+};
+
 //-------------------------------------------------------------------------------------------------
 // SummingStatisticsProvider
 
@@ -15,6 +15,11 @@ void HttpStreamSocketServer::setPersistentConnectionEnabled(bool value)
     m_persistentConnectionEnabled = value;
 }
 
+void HttpStreamSocketServer::setHttp2Enabled(bool value)
+{
+    m_http2Enabled = value;
+}
+
 void HttpStreamSocketServer::setExtraSuccessResponseHeaders(HttpHeaders responseHeaders)
 {
     m_extraSuccessResponseHeaders = std::move(responseHeaders);
@@ -29,6 +34,14 @@ server::HttpStatistics HttpStreamSocketServer::httpStatistics() const
 {
     server::HttpStatistics httpStats;
     httpStats.operator=(statistics());
+
+    server::ListenerStatistics listenerStats;
+    if (const auto endpoint = boundAddress())
+        listenerStats.endpoint = endpoint->toString();
+    listenerStats.connectionCount = httpStats.connectionCount;
+    listenerStats.connectionsAcceptedPerMinute = httpStats.connectionsAcceptedPerMinute;
+    httpStats.listeners.push_back(std::move(listenerStats));
+
     NX_MUTEX_LOCKER lock(&m_mutex);
     httpStats.operator=(m_statsCalculator.requestStatistics());
 
@@ -39,6 +52,7 @@ server::HttpStatistics HttpStreamSocketServer::httpStatistics() const
         {
             httpStats.statuses = dispatcher->statusCodesReported();
             httpStats.requests = dispatcher->requestPathStatistics();
+            httpStats.routes = dispatcher->routeStatistics();
             break;
         }
 
@@ -59,6 +73,7 @@ std::shared_ptr<HttpServerConnection> HttpStreamSocketServer::createConnection(
         m_requestHandler,
         m_addressToRedirect);
     result->setPersistentConnectionEnabled(m_persistentConnectionEnabled);
+    result->setHttp2Enabled(m_http2Enabled);
     result->setExtraSuccessResponseHeaders(m_extraSuccessResponseHeaders);
     result->setOnResponseSent(
         [this](const auto& requestProcessingTime)
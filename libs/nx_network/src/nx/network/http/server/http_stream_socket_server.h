@@ -48,6 +48,11 @@ public:
 
     void setPersistentConnectionEnabled(bool value);
 
+    /**
+     * Enables HTTP/2 on the accepted connections. See HttpServerConnection::setHttp2Enabled.
+     */
+    void setHttp2Enabled(bool value);
+
     /**
      * Set some HTTP headers to be included in every response.
      */
@@ -64,6 +69,7 @@ protected:
 private:
     nx::network::http::AbstractRequestHandler* m_requestHandler = nullptr;
     bool m_persistentConnectionEnabled = true;
+    bool m_http2Enabled = false;
     HttpHeaders m_extraSuccessResponseHeaders;
 
     mutable nx::Mutex m_mutex;
@@ -23,6 +23,9 @@ HttpsServerContext::HttpsServerContext(const Settings& settings):
         }
     }
 
+    if (settings.http2Enabled)
+        m_sslContext->setAlpnProtocols({"h2", "http/1.1"});
+
     if (!m_settings.certificatePath.empty())
     {
         const bool isMonitoringEnabled = m_settings.certificateMonitorTimeout.has_value();
@@ -2,7 +2,9 @@
 
 #include "multi_endpoint_acceptor.h"
 
+#include <nx/network/socket_global.h>
 #include <nx/network/ssl/context.h>
+#include <nx/utils/log/log.h>
 
 namespace nx::network::http::server {
 
@@ -31,6 +33,11 @@ void MultiEndpointAcceptor::pleaseStopSync()
         m_multiAddressHttpServer->pleaseStopSync();
 }
 
+void MultiEndpointAcceptor::setListenersPerEndpoint(std::size_t count)
+{
+    m_listenersPerEndpoint = count;
+}
+
 bool MultiEndpointAcceptor::bind(
     const std::vector<SocketAddress>& endpoints,
     const std::vector<SocketAddress>& sslEndpoints)
@@ -94,35 +101,63 @@ std::unique_ptr<MultiEndpointAcceptor::MultiHttpServer>
     MultiEndpointAcceptor::startHttpServer(
         const std::vector<network::SocketAddress>& endpoints)
 {
-    auto server = startServer(endpoints);
-    if (server)
-        m_endpoints = server->endpoints();
-    return server;
+    return startServer(endpoints, &m_endpoints);
 }
 
 std::unique_ptr<MultiEndpointAcceptor::MultiHttpServer>
     MultiEndpointAcceptor::startHttpsServer(
         const std::vector<network::SocketAddress>& endpoints)
 {
-    auto server = startServer(endpoints, ssl::Context::instance());
-    if (server)
-        m_sslEndpoints = server->endpoints();
-    return server;
+    return startServer(endpoints, &m_sslEndpoints, ssl::Context::instance());
 }
 
 template<typename... Args>
 std::unique_ptr<MultiEndpointAcceptor::MultiHttpServer>
     MultiEndpointAcceptor::startServer(
         const std::vector<network::SocketAddress>& endpoints,
+        std::vector<network::SocketAddress>* boundEndpoints,
         Args&&... args)
 {
     auto multiAddressHttpServer = std::make_unique<MultiHttpServer>(
         m_requestHandler,
         std::forward<Args>(args)...);
 
-    if (!multiAddressHttpServer->bind(endpoints))
+    const auto aioThreads = SocketGlobals::instance().aioService().getAllAioThreads();
+    const std::size_t listenersPerEndpoint =
+        m_listenersPerEndpoint == 0 ? aioThreads.size() : m_listenersPerEndpoint;
+    std::size_t nextAioThreadIndex = 0;
+
+    const auto configureListener =
+        [&](HttpStreamSocketServer* listener)
+        {
+            if (listenersPerEndpoint <= 1)
+                return true;
+
+            if (!listener->setReusePort(true))
+            {
+                NX_WARNING(this, "Could not set reuse port flag. %1",
+                    SystemError::getLastOSErrorText());
+                return false;
+            }
+
+            listener->bindToAioThread(aioThreads[nextAioThreadIndex++ % aioThreads.size()]);
+            return true;
+        };
+
+    if (!multiAddressHttpServer->bind(endpoints, configureListener))
         return nullptr;
 
+    // Additional listeners share the actual endpoints since a random port could be requested.
+    *boundEndpoints = multiAddressHttpServer->endpoints();
+    for (std::size_t i = 1; i < listenersPerEndpoint; ++i)
+    {
+        if (!multiAddressHttpServer->bind(*boundEndpoints, configureListener))
+            return nullptr;
+    }
+
+    NX_DEBUG(this, "Bound to %1 with %2 listener(s) per endpoint",
+        *boundEndpoints, listenersPerEndpoint);
+
     return multiAddressHttpServer;
 }
 
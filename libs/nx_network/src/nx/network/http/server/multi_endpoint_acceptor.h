@@ -22,6 +22,16 @@ public:
 
     void pleaseStopSync();
 
+    /**
+     * Sets the number of listening sockets to open for every endpoint. The sockets share the
+     * endpoint with the "reuse port" flag and are bound to different AIO threads, so that the
+     * OS spreads incoming connections between them and every AIO thread accepts independently.
+     * 0 means one listening socket per AIO thread. By default, 1.
+     * NOTE: Must be called before MultiEndpointAcceptor::bind.
+     * NOTE: Connections are spread by the OS on Linux and BSD systems only (SO_REUSEPORT).
+     */
+    void setListenersPerEndpoint(std::size_t count);
+
     bool bind(
         const std::vector<SocketAddress>& endpoints,
         const std::vector<SocketAddress>& sslEndpoints);
@@ -46,6 +56,7 @@ private:
     std::vector<SocketAddress> m_sslEndpoints;
     std::unique_ptr<MultiHttpServer> m_multiAddressHttpServer;
     std::unique_ptr<SummingStatisticsProvider> m_httpStatsProvider;
+    std::size_t m_listenersPerEndpoint = 1;
 
     std::unique_ptr<MultiHttpServer> startHttpServer(
         const std::vector<network::SocketAddress>& endpoints);
@@ -53,9 +64,14 @@ private:
     std::unique_ptr<MultiHttpServer> startHttpsServer(
         const std::vector<network::SocketAddress>& endpoints);
 
+    /**
+     * @param boundEndpoints The actual endpoints. Each is specified once even if there are
+     * multiple listeners per endpoint.
+     */
     template<typename... Args>
     std::unique_ptr<MultiHttpServer> startServer(
         const std::vector<network::SocketAddress>& endpoints,
+        std::vector<network::SocketAddress>* boundEndpoints,
         Args&&... args);
 
     void initializeHttpStatisticsProvider();
@@ -9,6 +9,7 @@
 
 #include "../../http_types.h"
 #include "../request_matcher.h"
+#include "path_template_trie.h"
 
 namespace nx::network::http::server::rest {
 
@@ -30,17 +31,16 @@ public:
     /**
      * Registers path that may contain REST parameters. Each parameter is a string token
      * enclosed into {}. E.g., {name}. A path template may contain zero or more REST parameters.
+     * The template is compiled into a radix tree. Only the templates with regular expressions
+     * other than '.' and a trailing ".*" are matched using std::regex.
      * @return true if path registered. false if a duplicate or an invalid path template.
      */
     bool add(const std::string_view& pathTemplate, Mapped mapped)
     {
         MatchContext matchContext;
-        matchContext.regex = convertToRegex(pathTemplate);
         if (!fetchParamNames(pathTemplate, &matchContext.paramNames))
             return false;
 
-        matchContext.mapped = std::move(mapped);
-
         if (std::any_of(
             m_restPathToMatchContext.begin(), m_restPathToMatchContext.end(),
             [&pathTemplate](const auto& elem) { return elem.first == pathTemplate; }))
@@ -49,6 +49,15 @@ public:
             return false;
         }
 
+        const auto index = m_restPathToMatchContext.size();
+        if (!m_trie.add(pathTemplate, index))
+        {
+            matchContext.regex = convertToRegex(pathTemplate);
+            m_regexTemplateIndices.push_back(index);
+        }
+
+        matchContext.mapped = std::move(mapped);
+
         m_restPathToMatchContext.emplace_back(
             std::string(pathTemplate),
             std::move(matchContext));
@@ -56,48 +65,43 @@ public:
     }
 
     /**
-     * Matches registered paths. Path templates are tested in the order
-     * they were registered using PathMatcher::add.
+     * Matches registered paths. If multiple templates match the path, the one registered first
+     * using PathMatcher::add wins.
      */
     std::optional<MatchResult> match(const std::string_view& path) const
     {
-        for (const auto& [pathTemplateStr, matchContext]: m_restPathToMatchContext)
+        const auto trieMatch = m_trie.match(path);
+        const auto trieIndex = trieMatch ? trieMatch->index : detail::PathTemplateTrie::kNoIndex;
+
+        for (const auto index: m_regexTemplateIndices)
         {
-            std::match_results<std::string_view::const_iterator> matchResult;
-            if (std::regex_search(path.begin(), path.end(), matchResult, matchContext.regex))
-            {
-                RequestPathParams params;
-                bool matched = true;
-                for (size_t i = 1; i < matchResult.size(); ++i)
-                {
-                    if (matchResult[i].length() == 0)
-                    {
-                        matched = false;
-                        break;
-                    }
-
-                    const auto& decodedStr =
-                        QUrl::fromPercentEncoding(QByteArray::fromStdString(matchResult[i]));
-                    params.emplace(matchContext.paramNames[i - 1], decodedStr.toStdString());
-                }
-
-                if (!matched)
-                    continue;
-
-                return MatchResult{
-                    .value = matchContext.mapped,
-                    .pathTemplate = (std::string_view) pathTemplateStr,
-                    .pathParams = std::move(params)};
-            }
+            if (index > trieIndex)
+                break;
+
+            if (auto result = matchRegex(m_restPathToMatchContext[index], path))
+                return result;
         }
 
-        return std::nullopt;
+        if (!trieMatch)
+            return std::nullopt;
+
+        const auto& [pathTemplateStr, matchContext] = m_restPathToMatchContext[trieIndex];
+
+        RequestPathParams params;
+        for (std::size_t i = 0; i < trieMatch->paramCount; ++i)
+            params.emplace(matchContext.paramNames[i], decode(trieMatch->params[i]));
+
+        return MatchResult{
+            .value = matchContext.mapped,
+            .pathTemplate = (std::string_view) pathTemplateStr,
+            .pathParams = std::move(params)};
     }
 
 private:
     struct MatchContext
     {
-        std::regex regex;
+        /** Initialized only if the template cannot be compiled into the radix tree. */
+        std::optional<std::regex> regex;
         /**
          * NOTE: Order preserves the order in the request.
          */
@@ -107,6 +111,44 @@ private:
 
     /** REST path template, context */
     std::vector<std::pair<std::string, MatchContext>> m_restPathToMatchContext;
+    detail::PathTemplateTrie m_trie;
+    std::vector<std::size_t> m_regexTemplateIndices;
+
+    static std::string decode(const std::string_view& value)
+    {
+        if (value.find('%') == std::string_view::npos)
+            return std::string(value);
+
+        return QUrl::fromPercentEncoding(QByteArray(value.data(), (int) value.size()))
+            .toStdString();
+    }
+
+    std::optional<MatchResult> matchRegex(
+        const std::pair<std::string, MatchContext>& pathTemplateAndContext,
+        const std::string_view& path) const
+    {
+        const auto& [pathTemplateStr, matchContext] = pathTemplateAndContext;
+
+        std::match_results<std::string_view::const_iterator> matchResult;
+        if (!std::regex_search(path.begin(), path.end(), matchResult, *matchContext.regex))
+            return std::nullopt;
+
+        RequestPathParams params;
+        for (size_t i = 1; i < matchResult.size(); ++i)
+        {
+            if (matchResult[i].length() == 0)
+                return std::nullopt;
+
+            const auto& decodedStr =
+                QUrl::fromPercentEncoding(QByteArray::fromStdString(matchResult[i]));
+            params.emplace(matchContext.paramNames[i - 1], decodedStr.toStdString());
+        }
+
+        return MatchResult{
+            .value = matchContext.mapped,
+            .pathTemplate = (std::string_view) pathTemplateStr,
+            .pathParams = std::move(params)};
+    }
 
     std::regex convertToRegex(const std::string_view& pathTemplate)
     {
@@ -0,0 +1,281 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "path_template_trie.h"
+
+#include <algorithm>
+
+namespace nx::network::http::server::rest::detail {
+
+static char toLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char) (c - 'A' + 'a') : c;
+}
+
+static bool isParamNameChar(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+        || c == '_' || c == '-';
+}
+
+static bool startsWithCaseInsensitive(
+    const std::string_view& str, std::size_t pos, const std::string& lowerPrefix)
+{
+    if (str.size() - pos < lowerPrefix.size())
+        return false;
+
+    for (std::size_t i = 0; i < lowerPrefix.size(); ++i)
+    {
+        if (toLower(str[pos + i]) != lowerPrefix[i])
+            return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+struct PathTemplateTrie::Node
+{
+    /** Lower-case literal that leads to this node from the parent's literal children. */
+    std::string label;
+
+    /** No two children start with the same character. */
+    std::vector<std::unique_ptr<Node>> literals;
+    std::unique_ptr<Node> anyChar;
+    std::unique_ptr<Node> param;
+
+    std::size_t leaf = kNoIndex;
+    std::size_t restLeaf = kNoIndex;
+
+    /** The lowest template index in the subtree. Used to skip the subtrees that cannot win. */
+    std::size_t minIndex = kNoIndex;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+PathTemplateTrie::PathTemplateTrie():
+    m_root(std::make_unique<Node>())
+{
+}
+
+PathTemplateTrie::~PathTemplateTrie() = default;
+
+PathTemplateTrie::PathTemplateTrie(PathTemplateTrie&&) = default;
+
+PathTemplateTrie& PathTemplateTrie::operator=(PathTemplateTrie&&) = default;
+
+bool PathTemplateTrie::add(const std::string_view& pathTemplate, std::size_t index)
+{
+    auto tokens = tokenize(pathTemplate);
+    if (!tokens)
+        return false;
+
+    Node* node = m_root.get();
+    node->minIndex = std::min(node->minIndex, index);
+    for (const auto& token: *tokens)
+    {
+        switch (token.type)
+        {
+            case Token::Type::literal:
+                node = addLiteral(node, token.literal, index);
+                break;
+
+            case Token::Type::anyChar:
+            case Token::Type::param:
+            {
+                auto& child = token.type == Token::Type::anyChar ? node->anyChar : node->param;
+                if (!child)
+                    child = std::make_unique<Node>();
+                node = child.get();
+                node->minIndex = std::min(node->minIndex, index);
+                break;
+            }
+
+            case Token::Type::rest:
+                node->restLeaf = std::min(node->restLeaf, index);
+                return true;
+        }
+    }
+
+    // A template that differs from an existing one only in the case or the names of the
+    // parameters would never be matched anyway. The one with the lower index wins.
+    node->leaf = std::min(node->leaf, index);
+    return true;
+}
+
+std::optional<PathTemplateTrie::MatchResult> PathTemplateTrie::match(
+    const std::string_view& path) const
+{
+    MatchResult current;
+    MatchResult best;
+    search(*m_root, path, 0, &current, &best);
+
+    if (best.index == kNoIndex)
+        return std::nullopt;
+    return best;
+}
+
+void PathTemplateTrie::clear()
+{
+    m_root = std::make_unique<Node>();
+}
+
+std::optional<std::vector<PathTemplateTrie::Token>> PathTemplateTrie::tokenize(
+    const std::string_view& pathTemplate)
+{
+    std::vector<Token> tokens;
+    std::size_t paramCount = 0;
+
+    const auto addLiteralChar =
+        [&tokens](char c)
+        {
+            if (tokens.empty() || tokens.back().type != Token::Type::literal)
+                tokens.push_back(Token{Token::Type::literal, {}});
+            tokens.back().literal += toLower(c);
+        };
+
+    for (std::size_t pos = 0; pos < pathTemplate.size(); ++pos)
+    {
+        const char c = pathTemplate[pos];
+        switch (c)
+        {
+            case '{':
+            {
+                auto end = pos + 1;
+                while (end < pathTemplate.size() && isParamNameChar(pathTemplate[end]))
+                    ++end;
+                if (end == pathTemplate.size() || pathTemplate[end] != '}')
+                {
+                    addLiteralChar(c);
+                    break;
+                }
+
+                if (++paramCount > kMaxParamCount)
+                    return std::nullopt;
+                tokens.push_back(Token{Token::Type::param, {}});
+                pos = end;
+                break;
+            }
+
+            case '.':
+                if (pos + 2 == pathTemplate.size() && pathTemplate[pos + 1] == '*')
+                {
+                    tokens.push_back(Token{Token::Type::rest, {}});
+                    return tokens;
+                }
+                tokens.push_back(Token{Token::Type::anyChar, {}});
+                break;
+
+            case '*':
+            case '[':
+            case '\\':
+            case '^':
+            case '$':
+                // Other regular expressions are left to std::regex.
+                return std::nullopt;
+
+            default:
+                addLiteralChar(c);
+                break;
+        }
+    }
+
+    return tokens;
+}
+
+PathTemplateTrie::Node* PathTemplateTrie::addLiteral(
+    Node* node, std::string_view literal, std::size_t index)
+{
+    while (!literal.empty())
+    {
+        auto childIter = std::find_if(
+            node->literals.begin(), node->literals.end(),
+            [c = literal.front()](const auto& child) { return child->label.front() == c; });
+
+        if (childIter == node->literals.end())
+        {
+            auto& child = node->literals.emplace_back(std::make_unique<Node>());
+            child->label = std::string(literal);
+            child->minIndex = index;
+            return child.get();
+        }
+
+        auto& child = *childIter;
+        const auto mismatch = std::mismatch(
+            literal.begin(), literal.end(), child->label.begin(), child->label.end());
+        const auto commonLength = (std::size_t) (mismatch.first - literal.begin());
+
+        if (commonLength < child->label.size())
+        {
+            // Splitting the edge.
+            auto middle = std::make_unique<Node>();
+            middle->label = child->label.substr(0, commonLength);
+            middle->minIndex = child->minIndex;
+            child->label.erase(0, commonLength);
+            middle->literals.push_back(std::move(child));
+            child = std::move(middle);
+        }
+
+        node = child.get();
+        node->minIndex = std::min(node->minIndex, index);
+        literal.remove_prefix(commonLength);
+    }
+
+    return node;
+}
+
+void PathTemplateTrie::search(
+    const Node& node,
+    const std::string_view& path,
+    std::size_t pos,
+    MatchResult* current,
+    MatchResult* best)
+{
+    if (node.minIndex >= best->index)
+        return;
+
+    if (node.restLeaf < best->index)
+    {
+        *best = *current;
+        best->index = node.restLeaf;
+    }
+
+    if (pos == path.size())
+    {
+        if (node.leaf < best->index)
+        {
+            *best = *current;
+            best->index = node.leaf;
+        }
+        return;
+    }
+
+    const char c = toLower(path[pos]);
+    for (const auto& child: node.literals)
+    {
+        if (child->label.front() != c)
+            continue;
+
+        if (startsWithCaseInsensitive(path, pos, child->label))
+            search(*child, path, pos + child->label.size(), current, best);
+        break;
+    }
+
+    if (node.anyChar)
+        search(*node.anyChar, path, pos + 1, current, best);
+
+    if (node.param && current->paramCount < kMaxParamCount)
+    {
+        // Same as std::regex: the parameter is greedy, shorter values are tried if the rest
+        // of the path does not match.
+        const auto end = std::min(path.find('/', pos), path.size());
+        for (auto valueEnd = end; valueEnd > pos; --valueEnd)
+        {
+            current->params[current->paramCount++] = path.substr(pos, valueEnd - pos);
+            search(*node.param, path, valueEnd, current, best);
+            --current->paramCount;
+        }
+    }
+}
+
+} // namespace nx::network::http::server::rest::detail
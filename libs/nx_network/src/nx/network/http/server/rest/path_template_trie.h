@@ -0,0 +1,79 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nx::network::http::server::rest::detail {
+
+/**
+ * Radix tree of REST path templates. Each template is compiled once by add(). match() walks the
+ * tree once per request and does not allocate: parameter values are returned as views of the
+ * path.
+ * The template syntax is the one of PathMatcher: literal characters are matched
+ * case-insensitively, "{name}" matches a non-empty string without '/', '.' matches any character
+ * and a trailing ".*" matches the rest of the path.
+ * If multiple templates match the path, the one with the lowest index wins.
+ */
+class NX_NETWORK_API PathTemplateTrie
+{
+public:
+    static constexpr std::size_t kMaxParamCount = 16;
+    static constexpr std::size_t kNoIndex = std::numeric_limits<std::size_t>::max();
+
+    struct MatchResult
+    {
+        std::size_t index = kNoIndex;
+        std::array<std::string_view, kMaxParamCount> params;
+        std::size_t paramCount = 0;
+    };
+
+    PathTemplateTrie();
+    ~PathTemplateTrie();
+
+    PathTemplateTrie(PathTemplateTrie&&);
+    PathTemplateTrie& operator=(PathTemplateTrie&&);
+
+    /**
+     * @return false if the template uses the syntax not supported here (e.g., a regular
+     * expression other than described above) or has too many parameters. The trie is not
+     * modified then.
+     */
+    bool add(const std::string_view& pathTemplate, std::size_t index);
+
+    std::optional<MatchResult> match(const std::string_view& path) const;
+
+    void clear();
+
+private:
+    struct Node;
+
+    struct Token
+    {
+        enum class Type { literal, anyChar, param, rest };
+
+        Type type = Type::literal;
+        std::string literal;
+    };
+
+    std::unique_ptr<Node> m_root;
+
+    static std::optional<std::vector<Token>> tokenize(const std::string_view& pathTemplate);
+
+    static Node* addLiteral(Node* node, std::string_view literal, std::size_t index);
+
+    static void search(
+        const Node& node,
+        const std::string_view& path,
+        std::size_t pos,
+        MatchResult* current,
+        MatchResult* best);
+};
+
+} // namespace nx::network::http::server::rest::detail
@@ -17,6 +17,7 @@ static constexpr char kServerName[] = "serverName";
 static constexpr char kRedirectHttpToHttps[] = "redirectHttpToHttps";
 static constexpr char kReusePort[] = "reusePort";
 static constexpr char kListeningConcurrency[] = "listeningConcurrency";
+static constexpr char kHttp2Enabled[] = "http2Enabled";
 
 static constexpr char kLegacySslEndpointsToListen[] = "sslEndpoints";
 static constexpr char kSslCertificatePath[] = "certificatePath";
@@ -46,6 +47,7 @@ void Settings::load(const SettingsReader& settings0, const char * groupName)
     redirectHttpToHttps = settings.value(kRedirectHttpToHttps, redirectHttpToHttps).toBool();
     reusePort = settings.value(kReusePort, reusePort).toBool();
     listeningConcurrency = settings.value(kListeningConcurrency, listeningConcurrency).toInt();
+    http2Enabled = settings.value(kHttp2Enabled, http2Enabled).toBool();
 
     loadSsl(settings);
     loadHeaders(settings);
@@ -76,6 +76,14 @@ public:
      */
     unsigned int listeningConcurrency = 1;
 
+    /**
+     * Accept HTTP/2 connections in addition to HTTP/1.x. The protocol is negotiated with ALPN
+     * on SSL endpoints and is detected by the connection preface on plain ones (h2c).
+     * NOTE: ALPN is announced only if Ssl::certificatePath is specified since the default
+     * SSL context is shared by the whole process.
+     */
+    bool http2Enabled = false;
+
     Ssl ssl;
 
     /**
@@ -102,6 +110,6 @@ NX_REFLECTION_INSTRUMENT(Settings::Ssl,
 
 NX_REFLECTION_INSTRUMENT(Settings,
     (tcpBacklogSize)(connectionInactivityPeriod)(endpoints)(serverName)\
-    (redirectHttpToHttps)(reusePort)(listeningConcurrency)(ssl))
+    (redirectHttpToHttps)(reusePort)(listeningConcurrency)(http2Enabled)(ssl))
 
 } // namespace nx::network::http::server
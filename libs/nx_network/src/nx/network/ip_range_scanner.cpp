@@ -2,14 +2,28 @@
 
 #include "ip_range_scanner.h"
 
+#include <algorithm>
+
 #include <nx/network/url/url_builder.h>
 #include <nx/utils/log/log.h>
 
+using namespace std::chrono;
+
 static constexpr int kMaxHostsCheckedSimultaneously = 256;
 
+/** Connects hold a socket only, but the default limit of open files is often 1024. */
+static constexpr int kMaxHostsConnectedSimultaneously = 512;
+
+/** The timeout before any round trip time is measured. Also the upper limit. */
+static constexpr milliseconds kMaxConnectTimeout = 3s;
+
+/** Even in a fast network, some devices are slow to accept a connection. */
+static constexpr milliseconds kMinConnectTimeout = 300ms;
+
 namespace nx::network {
 
-IpRangeScanner::IpRangeScanner(aio::AbstractAioThread* aioThread)
+IpRangeScanner::IpRangeScanner(aio::AbstractAioThread* aioThread):
+    m_connectTimeoutMs(kMaxConnectTimeout.count())
 {
     NX_VERBOSE(this, "Created");
     bindToAioThread(aioThread ? aioThread : getAioThread());
@@ -27,9 +41,17 @@ void IpRangeScanner::stopWhileInAioThread()
         HostAddress(nx::network::HostAddress::ipV4from(m_startIpv4)),
         HostAddress(nx::network::HostAddress::ipV4from(m_endIpv4)));
     m_ipCheckers.clear();
+    m_connectors.clear();
+    m_hostsToCheck.clear();
     m_state = State::terminated;
 }
 
+void IpRangeScanner::setTcpPreScanEnabled(bool value)
+{
+    NX_ASSERT(m_state == State::readyToScan);
+    m_tcpPreScanEnabled = value;
+}
+
 void IpRangeScanner::scanOnlineHosts(
     CompletionHandler callback,
     nx::network::HostAddress startAddr,
@@ -54,8 +76,17 @@ void IpRangeScanner::scanOnlineHosts(
 
             m_state = State::scanning;
             m_nextIPToCheck = m_startIpv4;
-            for (int i = 0; i < kMaxHostsCheckedSimultaneously; ++i)
-                startHostCheck();
+            m_smoothedRoundTripTime.reset(); //< Another range may be in another network.
+            m_connectTimeoutMs = kMaxConnectTimeout.count();
+            if (m_tcpPreScanEnabled)
+            {
+                for (int i = 0; i < kMaxHostsConnectedSimultaneously; ++i)
+                    startConnect();
+            }
+            else
+            {
+                startHostChecks();
+            }
         });
 }
 
@@ -69,14 +100,130 @@ int IpRangeScanner::maxHostsCheckedSimultaneously()
     return kMaxHostsCheckedSimultaneously;
 }
 
-bool IpRangeScanner::startHostCheck()
+int IpRangeScanner::maxHostsConnectedSimultaneously()
+{
+    return kMaxHostsConnectedSimultaneously;
+}
+
+milliseconds IpRangeScanner::connectTimeout() const
+{
+    return milliseconds(m_connectTimeoutMs.load());
+}
+
+bool IpRangeScanner::startConnect()
 {
     NX_ASSERT(isInSelfAioThread());
     NX_ASSERT(m_state == State::scanning);
 
     if (m_nextIPToCheck > m_endIpv4)
-        return false;  // All ip addresses are being scanned at the moment.
-    uint32_t ipToCheck = m_nextIPToCheck++;
+        return false; //< All ip addresses are being scanned at the moment.
+    const uint32_t ipToCheck = m_nextIPToCheck++;
+
+    auto socket = std::make_unique<TCPSocket>(AF_INET);
+    socket->bindToAioThread(getAioThread());
+    if (!socket->setNonBlockingMode(true)
+        || !socket->setSendTimeout(connectTimeout())) //< The connect timeout.
+    {
+        NX_VERBOSE(this, "Failed to configure socket for IP %1: %2. Checking it with HTTP",
+            HostAddress(HostAddress::ipV4from(ipToCheck)), SystemError::getLastOSErrorText());
+        m_hostsToCheck.push_back(ipToCheck);
+        startHostChecks();
+        return true;
+    }
+
+    const auto connectorIter = m_connectors.insert(
+        m_connectors.end(), Connector{std::move(socket), ipToCheck, steady_clock::now()});
+    connectorIter->socket->connectAsync(
+        SocketAddress(HostAddress(HostAddress::ipV4from(ipToCheck)), uint16_t(m_portToScan)),
+        [this, connectorIter](SystemError::ErrorCode errorCode)
+        {
+            onConnected(connectorIter, errorCode);
+        });
+    return true;
+}
+
+void IpRangeScanner::onConnected(
+    Connectors::iterator connectorIter, SystemError::ErrorCode errorCode)
+{
+    NX_ASSERT(isInSelfAioThread());
+    NX_ASSERT(m_state == State::scanning);
+
+    const uint32_t ipv4 = connectorIter->ipv4;
+    const auto roundTripTime =
+        duration_cast<microseconds>(steady_clock::now() - connectorIter->startTime);
+    m_connectors.erase(connectorIter);
+
+    // The refused connection is a reply of the host as well, so its time is a valid sample.
+    if (errorCode == SystemError::noError || errorCode == SystemError::connectionRefused)
+        updateRoundTripTime(roundTripTime);
+
+    if (errorCode == SystemError::noError)
+    {
+        NX_VERBOSE(this, "Pre-scanned IP: %1 (accepted in %2)",
+            HostAddress(HostAddress::ipV4from(ipv4)), roundTripTime);
+        m_hostsToCheck.push_back(ipv4);
+    }
+    else
+    {
+        NX_VERBOSE(this, "Checked IP: %1 (offline, %2)",
+            HostAddress(HostAddress::ipV4from(ipv4)), SystemError::toString(errorCode));
+        m_hostsChecked++;
+    }
+
+    startConnect();
+    startHostChecks();
+    completeIfDone();
+}
+
+void IpRangeScanner::updateRoundTripTime(microseconds roundTripTime)
+{
+    // The same estimation as for the TCP retransmission timeout (RFC 6298).
+    if (!m_smoothedRoundTripTime)
+    {
+        m_smoothedRoundTripTime = roundTripTime;
+        m_roundTripTimeVariation = roundTripTime / 2;
+    }
+    else
+    {
+        const auto deviation = *m_smoothedRoundTripTime > roundTripTime
+            ? *m_smoothedRoundTripTime - roundTripTime
+            : roundTripTime - *m_smoothedRoundTripTime;
+        m_roundTripTimeVariation = (m_roundTripTimeVariation * 3 + deviation) / 4;
+        m_smoothedRoundTripTime = (*m_smoothedRoundTripTime * 7 + roundTripTime) / 8;
+    }
+
+    const auto timeout = std::clamp(
+        duration_cast<milliseconds>(*m_smoothedRoundTripTime + m_roundTripTimeVariation * 4),
+        kMinConnectTimeout, kMaxConnectTimeout);
+    m_connectTimeoutMs = timeout.count();
+}
+
+void IpRangeScanner::startHostChecks()
+{
+    while ((int) m_ipCheckers.size() < kMaxHostsCheckedSimultaneously && startHostCheck())
+    {
+    }
+}
+
+bool IpRangeScanner::startHostCheck()
+{
+    NX_ASSERT(isInSelfAioThread());
+    NX_ASSERT(m_state == State::scanning);
+
+    uint32_t ipToCheck = 0;
+    if (m_tcpPreScanEnabled)
+    {
+        if (m_hostsToCheck.empty())
+            return false;
+        ipToCheck = m_hostsToCheck.front();
+        m_hostsToCheck.pop_front();
+    }
+    else
+    {
+        if (m_nextIPToCheck > m_endIpv4)
+            return false;  // All ip addresses are being scanned at the moment.
+        ipToCheck = m_nextIPToCheck++;
+    }
     NX_VERBOSE(this, "Checking IP: %1", HostAddress(HostAddress::ipV4from(ipToCheck)));
 
     auto clientIter =
@@ -114,9 +261,20 @@ void IpRangeScanner::onDone(IpCheckers::iterator clientIter)
 
     m_ipCheckers.erase(clientIter);
 
-    startHostCheck();
-    if (!m_ipCheckers.empty()) // Check if it was the last host check.
+    startHostChecks();
+    completeIfDone();
+}
+
+void IpRangeScanner::completeIfDone()
+{
+    if (m_state != State::scanning
+        || m_nextIPToCheck <= m_endIpv4
+        || !m_connectors.empty()
+        || !m_hostsToCheck.empty()
+        || !m_ipCheckers.empty())
+    {
         return;
+    }
 
     NX_VERBOSE(this, "Search in range [%1, %2] has finished, %3 hosts are online",
         HostAddress(HostAddress::ipV4from(m_startIpv4)),
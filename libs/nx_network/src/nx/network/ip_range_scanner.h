@@ -2,16 +2,26 @@
 
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <list>
+#include <optional>
 #include <unordered_set>
 
 #include <nx/network/aio/basic_pollable.h>
 #include <nx/network/async_stoppable.h>
 #include <nx/network/http/http_async_client.h>
+#include <nx/network/system_socket.h>
 
 namespace nx::network {
 
 /**
  * Asynchronously scans specified ip address range for specified port to be opened and listening.
+ *
+ * By default, the range is pre-scanned with plain TCP connects first: they are much cheaper than
+ * the HTTP requests, so many more of them are run simultaneously, and their timeout adapts to the
+ * round trip time observed in the network. Only the hosts which have accepted the connection are
+ * checked with an HTTP request.
  */
 class NX_NETWORK_API IpRangeScanner:
     public aio::BasicPollable
@@ -35,22 +45,50 @@ public:
         nx::network::HostAddress endAddr,
         int portToScan);
 
+    /** Must be called before the scan is started. Enabled by default. */
+    void setTcpPreScanEnabled(bool value);
+
     static int maxHostsCheckedSimultaneously();
+    static int maxHostsConnectedSimultaneously();
+
+    /**
+     * Number of the hosts which have been checked completely, either by the pre-scan or by the
+     * HTTP request. Can be used to report the scan progress.
+     */
     size_t hostsChecked() const;
 
+    /** Current timeout of the pre-scan connects. */
+    std::chrono::milliseconds connectTimeout() const;
 
 private:
     enum class State {readyToScan, scanning, terminated};
     using IpCheckers = std::unordered_set<std::unique_ptr<nx::network::http::AsyncClient>>;
 
+    struct Connector
+    {
+        std::unique_ptr<TCPSocket> socket;
+        uint32_t ipv4 = 0;
+        std::chrono::steady_clock::time_point startTime;
+    };
+    using Connectors = std::list<Connector>;
+
+    bool startConnect();
+    void onConnected(Connectors::iterator connectorIter, SystemError::ErrorCode errorCode);
+    void updateRoundTripTime(std::chrono::microseconds roundTripTime);
+
     bool startHostCheck();
+    void startHostChecks();
     void onDone(IpCheckers::iterator clientIter);
+    void completeIfDone();
     virtual void stopWhileInAioThread() override;
 
 private:
     CompletionHandler m_completionHandler;
     std::vector<nx::network::HostAddress> m_onlineHosts;
     IpCheckers m_ipCheckers;
+    Connectors m_connectors;
+    std::deque<uint32_t> m_hostsToCheck; //< Accepted the pre-scan connection.
+    bool m_tcpPreScanEnabled = true;
 
     std::atomic<State> m_state = State::readyToScan;
 
@@ -59,6 +97,10 @@ private:
     uint32_t m_endIpv4 = 0;
     uint32_t m_nextIPToCheck = 0;
     std::atomic<size_t> m_hostsChecked = 0;
+
+    std::optional<std::chrono::microseconds> m_smoothedRoundTripTime;
+    std::chrono::microseconds m_roundTripTimeVariation{0};
+    std::atomic<std::chrono::milliseconds::rep> m_connectTimeoutMs;
 };
 
 } // namespace nx::network
@@ -0,0 +1,43 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "get_lock_contention.h"
+
+#include <nx/network/http/buffer_source.h>
+#include <nx/network/http/http_types.h>
+#include <nx/reflect/json.h>
+#include <nx/utils/thread/lock_contention_profiler.h>
+#include <nx/utils/thread/mutex_delegate_factory.h>
+#include <nx/utils/url_query.h>
+
+namespace nx::network::maintenance {
+
+void GetLockContention::processRequest(
+    http::RequestContext requestContext,
+    http::RequestProcessedHandler completionHandler)
+{
+    const nx::utils::UrlQuery query(requestContext.request.requestLine.url.query());
+
+    std::size_t topSiteCount = kDefaultTopSiteCount;
+    if (query.contains("top"))
+    {
+        bool ok = false;
+        topSiteCount = query.queryItemValue<std::size_t>("top", QUrl::PrettyDecoded, &ok);
+        if (!ok)
+            return completionHandler(http::StatusCode::badRequest);
+    }
+
+    auto& profiler = LockContentionProfiler::instance();
+    auto report = profiler.report(topSiteCount);
+    report.enabled = (mutexImplementation() & MutexImplementations::profile) != 0;
+
+    if (query.contains("reset"))
+        profiler.clear();
+
+    http::RequestResult result(http::StatusCode::ok);
+    result.body = std::make_unique<http::BufferSource>(
+        http::header::ContentType::kJson,
+        nx::reflect::json::serialize(report));
+    completionHandler(std::move(result));
+}
+
+} // namespace nx::network::maintenance
@@ -0,0 +1,24 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <nx/network/http/server/abstract_http_request_handler.h>
+
+namespace nx::network::maintenance {
+
+/**
+ * Reports the most contended lock call sites collected by nx::LockContentionProfiler.
+ */
+class GetLockContention:
+    public http::RequestHandlerWithContext
+{
+public:
+    static constexpr std::size_t kDefaultTopSiteCount = 20;
+
+protected:
+    virtual void processRequest(
+        http::RequestContext requestContext,
+        http::RequestProcessedHandler completionHandler) override;
+};
+
+} // namespace nx::network::maintenance
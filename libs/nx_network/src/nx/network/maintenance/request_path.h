@@ -9,6 +9,7 @@ static constexpr char kMallocInfo[] = "/malloc_info";
 static constexpr char kLog[] = "/log";
 static constexpr char kStatistics[] = "/statistics";
 static constexpr char kDebugCounters[] = "/debug/counters";
+static constexpr char kLockContention[] = "/debug/lock_contention";
 static constexpr char kVersion[] = "/version";
 static constexpr char kHealth[] = "/health";
 
@@ -8,6 +8,7 @@
 
 #include "get_debug_counters.h"
 #include "get_health.h"
+#include "get_lock_contention.h"
 #include "get_malloc_info.h"
 #include "get_version.h"
 #include "request_path.h"
@@ -60,6 +61,22 @@ void Server::registerRequestHandlers(
         url::joinPath(m_maintenancePath, kDebugCounters),
         http::Method::get);
 
+    /**%apidoc GET /placeholder/maintenance/debug/lock_contention
+     * Retrieves the lock call sites that waited for the locks the most. The values are collected
+     * only if the component was started with "mutexImplementation=profile" in nx_utils.ini. Only
+     * one of "mutexProfileSamplingPeriod" lock calls of each thread is measured, so the values
+     * are approximate. This was designed to find the lock convoys on loaded servers.
+     * %param[opt]:integer top Maximum number of the lock call sites to report. 20 by default.
+     * %param[opt]:boolean reset Start collecting the statistics from scratch after it is reported.
+     * %caption Get lock contention statistics
+     * %ingroup Maintenance
+     * %return The lock call sites sorted by the total wait time.
+     *     %struct LockContentionReport
+     */
+    messageDispatcher->registerRequestProcessor<GetLockContention>(
+        url::joinPath(m_maintenancePath, kLockContention),
+        http::Method::get);
+
     /**%apidoc GET /placeholder/maintenance/version
      * Reports the component version detected at build time.
      * %caption Get component version
@@ -3,5 +3,6 @@
 namespace nx::network::maintenance::statistics {
 
 static constexpr char kGeneral[] = "/general";
+static constexpr char kRoutes[] = "/routes";
 
 } // namespace nx::network::maintenance::statistics
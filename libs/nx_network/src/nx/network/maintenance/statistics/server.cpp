@@ -35,6 +35,24 @@ void Server::registerRequestHandlers(
         http::Method::get,
         url::joinPath(basePath, kGeneral),
         [this](auto&& ... args){ getStatisticsGeneral(std::forward<decltype(args)>(args)...); });
+
+    m_messageDispatcher = messageDispatcher;
+
+    /**%apidoc GET /placeholder/maintenance/statistics/routes
+     * Provides the statistics of each request handler registered in the same dispatcher as this
+     * call: the number of requests served and being served, the request and response body bytes
+     * and the request processing time percentiles. The values are accumulated since the handler
+     * registration.
+     *
+     * %caption Get request handler statistics
+     * %ingroup Maintenance
+     * %return Statistics per "{method} {path}" of each handler registration. "*" stands for any
+     *     method or path.
+     */
+    messageDispatcher->registerRequestProcessorFunc(
+        http::Method::get,
+        url::joinPath(basePath, kRoutes),
+        [this](auto&& ... args){ getRouteStatistics(std::forward<decltype(args)>(args)...); });
 }
 
 void Server::getStatisticsGeneral(
@@ -53,4 +71,16 @@ void Server::getStatisticsGeneral(
     completionHandler(std::move(result));
 }
 
+void Server::getRouteStatistics(
+    http::RequestContext /*requestContext*/,
+    http::RequestProcessedHandler completionHandler)
+{
+    http::RequestResult result(http::StatusCode::ok);
+    result.body = std::make_unique<http::BufferSource>(
+        http::header::ContentType::kJson,
+        nx::reflect::json::serialize(m_messageDispatcher->routeStatistics()));
+
+    completionHandler(std::move(result));
+}
+
 } // namespace nx::network::maintenance::statistics
@@ -20,8 +20,13 @@ private:
         http::RequestContext requestContext,
         http::RequestProcessedHandler completionHandler);
 
+    void getRouteStatistics(
+        http::RequestContext requestContext,
+        http::RequestProcessedHandler completionHandler);
+
 private:
     std::chrono::steady_clock::time_point m_processStartTime;
+    const http::AbstractMessageDispatcher* m_messageDispatcher = nullptr;
 };
 
 } // namespace nx::network::maintenance::statistics
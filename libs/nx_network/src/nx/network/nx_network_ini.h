@@ -12,6 +12,18 @@ struct NX_NETWORK_API Ini: nx::kit::IniConfig
 
     NX_INI_INT(0, aioThreadCount, "Number of AIO threads, 0 means the number of CPU cores.");
 
+    NX_INI_FLAG(false, useIoUringPollSet,
+        "Use io_uring instead of epoll for polling system sockets in AIO threads when UDT is\n"
+        "disabled. Falls back to epoll if the kernel does not support io_uring.");
+
+    NX_INI_INT(1, aioTimerGranularityMs,
+        "Tick of the timing wheel keeping AIO timers and socket timeouts, in milliseconds.\n"
+        "A timer fires up to this value - 1 milliseconds later than scheduled.");
+
+    NX_INI_FLAG(true, useSpliceInStreamProxy,
+        "Forward the traffic between plain TCP connections in StreamProxy with splice() on Linux,\n"
+        "without copying it to the user space.");
+
     NX_INI_FLAG(true, verifySslCertificates, "Enables SSL certificate validation in general.");
 
     // VMS-20300
@@ -23,6 +35,18 @@ struct NX_NETWORK_API Ini: nx::kit::IniConfig
         "Verify SSL certificates using OS CA by default if there is no specific certificate\n"
         "verification assumed (i.e. client-server, server-server or server-cloud connections)");
 
+    NX_INI_FLAG(false, useKernelTls,
+        "Hand the sending direction of established TLS 1.3 connections over TCP to the kernel\n"
+        "(Linux kTLS), so that the plain and sendfile send paths can be used for encrypted data.");
+
+    NX_INI_INT(3, zstdCompressionLevel,
+        "zstd level of HTTP message bodies compressed by the \"zstd\" content encoding:\n"
+        "from -7 (fastest) to 22 (smallest).");
+
+    NX_INI_INT(-1, gzipCompressionLevel,
+        "zlib level of HTTP message bodies compressed by the \"gzip\" content encoding:\n"
+        "from 1 (fastest) to 9 (smallest), -1 for the zlib default (6).");
+
     NX_INI_FLAG(false, httpClientTraffic, "Trace HTTP traffic for nx::network::http::AsyncHttpClient");
     NX_INI_STRING("", disableHosts, "Comma-separated list of forbidden IPs and domains");
 
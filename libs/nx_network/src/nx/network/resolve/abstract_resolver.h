@@ -16,6 +16,10 @@ namespace network {
 struct ResolveResult
 {
     std::deque<AddressEntry> entries;
+    /**
+     * The period the result can be cached for. Not set if the result must not be cached.
+     * If set on SystemError::hostNotFound, the failure is cached (negative caching).
+     */
     std::optional<std::chrono::milliseconds> ttl;
 };
 
@@ -66,7 +66,9 @@ static void convertAddrInfo(
 
 /*static*/ std::atomic<bool> SystemResolver::s_resolveLocalhost{false};
 
+// getaddrinfo does not report the TTL of the records.
 static constexpr auto kMaxCachePeriod = std::chrono::minutes(1);
+static constexpr auto kNegativeCachePeriod = std::chrono::seconds(5);
 
 SystemError::ErrorCode SystemResolver::resolve(
     const std::string_view& hostNameOriginal,
@@ -145,6 +147,8 @@ SystemError::ErrorCode SystemResolver::resolve(
     if (status != 0)
     {
         resultCode = resolveStatusToErrno(status);
+        if (resultCode == SystemError::hostNotFound)
+            resolveResult->ttl = kNegativeCachePeriod; //< The name does not exist.
 
         NX_VERBOSE(this, nx::format("Resolve of %1 on DNS failed with result %2")
             .arg(hostName).arg(SystemError::toString(resultCode)));
@@ -16,6 +16,7 @@
 #endif
 
 #include <chrono>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -321,6 +322,20 @@ struct NX_NETWORK_API KeepAliveOptions
 NX_NETWORK_API void PrintTo(const KeepAliveOptions& val, ::std::ostream* os);
 NX_REFLECTION_TAG_TYPE(KeepAliveOptions, useStringConversionForSerialization)
 
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Contiguous part of an opened regular file. Used to transmit file data to a socket without
+ * copying it to the user space.
+ */
+struct FileRegion
+{
+    /** OS file descriptor. The owner of the descriptor keeps it opened while the region is used. */
+    int fd = -1;
+    std::uint64_t offset = 0;
+    std::uint64_t size = 0;
+};
+
 } // namespace nx::network
 
 namespace std {
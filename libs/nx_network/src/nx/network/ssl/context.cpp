@@ -4,10 +4,15 @@
 
 #ifdef ENABLE_SSL
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <mutex>
+#include <optional>
 
+#include <openssl/evp.h>
 #include <openssl/ssl.h>
+#include <openssl/x509.h>
 
 #include <nx/utils/log/assert.h>
 #include <nx/utils/log/log.h>
@@ -15,6 +20,8 @@
 #include <nx/utils/string.h>
 #include <nx/utils/type_utils.h>
 
+#include "ssl_pipeline.h"
+
 namespace nx::network::ssl {
 
 static constexpr std::string_view kSslSessionId = "Nx network SSL socket";
@@ -37,9 +44,31 @@ public:
 static constexpr int kDefaultDisabledServerVersions =
     SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 | SSL_OP_NO_TLSv1;
 
+/**
+ * Parses the server_name extension (RFC 6066, 3) of the ClientHello being processed.
+ */
+std::optional<std::string> getServerNameFromClientHello(SSL* s)
+{
+    const unsigned char* data = nullptr;
+    std::size_t length = 0;
+    if (SSL_client_hello_get0_ext(s, TLSEXT_TYPE_server_name, &data, &length) != 1)
+        return std::nullopt;
+
+    // The list length (2 bytes), the name type (1 byte) and the name length (2 bytes).
+    if (length < 5 || data[2] != TLSEXT_NAMETYPE_host_name)
+        return std::nullopt;
+
+    const std::size_t nameLength = (data[3] << 8) | data[4];
+    if (nameLength > length - 5)
+        return std::nullopt;
+
+    return std::string(reinterpret_cast<const char*>(data) + 5, nameLength);
+}
+
 } // namespace
 
 Context::Context():
+    m_serverSessionCache(ServerSessionCache::sharedInstance()),
     m_disabledServerVersions(kDefaultDisabledServerVersions),
     m_allowedServerCiphers("HIGH:!RC4:!3DES")
 {
@@ -54,6 +83,8 @@ Context::Context():
     auto verifyParam = nx::utils::wrapUnique(X509_VERIFY_PARAM_new(), &X509_VERIFY_PARAM_free);
     X509_VERIFY_PARAM_set_flags(verifyParam.get(), X509_V_FLAG_PARTIAL_CHAIN);
     SSL_CTX_set1_param(m_clientContext.get(), verifyParam.get());
+    SSL_CTX_set_keylog_callback(m_clientContext.get(), &Pipeline::saveTrafficSecret);
+    m_clientSessionCache.install(m_clientContext.get());
 }
 
 Context::~Context() = default;
@@ -74,6 +105,27 @@ const std::string_view& Context::sslSessionId()
     return kSslSessionId;
 }
 
+void Context::setServerSessionCache(std::shared_ptr<ServerSessionCache> cache)
+{
+    NX_MUTEX_LOCKER locker(&m_mutex);
+
+    m_serverSessionCache = std::move(cache);
+    m_serverSessionCache->install(m_defaultServerContext.get());
+    for (const auto& [hostnameRegex, virtualHost]: m_virtualHosts)
+        m_serverSessionCache->install(virtualHost.sslContext.get());
+}
+
+ServerSessionCache* Context::serverSessionCache()
+{
+    NX_MUTEX_LOCKER locker(&m_mutex);
+    return m_serverSessionCache.get();
+}
+
+ClientSessionCache* Context::clientSessionCache()
+{
+    return &m_clientSessionCache;
+}
+
 bool Context::setDefaultCertificate(const std::string& pemStr, bool allowEcdsaCertificates)
 {
     Pem pem;
@@ -89,6 +141,7 @@ bool Context::setDefaultCertificate(Pem pem, std::string* errorMessage)
 
     if (!pem.bindToContext(newDefaultContext.get(), errorMessage))
         return false;
+    setSessionIdContextFromCertificate(newDefaultContext.get());
 
     {
         NX_MUTEX_LOCKER locker(&m_mutex);
@@ -114,6 +167,7 @@ bool Context::configureVirtualHost(
     auto sslContext = createServerContext();
     if (!bindCertificateToSslContext(sslContext.get(), certDataPem))
         return false;
+    setSessionIdContextFromCertificate(sslContext.get());
 
     NX_MUTEX_LOCKER locker(&m_mutex);
 
@@ -216,6 +270,20 @@ bool Context::setAllowedServerCiphers(const std::string& ciphers)
     return true;
 }
 
+void Context::setAlpnProtocols(std::vector<std::string> protocols)
+{
+    NX_INFO(this, "Set server ALPN protocols: %1", containerString(protocols));
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_alpnProtocols = std::move(protocols);
+}
+
+std::vector<std::string> Context::alpnProtocols() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_alpnProtocols;
+}
+
 void Context::configure(SSL* ssl)
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
@@ -227,10 +295,8 @@ void Context::configure(SSL* ssl)
     else
         SSL_set_cipher_list(ssl, "DEFAULT");
 
-    SSL_set_session_id_context(
-        ssl,
-        reinterpret_cast<const unsigned char*>(kSslSessionId.data()),
-        kSslSessionId.size());
+    // NOTE: The session id context is inherited from SSL_CTX. It is replaced along with SSL_CTX
+    // when a virtual host is chosen only if it has not been altered.
 }
 
 std::shared_ptr<SSL_CTX> Context::createServerContext()
@@ -250,11 +316,18 @@ std::shared_ptr<SSL_CTX> Context::createServerContext()
         reinterpret_cast<const unsigned char*>(kSslSessionId.data()),
         kSslSessionId.size());
 
-    SSL_CTX_set_tlsext_servername_callback(
+    // The virtual host is chosen before a session to resume is looked up. So, only the sessions
+    // established with the certificate of the virtual host are resumed.
+    SSL_CTX_set_client_hello_cb(
         context.get(),
-        &Context::chooseSslContextForIncomingConnectionStatic);
+        &Context::chooseSslContextForIncomingConnectionStatic,
+        this);
 
-    SSL_CTX_set_tlsext_servername_arg(context.get(), this);
+    SSL_CTX_set_alpn_select_cb(context.get(), &Context::selectAlpnProtocolStatic, this);
+
+    SSL_CTX_set_keylog_callback(context.get(), &Pipeline::saveTrafficSecret);
+
+    m_serverSessionCache->install(context.get());
 
     return context;
 }
@@ -267,27 +340,73 @@ int Context::chooseSslContextForIncomingConnectionStatic(
 
 int Context::chooseSslContextForIncomingConnection(SSL* s, int* /*al*/)
 {
-    const int serverNameType = SSL_get_servername_type(s);
-    if (serverNameType == -1)
-        return SSL_TLSEXT_ERR_OK; //< Using default SSL context.
-
-    const char* serverName = SSL_get_servername(s, serverNameType);
+    const auto serverName = getServerNameFromClientHello(s);
     if (!serverName)
-        return SSL_TLSEXT_ERR_OK; //< Using default SSL context.
+        return SSL_CLIENT_HELLO_SUCCESS; //< Using default SSL context.
 
     NX_MUTEX_LOCKER locker(&m_mutex);
 
     for (const auto& [hostnameRegex, ctx]: m_virtualHosts)
     {
-        if (!std::regex_match(serverName, ctx.hostnameRegex))
+        if (!std::regex_match(*serverName, ctx.hostnameRegex))
             continue;
 
         SSL_set_SSL_CTX(s, ctx.sslContext.get());
-        return SSL_TLSEXT_ERR_OK;
+        return SSL_CLIENT_HELLO_SUCCESS;
     }
 
     // Leaving the default SSL context (along with the certificate) in place.
-    return SSL_TLSEXT_ERR_OK;
+    return SSL_CLIENT_HELLO_SUCCESS;
+}
+
+int Context::selectAlpnProtocolStatic(
+    SSL* /*s*/,
+    const unsigned char** out, unsigned char* outLength,
+    const unsigned char* in, unsigned int inLength,
+    void* arg)
+{
+    return static_cast<Context*>(arg)->selectAlpnProtocol(out, outLength, in, inLength);
+}
+
+int Context::selectAlpnProtocol(
+    const unsigned char** out, unsigned char* outLength,
+    const unsigned char* in, unsigned int inLength)
+{
+    NX_MUTEX_LOCKER locker(&m_mutex);
+
+    // The server preference wins. The client list is a sequence of length-prefixed names.
+    for (const auto& protocol: m_alpnProtocols)
+    {
+        for (unsigned int pos = 0; pos < inLength; pos += 1 + in[pos])
+        {
+            const unsigned int length = in[pos];
+            if (pos + 1 + length > inLength)
+                break;
+
+            if (length == protocol.size() && memcmp(in + pos + 1, protocol.data(), length) == 0)
+            {
+                *out = in + pos + 1;
+                *outLength = (unsigned char) length;
+                return SSL_TLSEXT_ERR_OK;
+            }
+        }
+    }
+
+    return SSL_TLSEXT_ERR_NOACK;
+}
+
+void Context::setSessionIdContextFromCertificate(SSL_CTX* sslContext)
+{
+    // Sessions are shared by every context having the same certificate, so a client never
+    // resumes a session established with a certificate that has been replaced.
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digestLength = 0;
+    X509* certificate = SSL_CTX_get0_certificate(sslContext);
+    if (!certificate || X509_digest(certificate, EVP_sha256(), digest, &digestLength) != 1)
+        return;
+
+    SSL_CTX_set_session_id_context(
+        sslContext, digest, std::min<unsigned int>(digestLength, SSL_MAX_SID_CTX_LENGTH));
 }
 
 bool Context::bindCertificateToSslContext(
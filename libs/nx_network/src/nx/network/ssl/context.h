@@ -9,6 +9,7 @@
 #include <optional>
 #include <regex>
 #include <string_view>
+#include <vector>
 
 #include <openssl/ssl.h>
 
@@ -16,6 +17,7 @@
 #include <nx/utils/thread/mutex.h>
 
 #include "certificate.h"
+#include "session_cache.h"
 
 namespace nx::network::ssl {
 
@@ -43,6 +45,21 @@ public:
 
     const std::string_view& sslSessionId();
 
+    /**
+     * Replaces the server-side session resumption state. By default, every Context uses
+     * ServerSessionCache::sharedInstance(), so that a session established with one server of the
+     * process can be resumed with any other one.
+     * NOTE: MUST be called before any connection is accepted with this Context.
+     */
+    void setServerSessionCache(std::shared_ptr<ServerSessionCache> cache);
+
+    ServerSessionCache* serverSessionCache();
+
+    /**
+     * @return Sessions established by the client connections that use this Context.
+     */
+    ClientSessionCache* clientSessionCache();
+
     /**
      * Set default certificate for connections where a custom certificate was not specified
      * using configureVirtualHost call.
@@ -95,6 +112,15 @@ public:
      */
     bool setAllowedServerCiphers(const std::string& ciphers);
 
+    /**
+     * Sets the application protocols (ALPN, RFC 7301) the server side agrees to, the most
+     * preferred first. E.g., {"h2", "http/1.1"}. If the client offers none of them, the
+     * connection is established without ALPN. By default, the list is empty, so ALPN is not used.
+     */
+    void setAlpnProtocols(std::vector<std::string> protocols);
+
+    std::vector<std::string> alpnProtocols() const;
+
     /**
      * Applies appropriate configuration to SSL connection.
      * This includes but not limited to: enabled server protocols, protocol ciphers.
@@ -113,6 +139,17 @@ private:
     static int chooseSslContextForIncomingConnectionStatic(SSL* s, int* al, void* arg);
     int chooseSslContextForIncomingConnection(SSL* s, int* al);
 
+    static int selectAlpnProtocolStatic(
+        SSL* s,
+        const unsigned char** out, unsigned char* outLength,
+        const unsigned char* in, unsigned int inLength,
+        void* arg);
+    int selectAlpnProtocol(
+        const unsigned char** out, unsigned char* outLength,
+        const unsigned char* in, unsigned int inLength);
+
+    static void setSessionIdContextFromCertificate(SSL_CTX* sslContext);
+
     bool bindCertificateToSslContext(
         SSL_CTX* sslContext,
         const std::string& pem);
@@ -137,6 +174,9 @@ private:
         }
     };
 
+    // NOTE: The caches are declared before the SSL contexts that refer to them.
+    std::shared_ptr<ServerSessionCache> m_serverSessionCache;
+    ClientSessionCache m_clientSessionCache;
     std::shared_ptr<SSL_CTX> m_defaultServerContext;
     std::shared_ptr<SSL_CTX> m_clientContext;
     Pem m_defaultServerPem;
@@ -148,6 +188,7 @@ private:
 
     std::atomic<int> m_disabledServerVersions = 0;
     std::string m_allowedServerCiphers;
+    std::vector<std::string> m_alpnProtocols;
 };
 
 } // namespace nx::network::ssl
@@ -0,0 +1,119 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "kernel_tls.h"
+
+#include <cstring>
+
+#include <openssl/crypto.h>
+
+#if defined(__linux__)
+    #include <linux/tls.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+#endif
+
+#if defined(__linux__)
+    #if !defined(TCP_ULP)
+        #define TCP_ULP 31
+    #endif
+    #if !defined(SOL_TLS)
+        #define SOL_TLS 282
+    #endif
+#endif
+
+namespace nx::network::ssl {
+
+TlsTxState::~TlsTxState()
+{
+    if (!key.empty())
+        OPENSSL_cleanse(key.data(), key.size());
+    OPENSSL_cleanse(iv.data(), iv.size());
+}
+
+namespace kernel_tls {
+
+#if defined(__linux__)
+
+namespace {
+
+template<typename CryptoInfo>
+SystemError::ErrorCode setTxCryptoInfo(
+    AbstractSocket::SOCKET_HANDLE handle,
+    int cipherType,
+    const TlsTxState& state)
+{
+    CryptoInfo info;
+    memset(&info, 0, sizeof(info));
+    info.info.version = TLS_1_3_VERSION;
+    info.info.cipher_type = cipherType;
+
+    if (state.key.size() != sizeof(info.key))
+        return SystemError::invalidData;
+    memcpy(info.key, state.key.data(), sizeof(info.key));
+
+    // The kernel splits the nonce base into the implicit "salt" part and the explicit "iv" one.
+    static_assert(sizeof(info.salt) + sizeof(info.iv) == std::tuple_size_v<decltype(state.iv)>);
+    memcpy(info.salt, state.iv.data(), sizeof(info.salt));
+    memcpy(info.iv, state.iv.data() + sizeof(info.salt), sizeof(info.iv));
+
+    for (std::size_t i = 0; i < sizeof(info.rec_seq); ++i)
+    {
+        info.rec_seq[sizeof(info.rec_seq) - i - 1] =
+            (unsigned char) (state.recordSequenceNumber >> (i * 8));
+    }
+
+    const int result = setsockopt(handle, SOL_TLS, TLS_TX, &info, sizeof(info));
+    const auto errorCode = result == 0 ? SystemError::noError : SystemError::getLastOSErrorCode();
+    OPENSSL_cleanse(&info, sizeof(info));
+    return errorCode;
+}
+
+} // namespace
+
+bool isSupported()
+{
+    return true;
+}
+
+SystemError::ErrorCode enableTx(
+    AbstractSocket::SOCKET_HANDLE handle,
+    const TlsTxState& state)
+{
+    static constexpr char kUlpName[] = "tls";
+    if (setsockopt(handle, SOL_TCP, TCP_ULP, kUlpName, sizeof(kUlpName)) != 0)
+        return SystemError::getLastOSErrorCode();
+
+    switch (state.cipher)
+    {
+        case TlsTxState::Cipher::aes128Gcm:
+            return setTxCryptoInfo<tls12_crypto_info_aes_gcm_128>(
+                handle, TLS_CIPHER_AES_GCM_128, state);
+
+        case TlsTxState::Cipher::aes256Gcm:
+            return setTxCryptoInfo<tls12_crypto_info_aes_gcm_256>(
+                handle, TLS_CIPHER_AES_GCM_256, state);
+    }
+
+    return SystemError::notImplemented;
+}
+
+#else
+
+bool isSupported()
+{
+    return false;
+}
+
+SystemError::ErrorCode enableTx(
+    AbstractSocket::SOCKET_HANDLE /*handle*/,
+    const TlsTxState& /*state*/)
+{
+    return SystemError::notImplemented;
+}
+
+#endif
+
+} // namespace kernel_tls
+
+} // namespace nx::network::ssl
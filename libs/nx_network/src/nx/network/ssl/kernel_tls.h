@@ -0,0 +1,61 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <nx/utils/system_error.h>
+
+#include "../abstract_socket.h"
+
+namespace nx::network::ssl {
+
+/**
+ * Symmetric state of the sending direction of an established TLS 1.3 session.
+ */
+struct TlsTxState
+{
+    enum class Cipher
+    {
+        aes128Gcm,
+        aes256Gcm,
+    };
+
+    Cipher cipher = Cipher::aes128Gcm;
+    std::vector<unsigned char> key;
+
+    /** Per-record nonce base, see RFC 8446, 5.3. */
+    std::array<unsigned char, 12> iv{};
+
+    /** Sequence number of the next record to be sent. */
+    std::uint64_t recordSequenceNumber = 0;
+
+    TlsTxState() = default;
+    ~TlsTxState();
+
+    TlsTxState(TlsTxState&&) = default;
+    TlsTxState& operator=(TlsTxState&&) = default;
+};
+
+namespace kernel_tls {
+
+/**
+ * @return true if the OS is able to encrypt TLS records sent over a TCP socket (Linux kTLS).
+ */
+NX_NETWORK_API bool isSupported();
+
+/**
+ * Switches the sending direction of the TCP socket to the kernel TLS. After a successful call
+ * every byte sent to the socket is encrypted into TLS application data records by the kernel.
+ * NOTE: All the records produced by the user-space TLS implementation must be sent to the socket
+ * before this call.
+ */
+NX_NETWORK_API SystemError::ErrorCode enableTx(
+    AbstractSocket::SOCKET_HANDLE handle,
+    const TlsTxState& state);
+
+} // namespace kernel_tls
+
+} // namespace nx::network::ssl
@@ -0,0 +1,397 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "session_cache.h"
+
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+
+#include <nx/utils/log/log.h>
+#include <nx/utils/time.h>
+
+namespace nx::network::ssl {
+
+namespace {
+
+/**
+ * Index of the SSL ex_data holding the client session cache key (std::string).
+ */
+int clientSessionKeyIndex()
+{
+    static const int index = SSL_get_ex_new_index(
+        0, nullptr, nullptr, nullptr,
+        [](void* /*parent*/, void* ptr, CRYPTO_EX_DATA* /*ad*/, int /*idx*/, long /*argl*/,
+            void* /*argp*/)
+        {
+            delete static_cast<std::string*>(ptr);
+        });
+    return index;
+}
+
+bool isResumable(const SSL_SESSION* session)
+{
+    return SSL_SESSION_is_resumable(session)
+        && SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) > std::time(nullptr);
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+// ServerSessionCache
+
+ServerSessionCache::TicketKey::~TicketKey()
+{
+    OPENSSL_cleanse(hmacKey.data(), hmacKey.size());
+    OPENSSL_cleanse(aesKey.data(), aesKey.size());
+}
+
+ServerSessionCache::ServerSessionCache(
+    std::size_t maxSize,
+    std::chrono::seconds ticketKeyRotationPeriod)
+    :
+    m_maxSize(maxSize),
+    m_ticketKeyRotationPeriod(ticketKeyRotationPeriod)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    rotateTicketKey(lock);
+}
+
+ServerSessionCache::~ServerSessionCache() = default;
+
+void ServerSessionCache::install(SSL_CTX* context)
+{
+    SSL_CTX_set_app_data(context, this);
+
+    SSL_CTX_set_session_cache_mode(
+        context, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+    SSL_CTX_sess_set_new_cb(context, &ServerSessionCache::onNewSession);
+    SSL_CTX_sess_set_get_cb(context, &ServerSessionCache::onGetSession);
+    SSL_CTX_sess_set_remove_cb(context, &ServerSessionCache::onRemoveSession);
+
+    SSL_CTX_set_tlsext_ticket_key_cb(context, &ServerSessionCache::onTicketKey);
+}
+
+void ServerSessionCache::rotateTicketKey()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    rotateTicketKey(lock);
+}
+
+SessionCacheStatistics ServerSessionCache::statistics() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto result = m_statistics;
+    result.size = m_sessions.size();
+    return result;
+}
+
+std::shared_ptr<ServerSessionCache> ServerSessionCache::sharedInstance()
+{
+    static const auto instance = std::make_shared<ServerSessionCache>();
+    return instance;
+}
+
+void ServerSessionCache::rotateTicketKeyIfNeeded(const nx::Locker<nx::Mutex>& lock)
+{
+    if (nx::utils::monotonicTime() - m_currentTicketKey->creationTime >= m_ticketKeyRotationPeriod)
+        rotateTicketKey(lock);
+}
+
+void ServerSessionCache::rotateTicketKey(const nx::Locker<nx::Mutex>& /*lock*/)
+{
+    auto key = std::make_unique<TicketKey>();
+    if (RAND_bytes(key->name.data(), (int) key->name.size()) != 1
+        || RAND_bytes(key->hmacKey.data(), (int) key->hmacKey.size()) != 1
+        || RAND_bytes(key->aesKey.data(), (int) key->aesKey.size()) != 1)
+    {
+        // Keeping the current key. Otherwise, a predictable key could be used.
+        NX_WARNING(this, "Failed to generate a session ticket key");
+        if (m_currentTicketKey)
+            return;
+    }
+    key->creationTime = nx::utils::monotonicTime();
+
+    m_previousTicketKey = std::exchange(m_currentTicketKey, std::move(key));
+
+    NX_DEBUG(this, "Session ticket key rotated");
+}
+
+int ServerSessionCache::initTicketCipher(
+    unsigned char* keyName,
+    unsigned char* iv,
+    EVP_CIPHER_CTX* cipherCtx,
+    HMAC_CTX* hmacCtx,
+    bool encrypt,
+    bool isTls13)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    rotateTicketKeyIfNeeded(lock);
+
+    const TicketKey* key = nullptr;
+    int result = 1;
+    if (encrypt)
+    {
+        key = m_currentTicketKey.get();
+        memcpy(keyName, key->name.data(), key->name.size());
+        if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1)
+            return -1;
+    }
+    else
+    {
+        if (memcmp(keyName, m_currentTicketKey->name.data(), m_currentTicketKey->name.size()) == 0)
+        {
+            key = m_currentTicketKey.get();
+            // TLS 1.3 clients use each ticket once, so the server has to issue a new one.
+            if (isTls13)
+                result = 2;
+        }
+        else if (m_previousTicketKey
+            && memcmp(keyName, m_previousTicketKey->name.data(),
+                m_previousTicketKey->name.size()) == 0)
+        {
+            key = m_previousTicketKey.get();
+            result = 2; //< The ticket has to be renewed.
+        }
+        else
+        {
+            ++m_statistics.misses;
+            return 0; //< Unknown or expired key. The full handshake is needed.
+        }
+        ++m_statistics.hits;
+    }
+
+    if (HMAC_Init_ex(hmacCtx, key->hmacKey.data(), (int) key->hmacKey.size(),
+            EVP_sha256(), nullptr) != 1)
+    {
+        return -1;
+    }
+
+    const int cipherInitResult = encrypt
+        ? EVP_EncryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr, key->aesKey.data(), iv)
+        : EVP_DecryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr, key->aesKey.data(), iv);
+    return cipherInitResult == 1 ? result : -1;
+}
+
+void ServerSessionCache::save(SSL_SESSION* session)
+{
+    unsigned int idLength = 0;
+    const unsigned char* id = SSL_SESSION_get_id(session, &idLength);
+
+    const int serializedSize = i2d_SSL_SESSION(session, nullptr);
+    if (idLength == 0 || serializedSize <= 0)
+        return;
+
+    std::vector<unsigned char> serialized(serializedSize);
+    unsigned char* serializedPtr = serialized.data();
+    i2d_SSL_SESSION(session, &serializedPtr);
+
+    std::string key((const char*) id, idLength);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    if (auto it = m_sessions.find(key); it != m_sessions.end())
+    {
+        m_lru.erase(it->second.lruIter);
+        m_sessions.erase(it);
+    }
+
+    while (!m_lru.empty() && m_sessions.size() >= m_maxSize)
+    {
+        m_sessions.erase(m_lru.front());
+        m_lru.pop_front();
+    }
+
+    m_lru.push_back(key);
+    m_sessions.emplace(std::move(key), Session{std::move(serialized), std::prev(m_lru.end())});
+}
+
+SSL_SESSION* ServerSessionCache::find(const unsigned char* id, int idLength)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto it = m_sessions.find(std::string((const char*) id, idLength));
+    if (it == m_sessions.end())
+    {
+        ++m_statistics.misses;
+        return nullptr;
+    }
+
+    m_lru.splice(m_lru.end(), m_lru, it->second.lruIter);
+
+    const unsigned char* serializedPtr = it->second.serialized.data();
+    SSL_SESSION* session = d2i_SSL_SESSION(
+        nullptr, &serializedPtr, (long) it->second.serialized.size());
+    if (session)
+        ++m_statistics.hits;
+    else
+        ++m_statistics.misses;
+
+    return session;
+}
+
+void ServerSessionCache::remove(SSL_SESSION* session)
+{
+    unsigned int idLength = 0;
+    const unsigned char* id = SSL_SESSION_get_id(session, &idLength);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto it = m_sessions.find(std::string((const char*) id, idLength));
+    if (it == m_sessions.end())
+        return;
+
+    m_lru.erase(it->second.lruIter);
+    m_sessions.erase(it);
+}
+
+int ServerSessionCache::onNewSession(SSL* ssl, SSL_SESSION* session)
+{
+    // TLS 1.3 sessions are resumed by tickets only unless the tickets are disabled.
+    if (SSL_version(ssl) >= TLS1_3_VERSION && (SSL_get_options(ssl) & SSL_OP_NO_TICKET) == 0)
+        return 0;
+
+    static_cast<ServerSessionCache*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))->save(session);
+    return 0; //< The cache keeps a serialized copy, not the reference.
+}
+
+SSL_SESSION* ServerSessionCache::onGetSession(
+    SSL* ssl, const unsigned char* id, int idLength, int* copy)
+{
+    *copy = 0; //< The returned session is a new object, the caller takes its ownership.
+    return static_cast<ServerSessionCache*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+        ->find(id, idLength);
+}
+
+void ServerSessionCache::onRemoveSession(SSL_CTX* context, SSL_SESSION* session)
+{
+    static_cast<ServerSessionCache*>(SSL_CTX_get_app_data(context))->remove(session);
+}
+
+int ServerSessionCache::onTicketKey(
+    SSL* ssl,
+    unsigned char* keyName,
+    unsigned char* iv,
+    EVP_CIPHER_CTX* cipherCtx,
+    HMAC_CTX* hmacCtx,
+    int encrypt)
+{
+    return static_cast<ServerSessionCache*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+        ->initTicketCipher(
+            keyName, iv, cipherCtx, hmacCtx, encrypt == 1, SSL_version(ssl) >= TLS1_3_VERSION);
+}
+
+//-------------------------------------------------------------------------------------------------
+// ClientSessionCache
+
+ClientSessionCache::ClientSessionCache(std::size_t maxSize):
+    m_maxSize(maxSize)
+{
+}
+
+ClientSessionCache::~ClientSessionCache()
+{
+    for (auto& [key, session]: m_sessions)
+        SSL_SESSION_free(session.session);
+}
+
+void ClientSessionCache::install(SSL_CTX* context)
+{
+    SSL_CTX_set_app_data(context, this);
+
+    SSL_CTX_set_session_cache_mode(
+        context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(context, &ClientSessionCache::onNewSession);
+}
+
+bool ClientSessionCache::resume(SSL* ssl, const std::string& key)
+{
+    // The key may have been set by a previous connection attempt.
+    delete static_cast<std::string*>(SSL_get_ex_data(ssl, clientSessionKeyIndex()));
+    SSL_set_ex_data(ssl, clientSessionKeyIndex(), new std::string(key));
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto it = m_sessions.find(key);
+    if (it == m_sessions.end() || !isResumable(it->second.session))
+    {
+        ++m_statistics.misses;
+        return false;
+    }
+
+    m_lru.splice(m_lru.end(), m_lru, it->second.lruIter);
+    if (SSL_set_session(ssl, it->second.session) != 1)
+    {
+        ++m_statistics.misses;
+        return false;
+    }
+
+    ++m_statistics.hits;
+    return true;
+}
+
+void ClientSessionCache::remove(const std::string& key)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto it = m_sessions.find(key);
+    if (it == m_sessions.end())
+        return;
+
+    SSL_SESSION_free(it->second.session);
+    m_lru.erase(it->second.lruIter);
+    m_sessions.erase(it);
+}
+
+SessionCacheStatistics ClientSessionCache::statistics() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto result = m_statistics;
+    result.size = m_sessions.size();
+    return result;
+}
+
+void ClientSessionCache::save(const std::string& key, SSL_SESSION* session)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    if (auto it = m_sessions.find(key); it != m_sessions.end())
+    {
+        // A newer ticket replaces the previous one.
+        SSL_SESSION_free(it->second.session);
+        it->second.session = session;
+        m_lru.splice(m_lru.end(), m_lru, it->second.lruIter);
+        return;
+    }
+
+    while (!m_lru.empty() && m_sessions.size() >= m_maxSize)
+    {
+        auto oldest = m_sessions.find(m_lru.front());
+        SSL_SESSION_free(oldest->second.session);
+        m_sessions.erase(oldest);
+        m_lru.pop_front();
+    }
+
+    m_lru.push_back(key);
+    m_sessions.emplace(key, Session{session, std::prev(m_lru.end())});
+}
+
+int ClientSessionCache::onNewSession(SSL* ssl, SSL_SESSION* session)
+{
+    const auto key = static_cast<const std::string*>(
+        SSL_get_ex_data(ssl, clientSessionKeyIndex()));
+    if (!key)
+        return 0; //< The connection does not use the cache.
+
+    static_cast<ClientSessionCache*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+        ->save(*key, session);
+    return 1; //< The cache has taken the reference.
+}
+
+} // namespace nx::network::ssl
@@ -0,0 +1,191 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <openssl/ssl.h>
+
+#include <nx/reflect/instrument.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::network::ssl {
+
+struct NX_NETWORK_API SessionCacheStatistics
+{
+    /** The number of times a session offered by the client has been found. */
+    std::uint64_t hits = 0;
+
+    /** The number of times the full handshake had to be done since no session was found. */
+    std::uint64_t misses = 0;
+
+    /** The number of sessions in the cache. */
+    std::size_t size = 0;
+};
+
+#define SessionCacheStatistics_Fields (hits)(misses)(size)
+
+NX_REFLECTION_INSTRUMENT(SessionCacheStatistics, SessionCacheStatistics_Fields)
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Server-side TLS session resumption state that can be shared by any number of SSL_CTX objects
+ * and, so, by any number of ssl::Context instances. Consists of:
+ * - Session ticket keys (TLS 1.3 tickets and RFC 5077 tickets for TLS 1.2). The key used to issue
+ * tickets is replaced every ticketKeyRotationPeriod. Tickets issued with the previous key are
+ * still accepted and are renewed.
+ * - Cache of sessions identified by the session id for TLS 1.2 clients that do not support
+ * tickets.
+ * All methods are thread-safe.
+ */
+class NX_NETWORK_API ServerSessionCache
+{
+public:
+    static constexpr std::size_t kDefaultMaxSize = 20'000;
+    static constexpr std::chrono::seconds kDefaultTicketKeyRotationPeriod = std::chrono::hours(1);
+
+    ServerSessionCache(
+        std::size_t maxSize = kDefaultMaxSize,
+        std::chrono::seconds ticketKeyRotationPeriod = kDefaultTicketKeyRotationPeriod);
+    ~ServerSessionCache();
+
+    ServerSessionCache(const ServerSessionCache&) = delete;
+    ServerSessionCache& operator=(const ServerSessionCache&) = delete;
+
+    /**
+     * Makes the server context use this cache.
+     * NOTE: The cache MUST outlive the context.
+     */
+    void install(SSL_CTX* context);
+
+    /**
+     * Issues a new ticket key immediately. The current key becomes the previous one.
+     */
+    void rotateTicketKey();
+
+    SessionCacheStatistics statistics() const;
+
+    /**
+     * @return The cache used by every ssl::Context by default. So, all TLS servers of the process
+     * resume each other's sessions.
+     */
+    static std::shared_ptr<ServerSessionCache> sharedInstance();
+
+private:
+    struct TicketKey
+    {
+        std::array<unsigned char, 16> name{};
+        std::array<unsigned char, 32> hmacKey{};
+        std::array<unsigned char, 32> aesKey{};
+        std::chrono::steady_clock::time_point creationTime;
+
+        ~TicketKey();
+    };
+
+    struct Session
+    {
+        std::vector<unsigned char> serialized;
+        std::list<std::string>::iterator lruIter;
+    };
+
+    const std::size_t m_maxSize;
+    const std::chrono::seconds m_ticketKeyRotationPeriod;
+    mutable nx::Mutex m_mutex;
+    std::unique_ptr<TicketKey> m_currentTicketKey;
+    std::unique_ptr<TicketKey> m_previousTicketKey;
+    std::unordered_map<std::string /*session id*/, Session> m_sessions;
+    /** Session ids, the least recently used first. */
+    std::list<std::string> m_lru;
+    SessionCacheStatistics m_statistics;
+
+    void rotateTicketKeyIfNeeded(const nx::Locker<nx::Mutex>& lock);
+    void rotateTicketKey(const nx::Locker<nx::Mutex>& lock);
+
+    int initTicketCipher(
+        unsigned char* keyName,
+        unsigned char* iv,
+        EVP_CIPHER_CTX* cipherCtx,
+        HMAC_CTX* hmacCtx,
+        bool encrypt,
+        bool isTls13);
+
+    void save(SSL_SESSION* session);
+    SSL_SESSION* find(const unsigned char* id, int idLength);
+    void remove(SSL_SESSION* session);
+
+    static int onNewSession(SSL* ssl, SSL_SESSION* session);
+    static SSL_SESSION* onGetSession(SSL* ssl, const unsigned char* id, int idLength, int* copy);
+    static void onRemoveSession(SSL_CTX* context, SSL_SESSION* session);
+    static int onTicketKey(
+        SSL* ssl,
+        unsigned char* keyName,
+        unsigned char* iv,
+        EVP_CIPHER_CTX* cipherCtx,
+        HMAC_CTX* hmacCtx,
+        int encrypt);
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Client-side cache of TLS sessions. A session is saved under the key specified for the
+ * connection which established it (e.g., the server name and endpoint) and is offered to the
+ * server by the subsequent connections with the same key.
+ * All methods are thread-safe.
+ */
+class NX_NETWORK_API ClientSessionCache
+{
+public:
+    static constexpr std::size_t kDefaultMaxSize = 1'000;
+
+    ClientSessionCache(std::size_t maxSize = kDefaultMaxSize);
+    ~ClientSessionCache();
+
+    ClientSessionCache(const ClientSessionCache&) = delete;
+    ClientSessionCache& operator=(const ClientSessionCache&) = delete;
+
+    /**
+     * Makes the client context save established sessions to this cache.
+     * NOTE: The cache MUST outlive the context.
+     */
+    void install(SSL_CTX* context);
+
+    /**
+     * Offers the session saved under the key to the server and saves sessions established by the
+     * connection under the same key. MUST be called before the handshake.
+     * @return true if a saved session has been found.
+     */
+    bool resume(SSL* ssl, const std::string& key);
+
+    void remove(const std::string& key);
+
+    SessionCacheStatistics statistics() const;
+
+private:
+    struct Session
+    {
+        SSL_SESSION* session = nullptr;
+        std::list<std::string>::iterator lruIter;
+    };
+
+    const std::size_t m_maxSize;
+    mutable nx::Mutex m_mutex;
+    std::unordered_map<std::string /*key*/, Session> m_sessions;
+    /** Keys, the least recently used first. */
+    std::list<std::string> m_lru;
+    SessionCacheStatistics m_statistics;
+
+    void save(const std::string& key, SSL_SESSION* session);
+
+    static int onNewSession(SSL* ssl, SSL_SESSION* session);
+};
+
+} // namespace nx::network::ssl
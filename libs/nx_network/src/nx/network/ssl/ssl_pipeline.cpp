@@ -2,9 +2,12 @@
 
 #include "ssl_pipeline.h"
 
+#include <string_view>
 #include <typeinfo>
 
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
 
 #include <nx/network/aio/basic_pollable.h>
 #include <nx/utils/log/assert.h>
@@ -16,6 +19,42 @@ namespace nx::network::ssl {
 
 static constexpr int kSslExDataThisIndex = 0;
 
+namespace {
+
+/**
+ * HKDF-Expand-Label, see RFC 8446, 7.1.
+ */
+bool hkdfExpandLabel(
+    const EVP_MD* md,
+    const std::vector<unsigned char>& secret,
+    std::string_view label,
+    unsigned char* out,
+    std::size_t outLength)
+{
+    static constexpr std::string_view kLabelPrefix = "tls13 ";
+
+    std::vector<unsigned char> hkdfLabel;
+    hkdfLabel.push_back((unsigned char) (outLength >> 8));
+    hkdfLabel.push_back((unsigned char) outLength);
+    hkdfLabel.push_back((unsigned char) (kLabelPrefix.size() + label.size()));
+    hkdfLabel.insert(hkdfLabel.end(), kLabelPrefix.begin(), kLabelPrefix.end());
+    hkdfLabel.insert(hkdfLabel.end(), label.begin(), label.end());
+    hkdfLabel.push_back(0); //< Empty context.
+
+    auto ctx = utils::wrapUnique(EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr), &EVP_PKEY_CTX_free);
+    std::size_t derivedLength = outLength;
+    return ctx
+        && EVP_PKEY_derive_init(ctx.get()) > 0
+        && EVP_PKEY_CTX_hkdf_mode(ctx.get(), EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0
+        && EVP_PKEY_CTX_set_hkdf_md(ctx.get(), md) > 0
+        && EVP_PKEY_CTX_set1_hkdf_key(ctx.get(), secret.data(), (int) secret.size()) > 0
+        && EVP_PKEY_CTX_add1_hkdf_info(ctx.get(), hkdfLabel.data(), (int) hkdfLabel.size()) > 0
+        && EVP_PKEY_derive(ctx.get(), out, &derivedLength) > 0
+        && derivedLength == outLength;
+}
+
+} // namespace
+
 Pipeline::Pipeline(
     Context* context,
     std::shared_ptr<SSL_CTX> sslContext)
@@ -38,11 +77,50 @@ std::string Pipeline::serverNameFromClientHello() const
     return serverName ? std::string(serverName) : std::string();
 }
 
+void Pipeline::setSessionCacheKey(const std::string& key)
+{
+    NX_ASSERT(m_state == State::init);
+
+    m_sessionCacheKey = key;
+    if (m_context->clientSessionCache()->resume(m_ssl.get(), key))
+        NX_VERBOSE(this, "Offering the saved session %1", key);
+}
+
+bool Pipeline::isSessionReused() const
+{
+    return SSL_session_reused(m_ssl.get()) == 1;
+}
+
+void Pipeline::setAlpnProtocols(const std::vector<std::string>& protocols)
+{
+    NX_ASSERT(m_state == State::init);
+
+    // The wire format: each protocol name is preceded by its length.
+    std::vector<unsigned char> serialized;
+    for (const auto& protocol: protocols)
+    {
+        if (!NX_ASSERT(!protocol.empty() && protocol.size() <= 255, protocol))
+            continue;
+        serialized.push_back((unsigned char) protocol.size());
+        serialized.insert(serialized.end(), protocol.begin(), protocol.end());
+    }
+
+    SSL_set_alpn_protos(m_ssl.get(), serialized.data(), (unsigned int) serialized.size());
+}
+
+std::string Pipeline::alpnProtocol() const
+{
+    const unsigned char* protocol = nullptr;
+    unsigned int length = 0;
+    SSL_get0_alpn_selected(m_ssl.get(), &protocol, &length);
+    return protocol ? std::string(reinterpret_cast<const char*>(protocol), length) : std::string();
+}
+
 int Pipeline::write(const void* data, size_t size)
 {
     NX_TRACE(this, "Write %1 bytes", size);
 
-    if (m_failed)
+    if (m_failed || m_isTxOffloaded)
     {
         SystemError::setLastErrorCode(SystemError::invalidData);
         return utils::bstream::StreamIoError::nonRecoverableError;
@@ -156,6 +234,100 @@ void Pipeline::resumeDataProcessing()
     m_isPaused = false;
 }
 
+void Pipeline::enableTxStateExport()
+{
+    NX_ASSERT(m_state == State::init);
+
+    m_isTxStateExportEnabled = true;
+    SSL_set_msg_callback(m_ssl.get(), &Pipeline::onSslMessage);
+    SSL_set_msg_callback_arg(m_ssl.get(), this);
+}
+
+std::optional<TlsTxState> Pipeline::exportTxState()
+{
+    if (!m_isTxStateExportEnabled || m_state < State::handshakeDone
+        || !m_isApplicationTxKeyInUse || m_txTrafficSecret.empty()
+        || SSL_version(m_ssl.get()) != TLS1_3_VERSION)
+    {
+        return std::nullopt;
+    }
+
+    const SSL_CIPHER* cipher = SSL_get_current_cipher(m_ssl.get());
+    if (!cipher)
+        return std::nullopt;
+
+    TlsTxState state;
+    switch (SSL_CIPHER_get_protocol_id(cipher))
+    {
+        case 0x1301: //< TLS_AES_128_GCM_SHA256.
+            state.cipher = TlsTxState::Cipher::aes128Gcm;
+            state.key.resize(16);
+            break;
+
+        case 0x1302: //< TLS_AES_256_GCM_SHA384.
+            state.cipher = TlsTxState::Cipher::aes256Gcm;
+            state.key.resize(32);
+            break;
+
+        default:
+            NX_VERBOSE(this, "Cipher %1 cannot be exported", SSL_CIPHER_get_name(cipher));
+            return std::nullopt;
+    }
+
+    const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+    if (!md
+        || !hkdfExpandLabel(md, m_txTrafficSecret, "key", state.key.data(), state.key.size())
+        || !hkdfExpandLabel(md, m_txTrafficSecret, "iv", state.iv.data(), state.iv.size()))
+    {
+        NX_DEBUG(this, "Failed to derive the traffic key");
+        return std::nullopt;
+    }
+
+    state.recordSequenceNumber = m_applicationTxRecordCount;
+    return state;
+}
+
+void Pipeline::setTxOffloaded()
+{
+    m_isTxOffloaded = true;
+
+    OPENSSL_cleanse(m_txTrafficSecret.data(), m_txTrafficSecret.size());
+    m_txTrafficSecret.clear();
+}
+
+bool Pipeline::isTxOffloaded() const
+{
+    return m_isTxOffloaded;
+}
+
+void Pipeline::saveTrafficSecret(const SSL* ssl, const char* line)
+{
+    auto pipeline = static_cast<Pipeline*>(SSL_get_ex_data(ssl, kSslExDataThisIndex));
+    if (!pipeline || !pipeline->m_isTxStateExportEnabled)
+        return;
+
+    // The line format is "<label> <client random> <secret>", all values are hex-encoded.
+    const std::string_view label =
+        SSL_is_server(ssl) ? "SERVER_TRAFFIC_SECRET_0 " : "CLIENT_TRAFFIC_SECRET_0 ";
+    const std::string_view str(line);
+    if (str.substr(0, label.size()) != label)
+        return;
+
+    const auto secretPos = str.find(' ', label.size());
+    if (secretPos == std::string_view::npos)
+        return;
+
+    long secretLength = 0;
+    auto secret = utils::wrapUnique(
+        OPENSSL_hexstr2buf(line + secretPos + 1, &secretLength),
+        [](unsigned char* ptr) { OPENSSL_free(ptr); });
+    if (!secret)
+        return;
+
+    pipeline->m_txTrafficSecret.assign(secret.get(), secret.get() + secretLength);
+    OPENSSL_cleanse(secret.get(), secretLength);
+}
+
 SSL* Pipeline::ssl()
 {
     return m_ssl.get();
@@ -224,11 +396,20 @@ int Pipeline::performSslIoOperation(Func sslFunc, Data* data, size_t size)
 
 int Pipeline::performHandshakeInternal()
 {
+    if (m_isResumedSessionRejected)
+        return -1;
+
     ERR_clear_error();
 
     const int resultCode = SSL_do_handshake(m_ssl.get());
     if (resultCode == 1)
     {
+        if (!verifyResumedSession())
+        {
+            m_isResumedSessionRejected = true;
+            return -1;
+        }
+
         m_state = State::handshakeDone;
         bool expected = true;
         if (m_isPausePending.compare_exchange_strong(expected, false))
@@ -242,6 +423,26 @@ int Pipeline::performHandshakeInternal()
     return resultCode == 0 ? -1 : resultCode;
 }
 
+bool Pipeline::verifyResumedSession()
+{
+    // The chain of a new session is verified by OpenSSL during the handshake.
+    if (!m_sessionCacheKey || !m_verifyCertificateChainCallback || !isSessionReused())
+        return true;
+
+    CertificateChainView chain;
+    STACK_OF(X509)* osslChain = SSL_get_peer_cert_chain(m_ssl.get());
+    const int certCount = osslChain ? sk_X509_num(osslChain) : 0;
+    for (int i = 0; i < certCount; i++)
+        chain.push_back(sk_X509_value(osslChain, i));
+
+    if (!chain.empty() && m_verifyCertificateChainCallback(std::move(chain)))
+        return true;
+
+    NX_DEBUG(this, "Certificate chain of the resumed session %1 is rejected", *m_sessionCacheKey);
+    m_context->clientSessionCache()->remove(*m_sessionCacheKey);
+    return false;
+}
+
 int Pipeline::bioRead(void* buffer, unsigned int bufferLen)
 {
     const auto resultCode = m_inputStream->read(buffer, bufferLen);
@@ -251,6 +452,14 @@ int Pipeline::bioRead(void* buffer, unsigned int bufferLen)
 
 int Pipeline::bioWrite(const void* buffer, unsigned int bufferLen)
 {
+    if (m_isTxOffloaded)
+    {
+        NX_DEBUG(this, "A record cannot be sent since the sending direction is offloaded");
+        m_failed = true;
+        SystemError::setLastErrorCode(SystemError::invalidData);
+        return utils::bstream::StreamIoError::osError;
+    }
+
     const auto resultCode = m_outputStream->write(buffer, bufferLen);
     m_writeThirsty = (resultCode == utils::bstream::StreamIoError::wouldBlock) || (resultCode == 0);
     return resultCode;
@@ -261,6 +470,14 @@ int Pipeline::handleSslIoResult(int resultCode)
     if (resultCode >= 0)
         return resultCode;
 
+    if (m_isResumedSessionRejected)
+    {
+        m_eof = true;
+        m_failed = true;
+        SystemError::setLastErrorCode(SystemError::sslHandshakeError);
+        return utils::bstream::StreamIoError::nonRecoverableError;
+    }
+
     const auto sslErrorCode = SSL_get_error(m_ssl.get(), resultCode);
     if (sslErrorCode == SSL_ERROR_WANT_READ || sslErrorCode == SSL_ERROR_WANT_WRITE)
         NX_TRACE(this, "SSL error %1", sslErrorCodeToString(sslErrorCode));
@@ -482,6 +699,40 @@ int Pipeline::verifyServerCertificateCallback(int /*preverifyOk*/, X509_STORE_CT
     return 1;
 }
 
+void Pipeline::onSslMessage(
+    int writeP, int /*version*/, int contentType, const void* buf, size_t len,
+    SSL* /*ssl*/, void* arg)
+{
+    if (!writeP)
+        return;
+
+    auto pipeline = static_cast<Pipeline*>(arg);
+    if (contentType == SSL3_RT_HEADER)
+    {
+        // The header of a record is reported before the handshake messages it carries.
+        if (pipeline->m_isApplicationTxKeyInUse)
+            ++pipeline->m_applicationTxRecordCount;
+        return;
+    }
+
+    if (contentType != SSL3_RT_HANDSHAKE || len == 0)
+        return;
+
+    switch (static_cast<const unsigned char*>(buf)[0])
+    {
+        case SSL3_MT_FINISHED:
+            // TLS 1.3 switches to the application traffic key right after the Finished message.
+            pipeline->m_isApplicationTxKeyInUse = true;
+            pipeline->m_applicationTxRecordCount = 0;
+            break;
+
+        case SSL3_MT_KEY_UPDATE:
+            // The traffic secret is not known anymore.
+            pipeline->m_txTrafficSecret.clear();
+            break;
+    }
+}
+
 int Pipeline::verifyEarlyData(SSL* /*s*/, void* /*arg*/)
 {
     // TLSv1.3 0-RTT is disabled for now.
@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <openssl/ssl.h>
 
@@ -12,6 +15,7 @@
 
 #include "certificate.h"
 #include "helpers.h"
+#include "kernel_tls.h"
 
 namespace nx::network::aio { class BasicPollable; }
 
@@ -53,6 +57,30 @@ public:
 
     std::string serverNameFromClientHello() const;
 
+    /**
+     * Makes the client connection offer the session saved in Context::clientSessionCache() under
+     * the key and save the sessions it establishes there. MUST be invoked before the handshake.
+     * If the session is resumed, the certificate chain it has been established with is verified
+     * again since the verification callback may differ from the one used before.
+     */
+    void setSessionCacheKey(const std::string& key);
+
+    /**
+     * @return true if the handshake has resumed a previously established session.
+     */
+    bool isSessionReused() const;
+
+    /**
+     * Makes ClientHello offer the application protocols (RFC 7301), the most preferred first.
+     * MUST be invoked before the handshake.
+     */
+    void setAlpnProtocols(const std::vector<std::string>& protocols);
+
+    /**
+     * @return The application protocol agreed on during the handshake. Empty if none.
+     */
+    std::string alpnProtocol() const;
+
     /**
      * NOTE: SSL pipeline does not recover from any I/O error because openssl supports
      * retrying write only with the same data. That does not conform to
@@ -98,6 +126,33 @@ public:
      */
     void resumeDataProcessing();
 
+    /**
+     * Makes the pipeline remember what is needed to continue encrypting the outgoing data outside
+     * of OpenSSL after the handshake. Must be invoked before the handshake is started.
+     */
+    void enableTxStateExport();
+
+    /**
+     * @return The state of the sending direction if the session allows it to be handed over to
+     * another TLS implementation (e.g., the kernel): the handshake is completed, TLS 1.3 with
+     * AES-GCM is used and keys have not been updated. Nothing otherwise.
+     * NOTE: The state is valid only if every record written by the pipeline has been sent.
+     */
+    std::optional<TlsTxState> exportTxState();
+
+    /**
+     * Tells the pipeline that the outgoing records are produced by someone else now.
+     * After that, write() fails. If OpenSSL needs to send something by itself (e.g., an alert or
+     * a KeyUpdate), the sending direction is considered failed since there is no way to insert
+     * a record into the sequence produced by the other TLS implementation.
+     */
+    void setTxOffloaded();
+
+    bool isTxOffloaded() const;
+
+    /** SSL_CTX_keylog_cb_func. Must be installed to every SSL_CTX used with the pipeline. */
+    static void saveTrafficSecret(const SSL* ssl, const char* line);
+
 protected:
     SSL* ssl();
 
@@ -120,12 +175,21 @@ private:
     std::atomic<bool> m_isPausePending = false;
     std::atomic<bool> m_isPaused = false;
     nx::utils::MoveOnlyFunc<void()> m_onIoPausedAfterHandshake;
+    bool m_isTxStateExportEnabled = false;
+    std::vector<unsigned char> m_txTrafficSecret;
+    /** true after the Finished message is sent, so that the application traffic key is in use. */
+    bool m_isApplicationTxKeyInUse = false;
+    std::uint64_t m_applicationTxRecordCount = 0;
+    bool m_isTxOffloaded = false;
+    std::optional<std::string> m_sessionCacheKey;
+    bool m_isResumedSessionRejected = false;
 
     void initSslBio(std::shared_ptr<SSL_CTX> sslContext);
 
     template<typename Func, typename Data>
     int performSslIoOperation(Func sslFunc, Data* data, size_t size);
     int performHandshakeInternal();
+    bool verifyResumedSession();
     int bioRead(void* buffer, unsigned int bufferLen);
     int bioWrite(const void* buffer, unsigned int bufferLen);
 
@@ -142,6 +206,11 @@ private:
     static int verifyServerCertificateCallback(int preverify_ok, X509_STORE_CTX* x509_ctx);
     static int verifyServerChainCallback(X509_STORE_CTX* x509_ctx);
 
+    /** The SSL_set_msg_callback callback. Counts the records sent with the actual key. */
+    static void onSslMessage(
+        int writeP, int version, int contentType, const void* buf, size_t len,
+        SSL* ssl, void* arg);
+
     /** SSL_allow_early_data_cb_fn. */
     static int verifyEarlyData(SSL* s, void* arg);
 };
@@ -2,12 +2,16 @@
 
 #include "ssl_stream_socket.h"
 
+#include <algorithm>
+
 #include <nx/network/socket_global.h>
 #include <nx/utils/log/log.h>
 
 #include "../aio/async_channel_adapter.h"
 #include "../nx_network_ini.h"
+#include "../system_socket.h"
 #include "helpers.h"
+#include "kernel_tls.h"
 
 namespace nx::network::ssl {
 
@@ -131,6 +135,12 @@ StreamSocket::StreamSocket(
         setSyncVerifyCertificateChainCallback(std::move(verifyChainCallback));
     }
 
+    if (ini().useKernelTls && kernel_tls::isSupported())
+    {
+        m_sslPipeline->enableTxStateExport();
+        m_kernelTlsState = KernelTlsState::undecided;
+    }
+
     m_proxyConverter.setDelegate(m_sslPipeline.get());
     m_asyncTransformingChannel = std::make_unique<aio::StreamTransformingAsyncChannel>(
         aio::makeAsyncChannelAdapter(m_delegate.get()),
@@ -150,6 +160,8 @@ StreamSocket::StreamSocket(
 
 StreamSocket::~StreamSocket()
 {
+    if (m_kernelTlsState == KernelTlsState::enabled)
+        --nx::network::SocketGlobals::instance().debugCounters().kernelTlsSocketCount;
     --nx::network::SocketGlobals::instance().debugCounters().sslSocketCount;
     SocketGlobals::instance().allocationAnalyzer().recordObjectDestruction(this);
 }
@@ -201,10 +213,7 @@ bool StreamSocket::connect(
         return false;
 
     switchToSyncModeIfNeeded();
-    if (m_serverName)
-        m_sslPipeline->setServerName(*m_serverName);
-    else
-        m_sslPipeline->setServerName(endpoint.address.toString());
+    setServerNameAndSessionCacheKey(endpoint);
 
     if (timeout != kNoTimeout)
     {
@@ -258,10 +267,7 @@ void StreamSocket::connectAsync(
             if (connectResultCode != SystemError::noError)
                 return handler(connectResultCode);
 
-            if (m_serverName)
-                m_sslPipeline->setServerName(*m_serverName);
-            else
-                m_sslPipeline->setServerName(endpoint.address.toString());
+            setServerNameAndSessionCacheKey(endpoint);
             handshakeAsync(std::move(handler));
         });
 }
@@ -284,6 +290,9 @@ int StreamSocket::recv(void* buffer, std::size_t bufferLen, int flags)
 
 int StreamSocket::send(const void* buffer, std::size_t bufferLen)
 {
+    if (switchToKernelTlsIfPossible())
+        return m_delegate->send(buffer, bufferLen);
+
     switchToSyncModeIfNeeded();
     const int result = m_sslPipeline->write(buffer, bufferLen);
     if (result >= 0)
@@ -304,6 +313,12 @@ void StreamSocket::sendAsync(
     const nx::Buffer* buffer,
     IoCompletionHandler handler)
 {
+    if (m_kernelTlsState == KernelTlsState::enabled
+        || (isInSelfAioThread() && switchToKernelTlsIfPossible()))
+    {
+        return m_delegate->sendAsync(buffer, std::move(handler));
+    }
+
     switchToAsyncModeIfNeeded();
     m_asyncTransformingChannel->sendAsync(
         buffer,
@@ -317,11 +332,83 @@ void StreamSocket::sendAsync(
         });
 }
 
+void StreamSocket::sendGatheredAsync(
+    std::vector<const nx::Buffer*> buffers,
+    IoCompletionHandler handler)
+{
+    if (m_kernelTlsState == KernelTlsState::enabled
+        || (isInSelfAioThread() && switchToKernelTlsIfPossible()))
+    {
+        return m_delegate->sendGatheredAsync(std::move(buffers), std::move(handler));
+    }
+
+    buffers.erase(
+        std::remove_if(
+            buffers.begin(), buffers.end(),
+            [](const nx::Buffer* buffer) { return buffer->empty(); }),
+        buffers.end());
+
+    if (buffers.empty())
+    {
+        post([handler = std::move(handler)]() mutable { handler(SystemError::noError, 0); });
+        return;
+    }
+
+    sendNextGatheredBuffer(std::move(buffers), 0, 0, std::move(handler));
+}
+
+void StreamSocket::sendGatheredAsync(
+    const nx::BufferChain* chain,
+    IoCompletionHandler handler)
+{
+    if (m_kernelTlsState == KernelTlsState::enabled
+        || (isInSelfAioThread() && switchToKernelTlsIfPossible()))
+    {
+        return m_delegate->sendGatheredAsync(chain, std::move(handler));
+    }
+
+    base_type::sendGatheredAsync(chain, std::move(handler));
+}
+
+void StreamSocket::sendNextGatheredBuffer(
+    std::vector<const nx::Buffer*> buffers,
+    std::size_t bufferIndex,
+    std::size_t bytesSent,
+    IoCompletionHandler handler)
+{
+    const nx::Buffer* buffer = buffers[bufferIndex];
+    sendAsync(
+        buffer,
+        [this, buffers = std::move(buffers), bufferIndex, bytesSent,
+            handler = std::move(handler)](
+                SystemError::ErrorCode resultCode, std::size_t bytesTransferred) mutable
+        {
+            if (resultCode != SystemError::noError)
+                return handler(resultCode, bytesSent);
+
+            bytesSent += bytesTransferred;
+            if (bufferIndex + 1 == buffers.size())
+                return handler(SystemError::noError, bytesSent);
+
+            sendNextGatheredBuffer(
+                std::move(buffers), bufferIndex + 1, bytesSent, std::move(handler));
+        });
+}
+
 bool StreamSocket::isConnected() const
 {
     return base_type::isConnected() && !m_sslPipeline->failed() && !m_sslPipeline->eof();
 }
 
+bool StreamSocket::getConnectionStatistics(StreamSocketInfo* info)
+{
+    if (!base_type::getConnectionStatistics(info))
+        return false;
+
+    info->isTlsOffloaded = isKernelTlsEnabled();
+    return true;
+}
+
 bool StreamSocket::isEncryptionEnabled() const
 {
     return true;
@@ -437,6 +524,61 @@ void StreamSocket::setServerName(const std::string& serverName)
         m_sslPipeline->setServerName(serverName);
 }
 
+void StreamSocket::setSessionCacheKey(const std::string& key)
+{
+    m_sessionCacheKey = key;
+}
+
+bool StreamSocket::isSessionReused() const
+{
+    return m_sslPipeline->isSessionReused();
+}
+
+void StreamSocket::setAlpnProtocols(const std::vector<std::string>& protocols)
+{
+    m_sslPipeline->setAlpnProtocols(protocols);
+}
+
+std::string StreamSocket::alpnProtocol() const
+{
+    return m_sslPipeline->alpnProtocol();
+}
+
+void StreamSocket::setServerNameAndSessionCacheKey(const SocketAddress& endpoint)
+{
+    const auto serverName = m_serverName ? *m_serverName : endpoint.address.toString();
+    m_sslPipeline->setServerName(serverName);
+    m_sslPipeline->setSessionCacheKey(
+        m_sessionCacheKey ? *m_sessionCacheKey : serverName + "/" + endpoint.toString());
+}
+
+bool StreamSocket::isKernelTlsEnabled() const
+{
+    return m_kernelTlsState == KernelTlsState::enabled;
+}
+
+bool StreamSocket::isSendFileAvailable() const
+{
+    return TCPSocket::isSendFileSupported()
+        && isKernelTlsEnabled()
+        && dynamic_cast<TCPSocket*>(m_delegate.get()) != nullptr;
+}
+
+void StreamSocket::sendFileAsync(const FileRegion& region, IoCompletionHandler handler)
+{
+    if (!isSendFileAvailable())
+    {
+        post(
+            [handler = std::move(handler)]() mutable
+            {
+                handler(SystemError::notImplemented, 0);
+            });
+        return;
+    }
+
+    static_cast<TCPSocket*>(m_delegate.get())->sendFileAsync(region, std::move(handler));
+}
+
 void StreamSocket::cancelIoInAioThread(nx::network::aio::EventType eventType)
 {
     // Performing handshake (part of connect) and cancellation of connect has been requested?
@@ -455,6 +597,48 @@ void StreamSocket::cancelIoInAioThread(nx::network::aio::EventType eventType)
     m_asyncTransformingChannel->cancelIOSync(eventType);
 }
 
+bool StreamSocket::switchToKernelTlsIfPossible()
+{
+    if (m_kernelTlsState != KernelTlsState::undecided)
+        return m_kernelTlsState == KernelTlsState::enabled;
+
+    // Records already generated by OpenSSL have to reach the socket before the kernel starts
+    // producing its own ones. Otherwise, the record sequence is broken.
+    if (!m_sslPipeline->isHandshakeCompleted()
+        || m_sslPipeline->isWriteThirsty()
+        || !m_asyncTransformingChannel->isSendQueueEmpty())
+    {
+        return false;
+    }
+
+    m_kernelTlsState = KernelTlsState::unavailable;
+
+    int protocol = 0;
+    if (!m_delegate->getProtocol(&protocol) || protocol != Protocol::tcp)
+        return false;
+
+    const auto txState = m_sslPipeline->exportTxState();
+    if (!txState)
+    {
+        NX_VERBOSE(this, "Kernel TLS cannot be used with the negotiated session parameters");
+        return false;
+    }
+
+    if (const auto resultCode = kernel_tls::enableTx(m_delegate->handle(), *txState);
+        resultCode != SystemError::noError)
+    {
+        NX_DEBUG(this, "Failed to enable kernel TLS. %1", SystemError::toString(resultCode));
+        return false;
+    }
+
+    m_sslPipeline->setTxOffloaded();
+    m_kernelTlsState = KernelTlsState::enabled;
+    ++nx::network::SocketGlobals::instance().debugCounters().kernelTlsSocketCount;
+
+    NX_VERBOSE(this, "Sending through the kernel TLS");
+    return true;
+}
+
 void StreamSocket::startHandshakeTimer(std::chrono::milliseconds timout)
 {
     m_handshakeTimer.start(
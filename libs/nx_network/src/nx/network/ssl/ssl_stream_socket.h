@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <optional>
@@ -132,8 +133,25 @@ public:
         const nx::Buffer* buffer,
         IoCompletionHandler handler) override;
 
+    /**
+     * Encrypts and sends the buffers one after another without concatenating them.
+     */
+    virtual void sendGatheredAsync(
+        std::vector<const nx::Buffer*> buffers,
+        IoCompletionHandler handler) override;
+
+    /**
+     * Copies the chain to a single buffer unless kernel TLS is used: the data is copied for
+     * encryption anyway.
+     */
+    virtual void sendGatheredAsync(
+        const nx::BufferChain* chain,
+        IoCompletionHandler handler) override;
+
     virtual bool isConnected() const override;
 
+    virtual bool getConnectionStatistics(StreamSocketInfo* info) override;
+
     virtual bool isEncryptionEnabled() const override;
 
     virtual void handshakeAsync(
@@ -145,10 +163,60 @@ public:
     void setAsyncVerifyCertificateChainCallback(VerifyCertificateChainCallbackAsync func);
     void setServerName(const std::string& serverName);
 
+    /**
+     * Client connections offer the session last established with the same key. By default, the
+     * key is made of the server name and the endpoint. A custom key allows resuming sessions with
+     * any server sharing the session ticket keys (e.g., any node of a cluster).
+     * MUST be invoked before connecting.
+     */
+    void setSessionCacheKey(const std::string& key);
+
+    /**
+     * @return true if the handshake has resumed a session established before.
+     */
+    bool isSessionReused() const;
+
+    /**
+     * Client connections offer the application protocols (ALPN, RFC 7301) in the given order of
+     * preference. The server side agrees on one of Context::alpnProtocols().
+     * MUST be invoked before connecting.
+     */
+    void setAlpnProtocols(const std::vector<std::string>& protocols);
+
+    /**
+     * @return The application protocol agreed on during the handshake (e.g., "h2"). Empty if
+     * ALPN has not been used.
+     */
+    std::string alpnProtocol() const;
+
+    /**
+     * @return true if the sending direction has been handed over to the kernel TLS.
+     * If ini().useKernelTls is set, that is done on the first send after the handshake.
+     */
+    bool isKernelTlsEnabled() const;
+
+    /**
+     * @return true if sendFileAsync() can be used.
+     */
+    bool isSendFileAvailable() const;
+
+    /**
+     * Sends the file region through the kernel TLS without copying it to the user space.
+     * Fails with SystemError::notImplemented if isSendFileAvailable() is false.
+     */
+    void sendFileAsync(const FileRegion& region, IoCompletionHandler handler);
+
 protected:
     virtual void cancelIoInAioThread(nx::network::aio::EventType eventType) override;
 
 private:
+    enum class KernelTlsState
+    {
+        undecided,
+        enabled,
+        unavailable,
+    };
+
     std::unique_ptr<aio::StreamTransformingAsyncChannel> m_asyncTransformingChannel;
     std::unique_ptr<AbstractStreamSocket> m_delegate;
     std::unique_ptr<ssl::Pipeline> m_sslPipeline;
@@ -160,10 +228,20 @@ private:
     std::optional<unsigned int> m_recvTimeoutBak;
     std::optional<unsigned int> m_sendTimeoutBak;
     std::optional<std::string> m_serverName;
+    std::optional<std::string> m_sessionCacheKey;
     std::variant<VerifyCertificateChainCallbackSync,
         VerifyCertificateChainCallbackAsync> m_verifyCertificateChainCallback;
     nx::utils::AsyncOperationGuard m_asyncOperationGuard;
+    std::atomic<KernelTlsState> m_kernelTlsState = KernelTlsState::unavailable;
 
+    /**
+     * Hands the sending direction over to the kernel TLS if it has been requested, the handshake
+     * is done and every record produced by OpenSSL has been sent.
+     * @return true if the kernel TLS is used for sending.
+     */
+    bool switchToKernelTlsIfPossible();
+
+    void setServerNameAndSessionCacheKey(const SocketAddress& endpoint);
     void startHandshakeTimer(std::chrono::milliseconds timout);
     void doHandshake();
 
@@ -174,6 +252,12 @@ private:
 
     void handleSslError(int sslPipelineResultCode);
 
+    void sendNextGatheredBuffer(
+        std::vector<const nx::Buffer*> buffers,
+        std::size_t bufferIndex,
+        std::size_t bytesSent,
+        IoCompletionHandler handler);
+
     bool saveTimeouts();
     bool restoreTimeouts();
 
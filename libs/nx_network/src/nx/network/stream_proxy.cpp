@@ -7,6 +7,12 @@
 #include <nx/network/socket_factory.h>
 #include <nx/utils/thread/barrier_handler.h>
 
+#if defined(__linux__) && !defined(__ANDROID__)
+    #include <nx/network/aio/splice_channel_bridge_linux.h>
+#endif
+
+#include "nx_network_ini.h"
+
 namespace nx::network {
 
 StreamProxy::StreamProxy():
@@ -62,6 +68,19 @@ void StreamProxy::closeAllConnectionsAsync()
     stopProxyChannels([]() {});
 }
 
+std::vector<StreamProxyConnectionStatistics> StreamProxy::connectionStatistics() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    std::vector<StreamProxyConnectionStatistics> result;
+    for (const auto& proxyChannel: m_proxyChannels)
+    {
+        if (auto statistics = proxyChannel->statistics())
+            result.push_back(std::move(*statistics));
+    }
+    return result;
+}
+
 void StreamProxy::onAcceptCompletion(
     SystemError::ErrorCode systemErrorCode,
     std::unique_ptr<AbstractStreamSocket> connection)
@@ -223,6 +242,16 @@ void StreamProxyPool::setConnectToDestinationTimeout(
     m_connectToDestinationTimeout = timeout;
 }
 
+std::vector<StreamProxyConnectionStatistics> StreamProxyPool::connectionStatistics(
+    int proxyId) const
+{
+    auto proxyIter = m_proxies.find(proxyId);
+    if (proxyIter == m_proxies.end())
+        return {};
+
+    return proxyIter->second->connectionStatistics();
+}
+
 //-------------------------------------------------------------------------------------------------
 // detail::StreamProxyChannel.
 
@@ -233,6 +262,7 @@ StreamProxyChannel::StreamProxyChannel(
     const SocketAddress& destinationEndpoint)
     :
     m_sourceConnection(std::move(sourceConnection)),
+    m_sourceEndpoint(m_sourceConnection->getForeignAddress()),
     m_destinationEndpoint(destinationEndpoint)
 {
     bindToAioThread(m_sourceConnection->getAioThread());
@@ -277,7 +307,16 @@ void StreamProxyChannel::start(ProxyCompletionHandler completionHandler)
 {
     m_completionHandler = std::move(completionHandler);
 
-    m_destinationConnection = SocketFactory::createStreamSocket(ssl::kAcceptAnyCertificate);
+    // A cloud socket is needed for a cloud address only. A plain TCP socket allows forwarding
+    // the traffic without copying it to the user space.
+    const auto& destinationHost = m_destinationEndpoint.address;
+    m_destinationConnection = SocketFactory::createStreamSocket(
+        ssl::kAcceptAnyCertificate,
+        /*sslRequired*/ false,
+        destinationHost.isIpAddress()
+            ? NatTraversalSupport::disabled
+            : NatTraversalSupport::enabled,
+        destinationHost.isPureIpV6() ? std::make_optional(AF_INET6) : std::nullopt);
     m_destinationConnection->bindToAioThread(getAioThread());
 
     if (!tuneDestinationConnectionAttributes())
@@ -308,11 +347,32 @@ bool StreamProxyChannel::tuneDestinationConnectionAttributes()
     return true;
 }
 
+std::optional<StreamProxyConnectionStatistics> StreamProxyChannel::statistics() const
+{
+    NX_MUTEX_LOCKER lock(&m_bridgeMutex);
+
+    if (!m_bridge)
+        return std::nullopt;
+
+    StreamProxyConnectionStatistics result;
+    result.source = m_sourceEndpoint;
+    result.destination = m_destinationEndpoint;
+    result.zeroCopy = m_isZeroCopy;
+    result.upStreamBytes = m_bridge->leftToRightBytes();
+    result.downStreamBytes = m_bridge->rightToLeftBytes();
+    return result;
+}
+
 void StreamProxyChannel::stopWhileInAioThread()
 {
     m_sourceConnection.reset();
     m_destinationConnection.reset();
-    m_bridge.reset();
+
+    std::unique_ptr<aio::AsyncChannelBridge> bridge;
+    {
+        NX_MUTEX_LOCKER lock(&m_bridgeMutex);
+        bridge = std::exchange(m_bridge, nullptr);
+    }
 }
 
 void StreamProxyChannel::onConnectToTargetCompletion(
@@ -326,13 +386,34 @@ void StreamProxyChannel::onConnectToTargetCompletion(
         return;
     }
 
-    m_bridge = aio::makeAsyncChannelBridge(
+    auto bridge = createBridge();
+    bridge->start(
+        [this](auto&&... args) { onBridgeCompleted(std::move(args)...); });
+
+    NX_MUTEX_LOCKER lock(&m_bridgeMutex);
+    m_bridge = std::move(bridge);
+}
+
+std::unique_ptr<aio::AsyncChannelBridge> StreamProxyChannel::createBridge()
+{
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (!m_upStreamConverter && !m_downStreamConverter && ini().useSpliceInStreamProxy)
+    {
+        if (auto bridge = aio::SpliceChannelBridge::create(
+            &m_sourceConnection, &m_destinationConnection))
+        {
+            NX_VERBOSE(this, "Proxy to %1. Forwarding with splice", m_destinationEndpoint);
+            m_isZeroCopy = true;
+            return bridge;
+        }
+    }
+#endif
+
+    return aio::makeAsyncChannelBridge(
         std::make_unique<aio::StreamTransformingAsyncChannel>(
             aio::makeAsyncChannelAdapter(std::move(m_sourceConnection)),
             &m_converter),
         std::move(m_destinationConnection));
-    m_bridge->start(
-        [this](auto&&... args) { onBridgeCompleted(std::move(args)...); });
 }
 
 void StreamProxyChannel::onBridgeCompleted(
@@ -3,8 +3,10 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <optional>
 #include <vector>
 
 #include <nx/network/aio/timer.h>
@@ -19,6 +21,16 @@ namespace nx::network {
 
 namespace detail { class StreamProxyChannel; }
 
+struct StreamProxyConnectionStatistics
+{
+    SocketAddress source;
+    SocketAddress destination;
+    /** The traffic is moved between the sockets in the kernel (splice). */
+    bool zeroCopy = false;
+    std::uint64_t upStreamBytes = 0;
+    std::uint64_t downStreamBytes = 0;
+};
+
 /**
  * Proxies byte stream from socket acceptor to a destination address.
  * Accepts connections on a server socket.
@@ -72,6 +84,12 @@ public:
 
     void closeAllConnectionsAsync();
 
+    /**
+     * @return Statistics of the connections being proxied. The connection to the destination is
+     * not counted until established.
+     */
+    std::vector<StreamProxyConnectionStatistics> connectionStatistics() const;
+
 private:
     using StreamProxyChannels =
         std::list<std::unique_ptr<detail::StreamProxyChannel>>;
@@ -140,6 +158,11 @@ public:
     void setConnectToDestinationTimeout(
         std::optional<std::chrono::milliseconds> timeout);
 
+    /**
+     * @param proxyId ID provided by StreamProxyPool::addProxy call.
+     */
+    std::vector<StreamProxyConnectionStatistics> connectionStatistics(int proxyId) const;
+
     template<typename T>
     // requires std::is_base_of<T, nx::utils::bstream::AbstractOutputConverter>::value
     void setUpStreamConverter()
@@ -207,14 +230,23 @@ public:
 
     void start(ProxyCompletionHandler completionHandler);
 
+    /**
+     * Thread-safe.
+     * @return std::nullopt if the data is not being forwarded.
+     */
+    std::optional<StreamProxyConnectionStatistics> statistics() const;
+
 protected:
     virtual void stopWhileInAioThread() override;
 
 private:
     std::unique_ptr<AbstractStreamSocket> m_sourceConnection;
+    const SocketAddress m_sourceEndpoint;
     const SocketAddress m_destinationEndpoint;
     std::unique_ptr<AbstractStreamSocket> m_destinationConnection;
+    mutable nx::Mutex m_bridgeMutex;
     std::unique_ptr<aio::AsyncChannelBridge> m_bridge;
+    bool m_isZeroCopy = false;
     ProxyCompletionHandler m_completionHandler;
     std::optional<std::chrono::milliseconds> m_connectTimeout;
     nx::utils::bstream::CompositeConverter m_converter;
@@ -227,6 +259,8 @@ private:
 
     void onConnectToTargetCompletion(SystemError::ErrorCode systemErrorCode);
 
+    std::unique_ptr<aio::AsyncChannelBridge> createBridge();
+
     void onBridgeCompleted(SystemError::ErrorCode completionCode);
 };
 
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <deque>
 
+#include <nx/utils/crc32.h>
 #include <nx/utils/qnbytearrayref.h>
 #include <nx/utils/string.h>
 
@@ -93,7 +94,7 @@ void MessageParser::reset()
     m_messageBytesParsed = 0;
     m_cache.clear();
 
-    m_currentMessageCrc32 = boost::crc_32_type{};
+    m_currentMessageCrc32 = 0;
     m_fingerprintFound = false;
 }
 
@@ -615,7 +616,7 @@ void MessageParser::parseInternal(
             {
                 // FINGERPRINT.
                 const attrs::FingerPrint* fingerprint = m_message->getAttribute<attrs::FingerPrint>();
-                if (fingerprint->getCrc32() != m_currentMessageCrc32.checksum())
+                if (fingerprint->getCrc32() != m_currentMessageCrc32)
                 {
                     m_state = State::failed;
                     break;
@@ -673,7 +674,7 @@ bool MessageParser::validateCachedData()
 
 void MessageParser::updateCurrentMessageCrc32(const char* buf, std::size_t size)
 {
-    m_currentMessageCrc32.process_bytes(buf, size);
+    m_currentMessageCrc32 = nx::utils::crc32(m_currentMessageCrc32, buf, size);
 }
 
 } // nx::network::stun
@@ -6,8 +6,6 @@
 #include <deque>
 #include <string>
 
-#include <boost/crc.hpp>
-
 #include <nx/network/abstract_socket.h>
 #include <nx/network/connection_server/base_protocol_message_types.h>
 #include <nx/network/stun/message.h>
@@ -172,7 +170,7 @@ private:
     STUNAttr m_attribute;
     Message* m_message = nullptr;
     LegacyState m_legacyState = LegacyState::HEADER_INITIAL_AND_TYPE;
-    boost::crc_32_type m_currentMessageCrc32;
+    std::uint32_t m_currentMessageCrc32 = 0;
     bool m_fingerprintFound = false;
 
     State m_state = State::header;
@@ -4,8 +4,7 @@
 
 #include <bitset>
 
-#include <boost/crc.hpp>
-
+#include <nx/utils/crc32.h>
 #include <nx/utils/string.h>
 
 #include "parse_utils.h"
@@ -456,9 +455,7 @@ std::uint32_t MessageSerializer::calcFingerprint(MessageSerializerBuffer* buffer
 
     // Now we calculate the CRC32 value , since the buffer has 4 bytes which is not needed
     // so we must ignore those bytes in the buffer.
-    boost::crc_32_type crc32;
-    crc32.process_bytes(buffer->buffer()->data(), buffer->size());
-    const std::uint32_t val = static_cast<std::uint32_t>(crc32.checksum());
+    const std::uint32_t val = nx::utils::crc32(buffer->buffer()->data(), buffer->size());
 
     // Do the XOR operation on it
     std::uint32_t xor_result = 0;
@@ -0,0 +1,60 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "message_template.h"
+
+#include <cstring>
+
+#include <QtCore/QtEndian>
+
+#include <nx/utils/crc32.h>
+
+#include "message_serializer.h"
+
+namespace nx::network::stun {
+
+static constexpr std::size_t kTransactionIdPos = 8;
+static constexpr std::size_t kFingerprintAttributeSize = 8;
+static constexpr std::uint32_t kFingerprintXorMask = 0x5354554e;
+
+MessageTemplate::MessageTemplate(const Message& message, bool addFingerprint)
+{
+    NX_ASSERT(!message.getAttribute<attrs::MessageIntegrity>(),
+        "MESSAGE-INTEGRITY depends on the transaction id");
+
+    MessageSerializer serializer;
+    serializer.setAlwaysAddFingerprint(addFingerprint);
+    m_message = serializer.serialized(message);
+
+    // The serializer always puts FINGERPRINT to the end of the message.
+    m_hasFingerprint =
+        addFingerprint || message.getAttribute<attrs::Attribute>(attrs::fingerPrint);
+}
+
+void MessageTemplate::serialize(std::string_view transactionId, nx::Buffer* buffer) const
+{
+    if (!NX_ASSERT(transactionId.size() == (std::size_t) Header::TRANSACTION_ID_SIZE))
+        return;
+
+    const std::size_t offset = buffer->size();
+    buffer->append(m_message.data(), m_message.size());
+    char* const message = buffer->data() + offset;
+    std::memcpy(message + kTransactionIdPos, transactionId.data(), transactionId.size());
+
+    if (m_hasFingerprint)
+    {
+        const std::size_t crcSize = m_message.size() - kFingerprintAttributeSize;
+        qToBigEndian<std::uint32_t>(
+            nx::utils::crc32(message, crcSize) ^ kFingerprintXorMask,
+            message + m_message.size() - sizeof(std::uint32_t));
+    }
+}
+
+nx::Buffer MessageTemplate::serialized(std::string_view transactionId) const
+{
+    nx::Buffer buffer;
+    buffer.reserve(m_message.size());
+    serialize(transactionId, &buffer);
+    return buffer;
+}
+
+} // namespace nx::network::stun
@@ -0,0 +1,38 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <string_view>
+
+#include <nx/utils/buffer.h>
+
+#include "message.h"
+
+namespace nx::network::stun {
+
+/**
+ * Message serialized once and then sent many times with different transaction ids, e.g. a
+ * binding or keep-alive response. Only the transaction id and the FINGERPRINT are rewritten for
+ * each message, the attributes are not serialized again.
+ * The message must not have attributes depending on the transaction id: MESSAGE-INTEGRITY and
+ * IPv6 XOR addresses.
+ */
+class NX_NETWORK_API MessageTemplate
+{
+public:
+    /**
+     * @param addFingerprint The same as MessageSerializer::setAlwaysAddFingerprint().
+     */
+    explicit MessageTemplate(const Message& message, bool addFingerprint = true);
+
+    /** Appends the message with the transaction id to the buffer. */
+    void serialize(std::string_view transactionId, nx::Buffer* buffer) const;
+
+    nx::Buffer serialized(std::string_view transactionId) const;
+
+private:
+    nx::Buffer m_message;
+    bool m_hasFingerprint = false;
+};
+
+} // namespace nx::network::stun
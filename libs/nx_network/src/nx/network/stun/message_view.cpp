@@ -0,0 +1,166 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "message_view.h"
+
+#include <vector>
+
+#include <QtCore/QtEndian>
+
+#include <nx/utils/auth/utils.h>
+#include <nx/utils/crc32.h>
+
+#include "parse_utils.h"
+
+namespace nx::network::stun {
+
+namespace {
+
+std::uint16_t readUint16(std::string_view buffer, std::size_t pos)
+{
+    return qFromBigEndian<std::uint16_t>(buffer.data() + pos);
+}
+
+std::uint32_t readUint32(std::string_view buffer, std::size_t pos)
+{
+    return qFromBigEndian<std::uint32_t>(buffer.data() + pos);
+}
+
+static constexpr std::uint32_t kFingerprintXorMask = 0x5354554e;
+
+} // namespace
+
+std::optional<MessageView> MessageView::parse(std::string_view buffer)
+{
+    if (buffer.size() < kHeaderSize)
+        return std::nullopt;
+
+    // The two most significant bits of the message type are zero.
+    if ((readUint16(buffer, 0) & 0xc000) != 0 || readUint32(buffer, 4) != MAGIC_COOKIE)
+        return std::nullopt;
+
+    const std::size_t length = readUint16(buffer, 2);
+    if (addPadding(length) != length || buffer.size() - kHeaderSize < length)
+        return std::nullopt;
+
+    const std::size_t end = kHeaderSize + length;
+    for (std::size_t pos = kHeaderSize; pos < end;)
+    {
+        if (end - pos < kAttributeHeaderSize)
+            return std::nullopt;
+
+        const std::size_t valueSize = addPadding(readUint16(buffer, pos + 2));
+        if (end - pos - kAttributeHeaderSize < valueSize)
+            return std::nullopt;
+
+        pos += kAttributeHeaderSize + valueSize;
+    }
+
+    return MessageView(buffer.substr(0, end));
+}
+
+MessageClass MessageView::messageClass() const
+{
+    // The message type bits are M M M M M C M M M C M M M M, see MessageParser.
+    const int type = readUint16(m_message, 0);
+    return static_cast<MessageClass>(((type & 0x0010) >> 4) | ((type & 0x0100) >> 7));
+}
+
+int MessageView::method() const
+{
+    const int type = readUint16(m_message, 0);
+    return (type & 0x000f) | ((type & 0x00e0) >> 1) | ((type & 0x3e00) >> 2);
+}
+
+std::string_view MessageView::transactionId() const
+{
+    return m_message.substr(8, Header::TRANSACTION_ID_SIZE);
+}
+
+std::optional<std::string_view> MessageView::attribute(int type) const
+{
+    const auto pos = findAttribute(type);
+    if (pos == 0)
+        return std::nullopt;
+
+    return attributeAt(pos).value;
+}
+
+bool MessageView::verifyIntegrity(
+    const std::string& userName,
+    const std::string& key,
+    MessageIntegrityOptions options) const
+{
+    const auto userNameValue = attribute(attrs::userName);
+    if (!userNameValue || *userNameValue != userName)
+        return false;
+
+    const auto pos = findAttribute(attrs::messageIntegrity);
+    if (pos == 0)
+        return false;
+
+    const auto receivedHmac = attributeAt(pos).value;
+    if (receivedHmac.size() != attrs::MessageIntegrity::SIZE)
+        return false;
+
+    static constexpr char k20ZeroBytes[attrs::MessageIntegrity::SIZE] = {};
+
+    // The message length is taken as if the message ended with MESSAGE-INTEGRITY.
+    const std::uint16_t length = qToBigEndian<std::uint16_t>(
+        pos - kHeaderSize + kAttributeHeaderSize + attrs::MessageIntegrity::SIZE);
+
+    std::vector<std::string_view> messageParts{
+        m_message.substr(0, 2),
+        std::string_view(reinterpret_cast<const char*>(&length), sizeof(length))};
+    if (options.legacyMode)
+    {
+        messageParts.push_back(m_message.substr(4, pos + kAttributeHeaderSize - 4));
+        messageParts.push_back(std::string_view(k20ZeroBytes, sizeof(k20ZeroBytes)));
+    }
+    else
+    {
+        messageParts.push_back(m_message.substr(4, pos - 4));
+    }
+
+    return nx::utils::auth::hmacSha1(key, messageParts) == receivedHmac;
+}
+
+bool MessageView::verifyFingerprint() const
+{
+    const auto pos = findAttribute(attrs::fingerPrint);
+    if (pos == 0)
+        return false;
+
+    const auto value = attributeAt(pos).value;
+    if (value.size() != sizeof(std::uint32_t))
+        return false;
+
+    return (readUint32(value, 0) ^ kFingerprintXorMask) == nx::utils::crc32(m_message.data(), pos);
+}
+
+MessageView::Attribute MessageView::attributeAt(std::size_t pos) const
+{
+    return Attribute{
+        .type = readUint16(m_message, pos),
+        .value = m_message.substr(pos + kAttributeHeaderSize, readUint16(m_message, pos + 2)),
+    };
+}
+
+std::size_t MessageView::nextAttributePos(std::size_t pos, const Attribute& attribute)
+{
+    return pos + kAttributeHeaderSize + addPadding(attribute.value.size());
+}
+
+std::size_t MessageView::findAttribute(int type) const
+{
+    for (std::size_t pos = kHeaderSize; pos < m_message.size();)
+    {
+        const auto attribute = attributeAt(pos);
+        if (attribute.type == type)
+            return pos;
+        pos = nextAttributePos(pos, attribute);
+    }
+
+    return 0;
+}
+
+} // namespace nx::network::stun
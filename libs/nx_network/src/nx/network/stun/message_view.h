@@ -0,0 +1,82 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "message.h"
+
+namespace nx::network::stun {
+
+/**
+ * Read-only view of a serialized STUN message, e.g. of a received datagram.
+ * Unlike parsing to Message, nothing is copied: the header fields and the attribute values
+ * reference the source buffer, so the buffer must outlive the view. MESSAGE-INTEGRITY and
+ * FINGERPRINT are verified over the source bytes without serializing the message again.
+ */
+class NX_NETWORK_API MessageView
+{
+public:
+    struct Attribute
+    {
+        int type = 0;
+        std::string_view value;
+    };
+
+    /**
+     * @return std::nullopt if the buffer does not start with a well-formed STUN message. The data
+     * following the message in the buffer is ignored.
+     */
+    static std::optional<MessageView> parse(std::string_view buffer);
+
+    MessageClass messageClass() const;
+    int method() const;
+    std::string_view transactionId() const;
+
+    /** @return The message bytes in the source buffer. */
+    std::string_view serialized() const { return m_message; }
+
+    /** @return Value of the first attribute of the type. */
+    std::optional<std::string_view> attribute(int type) const;
+
+    template<typename Func>
+    // requires std::is_invocable_v<Func, const Attribute&>
+    void forEachAttribute(Func func) const
+    {
+        for (std::size_t pos = kHeaderSize; pos < m_message.size();)
+        {
+            const auto attribute = attributeAt(pos);
+            func(attribute);
+            pos = nextAttributePos(pos, attribute);
+        }
+    }
+
+    /** The same as Message::verifyIntegrity(), but calculated over the source bytes. */
+    bool verifyIntegrity(
+        const std::string& userName,
+        const std::string& key,
+        MessageIntegrityOptions options = {}) const;
+
+    /** @return False if there is no FINGERPRINT attribute or its value does not match. */
+    bool verifyFingerprint() const;
+
+private:
+    static constexpr std::size_t kHeaderSize = 20;
+    static constexpr std::size_t kAttributeHeaderSize = 4;
+
+    MessageView(std::string_view message): m_message(message) {}
+
+    Attribute attributeAt(std::size_t pos) const;
+    static std::size_t nextAttributePos(std::size_t pos, const Attribute& attribute);
+
+    /** @return Position of the first attribute of the type, 0 if not found. */
+    std::size_t findAttribute(int type) const;
+
+private:
+    std::string_view m_message;
+};
+
+} // namespace nx::network::stun
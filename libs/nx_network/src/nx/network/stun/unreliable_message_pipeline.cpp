@@ -6,6 +6,17 @@
 
 namespace nx::network {
 
+/**
+ * STUN messages fit into the path MTU. So, the batch read buffers take as much memory as the
+ * buffer of a single read.
+ */
+static constexpr std::size_t kReadBatchSize = 16;
+static constexpr std::size_t kReadBatchDatagramSize = 4 * 1024;
+/** Other events of the AIO thread are not delayed for too long under a datagram flood. */
+static constexpr std::size_t kMaxDatagramsReadPerEvent = 256;
+
+static constexpr std::size_t kMaxSendBatchSize = 64;
+
 DatagramPipeline::DatagramPipeline(std::unique_ptr<AbstractDatagramSocket> socket):
     m_socket(std::move(socket))
 {
@@ -120,11 +131,68 @@ void DatagramPipeline::onBytesRead(
             return; //this has been freed
     }
 
+    if (!readQueuedDatagrams())
+        return; //this has been freed
+
     startReceivingMessages();
 }
 
+bool DatagramPipeline::readQueuedDatagrams()
+{
+    if (m_readBatch.empty())
+        m_readBatch.resize(kReadBatchSize);
+
+    std::size_t totalRead = 0;
+    while (totalRead < kMaxDatagramsReadPerEvent)
+    {
+        for (auto& datagram: m_readBatch)
+            datagram.data.reserve(kReadBatchDatagramSize);
+
+        // An error is reported by the following asynchronous read.
+        const int datagramCount = m_socket->recvMultipleFrom(&m_readBatch);
+        if (datagramCount <= 0)
+            return true;
+
+        for (int i = 0; i < datagramCount; ++i)
+        {
+            const auto& datagram = m_readBatch[i];
+            if (datagram.truncated)
+            {
+                NX_DEBUG(this, "Dropping UDP datagram from %1 larger than %2 bytes",
+                    datagram.address, kReadBatchDatagramSize);
+                continue;
+            }
+
+            if (datagram.data.empty())
+                continue;
+
+            nx::utils::InterruptionFlag::Watcher watcher(&m_terminationFlag);
+            datagramReceived(datagram.address, datagram.data);
+            if (watcher.interrupted())
+                return false;
+        }
+
+        totalRead += datagramCount;
+        if ((std::size_t) datagramCount < m_readBatch.size())
+            break;
+    }
+
+    return true;
+}
+
 void DatagramPipeline::sendOutNextMessage()
 {
+    // The messages queued while the previous one was being sent go out with a single system call.
+    // The remaining ones are sent asynchronously if the socket send buffer gets full.
+    for (bool allSent = true; allSent && m_sendQueue.size() > 1;)
+    {
+        if (!sendQueuedMessagesInBatch(&allSent))
+            return; //this has been freed
+    }
+
+    if (m_sendQueue.empty())
+        return;
+
     OutgoingMessageContext& msgCtx = m_sendQueue.front();
 
     using namespace std::placeholders;
@@ -167,6 +235,57 @@ void DatagramPipeline::messageSent(
         sendOutNextMessage();
 }
 
+bool DatagramPipeline::sendQueuedMessagesInBatch(bool* allSent)
+{
+    *allSent = false;
+
+    bool isNonBlockingMode = false;
+    if (!m_socket->getNonBlockingMode(&isNonBlockingMode) || !isNonBlockingMode)
+        return true;
+
+    // Destinations of the batch have to be resolved already.
+    std::size_t batchSize = 0;
+    while (batchSize < m_sendQueue.size() && batchSize < kMaxSendBatchSize
+        && m_sendQueue[batchSize].destinationEndpoint.address.isIpAddress())
+    {
+        ++batchSize;
+    }
+
+    if (batchSize < 2)
+        return true;
+
+    m_sendBatch.resize(batchSize);
+    for (std::size_t i = 0; i < batchSize; ++i)
+    {
+        m_sendBatch[i].address = m_sendQueue[i].destinationEndpoint;
+        m_sendBatch[i].data = std::move(m_sendQueue[i].serializedMessage);
+    }
+
+    const std::size_t sentCount = std::max(m_socket->sendMultipleTo(m_sendBatch), 0);
+
+    // The rest is sent one by one so that the send error is reported for the right message.
+    for (std::size_t i = sentCount; i < batchSize; ++i)
+        m_sendQueue[i].serializedMessage = std::move(m_sendBatch[i].data);
+    m_sendBatch.clear();
+
+    for (std::size_t i = 0; i < sentCount; ++i)
+    {
+        // The handler is invoked before removing the message from the queue so that a message
+        // sent from the handler is queued and not sent right away.
+        if (auto completionHandler = std::move(m_sendQueue.front().completionHandler))
+        {
+            nx::utils::InterruptionFlag::Watcher watcher(&m_terminationFlag);
+            completionHandler(SystemError::noError, m_sendQueue.front().destinationEndpoint);
+            if (watcher.interrupted())
+                return false;
+        }
+        m_sendQueue.pop_front();
+    }
+
+    *allSent = sentCount == batchSize;
+    return true;
+}
+
 //-------------------------------------------------------------------------------------------------
 // DatagramPipeline::OutgoingMessageContext
 
@@ -5,6 +5,7 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <nx/network/abstract_socket.h>
 #include <nx/network/aio/basic_pollable.h>
@@ -78,7 +79,9 @@ private:
 
     std::unique_ptr<AbstractDatagramSocket> m_socket;
     nx::Buffer m_readBuffer;
+    std::vector<Datagram> m_readBatch;
     std::deque<OutgoingMessageContext> m_sendQueue;
+    std::vector<Datagram> m_sendBatch;
     nx::utils::InterruptionFlag m_terminationFlag;
 
     virtual void stopWhileInAioThread() override;
@@ -88,8 +91,21 @@ private:
         SocketAddress sourceAddress,
         size_t bytesRead);
 
+    /**
+     * Reads the datagrams that have been queued in the socket in a batch.
+     * @return false if this has been freed by the datagram handler.
+     */
+    bool readQueuedDatagrams();
+
     void sendOutNextMessage();
 
+    /**
+     * Sends the queued messages in a batch.
+     * @param allSent Set to false if not all messages have been sent.
+     * @return false if this has been freed by a completion handler.
+     */
+    bool sendQueuedMessagesInBatch(bool* allSent);
+
     void messageSent(
         SystemError::ErrorCode errorCode,
         SocketAddress resolvedTargetAddress,
@@ -2,7 +2,11 @@
 
 #include "system_socket.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <type_traits>
 
@@ -36,6 +40,7 @@
 #else
     #include <sys/types.h>       // For data types
     #include <sys/socket.h>      // For socket(), connect(), send(), and recv()
+    #include <sys/uio.h>         // For iovec
     #include <netdb.h>           // For getaddrinfo()
     #include <arpa/inet.h>       // For inet_addr()
     #include <unistd.h>          // For close()
@@ -49,6 +54,19 @@
     #define SOCKET_ERROR (-1)
 #endif
 
+#if defined(__linux__)
+    #include <netinet/udp.h>
+    #include <sys/sendfile.h>
+
+    // Older C library headers lack the UDP segmentation offload options.
+    #ifndef UDP_SEGMENT
+        #define UDP_SEGMENT 103
+    #endif
+    #ifndef UDP_GRO
+        #define UDP_GRO 104
+    #endif
+#endif
+
 // Needed only for bpi build, that use old C Library headers.
 #ifdef __linux__
     #include <sys/utsname.h>
@@ -780,6 +798,104 @@ int CommunicatingSocket<SocketInterfaceToImplement>::send(
             0);
     #endif
 
+    return processSendResult(sent);
+}
+
+template<typename SocketInterfaceToImplement>
+int CommunicatingSocket<SocketInterfaceToImplement>::sendGathered(
+    const std::string_view* buffers, std::size_t bufferCount)
+{
+    // Sending less than requested is allowed, so not allocating anything for long buffer lists.
+    bufferCount = std::min(bufferCount, kMaxGatheredBufferCount);
+
+    #if defined(Q_OS_WIN)
+        WSABUF wsaBuffers[kMaxGatheredBufferCount];
+        for (std::size_t i = 0; i < bufferCount; ++i)
+        {
+            wsaBuffers[i].buf = const_cast<char*>(buffers[i].data());
+            wsaBuffers[i].len = (ULONG) buffers[i].size();
+        }
+
+        DWORD bytesSent = 0;
+        const int sent = WSASend(
+            this->m_fd, wsaBuffers, (DWORD) bufferCount, &bytesSent, 0, nullptr, nullptr) == 0
+            ? (int) bytesSent
+            : -1;
+    #else
+        unsigned int sendTimeout = 0;
+        if (!this->getSendTimeout(&sendTimeout))
+            return -1;
+
+        iovec ioVectors[kMaxGatheredBufferCount];
+        for (std::size_t i = 0; i < bufferCount; ++i)
+        {
+            ioVectors[i].iov_base = const_cast<char*>(buffers[i].data());
+            ioVectors[i].iov_len = buffers[i].size();
+        }
+
+        msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = ioVectors;
+        message.msg_iovlen = bufferCount;
+
+        const int sent = doInterruptableSystemCallWithTimeout<>(
+            this,
+            [this, &message]()
+            {
+                return (int) ::sendmsg(
+                    this->m_fd,
+                    &message,
+                    #if defined(Q_OS_LINUX)
+                        MSG_NOSIGNAL
+                    #else
+                        0
+                    #endif
+                );
+            },
+            sendTimeout,
+            0);
+    #endif
+
+    return processSendResult(sent);
+}
+
+template<typename SocketInterfaceToImplement>
+int CommunicatingSocket<SocketInterfaceToImplement>::sendFile(const FileRegion& region)
+{
+    // Limiting a single call so that the result fits into int.
+    const std::size_t count = (std::size_t) std::min<std::uint64_t>(
+        region.size, std::numeric_limits<int>::max());
+
+    #if defined(__linux__)
+        off_t offset = (off_t) region.offset;
+        const int sent = (int) ::sendfile(this->m_fd, region.fd, &offset, count);
+    #elif defined(__APPLE__)
+        off_t bytesSent = (off_t) count;
+        int sent = ::sendfile(region.fd, this->m_fd, (off_t) region.offset, &bytesSent, nullptr, 0);
+        // The call may be interrupted or would block after sending some data.
+        if (sent == 0 || bytesSent > 0)
+            sent = (int) bytesSent;
+    #else
+        NX_ASSERT(false, "sendfile is not supported on this platform");
+        SystemError::setLastErrorCode(SystemError::notImplemented);
+        const int sent = -1;
+        (void) count;
+    #endif
+
+    return processSendResult(sent);
+}
+
+template<typename SocketInterfaceToImplement>
+void CommunicatingSocket<SocketInterfaceToImplement>::sendFileAsync(
+    const FileRegion& region,
+    IoCompletionHandler handler)
+{
+    return m_aioHelper->sendFileAsync(region, std::move(handler));
+}
+
+template<typename SocketInterfaceToImplement>
+int CommunicatingSocket<SocketInterfaceToImplement>::processSendResult(int sent)
+{
     if (sent < 0)
     {
         const SystemError::ErrorCode errCode = SystemError::getLastOSErrorCode();
@@ -858,6 +974,22 @@ void CommunicatingSocket<SocketInterfaceToImplement>::sendAsync(
     return m_aioHelper->sendAsync(buf, std::move(handler));
 }
 
+template<typename SocketInterfaceToImplement>
+void CommunicatingSocket<SocketInterfaceToImplement>::sendGatheredAsync(
+    std::vector<const nx::Buffer*> buffers,
+    IoCompletionHandler handler)
+{
+    return m_aioHelper->sendGatheredAsync(std::move(buffers), std::move(handler));
+}
+
+template<typename SocketInterfaceToImplement>
+void CommunicatingSocket<SocketInterfaceToImplement>::sendGatheredAsync(
+    const nx::BufferChain* chain,
+    IoCompletionHandler handler)
+{
+    return m_aioHelper->sendGatheredAsync(chain->views(), std::move(handler));
+}
+
 template<typename SocketInterfaceToImplement>
 void CommunicatingSocket<SocketInterfaceToImplement>::registerTimer(
     std::chrono::milliseconds timeout,
@@ -1852,6 +1984,20 @@ int UDPSocket::send(const void* buffer, std::size_t bufferLen)
 #endif
 }
 
+void UDPSocket::sendGatheredAsync(
+    std::vector<const nx::Buffer*> buffers,
+    IoCompletionHandler handler)
+{
+    AbstractCommunicatingSocket::sendGatheredAsync(std::move(buffers), std::move(handler));
+}
+
+void UDPSocket::sendGatheredAsync(
+    const nx::BufferChain* chain,
+    IoCompletionHandler handler)
+{
+    AbstractCommunicatingSocket::sendGatheredAsync(chain, std::move(handler));
+}
+
 bool UDPSocket::setDestAddr(const SocketAddress& endpoint)
 {
     if (endpoint.address.isIpAddress())
@@ -1997,6 +2143,267 @@ SocketAddress UDPSocket::lastDatagramSourceAddress() const
     return m_prevDatagramAddress;
 }
 
+#if defined(__linux__)
+
+namespace {
+
+/** Limits the stack usage of a single recvmmsg/sendmmsg call. */
+static constexpr std::size_t kMaxMessagesPerCall = 64;
+
+struct alignas(cmsghdr) SegmentSizeControl
+{
+    char data[CMSG_SPACE(sizeof(std::uint16_t))];
+};
+
+struct alignas(cmsghdr) GroControl
+{
+    char data[CMSG_SPACE(sizeof(int))];
+};
+
+} // namespace
+
+int UDPSocket::recvMultipleFrom(std::vector<Datagram>* datagrams)
+{
+    std::array<mmsghdr, kMaxMessagesPerCall> messages;
+    std::array<iovec, kMaxMessagesPerCall> iovecs;
+    std::array<SystemSocketAddress, kMaxMessagesPerCall> addresses;
+    std::array<GroControl, kMaxMessagesPerCall> controls;
+
+    int totalReceived = 0;
+    while ((std::size_t) totalReceived < datagrams->size())
+    {
+        const auto count = std::min<std::size_t>(
+            datagrams->size() - totalReceived, kMaxMessagesPerCall);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& datagram = (*datagrams)[totalReceived + i];
+            datagram.data.resize(datagram.data.capacity());
+            iovecs[i] = {datagram.data.data(), datagram.data.size()};
+            addresses[i] = SystemSocketAddress(m_ipVersion);
+
+            messages[i] = {};
+            messages[i].msg_hdr.msg_name = addresses[i].get();
+            messages[i].msg_hdr.msg_namelen = addresses[i].length();
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            if (m_isReceiveOffloadEnabled)
+            {
+                messages[i].msg_hdr.msg_control = controls[i].data;
+                messages[i].msg_hdr.msg_controllen = sizeof(controls[i].data);
+            }
+        }
+
+        int received = -1;
+        do
+        {
+            received = ::recvmmsg(handle(), messages.data(), count, MSG_DONTWAIT, nullptr);
+        } while (received < 0 && SystemError::getLastOSErrorCode() == SystemError::interrupted);
+
+        const auto lastError = SystemError::getLastOSErrorCode();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& datagram = (*datagrams)[totalReceived + i];
+            if ((int) i >= received)
+            {
+                datagram.data.resize(0);
+                continue;
+            }
+
+            const auto& header = messages[i].msg_hdr;
+            datagram.data.resize(messages[i].msg_len);
+            addresses[i].length() = header.msg_namelen;
+            datagram.address = addresses[i].toSocketAddress();
+            datagram.truncated = (header.msg_flags & MSG_TRUNC) != 0;
+            datagram.segmentSize = 0;
+
+            for (auto cmsg = CMSG_FIRSTHDR(&header); cmsg; cmsg = CMSG_NXTHDR(&header, cmsg))
+            {
+                if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+                {
+                    int segmentSize = 0;
+                    memcpy(&segmentSize, CMSG_DATA(cmsg), sizeof(segmentSize));
+                    if ((std::size_t) segmentSize < datagram.data.size())
+                        datagram.segmentSize = segmentSize;
+                }
+            }
+        }
+
+        if (received < 0)
+        {
+            SystemError::setLastErrorCode(lastError);
+            if (lastError == SystemError::again || lastError == SystemError::wouldBlock)
+                return totalReceived;
+            return totalReceived > 0 ? totalReceived : -1;
+        }
+
+        totalReceived += received;
+        if ((std::size_t) received < count)
+        {
+            SystemError::setLastErrorCode(SystemError::wouldBlock);
+            break;
+        }
+    }
+
+    if (totalReceived > 0)
+        m_prevDatagramAddress = (*datagrams)[totalReceived - 1].address;
+
+    return totalReceived;
+}
+
+int UDPSocket::sendMultipleTo(const std::vector<Datagram>& datagrams)
+{
+    std::array<mmsghdr, kMaxMessagesPerCall> messages;
+    std::array<iovec, kMaxMessagesPerCall> iovecs;
+    std::array<SystemSocketAddress, kMaxMessagesPerCall> addresses;
+    std::array<SegmentSizeControl, kMaxMessagesPerCall> controls;
+
+    std::size_t totalSent = 0;
+    while (totalSent < datagrams.size())
+    {
+        const auto count = std::min<std::size_t>(datagrams.size() - totalSent, kMaxMessagesPerCall);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& datagram = datagrams[totalSent + i];
+            iovecs[i] = {const_cast<char*>(datagram.data.data()), datagram.data.size()};
+            addresses[i] = SystemSocketAddress(datagram.address, m_ipVersion);
+
+            messages[i] = {};
+            messages[i].msg_hdr.msg_name = addresses[i].get();
+            messages[i].msg_hdr.msg_namelen = addresses[i].length();
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+
+            if (datagram.segmentSize > 0 && datagram.segmentSize < datagram.data.size())
+            {
+                messages[i].msg_hdr.msg_control = controls[i].data;
+                messages[i].msg_hdr.msg_controllen = sizeof(controls[i].data);
+
+                auto cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr);
+                cmsg->cmsg_level = SOL_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+                const auto segmentSize = (std::uint16_t) datagram.segmentSize;
+                memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+            }
+        }
+
+        int sent = -1;
+        do
+        {
+            sent = ::sendmmsg(handle(), messages.data(), count, MSG_NOSIGNAL);
+        } while (sent < 0 && SystemError::getLastOSErrorCode() == SystemError::interrupted);
+
+        if (sent < 0)
+        {
+            const auto lastError = SystemError::getLastOSErrorCode();
+            // The kernel or the network device does not support UDP GSO.
+            if (lastError == SystemError::invalidData || lastError == SystemError::ioError ||
+                lastError == SystemError::notImplemented)
+            {
+                const auto& datagram = datagrams[totalSent];
+                if (datagram.segmentSize > 0)
+                {
+                    if (sendMultipleToOneByOne({datagram}) != 1)
+                        return totalSent > 0 ? (int) totalSent : -1;
+                    ++totalSent;
+                    continue;
+                }
+            }
+            return totalSent > 0 ? (int) totalSent : -1;
+        }
+
+        totalSent += sent;
+        if ((std::size_t) sent < count)
+            break;
+    }
+
+    return (int) totalSent;
+}
+
+bool UDPSocket::setReceiveOffload(bool enabled)
+{
+    int value = enabled ? 1 : 0;
+    if (::setsockopt(handle(), SOL_UDP, UDP_GRO, &value, sizeof(value)) != 0)
+        return false;
+
+    m_isReceiveOffloadEnabled = enabled;
+    return true;
+}
+
+#else
+
+int UDPSocket::recvMultipleFrom(std::vector<Datagram>* datagrams)
+{
+    return recvMultipleFromOneByOne(datagrams);
+}
+
+int UDPSocket::sendMultipleTo(const std::vector<Datagram>& datagrams)
+{
+    return sendMultipleToOneByOne(datagrams);
+}
+
+bool UDPSocket::setReceiveOffload(bool /*enabled*/)
+{
+    SystemError::setLastErrorCode(SystemError::notImplemented);
+    return false;
+}
+
+#endif
+
+int UDPSocket::recvMultipleFromOneByOne(std::vector<Datagram>* datagrams)
+{
+    int totalReceived = 0;
+    for (auto& datagram: *datagrams)
+    {
+        if (!hasData())
+        {
+            datagram.data.resize(0);
+            continue;
+        }
+
+        datagram.data.resize(datagram.data.capacity());
+        const int bytesRead = recvFrom(datagram.data.data(), datagram.data.size(), &datagram.address);
+        if (bytesRead < 0)
+        {
+            datagram.data.resize(0);
+            return totalReceived > 0 ? totalReceived : -1;
+        }
+
+        datagram.data.resize(bytesRead);
+        datagram.segmentSize = 0;
+        datagram.truncated = false;
+        ++totalReceived;
+    }
+
+    if ((std::size_t) totalReceived < datagrams->size())
+        SystemError::setLastErrorCode(SystemError::wouldBlock);
+    return totalReceived;
+}
+
+int UDPSocket::sendMultipleToOneByOne(const std::vector<Datagram>& datagrams)
+{
+    int totalSent = 0;
+    for (const auto& datagram: datagrams)
+    {
+        const auto segmentSize =
+            datagram.segmentSize > 0 ? datagram.segmentSize : datagram.data.size();
+
+        std::size_t pos = 0;
+        do
+        {
+            const auto size = std::min(segmentSize, datagram.data.size() - pos);
+            if (!sendTo(datagram.data.data() + pos, size, datagram.address))
+                return totalSent > 0 ? totalSent : -1;
+            pos += size;
+        } while (pos < datagram.data.size());
+
+        ++totalSent;
+    }
+
+    return totalSent;
+}
+
 bool UDPSocket::hasData() const
 {
 #ifdef _WIN32
@@ -156,6 +156,7 @@ public:
 
     virtual int recv(void* buffer, std::size_t bufferLen, int flags) override;
     virtual int send(const void* buffer, std::size_t bufferLen) override;
+    virtual int sendGathered(const std::string_view* buffers, std::size_t bufferCount) override;
     virtual SocketAddress getForeignAddress() const override;
 
     virtual void readSomeAsync(
@@ -166,6 +167,42 @@ public:
         const nx::Buffer* buf,
         IoCompletionHandler handler) override;
 
+    virtual void sendGatheredAsync(
+        std::vector<const nx::Buffer*> buffers,
+        IoCompletionHandler handler) override;
+
+    virtual void sendGatheredAsync(
+        const nx::BufferChain* chain,
+        IoCompletionHandler handler) override;
+
+    /**
+     * Sends some data from the file region without copying it to the user space.
+     * Partial write semantics are the same as of send().
+     * @return number of bytes sent. -1 if failed to send something.
+     * NOTE: Fails with SystemError::notImplemented if isSendFileSupported() is false.
+     */
+    int sendFile(const FileRegion& region);
+
+    /**
+     * Asynchronously transmits the whole file region to the socket. Same as sendAsync otherwise.
+     * NOTE: The data is read from the file within the socket's AIO thread. So, it is not
+     * recommended for files that are not likely to reside in the OS page cache or on a slow
+     * storage.
+     */
+    void sendFileAsync(const FileRegion& region, IoCompletionHandler handler);
+
+    /**
+     * @return true if the platform provides zero-copy file transmission (sendfile).
+     */
+    static constexpr bool isSendFileSupported()
+    {
+        #if defined(__linux__) || defined(__APPLE__)
+            return true;
+        #else
+            return false;
+        #endif
+    }
+
     virtual void registerTimer(
         std::chrono::milliseconds timeoutMs,
         nx::utils::MoveOnlyFunc<void()> handler) override;
@@ -181,9 +218,13 @@ protected:
     bool m_connected;
 
 private:
+    static constexpr std::size_t kMaxGatheredBufferCount = 16;
+
     bool connectToIp(
         const SocketAddress& remoteAddress,
         std::chrono::milliseconds timeout);
+
+    int processSendResult(int sent);
 };
 
 /**
@@ -315,6 +356,18 @@ public:
 
     virtual int send( const void* buffer, std::size_t bufferLen ) override;
 
+    /**
+     * Datagram boundaries must be preserved, so the buffers are concatenated and sent with
+     * UDPSocket::sendAsync.
+     */
+    virtual void sendGatheredAsync(
+        std::vector<const nx::Buffer*> buffers,
+        IoCompletionHandler handler) override;
+
+    virtual void sendGatheredAsync(
+        const nx::BufferChain* chain,
+        IoCompletionHandler handler) override;
+
     virtual bool setDestAddr( const SocketAddress& foreignEndpoint ) override;
 
     virtual bool sendTo(
@@ -343,6 +396,9 @@ public:
         nx::utils::MoveOnlyFunc<void(SystemError::ErrorCode, SocketAddress, size_t)> handler) override;
 
     virtual SocketAddress lastDatagramSourceAddress() const override;
+    virtual int recvMultipleFrom(std::vector<Datagram>* datagrams) override;
+    virtual int sendMultipleTo(const std::vector<Datagram>& datagrams) override;
+    virtual bool setReceiveOffload(bool enabled) override;
     virtual bool hasData() const override;
     /**
      * Sets the multicast send interface.
@@ -353,8 +409,11 @@ public:
 private:
     SystemSocketAddress m_destAddr;
     SocketAddress m_prevDatagramAddress;
+    bool m_isReceiveOffloadEnabled = false;
 
     void setBroadcast();
+    int recvMultipleFromOneByOne(std::vector<Datagram>* datagrams);
+    int sendMultipleToOneByOne(const std::vector<Datagram>& datagrams);
     /**
      * @param sourcePort Port is returned in host byte order.
      */
@@ -622,6 +622,57 @@ protected:
             });
     }
 
+    void whenSendGatheredAsyncRandomDataToServer()
+    {
+        ASSERT_TRUE(m_connection->setNonBlockingMode(true));
+
+        // The large buffer makes the data to be sent with multiple system calls.
+        m_gatheredBuffers = {
+            nx::utils::generateRandomName(17),
+            nx::Buffer(),
+            nx::utils::generateRandomName(300*1024),
+            nx::utils::generateRandomName(1)};
+
+        m_sentData.clear();
+        std::vector<const nx::Buffer*> buffers;
+        for (const auto& buffer: m_gatheredBuffers)
+        {
+            m_sentData.append(buffer.data(), buffer.size());
+            buffers.push_back(&buffer);
+        }
+
+        m_connection->sendGatheredAsync(
+            std::move(buffers),
+            [this](SystemError::ErrorCode systemErrorCode, std::size_t bytesSent)
+            {
+                if (systemErrorCode == SystemError::noError)
+                    EXPECT_EQ(m_sentData.size(), bytesSent);
+                m_sendResultQueue.push(systemErrorCode);
+            });
+    }
+
+    void whenSendBufferChainAsyncRandomDataToServer()
+    {
+        ASSERT_TRUE(m_connection->setNonBlockingMode(true));
+
+        // Slices of the same buffer, not in the original order.
+        const nx::SharedBuffer data(nx::Buffer(nx::utils::generateRandomName(300*1024)));
+        m_bufferChain.clear();
+        m_bufferChain.append(data.subBuffer(100*1024));
+        m_bufferChain.append(data.subBuffer(17, 1));
+        m_bufferChain.append(data.subBuffer(0, 100*1024));
+        m_sentData = m_bufferChain.toBuffer();
+
+        m_connection->sendGatheredAsync(
+            &m_bufferChain,
+            [this](SystemError::ErrorCode systemErrorCode, std::size_t bytesSent)
+            {
+                if (systemErrorCode == SystemError::noError)
+                    EXPECT_EQ(m_sentData.size(), bytesSent);
+                m_sendResultQueue.push(systemErrorCode);
+            });
+    }
+
     void whenServerReadsWithFlags(int recvFlags)
     {
         whenAcceptConnection();
@@ -1521,6 +1572,8 @@ private:
     nx::Buffer m_readBuffer;
     nx::utils::SyncQueue<RecvResult> m_recvResultQueue;
     nx::utils::SyncQueue<SystemError::ErrorCode> m_sendResultQueue;
+    std::vector<nx::Buffer> m_gatheredBuffers;
+    nx::BufferChain m_bufferChain;
     nx::Buffer m_randomDataBuffer;
     std::unique_ptr<typename SocketTypeSet::ServerSocket> m_serverSocket;
     std::unique_ptr<typename SocketTypeSet::ClientSocket> m_connection;
@@ -1699,6 +1752,28 @@ TYPED_TEST_P(StreamSocketAcceptance, synchronous_server_receives_data)
     this->thenServerReceivedData();
 }
 
+TYPED_TEST_P(StreamSocketAcceptance, gathered_async_send_delivers_all_buffers_in_order)
+{
+    this->givenListeningSynchronousServer();
+    this->givenConnectedSocket();
+
+    this->whenSendGatheredAsyncRandomDataToServer();
+
+    this->thenSendSucceeded();
+    this->thenServerReceivedData();
+}
+
+TYPED_TEST_P(StreamSocketAcceptance, buffer_chain_async_send_delivers_all_slices_in_order)
+{
+    this->givenListeningSynchronousServer();
+    this->givenConnectedSocket();
+
+    this->whenSendBufferChainAsyncRandomDataToServer();
+
+    this->thenSendSucceeded();
+    this->thenServerReceivedData();
+}
+
 TYPED_TEST_P(StreamSocketAcceptance, synchronous_server_responds_to_request)
 {
     this->givenSynchronousPingPongServer();
@@ -2391,6 +2466,8 @@ REGISTER_TYPED_TEST_SUITE_P(StreamSocketAcceptance,
     // I/O data transfer tests.
     transfer_async,
     synchronous_server_receives_data,
+    gathered_async_send_delivers_all_buffers_in_order,
+    buffer_chain_async_send_delivers_all_slices_in_order,
     synchronous_server_responds_to_request,
     recv_sync_with_wait_all_flag,
     recv_timeout_is_reported,
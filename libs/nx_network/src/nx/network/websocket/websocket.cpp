@@ -10,6 +10,11 @@ namespace nx::network::websocket {
 static const auto kAliveTimeout = std::chrono::seconds(10);
 static const auto kBufferSize = 4096;
 static const auto kMaxIncomingMessageQueueSize = 1000;
+/**
+ * Messages are coalesced into a single socket send until this size is reached. Larger messages
+ * are never delayed.
+ */
+static constexpr std::size_t kMaxCoalescedSendSize = 64 * 1024;
 
 using namespace std::placeholders;
 
@@ -28,6 +33,7 @@ WebSocket::WebSocket(
     m_receiveMode(receiveMode),
     m_pingTimer(new nx::network::aio::Timer),
     m_pongTimer(new nx::network::aio::Timer),
+    m_sendCoalescingTimer(new nx::network::aio::Timer),
     m_aliveTimeout(kAliveTimeout),
     m_defaultFrameType(
         frameType == FrameType::binary || frameType == FrameType::text
@@ -189,12 +195,14 @@ void WebSocket::bindToAioThread(aio::AbstractAioThread* aioThread)
     m_socket->bindToAioThread(aioThread);
     m_pingTimer->bindToAioThread(aioThread);
     m_pongTimer->bindToAioThread(aioThread);
+    m_sendCoalescingTimer->bindToAioThread(aioThread);
 }
 
 void WebSocket::stopWhileInAioThread()
 {
     m_pingTimer.reset();
     m_pongTimer.reset();
+    m_sendCoalescingTimer.reset();
     if (m_socket)
     {
         // Timer is inherited from BasicPollable and is stopped in the destructor while
@@ -276,56 +284,169 @@ void WebSocket::sendAsync(Frame&& frame, IoCompletionHandler handler)
     post(
         [this, frame = std::move(frame), handler = std::move(handler)]() mutable
         {
-            nx::Buffer writeBuffer;
-            if (m_sendMode == SendMode::singleMessage)
-            {
-                writeBuffer = m_serializer.prepareMessage(frame.buffer, frame.type, m_compressionType);
-            }
-            else
+            sendFrame(std::move(frame), std::move(handler));
+        });
+}
+
+void WebSocket::sendAsync(
+    std::shared_ptr<const SharedMessage> message, IoCompletionHandler handler)
+{
+    NX_ASSERT(handler);
+    post(
+        [this, message = std::move(message), handler = std::move(handler)]() mutable
+        {
+            if (m_sendMode != SendMode::singleMessage || m_serializer.isMasked())
+                return sendFrame(Frame{message->payload, message->type}, std::move(handler));
+
+            const bool compress = shouldMessageBeCompressed(
+                message->type, m_compressionType, message->payload.size());
+            if (compress)
             {
-                FrameType type = !m_isFirstFrame ? FrameType::continuation : frame.type;
-                writeBuffer = m_serializer.prepareFrame(frame.buffer, type, m_isLastFrame);
-                m_isFirstFrame = m_isLastFrame;
-                if (m_isLastFrame)
-                    m_isLastFrame = false;
+                // The peer's DEFLATE window now has the data this serializer has not seen, so
+                // its next messages must not refer to the earlier ones.
+                m_serializer.resetCompression();
             }
 
-            sendMessage(writeBuffer, frame.buffer.size(), std::move(handler));
+            const auto writeSize = message->payload.size();
+            const nx::Buffer* frame = compress ? &message->compressedFrame : &message->frame;
+            sendMessage(WriteContext{
+                .handler = std::move(handler),
+                .userDataSize = writeSize,
+                .sharedBuffer = std::shared_ptr<const nx::Buffer>(std::move(message), frame)});
         });
 }
 
+void WebSocket::sendFrame(Frame frame, IoCompletionHandler handler)
+{
+    nx::Buffer writeBuffer;
+    if (m_sendMode == SendMode::singleMessage)
+    {
+        writeBuffer = m_serializer.prepareMessage(frame.buffer, frame.type, m_compressionType);
+    }
+    else
+    {
+        FrameType type = !m_isFirstFrame ? FrameType::continuation : frame.type;
+        writeBuffer = m_serializer.prepareFrame(frame.buffer, type, m_isLastFrame);
+        m_isFirstFrame = m_isLastFrame;
+        if (m_isLastFrame)
+            m_isLastFrame = false;
+    }
+
+    sendMessage(std::move(writeBuffer), frame.buffer.size(), std::move(handler));
+}
+
 void WebSocket::setAliveTimeout(std::chrono::milliseconds timeout)
 {
     m_aliveTimeout = timeout;
 }
 
+void WebSocket::setSendCoalescingWindow(std::chrono::milliseconds window)
+{
+    m_sendCoalescingWindow = window;
+}
+
 void WebSocket::sendCloseAsync()
 {
     post([this]() { sendControlRequest(FrameType::close); });
 }
 
-void WebSocket::sendMessage(const nx::Buffer& message, int writeSize, IoCompletionHandler handler)
+void WebSocket::sendMessage(
+    nx::Buffer message,
+    std::size_t writeSize,
+    IoCompletionHandler handler,
+    bool canBeDelayed)
+{
+    sendMessage(
+        WriteContext{
+            .handler = std::move(handler),
+            .buffer = std::move(message),
+            .userDataSize = writeSize},
+        canBeDelayed);
+}
+
+void WebSocket::sendMessage(WriteContext context, bool canBeDelayed)
 {
-    NX_VERBOSE(this, "SendMessage: IsFailed: %1, Write size: %2", m_failed, writeSize);
+    NX_VERBOSE(this, "SendMessage: IsFailed: %1, Write size: %2",
+        m_failed, context.userDataSize);
     if (m_failed)
     {
         NX_VERBOSE(
             this,
             "sendMessage() called after connection has been terminated. Ignoring.");
-        handler(SystemError::connectionAbort, 0);
+        context.handler(SystemError::connectionAbort, 0);
         return;
     }
 
-    m_writeQueue.emplace(std::move(handler), message);
-    if (m_writeQueue.size() == 1)
+    const auto messageSize = context.data().size();
+    m_writeQueue.push_back(std::move(context));
+    if (m_messagesBeingSent > 0)
+        return; //< Will be sent as soon as the current socket send completes.
+
+    if (canBeDelayed
+        && m_sendCoalescingWindow > std::chrono::milliseconds::zero()
+        && messageSize < kMaxCoalescedSendSize)
     {
-        m_socket->sendAsync(
-            &m_writeQueue.front().second,
-            [this, writeSize](SystemError::ErrorCode error, size_t transferred)
-            {
-                onWrite(error, transferred == 0 ? 0 : writeSize);
-            });
+        if (!m_isSendCoalescingTimerStarted)
+        {
+            m_isSendCoalescingTimerStarted = true;
+            m_sendCoalescingTimer->start(
+                m_sendCoalescingWindow,
+                [this]()
+                {
+                    m_isSendCoalescingTimerStarted = false;
+                    sendQueuedMessages();
+                });
+        }
+        return;
+    }
+
+    if (m_isSendCoalescingTimerStarted)
+    {
+        m_sendCoalescingTimer->cancelSync();
+        m_isSendCoalescingTimerStarted = false;
     }
+
+    sendQueuedMessages();
+}
+
+void WebSocket::sendQueuedMessages()
+{
+    if (m_writeQueue.empty() || m_messagesBeingSent > 0)
+        return;
+
+    m_messagesBeingSent = 1;
+    const nx::Buffer* sendBuffer = &m_sendBuffer;
+    if (m_writeQueue.size() == 1 && m_writeQueue.front().sharedBuffer)
+    {
+        // The frame shared with other connections is sent as is. The queue keeps it alive until
+        // the send completes.
+        sendBuffer = m_writeQueue.front().sharedBuffer.get();
+    }
+    else
+    {
+        auto& front = m_writeQueue.front();
+        m_sendBuffer = front.sharedBuffer ? *front.sharedBuffer : std::move(front.buffer);
+        for (; m_messagesBeingSent < m_writeQueue.size(); ++m_messagesBeingSent)
+        {
+            auto& context = m_writeQueue[m_messagesBeingSent];
+            const auto& buffer = context.data();
+            if (m_sendBuffer.size() + buffer.size() > kMaxCoalescedSendSize)
+                break;
+
+            m_sendBuffer.append(buffer.data(), buffer.size());
+            context.buffer.clear();
+            context.sharedBuffer.reset();
+        }
+    }
+
+    NX_VERBOSE(this, "Sending %1 message(s), %2 bytes", m_messagesBeingSent, sendBuffer->size());
+
+    m_socket->sendAsync(
+        sendBuffer,
+        [this](SystemError::ErrorCode error, size_t transferred)
+        {
+            onWrite(error, transferred);
+        });
 }
 
 QString WebSocket::lastErrorMessage() const
@@ -343,6 +464,7 @@ void WebSocket::onWrite(SystemError::ErrorCode error, size_t transferred)
 {
     if (m_failed)
     {
+        m_messagesBeingSent = 0;
         while (!m_writeQueue.empty())
         {
             utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
@@ -356,6 +478,7 @@ void WebSocket::onWrite(SystemError::ErrorCode error, size_t transferred)
     if (error != SystemError::noError)
     {
         setFailedState(nx::format("Write error %1", error));
+        m_messagesBeingSent = 0;
         while (!m_writeQueue.empty())
         {
             utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
@@ -367,6 +490,7 @@ void WebSocket::onWrite(SystemError::ErrorCode error, size_t transferred)
     else if (transferred == 0)
     {
         setFailedState("0 bytes written");
+        m_messagesBeingSent = 0;
         while (!m_writeQueue.empty())
         {
             utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
@@ -377,34 +501,36 @@ void WebSocket::onWrite(SystemError::ErrorCode error, size_t transferred)
     }
     else
     {
-        utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
-        callOnWriteHandler(SystemError::noError, transferred);
-        if (watcher.interrupted())
-            return;
-
-        if (!m_writeQueue.empty())
+        // Decrementing before invoking the handler, so that the handler sees the actual state.
+        while (m_messagesBeingSent > 0)
         {
-            m_socket->sendAsync(
-                &m_writeQueue.front().second,
-                [this](SystemError::ErrorCode error, size_t transferred)
-                {
-                    onWrite(error, transferred);
-                });
+            --m_messagesBeingSent;
+            utils::InterruptionFlag::Watcher watcher(&m_destructionFlag);
+            callOnWriteHandler(SystemError::noError, m_writeQueue.front().userDataSize);
+            if (watcher.interrupted())
+                return;
         }
+
+        sendQueuedMessages();
     }
 }
 
 void WebSocket::callOnWriteHandler(SystemError::ErrorCode error, size_t transferred)
 {
-    const auto userWritePair = std::move(m_writeQueue.front());
-    m_writeQueue.pop();
-    userWritePair.first(error, transferred);
+    auto writeContext = std::move(m_writeQueue.front());
+    m_writeQueue.pop_front();
+    writeContext.handler(error, transferred);
 }
 
 void WebSocket::cancelIoInAioThread(nx::network::aio::EventType eventType)
 {
     m_pingTimer->cancelSync();
     m_pongTimer->cancelSync();
+    if (eventType == aio::EventType::etWrite || eventType == aio::EventType::etAll)
+    {
+        m_sendCoalescingTimer->cancelSync();
+        m_isSendCoalescingTimerStarted = false;
+    }
     m_socket->cancelIOSync(eventType);
 }
 
@@ -452,8 +578,9 @@ void WebSocket::sendControlResponse(FrameType type)
         m_serializer.prepareMessage(m_controlBuffer, type, m_compressionType);
     m_controlBuffer.resize(0);
 
+    const auto responseFrameSize = responseFrame.size();
     sendMessage(
-        responseFrame, responseFrame.size(),
+        std::move(responseFrame), responseFrameSize,
         [this, type](SystemError::ErrorCode error, size_t /*transferred*/)
         {
             NX_VERBOSE(
@@ -461,14 +588,16 @@ void WebSocket::sendControlResponse(FrameType type)
                 nx::format("Control response %1 has been sent. Result: %2").args(
                     frameTypeString(type),
                     error));
-        });
+        },
+        /*canBeDelayed*/ false);
 }
 
 void WebSocket::sendControlRequest(FrameType type)
 {
     nx::Buffer requestFrame = m_serializer.prepareMessage("", type, m_compressionType);
+    const auto requestFrameSize = requestFrame.size();
     sendMessage(
-        requestFrame, requestFrame.size(),
+        std::move(requestFrame), requestFrameSize,
         [this, type](SystemError::ErrorCode error, size_t /*transferred*/)
         {
             NX_VERBOSE(
@@ -476,7 +605,8 @@ void WebSocket::sendControlRequest(FrameType type)
                 nx::format("Control request %1 has been sent. Result: %2").args(
                     frameTypeString(type),
                     error));
-        });
+        },
+        /*canBeDelayed*/ false);
 }
 
 std::string frameTypeString(FrameType type)
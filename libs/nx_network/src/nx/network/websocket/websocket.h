@@ -2,8 +2,8 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
-#include <queue>
 
 #include <nx/network/aio/abstract_async_channel.h>
 #include <nx/network/aio/timer.h>
@@ -49,6 +49,13 @@ public:
     void readAsync(Frame* const frame, IoCompletionHandler handler);
     void sendAsync(Frame&& frame, IoCompletionHandler handler);
 
+    /**
+     * Sends the message serialized once for many peers. Its frame goes to the socket without
+     * copying when this peer can take it as is, otherwise the payload is serialized as by the
+     * other overloads.
+     */
+    void sendAsync(std::shared_ptr<const SharedMessage> message, IoCompletionHandler handler);
+
     virtual void readSomeAsync(nx::Buffer* const buffer, IoCompletionHandler handler) override;
     virtual void sendAsync(const nx::Buffer* buffer, IoCompletionHandler handler) override;
 
@@ -80,6 +87,16 @@ public:
     const AbstractStreamSocket* socket() const { return m_socket.get(); }
     QString lastErrorMessage() const;
 
+    /**
+     * Enables Nagle-like coalescing of small messages: a message that is sent while no socket
+     * send is in progress is delayed for up to window, so that messages sent during this time go
+     * to the socket in a single send call. Messages queued while a socket send is in progress are
+     * always sent with a single call as soon as the previous one completes.
+     * Zero window (the default) disables the delay. Control frames are never delayed.
+     * NOTE: Should be called before start().
+     */
+    void setSendCoalescingWindow(std::chrono::milliseconds window);
+
     /**
      * Disable PONG responses.
      * NOTE: Don't call it unless you are completely sure what you are doing.
@@ -102,6 +119,18 @@ private:
     };
     using UserReadContextPtr = std::unique_ptr<UserReadContext>;
 
+    struct WriteContext
+    {
+        IoCompletionHandler handler;
+        nx::Buffer buffer;
+        /** Reported to the handler as the number of bytes transferred. */
+        std::size_t userDataSize = 0;
+        /** The frame shared with other connections. Used instead of buffer if set. */
+        std::shared_ptr<const nx::Buffer> sharedBuffer;
+
+        const nx::Buffer& data() const { return sharedBuffer ? *sharedBuffer : buffer; }
+    };
+
     std::unique_ptr<AbstractStreamSocket> m_socket;
     Parser m_parser;
     Serializer m_serializer;
@@ -109,7 +138,13 @@ private:
     ReceiveMode m_receiveMode;
     bool m_isLastFrame = false;
     bool m_isFirstFrame = true;
-    std::queue<std::pair<IoCompletionHandler, nx::Buffer>> m_writeQueue;
+    std::deque<WriteContext> m_writeQueue;
+    /** The number of m_writeQueue elements being sent with m_sendBuffer. */
+    std::size_t m_messagesBeingSent = 0;
+    nx::Buffer m_sendBuffer;
+    std::chrono::milliseconds m_sendCoalescingWindow = std::chrono::milliseconds::zero();
+    std::unique_ptr<nx::network::aio::Timer> m_sendCoalescingTimer;
+    bool m_isSendCoalescingTimerStarted = false;
     UserReadContextPtr m_userReadContext;
     websocket::MultiBuffer m_incomingMessageQueue;
     nx::Buffer m_controlBuffer;
@@ -131,7 +166,14 @@ private:
     void gotFrame(FrameType type, nx::Buffer&& data, bool fin);
 
     /** Own helper functions*/
-    void sendMessage(const nx::Buffer& message, int writeSize, IoCompletionHandler handler);
+    void sendFrame(Frame frame, IoCompletionHandler handler);
+    void sendMessage(
+        nx::Buffer message,
+        std::size_t writeSize,
+        IoCompletionHandler handler,
+        bool canBeDelayed = true);
+    void sendMessage(WriteContext context, bool canBeDelayed = true);
+    void sendQueuedMessages();
     void sendControlResponse(FrameType type);
     void sendControlRequest(FrameType type);
     void onPingTimer();
@@ -2,6 +2,8 @@
 
 #include "websocket_common_types.h"
 
+#include <cstring>
+
 namespace nx::network::websocket {
 
 std::string toString(Error error)
@@ -25,4 +27,27 @@ std::string toString(Error error)
     return "unknown";
 }
 
+void applyMask(char* data, std::size_t size, std::uint32_t mask, std::size_t maskOffset)
+{
+    unsigned char maskBytes[sizeof(std::uint64_t)];
+    for (std::size_t i = 0; i < sizeof(maskBytes); ++i)
+        maskBytes[i] = ((const unsigned char*) &mask)[(maskOffset + i) % sizeof(mask)];
+
+    // The word is a multiple of the mask size, so the mask is aligned the same way in every word.
+    std::uint64_t wordMask = 0;
+    memcpy(&wordMask, maskBytes, sizeof(wordMask));
+
+    std::size_t pos = 0;
+    for (; pos + sizeof(wordMask) <= size; pos += sizeof(wordMask))
+    {
+        std::uint64_t word = 0;
+        memcpy(&word, data + pos, sizeof(word));
+        word ^= wordMask;
+        memcpy(data + pos, &word, sizeof(word));
+    }
+
+    for (std::size_t i = 0; pos < size; ++pos, ++i)
+        data[pos] ^= maskBytes[i];
+}
+
 } // namespace nx::network::websocket
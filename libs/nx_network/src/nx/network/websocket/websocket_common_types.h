@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <string>
 
@@ -115,4 +117,13 @@ inline bool shouldMessageBeCompressed(
     return payloadLen > kCompressionMessageThreshold;
 }
 
+/**
+ * XORs data with the masking key (RFC 6455, section 5.3). The data is processed word by word.
+ * @param mask Masking key as it is stored in the frame header (in network byte order).
+ * @param maskOffset Index of the masking key byte corresponding to data[0]. Allows (un)masking
+ *     a payload that arrives in several portions.
+ */
+NX_NETWORK_API void applyMask(
+    char* data, std::size_t size, std::uint32_t mask, std::size_t maskOffset = 0);
+
 } // namespace nx::network::websocket
@@ -38,18 +38,18 @@ Parser::BufferedState Parser::bufferDataIfNeeded(const char* data, int len, int
     return BufferedState::enough;
 }
 
-Parser::ParseState Parser::processPayload(char* data, int len)
+Parser::ParseState Parser::processPayload(const char* data, int len)
 {
     int outLen = std::min(len, m_payloadLen);
+
+    // Unmasking the copy, so that the source data is not modified and can be shared.
+    const auto frameBufferSize = m_frameBuffer.size();
+    m_frameBuffer.append(data, outLen);
     if (m_masked)
     {
-        for (int i = 0; i < outLen; i++)
-        {
-            data[i] = data[i] ^ ((unsigned char*)(&m_mask))[m_maskPos % 4];
-            m_maskPos++;
-        }
+        applyMask(m_frameBuffer.data() + frameBufferSize, outLen, m_mask, m_maskPos);
+        m_maskPos += outLen;
     }
-    m_frameBuffer.append(data, outLen);
     m_payloadLen -= outLen;
     m_pos += outLen;
     if (m_payloadLen == 0)
@@ -61,7 +61,10 @@ Parser::ParseState Parser::processPayload(char* data, int len)
 }
 
 void Parser::processPart(
-    char* data, int len, int neededLen, ParseState (Parser::*processFunc)(char* data))
+    const char* data,
+    int len,
+    int neededLen,
+    ParseState (Parser::*processFunc)(const char* data))
 {
     switch (bufferDataIfNeeded(data, len, neededLen))
     {
@@ -78,7 +81,7 @@ void Parser::processPart(
     }
 }
 
-void Parser::parse(char* data, int len)
+void Parser::parse(const char* data, int len)
 {
     switch (m_state)
     {
@@ -114,12 +117,22 @@ void Parser::consume(nx::Buffer& buf)
     consume(buf.data(), buf.size());
 }
 
+void Parser::consume(const nx::BufferChain& data)
+{
+    for (const auto& slice: data)
+    {
+        m_pos = 0;
+        while (m_pos < (int) slice.size())
+            parse(slice.data() + m_pos, (int) slice.size() - m_pos);
+    }
+}
+
 void Parser::setRole(Role role)
 {
     m_role = role;
 }
 
-Parser::ParseState Parser::readHeaderFixed(char* data)
+Parser::ParseState Parser::readHeaderFixed(const char* data)
 {
     m_opCode = (FrameType)(*data & 0x0F);
     m_fin = (*data >> 7) & 0x01;
@@ -152,8 +165,9 @@ void Parser::handleFrame()
         }
         else
         {
+            // The inflate context is kept between messages since the peer may refer to the
+            // previous messages (RFC 7692, section 7.2.1 "context takeover").
             m_uncompressor.processData(m_frameBuffer);
-            m_frameBuffer = m_uncompressed;
 
             if (m_fin)
             {
@@ -164,6 +178,7 @@ void Parser::handleFrame()
                 m_uncompressor.processData(buf);
             }
 
+            m_frameBuffer = std::move(m_uncompressed);
             m_uncompressed.clear();
         }
     }
@@ -181,7 +196,7 @@ void Parser::handleFrame()
     }
 }
 
-Parser::ParseState Parser::readHeaderExtension(char* data)
+Parser::ParseState Parser::readHeaderExtension(const char* data)
 {
     if (m_payloadLen == 126)
     {
@@ -196,7 +211,7 @@ Parser::ParseState Parser::readHeaderExtension(char* data)
 
     if (m_masked)
     {
-        m_mask = *((unsigned int*)(data));
+        m_mask = *((const unsigned int*)(data));
         m_maskPos = 0;
     }
 
@@ -6,6 +6,7 @@
 #include <nx/utils/byte_stream/custom_output_stream.h>
 #include <nx/utils/gzip/gzip_uncompressor.h>
 #include <nx/utils/move_only_func.h>
+#include <nx/utils/shared_buffer.h>
 
 #include "websocket_common_types.h"
 
@@ -35,6 +36,11 @@ public:
     Parser(Role role, GotFrameHandler gotFrameHandler);
     void consume(char* data, int len);
     void consume(nx::Buffer& buf);
+
+    /**
+     * Parses the slices one after another without joining them. The data is not modified.
+     */
+    void consume(const nx::BufferChain& data);
     void setRole(Role role);
     FrameType frameType() const;
     int frameSize() const;
@@ -58,13 +64,16 @@ private:
     bool m_doUncompress = false;
     nx::utils::bstream::gzip::Uncompressor m_uncompressor;
 
-    void parse(char* data, int len);
+    void parse(const char* data, int len);
     void processPart(
-        char* data, int len, int neededLen, ParseState (Parser::*processFunc)(char* data));
-    ParseState processPayload(char* data, int len);
+        const char* data,
+        int len,
+        int neededLen,
+        ParseState (Parser::*processFunc)(const char* data));
+    ParseState processPayload(const char* data, int len);
     void reset();
-    ParseState readHeaderFixed(char* data);
-    ParseState readHeaderExtension(char* data);
+    ParseState readHeaderFixed(const char* data);
+    ParseState readHeaderExtension(const char* data);
     BufferedState bufferDataIfNeeded(const char* data, int len, int neededLen);
     void handleFrame();
 };
@@ -3,8 +3,8 @@
 #include "websocket_serializer.h"
 
 #include <nx/network/socket_common.h>
+#include <nx/utils/log/assert.h>
 #include <nx/utils/random.h>
-#include <nx/utils/gzip/gzip_compressor.h>
 
 #include <stdint.h>
 
@@ -48,14 +48,7 @@ nx::Buffer Serializer::prepareMessage(
 nx::Buffer Serializer::prepareFrame(nx::Buffer payload, FrameType type, bool fin)
 {
     if (m_doCompress)
-    {
-        payload = nx::utils::bstream::gzip::Compressor::deflateData(std::move(payload));
-        /* https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.3.4
-         * deflateData() generates DEFLATE block with BFINAL bit set.
-         * Such payload should be flushed with empty uncompressed DEFLATE block with BFINAL set to 0.
-         * */
-        payload.append("\x0", 1);
-    }
+        payload = compress(payload);
 
     nx::Buffer header;
     int payloadLenType = payloadLenTypeByLen(payload.size());
@@ -64,12 +57,38 @@ nx::Buffer Serializer::prepareFrame(nx::Buffer payload, FrameType type, bool fin
     fillHeader(header.data(), fin, type, payloadLenType, payload.size());
 
     if (m_masked)
+        applyMask(payload.data(), payload.size(), m_mask);
+
+    return header + payload;
+}
+
+nx::Buffer Serializer::compress(const nx::Buffer& payload)
+{
+    // https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.1
+    static constexpr char kSyncFlushTail[] = {'\x00', '\x00', '\xff', '\xff'};
+
+    if (!m_deflater)
+        m_deflater = std::make_unique<nx::utils::bstream::gzip::Deflater>();
+
+    nx::Buffer compressed;
+    compressed.reserve(payload.size() / 2 + sizeof(kSyncFlushTail));
+    const bool isCompressed = m_deflater->compress(payload, &compressed);
+    if (!NX_ASSERT(isCompressed && compressed.ends_with(kSyncFlushTail, sizeof(kSyncFlushTail))))
     {
-        for (std::size_t i = 0; i < payload.size(); ++i)
-            payload[i] = payload[i] ^ ((unsigned char*) (&m_mask))[i % 4];
+        // The peer is not able to inflate anything after that anyway.
+        m_deflater->reset();
+        return compressed;
     }
 
-    return header + payload;
+    // The peer appends the tail back before inflating the message.
+    compressed.resize(compressed.size() - sizeof(kSyncFlushTail));
+    return compressed;
+}
+
+void Serializer::resetCompression()
+{
+    if (m_deflater)
+        m_deflater->reset();
 }
 
 void Serializer::setMasked(bool masked, unsigned mask)
@@ -126,4 +145,21 @@ int Serializer::fillHeader(
     return pdata - data;
 }
 
+//-------------------------------------------------------------------------------------------------
+
+std::shared_ptr<const SharedMessage> SharedMessage::create(nx::Buffer payload, FrameType type)
+{
+    auto message = std::make_shared<SharedMessage>();
+    message->frame = Serializer(/*masked*/ false).prepareMessage(
+        payload, type, CompressionType::none);
+    if (shouldMessageBeCompressed(type, CompressionType::perMessageDeflate, payload.size()))
+    {
+        message->compressedFrame = Serializer(/*masked*/ false).prepareMessage(
+            payload, type, CompressionType::perMessageDeflate);
+    }
+    message->payload = std::move(payload);
+    message->type = type;
+    return message;
+}
+
 } // nx::network::websocket
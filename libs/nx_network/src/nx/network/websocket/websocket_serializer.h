@@ -2,12 +2,20 @@
 
 #pragma once
 
+#include <memory>
+
 #include <nx/utils/buffer.h>
+#include <nx/utils/gzip/gzip_deflater.h>
 
 #include "websocket_common_types.h"
 
 namespace nx::network::websocket {
 
+/**
+ * Compressed messages are produced with the same DEFLATE context, so that every message refers
+ * to the previous ones (RFC 7692, section 7.2.1 "context takeover"). So, all messages produced
+ * by a Serializer MUST be delivered to the same peer in the order they have been produced.
+ */
 class NX_NETWORK_API Serializer
 {
 public:
@@ -16,14 +24,44 @@ public:
     nx::Buffer prepareMessage(const nx::Buffer& payload, FrameType type, CompressionType compressionType);
     nx::Buffer prepareFrame(nx::Buffer payload, FrameType type, bool fin);
 
+    bool isMasked() const { return m_masked; }
+
+    /**
+     * Makes the next compressed message not refer to the previous ones. Must be called when
+     * the peer has been sent a compressed message not produced by this serializer.
+     */
+    void resetCompression();
+
 private:
     bool m_masked = false;
     bool m_doCompress = false;
     unsigned m_mask = 0;
+    std::unique_ptr<nx::utils::bstream::gzip::Deflater> m_deflater;
 
     void setMasked(bool masked, unsigned mask = 0);
+    nx::Buffer compress(const nx::Buffer& payload);
     int fillHeader(char* data, bool fin, FrameType opCode, int payloadLenType, int payloadLen);
 };
 
+/**
+ * A data message serialized once to be sent to many peers with WebSocket::sendAsync(), e.g. a
+ * notification broadcast to all subscribers. The frames are not masked, so only the server side
+ * can send them as is.
+ */
+struct NX_NETWORK_API SharedMessage
+{
+    nx::Buffer payload;
+    FrameType type = FrameType::binary;
+    nx::Buffer frame;
+
+    /**
+     * Compressed from the empty DEFLATE context, so any peer that negotiated per-message deflate
+     * is able to inflate it. Empty if the payload is too small to be compressed.
+     */
+    nx::Buffer compressedFrame;
+
+    static std::shared_ptr<const SharedMessage> create(nx::Buffer payload, FrameType type);
+};
+
 
 } // nx::network::websocket
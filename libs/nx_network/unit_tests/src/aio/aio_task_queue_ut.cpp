@@ -1,5 +1,6 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -96,6 +97,37 @@ protected:
         pollableCtx->isCancelled = true;
     }
 
+    void whenPostedCallsConcurrentlyFromMultipleThreads()
+    {
+        std::vector<std::thread> threads;
+        for (auto& pollableCtx: m_pollables)
+        {
+            threads.emplace_back(
+                [this, pollableCtx = pollableCtx.get()]()
+                {
+                    for (int i = 0; i < kCallsPerThread; ++i)
+                        postCall(pollableCtx, &pollableCtx->invokedCallCounter);
+                });
+        }
+
+        for (auto& thread: threads)
+            thread.join();
+    }
+
+    void thenEveryCallIsInvokedExactlyOnceUnlessCancelled()
+    {
+        m_aioTaskQueue.processPollSetModificationQueue(TaskType::tAll);
+        m_aioTaskQueue.processPostedCalls();
+
+        for (auto& pollableCtx: m_pollables)
+        {
+            const std::size_t expected =
+                pollableCtx->isCancelled ? 0 : pollableCtx->expectedPostedCallCounter;
+            ASSERT_EQ(expected, pollableCtx->invokedCallCounter.load());
+        }
+        ASSERT_EQ(0U, m_aioTaskQueue.postedCallCount());
+    }
+
     void assertFunctorsWereNotRemovedByCancelButReturnedtoTheCaller()
     {
         for (auto& pollableCtx: m_pollables)
@@ -121,6 +153,7 @@ private:
     {
         Pollable pollable;
         std::atomic<std::size_t> postedCallCounter;
+        std::atomic<std::size_t> invokedCallCounter;
         std::size_t expectedPostedCallCounter;
         std::vector<SocketAddRemoveTask> cancelledTasks;
         bool isCancelled;
@@ -128,6 +161,7 @@ private:
         PollableContext():
             pollable(nullptr /*aioThread*/, AbstractSocket::kInvalidSocket),
             postedCallCounter(0),
+            invokedCallCounter(0),
             expectedPostedCallCounter(0),
             isCancelled(false)
         {
@@ -137,13 +171,19 @@ private:
     std::vector<std::unique_ptr<PollableContext>> m_pollables;
     detail::AioTaskQueue m_aioTaskQueue;
 
-    void postCall(PollableContext* pollableContext)
+    static constexpr int kCallsPerThread = 10'000;
+
+    void postCall(
+        PollableContext* pollableContext,
+        std::atomic<std::size_t>* invokedCallCounter = nullptr)
     {
         m_aioTaskQueue.addTask(PostAsyncCallTask(
             &pollableContext->pollable,
             [scopedIncrement = std::make_unique<ScopedIncrement>(
-                &pollableContext->postedCallCounter)]()
+                &pollableContext->postedCallCounter), invokedCallCounter]()
             {
+                if (invokedCallCounter)
+                    ++(*invokedCallCounter);
             }));
         ++pollableContext->expectedPostedCallCounter;
     }
@@ -157,6 +197,14 @@ TEST_F(AioTaskQueue, posted_calls_are_not_freed_by_queue_when_cancelling)
     assertFunctorsWereNotRemovedByCancelButReturnedtoTheCaller();
 }
 
+TEST_F(AioTaskQueue, calls_posted_concurrently_are_invoked_exactly_once)
+{
+    givenSeveralPollables();
+    whenPostedCallsConcurrentlyFromMultipleThreads();
+    whenCancelledCallsOfARandomPollable();
+    thenEveryCallIsInvokedExactlyOnceUnlessCancelled();
+}
+
 } // namespace test
 } // namespace detail
 } // namespace aio
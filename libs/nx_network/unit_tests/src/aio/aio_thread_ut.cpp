@@ -2,6 +2,7 @@
 
 #include <future>
 #include <memory>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -115,6 +116,24 @@ protected:
         ASSERT_EQ(0U, m_aioThread.taskQueue().periodicTasksCount());
     }
 
+    void whenPostedBusyCalls()
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            m_aioThread.post(
+                nullptr,
+                []() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); });
+        }
+    }
+
+    void thenThreadLoadIsReportedEventually()
+    {
+        while (m_aioThread.load().busyRatio == 0 || m_aioThread.load().eventsPerSecond == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        ASSERT_LE(m_aioThread.load().busyRatio, 1.0);
+    }
+
     aio::AioThread m_aioThread;
     std::unique_ptr<TCPSocket> m_tcpSocket;
     nx::utils::SyncQueue<aio::EventType> m_eventsReported;
@@ -198,6 +217,12 @@ TEST_F(AioThread, socket_timer_is_removed_when_deleting_socket)
     thenTimerTaskIsRemovedFromAio();
 }
 
+TEST_F(AioThread, load_is_measured_even_if_thread_is_idle_afterwards)
+{
+    whenPostedBusyCalls();
+    thenThreadLoadIsReportedEventually();
+}
+
 //-------------------------------------------------------------------------------------------------
 
 class FailingPollSet:
@@ -0,0 +1,122 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/aio/awaitables.h>
+#include <nx/network/system_socket.h>
+#include <nx/utils/test_support/sync_queue.h>
+
+namespace nx::network::aio::test {
+
+class AioAwaitables:
+    public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_server = std::make_unique<TCPServerSocket>(AF_INET);
+        ASSERT_TRUE(m_server->setReuseAddrFlag(true));
+        ASSERT_TRUE(m_server->bind(SocketAddress(HostAddress::localhost, 0)));
+        ASSERT_TRUE(m_server->listen(10));
+
+        m_client = std::make_unique<TCPSocket>(AF_INET);
+        ASSERT_TRUE(m_client->setNonBlockingMode(true));
+    }
+
+    virtual void TearDown() override
+    {
+        if (m_client)
+            m_client->pleaseStopSync();
+    }
+
+    nx::coro::FireAndForget connectAndExchange(nx::Buffer request, std::size_t responseSize)
+    {
+        try
+        {
+            const auto connectResult = co_await connect(m_client.get(), m_server->getLocalAddress());
+            m_resumedInAioThread.push(m_client->isInSelfAioThread());
+            if (connectResult != SystemError::noError)
+            {
+                m_results.push(connectResult);
+                co_return;
+            }
+
+            const auto sendResult = co_await send(m_client.get(), &request);
+            if (!sendResult.ok())
+            {
+                m_results.push(sendResult.resultCode);
+                co_return;
+            }
+
+            m_response.reserve(responseSize);
+            const auto readResult = co_await readAtLeast(m_client.get(), &m_response, responseSize);
+            m_results.push(readResult.resultCode);
+        }
+        catch (const nx::coro::TaskCancelException&)
+        {
+            m_results.push(SystemError::interrupted);
+        }
+    }
+
+    std::unique_ptr<AbstractStreamSocket> acceptConnection()
+    {
+        auto connection = m_server->accept();
+        if (connection)
+            connection->setNonBlockingMode(false);
+        return connection;
+    }
+
+protected:
+    std::unique_ptr<TCPServerSocket> m_server;
+    std::unique_ptr<TCPSocket> m_client;
+    nx::Buffer m_response;
+    nx::utils::TestSyncQueue<SystemError::ErrorCode> m_results;
+    nx::utils::TestSyncQueue<bool> m_resumedInAioThread;
+};
+
+TEST_F(AioAwaitables, socket_operations_resume_coroutine_in_aio_thread)
+{
+    const nx::Buffer request("ping");
+    const nx::Buffer response("pong");
+
+    connectAndExchange(request, response.size());
+    auto connection = acceptConnection();
+    ASSERT_NE(nullptr, connection);
+    ASSERT_TRUE(m_resumedInAioThread.pop());
+
+    nx::Buffer received(request.size(), '\0');
+    ASSERT_EQ((int) request.size(), connection->recv(received.data(), received.size(), MSG_WAITALL));
+    ASSERT_EQ(request, received);
+    ASSERT_EQ((int) response.size(), connection->send(response));
+
+    ASSERT_EQ(SystemError::noError, m_results.pop());
+    ASSERT_EQ(response, m_response);
+}
+
+TEST_F(AioAwaitables, cancelled_operation_throws_task_cancel_exception)
+{
+    connectAndExchange(nx::Buffer("ping"), 4);
+    auto connection = acceptConnection();
+    ASSERT_NE(nullptr, connection);
+
+    // The coroutine is waiting for the response.
+    m_client->pleaseStopSync();
+    ASSERT_EQ(SystemError::interrupted, m_results.pop());
+}
+
+TEST_F(AioAwaitables, timer_sleep)
+{
+    Timer timer;
+    nx::utils::TestSyncQueue<bool> resumed;
+
+    [](Timer* timer, nx::utils::TestSyncQueue<bool>* resumed) -> nx::coro::FireAndForget
+    {
+        co_await sleep(timer, std::chrono::milliseconds(10));
+        resumed->push(timer->isInSelfAioThread());
+    }(&timer, &resumed);
+
+    ASSERT_TRUE(resumed.pop());
+    timer.pleaseStopSync();
+}
+
+} // namespace nx::network::aio::test
@@ -0,0 +1,123 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <map>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/aio/pollset_io_uring_linux.h>
+#include <nx/utils/test_support/utils.h>
+
+#include "pollset_test_common.h"
+#include "pollset_performance_tests.h"
+
+namespace nx::network::aio::test {
+
+class IoUringPollSetHelper
+{
+public:
+    using PollSet = aio::IoUringPollSet;
+
+    bool simulateSocketEvent(Pollable* socket, int /*eventMask*/)
+    {
+        const auto udpSocket = static_cast<UDPSocket*>(socket);
+
+        char buf[16];
+        NX_GTEST_ASSERT_TRUE(udpSocket->sendTo(buf, sizeof(buf), udpSocket->getLocalAddress()));
+
+        return true;
+    }
+
+    std::unique_ptr<Pollable> createRegularSocket()
+    {
+        auto udpSocket = std::make_unique<UDPSocket>(AF_INET);
+        NX_GTEST_ASSERT_TRUE(udpSocket->bind(SocketAddress(HostAddress::localhost, 0)));
+        return udpSocket;
+    }
+
+    std::unique_ptr<Pollable> createSocketOfRandomType()
+    {
+        return createRegularSocket();
+    }
+
+    std::vector<std::unique_ptr<Pollable>> createSocketOfAllSupportedTypes()
+    {
+        std::vector<std::unique_ptr<Pollable>> sockets;
+        sockets.push_back(createRegularSocket());
+        return sockets;
+    }
+};
+
+TEST(IoUringPollSet, validity_matches_kernel_support)
+{
+    IoUringPollSet pollSet;
+    ASSERT_EQ(IoUringPollSet::isSupported(), pollSet.isValid());
+}
+
+TEST(IoUringPollSet, more_subscriptions_than_submission_queue_entries)
+{
+    using namespace std::chrono;
+
+    if (!IoUringPollSet::isSupported())
+        GTEST_SKIP() << "io_uring is not supported";
+
+    static constexpr int kSocketCount = 64;
+    static constexpr int kReportsPerSocket = 3;
+
+    IoUringPollSet pollSet(/*submissionQueueSize*/ 4);
+    ASSERT_TRUE(pollSet.isValid());
+
+    IoUringPollSetHelper helper;
+    std::vector<std::unique_ptr<Pollable>> sockets;
+    for (int i = 0; i < kSocketCount; ++i)
+    {
+        sockets.push_back(helper.createRegularSocket());
+        ASSERT_TRUE(pollSet.add(sockets.back().get(), etRead));
+        ASSERT_TRUE(helper.simulateSocketEvent(sockets.back().get(), etRead));
+    }
+
+    // The data is never read, so every socket has to be reported again after each re-arm.
+    std::map<Pollable*, int> reportCounts;
+    const auto isEverySocketReported =
+        [&]()
+        {
+            for (const auto& socket: sockets)
+            {
+                if (reportCounts[socket.get()] < kReportsPerSocket)
+                    return false;
+            }
+            return true;
+        };
+
+    for (int i = 0; i < kSocketCount * kReportsPerSocket && !isEverySocketReported(); ++i)
+    {
+        ASSERT_GT(pollSet.poll(milliseconds(10s).count()), 0);
+        for (auto it = pollSet.getSocketEventsIterator(); it->next();)
+            ++reportCounts[it->socket()];
+    }
+    ASSERT_TRUE(isEverySocketReported());
+
+    // Removal overflows the submission queue as well, the interrupt must survive it.
+    for (const auto& socket: sockets)
+        pollSet.remove(socket.get(), etRead);
+
+    std::thread interruptThread(
+        [&pollSet]()
+        {
+            std::this_thread::sleep_for(100ms);
+            pollSet.interrupt();
+        });
+    const auto startTime = steady_clock::now();
+    pollSet.poll(milliseconds(1min).count());
+    interruptThread.join();
+    ASSERT_LT(steady_clock::now() - startTime, 30s);
+}
+
+INSTANTIATE_TYPED_TEST_SUITE_P(IoUringPollSet, PollSetAcceptance, IoUringPollSetHelper);
+
+//-------------------------------------------------------------------------------------------------
+
+INSTANTIATE_TYPED_TEST_SUITE_P(IoUringPollSet, PollSetPerformance, aio::IoUringPollSet);
+
+} // namespace nx::network::aio::test
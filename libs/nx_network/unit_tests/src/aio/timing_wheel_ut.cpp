@@ -0,0 +1,197 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/aio/detail/timing_wheel.h>
+#include <nx/utils/random.h>
+
+namespace nx::network::aio::detail::test {
+
+class TimingWheel:
+    public ::testing::Test
+{
+protected:
+    void setTickGranularity(std::chrono::milliseconds granularity)
+    {
+        m_wheel = std::make_unique<detail::TimingWheel<int>>(granularity);
+    }
+
+    detail::TimingWheel<int>::Handle add(std::int64_t clock, int value)
+    {
+        m_expected.emplace(clock, value);
+        return m_wheel->add(clock, value);
+    }
+
+    void remove(detail::TimingWheel<int>::Handle handle, int value)
+    {
+        m_wheel->remove(handle);
+        std::erase_if(m_expected, [value](const auto& item) { return item.second == value; });
+    }
+
+    /**
+     * Takes everything that expired by the clock and verifies that nothing expires earlier than
+     * its clock and not later than the tick granularity after it.
+     */
+    std::vector<int> takeExpired(std::int64_t curClock)
+    {
+        std::vector<int> values;
+        while (auto value = m_wheel->takeNextExpired(curClock))
+        {
+            const auto it = std::find_if(m_expected.begin(), m_expected.end(),
+                [&value](const auto& item) { return item.second == *value; });
+            EXPECT_NE(m_expected.end(), it);
+            if (it == m_expected.end())
+                continue;
+
+            EXPECT_LE(it->first, curClock);
+            m_expected.erase(it);
+            values.push_back(*value);
+        }
+
+        for (const auto& [clock, value]: m_expected)
+            EXPECT_GT(clock + m_wheel->tickGranularity().count(), curClock) << value;
+
+        return values;
+    }
+
+    void thenNextEventClockIsNotLaterThanEarliestElement()
+    {
+        if (m_expected.empty())
+            return;
+
+        ASSERT_NE(0, m_wheel->nextEventClock());
+        ASSERT_LE(m_wheel->nextEventClock(), m_expected.begin()->first);
+    }
+
+    /**
+     * Emulates the AIO thread: sleeping until the next event clock and processing the wheel.
+     */
+    void processUntilEmpty()
+    {
+        while (!m_wheel->empty())
+        {
+            thenNextEventClockIsNotLaterThanEarliestElement();
+            takeExpired(m_wheel->nextEventClock());
+        }
+        ASSERT_TRUE(m_expected.empty());
+    }
+
+    detail::TimingWheel<int>& wheel() { return *m_wheel; }
+
+private:
+    std::unique_ptr<detail::TimingWheel<int>> m_wheel =
+        std::make_unique<detail::TimingWheel<int>>();
+    std::multimap<std::int64_t, int> m_expected;
+};
+
+TEST_F(TimingWheel, elements_expire_in_clock_order)
+{
+    add(30, 3);
+    add(10, 1);
+    add(20, 2);
+
+    ASSERT_EQ(10, wheel().nextEventClock());
+    ASSERT_TRUE(takeExpired(9).empty());
+    ASSERT_EQ(std::vector<int>({1}), takeExpired(10));
+    ASSERT_EQ(std::vector<int>({2, 3}), takeExpired(35));
+    ASSERT_TRUE(wheel().empty());
+    ASSERT_EQ(0, wheel().nextEventClock());
+}
+
+TEST_F(TimingWheel, elements_with_the_same_clock_expire_in_the_order_added)
+{
+    for (int i = 0; i < 10; ++i)
+        add(100, i);
+
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), takeExpired(100));
+}
+
+TEST_F(TimingWheel, element_in_the_past_expires_immediately)
+{
+    takeExpired(1000);
+    add(500, 1);
+
+    ASSERT_EQ(500, wheel().nextEventClock());
+    ASSERT_EQ(std::vector<int>({1}), takeExpired(1000));
+}
+
+TEST_F(TimingWheel, removed_element_does_not_expire)
+{
+    add(10, 1);
+    const auto handle = add(20, 2);
+    add(30, 3);
+
+    remove(handle, 2);
+
+    ASSERT_EQ(2U, wheel().size());
+    ASSERT_EQ(std::vector<int>({1, 3}), takeExpired(100));
+}
+
+TEST_F(TimingWheel, element_expires_not_earlier_than_its_clock_with_coarse_granularity)
+{
+    setTickGranularity(std::chrono::milliseconds(10));
+
+    add(101, 1);
+
+    ASSERT_TRUE(takeExpired(105).empty());
+    ASSERT_TRUE(takeExpired(109).empty());
+    ASSERT_EQ(std::vector<int>({1}), takeExpired(110));
+}
+
+TEST_F(TimingWheel, far_elements_are_cascaded_to_lower_levels)
+{
+    takeExpired(12345);
+
+    add(12345 + 300, 1); //< Level 1.
+    add(12345 + 70'000, 2); //< Level 2.
+    add(12345 + 20'000'000, 3); //< Level 3.
+    add(12345 + 5'000'000'000LL, 4); //< Beyond the wheel range.
+
+    processUntilEmpty();
+}
+
+TEST_F(TimingWheel, large_clock_jump_does_not_skip_elements)
+{
+    add(1000, 1);
+    add(1'000'000, 2);
+
+    ASSERT_EQ(std::vector<int>({1, 2}), takeExpired(10'000'000'000LL));
+}
+
+TEST_F(TimingWheel, random_elements)
+{
+    std::int64_t curClock = nx::utils::random::number<std::int64_t>(0, 1'000'000'000);
+    takeExpired(curClock);
+
+    std::vector<detail::TimingWheel<int>::Handle> handles;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const auto timeout = nx::utils::random::number<std::int64_t>(0, 100'000'000);
+        handles.push_back(add(curClock + timeout, i));
+    }
+
+    for (int i = 0; i < 200; ++i)
+        remove(handles[i * 10], i * 10);
+
+    processUntilEmpty();
+}
+
+TEST_F(TimingWheel, take_all_values)
+{
+    add(10, 1);
+    add(1'000'000, 2);
+    takeExpired(0);
+
+    auto values = wheel().takeAllValues();
+    std::sort(values.begin(), values.end());
+
+    ASSERT_EQ(std::vector<int>({1, 2}), values);
+    ASSERT_TRUE(wheel().empty());
+    ASSERT_EQ(0, wheel().nextEventClock());
+}
+
+} // namespace nx::network::aio::detail::test
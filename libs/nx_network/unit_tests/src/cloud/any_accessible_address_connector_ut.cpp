@@ -0,0 +1,120 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/cloud/any_accessible_address_connector.h>
+#include <nx/network/cloud/connect_history.h>
+#include <nx/network/system_socket.h>
+#include <nx/utils/std/future.h>
+
+namespace nx::network::cloud::test {
+
+class AnyAccessibleAddressConnector:
+    public ::testing::Test
+{
+protected:
+    static constexpr char kTarget[] = "target";
+
+    virtual void SetUp() override
+    {
+        m_server = std::make_unique<TCPServerSocket>(AF_INET);
+        ASSERT_TRUE(m_server->bind(SocketAddress::anyPrivateAddressV4));
+        ASSERT_TRUE(m_server->listen());
+
+        // The port nobody listens on. So, the connection is refused immediately.
+        TCPServerSocket closedServer(AF_INET);
+        ASSERT_TRUE(closedServer.bind(SocketAddress::anyPrivateAddressV4));
+        m_closedEndpoint = closedServer.getLocalAddress();
+    }
+
+    virtual void TearDown() override
+    {
+        if (m_connector)
+            m_connector->pleaseStopSync();
+    }
+
+    void whenConnect(
+        std::deque<AddressEntry> entries,
+        std::chrono::milliseconds connectAttemptDelay)
+    {
+        m_connector = std::make_unique<cloud::AnyAccessibleAddressConnector>(
+            AF_INET, std::move(entries));
+        m_connector->setConnectAttemptDelay(connectAttemptDelay);
+        m_connector->setConnectHistory(&m_history, kTarget);
+
+        nx::utils::promise<SystemError::ErrorCode> done;
+        m_connector->connectAsync(
+            std::chrono::seconds(10),
+            StreamSocketAttributes(),
+            [this, &done](
+                SystemError::ErrorCode resultCode,
+                std::optional<TunnelAttributes> /*cloudTunnelAttributes*/,
+                std::unique_ptr<AbstractStreamSocket> connection)
+            {
+                m_connection = std::move(connection);
+                done.set_value(resultCode);
+            });
+        m_resultCode = done.get_future().get();
+    }
+
+    void thenConnectionIsEstablished()
+    {
+        ASSERT_EQ(SystemError::noError, m_resultCode);
+        ASSERT_NE(nullptr, m_connection);
+        ASSERT_EQ(m_server->getLocalAddress(), m_connection->getForeignAddress());
+    }
+
+    void thenConnectFailed()
+    {
+        ASSERT_NE(SystemError::noError, m_resultCode);
+        ASSERT_EQ(nullptr, m_connection);
+    }
+
+    void andEntriesAreOrderedByHistory(std::deque<AddressEntry> expected)
+    {
+        auto entries = expected;
+        std::reverse(entries.begin(), entries.end());
+        m_history.sort(kTarget, &entries);
+        ASSERT_EQ(expected, entries);
+    }
+
+    AddressEntry serverEntry() const { return AddressEntry(m_server->getLocalAddress()); }
+    AddressEntry closedEntry() const { return AddressEntry(m_closedEndpoint); }
+
+private:
+    std::unique_ptr<TCPServerSocket> m_server;
+    SocketAddress m_closedEndpoint;
+    ConnectHistory m_history;
+    std::unique_ptr<cloud::AnyAccessibleAddressConnector> m_connector;
+    SystemError::ErrorCode m_resultCode = SystemError::noError;
+    std::unique_ptr<AbstractStreamSocket> m_connection;
+};
+
+TEST_F(AnyAccessibleAddressConnector, next_entry_is_tried_as_soon_as_previous_fails)
+{
+    // The delay is large enough for the test to time out if it was waited for.
+    whenConnect({closedEntry(), serverEntry()}, std::chrono::hours(1));
+
+    thenConnectionIsEstablished();
+    andEntriesAreOrderedByHistory({serverEntry(), closedEntry()});
+}
+
+TEST_F(AnyAccessibleAddressConnector, all_entries_are_tried_at_once_with_zero_delay)
+{
+    whenConnect({closedEntry(), serverEntry()}, std::chrono::milliseconds::zero());
+
+    thenConnectionIsEstablished();
+}
+
+TEST_F(AnyAccessibleAddressConnector, failure_is_reported_when_all_entries_fail)
+{
+    whenConnect(
+        {closedEntry()},
+        cloud::AnyAccessibleAddressConnector::kDefaultConnectAttemptDelay);
+
+    thenConnectFailed();
+}
+
+} // namespace nx::network::cloud::test
@@ -0,0 +1,90 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/cloud/connect_history.h>
+
+namespace nx::network::cloud::test {
+
+class ConnectHistory:
+    public ::testing::Test
+{
+protected:
+    static constexpr char kTarget[] = "target";
+
+    std::deque<AddressEntry> sorted(const std::string& target = kTarget)
+    {
+        auto entries = m_entries;
+        m_history.sort(target, &entries);
+        return entries;
+    }
+
+    const AddressEntry& entry(int index) const { return m_entries[index]; }
+
+    cloud::ConnectHistory& history() { return m_history; }
+
+private:
+    std::deque<AddressEntry> m_entries = {
+        AddressEntry(SocketAddress("192.168.0.1", 7001)),
+        AddressEntry(SocketAddress("192.168.0.2", 7001)),
+        AddressEntry(SocketAddress("192.168.0.3", 7001)),
+        AddressEntry(AddressType::cloud, HostAddress("system_id")),
+    };
+    cloud::ConnectHistory m_history;
+};
+
+TEST_F(ConnectHistory, original_order_is_kept_without_history)
+{
+    ASSERT_EQ(std::deque<AddressEntry>({entry(0), entry(1), entry(2), entry(3)}), sorted());
+}
+
+TEST_F(ConnectHistory, successful_entry_goes_first)
+{
+    history().saveSuccess(kTarget, entry(2), std::chrono::milliseconds(10));
+
+    ASSERT_EQ(std::deque<AddressEntry>({entry(2), entry(0), entry(1), entry(3)}), sorted());
+}
+
+TEST_F(ConnectHistory, faster_entry_goes_first)
+{
+    history().saveSuccess(kTarget, entry(3), std::chrono::milliseconds(100));
+    history().saveSuccess(kTarget, entry(1), std::chrono::milliseconds(10));
+
+    ASSERT_EQ(std::deque<AddressEntry>({entry(1), entry(3), entry(0), entry(2)}), sorted());
+}
+
+TEST_F(ConnectHistory, failed_entries_go_last)
+{
+    history().saveFailure(kTarget, entry(0));
+    history().saveFailure(kTarget, entry(0));
+    history().saveFailure(kTarget, entry(1));
+
+    ASSERT_EQ(std::deque<AddressEntry>({entry(2), entry(3), entry(1), entry(0)}), sorted());
+}
+
+TEST_F(ConnectHistory, failure_overrides_previous_success)
+{
+    history().saveSuccess(kTarget, entry(1), std::chrono::milliseconds(10));
+    history().saveFailure(kTarget, entry(1));
+
+    ASSERT_EQ(std::deque<AddressEntry>({entry(0), entry(2), entry(3), entry(1)}), sorted());
+}
+
+TEST_F(ConnectHistory, history_is_kept_per_target)
+{
+    history().saveSuccess(kTarget, entry(2), std::chrono::milliseconds(10));
+
+    ASSERT_EQ(
+        std::deque<AddressEntry>({entry(0), entry(1), entry(2), entry(3)}),
+        sorted("another_target"));
+}
+
+TEST_F(ConnectHistory, clear)
+{
+    history().saveSuccess(kTarget, entry(2), std::chrono::milliseconds(10));
+    history().clear();
+
+    ASSERT_EQ(std::deque<AddressEntry>({entry(0), entry(1), entry(2), entry(3)}), sorted());
+}
+
+} // namespace nx::network::cloud::test
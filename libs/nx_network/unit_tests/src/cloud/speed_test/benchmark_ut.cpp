@@ -0,0 +1,106 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/cloud/speed_test/benchmark/benchmark_client.h>
+#include <nx/network/cloud/speed_test/benchmark/benchmark_server.h>
+#include <nx/utils/std/future.h>
+
+namespace nx::network::cloud::speed_test::benchmark::test {
+
+TEST(BenchmarkLatencyStatistics, percentiles_are_calculated_by_nearest_rank)
+{
+    std::vector<std::chrono::microseconds> samples;
+    for (int i = 100; i > 0; --i)
+        samples.push_back(std::chrono::microseconds(i));
+
+    const auto statistics = LatencyStatistics::calculate(&samples);
+
+    ASSERT_EQ(100U, statistics.count);
+    ASSERT_EQ(std::chrono::microseconds(1), statistics.min);
+    ASSERT_EQ(std::chrono::microseconds(50), statistics.p50);
+    ASSERT_EQ(std::chrono::microseconds(90), statistics.p90);
+    ASSERT_EQ(std::chrono::microseconds(99), statistics.p99);
+    ASSERT_EQ(std::chrono::microseconds(100), statistics.max);
+}
+
+TEST(BenchmarkLatencyStatistics, no_samples)
+{
+    std::vector<std::chrono::microseconds> samples;
+    ASSERT_EQ(0U, LatencyStatistics::calculate(&samples).count);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class Benchmark:
+    public ::testing::TestWithParam<Transport>
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_server = std::make_unique<BenchmarkServer>(GetParam());
+        ASSERT_TRUE(m_server->listen(SocketAddress::anyPrivateAddressV4));
+
+        m_settings.transport = GetParam();
+        m_settings.serverAddress = m_server->address();
+        m_settings.payloadSize = 1024;
+        m_settings.concurrency = 2;
+        m_settings.messagesInFlight = 2;
+        m_settings.duration = std::chrono::milliseconds(500);
+    }
+
+    virtual void TearDown() override
+    {
+        m_client.reset();
+        m_server.reset();
+    }
+
+    void whenRunBenchmark()
+    {
+        m_client = std::make_unique<BenchmarkClient>(m_settings);
+
+        nx::utils::promise<BenchmarkResult> done;
+        m_client->start([&done](BenchmarkResult result) { done.set_value(std::move(result)); });
+        m_result = done.get_future().get();
+    }
+
+    void thenAllConnectionsAreEstablished()
+    {
+        ASSERT_EQ(m_settings.concurrency, m_result.connectionsEstablished) << m_result.toString();
+        ASSERT_EQ(0, m_result.connectionsFailed);
+        ASSERT_EQ((std::size_t) m_settings.concurrency, m_result.connectTime.count);
+    }
+
+    void andTrafficIsMeasured()
+    {
+        ASSERT_GT(m_result.roundTripTime.count, 0U) << m_result.toString();
+        ASSERT_LE(m_result.roundTripTime.min, m_result.roundTripTime.p50);
+        ASSERT_LE(m_result.roundTripTime.p99, m_result.roundTripTime.max);
+
+        ASSERT_GE(m_result.bytesReceived, m_result.roundTripTime.count * m_settings.payloadSize);
+        ASSERT_GT(m_result.throughputBitsPerSecond(), 0);
+        ASSERT_GE(m_server->echoServer().totalConnectionsAccepted(),
+            (std::uint64_t) m_settings.concurrency);
+    }
+
+private:
+    BenchmarkSettings m_settings;
+    std::unique_ptr<BenchmarkServer> m_server;
+    std::unique_ptr<BenchmarkClient> m_client;
+    BenchmarkResult m_result;
+};
+
+TEST_P(Benchmark, measures_connection_setup_and_round_trip_time)
+{
+    whenRunBenchmark();
+
+    thenAllConnectionsAreEstablished();
+    andTrafficIsMeasured();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SpeedTest,
+    Benchmark,
+    ::testing::Values(Transport::tcp, Transport::ssl, Transport::udt, Transport::httpTunnel));
+
+} // namespace nx::network::cloud::speed_test::benchmark::test
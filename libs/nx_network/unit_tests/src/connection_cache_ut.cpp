@@ -1,5 +1,7 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <future>
+#include <thread>
 #include <tuple>
 
 #include <gtest/gtest.h>
@@ -50,6 +52,32 @@ protected:
         m_cache = network::ConnectionCache(period);
     }
 
+    void setMaxConnectionsPerEndpoint(std::size_t count)
+    {
+        m_cache = network::ConnectionCache(
+            network::ConnectionCache::kDefaultExpirationPeriod, count);
+    }
+
+    void waitForCacheSize(std::size_t size)
+    {
+        while (m_cache.size() != size)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::unique_ptr<AbstractStreamSocket> takeConnectionFromCache(const SocketAddress& endpoint)
+    {
+        std::promise<std::unique_ptr<AbstractStreamSocket>> connection;
+        m_cache.take(
+            {.addr = endpoint, .isTls = false},
+            [&connection](auto socket) { connection.set_value(std::move(socket)); });
+        return connection.get_future().get();
+    }
+
+    const network::ConnectionCache& cache() const
+    {
+        return m_cache;
+    }
+
 private:
     network::ConnectionCache m_cache;
     TCPServerSocket m_server;
@@ -78,4 +106,47 @@ TEST_F(ConnectionCache, connection_is_closed_by_timeout)
     assertConnectionIsRemovedFromCacheEventually(key);
 }
 
+TEST_F(ConnectionCache, number_of_connections_per_endpoint_is_limited)
+{
+    setMaxConnectionsPerEndpoint(2);
+
+    std::vector<std::unique_ptr<AbstractStreamSocket>> serverConnections;
+    SocketAddress key;
+    AbstractStreamSocket* lastConnection = nullptr;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto [clientConn, serverConn] = givenEstablishedConnection();
+        key = clientConn->getForeignAddress();
+        lastConnection = clientConn.get();
+        saveConnectionInCache(key, std::move(clientConn));
+        serverConnections.push_back(std::move(serverConn));
+
+        // Connections are handed over to the cache asynchronously.
+        if (i < 2)
+            waitForCacheSize(i + 1);
+    }
+
+    while (cache().statistics().evictedConnections == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(2U, cache().size());
+
+    auto connection = takeConnectionFromCache(key);
+    ASSERT_EQ(lastConnection, connection.get());
+    connection->pleaseStopSync();
+
+    const auto statistics = cache().statistics();
+    ASSERT_EQ(1U, statistics.lookups);
+    ASSERT_EQ(1U, statistics.hits);
+    ASSERT_EQ(1.0, statistics.reuseRate());
+}
+
+TEST_F(ConnectionCache, lookup_of_unknown_endpoint_is_a_miss)
+{
+    ASSERT_EQ(nullptr, takeConnectionFromCache(SocketAddress::anyPrivateAddress));
+
+    const auto statistics = cache().statistics();
+    ASSERT_EQ(1U, statistics.lookups);
+    ASSERT_EQ(0U, statistics.hits);
+}
+
 } // namespace nx::network::test
@@ -52,8 +52,9 @@ protected:
 
     void postDelayedResolveTasks(int count)
     {
+        // Different names since the resolves of the same name are coalesced.
         for (int i = 0; i < count; ++i)
-            startResolveAsync(delayedResolveHost);
+            startResolveAsync(nx::utils::buildString(delayedResolveHost, std::to_string(i)));
     }
 
     void waitForResolveNResults(int count)
@@ -124,7 +125,7 @@ private:
         int /*ipVersion*/,
         ResolveResult* resolved)
     {
-        if (hostName == delayedResolveHost)
+        if (hostName.starts_with(delayedResolveHost))
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(1));
             resolved->entries.push_back({AddressType::direct, HostAddress::localhost});
@@ -280,4 +281,278 @@ TEST_F(DnsResolver, old_and_unclear_test_to_be_refactored)
     }
 }
 
+//-------------------------------------------------------------------------------------------------
+
+class DnsResolverCache:
+    public ::testing::Test
+{
+public:
+    DnsResolverCache()
+    {
+        m_dnsResolver.registerResolver(
+            makeCustomResolver([this](auto&&... args) {
+                return testResolve(std::forward<decltype(args)>(args)...);
+            }),
+            m_dnsResolver.maxRegisteredResolverPriority() + 1);
+    }
+
+    ~DnsResolverCache()
+    {
+        unblockResolve();
+        m_dnsResolver.stop();
+    }
+
+protected:
+    static constexpr auto kTtl = std::chrono::minutes(1);
+    static constexpr char kHostname[] = "cached-host-name";
+
+    void givenResolveBlocked()
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_resolveBlocked = true;
+    }
+
+    void givenNotExistingHostname()
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_hostnameExists = false;
+    }
+
+    void givenCachedHostname()
+    {
+        whenResolve();
+        thenResolveSucceeded();
+    }
+
+    void unblockResolve()
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_resolveBlocked = false;
+        m_cond.wakeAll();
+    }
+
+    void whenHostnameIsMovedToOtherAddress()
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_address = HostAddress("12.34.56.78");
+    }
+
+    void whenHostnameStopsResolving()
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_hostnameExists = false;
+    }
+
+    void whenTtlPasses()
+    {
+        m_timeShift.applyRelativeShift(kTtl + std::chrono::seconds(1));
+    }
+
+    void whenStaleCacheTimeoutPasses()
+    {
+        m_timeShift.applyRelativeShift(
+            m_dnsResolver.staleCacheTimeout() + std::chrono::seconds(1));
+    }
+
+    void whenResolve()
+    {
+        m_dnsResolver.resolveAsync(
+            kHostname,
+            [this](SystemError::ErrorCode resultCode, std::deque<HostAddress> addresses)
+            {
+                m_results.push({resultCode, std::move(addresses)});
+            },
+            AF_INET,
+            nullptr);
+    }
+
+    void whenPrefetch()
+    {
+        m_dnsResolver.prefetch({kHostname});
+    }
+
+    void thenResolveSucceeded()
+    {
+        m_lastResult = m_results.pop();
+        ASSERT_EQ(SystemError::noError, std::get<0>(m_lastResult));
+    }
+
+    void thenResolveFailed(SystemError::ErrorCode expected)
+    {
+        m_lastResult = m_results.pop();
+        ASSERT_EQ(expected, std::get<0>(m_lastResult));
+    }
+
+    void andResolvedTo(const HostAddress& expected)
+    {
+        ASSERT_EQ(std::deque<HostAddress>{expected}, std::get<1>(m_lastResult));
+    }
+
+    void thenResolverIsInvoked(int count)
+    {
+        while (resolveCount() < count)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        ASSERT_EQ(count, resolveCount());
+    }
+
+    void thenResolverIsNotInvokedAgain(int count)
+    {
+        ASSERT_EQ(count, resolveCount());
+    }
+
+    HostAddress address() const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_address;
+    }
+
+    void waitUntilResolvedToCurrentAddress()
+    {
+        for (;;)
+        {
+            whenResolve();
+            thenResolveSucceeded();
+            if (std::get<1>(m_lastResult).front() == address())
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+private:
+    using Result = std::tuple<SystemError::ErrorCode, std::deque<HostAddress>>;
+
+    network::DnsResolver m_dnsResolver{1};
+    nx::utils::test::ScopedTimeShift m_timeShift{nx::utils::test::ClockType::steady};
+    mutable nx::Mutex m_mutex;
+    nx::WaitCondition m_cond;
+    bool m_resolveBlocked = false;
+    bool m_hostnameExists = true;
+    HostAddress m_address = HostAddress("1.2.3.4");
+    int m_resolveCount = 0;
+    nx::utils::SyncQueue<Result> m_results;
+    Result m_lastResult;
+
+    int resolveCount() const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_resolveCount;
+    }
+
+    SystemError::ErrorCode testResolve(
+        const std::string_view& /*hostName*/,
+        int /*ipVersion*/,
+        ResolveResult* resolved)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+
+        ++m_resolveCount;
+        while (m_resolveBlocked)
+            m_cond.wait(lock.mutex());
+
+        resolved->ttl = kTtl;
+        if (!m_hostnameExists)
+            return SystemError::hostNotFound;
+
+        resolved->entries.push_back({AddressType::direct, m_address});
+        return SystemError::noError;
+    }
+};
+
+TEST_F(DnsResolverCache, result_is_cached_for_ttl)
+{
+    givenCachedHostname();
+
+    whenResolve();
+
+    thenResolveSucceeded();
+    thenResolverIsNotInvokedAgain(1);
+}
+
+TEST_F(DnsResolverCache, concurrent_resolves_of_the_same_name_are_coalesced)
+{
+    givenResolveBlocked();
+
+    whenResolve();
+    whenResolve();
+    whenResolve();
+    thenResolverIsInvoked(1);
+
+    unblockResolve();
+
+    for (int i = 0; i < 3; ++i)
+        thenResolveSucceeded();
+    thenResolverIsNotInvokedAgain(1);
+}
+
+TEST_F(DnsResolverCache, stale_value_is_reported_while_the_name_is_refreshed)
+{
+    givenCachedHostname();
+    const auto oldAddress = address();
+
+    whenHostnameIsMovedToOtherAddress();
+    whenTtlPasses();
+    whenResolve();
+
+    thenResolveSucceeded();
+    andResolvedTo(oldAddress);
+    thenResolverIsInvoked(2);
+
+    // The refreshed value is seen after the refresh completion.
+    waitUntilResolvedToCurrentAddress();
+}
+
+TEST_F(DnsResolverCache, stale_value_is_kept_if_refresh_fails)
+{
+    givenCachedHostname();
+    const auto oldAddress = address();
+
+    whenHostnameStopsResolving();
+    whenTtlPasses();
+    whenResolve();
+    thenResolveSucceeded();
+    thenResolverIsInvoked(2);
+
+    whenResolve();
+    thenResolveSucceeded();
+    andResolvedTo(oldAddress);
+}
+
+TEST_F(DnsResolverCache, value_is_not_reported_after_stale_cache_timeout)
+{
+    givenCachedHostname();
+
+    whenHostnameIsMovedToOtherAddress();
+    whenTtlPasses();
+    whenStaleCacheTimeoutPasses();
+    whenResolve();
+
+    thenResolveSucceeded();
+    andResolvedTo(address());
+}
+
+TEST_F(DnsResolverCache, failure_is_cached)
+{
+    givenNotExistingHostname();
+
+    whenResolve();
+    thenResolveFailed(SystemError::hostNotFound);
+
+    whenResolve();
+    thenResolveFailed(SystemError::hostNotFound);
+    thenResolverIsNotInvokedAgain(1);
+}
+
+TEST_F(DnsResolverCache, prefetched_name_is_resolved_from_cache)
+{
+    whenPrefetch();
+    thenResolverIsInvoked(1);
+
+    // Either served from the cache or joins the prefetch in progress.
+    whenResolve();
+
+    thenResolveSucceeded();
+    thenResolverIsNotInvokedAgain(1);
+}
+
 } // namespace nx::network::test
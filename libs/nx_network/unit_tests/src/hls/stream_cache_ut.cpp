@@ -0,0 +1,171 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/hls/stream_cache.h>
+
+namespace nx::network::hls::test {
+
+class HlsStreamCache: public ::testing::Test
+{
+protected:
+    struct Load
+    {
+        std::string url;
+        StreamCache::SegmentHandler handler;
+    };
+
+    void createCache(StreamCache::Settings settings)
+    {
+        m_cache = std::make_unique<StreamCache>(
+            [this](const Chunk& chunk, StreamCache::SegmentHandler handler)
+            {
+                m_loads.push_back({chunk.url.path().toStdString(), std::move(handler)});
+            },
+            settings);
+    }
+
+    unsigned int addChunk(int index)
+    {
+        Chunk chunk;
+        chunk.duration = 2.0;
+        chunk.url = nx::utils::Url(QString("/hls/camera/%1.ts").arg(index));
+        return m_cache->addChunk(chunk);
+    }
+
+    std::vector<std::string> loadedUrls() const
+    {
+        std::vector<std::string> urls;
+        for (const auto& load: m_loads)
+            urls.push_back(load.url);
+        return urls;
+    }
+
+    void completeLoad(int index, StreamCache::Segment segment)
+    {
+        auto handler = std::move(m_loads[index].handler);
+        handler(std::move(segment));
+    }
+
+    StreamCache::SegmentHandler saveTo(StreamCache::Segment* result)
+    {
+        return [result](StreamCache::Segment segment) { *result = std::move(segment); };
+    }
+
+protected:
+    std::unique_ptr<StreamCache> m_cache;
+    std::vector<Load> m_loads;
+};
+
+TEST_F(HlsStreamCache, playlist_is_generated_once_per_change)
+{
+    createCache({});
+    Playlist expected;
+    for (int i = 0; i < 3; ++i)
+    {
+        addChunk(i);
+        expected.chunks.push_back(
+            {.duration = 2.0, .url = nx::utils::Url(QString("/hls/camera/%1.ts").arg(i))});
+    }
+
+    const auto playlist = m_cache->playlist();
+    ASSERT_EQ(expected.toString(), *playlist);
+    ASSERT_EQ(playlist, m_cache->playlist());
+    ASSERT_EQ(1, m_cache->statistics().playlistsGenerated);
+
+    m_cache->close();
+    expected.closed = true;
+    ASSERT_EQ(expected.toString(), *m_cache->playlist());
+    ASSERT_EQ(2, m_cache->statistics().playlistsGenerated);
+}
+
+TEST_F(HlsStreamCache, live_playlist_keeps_latest_chunks)
+{
+    createCache({.maxChunkCount = 2});
+    for (int i = 0; i < 5; ++i)
+        ASSERT_EQ(i, addChunk(i));
+
+    const auto playlist = *m_cache->playlist();
+    ASSERT_NE(std::string::npos, playlist.find("#EXT-X-MEDIA-SEQUENCE:3\r\n"));
+    ASSERT_EQ(std::string::npos, playlist.find("/hls/camera/2.ts"));
+    ASSERT_NE(std::string::npos, playlist.find("/hls/camera/4.ts"));
+
+    StreamCache::Segment segment = std::make_shared<const nx::Buffer>("stale");
+    m_cache->getSegment(2, saveTo(&segment));
+    ASSERT_FALSE(segment);
+}
+
+TEST_F(HlsStreamCache, viewers_share_segment_load)
+{
+    createCache({.prefetchNextSegment = false});
+    addChunk(0);
+
+    StreamCache::Segment first;
+    StreamCache::Segment second;
+    m_cache->getSegment(0, saveTo(&first));
+    m_cache->getSegment(0, saveTo(&second));
+    ASSERT_EQ(1, m_loads.size());
+
+    completeLoad(0, std::make_shared<const nx::Buffer>("segment"));
+    ASSERT_TRUE(first);
+    ASSERT_EQ(first, second);
+
+    StreamCache::Segment third;
+    m_cache->getSegment(0, saveTo(&third));
+    ASSERT_EQ(first, third);
+    ASSERT_EQ(1, m_loads.size());
+    ASSERT_EQ(1, m_cache->statistics().segmentHits);
+    ASSERT_EQ(1, m_cache->statistics().segmentLoads);
+}
+
+TEST_F(HlsStreamCache, next_segment_is_prefetched)
+{
+    createCache({});
+    addChunk(0);
+    addChunk(1);
+
+    StreamCache::Segment segment;
+    m_cache->getSegment(0, saveTo(&segment));
+    ASSERT_EQ((std::vector<std::string>{"/hls/camera/0.ts", "/hls/camera/1.ts"}), loadedUrls());
+
+    // The viewer at the live edge gets the next chunk prefetched as soon as it is closed.
+    m_cache->getSegment(1, saveTo(&segment));
+    addChunk(2);
+    ASSERT_EQ(3, m_loads.size());
+    ASSERT_EQ("/hls/camera/2.ts", m_loads[2].url);
+    ASSERT_EQ(2, m_cache->statistics().segmentPrefetches);
+}
+
+TEST_F(HlsStreamCache, failed_load_is_retried)
+{
+    createCache({.prefetchNextSegment = false});
+    addChunk(0);
+
+    StreamCache::Segment segment = std::make_shared<const nx::Buffer>("stale");
+    m_cache->getSegment(0, saveTo(&segment));
+    completeLoad(0, nullptr);
+    ASSERT_FALSE(segment);
+
+    m_cache->getSegment(0, saveTo(&segment));
+    ASSERT_EQ(2, m_loads.size());
+    completeLoad(1, std::make_shared<const nx::Buffer>("segment"));
+    ASSERT_TRUE(segment);
+}
+
+TEST_F(HlsStreamCache, pending_viewers_are_notified_on_destruction)
+{
+    createCache({});
+    addChunk(0);
+
+    StreamCache::Segment segment = std::make_shared<const nx::Buffer>("stale");
+    m_cache->getSegment(0, saveTo(&segment));
+    m_cache.reset();
+    ASSERT_FALSE(segment);
+
+    completeLoad(0, std::make_shared<const nx::Buffer>("segment"));
+    ASSERT_FALSE(segment);
+}
+
+} // namespace nx::network::hls::test
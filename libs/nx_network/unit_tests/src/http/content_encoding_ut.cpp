@@ -0,0 +1,54 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/http/content_encoding.h>
+#include <nx/utils/byte_stream/custom_output_stream.h>
+
+namespace nx::network::http::test {
+
+TEST(HttpContentEncoding, selection)
+{
+    const auto select =
+        [](const char* acceptEncoding)
+        {
+            return selectContentEncoding(header::AcceptEncodingHeader(acceptEncoding));
+        };
+
+    ASSERT_EQ("zstd", select("gzip, deflate, br, zstd"));
+    ASSERT_EQ("identity", select("zstd;q=0, gzip"));
+    ASSERT_EQ("identity", select("gzip, deflate"));
+    ASSERT_EQ("identity", select("*"));
+    ASSERT_EQ("gzip", select("gzip, identity;q=0"));
+    ASSERT_EQ("", select("br, identity;q=0"));
+}
+
+TEST(HttpContentEncoding, encoded_body_is_decoded)
+{
+    nx::Buffer body;
+    for (int i = 0; i < 1000; ++i)
+        body += "{\"id\":" + std::to_string(i) + ",\"name\":\"resource\"},";
+
+    for (const auto encoding: {kZstdContentEncoding, kGzipContentEncoding})
+    {
+        const auto encoded = encodeMessageBody(encoding, body);
+        ASSERT_TRUE(encoded);
+        ASSERT_LT(encoded->size(), body.size());
+
+        nx::Buffer decoded;
+        auto decoder = createContentDecoder(encoding);
+        ASSERT_NE(nullptr, decoder);
+        decoder->setNextFilter(nx::utils::bstream::makeCustomOutputStream(
+            [&decoded](const auto& data) { decoded += data; }));
+        ASSERT_TRUE(decoder->processData(*encoded));
+        decoder->flush();
+
+        ASSERT_EQ(body, decoded) << encoding;
+    }
+
+    ASSERT_EQ(body, encodeMessageBody(header::IDENTITY_CODING, body));
+    ASSERT_FALSE(encodeMessageBody("br", body));
+    ASSERT_EQ(nullptr, createContentDecoder("br"));
+}
+
+} // namespace nx::network::http::test
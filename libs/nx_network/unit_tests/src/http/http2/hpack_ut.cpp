@@ -0,0 +1,153 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/http/http2/hpack.h>
+#include <nx/utils/std_string_utils.h>
+
+namespace nx::network::http::http2::test {
+
+/**
+ * The examples are from RFC 7541, Appendix C.
+ */
+class Hpack:
+    public ::testing::Test
+{
+protected:
+    static const HeaderList kRequests[3];
+    static const char* const kHuffmanEncodedRequests[3];
+
+    static const HeaderList kResponses[3];
+    static const char* const kHuffmanEncodedResponses[3];
+
+    void assertDecoded(
+        HpackDecoder* decoder,
+        const char* hexBlock,
+        const HeaderList& expected,
+        std::size_t expectedTableSize)
+    {
+        HeaderList headers;
+        ASSERT_TRUE(decoder->decode(nx::utils::fromHex(hexBlock), &headers));
+        ASSERT_EQ(expected, headers);
+        ASSERT_EQ(expectedTableSize, decoder->dynamicTable().size());
+    }
+};
+
+const HeaderList Hpack::kRequests[3] = {
+    {{":method", "GET"}, {":scheme", "http"}, {":path", "/"},
+        {":authority", "www.example.com"}},
+    {{":method", "GET"}, {":scheme", "http"}, {":path", "/"},
+        {":authority", "www.example.com"}, {"cache-control", "no-cache"}},
+    {{":method", "GET"}, {":scheme", "https"}, {":path", "/index.html"},
+        {":authority", "www.example.com"}, {"custom-key", "custom-value"}},
+};
+
+const char* const Hpack::kHuffmanEncodedRequests[3] = {
+    "828684418cf1e3c2e5f23a6ba0ab90f4ff",
+    "828684be5886a8eb10649cbf",
+    "828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf",
+};
+
+const HeaderList Hpack::kResponses[3] = {
+    {{":status", "302"}, {"cache-control", "private"},
+        {"date", "Mon, 21 Oct 2013 20:13:21 GMT"}, {"location", "https://www.example.com"}},
+    {{":status", "307"}, {"cache-control", "private"},
+        {"date", "Mon, 21 Oct 2013 20:13:21 GMT"}, {"location", "https://www.example.com"}},
+    {{":status", "200"}, {"cache-control", "private"},
+        {"date", "Mon, 21 Oct 2013 20:13:22 GMT"}, {"location", "https://www.example.com"},
+        {"content-encoding", "gzip"},
+        {"set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1"}},
+};
+
+const char* const Hpack::kHuffmanEncodedResponses[3] = {
+    "488264025885aec3771a4b6196d07abe941054d444a8200595040b8166e082a62d1bff6e919d29ad171863"
+        "c78f0b97c8e9ae82ae43d3",
+    "4883640effc1c0bf",
+    "88c16196d07abe941054d444a8200595040b8166e084a62d1bffc05a839bd9ab77ad94e7821dd7f2e6c7b3"
+        "35dfdfcd5b3960d5af27087f3672c1ab270fb5291f9587316065c003ed4ee5b1063d5007",
+};
+
+TEST_F(Hpack, decodes_requests_with_huffman_coding)
+{
+    HpackDecoder decoder;
+    assertDecoded(&decoder, kHuffmanEncodedRequests[0], kRequests[0], 57);
+    assertDecoded(&decoder, kHuffmanEncodedRequests[1], kRequests[1], 110);
+    assertDecoded(&decoder, kHuffmanEncodedRequests[2], kRequests[2], 164);
+}
+
+TEST_F(Hpack, encoder_output_matches_rfc_examples)
+{
+    HpackEncoder encoder;
+    for (std::size_t i = 0; i < std::size(kRequests); ++i)
+    {
+        nx::Buffer block;
+        encoder.encode(kRequests[i], &block);
+        ASSERT_EQ(nx::utils::fromHex(kHuffmanEncodedRequests[i]), block.toStdString());
+    }
+}
+
+TEST_F(Hpack, decodes_responses_with_eviction)
+{
+    HpackDecoder decoder(256);
+    assertDecoded(&decoder, kHuffmanEncodedResponses[0], kResponses[0], 222);
+    assertDecoded(&decoder, kHuffmanEncodedResponses[1], kResponses[1], 222);
+    assertDecoded(&decoder, kHuffmanEncodedResponses[2], kResponses[2], 215);
+}
+
+TEST_F(Hpack, encoded_headers_are_decoded_after_table_size_update)
+{
+    const HeaderList headers = {
+        {":status", "200"}, {"authorization", "secret"}, {"x-long", std::string(300, 'a')}};
+
+    HpackEncoder encoder(256);
+    HpackDecoder decoder(256);
+
+    nx::Buffer block;
+    encoder.encode(headers, &block);
+    HeaderList decoded;
+    ASSERT_TRUE(decoder.decode(block, &decoded));
+    ASSERT_EQ(headers, decoded);
+
+    encoder.setMaxTableSize(100);
+    block.clear();
+    encoder.encode(headers, &block);
+    decoded.clear();
+    ASSERT_TRUE(decoder.decode(block, &decoded));
+    ASSERT_EQ(headers, decoded);
+    ASSERT_LE(decoder.dynamicTable().maxSize(), 100U);
+}
+
+TEST_F(Hpack, header_list_size_limit_is_enforced)
+{
+    HpackEncoder encoder;
+    nx::Buffer block;
+    encoder.encode({{"x-long", std::string(1000, 'a')}}, &block);
+
+    HpackDecoder decoder;
+    decoder.setMaxHeaderListSize(512);
+    HeaderList decoded;
+    ASSERT_FALSE(decoder.decode(block, &decoded));
+}
+
+TEST(HpackHuffman, every_octet_survives_roundtrip)
+{
+    std::string data;
+    for (int i = 0; i < 256; ++i)
+        data += (char) i;
+
+    nx::Buffer encoded;
+    huffman::encode(data, &encoded);
+    ASSERT_EQ(huffman::encodedSize(data), encoded.size());
+
+    std::string decoded;
+    ASSERT_TRUE(huffman::decode(encoded, &decoded));
+    ASSERT_EQ(data, decoded);
+}
+
+TEST(HpackHuffman, padding_longer_than_7_bits_is_rejected)
+{
+    std::string decoded;
+    ASSERT_FALSE(huffman::decode(nx::utils::fromHex("ff"), &decoded));
+}
+
+} // namespace nx::network::http::http2::test
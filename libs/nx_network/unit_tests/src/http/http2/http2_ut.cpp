@@ -0,0 +1,205 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/http/buffer_source.h>
+#include <nx/network/http/http_async_client.h>
+#include <nx/network/http/http2/client_connection_pool.h>
+#include <nx/network/http/test_http_server.h>
+#include <nx/network/socket_global.h>
+#include <nx/network/ssl/certificate.h>
+#include <nx/network/system_socket.h>
+#include <nx/network/url/url_builder.h>
+#include <nx/utils/thread/sync_queue.h>
+
+namespace nx::network::http::http2::test {
+
+static constexpr char kResourcePath[] = "/Http2/resource";
+static constexpr char kEchoPath[] = "/Http2/echo";
+static constexpr char kResourceBody[] = "Hello, world";
+
+class Http2:
+    public ::testing::Test
+{
+public:
+    ~Http2()
+    {
+        for (auto& client: m_clients)
+            client->pleaseStopSync();
+
+        if (m_server)
+            m_server->pleaseStopSync();
+    }
+
+protected:
+    struct Result
+    {
+        bool succeeded = false;
+        nx::Buffer body;
+    };
+
+    virtual void SetUp() override
+    {
+        ASSERT_TRUE(m_serverContext.setDefaultCertificate(
+            ssl::makeCertificateAndKey({"test", "US", "NX"})));
+
+        m_aioThread = SocketGlobals::instance().aioService().getRandomAioThread();
+    }
+
+    void givenServer(bool isHttp2Enabled = true)
+    {
+        if (isHttp2Enabled)
+            m_serverContext.setAlpnProtocols({"h2", "http/1.1"});
+
+        m_server = std::make_unique<TestHttpServer>(
+            server::Role::resourceServer,
+            SocketFactory::createSslAdapter(
+                std::make_unique<TCPServerSocket>(AF_INET),
+                &m_serverContext,
+                ssl::EncryptionUse::always));
+        m_server->server().setHttp2Enabled(isHttp2Enabled);
+
+        m_server->registerRequestProcessorFunc(
+            kResourcePath,
+            [this](RequestContext requestContext, RequestProcessedHandler completionHandler)
+            {
+                m_clientEndpoints.push(requestContext.clientEndpoint);
+                completionHandler(RequestResult(
+                    StatusCode::ok,
+                    std::make_unique<BufferSource>("text/plain", kResourceBody)));
+            });
+
+        m_server->registerRequestProcessorFunc(
+            kEchoPath,
+            [this](RequestContext requestContext, RequestProcessedHandler completionHandler)
+            {
+                m_clientEndpoints.push(requestContext.clientEndpoint);
+                completionHandler(RequestResult(
+                    StatusCode::ok,
+                    std::make_unique<BufferSource>(
+                        "application/octet-stream",
+                        std::move(requestContext.request.messageBody))));
+            });
+
+        ASSERT_TRUE(m_server->bindAndListen(SocketAddress::anyPrivateAddressV4));
+    }
+
+    void whenIssueConcurrentGetRequests(int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            auto client = prepareClient();
+            client->doGet(
+                url(kResourcePath),
+                [this, client = client.get()]() { saveResult(client); });
+            m_clients.push_back(std::move(client));
+        }
+    }
+
+    void whenPostLargeBody()
+    {
+        m_requestBody = nx::Buffer(1024 * 1024, 'x');
+
+        auto client = prepareClient();
+        client->doPost(
+            url(kEchoPath),
+            std::make_unique<BufferSource>("application/octet-stream", m_requestBody),
+            [this, client = client.get()]() { saveResult(client); });
+        m_clients.push_back(std::move(client));
+    }
+
+    void thenEveryRequestSucceeded(int count, const nx::Buffer& expectedBody)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            const auto result = m_results.pop();
+            ASSERT_TRUE(result.succeeded);
+            ASSERT_EQ(expectedBody, result.body);
+        }
+    }
+
+    void thenEveryRequestSucceeded(int count)
+    {
+        thenEveryRequestSucceeded(count, nx::Buffer(kResourceBody));
+    }
+
+    void thenRequestBodyIsEchoed()
+    {
+        thenEveryRequestSucceeded(1, m_requestBody);
+    }
+
+    void andRequestsWereServedOverSingleConnection(int count)
+    {
+        const auto firstEndpoint = m_clientEndpoints.pop();
+        for (int i = 1; i < count; ++i)
+            ASSERT_EQ(firstEndpoint, m_clientEndpoints.pop());
+    }
+
+    void andServerIsRememberedAsHttp1Only()
+    {
+        ASSERT_FALSE(m_pool.isHttp2Expected(m_server->serverAddress()));
+    }
+
+private:
+    ssl::Context m_serverContext;
+    ClientConnectionPool m_pool{ssl::kAcceptAnyCertificate};
+    std::unique_ptr<TestHttpServer> m_server;
+    aio::AbstractAioThread* m_aioThread = nullptr;
+    std::vector<std::unique_ptr<AsyncClient>> m_clients;
+    nx::utils::SyncQueue<Result> m_results;
+    nx::utils::SyncQueue<SocketAddress> m_clientEndpoints;
+    nx::Buffer m_requestBody;
+
+    std::unique_ptr<AsyncClient> prepareClient()
+    {
+        auto client = std::make_unique<AsyncClient>(ssl::kAcceptAnyCertificate);
+        // The connections are shared per aio thread.
+        client->bindToAioThread(m_aioThread);
+        client->setHttp2ConnectionPool(&m_pool);
+        client->setResponseReadTimeout(kNoTimeout);
+        return client;
+    }
+
+    nx::utils::Url url(const char* path) const
+    {
+        return url::Builder().setScheme(kSecureUrlSchemeName)
+            .setEndpoint(m_server->serverAddress()).setPath(path);
+    }
+
+    void saveResult(AsyncClient* client)
+    {
+        m_results.push({client->hasRequestSucceeded(), client->fetchMessageBodyBuffer()});
+    }
+};
+
+TEST_F(Http2, concurrent_requests_are_multiplexed_over_single_connection)
+{
+    static constexpr int kRequestCount = 7;
+
+    givenServer();
+    whenIssueConcurrentGetRequests(kRequestCount);
+
+    thenEveryRequestSucceeded(kRequestCount);
+    andRequestsWereServedOverSingleConnection(kRequestCount);
+}
+
+TEST_F(Http2, request_body_is_delivered_with_flow_control)
+{
+    givenServer();
+    whenPostLargeBody();
+    thenRequestBodyIsEchoed();
+}
+
+TEST_F(Http2, client_falls_back_to_http_1_1)
+{
+    givenServer(/*isHttp2Enabled*/ false);
+    whenIssueConcurrentGetRequests(2);
+
+    thenEveryRequestSucceeded(2);
+    andServerIsRememberedAsHttp1Only();
+}
+
+} // namespace nx::network::http::http2::test
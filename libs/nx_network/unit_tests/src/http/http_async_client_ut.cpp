@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <thread>
 
 #include <nx/network/http/auth_tools.h>
 #include <nx/network/http/buffer_source.h>
@@ -145,6 +146,8 @@ protected:
     std::unique_ptr<AsyncClient> m_client;
     nx::utils::SyncQueue<RequestContext> m_receivedRequests;
     std::optional<RequestContext> m_lastRequestCtx;
+    ConnectionCache m_connectionCache;
+    bool m_isConnectionCacheEnabled = false;
 
     virtual void SetUp() override
     {
@@ -254,6 +257,18 @@ protected:
         thenSuccessResponseIsReceived();
     }
 
+    void givenConnectionInCache()
+    {
+        m_isConnectionCacheEnabled = true;
+        createClient();
+        givenClientWithPersistentConnectionToHttp11Server();
+
+        // The stopped client passes its connection to the cache.
+        createClient();
+        while (m_connectionCache.size() == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
     void givenHttpClientInitializedWithPreexistingConnectionToServer()
     {
         givenClientWithPersistentConnectionToHttp11Server();
@@ -565,6 +580,19 @@ protected:
         }
     }
 
+    void thenConnectionIsRemovedFromCache()
+    {
+        while (m_connectionCache.size() > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    void andCachedConnectionReuseIsReported()
+    {
+        const auto statistics = m_connectionCache.statistics();
+        ASSERT_EQ(1U, statistics.hits);
+        ASSERT_GT(statistics.savedConnectTime, std::chrono::microseconds::zero());
+    }
+
     void andNoMoreEventsAreReported()
     {
         ASSERT_FALSE(m_responses.pop(std::chrono::milliseconds(10)));
@@ -617,6 +645,8 @@ private:
         m_client->setResponseReadTimeout(kNoTimeout);
         m_client->setMessageBodyReadTimeout(kNoTimeout);
         m_client->setCredentials(m_credentials);
+        if (m_isConnectionCacheEnabled)
+            m_client->setConnectionCache(&m_connectionCache);
     }
 
     void processHttpRequest(
@@ -837,6 +867,28 @@ TEST_F(HttpAsyncClient, silently_reconnects_if_inactive_persistent_connection_is
     thenSuccessResponseIsReceived();
 }
 
+TEST_F(HttpAsyncClient, connection_from_cache_is_reused_by_another_client)
+{
+    givenConnectionInCache();
+
+    whenSendGetRequest();
+
+    thenSuccessResponseIsReceived();
+    andTheSameTcpConnectionHasBeenUsed();
+    andCachedConnectionReuseIsReported();
+}
+
+TEST_F(HttpAsyncClient, cached_connection_closed_by_server_is_not_used)
+{
+    givenConnectionInCache();
+
+    whenServerClosesConnection();
+    thenConnectionIsRemovedFromCache();
+
+    whenSendGetRequest();
+    thenSuccessResponseIsReceived();
+}
+
 TEST_F(HttpAsyncClient, message_body_receival_can_be_stopped_and_resumed)
 {
     whenRequestResourceWithInfiniteBody();
@@ -0,0 +1,204 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/http/http_message_view.h>
+#include <nx/network/http/http_stream_reader.h>
+
+namespace nx::network::http::test {
+
+static constexpr char kRequest[] =
+    "GET /ec2/getResourceTypes?format=json HTTP/1.1\r\n"
+    "Host: 192.168.0.1:7001\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36\r\n"
+    "Accept: application/json\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "Connection: keep-alive\r\n"
+    "Cookie: x-runtime-guid=6f1dbd5a-38b3-4b8b-9f27-f6b0e7b4dd9e\r\n"
+    "X-Request-Id:   3a9b1c  \r\n"
+    "\r\n";
+
+static constexpr char kResponse[] =
+    "HTTP/1.1 404 Not Found\n"
+    "Content-Type: text/plain\n"
+    "Content-Length: 5\n"
+    "\n"
+    "Hello";
+
+class HttpMessageView:
+    public ::testing::Test
+{
+protected:
+    MessageView m_view;
+
+    void assertParsed(const std::string_view& data, std::size_t expectedBytesProcessed)
+    {
+        std::size_t bytesProcessed = 0;
+        ASSERT_EQ(MessageView::ParseResult::done, m_view.parse(data, &bytesProcessed));
+        ASSERT_EQ(expectedBytesProcessed, bytesProcessed);
+    }
+};
+
+TEST_F(HttpMessageView, request_is_parsed)
+{
+    assertParsed(kRequest, sizeof(kRequest) - 1);
+
+    ASSERT_EQ(MessageType::request, m_view.type());
+    ASSERT_EQ("GET", m_view.method());
+    ASSERT_EQ("/ec2/getResourceTypes?format=json", m_view.requestTarget());
+    ASSERT_EQ("HTTP/1.1", m_view.version());
+    ASSERT_EQ(8U, m_view.headers().size());
+    ASSERT_EQ("keep-alive", m_view.header("connection"));
+    ASSERT_EQ("3a9b1c", m_view.header("X-Request-Id"));
+    ASSERT_FALSE(m_view.header("Content-Length"));
+}
+
+TEST_F(HttpMessageView, response_is_parsed_with_lf_line_endings)
+{
+    const std::string_view response(kResponse);
+    assertParsed(response, response.find("Hello"));
+
+    ASSERT_EQ(MessageType::response, m_view.type());
+    ASSERT_EQ(StatusCode::notFound, m_view.statusCode());
+    ASSERT_EQ("Not Found", m_view.reasonPhrase());
+    ASSERT_EQ(5U, m_view.contentLength());
+}
+
+TEST_F(HttpMessageView, incomplete_header_requires_more_data)
+{
+    const std::string_view request(kRequest);
+    for (std::size_t size = 0; size < request.size(); ++size)
+    {
+        std::size_t bytesProcessed = 1;
+        ASSERT_EQ(
+            MessageView::ParseResult::needMoreData,
+            m_view.parse(request.substr(0, size), &bytesProcessed));
+        ASSERT_EQ(0U, bytesProcessed);
+    }
+
+    assertParsed(request, request.size());
+}
+
+TEST_F(HttpMessageView, invalid_header_is_rejected)
+{
+    std::size_t bytesProcessed = 0;
+    ASSERT_EQ(
+        MessageView::ParseResult::failed,
+        m_view.parse("GET / HTTP/1.1\r\nHost\r\n\r\n", &bytesProcessed));
+    ASSERT_EQ(
+        MessageView::ParseResult::failed,
+        m_view.parse("HTTP/1.1 OK\r\n\r\n", &bytesProcessed));
+}
+
+TEST_F(HttpMessageView, changed_headers_are_serialized)
+{
+    assertParsed(kRequest, sizeof(kRequest) - 1);
+
+    m_view.setHeader("Host", "example.com");
+    m_view.setHeader("X-Forwarded-For", "10.0.0.1");
+    ASSERT_EQ(1U, m_view.removeHeader("cookie"));
+
+    nx::Buffer serialized;
+    m_view.serialize(&serialized);
+
+    Request request;
+    ASSERT_TRUE(request.parse(serialized));
+    ASSERT_EQ("example.com", getHeaderValue(request.headers, "Host"));
+    ASSERT_EQ("10.0.0.1", getHeaderValue(request.headers, "X-Forwarded-For"));
+    ASSERT_EQ(0U, request.headers.count("Cookie"));
+    ASSERT_EQ(8U, request.headers.size());
+}
+
+TEST_F(HttpMessageView, detached_view_does_not_refer_to_source_buffer)
+{
+    std::string source = kRequest;
+    assertParsed(source, source.size());
+    m_view.setHeader("Accept", "text/html");
+
+    m_view.detach();
+    std::fill(source.begin(), source.end(), 'x');
+
+    ASSERT_EQ("GET", m_view.method());
+    ASSERT_EQ("192.168.0.1:7001", m_view.header("Host"));
+    ASSERT_EQ("text/html", m_view.header("Accept"));
+}
+
+TEST_F(HttpMessageView, materialized_message_is_the_same_as_from_stream_reader)
+{
+    for (const std::string_view data: {std::string_view(kRequest), std::string_view(kResponse)})
+    {
+        std::size_t bytesProcessed = 0;
+        ASSERT_EQ(MessageView::ParseResult::done, m_view.parse(data, &bytesProcessed));
+
+        HttpStreamReader reader;
+        reader.setBreakAfterReadingHeaders(true);
+        ASSERT_TRUE(reader.parseBytes(data.substr(0, bytesProcessed)));
+
+        nx::Buffer expected;
+        reader.message().serialize(&expected);
+        nx::Buffer actual;
+        m_view.toMessage().serialize(&actual);
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class HttpMessageViewPerformance:
+    public ::testing::Test
+{
+protected:
+    static constexpr int kIterationCount = 1000 * 1000;
+
+    template<typename Func>
+    void measure(const char* parserName, Func parseRequest)
+    {
+        using namespace std::chrono;
+
+        const auto t0 = steady_clock::now();
+        for (int i = 0; i < kIterationCount; ++i)
+            ASSERT_TRUE(parseRequest());
+        const auto t1 = steady_clock::now();
+
+        std::cout << parserName << ": parsing " << kIterationCount << " requests took "
+            << duration_cast<milliseconds>(t1 - t0).count() << "ms" << std::endl;
+    }
+};
+
+TEST_F(HttpMessageViewPerformance, DISABLED_comparison_with_stream_reader)
+{
+    const std::string_view request(kRequest);
+
+    HttpStreamReader reader;
+    reader.setBreakAfterReadingHeaders(true);
+    measure("HttpStreamReader",
+        [&]()
+        {
+            reader.resetState();
+            return reader.parseBytes(request)
+                && reader.message().headers().size() == 8;
+        });
+
+    MessageView view;
+    measure("MessageView",
+        [&]()
+        {
+            std::size_t bytesProcessed = 0;
+            return view.parse(request, &bytesProcessed) == MessageView::ParseResult::done
+                && view.headers().size() == 8;
+        });
+
+    measure("MessageView with materialization",
+        [&]()
+        {
+            std::size_t bytesProcessed = 0;
+            return view.parse(request, &bytesProcessed) == MessageView::ParseResult::done
+                && view.toMessage().headers().size() == 8;
+        });
+}
+
+} // namespace nx::network::http::test
@@ -0,0 +1,155 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/http/multipart_fan_out.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::network::http::test {
+
+namespace {
+
+class Client
+{
+public:
+    Client(std::unique_ptr<MultipartFanOutBodySource> body):
+        m_body(std::move(body))
+    {
+    }
+
+    ~Client()
+    {
+        m_body->pleaseStopSync();
+    }
+
+    void startReading()
+    {
+        m_body->readAsync(
+            [this](auto&&... args) { onSomeBodyBytesRead(std::move(args)...); });
+    }
+
+    void waitForBody(const nx::Buffer& expected)
+    {
+        while (!m_eofReported)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        ASSERT_EQ(expected, m_receivedBody);
+    }
+
+    void waitForSkippedParts(int count)
+    {
+        while (m_body->skippedPartCount() < count)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+private:
+    std::unique_ptr<MultipartFanOutBodySource> m_body;
+    nx::Mutex m_mutex;
+    nx::Buffer m_receivedBody;
+    std::atomic<bool> m_eofReported = false;
+
+    void onSomeBodyBytesRead(SystemError::ErrorCode errorCode, nx::Buffer buffer)
+    {
+        ASSERT_EQ(SystemError::noError, errorCode);
+
+        if (buffer.empty())
+        {
+            m_eofReported = true;
+            return;
+        }
+
+        {
+            NX_MUTEX_LOCKER lock(&m_mutex);
+            m_receivedBody += buffer;
+        }
+
+        startReading();
+    }
+};
+
+static constexpr char kEpilogue[] = "\r\n--boundary--";
+
+nx::Buffer serializedPart(const std::string& data)
+{
+    return "\r\n--boundary\r\n"
+        "Content-Type: image/jpeg\r\n"
+        "Content-Length: " + std::to_string(data.size()) + "\r\n"
+        "\r\n" + data;
+}
+
+} // namespace
+
+class HttpMultipartFanOut:
+    public ::testing::Test
+{
+protected:
+    MultipartFanOut m_fanOut{"boundary"};
+
+    void writePart(const std::string& data)
+    {
+        m_fanOut.writeBodyPart("image/jpeg", HttpHeaders(), nx::Buffer(data));
+    }
+};
+
+TEST_F(HttpMultipartFanOut, every_subscriber_receives_the_parts)
+{
+    Client client1(m_fanOut.subscribe());
+    Client client2(m_fanOut.subscribe());
+    ASSERT_EQ(2U, m_fanOut.subscriberCount());
+    ASSERT_EQ("multipart/x-mixed-replace;boundary=boundary", m_fanOut.contentType());
+
+    client1.startReading();
+    client2.startReading();
+
+    writePart("frame1");
+    writePart("frame2");
+    m_fanOut.writeEpilogue();
+
+    const nx::Buffer expected = serializedPart("frame1") + serializedPart("frame2") + kEpilogue;
+    client1.waitForBody(expected);
+    client2.waitForBody(expected);
+}
+
+TEST_F(HttpMultipartFanOut, slow_subscriber_skips_parts)
+{
+    Client client(m_fanOut.subscribe());
+
+    writePart("frame1");
+    writePart("frame2");
+    writePart("frame3");
+    client.waitForSkippedParts(2);
+
+    m_fanOut.writeEpilogue();
+    client.startReading();
+
+    client.waitForBody(serializedPart("frame3") + kEpilogue);
+}
+
+TEST_F(HttpMultipartFanOut, new_subscriber_starts_with_the_last_part)
+{
+    writePart("frame1");
+    writePart("frame2");
+
+    Client client(m_fanOut.subscribe());
+    client.startReading();
+    m_fanOut.writeEpilogue();
+
+    client.waitForBody(serializedPart("frame2") + kEpilogue);
+}
+
+TEST_F(HttpMultipartFanOut, stopped_subscriber_is_removed)
+{
+    {
+        Client client(m_fanOut.subscribe());
+        ASSERT_EQ(1U, m_fanOut.subscriberCount());
+    }
+
+    ASSERT_EQ(0U, m_fanOut.subscriberCount());
+    writePart("frame1");
+}
+
+} // namespace nx::network::http::test
@@ -0,0 +1,99 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/http/pull_message_body_source.h>
+#include <nx/utils/thread/sync_queue.h>
+
+namespace nx::network::http::test {
+
+class HttpPullMessageBodySource:
+    public ::testing::Test
+{
+public:
+    ~HttpPullMessageBodySource()
+    {
+        if (m_messageBody)
+            m_messageBody->pleaseStopSync();
+        if (m_producerThread.joinable())
+            m_producerThread.join();
+    }
+
+protected:
+    virtual void SetUp() override
+    {
+        m_messageBody = std::make_unique<PullMessageBodySource>(
+            "text/plain",
+            [this](auto handler) { m_readRequests.push(std::move(handler)); });
+    }
+
+    void whenStartReading()
+    {
+        m_messageBody->readAsync(
+            [this](SystemError::ErrorCode resultCode, nx::Buffer buffer)
+            {
+                m_readQueue.push(std::make_tuple(resultCode, std::move(buffer)));
+            });
+    }
+
+    void whenProduce(nx::Buffer data)
+    {
+        auto handler = m_readRequests.pop();
+        if (m_producerThread.joinable())
+            m_producerThread.join();
+
+        // Producing in another thread as a DB cursor would.
+        m_producerThread = std::thread(
+            [handler = std::move(handler), data = std::move(data)]() mutable
+            {
+                handler(SystemError::noError, std::move(data));
+            });
+    }
+
+    void thenDataIsRead(const nx::Buffer& expected)
+    {
+        const auto result = m_readQueue.pop();
+        ASSERT_EQ(SystemError::noError, std::get<0>(result));
+        ASSERT_EQ(expected, std::get<1>(result));
+    }
+
+    void thenProducerIsNotAskedForMoreData()
+    {
+        ASSERT_FALSE(m_readRequests.pop(std::chrono::milliseconds(100)));
+    }
+
+private:
+    std::unique_ptr<PullMessageBodySource> m_messageBody;
+    nx::utils::SyncQueue<AbstractMsgBodySource::CompletionHandler> m_readRequests;
+    nx::utils::SyncQueue<std::tuple<SystemError::ErrorCode, nx::Buffer>> m_readQueue;
+    std::thread m_producerThread;
+};
+
+TEST_F(HttpPullMessageBodySource, data_is_produced_on_demand)
+{
+    whenStartReading();
+    whenProduce("Hello");
+    thenDataIsRead("Hello");
+
+    // The previous portion has not been sent yet.
+    thenProducerIsNotAskedForMoreData();
+}
+
+TEST_F(HttpPullMessageBodySource, eof_is_reported_without_asking_producer_again)
+{
+    whenStartReading();
+    whenProduce("Hello");
+    thenDataIsRead("Hello");
+
+    whenStartReading();
+    whenProduce(nx::Buffer());
+    thenDataIsRead(nx::Buffer());
+
+    whenStartReading();
+    thenDataIsRead(nx::Buffer());
+    thenProducerIsNotAskedForMoreData();
+}
+
+} // namespace nx::network::http::test
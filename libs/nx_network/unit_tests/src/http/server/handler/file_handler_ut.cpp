@@ -57,6 +57,17 @@ protected:
                 "/fs/", testDataDir().toStdString(), m_fileReadSize); },
             Method::get);
 
+        m_server.httpMessageDispatcher().registerRequestProcessor(
+            "/fs-buffered/.*",
+            [this]()
+            {
+                auto handler = std::make_unique<FileDownloader>(
+                    "/fs-buffered/", testDataDir().toStdString(), m_fileReadSize);
+                handler->setZeroCopyEnabled(false);
+                return handler;
+            },
+            Method::get);
+
         m_server.httpMessageDispatcher().registerRequestProcessor(
             "/content/.*",
             [this]() { return std::make_unique<FileDownloader>(
@@ -83,6 +94,12 @@ protected:
         whenRequestFile("/fs/test.txt");
     }
 
+    void whenRequestExistingFileWithZeroCopyDisabled()
+    {
+        m_expectedFileContents = &m_regularFileContents;
+        whenRequestFile("/fs-buffered/test.txt");
+    }
+
     void whenRequestExistingFileAsync(EventHandlers handlers = {})
     {
         m_expectedFileContents = &m_regularFileContents;
@@ -178,6 +195,15 @@ TEST_F(HttpServerFileDownloader, provides_regular_file)
     andFileDownloaded();
 }
 
+TEST_F(HttpServerFileDownloader, provides_regular_file_with_zero_copy_disabled)
+{
+    whenRequestExistingFileWithZeroCopyDisabled();
+
+    thenRequestSucceeded();
+    andContentLengthIsEqualToFileSize();
+    andFileDownloaded();
+}
+
 TEST_F(HttpServerFileDownloader, provides_qt_resource_file)
 {
     whenRequestResourceFile();
@@ -2,11 +2,13 @@
 
 #include <memory>
 #include <optional>
+#include <thread>
 
 #include <gtest/gtest.h>
 
 #include <nx/network/http/buffer_source.h>
 #include <nx/network/http/chunked_body_source.h>
+#include <nx/network/http/http2/frame.h>
 #include <nx/network/http/http_client.h>
 #include <nx/network/http/server/http_server_connection.h>
 #include <nx/network/http/empty_message_body_source.h>
@@ -224,6 +226,32 @@ protected:
         sendDataThroughRawConnection(kSubscribeToServerConnectionClosedPath);
     }
 
+    void whenSendPartialHttp2PrefaceAndCloseConnection()
+    {
+        auto conn = std::make_unique<TCPSocket>(AF_INET);
+        ASSERT_TRUE(conn->connect(m_httpServer.serverAddress(), kNoTimeout))
+            << SystemError::getLastOSErrorText();
+
+        const std::string_view partialPreface = http2::kConnectionPreface.substr(0, 8);
+        ASSERT_EQ(
+            partialPreface.size(),
+            conn->send(partialPreface.data(), partialPreface.size()));
+
+        // There might be a small delay before the server creates a connection from the accepted
+        // socket.
+        while (m_httpServer.server().connectionCount() < 1)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        conn.reset();
+    }
+
+    void thenServerRemovesConnection()
+    {
+        // NOTE: the following loop hangs if the connection closure is not reported.
+        while (m_httpServer.server().connectionCount() > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
     void thenOnResponseSentHandlerIsCalled()
     {
         m_responseSentEvents.pop();
@@ -627,6 +655,14 @@ TEST_F(HttpServerConnection, inactivity_timeout_is_prolonged)
     thenServerDoesNotCloseConnection(std::chrono::milliseconds(100));
 }
 
+TEST_F(HttpServerConnection, closure_during_http2_preface_detection_is_reported)
+{
+    httpServer().server().setHttp2Enabled(true);
+
+    whenSendPartialHttp2PrefaceAndCloseConnection();
+    thenServerRemovesConnection();
+}
+
 TEST_F(HttpServerConnection, custom_server_header)
 {
     HttpHeaders responseHeaders {{"Server", compatibilityServerName()}};
@@ -211,6 +211,37 @@ TEST_F(SummingStatisticsProvider, merges_request_path_statistics)
     thenStatisticsHaveExpectedValues(expectedStatistics(providers), statistics);
 }
 
+TEST_F(SummingStatisticsProvider, sums_up_route_statistics)
+{
+    auto providers = givenStatisticsProviders();
+    for (std::size_t i = 0; i < providers.size(); ++i)
+    {
+        auto stats = providers[i].httpStatistics();
+        auto& routeStats = stats.routes["GET /route"];
+        routeStats.requestCount = 1;
+        routeStats.requestsInFlight = 1;
+        routeStats.requestBytes = 10;
+        routeStats.responseBytes = 100;
+        routeStats.maxRequestProcessingTimeUsec = std::chrono::microseconds(i + 1);
+        routeStats.requestProcessingTimePercentilesUsec["99"] = std::chrono::microseconds(i + 1);
+        providers[i].setHttpStatistics(std::move(stats));
+    }
+
+    const auto statistics = whenRequestAggregateStatistics(providers);
+
+    const auto& routeStats = statistics.routes.at("GET /route");
+    ASSERT_EQ(providers.size(), routeStats.requestCount);
+    ASSERT_EQ((int) providers.size(), routeStats.requestsInFlight);
+    ASSERT_EQ(10 * providers.size(), routeStats.requestBytes);
+    ASSERT_EQ(100 * providers.size(), routeStats.responseBytes);
+    ASSERT_EQ(
+        std::chrono::microseconds(providers.size()),
+        routeStats.maxRequestProcessingTimeUsec);
+    ASSERT_EQ(
+        std::chrono::microseconds(providers.size()),
+        routeStats.requestProcessingTimePercentilesUsec.at("99"));
+}
+
 // ------------------------------------------------------------------------------------------------
 // MultiEndpointServerHttpStatistics
 
@@ -418,6 +449,29 @@ TEST_F(MultiEndpointServerHttpStatistics, percentiles_present)
     ASSERT_NE(zero, stats.requestProcessingTimePercentilesUsec.at("99"));
 }
 
+TEST_F(MultiEndpointServerHttpStatistics, route_statistics)
+{
+    givenGetRequestPaths({"/0", "/1"});
+
+    for (int i = 0; i < 3; ++i)
+        whenMakeGetRequest("/0");
+
+    const auto stats = whenRequestHttpStatistics();
+
+    const auto& routeStats = stats.routes.at("GET /0");
+    ASSERT_EQ(3U, routeStats.requestCount);
+    ASSERT_EQ(0, routeStats.requestsInFlight);
+    ASSERT_GT(routeStats.maxRequestProcessingTimeUsec, std::chrono::microseconds::zero());
+    for (const auto& key: {"50", "95", "99"})
+    {
+        ASSERT_LE(
+            routeStats.requestProcessingTimePercentilesUsec.at(key),
+            routeStats.maxRequestProcessingTimeUsec);
+    }
+
+    ASSERT_EQ(0U, stats.routes.at("GET /1").requestCount);
+}
+
 TEST_F(MultiEndpointServerHttpStatistics, http_status_codes)
 {
     std::vector<RequestHandlerData> requestHandlers = {
@@ -0,0 +1,95 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/http/http_client.h>
+#include <nx/network/http/server/multi_endpoint_acceptor.h>
+#include <nx/network/http/server/rest/http_server_rest_message_dispatcher.h>
+#include <nx/network/url/url_builder.h>
+
+namespace nx::network::http::server::test {
+
+static constexpr char kTestPath[] = "/test";
+
+class MultiEndpointAcceptor:
+    public ::testing::Test
+{
+public:
+    ~MultiEndpointAcceptor()
+    {
+        m_acceptor.pleaseStopSync();
+    }
+
+protected:
+    virtual void SetUp() override
+    {
+        m_dispatcher.registerRequestProcessorFunc(
+            Method::get,
+            kTestPath,
+            [](auto /*requestContext*/, auto handler) { handler(StatusCode::ok); });
+    }
+
+    void givenAcceptorWithListenersPerEndpoint(std::size_t count)
+    {
+        m_acceptor.setListenersPerEndpoint(count);
+        ASSERT_TRUE(m_acceptor.bind({SocketAddress::anyPrivateAddressV4}, {}));
+        ASSERT_TRUE(m_acceptor.listen());
+    }
+
+    void whenIssueRequests(int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            HttpClient client(ssl::kAcceptAnyCertificate);
+            ASSERT_TRUE(client.doGet(url::Builder().setScheme(kUrlSchemeName)
+                .setEndpoint(m_acceptor.endpoints().front()).setPath(kTestPath)));
+            ASSERT_EQ(StatusCode::ok, client.response()->statusLine.statusCode);
+        }
+        m_requestCount += count;
+    }
+
+    void thenEndpointIsReportedOnce()
+    {
+        ASSERT_EQ(1U, m_acceptor.endpoints().size());
+    }
+
+    void andEveryListenerIsReportedInStatistics(std::size_t expectedListenerCount)
+    {
+        const auto stats = m_acceptor.httpStatistics();
+        ASSERT_EQ(expectedListenerCount, stats.listeners.size());
+
+        int connectionsAccepted = 0;
+        for (const auto& listener: stats.listeners)
+        {
+            ASSERT_EQ(m_acceptor.endpoints().front().toString(), listener.endpoint);
+            connectionsAccepted += listener.connectionsAcceptedPerMinute;
+        }
+        ASSERT_EQ(m_requestCount, connectionsAccepted);
+        ASSERT_EQ(stats.connectionsAcceptedPerMinute, connectionsAccepted);
+    }
+
+private:
+    rest::MessageDispatcher m_dispatcher;
+    server::MultiEndpointAcceptor m_acceptor{&m_dispatcher};
+    int m_requestCount = 0;
+};
+
+TEST_F(MultiEndpointAcceptor, single_listener_per_endpoint_by_default)
+{
+    givenAcceptorWithListenersPerEndpoint(1);
+    whenIssueRequests(3);
+
+    thenEndpointIsReportedOnce();
+    andEveryListenerIsReportedInStatistics(1);
+}
+
+TEST_F(MultiEndpointAcceptor, multiple_listeners_share_the_endpoint)
+{
+    givenAcceptorWithListenersPerEndpoint(3);
+    whenIssueRequests(10);
+
+    thenEndpointIsReportedOnce();
+    andEveryListenerIsReportedInStatistics(3);
+}
+
+} // namespace nx::network::http::server::test
@@ -1,8 +1,15 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <chrono>
+#include <iostream>
+#include <regex>
+
 #include <gtest/gtest.h>
 
 #include <nx/network/http/server/rest/http_server_rest_path_matcher.h>
+#include <nx/utils/random.h>
+
+#include "vms_route_table.h"
 
 namespace nx::network::http::server::rest::test {
 
@@ -135,4 +142,193 @@ TEST_F(RestPathMatcher, sub_resource_path_is_not_matched_as_parent_resource_name
     assertPathMatches("/account/vpupkin/bills/", 2, {{"accountId", "vpupkin"}}, "/account/{accountId}/bills/");
 }
 
+TEST_F(RestPathMatcher, template_registered_first_wins)
+{
+    assertPathRegistered("/account/{accountId}", 1);
+    assertPathRegistered("/account/self", 2);
+    assertPathRegistered("/account/{accountId}/systems", 3);
+
+    assertPathMatches("/account/self", 1, {{"accountId", "self"}}, "/account/{accountId}");
+    assertPathMatches(
+        "/account/self/systems", 3, {{"accountId", "self"}}, "/account/{accountId}/systems");
+}
+
+TEST_F(RestPathMatcher, parameter_followed_by_literal_in_the_same_path_item)
+{
+    const std::string file{"/files/{name}.txt"};
+    assertPathRegistered(file, 1);
+
+    assertPathMatches("/files/report.v2.txt", 1, {{"name", "report.v2"}}, file);
+    assertPathNotMatched("/files/.txt");
+}
+
+TEST_F(RestPathMatcher, rest_of_path)
+{
+    const std::string files{"/fs/.*"};
+    const std::string sessions{"/relay/server/{serverId}/.*"};
+    assertPathRegistered(files, 1);
+    assertPathRegistered(sessions, 2);
+
+    assertPathMatches("/fs/", 1, {}, files);
+    assertPathMatches("/fs/dir/file.txt", 1, {}, files);
+    assertPathMatches("/relay/server/id/client_sessions/", 2, {{"serverId", "id"}}, sessions);
+    assertPathNotMatched("/fs");
+}
+
+TEST_F(RestPathMatcher, template_with_regular_expression)
+{
+    const std::string items{"/items/[0-9][0-9]*"};
+    assertPathRegistered(items, 1);
+    assertPathRegistered("/items/{id}", 2);
+
+    assertPathMatches("/items/123", 1, {}, items);
+    assertPathMatches("/items/abc", 2, {{"id", "abc"}}, "/items/{id}");
+}
+
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * Matches all templates with std::regex one by one. That is how PathMatcher worked before the
+ * radix tree was introduced.
+ */
+class RegexPathMatcher
+{
+public:
+    void add(const std::string& pathTemplate)
+    {
+        const std::regex paramRegex("{[0-9a-zA-Z_-]*}", std::regex_constants::basic);
+        const auto regexStr =
+            "^" + std::regex_replace(pathTemplate, paramRegex, "\\([^/]*\\)") + "$";
+        m_templates.emplace_back(
+            pathTemplate,
+            std::regex(regexStr, std::regex::icase | std::regex_constants::basic));
+    }
+
+    std::optional<std::string /*pathTemplate*/> match(const std::string& path) const
+    {
+        for (const auto& [pathTemplate, regex]: m_templates)
+        {
+            std::smatch matchResult;
+            if (!std::regex_search(path, matchResult, regex))
+                continue;
+
+            bool emptyParamFound = false;
+            for (std::size_t i = 1; i < matchResult.size(); ++i)
+                emptyParamFound |= matchResult[i].length() == 0;
+            if (!emptyParamFound)
+                return pathTemplate;
+        }
+
+        return std::nullopt;
+    }
+
+private:
+    std::vector<std::pair<std::string, std::regex>> m_templates;
+};
+
+} // namespace
+
+class RestPathMatcherVmsRouteTable:
+    public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        int value = 0;
+        for (const auto& pathTemplate: kVmsRouteTable)
+        {
+            ASSERT_TRUE(m_matcher.add(pathTemplate, value++));
+            m_regexMatcher.add(pathTemplate);
+        }
+
+        for (const auto& pathTemplate: kVmsRouteTable)
+        {
+            const auto path = instantiate(pathTemplate);
+            m_paths.push_back(path);
+            m_paths.push_back(path + "/unknown");
+            m_paths.push_back(path.substr(0, path.size() - 1));
+        }
+    }
+
+    const std::vector<std::string>& paths() const { return m_paths; }
+    const PathMatcher<int>& matcher() const { return m_matcher; }
+    const RegexPathMatcher& regexMatcher() const { return m_regexMatcher; }
+
+private:
+    PathMatcher<int> m_matcher;
+    RegexPathMatcher m_regexMatcher;
+    std::vector<std::string> m_paths;
+
+    /** Substitutes the parameters with random values and randomly changes the case. */
+    static std::string instantiate(const std::string& pathTemplate)
+    {
+        static constexpr char kParamChars[] = "abcXYZ019_-.%";
+
+        std::string path;
+        for (std::size_t pos = 0; pos < pathTemplate.size(); ++pos)
+        {
+            if (pathTemplate[pos] == '{')
+            {
+                const auto length = nx::utils::random::number<int>(1, 8);
+                for (int i = 0; i < length; ++i)
+                {
+                    path += kParamChars[
+                        nx::utils::random::number<std::size_t>(0, sizeof(kParamChars) - 2)];
+                }
+                pos = pathTemplate.find('}', pos);
+                continue;
+            }
+
+            path += nx::utils::random::number<int>(0, 9) == 0
+                ? (char) std::toupper(pathTemplate[pos])
+                : pathTemplate[pos];
+        }
+
+        return path;
+    }
+};
+
+TEST_F(RestPathMatcherVmsRouteTable, same_result_as_regex_matcher)
+{
+    for (const auto& path: paths())
+    {
+        const auto result = matcher().match(path);
+        const auto expected = regexMatcher().match(path);
+
+        ASSERT_EQ(expected.has_value(), result.has_value()) << path;
+        if (expected)
+            ASSERT_EQ(*expected, result->pathTemplate) << path;
+    }
+}
+
+TEST_F(RestPathMatcherVmsRouteTable, DISABLED_performance)
+{
+    using namespace std::chrono;
+
+    static constexpr int kIterationCount = 10;
+
+    const auto measure =
+        [this](const char* name, auto match)
+        {
+            const auto t0 = steady_clock::now();
+            int matchedCount = 0;
+            for (int i = 0; i < kIterationCount; ++i)
+            {
+                for (const auto& path: paths())
+                    matchedCount += match(path) ? 1 : 0;
+            }
+            const auto t1 = steady_clock::now();
+
+            std::cout << name << ": matching " << kIterationCount * paths().size()
+                << " paths (" << matchedCount << " matched) took "
+                << duration_cast<milliseconds>(t1 - t0).count() << "ms" << std::endl;
+        };
+
+    measure("PathMatcher", [this](const auto& path) { return matcher().match(path).has_value(); });
+    measure("RegexPathMatcher",
+        [this](const auto& path) { return regexMatcher().match(path).has_value(); });
+}
+
 } // nx::network::http::server::rest::test
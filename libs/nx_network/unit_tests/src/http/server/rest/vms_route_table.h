@@ -0,0 +1,542 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+namespace nx::network::http::server::rest::test {
+
+/**
+ * REST API request path templates registered by the VMS Server (see nx_vms_api
+ * register_*_handlers.inc). The API versions are expanded.
+ */
+static constexpr const char* kVmsRouteTable[] = {
+    "/rest/v1/login/users/{username}",
+    "/rest/v2/login/users/{username}",
+    "/rest/v3/login/users/{username}",
+    "/rest/v4/login/users/{username}",
+    "/rest/v1/login/users",
+    "/rest/v2/login/users",
+    "/rest/v3/login/users",
+    "/rest/v4/login/users",
+    "/rest/v1/login/sessions",
+    "/rest/v2/login/sessions",
+    "/rest/v3/login/sessions",
+    "/rest/v4/login/sessions",
+    "/rest/v1/login/sessions/{token}",
+    "/rest/v2/login/sessions/{token}",
+    "/rest/v3/login/sessions/{token}",
+    "/rest/v4/login/sessions/{token}",
+    "/rest/v3/login/temporaryToken",
+    "/rest/v4/login/temporaryToken",
+    "/rest/v3/login/tickets",
+    "/rest/v4/login/tickets",
+    "/rest/v3/login/tickets/{token}",
+    "/rest/v4/login/tickets/{token}",
+    "/rest/v1/system/info",
+    "/rest/v2/system/info",
+    "/rest/v3/system/info",
+    "/rest/v4/site/info",
+    "/rest/v1/system/other",
+    "/rest/v2/system/other",
+    "/rest/v3/system/other",
+    "/rest/v4/site/other",
+    "/rest/v1/system/cloudSignature",
+    "/rest/v2/system/cloudSignature",
+    "/rest/v3/system/cloud/signature",
+    "/rest/v4/cloud/signature",
+    "/rest/v1/system/merge",
+    "/rest/v2/system/merge",
+    "/rest/v3/system/merge",
+    "/rest/v4/site/merge",
+    "/rest/v1/system/storageEncryption",
+    "/rest/v2/system/storageEncryption",
+    "/rest/v3/system/storageEncryption",
+    "/rest/v1/system/storageEncryption/{ivVect}",
+    "/rest/v2/system/storageEncryption/{ivVect}",
+    "/rest/v3/system/storageEncryption/{ivVect}",
+    "/rest/v4/site/storageEncryption",
+    "/rest/v4/site/storageEncryption/{ivVect}",
+    "/rest/v2/system/resourceData",
+    "/rest/v3/system/resourceData",
+    "/rest/v4/site/resourceData",
+    "/rest/v2/system/metrics/manifest",
+    "/rest/v3/system/metrics/manifest",
+    "/rest/v4/metrics/manifest",
+    "/rest/v2/system/metrics/rules",
+    "/rest/v3/system/metrics/rules",
+    "/rest/v4/metrics/rules",
+    "/rest/v2/system/metrics/values",
+    "/rest/v3/system/metrics/values",
+    "/rest/v4/metrics/values",
+    "/rest/v2/system/metrics/alarms",
+    "/rest/v3/system/metrics/alarms",
+    "/rest/v4/metrics/alarms",
+    "/rest/v3/system/cloud/sync",
+    "/rest/v3/system/cloud/sync/{service}",
+    "/rest/v4/cloud/sync",
+    "/rest/v4/cloud/sync/{service}",
+    "/rest/v3/system/cloud/saas",
+    "/rest/v4/cloud/saas",
+    "/rest/v1/system/cleanupTaxonomy",
+    "/rest/v2/system/cleanupTaxonomy",
+    "/rest/v3/system/cleanupTaxonomy",
+    "/rest/v4/site/cleanupTaxonomy",
+    "/rest/v3/resourceGroups",
+    "/rest/v4/resourceGroups",
+    "/rest/v4/site/resources/{id}",
+    "/rest/v4/site/resources",
+    "/rest/v3/servers/{id}/info",
+    "/rest/v3/servers/%2A/info",
+    "/rest/v1/servers/{id}/info",
+    "/rest/v2/servers/{id}/info",
+    "/rest/v1/servers/%2A/info",
+    "/rest/v2/servers/%2A/info",
+    "/rest/v4/servers/{id}/info",
+    "/rest/v4/servers/%2A/info",
+    "/rest/v2/servers/{id}/runtimeInfo",
+    "/rest/v3/servers/{id}/runtimeInfo",
+    "/rest/v4/servers/{id}/runtimeInfo",
+    "/rest/v2/servers/%2A/runtimeInfo",
+    "/rest/v3/servers/%2A/runtimeInfo",
+    "/rest/v4/servers/%2A/runtimeInfo",
+    "/rest/v2/servers/{id}/logSettings",
+    "/rest/v3/servers/{id}/logSettings",
+    "/rest/v4/servers/{id}/logSettings",
+    "/rest/v2/servers/%2A/logSettings",
+    "/rest/v3/servers/%2A/logSettings",
+    "/rest/v4/servers/%2A/logSettings",
+    "/rest/v2/servers/{id}/logArchive",
+    "/rest/v3/servers/{id}/logArchive",
+    "/rest/v4/servers/{id}/logArchive",
+    "/rest/v2/servers/{id}/staticWebContent",
+    "/rest/v3/servers/{id}/staticWebContent",
+    "/rest/v4/servers/{id}/staticWebContent",
+    "/rest/v1/servers/{id}/backupSettings",
+    "/rest/v2/servers/{id}/backupSettings",
+    "/rest/v3/servers/{id}/backupSettings",
+    "/rest/v4/servers/{id}/backupSettings",
+    "/rest/v1/servers/%2A/backupSettings",
+    "/rest/v2/servers/%2A/backupSettings",
+    "/rest/v3/servers/%2A/backupSettings",
+    "/rest/v4/servers/%2A/backupSettings",
+    "/rest/v1/servers/{serverId}/backupPositions",
+    "/rest/v2/servers/{serverId}/backupPositions",
+    "/rest/v3/servers/{serverId}/backupPositions",
+    "/rest/v1/servers/{serverId}/backupPositions/{deviceId}",
+    "/rest/v2/servers/{serverId}/backupPositions/{deviceId}",
+    "/rest/v3/servers/{serverId}/backupPositions/{deviceId}",
+    "/rest/v2/servers/{serverId}/backupPositions/{deviceId}/reset",
+    "/rest/v3/servers/{serverId}/backupPositions/{deviceId}/reset",
+    "/rest/v4/servers/{serverId}/backupPositions",
+    "/rest/v4/servers/{serverId}/backupPositions/{deviceId}",
+    "/rest/v4/servers/{serverId}/backupPositions/{deviceId}/reset",
+    "/rest/v4/servers/{serverId}/deploymentCode",
+    "/rest/v4/servers/%2A/deploymentCode",
+    "/rest/v4/servers/{serverId}/qrcode/image",
+    "/rest/v2/servers/{serverId}/remoteArchive/{deviceId}/sync",
+    "/rest/v3/servers/{serverId}/remoteArchive/{deviceId}/sync",
+    "/rest/v4/servers/{serverId}/remoteArchive/{deviceId}/sync",
+    "/rest/v2/servers/{serverId}/remoteArchive/%2A/sync",
+    "/rest/v3/servers/{serverId}/remoteArchive/%2A/sync",
+    "/rest/v4/servers/{serverId}/remoteArchive/%2A/sync",
+    "/rest/v1/servers/{id}/dbBackups",
+    "/rest/v2/servers/{id}/dbBackups",
+    "/rest/v3/servers/{id}/dbBackups",
+    "/rest/v4/servers/{id}/dbBackups",
+    "/rest/v1/servers/{id}/detach",
+    "/rest/v2/servers/{id}/detach",
+    "/rest/v3/servers/{id}/detach",
+    "/rest/v4/servers/{id}/detach",
+    "/rest/v1/servers/{id}/reset",
+    "/rest/v2/servers/{id}/reset",
+    "/rest/v3/servers/{id}/reset",
+    "/rest/v4/servers/{id}/reset",
+    "/rest/v1/servers/{id}/restart",
+    "/rest/v2/servers/{id}/restart",
+    "/rest/v3/servers/{id}/restart",
+    "/rest/v4/servers/{id}/restart",
+    "/rest/v2/servers/{id}/recordingStatistics",
+    "/rest/v3/servers/{id}/recordingStatistics",
+    "/rest/v4/servers/{id}/recordingStatistics",
+    "/rest/v2/servers/%2A/recordingStatistics",
+    "/rest/v3/servers/%2A/recordingStatistics",
+    "/rest/v4/servers/%2A/recordingStatistics",
+    "/rest/v2/servers/{id}/settingsManifest",
+    "/rest/v3/servers/{id}/settingsManifest",
+    "/rest/v2/servers/%2A/settingsManifest",
+    "/rest/v3/servers/%2A/settingsManifest",
+    "/rest/v4/servers/{id}/settings",
+    "/rest/v4/servers/%2A/settings",
+    "/rest/v2/servers/{id}/storageForecast",
+    "/rest/v3/servers/{id}/storageForecast",
+    "/rest/v4/servers/{id}/storageForecast",
+    "/rest/v2/servers/%2A/storageForecast",
+    "/rest/v3/servers/%2A/storageForecast",
+    "/rest/v4/servers/%2A/storageForecast",
+    "/rest/v1/servers/{id}/storages/%2A/purge",
+    "/rest/v2/servers/{id}/storages/%2A/purge",
+    "/rest/v3/servers/{id}/storages/%2A/purge",
+    "/rest/v4/servers/{id}/storages/%2A/purge",
+    "/rest/v1/servers/%2A/storages/%2A/purge",
+    "/rest/v2/servers/%2A/storages/%2A/purge",
+    "/rest/v3/servers/%2A/storages/%2A/purge",
+    "/rest/v4/servers/%2A/storages/%2A/purge",
+    "/rest/v1/servers/{serverId}/storages/{id}/status",
+    "/rest/v2/servers/{serverId}/storages/{id}/status",
+    "/rest/v1/servers/{serverId}/storages/%2A/status",
+    "/rest/v2/servers/{serverId}/storages/%2A/status",
+    "/rest/v3/servers/{serverId}/storages/{id}/status",
+    "/rest/v4/servers/{serverId}/storages/{id}/status",
+    "/rest/v3/servers/{serverId}/storages/%2A/status",
+    "/rest/v4/servers/{serverId}/storages/%2A/status",
+    "/rest/v4/servers/{serverId}/storages/%2A/check",
+    "/rest/v2/servers/{id}/rebuildArchive",
+    "/rest/v3/servers/{id}/rebuildArchive",
+    "/rest/v4/servers/{id}/rebuildArchive",
+    "/rest/v2/servers/%2A/rebuildArchive",
+    "/rest/v3/servers/%2A/rebuildArchive",
+    "/rest/v4/servers/%2A/rebuildArchive",
+    "/rest/v2/servers/{id}/rebuildArchive/{location}",
+    "/rest/v3/servers/{id}/rebuildArchive/{location}",
+    "/rest/v4/servers/{id}/rebuildArchive/{location}",
+    "/rest/v2/servers/%2A/rebuildArchive/{location}",
+    "/rest/v3/servers/%2A/rebuildArchive/{location}",
+    "/rest/v4/servers/%2A/rebuildArchive/{location}",
+    "/rest/v3/servers/{id}/timeZones",
+    "/rest/v4/servers/{id}/timeZones",
+    "/rest/v3/servers/{id}/scripts",
+    "/rest/v4/servers/{id}/scripts",
+    "/rest/v3/servers/{id}/scripts/{name}/run",
+    "/rest/v4/servers/{id}/scripts/{name}/run",
+    "/rest/v3/servers/{serverId}/testEmail",
+    "/rest/v4/servers/{serverId}/testEmail",
+    "/rest/v3/servers/{serverId}/pingDevices",
+    "/rest/v4/servers/{serverId}/pingDevices",
+    "/rest/v4/servers/{serverId}/audit",
+    "/rest/v1/devices/%2A/bookmarks",
+    "/rest/v2/devices/%2A/bookmarks",
+    "/rest/v1/devices/{deviceId}/bookmarks",
+    "/rest/v2/devices/{deviceId}/bookmarks",
+    "/rest/v1/devices/{deviceId}/bookmarks/{id}",
+    "/rest/v2/devices/{deviceId}/bookmarks/{id}",
+    "/rest/v1/devices/%2A/bookmarks/{id}",
+    "/rest/v2/devices/%2A/bookmarks/{id}",
+    "/rest/v3/devices/%2A/bookmarks",
+    "/rest/v4/devices/%2A/bookmarks",
+    "/rest/v3/devices/{deviceId}/bookmarks",
+    "/rest/v4/devices/{deviceId}/bookmarks",
+    "/rest/v3/devices/{deviceId}/bookmarks/{id}",
+    "/rest/v4/devices/{deviceId}/bookmarks/{id}",
+    "/rest/v3/devices/%2A/bookmarks/{id}",
+    "/rest/v4/devices/%2A/bookmarks/{id}",
+    "/rest/v1/devices/%2A/bookmarks/%2A/tags",
+    "/rest/v2/devices/%2A/bookmarks/%2A/tags",
+    "/rest/v3/devices/%2A/bookmarks/%2A/tags",
+    "/rest/v4/devices/%2A/bookmarks/%2A/tags",
+    "/rest/v4/devices/%2A/bookmarks/{id}/description",
+    "/rest/v4/devices/%2A/bookmarks/{bookmarkId}/media",
+    "/rest/v4/devices/%2A/bookmarks/{bookmarkId}/media.{format}",
+    "/rest/v4/devices/%2A/bookmarks/{bookmarkId}/hls",
+    "/rest/v1/devices/%2A/searches",
+    "/rest/v1/devices/%2A/searches/{id}",
+    "/rest/v2/devices/%2A/searches",
+    "/rest/v3/devices/%2A/searches",
+    "/rest/v2/devices/%2A/searches/{id}",
+    "/rest/v3/devices/%2A/searches/{id}",
+    "/rest/v4/devices/%2A/searches",
+    "/rest/v4/devices/%2A/searches/{id}",
+    "/rest/v2/devices/{id}/image",
+    "/rest/v3/devices/{id}/image",
+    "/rest/v4/devices/{id}/image",
+    "/rest/v3/devices/{id}/media",
+    "/rest/v4/devices/{id}/media",
+    "/rest/v3/devices/{id}/media.{format}",
+    "/rest/v4/devices/{id}/media.{format}",
+    "/rest/v3/devices/{id}/webrtc",
+    "/rest/v4/devices/{id}/webrtc",
+    "/rest/v4/devices/{id}/webrtc-camera",
+    "/rest/v3/devices/{id}/virtual/status",
+    "/rest/v4/devices/{id}/virtual/status",
+    "/rest/v3/devices/{id}/virtual/prepare",
+    "/rest/v4/devices/{id}/virtual/prepare",
+    "/rest/v3/devices/{id}/virtual/consume",
+    "/rest/v4/devices/{id}/virtual/consume",
+    "/rest/v3/devices/{id}/virtual/lock",
+    "/rest/v4/devices/{id}/virtual/lock",
+    "/rest/v3/devices/{id}/virtual/extend",
+    "/rest/v4/devices/{id}/virtual/extend",
+    "/rest/v3/devices/{id}/virtual/release",
+    "/rest/v4/devices/{id}/virtual/release",
+    "/rest/v3/ldap/sync",
+    "/rest/v4/ldap/sync",
+    "/rest/v3/ldap/authenticate",
+    "/rest/v4/ldap/authenticate",
+    "/rest/v3/ldap/test",
+    "/rest/v4/ldap/test",
+    "/rest/v3/ldap/settings",
+    "/rest/v4/ldap/settings",
+    "/rest/v4/integrations",
+    "/rest/v4/integrations/{id}",
+    "/rest/v4/analytics/integrations/%2A/requests",
+    "/rest/v4/analytics/integrations/%2A/requests/{requestId}",
+    "/rest/v4/analytics/integrations/%2A/requests/{requestId}/approve",
+    "/rest/v4/analytics/engines/%2A/actions",
+    "/rest/v4/analytics/engines/{engineId}/actions",
+    "/rest/v4/analytics/engines/{engineId}/actions/{actionId}/execute",
+    "/rest/v4/analytics/engines/{id}/settings",
+    "/rest/v4/analytics/engines/{engineId}/deviceAgents",
+    "/rest/v4/analytics/engines/{engineId}/deviceAgents/{id}",
+    "/rest/v4/analytics/engines/{engineId}/deviceAgents/{deviceId}/settings",
+    "/rest/v3/analytics/engines",
+    "/rest/v4/analytics/engines",
+    "/rest/v3/analytics/engines/{id}",
+    "/rest/v4/analytics/engines/{id}",
+    "/rest/v3/analytics/integrations",
+    "/rest/v4/analytics/integrations",
+    "/rest/v3/analytics/integrations/{id}",
+    "/rest/v4/analytics/integrations/{id}",
+    "/rest/v4/analytics/objectTracks",
+    "/rest/v4/analytics/objectTracks/{id}",
+    "/rest/v4/analytics/objectTracks/{id}/objectMetadata",
+    "/rest/v4/analytics/objectTracks/{id}/bestShotImage",
+    "/rest/v4/analytics/objectTracks/{id}/bestShotImage.{format}",
+    "/rest/v4/analytics/objectTracks/{id}/titleImage",
+    "/rest/v4/analytics/objectTracks/{id}/titleImage.{format}",
+    "/rest/v4/analytics/engines/{id}/manifest",
+    "/rest/v4/analytics/engines/{id}/deviceAgents/{deviceId}/manifest",
+    "/rest/v4/analytics/engines/{id}/integrationDiagnosticEvent",
+    "/rest/v4/analytics/engines/{id}/deviceAgents/{deviceId}/integrationDiagnosticEvent",
+    "/rest/v4/analytics/engines/{id}/deviceAgents/{deviceId}/metadata/object",
+    "/rest/v4/analytics/engines/{id}/deviceAgents/{deviceId}/metadata/event",
+    "/rest/v4/analytics/engines/{id}/deviceAgents/{deviceId}/metadata/bestShot",
+    "/rest/v4/analytics/engines/{id}/deviceAgents/{deviceId}/metadata/title",
+    "/rest/v1/licenseSummaries",
+    "/rest/v2/licenseSummaries",
+    "/rest/v3/licenses/%2A/summary",
+    "/rest/v4/licenses/%2A/summary",
+    "/rest/v3/users/{id}/permissions",
+    "/rest/v4/users/{id}/permissions",
+    "/rest/v3/userGroups/{id}/permissions",
+    "/rest/v4/userGroups/{id}/permissions",
+    "/rest/v4/update/start",
+    "/rest/v4/update/install",
+    "/rest/v4/update/finish",
+    "/rest/v4/update/retry",
+    "/rest/v4/update/info",
+    "/rest/v4/update",
+    "/rest/v4/update/storage",
+    "/rest/v4/update/storage/{infoCategory}",
+    "/rest/v1/servers",
+    "/rest/v2/servers",
+    "/rest/v3/servers",
+    "/rest/v1/servers/{id}",
+    "/rest/v2/servers/{id}",
+    "/rest/v3/servers/{id}",
+    "/rest/v4/servers",
+    "/rest/v4/servers/{id}",
+    "/rest/v1/servers/{serverId}/storages",
+    "/rest/v2/servers/{serverId}/storages",
+    "/rest/v3/servers/{serverId}/storages",
+    "/rest/v4/servers/{serverId}/storages",
+    "/rest/v1/servers/{serverId}/storages/{id}",
+    "/rest/v2/servers/{serverId}/storages/{id}",
+    "/rest/v3/servers/{serverId}/storages/{id}",
+    "/rest/v4/servers/{serverId}/storages/{id}",
+    "/rest/v1/devices",
+    "/rest/v2/devices",
+    "/rest/v1/devices/{id}",
+    "/rest/v2/devices/{id}",
+    "/rest/v3/devices",
+    "/rest/v3/devices/{id}",
+    "/rest/v4/devices",
+    "/rest/v4/devices/{id}",
+    "/rest/v1/devices/%2A/types",
+    "/rest/v2/devices/%2A/types",
+    "/rest/v3/devices/%2A/types",
+    "/rest/v4/devices/%2A/types",
+    "/rest/v3/devices/%2A/virtual",
+    "/rest/v3/devices/{id}/virtual",
+    "/rest/v4/devices/%2A/virtual",
+    "/rest/v4/devices/{id}/virtual",
+    "/rest/v1/users",
+    "/rest/v2/users",
+    "/rest/v1/users/{id}",
+    "/rest/v2/users/{id}",
+    "/rest/v3/users",
+    "/rest/v3/users/{id}",
+    "/rest/v4/users",
+    "/rest/v4/users/{id}",
+    "/rest/v1/storedFiles",
+    "/rest/v2/storedFiles",
+    "/rest/v3/storedFiles",
+    "/rest/v4/storedFiles",
+    "/rest/v1/storedFiles/{path}",
+    "/rest/v2/storedFiles/{path}",
+    "/rest/v3/storedFiles/{path}",
+    "/rest/v4/storedFiles/{path}",
+    "/rest/v1/licenses",
+    "/rest/v2/licenses",
+    "/rest/v3/licenses",
+    "/rest/v4/licenses",
+    "/rest/v1/licenses/{key}",
+    "/rest/v2/licenses/{key}",
+    "/rest/v3/licenses/{key}",
+    "/rest/v4/licenses/{key}",
+    "/rest/v1/userRoles",
+    "/rest/v2/userRoles",
+    "/rest/v1/userRoles/{id}",
+    "/rest/v2/userRoles/{id}",
+    "/rest/v3/userGroups",
+    "/rest/v4/userGroups",
+    "/rest/v3/userGroups/{id}",
+    "/rest/v4/userGroups/{id}",
+    "/rest/v1/layouts",
+    "/rest/v2/layouts",
+    "/rest/v3/layouts",
+    "/rest/v4/layouts",
+    "/rest/v1/layouts/{id}",
+    "/rest/v2/layouts/{id}",
+    "/rest/v3/layouts/{id}",
+    "/rest/v4/layouts/{id}",
+    "/rest/v2/layouts/{layoutId}/items",
+    "/rest/v3/layouts/{layoutId}/items",
+    "/rest/v4/layouts/{layoutId}/items",
+    "/rest/v2/layouts/{layoutId}/items/{id}",
+    "/rest/v3/layouts/{layoutId}/items/{id}",
+    "/rest/v4/layouts/{layoutId}/items/{id}",
+    "/rest/v1/layoutTours",
+    "/rest/v1/layoutTours/{id}",
+    "/rest/v2/showreels",
+    "/rest/v3/showreels",
+    "/rest/v4/showreels",
+    "/rest/v2/showreels/{id}",
+    "/rest/v3/showreels/{id}",
+    "/rest/v4/showreels/{id}",
+    "/rest/v3/lookupLists",
+    "/rest/v4/lookupLists",
+    "/rest/v3/lookupLists/{id}",
+    "/rest/v4/lookupLists/{id}",
+    "/rest/v1/videoWalls",
+    "/rest/v2/videoWalls",
+    "/rest/v3/videoWalls",
+    "/rest/v4/videoWalls",
+    "/rest/v1/videoWalls/{id}",
+    "/rest/v2/videoWalls/{id}",
+    "/rest/v3/videoWalls/{id}",
+    "/rest/v4/videoWalls/{id}",
+    "/rest/v1/webPages",
+    "/rest/v2/webPages",
+    "/rest/v1/webPages/{id}",
+    "/rest/v2/webPages/{id}",
+    "/rest/v3/webPages",
+    "/rest/v4/webPages",
+    "/rest/v3/webPages/{id}",
+    "/rest/v4/webPages/{id}",
+    "/rest/v1/system/database",
+    "/rest/v2/system/database",
+    "/rest/v3/system/database",
+    "/rest/v4/site/database",
+    "/rest/v1/devices/{id}/changePassword",
+    "/rest/v2/devices/{id}/changePassword",
+    "/rest/v3/devices/{id}/changePassword",
+    "/rest/v4/devices/{id}/changePassword",
+    "/rest/v1/devices/{id}/footage",
+    "/rest/v2/devices/{id}/footage",
+    "/rest/v1/devices/%2A/footage",
+    "/rest/v2/devices/%2A/footage",
+    "/rest/v3/devices/{id}/footage",
+    "/rest/v4/devices/{id}/footage",
+    "/rest/v3/devices/%2A/footage",
+    "/rest/v4/devices/%2A/footage",
+    "/rest/v1/devices/{id}/status",
+    "/rest/v2/devices/{id}/status",
+    "/rest/v3/devices/{id}/status",
+    "/rest/v4/devices/{id}/status",
+    "/rest/v1/devices/%2A/status",
+    "/rest/v2/devices/%2A/status",
+    "/rest/v3/devices/%2A/status",
+    "/rest/v4/devices/%2A/status",
+    "/rest/v3/devices/{id}/resourceData",
+    "/rest/v4/devices/{id}/resourceData",
+    "/rest/v3/devices/%2A/resourceData",
+    "/rest/v4/devices/%2A/resourceData",
+    "/rest/v2/devices/{id}/replace",
+    "/rest/v3/devices/{id}/replace",
+    "/rest/v4/devices/{id}/replace",
+    "/rest/v2/devices/{id}/changeId",
+    "/rest/v3/devices/{id}/changeId",
+    "/rest/v4/devices/{id}/changeId",
+    "/rest/v2/devices/{id}/advanced/%2A/manifest",
+    "/rest/v3/devices/{id}/advanced/%2A/manifest",
+    "/rest/v4/devices/{id}/advanced/%2A/manifest",
+    "/rest/v2/devices/%2A/advanced/%2A/manifest",
+    "/rest/v3/devices/%2A/advanced/%2A/manifest",
+    "/rest/v4/devices/%2A/advanced/%2A/manifest",
+    "/rest/v2/devices/{deviceId}/advanced/{id}",
+    "/rest/v3/devices/{deviceId}/advanced/{id}",
+    "/rest/v4/devices/{deviceId}/advanced/{id}",
+    "/rest/v2/devices/{deviceId}/advanced",
+    "/rest/v3/devices/{deviceId}/advanced",
+    "/rest/v4/devices/{deviceId}/advanced",
+    "/rest/v4/devices/{deviceId}/io",
+    "/rest/v4/devices/%2A/io",
+    "/rest/v3/devices/{deviceId}/ptz/move",
+    "/rest/v4/devices/{deviceId}/ptz/move",
+    "/rest/v3/devices/{deviceId}/ptz/position",
+    "/rest/v4/devices/{deviceId}/ptz/position",
+    "/rest/v3/devices/{deviceId}/ptz/limits",
+    "/rest/v4/devices/{deviceId}/ptz/limits",
+    "/rest/v3/devices/{deviceId}/ptz/presets",
+    "/rest/v4/devices/{deviceId}/ptz/presets",
+    "/rest/v3/devices/{deviceId}/ptz/presets/{id}",
+    "/rest/v4/devices/{deviceId}/ptz/presets/{id}",
+    "/rest/v3/devices/{deviceId}/ptz/presets/{id}/activate",
+    "/rest/v4/devices/{deviceId}/ptz/presets/{id}/activate",
+    "/rest/v3/devices/{deviceId}/ptz/tours",
+    "/rest/v4/devices/{deviceId}/ptz/tours",
+    "/rest/v3/devices/{deviceId}/ptz/tours/{id}",
+    "/rest/v4/devices/{deviceId}/ptz/tours/{id}",
+    "/rest/v3/devices/{deviceId}/ptz/tours/%2A/active",
+    "/rest/v4/devices/{deviceId}/ptz/tours/%2A/active",
+    "/rest/v3/devices/{deviceId}/ptz/tours/{id}/active",
+    "/rest/v4/devices/{deviceId}/ptz/tours/{id}/active",
+    "/rest/v3/servers/{serverId}/events",
+    "/rest/v4/events/manifest/events",
+    "/rest/v4/events/manifest/actions",
+    "/rest/v4/events/log",
+    "/rest/v4/events/log/{serverId}",
+    "/rest/v4/events/acknowledges",
+    "/rest/v4/events/acknowledges/{id}",
+    "/rest/v4/events/generic",
+    "/rest/v4/events/triggers",
+    "/rest/v4/events/triggers/{id}",
+    "/rest/v4/events/rules",
+    "/rest/v4/events/rules/{id}",
+    "/rest/v4/events/rules/%2A/reset",
+    "/rest/v1/system/cloudBind",
+    "/rest/v2/system/cloudBind",
+    "/rest/v3/system/cloud/bind",
+    "/rest/v4/cloud/bind",
+    "/rest/v1/system/cloudUnbind",
+    "/rest/v2/system/cloudUnbind",
+    "/rest/v3/system/cloud/unbind",
+    "/rest/v4/cloud/unbind",
+    "/rest/v1/system/setup",
+    "/rest/v2/system/setup",
+    "/rest/v3/system/setup",
+    "/rest/v4/site/setup",
+    "/rest/v1/system/settings",
+    "/rest/v2/system/settings",
+    "/rest/v3/system/settings",
+    "/rest/v1/system/settings/{name}",
+    "/rest/v2/system/settings/{name}",
+    "/rest/v3/system/settings/{name}",
+    "/rest/v4/site/settings",
+    "/rest/v4/site/settings/{name}",
+    "/rest/v1/system/settingsManifest",
+    "/rest/v2/system/settings/%2A/manifest",
+    "/rest/v3/system/settings/%2A/manifest",
+    "/rest/v2/system/settings/{name}/manifest",
+    "/rest/v3/system/settings/{name}/manifest",
+};
+
+} // namespace nx::network::http::server::rest::test
@@ -8,6 +8,7 @@
 #include <nx/network/maintenance/request_path.h>
 #include <nx/network/maintenance/server.h>
 #include <nx/network/url/url_builder.h>
+#include <nx/utils/thread/lock_contention_profiler.h>
 
 namespace nx::network::maintenance::test {
 
@@ -49,6 +50,11 @@ protected:
         ASSERT_TRUE(m_httpClient.doGet(requestUrl(kDebugCounters)));
     }
 
+    void whenRequestLockContention()
+    {
+        ASSERT_TRUE(m_httpClient.doGet(requestUrl(kLockContention)));
+    }
+
     void whenRequestVersion()
     {
         ASSERT_TRUE(m_httpClient.doGet(requestUrl(kVersion)));
@@ -81,6 +87,17 @@ protected:
         ASSERT_EQ(0U, debugCounters.stunServerConnectionCount);
     }
 
+    void andLockContentionReportIsProvided()
+    {
+        const auto msgBody = m_httpClient.fetchEntireMessageBody();
+        ASSERT_TRUE(msgBody);
+
+        const auto [report, result] =
+            nx::reflect::json::deserialize<nx::LockContentionReport>(*msgBody);
+        ASSERT_TRUE(result);
+        ASSERT_GT(report.samplingPeriod, 0);
+    }
+
     void andVersionIsProvided()
     {
         const auto msgBody = m_httpClient.fetchEntireMessageBody();
@@ -121,6 +138,14 @@ TEST_F(MaintenanceServer, debug_counters)
     andDebugCountersReceived();
 }
 
+TEST_F(MaintenanceServer, lock_contention)
+{
+    whenRequestLockContention();
+
+    thenRequestSucceeded();
+    andLockContentionReportIsProvided();
+}
+
 TEST_F(MaintenanceServer, version)
 {
     whenRequestVersion();
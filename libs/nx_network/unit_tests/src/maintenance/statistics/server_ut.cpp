@@ -3,8 +3,10 @@
 #include <gtest/gtest.h>
 
 #include <nx/network/http/http_client.h>
+#include <nx/network/http/server/http_statistics.h>
 #include <nx/network/http/test_http_server.h>
 #include <nx/network/url/url_builder.h>
+#include <nx/reflect/json.h>
 
 #include <nx/network/maintenance/request_path.h>
 #include <nx/network/maintenance/statistics/request_path.h>
@@ -35,6 +37,11 @@ protected:
         ASSERT_TRUE(m_httpClient.doGet(requestUrl(kGeneral)));
     }
 
+    void whenRequestRouteStatistics()
+    {
+        ASSERT_TRUE(m_httpClient.doGet(requestUrl(kRoutes)));
+    }
+
     void thenRequestSucceeded()
     {
         ASSERT_NE(nullptr, m_httpClient.response());
@@ -55,6 +62,26 @@ protected:
         NX_DEBUG(this, "server uptime: %1", statistics.uptimeMsec);
     }
 
+    void andRouteStatisticsAreProvided()
+    {
+        const auto msgBody = m_httpClient.fetchEntireMessageBody();
+        ASSERT_TRUE(msgBody);
+
+        const auto [routes, result] = nx::reflect::json::deserialize<
+            std::map<std::string, http::server::RouteStatistics>>(*msgBody);
+        ASSERT_TRUE(result.success);
+
+        const auto& generalStats = routes.at(std::string("GET ") + kStatistics + kGeneral);
+        ASSERT_EQ(1U, generalStats.requestCount);
+        ASSERT_GT(generalStats.responseBytes, 0U);
+        ASSERT_TRUE(generalStats.requestProcessingTimePercentilesUsec.contains("50"));
+        ASSERT_TRUE(generalStats.requestProcessingTimePercentilesUsec.contains("95"));
+        ASSERT_TRUE(generalStats.requestProcessingTimePercentilesUsec.contains("99"));
+
+        // The request being served is counted as in-flight.
+        ASSERT_EQ(1, routes.at(std::string("GET ") + kStatistics + kRoutes).requestsInFlight);
+    }
+
 private:
     http::TestHttpServer m_httpServer;
     statistics::Server m_statisticsServer;
@@ -77,4 +104,15 @@ TEST_F(StatisticsServer, general_statistics)
     andStatisticsAreProvided();
 }
 
+TEST_F(StatisticsServer, route_statistics)
+{
+    whenRequestStatistics();
+    thenRequestSucceeded();
+    andStatisticsAreProvided();
+
+    whenRequestRouteStatistics();
+    thenRequestSucceeded();
+    andRouteStatisticsAreProvided();
+}
+
 } // namespace nx::network::maintenance::statistics::test
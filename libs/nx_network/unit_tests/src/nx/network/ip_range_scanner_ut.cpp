@@ -0,0 +1,106 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <nx/network/http/test_http_server.h>
+#include <nx/network/ip_range_scanner.h>
+#include <nx/utils/std/future.h>
+
+namespace nx::network::test {
+
+// The whole 127.0.0.0/8 is routed to the loopback interface on Linux only, so the range of hosts
+// is simulated there by the servers listening on the different loopback addresses.
+#if defined(__linux__)
+
+class IpRangeScanner:
+    public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        for (const char* address: {"127.0.0.2", "127.0.0.5"})
+        {
+            auto server = std::make_unique<http::TestHttpServer>();
+            ASSERT_TRUE(server->bindAndListen(SocketAddress(address, m_port)));
+            m_port = server->serverAddress().port;
+            m_servers.push_back(std::move(server));
+        }
+    }
+
+    std::vector<HostAddress> scan(
+        nx::network::IpRangeScanner* scanner, const char* startAddress, const char* endAddress)
+    {
+        nx::utils::promise<std::vector<HostAddress>> done;
+        scanner->scanOnlineHosts(
+            [&done](std::vector<HostAddress> hosts) { done.set_value(std::move(hosts)); },
+            HostAddress(startAddress),
+            HostAddress(endAddress),
+            m_port);
+
+        auto hosts = done.get_future().get();
+        std::sort(hosts.begin(), hosts.end(),
+            [](const auto& left, const auto& right) { return left.toString() < right.toString(); });
+        return hosts;
+    }
+
+    void assertOnlineHostsFound(bool tcpPreScanEnabled)
+    {
+        nx::network::IpRangeScanner scanner;
+        scanner.setTcpPreScanEnabled(tcpPreScanEnabled);
+
+        const auto hosts = scan(&scanner, "127.0.0.1", "127.0.0.10");
+        scanner.pleaseStopSync();
+
+        ASSERT_EQ(2U, hosts.size());
+        ASSERT_EQ("127.0.0.2", hosts[0].toString());
+        ASSERT_EQ("127.0.0.5", hosts[1].toString());
+        ASSERT_EQ(10U, scanner.hostsChecked());
+    }
+
+    std::chrono::milliseconds measureScan(bool tcpPreScanEnabled)
+    {
+        nx::network::IpRangeScanner scanner;
+        scanner.setTcpPreScanEnabled(tcpPreScanEnabled);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        const auto hosts = scan(&scanner, "127.0.0.1", "127.0.15.255");
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime);
+        scanner.pleaseStopSync();
+
+        EXPECT_EQ(2U, hosts.size());
+        EXPECT_EQ(16U * 256 - 1, scanner.hostsChecked());
+        return duration;
+    }
+
+private:
+    std::vector<std::unique_ptr<http::TestHttpServer>> m_servers;
+    uint16_t m_port = 0;
+};
+
+TEST_F(IpRangeScanner, online_hosts_are_found)
+{
+    assertOnlineHostsFound(/*tcpPreScanEnabled*/ true);
+}
+
+TEST_F(IpRangeScanner, online_hosts_are_found_without_pre_scan)
+{
+    assertOnlineHostsFound(/*tcpPreScanEnabled*/ false);
+}
+
+TEST_F(IpRangeScanner, pre_scan_performance)
+{
+    const auto withPreScan = measureScan(/*tcpPreScanEnabled*/ true);
+    const auto withoutPreScan = measureScan(/*tcpPreScanEnabled*/ false);
+
+    std::cout << "Scanned 4095 hosts in " << withPreScan.count() << "ms with the pre-scan, in "
+        << withoutPreScan.count() << "ms without it" << std::endl;
+}
+
+#endif // defined(__linux__)
+
+} // namespace nx::network::test
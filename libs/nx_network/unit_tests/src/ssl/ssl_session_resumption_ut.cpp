@@ -0,0 +1,264 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <optional>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/ssl/context.h>
+#include <nx/network/ssl/session_cache.h>
+#include <nx/network/ssl/ssl_stream_server_socket.h>
+#include <nx/network/ssl/ssl_stream_socket.h>
+#include <nx/network/system_socket.h>
+
+namespace nx::network::ssl::test {
+
+static const nx::Buffer kGreeting("hello");
+
+class SslSessionResumption:
+    public ::testing::Test
+{
+public:
+    ~SslSessionResumption()
+    {
+        for (auto& server: m_servers)
+        {
+            server->socket->pleaseStopSync();
+            for (auto& connection: server->connections)
+                connection->pleaseStopSync();
+        }
+    }
+
+protected:
+    virtual void SetUp() override
+    {
+        m_pem = makeCertificateAndKey({"test", "US", "NX"});
+    }
+
+    void givenServer()
+    {
+        addServer(std::make_unique<Context>());
+    }
+
+    void givenServerWithSessionCache(std::shared_ptr<ServerSessionCache> cache)
+    {
+        auto context = std::make_unique<Context>();
+        context->setServerSessionCache(std::move(cache));
+        addServer(std::move(context));
+    }
+
+    void givenConnectionEstablished(int serverIndex = 0)
+    {
+        whenConnect(serverIndex);
+        thenConnectionIsEstablished();
+    }
+
+    void whenConnect(int serverIndex = 0)
+    {
+        ClientStreamSocket client(
+            &m_clientContext,
+            std::make_unique<TCPSocket>(AF_INET),
+            kAcceptAnyCertificateCallback);
+        client.setSyncVerifyCertificateChainCallback(
+            [this](CertificateChainView chain, StreamSocket* /*socket*/)
+            {
+                m_lastReceivedCertificate = Certificate(chain.front());
+                return !m_isCertificateRejected;
+            });
+        if (m_sessionCacheKey)
+            client.setSessionCacheKey(*m_sessionCacheKey);
+
+        m_isConnected = client.connect(
+            m_servers[serverIndex]->socket->getLocalAddress(), kNoTimeout);
+        if (!m_isConnected)
+            return;
+
+        // TLS 1.3 session tickets are received along with the application data.
+        nx::Buffer buffer(kGreeting.size(), '\0');
+        ASSERT_EQ(
+            (int) kGreeting.size(),
+            client.recv(buffer.data(), buffer.size(), MSG_WAITALL));
+        m_isSessionReused = client.isSessionReused();
+    }
+
+    void whenConnectUsingTheSameSessionCacheKey(int serverIndex)
+    {
+        m_sessionCacheKey = "cluster";
+        whenConnect(serverIndex);
+    }
+
+    void whenReplaceServerCertificate()
+    {
+        m_pem = makeCertificateAndKey({"test", "US", "NX"});
+        ASSERT_TRUE(m_servers.front()->context->setDefaultCertificate(m_pem));
+    }
+
+    void whenCertificateIsRejectedByClient()
+    {
+        m_isCertificateRejected = true;
+    }
+
+    void whenCertificateIsAcceptedByClient()
+    {
+        m_isCertificateRejected = false;
+    }
+
+    void thenConnectionIsEstablished()
+    {
+        ASSERT_TRUE(m_isConnected);
+    }
+
+    void thenConnectionFailed()
+    {
+        ASSERT_FALSE(m_isConnected);
+    }
+
+    void thenFullHandshakeIsDone()
+    {
+        thenConnectionIsEstablished();
+        ASSERT_FALSE(m_isSessionReused);
+    }
+
+    void thenSessionIsResumed()
+    {
+        thenConnectionIsEstablished();
+        ASSERT_TRUE(m_isSessionReused);
+    }
+
+    void andCertificateIsVerified()
+    {
+        X509Certificate x509;
+        ASSERT_TRUE(x509.parsePem(m_pem));
+        ASSERT_TRUE(m_lastReceivedCertificate);
+        ASSERT_EQ(x509.certificates().front(), *m_lastReceivedCertificate);
+    }
+
+    void andClientCacheReportsHits(std::uint64_t expected)
+    {
+        ASSERT_EQ(expected, m_clientContext.clientSessionCache()->statistics().hits);
+    }
+
+private:
+    struct Server
+    {
+        std::unique_ptr<Context> context;
+        std::unique_ptr<ssl::StreamServerSocket> socket;
+        std::vector<std::unique_ptr<AbstractStreamSocket>> connections;
+    };
+
+    Context m_clientContext;
+    std::string m_pem;
+    std::vector<std::unique_ptr<Server>> m_servers;
+    std::optional<std::string> m_sessionCacheKey;
+    std::optional<Certificate> m_lastReceivedCertificate;
+    bool m_isCertificateRejected = false;
+    bool m_isConnected = false;
+    bool m_isSessionReused = false;
+
+    void addServer(std::unique_ptr<Context> context)
+    {
+        auto server = std::make_unique<Server>();
+        server->context = std::move(context);
+        ASSERT_TRUE(server->context->setDefaultCertificate(m_pem));
+
+        server->socket = std::make_unique<ssl::StreamServerSocket>(
+            server->context.get(),
+            std::make_unique<TCPServerSocket>(AF_INET),
+            EncryptionUse::always);
+        ASSERT_TRUE(server->socket->bind(SocketAddress::anyPrivateAddressV4));
+        ASSERT_TRUE(server->socket->listen());
+        ASSERT_TRUE(server->socket->setNonBlockingMode(true));
+
+        acceptConnections(server.get());
+        m_servers.push_back(std::move(server));
+    }
+
+    void acceptConnections(Server* server)
+    {
+        server->socket->acceptAsync(
+            [this, server](
+                SystemError::ErrorCode resultCode,
+                std::unique_ptr<AbstractStreamSocket> connection)
+            {
+                if (resultCode == SystemError::noError)
+                {
+                    connection->bindToAioThread(server->socket->getAioThread());
+                    ASSERT_TRUE(connection->setNonBlockingMode(true));
+                    connection->sendAsync(&kGreeting, [](auto&&...) {});
+                    server->connections.push_back(std::move(connection));
+                }
+
+                acceptConnections(server);
+            });
+    }
+};
+
+TEST_F(SslSessionResumption, session_is_resumed_on_reconnect)
+{
+    givenServer();
+    givenConnectionEstablished();
+
+    whenConnect();
+
+    thenSessionIsResumed();
+    andCertificateIsVerified();
+    andClientCacheReportsHits(1);
+}
+
+TEST_F(SslSessionResumption, session_is_resumed_by_another_server_with_same_certificate)
+{
+    givenServer();
+    givenServer();
+
+    whenConnectUsingTheSameSessionCacheKey(0);
+    thenFullHandshakeIsDone();
+
+    whenConnectUsingTheSameSessionCacheKey(1);
+    thenSessionIsResumed();
+}
+
+TEST_F(SslSessionResumption, session_is_not_resumed_after_certificate_replacement)
+{
+    givenServer();
+    givenConnectionEstablished();
+
+    whenReplaceServerCertificate();
+    whenConnect();
+
+    thenFullHandshakeIsDone();
+    andCertificateIsVerified();
+}
+
+TEST_F(SslSessionResumption, resumed_session_is_verified_again)
+{
+    givenServer();
+    givenConnectionEstablished();
+
+    whenCertificateIsRejectedByClient();
+    whenConnect();
+    thenConnectionFailed();
+
+    // The rejected session is not offered anymore.
+    whenCertificateIsAcceptedByClient();
+    whenConnect();
+    thenFullHandshakeIsDone();
+}
+
+TEST_F(SslSessionResumption, ticket_issued_with_previous_key_is_accepted)
+{
+    auto cache = std::make_shared<ServerSessionCache>();
+    givenServerWithSessionCache(cache);
+    givenConnectionEstablished();
+
+    cache->rotateTicketKey();
+    whenConnect();
+    thenSessionIsResumed();
+
+    // The ticket has been renewed with the current key. Forgetting both the current key and the
+    // previous one.
+    cache->rotateTicketKey();
+    cache->rotateTicketKey();
+    whenConnect();
+    thenFullHandshakeIsDone();
+}
+
+} // namespace nx::network::ssl::test
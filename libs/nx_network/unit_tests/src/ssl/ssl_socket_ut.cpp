@@ -8,6 +8,7 @@
 #include <openssl/ssl.h>
 
 #include <nx/network/aio/async_channel_reflector.h>
+#include <nx/network/nx_network_ini.h>
 #include <nx/network/ssl/context.h>
 #include <nx/network/test_support/simple_socket_test_helper.h>
 #include <nx/network/test_support/socket_test_helper.h>
@@ -1387,6 +1388,48 @@ TEST_F(SslSocketSwitchIoMode, from_sync_to_async)
     exchangeDataInAsyncMode();
 }
 
+//-------------------------------------------------------------------------------------------------
+// Sending through the kernel TLS. If the kernel does not support it, the regular path is tested.
+
+class SslSocketKernelTls:
+    public SslSocketVerifySslIsActuallyUsed
+{
+public:
+    SslSocketKernelTls()
+    {
+        m_iniTweaks.set(&ini().useKernelTls, true);
+    }
+
+protected:
+    void exchangeDataSeveralTimes()
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            whenSentRandomData();
+            thenSameDataHasBeenReceivedInResponse();
+        }
+    }
+
+private:
+    nx::kit::IniConfig::Tweaks m_iniTweaks;
+};
+
+TEST_F(SslSocketKernelTls, data_is_delivered_by_async_io)
+{
+    switchToAsynchronousMode();
+
+    givenEstablishedConnection();
+    exchangeDataSeveralTimes();
+}
+
+TEST_F(SslSocketKernelTls, data_is_delivered_by_sync_io)
+{
+    switchToSynchronousMode();
+
+    givenEstablishedConnection();
+    exchangeDataSeveralTimes();
+}
+
 //-------------------------------------------------------------------------------------------------
 
 class SslSocketCertificateAsyncVerification:
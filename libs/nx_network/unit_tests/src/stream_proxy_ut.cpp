@@ -1,5 +1,7 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <nx/network/connection_server/simple_message_server.h>
@@ -68,6 +70,7 @@ protected:
         destinationContext.server = std::make_unique<server::SimpleMessageServer>();
         destinationContext.server->setRequest(m_clientMessage);
         destinationContext.server->setResponse(m_serverMessage);
+        destinationContext.server->setKeepConnection(m_keepDestinationConnection);
         ASSERT_TRUE(destinationContext.server->bind(SocketAddress::anyPrivateAddressV4));
         ASSERT_TRUE(destinationContext.server->listen());
         m_destinationServers.push_back(std::move(destinationContext));
@@ -88,6 +91,12 @@ protected:
         givenListeningPingPongServer();
     }
 
+    void givenProxyToServerKeepingConnection()
+    {
+        m_keepDestinationConnection = true;
+        givenListeningPingPongServer();
+    }
+
     void givenProxyWithBrokenAcceptor()
     {
         m_proxy.addProxy(
@@ -179,6 +188,30 @@ protected:
         ASSERT_NE(SystemError::noError, m_prevResponse->osResultCode);
     }
 
+    void thenConnectionStatisticsContainProxiedBytes()
+    {
+        const auto& destination = m_destinationServers[m_expectedDestinationIndex];
+
+        // The counters are updated after the data is sent. So, the pong may be received earlier.
+        for (;;)
+        {
+            const auto statistics = m_proxy.connectionStatistics(destination.proxyId);
+            ASSERT_EQ(1U, statistics.size());
+            ASSERT_EQ(destination.server->address(), statistics.front().destination);
+
+            if (statistics.front().upStreamBytes == m_clientMessage.size() &&
+                statistics.front().downStreamBytes == m_serverMessage.size())
+            {
+#if defined(__linux__) && !defined(__ANDROID__)
+                ASSERT_TRUE(statistics.front().zeroCopy);
+#endif
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
     void assertAcceptIsRetriedAfterFailure()
     {
         for (int i = 0; i < 2; ++i)
@@ -204,6 +237,7 @@ private:
     nx::utils::SyncQueue<RequestResult> m_requestResults;
     std::optional<RequestResult> m_prevResponse;
     int m_expectedDestinationIndex = -1;
+    bool m_keepDestinationConnection = false;
     nx::utils::SyncQueue<int> m_acceptRequestQueue;
     nx::Buffer m_readBuffer;
 
@@ -226,6 +260,14 @@ TEST_F(StreamProxyPool, data_is_delivered_to_the_target_server)
     thenPongIsReceived();
 }
 
+TEST_F(StreamProxyPool, connection_statistics_are_reported)
+{
+    givenProxyToServerKeepingConnection();
+    whenSendPingViaProxy();
+    thenPongIsReceived();
+    thenConnectionStatisticsContainProxiedBytes();
+}
+
 TEST_F(StreamProxyPool, change_proxy_destination)
 {
     givenWorkingProxy();
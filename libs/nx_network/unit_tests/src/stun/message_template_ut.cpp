@@ -0,0 +1,44 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/stun/message_parser.h>
+#include <nx/network/stun/message_serializer.h>
+#include <nx/network/stun/message_template.h>
+
+namespace nx::network::stun::test {
+
+TEST(StunMessageTemplate, serialized_as_message_with_transaction_id)
+{
+    Message response(Header(MessageClass::successResponse, MethodType::bindingMethod));
+    response.newAttribute<attrs::XorMappedAddress>(12345, 0x7f000001);
+    response.newAttribute<attrs::Unknown>(attrs::userDefined, nx::Buffer("keep-alive"));
+    const MessageTemplate messageTemplate(response);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        response.header.transactionId = Header::makeTransactionId();
+
+        nx::Buffer serialized("prefix");
+        messageTemplate.serialize(response.header.transactionId, &serialized);
+        ASSERT_EQ("prefix" + MessageSerializer().serialized(response), serialized);
+    }
+}
+
+TEST(StunMessageTemplate, fingerprint_is_valid)
+{
+    const MessageTemplate messageTemplate(
+        Message(Header(MessageClass::successResponse, MethodType::bindingMethod)));
+    const auto transactionId = Header::makeTransactionId();
+    const auto serialized = messageTemplate.serialized(transactionId);
+
+    Message parsed;
+    MessageParser parser;
+    parser.setFingerprintRequired(true);
+    parser.setMessage(&parsed);
+    std::size_t bytesProcessed = 0;
+    ASSERT_EQ(server::ParserState::done, parser.parse(serialized, &bytesProcessed));
+    ASSERT_EQ(transactionId, parsed.header.transactionId);
+}
+
+} // namespace nx::network::stun::test
@@ -0,0 +1,120 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/stun/message_serializer.h>
+#include <nx/network/stun/message_view.h>
+
+namespace nx::network::stun::test {
+
+class StunMessageView: public ::testing::Test
+{
+protected:
+    static nx::Buffer serialize(const Message& message)
+    {
+        return MessageSerializer().serialized(message);
+    }
+
+    static Message requestWithIntegrity()
+    {
+        Message message(Header(MessageClass::request, MethodType::bindingMethod));
+        message.newAttribute<attrs::Unknown>(attrs::userDefined, nx::Buffer("value"));
+        message.insertIntegrity(kUserName, kKey);
+        return message;
+    }
+
+    static constexpr char kUserName[] = "user";
+    static constexpr char kKey[] = "key";
+};
+
+TEST_F(StunMessageView, header_and_attributes_reference_source_buffer)
+{
+    Message message(Header(MessageClass::errorResponse, MethodType::userMethod + 5));
+    message.newAttribute<attrs::Unknown>(attrs::userDefined, nx::Buffer("abcde"));
+    message.newAttribute<attrs::Unknown>(attrs::userDefined + 1, nx::Buffer("fgh"));
+
+    // The data following the message is not a part of it.
+    const auto serialized = serialize(message) + nx::Buffer("tail");
+    const auto view = MessageView::parse(serialized);
+    ASSERT_TRUE(view);
+
+    ASSERT_EQ(MessageClass::errorResponse, view->messageClass());
+    ASSERT_EQ(MethodType::userMethod + 5, view->method());
+    ASSERT_EQ(message.header.transactionId, view->transactionId());
+    ASSERT_EQ(serialized.size() - 4, view->serialized().size());
+
+    const auto value = view->attribute(attrs::userDefined);
+    ASSERT_TRUE(value);
+    ASSERT_EQ("abcde", *value);
+    ASSERT_GE(value->data(), serialized.data());
+    ASSERT_LT(value->data(), serialized.data() + serialized.size());
+    ASSERT_FALSE(view->attribute(attrs::userName));
+
+    std::vector<int> types;
+    view->forEachAttribute(
+        [&types](const MessageView::Attribute& attribute) { types.push_back(attribute.type); });
+    ASSERT_EQ((std::vector<int>{attrs::userDefined, attrs::userDefined + 1, attrs::fingerPrint}),
+        types);
+    ASSERT_TRUE(view->verifyFingerprint());
+}
+
+TEST_F(StunMessageView, malformed_message_is_rejected)
+{
+    Message message(Header(MessageClass::request, MethodType::bindingMethod));
+    message.newAttribute<attrs::Unknown>(attrs::userDefined, nx::Buffer("abcde"));
+    const auto serialized = serialize(message);
+
+    ASSERT_FALSE(MessageView::parse(std::string_view(serialized).substr(0, 19)));
+    ASSERT_FALSE(MessageView::parse(std::string_view(serialized).substr(0, serialized.size() - 1)));
+
+    auto badAttributeLength = serialized;
+    badAttributeLength[23] = 100; //< The first attribute value size.
+    ASSERT_FALSE(MessageView::parse(badAttributeLength));
+
+    auto badCookie = serialized;
+    ++badCookie[4];
+    ASSERT_FALSE(MessageView::parse(badCookie));
+}
+
+TEST_F(StunMessageView, integrity_is_verified_in_place)
+{
+    const auto serialized = serialize(requestWithIntegrity());
+    const auto view = MessageView::parse(serialized);
+    ASSERT_TRUE(view);
+
+    ASSERT_TRUE(view->verifyIntegrity(kUserName, kKey));
+    ASSERT_FALSE(view->verifyIntegrity(kUserName, "wrong key"));
+    ASSERT_FALSE(view->verifyIntegrity("wrong user", kKey));
+
+    auto corrupted = serialized;
+    ++corrupted[24]; //< The first attribute value.
+    ASSERT_FALSE(MessageView::parse(corrupted)->verifyIntegrity(kUserName, kKey));
+    ASSERT_FALSE(MessageView::parse(corrupted)->verifyFingerprint());
+}
+
+TEST_F(StunMessageView, integrity_verification_matches_message)
+{
+    Message message(Header(MessageClass::request, MethodType::bindingMethod));
+    message.newAttribute<attrs::UserName>(kUserName);
+    message.newAttribute<attrs::MessageIntegrity>();
+    const auto serialized = serialize(message);
+    const auto view = MessageView::parse(serialized);
+    ASSERT_TRUE(view);
+
+    for (const bool legacyMode: {false, true})
+    {
+        auto withIntegrity = message;
+        withIntegrity.newAttribute<attrs::MessageIntegrity>(
+            calcMessageIntegrity(message, kKey, {.legacyMode = legacyMode}));
+        const auto serializedWithIntegrity = serialize(withIntegrity);
+
+        ASSERT_EQ(
+            withIntegrity.verifyIntegrity(kUserName, kKey, {.legacyMode = legacyMode}),
+            MessageView::parse(serializedWithIntegrity)->verifyIntegrity(
+                kUserName, kKey, {.legacyMode = legacyMode}));
+        ASSERT_TRUE(MessageView::parse(serializedWithIntegrity)->verifyIntegrity(
+            kUserName, kKey, {.legacyMode = legacyMode}));
+    }
+}
+
+} // namespace nx::network::stun::test
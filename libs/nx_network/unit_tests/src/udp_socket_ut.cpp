@@ -1,5 +1,7 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <nx/network/aio/aio_service.h>
@@ -9,6 +11,7 @@
 #include <nx/network/socket_global.h>
 #include <nx/utils/uuid.h>
 #include <nx/utils/log/log.h>
+#include <nx/utils/random.h>
 #include <nx/utils/scope_guard.h>
 #include <nx/utils/std/cpp14.h>
 #include <nx/utils/std/future.h>
@@ -272,6 +275,101 @@ TEST_F(UdpSocket, resolve_error_is_reported_in_aio_thread)
 
 //-------------------------------------------------------------------------------------------------
 
+class UdpSocketBatch:
+    public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        ASSERT_TRUE(m_receiver.bind(SocketAddress(HostAddress::localhost, 0)));
+        ASSERT_TRUE(m_receiver.setNonBlockingMode(true));
+        ASSERT_TRUE(m_sender.bind(SocketAddress(HostAddress::localhost, 0)));
+    }
+
+    void whenSendDatagramsInBatch(std::size_t count)
+    {
+        std::vector<Datagram> datagrams(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            datagrams[i].address = m_receiver.getLocalAddress();
+            datagrams[i].data = nx::utils::random::generate<nx::Buffer>(100 + (int) i);
+            m_sentData.push_back(datagrams[i].data);
+        }
+
+        ASSERT_EQ((int) count, m_sender.sendMultipleTo(datagrams));
+    }
+
+    void whenSendSegmentedDatagram(std::size_t segmentCount, std::size_t segmentSize)
+    {
+        Datagram datagram;
+        datagram.address = m_receiver.getLocalAddress();
+        datagram.data = nx::utils::random::generate<nx::Buffer>((int) (segmentCount * segmentSize));
+        datagram.segmentSize = segmentSize;
+
+        for (std::size_t i = 0; i < segmentCount; ++i)
+            m_sentData.push_back(datagram.data.substr(i * segmentSize, segmentSize));
+
+        ASSERT_EQ(1, m_sender.sendMultipleTo({datagram}));
+    }
+
+    void thenSameDatagramsAreReceivedInBatch()
+    {
+        std::vector<Datagram> batch(m_sentData.size() + 1);
+        std::vector<nx::Buffer> receivedData;
+        while (receivedData.size() < m_sentData.size())
+        {
+            for (auto& datagram: batch)
+                datagram.data.reserve(4 * 1024);
+
+            const int count = m_receiver.recvMultipleFrom(&batch);
+            ASSERT_GE(count, 0);
+            for (int i = 0; i < count; ++i)
+            {
+                ASSERT_FALSE(batch[i].truncated);
+                ASSERT_EQ(m_sender.getLocalAddress(), batch[i].address);
+                receivedData.push_back(batch[i].data);
+            }
+
+            if (count == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        ASSERT_EQ(m_sentData, receivedData);
+    }
+
+    void thenNothingIsReceived()
+    {
+        std::vector<Datagram> batch(4);
+        ASSERT_EQ(0, m_receiver.recvMultipleFrom(&batch));
+        ASSERT_EQ(SystemError::wouldBlock, SystemError::getLastOSErrorCode());
+    }
+
+private:
+    UDPSocket m_receiver;
+    UDPSocket m_sender;
+    std::vector<nx::Buffer> m_sentData;
+};
+
+TEST_F(UdpSocketBatch, datagrams_are_delivered)
+{
+    whenSendDatagramsInBatch(10);
+    thenSameDatagramsAreReceivedInBatch();
+    thenNothingIsReceived();
+}
+
+TEST_F(UdpSocketBatch, receiving_does_not_block_without_data)
+{
+    thenNothingIsReceived();
+}
+
+TEST_F(UdpSocketBatch, segmented_datagram_is_delivered_as_separate_datagrams)
+{
+    whenSendSegmentedDatagram(3, 1000);
+    thenSameDatagramsAreReceivedInBatch();
+}
+
+//-------------------------------------------------------------------------------------------------
+
 TEST_F(UdpSocket, DISABLED_multipleSocketsOnTheSamePort)
 {
     constexpr int socketCount = 2;
@@ -2,6 +2,7 @@
 
 #include <cstring>
 #include <random>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -46,3 +47,65 @@ TEST(Websockets, DeflateCompressDecompressWithContext)
         test(size);
     }
 }
+
+TEST(Websockets, DeflateContextIsTakenOverBetweenMessages)
+{
+    const nx::Buffer kMessage(
+        R"({"jsonrpc":"2.0","method":"update","params":{"id":"6f1dbd5a","status":"Online"}})");
+
+    Serializer serializer(true);
+    std::vector<nx::Buffer> receivedMessages;
+    Parser parser(Role::server,
+        [&](FrameType /*type*/, const nx::Buffer& buffer, bool /*fin*/)
+        {
+            receivedMessages.push_back(buffer);
+        });
+
+    std::vector<std::size_t> frameSizes;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto frame = serializer.prepareMessage(
+            kMessage, FrameType::text, CompressionType::perMessageDeflate);
+        frameSizes.push_back(frame.size());
+        parser.consume(frame);
+    }
+
+    ASSERT_EQ(3U, receivedMessages.size());
+    for (const auto& message: receivedMessages)
+        ASSERT_EQ(kMessage, message);
+
+    // The repeated messages refer to the first one.
+    ASSERT_LT(frameSizes[1] * 4, frameSizes[0]);
+    ASSERT_LT(frameSizes[2] * 4, frameSizes[0]);
+}
+
+TEST(Websockets, SharedMessageIsInflatedAmongContextTakeoverMessages)
+{
+    const nx::Buffer kMessage(
+        R"({"jsonrpc":"2.0","method":"update","params":{"id":"6f1dbd5a","status":"Online"}})");
+    const nx::Buffer kSharedMessage(
+        R"({"jsonrpc":"2.0","method":"update","params":{"id":"0b3c29e1","status":"Offline"}})");
+
+    Serializer serializer(false);
+    std::vector<nx::Buffer> receivedMessages;
+    Parser parser(Role::client,
+        [&](FrameType /*type*/, const nx::Buffer& buffer, bool /*fin*/)
+        {
+            receivedMessages.push_back(buffer);
+        });
+
+    const auto shared = SharedMessage::create(kSharedMessage, FrameType::text);
+    ASSERT_FALSE(shared->compressedFrame.empty());
+
+    parser.consume(
+        serializer.prepareMessage(kMessage, FrameType::text, CompressionType::perMessageDeflate));
+    parser.consume(shared->compressedFrame);
+    serializer.resetCompression();
+    parser.consume(
+        serializer.prepareMessage(kMessage, FrameType::text, CompressionType::perMessageDeflate));
+    parser.consume(shared->frame);
+
+    ASSERT_EQ(
+        std::vector<nx::Buffer>({kMessage, kSharedMessage, kMessage, kSharedMessage}),
+        receivedMessages);
+}
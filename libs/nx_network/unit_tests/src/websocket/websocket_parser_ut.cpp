@@ -107,6 +107,25 @@ protected:
         m_frameTypes.clear();
     }
 
+    void testConsumingBufferChain(
+        int sliceSize, int frameCount, FrameType type, bool masked, unsigned int mask)
+    {
+        const nx::SharedBuffer message(prepareMessage(
+            m_defaultPayload, frameCount, type, masked, mask, GetParam().compressionType));
+        const auto messageCopy = message.toBuffer();
+
+        nx::BufferChain chain;
+        for (std::size_t offset = 0; offset < message.size(); offset += sliceSize)
+            chain.append(message.subBuffer(offset, sliceSize));
+
+        m_parser.consume(chain);
+
+        ASSERT_EQ(m_defaultPayload, m_payload);
+        ASSERT_EQ(messageCopy, message.toBuffer()); //< Unmasking does not modify the source.
+
+        m_frameTypes.clear();
+    }
+
 private:
     Parser m_parser;
     std::vector<FrameType> m_frameTypes;
@@ -133,6 +152,13 @@ TEST_P(WebsocketParserTest, Mask)
     testWebsocketParserAndSerializer(256, 32, FrameType::binary, true, 0xd903);
 }
 
+TEST_P(WebsocketParserTest, BufferChain)
+{
+    testConsumingBufferChain(26, 1, FrameType::binary, false, 0);
+    testConsumingBufferChain(13, 33, FrameType::binary, true, 0xfa121a23);
+    testConsumingBufferChain(1, 7, FrameType::binary, true, 0xfa121423);
+}
+
 INSTANTIATE_TEST_SUITE_P(WebsocketParserSerializer_differentCompressionModes,
     WebsocketParserTest,
     ::testing::Values(
@@ -140,3 +166,23 @@ INSTANTIATE_TEST_SUITE_P(WebsocketParserSerializer_differentCompressionModes,
         ParserTestParams(CompressionType::perMessageDeflate, 20),
         ParserTestParams(CompressionType::none, 1000),
         ParserTestParams(CompressionType::perMessageDeflate, 1000)));
+
+TEST(WebsocketMask, word_wise_masking_is_the_same_as_byte_wise)
+{
+    const std::uint32_t mask = 0xfa121a23;
+    const auto payload = fillDummyPayload(100);
+
+    for (std::size_t size = 0; size < payload.size(); ++size)
+    {
+        for (std::size_t maskOffset = 0; maskOffset < 8; ++maskOffset)
+        {
+            nx::Buffer expected(payload.data(), size);
+            for (std::size_t i = 0; i < expected.size(); ++i)
+                expected[i] ^= ((const unsigned char*) &mask)[(maskOffset + i) % 4];
+
+            nx::Buffer actual(payload.data(), size);
+            applyMask(actual.data(), actual.size(), mask, maskOffset);
+            ASSERT_EQ(expected, actual) << "size " << size << ", offset " << maskOffset;
+        }
+    }
+}
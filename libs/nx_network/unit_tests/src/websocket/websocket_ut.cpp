@@ -286,6 +286,7 @@ protected:
         clientWebSocket->bindToAioThread(serverWebSocket->getAioThread());
         clientWebSocket->setAliveTimeout(clientTimeout);
         serverWebSocket->setAliveTimeout(serverTimeout);
+        clientWebSocket->setSendCoalescingWindow(clientSendCoalescingWindow);
 
         if (noPongs)
         {
@@ -409,6 +410,28 @@ protected:
         readyFuture.wait();
     }
 
+    void whenClientSendsWithoutWaitingForCompletion(int messageCount)
+    {
+        nx::utils::promise<void> allSent;
+        std::atomic<int> sentCount = 0;
+
+        for (int i = 0; i < messageCount; ++i)
+        {
+            clientWebSocket->sendAsync(
+                &clientSendBuf,
+                [this, &allSent, &sentCount, messageCount](
+                    SystemError::ErrorCode error, size_t transferred)
+                {
+                    EXPECT_EQ(SystemError::noError, error);
+                    EXPECT_EQ(clientSendBuf.size(), transferred);
+                    if (++sentCount == messageCount)
+                        allSent.set_value();
+                });
+        }
+
+        allSent.get_future().wait();
+    }
+
     void whenServerStartsReading()
     {
         serverReadCb =
@@ -652,6 +675,7 @@ protected:
     std::promise<void> readyPromise;
     std::future<void> readyFuture;
     Role serverRole = Role::server;
+    std::chrono::milliseconds clientSendCoalescingWindow = std::chrono::milliseconds::zero();
 
     std::unique_ptr<TestWebSocket> clientWebSocket;
     std::unique_ptr<TestWebSocket> serverWebSocket;
@@ -1337,6 +1361,19 @@ TEST_P(WebSocket, imcomingMessagesQueueOverflow)
     thenAllMessagesShouldBeReceived(/*messageCount*/1100);
 }
 
+TEST_P(WebSocket, small_messages_are_coalesced)
+{
+    givenClientModes(SendMode::singleMessage, ReceiveMode::message);
+    givenServerModes(SendMode::singleMessage, ReceiveMode::message);
+    givenClientTestDataPrepared(100);
+    clientSendCoalescingWindow = std::chrono::milliseconds(10);
+    givenServerClientWebSockets();
+
+    whenClientSendsWithoutWaitingForCompletion(/*messageCount*/ 100);
+    whenServerStartsReading();
+    thenAllMessagesShouldBeReceived(/*messageCount*/ 100);
+}
+
 INSTANTIATE_TEST_SUITE_P(Websockets_PingPong_differentCompressionModes,
     WebSocket_PingPong,
     ::testing::Values(CompressionType::none, CompressionType::perMessageDeflate));
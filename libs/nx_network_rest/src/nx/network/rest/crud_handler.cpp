@@ -2,6 +2,7 @@
 
 #include "crud_handler.h"
 
+#include "nx_network_rest_ini.h"
 #include "open_api_schema.h"
 
 namespace nx::network::rest::detail {
@@ -161,6 +162,16 @@ nx::reflect::ArrayOrder orderFromParams(const Params& params)
     return order;
 }
 
+bool isStreamable(const Request& request, Qn::SerializationFormat format, size_t size)
+{
+    const int minSize = ini().minStreamedArraySize;
+    return minSize > 0
+        && size >= (size_t) minSize
+        && format == Qn::SerializationFormat::json
+        && !request.jsonRpcContext()
+        && !request.isExtraFormattingRequired();
+}
+
 void setResponseContent(Response* response,
     QJsonValue value,
     Qn::SerializationFormat format,
@@ -19,6 +19,8 @@
 
 #include "handler.h"
 #include "json.h"
+#include "json_array_body_source.h"
+#include "open_api_schema.h"
 
 namespace nx::network::rest {
 
@@ -56,6 +58,48 @@ NX_NETWORK_REST_API void setResponseContent(Response* response,
     const json::OpenApiSchemas* schemas,
     const Request& request);
 
+/**
+ * @return True if the array response of the given size is to be serialized element by element
+ *     while sending, see nx::network::rest::Ini::minStreamedArraySize.
+ */
+NX_NETWORK_REST_API bool isStreamable(
+    const Request& request, Qn::SerializationFormat format, size_t size);
+
+/**
+ * Sets the response body source that serializes the elements of the already filtered and ordered
+ * data one by one with the same _with filtering and schema postprocessing as json::serialize()
+ * and setResponseContent() apply to the whole array.
+ */
+template<typename Data>
+void setStreamedResponseContent(Response* response,
+    Data data,
+    Params filters,
+    json::DefaultValueAction defaultValueAction,
+    std::shared_ptr<json::OpenApiSchemas> schemas,
+    const Request& request)
+{
+    auto items = std::make_shared<Data>(std::move(data));
+    response->content = {
+        Qn::serializationFormatToHttpContentType(Qn::SerializationFormat::json), QByteArray{}};
+    response->isUndefinedContentLength = true;
+    response->bodySource = std::make_shared<JsonArrayBodySource>(
+        [items, it = items->cbegin(), with = json::details::extractWithParam(&filters),
+            stripDefault = defaultValueAction == json::DefaultValueAction::removeEqual,
+            schemas = std::move(schemas), method = request.method(),
+            path = request.decodedPath()]() mutable -> std::optional<nx::Buffer>
+        {
+            if (it == items->cend())
+                return std::nullopt;
+
+            auto item = nx::json::serialized(*it, stripDefault);
+            ++it;
+            json::details::filter(&item, with);
+            if (NX_ASSERT(schemas))
+                schemas->postprocessResponseItem(method, path, &item);
+            return nx::Buffer(json::serialized(item, Qn::SerializationFormat::json));
+        });
+}
+
 template<typename T>
 void filter(T* data, const Params& params)
 {
@@ -226,6 +270,16 @@ protected:
         {
             detail::filter(&data, filters);
             detail::orderBy(&data, filters);
+            if constexpr (nx::reflect::IsSequenceContainerV<std::decay_t<Data>>)
+            {
+                if (detail::isStreamable(request, format, data.size()))
+                {
+                    detail::setStreamedResponseContent<std::decay_t<Data>>(&response,
+                        std::forward<Data>(data), std::move(filters), defaultValueAction,
+                        m_schemas, request);
+                    return response;
+                }
+            }
             detail::setResponseContent(&response,
                 json::serialize(std::forward<Data>(data), std::move(filters), defaultValueAction),
                 format, m_schemas.get(), request);
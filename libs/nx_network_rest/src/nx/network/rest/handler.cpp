@@ -2,15 +2,58 @@
 
 #include "handler.h"
 
+#include <future>
+
 #include <nx/fusion/serialization/json.h>
 #include <nx/network/abstract_socket.h>
 #include <nx/utils/log/log.h>
 
 #include "audit.h"
 #include "open_api_schema.h"
+#include "response_cache.h"
 
 namespace nx::network::rest {
 
+namespace {
+
+void sendBody(http::AbstractMsgBodySource* source, AbstractStreamSocket* socket)
+{
+    for (;;)
+    {
+        std::promise<std::pair<SystemError::ErrorCode, nx::Buffer>> read;
+        source->readAsync(
+            [&read](SystemError::ErrorCode resultCode, nx::Buffer buffer)
+            {
+                read.set_value({resultCode, std::move(buffer)});
+            });
+
+        const auto [resultCode, buffer] = read.get_future().get();
+        if (resultCode != SystemError::noError)
+        {
+            NX_DEBUG(NX_SCOPE_TAG, "Failed to read response body: %1",
+                SystemError::toString(resultCode));
+            return;
+        }
+
+        if (buffer.empty())
+            return;
+
+        for (size_t offset = 0; offset < buffer.size();)
+        {
+            const int sent = socket->send(buffer.data() + offset, (int) (buffer.size() - offset));
+            if (sent <= 0)
+            {
+                NX_DEBUG(NX_SCOPE_TAG, "Failed to send response body: %1",
+                    SystemError::getLastOSErrorText());
+                return;
+            }
+            offset += (size_t) sent;
+        }
+    }
+}
+
+} // namespace
+
 void Handler::validateAndAmend(Request* request, http::HttpHeaders* headers)
 {
     if (NX_ASSERT(m_schemas) && request->method() != nx::network::http::Method::options)
@@ -120,6 +163,9 @@ Response Handler::executeRequestOrThrow(Request* request, http::HttpHeaders* hea
         throw Exception::internalServerError("Request is nullptr");
 
     validateAndAmend(request, headers);
+    if (m_responseCache && ResponseCache::isCacheable(*request))
+        return executeCachedGet(*request);
+
     Response response = executeAnyMethod(*request);
     if (response.content && response.content->type.value == http::header::ContentType::kJson.value
         && request->isExtraFormattingRequired())
@@ -129,12 +175,62 @@ Response Handler::executeRequestOrThrow(Request* request, http::HttpHeaders* hea
     return response;
 }
 
+Response Handler::executeCachedGet(const Request& request)
+{
+    auto key = ResponseCache::key(request);
+    auto entry = m_responseCache->find(key);
+    if (!entry)
+    {
+        const int generation = m_responseCache->generation();
+        Response response = executeAnyMethod(request);
+        if (response.content
+            && response.content->type.value == http::header::ContentType::kJson.value
+            && request.isExtraFormattingRequired())
+        {
+            response.content->body = nx::utils::formatJsonString(response.content->body);
+        }
+
+        if (!ResponseCache::isCacheable(response))
+            return response;
+
+        entry = m_responseCache->insert(std::move(key), response, generation);
+    }
+
+    if (ResponseCache::isNotModified(request, entry->etag))
+    {
+        Response response(http::StatusCode::notModified);
+        response.httpHeaders.emplace("ETag", entry->etag);
+        return response;
+    }
+
+    return entry->toResponse();
+}
+
+void Handler::enableResponseCache(int maxSize)
+{
+    auto cache = std::make_shared<ResponseCache>(maxSize);
+    auto guard = monitorChanges([cache]() { cache->invalidate(); });
+    if (!guard)
+    {
+        NX_DEBUG(this, "Response cache is not supported for %1", m_path);
+        return;
+    }
+
+    m_responseCacheMonitorGuard = std::move(guard);
+    m_responseCache = std::move(cache);
+}
+
 void Handler::afterExecute(
     const Request& /*request*/,
     const Response& response,
     std::unique_ptr<AbstractStreamSocket> socket)
 {
     NX_ASSERT(!response.isUndefinedContentLength || socket);
+    if (response.bodySource && socket)
+    {
+        sendBody(response.bodySource.get(), socket.get());
+        response.bodySource->pleaseStopSync();
+    }
 }
 
 Handler::GlobalPermission Handler::permissions(const Request& request) const
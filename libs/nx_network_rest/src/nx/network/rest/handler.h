@@ -16,6 +16,7 @@ namespace nx::network { class AbstractStreamSocket; }
 
 namespace nx::network::rest {
 
+class ResponseCache;
 namespace audit { class Manager; }
 namespace audit { struct Record; }
 namespace json { class OpenApiSchemas; }
@@ -51,6 +52,18 @@ protected:
     virtual Response executePut(const Request& request);
     virtual Response executePatch(const Request& request);
 
+    /**
+     * Customization point to enable the response cache. The handler is to be invoked on every
+     * change of the data the GET responses of this Handler are produced from, including the
+     * access rights of the users.
+     * @return Guard to stop the monitoring. Empty if the changes can not be monitored, so the
+     *     responses can not be cached.
+     */
+    virtual nx::utils::Guard monitorChanges(nx::utils::MoveOnlyFunc<void()> /*handler*/)
+    {
+        return {};
+    }
+
 public:
     using GlobalPermission = nx::utils::auth::GlobalPermission;
 
@@ -69,7 +82,8 @@ public:
 
     /**
      * Override to execute some logic after request processing. socket is not empty only if
-     * response.isUndefinedContentLength is true set by any execute... methods.
+     * response.isUndefinedContentLength is true set by any execute... methods. The default
+     * implementation sends response.bodySource to the socket, so the overrides call it first.
      */
     virtual void afterExecute(
         const Request& request,
@@ -84,6 +98,14 @@ public:
     void setSchemas(std::shared_ptr<json::OpenApiSchemas> schemas);
     void setAuditManager(audit::Manager* auditManager) { m_auditManager = auditManager; }
 
+    /**
+     * Enables caching of the serialized GET responses. Cached responses are served with ETag, and
+     * the requests with the matching If-None-Match receive 304 Not Modified.
+     * NOTE: Does nothing if the Handler does not implement monitorChanges.
+     */
+    void enableResponseCache(int maxSize);
+    const ResponseCache* responseCache() const { return m_responseCache.get(); }
+
     QString extractAction(const QString& path) const;
 
     /** In derived classes, report all url params carrying camera id. */
@@ -146,6 +168,13 @@ protected:
     //   schema file.
     std::shared_ptr<json::OpenApiSchemas> m_schemas;
     audit::Manager* m_auditManager = nullptr;
+
+private:
+    Response executeCachedGet(const Request& request);
+
+private:
+    std::shared_ptr<ResponseCache> m_responseCache;
+    nx::utils::Guard m_responseCacheMonitorGuard;
 };
 
 } // namespace nx::network::rest
@@ -5,6 +5,7 @@
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 
+#include <nx/reflect/binary.h>
 #include <nx/utils/json/qjson.h>
 #include <nx/utils/log/log_main.h>
 
@@ -725,6 +726,10 @@ QByteArray serialized(const rapidjson::Value& value, Qn::SerializationFormat for
             return QByteArray::fromStdString(
                 nx::reflect::json_detail::getStringRepresentation(value));
 
+        case Qn::SerializationFormat::compactBinary:
+            // Members are written by names, which are put to the string table once.
+            return QByteArray::fromStdString(nx::reflect::binary::serialize(value));
+
         case Qn::SerializationFormat::csv:
             return QnCsv::serialized(value);
 
@@ -0,0 +1,56 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "json_array_body_source.h"
+
+#include <nx/network/http/http_types.h>
+
+namespace nx::network::rest {
+
+JsonArrayBodySource::JsonArrayBodySource(NextItemFunc nextItem, size_t maxChunkSize):
+    m_nextItem(std::move(nextItem)),
+    m_maxChunkSize(maxChunkSize)
+{
+}
+
+std::string JsonArrayBodySource::mimeType() const
+{
+    return nx::network::http::header::ContentType::kJson.toString();
+}
+
+std::optional<uint64_t> JsonArrayBodySource::contentLength() const
+{
+    return std::nullopt;
+}
+
+void JsonArrayBodySource::readAsync(CompletionHandler completionHandler)
+{
+    nx::Buffer chunk;
+    if (m_eof)
+        return completionHandler(SystemError::noError, std::move(chunk));
+
+    if (!m_started)
+    {
+        chunk.append('[');
+        m_started = true;
+    }
+
+    while (chunk.size() < m_maxChunkSize)
+    {
+        auto item = m_nextItem();
+        if (!item)
+        {
+            chunk.append(']');
+            m_eof = true;
+            break;
+        }
+
+        if (m_hasItems)
+            chunk.append(',');
+        chunk.append(item->data(), item->size());
+        m_hasItems = true;
+    }
+
+    completionHandler(SystemError::noError, std::move(chunk));
+}
+
+} // namespace nx::network::rest
@@ -0,0 +1,48 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <optional>
+
+#include <nx/network/http/abstract_msg_body_source.h>
+#include <nx/utils/move_only_func.h>
+
+namespace nx::network::rest {
+
+/**
+ * Message body source that provides a JSON array serializing its elements on demand, so a large
+ * collection is never serialized into a single buffer. Each read result contains as many
+ * elements as fit into maxChunkSize, but at least one, so the memory used for the serialized data
+ * is bounded by maxChunkSize plus the size of the largest element.
+ * The body has no Content-Length.
+ */
+class NX_NETWORK_REST_API JsonArrayBodySource:
+    public nx::network::http::AbstractMsgBodySource
+{
+public:
+    /**
+     * @return Serialized next element of the array or std::nullopt if there are no more elements.
+     */
+    using NextItemFunc = nx::utils::MoveOnlyFunc<std::optional<nx::Buffer>()>;
+
+    static constexpr size_t kDefaultMaxChunkSize = 64 * 1024;
+
+    JsonArrayBodySource(NextItemFunc nextItem, size_t maxChunkSize = kDefaultMaxChunkSize);
+
+    virtual std::string mimeType() const override;
+    virtual std::optional<uint64_t> contentLength() const override;
+
+    /**
+     * NOTE: The completion handler is invoked directly in this call.
+     */
+    virtual void readAsync(CompletionHandler completionHandler) override;
+
+private:
+    NextItemFunc m_nextItem;
+    const size_t m_maxChunkSize;
+    bool m_started = false;
+    bool m_hasItems = false;
+    bool m_eof = false;
+};
+
+} // namespace nx::network::rest
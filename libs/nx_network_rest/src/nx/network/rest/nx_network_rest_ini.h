@@ -29,6 +29,10 @@ struct Ini: nx::kit::IniConfig
     NX_INI_INT(5, waitForTranslationLocaleS,
         "Wait for translation locale installation on API call. Zero means do not wait.");
 
+    NX_INI_INT(1000, minStreamedArraySize,
+        "Minimal number of elements in a JSON array response of CrudHandler to serialize it\n"
+        "element by element while sending instead of into a single buffer. Zero disables.");
+
     NX_INI_FLAG(true, auditOnlyParameterNames,
         "Audit parameter values along with names if false.");
 };
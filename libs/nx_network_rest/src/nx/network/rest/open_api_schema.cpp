@@ -755,6 +755,19 @@ void removeUnused(const std::vector<QString>& unused, QJsonValue* from)
         removePathFromValue(path, from);
 }
 
+QJsonObject arrayItemsSchema(const QJsonObject& schema)
+{
+    if (const auto type = optString(schema, "type"); !type.isEmpty())
+        return type == "array" ? optObject(schema, "items") : QJsonObject{};
+
+    for (const auto item: optArray(schema, "oneOf"))
+    {
+        if (auto items = arrayItemsSchema(asObject(item)); !items.isEmpty())
+            return items;
+    }
+    return {};
+}
+
 } // anonymous namespace
 
 void OpenApiSchema::postprocessResponse(
@@ -791,6 +804,21 @@ void OpenApiSchema::postprocessResponse(
     PostprocessorV4{}(response, getObject(getObject(content, "application/json"), "schema"));
 }
 
+void OpenApiSchema::postprocessResponseItem(
+    const QJsonObject& path, const QJsonObject& method, rapidjson::Value* item) const
+{
+    if (path.isEmpty() || method.isEmpty())
+        return;
+
+    const auto content =
+        optObject(optObject(optObject(method, "responses"), "default"), "content");
+    if (content.isEmpty())
+        return;
+
+    PostprocessorV4{}(item,
+        arrayItemsSchema(getObject(getObject(content, "application/json"), "schema")));
+}
+
 void OpenApiSchema::validateOrThrow(const QJsonObject& path,
     const QJsonObject& method,
     Request* request,
@@ -1198,6 +1226,19 @@ void OpenApiSchemas::postprocessResponse(
         schema->postprocessResponse(path, method_, response);
 }
 
+void OpenApiSchemas::postprocessResponseItem(
+    const nx::network::http::Method& method,
+    const QString& decodedPath,
+    rapidjson::Value* item) const
+{
+    if (!NX_ASSERT(!decodedPath.isEmpty()))
+        return;
+
+    auto [schema, path, method_] = findSchema(decodedPath, method);
+    if (schema)
+        schema->postprocessResponseItem(path, method_, item);
+}
+
 std::tuple<std::shared_ptr<OpenApiSchema>, QJsonObject, QJsonObject> OpenApiSchemas::findSchema(
     const QString& requestPath, const nx::network::http::Method& method_, bool throwIfNotFound) const
 {
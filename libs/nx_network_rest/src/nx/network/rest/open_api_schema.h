@@ -29,6 +29,10 @@ public:
     void postprocessResponse(
         const QJsonObject& path, const QJsonObject& method, rapidjson::Value* response) const;
 
+    /** Postprocesses an element of the array response serialized separately. */
+    void postprocessResponseItem(
+        const QJsonObject& path, const QJsonObject& method, rapidjson::Value* item) const;
+
     void validateOrThrow(const QJsonObject& path,
         const QJsonObject& method,
         Request* request,
@@ -74,6 +78,11 @@ public:
         const QString& decodedPath,
         rapidjson::Value* response) const;
 
+    void postprocessResponseItem(
+        const nx::network::http::Method& method,
+        const QString& decodedPath,
+        rapidjson::Value* item) const;
+
 private:
     std::tuple<std::shared_ptr<OpenApiSchema>, QJsonObject, QJsonObject> findSchema(
         const QString& requestPath,
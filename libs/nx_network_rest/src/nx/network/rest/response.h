@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <memory>
+
+#include <nx/network/http/abstract_msg_body_source.h>
+
 #include "params.h"
 #include "result.h"
 
@@ -15,6 +19,12 @@ struct NX_NETWORK_REST_API Response
     nx::network::http::HttpHeaders httpHeaders;
     std::variant<std::nullptr_t, rapidjson::Document, QJsonValue> contentBodyJson;
 
+    /**
+     * Provides the body instead of content->body if set, so it is not kept in memory as a whole.
+     * Requires isUndefinedContentLength, the body is sent by Handler::afterExecute.
+     */
+    std::shared_ptr<nx::network::http::AbstractMsgBodySource> bodySource;
+
     Response(
         nx::network::http::StatusCode::Value statusCode = nx::network::http::StatusCode::undefined,
         nx::network::http::HttpHeaders httpHeaders = {});
@@ -0,0 +1,120 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "response_cache.h"
+
+#include <QtCore/QCryptographicHash>
+
+#include <nx/utils/log/log.h>
+#include <nx/utils/std_string_utils.h>
+
+namespace nx::network::rest {
+
+Response ResponseCache::Entry::toResponse() const
+{
+    Response response(statusCode, httpHeaders);
+    response.content = content;
+    response.httpHeaders.emplace("ETag", etag);
+    return response;
+}
+
+ResponseCache::ResponseCache(int maxSize):
+    m_entries(maxSize)
+{
+}
+
+bool ResponseCache::isCacheable(const Request& request)
+{
+    // JSON-RPC responses are not serialized by the handler.
+    return request.method() == nx::network::http::Method::get && !request.jsonRpcContext();
+}
+
+bool ResponseCache::isCacheable(const Response& response)
+{
+    return response.statusCode == nx::network::http::StatusCode::ok
+        && response.content
+        && !response.isUndefinedContentLength
+        && !response.httpHeaders.contains("Set-Cookie");
+}
+
+std::string ResponseCache::key(const Request& request)
+{
+    const auto header =
+        [&request](const char* name)
+        {
+            return nx::network::http::getHeaderValue(request.httpHeaders(), name);
+        };
+
+    // Params are ordered by the name, so the same query always produces the same key.
+    return nx::format("%1?%2 %3 %4 %5 %6").args(
+        request.decodedPath(),
+        request.params().toString(),
+        request.userSession.access.userId,
+        (int) request.userSession.access.access,
+        header("Accept"),
+        header("Accept-Language")).toStdString();
+}
+
+std::string ResponseCache::etag(const QByteArray& body)
+{
+    return '"' + QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex().toStdString()
+        + '"';
+}
+
+bool ResponseCache::isNotModified(const Request& request, const std::string& etag)
+{
+    const auto ifNoneMatch =
+        nx::network::http::getHeaderValue(request.httpHeaders(), "If-None-Match");
+    if (ifNoneMatch.empty())
+        return false;
+
+    auto splitter = nx::utils::makeSplitter(ifNoneMatch, ',');
+    while (splitter.next())
+    {
+        auto tag = nx::utils::trim(splitter.token());
+        // Weak comparison is used for If-None-Match [rfc7232, 3.2].
+        if (tag.starts_with("W/"))
+            tag.remove_prefix(2);
+        if (tag == "*" || tag == etag)
+            return true;
+    }
+    return false;
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::find(const std::string& key)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (auto entry = m_entries.getValue(key))
+        return entry->get();
+    return nullptr;
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::insert(
+    std::string key, const Response& response, int generation)
+{
+    auto entry = std::make_shared<Entry>();
+    entry->statusCode = response.statusCode;
+    entry->httpHeaders = response.httpHeaders;
+    entry->content = *response.content;
+    entry->etag = etag(entry->content.body);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (generation != m_generation)
+        NX_VERBOSE(this, "Not caching %1: invalidated while being produced", key);
+    else
+        m_entries.put(std::move(key), entry);
+    return entry;
+}
+
+int ResponseCache::generation() const
+{
+    return m_generation;
+}
+
+void ResponseCache::invalidate()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    ++m_generation;
+    m_entries.clear();
+}
+
+} // namespace nx::network::rest
@@ -0,0 +1,81 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <nx/utils/data_structures/lru_cache.h>
+#include <nx/utils/thread/mutex.h>
+
+#include "request.h"
+#include "response.h"
+
+namespace nx::network::rest {
+
+/**
+ * Serialized successful GET responses of a single Handler. The entries are keyed by the path, the
+ * query parameters, the user access and the content negotiation headers. All of them are dropped
+ * by invalidate() when the data provided by the Handler changes.
+ * Every entry has a strong ETag computed from its body, so the clients polling with
+ * If-None-Match receive 304 Not Modified until the data changes.
+ */
+class NX_NETWORK_REST_API ResponseCache
+{
+public:
+    static constexpr int kDefaultMaxSize = 256;
+
+    struct Entry
+    {
+        nx::network::http::StatusCode::Value statusCode = nx::network::http::StatusCode::ok;
+        nx::network::http::HttpHeaders httpHeaders;
+        Content content;
+        std::string etag;
+
+        Response toResponse() const;
+    };
+
+    ResponseCache(int maxSize = kDefaultMaxSize);
+
+    /**
+     * @return Whether the response to the request can be taken from the cache.
+     */
+    static bool isCacheable(const Request& request);
+
+    /**
+     * @return Whether the response can be put to the cache.
+     */
+    static bool isCacheable(const Response& response);
+
+    static std::string key(const Request& request);
+
+    /**
+     * @return Quoted hash of the body.
+     */
+    static std::string etag(const QByteArray& body);
+
+    /**
+     * @return Whether the ETag matches the If-None-Match header of the request.
+     */
+    static bool isNotModified(const Request& request, const std::string& etag);
+
+    std::shared_ptr<const Entry> find(const std::string& key);
+
+    /**
+     * @param generation The value of generation() before the response was produced. The response
+     *     is not cached if the cache has been invalidated since then, because the response may
+     *     have been produced from the outdated data.
+     */
+    std::shared_ptr<const Entry> insert(std::string key, const Response& response, int generation);
+
+    int generation() const;
+    void invalidate();
+
+private:
+    nx::Mutex m_mutex;
+    nx::utils::LruCache<std::string, std::shared_ptr<const Entry>> m_entries;
+    std::atomic<int> m_generation = 0;
+};
+
+} // namespace nx::network::rest
@@ -2,7 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <nx/kit/ini_config.h>
 #include <nx/network/rest/crud_handler.h>
+#include <nx/network/rest/nx_network_rest_ini.h>
 #include <nx/network/rest/open_api_schema.h>
 #include <nx/vms/api/data/analytics_data.h>
 #include <nx/vms/api/data/bookmark_models.h>
@@ -232,6 +234,49 @@ TEST_P(CrudHandlerTest, ObjectTrackGet)
 ])json");
 }
 
+TEST_P(CrudHandlerTest, ObjectTrackGetStreamed)
+{
+    if (GetParam() == *kRestApiV3)
+        return;
+
+    AnalyticsObjectTracksHandler handler;
+    handler.setSchemas(std::make_shared<json::OpenApiSchemas>(json::OpenApiSchemas{{
+        json::OpenApiSchema::load(":/openapi_v4.json")}}));
+    http::Request httpRequest;
+    httpRequest.requestLine.method = http::Method::get;
+    const auto execute =
+        [&]()
+        {
+            Request request{&httpRequest, std::optional<Content>{}};
+            request.setDecodedPath("/rest/v4/analytics/objectTracks");
+            request.setApiVersion(4);
+            return handler.executeRequestOrThrow(&request);
+        };
+
+    const auto expected = execute();
+    ASSERT_FALSE(expected.bodySource);
+
+    nx::kit::IniConfig::Tweaks iniTweaks;
+    iniTweaks.set(&ini().minStreamedArraySize, 1);
+    const auto streamed = execute();
+    ASSERT_TRUE(streamed.isUndefinedContentLength);
+    ASSERT_TRUE(streamed.bodySource);
+    ASSERT_TRUE(streamed.content->body.isEmpty());
+
+    QByteArray body;
+    for (bool eof = false; !eof;)
+    {
+        streamed.bodySource->readAsync(
+            [&](SystemError::ErrorCode resultCode, nx::Buffer buffer)
+            {
+                ASSERT_EQ(SystemError::noError, resultCode);
+                eof = buffer.empty();
+                body += buffer.toByteArray();
+            });
+    }
+    ASSERT_EQ(expected.content->body, body);
+}
+
 INSTANTIATE_TEST_SUITE_P(Rest, CrudHandlerTest, ::testing::ValuesIn(kRestApiV3, kRestApiEnd),
     [](auto info) { return std::string(info.param); });
 
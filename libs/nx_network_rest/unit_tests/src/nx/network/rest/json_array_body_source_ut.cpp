@@ -0,0 +1,72 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/rest/json_array_body_source.h>
+
+namespace nx::network::rest::test {
+
+class JsonArrayBodySourceTest: public ::testing::Test
+{
+protected:
+    std::unique_ptr<JsonArrayBodySource> createSource(
+        std::vector<std::string> items, size_t maxChunkSize)
+    {
+        return std::make_unique<JsonArrayBodySource>(
+            [items = std::move(items), i = size_t(0)]() mutable -> std::optional<nx::Buffer>
+            {
+                if (i == items.size())
+                    return std::nullopt;
+                return nx::Buffer(items[i++]);
+            },
+            maxChunkSize);
+    }
+
+    std::vector<std::string> readAll(JsonArrayBodySource* source)
+    {
+        std::vector<std::string> chunks;
+        for (bool eof = false; !eof;)
+        {
+            source->readAsync(
+                [&](SystemError::ErrorCode resultCode, nx::Buffer buffer)
+                {
+                    EXPECT_EQ(SystemError::noError, resultCode);
+                    eof = buffer.empty();
+                    if (!eof)
+                        chunks.push_back(buffer.takeStdString());
+                });
+        }
+        return chunks;
+    }
+};
+
+TEST_F(JsonArrayBodySourceTest, empty_array)
+{
+    auto source = createSource({}, JsonArrayBodySource::kDefaultMaxChunkSize);
+    ASSERT_FALSE(source->contentLength());
+    ASSERT_EQ(std::vector<std::string>{"[]"}, readAll(source.get()));
+    source->pleaseStopSync();
+}
+
+TEST_F(JsonArrayBodySourceTest, elements_are_split_into_bounded_chunks)
+{
+    auto source = createSource({"1", "22", "333", "4444"}, /*maxChunkSize*/ 4);
+    ASSERT_EQ(
+        (std::vector<std::string>{"[1,22", ",333", ",4444", "]"}), readAll(source.get()));
+    source->pleaseStopSync();
+}
+
+TEST_F(JsonArrayBodySourceTest, all_elements_fit_into_single_chunk)
+{
+    auto source = createSource(
+        {R"({"id":1})", R"({"id":2})"}, JsonArrayBodySource::kDefaultMaxChunkSize);
+    ASSERT_EQ(std::vector<std::string>{R"([{"id":1},{"id":2}])"}, readAll(source.get()));
+    source->pleaseStopSync();
+}
+
+} // namespace nx::network::rest::test
@@ -0,0 +1,115 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/network/rest/handler.h>
+#include <nx/network/rest/response_cache.h>
+
+namespace nx::network::rest::test {
+
+class CachedHandler: public Handler
+{
+public:
+    int executeCount = 0;
+    QByteArray body = "[1]";
+    nx::utils::MoveOnlyFunc<void()> notifyChange;
+
+protected:
+    virtual void validateAndAmend(Request*, http::HttpHeaders*) override {}
+
+    virtual Response executeGet(const Request&) override
+    {
+        ++executeCount;
+        Response response(http::StatusCode::ok);
+        response.content = {http::header::ContentType::kJson, body};
+        return response;
+    }
+
+    virtual nx::utils::Guard monitorChanges(nx::utils::MoveOnlyFunc<void()> handler) override
+    {
+        notifyChange = std::move(handler);
+        return nx::utils::Guard([this]() { notifyChange = nullptr; });
+    }
+};
+
+class RestResponseCache: public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_handler.enableResponseCache(ResponseCache::kDefaultMaxSize);
+        ASSERT_NE(nullptr, m_handler.responseCache());
+    }
+
+    Response get(const std::string& path, const std::string& etag = {})
+    {
+        http::Request httpRequest;
+        httpRequest.requestLine.method = http::Method::get;
+        httpRequest.requestLine.url = nx::utils::Url(QString::fromStdString(path));
+        httpRequest.requestLine.version = http::http_1_1;
+        if (!etag.empty())
+            httpRequest.headers.emplace("If-None-Match", etag);
+
+        Request request(&httpRequest, kSystemSession);
+        return m_handler.executeRequestOrThrow(&request);
+    }
+
+    static std::string etag(const Response& response)
+    {
+        return http::getHeaderValue(response.httpHeaders, "ETag");
+    }
+
+    CachedHandler m_handler;
+};
+
+TEST_F(RestResponseCache, response_is_served_from_cache_until_invalidated)
+{
+    const auto first = get("/rest/v4/data?a=1");
+    ASSERT_EQ(http::StatusCode::ok, first.statusCode);
+    ASSERT_FALSE(etag(first).empty());
+
+    const auto second = get("/rest/v4/data?a=1");
+    ASSERT_EQ(1, m_handler.executeCount);
+    ASSERT_EQ(first.content->body, second.content->body);
+    ASSERT_EQ(etag(first), etag(second));
+
+    get("/rest/v4/data?a=2");
+    ASSERT_EQ(2, m_handler.executeCount);
+
+    m_handler.body = "[2]";
+    m_handler.notifyChange();
+    const auto third = get("/rest/v4/data?a=1");
+    ASSERT_EQ(3, m_handler.executeCount);
+    ASSERT_EQ("[2]", third.content->body);
+    ASSERT_NE(etag(first), etag(third));
+}
+
+TEST_F(RestResponseCache, not_modified_is_reported_for_matching_etag)
+{
+    const auto tag = etag(get("/rest/v4/data"));
+
+    const auto notModified = get("/rest/v4/data", "\"other\", " + tag);
+    ASSERT_EQ(http::StatusCode::notModified, notModified.statusCode);
+    ASSERT_FALSE(notModified.content);
+    ASSERT_EQ(tag, etag(notModified));
+
+    ASSERT_EQ(http::StatusCode::notModified, get("/rest/v4/data", "W/" + tag).statusCode);
+    ASSERT_EQ(http::StatusCode::ok, get("/rest/v4/data", "\"other\"").statusCode);
+}
+
+TEST_F(RestResponseCache, response_produced_before_invalidation_is_not_cached)
+{
+    auto* cache = const_cast<ResponseCache*>(m_handler.responseCache());
+    const int generation = cache->generation();
+    Response response(http::StatusCode::ok);
+    response.content = {http::header::ContentType::kJson, "[1]"};
+
+    cache->invalidate();
+    cache->insert("key", response, generation);
+    ASSERT_EQ(nullptr, cache->find("key"));
+
+    cache->insert("key", response, cache->generation());
+    ASSERT_NE(nullptr, cache->find("key"));
+}
+
+} // namespace nx::network::rest::test
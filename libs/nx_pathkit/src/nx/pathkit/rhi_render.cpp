@@ -75,34 +75,38 @@ static constexpr float kTolerance = 0.25f;
 static constexpr int kMaxCachedGradientTextures = 50;
 static constexpr int kGradientTextureSize = 1024; //< Qt uses this size for gradients internally.
 
+// Limit the search of the batch to append an entry to, so the batching cost stays linear.
+static constexpr int kMaxBatchLookback = 64;
+static constexpr size_t kMaxBatchEntryBounds = 256;
+
 static const QRhiShaderResourceBinding::StageFlags kCommonVisibility =
     QRhiShaderResourceBinding::VertexStage
     | QRhiShaderResourceBinding::FragmentStage;
 
+/** @return Number of the added vertices, each one is 3 floats: x, y, alpha. */
 int pathToTriangles(
     const SkPath& path,
-    QColor color,
-    const nx::pathkit::PaintPath& pp,
-    VertexAllocator& triangles,
-    VertexAllocator& colors,
-    QSize clip)
+    bool aa,
+    const SkRect& clipBounds,
+    VertexAllocator& triangles)
 {
     const auto prevSize = triangles.size();
-    const SkRect clipBounds = SkRect::MakeXYWH(0, 0, clip.width(), clip.height());
     bool isLinear;
-    if (pp.aa)
+    if (aa)
         GrAATriangulator::PathToAATriangles(path, kTolerance, clipBounds, &triangles);
     else
         GrTriangulator::PathToTriangles(path, kTolerance, clipBounds, &triangles, &isLinear);
 
-    // Each triangle vertex is 3 floats: x, y, alpha.
-    const auto numVerts = (triangles.size() - prevSize) / 3;
+    return (triangles.size() - prevSize) / 3;
+}
 
+void addVertexColors(size_t numVerts, QColor color, qreal opacity, VertexAllocator& colors)
+{
     const float colorF[4] = {
         color.redF(),
         color.greenF(),
         color.blueF(),
-        (float) pp.opacity * color.alphaF()};
+        (float) opacity * color.alphaF()};
 
     float* pColor = (float*) colors.lock(sizeof(float), numVerts * 4);
 
@@ -114,8 +118,18 @@ int pathToTriangles(
     }
 
     colors.unlock(numVerts * 4);
+}
 
-    return numVerts;
+SkRect boundsOfTextureVerts(const std::vector<float>& textureVerts, size_t offset)
+{
+    // Each vertex is 5 floats: x, y, tx, ty, opacity.
+    SkRect bounds = SkRect::MakeEmpty();
+    for (size_t i = offset; i + 5 <= textureVerts.size(); i += 5)
+    {
+        bounds.join(SkRect::MakeLTRB(
+            textureVerts[i], textureVerts[i + 1], textureVerts[i], textureVerts[i + 1]));
+    }
+    return bounds.makeOutset(1, 1);
 }
 
 SkPaint::Cap getSkCap(Qt::PenCapStyle style)
@@ -250,6 +264,29 @@ void fillGradientBrushVerts(
 
 static constexpr auto kMatrix4x4Size = 4 * 4 * sizeof(float);
 
+bool RhiPaintDeviceRenderer::Batch::intersects(const SkRect& rect) const
+{
+    if (!SkRect::Intersects(bounds, rect))
+        return false;
+
+    if (entryBounds.empty())
+        return true; //< Too many entries, only the union of their bounds is known.
+
+    return std::any_of(entryBounds.begin(), entryBounds.end(),
+        [&rect](const SkRect& entryRect) { return SkRect::Intersects(entryRect, rect); });
+}
+
+void RhiPaintDeviceRenderer::Batch::addBounds(const SkRect& rect)
+{
+    const bool tracked = !entryBounds.empty() || bounds.isEmpty();
+    bounds.join(rect);
+
+    if (tracked && entryBounds.size() < kMaxBatchEntryBounds)
+        entryBounds.push_back(rect);
+    else
+        entryBounds.clear();
+}
+
 RhiPaintDeviceRenderer::RhiPaintDeviceRenderer(QRhi* rhi, Settings settings):
     m_rhi(rhi),
     m_settings(settings)
@@ -257,6 +294,7 @@ RhiPaintDeviceRenderer::RhiPaintDeviceRenderer(QRhi* rhi, Settings settings):
     m_textureSizeMax = m_rhi->resourceLimit(QRhi::TextureSizeMax);
     if (m_settings.cacheSize == 0)
         m_settings.cacheSize = m_textureSizeMax;
+    m_pathCache.setMaxCost(m_settings.pathCacheSize);
 }
 
 RhiPaintDeviceRenderer::~RhiPaintDeviceRenderer() {}
@@ -483,6 +521,9 @@ bool RhiPaintDeviceRenderer::prepare(QRhiRenderPassDescriptor* rp, QRhiResourceU
 
     u->updateDynamicBuffer(ubuf.get(), 0, kMatrix4x4Size, modelView().constData());
 
+    currentStats.uploadedBytes +=
+        (vertexData.size() + colors.size() + textureData.size()) * sizeof(float);
+
     return true;
 }
 
@@ -494,6 +535,81 @@ QMatrix4x4 RhiPaintDeviceRenderer::modelView() const
     return viewProjection;
 }
 
+int RhiPaintDeviceRenderer::addPathTriangles(
+    const SkPath& path,
+    QColor color,
+    const PaintPath& paintPath,
+    VertexAllocator& triangles,
+    VertexAllocator& colors,
+    QSize clip)
+{
+    const SkRect clipBounds = SkRect::MakeXYWH(0, 0, clip.width(), clip.height());
+
+    // The triangles of the inverse fills depend on the clip bounds.
+    if (m_settings.pathCacheSize <= 0 || path.isInverseFillType() || path.isEmpty())
+    {
+        const int numVerts = pathToTriangles(path, paintPath.aa, clipBounds, triangles);
+        addVertexColors(numVerts, color, paintPath.opacity, colors);
+        return numVerts;
+    }
+
+    // Integer offsets keep the triangulation exactly the same.
+    const SkRect bounds = path.getBounds();
+    const float dx = std::floor(bounds.left());
+    const float dy = std::floor(bounds.top());
+
+    SkPath normalized(pathAllocator.get());
+    path.offset(-dx, -dy, &normalized);
+
+    m_pathData.resize(normalized.writeToMemory(nullptr));
+    normalized.writeToMemory(m_pathData.data());
+
+    const PathKey key{
+        .hash = qHashBits(m_pathData.data(), m_pathData.size()),
+        .verbCount = normalized.countVerbs(),
+        .pointCount = normalized.countPoints(),
+        .aa = paintPath.aa};
+
+    const PathTriangles* cached = m_pathCache.object(key);
+    PathTriangles computed;
+    if (cached)
+    {
+        ++currentStats.pathCacheHits;
+    }
+    else
+    {
+        ++currentStats.pathCacheMisses;
+
+        VertexAllocator vertices;
+        const int numVerts = pathToTriangles(
+            normalized, paintPath.aa, clipBounds.makeOffset(-dx, -dy), vertices);
+        const auto data = static_cast<const float*>(vertices.data());
+        computed.vertices.assign(data, data + numVerts * 3);
+        cached = &computed;
+    }
+
+    const int numVerts = (int) cached->vertices.size() / 3;
+    float* target = (float*) triangles.lock(3 * sizeof(float), numVerts);
+    const float* source = cached->vertices.data();
+    for (int i = 0; i < numVerts; ++i, source += 3, target += 3)
+    {
+        target[0] = source[0] + dx;
+        target[1] = source[1] + dy;
+        target[2] = source[2];
+    }
+    triangles.unlock(numVerts);
+
+    if (cached == &computed)
+    {
+        const qsizetype cost = std::max<qsizetype>(1, computed.vertices.size());
+        if (cost <= m_pathCache.maxCost())
+            m_pathCache.insert(key, new PathTriangles(std::move(computed)), cost);
+    }
+
+    addVertexColors(numVerts, color, paintPath.opacity, colors);
+    return numVerts;
+}
+
 QRectF RhiPaintDeviceRenderer::textureCoordsFromAtlas(const Atlas::Rect& rect, int padding) const
 {
     if (padding == 1)
@@ -581,6 +697,8 @@ std::shared_ptr<QRhiTexture> RhiPaintDeviceRenderer::textureForGradient(
     texture->create();
     rub->uploadTexture(texture.get(), image);
     m_gradientCache.insert(gradient, new TextureEntry(texture));
+    ++currentStats.textureUploads;
+    currentStats.uploadedBytes += image.sizeInBytes();
     return texture;
 }
 
@@ -618,6 +736,8 @@ QRhiShaderResourceBindings* RhiPaintDeviceRenderer::getTextureBindings(
         texture.reset(m_rhi->newTexture(textureFormat, image.size(), 1));
         texture->create();
         rub->uploadTexture(texture.get(), image);
+        ++currentStats.textureUploads;
+        currentStats.uploadedBytes += image.sizeInBytes();
         const auto size = texture->pixelSize();
         m_textureCache.insert(key, new TextureEntry(texture), size.width() * size.height());
     }
@@ -747,6 +867,8 @@ void RhiPaintDeviceRenderer::prepareAtlas(const RhiPaintEngineSyncData::Entries&
             QRhiTextureUploadEntry entry(0, 0, subresDesc);
 
             atlasUpdates.push_back(entry);
+            ++currentStats.textureUploads;
+            currentStats.uploadedBytes += image.sizeInBytes();
         }
     }
 }
@@ -866,9 +988,42 @@ std::vector<RhiPaintDeviceRenderer::Batch> RhiPaintDeviceRenderer::processEntrie
 
     textures.clear();
     atlasUpdates.clear();
+    currentStats = {};
 
     prepareAtlas(entries);
 
+    // Appends the vertices to the last batch using the same vertex buffer, so they stay
+    // contiguous, if it has the same bindings and the batches drawn after it do not overlap the
+    // vertices. So the overlays consisting of the same kinds of primitives (e.g. frames, labels
+    // and icons of the analytics objects) are drawn with a draw call per kind.
+    const auto addToBatch =
+        [&batches](Batch batch, const SkRect& bounds)
+        {
+            const int lastIndex = (int) batches.size() - 1;
+            for (int i = lastIndex; i >= 0 && i > lastIndex - kMaxBatchLookback; --i)
+            {
+                Batch& candidate = batches[i];
+                if (candidate.render)
+                    break; //< Custom rendering may draw anywhere.
+
+                if (candidate.vertexInput == batch.vertexInput)
+                {
+                    if (candidate.bindigs != batch.bindigs)
+                        break;
+
+                    candidate.count += batch.count;
+                    candidate.addBounds(bounds);
+                    return;
+                }
+
+                if (candidate.intersects(bounds))
+                    break;
+            }
+
+            batch.addBounds(bounds);
+            batches.push_back(std::move(batch));
+        };
+
     for (const auto& entry: entries.all())
     {
         if (auto paintPath = std::get_if<PaintPath>(&entry))
@@ -879,24 +1034,23 @@ std::vector<RhiPaintDeviceRenderer::Batch> RhiPaintDeviceRenderer::processEntrie
                     int offset = triangles.size();
                     int colorsOffset = colors.size();
 
-                    if (pathToTriangles(path, color, *paintPath, triangles, colors, clip) == 0)
+                    const int count =
+                        addPathTriangles(path, color, *paintPath, triangles, colors, clip);
+                    if (count == 0)
                         return;
 
-                    if (!batches.empty() && batches.back().colorInput)
-                    {
-                        batches.back().count += ((int) triangles.size() - offset) / 3;
-                        return;
-                    }
-
-                    batches.push_back({
-                        .offset = offset,
-                        .colorsOffset = colorsOffset,
-                        .count = ((int) triangles.size() - offset) / 3,
-                        .bindigs = csrb.get(),
-                        .pipeline = cps.get(),
-                        .vertexInput = vbuf.get(),
-                        .colorInput = cbuf.get(),
-                    });
+                    // Antialiasing adds a fringe around the path.
+                    addToBatch(
+                        {
+                            .offset = offset,
+                            .colorsOffset = colorsOffset,
+                            .count = count,
+                            .bindigs = csrb.get(),
+                            .pipeline = cps.get(),
+                            .vertexInput = vbuf.get(),
+                            .colorInput = cbuf.get(),
+                        },
+                        path.getBounds().makeOutset(1, 1));
                 };
 
             const auto addGradientPath =
@@ -917,20 +1071,15 @@ std::vector<RhiPaintDeviceRenderer::Batch> RhiPaintDeviceRenderer::processEntrie
                         paintPath->brush,
                         textureVerts);
 
-                    if (!batches.empty() && batches.back().bindigs == bindings)
-                    {
-                        batches.back().count += (textureVerts.size() - offset) / 5;
-                    }
-                    else
-                    {
-                        batches.push_back({
+                    addToBatch(
+                        {
                             .offset = (int) offset,
                             .count = (int) (textureVerts.size() - offset) / 5,
                             .bindigs = bindings,
                             .pipeline = tps.get(),
                             .vertexInput = tvbuf.get(),
-                        });
-                    }
+                        },
+                        boundsOfTextureVerts(textureVerts, offset));
                 };
 
             if (paintPath->brush.style() != Qt::NoBrush)
@@ -982,20 +1131,15 @@ std::vector<RhiPaintDeviceRenderer::Batch> RhiPaintDeviceRenderer::processEntrie
 
             fillTextureVerts(*paintPixmap, src, clip, textureVerts);
 
-            if (!batches.empty() && batches.back().bindigs == bindings)
-            {
-                batches.back().count += (textureVerts.size() - offset) / 5;
-            }
-            else
-            {
-                batches.push_back({
+            addToBatch(
+                {
                     .offset = (int) offset,
                     .count = (int) (textureVerts.size() - offset) / 5,
                     .bindigs = bindings,
                     .pipeline = tps.get(),
                     .vertexInput = tvbuf.get(),
-                });
-            }
+                },
+                boundsOfTextureVerts(textureVerts, offset));
         }
         else if (auto paintTexture = std::get_if<PaintTexture>(&entry))
         {
@@ -1038,13 +1182,15 @@ std::vector<RhiPaintDeviceRenderer::Batch> RhiPaintDeviceRenderer::processEntrie
             for (int i: {0, 1, 3, 3, 1, 2})
                 emitVertex(i);
 
-            batches.push_back({
-                .offset = (int) offset,
-                .count = (int) (textureVerts.size() - offset) / 5,
-                .bindigs = bindings,
-                .pipeline = tps.get(),
-                .vertexInput = tvbuf.get(),
-            });
+            addToBatch(
+                {
+                    .offset = (int) offset,
+                    .count = (int) (textureVerts.size() - offset) / 5,
+                    .bindigs = bindings,
+                    .pipeline = tps.get(),
+                    .vertexInput = tvbuf.get(),
+                },
+                boundsOfTextureVerts(textureVerts, offset));
         }
         else if (auto customPaint = std::get_if<PaintCustom>(&entry))
         {
@@ -1063,29 +1209,45 @@ std::vector<RhiPaintDeviceRenderer::Batch> RhiPaintDeviceRenderer::processEntrie
 
     pathAllocator->clear();
 
-    currentStats = {
-        .entries = (size_t) entries.all().size(),
-        .batches = batches.size(),
-        .texturesInCache = (size_t) m_textureCache.size(),
-        .texturesInAtlas = (size_t) atlasCache.size(),
-    };
+    currentStats.entries = (size_t) entries.all().size();
+    currentStats.batches = batches.size();
+    currentStats.texturesInCache = (size_t) m_textureCache.size();
+    currentStats.texturesInAtlas = (size_t) atlasCache.size();
+    currentStats.pathsInCache = (size_t) m_pathCache.size();
 
     return batches;
 }
 
 void RhiPaintDeviceRenderer::render(QRhiCommandBuffer* cb)
 {
+    QRhiGraphicsPipeline* currentPipeline = nullptr;
+    QRhiShaderResourceBindings* currentBindings = nullptr;
+
     for (const auto& batch: batches)
     {
         if (batch.render)
         {
             batch.render(m_rhi, cb, m_size);
+
+            // The custom rendering may change any state.
+            currentPipeline = nullptr;
+            currentBindings = nullptr;
             continue;
         }
 
-        cb->setGraphicsPipeline(batch.pipeline);
-        cb->setViewport(QRhiViewport(0, 0, m_size.width(), m_size.height()));
-        cb->setShaderResources(batch.bindigs);
+        if (batch.pipeline != currentPipeline)
+        {
+            cb->setGraphicsPipeline(batch.pipeline);
+            cb->setViewport(QRhiViewport(0, 0, m_size.width(), m_size.height()));
+            currentPipeline = batch.pipeline;
+            currentBindings = nullptr; //< Must be set again for the new pipeline.
+        }
+
+        if (batch.bindigs != currentBindings)
+        {
+            cb->setShaderResources(batch.bindigs);
+            currentBindings = batch.bindigs;
+        }
 
         if (batch.colorInput)
         {
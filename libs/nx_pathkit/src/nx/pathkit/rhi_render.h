@@ -87,6 +87,14 @@ public:
         QRhiBuffer* colorInput = nullptr;
 
         std::function<void(QRhi*, QRhiCommandBuffer*, QSize)> render;
+
+        // Device areas covered by the batch entries. Allow to append the later entries to the
+        // batch if the batches drawn after it do not overlap them.
+        SkRect bounds = SkRect::MakeEmpty();
+        std::vector<SkRect> entryBounds; //< Not filled if there are too many entries.
+
+        bool intersects(const SkRect& rect) const;
+        void addBounds(const SkRect& rect);
     };
 
     struct TextureEntry
@@ -101,13 +109,15 @@ public:
         int cacheSize = 0; //< Use max texture size.
         int atlasSize = 1024;
         int maxAtlasEntrySize = 128;
+        int pathCacheSize = 4 * 1024 * 1024; //< Floats of the cached path triangles.
     };
 
     static constexpr Settings kDefaultSettinigs =
     {
         .cacheSize = 0,
         .atlasSize = 1024,
-        .maxAtlasEntrySize = 128
+        .maxAtlasEntrySize = 128,
+        .pathCacheSize = 4 * 1024 * 1024
     };
 
     struct Stats
@@ -116,6 +126,13 @@ public:
         size_t batches = 0;
         size_t texturesInCache = 0;
         size_t texturesInAtlas = 0;
+        size_t pathsInCache = 0;
+
+        // Per-frame counters.
+        size_t pathCacheHits = 0; //< Paths which are not triangulated again.
+        size_t pathCacheMisses = 0;
+        size_t textureUploads = 0; //< Including the atlas updates.
+        size_t uploadedBytes = 0; //< Textures and vertex buffers.
     };
 
 public:
@@ -157,6 +174,20 @@ private:
         QRhiResourceUpdateBatch* rub,
         const QGradient& gradient);
 
+    /**
+     * Triangulates the path or takes its triangles from the cache. The paths are cached relative
+     * to their integer position, so the same shapes and texts drawn at another place, e.g. the
+     * labels of the analytics objects, are triangulated once.
+     * @return Number of the added vertices.
+     */
+    int addPathTriangles(
+        const SkPath& path,
+        QColor color,
+        const PaintPath& paintPath,
+        VertexAllocator& triangles,
+        VertexAllocator& colors,
+        QSize clip);
+
     QRectF textureCoordsFromAtlas(const Atlas::Rect& rect, int padding) const;
 
     void prepareAtlas(const RhiPaintEngineSyncData::Entries& entries);
@@ -206,6 +237,29 @@ private:
     QCache<qint64, TextureEntry> m_textureCache;
     QCache<GradientWrapper, TextureEntry> m_gradientCache;
 
+    struct PathKey
+    {
+        size_t hash = 0;
+        int verbCount = 0;
+        int pointCount = 0;
+        bool aa = false;
+
+        bool operator==(const PathKey&) const = default;
+
+        friend size_t qHash(const PathKey& key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.hash, key.verbCount, key.pointCount, key.aa);
+        }
+    };
+
+    struct PathTriangles
+    {
+        std::vector<float> vertices; //< x, y, alpha relative to the integer path position.
+    };
+
+    QCache<PathKey, PathTriangles> m_pathCache;
+    std::vector<char> m_pathData;
+
     std::vector<Batch> batches;
     Stats currentStats;
 };
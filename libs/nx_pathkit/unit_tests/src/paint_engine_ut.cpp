@@ -43,7 +43,8 @@ public:
     {
     }
 
-    void checkResult(QSize size, float pixelRatio, const QString& name, TestFunc testFunc);
+    RhiPaintDeviceRenderer::Stats checkResult(
+        QSize size, float pixelRatio, const QString& name, TestFunc testFunc);
 
 public:
     std::unique_ptr<QRhi> rhi;
@@ -87,7 +88,7 @@ QImage imageDiff(const QImage& img1, const QImage& img2, int& accError)
 
 } // namespace
 
-void PaintEngineTest::checkResult(
+RhiPaintDeviceRenderer::Stats PaintEngineTest::checkResult(
     QSize size, float pixelRatio, const QString& name, TestFunc testFunc)
 {
     QImage referenceImage(size.width(), size.height(), QImage::Format_RGBA8888_Premultiplied);
@@ -129,14 +130,19 @@ void PaintEngineTest::checkResult(
     std::cerr << "entries: " << stats.entries
         << " -> batches: " << stats.batches
         << " textures cache: " << stats.texturesInCache
-        << " atlas: " << stats.texturesInAtlas << "\n";
+        << " atlas: " << stats.texturesInAtlas
+        << " path cache hits: " << stats.pathCacheHits
+        << " misses: " << stats.pathCacheMisses
+        << " texture uploads: " << stats.textureUploads
+        << " uploaded bytes: " << stats.uploadedBytes << "\n";
 
     if (rhi->backend() != QRhi::Null)
     {
         EXPECT_LE(errPercent, 0.5); //< This is more of a sanity check.
     }
 
-    ASSERT_EQ(referenceImage.size(), rhiImage.size());
+    EXPECT_EQ(referenceImage.size(), rhiImage.size());
+    return stats;
 }
 
 TEST_F(PaintEngineTest, linearGradient)
@@ -380,6 +386,47 @@ TEST_F(PaintEngineTest, pathWithHoleOnTop)
         });
 }
 
+TEST_F(PaintEngineTest, repeatedOverlays)
+{
+    QImage iconImage(16, 16, QImage::Format_RGBA8888_Premultiplied);
+    iconImage.fill(Qt::green);
+    const QPixmap icon = QPixmap::fromImage(iconImage);
+
+    const auto stats = checkResult({600, 400}, 1, test_info_->name(),
+        [&icon](QPaintDevice* pd)
+        {
+            QPainter p(pd);
+            p.setRenderHint(QPainter::Antialiasing);
+
+            auto f = p.font();
+            f.setPixelSize(12);
+            p.setFont(f);
+
+            // Labels of the analytics objects: a frame, an icon and a text.
+            for (int row = 0; row < 6; ++row)
+            {
+                for (int column = 0; column < 6; ++column)
+                {
+                    p.save();
+                    p.translate(column * 100, row * 60);
+                    p.setPen(QPen(Qt::red, 2));
+                    p.setBrush(Qt::NoBrush);
+                    p.drawRect(5, 5, 90, 50);
+                    p.drawPixmap(10, 10, icon);
+                    p.setPen(Qt::black);
+                    p.drawText(30, 40, "Person");
+                    p.restore();
+                }
+            }
+        });
+
+    // The same shapes at other integer positions are not triangulated again.
+    EXPECT_GT(stats.pathCacheHits, stats.pathCacheMisses);
+
+    // Non-overlapping entries of the same kind are drawn together.
+    EXPECT_LE(stats.batches, 3u);
+}
+
 } // namespace test
 
 } // namespace namespace nx::pathkit
@@ -309,12 +309,20 @@ public:
     void visitField(const WrappedField& field)
     {
         writeAttribute(field.name(), field.get(m_data));
+        ++m_fieldIndex;
     }
 
 private:
     SerializationContext* m_ctx = nullptr;
     const Data& m_data;
     int m_attributes = 0;
+    std::size_t m_fieldIndex = 0;
+
+    /**
+     * A context can provide attribute names prepared once per type, e.g. already escaped.
+     */
+    static constexpr bool kHasFieldKeys =
+        requires(SerializationContext* ctx) { ctx->template writeFieldKey<Data>(std::size_t()); };
 
     template<typename Value>
     void writeAttribute(const char* name, const std::optional<Value>& value)
@@ -333,7 +341,10 @@ private:
         }
         else
         {
-            m_ctx->composer.writeAttributeName(name);
+            if constexpr (kHasFieldKeys)
+                m_ctx->template writeFieldKey<Data>(m_fieldIndex);
+            else
+                m_ctx->composer.writeAttributeName(name);
             BasicSerializer::serializeAdl(m_ctx, value);
             ++m_attributes;
         }
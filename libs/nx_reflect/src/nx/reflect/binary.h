@@ -0,0 +1,6 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include "binary/deserializer.h"
+#include "binary/serializer.h"
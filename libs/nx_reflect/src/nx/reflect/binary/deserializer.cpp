@@ -0,0 +1,175 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "deserializer.h"
+
+#include <cstring>
+
+namespace nx::reflect::binary::detail {
+
+namespace {
+
+/** Protects the stack from malformed data when skipping the values of unknown types. */
+constexpr int kMaxSkipDepth = 128;
+
+} // namespace
+
+Reader::Reader(const std::string_view& data):
+    m_data(data)
+{
+}
+
+bool Reader::readTag(Tag* tag)
+{
+    if (atEnd())
+        return false;
+    *tag = (Tag) m_data[m_position++];
+    return true;
+}
+
+bool Reader::readInt(std::int64_t* value)
+{
+    std::uint64_t encoded = 0;
+    if (!readVarint(&encoded))
+        return false;
+    *value = (std::int64_t) (encoded >> 1) ^ -(std::int64_t) (encoded & 1);
+    return true;
+}
+
+bool Reader::readFloat(double* value)
+{
+    if (m_data.size() - m_position < 8)
+        return false;
+
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i)
+        bits |= (std::uint64_t) (unsigned char) m_data[m_position++] << (i * 8);
+    std::memcpy(value, &bits, sizeof(bits));
+    return true;
+}
+
+bool Reader::readString(Tag tag, std::string_view* value)
+{
+    std::uint64_t number = 0;
+    if (!readVarint(&number))
+        return false;
+
+    if (tag == Tag::stringReference)
+    {
+        if (number >= m_strings.size())
+            return false;
+        *value = m_strings[number];
+        return true;
+    }
+
+    if (number > m_data.size() - m_position)
+        return false;
+    *value = m_data.substr(m_position, number);
+    m_position += number;
+
+    if (tag == Tag::indexedString)
+        m_strings.push_back(*value);
+    return true;
+}
+
+bool Reader::readKey(std::uint64_t* key)
+{
+    return readVarint(key);
+}
+
+bool Reader::readName(std::string_view* name)
+{
+    Tag tag = Tag::end;
+    return readTag(&tag) && isString(tag) && readString(tag, name);
+}
+
+bool Reader::skipValue(Tag tag, int depth)
+{
+    if (depth > kMaxSkipDepth)
+        return false;
+
+    switch (tag)
+    {
+        case Tag::null:
+        case Tag::falseValue:
+        case Tag::trueValue:
+            return true;
+
+        case Tag::integer:
+        {
+            std::int64_t value = 0;
+            return readInt(&value);
+        }
+
+        case Tag::floatingPoint:
+        {
+            double value = 0;
+            return readFloat(&value);
+        }
+
+        case Tag::string:
+        case Tag::indexedString:
+        case Tag::stringReference:
+        {
+            // Indexed strings are read to keep the string table complete.
+            std::string_view value;
+            return readString(tag, &value);
+        }
+
+        case Tag::array:
+            for (;;)
+            {
+                Tag itemTag = Tag::end;
+                if (!readTag(&itemTag))
+                    return false;
+                if (itemTag == Tag::end)
+                    return true;
+                if (!skipValue(itemTag, depth + 1))
+                    return false;
+            }
+
+        case Tag::object:
+            for (;;)
+            {
+                std::uint64_t key = 0;
+                if (!readKey(&key))
+                    return false;
+                if (key == 0)
+                    return true;
+
+                std::string_view name;
+                if (key % 2 == 0 && (key != kNamedKey || !readName(&name)))
+                    return false;
+
+                Tag valueTag = Tag::end;
+                if (!readTag(&valueTag) || !skipValue(valueTag, depth + 1))
+                    return false;
+            }
+
+        default:
+            return false;
+    }
+}
+
+DeserializationResult Reader::error(const std::string& description) const
+{
+    return DeserializationResult(
+        false, description, "Offset " + std::to_string(m_position));
+}
+
+bool Reader::readVarint(std::uint64_t* value)
+{
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (atEnd())
+            return false;
+
+        const auto byte = (unsigned char) m_data[m_position++];
+        *value |= (std::uint64_t) (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+} // namespace nx::reflect::binary::detail
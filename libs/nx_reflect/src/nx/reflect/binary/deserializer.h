@@ -0,0 +1,450 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <nx/reflect/generic_visitor.h>
+#include <nx/reflect/instrument.h>
+
+#include "../from_string.h"
+#include "../serialization_utils.h"
+#include "../type_utils.h"
+#include "wire_format.h"
+
+namespace nx::reflect::binary {
+
+namespace detail {
+
+/**
+ * Reads the primitives of the format. The strings are not copied: they, as well as the string
+ * table, refer to the input data.
+ */
+class NX_REFLECT_API Reader
+{
+public:
+    Reader(const std::string_view& data);
+
+    bool atEnd() const { return m_position == m_data.size(); }
+
+    bool readTag(Tag* tag);
+
+    /** Reads the payload of Tag::integer. */
+    bool readInt(std::int64_t* value);
+
+    /** Reads the payload of Tag::floatingPoint. */
+    bool readFloat(double* value);
+
+    /** Reads the payload of the string tags. */
+    bool readString(Tag tag, std::string_view* value);
+
+    /** Reads the key of an object member. The zero key ends the object. */
+    bool readKey(std::uint64_t* key);
+
+    /** Reads the member name following kNamedKey. */
+    bool readName(std::string_view* name);
+
+    /** Skips the payload of the value with the given tag, including the nested values. */
+    bool skipValue(Tag tag, int depth = 0);
+
+    DeserializationResult error(const std::string& description) const;
+
+    static bool isString(Tag tag)
+    {
+        return tag == Tag::string || tag == Tag::indexedString || tag == Tag::stringReference;
+    }
+
+private:
+    bool readVarint(std::uint64_t* value);
+
+private:
+    const std::string_view m_data;
+    std::size_t m_position = 0;
+    std::vector<std::string_view> m_strings;
+};
+
+/**
+ * Indexes of the fields of an instrumented type by their names. Built once per type.
+ */
+template<typename Data>
+class FieldIndexes
+{
+public:
+    static const std::unordered_map<std::string_view, std::size_t>& get()
+    {
+        static const std::unordered_map<std::string_view, std::size_t> indexes =
+            nx::reflect::visitAllFields<Data>(
+                [](const auto&... fields)
+                {
+                    std::unordered_map<std::string_view, std::size_t> result;
+                    std::size_t index = 0;
+                    (result.emplace(fields.name(), index++), ...);
+                    return result;
+                });
+        return indexes;
+    }
+};
+
+template<typename T>
+DeserializationResult readValue(Reader* reader, Tag tag, T* value);
+
+template<typename T>
+DeserializationResult readValue(Reader* reader, T* value)
+{
+    Tag tag = Tag::end;
+    if (!reader->readTag(&tag))
+        return reader->error("Unexpected end of data");
+    return readValue(reader, tag, value);
+}
+
+/**
+ * Reads the members of an object into the fields of an instrumented type in a single pass. The
+ * members are expected in the instrumentation order, as they are written by the serializer: a
+ * member which goes after a member of a later field is skipped.
+ */
+template<typename Data>
+class ObjectDeserializer: public nx::reflect::GenericVisitor<ObjectDeserializer<Data>>
+{
+public:
+    ObjectDeserializer(Reader* reader, Data* data):
+        m_reader(reader),
+        m_data(data)
+    {
+        readNextKey();
+    }
+
+    template<typename WrappedField>
+    void visitField(const WrappedField& field)
+    {
+        using FieldType = typename WrappedField::Type;
+
+        const std::size_t index = m_fieldIndex++;
+        while (m_result && m_nextFieldIndex < index)
+            skipNextValue();
+        if (!m_result)
+            return;
+
+        if (m_nextFieldIndex != index)
+        {
+            if constexpr (IsOptionalV<FieldType>)
+                field.set(m_data, std::nullopt);
+            return;
+        }
+
+        auto value = createDefault<FieldType>();
+        if (auto result = readValue(m_reader, &value); !result)
+        {
+            m_result = std::move(result);
+            if (!m_result.firstNonDeserializedField)
+                m_result.firstNonDeserializedField = field.name();
+            return;
+        }
+
+        field.set(m_data, std::move(value));
+        readNextKey();
+    }
+
+    DeserializationResult finish()
+    {
+        while (m_result && !m_endReached)
+            skipNextValue();
+        return std::move(m_result);
+    }
+
+private:
+    void readNextKey()
+    {
+        for (;;)
+        {
+            std::uint64_t key = 0;
+            if (!m_reader->readKey(&key))
+            {
+                m_result = m_reader->error("Failed to read the member key");
+                return;
+            }
+
+            if (key == 0)
+            {
+                m_endReached = true;
+                m_nextFieldIndex = std::numeric_limits<std::size_t>::max();
+                return;
+            }
+
+            if (key % 2 == 1)
+            {
+                m_nextFieldIndex = (std::size_t) (key / 2);
+                return;
+            }
+
+            std::string_view name;
+            if (key != kNamedKey || !m_reader->readName(&name))
+            {
+                m_result = m_reader->error("Invalid member key");
+                return;
+            }
+
+            const auto& indexes = FieldIndexes<Data>::get();
+            if (const auto it = indexes.find(name); it != indexes.end())
+            {
+                m_nextFieldIndex = it->second;
+                return;
+            }
+
+            // Unknown member.
+            Tag tag = Tag::end;
+            if (!m_reader->readTag(&tag) || !m_reader->skipValue(tag))
+            {
+                m_result = m_reader->error("Failed to skip an unknown member");
+                return;
+            }
+        }
+    }
+
+    void skipNextValue()
+    {
+        Tag tag = Tag::end;
+        if (!m_reader->readTag(&tag) || !m_reader->skipValue(tag))
+        {
+            m_result = m_reader->error("Failed to skip a member");
+            return;
+        }
+        readNextKey();
+    }
+
+private:
+    Reader* const m_reader;
+    Data* const m_data;
+    DeserializationResult m_result{true};
+    std::size_t m_fieldIndex = 0;
+    std::size_t m_nextFieldIndex = 0;
+    bool m_endReached = false;
+};
+
+template<typename T>
+DeserializationResult readValue(Reader* reader, Tag tag, T* value)
+{
+    if constexpr (IsOptionalV<T>)
+    {
+        if (tag == Tag::null)
+        {
+            value->reset();
+            return true;
+        }
+        if (!*value)
+            *value = createDefault<typename T::value_type>();
+        return readValue(reader, tag, &**value);
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        if (tag != Tag::trueValue && tag != Tag::falseValue)
+            return reader->error("Unexpected value type");
+        *value = tag == Tag::trueValue;
+        return true;
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        if (Reader::isString(tag)) //< 64-bit integers may come as strings from JSON documents.
+        {
+            std::string_view str;
+            if (!reader->readString(tag, &str) || !nx::reflect::fromString(str, value))
+                return reader->error("Invalid integer string");
+            return true;
+        }
+
+        std::int64_t number = 0;
+        if (tag != Tag::integer)
+            return reader->error("Unexpected value type");
+        if (!reader->readInt(&number))
+            return reader->error("Invalid integer");
+
+        if constexpr (sizeof(T) < sizeof(std::int64_t))
+        {
+            if (number < (std::int64_t) std::numeric_limits<T>::min()
+                || number > (std::int64_t) std::numeric_limits<T>::max())
+            {
+                return reader->error("Integer is out of range");
+            }
+        }
+        *value = (T) number;
+        return true;
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        if (tag == Tag::integer)
+        {
+            std::int64_t number = 0;
+            if (!reader->readInt(&number))
+                return reader->error("Invalid integer");
+            *value = (T) number;
+            return true;
+        }
+
+        double number = 0;
+        if (tag != Tag::floatingPoint)
+            return reader->error("Unexpected value type");
+        if (!reader->readFloat(&number))
+            return reader->error("Invalid floating point number");
+        *value = (T) number;
+        return true;
+    }
+    else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+    {
+        std::string_view str;
+        if (!Reader::isString(tag))
+            return reader->error("Unexpected value type");
+        if (!reader->readString(tag, &str))
+            return reader->error("Invalid string");
+        *value = T(str);
+        return true;
+    }
+    else if constexpr (IsStdChronoDurationV<T> || IsStdChronoTimePointV<T>)
+    {
+        using Duration = std::conditional_t<IsStdChronoDurationV<T>, T, std::chrono::milliseconds>;
+
+        std::int64_t number = 0;
+        if (tag != Tag::integer)
+            return reader->error("Unexpected value type");
+        if (!reader->readInt(&number))
+            return reader->error("Invalid integer");
+
+        if constexpr (IsStdChronoDurationV<T>)
+            *value = Duration(number);
+        else
+            *value = T(std::chrono::duration_cast<typename T::duration>(Duration(number)));
+        return true;
+    }
+    else if constexpr (IsStringAlikeV<T> || IsInstrumentedEnumV<T>)
+    {
+        std::string_view str;
+        if (!Reader::isString(tag))
+            return reader->error("Unexpected value type");
+        if (!reader->readString(tag, &str))
+            return reader->error("Invalid string");
+        if (!nx::reflect::fromString(str, value))
+            return reader->error("Failed to deserialize from string");
+        return true;
+    }
+    else if constexpr (IsArrayV<T>)
+    {
+        if (tag != Tag::array)
+            return reader->error("Unexpected value type");
+
+        for (std::size_t i = 0;; ++i)
+        {
+            Tag itemTag = Tag::end;
+            if (!reader->readTag(&itemTag))
+                return reader->error("Unexpected end of data");
+            if (itemTag == Tag::end)
+                return true;
+            if (i >= value->size())
+                return reader->error("Too many array items");
+            if (auto result = readValue(reader, itemTag, &(*value)[i]); !result)
+                return result;
+        }
+    }
+    else if constexpr (IsSequenceContainerV<T> || IsSetContainerV<T> || IsUnorderedSetContainerV<T>)
+    {
+        if (tag != Tag::array)
+            return reader->error("Unexpected value type");
+
+        value->clear();
+        for (;;)
+        {
+            Tag itemTag = Tag::end;
+            if (!reader->readTag(&itemTag))
+                return reader->error("Unexpected end of data");
+            if (itemTag == Tag::end)
+                return true;
+
+            auto item = createDefault<typename T::value_type>();
+            if (auto result = readValue(reader, itemTag, &item); !result)
+                return result;
+            std::inserter(*value, value->end()) = std::move(item);
+        }
+    }
+    else if constexpr (IsAssociativeContainerV<T> || IsUnorderedAssociativeContainerV<T>)
+    {
+        if (tag != Tag::object)
+            return reader->error("Unexpected value type");
+
+        value->clear();
+        for (;;)
+        {
+            std::uint64_t key = 0;
+            if (!reader->readKey(&key))
+                return reader->error("Failed to read the member key");
+            if (key == 0)
+                return true;
+
+            std::string_view name;
+            if (key != kNamedKey || !reader->readName(&name))
+                return reader->error("Invalid member key");
+
+            auto mapKey = createDefault<typename T::key_type>();
+            if constexpr (std::is_same_v<typename T::key_type, std::string>
+                || std::is_same_v<typename T::key_type, std::string_view>)
+            {
+                mapKey = typename T::key_type(name);
+            }
+            else if (!nx::reflect::fromString(name, &mapKey))
+                return reader->error("Failed to deserialize the map key");
+
+            auto mapValue = createDefault<typename T::mapped_type>();
+            if (auto result = readValue(reader, &mapValue); !result)
+                return result;
+            value->emplace(std::move(mapKey), std::move(mapValue));
+        }
+    }
+    else if constexpr (IsInstrumentedV<T>)
+    {
+        if (tag != Tag::object)
+            return reader->error("Unexpected value type");
+
+        ObjectDeserializer<T> visitor(reader, value);
+        return nx::reflect::visitAllFields<T>(visitor);
+    }
+    else
+    {
+        static_assert(std::is_same_v<T, void>, "Type is not deserializable");
+    }
+}
+
+} // namespace detail
+
+/**
+ * Deserializes the compact binary data into an object of supported type Data.
+ * NOTE: std::string_view fields refer to the input data.
+ * NOTE: All fields are considered optional. So, missing field is not an error.
+ */
+template<typename Data>
+DeserializationResult deserialize(const std::string_view& data, Data* value)
+{
+    detail::Reader reader(data);
+    auto result = detail::readValue(&reader, value);
+    if (result && !reader.atEnd())
+        return reader.error("Unexpected data after the value");
+    return result;
+}
+
+/**
+ * Deserializes the compact binary data into an object of supported type Data.
+ * This is a convenience overload. See the previous deserialize for details.
+ * @return std::tuple<deserialized value, result>
+ */
+template<typename Data>
+std::tuple<Data, DeserializationResult> deserialize(const std::string_view& data)
+{
+    Data value = createDefault<Data>();
+    auto result = deserialize(data, &value);
+    return {std::move(value), std::move(result)};
+}
+
+} // namespace nx::reflect::binary
@@ -0,0 +1,121 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "serializer.h"
+
+#include <cstring>
+#include <utility>
+
+namespace nx::reflect::binary::detail {
+
+BinaryComposer::BinaryComposer()
+{
+    setSerializeFlags(/*durationAsNumber*/ 1u << 0);
+}
+
+void BinaryComposer::startArray()
+{
+    writeTag(Tag::array);
+}
+
+void BinaryComposer::endArray(int /*items*/)
+{
+    writeTag(Tag::end);
+}
+
+void BinaryComposer::startObject()
+{
+    writeTag(Tag::object);
+}
+
+void BinaryComposer::endObject(int /*members*/)
+{
+    writeTag(Tag::end);
+}
+
+void BinaryComposer::writeBool(bool val)
+{
+    writeTag(val ? Tag::trueValue : Tag::falseValue);
+}
+
+void BinaryComposer::writeInt(const std::int64_t& val)
+{
+    writeTag(Tag::integer);
+    writeVarint(((std::uint64_t) val << 1) ^ (std::uint64_t) (val >> 63));
+}
+
+void BinaryComposer::writeFloat(const double& val)
+{
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &val, sizeof(bits));
+
+    writeTag(Tag::floatingPoint);
+    for (int i = 0; i < 8; ++i)
+        m_data.push_back((char) (bits >> (i * 8)));
+}
+
+void BinaryComposer::writeString(const std::string_view& val)
+{
+    if (val.empty() || val.size() > kMaxIndexedStringLength)
+    {
+        writeTag(Tag::string);
+    }
+    else if (const auto it = m_stringIndexes.find(val); it != m_stringIndexes.end())
+    {
+        writeTag(Tag::stringReference);
+        writeVarint(it->second);
+        return;
+    }
+    else
+    {
+        const auto index = m_stringIndexes.size();
+        m_stringIndexes.emplace(val, index);
+        writeTag(Tag::indexedString);
+    }
+
+    writeVarint(val.size());
+    m_data.append(val);
+}
+
+void BinaryComposer::writeRawString(const std::string_view& val)
+{
+    writeString(val);
+}
+
+void BinaryComposer::writeNull()
+{
+    writeTag(Tag::null);
+}
+
+void BinaryComposer::writeAttributeName(const std::string_view& name)
+{
+    writeVarint(kNamedKey);
+    writeString(name);
+}
+
+void BinaryComposer::writeFieldId(std::size_t index)
+{
+    writeVarint(fieldIdKey(index));
+}
+
+std::string BinaryComposer::take()
+{
+    m_stringIndexes.clear();
+    return std::exchange(m_data, std::string());
+}
+
+void BinaryComposer::writeTag(Tag tag)
+{
+    m_data.push_back((char) tag);
+}
+
+void BinaryComposer::writeVarint(std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        m_data.push_back((char) ((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    m_data.push_back((char) value);
+}
+
+} // namespace nx::reflect::binary::detail
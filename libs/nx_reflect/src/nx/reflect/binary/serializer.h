@@ -0,0 +1,107 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <nx/reflect/basic_serializer.h>
+#include <nx/reflect/flags.h>
+#include <nx/reflect/type_utils.h>
+
+#include "wire_format.h"
+
+namespace nx::reflect::binary {
+
+namespace detail {
+
+class NX_REFLECT_API BinaryComposer: public AbstractComposer<std::string>
+{
+public:
+    BinaryComposer();
+
+    virtual void startArray() override;
+    virtual void endArray(int items) override;
+    virtual void startObject() override;
+    virtual void endObject(int members) override;
+    virtual void writeBool(bool val) override;
+    virtual void writeInt(const std::int64_t& val) override;
+    virtual void writeFloat(const double& val) override;
+    virtual void writeString(const std::string_view& val) override;
+
+    /** There is no raw representation in this format, so the value is written as a string. */
+    virtual void writeRawString(const std::string_view& val) override;
+
+    virtual void writeNull() override;
+    virtual void writeAttributeName(const std::string_view& name) override;
+
+    /** Writes the member key of the field with the given index in the type instrumentation. */
+    void writeFieldId(std::size_t index);
+
+    virtual std::string take() override;
+
+private:
+    void writeTag(Tag tag);
+    void writeVarint(std::uint64_t value);
+
+private:
+    struct StringHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view str) const
+        {
+            return std::hash<std::string_view>()(str);
+        }
+    };
+
+    std::string m_data;
+    std::unordered_map<std::string, std::size_t, StringHash, std::equal_to<>> m_stringIndexes;
+};
+
+struct SerializationContext
+{
+    BinaryComposer composer;
+    int flags = (int) SerializationFlag::uuidWithBraces;
+
+    bool uuidWithBraces() const { return flags & ((int) SerializationFlag::uuidWithBraces); }
+
+    template<typename T>
+    int beforeSerialize(const T&) { return -1; /*dummy*/ }
+
+    template<typename T>
+    void afterSerialize(const T&, int) {}
+
+    template<typename Data>
+    void writeFieldKey(std::size_t index)
+    {
+        composer.writeFieldId(index);
+    }
+};
+
+} // namespace detail
+
+using SerializationContext = detail::SerializationContext;
+
+template<typename Data>
+void serialize(SerializationContext* ctx, const Data& data)
+{
+    BasicSerializer::serializeAdl(ctx, data);
+}
+
+/**
+ * Serializes object of supported type Data to the compact binary format.
+ * @param data has to be instrumented type or build-in type. The same types as for JSON are
+ * supported.
+ */
+template<typename Data>
+std::string serialize(const Data& data)
+{
+    SerializationContext ctx;
+    serialize(&ctx, data);
+    return ctx.composer.take();
+}
+
+} // namespace nx::reflect::binary
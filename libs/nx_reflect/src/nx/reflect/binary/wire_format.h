@@ -0,0 +1,47 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nx::reflect::binary::detail {
+
+/**
+ * The first byte of each encoded value. See readme.md for the format description.
+ */
+enum class Tag: std::uint8_t
+{
+    end = 0,
+    null = 1,
+    falseValue = 2,
+    trueValue = 3,
+    /** Zigzag-encoded varint. */
+    integer = 4,
+    /** IEEE 754 double, little-endian. */
+    floatingPoint = 5,
+    /** Varint length and the bytes. */
+    string = 6,
+    /** Same as string, and the string is appended to the string table. */
+    indexedString = 7,
+    /** Varint index in the string table. */
+    stringReference = 8,
+    /** Values up to the end tag. */
+    array = 9,
+    /** Members (key and value) up to the zero key. */
+    object = 10,
+};
+
+/** Member key followed by a string value with the member name. */
+constexpr std::uint64_t kNamedKey = 2;
+
+/** Odd member keys are field ids: the indexes of the fields in the type instrumentation. */
+constexpr std::uint64_t fieldIdKey(std::size_t index) { return index * 2 + 1; }
+
+/**
+ * Longer strings are rarely repeated (descriptions, URLs with tokens), so they are not put in the
+ * string table.
+ */
+constexpr std::size_t kMaxIndexedStringLength = 64;
+
+} // namespace nx::reflect::binary::detail
@@ -50,6 +50,9 @@ struct DeserializationContext
 
 template<typename Data> class Deserializer;
 
+template<typename Data> DeserializationResult deserializeWithoutDom(
+    const std::string_view& json, Data* data, int flags);
+
 template<typename T> DeserializationResult deserializeValue(
     const DeserializationContext& ctx, T* data);
 
@@ -608,6 +611,8 @@ DeserializationResult deserialize(const DeserializationContext& ctx, T* data)
  * - static T T::fromStdString(const std::string&)
  * - static T T::fromString(const std::string&)
  * - bool fromString(const std::string&, Data*)
+ * The text is deserialized straight from the rapidjson token stream without building a DOM,
+ * unless DeserializationFlag::fields is specified.
  */
 template<typename Data>
 DeserializationResult deserialize(
@@ -617,6 +622,13 @@ DeserializationResult deserialize(
 {
     using namespace rapidjson;
 
+    // The DOM-based deserialization is repeated on failure to report the error details.
+    if (!((int) skipErrors & (int) json::DeserializationFlag::fields)
+        && json_detail::deserializeWithoutDom(json, data, (int) skipErrors))
+    {
+        return DeserializationResult(true);
+    }
+
     Document document;
     document.Parse(json.data(), json.size());
     if (document.HasParseError())
@@ -644,3 +656,5 @@ std::tuple<Data, DeserializationResult> deserialize(
 } // namespace json
 
 } // namespace nx::reflect
+
+#include "stream_deserializer.h"
@@ -2,71 +2,219 @@
 
 #include "serializer.h"
 
+#include <array>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+#include <rapidjson/internal/dtoa.h>
+#include <rapidjson/internal/itoa.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define NX_REFLECT_JSON_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define NX_REFLECT_JSON_NEON
+#endif
+
 namespace nx::reflect::json::detail {
 
-JsonComposer::JsonComposer():
-    m_writer(m_buffer)
+namespace {
+
+/**
+ * The escape character for the characters escaped by rapidjson::Writer, 'u' for \u00XX.
+ */
+constexpr std::array<char, 256> makeEscapeTable()
+{
+    std::array<char, 256> table{};
+    for (int c = 0; c < 0x20; ++c)
+        table[c] = 'u';
+    table['\b'] = 'b';
+    table['\t'] = 't';
+    table['\n'] = 'n';
+    table['\f'] = 'f';
+    table['\r'] = 'r';
+    table['"'] = '"';
+    table['\\'] = '\\';
+    return table;
+}
+
+constexpr std::array<char, 256> kEscape = makeEscapeTable();
+
+/**
+ * @return Position of the first character to escape, or size.
+ */
+std::size_t findCharToEscape(const char* data, std::size_t size)
+{
+    std::size_t pos = 0;
+
+    #if defined(NX_REFLECT_JSON_SSE2)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i maxControl = _mm_set1_epi8(0x1f);
+        for (; pos + 16 <= size; pos += 16)
+        {
+            const __m128i chars = _mm_loadu_si128((const __m128i*) (data + pos));
+            const __m128i toEscape = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)),
+                _mm_cmpeq_epi8(_mm_min_epu8(chars, maxControl), chars));
+            if (const int mask = _mm_movemask_epi8(toEscape); mask != 0)
+                return pos + (std::size_t) std::countr_zero((unsigned) mask);
+        }
+    #elif defined(NX_REFLECT_JSON_NEON)
+        const uint8x16_t quote = vdupq_n_u8('"');
+        const uint8x16_t backslash = vdupq_n_u8('\\');
+        const uint8x16_t control = vdupq_n_u8(0x20);
+        for (; pos + 16 <= size; pos += 16)
+        {
+            const uint8x16_t chars = vld1q_u8((const uint8_t*) (data + pos));
+            const uint8x16_t toEscape = vorrq_u8(
+                vorrq_u8(vceqq_u8(chars, quote), vceqq_u8(chars, backslash)),
+                vcltq_u8(chars, control));
+            if (vmaxvq_u8(toEscape) != 0)
+                break; //< The scalar loop below finds the exact position.
+        }
+    #endif
+
+    for (; pos < size; ++pos)
+    {
+        if (kEscape[(unsigned char) data[pos]])
+            break;
+    }
+    return pos;
+}
+
+} // namespace
+
+JsonComposer::JsonComposer(std::string buffer):
+    m_text(std::move(buffer))
 {
+    m_text.clear();
 }
 
 void JsonComposer::startArray()
 {
-    m_writer.StartArray();
+    beforeValue();
+    m_text += '[';
+    m_needsComma = false;
 }
 
-void JsonComposer::endArray(int items)
+void JsonComposer::endArray(int /*items*/)
 {
-    m_writer.EndArray(items);
+    m_text += ']';
+    m_needsComma = true;
 }
 
 void JsonComposer::startObject()
 {
-    m_writer.StartObject();
+    beforeValue();
+    m_text += '{';
+    m_needsComma = false;
 }
 
-void JsonComposer::endObject(int members)
+void JsonComposer::endObject(int /*members*/)
 {
-    m_writer.EndObject(members);
+    m_text += '}';
+    m_needsComma = true;
 }
 
 void JsonComposer::writeBool(bool val)
 {
-    m_writer.Bool(val);
+    beforeValue();
+    m_text += val ? std::string_view("true") : std::string_view("false");
+    m_needsComma = true;
 }
 
 void JsonComposer::writeInt(const std::int64_t& val)
 {
-    m_writer.Int64(val);
+    beforeValue();
+    char buffer[32];
+    char* end = rapidjson::internal::i64toa(val, buffer);
+    m_text.append(buffer, (std::size_t) (end - buffer));
+    m_needsComma = true;
 }
 
 void JsonComposer::writeFloat(const double& val)
 {
-    m_writer.Double(val);
+    // Same as rapidjson::kWriteNanAndInfNullFlag.
+    if (!std::isfinite(val))
+        return writeNull();
+
+    beforeValue();
+    char buffer[32];
+    char* end = rapidjson::internal::dtoa(val, buffer);
+    m_text.append(buffer, (std::size_t) (end - buffer));
+    m_needsComma = true;
 }
 
 void JsonComposer::writeString(const std::string_view& val)
 {
-    m_writer.String(val.data(), (rapidjson::SizeType) val.size());
+    beforeValue();
+    appendEscaped(val);
+    m_needsComma = true;
 }
 
 void JsonComposer::writeRawString(const std::string_view& val)
 {
-    m_writer.RawValue(val.data(), (rapidjson::SizeType) val.size(), (rapidjson::Type::kStringType));
+    beforeValue();
+    m_text += val;
+    m_needsComma = true;
 }
 
 void JsonComposer::writeNull()
 {
-    m_writer.Null();
+    beforeValue();
+    m_text += "null";
+    m_needsComma = true;
 }
 
 void JsonComposer::writeAttributeName(const std::string_view& name)
 {
-    m_writer.Key(name.data(), (rapidjson::SizeType) name.size());
+    beforeValue();
+    appendEscaped(name);
+    m_text += ':';
+    m_needsComma = false;
+}
+
+void JsonComposer::writeAttributeKey(const std::string_view& key)
+{
+    beforeValue();
+    m_text += key;
+    m_needsComma = false;
 }
 
 std::string JsonComposer::take()
 {
-    return m_buffer.GetString();
+    m_needsComma = false;
+    return std::exchange(m_text, std::string());
+}
+
+void JsonComposer::beforeValue()
+{
+    if (m_needsComma)
+        m_text += ',';
+}
+
+void JsonComposer::appendEscaped(const std::string_view& str)
+{
+    static constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+    m_text += '"';
+    for (std::size_t pos = 0; pos < str.size();)
+    {
+        const auto escapePos = pos + findCharToEscape(str.data() + pos, str.size() - pos);
+        m_text.append(str.data() + pos, escapePos - pos);
+        if (escapePos == str.size())
+            break;
+
+        const auto c = (unsigned char) str[escapePos];
+        const char escaped[] = {
+            '\\', kEscape[c], '0', '0', kHexDigits[c >> 4], kHexDigits[c & 0xf]};
+        m_text.append(escaped, kEscape[c] == 'u' ? 6 : 2);
+        pos = escapePos + 1;
+    }
+    m_text += '"';
 }
 
 } // namespace nx::reflect::json::detail
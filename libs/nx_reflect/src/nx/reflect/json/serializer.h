@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
@@ -17,11 +18,18 @@ namespace nx::reflect::json {
 
 namespace detail {
 
+/**
+ * Writes JSON text straight into a growable string buffer. The output is the same as of
+ * rapidjson::Writer.
+ */
 class NX_REFLECT_API JsonComposer:
     public AbstractComposer<std::string>
 {
 public:
-    JsonComposer();
+    /**
+     * @param buffer Its capacity is reused for the output, the content is discarded.
+     */
+    JsonComposer(std::string buffer = std::string());
 
     virtual void startArray() override;
     virtual void endArray(int items) override;
@@ -35,17 +43,47 @@ public:
     virtual void writeNull() override;
     virtual void writeAttributeName(const std::string_view& name) override;
 
+    /**
+     * @param key Already escaped and quoted attribute name followed by the colon.
+     */
+    void writeAttributeKey(const std::string_view& key);
+
     virtual std::string take() override;
 
+private:
+    void beforeValue();
+    void appendEscaped(const std::string_view& str);
+
 private:
     std::string m_text;
-    rapidjson::StringBuffer m_buffer;
-    rapidjson::Writer<
-        rapidjson::StringBuffer,
-        rapidjson::UTF8<>,
-        rapidjson::UTF8<>,
-        rapidjson::CrtAllocator,
-        rapidjson::kWriteNanAndInfNullFlag> m_writer;
+    bool m_needsComma = false;
+};
+
+/**
+ * Escaped and quoted names of the fields of an instrumented type followed by the colon, e.g.
+ * "\"name\":". Built once per type.
+ */
+template<typename Data>
+class FieldKeys
+{
+public:
+    static const std::vector<std::string>& get()
+    {
+        static const std::vector<std::string> keys = nx::reflect::visitAllFields<Data>(
+            [](const auto&... fields)
+            {
+                return std::vector<std::string>{makeKey(fields.name())...};
+            });
+        return keys;
+    }
+
+private:
+    static std::string makeKey(const char* name)
+    {
+        JsonComposer composer;
+        composer.writeAttributeName(name);
+        return composer.take();
+    }
 };
 
 struct SerializationContext
@@ -68,6 +106,12 @@ struct SerializationContext
     {
         composer.setSerializeFlags(state);
     }
+
+    template<typename Data>
+    void writeFieldKey(std::size_t index)
+    {
+        composer.writeAttributeKey(FieldKeys<Data>::get()[index]);
+    }
 };
 
 } // namespace detail
@@ -100,4 +144,16 @@ std::string serialize(const Data& data)
     return ctx.composer.take();
 }
 
+/**
+ * Serializes data to JSON replacing the buffer content. The buffer capacity is reused, so
+ * serializing many objects into the same buffer avoids reallocations.
+ */
+template<typename Data>
+void serialize(const Data& data, std::string* buffer)
+{
+    SerializationContext ctx{detail::JsonComposer(std::move(*buffer))};
+    nx::reflect::json::serialize(&ctx, data);
+    *buffer = ctx.composer.take();
+}
+
 } // namespace nx::reflect::json
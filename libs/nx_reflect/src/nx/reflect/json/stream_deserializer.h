@@ -0,0 +1,494 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "deserializer.h"
+#include "token_reader.h"
+
+/**
+ * Used only to detect custom deserialize() functions via ADL: no nx::reflect::json_detail
+ * built-in overload accepts the probe context.
+ */
+namespace nx_reflect_json_adl_probe {
+
+struct Context
+{
+    operator const nx::reflect::json_detail::DeserializationContext&() const;
+};
+
+template<typename T, typename = std::void_t<>>
+struct HasCustomDeserializer: std::false_type {};
+
+template<typename T>
+struct HasCustomDeserializer<
+    T,
+    std::void_t<decltype(deserialize(std::declval<const Context&>(), (T*) nullptr))>>
+:
+    std::true_type {};
+
+} // namespace nx_reflect_json_adl_probe
+
+namespace nx::reflect::json_detail {
+
+/**
+ * Deserialization straight from the token stream, without building a DOM. Mirrors
+ * deserializeValue() and the built-in deserialize() overloads. Values of types with custom
+ * deserialize() functions and of types without a streaming implementation (e.g., std::variant)
+ * are read into a DOM of their own and passed to deserializeValue().
+ *
+ * Failure results carry no description: the caller repeats the DOM-based deserialization to
+ * report the error.
+ * NOTE: The object members are matched to the fields by name in one pass, the first one of the
+ * repeated members is used like rapidjson::Value::FindMember() does.
+ */
+struct StreamContext
+{
+    TokenReader& reader;
+    int flags = 0;
+
+    /** Set when a value is met that only the DOM-based deserialization handles. */
+    bool requiresDom = false;
+
+    bool ignoreErrors() const
+    {
+        return flags & (int) json::DeserializationFlag::ignoreFieldTypeMismatch;
+    }
+};
+
+template<typename T>
+inline constexpr bool HasCustomDeserializerV =
+    nx_reflect_json_adl_probe::HasCustomDeserializer<T>::value;
+
+template<typename T>
+DeserializationResult streamCurrentValue(StreamContext& ctx, T* data);
+
+template<typename T>
+DeserializationResult streamCurrentValue(StreamContext& ctx, std::optional<T>* data);
+
+/**
+ * Reads the next value.
+ */
+template<typename T>
+DeserializationResult streamValue(StreamContext& ctx, T* data)
+{
+    if (!ctx.reader.next())
+        return DeserializationResult(false);
+    return streamCurrentValue(ctx, data);
+}
+
+template<typename T>
+DeserializationResult streamWithDom(StreamContext& ctx, T* data)
+{
+    rapidjson::Document document;
+    if (!ctx.reader.readValue(&document))
+        return DeserializationResult(false);
+    return deserializeValue(DeserializationContext{document, ctx.flags}, data);
+}
+
+template<typename Data>
+class StreamDeserializer
+{
+public:
+    StreamDeserializer(StreamContext& ctx, Data* data):
+        m_ctx(ctx),
+        m_data(data)
+    {
+    }
+
+    template<typename... Fields>
+    DeserializationResult operator()(Fields... fields)
+    {
+        const std::array<std::string_view, sizeof...(Fields)> names{
+            std::string_view(fields.name())...};
+        std::array<bool, sizeof...(Fields)> found{};
+
+        auto& reader = m_ctx.reader;
+        std::size_t expected = 0; //< The members usually go in the order of the fields.
+        for (;;)
+        {
+            if (!reader.next())
+                return DeserializationResult(false);
+            if (reader.token().type == TokenType::endObject)
+                break;
+
+            const auto index = findField(names, reader.token().string, expected);
+            if (index == names.size() || found[index])
+            {
+                // Not a field, or a repeated member: the first one is used.
+                if (!reader.next() || !reader.skipTo(reader.valueDepth()))
+                    return DeserializationResult(false);
+                continue;
+            }
+
+            found[index] = true;
+            expected = index + 1;
+
+            DeserializationResult result(true);
+            [[maybe_unused]] std::size_t i = 0;
+            ((i++ == index
+                ? (void) (result = streamField(fields, (typename Fields::Type*) nullptr))
+                : (void) 0), ...);
+
+            if (!result && !m_ctx.ignoreErrors())
+                return result;
+        }
+
+        [[maybe_unused]] std::size_t i = 0;
+        (resetMissingField(fields, found[i++], (typename Fields::Type*) nullptr), ...);
+        return DeserializationResult(true);
+    }
+
+private:
+    template<std::size_t N>
+    static std::size_t findField(
+        const std::array<std::string_view, N>& names,
+        const std::string& name,
+        std::size_t expected)
+    {
+        if (expected < N && names[expected] == name)
+            return expected;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (names[i] == name)
+                return i;
+        }
+        return N;
+    }
+
+    template<typename WrappedField, typename T>
+    DeserializationResult streamField(const WrappedField& field, std::optional<T>*)
+    {
+        std::optional<T> data;
+        if constexpr (HasGet<WrappedField>::value)
+        {
+            data = field.get(*m_data);
+            if (!data)
+                data.emplace(createDefault<T>());
+        }
+        else
+        {
+            data.emplace(createDefault<T>());
+        }
+
+        auto result = streamValue(m_ctx, &*data);
+        if (result)
+            field.set(m_data, std::move(data));
+        return result;
+    }
+
+    template<typename WrappedField, typename T>
+    DeserializationResult streamField(const WrappedField& field, T*)
+    {
+        T data = defaultField<T>(field);
+        if (!m_ctx.reader.next())
+            return DeserializationResult(false);
+
+        // If null value cannot be converted to target value type, then just ignore it.
+        const bool isNull = m_ctx.reader.token().type == TokenType::null;
+        auto result = streamCurrentValue(m_ctx, &data);
+        if (result)
+            field.set(m_data, std::move(data));
+        else if (isNull)
+            return DeserializationResult(true);
+        return result;
+    }
+
+    template<typename WrappedField, typename T>
+    void resetMissingField(const WrappedField& field, bool found, std::optional<T>*)
+    {
+        if (!found)
+            field.set(m_data, std::nullopt);
+    }
+
+    template<typename WrappedField, typename T>
+    void resetMissingField(const WrappedField&, bool, T*)
+    {
+    }
+
+    template<typename F, typename = void>
+    struct HasGet { static constexpr bool value = false; };
+
+    template<typename F>
+    struct HasGet<F, std::void_t<decltype(&F::get)>> { static constexpr bool value = true; };
+
+    template<typename T, typename WrappedField>
+    T defaultField(const WrappedField& field)
+    {
+        if constexpr (HasGet<WrappedField>::value)
+            return field.get(*m_data);
+        else
+            return createDefault<T>();
+    }
+
+private:
+    StreamContext& m_ctx;
+    Data* m_data = nullptr;
+};
+
+template<typename C>
+DeserializationResult streamArray(StreamContext& ctx, C* data)
+{
+    *data = C();
+    if (ctx.reader.token().type != TokenType::startArray)
+        return DeserializationResult(false);
+
+    for (;;)
+    {
+        if (!ctx.reader.next())
+            return DeserializationResult(false);
+        if (ctx.reader.token().type == TokenType::endArray)
+            return DeserializationResult(true);
+
+        auto element = createDefault<typename C::value_type>();
+        auto result = streamCurrentValue(ctx, &element);
+        if (!result)
+        {
+            if (!ctx.ignoreErrors())
+                return result;
+            continue;
+        }
+        std::inserter(*data, data->end()) = std::move(element);
+    }
+}
+
+template<typename C>
+DeserializationResult streamMap(StreamContext& ctx, C* data)
+{
+    if (ctx.reader.token().type != TokenType::startObject)
+        return DeserializationResult(false);
+
+    for (;;)
+    {
+        if (!ctx.reader.next())
+            return DeserializationResult(false);
+        if (ctx.reader.token().type == TokenType::endObject)
+            return DeserializationResult(true);
+
+        typename C::key_type key;
+        const bool isKeyValid =
+            nx::reflect::fromString(std::string_view(ctx.reader.token().string), &key);
+
+        auto element = createDefault<typename C::mapped_type>();
+        auto result = streamValue(ctx, &element);
+        if (!result || !isKeyValid)
+        {
+            if (!ctx.ignoreErrors())
+                return DeserializationResult(false);
+            continue;
+        }
+
+        if constexpr (HasSquareBracketOperatorV<C, decltype(key)>)
+            data->insert_or_assign(std::move(key), std::move(element)); //< E.g., std::map
+        else
+            data->emplace(std::move(key), std::move(element)); //< E.g., std::multimap
+    }
+}
+
+template<typename T>
+DeserializationResult streamCurrentValueImpl(StreamContext& ctx, T* data)
+{
+    Token& token = ctx.reader.token();
+
+    // rapidjson::Value::GetInt64() does not support the other numbers, so they are left to the
+    // DOM-based deserialization.
+    const auto getInt64 =
+        [&ctx, &token](std::int64_t* value)
+        {
+            if (token.type == TokenType::number && !token.isInt64())
+                ctx.requiresDom = true;
+            if (!token.isInt64())
+                return false;
+            *value = token.integer;
+            return true;
+        };
+
+    if constexpr (IsStringAlikeV<T>)
+    {
+        *data = T();
+        if (token.type != TokenType::string)
+            return DeserializationResult(false);
+
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            *data = std::move(token.string);
+            return DeserializationResult(true);
+        }
+        else
+        {
+            if (!nx::reflect::fromString(token.string.c_str(), data))
+            {
+                *data = T();
+                return DeserializationResult(false);
+            }
+            return DeserializationResult(true);
+        }
+    }
+    else if constexpr (nx::reflect::IsInstrumentedV<T>)
+    {
+        if constexpr (HasCustomDeserializerV<T>)
+        {
+            return streamWithDom(ctx, data);
+        }
+        else
+        {
+            if (token.type != TokenType::startObject)
+                return DeserializationResult(false);
+            return nx::reflect::visitAllFields<T>(StreamDeserializer<T>(ctx, data));
+        }
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        *data = bool();
+        if (token.type == TokenType::boolean)
+            *data = token.boolean;
+        else if (token.type == TokenType::string && token.string == "true")
+            *data = true;
+        else if (token.type == TokenType::string && token.string == "false")
+            *data = false;
+        else
+            return DeserializationResult(false);
+        return DeserializationResult(true);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        *data = T();
+        std::int64_t value = 0;
+        if (getInt64(&value))
+            *data = static_cast<T>(value);
+        else if (token.type == TokenType::string)
+            *data = static_cast<T>(std::stoll(token.string));
+        else
+            return DeserializationResult(false);
+        return DeserializationResult(true);
+    }
+    else if constexpr (std::is_same_v<T, std::nullptr_t>)
+    {
+        *data = std::nullptr_t();
+        return DeserializationResult(token.type == TokenType::null);
+    }
+    else if constexpr (IsInstrumentedEnumV<T>)
+    {
+        *data = T();
+        if (token.type == TokenType::string)
+            return DeserializationResult(enumeration::fromString<T>(token.string, data));
+
+        std::int64_t value = 0;
+        if (!getInt64(&value))
+            return DeserializationResult(false);
+        *data = static_cast<T>(value);
+        return DeserializationResult(enumeration::isValidEnumValue<T>(*data));
+    }
+    else if constexpr (IsDeserializableV<T> && !HasCustomDeserializerV<T>)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (token.isDouble())
+                *data = (T) token.real;
+            else if (token.isInt64())
+                *data = (T) token.integer;
+            else if (token.type == TokenType::string)
+                *data = (T) std::stod(token.string);
+            else
+                return DeserializationResult(false);
+            return DeserializationResult(true);
+        }
+        else if constexpr (IsStdChronoDurationV<T>)
+        {
+            *data = T();
+            std::int64_t value = 0;
+            if (getInt64(&value))
+                *data = T(value);
+            else if (token.type == TokenType::string)
+                *data = T(std::stoll(token.string));
+            else
+                return DeserializationResult(false);
+            return DeserializationResult(true);
+        }
+        else if constexpr (IsStdChronoTimePointV<T>)
+        {
+            *data = T();
+            std::chrono::milliseconds ms;
+            auto result = streamCurrentValueImpl(ctx, &ms);
+            if (result)
+                *data = T(ms);
+            return result;
+        }
+        else if constexpr (IsArrayV<T>
+            || IsSequenceContainerV<T>
+            || IsSetContainerV<T>
+            || IsUnorderedSetContainerV<T>)
+        {
+            return streamArray(ctx, data);
+        }
+        else if constexpr ((IsAssociativeContainerV<T> && !IsSetContainerV<T>)
+            || (IsUnorderedAssociativeContainerV<T> && !IsUnorderedSetContainerV<T>))
+        {
+            return streamMap(ctx, data);
+        }
+        else
+        {
+            return streamWithDom(ctx, data);
+        }
+    }
+    else
+    {
+        // Custom deserializers and unsupported types. The latter are reported at compile time.
+        return streamWithDom(ctx, data);
+    }
+}
+
+/**
+ * Reads the value started by the current token. On failure, the rest of the value is skipped.
+ */
+template<typename T>
+DeserializationResult streamCurrentValue(StreamContext& ctx, T* data)
+{
+    const int depth = ctx.reader.valueDepth();
+    auto result = streamCurrentValueImpl(ctx, data);
+    if (!result)
+        ctx.reader.skipTo(depth);
+    return result;
+}
+
+template<typename T>
+DeserializationResult streamCurrentValue(StreamContext& ctx, std::optional<T>* data)
+{
+    if (data->has_value())
+        return streamCurrentValue(ctx, &data->value());
+
+    T val;
+    auto result = streamCurrentValue(ctx, &val);
+    if (result)
+        *data = std::move(val);
+    return result;
+}
+
+template<typename Data>
+DeserializationResult deserializeWithoutDom(const std::string_view& json, Data* data, int flags)
+{
+    TokenReader reader(json);
+    StreamContext ctx{reader, flags};
+    try
+    {
+        auto result = streamValue(ctx, data);
+        if (ctx.requiresDom || (result && !reader.isComplete()))
+            return DeserializationResult(false);
+        return result;
+    }
+    catch (const std::exception&)
+    {
+        return DeserializationResult(false);
+    }
+}
+
+} // namespace nx::reflect::json_detail
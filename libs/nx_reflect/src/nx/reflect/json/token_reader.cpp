@@ -0,0 +1,197 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "token_reader.h"
+
+namespace nx::reflect::json_detail {
+
+class TokenReader::Handler
+{
+public:
+    Handler(Token* token): m_token(token) {}
+
+    bool Null() { return set(TokenType::null); }
+
+    bool Bool(bool value)
+    {
+        m_token->boolean = value;
+        return set(TokenType::boolean);
+    }
+
+    bool Int(int value) { return setNumber(NumberType::int32, value); }
+    bool Uint(unsigned value) { return setNumber(NumberType::uint32, value); }
+    bool Int64(std::int64_t value) { return setNumber(NumberType::int64, value); }
+    bool Uint64(std::uint64_t value) { return setNumber(NumberType::uint64, (std::int64_t) value); }
+
+    bool Double(double value)
+    {
+        m_token->numberType = NumberType::real;
+        m_token->real = value;
+        return set(TokenType::number);
+    }
+
+    /** Not reported with the default parse flags. */
+    bool RawNumber(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        return String(str, length, copy);
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool /*copy*/)
+    {
+        m_token->string.assign(str, length);
+        return set(TokenType::string);
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool /*copy*/)
+    {
+        m_token->string.assign(str, length);
+        return set(TokenType::key);
+    }
+
+    bool StartObject() { return set(TokenType::startObject); }
+
+    bool EndObject(rapidjson::SizeType memberCount)
+    {
+        m_token->count = memberCount;
+        return set(TokenType::endObject);
+    }
+
+    bool StartArray() { return set(TokenType::startArray); }
+
+    bool EndArray(rapidjson::SizeType elementCount)
+    {
+        m_token->count = elementCount;
+        return set(TokenType::endArray);
+    }
+
+private:
+    bool set(TokenType type)
+    {
+        m_token->type = type;
+        return true;
+    }
+
+    bool setNumber(NumberType numberType, std::int64_t value)
+    {
+        m_token->numberType = numberType;
+        m_token->integer = value;
+        return set(TokenType::number);
+    }
+
+private:
+    Token* m_token = nullptr;
+};
+
+namespace {
+
+bool emit(const Token& token, rapidjson::Document* document)
+{
+    const auto length = (rapidjson::SizeType) token.string.size();
+    const auto count = (rapidjson::SizeType) token.count;
+
+    switch (token.type)
+    {
+        case TokenType::null:
+            return document->Null();
+        case TokenType::boolean:
+            return document->Bool(token.boolean);
+        case TokenType::number:
+            switch (token.numberType)
+            {
+                case NumberType::int32:
+                    return document->Int((int) token.integer);
+                case NumberType::uint32:
+                    return document->Uint((unsigned) token.integer);
+                case NumberType::int64:
+                    return document->Int64(token.integer);
+                case NumberType::uint64:
+                    return document->Uint64((std::uint64_t) token.integer);
+                case NumberType::real:
+                    return document->Double(token.real);
+            }
+            return false;
+        case TokenType::string:
+            return document->String(token.string.data(), length, /*copy*/ true);
+        case TokenType::key:
+            return document->Key(token.string.data(), length, /*copy*/ true);
+        case TokenType::startObject:
+            return document->StartObject();
+        case TokenType::endObject:
+            return document->EndObject(count);
+        case TokenType::startArray:
+            return document->StartArray();
+        case TokenType::endArray:
+            return document->EndArray(count);
+        case TokenType::none:
+            return false;
+    }
+
+    return false;
+}
+
+} // namespace
+
+TokenReader::TokenReader(const std::string_view& json):
+    m_memoryStream(json.data(), json.size()),
+    m_stream(m_memoryStream)
+{
+    m_reader.IterativeParseInit();
+}
+
+TokenReader::~TokenReader() = default;
+
+bool TokenReader::next()
+{
+    m_token.type = TokenType::none;
+
+    // Also true after a parse error.
+    if (m_reader.IterativeParseComplete())
+        return false;
+
+    Handler handler(&m_token);
+    if (!m_reader.IterativeParseNext<rapidjson::kParseDefaultFlags>(m_stream, handler)
+        || m_token.type == TokenType::none)
+    {
+        return false;
+    }
+
+    if (m_token.isStart())
+        ++m_depth;
+    else if (m_token.type == TokenType::endObject || m_token.type == TokenType::endArray)
+        --m_depth;
+
+    return true;
+}
+
+bool TokenReader::skipTo(int depth)
+{
+    while (m_depth > depth)
+    {
+        if (!next())
+            return false;
+    }
+    return true;
+}
+
+bool TokenReader::readValue(rapidjson::Document* document)
+{
+    const int depth = valueDepth();
+    bool ok = true;
+    auto generator =
+        [this, depth, &ok](rapidjson::Document& handler)
+        {
+            ok = emit(m_token, &handler);
+            while (ok && m_depth > depth)
+                ok = next() && emit(m_token, &handler);
+            return ok;
+        };
+
+    document->Populate(generator);
+    return ok;
+}
+
+bool TokenReader::isComplete() const
+{
+    return m_reader.IterativeParseComplete() && !m_reader.HasParseError();
+}
+
+} // namespace nx::reflect::json_detail
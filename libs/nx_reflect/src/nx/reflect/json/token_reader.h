@@ -0,0 +1,132 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <rapidjson/document.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+namespace nx::reflect::json_detail {
+
+enum class TokenType
+{
+    none,
+    null,
+    boolean,
+    number,
+    string,
+    key,
+    startObject,
+    endObject,
+    startArray,
+    endArray,
+};
+
+/**
+ * Numbers are reported with the narrowest rapidjson type that fits them, the same way they are
+ * stored in rapidjson::Value.
+ */
+enum class NumberType
+{
+    int32,
+    uint32,
+    int64,
+    uint64,
+    real,
+};
+
+struct Token
+{
+    TokenType type = TokenType::none;
+    bool boolean = false;
+    NumberType numberType = NumberType::int64;
+
+    /** Integer value. uint64 numbers are stored bit-casted. */
+    std::int64_t integer = 0;
+
+    double real = 0;
+
+    /** The string value or the object member name. */
+    std::string string;
+
+    /** Number of the object members or the array elements, for the end tokens. */
+    std::size_t count = 0;
+
+    bool isStart() const
+    {
+        return type == TokenType::startObject || type == TokenType::startArray;
+    }
+
+    /** Same as rapidjson::Value::IsInt64(). */
+    bool isInt64() const
+    {
+        return type == TokenType::number
+            && numberType != NumberType::real
+            && (numberType != NumberType::uint64 || integer >= 0);
+    }
+
+    /** Same as rapidjson::Value::IsDouble(). */
+    bool isDouble() const
+    {
+        return type == TokenType::number && numberType == NumberType::real;
+    }
+};
+
+/**
+ * Pull parser over JSON text: reads the text one token at a time without building a DOM.
+ * Syntax and encoding are validated the same way rapidjson::Document::Parse() does.
+ */
+class NX_REFLECT_API TokenReader
+{
+public:
+    TokenReader(const std::string_view& json);
+    ~TokenReader();
+
+    TokenReader(const TokenReader&) = delete;
+    TokenReader& operator=(const TokenReader&) = delete;
+
+    /**
+     * @return false on a parse error or if the whole text has been read already.
+     */
+    bool next();
+
+    Token& token() { return m_token; }
+
+    /** Number of the arrays and objects open, including the one started by the current token. */
+    int depth() const { return m_depth; }
+
+    /** Depth of the value started by the current token. */
+    int valueDepth() const { return m_depth - (m_token.isStart() ? 1 : 0); }
+
+    /**
+     * Reads the tokens until the depth decreases to the specified one. Used to skip the rest of a
+     * value.
+     */
+    bool skipTo(int depth);
+
+    /**
+     * Reads the value started by the current token into the document.
+     */
+    bool readValue(rapidjson::Document* document);
+
+    /**
+     * @return true if the whole text has been read without errors.
+     */
+    bool isComplete() const;
+
+private:
+    class Handler;
+
+    rapidjson::MemoryStream m_memoryStream;
+    rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> m_stream;
+    rapidjson::Reader m_reader;
+    Token m_token;
+    int m_depth = 0;
+};
+
+} // namespace nx::reflect::json_detail
@@ -0,0 +1,236 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nx/reflect/binary.h>
+#include <nx/reflect/instrument.h>
+
+#include "serialization_acceptance_tests.h"
+
+namespace nx::reflect::test {
+
+struct BinaryTypeSet
+{
+    template<typename... Args>
+    static auto serialize(Args&&... args)
+    {
+        return nx::reflect::binary::serialize(std::move(args)...);
+    }
+
+    template<typename... Args>
+    static auto deserialize(Args&&... args)
+    {
+        return nx::reflect::binary::deserialize(std::move(args)...);
+    }
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+    Binary,
+    FormatAcceptance,
+    BinaryTypeSet);
+
+} // namespace nx::reflect::test
+
+namespace nx::reflect::binary::test {
+
+enum class Status
+{
+    offline,
+    online,
+    recording
+};
+
+NX_REFLECTION_INSTRUMENT_ENUM(Status, offline, online, recording)
+
+struct Device
+{
+    std::string id;
+    std::string name;
+    std::int64_t number = 0;
+    double ratio = 0;
+    bool enabled = false;
+    std::optional<int> port;
+    Status status = Status::offline;
+    std::chrono::milliseconds timeout{0};
+    std::vector<std::string> tags;
+    std::map<std::string, int> counters;
+
+    bool operator==(const Device&) const = default;
+};
+
+NX_REFLECTION_INSTRUMENT(Device,
+    (id)(name)(number)(ratio)(enabled)(port)(status)(timeout)(tags)(counters))
+
+/** An older version of Device: the fields which are added later are unknown to it. */
+struct DeviceV1
+{
+    std::string id;
+    std::string name;
+    std::int64_t number = 0;
+
+    bool operator==(const DeviceV1&) const = default;
+};
+
+NX_REFLECTION_INSTRUMENT(DeviceV1, (id)(name)(number))
+
+struct DeviceView
+{
+    std::string_view id;
+    std::string_view name;
+};
+
+NX_REFLECTION_INSTRUMENT(DeviceView, (id)(name))
+
+struct NamedFields
+{
+    int first = 0;
+    std::string second;
+    int third = 0;
+};
+
+NX_REFLECTION_INSTRUMENT(NamedFields, (first)(second)(third))
+
+static std::vector<Device> devices(int count)
+{
+    std::vector<Device> result;
+    for (int i = 0; i < count; ++i)
+    {
+        Device device;
+        device.id = "device_" + std::to_string(i);
+        device.name = "Camera " + std::to_string(i % 4);
+        device.number = -1000000000000LL * i;
+        device.ratio = 0.25 * i;
+        device.enabled = i % 2 == 0;
+        if (i % 3 == 0)
+            device.port = 554 + i;
+        device.status = (Status) (i % 3);
+        device.timeout = std::chrono::milliseconds(i * 100);
+        device.tags = {"indoor", "lobby"};
+        device.counters = {{"frames", i}, {"gaps", -i}};
+        result.push_back(std::move(device));
+    }
+    return result;
+}
+
+TEST(BinarySerialization, data_is_symmetric)
+{
+    const auto data = devices(10);
+    const auto serialized = binary::serialize(data);
+
+    const auto [parsed, result] = binary::deserialize<std::vector<Device>>(serialized);
+    ASSERT_TRUE(result) << result.toString();
+    ASSERT_EQ(data, parsed);
+}
+
+TEST(BinarySerialization, repeated_strings_are_written_once)
+{
+    const auto data = devices(100);
+    const auto serialized = binary::serialize(data);
+
+    ASSERT_EQ(serialized.find("lobby"), serialized.rfind("lobby"));
+    ASSERT_EQ(serialized.find("Camera 1"), serialized.rfind("Camera 1"));
+}
+
+TEST(BinarySerialization, integers_are_compact)
+{
+    ASSERT_EQ(2U, binary::serialize(0).size());
+    ASSERT_EQ(2U, binary::serialize(-1).size());
+    ASSERT_EQ(3U, binary::serialize(100).size());
+
+    const std::vector<std::int64_t> values{
+        0, 1, -1, 300, -300,
+        std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::min()};
+    for (const auto value: values)
+    {
+        const auto [parsed, result] = binary::deserialize<std::int64_t>(binary::serialize(value));
+        ASSERT_TRUE(result);
+        ASSERT_EQ(value, parsed);
+    }
+}
+
+TEST(BinarySerialization, unknown_fields_are_skipped)
+{
+    const auto data = devices(3);
+
+    const auto [parsed, result] =
+        binary::deserialize<std::vector<DeviceV1>>(binary::serialize(data));
+    ASSERT_TRUE(result) << result.toString();
+    ASSERT_EQ(3U, parsed.size());
+    for (std::size_t i = 0; i < parsed.size(); ++i)
+    {
+        ASSERT_EQ(data[i].id, parsed[i].id);
+        ASSERT_EQ(data[i].name, parsed[i].name);
+        ASSERT_EQ(data[i].number, parsed[i].number);
+    }
+}
+
+TEST(BinarySerialization, missing_fields_keep_default_values)
+{
+    const DeviceV1 data{"id", "name", 7};
+
+    const auto [parsed, result] = binary::deserialize<Device>(binary::serialize(data));
+    ASSERT_TRUE(result) << result.toString();
+    ASSERT_EQ("id", parsed.id);
+    ASSERT_EQ(7, parsed.number);
+    ASSERT_FALSE(parsed.port);
+    ASSERT_TRUE(parsed.tags.empty());
+}
+
+TEST(BinarySerialization, string_views_refer_to_input)
+{
+    const auto serialized = binary::serialize(devices(2));
+
+    const auto [parsed, result] = binary::deserialize<std::vector<DeviceView>>(serialized);
+    ASSERT_TRUE(result) << result.toString();
+    ASSERT_EQ(2U, parsed.size());
+    ASSERT_EQ("device_1", parsed[1].id);
+    ASSERT_EQ("Camera 1", parsed[1].name);
+    ASSERT_GE(parsed[1].name.data(), serialized.data());
+    ASSERT_LT(parsed[1].name.data(), serialized.data() + serialized.size());
+}
+
+TEST(BinarySerialization, named_members_are_matched_by_name)
+{
+    // The way a JSON document is written: members have names instead of field ids.
+    detail::BinaryComposer composer;
+    composer.startObject();
+    composer.writeAttributeName("first");
+    composer.writeInt(1);
+    composer.writeAttributeName("unknown");
+    composer.writeString("value");
+    composer.writeAttributeName("third");
+    composer.writeInt(3);
+    composer.endObject(3);
+
+    const auto [parsed, result] = binary::deserialize<NamedFields>(composer.take());
+    ASSERT_TRUE(result) << result.toString();
+    ASSERT_EQ(1, parsed.first);
+    ASSERT_EQ("", parsed.second);
+    ASSERT_EQ(3, parsed.third);
+}
+
+TEST(BinarySerialization, malformed_data_is_rejected)
+{
+    const auto serialized = binary::serialize(devices(3));
+
+    for (std::size_t size = 0; size < serialized.size(); ++size)
+    {
+        const auto [_, result] =
+            binary::deserialize<std::vector<Device>>(std::string_view(serialized).substr(0, size));
+        ASSERT_FALSE(result) << size;
+    }
+
+    const auto [_, result] = binary::deserialize<std::vector<Device>>(serialized + '\0');
+    ASSERT_FALSE(result);
+}
+
+} // namespace nx::reflect::binary::test
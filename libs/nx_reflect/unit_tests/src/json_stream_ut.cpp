@@ -0,0 +1,184 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <map>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/reflect/enum_instrument.h>
+#include <nx/reflect/json/deserializer.h>
+
+namespace nx::reflect::test {
+
+NX_REFLECTION_ENUM_CLASS(StreamEnum, first, second)
+
+struct StreamItem
+{
+    int id = 0;
+    std::string name;
+    std::optional<double> weight;
+    std::vector<std::string> tags;
+    StreamEnum kind = StreamEnum::first;
+
+    bool operator==(const StreamItem&) const = default;
+};
+
+NX_REFLECTION_INSTRUMENT(StreamItem, (id)(name)(weight)(tags)(kind))
+
+/** Has a custom deserializer: accepts a number only. */
+struct StreamCustom
+{
+    std::string value;
+
+    bool operator==(const StreamCustom&) const = default;
+};
+
+NX_REFLECTION_INSTRUMENT(StreamCustom, (value))
+
+DeserializationResult deserialize(
+    const json::DeserializationContext& ctx, StreamCustom* data)
+{
+    if (!ctx.value.IsInt64())
+        return {false, "A number is expected", json_detail::getStringRepresentation(ctx.value)};
+    data->value = std::to_string(ctx.value.GetInt64());
+    return DeserializationResult(true);
+}
+
+struct StreamRoot
+{
+    std::vector<StreamItem> items;
+    std::map<std::string, int> counters;
+    std::variant<int, std::string> variant;
+    StreamCustom custom;
+    std::chrono::milliseconds timeout{0};
+    std::optional<StreamItem> extra;
+    bool flag = false;
+
+    bool operator==(const StreamRoot&) const = default;
+};
+
+NX_REFLECTION_INSTRUMENT(StreamRoot, (items)(counters)(variant)(custom)(timeout)(extra)(flag))
+
+//-------------------------------------------------------------------------------------------------
+
+class JsonStream: public ::testing::Test
+{
+protected:
+    template<typename T>
+    void assertSameAsDom(
+        const std::string& json,
+        json::DeserializationFlag flags = json::DeserializationFlag::none)
+    {
+        T expected = createDefault<T>();
+        DeserializationResult expectedResult;
+        rapidjson::Document document;
+        document.Parse(json.data(), json.size());
+        if (document.HasParseError())
+        {
+            expectedResult = DeserializationResult(
+                false, json_detail::parseErrorToString(document), json);
+        }
+        else
+        {
+            expectedResult = json::deserialize(
+                json::DeserializationContext{document, (int) flags}, &expected);
+        }
+
+        T actual = createDefault<T>();
+        const auto result = json::deserialize(json, &actual, flags);
+        ASSERT_EQ(expectedResult.success, result.success) << json;
+        ASSERT_EQ(expectedResult.errorDescription, result.errorDescription) << json;
+        ASSERT_EQ(expectedResult.firstBadFragment, result.firstBadFragment) << json;
+        ASSERT_EQ(expectedResult.firstNonDeserializedField, result.firstNonDeserializedField)
+            << json;
+        if (expectedResult.success)
+        {
+            ASSERT_EQ(expected, actual) << json;
+        }
+
+        // Successful deserialization must not fall back to the DOM.
+        T streamed = createDefault<T>();
+        ASSERT_EQ(
+            expectedResult.success,
+            json_detail::deserializeWithoutDom(json, &streamed, (int) flags).success) << json;
+    }
+};
+
+TEST_F(JsonStream, all_supported_types)
+{
+    assertSameAsDom<StreamRoot>(R"json(
+        {
+            "items": [
+                {"id": 1, "name": "one", "weight": 1.5, "tags": ["a", "b"], "kind": "second"},
+                {"id": "2", "name": "two", "weight": 2, "kind": 1},
+                {}
+            ],
+            "counters": {"x": 1, "y": -2},
+            "variant": "text",
+            "custom": 42,
+            "timeout": 1000,
+            "extra": {"id": 3},
+            "flag": "true",
+            "unknown": {"nested": [1, {"a": null}]}
+        })json");
+
+    assertSameAsDom<StreamRoot>(R"({"variant": 7, "timeout": "15", "flag": true})");
+    assertSameAsDom<std::vector<StreamItem>>(R"([{"id": 1}, {"id": 2, "tags": []}])");
+    assertSameAsDom<std::map<int, StreamItem>>(R"({"1": {"id": 1}, "2": {"name": "A"}})");
+    assertSameAsDom<std::optional<int>>("5");
+    assertSameAsDom<std::string>(R"("caf\u00e9")");
+}
+
+TEST_F(JsonStream, missing_optional_field_is_reset)
+{
+    StreamItem item;
+    item.weight = 5;
+    ASSERT_TRUE(json::deserialize(R"({"id": 1})", &item));
+    ASSERT_EQ(1, item.id);
+    ASSERT_FALSE(item.weight);
+}
+
+TEST_F(JsonStream, first_of_repeated_members_is_used)
+{
+    assertSameAsDom<StreamItem>(R"({"id": 1, "name": "a", "id": 2, "id": {"x": [1]}})");
+}
+
+TEST_F(JsonStream, null_value_of_non_optional_field_is_ignored)
+{
+    assertSameAsDom<StreamItem>(R"({"id": null, "name": null, "tags": null})");
+    assertSameAsDom<StreamItem>(R"({"weight": null})");
+}
+
+TEST_F(JsonStream, type_mismatch)
+{
+    assertSameAsDom<StreamItem>(R"({"id": [1], "name": "a"})");
+    assertSameAsDom<StreamRoot>(R"({"items": 5})");
+    assertSameAsDom<StreamRoot>(R"({"custom": "5"})");
+    assertSameAsDom<StreamRoot>(R"({"counters": {"x": "y"}})");
+    assertSameAsDom<std::vector<int>>(R"({"a": 1})");
+}
+
+TEST_F(JsonStream, type_mismatch_is_ignored_on_request)
+{
+    const auto flags = json::DeserializationFlag::ignoreFieldTypeMismatch;
+    assertSameAsDom<StreamItem>(R"({"id": [1, [2]], "name": "a", "tags": ["a", 1, {}]})", flags);
+    assertSameAsDom<StreamRoot>(
+        R"({"items": [{"id": {}}, 5, {"id": 2}], "custom": "5", "flag": true})", flags);
+    assertSameAsDom<StreamRoot>(R"({"counters": {"x": [], "y": 2}, "variant": 1})", flags);
+}
+
+TEST_F(JsonStream, invalid_json)
+{
+    assertSameAsDom<StreamItem>("");
+    assertSameAsDom<StreamItem>(R"({"id": 1)");
+    assertSameAsDom<StreamItem>(R"({"id": 1} x)");
+    assertSameAsDom<StreamItem>(R"({"id": 1,})");
+    assertSameAsDom<std::vector<int>>("[1, 2");
+    assertSameAsDom<int>("1 2");
+}
+
+} // namespace nx::reflect::test
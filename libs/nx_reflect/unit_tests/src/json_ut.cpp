@@ -266,6 +266,34 @@ TEST_F(Json, string_support)
     testSerialization(R"({"s":"Hello\nHello"})", FooString{"Hello\nHello"});
 }
 
+TEST_F(Json, string_escaping)
+{
+    testSerialization(
+        R"({"s":"a\"b\\c\u0001\u001F\b\f\t\r/)" "\xc3\xa9" R"("})",
+        FooString{"a\"b\\c\x01\x1f\b\f\t\r/\xc3\xa9"});
+
+    // Long strings are scanned for the characters to escape by blocks.
+    const std::string plain(100, 'x');
+    for (std::size_t i = 0; i < plain.size(); ++i)
+    {
+        auto str = plain;
+        str[i] = '\n';
+        assertSerializedTo(
+            R"({"s":")" + plain.substr(0, i) + "\\n" + plain.substr(i + 1) + R"("})",
+            FooString{str});
+    }
+}
+
+TEST_F(Json, serialization_to_reused_buffer)
+{
+    std::string buffer = "garbage";
+    json::serialize(FooString{"Hello"}, &buffer);
+    ASSERT_EQ(R"({"s":"Hello"})", buffer);
+
+    json::serialize(std::vector<FooString>{{"a"}, {"b"}}, &buffer);
+    ASSERT_EQ(R"([{"s":"a"},{"s":"b"}])", buffer);
+}
+
 struct FooOptionalWithCustomDefault: FooOptional
 {
     FooOptionalWithCustomDefault() { t = "default"; }
@@ -0,0 +1,99 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <cstring>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nx/rtp/parsers/h264_rtp_parser.h>
+
+namespace nx::rtp::test {
+
+namespace {
+
+const std::vector<uint8_t> kSps = {
+    0x67, 0x42, 0x00, 0x29, 0xe3, 0x50, 0x14, 0x07, 0xb6, 0x02, 0xdc, 0x04, 0x04, 0x06, 0x90,
+    0x78, 0x91, 0x15};
+const std::vector<uint8_t> kPps = {0x68, 0xce, 0x3c, 0x80};
+
+constexpr int kMaxPayloadSize = 1400;
+
+struct Packet
+{
+    RtpHeader header;
+    std::vector<uint8_t> payload;
+};
+
+/**
+ * Packetizes a key frame as a camera does: SPS and PPS in single NAL unit packets and the IDR
+ * slice in FU-A packets, the last one with the marker bit.
+ */
+std::vector<Packet> packetizeKeyFrame(int sliceSize, uint32_t rtpTime)
+{
+    std::vector<uint8_t> slice(sliceSize, 0x5a);
+    slice[0] = 0x65; //< IDR slice.
+    slice[1] = 0x88; //< first_mb_in_slice is 0.
+
+    std::vector<std::vector<uint8_t>> payloads{kSps, kPps};
+    const uint8_t nalHeader = slice[0];
+    for (int pos = 1; pos < sliceSize; pos += kMaxPayloadSize)
+    {
+        const int size = std::min(kMaxPayloadSize, sliceSize - pos);
+        std::vector<uint8_t> payload{
+            (uint8_t) ((nalHeader & 0xe0) | nx::media::h264::FU_A_PACKET),
+            (uint8_t) (nalHeader & 0x1f)};
+        if (pos == 1)
+            payload[1] |= 0x80; //< Start.
+        if (pos + size == sliceSize)
+            payload[1] |= 0x40; //< End.
+        payload.insert(payload.end(), slice.begin() + pos, slice.begin() + pos + size);
+        payloads.push_back(std::move(payload));
+    }
+
+    std::vector<Packet> packets;
+    for (auto& payload: payloads)
+    {
+        Packet packet;
+        std::memset(&packet.header, 0, sizeof(packet.header));
+        packet.header.version = RtpHeader::kVersion;
+        packet.header.sequence = htons((uint16_t) packets.size());
+        packet.header.timestamp = htonl(rtpTime);
+        packet.payload = std::move(payload);
+        packets.push_back(std::move(packet));
+    }
+    packets.back().header.marker = 1;
+    return packets;
+}
+
+} // namespace
+
+/**
+ * Reassembles a key frame of state.range(0) bytes from the RTP packets.
+ */
+static void H264RtpParser_reassembleFrame(benchmark::State& state)
+{
+    auto packets = packetizeKeyFrame((int) state.range(0), /*rtpTime*/ 90'000);
+
+    H264Parser parser;
+    for (auto _: state)
+    {
+        for (auto& packet: packets)
+        {
+            bool gotData = false;
+            const auto result = parser.processData(
+                packet.header, packet.payload.data(), /*offset*/ 0,
+                (int) packet.payload.size(), gotData);
+            if (!result.success)
+            {
+                state.SkipWithError(result.message.toStdString().c_str());
+                return;
+            }
+            if (gotData)
+                benchmark::DoNotOptimize(parser.nextData());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(H264RtpParser_reassembleFrame)->Arg(16 * 1024)->Arg(256 * 1024);
+
+} // namespace nx::rtp::test
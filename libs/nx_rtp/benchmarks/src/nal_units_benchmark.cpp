@@ -0,0 +1,61 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nx/codec/nal_units.h>
+
+namespace nx::media::nal::test {
+
+namespace {
+
+/**
+ * An Annex B stream of the given size with a NAL unit every 1400 bytes. The payload bytes
+ * are non-zero, as the encoded data has no start code emulation.
+ */
+std::vector<uint8_t> makeAnnexBStream(int size)
+{
+    constexpr int kNalUnitSize = 1400;
+
+    std::vector<uint8_t> stream;
+    stream.reserve(size);
+    while ((int) stream.size() < size)
+    {
+        stream.insert(stream.end(), kStartCode.begin(), kStartCode.end());
+        stream.push_back(0x41); //< Non-IDR slice.
+        for (int i = 0; i < kNalUnitSize && (int) stream.size() < size; ++i)
+            stream.push_back((uint8_t) (i % 255 + 1));
+    }
+    return stream;
+}
+
+} // namespace
+
+static void Nal_findNextNal(benchmark::State& state)
+{
+    const auto stream = makeAnnexBStream((int) state.range(0));
+    const uint8_t* const end = stream.data() + stream.size();
+
+    for (auto _: state)
+    {
+        int count = 0;
+        for (auto nal = findNextNAL(stream.data(), end); nal < end; nal = findNextNAL(nal, end))
+            ++count;
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(Nal_findNextNal)->Arg(256 * 1024);
+
+static void Nal_findNalUnitsAnnexB(benchmark::State& state)
+{
+    const auto stream = makeAnnexBStream((int) state.range(0));
+
+    for (auto _: state)
+        benchmark::DoNotOptimize(findNalUnitsAnnexB(stream.data(), (int32_t) stream.size()));
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(Nal_findNalUnitsAnnexB)->Arg(256 * 1024);
+
+} // namespace nx::media::nal::test
@@ -0,0 +1,13 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "nx_rtp_ini.h"
+
+namespace nx::rtp {
+
+Ini& ini()
+{
+    static Ini ini;
+    return ini;
+}
+
+} // namespace nx::rtp
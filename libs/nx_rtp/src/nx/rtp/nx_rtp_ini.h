@@ -0,0 +1,20 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <nx/kit/ini_config.h>
+
+namespace nx::rtp {
+
+struct NX_RTP_API Ini: nx::kit::IniConfig
+{
+    Ini(): IniConfig("nx_rtp.ini") { reload(); }
+
+    NX_INI_FLAG(1, directFrameReassembly,
+        "Write H.264/H.265 RTP payloads to the frame buffer as they arrive, instead of collecting\n"
+        "the chunk offsets and copying the chunks when the frame is complete.");
+};
+
+NX_RTP_API Ini& ini();
+
+} // namespace nx::rtp
@@ -5,6 +5,7 @@
 #include <nx/codec/h264/common.h>
 #include <nx/codec/h264/slice_header.h>
 #include <nx/media/ffmpeg_helper.h>
+#include <nx/rtp/nx_rtp_ini.h>
 #include <nx/rtp/rtp.h>
 #include <nx/utils/log/log.h>
 
@@ -14,6 +15,7 @@ static const int kMinIdrCountToDetectIFrameByIdr = 2;
 
 H264Parser::H264Parser():
     VideoStreamParser(),
+    m_chunks(ini().directFrameReassembly),
     m_spsInitialized(false),
     m_builtinSpsFound(false),
     m_builtinPpsFound(false),
@@ -171,6 +173,7 @@ void H264Parser::updateNalFlags(const uint8_t* data, int size)
         if (nalUnitType == nx::media::h264::nuSliceIDR)
         {
             m_keyDataExists = true;
+            m_chunks.setKeyFrame();
             if (m_idrCounter < kMinIdrCountToDetectIFrameByIdr)
             {
                 if (isFirstSliceNal(nalUnitType, data, size))
@@ -180,6 +183,7 @@ void H264Parser::updateNalFlags(const uint8_t* data, int size)
         else if (m_idrCounter < kMinIdrCountToDetectIFrameByIdr && nx::media::h264::isIFrame(data, size))
         {
             m_keyDataExists = true;
+            m_chunks.setKeyFrame();
         }
     }
 }
@@ -302,7 +306,7 @@ Result H264Parser::processData(
                         "Failed to parse RTP packet, invalid NAL unit length in STAP_A_PACKET")};
                 }
 
-                m_chunks.addChunk((int) (curPtr - rtpBufferBase), nalUnitLen, true);
+                m_chunks.addChunk(rtpBufferBase, (int) (curPtr - rtpBufferBase), nalUnitLen, true);
                 updateNalFlags(curPtr, bufferEnd - curPtr);
                 curPtr += nalUnitLen;
             }
@@ -368,6 +372,7 @@ Result H264Parser::processData(
                     *curPtr = nalUnitType;
             }
             m_chunks.addChunk(
+                rtpBufferBase,
                 (int) (curPtr - rtpBufferBase),
                 (quint16) (bufferEnd - curPtr),
                 m_packetPerNal == 0);
@@ -413,7 +418,7 @@ void H264Parser::handleSingleNalunitPacket(uint8_t* buffer, int offset, int size
     auto nalUnits = nx::media::nal::findNalUnitsAnnexB(buffer + offset, size, true);
     for (const auto& nalu: nalUnits)
     {
-        m_chunks.addChunk(nalu.data - buffer, nalu.size, true);
+        m_chunks.addChunk(buffer, nalu.data - buffer, nalu.size, true);
         updateNalFlags(nalu.data, nalu.size);
     }
 }
@@ -26,6 +26,7 @@ public:
         int bytesRead,
         bool& gotData) override;
     virtual void clear() override;
+    virtual bool retainsPacketBuffer() const override { return !m_chunks.isDirectMode(); }
 
 private:
     RtpChunkBuffer m_chunks;
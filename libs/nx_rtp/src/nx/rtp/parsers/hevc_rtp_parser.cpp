@@ -5,6 +5,7 @@
 #include <nx/codec/h265/sequence_parameter_set.h>
 #include <nx/codec/nal_units.h>
 #include <nx/media/ffmpeg_helper.h>
+#include <nx/rtp/nx_rtp_ini.h>
 #include <nx/utils/log/assert.h>
 #include <nx/utils/log/log.h>
 
@@ -34,7 +35,8 @@ bool isKeyFrame(const uint8_t* data, int64_t size)
 
 } // namespace
 
-HevcParser::HevcParser()
+HevcParser::HevcParser():
+    m_chunks(ini().directFrameReassembly)
 {
     StreamParser::setFrequency(90'000);
 }
@@ -225,7 +227,9 @@ void HevcParser::addChunk(
         m_gotData = true;
     }
 
-    m_chunks.addChunk(bufferOffset, payloadLength, hasStartCode);
+    m_chunks.addChunk(m_rtpBufferBase, bufferOffset, payloadLength, hasStartCode);
+    if (m_context.keyDataFound)
+        m_chunks.setKeyFrame();
 }
 
 Result HevcParser::handleSingleNalUnitPacket(
@@ -54,6 +54,7 @@ public:
         bool& gotData) override;
 
     virtual void clear() override;
+    virtual bool retainsPacketBuffer() const override { return !m_chunks.isDirectMode(); }
 
     // Implementation of StreamParser::setSDPInfo
     virtual void setSdpInfo(const Sdp::Media& sdp) override;
@@ -2,6 +2,7 @@
 
 #include "rtp_chunk_buffer.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include <nx/codec/nal_units.h>
@@ -9,14 +10,17 @@
 namespace {
 
 static const int kDefaultChunkContainerSize = 1024;
+static const size_t kMinFrameCapacity = 16 * 1024;
 
 } // namespace
 
 namespace nx::rtp {
 
-RtpChunkBuffer::RtpChunkBuffer()
+RtpChunkBuffer::RtpChunkBuffer(bool directMode):
+    m_directMode(directMode)
 {
-    m_chunks.reserve(kDefaultChunkContainerSize);
+    if (!m_directMode)
+        m_chunks.reserve(kDefaultChunkContainerSize);
 }
 
 int RtpChunkBuffer::size() const
@@ -24,22 +28,76 @@ int RtpChunkBuffer::size() const
     return m_videoFrameSize;
 }
 
-void RtpChunkBuffer::addChunk(int bufferOffset, uint16_t size, bool nalStart)
+void RtpChunkBuffer::addChunk(
+    const uint8_t* rtpBuffer, int bufferOffset, uint16_t size, bool nalStart)
 {
-    m_chunks.emplace_back(bufferOffset, size, nalStart);
     if (nalStart)
         m_videoFrameSize += sizeof(nx::media::nal::kNalUnitSizeLength);
     m_videoFrameSize += size;
+
+    if (!m_directMode)
+    {
+        m_chunks.emplace_back(bufferOffset, size, nalStart);
+        return;
+    }
+
+    if (!m_frame)
+    {
+        m_frame = QnWritableCompressedVideoDataPtr(
+            new QnWritableCompressedVideoData(expectedFrameSize()));
+    }
+
+    auto& data = m_frame->m_data;
+    if (nalStart)
+    {
+        finishNalUnit();
+        m_nalSizeOffset = (int) data.size();
+        data.writeFiller(0, nx::media::nal::kNalUnitSizeLength);
+    }
+    data.write((const char*) rtpBuffer + bufferOffset, size);
+}
+
+void RtpChunkBuffer::setKeyFrame()
+{
+    m_isKeyFrame = true;
+    if (m_frame)
+        m_frame->m_data.reserve(expectedFrameSize());
+}
+
+size_t RtpChunkBuffer::expectedFrameSize() const
+{
+    // Some room for the frames larger than the previous one.
+    const size_t size = m_isKeyFrame ? m_lastKeyFrameSize : m_lastFrameSize;
+    return std::max(size + size / 4, kMinFrameCapacity);
+}
+
+void RtpChunkBuffer::finishNalUnit()
+{
+    if (m_nalSizeOffset < 0)
+        return;
+
+    auto& data = m_frame->m_data;
+    const uint32_t sizeData = htonl(
+        (uint32_t) (data.size() - m_nalSizeOffset - nx::media::nal::kNalUnitSizeLength));
+    memcpy(data.data() + m_nalSizeOffset, &sizeData, sizeof(sizeData));
+    m_nalSizeOffset = -1;
 }
 
 void RtpChunkBuffer::clear()
 {
     m_videoFrameSize = 0;
     m_chunks.clear();
+    m_retainedBuffers.clear();
+    m_frame.reset();
+    m_nalSizeOffset = -1;
+    m_isKeyFrame = false;
 }
 
 void RtpChunkBuffer::backupCurrentData(const uint8_t* currentBufferBase)
 {
+    if (m_directMode)
+        return;
+
     int chunksLength = 0;
     for (const auto& chunk: m_chunks)
         chunksLength += chunk.size;
@@ -57,9 +115,45 @@ void RtpChunkBuffer::backupCurrentData(const uint8_t* currentBufferBase)
     }
 }
 
+void RtpChunkBuffer::backupCurrentData(const nx::SharedBuffer& currentBuffer)
+{
+    bool isBufferReferenced = false;
+    for (auto& chunk: m_chunks)
+    {
+        if (chunk.bufferStart)
+            continue;
+
+        NX_ASSERT(chunk.bufferOffset + chunk.size <= (int) currentBuffer.size());
+        chunk.bufferStart = (const uint8_t*) currentBuffer.data();
+        isBufferReferenced = true;
+    }
+
+    if (isBufferReferenced)
+        m_retainedBuffers.push_back(currentBuffer);
+}
+
 QnWritableCompressedVideoDataPtr RtpChunkBuffer::buildFrame(
     const uint8_t* rtpBuffer, const uint8_t* header, int headerSize)
 {
+    if (m_directMode)
+    {
+        if (!m_frame)
+            m_frame = QnWritableCompressedVideoDataPtr(new QnWritableCompressedVideoData());
+        finishNalUnit();
+
+        QnWritableCompressedVideoDataPtr result = std::move(m_frame);
+        auto& data = result->m_data;
+        (m_isKeyFrame ? m_lastKeyFrameSize : m_lastFrameSize) = data.size();
+        if (header && headerSize > 0)
+        {
+            const size_t size = data.size();
+            data.resize(size + headerSize);
+            memmove(data.data() + headerSize, data.data(), size);
+            memcpy(data.data(), header, headerSize);
+        }
+        return result;
+    }
+
     QnWritableCompressedVideoDataPtr result = QnWritableCompressedVideoDataPtr(
         new QnWritableCompressedVideoData(m_videoFrameSize + headerSize));
 
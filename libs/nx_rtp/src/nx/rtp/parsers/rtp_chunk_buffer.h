@@ -6,19 +6,59 @@
 #include <cstdint>
 
 #include <nx/media/video_data_packet.h>
+#include <nx/utils/shared_buffer.h>
 
 namespace nx::rtp {
 
-class RtpChunkBuffer
+/**
+ * Collects the NAL unit chunks of a video frame from the RTP packets and builds the frame with
+ * the NAL units prefixed by their sizes.
+ */
+class NX_RTP_API RtpChunkBuffer
 {
 public:
-    RtpChunkBuffer();
-    void addChunk(int bufferOffset, uint16_t len, bool nalStart = false);
+    /**
+     * @param directMode If true, the chunks are written to the frame buffer as they are added, so
+     *     buildFrame() does not copy them and backupCurrentData() has nothing to copy. The frame
+     *     buffer is preallocated with the size of the previous frame of the same kind, see
+     *     setKeyFrame(). Otherwise only the chunk offsets are stored until buildFrame().
+     */
+    explicit RtpChunkBuffer(bool directMode = false);
+
+    /**
+     * @param rtpBuffer The buffer the offset is relative to. It is only read in the direct mode,
+     *     otherwise the same buffer is to be passed to buildFrame() or backupCurrentData().
+     */
+    void addChunk(const uint8_t* rtpBuffer, int bufferOffset, uint16_t len, bool nalStart = false);
+
+    /**
+     * Marks the frame being collected as a key one. In the direct mode the frame buffer is
+     * enlarged to the size of the previous key frame at once instead of growing step by step.
+     */
+    void setKeyFrame();
+
+    /**
+     * @param header Data to put before the chunks, e.g. the parameter sets from SDP. In the
+     *     direct mode the chunks are moved to make room for it.
+     */
     QnWritableCompressedVideoDataPtr buildFrame(
         const uint8_t* rtpBuffer, const uint8_t* header, int headerSize);
+
+    /**
+     * Copies the chunks which are still in the receive buffer, since the buffer is reused for
+     * the next packets. Does nothing in the direct mode.
+     */
     void backupCurrentData(const uint8_t* currentBufferBase);
+
+    /**
+     * Same as above, but keeps a reference to the buffer instead of copying the chunks. The
+     * buffer is released by clear().
+     * @param currentBuffer The buffer the chunk offsets are relative to.
+     */
+    void backupCurrentData(const nx::SharedBuffer& currentBuffer);
     void clear();
     int size() const;
+    bool isDirectMode() const { return m_directMode; }
 
 private:
     struct Chunk
@@ -32,16 +72,28 @@ private:
         {
         }
 
-        uint8_t* bufferStart = nullptr;
+        const uint8_t* bufferStart = nullptr;
         int bufferOffset = 0;
         uint16_t size = 0;
         bool nalStart = false;
     };
 
+    size_t expectedFrameSize() const;
+    void finishNalUnit();
+
 private:
+    const bool m_directMode;
     int m_videoFrameSize = 0;
     std::vector<Chunk> m_chunks;
     std::vector<uint8_t> m_nextFrameChunksBuffer;
+    std::vector<nx::SharedBuffer> m_retainedBuffers;
+
+    /** Direct mode state. */
+    QnWritableCompressedVideoDataPtr m_frame;
+    int m_nalSizeOffset = -1; //< Position of the size of the NAL unit being written.
+    bool m_isKeyFrame = false;
+    size_t m_lastFrameSize = 0;
+    size_t m_lastKeyFrameSize = 0;
 };
 
 } // namespace nx::rtp
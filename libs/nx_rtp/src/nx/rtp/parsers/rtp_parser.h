@@ -21,6 +21,7 @@ public:
     QnAbstractMediaDataPtr nextData(const nx::rtp::RtcpSenderReport& senderReport);
     QString idForToStringFromPtr() const;
     bool isUtcTime();
+    bool retainsPacketBuffer() const { return m_codecParser->retainsPacketBuffer(); }
 
 private:
     Result processRtpExtension(
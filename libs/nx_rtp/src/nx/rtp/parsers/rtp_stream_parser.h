@@ -34,6 +34,13 @@ public:
 
     virtual bool forceProcessEmptyData() const { return false; }
 
+    /**
+     * @return False if the parser does not reference the packet buffer after processData()
+     *     returns, so the caller may pass a slice of its receive buffer and reuse it right away.
+     *     Otherwise the buffer is to stay intact until the parser reports gotData.
+     */
+    virtual bool retainsPacketBuffer() const { return true; }
+
     int getFrequency() const { return m_frequency; };
     virtual bool isUtcTime() const { return false; }
     void setLogId(const std::string& id) { m_id = id; }
@@ -2,7 +2,11 @@
 
 #include "reordering_cache.h"
 
+#include <algorithm>
+#include <bit>
+
 #include <nx/utils/log/log.h>
+#include <nx/utils/time.h>
 
 namespace nx::rtp {
 
@@ -12,9 +16,10 @@ constexpr int kMaxCacheSize = std::numeric_limits<uint16_t>::max() / 2;
 // Can't make any reorder with limit < 2.
 constexpr int kMinCacheSize = 2;
 
-ReorderingCache::ReorderingCache(int queueLimit)
+ReorderingCache::ReorderingCache(int queueLimit, std::chrono::milliseconds maxDelay)
     :
-    m_queueLimit(std::min(queueLimit, kMaxCacheSize))
+    m_queueLimit(std::min(queueLimit, kMaxCacheSize)),
+    m_maxDelay(maxDelay)
 {
 }
 
@@ -28,6 +33,7 @@ ReorderingCache::Status ReorderingCache::pushPacket(
     if (!m_lastSeq) //< First packet.
     {
         m_lastSeq = linearized;
+        m_windowStart = linearized + 1;
         return ReorderingCache::Status::pass;
     }
 
@@ -38,17 +44,28 @@ ReorderingCache::Status ReorderingCache::pushPacket(
         return ReorderingCache::Status::pass;
     }
     if (linearized - *m_lastSeq == 1
-        && m_lostSequences.empty()) //< Normal case without any drops.
+        && m_lostCount == 0) //< Normal case without any drops.
     {
-        NX_ASSERT(m_packets.empty());
+        NX_ASSERT(getTotalSize() == 0);
         *m_lastSeq = linearized;
+        m_windowStart = linearized + 1;
         return ReorderingCache::Status::pass;
     }
 
     if (outOfQueue(linearized))
         return ReorderingCache::Status::skip;
 
-    insertPacket({packet, linearized});
+    if (m_slots.empty())
+    {
+        // The window is at most twice the limit: the limit is checked before the insertion. The
+        // ring consists of whole bitmap words.
+        const auto size = std::max<size_t>(std::bit_ceil((size_t) m_queueLimit * 2), 64);
+        m_slots.resize(size);
+        m_lostBits.resize((size + 63) / 64);
+        m_slotMask = (int64_t) size - 1;
+    }
+
+    insertPacket(packet, linearized);
 
     popPackets();
 
@@ -56,7 +73,7 @@ ReorderingCache::Status ReorderingCache::pushPacket(
     {
         return Status::flush;
     }
-    else if (!m_lostSequences.empty())
+    else if (m_lostCount > 0)
     {
         return Status::wait;
     }
@@ -67,113 +84,196 @@ ReorderingCache::Status ReorderingCache::pushPacket(
     }
 }
 
-bool ReorderingCache::outOfQueue(int64_t linearized)
+bool ReorderingCache::outOfQueue(int64_t linearized) const
+{
+    return linearized < m_windowStart && (!m_lastSeq || *m_lastSeq >= linearized);
+}
+
+bool ReorderingCache::isLost(int64_t linearized) const
+{
+    const int64_t index = linearized & m_slotMask;
+    return m_lostBits[index / 64] & (1ull << (index % 64));
+}
+
+void ReorderingCache::setLost(int64_t linearized, bool value)
 {
-    bool outOfPackets = (m_packets.empty() || linearized < m_packets.front().second);
-    bool outOfLost = (m_lostSequences.empty() || linearized < m_lostSequences.front());
-    bool outOfSeq = (!m_lastSeq || *m_lastSeq >= linearized);
-    return outOfPackets && outOfLost && outOfSeq;
+    const int64_t index = linearized & m_slotMask;
+    if (value)
+        m_lostBits[index / 64] |= 1ull << (index % 64);
+    else
+        m_lostBits[index / 64] &= ~(1ull << (index % 64));
+    m_lostCount += value ? 1 : -1;
 }
 
 void ReorderingCache::popPackets()
 {
-    NX_ASSERT(!m_packets.empty());
-    while (!m_packets.empty() || !m_lostSequences.empty())
+    NX_ASSERT(getTotalSize() > 0);
+    const auto now = nx::utils::monotonicTime();
+    for (; m_windowStart <= *m_lastSeq; ++m_windowStart)
     {
-        bool popPackets = false; //< Pop packets queue or lost sequences queue.
-        if (!m_packets.empty() && m_lostSequences.empty())
-        {
-            popPackets = true;
-        }
-        else if (m_packets.empty() && !m_lostSequences.empty())
-        {
-            popPackets = false;
-        }
-        else
-        {
-            auto firstSequence = m_packets.front().second;
-            auto firstLostSequence = m_lostSequences.front();
-            NX_ASSERT(firstSequence != firstLostSequence);
-            popPackets = (firstSequence < firstLostSequence);
-        }
-        if (popPackets)
+        if (!isLost(m_windowStart))
         {
             // It's a packet.
-            m_packetsToFlush.emplace_back(std::move(m_packets.front().first));
-            m_packets.pop_front();
-        }
-        else
-        {
-            // It's a lost packet.
-            if (getTotalSize() <= m_queueLimit)
-                break;
-            m_lostSequences.pop_front();
+            m_packetsToFlush.emplace_back(std::move(slot(m_windowStart).packet));
+            continue;
         }
+
+        // It's a lost packet.
+        const bool isExpired = m_maxDelay > std::chrono::milliseconds::zero()
+            && now - slot(m_windowStart).lostSince >= m_maxDelay;
+        if (getTotalSize() <= m_queueLimit && !isExpired)
+            break;
+        setLost(m_windowStart, false);
+        ++m_statistics.unrecoverablePackets;
     }
 }
 
-void ReorderingCache::insertPacket(const Packet& packet)
+void ReorderingCache::insertPacket(const nx::utils::ByteArray& packet, int64_t linearized)
 {
-    auto pos = std::lower_bound(
-        m_packets.begin(),
-        m_packets.end(),
-        packet.second,
-        [](const Packet& packet, int64_t linearized)
+    if (linearized > *m_lastSeq)
+    {
+        NX_ASSERT(linearized - *m_lastSeq <= m_queueLimit);
+        const auto now = nx::utils::monotonicTime();
+        while ((++*m_lastSeq) != linearized)
         {
-            return packet.second < linearized;
-        });
-    if (pos == m_packets.end())
+            setLost(*m_lastSeq, true);
+            auto& lostSlot = slot(*m_lastSeq);
+            lostSlot.lostSince = now;
+            lostSlot.requestCount = 0;
+        }
+    }
+    else if (isLost(linearized))
     {
-        NX_ASSERT(packet.second >= *m_lastSeq && packet.second - *m_lastSeq <= m_queueLimit);
-        while ((++*m_lastSeq) != packet.second)
-            m_lostSequences.push_back(*m_lastSeq);
+        setLost(linearized, false);
+        if (slot(linearized).requestCount > 0)
+            ++m_statistics.recoveredPackets;
     }
-    else if (pos->second == packet.second)
+
+    // Duplicates replace the stored packet.
+    auto& storedPacket = slot(linearized).packet;
+    if (storedPacket.capacity() == 0 && !m_freeBuffers.empty())
     {
-        pos = m_packets.erase(pos);
+        storedPacket = std::move(m_freeBuffers.back());
+        m_freeBuffers.pop_back();
+    }
+    if (storedPacket.capacity() == 0)
+    {
+        storedPacket = packet;
+    }
+    else
+    {
+        storedPacket.clear();
+        storedPacket.write(packet.constData(), packet.size());
     }
-    std::erase(m_lostSequences, packet.second);
-    m_packets.insert(pos, packet);
 }
 
-int ReorderingCache::getTotalSize() const
+int64_t ReorderingCache::getTotalSize() const
 {
-    return m_packets.size() + m_lostSequences.size();
+    return m_lastSeq ? *m_lastSeq - m_windowStart + 1 : 0;
 }
 
 void ReorderingCache::resetState(int64_t linearized)
 {
-    m_packets.clear();
-    m_lostSequences.clear();
+    for (; m_lastSeq && m_windowStart <= *m_lastSeq; ++m_windowStart)
+    {
+        if (isLost(m_windowStart))
+        {
+            setLost(m_windowStart, false);
+            ++m_statistics.unrecoverablePackets;
+        }
+        else
+            slot(m_windowStart).packet.clear();
+    }
     m_lastSeq = linearized;
+    m_windowStart = linearized + 1;
 }
 
 bool ReorderingCache::getNextPacket(nx::utils::ByteArray& outputPacket)
 {
     if (m_packetsToFlush.empty())
         return false;
-    outputPacket = std::move(m_packetsToFlush.front());
+    std::swap(outputPacket, m_packetsToFlush.front());
+    if (m_packetsToFlush.front().capacity() > 0 && m_freeBuffers.size() < m_slots.size())
+        m_freeBuffers.push_back(std::move(m_packetsToFlush.front()));
     m_packetsToFlush.pop_front();
     return true;
 }
 
+template<typename Handler>
+void ReorderingCache::forEachLost(Handler handler) const
+{
+    if (m_lostCount == 0)
+        return;
+
+    for (int64_t seq = m_windowStart; seq <= *m_lastSeq; )
+    {
+        // Scan the bitmap word by word, up to the end of the word or of the ring.
+        const int64_t index = seq & m_slotMask;
+        const int bit = (int) (index % 64);
+        const uint64_t word = m_lostBits[index / 64] >> bit;
+        if (word == 0)
+        {
+            seq += 64 - bit;
+            continue;
+        }
+        seq += std::countr_zero(word);
+        if (seq > *m_lastSeq)
+            break;
+        handler(seq);
+        ++seq;
+    }
+}
+
 std::optional<RtcpNackReport> ReorderingCache::getNextNackPacket(
     uint16_t sourceSsrc, uint16_t senderSsrc) const
 {
-    if (m_lostSequences.empty())
+    if (m_lostCount == 0)
         return std::nullopt;
-    std::vector<uint16_t> sequences(m_lostSequences.size());
-    std::transform(
-        m_lostSequences.begin(),
-        m_lostSequences.end(),
-        sequences.begin(),
-        [](int64_t linearized)
-        {
-            return (uint16_t) linearized;
-        });
+
+    std::vector<uint16_t> sequences;
+    sequences.reserve(m_lostCount);
+    forEachLost([&sequences](int64_t seq) { sequences.push_back((uint16_t) seq); });
     // A simple way - for any moment report about all lost sequences.
     // Maybe this logic should be corrected in future.
     return buildNackReport(sourceSsrc, senderSsrc, sequences);
 }
 
+std::optional<RtcpNackReport> ReorderingCache::takeNackReport(
+    uint32_t sourceSsrc, uint32_t senderSsrc)
+{
+    if (m_lostCount == 0)
+        return std::nullopt;
+
+    const auto now = nx::utils::monotonicTime();
+    if (m_lastNackTime && now - *m_lastNackTime < m_nackSettings.aggregationInterval)
+        return std::nullopt;
+
+    // The retransmission of the previous request can't arrive earlier than in RTT.
+    const auto retryInterval = std::max<std::chrono::microseconds>(
+        m_roundTripTime + m_roundTripTime / 2, m_nackSettings.aggregationInterval);
+
+    std::vector<uint16_t> sequences;
+    forEachLost(
+        [&](int64_t seq)
+        {
+            auto& lostSlot = m_slots[seq & m_slotMask];
+            if (lostSlot.requestCount >= m_nackSettings.maxRequests)
+                return;
+            if (lostSlot.requestCount > 0 && now - lostSlot.lastRequested < retryInterval)
+            {
+                ++m_statistics.suppressedRequests;
+                return;
+            }
+            lostSlot.lastRequested = now;
+            ++lostSlot.requestCount;
+            sequences.push_back((uint16_t) seq);
+        });
+    if (sequences.empty())
+        return std::nullopt;
+
+    m_lastNackTime = now;
+    m_statistics.requestedPackets += (int64_t) sequences.size();
+    return buildNackReport(sourceSsrc, senderSsrc, sequences);
+}
+
 } // namespace nx::rtp
@@ -2,8 +2,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <deque>
-#include <list>
+#include <vector>
 
 #include <nx/utils/byte_array.h>
 
@@ -12,6 +13,11 @@
 
 namespace nx::rtp {
 
+/**
+ * Restores the order of the RTP packets. The window of the awaited sequences is kept in a ring
+ * indexed by the sequence number, the lost sequences are marked in a bitmap, so a packet is
+ * inserted in O(1) and nothing is allocated per packet once the buffers are reused.
+ */
 class NX_RTP_API ReorderingCache
 {
 public:
@@ -23,27 +29,81 @@ public:
         flush, /**< Reordering is done, can flush the frames from the reorderer. */
     };
 public:
-    ReorderingCache(int queueLimit = (int) kRtcpNackQueueSize);
+    /**
+     * @param queueLimit Maximum number of the packets and the lost sequences in the window. The
+     *     oldest lost sequence is given up when the limit is exceeded.
+     * @param maxDelay If not zero, a lost sequence is also given up when it has been awaited
+     *     that long, so the delay added by the reordering does not depend on the bitrate.
+     */
+    ReorderingCache(
+        int queueLimit = (int) kRtcpNackQueueSize,
+        std::chrono::milliseconds maxDelay = std::chrono::milliseconds::zero());
     Status pushPacket(const nx::utils::ByteArray& packet, uint16_t seq);
-    // Call on `flush` status.
+    // Call on `flush` status. The previous buffer of outputPacket is reused for the next packets.
     bool getNextPacket(nx::utils::ByteArray& outputPacket);
     // Call on `wait` status.
     std::optional<RtcpNackReport> getNextNackPacket(uint16_t sourceSsrc, uint16_t senderSsrc) const;
+
+    struct NackSettings
+    {
+        /** The losses detected within this interval are requested by a single report. */
+        std::chrono::milliseconds aggregationInterval{20};
+        /** Maximum number of the requests of a lost sequence. */
+        int maxRequests = 3;
+    };
+    void setNackSettings(const NackSettings& settings) { m_nackSettings = settings; }
+
+    /**
+     * A lost sequence is requested again only if it has not arrived within one and a half RTT
+     * after the previous request.
+     */
+    void setRoundTripTime(std::chrono::microseconds value) { m_roundTripTime = value; }
+
+    /**
+     * Aggregating alternative to getNextNackPacket() for calling on each packet: returns a report
+     * at most once per NackSettings::aggregationInterval, and only with the sequences that are
+     * not requested yet or are due for a retry.
+     */
+    std::optional<RtcpNackReport> takeNackReport(uint32_t sourceSsrc, uint32_t senderSsrc);
+
+    const RtcpNackStatistics& statistics() const { return m_statistics; }
+
 private:
-    using Packet = std::pair<nx::utils::ByteArray, int64_t>;
+    struct Slot
+    {
+        nx::utils::ByteArray packet;
+        std::chrono::steady_clock::time_point lostSince;
+        std::chrono::steady_clock::time_point lastRequested;
+        int requestCount = 0;
+    };
 private:
     void resetState(int64_t linearized);
     void popPackets();
-    void insertPacket(const Packet& packet);
-    bool outOfQueue(int64_t seq);
-    int getTotalSize() const;
+    void insertPacket(const nx::utils::ByteArray& packet, int64_t linearized);
+    bool outOfQueue(int64_t seq) const;
+    int64_t getTotalSize() const;
+    Slot& slot(int64_t linearized) { return m_slots[linearized & m_slotMask]; }
+    bool isLost(int64_t linearized) const;
+    void setLost(int64_t linearized, bool value);
+    template<typename Handler>
+    void forEachLost(Handler handler) const;
 private:
-    std::deque<Packet> m_packets;
-    std::list<nx::utils::ByteArray> m_packetsToFlush;
-    std::deque<int64_t> m_lostSequences;
+    /** Window of the awaited sequences is [m_windowStart, *m_lastSeq]. */
+    std::vector<Slot> m_slots;
+    std::vector<uint64_t> m_lostBits;
+    int64_t m_slotMask = 0;
+    int64_t m_windowStart = 0;
+    int m_lostCount = 0;
+    std::deque<nx::utils::ByteArray> m_packetsToFlush;
+    std::vector<nx::utils::ByteArray> m_freeBuffers;
     std::optional<int64_t> m_lastSeq;
     TimeLinearizer<uint16_t> m_linearizer;
     int m_queueLimit = 0;
+    std::chrono::milliseconds m_maxDelay{0};
+    NackSettings m_nackSettings;
+    std::chrono::microseconds m_roundTripTime = kRtcpNackDefaultRoundTripTime;
+    std::optional<std::chrono::steady_clock::time_point> m_lastNackTime;
+    RtcpNackStatistics m_statistics;
 };
 
 } // namespace nx::rtp
@@ -163,34 +163,24 @@ RtcpNackReport buildNackReport(
     if (sequences.empty())
         return result;
 
-    std::optional<uint16_t> startSequence;
-    uint16_t sequenceMask = 0;
     constexpr int kMaxSequenceNumber = 4096;
     int sequenceLimit = std::min(kMaxSequenceNumber, (int) sequences.size());
     for (int i = 0; i < sequenceLimit; ++i)
     {
-        if (!startSequence)
-            startSequence = sequences[i];
-        bool isStart = (*startSequence == sequences[i]);
-        bool isLast = (i == (int) sequences.size() - 1);
-        bool isOutOfMask = (sequences[i] - *startSequence > 16 || sequences[i] < *startSequence);
-        if (!isOutOfMask && !isStart)
+        // The distance is modulo 2^16, so a part is not split at the sequence number wraparound.
+        if (!result.nacks.empty())
         {
-            sequenceMask |= (1 << (sequences[i] - *startSequence - 1));
-        }
-        if (isLast || isOutOfMask)
-        {
-            result.nacks.emplace_back(RtcpNackPart{*startSequence, sequenceMask});
-            sequenceMask = 0;
-        }
-        if (isOutOfMask)
-        {
-            *startSequence = sequences[i];
-        }
-        if (isLast && isOutOfMask)
-        {
-            result.nacks.emplace_back(RtcpNackPart{*startSequence, sequenceMask});
+            auto& part = result.nacks.back();
+            const uint16_t distance = sequences[i] - part.pid;
+            if (distance == 0)
+                continue;
+            if (distance <= 16)
+            {
+                part.blp |= 1 << (distance - 1);
+                continue;
+            }
         }
+        result.nacks.emplace_back(RtcpNackPart{sequences[i], 0});
     }
     result.header.length += result.nacks.size();
     return result;
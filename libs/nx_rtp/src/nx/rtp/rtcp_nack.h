@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <deque>
 #include <vector>
 
@@ -12,6 +13,26 @@ namespace nx::rtp {
 
 constexpr size_t kRtcpNackQueueSize = 1024;
 
+/** Used until the actual round trip time of the stream is known. */
+constexpr std::chrono::milliseconds kRtcpNackDefaultRoundTripTime(100);
+
+/** Counters of the packet retransmission requested by RTCP NACK. */
+struct RtcpNackStatistics
+{
+    /** Sequence numbers sent (by the receiver) or received (by the sender) in the reports. */
+    int64_t requestedPackets = 0;
+    /** Requests skipped because the packet was requested or resent less than RTT ago. */
+    int64_t suppressedRequests = 0;
+    /** Packets resent by the sender. */
+    int64_t retransmittedPackets = 0;
+    /** Lost packets that arrived after they had been requested. */
+    int64_t recoveredPackets = 0;
+    /** Lost packets given up by the receiver, or requested ones missing in the sender history. */
+    int64_t unrecoverablePackets = 0;
+
+    bool operator==(const RtcpNackStatistics& other) const = default;
+};
+
 struct NX_RTP_API RtcpNackPart
 {
     uint16_t pid;
@@ -46,6 +67,10 @@ struct NX_RTP_API RtcpNackReport
     bool operator==(const RtcpNackReport& lhs) const = default;
 };
 
+/**
+ * @param sequences Lost sequence numbers, preferably in ascending order: each sequence within 16
+ *     after the PID of the current part is packed into its BLP bitmask.
+ */
 NX_RTP_API RtcpNackReport buildNackReport(
     uint32_t sourceSsrc,
     uint32_t senderSsrc,
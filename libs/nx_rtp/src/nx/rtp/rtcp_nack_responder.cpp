@@ -2,13 +2,18 @@
 
 #include "rtcp_nack_responder.h"
 
+#include <algorithm>
+#include <bit>
+
 #include <nx/utils/log/log.h>
+#include <nx/utils/time.h>
 
 namespace nx::rtp {
 
-RtcpNackResponder::RtcpNackResponder(size_t queueLimit)
+RtcpNackResponder::RtcpNackResponder(size_t queueLimit, size_t memoryLimit)
     :
-    m_queueLimit(std::min(queueLimit, (size_t) std::numeric_limits<uint16_t>::max()))
+    m_queueLimit(std::min(queueLimit, (size_t) std::numeric_limits<uint16_t>::max())),
+    m_memoryLimit(memoryLimit)
 {
 }
 
@@ -16,22 +21,58 @@ void RtcpNackResponder::pushPacket(const nx::utils::ByteArray& packet, uint16_t
 {
     if (m_queueLimit == 0)
         return;
-    if (m_packets.size() == m_queueLimit)
+    if (m_entries.empty())
     {
-        m_packets.pop_front();
-        ++m_startSeq;
+        m_entries.resize(std::bit_ceil(m_queueLimit));
+        m_mask = m_entries.size() - 1;
     }
-    if (m_packets.size() == 0)
-        m_startSeq = seq;
 
-    if (((uint16_t) (m_startSeq + (uint16_t) m_packets.size())) != seq)
+    if (m_size > 0 && (uint16_t) (m_startSeq + m_size) != seq)
     {
         NX_DEBUG(this, "Pushed unexpected sequence number: %1, expected %2. Cleanup queue.",
-            (int) seq, (uint16_t) (m_startSeq + (uint16_t) m_packets.size()));
-        m_packets.clear();
+            (int) seq, (uint16_t) (m_startSeq + m_size));
+        while (m_size > 0)
+            popFront();
+    }
+    while (m_size > 0
+        && (m_size == m_queueLimit || m_totalBytes + packet.size() > m_memoryLimit))
+    {
+        popFront();
+    }
+    if (m_size == 0)
         m_startSeq = seq;
+
+    // The buffer of the dropped packet in this entry is reused.
+    auto& entry = m_entries[seq & m_mask];
+    if (entry.packet.capacity() == 0)
+    {
+        entry.packet = packet;
+    }
+    else
+    {
+        entry.packet.clear();
+        entry.packet.write(packet.constData(), packet.size());
     }
-    m_packets.emplace_back(packet);
+    entry.lastSent.reset();
+    entry.isRequested = false;
+    m_totalBytes += packet.size();
+    ++m_size;
+}
+
+void RtcpNackResponder::popFront()
+{
+    auto& entry = m_entries[m_startSeq & m_mask];
+    m_totalBytes -= entry.packet.size();
+    entry.packet.clear();
+    entry.isRequested = false;
+    ++m_startSeq;
+    --m_size;
+}
+
+RtcpNackResponder::Entry* RtcpNackResponder::find(uint16_t seq)
+{
+    const uint16_t offset = seq - m_startSeq;
+    return offset < m_size ? &m_entries[seq & m_mask] : nullptr;
 }
 
 void RtcpNackResponder::pushRtcpNack(const uint8_t* data, int size)
@@ -48,26 +89,50 @@ void RtcpNackResponder::pushRtcpNack(const uint8_t* data, int size)
         }
         NX_VERBOSE(this, "Got NACK for seqs: %1", ss.str());
     }
-    m_reports.insert(m_reports.end(), reports.begin(), reports.end());
+    m_statistics.requestedPackets += (int64_t) reports.size();
+    for (const auto seq: reports)
+    {
+        // The same sequence may be requested by several reports before it is resent.
+        Entry* entry = find(seq);
+        if (entry && entry->isRequested)
+        {
+            ++m_statistics.suppressedRequests;
+            continue;
+        }
+        if (entry)
+            entry->isRequested = true;
+        m_reports.push_back(seq);
+    }
 }
 
 bool RtcpNackResponder::getNextPacket(nx::utils::ByteArray& outputPacket)
 {
+    const auto now = nx::utils::monotonicTime();
     while (m_reports.size())
     {
         const auto report = m_reports.front();
         m_reports.pop_front();
-        size_t offset = report < m_startSeq
-            ? (std::numeric_limits<uint16_t>::max() - m_startSeq + report + 1)
-            : report - m_startSeq;
-        if (offset < m_packets.size())
+        Entry* entry = find(report);
+        if (!entry)
+        {
+            NX_VERBOSE(this,
+                "Failed to re-send out of queue packet with seq: %1 (start seq: %2, size: %3)",
+                (int) report, m_startSeq, m_size);
+            ++m_statistics.unrecoverablePackets;
+            continue;
+        }
+        entry->isRequested = false;
+        if (entry->lastSent && now - *entry->lastSent < m_roundTripTime / 2)
         {
-            NX_VERBOSE(this, "Re-send packet with seq: %1", (int) report);
-            outputPacket = m_packets[offset];
-            return true;
+            NX_VERBOSE(this, "Skip the repeated request of the packet with seq: %1", (int) report);
+            ++m_statistics.suppressedRequests;
+            continue;
         }
-        NX_VERBOSE(this, "Failed to re-send out of queue packet with seq: %1 (start seq: %2, size: %3, offset: %4)",
-            (int) report, m_startSeq, m_packets.size(), offset);
+        NX_VERBOSE(this, "Re-send packet with seq: %1", (int) report);
+        entry->lastSent = now;
+        ++m_statistics.retransmittedPackets;
+        outputPacket = entry->packet;
+        return true;
     }
     return false;
 }
@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include <chrono>
 #include <deque>
+#include <optional>
+#include <vector>
 
 #include <nx/utils/byte_array.h>
 
@@ -10,18 +13,58 @@
 
 namespace nx::rtp {
 
+/** Default memory limit of the retransmission history of a stream. */
+constexpr size_t kRtcpNackHistoryMemoryLimit = 2 * 1024 * 1024;
+
+/**
+ * Keeps the history of the sent packets in a ring indexed by the sequence number and resends the
+ * ones requested by RTCP NACK.
+ */
 class NX_RTP_API RtcpNackResponder
 {
 public:
-    RtcpNackResponder(size_t queueLimit = kRtcpNackQueueSize);
+    /**
+     * @param queueLimit Maximum number of the packets in the history.
+     * @param memoryLimit Maximum total size of the packets in the history. The oldest packets are
+     *     dropped when any of the limits is exceeded.
+     */
+    RtcpNackResponder(
+        size_t queueLimit = kRtcpNackQueueSize,
+        size_t memoryLimit = kRtcpNackHistoryMemoryLimit);
     void pushPacket(const nx::utils::ByteArray& packet, uint16_t seq);
     void pushRtcpNack(const uint8_t* data, int size);
     bool getNextPacket(nx::utils::ByteArray& outputPacket);
+
+    /**
+     * A request of the packet resent less than half of RTT ago is ignored: the peer has sent it
+     * before the retransmission could arrive.
+     */
+    void setRoundTripTime(std::chrono::microseconds value) { m_roundTripTime = value; }
+
+    const RtcpNackStatistics& statistics() const { return m_statistics; }
+
 private:
-    std::deque<nx::utils::ByteArray> m_packets;
-    std::deque<uint16_t> m_reports;
+    struct Entry
+    {
+        nx::utils::ByteArray packet;
+        std::optional<std::chrono::steady_clock::time_point> lastSent;
+        bool isRequested = false;
+    };
+
+    Entry* find(uint16_t seq);
+    void popFront();
+
+private:
+    std::vector<Entry> m_entries;
+    size_t m_mask = 0;
     uint16_t m_startSeq = 0;
+    size_t m_size = 0;
+    size_t m_totalBytes = 0;
+    std::deque<uint16_t> m_reports;
     size_t m_queueLimit = 0;
+    size_t m_memoryLimit = 0;
+    std::chrono::microseconds m_roundTripTime = kRtcpNackDefaultRoundTripTime;
+    RtcpNackStatistics m_statistics;
 };
 
 } // namespace nx::rtp
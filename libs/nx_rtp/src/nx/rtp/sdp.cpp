@@ -2,24 +2,87 @@
 
 #include "sdp.h"
 
+#include <algorithm>
+#include <optional>
+
 #include <nx/utils/log/assert.h>
+#include <nx/utils/std_string_utils.h>
 
 namespace nx::rtp {
 
-static Sdp::MediaType mediaTypeFromString(const QString& value)
+namespace {
+
+static constexpr std::string_view kControlPrefix = "a=control:";
+
+/** The token of str split by the separator, empty tokens included, as QString::split() does. */
+std::optional<std::string_view> fieldAt(
+    std::string_view str, char separator, size_t index, bool skipEmpty = false)
+{
+    for (;;)
+    {
+        const auto end = str.find(separator);
+        const auto token = str.substr(0, end);
+        if (!skipEmpty || !token.empty())
+        {
+            if (index == 0)
+                return token;
+            --index;
+        }
+        if (end == std::string_view::npos)
+            return std::nullopt;
+        str.remove_prefix(end + 1);
+    }
+}
+
+template<typename Func>
+void forEachField(std::string_view str, char separator, Func func)
+{
+    for (;;)
+    {
+        const auto end = str.find(separator);
+        func(str.substr(0, end));
+        if (end == std::string_view::npos)
+            return;
+        str.remove_prefix(end + 1);
+    }
+}
+
+/** Behaves like QString::toInt(): the whole trimmed string must be a number, 0 otherwise. */
+template<typename Value>
+Value toNumber(std::optional<std::string_view> str)
+{
+    if (!str)
+        return Value();
+    const auto value = nx::utils::trim(*str);
+    std::size_t pos = 0;
+    const auto result = nx::utils::ston<Value>(value, &pos, 10);
+    return pos == value.size() && !value.empty() ? result : Value();
+}
+
+QString toQString(std::string_view str)
 {
-    QString trackTypeStr = value.toLower();
-    if (trackTypeStr == "audio")
+    return QString::fromUtf8(str.data(), (qsizetype) str.size());
+}
+
+bool startsWith(std::string_view line, std::string_view prefix)
+{
+    return nx::utils::startsWith(line, prefix, nx::utils::CaseSensitivity::off);
+}
+
+Sdp::MediaType mediaTypeFromString(std::string_view value)
+{
+    const auto is = [value](std::string_view type) { return nx::utils::stricmp(value, type) == 0; };
+    if (is("audio"))
         return Sdp::MediaType::Audio;
-    else if (trackTypeStr == "video")
+    else if (is("video"))
         return Sdp::MediaType::Video;
-    else if (trackTypeStr == "metadata" || trackTypeStr == "application")
+    else if (is("metadata") || is("application"))
         return Sdp::MediaType::Metadata;
     else
         return Sdp::MediaType::Unknown;
 }
 
-static QString toString(Sdp::MediaType mediaType)
+QString toString(Sdp::MediaType mediaType)
 {
     switch (mediaType)
     {
@@ -38,7 +101,7 @@ static QString toString(Sdp::MediaType mediaType)
 }
 
 // see rfc1890 for full RTP predefined codec list
-static QString findCodecById(int num)
+QString findCodecById(int num)
 {
     switch (num)
     {
@@ -49,90 +112,97 @@ static QString findCodecById(int num)
     }
 }
 
-static QHostAddress parseConnectionAddress(const QString& line)
+QHostAddress parseConnectionAddress(std::string_view line)
 {
-    auto fields = line.split(' ');
-    if (fields.size() >= 3 && fields[1].toUpper() == "IP4")
-        return QHostAddress(fields[2].split('/').front());
+    const auto addressType = fieldAt(line, ' ', 1);
+    const auto address = fieldAt(line, ' ', 2);
+    if (addressType && address && nx::utils::stricmp(*addressType, "IP4") == 0)
+        return QHostAddress(toQString(*fieldAt(*address, '/', 0)));
     return QHostAddress();
 }
 
-static uint32_t parseSsrc(const QString& line)
+uint32_t parseSsrc(std::string_view line)
 {
-    uint32_t ssrc = 0;
-    auto splittedBySpace = line.split(" ", Qt::SkipEmptyParts);
-    if (!splittedBySpace.empty())
-    {
-        auto splittedByColon = splittedBySpace[0].split(":", Qt::SkipEmptyParts);
-        if (splittedByColon.size() > 1)
-        {
-            ssrc = (uint32_t) splittedByColon[1].toULong();
-        }
-    }
-    return ssrc;
+    const auto ssrcField = fieldAt(line, ' ', 0, /*skipEmpty*/ true);
+    if (!ssrcField)
+        return 0;
+    return (uint32_t) toNumber<unsigned long>(fieldAt(*ssrcField, ':', 1, /*skipEmpty*/ true));
 }
 
-bool parseRtpMap(const QString& line, Sdp::RtpMap* outRtpmap, int* outPayloadType)
+bool parseRtpMap(std::string_view line, Sdp::RtpMap* outRtpmap, int* outPayloadType)
 {
-    QStringList params = line.split(' ');
-    if (params.size() < 2)
+    const auto trackInfo = fieldAt(line, ' ', 0);
+    const auto codecInfo = fieldAt(line, ' ', 1);
+    if (!codecInfo)
         return false; // invalid data format. skip
-    QStringList trackInfo = params[0].split(':');
-    QStringList codecInfo = params[1].split('/');
-    if (trackInfo.size() < 2 || codecInfo.size() < 2)
+    const auto payloadType = fieldAt(*trackInfo, ':', 1);
+    const auto clockRate = fieldAt(*codecInfo, '/', 1);
+    if (!payloadType || !clockRate)
         return false; // invalid data format
 
-    *outPayloadType = trackInfo[1].toUInt();
-    outRtpmap->codecName = codecInfo[0];
-    outRtpmap->clockRate = codecInfo[1].toInt();
-    if (codecInfo.size() >= 3)
-        outRtpmap->channels = codecInfo[2].toInt();
+    *outPayloadType = (int) toNumber<unsigned>(payloadType);
+    outRtpmap->codecName = toQString(*fieldAt(*codecInfo, '/', 0));
+    outRtpmap->clockRate = toNumber<int>(clockRate);
+    if (const auto channels = fieldAt(*codecInfo, '/', 2))
+        outRtpmap->channels = toNumber<int>(channels);
     else
         outRtpmap->channels = 1;
     return true;
 }
 
-bool parseFmtp(const QString& line, Sdp::Fmtp* outFmtp, int* outPayloadType)
+bool parseFmtp(std::string_view line, Sdp::Fmtp* outFmtp, int* outPayloadType)
 {
-    int valueIndex = line.indexOf(' ');
-    if (valueIndex == -1)
+    const auto valueIndex = line.find(' ');
+    if (valueIndex == std::string_view::npos)
         return false;
 
-    QStringList fmtpHeader = line.left(valueIndex).split(':');
-    if (fmtpHeader.size() < 2)
+    const auto payloadType = fieldAt(line.substr(0, valueIndex), ':', 1);
+    if (!payloadType)
         return false;
-    *outPayloadType = fmtpHeader[1].toUInt();
-    outFmtp->params = line.mid(valueIndex + 1).split(';');
-    for (QString& param: outFmtp->params)
-        param = param.trimmed();
+    *outPayloadType = (int) toNumber<unsigned>(payloadType);
 
+    outFmtp->params.clear();
+    forEachField(line.substr(valueIndex + 1), ';',
+        [outFmtp](std::string_view param)
+        {
+            outFmtp->params.push_back(toQString(nx::utils::trim(param)));
+        });
     return true;
 }
 
-Sdp::Media parseMedia(QStringList& lines, const Sdp::RtpMap& preferredMap)
+/** Splits the SDP into the lines without copying them, as QString::split('\n') does. */
+std::vector<std::string_view> splitLines(std::string_view sdp)
+{
+    std::vector<std::string_view> lines;
+    lines.reserve(std::count(sdp.begin(), sdp.end(), '\n') + 1);
+    forEachField(sdp, '\n', [&lines](std::string_view line) { lines.push_back(line); });
+    return lines;
+}
+
+Sdp::Media parseMedia(
+    const std::vector<std::string_view>& lines, size_t* index, const Sdp::RtpMap& preferredMap)
 {
     Sdp::Media media;
-    QString line = lines.front().trimmed().toLower();
-    QStringList trackParams = line.mid(2).split(' ');
-    media.mediaType = mediaTypeFromString(trackParams[0]);
+    const auto trackParams = nx::utils::trim(lines[*index]).substr(2);
+    media.mediaType = mediaTypeFromString(*fieldAt(trackParams, ' ', 0));
 
-    if (trackParams.size() >= 4)
-        media.rtpmap.codecName = findCodecById(trackParams[3].toInt());
+    const auto payloadType = fieldAt(trackParams, ' ', 3);
+    if (payloadType)
+        media.rtpmap.codecName = findCodecById(toNumber<int>(payloadType));
 
-    if (trackParams.size() >= 2)
-        media.serverPort = trackParams[1].toInt();
+    if (const auto serverPort = fieldAt(trackParams, ' ', 1))
+        media.serverPort = toNumber<int>(serverPort);
 
-    if (trackParams.size() >= 4)
-        media.payloadType = trackParams[3].toInt();
+    if (payloadType)
+        media.payloadType = toNumber<int>(payloadType);
 
-    lines.pop_front();
-    for (; !lines.empty() && !lines.front().startsWith("m=", Qt::CaseInsensitive); lines.pop_front())
+    for (++*index; *index < lines.size() && !startsWith(lines[*index], "m="); ++*index)
     {
-        line = lines.front().trimmed();
-        if (line.startsWith("a=", Qt::CaseInsensitive))
-            media.sdpAttributes << line; // save sdp for codec parser
+        const auto line = nx::utils::trim(lines[*index]);
+        if (startsWith(line, "a="))
+            media.sdpAttributes << toQString(line); // save sdp for codec parser
 
-        if (line.startsWith("a=rtpmap", Qt::CaseInsensitive))
+        if (startsWith(line, "a=rtpmap"))
         {
             int payloadType = 0;
             Sdp::RtpMap rtpmap;
@@ -146,26 +216,26 @@ Sdp::Media parseMedia(QStringList& lines, const Sdp::RtpMap& preferredMap)
                     rtpmap.codecName = findCodecById(payloadType);
             }
         }
-        else if (line.startsWith("a=fmtp", Qt::CaseInsensitive))
+        else if (startsWith(line, "a=fmtp"))
         {
             int payloadType = 0;
             Sdp::Fmtp fmtp;
             if (parseFmtp(line, &fmtp, &payloadType) && payloadType == media.payloadType)
-                media.fmtp = fmtp;
+                media.fmtp = std::move(fmtp);
         }
-        else if (line.startsWith("a=control:", Qt::CaseInsensitive))
+        else if (startsWith(line, kControlPrefix))
         {
-            media.control = line.mid(QString("a=control:").length());
+            media.control = toQString(line.substr(kControlPrefix.size()));
         }
-        else if (line.startsWith("a=sendonly", Qt::CaseInsensitive))
+        else if (startsWith(line, "a=sendonly"))
         {
             media.sendOnly = true;
         }
-        else if (line.startsWith("c=", Qt::CaseInsensitive))
+        else if (startsWith(line, "c="))
         {
             media.connectionAddress = parseConnectionAddress(line);
         }
-        else if (line.startsWith("a=ssrc:", Qt::CaseInsensitive))
+        else if (startsWith(line, "a=ssrc:"))
         {
             media.ssrc = parseSsrc(line);
         }
@@ -173,27 +243,34 @@ Sdp::Media parseMedia(QStringList& lines, const Sdp::RtpMap& preferredMap)
     return media;
 }
 
+} // namespace
+
 void Sdp::parse(const QString& sdpData)
+{
+    const QByteArray data = sdpData.toUtf8();
+    parse(std::string_view(data.data(), (size_t) data.size()));
+}
+
+void Sdp::parse(std::string_view sdpData)
 {
     controlUrl.clear();
     media.clear();
     QHostAddress sessionConnectionAddress;
-    QStringList lines = sdpData.split('\n');
-    while(!lines.isEmpty())
+    const auto lines = splitLines(sdpData);
+    for (size_t i = 0; i < lines.size(); )
     {
-        QString line = lines.front().trimmed();
-        if (line.startsWith("m=", Qt::CaseInsensitive))
+        const auto line = nx::utils::trim(lines[i]);
+        if (startsWith(line, "m="))
         {
-            media.push_back(parseMedia(lines, preferredMap));
+            media.push_back(parseMedia(lines, &i, preferredMap));
         }
         else
         {
-            const static QString kControlUrlPrefix = "a=control:";
-            if (line.startsWith("c=", Qt::CaseInsensitive))
+            if (startsWith(line, "c="))
                 sessionConnectionAddress = parseConnectionAddress(line);
-            else if (line.startsWith(kControlUrlPrefix, Qt::CaseInsensitive))
-                controlUrl = line.mid(kControlUrlPrefix.length());
-            lines.pop_front();
+            else if (startsWith(line, kControlPrefix))
+                controlUrl = toQString(line.substr(kControlPrefix.size()));
+            ++i;
         }
     }
     if (!sessionConnectionAddress.isNull())
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <string_view>
 #include <vector>
 
 #include <QtCore/QString>
@@ -65,6 +66,12 @@ struct NX_RTP_API Sdp
      */
     void parse(const QString& sdp);
 
+    /**
+     * Same as parse(const QString&) for the UTF-8 data. The lines and fields are not copied,
+     * only the resulting values are.
+     */
+    void parse(std::string_view sdp);
+
     QString controlUrl;
     std::vector<Media> media;
     RtpMap preferredMap;
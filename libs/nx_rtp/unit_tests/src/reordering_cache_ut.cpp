@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <nx/rtp/reordering_cache.h>
+#include <nx/utils/time.h>
 
 using namespace nx::rtp;
 
@@ -148,3 +149,90 @@ TEST(RtpReorderingCache, readWrite)
         ASSERT_EQ(flushToString(cache), "$65535$0$1");
     }
 }
+
+TEST(RtpReorderingCache, maxDelay)
+{
+    using Status = ReorderingCache::Status;
+    nx::utils::test::ScopedTimeShift timeShift(nx::utils::test::ClockType::steady);
+
+    ReorderingCache cache(/*queueLimit*/ 100, /*maxDelay*/ std::chrono::milliseconds(50));
+    ASSERT_EQ(pushFakePacket(cache, 1), Status::pass);
+    ASSERT_EQ(pushFakePacket(cache, 3), Status::wait);
+    timeShift.applyRelativeShift(std::chrono::milliseconds(10));
+    ASSERT_EQ(pushFakePacket(cache, 5), Status::wait);
+    ASSERT_EQ(cache.getNextNackPacket(0, 0), buildFakeReport(2, 4));
+
+    timeShift.applyRelativeShift(std::chrono::milliseconds(40));
+    ASSERT_EQ(pushFakePacket(cache, 6), Status::flush); //< seq 2 is given up, 4 is not yet.
+    ASSERT_EQ(cache.getNextNackPacket(0, 0), buildFakeReport(4));
+    ASSERT_EQ(flushToString(cache), "$3");
+    ASSERT_EQ(pushFakePacket(cache, 2), Status::skip);
+
+    timeShift.applyRelativeShift(std::chrono::milliseconds(10));
+    ASSERT_EQ(pushFakePacket(cache, 7), Status::flush);
+    ASSERT_EQ(cache.getNextNackPacket(0, 0), buildFakeReport());
+    ASSERT_EQ(flushToString(cache), "$5$6$7");
+    ASSERT_EQ(pushFakePacket(cache, 8), Status::pass);
+}
+
+TEST(RtpReorderingCache, wideWindow)
+{
+    using Status = ReorderingCache::Status;
+    static constexpr int kCount = 900;
+
+    // The window wraps around both the ring and the sequence numbers.
+    ReorderingCache cache(1000);
+    for (int round = 0; round < 100; ++round)
+    {
+        const uint16_t first = (uint16_t) (round * kCount);
+        ASSERT_EQ(pushFakePacket(cache, first), Status::pass);
+        for (int i = 2; i < kCount; ++i)
+            ASSERT_EQ(pushFakePacket(cache, uint16_t(first + i)), Status::wait);
+        ASSERT_EQ(cache.getNextNackPacket(0, 0), buildFakeReport(uint16_t(first + 1)));
+
+        ASSERT_EQ(pushFakePacket(cache, uint16_t(first + 1)), Status::flush);
+        int count = 0;
+        nx::utils::ByteArray packet;
+        while (cache.getNextPacket(packet))
+            ++count;
+        ASSERT_EQ(count, kCount - 1);
+    }
+}
+
+TEST(RtpReorderingCache, aggregatedNack)
+{
+    using namespace std::chrono;
+    using Status = ReorderingCache::Status;
+    nx::utils::test::ScopedTimeShift timeShift(nx::utils::test::ClockType::steady);
+
+    ReorderingCache cache(100);
+    cache.setNackSettings({.aggregationInterval = milliseconds(20), .maxRequests = 2});
+    cache.setRoundTripTime(milliseconds(100)); //< Retry in 150ms.
+
+    ASSERT_EQ(pushFakePacket(cache, 1), Status::pass);
+    ASSERT_EQ(pushFakePacket(cache, 3), Status::wait);
+    ASSERT_EQ(cache.takeNackReport(0, 0), buildFakeReport(2));
+    ASSERT_EQ(pushFakePacket(cache, 5), Status::wait);
+    ASSERT_EQ(cache.takeNackReport(0, 0), buildFakeReport()); //< Aggregated with the next ones.
+
+    timeShift.applyRelativeShift(milliseconds(20));
+    ASSERT_EQ(cache.takeNackReport(0, 0), buildFakeReport(4));
+
+    timeShift.applyRelativeShift(milliseconds(130));
+    ASSERT_EQ(cache.takeNackReport(0, 0), buildFakeReport(2));
+
+    timeShift.applyRelativeShift(milliseconds(150));
+    ASSERT_EQ(cache.takeNackReport(0, 0), buildFakeReport(4));
+
+    timeShift.applyRelativeShift(milliseconds(150));
+    ASSERT_EQ(cache.takeNackReport(0, 0), buildFakeReport()); //< No more retries.
+
+    ASSERT_EQ(pushFakePacket(cache, 2), Status::flush);
+    ASSERT_EQ(flushToString(cache), "$2$3");
+
+    const auto& statistics = cache.statistics();
+    ASSERT_EQ(statistics.requestedPackets, 4);
+    ASSERT_EQ(statistics.suppressedRequests, 2);
+    ASSERT_EQ(statistics.recoveredPackets, 1);
+    ASSERT_EQ(statistics.unrecoverablePackets, 0);
+}
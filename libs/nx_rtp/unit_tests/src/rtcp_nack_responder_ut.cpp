@@ -0,0 +1,99 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/rtp/rtcp_nack_responder.h>
+#include <nx/utils/time.h>
+
+namespace nx::rtp::test {
+
+namespace {
+
+void pushFakePacket(RtcpNackResponder& responder, uint16_t seq)
+{
+    // All the packets are of the same size.
+    char data[8];
+    snprintf(data, sizeof(data), "$%05d", (int) seq);
+    nx::utils::ByteArray packet;
+    packet.write(data, 6);
+    responder.pushPacket(packet, seq);
+}
+
+void pushNack(RtcpNackResponder& responder, const std::vector<uint16_t>& sequences)
+{
+    const auto report = buildNackReport(0, 0, sequences);
+    std::vector<uint8_t> data(report.serialized());
+    report.serialize(data.data(), data.size());
+    responder.pushRtcpNack(data.data(), (int) data.size());
+}
+
+std::string resentToString(RtcpNackResponder& responder)
+{
+    std::string output;
+    nx::utils::ByteArray packet;
+    while (responder.getNextPacket(packet))
+        output.append(packet.data(), packet.size());
+    return output;
+}
+
+} // namespace
+
+TEST(RtcpNackResponder, historyLimits)
+{
+    {
+        RtcpNackResponder responder(/*queueLimit*/ 8, /*memoryLimit*/ 6 * 5);
+        for (uint16_t seq = 65530; seq != 4; ++seq)
+            pushFakePacket(responder, seq);
+
+        // Only 5 last packets fit into the memory limit.
+        pushNack(responder, {65534, 65535, 3});
+        ASSERT_EQ(resentToString(responder), "$65535$00003");
+        ASSERT_EQ(responder.statistics().unrecoverablePackets, 1);
+    }
+    {
+        RtcpNackResponder responder(/*queueLimit*/ 4);
+        for (uint16_t seq = 0; seq < 10; ++seq)
+            pushFakePacket(responder, seq);
+        pushNack(responder, {5, 6, 9});
+        ASSERT_EQ(resentToString(responder), "$00006$00009");
+
+        // The history is restarted on a sequence number gap.
+        pushFakePacket(responder, 20);
+        pushNack(responder, {9, 20});
+        ASSERT_EQ(resentToString(responder), "$00020");
+
+        ASSERT_EQ(responder.statistics().requestedPackets, 5);
+        ASSERT_EQ(responder.statistics().retransmittedPackets, 3);
+        ASSERT_EQ(responder.statistics().unrecoverablePackets, 2);
+    }
+}
+
+TEST(RtcpNackResponder, repeatedRequests)
+{
+    using namespace std::chrono;
+    nx::utils::test::ScopedTimeShift timeShift(nx::utils::test::ClockType::steady);
+
+    RtcpNackResponder responder;
+    responder.setRoundTripTime(milliseconds(100));
+    for (uint16_t seq = 0; seq < 10; ++seq)
+        pushFakePacket(responder, seq);
+
+    pushNack(responder, {3, 4});
+    pushNack(responder, {3});
+    ASSERT_EQ(resentToString(responder), "$00003$00004");
+
+    // Sent by the peer before the retransmission has arrived.
+    timeShift.applyRelativeShift(milliseconds(20));
+    pushNack(responder, {3});
+    ASSERT_EQ(resentToString(responder), "");
+
+    timeShift.applyRelativeShift(milliseconds(100));
+    pushNack(responder, {3});
+    ASSERT_EQ(resentToString(responder), "$00003");
+
+    ASSERT_EQ(responder.statistics().requestedPackets, 5);
+    ASSERT_EQ(responder.statistics().suppressedRequests, 2);
+    ASSERT_EQ(responder.statistics().retransmittedPackets, 3);
+}
+
+} // namespace nx::rtp::test
@@ -184,3 +184,16 @@ TEST(RtcpNackReport, readWrite)
         ASSERT_EQ(buildedReport, report);
     }
 }
+
+TEST(RtcpNackReport, sequenceWraparound)
+{
+    using namespace nx::rtp;
+
+    const std::vector<uint16_t> lostSequences{0xfffe, 0xffff, 0x0, 0x1, 0x20};
+    const auto report = buildNackReport(0x01020304, 0x05060708, lostSequences);
+    ASSERT_EQ(report.nacks.size(), 2U);
+    ASSERT_EQ(report.nacks[0], (RtcpNackPart{0xfffe, 0b111}));
+    ASSERT_EQ(report.nacks[1], (RtcpNackPart{0x20, 0}));
+    ASSERT_EQ(report.header.length, 4);
+    ASSERT_EQ(report.getAllSequenceNumbers(), lostSequences);
+}
@@ -0,0 +1,124 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/rtp/parsers/rtp_chunk_buffer.h>
+
+namespace nx::rtp::test {
+
+namespace {
+
+struct Chunk
+{
+    std::string data;
+    bool nalStart = false;
+};
+
+struct Packet
+{
+    std::vector<Chunk> chunks;
+    bool startsFrame = false;
+};
+
+/**
+ * Feeds the chunks like the RTP parsers do: the packets are appended to the receive buffer, and
+ * when a packet starts a new frame, the previous one is built and the receive buffer is cleared
+ * after the packet is processed.
+ */
+std::vector<std::string> buildFrames(
+    bool directMode, const std::vector<Packet>& packets, const std::string& header)
+{
+    RtpChunkBuffer buffer(directMode);
+    std::vector<std::string> frames;
+    std::vector<uint8_t> receiveBuffer;
+    const auto buildFrame =
+        [&]()
+        {
+            const auto frame = buffer.buildFrame(
+                receiveBuffer.data(), (const uint8_t*) header.data(), (int) header.size());
+            frames.emplace_back(frame->data(), frame->dataSize());
+            buffer.clear();
+        };
+
+    for (const auto& packet: packets)
+    {
+        const bool gotData = packet.startsFrame && buffer.size() > 0;
+        if (gotData)
+            buildFrame();
+
+        for (const auto& chunk: packet.chunks)
+        {
+            const int offset = (int) receiveBuffer.size();
+            receiveBuffer.insert(receiveBuffer.end(), chunk.data.begin(), chunk.data.end());
+            buffer.addChunk(
+                receiveBuffer.data(), offset, (uint16_t) chunk.data.size(), chunk.nalStart);
+        }
+
+        if (gotData)
+        {
+            buffer.backupCurrentData(receiveBuffer.data());
+            receiveBuffer.clear();
+        }
+    }
+    buildFrame();
+    return frames;
+}
+
+std::string sizePrefixed(const std::string& nalUnit)
+{
+    const auto size = (uint32_t) nalUnit.size();
+    return std::string{(char) (size >> 24), (char) (size >> 16), (char) (size >> 8), (char) size}
+        + nalUnit;
+}
+
+} // namespace
+
+TEST(RtpChunkBuffer, directModeBuildsSameFrames)
+{
+    const std::vector<Packet> packets = {
+        {{{"sps", true}, {"pps", true}}, /*startsFrame*/ true},
+        {{{"idr-1", true}}},
+        {{{"-2", false}}},
+        {{{"-3", false}}},
+        {{{"p-1", true}}, /*startsFrame*/ true},
+        {{{"-2", false}, {"sei", true}}},
+        {{{"p", true}}, /*startsFrame*/ true}};
+
+    for (const std::string header: {"", "header"})
+    {
+        const auto expected = buildFrames(/*directMode*/ false, packets, header);
+        ASSERT_EQ(expected, buildFrames(/*directMode*/ true, packets, header));
+        ASSERT_EQ(3u, expected.size());
+        ASSERT_EQ(header + sizePrefixed("sps") + sizePrefixed("pps") + sizePrefixed("idr-1-2-3"),
+            expected[0]);
+        ASSERT_EQ(header + sizePrefixed("p-1-2") + sizePrefixed("sei"), expected[1]);
+        ASSERT_EQ(header + sizePrefixed("p"), expected[2]);
+    }
+}
+
+TEST(RtpChunkBuffer, directModeFrameLargerThanPrevious)
+{
+    RtpChunkBuffer buffer(/*directMode*/ true);
+    const std::string payload(60'000, 'x');
+    for (int frameCount = 1; frameCount <= 3; ++frameCount)
+    {
+        for (int i = 0; i < frameCount; ++i)
+        {
+            buffer.addChunk((const uint8_t*) payload.data(), /*bufferOffset*/ 0,
+                (uint16_t) payload.size(), /*nalStart*/ i == 0);
+        }
+        buffer.setKeyFrame();
+
+        const auto frame = buffer.buildFrame(nullptr, nullptr, 0);
+        buffer.clear();
+        ASSERT_EQ(sizeof(uint32_t) + payload.size() * frameCount, frame->dataSize());
+        ASSERT_EQ(0, memcmp(frame->data() + sizeof(uint32_t), payload.data(), payload.size()));
+    }
+}
+
+} // namespace nx::rtp::test
@@ -1,11 +1,41 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <chrono>
+#include <iostream>
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include <nx/rtp/sdp.h>
 
 using namespace nx::rtp;
 
+namespace {
+
+static const std::string kSdpWithAudio =
+    "v=0\r\n"
+    "o=- 1357696464263190 1 IN IP4 192.168.0.30\r\n"
+    "s=Session streamed by \"TEST RTSP Server\"\r\n"
+    "c=IN IP4 127.0.0.1\r\n"
+    "t=0 0\r\n"
+    "a=control:*\r\n"
+    "m=video 4040 RTP/AVP 96\r\n"
+    "a=rtpmap:96 H264/90000\r\n"
+    "a=fmtp:96 packetization-mode=1; profile-level-id=4D401E; sprop-parameter-sets=Z01AHppkBQF/y/+AEAANtwEBAUAAAPoAAA2sOhgdgB167y40MDsAOvXeXCg=,aO48gA==\r\n"
+    "a=control:track1\r\n"
+    "m=audio 0 RTP/AVP 97 0 8\r\n"
+    "A=RTPMAP:97 mpeg4-generic/8000/2\r\n"
+    "a=rtpmap:8 PCMA/8000\r\n"
+    "a=fmtp:97 streamtype=5; ; config=1588;\r\n"
+    "a=control:track2\r\n"
+    "a=ssrc:1234 cname:test\r\n"
+    "a=sendonly\r\n"
+    "m=application 0 RTP/AVP 98\r\n"
+    "c=IN IP4 239.0.0.1/16\r\n"
+    "a=rtpmap:98 vnd.onvif.metadata/90000\r\n";
+
+} // namespace
+
 TEST(Sdp, h264AndMpa)
 {
     QString sdpString =
@@ -410,3 +440,93 @@ TEST(Sdp, ConnectionAddress)
     ASSERT_EQ("241.0.0.2", sdp.media[1].connectionAddress.toString());
     ASSERT_EQ("241.0.0.2", sdp.media[2].connectionAddress.toString());
 }
+
+TEST(Sdp, stringViewParse)
+{
+    for (const auto preferredMap: {Sdp::RtpMap(), Sdp::RtpMap{"PCMA", 8000, 1}})
+    {
+        Sdp fromString;
+        fromString.preferredMap = preferredMap;
+        fromString.parse(QString::fromStdString(kSdpWithAudio));
+
+        Sdp fromView;
+        fromView.preferredMap = preferredMap;
+        fromView.parse(std::string_view(kSdpWithAudio));
+        ASSERT_EQ(fromString.toString(), fromView.toString());
+    }
+
+    Sdp sdp;
+    sdp.parse(std::string_view(kSdpWithAudio));
+    ASSERT_EQ("*", sdp.controlUrl);
+    ASSERT_EQ(3, sdp.media.size());
+
+    ASSERT_EQ(4040, sdp.media[0].serverPort);
+    ASSERT_EQ("127.0.0.1", sdp.media[0].connectionAddress.toString());
+    ASSERT_EQ(3, sdp.media[0].fmtp.params.size());
+
+    ASSERT_EQ(Sdp::MediaType::Audio, sdp.media[1].mediaType);
+    ASSERT_EQ(97, sdp.media[1].payloadType);
+    ASSERT_EQ("mpeg4-generic", sdp.media[1].rtpmap.codecName);
+    ASSERT_EQ(8000, sdp.media[1].rtpmap.clockRate);
+    ASSERT_EQ(2, sdp.media[1].rtpmap.channels);
+    ASSERT_EQ(QStringList({"streamtype=5", "", "config=1588", ""}), sdp.media[1].fmtp.params);
+    ASSERT_EQ("track2", sdp.media[1].control);
+    ASSERT_EQ(1234, sdp.media[1].ssrc);
+    ASSERT_TRUE(sdp.media[1].sendOnly);
+    ASSERT_EQ(6, sdp.media[1].sdpAttributes.size());
+    ASSERT_EQ("A=RTPMAP:97 mpeg4-generic/8000/2", sdp.media[1].sdpAttributes[0]);
+
+    ASSERT_EQ(Sdp::MediaType::Metadata, sdp.media[2].mediaType);
+    ASSERT_EQ("239.0.0.1", sdp.media[2].connectionAddress.toString());
+
+    // Parsing again replaces the previous data.
+    sdp.parse(std::string_view("v=0\r\nm=video 0 RTP/AVP 26\r\n"));
+    ASSERT_TRUE(sdp.controlUrl.isEmpty());
+    ASSERT_EQ(1, sdp.media.size());
+    ASSERT_EQ("JPEG", sdp.media[0].rtpmap.codecName);
+}
+
+TEST(Sdp, DISABLED_parsePerformance)
+{
+    static constexpr int kIterations = 20'000;
+
+    const auto measure =
+        [](auto func)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i)
+                func();
+            const std::chrono::duration<double, std::micro> duration =
+                std::chrono::steady_clock::now() - start;
+            return duration.count() / kIterations;
+        };
+
+    // QnRtspClient receives the SDP as UTF-8 bytes of the DESCRIBE response.
+    const QByteArray response = QByteArray::fromStdString(kSdpWithAudio);
+    size_t mediaCount = 0;
+    Sdp sdp;
+    std::cout << "QString: "
+        << measure(
+            [&]()
+            {
+                sdp.parse(QString(response));
+                mediaCount += sdp.media.size();
+            })
+        << " us, std::string_view: "
+        << measure(
+            [&]()
+            {
+                sdp.parse(std::string_view(response.data(), response.size()));
+                mediaCount += sdp.media.size();
+            })
+        << " us, cached (hash and compare): "
+        << measure(
+            [&]()
+            {
+                const std::string_view body(response.data(), response.size());
+                if (std::hash<std::string_view>()(body) != 0 && body == kSdpWithAudio)
+                    mediaCount += sdp.media.size();
+            })
+        << " us" << std::endl;
+    ASSERT_GT(mediaCount, 0);
+}
@@ -37,6 +37,27 @@ static constexpr std::chrono::minutes kDefaultStatisticsAggregationPeriod = std:
 
 const int AsyncSqlQueryExecutor::kDefaultQueryPriority = detail::QueryQueue::kDefaultPriority;
 
+static ConnectionOptions readOnlyConnectionOptions(const ConnectionOptions& connectionOptions)
+{
+    auto result = connectionOptions;
+    result.maxConnectionCount = connectionOptions.maxReadOnlyConnectionCount;
+    result.maxReadOnlyConnectionCount = 0;
+
+    if (connectionOptions.driverType == RdbmsDriverType::sqlite)
+    {
+        if (!result.connectOptions.isEmpty())
+            result.connectOptions += ';';
+        result.connectOptions += "QSQLITE_OPEN_READONLY";
+        return result;
+    }
+
+    if (!connectionOptions.readOnlyHostName.isEmpty())
+        result.hostName = connectionOptions.readOnlyHostName;
+    if (connectionOptions.readOnlyPort)
+        result.port = *connectionOptions.readOnlyPort;
+    return result;
+}
+
 AsyncSqlQueryExecutor::AsyncSqlQueryExecutor(
     const ConnectionOptions& connectionOptions)
     :
@@ -57,6 +78,9 @@ AsyncSqlQueryExecutor::AsyncSqlQueryExecutor(
 
     m_queryQueue.setAggregationLimit(
         m_connectionOptions.maxQueriesAggregatedUnderSingleTransaction);
+    m_queryQueue.setAggregationDelay(m_connectionOptions.queryAggregationDelay);
+    m_queryQueue.setStatisticsCollector(&m_statisticsCollector);
+    m_statisticsCollector.setSlowQueryThreshold(m_connectionOptions.slowQueryThreshold);
 
     if (m_connectionOptions.maxPeriodQueryWaitsForAvailableConnection
             > std::chrono::minutes::zero())
@@ -75,6 +99,15 @@ AsyncSqlQueryExecutor::AsyncSqlQueryExecutor(
         m_queryQueue.setConcurrentModificationQueryLimit(
             *m_connectionOptions.concurrentModificationQueryLimit);
     }
+
+    // Interactive queries go first.
+    m_queryQueue.setQueryPriority(QueryType::maintenance, kDefaultQueryPriority - 1);
+
+    if (m_connectionOptions.maxReadOnlyConnectionCount > 0)
+    {
+        m_readOnlyExecutor = std::make_unique<AsyncSqlQueryExecutor>(
+            readOnlyConnectionOptions(m_connectionOptions));
+    }
 }
 
 AsyncSqlQueryExecutor::~AsyncSqlQueryExecutor()
@@ -84,6 +117,9 @@ AsyncSqlQueryExecutor::~AsyncSqlQueryExecutor()
 
 void AsyncSqlQueryExecutor::pleaseStopSync()
 {
+    if (m_readOnlyExecutor)
+        m_readOnlyExecutor->pleaseStopSync();
+
     if (m_dropConnectionThread.joinable())
     {
         m_connectionsToDropQueue.push(nullptr);
@@ -133,10 +169,27 @@ void AsyncSqlQueryExecutor::executeUpdate(
         std::move(completionHandler));
 }
 
+void AsyncSqlQueryExecutor::executeMaintenance(
+    nx::utils::MoveOnlyFunc<DBResult(nx::sql::QueryContext*)> dbUpdateFunc,
+    nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler)
+{
+    scheduleQuery(std::make_unique<detail::UpdateWithoutAnyDataExecutor>(
+        std::move(dbUpdateFunc),
+        std::move(completionHandler),
+        /*queryAggregationKey*/ std::string(),
+        QueryType::maintenance));
+}
+
 void AsyncSqlQueryExecutor::executeSelect(
     nx::utils::MoveOnlyFunc<DBResult(nx::sql::QueryContext*)> dbSelectFunc,
     nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler)
 {
+    if (m_readOnlyExecutor)
+    {
+        m_readOnlyExecutor->executeSelect(std::move(dbSelectFunc), std::move(completionHandler));
+        return;
+    }
+
     scheduleQuery<detail::SelectExecutor>(
         std::string(),
         std::move(dbSelectFunc),
@@ -171,9 +224,11 @@ bool AsyncSqlQueryExecutor::init()
 
             case detail::ConnectionState::opened:
             {
-                NX_MUTEX_LOCKER lock(&m_mutex);
-                saveOpenedConnection(lock, std::move(executorThread));
-                return true;
+                {
+                    NX_MUTEX_LOCKER lock(&m_mutex);
+                    saveOpenedConnection(lock, std::move(executorThread));
+                }
+                return !m_readOnlyExecutor || m_readOnlyExecutor->init();
             }
 
             case detail::ConnectionState::closed:
@@ -206,6 +261,13 @@ Statistics AsyncSqlQueryExecutor::statistics() const
     return m_statisticsCollector.getStatistics();
 }
 
+std::optional<Statistics> AsyncSqlQueryExecutor::readOnlyStatistics() const
+{
+    if (!m_readOnlyExecutor)
+        return std::nullopt;
+    return m_readOnlyExecutor->statistics();
+}
+
 void AsyncSqlQueryExecutor::createCursorImpl(
     std::unique_ptr<detail::AbstractCursorHandler> cursorHandler)
 {
@@ -254,6 +316,17 @@ void AsyncSqlQueryExecutor::setCustomConnectionFactory(
     std::optional<ConnectionFactoryFunc> func)
 {
     m_connectionFactory = std::move(func);
+
+    if (m_readOnlyExecutor)
+    {
+        m_readOnlyExecutor->setCustomConnectionFactory(m_connectionFactory
+            ? std::make_optional<ConnectionFactoryFunc>(
+                [this](const ConnectionOptions& connectionOptions)
+                {
+                    return (*m_connectionFactory)(connectionOptions);
+                })
+            : std::nullopt);
+    }
 }
 
 void AsyncSqlQueryExecutor::setConcurrentModificationQueryLimit(int value)
@@ -266,6 +339,9 @@ void AsyncSqlQueryExecutor::setQueryTimeoutEnabled(bool enabled)
     m_queryQueue.setItemStayTimeout(enabled
         ? std::make_optional(m_connectionOptions.maxPeriodQueryWaitsForAvailableConnection)
         : std::nullopt);
+
+    if (m_readOnlyExecutor)
+        m_readOnlyExecutor->setQueryTimeoutEnabled(enabled);
 }
 
 void AsyncSqlQueryExecutor::setQueryPriority(
@@ -273,6 +349,9 @@ void AsyncSqlQueryExecutor::setQueryPriority(
     int newPriority)
 {
     m_queryQueue.setQueryPriority(queryType, newPriority);
+
+    if (m_readOnlyExecutor)
+        m_readOnlyExecutor->setQueryPriority(queryType, newPriority);
 }
 
 bool AsyncSqlQueryExecutor::isNewConnectionNeeded() const
@@ -391,6 +470,14 @@ void AsyncSqlQueryExecutor::scheduleQuery(
     const std::string& queryAggregationKey,
     UpdateFunc updateFunc,
     CompletionHandler completionHandler)
+{
+    scheduleQuery(std::make_unique<Executor>(
+        std::move(updateFunc),
+        std::move(completionHandler),
+        queryAggregationKey));
+}
+
+void AsyncSqlQueryExecutor::scheduleQuery(std::unique_ptr<detail::BaseExecutor> executor)
 {
     if (isNewConnectionNeeded())
     {
@@ -400,11 +487,6 @@ void AsyncSqlQueryExecutor::scheduleQuery(
             openNewConnection(lk);
     }
 
-    auto executor = std::make_unique<Executor>(
-        std::move(updateFunc),
-        std::move(completionHandler),
-        queryAggregationKey);
-
     executor->setStatisticsCollector(&m_statisticsCollector);
     m_queryQueue.push(std::move(executor));
 }
@@ -69,13 +69,24 @@ public:
         nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler,
         const std::string& queryAggregationKey = std::string()) = 0;
 
+    /**
+     * Same as executeUpdate, but the query is of QueryType::maintenance. Such queries are run
+     * after the interactive ones unless the priority is changed with setQueryPriority.
+     * Intended for periodic background tasks, e.g. those run by QueryScheduler.
+     */
+    virtual void executeMaintenance(
+        nx::utils::MoveOnlyFunc<DBResult(nx::sql::QueryContext*)> dbUpdateFunc,
+        nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler) = 0;
+
     /**
      * Executes dbSelectFunc without starting transaction.
      * A separate executeSelect method was introduced to allow managing priorities of
      * select/update queries and to parallel them separately.
      * NOTE: dbSelectFunc can include any queries. There is no check that only "SELECT ..."
      * is executed here. So, misuse of this function can lead to updates executed without
-     * DB transaction resulting in data consistency issues.
+     * DB transaction resulting in data consistency issues. If
+     * ConnectionOptions::maxReadOnlyConnectionCount is set, dbSelectFunc is run by a read-only
+     * connection, so updates fail there.
      */
     virtual void executeSelect(
         nx::utils::MoveOnlyFunc<DBResult(nx::sql::QueryContext*)> dbSelectFunc,
@@ -305,6 +316,24 @@ public:
         fetchNextRecordFromCursorImpl(std::move(task));
     }
 
+    /**
+     * Same as fetchNextRecordFromCursor, but reads up to maxCount records within a single DB
+     * thread hop. A batch shorter than maxCount means that the query result is depleted.
+     * DBResult::endOfData is reported once there are no more records.
+     */
+    template<typename Record>
+    void fetchNextRecordsFromCursor(
+        nx::Uuid id,
+        int maxCount,
+        nx::utils::MoveOnlyFunc<void(DBResult, std::vector<Record>)> completionHandler)
+    {
+        auto task = std::make_unique<detail::FetchNextRecordsFromCursorTask<Record>>(
+            id,
+            maxCount,
+            std::move(completionHandler));
+        fetchNextRecordFromCursorImpl(std::move(task));
+    }
+
     /**
      * @param id Provided by createCursor.
      */
@@ -355,6 +384,10 @@ public:
         nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler,
         const std::string& queryAggregationKey = std::string()) override;
 
+    virtual void executeMaintenance(
+        nx::utils::MoveOnlyFunc<DBResult(nx::sql::QueryContext*)> dbUpdateFunc,
+        nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler) override;
+
     virtual void executeSelect(
         nx::utils::MoveOnlyFunc<DBResult(nx::sql::QueryContext*)> dbSelectFunc,
         nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler) override;
@@ -363,9 +396,18 @@ public:
         nx::sql::QueryContext* const queryContext,
         const std::string& script) override;
 
+    /**
+     * NOTE: If ConnectionOptions::maxReadOnlyConnectionCount is set, selects are not included.
+     * See readOnlyStatistics().
+     */
     virtual QueryQueueStatistics queryQueueStatistics() const override;
     virtual Statistics statistics() const override;
 
+    /**
+     * @return Statistics of the read-only connection pool. std::nullopt if the pool is not used.
+     */
+    std::optional<Statistics> readOnlyStatistics() const;
+
     /** Have to introduce this method because we do not use exceptions. */
     bool init();
 
@@ -411,6 +453,9 @@ private:
     detail::QueryQueue m_cursorTaskQueue;
     std::vector<std::unique_ptr<CursorProcessorContext>> m_cursorProcessorContexts;
 
+    /** Executes selects if ConnectionOptions::maxReadOnlyConnectionCount is set. */
+    std::unique_ptr<AsyncSqlQueryExecutor> m_readOnlyExecutor;
+
     bool isNewConnectionNeeded() const;
 
     void openNewConnection(
@@ -440,6 +485,8 @@ private:
         UpdateFunc updateFunc,
         CompletionHandler completionHandler);
 
+    void scheduleQuery(std::unique_ptr<detail::BaseExecutor> executor);
+
     void addCursorProcessingThread(const nx::Locker<nx::Mutex>& lock);
 
     void reportQueryTimeoutThreadMain();
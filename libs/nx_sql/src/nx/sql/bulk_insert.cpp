@@ -0,0 +1,142 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "bulk_insert.h"
+
+#include <cctype>
+
+namespace nx::sql {
+
+namespace {
+
+bool isIdentifierChar(char c)
+{
+    return std::isalnum((unsigned char) c) || c == '_';
+}
+
+std::size_t findValuesKeyword(const std::string_view& statement)
+{
+    static constexpr std::string_view kValues = "values";
+
+    for (std::size_t pos = statement.size(); pos-- > 0;)
+    {
+        if (statement.size() - pos < kValues.size())
+            continue;
+        if (pos > 0 && isIdentifierChar(statement[pos - 1]))
+            continue;
+
+        bool matches = true;
+        for (std::size_t i = 0; i < kValues.size() && matches; ++i)
+            matches = std::tolower((unsigned char) statement[pos + i]) == kValues[i];
+        if (!matches)
+            continue;
+
+        const auto end = pos + kValues.size();
+        if (end == statement.size() || !isIdentifierChar(statement[end]))
+            return pos;
+    }
+    return std::string_view::npos;
+}
+
+} // namespace
+
+BulkInsertStatement::BulkInsertStatement(
+    const std::string_view& statement,
+    int maxBoundValues)
+{
+    const auto valuesPos = findValuesKeyword(statement);
+    if (valuesPos == std::string_view::npos)
+        return;
+
+    auto rowStart = statement.find_first_not_of(" \t\r\n", valuesPos + 6);
+    if (rowStart == std::string_view::npos || statement[rowStart] != '(')
+        return;
+
+    // Copying the row replacing the named placeholders with the positional ones.
+    std::string row;
+    int depth = 0;
+    std::size_t pos = rowStart;
+    for (; pos < statement.size(); ++pos)
+    {
+        const char c = statement[pos];
+        if (c == '\'')
+        {
+            const auto literalEnd = statement.find('\'', pos + 1);
+            if (literalEnd == std::string_view::npos)
+                return;
+            row += statement.substr(pos, literalEnd - pos + 1);
+            pos = literalEnd;
+            continue;
+        }
+
+        // Not a part of the PostgreSQL cast operator "::".
+        const bool isPlaceholder = c == ':' && statement[pos - 1] != ':'
+            && pos + 1 < statement.size() && isIdentifierChar(statement[pos + 1]);
+        if (isPlaceholder)
+        {
+            auto nameEnd = pos + 1;
+            while (nameEnd < statement.size() && isIdentifierChar(statement[nameEnd]))
+                ++nameEnd;
+            m_placeholders.emplace_back(statement.substr(pos, nameEnd - pos));
+            row += '?';
+            pos = nameEnd - 1;
+            continue;
+        }
+
+        if (c == '?')
+            m_placeholders.emplace_back("?");
+        else if (c == '(')
+            ++depth;
+        else if (c == ')')
+            --depth;
+
+        row += c;
+        if (depth == 0)
+            break;
+    }
+
+    if (depth != 0)
+    {
+        m_placeholders.clear();
+        return;
+    }
+
+    m_prefix = statement.substr(0, rowStart);
+    m_row = std::move(row);
+    m_suffix = statement.substr(pos + 1);
+
+    const int valuesPerRow = std::max<int>(1, (int) m_placeholders.size());
+    m_maxRowsPerStatement = std::clamp(maxBoundValues / valuesPerRow, 1, kMaxRowsPerStatement);
+}
+
+bool BulkInsertStatement::isValid() const
+{
+    return m_maxRowsPerStatement > 0;
+}
+
+const std::vector<std::string>& BulkInsertStatement::placeholders() const
+{
+    return m_placeholders;
+}
+
+int BulkInsertStatement::maxRowsPerStatement() const
+{
+    return m_maxRowsPerStatement;
+}
+
+std::string BulkInsertStatement::text(int rowCount) const
+{
+    std::string result;
+    result.reserve(m_prefix.size() + (m_row.size() + 2) * rowCount + m_suffix.size());
+
+    result += m_prefix;
+    for (int i = 0; i < rowCount; ++i)
+    {
+        if (i > 0)
+            result += ", ";
+        result += m_row;
+    }
+    result += m_suffix;
+    return result;
+}
+
+} // namespace nx::sql
@@ -0,0 +1,106 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <QtCore/QVariant>
+
+#include "query.h"
+#include "query_context.h"
+
+namespace nx::sql {
+
+/**
+ * Turns a single-row INSERT statement into the statements inserting many rows at once with the
+ * multi-row VALUES syntax, supported by SQLite, MySQL and PostgreSQL. E.g.,
+ * "INSERT INTO t(a, b) VALUES (:a, :b)" becomes "INSERT INTO t(a, b) VALUES (?, ?), (?, ?)".
+ * The values are bound by position, so the named placeholders are resolved once, not per row.
+ */
+class NX_SQL_API BulkInsertStatement
+{
+public:
+    /** SQLITE_MAX_VARIABLE_NUMBER of SQLite before 3.32, the lowest limit of the supported DBs. */
+    static constexpr int kMaxBoundValues = 999;
+
+    /** Larger statements do not make the insertion faster but take longer to prepare. */
+    static constexpr int kMaxRowsPerStatement = 256;
+
+    /**
+     * @param statement INSERT with a single parenthesized row after VALUES. The row may contain
+     *     named (":name") and positional ("?") placeholders and constant expressions.
+     */
+    BulkInsertStatement(const std::string_view& statement, int maxBoundValues = kMaxBoundValues);
+
+    /** The statement is invalid if it has no VALUES clause with a parenthesized row. */
+    bool isValid() const;
+
+    /** The placeholders of the row in the binding order. Positional ones are "?". */
+    const std::vector<std::string>& placeholders() const;
+
+    int maxRowsPerStatement() const;
+
+    /** @return The statement inserting rowCount rows, up to maxRowsPerStatement(). */
+    std::string text(int rowCount) const;
+
+private:
+    std::string m_prefix;
+    std::string m_row;
+    std::string m_suffix;
+    std::vector<std::string> m_placeholders;
+    int m_maxRowsPerStatement = 0;
+};
+
+/**
+ * Inserts the rows executing a statement per BulkInsertStatement::maxRowsPerStatement() rows.
+ * Meant to be called from the update queries of AsyncSqlQueryExecutor, which combines them into
+ * a single transaction.
+ * @param serializeRow void(const Row&, QVariant* values). Writes the values of the row
+ *     placeholders, in the order of BulkInsertStatement::placeholders().
+ * NOTE: Throws nx::sql::Exception on failure.
+ */
+template<typename Rows, typename RowSerializer>
+void insertMany(
+    QueryContext* queryContext,
+    const BulkInsertStatement& statement,
+    const Rows& rows,
+    const RowSerializer& serializeRow)
+{
+    if (!statement.isValid())
+        throw Exception(DBResultCode::statementError, "Unsupported bulk insert statement");
+
+    const int valuesPerRow = (int) statement.placeholders().size();
+    std::vector<QVariant> values(valuesPerRow);
+
+    std::unique_ptr<AbstractSqlQuery> query;
+    int preparedRowCount = 0;
+
+    auto row = rows.begin();
+    for (auto remaining = rows.size(); remaining > 0;)
+    {
+        const int rowCount = (int) std::min<std::size_t>(
+            remaining, (std::size_t) statement.maxRowsPerStatement());
+        if (rowCount != preparedRowCount)
+        {
+            // Only the full statement and the last one are prepared.
+            query = queryContext->connection()->createQuery();
+            query->prepare(statement.text(rowCount));
+            preparedRowCount = rowCount;
+        }
+
+        for (int i = 0; i < rowCount; ++i, ++row)
+        {
+            serializeRow(*row, values.data());
+            for (int j = 0; j < valuesPerRow; ++j)
+                query->bindValue(i * valuesPerRow + j, values[j]);
+        }
+        query->exec();
+        remaining -= rowCount;
+    }
+}
+
+} // namespace nx::sql
@@ -2,19 +2,36 @@
 
 #include "db_statistics_collector.h"
 
+#include <algorithm>
+
+#include <nx/utils/log/log.h>
 #include <nx/utils/time.h>
 
 #include "detail/query_queue.h"
+#include "utils.h"
 
 namespace nx::sql {
 
+static constexpr int kMaxQueriesWithHistogram = 256;
+static constexpr std::size_t kSlowestQueryCount = 10;
+static constexpr std::size_t kMaxRecentSlowQueries = 20;
+
+static constexpr std::pair<double, const char*> kPercentiles[] = {
+    {0.5, "50"}, {0.9, "90"}, {0.99, "99"}};
+
 StatisticsCollector::QueryExecutionTaskContext::QueryExecutionTaskContext(std::chrono::milliseconds period)
     :
     successfulRequestsCounter(period),
     failedRequestsCounter(period),
     cancelledRequestsCounter(period),
     taskExecutionTimeCounter(period),
-    tasksWaitingForExecutionCounter(period)
+    tasksWaitingForExecutionCounter(period),
+    preparedStatementCacheHitsCounter(period),
+    preparedStatementCacheMissesCounter(period),
+    modificationBatchCounter(period),
+    modificationBatchSizeCounter(period),
+    queueWaitHistogram(std::make_unique<nx::utils::math::LogLinearHistogram>()),
+    taskExecutionHistogram(std::make_unique<nx::utils::math::LogLinearHistogram>())
 {}
 
 void StatisticsCollector::QueryExecutionTaskContext::reset()
@@ -24,6 +41,12 @@ void StatisticsCollector::QueryExecutionTaskContext::reset()
     cancelledRequestsCounter.reset();
     taskExecutionTimeCounter.reset();
     tasksWaitingForExecutionCounter.reset();
+    preparedStatementCacheHitsCounter.reset();
+    preparedStatementCacheMissesCounter.reset();
+    modificationBatchCounter.reset();
+    modificationBatchSizeCounter.reset();
+    queueWaitHistogram = std::make_unique<nx::utils::math::LogLinearHistogram>();
+    taskExecutionHistogram = std::make_unique<nx::utils::math::LogLinearHistogram>();
 }
 
 StatisticsCollector::SingleQueryStatisticsContext::SingleQueryStatisticsContext(
@@ -38,6 +61,8 @@ void StatisticsCollector::SingleQueryStatisticsContext::reset()
     statisticsCalculator.reset();
     frequencyCounter.reset();
     durationStatistics = {};
+    if (executionTimeHistogram)
+        executionTimeHistogram = std::make_unique<nx::utils::math::LogLinearHistogram>();
 }
 
 StatisticsCollector::StatisticsCollector(
@@ -54,12 +79,20 @@ StatisticsCollector::StatisticsCollector(
 
 void StatisticsCollector::recordQueryExecutionTask(QueryExecutionTaskRecord record)
 {
+    using namespace std::chrono;
+
     NX_MUTEX_LOCKER lock(&m_mutex);
 
     if (record.executionDuration)
+    {
         m_queryExecutionTaskStatistics.taskExecutionTimeCounter.add(*record.executionDuration);
+        m_queryExecutionTaskStatistics.taskExecutionHistogram->add(
+            duration_cast<microseconds>(*record.executionDuration).count());
+    }
 
     m_queryExecutionTaskStatistics.tasksWaitingForExecutionCounter.add(record.waitForExecutionDuration);
+    m_queryExecutionTaskStatistics.queueWaitHistogram->add(
+        duration_cast<microseconds>(record.waitForExecutionDuration).count());
 
     if (!record.result)
     {
@@ -75,12 +108,63 @@ void StatisticsCollector::recordQueryExecutionTask(QueryExecutionTaskRecord reco
 
 void StatisticsCollector::recordQuery(
     std::string query,
-    std::chrono::milliseconds executionTime)
+    std::chrono::microseconds executionTime,
+    int boundValueCount)
 {
+    using namespace std::chrono;
+
+    auto normalizedQuery = detail::normalizeQuery(query);
+
     NX_MUTEX_LOCKER lock(&m_mutex);
-    auto& queryStatistics = m_queryStatistics.emplace(std::move(query), m_period).first->second;
+
+    auto [it, inserted] = m_queryStatistics.emplace(std::move(normalizedQuery), m_period);
+    auto& queryStatistics = it->second;
+    if (inserted && m_queryHistogramCount < kMaxQueriesWithHistogram)
+    {
+        queryStatistics.executionTimeHistogram =
+            std::make_unique<nx::utils::math::LogLinearHistogram>();
+        ++m_queryHistogramCount;
+    }
+
     queryStatistics.frequencyCounter.add(1);
-    queryStatistics.statisticsCalculator.add(executionTime);
+    queryStatistics.statisticsCalculator.add(floor<milliseconds>(executionTime));
+    if (queryStatistics.executionTimeHistogram)
+        queryStatistics.executionTimeHistogram->add(executionTime.count());
+
+    if (m_slowQueryThreshold > milliseconds::zero() && executionTime >= m_slowQueryThreshold)
+    {
+        NX_INFO(this, "Slow query: %1 with %2 bound values took %3",
+            query, boundValueCount, executionTime);
+
+        m_recentSlowQueries.push_back(SlowQuery{
+            .query = std::move(query),
+            .boundValueCount = boundValueCount,
+            .executionTime = executionTime});
+        if (m_recentSlowQueries.size() > kMaxRecentSlowQueries)
+            m_recentSlowQueries.pop_front();
+    }
+}
+
+void StatisticsCollector::setSlowQueryThreshold(std::chrono::milliseconds threshold)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_slowQueryThreshold = threshold;
+}
+
+void StatisticsCollector::recordPreparedStatementLookup(bool found)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (found)
+        m_queryExecutionTaskStatistics.preparedStatementCacheHitsCounter.add(1);
+    else
+        m_queryExecutionTaskStatistics.preparedStatementCacheMissesCounter.add(1);
+}
+
+void StatisticsCollector::recordModificationBatch(int size)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_queryExecutionTaskStatistics.modificationBatchCounter.add(1);
+    m_queryExecutionTaskStatistics.modificationBatchSizeCounter.add(size);
 }
 
 Statistics StatisticsCollector::getStatistics() const
@@ -105,6 +189,18 @@ Statistics StatisticsCollector::getStatistics() const
             self->getDurationStatistics(&self->m_queryExecutionTaskStatistics.tasksWaitingForExecutionCounter),
         .queryQueue = m_queryQueue.stats(),
         .queries = getQueryStatistics(lock),
+        .preparedStatementCacheHits = self->m_queryExecutionTaskStatistics
+            .preparedStatementCacheHitsCounter.getSumPerLastPeriod(),
+        .preparedStatementCacheMisses = self->m_queryExecutionTaskStatistics
+            .preparedStatementCacheMissesCounter.getSumPerLastPeriod(),
+        .modificationBatches = getBatchStatistics(),
+        .queueWaitTimes =
+            getLatencyStatistics(*m_queryExecutionTaskStatistics.queueWaitHistogram),
+        .taskExecutionTimes =
+            getLatencyStatistics(*m_queryExecutionTaskStatistics.taskExecutionHistogram),
+        .slowestQueries = getSlowestQueries(lock),
+        .recentSlowQueries = std::vector<SlowQuery>(
+            m_recentSlowQueries.begin(), m_recentSlowQueries.end()),
     };
 }
 
@@ -121,6 +217,8 @@ void StatisticsCollector::clearStatistics()
 
     for (auto& query : m_queryStatistics)
         query.second.reset();
+
+    m_recentSlowQueries.clear();
 }
 
 DurationStatistics StatisticsCollector::getDurationStatistics(
@@ -134,6 +232,22 @@ DurationStatistics StatisticsCollector::getDurationStatistics(
     };
 }
 
+QueryBatchStatistics StatisticsCollector::getBatchStatistics() const
+{
+    const int count =
+        m_queryExecutionTaskStatistics.modificationBatchCounter.getSumPerLastPeriod();
+    if (count == 0)
+        return QueryBatchStatistics();
+
+    const auto summaryStatistics = m_queryExecutionTaskStatistics
+        .modificationBatchSizeCounter.summaryStatisticsPerLastPeriod();
+    return QueryBatchStatistics{
+        .count = count,
+        .maxSize = summaryStatistics.max,
+        .averageSize = summaryStatistics.average
+    };
+}
+
 std::map<std::string, QueryStatistics> StatisticsCollector::getQueryStatistics(const nx::MutexLocker& /*lock*/) const
 {
     static constexpr int kQueryCount = 5;
@@ -164,4 +278,45 @@ std::map<std::string, QueryStatistics> StatisticsCollector::getQueryStatistics(c
     return result;
 }
 
+std::vector<QueryLatencyStatistics> StatisticsCollector::getSlowestQueries(
+    const nx::MutexLocker& /*lock*/) const
+{
+    using QueryIterator = decltype(m_queryStatistics)::const_iterator;
+
+    std::vector<std::pair<std::uint64_t /*99th percentile*/, QueryIterator>> queries;
+    for (auto it = m_queryStatistics.begin(); it != m_queryStatistics.end(); ++it)
+    {
+        if (it->second.executionTimeHistogram && it->second.executionTimeHistogram->count() > 0)
+            queries.emplace_back(it->second.executionTimeHistogram->percentile(0.99), it);
+    }
+
+    const auto count = std::min(queries.size(), kSlowestQueryCount);
+    std::partial_sort(
+        queries.begin(), queries.begin() + count, queries.end(),
+        [](const auto& left, const auto& right) { return left.first > right.first; });
+
+    std::vector<QueryLatencyStatistics> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        result.push_back(QueryLatencyStatistics{
+            .query = queries[i].second->first,
+            .executionTimes =
+                getLatencyStatistics(*queries[i].second->second.executionTimeHistogram)});
+    }
+
+    return result;
+}
+
+LatencyStatistics StatisticsCollector::getLatencyStatistics(
+    const nx::utils::math::LogLinearHistogram& histogram)
+{
+    LatencyStatistics result;
+    result.count = histogram.count();
+    result.max = std::chrono::microseconds(histogram.max());
+    for (const auto& [percentile, key]: kPercentiles)
+        result.percentiles[key] = std::chrono::microseconds(histogram.percentile(percentile));
+    return result;
+}
+
 } // namespace nx::sql
@@ -4,11 +4,14 @@
 
 #include <chrono>
 #include <deque>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <nx/reflect/instrument.h>
 #include <nx/utils/elapsed_timer.h>
 #include <nx/utils/math/average_per_period.h>
+#include <nx/utils/math/log_linear_histogram.h>
 #include <nx/utils/math/max_per_period.h>
 #include <nx/utils/math/sum_per_period.h>
 #include <nx/utils/math/summary_statistics_per_period.h>
@@ -49,8 +52,31 @@ public:
 
     /**
      * Record statistics about a specific query immediately after query execution.
+     * The queries are aggregated by their normalized text (see detail::normalizeQuery).
+     * @param boundValueCount Reported in the slow query log.
      */
-    void recordQuery(std::string query, std::chrono::milliseconds executionTime);
+    void recordQuery(
+        std::string query,
+        std::chrono::microseconds executionTime,
+        int boundValueCount = 0);
+
+    /**
+     * @param threshold Queries executing longer are logged and reported in
+     * Statistics::recentSlowQueries. Zero disables the slow query log. By default, zero.
+     */
+    void setSlowQueryThreshold(std::chrono::milliseconds threshold);
+
+    /**
+     * Record a lookup of a prepared statement in the cache of a connection.
+     */
+    void recordPreparedStatementLookup(bool found);
+
+    /**
+     * Record a batch of modification queries taken from the queue to be executed under a
+     * single transaction. A query that has not been aggregated with others is a batch of one.
+     */
+    void recordModificationBatch(int size);
+
     Statistics getStatistics() const;
 
     std::chrono::milliseconds aggregationPeriod() const;
@@ -70,6 +96,16 @@ private:
         nx::utils::math::SummaryStatisticsPerPeriod<std::chrono::milliseconds>
             tasksWaitingForExecutionCounter;
 
+        nx::utils::math::SumPerPeriod<int> preparedStatementCacheHitsCounter;
+        nx::utils::math::SumPerPeriod<int> preparedStatementCacheMissesCounter;
+
+        nx::utils::math::SumPerPeriod<int> modificationBatchCounter;
+        nx::utils::math::SummaryStatisticsPerPeriod<int> modificationBatchSizeCounter;
+
+        // Not limited to the period.
+        std::unique_ptr<nx::utils::math::LogLinearHistogram> queueWaitHistogram;
+        std::unique_ptr<nx::utils::math::LogLinearHistogram> taskExecutionHistogram;
+
         QueryExecutionTaskContext(std::chrono::milliseconds period);
 
         void reset();
@@ -82,6 +118,9 @@ private:
         nx::utils::math::SumPerPeriod<int> frequencyCounter;
         DurationStatistics durationStatistics;
 
+        /** Not limited to the period. Null if too many queries are tracked already. */
+        std::unique_ptr<nx::utils::math::LogLinearHistogram> executionTimeHistogram;
+
         SingleQueryStatisticsContext(std::chrono::milliseconds period);
 
         void reset();
@@ -93,11 +132,21 @@ private:
     mutable nx::Mutex m_mutex;
     QueryExecutionTaskContext m_queryExecutionTaskStatistics;
     std::unordered_map<std::string /*query */, SingleQueryStatisticsContext> m_queryStatistics;
+    int m_queryHistogramCount = 0;
+    std::chrono::milliseconds m_slowQueryThreshold = std::chrono::milliseconds::zero();
+    std::deque<SlowQuery> m_recentSlowQueries;
 
     DurationStatistics getDurationStatistics(
         nx::utils::math::SummaryStatisticsPerPeriod<std::chrono::milliseconds>* calculator);
 
+    QueryBatchStatistics getBatchStatistics() const;
+
     std::map<std::string, QueryStatistics> getQueryStatistics(const nx::MutexLocker&) const;
+
+    std::vector<QueryLatencyStatistics> getSlowestQueries(const nx::MutexLocker&) const;
+
+    static LatencyStatistics getLatencyStatistics(
+        const nx::utils::math::LogLinearHistogram& histogram);
 };
 
 } // namespace nx::sql
@@ -5,6 +5,7 @@
 #include <nx/utils/log/log.h>
 
 #include "async_sql_query_executor.h"
+#include "prepared_statement_cache.h"
 #include "sql_query_execution_helper.h"
 #include "query.h"
 #include "types.h"
@@ -129,6 +130,7 @@ void DbStructureUpdater::updateStruct(nx::sql::QueryContext* queryContext)
         syncDbVersionAndAppliedScriptsTables(queryContext);
 
     m_schemaUpdater.updateStruct(queryContext);
+    PreparedStatementCache::invalidateAll();
 }
 
 bool DbStructureUpdater::exists() const
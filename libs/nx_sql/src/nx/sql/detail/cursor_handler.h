@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <nx/utils/move_only_func.h>
 #include <nx/utils/std/cpp14.h>
@@ -76,6 +77,25 @@ public:
         return record;
     }
 
+    /**
+     * @return Up to maxCount records. Empty vector is never returned: Exception with
+     *     DBResultCode::endOfData is thrown instead.
+     */
+    std::vector<Record> fetchNextRecords(int maxCount)
+    {
+        std::vector<Record> records;
+        records.reserve(maxCount);
+        while ((int) records.size() < maxCount && m_query->next())
+        {
+            records.emplace_back();
+            m_readRecordFunc(m_query.get(), &records.back());
+        }
+
+        if (records.empty())
+            throw Exception(DBResultCode::endOfData);
+        return records;
+    }
+
     virtual void reportErrorWithoutExecution(DBResult errorCode) override
     {
         if (m_cursorCreatedHandler)
@@ -207,6 +227,53 @@ private:
     std::optional<Record> m_record;
 };
 
+/**
+ * Reads up to maxCount records within a single DB thread hop.
+ */
+template<typename Record>
+class FetchNextRecordsFromCursorTask:
+    public AbstractFetchNextRecordFromCursorTask
+{
+public:
+    FetchNextRecordsFromCursorTask(
+        nx::Uuid cursorId,
+        int maxCount,
+        nx::utils::MoveOnlyFunc<void(DBResult, std::vector<Record>)> completionHandler)
+        :
+        m_cursorId(std::move(cursorId)),
+        m_maxCount(maxCount),
+        m_completionHandler(std::move(completionHandler))
+    {
+    }
+
+    virtual nx::Uuid cursorId() const override
+    {
+        return m_cursorId;
+    }
+
+    virtual void fetchNextRecordFrom(AbstractCursorHandler* cursorHandler) override
+    {
+        auto typedCursorHandler = static_cast<CursorHandler<Record>*>(cursorHandler);
+        m_records = typedCursorHandler->fetchNextRecords(m_maxCount);
+    }
+
+    virtual void reportRecord() override
+    {
+        m_completionHandler(DBResultCode::ok, std::exchange(m_records, {}));
+    }
+
+    virtual void reportError(DBResult resultCode) override
+    {
+        m_completionHandler(resultCode, std::vector<Record>());
+    }
+
+private:
+    const nx::Uuid m_cursorId;
+    const int m_maxCount;
+    nx::utils::MoveOnlyFunc<void(DBResult, std::vector<Record>)> m_completionHandler;
+    std::vector<Record> m_records;
+};
+
 class FetchCursorDataExecutor:
     public BasicCursorOperationExecutor
 {
@@ -83,11 +83,13 @@ void BaseExecutor::setStatisticsCollector(StatisticsCollector* statisticsCollect
 UpdateWithoutAnyDataExecutor::UpdateWithoutAnyDataExecutor(
     nx::utils::MoveOnlyFunc<DBResult(QueryContext* const)> dbUpdateFunc,
     nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler,
-    const std::string& queryAggregationKey)
+    const std::string& queryAggregationKey,
+    QueryType queryType)
     :
     base_type(
         std::move(completionHandler),
-        queryAggregationKey),
+        queryAggregationKey,
+        queryType),
     m_dbUpdateFunc(std::move(dbUpdateFunc))
 {
 }
@@ -95,8 +95,11 @@ class AbstractUpdateExecutor:
     public BaseExecutor
 {
 public:
-    AbstractUpdateExecutor(const std::string& queryAggregationKey):
-        BaseExecutor(QueryType::modification, queryAggregationKey)
+    AbstractUpdateExecutor(
+        const std::string& queryAggregationKey,
+        QueryType queryType = QueryType::modification)
+        :
+        BaseExecutor(queryType, queryAggregationKey)
     {
     }
 };
@@ -113,9 +116,10 @@ public:
 
     BaseUpdateExecutor(
         CompletionHandler completionHandler,
-        const std::string& queryAggregationKey)
+        const std::string& queryAggregationKey,
+        QueryType queryType = QueryType::modification)
         :
-        base_type(queryAggregationKey),
+        base_type(queryAggregationKey, queryType),
         m_completionHandler(std::move(completionHandler))
     {
     }
@@ -271,7 +275,8 @@ public:
     UpdateWithoutAnyDataExecutor(
         nx::utils::MoveOnlyFunc<DBResult(QueryContext* const)> dbUpdateFunc,
         nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler,
-        const std::string& queryAggregationKey);
+        const std::string& queryAggregationKey,
+        QueryType queryType = QueryType::modification);
 
 protected:
     virtual DBResult doQuery(QueryContext* queryContext) override;
@@ -74,6 +74,7 @@ std::optional<QueryQueue::value_type> QueryQueue::pop(
     QuerySelectionContext querySelectionContext;
 
     std::vector<QueryQueue::value_type> resultingQueries;
+    std::chrono::steady_clock::time_point firstQueryEnqueueTime;
     for (;;)
     {
         moveFromPreliminaryToMainQueue();
@@ -88,6 +89,8 @@ std::optional<QueryQueue::value_type> QueryQueue::pop(
         {
             if (canAggregate(resultingQueries, queryQueueElementContext->value))
             {
+                if (resultingQueries.empty())
+                    firstQueryEnqueueTime = queryQueueElementContext->it->enqueueTime;
                 resultingQueries.push_back(std::move(queryQueueElementContext->value));
                 pop(*queryQueueElementContext);
                 continue;
@@ -101,7 +104,11 @@ std::optional<QueryQueue::value_type> QueryQueue::pop(
         }
 
         if (!resultingQueries.empty())
+        {
+            if (waitForMoreQueriesToAggregate(resultingQueries, firstQueryEnqueueTime, &lock))
+                continue;
             return aggregateQueries(std::exchange(resultingQueries, {}));
+        }
 
         querySelectionContext = QuerySelectionContext();
 
@@ -142,7 +149,7 @@ int QueryQueue::concurrentModificationCount() const
 void QueryQueue::setQueryPriority(QueryType queryType, int newPriority)
 {
     NX_MUTEX_LOCKER lock(&m_mainQueueMutex);
-    m_customPriorities.emplace(queryType, newPriority);
+    m_customPriorities[queryType] = newPriority;
 }
 
 void QueryQueue::setAggregationLimit(int limit)
@@ -155,6 +162,21 @@ int QueryQueue::aggregationLimit() const
     return m_aggregationLimit;
 }
 
+void QueryQueue::setAggregationDelay(std::chrono::milliseconds delay)
+{
+    m_aggregationDelay = delay;
+}
+
+std::chrono::milliseconds QueryQueue::aggregationDelay() const
+{
+    return m_aggregationDelay;
+}
+
+void QueryQueue::setStatisticsCollector(StatisticsCollector* statisticsCollector)
+{
+    m_statisticsCollector = statisticsCollector;
+}
+
 void QueryQueue::moveFromPreliminaryToMainQueue()
 {
     Queries lightQueue;
@@ -274,7 +296,7 @@ bool QueryQueue::canAggregate(
 void QueryQueue::decreaseLimitCounters(AbstractExecutor* finishedQuery)
 {
     if (m_concurrentModificationQueryLimit > 0 &&
-        finishedQuery->queryType() == QueryType::modification)
+        finishedQuery->queryType() != QueryType::lookup)
     {
         if (--m_currentModificationCount < m_concurrentModificationQueryLimit)
             m_cond.wakeAll();
@@ -301,9 +323,36 @@ void QueryQueue::removeExpiredElements(nx::Locker<nx::Mutex>* lock)
     }
 }
 
+bool QueryQueue::waitForMoreQueriesToAggregate(
+    const std::vector<QueryQueue::value_type>& queries,
+    std::chrono::steady_clock::time_point firstQueryEnqueueTime,
+    nx::Locker<nx::Mutex>* lock)
+{
+    if (m_aggregationDelay <= std::chrono::milliseconds::zero() ||
+        queries.back()->aggregationKey().empty() ||
+        ((m_aggregationLimit >= 0) && ((int) queries.size() >= m_aggregationLimit)))
+    {
+        return false;
+    }
+
+    const auto now = nx::utils::monotonicTime();
+    const auto deadline = firstQueryEnqueueTime + m_aggregationDelay;
+    if (now >= deadline)
+        return false;
+
+    // Woken up by push(), so the new query is considered for aggregation right away.
+    m_cond.wait(
+        lock->mutex(),
+        std::chrono::ceil<std::chrono::milliseconds>(deadline - now));
+    return true;
+}
+
 QueryQueue::value_type QueryQueue::aggregateQueries(
     std::vector<QueryQueue::value_type> queries)
 {
+    if (m_statisticsCollector && queries.front()->queryType() == QueryType::modification)
+        m_statisticsCollector->recordModificationBatch((int) queries.size());
+
     if (queries.size() == 1U)
         return std::move(queries.front());
 
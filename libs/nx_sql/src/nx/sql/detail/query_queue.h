@@ -67,6 +67,21 @@ public:
     void setAggregationLimit(int limit);
     int aggregationLimit() const;
 
+    /**
+     * @param delay If positive, pop() holds a query that can be aggregated until this long has
+     * passed since the query was pushed, collecting the queries pushed meanwhile with the same
+     * aggregation key. The wait ends early when the aggregation limit is reached or a query
+     * that cannot be aggregated is next in the queue.
+     * By default, zero: only the queries already in the queue are aggregated.
+     */
+    void setAggregationDelay(std::chrono::milliseconds delay);
+    std::chrono::milliseconds aggregationDelay() const;
+
+    /**
+     * The size of every popped batch of modification queries is reported to the collector.
+     */
+    void setStatisticsCollector(StatisticsCollector* statisticsCollector);
+
 private:
     struct ElementContext
     {
@@ -99,6 +114,8 @@ private:
     std::atomic<int> m_currentModificationCount{0};
     int m_concurrentModificationQueryLimit = 0;
     int m_aggregationLimit = -1;
+    std::chrono::milliseconds m_aggregationDelay = std::chrono::milliseconds::zero();
+    StatisticsCollector* m_statisticsCollector = nullptr;
     std::map<int, Queries, std::greater<int>> m_priorityToQueue;
     std::atomic<std::size_t> m_preliminaryQueueSize{0};
     std::atomic<std::size_t> m_pendingQueryCount{0};
@@ -127,6 +144,11 @@ private:
 
     void removeExpiredElements(nx::Locker<nx::Mutex>* lock);
 
+    bool waitForMoreQueriesToAggregate(
+        const std::vector<QueryQueue::value_type>& queries,
+        std::chrono::steady_clock::time_point firstQueryEnqueueTime,
+        nx::Locker<nx::Mutex>* lock);
+
     QueryQueue::value_type aggregateQueries(std::vector<QueryQueue::value_type> queries);
 };
 
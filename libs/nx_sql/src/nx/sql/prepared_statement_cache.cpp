@@ -0,0 +1,65 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "prepared_statement_cache.h"
+
+namespace nx::sql {
+
+std::atomic<int> PreparedStatementCache::s_generation = 0;
+
+PreparedStatementCache::PreparedStatementCache(int maxSize):
+    m_statements(maxSize),
+    m_generation(s_generation.load())
+{
+}
+
+std::optional<QSqlQuery> PreparedStatementCache::take(const QString& queryText, bool forwardOnly)
+{
+    clearIfInvalidated();
+
+    const Key key(queryText, forwardOnly);
+    auto statement = m_statements.getValue(key);
+    if (!statement)
+        return std::nullopt;
+
+    std::optional<QSqlQuery> result(std::move(statement->get()));
+    m_statements.erase(key);
+    return result;
+}
+
+void PreparedStatementCache::put(const QString& queryText, QSqlQuery query, int generation)
+{
+    clearIfInvalidated();
+    if (generation != m_generation)
+        return;
+
+    // Releases the result set, so the statement does not hold locks while it is cached.
+    query.finish();
+    const bool forwardOnly = query.isForwardOnly();
+    m_statements.put(Key(queryText, forwardOnly), std::move(query));
+}
+
+int PreparedStatementCache::generation() const
+{
+    return s_generation.load();
+}
+
+void PreparedStatementCache::clear()
+{
+    m_statements.clear();
+}
+
+void PreparedStatementCache::invalidateAll()
+{
+    ++s_generation;
+}
+
+void PreparedStatementCache::clearIfInvalidated()
+{
+    if (const int generation = s_generation.load(); generation != m_generation)
+    {
+        m_statements.clear();
+        m_generation = generation;
+    }
+}
+
+} // namespace nx::sql
@@ -0,0 +1,61 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <optional>
+#include <utility>
+
+#include <QtCore/QString>
+#include <QtSql/QSqlQuery>
+
+#include <nx/utils/data_structures/lru_cache.h>
+
+namespace nx::sql {
+
+/**
+ * Bounded LRU of the prepared statements of a single DB connection, keyed by the query text.
+ * SqlQuery takes a statement out of the cache on prepare and puts it back when it is done with
+ * it, so a statement is never used by two queries at once.
+ * NOTE: Not thread-safe, same as the connection it belongs to.
+ */
+class NX_SQL_API PreparedStatementCache
+{
+public:
+    PreparedStatementCache(int maxSize);
+
+    /**
+     * @return Statement prepared with the given text, removed from the cache.
+     */
+    std::optional<QSqlQuery> take(const QString& queryText, bool forwardOnly);
+
+    /**
+     * @param generation The value of generation() when the statement was prepared. The statement
+     *     is dropped if the cache has been invalidated since then.
+     */
+    void put(const QString& queryText, QSqlQuery query, int generation);
+
+    int generation() const;
+
+    void clear();
+
+    /**
+     * Invalidates the caches of all connections. Called when the DB schema is updated, so that
+     * the statements referring to the altered tables are prepared again.
+     */
+    static void invalidateAll();
+
+private:
+    void clearIfInvalidated();
+
+private:
+    using Key = std::pair<QString /*queryText*/, bool /*forwardOnly*/>;
+
+    nx::utils::LruCache<Key, QSqlQuery, std::map> m_statements;
+    int m_generation = 0;
+
+    static std::atomic<int> s_generation;
+};
+
+} // namespace nx::sql
@@ -32,6 +32,12 @@ QtDbConnection::QtDbConnection(const ConnectionOptions& connectionOptions)
     m_connection.setUserName(connectionOptions.userName);
     m_connection.setPassword(connectionOptions.password);
     m_connection.setPort(connectionOptions.port);
+
+    if (connectionOptions.maxCachedPreparedStatements > 0)
+    {
+        m_statementCache = std::make_unique<PreparedStatementCache>(
+            connectionOptions.maxCachedPreparedStatements);
+    }
 }
 
 QtDbConnection::~QtDbConnection()
@@ -39,6 +45,7 @@ QtDbConnection::~QtDbConnection()
     if (m_isOpen)
         close();
 
+    m_statementCache.reset();
     m_connection = QSqlDatabase();
     nx::sql::Database::removeDatabase(m_connectionName);
 }
@@ -51,6 +58,8 @@ bool QtDbConnection::open()
 
 void QtDbConnection::close()
 {
+    if (m_statementCache)
+        m_statementCache->clear();
     m_connection.close();
     m_isOpen = false;
 }
@@ -100,7 +109,8 @@ DBResult QtDbConnection::lastError()
 
 std::unique_ptr<AbstractSqlQuery> QtDbConnection::createQuery()
 {
-    return std::make_unique<SqlQuery>(m_connection, statisticsCollector());
+    return std::make_unique<SqlQuery>(
+        m_connection, statisticsCollector(), m_statementCache.get());
 }
 
 RdbmsDriverType QtDbConnection::driverType() const
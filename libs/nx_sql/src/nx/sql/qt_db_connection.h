@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include <QtSql/QSqlDatabase>
 
 #include "abstract_db_connection.h"
+#include "prepared_statement_cache.h"
 
 namespace nx::sql {
 
@@ -40,6 +43,7 @@ private:
     QString m_connectionName;
     QSqlDatabase m_connection;
     bool m_isOpen = false;
+    std::unique_ptr<PreparedStatementCache> m_statementCache;
 };
 
 } // namespace nx::sql
@@ -3,6 +3,7 @@
 #include "query.h"
 
 #include <chrono>
+#include <utility>
 
 #include <QtSql/QSqlError>
 
@@ -10,16 +11,19 @@
 
 #include "abstract_db_connection.h"
 #include "db_statistics_collector.h"
+#include "prepared_statement_cache.h"
 
 namespace nx::sql {
 
 SqlQuery::SqlQuery(QSqlDatabase connection):
+    m_connection(connection),
     m_sqlQuery(connection),
     m_driverType(rdbmsDriverTypeFromString(connection.driverName().toStdString()))
 {
 }
 
 SqlQuery::SqlQuery(AbstractDbConnection* connection):
+    m_connection(*connection->qtSqlConnection()),
     m_sqlQuery(*connection->qtSqlConnection()),
     m_driverType(
         rdbmsDriverTypeFromString(connection->qtSqlConnection()->driverName().toStdString()))
@@ -28,10 +32,26 @@ SqlQuery::SqlQuery(AbstractDbConnection* connection):
 
 SqlQuery::SqlQuery(QSqlDatabase connection, StatisticsCollector* statisticsCollector)
     :
+    SqlQuery(connection, statisticsCollector, /*statementCache*/ nullptr)
+{
+}
+
+SqlQuery::SqlQuery(
+    QSqlDatabase connection,
+    StatisticsCollector* statisticsCollector,
+    PreparedStatementCache* statementCache)
+    :
+    m_connection(connection),
     m_sqlQuery(connection),
     m_statisticsCollector(statisticsCollector),
-    m_driverType(rdbmsDriverTypeFromString(connection.driverName().toStdString()))
+    m_driverType(rdbmsDriverTypeFromString(connection.driverName().toStdString())),
+    m_statementCache(statementCache)
+{
+}
+
+SqlQuery::~SqlQuery()
 {
+    returnPreparedStatement(/*resetQuery*/ false);
 }
 
 void SqlQuery::setForwardOnly(bool val)
@@ -42,6 +62,7 @@ void SqlQuery::setForwardOnly(bool val)
 void SqlQuery::prepare(const std::string_view& query)
 {
     m_unpreparedQuery.reset();
+    returnPreparedStatement(/*resetQuery*/ true);
 
     if (!shouldPrepare(query))
     {
@@ -49,11 +70,21 @@ void SqlQuery::prepare(const std::string_view& query)
         return;
     }
 
-    if (!m_sqlQuery.prepare(QString::fromUtf8(query.data(), query.size())))
+    auto queryText = QString::fromUtf8(query.data(), query.size());
+    if (takePreparedStatement(queryText))
+        return;
+
+    if (!m_sqlQuery.prepare(queryText))
     {
         NX_DEBUG(this, "Error preparing query %1. %2", query, m_sqlQuery.lastError().text());
         throw Exception(getLastError());
     }
+
+    if (m_statementCache)
+    {
+        m_cacheableQuery = std::move(queryText);
+        m_statementGeneration = m_statementCache->generation();
+    }
 }
 
 void SqlQuery::addBindValue(const QVariant& value) noexcept
@@ -104,6 +135,7 @@ void SqlQuery::exec(const std::optional<std::string_view>& query)
 {
     using namespace std::chrono;
 
+    const int boundValueCount = (int) m_sqlQuery.boundValues().size();
     const auto t0 = steady_clock::now();
 
     bool ok;
@@ -121,10 +153,13 @@ void SqlQuery::exec(const std::optional<std::string_view>& query)
         ok = m_sqlQuery.exec();
     }
 
-    auto executionTime = floor<milliseconds>(steady_clock::now() - t0);
+    auto executionTime = floor<microseconds>(steady_clock::now() - t0);
 
     if (m_statisticsCollector)
-        m_statisticsCollector->recordQuery(m_sqlQuery.lastQuery().toStdString(), executionTime);
+    {
+        m_statisticsCollector->recordQuery(
+            m_sqlQuery.lastQuery().toStdString(), executionTime, boundValueCount);
+    }
 
     if (ok)
     {
@@ -139,6 +174,44 @@ void SqlQuery::exec(const std::optional<std::string_view>& query)
     }
 }
 
+bool SqlQuery::takePreparedStatement(const QString& query)
+{
+    if (!m_statementCache)
+        return false;
+
+    const int generation = m_statementCache->generation();
+    auto statement = m_statementCache->take(query, m_sqlQuery.isForwardOnly());
+    if (m_statisticsCollector)
+        m_statisticsCollector->recordPreparedStatementLookup(statement.has_value());
+    if (!statement)
+        return false;
+
+    m_sqlQuery = std::move(*statement);
+    m_cacheableQuery = query;
+    m_statementGeneration = generation;
+    return true;
+}
+
+void SqlQuery::returnPreparedStatement(bool resetQuery)
+{
+    if (!m_cacheableQuery)
+        return;
+
+    const auto query = std::exchange(m_cacheableQuery, std::nullopt);
+
+    // The statement could be replaced by exec(query) or through impl().
+    if (m_sqlQuery.lastQuery() != *query)
+        return;
+
+    const bool forwardOnly = m_sqlQuery.isForwardOnly();
+    m_statementCache->put(*query, std::move(m_sqlQuery), m_statementGeneration);
+    if (resetQuery)
+    {
+        m_sqlQuery = QSqlQuery(m_connection);
+        m_sqlQuery.setForwardOnly(forwardOnly);
+    }
+}
+
 bool SqlQuery::shouldPrepare(const std::string_view& query)
 {
     auto stmt = QString::fromUtf8(query);
@@ -12,6 +12,7 @@ namespace nx::sql {
 
 class StatisticsCollector;
 class AbstractDbConnection;
+class PreparedStatementCache;
 
 /**
  * Follows same conventions as QSqlQuery except error reporting:
@@ -92,6 +93,17 @@ public:
     SqlQuery(AbstractDbConnection* connection);
     SqlQuery(QSqlDatabase connection, StatisticsCollector* statisticsCollector);
 
+    /**
+     * @param statementCache Statements are taken from it on prepare and returned on destruction
+     *     or on the next prepare. MUST outlive the query.
+     */
+    SqlQuery(
+        QSqlDatabase connection,
+        StatisticsCollector* statisticsCollector,
+        PreparedStatementCache* statementCache);
+
+    virtual ~SqlQuery() override;
+
     virtual void setForwardOnly(bool val) override;
     virtual void prepare(const std::string_view& query) override;
 
@@ -119,6 +131,7 @@ public:
     static void exec(AbstractDbConnection* connection, const QByteArray& queryText);
 
 private:
+    QSqlDatabase m_connection;
     QSqlQuery m_sqlQuery;
 
     std::optional<QString> m_unpreparedQuery;
@@ -127,9 +140,21 @@ private:
 
     RdbmsDriverType m_driverType = RdbmsDriverType::unknown;
 
+    PreparedStatementCache* m_statementCache = nullptr;
+    /** The text of the prepared statement that can be returned to m_statementCache. */
+    std::optional<QString> m_cacheableQuery;
+    int m_statementGeneration = 0;
+
 private:
     void exec(const std::optional<std::string_view>& query);
 
+    bool takePreparedStatement(const QString& query);
+    /**
+     * @param resetQuery Whether to replace the returned statement with a new one. It is not
+     *     needed on destruction.
+     */
+    void returnPreparedStatement(bool resetQuery);
+
     bool shouldPrepare(const std::string_view& query);
 
     DBResult getLastError();
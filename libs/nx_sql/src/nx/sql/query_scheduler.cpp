@@ -2,6 +2,8 @@
 
 #include "query_scheduler.h"
 
+#include <future>
+
 #include "async_sql_query_executor.h"
 #include "query_context.h"
 
@@ -105,17 +107,19 @@ void QueryScheduler::threadMain()
 
 void QueryScheduler::runQuery()
 {
-    try
-    {
-        m_queryExecutor->executeUpdateSync(
-            [this](nx::sql::QueryContext* ctx) { m_func(ctx); });
+    std::promise<DBResult> queryDone;
+    m_queryExecutor->executeMaintenance(
+        [this](nx::sql::QueryContext* ctx)
+        {
+            m_func(ctx);
+            return DBResult::success();
+        },
+        [&queryDone](DBResult dbResult) { queryDone.set_value(std::move(dbResult)); });
 
+    if (const auto dbResult = queryDone.get_future().get(); dbResult == DBResultCode::ok)
         NX_VERBOSE(this, "Query succeeded");
-    }
-    catch (const Exception& e)
-    {
-        NX_DEBUG(this, "Query failed with %1", e.dbResult());
-    }
+    else
+        NX_DEBUG(this, "Query failed with %1", dbResult);
 }
 
 } // namespace nx::sql
@@ -15,6 +15,7 @@ class QueryContext;
 
 /**
  * Runs the given SQL query function periodically.
+ * The function is executed as a maintenance query, so it gives way to the interactive ones.
  */
 class NX_SQL_API QueryScheduler
 {
@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <future>
+#include <memory>
+#include <vector>
 
+#include <nx/utils/log/assert.h>
 #include <nx/utils/std/optional.h>
 #include <nx/utils/uuid.h>
 
@@ -57,4 +61,107 @@ private:
     const nx::Uuid m_id;
 };
 
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Streams the query result in batches of up to batchSize records without materializing the whole
+ * result set. Each batch is read within a single DB thread hop.
+ * Back-pressure: the next batch is not read from the DB until the consumer asks for it, so at
+ * most one batch per cursor is held in memory.
+ */
+template<typename Record>
+class StreamingCursor:
+    public BaseCursor
+{
+public:
+    using BatchHandler = nx::utils::MoveOnlyFunc<void(DBResult, std::vector<Record>)>;
+
+    static constexpr int kDefaultBatchSize = 100;
+
+    /**
+     * @param id Provided by AbstractAsyncSqlQueryExecutor::createCursor.
+     */
+    StreamingCursor(
+        AbstractAsyncSqlQueryExecutor* asyncSqlQueryExecutor,
+        nx::Uuid id,
+        int batchSize = kDefaultBatchSize)
+        :
+        m_asyncSqlQueryExecutor(asyncSqlQueryExecutor),
+        m_id(id),
+        m_batchSize(batchSize),
+        m_state(std::make_shared<State>())
+    {
+    }
+
+    virtual ~StreamingCursor()
+    {
+        m_asyncSqlQueryExecutor->removeCursor(m_id);
+    }
+
+    /**
+     * Reads the next batch. The handler is invoked within a DB thread. It receives
+     * DBResultCode::endOfData after the last batch has been delivered.
+     * NOTE: Must not be invoked until the handler of the previous call has been invoked.
+     * NOTE: The cursor may be destroyed in the handler.
+     */
+    void readNextBatch(BatchHandler handler)
+    {
+        NX_ASSERT(!m_state->readInProgress);
+
+        if (m_state->depleted)
+            return handler(DBResultCode::endOfData, std::vector<Record>());
+
+        m_state->readInProgress = true;
+        m_asyncSqlQueryExecutor->fetchNextRecordsFromCursor<Record>(
+            m_id,
+            m_batchSize,
+            [state = m_state, batchSize = m_batchSize, handler = std::move(handler)](
+                DBResult resultCode, std::vector<Record> records)
+            {
+                state->depleted = resultCode != DBResultCode::ok
+                    || (int) records.size() < batchSize;
+                state->readInProgress = false;
+                handler(resultCode, std::move(records));
+            });
+    }
+
+    /**
+     * Synchronous version of StreamingCursor::readNextBatch.
+     * @return std::nullopt after the last batch or on error.
+     */
+    std::optional<std::vector<Record>> nextBatch()
+    {
+        std::promise<std::tuple<DBResult, std::vector<Record>>> batchRead;
+        readNextBatch(
+            [&batchRead](DBResult resultCode, std::vector<Record> records)
+            {
+                batchRead.set_value(std::make_tuple(resultCode, std::move(records)));
+            });
+        auto result = batchRead.get_future().get();
+
+        if (std::get<0>(result) == DBResultCode::ok)
+            return std::move(std::get<1>(result));
+
+        return std::nullopt;
+    }
+
+    int batchSize() const
+    {
+        return m_batchSize;
+    }
+
+private:
+    /** Shared with the pending read, so that the cursor can be destroyed in the handler. */
+    struct State
+    {
+        std::atomic<bool> readInProgress = false;
+        std::atomic<bool> depleted = false;
+    };
+
+    AbstractAsyncSqlQueryExecutor* m_asyncSqlQueryExecutor;
+    const nx::Uuid m_id;
+    const int m_batchSize;
+    std::shared_ptr<State> m_state;
+};
+
 } // namespace nx::sql
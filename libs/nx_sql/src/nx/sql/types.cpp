@@ -120,6 +120,14 @@ static constexpr char kDbReconnectAfterFailureDelay[] = "reconnectAfterFailureDe
 static constexpr char kDbMaxQueriesAggregatedUnderSingleTransaction[] =
     "maxQueriesAggregatedUnderSingleTransaction";
 
+static constexpr char kDbQueryAggregationDelay[] = "queryAggregationDelay";
+
+static constexpr char kDbMaxCachedPreparedStatements[] = "maxCachedPreparedStatements";
+static constexpr char kDbMaxReadOnlyConnections[] = "maxReadOnlyConnections";
+static constexpr char kDbReadOnlyHostName[] = "readOnlyHostName";
+static constexpr char kDbReadOnlyPort[] = "readOnlyPort";
+static constexpr char kDbSlowQueryThreshold[] = "slowQueryThreshold";
+
 } // namespace
 
 ConnectionOptions::ConnectionOptions():
@@ -198,6 +206,33 @@ void ConnectionOptions::loadFromSettings(const QnSettings& settings, const QStri
         maxQueriesAggregatedUnderSingleTransaction =
             settingsReader.value(kDbMaxQueriesAggregatedUnderSingleTransaction).toInt();
     }
+
+    if (settingsReader.contains(kDbQueryAggregationDelay))
+    {
+        queryAggregationDelay = nx::utils::parseTimerDuration(
+            settingsReader.value(kDbQueryAggregationDelay).toString());
+    }
+
+    if (settingsReader.contains(kDbMaxCachedPreparedStatements))
+    {
+        maxCachedPreparedStatements =
+            settingsReader.value(kDbMaxCachedPreparedStatements).toInt();
+    }
+
+    if (settingsReader.contains(kDbMaxReadOnlyConnections))
+        maxReadOnlyConnectionCount = settingsReader.value(kDbMaxReadOnlyConnections).toInt();
+
+    if (settingsReader.contains(kDbReadOnlyHostName))
+        readOnlyHostName = settingsReader.value(kDbReadOnlyHostName).toString();
+
+    if (settingsReader.contains(kDbReadOnlyPort))
+        readOnlyPort = settingsReader.value(kDbReadOnlyPort).toInt();
+
+    if (settingsReader.contains(kDbSlowQueryThreshold))
+    {
+        slowQueryThreshold = nx::utils::parseTimerDuration(
+            settingsReader.value(kDbSlowQueryThreshold).toString());
+    }
 }
 
 //-------------------------------------------------------------------------------------------------
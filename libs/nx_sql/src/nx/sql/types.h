@@ -3,11 +3,13 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtSql/QSqlDatabase>
@@ -112,6 +114,46 @@ public:
      */
     int maxQueriesAggregatedUnderSingleTransaction = 9999;
 
+    /**
+     * If positive, a query that can be aggregated with others waits in the queue up to this
+     * long for more such queries to arrive, so that they are all executed under a single
+     * transaction. The wait ends early once maxQueriesAggregatedUnderSingleTransaction queries
+     * are collected. Every query still reports its own result.
+     * By default, zero: queries are aggregated only if they are already queued.
+     */
+    std::chrono::milliseconds queryAggregationDelay = std::chrono::milliseconds::zero();
+
+    /**
+     * Prepared statements kept by each connection for reuse, the least recently used ones are
+     * dropped first. Zero disables the cache.
+     */
+    int maxCachedPreparedStatements = 64;
+
+    /**
+     * If positive, selects are executed by a separate pool of up to this many read-only
+     * connections with a queue of its own, so that long-running selects do not wait behind the
+     * updates and vice versa. maxConnectionCount then limits the connections executing updates.
+     * SQLite readers open the DB file read-only and rely on the WAL journal mode enabled by
+     * InstanceController. So, the separate pool is not usable with an in-memory SQLite DB.
+     * By default, zero: every query is executed by the same pool.
+     */
+    int maxReadOnlyConnectionCount = 0;
+
+    /**
+     * Host of the read-only connections, e.g. a replica of the DB. If empty, hostName is used.
+     * Ignored for SQLite.
+     */
+    QString readOnlyHostName;
+
+    /** Port of the read-only connections. If not specified, port is used. */
+    std::optional<int> readOnlyPort;
+
+    /**
+     * Queries executing longer than this are logged with their text and the number of bound
+     * values, and reported in Statistics::recentSlowQueries. Zero disables the slow query log.
+     */
+    std::chrono::milliseconds slowQueryThreshold = std::chrono::milliseconds::zero();
+
     ConnectionOptions();
 
     void loadFromSettings(const QnSettings& settings, const QString& groupName = "db");
@@ -122,12 +164,16 @@ public:
 NX_REFLECTION_INSTRUMENT(ConnectionOptions, (driverType)(hostName)(port)(dbName)(userName) \
     (password)(connectOptions)(encoding)(maxConnectionCount)(inactivityTimeout) \
     (maxPeriodQueryWaitsForAvailableConnection)(maxErrorsInARowBeforeClosingConnection) \
-    (failOnDbTuneError)(concurrentModificationQueryLimit))
+    (failOnDbTuneError)(concurrentModificationQueryLimit)(maxCachedPreparedStatements) \
+    (queryAggregationDelay)(maxReadOnlyConnectionCount)(readOnlyHostName)(readOnlyPort) \
+    (slowQueryThreshold))
 
 enum class QueryType
 {
     lookup,
     modification,
+    /** Modification performed periodically in background, e.g. by QueryScheduler. */
+    maintenance,
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -178,6 +224,45 @@ struct QueryStatistics
 
 NX_REFLECTION_INSTRUMENT(QueryStatistics, (count)(requestExecutionTimes))
 
+struct QueryBatchStatistics
+{
+    int count = 0;
+    int maxSize = 0;
+    int averageSize = 0;
+};
+
+NX_REFLECTION_INSTRUMENT(QueryBatchStatistics, (count)(maxSize)(averageSize))
+
+/**
+ * Distribution of durations accumulated since the start.
+ */
+struct LatencyStatistics
+{
+    std::uint64_t count = 0;
+    std::chrono::microseconds max{0};
+    std::map<std::string /*percent*/, std::chrono::microseconds> percentiles;
+};
+
+NX_REFLECTION_INSTRUMENT(LatencyStatistics, (count)(max)(percentiles))
+
+struct QueryLatencyStatistics
+{
+    /** See detail::normalizeQuery. */
+    std::string query;
+    LatencyStatistics executionTimes;
+};
+
+NX_REFLECTION_INSTRUMENT(QueryLatencyStatistics, (query)(executionTimes))
+
+struct SlowQuery
+{
+    std::string query;
+    int boundValueCount = 0;
+    std::chrono::microseconds executionTime{0};
+};
+
+NX_REFLECTION_INSTRUMENT(SlowQuery, (query)(boundValueCount)(executionTime))
+
 /**
  * Top level statistics
  */
@@ -192,11 +277,32 @@ struct Statistics
     DurationStatistics waitingForExecutionTimes;
     QueryQueueStatistics queryQueue;
     std::map<std::string /* query */, QueryStatistics> queries;
+
+    /** Lookups of prepared statements in the connections' caches. */
+    int preparedStatementCacheHits = 0;
+    int preparedStatementCacheMisses = 0;
+
+    /** Sizes of the batches of modification queries executed under a single transaction. */
+    QueryBatchStatistics modificationBatches;
+
+    /**
+     * Time the tasks (see QueryExecutionTaskRecord) spent in the queue and then executing, since
+     * the start. Telling one from the other shows whether the DB or the pool is the bottleneck.
+     */
+    LatencyStatistics queueWaitTimes;
+    LatencyStatistics taskExecutionTimes;
+
+    /** Queries with the highest 99th percentile of execution time since the start. */
+    std::vector<QueryLatencyStatistics> slowestQueries;
+
+    /** The latest queries that took longer than ConnectionOptions::slowQueryThreshold. */
+    std::vector<SlowQuery> recentSlowQueries;
 };
 
 NX_REFLECTION_INSTRUMENT(Statistics,
     (statisticalPeriod)(requestsSucceeded)(requestsFailed)(requestsCancelled) \
     (dbThreadPoolSize)(requestExecutionTimes)(waitingForExecutionTimes)(queryQueue) \
-    (queries))
+    (queries)(preparedStatementCacheHits)(preparedStatementCacheMisses)(modificationBatches) \
+    (queueWaitTimes)(taskExecutionTimes)(slowestQueries)(recentSlowQueries))
 
 } // namespace nx::sql
@@ -2,6 +2,8 @@
 
 #include "utils.h"
 
+#include <cctype>
+
 #include <nx/utils/string.h>
 
 #include "query_context.h"
@@ -78,6 +80,89 @@ std::optional<nx::utils::SoftwareVersion> parseVersion(
     return nx::utils::SoftwareVersion(major, minor, build);
 }
 
+static bool isIdentifierChar(char ch)
+{
+    return std::isalnum((unsigned char) ch) || ch == '_' || ch == '$';
+}
+
+static void appendPlaceholder(std::string* result)
+{
+    // Collapsing "?, ?" to "?".
+    auto end = result->find_last_not_of(' ');
+    if (end != std::string::npos && (*result)[end] == ',')
+    {
+        const auto prev = result->find_last_not_of(' ', end == 0 ? 0 : end - 1);
+        if (prev != std::string::npos && prev != end && (*result)[prev] == '?')
+        {
+            result->resize(prev + 1);
+            return;
+        }
+    }
+
+    *result += '?';
+}
+
+std::string normalizeQuery(std::string_view query)
+{
+    std::string result;
+    result.reserve(query.size());
+
+    for (std::size_t i = 0; i < query.size();)
+    {
+        const char ch = query[i];
+
+        if (std::isspace((unsigned char) ch))
+        {
+            while (i < query.size() && std::isspace((unsigned char) query[i]))
+                ++i;
+            if (!result.empty())
+                result += ' ';
+            continue;
+        }
+
+        if (ch == '\'')
+        {
+            // A quote inside the literal is escaped by doubling it.
+            for (++i; i < query.size(); ++i)
+            {
+                if (query[i] != '\'')
+                    continue;
+                if (i + 1 < query.size() && query[i + 1] == '\'')
+                    ++i;
+                else
+                    break;
+            }
+            ++i;
+            appendPlaceholder(&result);
+            continue;
+        }
+
+        if (std::isdigit((unsigned char) ch)
+            && (result.empty() || !isIdentifierChar(result.back())))
+        {
+            while (i < query.size() && (isIdentifierChar(query[i]) || query[i] == '.'))
+                ++i;
+            appendPlaceholder(&result);
+            continue;
+        }
+
+        if (ch == '?')
+        {
+            ++i;
+            appendPlaceholder(&result);
+            continue;
+        }
+
+        result += ch;
+        ++i;
+    }
+
+    while (!result.empty() && result.back() == ' ')
+        result.pop_back();
+
+    return result;
+}
+
 } // namespace detail
 
 } // namespace nx::sql
@@ -4,6 +4,7 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include <nx/utils/software_version.h>
 
@@ -38,6 +39,14 @@ namespace detail {
  */
 NX_SQL_API std::optional<nx::utils::SoftwareVersion> parseVersion(std::string_view text);
 
+/**
+ * Reduces the query text to its shape, so that the statistics of the same statement with
+ * different values are aggregated together: string and numeric literals are replaced with "?",
+ * lists of "?" (e.g., "IN (?, ?, ?)") are collapsed to a single "?", and whitespace is collapsed
+ * to a single space.
+ */
+NX_SQL_API std::string normalizeQuery(std::string_view query);
+
 } // namespace detail
 
 } // namespace nx::sql
@@ -607,6 +607,64 @@ TEST_F(DbAsyncSqlQueryExecutorNew, DISABLED_interleaved_reads_with_hanging_updat
 
 //-------------------------------------------------------------------------------------------------
 
+class DbAsyncSqlQueryExecutorReadOnlyPool:
+    public DbAsyncSqlQueryExecutor
+{
+    using base_type = DbAsyncSqlQueryExecutor;
+
+protected:
+    virtual void SetUp() override
+    {
+        base_type::SetUp();
+
+        connectionOptions().maxReadOnlyConnectionCount = 3;
+        initializeDatabase();
+    }
+
+    DBResult whenUpdateIsIssuedAsSelect()
+    {
+        nx::utils::promise<DBResult> queryDone;
+        asyncSqlQueryExecutor().executeSelect(
+            [](QueryContext* queryContext)
+            {
+                SqlQuery query(queryContext->connection());
+                query.prepare("INSERT INTO company (name, yearFounded) VALUES ('Foo Inc.', 1975)");
+                query.exec();
+                return DBResultCode::ok;
+            },
+            [&queryDone](DBResult dbResult) { queryDone.set_value(dbResult); });
+        return queryDone.get_future().get();
+    }
+
+    void thenReadOnlyPoolIsUsed()
+    {
+        const auto readOnlyStatistics =
+            static_cast<AsyncSqlQueryExecutor&>(asyncSqlQueryExecutor()).readOnlyStatistics();
+        ASSERT_TRUE(readOnlyStatistics);
+    }
+};
+
+TEST_F(DbAsyncSqlQueryExecutorReadOnlyPool, selects_see_committed_updates)
+{
+    const auto expected = givenRandomData();
+
+    ASSERT_EQ(expected, executeSelect<Company>("SELECT * FROM company"));
+    thenReadOnlyPoolIsUsed();
+}
+
+TEST_F(DbAsyncSqlQueryExecutorReadOnlyPool, concurrent_read_writes)
+{
+    whenIssueMultipleReadWriteQueries();
+    thenEveryQuerySucceeded();
+}
+
+TEST_F(DbAsyncSqlQueryExecutorReadOnlyPool, select_cannot_modify_data)
+{
+    ASSERT_NE(DBResultCode::ok, whenUpdateIsIssuedAsSelect());
+}
+
+//-------------------------------------------------------------------------------------------------
+
 class DbAsyncSqlQueryExecutorCursor:
     public DbAsyncSqlQueryExecutorNew
 {
@@ -660,7 +718,8 @@ protected:
         for (int i = 0; i < m_cursorsRequested; ++i)
         {
             CursorContext cursorContext;
-            cursorContext.cursor = m_cursorsCreated.pop();
+            cursorContext.cursor =
+                std::make_unique<CompanyCursor>(&asyncSqlQueryExecutor(), m_cursorsCreated.pop());
             m_cursors.push_back(std::move(cursorContext));
             ASSERT_NE(nullptr, m_cursors.back().cursor);
         }
@@ -686,6 +745,40 @@ protected:
             std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
+    void givenStreamingCursor(int batchSize)
+    {
+        whenRequestCursor();
+        const auto cursorId = m_cursorsCreated.pop();
+        ASSERT_FALSE(cursorId.isNull());
+        m_streamingCursor = std::make_unique<StreamingCursor<Company>>(
+            &asyncSqlQueryExecutor(), cursorId, batchSize);
+    }
+
+    void whenReadAllBatches()
+    {
+        while (auto batch = m_streamingCursor->nextBatch())
+        {
+            m_batchSizes.push_back((int) batch->size());
+            std::move(batch->begin(), batch->end(), std::back_inserter(m_recordsStreamed));
+        }
+    }
+
+    void whenDeleteStreamingCursor()
+    {
+        m_streamingCursor.reset();
+    }
+
+    void thenBatchSizesAre(const std::vector<int>& expected)
+    {
+        ASSERT_EQ(expected, m_batchSizes);
+    }
+
+    void andAllDataIsStreamed()
+    {
+        std::sort(m_recordsStreamed.begin(), m_recordsStreamed.end(), std::less<Company>());
+        ASSERT_EQ(m_initialData, m_recordsStreamed);
+    }
+
 private:
     using CompanyCursor = Cursor<Company>;
 
@@ -695,10 +788,13 @@ private:
         std::vector<Company> recordsRead;
     };
 
-    nx::utils::SyncQueue<std::unique_ptr<CompanyCursor>> m_cursorsCreated;
+    nx::utils::SyncQueue<nx::Uuid> m_cursorsCreated;
     std::vector<Company> m_initialData;
     std::vector<CursorContext> m_cursors;
     int m_cursorsRequested = 0;
+    std::unique_ptr<StreamingCursor<Company>> m_streamingCursor;
+    std::vector<int> m_batchSizes;
+    std::vector<Company> m_recordsStreamed;
 
     void prepareCursorQuery(SqlQuery* query)
     {
@@ -707,7 +803,7 @@ private:
 
     void saveCursor(DBResult /*resultCode*/, nx::Uuid cursorId)
     {
-        m_cursorsCreated.push(std::make_unique<CompanyCursor>(&asyncSqlQueryExecutor(), cursorId));
+        m_cursorsCreated.push(cursorId);
     }
 
     void readAllData()
@@ -751,6 +847,31 @@ TEST_F(DbAsyncSqlQueryExecutorCursor, cursor_query_cleaned_up_when_after_early_c
     thenCursorQueryIsDeleted();
 }
 
+TEST_F(DbAsyncSqlQueryExecutorCursor, streaming_cursor_reads_data_in_batches)
+{
+    givenStreamingCursor(/*batchSize*/ 2);
+    whenReadAllBatches();
+
+    thenBatchSizesAre({2, 1});
+    andAllDataIsStreamed();
+}
+
+TEST_F(DbAsyncSqlQueryExecutorCursor, streaming_cursor_delivers_whole_result_in_a_single_batch)
+{
+    givenStreamingCursor(/*batchSize*/ 100);
+    whenReadAllBatches();
+
+    thenBatchSizesAre({3});
+    andAllDataIsStreamed();
+}
+
+TEST_F(DbAsyncSqlQueryExecutorCursor, streaming_cursor_query_cleaned_up_after_deletion)
+{
+    givenStreamingCursor(/*batchSize*/ 1);
+    whenDeleteStreamingCursor();
+    thenCursorQueryIsDeleted();
+}
+
 // TEST_F(DbAsyncSqlQueryExecutorCursor, many_cursors_do_not_block_queries)
 
 //-------------------------------------------------------------------------------------------------
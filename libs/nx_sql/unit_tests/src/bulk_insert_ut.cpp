@@ -0,0 +1,145 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/sql/bulk_insert.h>
+#include <nx/sql/qt_db_connection.h>
+#include <nx/sql/query_context.h>
+
+namespace nx::sql::test {
+
+TEST(BulkInsertStatement, named_placeholders_are_replaced)
+{
+    const BulkInsertStatement statement(
+        "INSERT OR REPLACE INTO t(a, b, c) VALUES (:a, 'x:y', coalesce(:b, ?))");
+    ASSERT_TRUE(statement.isValid());
+    ASSERT_EQ((std::vector<std::string>{":a", ":b", "?"}), statement.placeholders());
+
+    ASSERT_EQ(
+        "INSERT OR REPLACE INTO t(a, b, c) VALUES (?, 'x:y', coalesce(?, ?))",
+        statement.text(1));
+    ASSERT_EQ(
+        "INSERT OR REPLACE INTO t(a, b, c) VALUES "
+            "(?, 'x:y', coalesce(?, ?)), (?, 'x:y', coalesce(?, ?))",
+        statement.text(2));
+}
+
+TEST(BulkInsertStatement, suffix_is_kept)
+{
+    const BulkInsertStatement statement(
+        "INSERT INTO t(a) values(:a::int) ON CONFLICT(a) DO NOTHING");
+    ASSERT_EQ((std::vector<std::string>{":a"}), statement.placeholders());
+    ASSERT_EQ(
+        "INSERT INTO t(a) values(?::int), (?::int) ON CONFLICT(a) DO NOTHING",
+        statement.text(2));
+}
+
+TEST(BulkInsertStatement, rows_per_statement_respect_bound_value_limit)
+{
+    ASSERT_EQ(
+        99,
+        BulkInsertStatement("INSERT INTO t VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)")
+            .maxRowsPerStatement());
+    ASSERT_EQ(
+        BulkInsertStatement::kMaxRowsPerStatement,
+        BulkInsertStatement("INSERT INTO t VALUES (?)").maxRowsPerStatement());
+    ASSERT_EQ(1, BulkInsertStatement("INSERT INTO t VALUES (?, ?)", 1).maxRowsPerStatement());
+}
+
+TEST(BulkInsertStatement, statement_without_values_is_invalid)
+{
+    ASSERT_FALSE(BulkInsertStatement("INSERT INTO t SELECT * FROM s").isValid());
+    ASSERT_FALSE(BulkInsertStatement("INSERT INTO t VALUES (?, (?)").isValid());
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class BulkInsert:
+    public ::testing::Test
+{
+public:
+    BulkInsert():
+        m_connection(connectionOptions()),
+        m_queryContext(&m_connection, /*transaction*/ nullptr)
+    {
+    }
+
+protected:
+    struct Row
+    {
+        int id = 0;
+        std::string name;
+    };
+
+    virtual void SetUp() override
+    {
+        ASSERT_TRUE(m_connection.open());
+        m_connection.executeQuery("CREATE TABLE data(id INTEGER, name TEXT, kind INTEGER)");
+    }
+
+    void insert(const std::vector<Row>& rows)
+    {
+        const BulkInsertStatement statement(
+            "INSERT INTO data(id, name, kind) VALUES (:id, :name, 7)", /*maxBoundValues*/ 10);
+
+        insertMany(&m_queryContext, statement, rows,
+            [](const Row& row, QVariant* values)
+            {
+                values[0] = row.id;
+                values[1] = QString::fromStdString(row.name);
+            });
+    }
+
+    std::vector<std::string> readNames()
+    {
+        auto query = m_connection.createQuery();
+        query->prepare("SELECT name, kind FROM data ORDER BY id");
+        query->exec();
+
+        std::vector<std::string> names;
+        while (query->next())
+        {
+            EXPECT_EQ(7, query->value<int>(1));
+            names.push_back(query->value<std::string>(0));
+        }
+        return names;
+    }
+
+private:
+    static ConnectionOptions connectionOptions()
+    {
+        ConnectionOptions options;
+        options.driverType = RdbmsDriverType::sqlite;
+        options.dbName = ":memory:";
+        return options;
+    }
+
+private:
+    QtDbConnection m_connection;
+    QueryContext m_queryContext;
+};
+
+TEST_F(BulkInsert, all_rows_are_inserted)
+{
+    std::vector<Row> rows;
+    std::vector<std::string> names;
+    for (int i = 0; i < 12; ++i) //< Two full statements of 5 rows and one of 2 rows.
+    {
+        rows.push_back({i, "name" + std::to_string(i)});
+        names.push_back(rows.back().name);
+    }
+
+    insert(rows);
+    ASSERT_EQ(names, readNames());
+}
+
+TEST_F(BulkInsert, empty_range_is_accepted)
+{
+    insert({});
+    ASSERT_TRUE(readNames().empty());
+}
+
+} // namespace nx::sql::test
@@ -44,6 +44,41 @@ protected:
         m_statisticsCollector.recordQuery(std::move(query), val);
     }
 
+    void recordModificationBatches(std::initializer_list<int> sizes)
+    {
+        for (const int size: sizes)
+            m_statisticsCollector.recordModificationBatch(size);
+    }
+
+    void assertModificationBatchStatisticsEqual(int count, int maxSize, int averageSize)
+    {
+        const auto statistics = m_statisticsCollector.getStatistics().modificationBatches;
+        ASSERT_EQ(count, statistics.count);
+        ASSERT_EQ(maxSize, statistics.maxSize);
+        ASSERT_EQ(averageSize, statistics.averageSize);
+    }
+
+    void recordQueryExecutionTask(QueryExecutionTaskRecord record)
+    {
+        m_statisticsCollector.recordQueryExecutionTask(std::move(record));
+    }
+
+    void enableSlowQueryLog(std::chrono::milliseconds threshold)
+    {
+        m_statisticsCollector.setSlowQueryThreshold(threshold);
+    }
+
+    void recordQuery(
+        std::string query, std::chrono::microseconds executionTime, int boundValueCount = 0)
+    {
+        m_statisticsCollector.recordQuery(std::move(query), executionTime, boundValueCount);
+    }
+
+    Statistics statistics() const
+    {
+        return m_statisticsCollector.getStatistics();
+    }
+
     void addRandomRecord()
     {
         using namespace std::chrono;
@@ -349,4 +384,69 @@ TEST_F(DbStatisticsCollector, queries_partially_expired_values_two)
         });
 }
 
+TEST_F(DbStatisticsCollector, modification_batch_sizes)
+{
+    assertModificationBatchStatisticsEqual(0, 0, 0);
+
+    recordModificationBatches({1, 3, 8});
+    assertModificationBatchStatisticsEqual(3, 8, 4);
+
+    waitForStatisticsToExpire();
+    assertModificationBatchStatisticsEqual(0, 0, 0);
+}
+
+TEST_F(DbStatisticsCollector, queue_wait_and_execution_are_tracked_separately)
+{
+    using namespace std::chrono;
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        QueryExecutionTaskRecord record;
+        record.waitForExecutionDuration = milliseconds(i);
+        record.executionDuration = milliseconds(1);
+        record.result = DBResultCode::ok;
+        recordQueryExecutionTask(record);
+    }
+
+    // The values are not limited to the statistics period.
+    waitForStatisticsToExpire();
+
+    const auto result = statistics();
+    ASSERT_EQ(100U, result.queueWaitTimes.count);
+    ASSERT_EQ(microseconds(milliseconds(100)), result.queueWaitTimes.max);
+    ASSERT_NEAR(50'000, result.queueWaitTimes.percentiles.at("50").count(), 50'000 / 32);
+    ASSERT_EQ(microseconds(milliseconds(1)), result.taskExecutionTimes.max);
+}
+
+TEST_F(DbStatisticsCollector, queries_are_aggregated_by_normalized_text)
+{
+    using namespace std::chrono;
+
+    recordQuery("SELECT * FROM t WHERE id = 1", microseconds(10));
+    recordQuery("SELECT * FROM t WHERE id = 2", microseconds(20));
+    recordQuery("DELETE FROM t WHERE id IN (1, 2)", milliseconds(5));
+
+    const auto result = statistics();
+    ASSERT_EQ(2U, result.slowestQueries.size());
+    ASSERT_EQ("DELETE FROM t WHERE id IN (?)", result.slowestQueries[0].query);
+    ASSERT_EQ("SELECT * FROM t WHERE id = ?", result.slowestQueries[1].query);
+    ASSERT_EQ(2U, result.slowestQueries[1].executionTimes.count);
+}
+
+TEST_F(DbStatisticsCollector, slow_queries_are_reported)
+{
+    using namespace std::chrono;
+
+    enableSlowQueryLog(milliseconds(10));
+
+    recordQuery("SELECT * FROM t WHERE id = ?", milliseconds(9), 1);
+    recordQuery("SELECT * FROM t WHERE name = 'foo'", milliseconds(11), 0);
+
+    const auto slowQueries = statistics().recentSlowQueries;
+    ASSERT_EQ(1U, slowQueries.size());
+    ASSERT_EQ("SELECT * FROM t WHERE name = 'foo'", slowQueries[0].query);
+    ASSERT_EQ(0, slowQueries[0].boundValueCount);
+    ASSERT_EQ(microseconds(milliseconds(11)), slowQueries[0].executionTime);
+}
+
 } // namespace nx::sql::test
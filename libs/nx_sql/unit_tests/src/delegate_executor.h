@@ -240,6 +240,13 @@ public:
             queryAggregationKey);
     }
 
+    virtual void executeMaintenance(
+        nx::utils::MoveOnlyFunc<DBResult(nx::sql::QueryContext*)> dbUpdateFunc,
+        nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler) override
+    {
+        m_delegate->executeMaintenance(std::move(dbUpdateFunc), std::move(completionHandler));
+    }
+
     virtual void executeSelect(
         nx::utils::MoveOnlyFunc<DBResult(nx::sql::QueryContext*)> dbSelectFunc,
         nx::utils::MoveOnlyFunc<void(DBResult)> completionHandler) override
@@ -1,6 +1,7 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
 #include <deque>
+#include <future>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -144,6 +145,11 @@ protected:
         m_queryQueue.setAggregationLimit(11);
     }
 
+    void setAggregationDelay(std::chrono::milliseconds delay)
+    {
+        m_queryQueue.setAggregationDelay(delay);
+    }
+
     void setConcurrentModificationQueryLimit(int limit)
     {
         m_queryQueue.setConcurrentModificationQueryLimit(limit);
@@ -182,6 +188,18 @@ protected:
         pushQuery(QueryType::lookup);
     }
 
+    void addMaintenanceQuery()
+    {
+        pushQuery(QueryType::maintenance);
+    }
+
+    void lowerMaintenanceQueryPriority()
+    {
+        m_queryQueue.setQueryPriority(
+            QueryType::maintenance,
+            detail::QueryQueue::kDefaultPriority - 1);
+    }
+
     void addMultipleModificationQueries(
         const std::string& queryAggregationKey = std::string())
     {
@@ -227,6 +245,18 @@ protected:
         m_prevPopResult = m_queryQueue.pop();
     }
 
+    void startPoppingQueries()
+    {
+        m_asyncPopResult = std::async(
+            std::launch::async,
+            [this]() { return m_queryQueue.pop(); });
+    }
+
+    void whenPoppedQueriesAreReceived()
+    {
+        m_prevPopResult = m_asyncPopResult.get();
+    }
+
     void whenReleasePoppedQueries()
     {
         m_prevPopResult = std::nullopt;
@@ -305,6 +335,13 @@ protected:
         ASSERT_LE(m_executedQueries.size(), m_queryQueue.aggregationLimit());
     }
 
+    void thenProvidedQueryCountIsEqualToAggregationLimit()
+    {
+        whenExecuteQueries();
+
+        ASSERT_EQ(m_queryQueue.aggregationLimit(), m_executedQueries.size());
+    }
+
     void andQueryAggregatesMultipleQueries()
     {
         whenExecuteQueries();
@@ -335,6 +372,7 @@ protected:
 
 private:
     std::optional<std::unique_ptr<AbstractExecutor>> m_prevPopResult;
+    std::future<std::optional<std::unique_ptr<AbstractExecutor>>> m_asyncPopResult;
     detail::QueryQueue m_queryQueue;
     nx::utils::SyncQueue<QueryType> m_timedOutQueries;
     std::deque<QueryType> m_queryTypes;
@@ -406,6 +444,19 @@ TEST_F(QueryQueue, select_query_priority_can_be_raised)
     assertSelectQueryIsReadFromQueue();
 }
 
+TEST_F(QueryQueue, interactive_queries_go_ahead_of_maintenance)
+{
+    lowerMaintenanceQueryPriority();
+
+    addMaintenanceQuery();
+    addMultipleModificationQueries();
+    addSelectQuery();
+
+    for (int i = 0; i < 11; ++i)
+        ASSERT_NE(QueryType::maintenance, (*queryQueue().pop())->queryType());
+    ASSERT_EQ(QueryType::maintenance, (*queryQueue().pop())->queryType());
+}
+
 TEST_F(QueryQueue, queries_aggregated_when_possible)
 {
     addMultipleModificationQueries("aggregation_key");
@@ -447,6 +498,39 @@ TEST_F(QueryQueue, aggregation_limit)
     thenProvidedQueryCountIsNotGreaterThanAggregationLimit();
 }
 
+TEST_F(QueryQueue, delayed_aggregation_collects_queries_pushed_after_pop_started)
+{
+    setAggregationLimit();
+    setAggregationDelay(std::chrono::hours(1));
+
+    startPoppingQueries();
+    addMoreModificationQueriesThanAggregationLimit();
+    whenPoppedQueriesAreReceived();
+
+    thenProvidedQueryCountIsEqualToAggregationLimit();
+}
+
+TEST_F(QueryQueue, delayed_aggregation_ends_when_delay_passes)
+{
+    setAggregationDelay(kQueryTimeout);
+
+    addMultipleModificationQueries("aggregation_key");
+    whenPopQueries();
+
+    thenQueriesAggregatedBeforeReturning();
+}
+
+TEST_F(QueryQueue, delayed_aggregation_ends_on_query_that_cannot_be_aggregated)
+{
+    setAggregationDelay(std::chrono::hours(1));
+
+    addMultipleModificationQueries("aggregation_key");
+    addSelectQuery();
+    whenPopQueries();
+
+    thenAggregatedQueriesOfSpecificTypeAreProvided(QueryType::modification);
+}
+
 TEST_F(QueryQueue, pending_query_count_is_reported_correctly)
 {
     const int expected = addSeveralQueriesOfDifferentType();
@@ -0,0 +1,167 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/sql/prepared_statement_cache.h>
+#include <nx/sql/qt_db_connection.h>
+#include <nx/sql/query.h>
+
+namespace nx::sql::test {
+
+class PreparedStatements:
+    public ::testing::Test
+{
+public:
+    PreparedStatements():
+        m_connection(connectionOptions()),
+        m_cache(kCacheSize)
+    {
+    }
+
+protected:
+    static constexpr int kCacheSize = 2;
+    static constexpr char kInsert[] = "INSERT INTO data(id, name) VALUES (?, ?)";
+    static constexpr char kSelect[] = "SELECT name FROM data WHERE id >= ? ORDER BY id";
+
+    virtual void SetUp() override
+    {
+        ASSERT_TRUE(m_connection.open());
+        m_connection.executeQuery("CREATE TABLE data(id INTEGER, name TEXT)");
+    }
+
+    std::unique_ptr<SqlQuery> createQuery()
+    {
+        return std::make_unique<SqlQuery>(
+            *m_connection.qtSqlConnection(), /*statisticsCollector*/ nullptr, &m_cache);
+    }
+
+    void insert(int id)
+    {
+        auto query = createQuery();
+        query->prepareWithValues(kInsert, id, std::to_string(id));
+        query->exec();
+    }
+
+    bool isCached(const QString& queryText, bool forwardOnly = false)
+    {
+        auto statement = m_cache.take(queryText, forwardOnly);
+        if (!statement)
+            return false;
+
+        m_cache.put(queryText, std::move(*statement), m_cache.generation());
+        return true;
+    }
+
+    std::vector<std::string> readNames(SqlQuery* query)
+    {
+        std::vector<std::string> names;
+        while (query->next())
+            names.push_back(query->value<std::string>(0));
+        return names;
+    }
+
+private:
+    static ConnectionOptions connectionOptions()
+    {
+        ConnectionOptions options;
+        options.driverType = RdbmsDriverType::sqlite;
+        options.dbName = ":memory:";
+        return options;
+    }
+
+private:
+    QtDbConnection m_connection;
+
+protected:
+    PreparedStatementCache m_cache;
+};
+
+TEST_F(PreparedStatements, statement_is_returned_to_cache_when_query_is_done)
+{
+    auto query = createQuery();
+    query->prepareWithValues(kInsert, 1, std::string("1"));
+    query->exec();
+    ASSERT_FALSE(isCached(kInsert));
+
+    query.reset();
+    ASSERT_TRUE(isCached(kInsert));
+
+    for (int i = 2; i <= 5; ++i)
+        insert(i);
+
+    auto select = createQuery();
+    select->prepareWithValues(kSelect, 3);
+    select->exec();
+    ASSERT_EQ((std::vector<std::string>{"3", "4", "5"}), readNames(select.get()));
+
+    // Preparing another statement returns the previous one.
+    select->prepare("SELECT count(*) FROM data");
+    ASSERT_TRUE(isCached(kSelect));
+    select->exec();
+    ASSERT_TRUE(select->next());
+    ASSERT_EQ(5, select->value<int>(0));
+}
+
+TEST_F(PreparedStatements, statement_is_not_shared_by_concurrent_queries)
+{
+    for (int i = 1; i <= 3; ++i)
+        insert(i);
+
+    auto first = createQuery();
+    first->prepareWithValues(kSelect, 1);
+    first->exec();
+    ASSERT_TRUE(first->next());
+
+    auto second = createQuery();
+    second->prepareWithValues(kSelect, 2);
+    second->exec();
+
+    ASSERT_EQ((std::vector<std::string>{"2", "3"}), readNames(second.get()));
+    ASSERT_EQ((std::vector<std::string>{"2", "3"}), readNames(first.get()));
+}
+
+TEST_F(PreparedStatements, least_recently_used_statement_is_dropped)
+{
+    insert(1);
+
+    for (const char* queryText: {kSelect, "SELECT id FROM data", "SELECT name FROM data"})
+    {
+        auto query = createQuery();
+        query->prepare(queryText);
+    }
+
+    ASSERT_FALSE(isCached(kSelect));
+    ASSERT_TRUE(isCached("SELECT id FROM data"));
+    ASSERT_TRUE(isCached("SELECT name FROM data"));
+}
+
+TEST_F(PreparedStatements, forward_only_statements_are_cached_separately)
+{
+    auto query = createQuery();
+    query->setForwardOnly(true);
+    query->prepare(kSelect);
+    query.reset();
+
+    ASSERT_FALSE(isCached(kSelect));
+    ASSERT_TRUE(isCached(kSelect, /*forwardOnly*/ true));
+}
+
+TEST_F(PreparedStatements, schema_update_invalidates_statements)
+{
+    insert(1);
+
+    auto query = createQuery();
+    query->prepare(kSelect);
+    PreparedStatementCache::invalidateAll();
+    query.reset();
+
+    // Prepared before the update, so not returned to the cache.
+    ASSERT_FALSE(isCached(kSelect));
+    ASSERT_FALSE(isCached(kInsert));
+}
+
+} // namespace nx::sql::test
@@ -18,4 +18,20 @@ TEST(DbVersion, parse)
     ASSERT_EQ(std::nullopt, detail::parseVersion("abcdef"));
 }
 
+TEST(NormalizeQuery, literals_and_lists_are_replaced)
+{
+    ASSERT_EQ(
+        "SELECT * FROM t WHERE id IN (?) AND name = ? AND col1 = ?",
+        detail::normalizeQuery(
+            "SELECT *  FROM t\n  WHERE id IN (1, 2, 3) AND name = 'it''s' AND col1 = ?"));
+
+    ASSERT_EQ(
+        "UPDATE t SET v=?, w = ? WHERE k IN (?)",
+        detail::normalizeQuery("UPDATE t SET v='a', w = 3.5 WHERE k IN (?,?,?) "));
+
+    ASSERT_EQ(
+        detail::normalizeQuery("DELETE FROM t WHERE id = 1"),
+        detail::normalizeQuery("DELETE FROM t WHERE id = 17"));
+}
+
 } // namespace nx::sql::test
@@ -0,0 +1,63 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <array>
+#include <functional>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <nx/utils/move_only_func.h>
+
+namespace nx::utils::test {
+
+namespace {
+
+/**
+ * A typical AIO completion handler captures "this" and a couple of values. The large one does
+ * not fit into any small buffer.
+ */
+template<std::size_t CaptureSize>
+struct Handler
+{
+    std::array<char, CaptureSize> capture{};
+
+    int operator()(int value) const { return value + capture[0]; }
+};
+
+template<typename Func, std::size_t CaptureSize>
+void constructAndInvoke(benchmark::State& state)
+{
+    int value = 0;
+    for (auto _: state)
+    {
+        Func func(Handler<CaptureSize>{});
+        value = func(value);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+template<typename Func>
+void moveAndInvoke(benchmark::State& state)
+{
+    Func func(Handler<16>{});
+    int value = 0;
+    for (auto _: state)
+    {
+        Func moved(std::move(func));
+        value = moved(value);
+        func = std::move(moved);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(constructAndInvoke, MoveOnlyFunc<int(int)>, 16);
+BENCHMARK_TEMPLATE(constructAndInvoke, std::function<int(int)>, 16);
+BENCHMARK_TEMPLATE(constructAndInvoke, MoveOnlyFunc<int(int)>, 128);
+BENCHMARK_TEMPLATE(constructAndInvoke, std::function<int(int)>, 128);
+
+BENCHMARK_TEMPLATE(moveAndInvoke, MoveOnlyFunc<int(int)>);
+BENCHMARK_TEMPLATE(moveAndInvoke, std::function<int(int)>);
+
+} // namespace nx::utils::test
@@ -0,0 +1,48 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <nx/utils/thread/sync_queue.h>
+
+namespace nx::utils::test {
+
+static void SyncQueue_pushPop(benchmark::State& state)
+{
+    SyncQueue<int> queue;
+    for (auto _: state)
+    {
+        queue.push(1);
+        benchmark::DoNotOptimize(queue.pop());
+    }
+}
+BENCHMARK(SyncQueue_pushPop);
+
+/**
+ * A producer thread pushes state.range(0) values while the benchmark thread pops them.
+ */
+static void SyncQueue_producerConsumer(benchmark::State& state)
+{
+    const int count = (int) state.range(0);
+
+    SyncQueue<int> queue;
+    for (auto _: state)
+    {
+        std::thread producer(
+            [&queue, count]()
+            {
+                for (int i = 0; i < count; ++i)
+                    queue.push(i);
+            });
+
+        for (int i = 0; i < count; ++i)
+            benchmark::DoNotOptimize(queue.pop());
+
+        producer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(SyncQueue_producerConsumer)->Arg(10'000)->UseRealTime();
+
+} // namespace nx::utils::test
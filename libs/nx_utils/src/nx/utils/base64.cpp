@@ -2,15 +2,405 @@
 
 #include "base64.h"
 
-namespace nx::utils {
+#include <array>
+#include <cstdint>
+
+#include "cpu_features.h"
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+    #include <immintrin.h>
+#elif defined(NX_NEON_SUPPORTED)
+    #include <arm_neon.h>
+#endif
 
-// TODO: #akolesnikov Get rid of QByteArray in base64 functions. It will save 2 allocations.
-// TODO: #akolesnikov Introduce in-place conversion. That will allow implementing fromBase64(String&&)
-// without allocations at all.
-// TODO: #akolesnikov Provide single implementation.
+namespace nx::utils {
 
 namespace {
 
+static constexpr char kAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static constexpr char kUrlAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/** Maps a character to its 6-bit value, -1 for characters out of the alphabet. */
+using DecodeTable = std::array<std::int8_t, 256>;
+
+constexpr DecodeTable makeDecodeTable(const char* alphabet)
+{
+    DecodeTable table{};
+    for (auto& value: table)
+        value = -1;
+    for (int i = 0; i < 64; ++i)
+        table[(std::uint8_t) alphabet[i]] = (std::int8_t) i;
+    return table;
+}
+
+static constexpr DecodeTable kDecodeTable = makeDecodeTable(kAlphabet);
+static constexpr DecodeTable kUrlDecodeTable = makeDecodeTable(kUrlAlphabet);
+
+//-------------------------------------------------------------------------------------------------
+// Scalar implementation.
+
+std::size_t encodeScalar(
+    const std::uint8_t* data, std::size_t size, char* out, const char* alphabet, bool pad)
+{
+    char* const outBegin = out;
+
+    std::size_t i = 0;
+    for (; i + 3 <= size; i += 3)
+    {
+        const std::uint32_t triple = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        *out++ = alphabet[triple >> 18];
+        *out++ = alphabet[(triple >> 12) & 0x3f];
+        *out++ = alphabet[(triple >> 6) & 0x3f];
+        *out++ = alphabet[triple & 0x3f];
+    }
+
+    if (size - i == 1)
+    {
+        const std::uint32_t triple = data[i] << 16;
+        *out++ = alphabet[triple >> 18];
+        *out++ = alphabet[(triple >> 12) & 0x3f];
+        if (pad)
+        {
+            *out++ = '=';
+            *out++ = '=';
+        }
+    }
+    else if (size - i == 2)
+    {
+        const std::uint32_t triple = (data[i] << 16) | (data[i + 1] << 8);
+        *out++ = alphabet[triple >> 18];
+        *out++ = alphabet[(triple >> 12) & 0x3f];
+        *out++ = alphabet[(triple >> 6) & 0x3f];
+        if (pad)
+            *out++ = '=';
+    }
+
+    return out - outBegin;
+}
+
+/**
+ * Decodes characters until a 4-character quantum is complete or the input ends.
+ * Characters out of the alphabet (including the padding) are skipped as QByteArray::fromBase64
+ * does.
+ * @return The first character not processed.
+ */
+const char* decodeScalar(
+    const char* data,
+    const char* end,
+    std::uint8_t** out,
+    Base64Decoder::State* state,
+    const DecodeTable& table)
+{
+    while (data != end)
+    {
+        const auto value = table[(std::uint8_t) *data++];
+        if (value < 0)
+            continue;
+
+        state->bits = (state->bits << 6) | (std::uint32_t) value;
+        state->bitCount += 6;
+        if (state->bitCount >= 8)
+        {
+            state->bitCount -= 8;
+            *(*out)++ = (std::uint8_t) (state->bits >> state->bitCount);
+            state->bits &= (1U << state->bitCount) - 1;
+        }
+
+        if (state->bitCount == 0)
+            break;
+    }
+
+    return data;
+}
+
+//-------------------------------------------------------------------------------------------------
+// AVX2 implementation. See "Faster Base64 Encoding and Decoding Using AVX2 Instructions"
+// by W. Mula and D. Lemire.
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+
+/**
+ * Encodes 24-byte blocks into 32 characters while 28 bytes can be read.
+ * @return Number of bytes encoded.
+ */
+NX_TARGET_AVX2 std::size_t encodeAvx2(
+    const std::uint8_t* data, std::size_t size, char* out, bool isUrl)
+{
+    const __m256i shuffle = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const char c62 = isUrl ? '-' : '+';
+    const char c63 = isUrl ? '_' : '/';
+    // Offset to add to the 6-bit value to get the character, indexed by the value range.
+    const __m256i offsets = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, c62 - 62, c63 - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, c62 - 62, c63 - 63, 'A', 0, 0);
+
+    std::size_t i = 0;
+    for (; size - i >= 28; i += 24, out += 32)
+    {
+        const __m128i low = _mm_loadu_si128((const __m128i*) (data + i));
+        const __m128i high = _mm_loadu_si128((const __m128i*) (data + i + 12));
+        __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        input = _mm256_shuffle_epi8(input, shuffle);
+
+        // Splitting every 3 bytes into 4 6-bit values.
+        const __m256i t0 = _mm256_and_si256(input, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(input, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i values = _mm256_or_si256(t1, t3);
+
+        __m256i offsetIndices = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+        const __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), values);
+        offsetIndices = _mm256_or_si256(
+            offsetIndices, _mm256_and_si256(isUpper, _mm256_set1_epi8(13)));
+
+        const __m256i chars = _mm256_add_epi8(
+            values, _mm256_shuffle_epi8(offsets, offsetIndices));
+        _mm256_storeu_si256((__m256i*) out, chars);
+    }
+
+    return i;
+}
+
+/**
+ * Decodes 32-character blocks into 24 bytes while the block has only alphabet characters and
+ * there are 32 bytes of the output space.
+ * @return The first character not processed.
+ */
+NX_TARGET_AVX2 const char* decodeAvx2(
+    const char* data, const char* end, std::uint8_t** out, std::uint8_t* outEnd, bool isUrl)
+{
+    // Bit sets of the invalid characters by the low nibble and the high nibble classes.
+    // A character is valid if the sets have no common bits.
+    const __m256i lowNibbleInvalidClasses = isUrl
+        ? _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x3B, 0x3B, 0x3A, 0x3B, 0x33,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x3B, 0x3B, 0x3A, 0x3B, 0x33)
+        : _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i highNibbleClasses = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, isUrl ? 0x20 : 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, isUrl ? 0x20 : 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+
+    // Offset to add to the character to get the 6-bit value, indexed by the high nibble.
+    // The character 63 needs a special offset: '/' shares the nibble with '+', so it is indexed
+    // by the unused slot 1, '_' shares the nibble with the upper case letters, so it gets an
+    // additional offset.
+    const __m256i offsets = isUrl
+        ? _mm256_setr_epi8(
+            0, 0, 62 - '-', 52 - '0', -'A', -'A', 26 - 'a', 26 - 'a', 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 62 - '-', 52 - '0', -'A', -'A', 26 - 'a', 26 - 'a', 0, 0, 0, 0, 0, 0, 0, 0)
+        : _mm256_setr_epi8(
+            0, 63 - '/', 62 - '+', 52 - '0', -'A', -'A', 26 - 'a', 26 - 'a', 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 63 - '/', 62 - '+', 52 - '0', -'A', -'A', 26 - 'a', 26 - 'a', 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i c63 = _mm256_set1_epi8(isUrl ? '_' : '/');
+    const __m256i c63IndexShift = _mm256_set1_epi8(isUrl ? 0 : -1);
+    const __m256i c63AdditionalOffset = _mm256_set1_epi8(isUrl ? 63 - '_' + 'A' : 0);
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0f);
+
+    const __m256i packShuffle = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i packPermutation = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+
+    while (end - data >= 32 && outEnd - *out >= 32)
+    {
+        const __m256i chars = _mm256_loadu_si256((const __m256i*) data);
+        const __m256i highNibbles =
+            _mm256_and_si256(_mm256_srli_epi32(chars, 4), nibbleMask);
+        const __m256i lowNibbles = _mm256_and_si256(chars, nibbleMask);
+        if (!_mm256_testz_si256(
+            _mm256_shuffle_epi8(lowNibbleInvalidClasses, lowNibbles),
+            _mm256_shuffle_epi8(highNibbleClasses, highNibbles)))
+        {
+            break;
+        }
+
+        const __m256i isC63 = _mm256_cmpeq_epi8(chars, c63);
+        const __m256i offsetIndices =
+            _mm256_add_epi8(highNibbles, _mm256_and_si256(isC63, c63IndexShift));
+        __m256i values = _mm256_add_epi8(chars, _mm256_shuffle_epi8(offsets, offsetIndices));
+        values = _mm256_add_epi8(values, _mm256_and_si256(isC63, c63AdditionalOffset));
+
+        // Joining every 4 6-bit values into 3 bytes.
+        const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        const __m256i bytes = _mm256_permutevar8x32_epi32(
+            _mm256_shuffle_epi8(triples, packShuffle), packPermutation);
+        _mm256_storeu_si256((__m256i*) *out, bytes);
+
+        data += 32;
+        *out += 24;
+    }
+
+    return data;
+}
+
+#endif // NX_AVX2_CODE_SUPPORTED
+
+//-------------------------------------------------------------------------------------------------
+// NEON implementation.
+
+#if defined(NX_NEON_SUPPORTED)
+
+uint8x16x4_t loadTable(const std::uint8_t* table)
+{
+    return {{vld1q_u8(table), vld1q_u8(table + 16), vld1q_u8(table + 32), vld1q_u8(table + 48)}};
+}
+
+/**
+ * Encodes 48-byte blocks into 64 characters.
+ * @return Number of bytes encoded.
+ */
+std::size_t encodeNeon(const std::uint8_t* data, std::size_t size, char* out, bool isUrl)
+{
+    const uint8x16x4_t alphabet =
+        loadTable((const std::uint8_t*) (isUrl ? kUrlAlphabet : kAlphabet));
+    const uint8x16_t mask = vdupq_n_u8(0x3f);
+
+    std::size_t i = 0;
+    for (; size - i >= 48; i += 48, out += 64)
+    {
+        const uint8x16x3_t input = vld3q_u8(data + i);
+
+        uint8x16x4_t chars;
+        chars.val[0] = vqtbl4q_u8(alphabet, vshrq_n_u8(input.val[0], 2));
+        chars.val[1] = vqtbl4q_u8(alphabet, vandq_u8(
+            vorrq_u8(vshlq_n_u8(input.val[0], 4), vshrq_n_u8(input.val[1], 4)), mask));
+        chars.val[2] = vqtbl4q_u8(alphabet, vandq_u8(
+            vorrq_u8(vshlq_n_u8(input.val[1], 2), vshrq_n_u8(input.val[2], 6)), mask));
+        chars.val[3] = vqtbl4q_u8(alphabet, vandq_u8(input.val[2], mask));
+        vst4q_u8((std::uint8_t*) out, chars);
+    }
+
+    return i;
+}
+
+/**
+ * Decodes 64-character blocks into 48 bytes while the block has only alphabet characters and
+ * there are 48 bytes of the output space.
+ * @return The first character not processed.
+ */
+const char* decodeNeon(
+    const char* data, const char* end, std::uint8_t** out, std::uint8_t* outEnd, bool isUrl)
+{
+    const auto table = (const std::uint8_t*) (isUrl ? kUrlDecodeTable : kDecodeTable).data();
+    const uint8x16x4_t lowTable = loadTable(table);
+    const uint8x16x4_t highTable = loadTable(table + 64);
+    const uint8x16_t highHalf = vdupq_n_u8(0x40);
+
+    while (end - data >= 64 && outEnd - *out >= 48)
+    {
+        const uint8x16x4_t chars = vld4q_u8((const std::uint8_t*) data);
+
+        // The table lookup gives 0 for the indexes out of the table, 0xff is the invalid value.
+        uint8x16_t values[4];
+        uint8x16_t errors = vdupq_n_u8(0);
+        for (int j = 0; j < 4; ++j)
+        {
+            values[j] = vorrq_u8(
+                vqtbl4q_u8(lowTable, chars.val[j]),
+                vqtbl4q_u8(highTable, veorq_u8(chars.val[j], highHalf)));
+            errors = vorrq_u8(errors, vorrq_u8(values[j], chars.val[j]));
+        }
+        if (vmaxvq_u8(errors) & 0x80)
+            break;
+
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(values[0], 2), vshrq_n_u8(values[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(values[1], 4), vshrq_n_u8(values[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(values[2], 6), values[3]);
+        vst3q_u8(*out, bytes);
+
+        data += 64;
+        *out += 48;
+    }
+
+    return data;
+}
+
+#endif // NX_NEON_SUPPORTED
+
+//-------------------------------------------------------------------------------------------------
+
+std::size_t encode(const void* data, std::size_t size, char* out, bool isUrl)
+{
+    const auto bytes = (const std::uint8_t*) data;
+    std::size_t encodedBytes = 0;
+
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (cpuSupportsAvx2())
+            encodedBytes = encodeAvx2(bytes, size, out, isUrl);
+    #elif defined(NX_NEON_SUPPORTED)
+        encodedBytes = encodeNeon(bytes, size, out, isUrl);
+    #endif
+
+    const std::size_t encodedChars = encodedBytes / 3 * 4;
+    return encodedChars + encodeScalar(
+        bytes + encodedBytes,
+        size - encodedBytes,
+        out + encodedChars,
+        isUrl ? kUrlAlphabet : kAlphabet,
+        /*pad*/ !isUrl);
+}
+
+/**
+ * Processes the longest prefix of whole blocks consisting of the alphabet characters.
+ */
+const char* decodeBlocks(
+    const char* data, const char* end, std::uint8_t** out, std::uint8_t* outEnd, bool isUrl)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (cpuSupportsAvx2())
+            return decodeAvx2(data, end, out, outEnd, isUrl);
+    #elif defined(NX_NEON_SUPPORTED)
+        return decodeNeon(data, end, out, outEnd, isUrl);
+    #endif
+
+    (void) end;
+    (void) out;
+    (void) outEnd;
+    (void) isUrl;
+    return data;
+}
+
+std::size_t decode(
+    const char* data,
+    std::size_t size,
+    std::uint8_t* out,
+    std::size_t outCapacity,
+    Base64Decoder::State* state,
+    bool isUrl)
+{
+    const char* const end = data + size;
+    std::uint8_t* const outBegin = out;
+    std::uint8_t* const outEnd = out + outCapacity;
+    const auto& table = isUrl ? kUrlDecodeTable : kDecodeTable;
+
+    while (data != end)
+    {
+        // Blocks can be decoded only on the quantum boundary.
+        if (state->bitCount == 0)
+            data = decodeBlocks(data, end, &out, outEnd, isUrl);
+        data = decodeScalar(data, end, &out, state, table);
+    }
+
+    return out - outBegin;
+}
+
 int toBase64Internal(
     const void* data, int size,
     char* outBuf, int outBufCapacity, bool isUrl)
@@ -23,12 +413,7 @@ int toBase64Internal(
     if (outBufCapacity < encodedLength)
         return -1;
 
-    const auto encoded =
-        QByteArray::fromRawData((const char*) data, size)
-            .toBase64(isUrl ? (QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals)
-                            : QByteArray::Base64Encoding);
-    memcpy(outBuf, encoded.data(), encoded.size());
-    return encoded.size();
+    return (int) encode(data, (std::size_t) size, outBuf, isUrl);
 }
 
 } // anonymous namespace
@@ -74,11 +459,12 @@ int fromBase64UrlInternal(
     if (outBufCapacity < decodedLength)
         return -1;
 
-    const auto decoded = QByteArray::fromBase64(
-        QByteArray::fromRawData((const char*) data, size),
-        isUrl ? QByteArray::Base64UrlEncoding : QByteArray::Base64Encoding);
-    memcpy(outBuf, decoded.data(), decoded.size());
-    return decoded.size();
+    Base64Decoder::State state;
+    return (int) decode(
+        data, (std::size_t) size,
+        (std::uint8_t*) outBuf, (std::size_t) outBufCapacity,
+        &state,
+        isUrl);
 }
 
 } // anonymous namespace
@@ -97,4 +483,29 @@ int fromBase64Url(
     return fromBase64UrlInternal(data, size, outBuf, outBufCapacity, true);
 }
 
+//-------------------------------------------------------------------------------------------------
+
+Base64Decoder::Base64Decoder(Alphabet alphabet):
+    m_isUrl(alphabet == Alphabet::url)
+{
+}
+
+void Base64Decoder::decode(const std::string_view& data, std::string* out)
+{
+    // Every 4 characters give 3 bytes, the pending bits give 2 bytes at most.
+    const auto pos = out->size();
+    out->resize(pos + data.size() / 4 * 3 + 3);
+    const auto decodedSize = nx::utils::decode(
+        data.data(), data.size(),
+        (std::uint8_t*) out->data() + pos, out->size() - pos,
+        &m_state,
+        m_isUrl);
+    out->resize(pos + decodedSize);
+}
+
+void Base64Decoder::reset()
+{
+    m_state = State();
+}
+
 } // namespace nx::utils
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -50,6 +51,42 @@ NX_UTILS_API int fromBase64Url(
 
 NX_UTILS_API int estimateBase64DecodedLen(const char* encoded, int size);
 
+/**
+ * Incremental base64 decoder: the encoded text can be split into chunks at arbitrary positions.
+ * Decoding all the chunks gives the same result as fromBase64() of the whole text.
+ * Characters out of the alphabet are skipped.
+ */
+class NX_UTILS_API Base64Decoder
+{
+public:
+    enum class Alphabet
+    {
+        standard,
+        url,
+    };
+
+    /** Bits of the incomplete 4-character quantum. */
+    struct State
+    {
+        std::uint32_t bits = 0;
+        int bitCount = 0;
+    };
+
+    Base64Decoder(Alphabet alphabet = Alphabet::standard);
+
+    /**
+     * Appends the decoded bytes to out. Up to 2 bytes of the incomplete quantum are held until
+     * the next call.
+     */
+    void decode(const std::string_view& data, std::string* out);
+
+    void reset();
+
+private:
+    bool m_isUrl = false;
+    State m_state;
+};
+
 inline std::string toBase64(const std::string_view& str)
 {
     std::string result;
@@ -2,8 +2,10 @@
 
 #include "byte_array.h"
 
-#include <nx/kit/utils.h>
+#include <cstring>
+
 #include <nx/utils/log/assert.h>
+#include <nx/utils/memory/aligned_buffer_pool.h>
 
 namespace nx::utils {
 
@@ -22,7 +24,7 @@ ByteArray::ByteArray(
 
 ByteArray::~ByteArray()
 {
-    nx::kit::utils::freeAligned(m_data);
+    freeBuffer();
 }
 
 void ByteArray::clear()
@@ -140,7 +142,7 @@ ByteArray& ByteArray::operator=(const ByteArray& right)
     if (&right == this)
         return *this;
 
-    nx::kit::utils::freeAligned(m_data);
+    freeBuffer();
 
     m_alignment = right.m_alignment;
     m_capacity = right.m_size;
@@ -160,24 +162,28 @@ ByteArray& ByteArray::operator=(ByteArray&& right) noexcept
     if (&right == this)
         return *this;
 
-    nx::kit::utils::freeAligned(m_data);
+    freeBuffer();
 
-    m_alignment = std::move(right.m_alignment);
-    m_capacity = std::move(right.m_size);
-    m_size = std::move(right.m_size);
-    m_padding = std::move(right.m_padding);
-    m_ignore = std::move(right.m_ignore);
-    m_data = std::move(right.m_data);
+    m_alignment = right.m_alignment;
+    m_capacity = right.m_capacity;
+    m_size = right.m_size;
+    m_padding = right.m_padding;
+    m_ignore = right.m_ignore;
+    m_data = right.m_data;
 
     // Avoid data double-free.
     right.m_data = nullptr;
+    right.m_capacity = 0;
+    right.m_size = 0;
+    right.m_ignore = 0;
 
     return *this;
 }
 
 char* ByteArray::allocateBuffer(size_t capacity)
 {
-    char* data = (char*) nx::kit::utils::mallocAligned((size_t) capacity + m_padding, m_alignment);
+    char* data = (char*) memory::AlignedBufferPool::instance().allocate(
+        capacity + m_padding, m_alignment);
 
     // If the first 23 bits of the additional bytes are not 0, then damaged MPEG bitstreams could
     // cause overread and segfault.
@@ -186,6 +192,13 @@ char* ByteArray::allocateBuffer(size_t capacity)
     return data;
 }
 
+void ByteArray::freeBuffer()
+{
+    // The pool needs the same size and alignment the buffer was allocated with.
+    memory::AlignedBufferPool::instance().deallocate(m_data, m_capacity + m_padding, m_alignment);
+    m_data = nullptr;
+}
+
 bool ByteArray::reallocate(size_t capacity)
 {
     if (!(NX_ASSERT(capacity >= m_size,
@@ -205,8 +218,7 @@ bool ByteArray::reallocate(size_t capacity)
     if (m_data && m_size)
         memcpy(data, m_data, m_size);
 
-    if (m_data)
-        nx::kit::utils::freeAligned(m_data);
+    freeBuffer();
 
     m_capacity = capacity;
     m_data = data;
@@ -153,6 +153,7 @@ public:
 private:
     bool reallocate(size_t capacity);
     char* allocateBuffer(size_t capacity);
+    void freeBuffer();
 
 private:
     size_t m_alignment = 1;
@@ -11,6 +11,17 @@ AbstractByteStreamFilter::AbstractByteStreamFilter(
 {
 }
 
+bool AbstractByteStreamFilter::processData(const nx::BufferChain& data)
+{
+    for (const auto& slice: data)
+    {
+        if (!processData(slice.view()))
+            return false;
+    }
+
+    return true;
+}
+
 size_t AbstractByteStreamFilter::flush()
 {
     if (!m_nextFilter)
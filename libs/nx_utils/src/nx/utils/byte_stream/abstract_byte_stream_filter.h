@@ -5,6 +5,7 @@
 #include <memory>
 
 #include <nx/utils/buffer.h>
+#include <nx/utils/shared_buffer.h>
 
 namespace nx::utils::bstream {
 
@@ -26,6 +27,14 @@ public:
      */
     virtual bool processData(const ConstBufferRefType& data) = 0;
 
+    /**
+     * Passes the slices to processData one after another without joining them.
+     * NOTE: A successor that overrides processData has to add
+     * "using AbstractByteStreamFilter::processData;" to make this overload visible.
+     * @return false in case of error.
+     */
+    bool processData(const nx::BufferChain& data);
+
     /**
      * Implementation SHOULD process any cached data.
      * This method is usually signals end of source data.
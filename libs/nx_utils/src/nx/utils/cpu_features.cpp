@@ -0,0 +1,87 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "cpu_features.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <immintrin.h>
+    #include <intrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <cpuid.h>
+#endif
+
+namespace nx::utils {
+
+namespace {
+
+bool detectAvx2()
+{
+    #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4] = {0};
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+        static constexpr int kOsXsave = 1 << 27;
+        static constexpr int kAvx = 1 << 28;
+        if ((info[2] & (kOsXsave | kAvx)) != (kOsXsave | kAvx))
+            return false;
+
+        // The OS saves the YMM registers on context switch.
+        if ((_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        static constexpr int kAvx2 = 1 << 5;
+        return (info[1] & kAvx2) != 0;
+    #elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        // Checks the OS support too.
+        return __builtin_cpu_supports("avx2");
+    #else
+        return false;
+    #endif
+}
+
+/**
+ * @return ECX of the CPUID leaf 1, 0 on non-x86 CPUs.
+ */
+unsigned int cpuidFeatureFlags()
+{
+    #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4] = {0};
+        __cpuid(info, 1);
+        return (unsigned int) info[2];
+    #elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return 0;
+        return ecx;
+    #else
+        return 0;
+    #endif
+}
+
+} // namespace
+
+bool cpuSupportsAvx2()
+{
+    static const bool result = detectAvx2();
+    return result;
+}
+
+bool cpuSupportsSse42()
+{
+    static constexpr unsigned int kSse42 = 1 << 20;
+    static const bool result = (cpuidFeatureFlags() & kSse42) != 0;
+    return result;
+}
+
+bool cpuSupportsPclmul()
+{
+    static constexpr unsigned int kPclmul = 1 << 1;
+    static constexpr unsigned int kSse41 = 1 << 19;
+    static const bool result = (cpuidFeatureFlags() & (kPclmul | kSse41)) == (kPclmul | kSse41);
+    return result;
+}
+
+} // namespace nx::utils
@@ -0,0 +1,40 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+/**
+ * NX_AVX2_CODE_SUPPORTED: x86 SIMD code can be compiled. It has to be marked with the
+ * NX_TARGET_... macro of the instruction set and invoked only if the corresponding
+ * cpuSupports...() returns true.
+ * NX_NEON_SUPPORTED: NEON is always available on the target CPU.
+ */
+#if defined(__x86_64__) || defined(_M_X64)
+    #define NX_AVX2_CODE_SUPPORTED
+    #if defined(__GNUC__) || defined(__clang__)
+        #define NX_TARGET_AVX2 __attribute__((target("avx2")))
+        #define NX_TARGET_SSE42 __attribute__((target("sse4.2")))
+        #define NX_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+    #else
+        #define NX_TARGET_AVX2
+        #define NX_TARGET_SSE42
+        #define NX_TARGET_PCLMUL
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define NX_NEON_SUPPORTED
+#endif
+
+namespace nx::utils {
+
+/**
+ * @return true if both the CPU and the OS support AVX2. Always false on non-x86 CPUs.
+ * The result is detected once.
+ */
+NX_UTILS_API bool cpuSupportsAvx2();
+
+/** @return true if the CPU has the SSE4.2 instructions, crc32 included. */
+NX_UTILS_API bool cpuSupportsSse42();
+
+/** @return true if the CPU has the carry-less multiplication and the SSE4.1 instructions. */
+NX_UTILS_API bool cpuSupportsPclmul();
+
+} // namespace nx::utils
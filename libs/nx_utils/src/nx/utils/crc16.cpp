@@ -1,6 +1,9 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
 #include "crc16.h"
+
+#include <array>
+
 #include <nx/utils/log/assert.h>
 
 namespace nx {
@@ -8,21 +11,29 @@ namespace utils {
 
 namespace {
 
+static constexpr uint16_t kIbmReversedPolynomial = 0xA001;
+
+constexpr std::array<uint16_t, 256> makeTable(uint16_t polynomial)
+{
+    std::array<uint16_t, 256> table{};
+    for (int i = 0; i < 256; ++i)
+    {
+        uint16_t crc = (uint16_t) i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 0x01) ? ((crc >> 1) ^ polynomial) : (crc >> 1);
+        table[i] = crc;
+    }
+    return table;
+}
+
+static constexpr auto kIbmReversedTable = makeTable(kIbmReversedPolynomial);
+
 static uint16_t crc16ibmRev(const uint8_t* ptr, size_t count)
 {
-   uint16_t crc = 0;
-   while (count--)
-   {
-      crc ^= (uint16_t) *ptr++;
-      for (int i = 0; i < 8; ++i)
-      {
-         if ((crc & 0x01) != 0)
-            crc = (crc >> 1) ^ 0xA001;
-         else
-            crc >>= 1;
-      }
-   }
-   return crc;
+    uint16_t crc = 0;
+    while (count--)
+        crc = (crc >> 8) ^ kIbmReversedTable[(crc ^ *ptr++) & 0xff];
+    return crc;
 }
 
 } // namespace
@@ -2,8 +2,20 @@
 
 #include "crc32.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include <nx/utils/zlib.h>
 
+#include "cpu_features.h"
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+    #include <immintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+#endif
+
 static inline uLong zlib_crc32(uLong crc, const Bytef *buf, uInt len)
 {
     return crc32(crc, buf, len);
@@ -16,9 +28,240 @@ namespace utils {
     #undef crc32 //< crc32 can be a macro.
 #endif
 
+namespace {
+
+//-------------------------------------------------------------------------------------------------
+// CRC-32.
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+
+inline __m128i load(const std::uint8_t* data)
+{
+    return _mm_loadu_si128((const __m128i*) data);
+}
+
+/**
+ * Multiplies the 64-bit halves of the value by the constants and adds them to the next value.
+ */
+NX_TARGET_PCLMUL inline __m128i fold(__m128i value, __m128i constants, __m128i next)
+{
+    return _mm_xor_si128(
+        _mm_xor_si128(
+            _mm_clmulepi64_si128(value, constants, 0x00),
+            _mm_clmulepi64_si128(value, constants, 0x11)),
+        next);
+}
+
+/**
+ * Folds 64-byte blocks with the carry-less multiplication and reduces the remainder with the
+ * Barrett reduction. See "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+ * Instruction" by V. Gopal et al. The constants are for the bit-reflected CRC-32 polynomial.
+ * @param size At least 64, a multiple of 16.
+ * @param state The CRC register, i.e. the inverted CRC value.
+ */
+NX_TARGET_PCLMUL std::uint32_t crc32Pclmul(
+    std::uint32_t state, const std::uint8_t* data, std::size_t size)
+{
+    // x^(4*128+32) mod P, x^(4*128-32) mod P.
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    // x^(128+32) mod P, x^(128-32) mod P.
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    // x^64 mod P.
+    const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124);
+    // P, floor(x^64 / P).
+    const __m128i polynomial = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128((int) state));
+    __m128i x2 = load(data + 16);
+    __m128i x3 = load(data + 32);
+    __m128i x4 = load(data + 48);
+    data += 64;
+    size -= 64;
+
+    for (; size >= 64; data += 64, size -= 64)
+    {
+        x1 = fold(x1, k1k2, load(data));
+        x2 = fold(x2, k1k2, load(data + 16));
+        x3 = fold(x3, k1k2, load(data + 32));
+        x4 = fold(x4, k1k2, load(data + 48));
+    }
+
+    x1 = fold(x1, k3k4, x2);
+    x1 = fold(x1, k3k4, x3);
+    x1 = fold(x1, k3k4, x4);
+
+    for (; size >= 16; data += 16, size -= 16)
+        x1 = fold(x1, k3k4, load(data));
+
+    // 128 bits to 64 bits.
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits.
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), polynomial, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), polynomial, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (std::uint32_t) _mm_extract_epi32(x1, 1);
+}
+
+#endif // NX_AVX2_CODE_SUPPORTED
+
+std::uint32_t crc32Zlib(std::uint32_t crc, const char* data, std::size_t size)
+{
+    // uInt may be narrower than std::size_t.
+    static constexpr std::size_t kMaxChunkSize = 1U << 30;
+    while (size > 0)
+    {
+        const auto chunkSize = std::min(size, kMaxChunkSize);
+        crc = (std::uint32_t) zlib_crc32(crc, (const Bytef*) data, (uInt) chunkSize);
+        data += chunkSize;
+        size -= chunkSize;
+    }
+    return crc;
+}
+
+//-------------------------------------------------------------------------------------------------
+// CRC-32C.
+
+static constexpr std::uint32_t kCrc32cPolynomial = 0x82f63b78; //< Bit-reflected.
+
+using Crc32cTables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+/**
+ * Slicing-by-8 tables: tables[k][b] is the CRC of byte b followed by k zero bytes.
+ */
+constexpr Crc32cTables makeCrc32cTables()
+{
+    Crc32cTables tables{};
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ ((crc & 1) ? kCrc32cPolynomial : 0);
+        tables[0][i] = crc;
+    }
+
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        for (std::size_t k = 1; k < tables.size(); ++k)
+            tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xff];
+    }
+
+    return tables;
+}
+
+static constexpr Crc32cTables kCrc32cTables = makeCrc32cTables();
+
+std::uint32_t crc32cScalar(std::uint32_t state, const std::uint8_t* data, std::size_t size)
+{
+    const auto& t = kCrc32cTables;
+
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint32_t low = 0;
+        std::uint32_t high = 0;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+        #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            low = __builtin_bswap32(low);
+            high = __builtin_bswap32(high);
+        #endif
+        low ^= state;
+
+        state = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff]
+            ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24]
+            ^ t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff]
+            ^ t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+    }
+
+    for (; size > 0; ++data, --size)
+        state = (state >> 8) ^ t[0][(state ^ *data) & 0xff];
+
+    return state;
+}
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+
+NX_TARGET_SSE42 std::uint32_t crc32cSse42(
+    std::uint32_t state, const std::uint8_t* data, std::size_t size)
+{
+    std::uint64_t state64 = state;
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint64_t value = 0;
+        std::memcpy(&value, data, sizeof(value));
+        state64 = _mm_crc32_u64(state64, value);
+    }
+
+    state = (std::uint32_t) state64;
+    for (; size > 0; ++data, --size)
+        state = _mm_crc32_u8(state, *data);
+
+    return state;
+}
+
+#elif defined(__ARM_FEATURE_CRC32)
+
+std::uint32_t crc32cArm(std::uint32_t state, const std::uint8_t* data, std::size_t size)
+{
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint64_t value = 0;
+        std::memcpy(&value, data, sizeof(value));
+        state = __crc32cd(state, value);
+    }
+
+    for (; size > 0; ++data, --size)
+        state = __crc32cb(state, *data);
+
+    return state;
+}
+
+std::uint32_t crc32Arm(std::uint32_t state, const std::uint8_t* data, std::size_t size)
+{
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint64_t value = 0;
+        std::memcpy(&value, data, sizeof(value));
+        state = __crc32d(state, value);
+    }
+
+    for (; size > 0; ++data, --size)
+        state = __crc32b(state, *data);
+
+    return state;
+}
+
+#endif
+
+} // namespace
+
+std::uint32_t crc32(std::uint32_t crc, const char* data, std::size_t size)
+{
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        // Below 64 bytes the folding setup costs more than it saves.
+        if (size >= 64 && cpuSupportsPclmul())
+        {
+            const auto foldedSize = size & ~(std::size_t) 15;
+            crc = ~crc32Pclmul(~crc, (const std::uint8_t*) data, foldedSize);
+            data += foldedSize;
+            size -= foldedSize;
+        }
+    #elif defined(__ARM_FEATURE_CRC32)
+        return ~crc32Arm(~crc, (const std::uint8_t*) data, size);
+    #endif
+
+    return crc32Zlib(crc, data, size);
+}
+
 std::uint32_t crc32(const char* data, std::size_t size)
 {
-    return (std::uint32_t) zlib_crc32(0, (const Bytef*) data, (uInt) size);
+    return crc32(0, data, size);
 }
 
 std::uint32_t crc32(const std::string& str)
@@ -36,5 +279,29 @@ uint32_t crc32(const QLatin1String& str)
     return crc32(str.data(), (size_t) str.size());
 }
 
+std::uint32_t crc32c(std::uint32_t crc, const char* data, std::size_t size)
+{
+    const auto bytes = (const std::uint8_t*) data;
+
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (cpuSupportsSse42())
+            return ~crc32cSse42(~crc, bytes, size);
+    #elif defined(__ARM_FEATURE_CRC32)
+        return ~crc32cArm(~crc, bytes, size);
+    #endif
+
+    return ~crc32cScalar(~crc, bytes, size);
+}
+
+std::uint32_t crc32c(const char* data, std::size_t size)
+{
+    return crc32c(0, data, size);
+}
+
+std::uint32_t crc32c(const std::string_view& str)
+{
+    return crc32c(str.data(), str.size());
+}
+
 } // namespace utils
 } // namespace nx
@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #include <QtCore/QByteArray>
 #include <QtCore/QLatin1String>
@@ -15,10 +16,31 @@
 namespace nx {
 namespace utils {
 
+/**
+ * CRC-32 (ISO-HDLC), the same as zlib crc32(). Folded with the carry-less multiplication where
+ * the CPU supports it.
+ */
 NX_UTILS_API std::uint32_t crc32(const char* data, std::size_t size);
 NX_UTILS_API std::uint32_t crc32(const std::string& str);
 NX_UTILS_API std::uint32_t crc32(const QByteArray& data);
 NX_UTILS_API std::uint32_t crc32(const QLatin1String& str);
 
+/**
+ * Continues the calculation: crc32(crc32(a), b) == crc32(a + b). The initial value is 0.
+ */
+NX_UTILS_API std::uint32_t crc32(std::uint32_t crc, const char* data, std::size_t size);
+
+/**
+ * CRC-32C (Castagnoli), used by iSCSI, SCTP, ext4. Calculated with the crc32 instruction where
+ * the CPU supports it.
+ */
+NX_UTILS_API std::uint32_t crc32c(const char* data, std::size_t size);
+NX_UTILS_API std::uint32_t crc32c(const std::string_view& str);
+
+/**
+ * Continues the calculation: crc32c(crc32c(a), b) == crc32c(a + b). The initial value is 0.
+ */
+NX_UTILS_API std::uint32_t crc32c(std::uint32_t crc, const char* data, std::size_t size);
+
 } // namespace utils
 } // namespace nx
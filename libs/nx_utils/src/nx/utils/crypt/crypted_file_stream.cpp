@@ -21,8 +21,10 @@ CryptedFileStream::CryptedFileStream(const QString& fileName, const QString& pas
     m_IV(IV),
     m_file(fileName)
 {
-    m_context = EVP_CIPHER_CTX_new();
-    NX_ASSERT(m_context);
+    m_encryptContext = EVP_CIPHER_CTX_new();
+    NX_ASSERT(m_encryptContext);
+    m_decryptContext = EVP_CIPHER_CTX_new();
+    NX_ASSERT(m_decryptContext);
     NX_ASSERT(EVP_MD_size(EVP_sha256()) == kKeySize);
 
     m_mdContext = EVP_MD_CTX_create();
@@ -42,7 +44,8 @@ CryptedFileStream::CryptedFileStream(const QString& fileName, qint64 position, q
 CryptedFileStream::~CryptedFileStream()
 {
     close();
-    EVP_CIPHER_CTX_free((EVP_CIPHER_CTX*) m_context);
+    EVP_CIPHER_CTX_free((EVP_CIPHER_CTX*) m_encryptContext);
+    EVP_CIPHER_CTX_free((EVP_CIPHER_CTX*) m_decryptContext);
     EVP_MD_CTX_destroy((EVP_MD_CTX*) m_mdContext);
 }
 
@@ -143,6 +146,16 @@ qint64 CryptedFileStream::readData(char* data, qint64 maxSize)
 
     while (toRead > kCryptoBlockSize)
     {
+        if (!isWriting())
+        {
+            const qint64 count = std::min((toRead - 1) / kCryptoBlockSize, kMaxBatchBlocks);
+            if (readBlocks(m_position.blockIndex + 1, count, data + (maxSize - toRead)))
+            {
+                toRead -= count * kCryptoBlockSize;
+                continue;
+            }
+        }
+
         advanceBlock();
         readFromBlock(data + (maxSize - toRead), kCryptoBlockSize);
         toRead -= kCryptoBlockSize;
@@ -169,9 +182,10 @@ qint64 CryptedFileStream::writeData(const char* data, qint64 maxSize)
 
     while (toWrite > kCryptoBlockSize)
     {
-        advanceBlock();
-        writeToBlock(data + (maxSize - toWrite), kCryptoBlockSize);
-        toWrite -= kCryptoBlockSize;
+        // The whole blocks are overwritten, so they are not loaded.
+        const qint64 count = std::min((toWrite - 1) / kCryptoBlockSize, kMaxBatchBlocks);
+        writeBlocks(m_position.blockIndex + 1, count, data + (maxSize - toWrite));
+        toWrite -= count * kCryptoBlockSize;
     }
 
     if (toWrite > 0)
@@ -285,6 +299,51 @@ void CryptedFileStream::loadCurrentBlock()
     }
 }
 
+bool CryptedFileStream::readBlocks(qint64 firstBlockIndex, qint64 count, char* data)
+{
+    // The same check as in loadCurrentBlock(), for all the blocks.
+    const qint64 size = count * kCryptoBlockSize;
+    if ((firstBlockIndex + count) * kCryptoBlockSize > m_enclosure.size)
+        return false;
+
+    m_file.seek(m_enclosure.position + kHeaderSize + kCryptoBlockSize * firstBlockIndex);
+    if (m_file.read(data, size) != size)
+        return false;
+
+    for (qint64 i = 0; i < count; ++i)
+    {
+        char* const block = data + i * kCryptoBlockSize;
+        decryptBlock(firstBlockIndex + i, block, block);
+    }
+
+    m_position.blockIndex = firstBlockIndex + count - 1;
+    m_position.positionInBlock = kCryptoBlockSize;
+    memcpy(m_currentPlainBlock, data + size - kCryptoBlockSize, kCryptoBlockSize);
+    return true;
+}
+
+void CryptedFileStream::writeBlocks(qint64 firstBlockIndex, qint64 count, const char* data)
+{
+    dumpCurrentBlock();
+
+    const qint64 size = count * kCryptoBlockSize;
+    m_batchBuffer.resize(size);
+    for (qint64 i = 0; i < count; ++i)
+    {
+        const qint64 offset = i * kCryptoBlockSize;
+        cryptBlock(firstBlockIndex + i, data + offset, m_batchBuffer.data() + offset);
+    }
+
+    m_file.seek(m_enclosure.position + kHeaderSize + kCryptoBlockSize * firstBlockIndex);
+    m_file.write(m_batchBuffer.data(), size);
+
+    m_position.blockIndex = firstBlockIndex + count - 1;
+    m_position.positionInBlock = kCryptoBlockSize;
+    memcpy(m_currentPlainBlock, data + size - kCryptoBlockSize, kCryptoBlockSize);
+    m_blockDirty = false;
+    m_header.dataSize = std::max(m_header.dataSize, m_position.position());
+}
+
 void CryptedFileStream::createHeader()
 {
     m_header = Header();
@@ -292,6 +351,7 @@ void CryptedFileStream::createHeader()
     m_header.salt = getRandomSalt();
     m_key = getKeyHash(xorKeys(m_passwordKey, m_header.salt));
     m_header.keyHash = getKeyHash(m_key);
+    initCiphers();
 
     writeHeader();
 }
@@ -309,8 +369,11 @@ bool CryptedFileStream::readHeader()
         return false;
 
     m_key = getKeyHash(xorKeys(m_passwordKey, m_header.salt));
+    if (getKeyHash(m_key) != m_header.keyHash)
+        return false;
 
-    return getKeyHash(m_key) == m_header.keyHash;
+    initCiphers();
+    return true;
 }
 
 void CryptedFileStream::writeHeader()
@@ -324,57 +387,76 @@ void CryptedFileStream::writeHeader()
 }
 
 // Actual encrypting & decrypting.
-void CryptedFileStream::cryptBlock()
+void CryptedFileStream::initCiphers()
+{
+    // The key schedule is expanded here once, and the blocks only reset the IV.
+    auto result = EVP_EncryptInit_ex((EVP_CIPHER_CTX*) m_encryptContext, EVP_aes_256_cbc(),
+        nullptr, m_key.data(), nullptr);
+    NX_ASSERT(result);
+    result = EVP_DecryptInit_ex((EVP_CIPHER_CTX*) m_decryptContext, EVP_aes_256_cbc(),
+        nullptr, m_key.data(), nullptr);
+    NX_ASSERT(result);
+}
+
+void CryptedFileStream::updateIv(qint64 blockIndex)
 {
     // Create IV from block index.
     auto result = EVP_DigestInit_ex((EVP_MD_CTX*) m_mdContext, EVP_sha256(), nullptr);
     NX_ASSERT(result);
-    result = EVP_DigestUpdate((EVP_MD_CTX*) m_mdContext, &m_position.blockIndex, sizeof(qint64));
+    result = EVP_DigestUpdate((EVP_MD_CTX*) m_mdContext, &blockIndex, sizeof(qint64));
     NX_ASSERT(result);
     unsigned int mdLen;
     result = EVP_DigestFinal_ex((EVP_MD_CTX*) m_mdContext, m_IV.data(), &mdLen);
     NX_ASSERT(result && mdLen <= m_IV.size());
+}
+
+void CryptedFileStream::cryptBlock()
+{
+    cryptBlock(m_position.blockIndex, m_currentPlainBlock, m_currentCryptedBlock);
+}
+
+void CryptedFileStream::decryptBlock()
+{
+    decryptBlock(m_position.blockIndex, m_currentCryptedBlock, m_currentPlainBlock);
+}
+
+void CryptedFileStream::cryptBlock(qint64 blockIndex, const char* plainBlock, char* cryptedBlock)
+{
+    updateIv(blockIndex);
 
     // Encrypt block.
-    result = EVP_EncryptInit_ex((EVP_CIPHER_CTX*) m_context , EVP_aes_256_cbc(),
-        nullptr, m_key.data(), m_IV.data());
-    EVP_CIPHER_CTX_set_padding((EVP_CIPHER_CTX*) m_context, 0);
+    const auto context = (EVP_CIPHER_CTX*) m_encryptContext;
+    auto result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, m_IV.data());
+    EVP_CIPHER_CTX_set_padding(context, 0);
     NX_ASSERT(result);
 
     int cryptlen;
-    result = EVP_EncryptUpdate((EVP_CIPHER_CTX*) m_context, (unsigned char *) m_currentCryptedBlock, &cryptlen,
-        (unsigned char *) m_currentPlainBlock, kCryptoBlockSize);
+    result = EVP_EncryptUpdate(context, (unsigned char *) cryptedBlock, &cryptlen,
+        (const unsigned char *) plainBlock, kCryptoBlockSize);
     NX_ASSERT(result);
 
     unsigned char dummy[32]; //< Actually 16 is enough for AES.
-    result = EVP_EncryptFinal_ex((EVP_CIPHER_CTX*) m_context, dummy, &cryptlen);
+    result = EVP_EncryptFinal_ex(context, dummy, &cryptlen);
     NX_ASSERT(result && (cryptlen == 0)); //< No extra bytes should be written to crypted buffer.
 }
 
-void CryptedFileStream::decryptBlock()
+void CryptedFileStream::decryptBlock(qint64 blockIndex, const char* cryptedBlock, char* plainBlock)
 {
-    // Create IV from block index.
-    auto result = EVP_DigestInit_ex((EVP_MD_CTX*) m_mdContext, EVP_sha256(), nullptr);
-    NX_ASSERT(result);
-    result = EVP_DigestUpdate((EVP_MD_CTX*) m_mdContext, &m_position.blockIndex, sizeof(qint64));
-    NX_ASSERT(result);
-    unsigned int mdLen;
-    result = EVP_DigestFinal_ex((EVP_MD_CTX*) m_mdContext, m_IV.data(), &mdLen);
-    NX_ASSERT(result && mdLen <= m_IV.size());
+    updateIv(blockIndex);
 
-    // Decrypt block.
-    result = EVP_DecryptInit_ex((EVP_CIPHER_CTX*) m_context , EVP_aes_256_cbc(),
-        nullptr, m_key.data(), m_IV.data());
-    EVP_CIPHER_CTX_set_padding((EVP_CIPHER_CTX*) m_context, 0);
+    // Decrypt block. It may be done in place.
+    const auto context = (EVP_CIPHER_CTX*) m_decryptContext;
+    auto result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, m_IV.data());
+    EVP_CIPHER_CTX_set_padding(context, 0);
     NX_ASSERT(result);
 
     int cryptLen;
-    result = EVP_DecryptUpdate((EVP_CIPHER_CTX*) m_context, (unsigned char *) m_currentPlainBlock, &cryptLen,
-        (unsigned char *) m_currentCryptedBlock, kCryptoBlockSize);
+    result = EVP_DecryptUpdate(context, (unsigned char *) plainBlock, &cryptLen,
+        (const unsigned char *) cryptedBlock, kCryptoBlockSize);
     NX_ASSERT(result);
 
     unsigned char dummy[32];
-    result = EVP_DecryptFinal_ex((EVP_CIPHER_CTX*) m_context, dummy, &cryptLen);
+    result = EVP_DecryptFinal_ex(context, dummy, &cryptLen);
     NX_ASSERT(result && (cryptLen == 0)); //< No extra bytes should be written to decrypted buffer.
 }
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include <QtCore/QFile>
 #include <QtCore/QString>
@@ -17,6 +18,10 @@ namespace nx::crypt {
  * Class that represents a crypted stream in a file.
  * The stream may constitute the whole file or part of it.
  * Additionally provides thread-safe access.
+ *
+ * Each block is encrypted by AES-256-CBC with its own IV, so the whole blocks of the large reads
+ * and writes are processed by batches, with a single file operation per batch. The AES key
+ * schedule is expanded once per stream, and only the IV is set per block.
  */
 class NX_UTILS_API CryptedFileStream: public QIODevice
 {
@@ -73,6 +78,7 @@ private:
     constexpr static int kCryptoStreamVersion = 1;
     constexpr static int kCryptoBlockSize = 1024;
     constexpr static int kHeaderSize = 1024;
+    constexpr static qint64 kMaxBatchBlocks = 256;
 
 #pragma pack(push, 4)
     struct Header
@@ -91,10 +97,12 @@ private:
 
     char m_currentPlainBlock[kCryptoBlockSize];
     char m_currentCryptedBlock[kCryptoBlockSize];
-    void* m_context; //< Using void* because EVP_CIPHER_CTX is a OpenSSL typedef.
+    void* m_encryptContext; //< Using void* because EVP_CIPHER_CTX is a OpenSSL typedef.
+    void* m_decryptContext;
     void* m_mdContext; //< Using void* because EVP_MD_CTX is a OpenSSL typedef.
     Key m_IV = {};
     bool m_blockDirty = false; //< Data in decrypted block was not flushed.
+    std::vector<char> m_batchBuffer;
 
     QFile m_file;
 
@@ -113,13 +121,29 @@ private:
     void dumpCurrentBlock();
     void loadCurrentBlock();
 
+    /**
+     * Reads and decrypts the whole blocks right into the data, and makes the last of them
+     * current.
+     * @return False if the blocks are not in the file, and nothing is read.
+     */
+    bool readBlocks(qint64 firstBlockIndex, qint64 count, char* data);
+
+    /** Encrypts and writes the whole blocks, and makes the last of them current. */
+    void writeBlocks(qint64 firstBlockIndex, qint64 count, const char* data);
+
     // Working with stream header.
     void createHeader();
     bool readHeader();
     void writeHeader();
 
+    /** Sets the key of the cipher contexts, after the key is derived from the header. */
+    void initCiphers();
+    void updateIv(qint64 blockIndex);
+
     void cryptBlock();
     void decryptBlock();
+    void cryptBlock(qint64 blockIndex, const char* plainBlock, char* cryptedBlock);
+    void decryptBlock(qint64 blockIndex, const char* cryptedBlock, char* plainBlock);
 };
 
 } // namespace nx::crypt
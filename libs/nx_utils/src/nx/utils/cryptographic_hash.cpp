@@ -3,6 +3,8 @@
 #include "cryptographic_hash.h"
 
 #include <cstdio>
+#include <cstring>
+#include <memory>
 
 #include <QtCore/QIODevice>
 
@@ -27,6 +29,8 @@ public:
     virtual void final(unsigned char *result) = 0;
     virtual int size() const = 0;
     virtual QnCryptographicHashPrivate *clone() const = 0;
+    virtual QByteArray state() const { return QByteArray(); }
+    virtual bool setState(const QByteArray& /*state*/) { return false; }
 
 private:
     friend class QnCryptographicHash;
@@ -34,6 +38,23 @@ private:
     QByteArray m_result;
 };
 
+/** The OpenSSL contexts of the legacy digests are plain structs, so they are copied as is. */
+template<typename Context>
+QByteArray contextState(const Context& context)
+{
+    return QByteArray(reinterpret_cast<const char*>(&context), (int) sizeof(context));
+}
+
+template<typename Context>
+bool setContextState(Context* context, const QByteArray& state)
+{
+    if (state.size() != (int) sizeof(Context))
+        return false;
+
+    std::memcpy(context, state.data(), sizeof(Context));
+    return true;
+}
+
 class QnMd4CryptographicHashPrivate: public QnCryptographicHashPrivate
 {
 public:
@@ -42,6 +63,8 @@ public:
     virtual void final(unsigned char *result) override { MD4_Final(result, &ctx); }
     virtual int size() const override { return MD4_DIGEST_LENGTH; }
     virtual QnCryptographicHashPrivate *clone() const override { return new QnMd4CryptographicHashPrivate(*this); }
+    virtual QByteArray state() const override { return contextState(ctx); }
+    virtual bool setState(const QByteArray& state) override { return setContextState(&ctx, state); }
 
 private:
     MD4_CTX ctx;
@@ -55,6 +78,8 @@ public:
     virtual void final(unsigned char *result) override { MD5_Final(result, &ctx); }
     virtual int size() const override { return MD5_DIGEST_LENGTH; }
     virtual QnCryptographicHashPrivate *clone() const override { return new QnMd5CryptographicHashPrivate(*this); }
+    virtual QByteArray state() const override { return contextState(ctx); }
+    virtual bool setState(const QByteArray& state) override { return setContextState(&ctx, state); }
 
 private:
     MD5_CTX ctx;
@@ -68,6 +93,8 @@ public:
     virtual void final(unsigned char *result) override { SHA1_Final(result, &ctx); }
     virtual int size() const override { return SHA_DIGEST_LENGTH; }
     virtual QnCryptographicHashPrivate *clone() const override { return new QnSha1CryptographicHashPrivate(*this); }
+    virtual QByteArray state() const override { return contextState(ctx); }
+    virtual bool setState(const QByteArray& state) override { return setContextState(&ctx, state); }
 
 private:
     SHA_CTX ctx;
@@ -81,6 +108,8 @@ public:
     virtual void final(unsigned char *result) override { SHA256_Final(result, &ctx); }
     virtual int size() const override { return SHA256_DIGEST_LENGTH; }
     virtual QnCryptographicHashPrivate *clone() const override { return new QnSha256CryptographicHashPrivate(*this); }
+    virtual QByteArray state() const override { return contextState(ctx); }
+    virtual bool setState(const QByteArray& state) override { return setContextState(&ctx, state); }
 
 private:
     SHA256_CTX ctx;
@@ -108,7 +137,9 @@ public:
 
     virtual void init() override
     {
-        m_ctx = EVP_MD_CTX_new();
+        // The context is reused by reset().
+        if (!m_ctx)
+            m_ctx = EVP_MD_CTX_new();
         EVP_DigestInit_ex(m_ctx, m_evpFunc(), nullptr);
     }
 
@@ -160,35 +191,32 @@ public:
 // -------------------------------------------------------------------------- //
 // QnCryptographicHash
 // -------------------------------------------------------------------------- //
-QnCryptographicHash::QnCryptographicHash(Algorithm algorithm)
+static QnCryptographicHashPrivate* createHashPrivate(QnCryptographicHash::Algorithm algorithm)
 {
     switch (algorithm)
     {
-    case Md4:
-        d.reset(new QnMd4CryptographicHashPrivate());
-        break;
-    case Md5:
-        d.reset(new QnMd5CryptographicHashPrivate());
-        break;
-    case Sha1:
-        d.reset(new QnSha1CryptographicHashPrivate());
-        break;
-    case Sha256:
-        d.reset(new QnSha256CryptographicHashPrivate());
-        break;
-    case Sha3_256:
-        d.reset(new QnSha3256CryptographicHashPrivate());
-        break;
-    case Sha3_512:
-        d.reset(new QnSha3512CryptographicHashPrivate());
-        break;
+    case QnCryptographicHash::Md4:
+        return new QnMd4CryptographicHashPrivate();
+    case QnCryptographicHash::Md5:
+        return new QnMd5CryptographicHashPrivate();
+    case QnCryptographicHash::Sha1:
+        return new QnSha1CryptographicHashPrivate();
+    case QnCryptographicHash::Sha256:
+        return new QnSha256CryptographicHashPrivate();
+    case QnCryptographicHash::Sha3_256:
+        return new QnSha3256CryptographicHashPrivate();
+    case QnCryptographicHash::Sha3_512:
+        return new QnSha3512CryptographicHashPrivate();
     default:
         std::printf("%s: Invalid cryptographic hash algorithm %d.\n",
             Q_FUNC_INFO, static_cast<int>(algorithm));
-        d.reset(new QnMd5CryptographicHashPrivate());
-        break;
+        return new QnMd5CryptographicHashPrivate();
     }
+}
 
+QnCryptographicHash::QnCryptographicHash(Algorithm algorithm)
+{
+    d.reset(createHashPrivate(algorithm));
     d->init();
 }
 
@@ -273,6 +301,23 @@ QByteArray QnCryptographicHash::result() const
     return d->m_result;
 }
 
+QByteArray QnCryptographicHash::saveState() const
+{
+    if (!d->m_result.isEmpty())
+        return QByteArray(); //< The context is finalized.
+
+    return d->state();
+}
+
+bool QnCryptographicHash::restoreState(const QByteArray& state)
+{
+    if (!d->setState(state))
+        return false;
+
+    d->m_result = QByteArray();
+    return true;
+}
+
 QByteArray QnCryptographicHash::hash(const QByteArray &data, Algorithm algorithm)
 {
     QnCryptographicHash hash(algorithm);
@@ -280,6 +325,24 @@ QByteArray QnCryptographicHash::hash(const QByteArray &data, Algorithm algorithm
     return hash.result();
 }
 
+std::vector<QByteArray> QnCryptographicHash::hash(
+    const std::vector<std::string_view>& buffers, Algorithm algorithm)
+{
+    std::unique_ptr<QnCryptographicHashPrivate> hasher(createHashPrivate(algorithm));
+
+    std::vector<QByteArray> result;
+    result.reserve(buffers.size());
+    for (const auto& buffer: buffers)
+    {
+        hasher->init();
+        hasher->update(buffer.data(), (int) buffer.size());
+        auto& digest = result.emplace_back(hasher->size(), Qt::Uninitialized);
+        hasher->final(reinterpret_cast<unsigned char*>(digest.data()));
+    }
+
+    return result;
+}
+
 //-------------------------------------------------------------------------------------------------
 
 template<typename Hasher, typename Output, typename Input>
@@ -4,6 +4,7 @@
 #define QN_CRYPTOGRAPHIC_HASH_H
 
 #include <string_view>
+#include <vector>
 
 #include <QtCore/QCryptographicHash>
 #include <QtCore/QScopedPointer>
@@ -50,8 +51,29 @@ public:
 
     QByteArray result() const;
 
+    /**
+     * Serializes the intermediate state, so hashing of a large file can be resumed after a
+     * restart. The state layout depends on the platform and must not be transferred to other
+     * hosts.
+     * @return Empty array if the algorithm does not support it (Sha3_256, Sha3_512).
+     */
+    QByteArray saveState() const;
+
+    /**
+     * Restores the state saved by saveState() of the same algorithm.
+     * @return False if the state is not valid, the hash is left intact in this case.
+     */
+    bool restoreState(const QByteArray& state);
+
     static QByteArray hash(const QByteArray &data, Algorithm algorithm);
 
+    /**
+     * Calculates the digest of every buffer. Faster than hashing the buffers one by one since
+     * a single hashing context is used for all of them.
+     */
+    static std::vector<QByteArray> hash(
+        const std::vector<std::string_view>& buffers, Algorithm algorithm);
+
 private:
     QScopedPointer<QnCryptographicHashPrivate> d;
 };
@@ -0,0 +1,398 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <nx/utils/thread/mutex.h>
+
+#include "lru_cache.h"
+
+namespace nx::utils {
+
+struct CacheStatistics
+{
+    /** Lookups that found the element. */
+    std::uint64_t hits = 0;
+
+    /** Lookups that did not find the element. */
+    std::uint64_t misses = 0;
+
+    /** Elements removed by the cache itself: to free space for new ones or because expired. */
+    std::uint64_t evictions = 0;
+
+    std::size_t size = 0;
+};
+
+enum class CacheEvictionPolicy
+{
+    /**
+     * Exact LRU within a shard: a read hit moves the element to the front of the shard list, so
+     * reads of a shard are serialized.
+     */
+    lru,
+
+    /**
+     * CLOCK (second chance) approximation of LRU: a read hit only marks the element as
+     * referenced, so reads of a shard do not block each other. Eviction skips (and unmarks) the
+     * referenced elements.
+     */
+    clock,
+};
+
+namespace detail {
+
+/** Shards smaller than this make the eviction order too different from the global one. */
+static constexpr std::size_t kMinCacheShardCapacity = 8;
+
+inline std::size_t cacheShardCount(std::size_t capacity, unsigned int shardCount)
+{
+    if (shardCount == 0)
+        shardCount = 2 * std::max(1U, std::thread::hardware_concurrency());
+
+    return std::clamp<std::size_t>(
+        shardCount, 1, std::max<std::size_t>(1, capacity / kMinCacheShardCapacity));
+}
+
+template<typename Key>
+std::size_t cacheShardIndex(const Key& key, std::size_t shardCount)
+{
+    // Mixing the hash, so the shard does not correlate with the bucket in the shard dictionary.
+    const std::uint64_t hash = std::hash<Key>()(key) * 0x9E3779B97F4A7C15ULL;
+    return (std::size_t) ((hash >> 32) % shardCount);
+}
+
+/**
+ * Each shard counts its own events to avoid contention on shared counters.
+ */
+struct CacheShardCounters
+{
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> evictions{0};
+
+    void registerLookup(bool found)
+    {
+        (found ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void addTo(CacheStatistics* statistics) const
+    {
+        statistics->hits += hits.load(std::memory_order_relaxed);
+        statistics->misses += misses.load(std::memory_order_relaxed);
+        statistics->evictions += evictions.load(std::memory_order_relaxed);
+    }
+};
+
+template<typename Key, typename Value>
+class LruCacheShard
+{
+public:
+    CacheShardCounters counters;
+
+    LruCacheShard(std::size_t capacity): m_cache(capacity) {}
+
+    std::optional<Value> getValue(const Key& key)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        const auto value = m_cache.getValue(key);
+        counters.registerLookup((bool) value);
+        if (!value)
+            return std::nullopt;
+        return value->get();
+    }
+
+    template<class K, class V>
+    void put(K&& key, V&& value)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        const bool isNew = !m_cache.contains(key);
+        const auto sizeBefore = m_cache.size();
+        m_cache.put(std::forward<K>(key), std::forward<V>(value));
+        if (isNew && m_cache.size() == sizeBefore)
+            counters.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool contains(const Key& key) const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_cache.contains(key);
+    }
+
+    void erase(const Key& key)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_cache.erase(key);
+    }
+
+    void clear()
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_cache.clear();
+    }
+
+    std::size_t size() const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return (std::size_t) m_cache.size();
+    }
+
+private:
+    mutable nx::Mutex m_mutex;
+    LruCacheBase<Key, Value, std::unordered_map> m_cache;
+};
+
+template<typename Key, typename Value>
+class ClockCacheShard
+{
+public:
+    CacheShardCounters counters;
+
+    ClockCacheShard(std::size_t capacity):
+        m_slots(std::max<std::size_t>(1, capacity))
+    {
+        resetFreeSlots();
+    }
+
+    std::optional<Value> getValue(const Key& key)
+    {
+        NX_READ_LOCKER lock(&m_lock);
+        const auto it = m_index.find(key);
+        counters.registerLookup(it != m_index.end());
+        if (it == m_index.end())
+            return std::nullopt;
+
+        auto& slot = m_slots[it->second];
+        slot.isReferenced.store(true, std::memory_order_relaxed);
+        return slot.element->second;
+    }
+
+    template<class K, class V>
+    void put(K&& key, V&& value)
+    {
+        NX_WRITE_LOCKER lock(&m_lock);
+        if (const auto it = m_index.find(key); it != m_index.end())
+        {
+            auto& slot = m_slots[it->second];
+            slot.element->second = std::forward<V>(value);
+            slot.isReferenced.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        std::size_t index = 0;
+        if (!m_freeSlots.empty())
+        {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            index = evict();
+            counters.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto& slot = m_slots[index];
+        slot.element.emplace(std::forward<K>(key), std::forward<V>(value));
+        slot.isReferenced.store(false, std::memory_order_relaxed);
+        m_index.emplace(slot.element->first, index);
+    }
+
+    bool contains(const Key& key) const
+    {
+        NX_READ_LOCKER lock(&m_lock);
+        return m_index.contains(key);
+    }
+
+    void erase(const Key& key)
+    {
+        NX_WRITE_LOCKER lock(&m_lock);
+        const auto it = m_index.find(key);
+        if (it == m_index.end())
+            return;
+
+        const auto index = it->second;
+        m_index.erase(it);
+        m_slots[index].element.reset();
+        m_freeSlots.push_back(index);
+    }
+
+    void clear()
+    {
+        NX_WRITE_LOCKER lock(&m_lock);
+        m_index.clear();
+        for (auto& slot: m_slots)
+            slot.element.reset();
+        resetFreeSlots();
+    }
+
+    std::size_t size() const
+    {
+        NX_READ_LOCKER lock(&m_lock);
+        return m_index.size();
+    }
+
+private:
+    struct Slot
+    {
+        std::optional<std::pair<Key, Value>> element;
+        std::atomic<bool> isReferenced{false};
+    };
+
+    /**
+     * MUST be called only when all slots are occupied.
+     * @return Index of the freed slot. The hand is moved past it, so the new element placed
+     * there is examined last.
+     */
+    std::size_t evict()
+    {
+        for (;;)
+        {
+            const auto index = m_hand;
+            m_hand = (m_hand + 1) % m_slots.size();
+
+            auto& slot = m_slots[index];
+            if (slot.isReferenced.exchange(false, std::memory_order_relaxed))
+                continue;
+
+            m_index.erase(slot.element->first);
+            slot.element.reset();
+            return index;
+        }
+    }
+
+    void resetFreeSlots()
+    {
+        m_freeSlots.resize(m_slots.size());
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
+            m_freeSlots[i] = m_slots.size() - i - 1;
+        m_hand = 0;
+    }
+
+private:
+    mutable nx::ReadWriteLock m_lock;
+    std::vector<Slot> m_slots;
+    std::unordered_map<Key, std::size_t> m_index;
+    std::vector<std::size_t> m_freeSlots;
+    std::size_t m_hand = 0;
+};
+
+} // namespace detail
+
+/**
+ * Thread-safe cache with a limited number of elements.
+ * The elements are distributed over shards by the key hash, each shard is an independent cache
+ * with its own lock and capacity / shardCount elements. So the capacity and the eviction order
+ * are approximate: an element is evicted when its shard is full, even if the other shards are not.
+ *
+ * Values are returned by copy since another thread may replace or evict the element right after
+ * the lookup. Use std::shared_ptr as the Value for large objects.
+ */
+template<
+    typename Key, typename Value,
+    CacheEvictionPolicy policy = CacheEvictionPolicy::lru
+>
+class ConcurrentLruCache
+{
+public:
+    /**
+     * @param shardCount If zero, then 2 * std::thread::hardware_concurrency(). Reduced so each
+     *     shard is not too small.
+     */
+    ConcurrentLruCache(std::size_t capacity, unsigned int shardCount = 0)
+    {
+        const auto count = detail::cacheShardCount(capacity, shardCount);
+        const auto shardCapacity = (capacity + count - 1) / count;
+        m_shards.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            m_shards.push_back(std::make_unique<Shard>(shardCapacity));
+        m_capacity = shardCapacity * count;
+    }
+
+    /**
+     * Returns copy of the value with the given key and marks it as used recently.
+     */
+    std::optional<Value> getValue(const Key& key)
+    {
+        return shard(key).getValue(key);
+    }
+
+    /**
+     * Inserts or replaces value with the given key. May evict another element of the same shard.
+     */
+    template<class K, class V>
+    void put(K&& key, V&& value)
+    {
+        shard(key).put(std::forward<K>(key), std::forward<V>(value));
+    }
+
+    /**
+     * Does not mark the element as used and is not counted in the statistics.
+     */
+    bool contains(const Key& key) const
+    {
+        return shard(key).contains(key);
+    }
+
+    void erase(const Key& key)
+    {
+        shard(key).erase(key);
+    }
+
+    void clear()
+    {
+        for (auto& shard: m_shards)
+            shard->clear();
+    }
+
+    /** The sum of the shard sizes, which is not an atomic snapshot under concurrent updates. */
+    std::size_t size() const
+    {
+        std::size_t result = 0;
+        for (const auto& shard: m_shards)
+            result += shard->size();
+        return result;
+    }
+
+    /** The sum of the shard capacities. Can be a bit larger than requested. */
+    std::size_t capacity() const { return m_capacity; }
+
+    std::size_t shardCount() const { return m_shards.size(); }
+
+    CacheStatistics statistics() const
+    {
+        CacheStatistics result;
+        for (const auto& shard: m_shards)
+        {
+            shard->counters.addTo(&result);
+            result.size += shard->size();
+        }
+        return result;
+    }
+
+private:
+    using Shard = std::conditional_t<policy == CacheEvictionPolicy::lru,
+        detail::LruCacheShard<Key, Value>,
+        detail::ClockCacheShard<Key, Value>>;
+
+    Shard& shard(const Key& key) const
+    {
+        return *m_shards[detail::cacheShardIndex(key, m_shards.size())];
+    }
+
+private:
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::size_t m_capacity = 0;
+};
+
+template<typename Key, typename Value>
+using ConcurrentClockCache = ConcurrentLruCache<Key, Value, CacheEvictionPolicy::clock>;
+
+} // namespace nx::utils
@@ -0,0 +1,147 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include "concurrent_lru_cache.h"
+#include "time_out_cache.h"
+
+namespace nx::utils {
+
+/**
+ * Thread-safe TimeOutCache sharded the same way as ConcurrentLruCache: each shard is a
+ * TimeOutCache with its own lock and maxSize / shardCount elements.
+ * Expired elements are removed by the calls to the same shard.
+ */
+template<typename Key, typename Value>
+class ConcurrentTimeOutCache
+{
+public:
+    /**
+     * @param shardCount See ConcurrentLruCache.
+     */
+    ConcurrentTimeOutCache(
+        std::chrono::milliseconds expirationPeriod,
+        std::size_t maxSize,
+        bool updateElementTimestampOnAccess = true,
+        unsigned int shardCount = 0)
+    {
+        const auto count = detail::cacheShardCount(maxSize, shardCount);
+        const auto shardCapacity = (maxSize + count - 1) / count;
+        m_shards.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_shards.push_back(std::make_unique<Shard>(
+                expirationPeriod, shardCapacity, updateElementTimestampOnAccess));
+        }
+    }
+
+    /**
+     * Returns copy of the value. Updates last access time of the element if configured so.
+     */
+    std::optional<Value> getValue(const Key& key)
+    {
+        auto& shard = this->shard(key);
+
+        NX_MUTEX_LOCKER lock(&shard.mutex);
+        const auto sizeBefore = shard.cache.size();
+        const auto value = shard.cache.getValue(key);
+        shard.counters.evictions.fetch_add(
+            sizeBefore - shard.cache.size(), std::memory_order_relaxed);
+        shard.counters.registerLookup((bool) value);
+        if (!value)
+            return std::nullopt;
+        return value->get();
+    }
+
+    template<class K, class V>
+    void put(K&& key, V&& value)
+    {
+        auto& shard = this->shard(key);
+
+        NX_MUTEX_LOCKER lock(&shard.mutex);
+        const auto sizeBefore = shard.cache.size() + (shard.cache.contains(key) ? 0 : 1);
+        shard.cache.put(std::forward<K>(key), std::forward<V>(value));
+        shard.counters.evictions.fetch_add(
+            sizeBefore - shard.cache.size(), std::memory_order_relaxed);
+    }
+
+    /**
+     * NOTE: Last access time of the element is not updated.
+     */
+    bool contains(const Key& key) const
+    {
+        auto& shard = this->shard(key);
+
+        NX_MUTEX_LOCKER lock(&shard.mutex);
+        return shard.cache.contains(key);
+    }
+
+    void erase(const Key& key)
+    {
+        auto& shard = this->shard(key);
+
+        NX_MUTEX_LOCKER lock(&shard.mutex);
+        shard.cache.erase(key);
+    }
+
+    void clear()
+    {
+        for (auto& shard: m_shards)
+        {
+            NX_MUTEX_LOCKER lock(&shard->mutex);
+            shard->cache.clear();
+        }
+    }
+
+    /** Can include expired elements that are not removed yet. */
+    std::size_t size() const
+    {
+        std::size_t result = 0;
+        for (const auto& shard: m_shards)
+        {
+            NX_MUTEX_LOCKER lock(&shard->mutex);
+            result += (std::size_t) shard->cache.size();
+        }
+        return result;
+    }
+
+    CacheStatistics statistics() const
+    {
+        CacheStatistics result;
+        for (const auto& shard: m_shards)
+        {
+            shard->counters.addTo(&result);
+
+            NX_MUTEX_LOCKER lock(&shard->mutex);
+            result.size += (std::size_t) shard->cache.size();
+        }
+        return result;
+    }
+
+private:
+    struct Shard
+    {
+        mutable nx::Mutex mutex;
+        TimeOutCache<Key, Value> cache;
+        detail::CacheShardCounters counters;
+
+        Shard(
+            std::chrono::milliseconds expirationPeriod,
+            std::size_t maxSize,
+            bool updateElementTimestampOnAccess)
+            :
+            cache(expirationPeriod, maxSize, updateElementTimestampOnAccess)
+        {
+        }
+    };
+
+    Shard& shard(const Key& key) const
+    {
+        return *m_shards[detail::cacheShardIndex(key, m_shards.size())];
+    }
+
+private:
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+} // namespace nx::utils
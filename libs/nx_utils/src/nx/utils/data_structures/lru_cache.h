@@ -63,6 +63,11 @@ public:
         m_impl.erase(key);
     }
 
+    void clear() noexcept
+    {
+        m_impl.clear();
+    }
+
 private:
     detail::LruCacheBase<Key, Value, Dict> m_impl;
 };
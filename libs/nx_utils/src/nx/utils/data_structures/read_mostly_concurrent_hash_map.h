@@ -0,0 +1,336 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <nx/utils/thread/mutex.h>
+#include <nx/utils/thread/read_epoch.h>
+
+namespace nx::utils {
+
+/**
+ * Read-optimized alternative to PartitionedConcurrentHashMap with the same interface.
+ *
+ * Lookups (find, contains, forEach) do not lock anything: each partition is an immutable hash map
+ * published through an atomic pointer and protected by ReadEpoch. A modification copies the
+ * partition, modifies the copy under the partition mutex, publishes it and frees the old version
+ * when no reader can see it anymore.
+ * So lookups scale with the number of reading threads, while a modification costs
+ * O(partition size) plus waiting for the current readers. Use it for the data that is read much
+ * more often than modified: e.g., registries of the objects looked up on every request.
+ */
+template<typename Key, typename T, typename Hash = std::hash<Key>>
+class ReadMostlyConcurrentHashMap
+{
+public:
+    using HashMap = std::unordered_map<Key, T, Hash>;
+    using key_type = typename HashMap::key_type;
+    using mapped_type = typename HashMap::mapped_type;
+    using value_type = typename HashMap::value_type;
+    using size_type = typename HashMap::size_type;
+    using hasher = typename HashMap::hasher;
+
+    /**
+     * @param partitionCount If zero, then initialized with 2 * std::thread::hardware_concurrency().
+     *     More partitions make the modifications cheaper.
+     */
+    ReadMostlyConcurrentHashMap(unsigned int partitionCount = 0);
+    ~ReadMostlyConcurrentHashMap();
+
+    ReadMostlyConcurrentHashMap(const ReadMostlyConcurrentHashMap&) = delete;
+    ReadMostlyConcurrentHashMap& operator=(const ReadMostlyConcurrentHashMap&) = delete;
+
+    bool empty() const;
+    size_type size() const;
+
+    bool insert(const value_type& value);
+    bool insert(value_type&& value);
+    template<typename... Args> bool emplace(Args&&... args);
+    size_type erase(const Key& key);
+
+    /** Removes and returns element from the dictionary. */
+    std::optional<T> take(const Key& key);
+
+    /** Aggregates all elements into a single dictionary and returns it. */
+    HashMap takeAll();
+
+    void clear();
+
+    std::optional<T> find(const Key& key) const;
+    bool contains(const Key& key) const;
+
+    /**
+     * Invokes func on the value associated with the given key.
+     * If no such element exists, it is inserted first.
+     */
+    template<typename Func>
+    // requires std::is_invocable_v<Func, mapped_type&>
+    void modify(const Key& key, Func func);
+
+    /**
+     * Invokes func for every element without locking. Each partition is iterated as of some
+     * moment: the modifications made during the iteration may be seen or not.
+     */
+    template<typename Func>
+    // requires std::is_invocable_v<Func, const value_type&>
+    void forEach(Func func) const;
+
+private:
+    struct Partition
+    {
+        std::atomic<const HashMap*> dict{nullptr};
+        nx::Mutex mutex;
+    };
+
+    Partition& partition(const key_type& key) const;
+
+    /**
+     * Invokes func(HashMap* copy) on a copy of the partition under the partition mutex and
+     * publishes the copy if func returns true.
+     */
+    template<typename Func>
+    void update(Partition* partition, Func func);
+
+    /** Replaces the partition dictionary. MUST be called with the partition mutex locked. */
+    void publish(Partition* partition, std::unique_ptr<const HashMap> dict);
+
+private:
+    std::unique_ptr<Partition[]> m_partitions;
+    std::size_t m_partitionCount = 0;
+    std::atomic<size_type> m_size{0};
+    ReadEpoch m_epoch;
+};
+
+template<typename Key, typename T, typename Hash>
+ReadMostlyConcurrentHashMap<Key, T, Hash>::ReadMostlyConcurrentHashMap(
+    unsigned int partitionCount)
+    :
+    m_partitionCount(
+        partitionCount > 0 ? partitionCount : 2 * std::thread::hardware_concurrency())
+{
+    if (m_partitionCount == 0)
+        m_partitionCount = 1;
+
+    m_partitions = std::make_unique<Partition[]>(m_partitionCount);
+    for (std::size_t i = 0; i < m_partitionCount; ++i)
+        m_partitions[i].dict = new HashMap();
+}
+
+template<typename Key, typename T, typename Hash>
+ReadMostlyConcurrentHashMap<Key, T, Hash>::~ReadMostlyConcurrentHashMap()
+{
+    for (std::size_t i = 0; i < m_partitionCount; ++i)
+        delete m_partitions[i].dict.load();
+}
+
+template<typename Key, typename T, typename Hash>
+bool ReadMostlyConcurrentHashMap<Key, T, Hash>::empty() const
+{
+    return size() == 0;
+}
+
+template<typename Key, typename T, typename Hash>
+typename ReadMostlyConcurrentHashMap<Key, T, Hash>::size_type
+    ReadMostlyConcurrentHashMap<Key, T, Hash>::size() const
+{
+    return m_size.load();
+}
+
+template<typename Key, typename T, typename Hash>
+bool ReadMostlyConcurrentHashMap<Key, T, Hash>::insert(const value_type& value)
+{
+    return emplace(value);
+}
+
+template<typename Key, typename T, typename Hash>
+bool ReadMostlyConcurrentHashMap<Key, T, Hash>::insert(value_type&& value)
+{
+    return emplace(std::move(value));
+}
+
+template<typename Key, typename T, typename Hash>
+template<typename... Args>
+bool ReadMostlyConcurrentHashMap<Key, T, Hash>::emplace(Args&&... args)
+{
+    value_type val(std::forward<Args>(args)...);
+    if (contains(val.first)) //< Not copying the partition in vain.
+        return false;
+
+    bool inserted = false;
+    update(
+        &partition(val.first),
+        [&](HashMap* dict)
+        {
+            inserted = dict->insert(std::move(val)).second;
+            return inserted;
+        });
+
+    if (inserted)
+        ++m_size;
+    return inserted;
+}
+
+template<typename Key, typename T, typename Hash>
+typename ReadMostlyConcurrentHashMap<Key, T, Hash>::size_type
+    ReadMostlyConcurrentHashMap<Key, T, Hash>::erase(const Key& key)
+{
+    if (!contains(key))
+        return 0;
+
+    size_type erasedCount = 0;
+    update(
+        &partition(key),
+        [&](HashMap* dict)
+        {
+            erasedCount = dict->erase(key);
+            return erasedCount > 0;
+        });
+
+    m_size -= erasedCount;
+    return erasedCount;
+}
+
+template<typename Key, typename T, typename Hash>
+std::optional<T> ReadMostlyConcurrentHashMap<Key, T, Hash>::take(const Key& key)
+{
+    if (!contains(key))
+        return std::nullopt;
+
+    std::optional<T> val;
+    update(
+        &partition(key),
+        [&](HashMap* dict)
+        {
+            auto it = dict->find(key);
+            if (it == dict->end())
+                return false;
+
+            val = std::move(it->second);
+            dict->erase(it);
+            return true;
+        });
+
+    if (val)
+        --m_size;
+    return val;
+}
+
+template<typename Key, typename T, typename Hash>
+typename ReadMostlyConcurrentHashMap<Key, T, Hash>::HashMap
+    ReadMostlyConcurrentHashMap<Key, T, Hash>::takeAll()
+{
+    HashMap all;
+    for (std::size_t i = 0; i < m_partitionCount; ++i)
+    {
+        auto& partition = m_partitions[i];
+        NX_MUTEX_LOCKER locker(&partition.mutex);
+
+        const auto& dict = *partition.dict.load();
+        all.insert(dict.begin(), dict.end());
+        m_size -= dict.size();
+        publish(&partition, std::make_unique<HashMap>());
+    }
+
+    return all;
+}
+
+template<typename Key, typename T, typename Hash>
+void ReadMostlyConcurrentHashMap<Key, T, Hash>::clear()
+{
+    for (std::size_t i = 0; i < m_partitionCount; ++i)
+    {
+        auto& partition = m_partitions[i];
+        NX_MUTEX_LOCKER locker(&partition.mutex);
+
+        m_size -= partition.dict.load()->size();
+        publish(&partition, std::make_unique<HashMap>());
+    }
+}
+
+template<typename Key, typename T, typename Hash>
+std::optional<T> ReadMostlyConcurrentHashMap<Key, T, Hash>::find(const Key& key) const
+{
+    const auto guard = m_epoch.read();
+    const auto& dict = *partition(key).dict.load(std::memory_order_acquire);
+
+    auto it = dict.find(key);
+    if (it != dict.end())
+        return it->second;
+    return std::nullopt;
+}
+
+template<typename Key, typename T, typename Hash>
+bool ReadMostlyConcurrentHashMap<Key, T, Hash>::contains(const Key& key) const
+{
+    const auto guard = m_epoch.read();
+    return partition(key).dict.load(std::memory_order_acquire)->contains(key);
+}
+
+template<typename Key, typename T, typename Hash>
+template<typename Func>
+void ReadMostlyConcurrentHashMap<Key, T, Hash>::modify(const Key& key, Func func)
+{
+    bool inserted = false;
+    update(
+        &partition(key),
+        [&](HashMap* dict)
+        {
+            auto [it, isNew] = dict->try_emplace(key);
+            inserted = isNew;
+            func(it->second);
+            return true;
+        });
+
+    if (inserted)
+        ++m_size;
+}
+
+template<typename Key, typename T, typename Hash>
+template<typename Func>
+void ReadMostlyConcurrentHashMap<Key, T, Hash>::forEach(Func func) const
+{
+    for (std::size_t i = 0; i < m_partitionCount; ++i)
+    {
+        const auto guard = m_epoch.read();
+        const auto& dict = *m_partitions[i].dict.load(std::memory_order_acquire);
+        std::for_each(dict.cbegin(), dict.cend(), func);
+    }
+}
+
+template<typename Key, typename T, typename Hash>
+typename ReadMostlyConcurrentHashMap<Key, T, Hash>::Partition&
+    ReadMostlyConcurrentHashMap<Key, T, Hash>::partition(const key_type& key) const
+{
+    return m_partitions[hasher()(key) % m_partitionCount];
+}
+
+template<typename Key, typename T, typename Hash>
+template<typename Func>
+void ReadMostlyConcurrentHashMap<Key, T, Hash>::update(Partition* partition, Func func)
+{
+    NX_MUTEX_LOCKER locker(&partition->mutex);
+
+    auto dict = std::make_unique<HashMap>(*partition->dict.load());
+    if (func(dict.get()))
+        publish(partition, std::move(dict));
+}
+
+template<typename Key, typename T, typename Hash>
+void ReadMostlyConcurrentHashMap<Key, T, Hash>::publish(
+    Partition* partition, std::unique_ptr<const HashMap> dict)
+{
+    std::unique_ptr<const HashMap> oldDict(
+        partition->dict.exchange(dict.release(), std::memory_order_acq_rel));
+
+    // The readers do not take the partition mutex, so waiting for them under it is safe.
+    m_epoch.synchronize();
+}
+
+} // namespace nx::utils
@@ -87,6 +87,14 @@ public:
     virtual bool truncate(qint64 newFileSize) override;
     virtual bool eof() const override;
     virtual QString url() const override;
+
+    /**
+     * @return OS descriptor of the opened file. std::nullopt if the file is not opened or is not
+     * backed by an OS file (e.g., it is a Qt resource). Always std::nullopt on Windows.
+     * NOTE: The descriptor is owned by this object.
+     */
+    std::optional<int> nativeDescriptor() const;
+
     /**
      * @param systemDependentFlags Usually, zero.
      */
@@ -174,6 +182,13 @@ public:
     virtual bool truncate( qint64 newFileSize) override;
     virtual QString url() const override { return fileName(); }
 
+#if !defined(_WIN32)
+    /**
+     * @return OS file descriptor. Meaningful only while the file is opened.
+     */
+    int descriptor() const { return m_fd; }
+#endif
+
     /**
      * @return true if file system entry with name fileName exists.
      */
@@ -283,6 +283,18 @@ QString File::url() const
     return m_delegate->url();
 }
 
+std::optional<int> File::nativeDescriptor() const
+{
+    #if defined(_WIN32)
+        return std::nullopt;
+    #else
+        const auto file = dynamic_cast<const QnFile*>(m_delegate.get());
+        if (!file || !file->isOpen())
+            return std::nullopt;
+        return file->descriptor();
+    #endif
+}
+
 void File::openAsync(
     nx::utils::fs::FileAsyncIoScheduler* scheduler,
     const QIODevice::OpenMode& mode,
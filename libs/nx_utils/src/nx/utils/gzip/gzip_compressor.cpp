@@ -43,9 +43,10 @@ nx::Buffer Compressor::uncompressData(const nx::Buffer& data)
     return runBytesThroughFilter<Uncompressor>(data);
 }
 
-QByteArray Compressor::compressData(const QByteArray& data, bool addCrcAndSize)
+QByteArray Compressor::compressData(
+    const QByteArray& data, bool addCrcAndSize, int compressionLevel)
 {
-    QByteArray deflatedData = Compressor::deflateData(data);
+    QByteArray deflatedData = Compressor::deflateData(data, compressionLevel);
     QByteArray result;
 
     result.reserve(deflatedData.size() + kGzipHeaderSize);
@@ -61,28 +62,29 @@ QByteArray Compressor::compressData(const QByteArray& data, bool addCrcAndSize)
     return result;
 }
 
-nx::Buffer Compressor::compressData(const nx::Buffer& data, bool addCrcAndSize)
+nx::Buffer Compressor::compressData(
+    const nx::Buffer& data, bool addCrcAndSize, int compressionLevel)
 {
     return nx::Buffer(compressData(
-        QByteArray::fromRawData(data.data(), (int) data.size()), addCrcAndSize));
+        QByteArray::fromRawData(data.data(), (int) data.size()), addCrcAndSize, compressionLevel));
 }
 
-QByteArray Compressor::deflateData(const QByteArray& data)
+QByteArray Compressor::deflateData(const QByteArray& data, int compressionLevel)
 {
     constexpr int kQtHeaderSize = 4;
     constexpr int kZlibHeaderSize = 2;
     constexpr int kZlibSuffixSize = 4;
 
-    QByteArray compressedData = qCompress(data);
+    QByteArray compressedData = qCompress(data, compressionLevel);
 
     return QByteArray(compressedData.data() + kQtHeaderSize + kZlibHeaderSize,
         compressedData.size() - (kQtHeaderSize + kZlibHeaderSize + kZlibSuffixSize));
 }
 
-nx::Buffer Compressor::deflateData(const nx::Buffer& data)
+nx::Buffer Compressor::deflateData(const nx::Buffer& data, int compressionLevel)
 {
     return nx::Buffer(deflateData(
-        QByteArray::fromRawData(data.data(), (int) data.size())));
+        QByteArray::fromRawData(data.data(), (int) data.size()), compressionLevel));
 }
 
 } // namespace gzip
@@ -16,11 +16,16 @@ class NX_UTILS_API Compressor
 public:
     static bool isZlibCompressed(const nx::Buffer& data);
 
-    static QByteArray compressData(const QByteArray& data, bool addCrcAndSize = true);
-    static nx::Buffer compressData(const nx::Buffer& data, bool addCrcAndSize = true);
-
-    static QByteArray deflateData(const QByteArray& data);
-    static nx::Buffer deflateData(const nx::Buffer& data);
+    /**
+     * @param compressionLevel zlib compression level. -1 stands for the zlib default.
+     */
+    static QByteArray compressData(
+        const QByteArray& data, bool addCrcAndSize = true, int compressionLevel = -1);
+    static nx::Buffer compressData(
+        const nx::Buffer& data, bool addCrcAndSize = true, int compressionLevel = -1);
+
+    static QByteArray deflateData(const QByteArray& data, int compressionLevel = -1);
+    static nx::Buffer deflateData(const nx::Buffer& data, int compressionLevel = -1);
 
     static nx::Buffer uncompressData(const nx::Buffer& data);
 };
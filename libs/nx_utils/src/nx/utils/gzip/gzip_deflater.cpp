@@ -0,0 +1,70 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "gzip_deflater.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <nx/utils/log/assert.h>
+#include <nx/utils/zlib.h>
+
+namespace nx::utils::bstream::gzip {
+
+static constexpr int kDeflateWindowSize = 15; //< Max window size.
+static constexpr int kMemLevel = 8; //< zlib default.
+static constexpr std::size_t kMinOutputChunkSize = 1024;
+// Enough for the block headers and the sync flush marker in most cases.
+static constexpr std::size_t kFlushOverhead = 64;
+
+class Deflater::Private
+{
+public:
+    z_stream zStream;
+};
+
+Deflater::Deflater(int compressionLevel):
+    d(new Private())
+{
+    memset(&d->zStream, 0, sizeof(d->zStream));
+    const int zResult = deflateInit2(
+        &d->zStream, compressionLevel, Z_DEFLATED, -kDeflateWindowSize, kMemLevel,
+        Z_DEFAULT_STRATEGY);
+    NX_ASSERT(zResult == Z_OK);
+}
+
+Deflater::~Deflater()
+{
+    deflateEnd(&d->zStream);
+}
+
+bool Deflater::compress(const ConstBufferRefType& data, nx::Buffer* output)
+{
+    d->zStream.next_in = (Bytef*) data.data();
+    d->zStream.avail_in = (uInt) data.size();
+
+    for (;;)
+    {
+        const auto offset = output->size();
+        output->resize(offset
+            + std::max<std::size_t>(d->zStream.avail_in + kFlushOverhead, kMinOutputChunkSize));
+        d->zStream.next_out = (Bytef*) output->data() + offset;
+        d->zStream.avail_out = (uInt) (output->size() - offset);
+
+        const int zResult = deflate(&d->zStream, Z_SYNC_FLUSH);
+        output->resize(output->size() - d->zStream.avail_out);
+
+        if (zResult != Z_OK && zResult != Z_BUF_ERROR)
+            return false;
+
+        // The flush is complete if deflate has not used all output space.
+        if (d->zStream.avail_out > 0)
+            return true;
+    }
+}
+
+void Deflater::reset()
+{
+    deflateReset(&d->zStream);
+}
+
+} // namespace nx::utils::bstream::gzip
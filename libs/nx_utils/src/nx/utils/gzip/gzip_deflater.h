@@ -0,0 +1,47 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <memory>
+
+#include "../buffer.h"
+
+namespace nx::utils::bstream::gzip {
+
+/**
+ * Raw DEFLATE (RFC 1951) compressor that keeps its state between calls. So, data is compressed
+ * with references to the data passed earlier (up to the window size), and the zlib context is
+ * not allocated for every portion of data as Compressor::deflateData() does.
+ * Each compress() call completes with a sync flush, so the output can be inflated right away.
+ * NOTE: Not thread-safe.
+ */
+class NX_UTILS_API Deflater
+{
+public:
+    /**
+     * @param compressionLevel zlib compression level. -1 stands for the zlib default.
+     */
+    Deflater(int compressionLevel = -1);
+    ~Deflater();
+
+    Deflater(const Deflater&) = delete;
+    Deflater& operator=(const Deflater&) = delete;
+
+    /**
+     * Appends the compressed data to output. The output always ends with the empty
+     * non-final stored block (0x00 0x00 0xff 0xff).
+     * @return false on zlib error. The deflater MUST be reset in that case.
+     */
+    bool compress(const ConstBufferRefType& data, nx::Buffer* output);
+
+    /**
+     * Forgets all data passed before. The next compress() call starts a new DEFLATE stream.
+     */
+    void reset();
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace nx::utils::bstream::gzip
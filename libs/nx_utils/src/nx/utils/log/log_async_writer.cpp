@@ -0,0 +1,302 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "log_async_writer.h"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <utility>
+
+#include <nx/utils/scope_guard.h>
+#include <nx/utils/thread/thread_util.h>
+
+#include "assert.h"
+#include "to_string.h"
+
+namespace nx::log {
+
+namespace {
+
+std::atomic<std::uint64_t> sNextWriterId{0};
+
+/** The writer whose queues are being flushed by the current thread. */
+thread_local const AsyncWriter* sFlushingWriter = nullptr;
+
+/** Set when the thread is exiting and its queues are not available anymore. */
+thread_local bool sThreadQueuesDestroyed = false;
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Single producer (the thread that logs), single consumer (the thread holding m_flushMutex)
+ * ring buffer.
+ */
+class AsyncWriter::Queue
+{
+public:
+    /** The thread that owns the queue has exited. */
+    std::atomic<bool> abandoned{false};
+
+    /** The writer is destroyed, the thread should forget the queue. */
+    std::atomic<bool> writerDestroyed{false};
+
+    Queue(std::size_t size):
+        m_items(std::bit_ceil(std::max<std::size_t>(size, 2))),
+        m_mask(m_items.size() - 1)
+    {
+    }
+
+    std::size_t capacity() const { return m_items.size(); }
+
+    /**
+     * Producer side.
+     * @return Number of items in the queue after the push. 0 if the queue is full, the item is not
+     * moved then.
+     */
+    std::size_t push(QueueItem* item)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        const auto head = m_head.load(std::memory_order_acquire);
+        if (tail - head == m_items.size())
+            return 0;
+
+        m_items[tail & m_mask] = std::move(*item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return tail + 1 - head;
+    }
+
+    /** Consumer side. */
+    void popAll(std::vector<QueueItem>* items)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        const auto tail = m_tail.load(std::memory_order_acquire);
+        for (auto i = head; i != tail; ++i)
+            items->push_back(std::move(m_items[i & m_mask]));
+        m_head.store(tail, std::memory_order_release);
+    }
+
+private:
+    std::vector<QueueItem> m_items;
+    const std::size_t m_mask;
+
+    // Written by different threads, so kept in different cache lines.
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
+
+//-------------------------------------------------------------------------------------------------
+
+struct AsyncWriter::ThreadQueues
+{
+    std::vector<std::pair<std::uint64_t /*writerId*/, std::shared_ptr<Queue>>> queues;
+
+    ~ThreadQueues()
+    {
+        for (const auto& [writerId, queue]: queues)
+            queue->abandoned = true;
+        sThreadQueuesDestroyed = true;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+
+AsyncWriter::AsyncWriter(std::unique_ptr<AbstractWriter> target, Settings settings):
+    m_target(std::move(target)),
+    m_settings(std::move(settings)),
+    m_id(++sNextWriterId)
+{
+    NX_ASSERT(m_target);
+    m_flusherThread = std::thread([this]() { runFlusher(); });
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_terminated = true;
+        m_flushRequested.wakeAll();
+    }
+    m_flusherThread.join();
+
+    flushQueues();
+
+    NX_MUTEX_LOCKER lock(&m_queuesMutex);
+    for (const auto& queue: m_queues)
+        queue->writerDestroyed = true;
+}
+
+void AsyncWriter::write(Level level, const QString& message)
+{
+    Queue* queue = sFlushingWriter == this ? nullptr : threadQueue();
+    if (!queue)
+    {
+        // The target writer is logging or the thread is exiting: queueing could block forever
+        // or lose the message.
+        m_target->write(level, message);
+        ++m_writtenMessageCount;
+        return;
+    }
+
+    QueueItem item{
+        m_sequence.fetch_add(1, std::memory_order_relaxed),
+        Record{level, message.toStdString()}};
+
+    if (const auto size = queue->push(&item); size > 0)
+    {
+        // Not waiting for the flush period if the queue is filling up.
+        if (size == queue->capacity() / 2)
+            requestFlush();
+        return;
+    }
+
+    if (m_settings.overflowPolicy == AsyncWriterOverflowPolicy::drop)
+    {
+        ++m_droppedMessageCount;
+        return;
+    }
+
+    pushOrWait(queue, &item);
+}
+
+cf::future<cf::unit> AsyncWriter::stopArchivingAsync()
+{
+    flush();
+    return m_target->stopArchivingAsync();
+}
+
+void AsyncWriter::flush()
+{
+    flushQueues();
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_spaceFreed.wakeAll();
+}
+
+AbstractWriter* AsyncWriter::target() const
+{
+    return m_target.get();
+}
+
+AsyncWriter::Statistics AsyncWriter::statistics() const
+{
+    Statistics result;
+    result.writtenMessageCount = m_writtenMessageCount.load();
+    result.droppedMessageCount = m_droppedMessageCount.load();
+    result.blockedWriteCount = m_blockedWriteCount.load();
+    return result;
+}
+
+AsyncWriter::Queue* AsyncWriter::threadQueue()
+{
+    if (sThreadQueuesDestroyed)
+        return nullptr;
+
+    thread_local ThreadQueues threadQueues;
+    for (const auto& [writerId, queue]: threadQueues.queues)
+    {
+        if (writerId == m_id)
+            return queue.get();
+    }
+
+    // The first message of this thread.
+    std::erase_if(
+        threadQueues.queues,
+        [](const auto& element) { return element.second->writerDestroyed.load(); });
+
+    auto queue = std::make_shared<Queue>(m_settings.queueSize);
+    {
+        NX_MUTEX_LOCKER lock(&m_queuesMutex);
+        m_queues.push_back(queue);
+    }
+    threadQueues.queues.emplace_back(m_id, queue);
+    return queue.get();
+}
+
+void AsyncWriter::pushOrWait(Queue* queue, QueueItem* item)
+{
+    ++m_blockedWriteCount;
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    while (queue->push(item) == 0)
+    {
+        m_flushPending = true;
+        m_flushRequested.wakeAll();
+        m_spaceFreed.wait(&m_mutex);
+    }
+}
+
+void AsyncWriter::requestFlush()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_flushPending = true;
+    m_flushRequested.wakeAll();
+}
+
+void AsyncWriter::runFlusher()
+{
+    nx::utils::setCurrentThreadName("AsyncLogWriter");
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    while (!m_terminated)
+    {
+        if (!m_flushPending)
+            m_flushRequested.wait(&m_mutex, m_settings.flushPeriod);
+        m_flushPending = false;
+
+        {
+            nx::Unlocker<nx::Mutex> unlocker(&lock);
+            flushQueues();
+        }
+
+        // Under m_mutex, so a writer that has just found its queue full cannot miss it.
+        m_spaceFreed.wakeAll();
+    }
+}
+
+void AsyncWriter::flushQueues()
+{
+    NX_MUTEX_LOCKER flushLock(&m_flushMutex);
+
+    const auto previousFlushingWriter = std::exchange(sFlushingWriter, this);
+    auto guard = nx::utils::makeScopeGuard(
+        [previousFlushingWriter]() { sFlushingWriter = previousFlushingWriter; });
+
+    {
+        NX_MUTEX_LOCKER lock(&m_queuesMutex);
+        std::erase_if(
+            m_queues,
+            [this](const auto& queue)
+            {
+                // Read before popping: the thread could write something right before exiting.
+                const bool abandoned = queue->abandoned.load();
+                queue->popAll(&m_batch);
+                return abandoned;
+            });
+    }
+
+    if (m_batch.empty())
+        return;
+
+    std::sort(
+        m_batch.begin(), m_batch.end(),
+        [](const auto& left, const auto& right) { return left.sequence < right.sequence; });
+
+    for (auto& item: m_batch)
+        m_records.push_back(std::move(item.record));
+    m_batch.clear();
+
+    m_target->writeBatch(m_records);
+    m_writtenMessageCount += m_records.size();
+    m_records.clear();
+
+    if (const auto dropped = m_droppedMessageCount.load(); dropped != m_reportedDroppedMessageCount)
+    {
+        std::cerr << nx::toString(this).toStdString() << ": "
+            << (dropped - m_reportedDroppedMessageCount) << " messages were dropped\n";
+        m_reportedDroppedMessageCount = dropped;
+    }
+}
+
+} // namespace nx::log
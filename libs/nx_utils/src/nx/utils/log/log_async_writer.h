@@ -0,0 +1,120 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <nx/reflect/enum_instrument.h>
+#include <nx/utils/thread/mutex.h>
+
+#include "log_writers.h"
+
+namespace nx::log {
+
+NX_REFLECTION_ENUM_CLASS(AsyncWriterOverflowPolicy,
+    /** The message that does not fit into the queue is lost. */
+    drop,
+    /** The writing thread waits until the flusher thread frees some space in the queue. */
+    block
+);
+
+static constexpr std::size_t kDefaultAsyncLogQueueSize = 4096;
+static constexpr AsyncWriterOverflowPolicy kDefaultAsyncLogOverflowPolicy =
+    AsyncWriterOverflowPolicy::drop;
+
+/**
+ * Moves the actual writing (and the file rotation) out of the threads that log.
+ * write() converts the message to UTF-8 and puts it into the lock-free queue of the calling
+ * thread. The single flusher thread takes all queued messages, orders them the way they were
+ * written and passes them to the target writer with a single writeBatch() call.
+ * Messages of different threads may appear slightly out of order if they were written in
+ * the middle of a flush.
+ * The messages that are still queued are written on destruction. If the process crashes, they
+ * are lost.
+ */
+class NX_UTILS_API AsyncWriter: public AbstractWriter
+{
+public:
+    struct Settings
+    {
+        /** Maximum number of messages queued by a single thread. Rounded up to a power of 2. */
+        std::size_t queueSize = kDefaultAsyncLogQueueSize;
+
+        /** What to do with a message when the queue of the thread is full. */
+        AsyncWriterOverflowPolicy overflowPolicy = kDefaultAsyncLogOverflowPolicy;
+
+        /** The longest time a message stays in the queue if the queue is not filling up. */
+        std::chrono::milliseconds flushPeriod = std::chrono::milliseconds(100);
+    };
+
+    struct Statistics
+    {
+        std::uint64_t writtenMessageCount = 0;
+        std::uint64_t droppedMessageCount = 0;
+
+        /** Number of write() calls that had to wait for the free space in the queue. */
+        std::uint64_t blockedWriteCount = 0;
+    };
+
+    AsyncWriter(std::unique_ptr<AbstractWriter> target, Settings settings);
+    virtual ~AsyncWriter() override;
+
+    virtual void write(Level level, const QString& message) override;
+    virtual cf::future<cf::unit> stopArchivingAsync() override;
+
+    /** Blocks until all messages queued before this call are passed to the target writer. */
+    void flush();
+
+    AbstractWriter* target() const;
+    Statistics statistics() const;
+
+private:
+    struct QueueItem
+    {
+        std::uint64_t sequence = 0;
+        Record record;
+    };
+
+    class Queue;
+    struct ThreadQueues;
+
+    Queue* threadQueue();
+    void pushOrWait(Queue* queue, QueueItem* item);
+    void requestFlush();
+    void runFlusher();
+    void flushQueues();
+
+private:
+    const std::unique_ptr<AbstractWriter> m_target;
+    const Settings m_settings;
+    const std::uint64_t m_id;
+
+    std::atomic<std::uint64_t> m_sequence{0};
+    std::atomic<std::uint64_t> m_writtenMessageCount{0};
+    std::atomic<std::uint64_t> m_droppedMessageCount{0};
+    std::atomic<std::uint64_t> m_blockedWriteCount{0};
+    std::uint64_t m_reportedDroppedMessageCount = 0;
+
+    nx::Mutex m_queuesMutex;
+    std::vector<std::shared_ptr<Queue>> m_queues;
+
+    /** Only one thread can read from the queues at a time. */
+    nx::Mutex m_flushMutex;
+    std::vector<QueueItem> m_batch;
+    std::vector<Record> m_records;
+
+    nx::Mutex m_mutex;
+    nx::WaitCondition m_flushRequested;
+    nx::WaitCondition m_spaceFreed;
+    bool m_flushPending = false;
+    bool m_terminated = false;
+
+    std::thread m_flusherThread;
+};
+
+} // namespace nx::log
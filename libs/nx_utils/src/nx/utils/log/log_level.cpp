@@ -195,6 +195,11 @@ QString Filter::toString() const
     return m_impl->pattern;
 }
 
+bool Filter::isTypeNamePrefix() const
+{
+    return !m_impl->regex && !m_impl->pattern.contains('(');
+}
+
 bool Filter::operator<(const Filter& rhs) const
 {
     return toString() < rhs.toString();
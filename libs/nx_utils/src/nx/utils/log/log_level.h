@@ -94,6 +94,12 @@ public:
     bool accepts(const Tag& tag) const;
     QString toString() const;
 
+    /**
+     * @return True if only the type name part of a tag made from a pointer can affect the result:
+     * the filter is a prefix that does not reach the address and the id following the type name.
+     */
+    bool isTypeNamePrefix() const;
+
     bool operator<(const Filter& rhs) const;
     bool operator==(const Filter& rhs) const;
     bool operator!=(const Filter& rhs) const;
@@ -21,6 +21,8 @@
 
 #include <nx/build_info.h>
 
+#include "log_async_writer.h"
+
 namespace {
 
 using namespace nx::log;
@@ -53,6 +55,14 @@ const QString& findLevel(Level level)
         });
     return kLevels[idx];
 }
+
+File* fileWriter(AbstractWriter* writer)
+{
+    if (const auto asyncWriter = dynamic_cast<AsyncWriter*>(writer))
+        writer = asyncWriter->target();
+    return dynamic_cast<File*>(writer);
+}
+
 } // namespace
 
 namespace nx::log {
@@ -179,7 +189,7 @@ void Logger::setSettings(const LoggerSettings& loggerSettings)
 
     m_settings = loggerSettings;
 
-    if (auto file = dynamic_cast<File*>(m_writer.get()); file)
+    if (auto file = fileWriter(m_writer.get()); file)
     {
         File::Settings fileSettings;
         fileSettings.maxFileTimePeriodS = m_settings.maxFileTimePeriodS;
@@ -230,7 +240,7 @@ std::optional<QString> Logger::filePath() const
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
 
-    if (const auto file = dynamic_cast<File*>(m_writer.get()); file)
+    if (const auto file = fileWriter(m_writer.get()); file)
         return file->getFileName();
 
     return std::nullopt;
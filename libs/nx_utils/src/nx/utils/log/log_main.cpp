@@ -14,6 +14,18 @@ namespace detail {
 
 /*static*/ bool LevelReducer::s_isEnabled = true;
 
+/*static*/ std::atomic<std::uint32_t> CallSiteCache::s_generation = 1;
+/*static*/ std::atomic<bool> CallSiteCache::s_isTagKeyAllowed = false;
+
+void CallSiteCache::invalidateAll(bool isTagKeyAllowed)
+{
+    s_isTagKeyAllowed = isTagKeyAllowed;
+
+    // 0 is the generation of a call site that has not decided anything yet.
+    if (++s_generation == 0)
+        ++s_generation;
+}
+
 } // namespace detail
 
 namespace {
@@ -2,6 +2,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <typeinfo>
+
 #include <nx/utils/system_error.h>
 #include <nx/utils/time.h>
 
@@ -87,18 +92,139 @@ private:
     std::atomic<uint32_t> m_windowStartS{0};
 };
 
+/**
+ * Makes a log statement that is known to be disabled cost a couple of atomic loads: no tag is
+ * built and no logger is looked up. Each call site remembers its latest "disabled" decision along
+ * with the generation of the logger configuration it was made for. LoggerCollection increments
+ * the generation on every change of the loggers, their levels or filters.
+ * A decision made by maxLevel() applies to any tag. A decision made by the logger applies to the
+ * type of the tag and is remembered only if the tag is made from a pointer (e.g., `this`) or from
+ * std::type_info, and every filter depends on the type name only (see Filter::isTypeNamePrefix()).
+ */
+class CallSiteCache
+{
+public:
+    bool isDisabled(Level level, const void* tagKey) const
+    {
+        const auto state = m_state.load(std::memory_order_acquire);
+        if ((state & ~kFingerprintMask & ~kAnyTagBit) != makeState(generation(), level))
+            return false;
+
+        if (state & kAnyTagBit)
+            return true;
+
+        // The fingerprint protects from a key stored concurrently with another state.
+        return tagKey
+            && (state & kFingerprintMask) == fingerprint(tagKey)
+            && m_tagKey.load(std::memory_order_relaxed) == tagKey;
+    }
+
+    void setDisabledForAnyTag(std::uint32_t generation, Level level)
+    {
+        m_state.store(makeState(generation, level) | kAnyTagBit, std::memory_order_release);
+    }
+
+    void setDisabledForTag(std::uint32_t generation, Level level, const void* tagKey)
+    {
+        if (!tagKey || !s_isTagKeyAllowed.load(std::memory_order_relaxed))
+            return;
+
+        m_tagKey.store(tagKey, std::memory_order_relaxed);
+        m_state.store(
+            makeState(generation, level) | fingerprint(tagKey), std::memory_order_release);
+    }
+
+    /** Must be read before the decision is made. */
+    static std::uint32_t generation() { return s_generation.load(std::memory_order_acquire); }
+
+    /** Invalidates the decisions of all call sites. */
+    NX_UTILS_API static void invalidateAll(bool isTagKeyAllowed);
+
+private:
+    // State layout: generation (32 bits), level (8 bits), key fingerprint (23 bits), any tag bit.
+    static constexpr std::uint64_t kAnyTagBit = 1;
+    static constexpr std::uint64_t kFingerprintMask = 0x00FF'FFFE;
+
+    static constexpr std::uint64_t makeState(std::uint32_t generation, Level level)
+    {
+        return ((std::uint64_t) generation << 32) | (((std::uint64_t) level & 0xFF) << 24);
+    }
+
+    static std::uint64_t fingerprint(const void* tagKey)
+    {
+        // Type info objects are aligned, so the lowest bits are not informative.
+        return ((std::uint64_t) reinterpret_cast<std::uintptr_t>(tagKey) >> 2) & kFingerprintMask;
+    }
+
+    NX_UTILS_API static std::atomic<std::uint32_t> s_generation /*= 1*/;
+    NX_UTILS_API static std::atomic<bool> s_isTagKeyAllowed /*= false*/;
+
+    std::atomic<std::uint64_t> m_state{0};
+    std::atomic<const void*> m_tagKey{nullptr};
+};
+
+template<typename T>
+constexpr bool hasTagKey()
+{
+    using Type = std::remove_cvref_t<T>;
+    return std::is_pointer_v<Type> || std::is_same_v<Type, std::type_info>;
+}
+
+/** The same type that Tag(const T*) uses for the tag text. */
+template<typename T>
+const void* tagKey(T* pointer)
+{
+    if constexpr (std::is_polymorphic_v<T>)
+    {
+        if (pointer)
+            return &typeid(*pointer);
+    }
+    return &typeid(T);
+}
+
+inline const void* tagKey(const std::type_info& info)
+{
+    return &info;
+}
+
+template<typename T>
+const void* tagKey(const T& /*tag*/)
+{
+    return nullptr;
+}
+
+/** @return false if no logger accepts the level. The decision is remembered by the call site. */
+inline bool isLevelEnabled(CallSiteCache* callSiteCache, Level level)
+{
+    const auto generation = CallSiteCache::generation();
+    if (level <= maxLevel())
+        return true;
+
+    callSiteCache->setDisabledForAnyTag(generation, level);
+    return false;
+}
+
 class Helper
 {
 public:
     Helper() {} //< Constructing a helper which does not log anything.
 
-    Helper(LevelReducer* levelReducer, Tag tag):
+    Helper(
+        LevelReducer* levelReducer,
+        CallSiteCache* callSiteCache,
+        const void* tagKey,
+        Tag tag)
+        :
         m_tag(std::move(tag)),
-        m_levelReducer(levelReducer),
-        m_logger(getLogger(m_tag))
+        m_levelReducer(levelReducer)
     {
+        const auto generation = CallSiteCache::generation();
+        m_logger = getLogger(m_tag);
         if (m_logger && !m_logger->isToBeLogged(levelReducer->baseLevel(), m_tag))
+        {
             m_logger.reset();
+            callSiteCache->setDisabledForTag(generation, levelReducer->baseLevel(), tagKey);
+        }
     }
 
     void log(const QString& message) const
@@ -170,19 +296,42 @@ inline void setLevelReducerEnabled(bool value)
     detail::LevelReducer::setEnabled(value);
 }
 
+/**
+ * Log statements of more verbose levels are removed by the compiler. Set by the
+ * logCompileTimeMaxLevel CMake option, e.g. `debug` removes NX_VERBOSE and NX_TRACE.
+ */
+#if defined(NX_LOG_COMPILE_TIME_MAX_LEVEL)
+    static constexpr Level kCompileTimeMaxLevel = Level::NX_LOG_COMPILE_TIME_MAX_LEVEL;
+#else
+    static constexpr Level kCompileTimeMaxLevel = Level::trace;
+#endif
+
+/** Evaluates TAG only if it can be a key of CallSiteCache. */
+#define NX_UTILS_LOG_TAG_KEY(TAG) \
+    (nx::log::detail::hasTagKey<decltype((TAG))>() ? nx::log::detail::tagKey(TAG) : nullptr)
+
 /**
  * NOTE: Preserves current system error code (SystemError::getLastOSErrorCode()).
  */
 #define NX_UTILS_LOG_MESSAGE(LEVEL, TAG, ...) do \
 { \
     struct ScopeTag{}; /*< Used by NX_SCOPE_TAG to get scope from demangled type_info::name(). */ \
-    if ((LEVEL) <= nx::log::maxLevel()) \
+    if ((LEVEL) <= nx::log::kCompileTimeMaxLevel) \
     { \
-        const auto systemErrorBak = SystemError::getLastOSErrorCode(); \
-        static nx::log::detail::LevelReducer levelReducer(LEVEL); \
-        if (auto _log_helper = nx::log::detail::Helper(&levelReducer, (TAG))) \
-            _log_helper.log(::nx::format(__VA_ARGS__)); \
-        SystemError::setLastErrorCode(systemErrorBak); \
+        static nx::log::detail::CallSiteCache callSiteCache; \
+        const void* const callSiteTagKey = NX_UTILS_LOG_TAG_KEY(TAG); \
+        if (!callSiteCache.isDisabled((LEVEL), callSiteTagKey) \
+            && nx::log::detail::isLevelEnabled(&callSiteCache, (LEVEL))) \
+        { \
+            const auto systemErrorBak = SystemError::getLastOSErrorCode(); \
+            static nx::log::detail::LevelReducer levelReducer(LEVEL); \
+            if (auto _log_helper = nx::log::detail::Helper( \
+                &levelReducer, &callSiteCache, callSiteTagKey, (TAG))) \
+            { \
+                _log_helper.log(::nx::format(__VA_ARGS__)); \
+            } \
+            SystemError::setLastErrorCode(systemErrorBak); \
+        } \
     } \
 } while (0)
 
@@ -190,10 +339,18 @@ inline void setLevelReducerEnabled(bool value)
     for (auto stream = \
             [&]() \
             { \
-                if ((LEVEL) > nx::log::maxLevel()) \
+                if ((LEVEL) > nx::log::kCompileTimeMaxLevel) \
+                    return nx::log::detail::Stream(); \
+                static nx::log::detail::CallSiteCache callSiteCache; \
+                const void* const callSiteTagKey = NX_UTILS_LOG_TAG_KEY(TAG); \
+                if (callSiteCache.isDisabled((LEVEL), callSiteTagKey) \
+                    || !nx::log::detail::isLevelEnabled(&callSiteCache, (LEVEL))) \
+                { \
                     return nx::log::detail::Stream(); \
+                } \
                 static nx::log::detail::LevelReducer levelReducer(LEVEL); \
-                return nx::log::detail::Stream(&levelReducer, (TAG));  \
+                return nx::log::detail::Stream( \
+                    &levelReducer, &callSiteCache, callSiteTagKey, (TAG)); \
             }(); \
         stream; stream.flush()) \
             stream /* <<... */
@@ -4,6 +4,7 @@
 
 #include <QtCore/QSettings>
 
+#include <nx/reflect/enum_string_conversion.h>
 #include <nx/utils/deprecated_settings.h>
 #include <nx/utils/std/filesystem.h>
 #include <nx/utils/string.h>
@@ -64,6 +65,23 @@ bool LoggerSettings::parse(const QString& str)
         {
             archivingEnabled = QVariant(param.second.c_str()).toBool();
         }
+        else if (param.first == kAsyncLogWritingSymbolicName)
+        {
+            asyncWritingEnabled = QVariant(param.second.c_str()).toBool();
+        }
+        else if (param.first == kAsyncLogQueueSizeSymbolicName)
+        {
+            bool ok = false;
+            const auto queueSize = QString::fromStdString(param.second).toULongLong(&ok);
+            if (ok && queueSize > 0)
+                asyncQueueSize = (std::size_t) queueSize;
+            parseSucceeded = parseSucceeded && ok && queueSize > 0;
+        }
+        else if (param.first == kAsyncLogOverflowPolicySymbolicName)
+        {
+            parseSucceeded = parseSucceeded
+                && nx::reflect::enumeration::fromString(param.second, &asyncOverflowPolicy);
+        }
     }
 
     if (!NX_ASSERT(maxVolumeSizeB >= maxFileSizeB))
@@ -85,6 +103,9 @@ bool LoggerSettings::operator==(const LoggerSettings& right) const
         && maxFileSizeB == right.maxFileSizeB
         && maxVolumeSizeB == right.maxVolumeSizeB
         && maxFileTimePeriodS == right.maxFileTimePeriodS
+        && asyncWritingEnabled == right.asyncWritingEnabled
+        && asyncQueueSize == right.asyncQueueSize
+        && asyncOverflowPolicy == right.asyncOverflowPolicy
         && logBaseName == right.logBaseName;
 }
 
@@ -101,6 +122,18 @@ static void readRotationParams(
         kMaxLogFileTimePeriodSymbolicName, (int) defaults.maxFileTimePeriodS.count()).toLongLong());
     target->archivingEnabled = settings->value(
         kLogArchivingEnabledSymbolicName, defaults.archivingEnabled).toBool();
+    target->asyncWritingEnabled = settings->value(
+        kAsyncLogWritingSymbolicName, defaults.asyncWritingEnabled).toBool();
+    target->asyncQueueSize = (std::size_t) settings->value(
+        kAsyncLogQueueSizeSymbolicName, (qulonglong) defaults.asyncQueueSize).toULongLong();
+    if (target->asyncQueueSize == 0)
+        target->asyncQueueSize = defaults.asyncQueueSize;
+    if (!nx::reflect::enumeration::fromString(
+        settings->value(kAsyncLogOverflowPolicySymbolicName).toString().toStdString(),
+        &target->asyncOverflowPolicy))
+    {
+        target->asyncOverflowPolicy = defaults.asyncOverflowPolicy;
+    }
 
     if (!NX_ASSERT(target->maxVolumeSizeB >= target->maxFileSizeB,
         "Volume size %1 is less then file size %2", target->maxVolumeSizeB, target->maxFileSizeB))
@@ -132,7 +165,10 @@ Settings::Settings(QSettings* settings)
             if (levelKey == kMaxLogVolumeSizeSymbolicName
                 || levelKey == kMaxLogFileSizeSymbolicName
                 || levelKey == kMaxLogFileTimePeriodSymbolicName
-                || levelKey == kLogArchivingEnabledSymbolicName)
+                || levelKey == kLogArchivingEnabledSymbolicName
+                || levelKey == kAsyncLogWritingSymbolicName
+                || levelKey == kAsyncLogQueueSizeSymbolicName
+                || levelKey == kAsyncLogOverflowPolicySymbolicName)
             {
                 continue; //< Already parsed by readRotationParams.
             }
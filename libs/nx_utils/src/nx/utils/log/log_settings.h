@@ -4,6 +4,7 @@
 
 #include <vector>
 
+#include "log_async_writer.h"
 #include "log_level.h"
 #include "log_writers.h"
 
@@ -16,6 +17,9 @@ static constexpr char kMaxLogVolumeSizeSymbolicName[] = "maxLogVolumeSizeB";
 static constexpr char kMaxLogFileSizeSymbolicName[] = "maxLogFileSizeB";
 static constexpr char kMaxLogFileTimePeriodSymbolicName[] = "maxLogFileTimePeriodS";
 static constexpr char kLogArchivingEnabledSymbolicName[] = "logArchivingEnabled";
+static constexpr char kAsyncLogWritingSymbolicName[] = "asyncLogWriting";
+static constexpr char kAsyncLogQueueSizeSymbolicName[] = "asyncLogQueueSize";
+static constexpr char kAsyncLogOverflowPolicySymbolicName[] = "asyncLogOverflowPolicy";
 
 /**
  * Specifies configuration of a logger.
@@ -26,13 +30,19 @@ static constexpr char kLogArchivingEnabledSymbolicName[] = "logArchivingEnabled"
  * param = key [= value]
  * value = TEXT
  * param = file | dir | maxLogVolumeSizeB | maxLogFileSizeB | maxLogFileTimePeriodS | level
+ *     | asyncLogWriting | asyncLogQueueSize | asyncLogOverflowPolicy
  * level = LogLevel ["[" messageTagPrefixes "]"]
  * messageTagPrefixes = messageTagPrefix (", " messageTagPrefix)*
  * file = - | fileName
+ * asyncLogOverflowPolicy = drop | block
  * </code></pre>
  *
  * "-" means STDOUT
  *
+ * With `asyncLogWriting=true` the file is written by a background thread (see AsyncWriter).
+ * `asyncLogQueueSize` is the number of messages each thread can queue, `asyncLogOverflowPolicy`
+ * tells whether the messages that do not fit are dropped or the logging thread waits.
+ *
  * For most applications logger settings are specified with `--log/logger=LOGGER_SETTINGS` argument.
  * There can be multiple `--log/logger=` arguments.
  *
@@ -64,6 +74,9 @@ public:
     qint64 maxFileSizeB = kDefaultMaxLogFileSizeB; //< 10 MB.
     std::chrono::seconds maxFileTimePeriodS = kDefaultMaxLogFileTimePeriodS; //< 0.
     bool archivingEnabled = kDefaultLogArchivingEnabled;
+    bool asyncWritingEnabled = false;
+    std::size_t asyncQueueSize = kDefaultAsyncLogQueueSize;
+    AsyncWriterOverflowPolicy asyncOverflowPolicy = kDefaultAsyncLogOverflowPolicy;
     QString logBaseName;
 
     bool parse(const QString& str);
@@ -24,6 +24,12 @@ static constexpr int kBufferSize = 64 * 1024;
 
 namespace nx::log {
 
+void AbstractWriter::writeBatch(const std::vector<Record>& records)
+{
+    for (const auto& record: records)
+        write(record.level, QString::fromStdString(record.message));
+}
+
 cf::future<cf::unit> AbstractWriter::stopArchivingAsync()
 {
     return cf::make_ready_future(cf::unit());
@@ -92,6 +98,32 @@ void File::write(Level /*level*/, const QString& message)
     rotateIfNeeded(&lock);
 }
 
+void File::writeBatch(const std::vector<Record>& records)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    for (const auto& record: records)
+    {
+        if (!openFile())
+        {
+            std::cerr << record.message + '\n';
+            continue;
+        }
+
+        m_file << record.message << '\n';
+        m_currentPos += record.message.size() + 1;
+
+        // The time limit is checked once per batch below.
+        if (m_currentPos >= m_settings.maxFileSizeB)
+            rotateIfNeeded(&lock);
+    }
+
+    if (m_file.is_open())
+    {
+        m_file.flush();
+        rotateIfNeeded(&lock);
+    }
+}
+
 QString File::makeFileName(QString fileName, size_t backupNumber, File::Extension ext)
 {
     auto removedExtension = fileName;
@@ -4,6 +4,8 @@
 
 #include <fstream>
 #include <future>
+#include <string>
+#include <vector>
 
 #include <QtCore/QDateTime>
 #include <QtCore/QFileInfo>
@@ -24,8 +26,18 @@ static constexpr bool kDefaultLogArchivingEnabled = true;
 class NX_UTILS_API AbstractWriter
 {
 public:
+    struct Record
+    {
+        Level level = Level::undefined;
+        std::string message; /**< UTF-8. */
+    };
+
     virtual ~AbstractWriter() = default;
     virtual void write(Level level, const QString& message) = 0;
+
+    /** Writes the records in the given order. By default, write() is invoked for each of them. */
+    virtual void writeBatch(const std::vector<Record>& records);
+
     virtual cf::future<cf::unit> stopArchivingAsync();
 };
 
@@ -84,6 +96,10 @@ public:
     File(Settings settings);
     virtual ~File();
     virtual void write(Level level, const QString& message) override;
+
+    /** Takes the lock and flushes the file once for all records. */
+    virtual void writeBatch(const std::vector<Record>& records) override;
+
     virtual cf::future<cf::unit> stopArchivingAsync() override;
     QString getFileName(size_t backupNumber = 0) const;
 
@@ -5,6 +5,7 @@
 #include <nx/utils/string.h>
 
 #include "aggregate_logger.h"
+#include "log_async_writer.h"
 #include "log_main.h"
 
 namespace nx::log {
@@ -97,6 +98,14 @@ std::unique_ptr<Logger> LoggerBuilder::buildLogger(
                 : (settings.directory + "/" + baseName);
 
             writer = std::make_unique<File>(fileSettings);
+
+            if (settings.asyncWritingEnabled)
+            {
+                AsyncWriter::Settings asyncSettings;
+                asyncSettings.queueSize = settings.asyncQueueSize;
+                asyncSettings.overflowPolicy = settings.asyncOverflowPolicy;
+                writer = std::make_unique<AsyncWriter>(std::move(writer), asyncSettings);
+            }
         }
         else
         {
@@ -2,10 +2,13 @@
 
 #include "logger_collection.h"
 
+#include <algorithm>
 #include <cstdlib>
 
 #include <QTextCodec>
 
+#include "log_main.h"
+
 namespace nx::log {
 
 static void stopArchivingInstance()
@@ -23,6 +26,7 @@ LoggerCollection::LoggerCollection()
 LoggerCollection::~LoggerCollection()
 {
     m_isDestroyed = true;
+    detail::CallSiteCache::invalidateAll(/*isTagKeyAllowed*/ false);
 }
 
 LoggerCollection* LoggerCollection::instance()
@@ -174,6 +178,8 @@ void LoggerCollection::remove(int loggerId)
         else
             ++it;
     }
+
+    updateMaxLevel();
 }
 
 Level LoggerCollection::maxLevel() const
@@ -186,6 +192,22 @@ void LoggerCollection::updateMaxLevel()
     m_maxLevel = m_mainLogger->maxLevel();
     for (const auto& element: m_loggersByFilter)
         m_maxLevel = std::max(element.second.logger->maxLevel(), m_maxLevel.load());
+
+    const auto isTypeNamePrefix =
+        [](const auto& element) { return element.first.isTypeNamePrefix(); };
+
+    bool isTagKeyAllowed = std::all_of(
+        m_loggersByFilter.begin(), m_loggersByFilter.end(), isTypeNamePrefix);
+    std::set<AbstractLogger*> loggers{m_mainLogger.get()};
+    for (const auto& element: m_loggersByFilter)
+        loggers.insert(element.second.logger.get());
+    for (auto it = loggers.begin(); isTagKeyAllowed && it != loggers.end(); ++it)
+    {
+        const auto levelFilters = (*it)->levelFilters();
+        isTagKeyAllowed = std::all_of(levelFilters.begin(), levelFilters.end(), isTypeNamePrefix);
+    }
+
+    detail::CallSiteCache::invalidateAll(isTagKeyAllowed);
 }
 
 void LoggerCollection::onLevelChanged()
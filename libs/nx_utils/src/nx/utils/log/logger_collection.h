@@ -80,6 +80,7 @@ public:
     void stopArchiving();
 
 private:
+    /** Also invalidates the decisions remembered by the log statements. */
     void updateMaxLevel();
 
     void onLevelChanged();
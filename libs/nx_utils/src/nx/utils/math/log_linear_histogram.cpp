@@ -0,0 +1,90 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "log_linear_histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace nx::utils::math {
+
+void LogLinearHistogram::add(std::uint64_t value)
+{
+    m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto currentMax = m_max.load(std::memory_order_relaxed);
+    while (value > currentMax
+        && !m_max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed))
+    {
+    }
+
+    m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t LogLinearHistogram::count() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LogLinearHistogram::sum() const
+{
+    return m_sum.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LogLinearHistogram::max() const
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LogLinearHistogram::percentile(double percentile) const
+{
+    std::array<std::uint64_t, kBucketCount> counts;
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i)
+    {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    if (total == 0)
+        return 0;
+
+    // Nearest rank.
+    const auto rank = std::clamp<std::uint64_t>(
+        (std::uint64_t) std::ceil(percentile * total), 1, total);
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+            return std::min(bucketUpperBound(i), max());
+    }
+
+    return max();
+}
+
+std::size_t LogLinearHistogram::bucketIndex(std::uint64_t value)
+{
+    value = std::min(value, kMaxTrackableValue);
+    if (value < kSubBucketCount)
+        return (std::size_t) value;
+
+    // The mantissa is kSubBucketBits + 1 most significant bits of the value.
+    const int shift = (int) std::bit_width(value) - 1 - kSubBucketBits;
+    const auto mantissa = value >> shift;
+    return (std::size_t) (shift * kSubBucketCount + mantissa);
+}
+
+std::uint64_t LogLinearHistogram::bucketUpperBound(std::size_t index)
+{
+    if (index < 2 * kSubBucketCount)
+        return index;
+
+    const auto shift = index / kSubBucketCount - 1;
+    const auto mantissa = index % kSubBucketCount + kSubBucketCount;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+} // namespace nx::utils::math
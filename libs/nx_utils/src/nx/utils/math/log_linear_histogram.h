@@ -0,0 +1,55 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace nx::utils::math {
+
+/**
+ * HDR-style histogram of non-negative integer values (e.g., latencies in microseconds).
+ * Each power of two range is split into kSubBucketCount equal buckets. So, a value is known with
+ * the relative error not exceeding 1 / kSubBucketCount (~3%) while the memory used is fixed.
+ * Values above kMaxTrackableValue are counted in the last bucket.
+ * Lock-free: all methods can be called concurrently. A reader may observe a value that is being
+ * added concurrently partially (e.g., in count(), but not yet in the percentile).
+ * The values are never expired: the histogram covers its whole lifetime.
+ */
+class NX_UTILS_API LogLinearHistogram
+{
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr std::uint64_t kSubBucketCount = 1 << kSubBucketBits;
+    static constexpr int kMaxValueBits = 40;
+    static constexpr std::uint64_t kMaxTrackableValue = (std::uint64_t(1) << kMaxValueBits) - 1;
+    static constexpr std::size_t kBucketCount =
+        (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+    void add(std::uint64_t value);
+
+    std::uint64_t count() const;
+    std::uint64_t sum() const;
+    std::uint64_t max() const;
+
+    /**
+     * @param percentile A value in the range (0, 1].
+     * @return The highest value that is equivalent to the one at the given percentile, but not
+     * greater than max(). 0 if the histogram is empty.
+     */
+    std::uint64_t percentile(double percentile) const;
+
+    static std::size_t bucketIndex(std::uint64_t value);
+
+    /** @return The highest value that falls into the bucket. */
+    static std::uint64_t bucketUpperBound(std::size_t index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBucketCount> m_buckets{};
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_sum{0};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+} // namespace nx::utils::math
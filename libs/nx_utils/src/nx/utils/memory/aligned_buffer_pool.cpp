@@ -0,0 +1,464 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "aligned_buffer_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+
+#include <nx/kit/utils.h>
+#include <nx/utils/nx_utils_ini.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::utils::memory {
+
+namespace {
+
+static constexpr int kClassesPerDoublingLog2 = 2;
+static constexpr std::size_t kClassesPerDoubling = 1 << kClassesPerDoublingLog2;
+static constexpr int kMinBlockSizeLog2 = std::bit_width(AlignedBufferPool::kMinBlockSize) - 1;
+
+/** The free blocks of each size class a thread keeps, in bytes. At least one block is kept. */
+static constexpr std::size_t kThreadCacheSizePerClass = 256 * 1024;
+
+/** Set when the thread is exiting and its caches are not available anymore. */
+thread_local bool sThreadCachesDestroyed = false;
+
+/**
+ * Class 0 is kMinBlockSize. Then every power of two 2^k is followed by kClassesPerDoubling
+ * classes: 2^k + 2^k / 4, 2^k + 2 * 2^k / 4, ..., 2^(k + 1).
+ */
+constexpr std::size_t sizeClassIndex(std::size_t size)
+{
+    if (size <= AlignedBufferPool::kMinBlockSize)
+        return 0;
+
+    const int log2 = std::bit_width(size - 1) - 1; //< 2^log2 < size <= 2^(log2 + 1).
+    const std::size_t step = (std::size_t(1) << log2) >> kClassesPerDoublingLog2;
+    const std::size_t stepCount = (size - (std::size_t(1) << log2) + step - 1) / step;
+    return (log2 - kMinBlockSizeLog2) * kClassesPerDoubling + stepCount;
+}
+
+constexpr std::size_t sizeClassBlockSize(std::size_t index)
+{
+    if (index == 0)
+        return AlignedBufferPool::kMinBlockSize;
+
+    const int log2 = kMinBlockSizeLog2 + (int) ((index - 1) / kClassesPerDoubling);
+    const std::size_t base = std::size_t(1) << log2;
+    const std::size_t stepCount = (index - 1) % kClassesPerDoubling + 1;
+    return base + stepCount * (base >> kClassesPerDoublingLog2);
+}
+
+static constexpr std::size_t kSizeClassCount =
+    sizeClassIndex(AlignedBufferPool::kMaxBlockSize) + 1;
+
+static_assert(sizeClassBlockSize(kSizeClassCount - 1) == AlignedBufferPool::kMaxBlockSize);
+static_assert(sizeClassBlockSize(sizeClassIndex(5000)) == 5120);
+
+constexpr std::size_t threadCacheCapacity(std::size_t index)
+{
+    return std::max<std::size_t>(1, kThreadCacheSizePerClass / sizeClassBlockSize(index));
+}
+
+template<typename T>
+void updateMax(std::atomic<T>* max, T value)
+{
+    auto current = max->load(std::memory_order_relaxed);
+    while (current < value
+        && !max->compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * The state shared by all threads. Outlives the pool while there are thread caches referencing
+ * it.
+ */
+class AlignedBufferPool::Central
+{
+public:
+    struct SizeClass
+    {
+        /** Guarded by mutex. */
+        std::vector<void*> freeBlocks;
+
+        std::atomic<std::size_t> usedBlockCount{0};
+        std::atomic<std::size_t> maxUsedBlockCount{0};
+        std::atomic<std::size_t> cachedBlockCount{0};
+        std::atomic<std::uint64_t> allocationCount{0};
+        std::atomic<std::uint64_t> reuseCount{0};
+    };
+
+    const std::size_t maxCachedBytes;
+    std::array<SizeClass, kSizeClassCount> sizeClasses;
+    std::atomic<std::size_t> usedBytes{0};
+    std::atomic<std::size_t> maxUsedBytes{0};
+    std::atomic<std::size_t> cachedBytes{0};
+
+    /** Thread caches are freed when this is changed. */
+    std::atomic<std::uint64_t> trimCount{0};
+
+    /** Set under mutex when the pool is destroyed. */
+    std::atomic<bool> isClosed{false};
+
+    mutable nx::Mutex mutex;
+
+    Central(std::size_t maxCachedBytes): maxCachedBytes(maxCachedBytes) {}
+
+    ~Central()
+    {
+        for (std::size_t i = 0; i < kSizeClassCount; ++i)
+        {
+            for (void* block: sizeClasses[i].freeBlocks)
+                releaseCached(i, block);
+        }
+    }
+
+    void* allocateFromSystem(std::size_t index)
+    {
+        const auto size = sizeClassBlockSize(index);
+        if (void* block = nx::kit::utils::mallocAligned(size, kAlignment))
+            return block;
+
+        trim(0);
+        return nx::kit::utils::mallocAligned(size, kAlignment);
+    }
+
+    void onBlockTaken(std::size_t index, bool isReused)
+    {
+        auto& sizeClass = sizeClasses[index];
+        if (isReused)
+            ++sizeClass.reuseCount;
+        else
+            ++sizeClass.allocationCount;
+
+        updateMax(&sizeClass.maxUsedBlockCount, ++sizeClass.usedBlockCount);
+        updateMax(&maxUsedBytes, usedBytes += sizeClassBlockSize(index));
+    }
+
+    void onBlockReturned(std::size_t index)
+    {
+        --sizeClasses[index].usedBlockCount;
+        usedBytes -= sizeClassBlockSize(index);
+    }
+
+    /**
+     * @return false if caching one more block would exceed maxCachedBytes.
+     */
+    bool reserveCacheSpace(std::size_t index)
+    {
+        if (isClosed)
+            return false;
+
+        const auto size = sizeClassBlockSize(index);
+        if (cachedBytes.fetch_add(size) + size > maxCachedBytes)
+        {
+            cachedBytes -= size;
+            return false;
+        }
+
+        ++sizeClasses[index].cachedBlockCount;
+        return true;
+    }
+
+    /** Accounts a cached block that is given out. */
+    void onCachedBlockTaken(std::size_t index)
+    {
+        --sizeClasses[index].cachedBlockCount;
+        cachedBytes -= sizeClassBlockSize(index);
+    }
+
+    /** Frees a cached block. */
+    void releaseCached(std::size_t index, void* block)
+    {
+        onCachedBlockTaken(index);
+        nx::kit::utils::freeAligned(block);
+    }
+
+    /**
+     * Moves up to count blocks from the shared list to the destination.
+     */
+    void takeFreeBlocks(std::size_t index, std::size_t count, std::vector<void*>* destination)
+    {
+        NX_MUTEX_LOCKER lock(&mutex);
+        auto& freeBlocks = sizeClasses[index].freeBlocks;
+        count = std::min(count, freeBlocks.size());
+        destination->insert(destination->end(), freeBlocks.end() - count, freeBlocks.end());
+        freeBlocks.resize(freeBlocks.size() - count);
+    }
+
+    /**
+     * Moves the last count blocks of the source to the shared list.
+     */
+    void putFreeBlocks(std::size_t index, std::size_t count, std::vector<void*>* source)
+    {
+        const auto first = source->end() - count;
+
+        NX_MUTEX_LOCKER lock(&mutex);
+        if (isClosed)
+        {
+            std::for_each(first, source->end(), [&](void* block) { releaseCached(index, block); });
+        }
+        else
+        {
+            auto& freeBlocks = sizeClasses[index].freeBlocks;
+            freeBlocks.insert(freeBlocks.end(), first, source->end());
+        }
+
+        source->erase(first, source->end());
+    }
+
+    void trim(std::size_t limit)
+    {
+        ++trimCount;
+
+        NX_MUTEX_LOCKER lock(&mutex);
+        // The larger blocks first: they are reused less often.
+        for (std::size_t i = kSizeClassCount; i-- > 0 && cachedBytes > limit;)
+        {
+            auto& freeBlocks = sizeClasses[i].freeBlocks;
+            while (!freeBlocks.empty() && cachedBytes > limit)
+            {
+                releaseCached(i, freeBlocks.back());
+                freeBlocks.pop_back();
+            }
+        }
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+
+class AlignedBufferPool::ThreadCache
+{
+public:
+    const std::shared_ptr<Central> central;
+
+    ThreadCache(std::shared_ptr<Central> central):
+        central(std::move(central)),
+        m_trimCount(this->central->trimCount)
+    {
+    }
+
+    ~ThreadCache()
+    {
+        for (std::size_t i = 0; i < kSizeClassCount; ++i)
+        {
+            if (!m_freeBlocks[i].empty())
+                central->putFreeBlocks(i, m_freeBlocks[i].size(), &m_freeBlocks[i]);
+        }
+    }
+
+    /**
+     * @return nullptr if there is no cached block of this size class.
+     */
+    void* take(std::size_t index)
+    {
+        releaseIfTrimmed();
+
+        auto& freeBlocks = m_freeBlocks[index];
+        if (freeBlocks.empty())
+            central->takeFreeBlocks(index, (threadCacheCapacity(index) + 1) / 2, &freeBlocks);
+
+        if (freeBlocks.empty())
+            return nullptr;
+
+        void* block = freeBlocks.back();
+        freeBlocks.pop_back();
+        central->onCachedBlockTaken(index);
+        return block;
+    }
+
+    void put(std::size_t index, void* block)
+    {
+        releaseIfTrimmed();
+
+        auto& freeBlocks = m_freeBlocks[index];
+        freeBlocks.push_back(block);
+        if (freeBlocks.size() > threadCacheCapacity(index))
+            central->putFreeBlocks(index, freeBlocks.size() / 2, &freeBlocks);
+    }
+
+private:
+    void releaseIfTrimmed()
+    {
+        const std::uint64_t trimCount = central->trimCount;
+        if (trimCount == m_trimCount)
+            return;
+
+        m_trimCount = trimCount;
+        for (std::size_t i = 0; i < kSizeClassCount; ++i)
+        {
+            for (void* block: m_freeBlocks[i])
+                central->releaseCached(i, block);
+            m_freeBlocks[i].clear();
+        }
+    }
+
+private:
+    std::array<std::vector<void*>, kSizeClassCount> m_freeBlocks;
+    std::uint64_t m_trimCount = 0;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+AlignedBufferPool::AlignedBufferPool(std::size_t maxCachedBytes):
+    m_central(std::make_shared<Central>(maxCachedBytes))
+{
+}
+
+AlignedBufferPool::~AlignedBufferPool()
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_central->mutex);
+        m_central->isClosed = true;
+    }
+
+    // The blocks cached by the other threads are freed when those threads exit.
+    m_central->trim(0);
+}
+
+void* AlignedBufferPool::allocate(std::size_t size, std::size_t alignment)
+{
+    if (!isPooled(size, alignment))
+        return nx::kit::utils::mallocAligned(size, alignment);
+
+    const auto index = sizeClassIndex(size);
+
+    void* block = nullptr;
+    if (auto cache = threadCache())
+    {
+        block = cache->take(index);
+    }
+    else
+    {
+        std::vector<void*> blocks;
+        m_central->takeFreeBlocks(index, 1, &blocks);
+        if (!blocks.empty())
+        {
+            block = blocks.front();
+            m_central->onCachedBlockTaken(index);
+        }
+    }
+
+    const bool isReused = block != nullptr;
+    if (!block)
+        block = m_central->allocateFromSystem(index);
+    if (!block)
+        return nullptr;
+
+    m_central->onBlockTaken(index, isReused);
+    return block;
+}
+
+void AlignedBufferPool::deallocate(void* ptr, std::size_t size, std::size_t alignment)
+{
+    if (!ptr)
+        return;
+
+    if (!isPooled(size, alignment))
+        return nx::kit::utils::freeAligned(ptr);
+
+    const auto index = sizeClassIndex(size);
+    m_central->onBlockReturned(index);
+
+    if (!m_central->reserveCacheSpace(index))
+        return nx::kit::utils::freeAligned(ptr);
+
+    if (auto cache = threadCache())
+    {
+        cache->put(index, ptr);
+    }
+    else
+    {
+        std::vector<void*> blocks{ptr};
+        m_central->putFreeBlocks(index, 1, &blocks);
+    }
+}
+
+void AlignedBufferPool::trim(std::size_t maxCachedBytes)
+{
+    m_central->trim(maxCachedBytes);
+}
+
+AlignedBufferPoolStatistics AlignedBufferPool::statistics() const
+{
+    AlignedBufferPoolStatistics result;
+    result.usedBytes = m_central->usedBytes;
+    result.maxUsedBytes = m_central->maxUsedBytes;
+    result.cachedBytes = m_central->cachedBytes;
+    result.maxCachedBytes = m_central->maxCachedBytes;
+    result.trimCount = m_central->trimCount;
+
+    for (std::size_t i = 0; i < kSizeClassCount; ++i)
+    {
+        const auto& sizeClass = m_central->sizeClasses[i];
+        if (sizeClass.allocationCount == 0)
+            continue;
+
+        AlignedBufferPoolSizeClass& item = result.sizeClasses.emplace_back();
+        item.blockSize = sizeClassBlockSize(i);
+        item.usedBlockCount = sizeClass.usedBlockCount;
+        item.maxUsedBlockCount = sizeClass.maxUsedBlockCount;
+        item.cachedBlockCount = sizeClass.cachedBlockCount;
+        item.allocationCount = sizeClass.allocationCount;
+        item.reuseCount = sizeClass.reuseCount;
+    }
+
+    return result;
+}
+
+std::size_t AlignedBufferPool::blockSize(std::size_t size)
+{
+    return size <= kMaxBlockSize ? sizeClassBlockSize(sizeClassIndex(size)) : 0;
+}
+
+AlignedBufferPool& AlignedBufferPool::instance()
+{
+    // Never destroyed: ByteArray objects may still be freed by the other static destructors.
+    static const auto pool = new AlignedBufferPool(
+        (std::size_t) std::max(0, ini().alignedBufferPoolMaxCachedMb) * 1024 * 1024);
+    return *pool;
+}
+
+bool AlignedBufferPool::isPooled(std::size_t size, std::size_t alignment) const
+{
+    return m_central->maxCachedBytes > 0
+        && size <= kMaxBlockSize
+        && alignment != 0
+        && kAlignment % alignment == 0;
+}
+
+AlignedBufferPool::ThreadCache* AlignedBufferPool::threadCache()
+{
+    struct ThreadCaches
+    {
+        std::vector<std::unique_ptr<ThreadCache>> caches;
+
+        ~ThreadCaches() { sThreadCachesDestroyed = true; }
+    };
+
+    if (sThreadCachesDestroyed)
+        return nullptr;
+
+    thread_local ThreadCaches threadCaches;
+    for (const auto& cache: threadCaches.caches)
+    {
+        if (cache->central == m_central)
+            return cache.get();
+    }
+
+    // The first call of this thread.
+    std::erase_if(
+        threadCaches.caches,
+        [](const auto& cache) { return cache->central->isClosed.load(); });
+
+    return threadCaches.caches.emplace_back(std::make_unique<ThreadCache>(m_central)).get();
+}
+
+} // namespace nx::utils::memory
@@ -0,0 +1,130 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <nx/reflect/instrument.h>
+
+namespace nx::utils::memory {
+
+struct NX_UTILS_API AlignedBufferPoolSizeClass
+{
+    std::size_t blockSize = 0;
+
+    /** Blocks given out and not returned yet. */
+    std::size_t usedBlockCount = 0;
+
+    /** High-water mark of usedBlockCount. */
+    std::size_t maxUsedBlockCount = 0;
+
+    /** Free blocks kept by the pool, including the ones in the thread caches. */
+    std::size_t cachedBlockCount = 0;
+
+    /** Number of the blocks allocated from the system. */
+    std::uint64_t allocationCount = 0;
+
+    /** Number of the allocations served with a cached block. */
+    std::uint64_t reuseCount = 0;
+};
+
+#define AlignedBufferPoolSizeClass_Fields \
+    (blockSize)(usedBlockCount)(maxUsedBlockCount)(cachedBlockCount)(allocationCount)(reuseCount)
+
+NX_REFLECTION_INSTRUMENT(AlignedBufferPoolSizeClass, AlignedBufferPoolSizeClass_Fields)
+
+struct NX_UTILS_API AlignedBufferPoolStatistics
+{
+    std::size_t usedBytes = 0;
+    std::size_t maxUsedBytes = 0;
+    std::size_t cachedBytes = 0;
+    std::size_t maxCachedBytes = 0;
+    std::uint64_t trimCount = 0;
+
+    /** Only the size classes that have ever been used. */
+    std::vector<AlignedBufferPoolSizeClass> sizeClasses;
+};
+
+#define AlignedBufferPoolStatistics_Fields \
+    (usedBytes)(maxUsedBytes)(cachedBytes)(maxCachedBytes)(trimCount)(sizeClasses)
+
+NX_REFLECTION_INSTRUMENT(AlignedBufferPoolStatistics, AlignedBufferPoolStatistics_Fields)
+
+/**
+ * Caches freed aligned memory blocks to give them out again instead of calling malloc/free.
+ * Designed for the media frame payloads (nx::utils::ByteArray) which are allocated and freed
+ * thousands times per second by different threads.
+ *
+ * The requested size is rounded up to one of the size classes: four classes per power of two
+ * from kMinBlockSize to kMaxBlockSize, so not more than 25% of a block is wasted. Each thread
+ * keeps a few free blocks of each class, so most of the calls do not lock anything. Thread caches
+ * overflow to and refill from the shared lists.
+ *
+ * The total size of the cached blocks is limited by maxCachedBytes. The blocks beyond the limit
+ * are freed immediately. trim() frees the cached blocks on demand, e.g., under memory pressure.
+ * It is also called automatically if the system fails to allocate memory.
+ *
+ * Larger blocks and the blocks with an alignment greater than kAlignment are not pooled.
+ */
+class NX_UTILS_API AlignedBufferPool
+{
+public:
+    static constexpr std::size_t kAlignment = 64;
+    static constexpr std::size_t kMinBlockSize = 256;
+    static constexpr std::size_t kMaxBlockSize = 16 * 1024 * 1024;
+
+    /**
+     * @param maxCachedBytes 0 disables pooling: the blocks are allocated and freed directly.
+     */
+    AlignedBufferPool(std::size_t maxCachedBytes);
+    ~AlignedBufferPool();
+
+    AlignedBufferPool(const AlignedBufferPool&) = delete;
+    AlignedBufferPool& operator=(const AlignedBufferPool&) = delete;
+
+    /**
+     * @return nullptr if the memory could not be allocated.
+     */
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    /**
+     * @param size, alignment MUST be the same as passed to allocate().
+     */
+    void deallocate(void* ptr, std::size_t size, std::size_t alignment);
+
+    /**
+     * Frees the cached blocks until the cached size is not greater than maxCachedBytes. The
+     * thread caches are freed completely on the next call of the corresponding thread.
+     */
+    void trim(std::size_t maxCachedBytes = 0);
+
+    AlignedBufferPoolStatistics statistics() const;
+
+    /**
+     * @return The size of the block allocated for the given size. 0 if the size is not pooled.
+     */
+    static std::size_t blockSize(std::size_t size);
+
+    /**
+     * The pool used by nx::utils::ByteArray. Its cache limit is set in nx_utils.ini.
+     */
+    static AlignedBufferPool& instance();
+
+private:
+    class Central;
+    class ThreadCache;
+
+    bool isPooled(std::size_t size, std::size_t alignment) const;
+    /**
+     * @return nullptr if the thread is exiting and its caches are not available anymore.
+     */
+    ThreadCache* threadCache();
+
+private:
+    std::shared_ptr<Central> m_central;
+};
+
+} // namespace nx::utils::memory
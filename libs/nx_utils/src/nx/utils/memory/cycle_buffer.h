@@ -6,6 +6,7 @@
 
 /**
  * Fixed size cyclic buffer implementation.
+ * Not thread-safe. See QnMediaSpscCyclicBuffer for passing data between two threads without locks.
  */
 class NX_UTILS_API QnMediaCyclicBuffer
 {
@@ -0,0 +1,130 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "spsc_cycle_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <nx/kit/utils.h>
+#include <nx/utils/log/assert.h>
+
+QnMediaSpscCyclicBuffer::QnMediaSpscCyclicBuffer(size_type bufferSize, int align):
+    m_buffer((value_type*) nx::kit::utils::mallocAligned(bufferSize, align)),
+    m_maxSize(bufferSize)
+{
+    NX_CRITICAL(bufferSize > 0);
+    NX_CRITICAL(m_buffer, "Failed to allocate buffer (size: %1, align: %2)", bufferSize, align);
+}
+
+QnMediaSpscCyclicBuffer::~QnMediaSpscCyclicBuffer()
+{
+    nx::kit::utils::freeAligned(m_buffer);
+}
+
+std::span<QnMediaSpscCyclicBuffer::value_type> QnMediaSpscCyclicBuffer::reserve()
+{
+    const auto writePosition = m_producer.position.load(std::memory_order_relaxed);
+    const auto index = writePosition % m_maxSize;
+    const auto tailSize = m_maxSize - index;
+
+    auto freeSize = m_maxSize - (writePosition - m_producer.otherSidePosition);
+    if (freeSize < tailSize)
+    {
+        m_producer.otherSidePosition = m_consumer.position.load(std::memory_order_acquire);
+        freeSize = m_maxSize - (writePosition - m_producer.otherSidePosition);
+    }
+
+    return {m_buffer + index, std::min(freeSize, tailSize)};
+}
+
+void QnMediaSpscCyclicBuffer::commit(size_type size)
+{
+    const auto writePosition = m_producer.position.load(std::memory_order_relaxed);
+    NX_ASSERT(size <= m_maxSize - writePosition % m_maxSize
+        && writePosition + size - m_producer.otherSidePosition <= m_maxSize,
+        "Committing more than reserved: %1", size);
+
+    m_producer.position.store(writePosition + size, std::memory_order_release);
+}
+
+QnMediaSpscCyclicBuffer::size_type QnMediaSpscCyclicBuffer::push_back(
+    const value_type* data, size_type size)
+{
+    size_type written = 0;
+    while (written < size)
+    {
+        const auto span = reserve();
+        if (span.empty())
+            break;
+
+        const auto bytesToWrite = std::min(span.size(), size - written);
+        memcpy(span.data(), data + written, bytesToWrite);
+        commit(bytesToWrite);
+        written += bytesToWrite;
+    }
+
+    return written;
+}
+
+QnMediaSpscCyclicBuffer::size_type QnMediaSpscCyclicBuffer::freeSize() const
+{
+    return m_maxSize - (m_producer.position.load(std::memory_order_relaxed)
+        - m_consumer.position.load(std::memory_order_acquire));
+}
+
+std::span<const QnMediaSpscCyclicBuffer::value_type> QnMediaSpscCyclicBuffer::readableData() const
+{
+    return fragmentedData()[0];
+}
+
+std::array<std::span<const QnMediaSpscCyclicBuffer::value_type>, 2>
+    QnMediaSpscCyclicBuffer::fragmentedData() const
+{
+    const auto readPosition = m_consumer.position.load(std::memory_order_relaxed);
+    const auto index = readPosition % m_maxSize;
+    const auto tailSize = m_maxSize - index;
+
+    auto dataSize = m_consumer.otherSidePosition - readPosition;
+    if (dataSize < tailSize)
+    {
+        m_consumer.otherSidePosition = m_producer.position.load(std::memory_order_acquire);
+        dataSize = m_consumer.otherSidePosition - readPosition;
+    }
+
+    const auto frontSize = std::min(dataSize, tailSize);
+    return {
+        std::span<const value_type>(m_buffer + index, frontSize),
+        std::span<const value_type>(m_buffer, dataSize - frontSize)};
+}
+
+void QnMediaSpscCyclicBuffer::pop_front(size_type size)
+{
+    const auto readPosition = m_consumer.position.load(std::memory_order_relaxed);
+    if (readPosition + size > m_consumer.otherSidePosition)
+        m_consumer.otherSidePosition = m_producer.position.load(std::memory_order_acquire);
+    NX_ASSERT(readPosition + size <= m_consumer.otherSidePosition,
+        "Releasing more than available: %1", size);
+
+    m_consumer.position.store(readPosition + size, std::memory_order_release);
+}
+
+QnMediaSpscCyclicBuffer::size_type QnMediaSpscCyclicBuffer::read(
+    value_type* dest, size_type size)
+{
+    size_type bytesRead = 0;
+    for (const auto& span: fragmentedData())
+    {
+        const auto bytesToRead = std::min(span.size(), size - bytesRead);
+        memcpy(dest + bytesRead, span.data(), bytesToRead);
+        bytesRead += bytesToRead;
+    }
+
+    pop_front(bytesRead);
+    return bytesRead;
+}
+
+QnMediaSpscCyclicBuffer::size_type QnMediaSpscCyclicBuffer::size() const
+{
+    return m_producer.position.load(std::memory_order_acquire)
+        - m_consumer.position.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,102 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+/**
+ * Fixed size cyclic buffer for passing a byte stream from one thread to another without locks.
+ *
+ * Lock-free variant of QnMediaCyclicBuffer for exactly one producer thread and exactly one
+ * consumer thread. The producer writes directly into the buffer: reserve() gives a contiguous
+ * free span, commit() publishes the bytes written there. The consumer reads directly from the
+ * buffer: readableData() gives a contiguous span of the published data, pop_front() releases it.
+ * So the data is copied only by the producer itself, e.g., by reading from a socket right into
+ * the span.
+ *
+ * Producer methods: reserve(), commit(), push_back(), freeSize().
+ * Consumer methods: readableData(), fragmentedData(), pop_front(), read(), size().
+ * Calling a method from a wrong thread is undefined behavior. maxSize() can be called by anyone.
+ */
+class NX_UTILS_API QnMediaSpscCyclicBuffer
+{
+public:
+    using size_type = std::size_t;
+    using value_type = char;
+
+    /**
+     * @param align Memory align factor for internal buffer.
+     */
+    QnMediaSpscCyclicBuffer(size_type bufferSize, int align);
+    ~QnMediaSpscCyclicBuffer();
+
+    QnMediaSpscCyclicBuffer(const QnMediaSpscCyclicBuffer&) = delete;
+    QnMediaSpscCyclicBuffer& operator=(const QnMediaSpscCyclicBuffer&) = delete;
+
+    /**
+     * @return The largest contiguous free span. It can be smaller than freeSize() when the free
+     * space wraps around the buffer end: the rest is available after committing this span.
+     * Empty if the buffer is full.
+     */
+    std::span<value_type> reserve();
+
+    /**
+     * Publishes the first size bytes of the span returned by reserve() to the consumer.
+     */
+    void commit(size_type size);
+
+    /**
+     * Copies as much of the data as fits into the buffer.
+     * @return Number of bytes copied.
+     */
+    size_type push_back(const value_type* data, size_type size);
+
+    size_type freeSize() const;
+
+    /**
+     * @return The largest contiguous span of the published data. Empty if there is no data.
+     */
+    std::span<const value_type> readableData() const;
+
+    /**
+     * @return All published data: one or two spans (if the data wraps around the buffer end).
+     */
+    std::array<std::span<const value_type>, 2> fragmentedData() const;
+
+    /** Releases the first size bytes of the data to the producer. */
+    void pop_front(size_type size);
+
+    /**
+     * Copies up to size bytes to dest and releases them.
+     * @return Number of bytes copied.
+     */
+    size_type read(value_type* dest, size_type size);
+
+    /** @return Size of the published data. */
+    size_type size() const;
+
+    size_type maxSize() const { return m_maxSize; }
+
+private:
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    /**
+     * Positions grow monotonically and are never wrapped, so equal read and write positions mean
+     * "empty" and the difference of maxSize means "full".
+     * Each side keeps its own copy of the other side position, refreshing it only when the copy
+     * does not allow to proceed, so the cache line of the other side is read rarely.
+     */
+    struct alignas(kCacheLineSize) Side
+    {
+        std::atomic<size_type> position{0};
+        size_type otherSidePosition = 0;
+    };
+
+    value_type* const m_buffer;
+    const size_type m_maxSize;
+    Side m_producer;
+    mutable Side m_consumer;
+};
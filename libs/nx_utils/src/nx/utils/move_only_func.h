@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 #include <nx/utils/log/assert.h>
 
@@ -11,99 +14,131 @@ namespace nx {
 namespace utils {
 
 /**
- * Move-only analogue of std::function.
- * Can be used to store lambda which has std::unique_ptr as its capture.
+ * Size of the buffer MoveOnlyFunc stores the callable in without allocating memory. Enough for
+ * a lambda that captures a pointer and a few more pointers or integers (e.g., `this`, a buffer
+ * pointer and an error code).
  */
-template<class F>
-class MoveOnlyFunc:
-    private std::function<F>
-{
-    using base_type = std::function<F>;
+static constexpr std::size_t kMoveOnlyFuncDefaultBufferSize = 48;
 
-    template<class Func>
-    class MoveOnlyFuncWrapper
-    {
-    private:
-        Func m_func;
+template<class F, std::size_t BufferSize = kMoveOnlyFuncDefaultBufferSize>
+class MoveOnlyFunc;
 
-    public:
-        MoveOnlyFuncWrapper(Func p):
-            m_func(std::move(p))
-        {
-        }
+namespace detail {
 
-        MoveOnlyFuncWrapper(const MoveOnlyFuncWrapper& rhs):
-            m_func(std::move(const_cast<MoveOnlyFuncWrapper&>(rhs).m_func))
-        {
-            NX_ASSERT(false);
-        }
+template<typename T>
+struct IsMoveOnlyFunc: std::false_type {};
 
-        MoveOnlyFuncWrapper& operator=(const MoveOnlyFuncWrapper&)
-        {
-            NX_ASSERT(false);
-            return *this;
-        }
+template<typename F, std::size_t BufferSize>
+struct IsMoveOnlyFunc<MoveOnlyFunc<F, BufferSize>>: std::true_type {};
 
-        MoveOnlyFuncWrapper(MoveOnlyFuncWrapper&& rhs) noexcept(
-            std::is_nothrow_move_constructible_v<Func>)
-            :
-            m_func(std::move(rhs.m_func))
-        {
-        }
+template<typename T>
+struct IsStdFunction: std::false_type {};
 
-        MoveOnlyFuncWrapper& operator=(MoveOnlyFuncWrapper&& rhs)
-        {
-            if (&rhs == this)
-                return *this;
-            m_func = std::move(rhs.m_func);
-            return *this;
-        }
+template<typename F>
+struct IsStdFunction<std::function<F>>: std::true_type {};
 
-        template<class... Args>
-        auto operator() (Args&&... args)
-            -> decltype(m_func(std::forward<Args>(args)...))
-        {
-            return m_func(std::forward<Args>(args)...);
-        }
-    };
+/**
+ * @return true for the callables that std::function considers empty: null pointers and empty
+ * function objects.
+ */
+template<typename Func>
+bool isNullCallable(const Func& func)
+{
+    if constexpr (std::is_pointer_v<Func> || std::is_member_pointer_v<Func>)
+        return func == nullptr;
+    else if constexpr (IsStdFunction<Func>::value || IsMoveOnlyFunc<Func>::value)
+        return !func;
+    else
+        return false;
+}
+
+} // namespace detail
 
+/**
+ * Move-only analogue of std::function.
+ * Can be used to store lambda which has std::unique_ptr as its capture.
+ *
+ * A callable that fits into BufferSize bytes and is nothrow-move-constructible is stored inside
+ * the object, so no memory is allocated. That is the case for the most of AIO completion
+ * handlers. Larger callables are allocated on the heap once and are never copied after that.
+ */
+template<class R, class... Args, std::size_t BufferSize>
+class MoveOnlyFunc<R(Args...), BufferSize>
+{
 public:
-    using result_type = typename std::function<F>::result_type;
+    using result_type = R;
 
     MoveOnlyFunc() = default;
 
-    MoveOnlyFunc(std::function<F> func):
-        std::function<F>(std::move(func))
+    MoveOnlyFunc(std::nullptr_t)
     {
     }
 
-    MoveOnlyFunc(std::nullptr_t val):
-        std::function<F>(val)
+    template<
+        class Func,
+        typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<Func>, MoveOnlyFunc>
+            && std::is_invocable_r_v<R, std::decay_t<Func>&, Args...>>
+    >
+    MoveOnlyFunc(Func&& func)
     {
+        using Callable = std::decay_t<Func>;
+
+        if (detail::isNullCallable(func))
+            return;
+
+        if constexpr (isStoredInline<Callable>())
+            ::new (static_cast<void*>(m_storage)) Callable(std::forward<Func>(func));
+        else
+            *reinterpret_cast<Callable**>(m_storage) = new Callable(std::forward<Func>(func));
+
+        m_operations = &kOperations<Callable>;
+    }
+
+    MoveOnlyFunc(MoveOnlyFunc&& other) noexcept
+    {
+        moveFrom(&other);
+    }
+
+    MoveOnlyFunc& operator=(MoveOnlyFunc&& other) noexcept
+    {
+        if (&other == this)
+            return *this;
+
+        reset();
+        moveFrom(&other);
+        return *this;
     }
 
-    MoveOnlyFunc(MoveOnlyFunc&&) = default;
-    MoveOnlyFunc& operator=(MoveOnlyFunc&&) = default;
     MoveOnlyFunc(const MoveOnlyFunc&) = delete;
     MoveOnlyFunc& operator=(const MoveOnlyFunc&) = delete;
 
-    template<class _Func>
-    MoveOnlyFunc(_Func func):
-        std::function<F>(MoveOnlyFuncWrapper<_Func>(std::move(func)))
+    ~MoveOnlyFunc()
     {
+        reset();
     }
 
-    MoveOnlyFunc& operator=(std::nullptr_t val)
+    MoveOnlyFunc& operator=(std::nullptr_t)
     {
-        std::function<F>::operator=(val);
+        reset();
         return *this;
     }
 
-    using base_type::operator();
+    /**
+     * Same as std::function, the stored callable is invoked as a non-const object.
+     * @throw std::bad_function_call if empty.
+     */
+    R operator()(Args... args) const
+    {
+        if (!m_operations)
+            throw std::bad_function_call();
+
+        return m_operations->invoke(storage(), std::forward<Args>(args)...);
+    }
 
     bool operator==(std::nullptr_t) const
     {
-        return static_cast<const base_type&>(*this) == nullptr;
+        return m_operations == nullptr;
     }
 
     bool operator!=(std::nullptr_t) const
@@ -113,10 +148,119 @@ public:
 
     void swap(MoveOnlyFunc& other)
     {
-        base_type::swap(static_cast<base_type&>(other));
+        MoveOnlyFunc tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    explicit operator bool() const
+    {
+        return m_operations != nullptr;
+    }
+
+    /**
+     * @return true if Callable is stored without allocating memory.
+     */
+    template<typename Callable>
+    static constexpr bool isStoredInline()
+    {
+        return sizeof(Callable) <= BufferSize
+            && alignof(Callable) <= kStorageAlignment
+            && std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+private:
+    struct Operations
+    {
+        R (*invoke)(void* storage, Args&&... args);
+
+        /** Move-constructs the callable into the destination storage and destroys the source. */
+        void (*relocate)(void* source, void* destination) noexcept;
+
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    /**
+     * Not alignof(std::max_align_t), so the whole object is not padded to 16 bytes. Callables
+     * with the larger alignment requirement are just allocated.
+     */
+    static constexpr std::size_t kStorageAlignment =
+        alignof(void*) < alignof(double) ? alignof(double) : alignof(void*);
+
+    static constexpr std::size_t kStorageSize =
+        BufferSize < sizeof(void*) ? sizeof(void*) : BufferSize;
+
+    template<typename Callable>
+    static Callable* callable(void* storage)
+    {
+        if constexpr (isStoredInline<Callable>())
+            return std::launder(reinterpret_cast<Callable*>(storage));
+        else
+            return *reinterpret_cast<Callable**>(storage);
+    }
+
+    template<typename Callable>
+    static R invoke(void* storage, Args&&... args)
+    {
+        if constexpr (std::is_void_v<R>)
+            std::invoke(*callable<Callable>(storage), std::forward<Args>(args)...);
+        else
+            return std::invoke(*callable<Callable>(storage), std::forward<Args>(args)...);
+    }
+
+    template<typename Callable>
+    static void relocate(void* source, void* destination) noexcept
+    {
+        if constexpr (isStoredInline<Callable>())
+        {
+            auto sourceCallable = callable<Callable>(source);
+            ::new (destination) Callable(std::move(*sourceCallable));
+            sourceCallable->~Callable();
+        }
+        else
+        {
+            *reinterpret_cast<Callable**>(destination) = callable<Callable>(source);
+        }
+    }
+
+    template<typename Callable>
+    static void destroy(void* storage) noexcept
+    {
+        if constexpr (isStoredInline<Callable>())
+            callable<Callable>(storage)->~Callable();
+        else
+            delete callable<Callable>(storage);
+    }
+
+    template<typename Callable>
+    static constexpr Operations kOperations{
+        &MoveOnlyFunc::invoke<Callable>,
+        &MoveOnlyFunc::relocate<Callable>,
+        &MoveOnlyFunc::destroy<Callable>};
+
+    void* storage() const
+    {
+        return const_cast<void*>(static_cast<const void*>(m_storage));
+    }
+
+    void moveFrom(MoveOnlyFunc* other) noexcept
+    {
+        if (!other->m_operations)
+            return;
+
+        other->m_operations->relocate(other->storage(), storage());
+        m_operations = std::exchange(other->m_operations, nullptr);
+    }
+
+    void reset() noexcept
+    {
+        if (m_operations)
+            std::exchange(m_operations, nullptr)->destroy(storage());
     }
 
-    using std::function<F>::operator bool;
+private:
+    alignas(kStorageAlignment) std::byte m_storage[kStorageSize];
+    const Operations* m_operations = nullptr;
 };
 
 template<typename Function, typename ... Args>
@@ -34,7 +34,17 @@ struct NX_UTILS_API Ini: nx::kit::IniConfig
         "qt - fastest, default for release;\n"
         "std - average speed, useful for valgrind;\n"
         "debug - average speed, provides more info for debugger, default for debug;\n"
-        "analyze - very slow, analyses mutexes for deadlocks.");
+        "analyze - very slow, analyses mutexes for deadlocks;\n"
+        "profile - almost as fast as qt, samples lock wait and hold times per lock call site.");
+
+    NX_INI_INT(64, mutexProfileSamplingPeriod,
+        "With mutexImplementation=profile, one of this many lock calls of each thread is\n"
+        "measured.");
+
+    NX_INI_INT(32, alignedBufferPoolMaxCachedMb,
+        "Maximum size of the free media buffers (nx::utils::ByteArray) kept for reuse, in MB.\n"
+        "The default suits the clients and the ARM devices; a server with many cameras may\n"
+        "need more. If 0, the buffers are allocated and freed directly.");
 
     NX_INI_FLAG(kDefaultAssertCrash, assertCrash,
         "Crash application on assertion failure.");
@@ -26,6 +26,8 @@ const char* serializationFormatToHttpContentType(SerializationFormat format)
             return "application/x-url-query";
         case SerializationFormat::urlEncoded:
             return "application/x-www-form-urlencoded";
+        case SerializationFormat::compactBinary:
+            return "application/x-nx-compact-binary";
         default:
             NX_ASSERT(false, "Value: %1", static_cast<int>(format));
             return "unsupported";
@@ -35,6 +37,9 @@ const char* serializationFormatToHttpContentType(SerializationFormat format)
 SerializationFormat serializationFormatFromHttpContentType(
     const std::string_view& httpContentType)
 {
+    // Checked first: the clients supporting it list JSON as a fallback.
+    if (nx::utils::contains(httpContentType, "application/x-nx-compact-binary"))
+        return SerializationFormat::compactBinary;
     if (nx::utils::contains(httpContentType, "application/json") || nx::utils::contains(httpContentType, "*/*"))
         return SerializationFormat::json;
     if (nx::utils::contains(httpContentType, "application/ubjson"))
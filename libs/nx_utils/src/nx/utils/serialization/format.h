@@ -36,6 +36,12 @@ enum class SerializationFormat: int
      */
     urlEncoded = 7,
 
+    /**%apidoc
+     * Compact binary format of nx_reflect: field ids, varints and the string table.
+     * %caption compactbinary
+     */
+    compactBinary = 8,
+
     /**%apidoc[unused] */
     unsupported = -1
 };
@@ -51,7 +57,8 @@ constexpr auto nxReflectVisitAllEnumItems(SerializationFormat*, Visitor&& visito
         Item{SerializationFormat::xml, "xml"},
         Item{SerializationFormat::compressedPeriods, "periods"},
         Item{SerializationFormat::urlQuery, "urlquery"},
-        Item{SerializationFormat::urlEncoded, "urlencoded"}
+        Item{SerializationFormat::urlEncoded, "urlencoded"},
+        Item{SerializationFormat::compactBinary, "compactbinary"}
     );
 }
 
@@ -0,0 +1,333 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "shared_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace nx {
+
+SharedBuffer::SharedBuffer(nx::Buffer buffer):
+    SharedBuffer(std::make_shared<nx::Buffer>(std::move(buffer)))
+{
+}
+
+SharedBuffer::SharedBuffer(std::shared_ptr<nx::Buffer> buffer):
+    m_buffer(std::move(buffer)),
+    m_size(m_buffer ? m_buffer->size() : 0)
+{
+}
+
+const char* SharedBuffer::data() const
+{
+    return m_buffer ? m_buffer->data() + m_offset : nullptr;
+}
+
+std::size_t SharedBuffer::size() const
+{
+    return m_size;
+}
+
+bool SharedBuffer::empty() const
+{
+    return m_size == 0;
+}
+
+char SharedBuffer::operator[](std::size_t pos) const
+{
+    NX_ASSERT(pos < m_size, "pos: %1, size: %2", pos, m_size);
+    return data()[pos];
+}
+
+std::string_view SharedBuffer::view() const
+{
+    return std::string_view(data(), m_size);
+}
+
+SharedBuffer SharedBuffer::subBuffer(std::size_t pos, std::size_t count) const
+{
+    pos = std::min(pos, m_size);
+
+    SharedBuffer result;
+    result.m_buffer = m_buffer;
+    result.m_offset = m_offset + pos;
+    result.m_size = std::min(count, m_size - pos);
+    return result;
+}
+
+void SharedBuffer::removePrefix(std::size_t count)
+{
+    count = std::min(count, m_size);
+    m_offset += count;
+    m_size -= count;
+}
+
+void SharedBuffer::removeSuffix(std::size_t count)
+{
+    m_size -= std::min(count, m_size);
+}
+
+nx::Buffer SharedBuffer::toBuffer() const
+{
+    if (m_size == 0)
+        return nx::Buffer();
+
+    return nx::Buffer(data(), m_size);
+}
+
+nx::Buffer SharedBuffer::takeBuffer()
+{
+    nx::Buffer result;
+    if (m_buffer && m_buffer.use_count() == 1 && m_offset == 0 && m_size == m_buffer->size())
+        result = std::move(*m_buffer);
+    else
+        result = toBuffer();
+
+    *this = SharedBuffer();
+    return result;
+}
+
+long SharedBuffer::useCount() const
+{
+    return m_buffer.use_count();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+BufferChain::BufferChain(SharedBuffer slice)
+{
+    append(std::move(slice));
+}
+
+void BufferChain::append(SharedBuffer slice)
+{
+    if (slice.empty())
+        return;
+
+    m_size += slice.size();
+    m_slices.push_back(std::move(slice));
+}
+
+void BufferChain::append(nx::Buffer buffer)
+{
+    append(SharedBuffer(std::move(buffer)));
+}
+
+void BufferChain::append(const BufferChain& chain)
+{
+    for (const auto& slice: chain.m_slices)
+        append(slice);
+}
+
+std::size_t BufferChain::size() const
+{
+    return m_size;
+}
+
+bool BufferChain::empty() const
+{
+    return m_size == 0;
+}
+
+std::size_t BufferChain::sliceCount() const
+{
+    return m_slices.size();
+}
+
+BufferChain::const_iterator BufferChain::begin() const
+{
+    return m_slices.begin();
+}
+
+BufferChain::const_iterator BufferChain::end() const
+{
+    return m_slices.end();
+}
+
+char BufferChain::operator[](std::size_t pos) const
+{
+    NX_ASSERT(pos < m_size, "pos: %1, size: %2", pos, m_size);
+
+    const auto [sliceIndex, offset] = locate(pos);
+    return m_slices[sliceIndex][offset];
+}
+
+std::size_t BufferChain::find(std::string_view str, std::size_t pos) const
+{
+    if (pos > m_size)
+        return npos;
+
+    if (str.empty())
+        return pos;
+
+    std::size_t sliceStart = 0;
+    for (std::size_t i = 0; i < m_slices.size(); ++i)
+    {
+        const auto view = m_slices[i].view();
+        const auto sliceEnd = sliceStart + view.size();
+        if (sliceEnd <= pos)
+        {
+            sliceStart = sliceEnd;
+            continue;
+        }
+
+        const std::size_t from = pos > sliceStart ? pos - sliceStart : 0;
+
+        // A match inside the slice starts before any match that spans the next slices.
+        if (const auto found = view.find(str, from); found != std::string_view::npos)
+            return sliceStart + found;
+
+        const std::size_t firstSpanningOffset =
+            view.size() >= str.size() ? view.size() - str.size() + 1 : 0;
+        for (std::size_t offset = std::max(from, firstSpanningOffset);
+            offset < view.size();
+            ++offset)
+        {
+            if (matchesAt(i, offset, str))
+                return sliceStart + offset;
+        }
+
+        sliceStart = sliceEnd;
+    }
+
+    return npos;
+}
+
+BufferChain BufferChain::subChain(std::size_t pos, std::size_t count) const
+{
+    BufferChain result;
+    if (pos >= m_size)
+        return result;
+
+    count = std::min(count, m_size - pos);
+    auto [sliceIndex, offset] = locate(pos);
+    for (; count > 0; ++sliceIndex, offset = 0)
+    {
+        auto slice = m_slices[sliceIndex].subBuffer(offset, count);
+        count -= slice.size();
+        result.append(std::move(slice));
+    }
+
+    return result;
+}
+
+SharedBuffer BufferChain::takeFront(std::size_t count)
+{
+    count = std::min(count, m_size);
+    if (count == 0)
+        return SharedBuffer();
+
+    SharedBuffer result;
+    if (m_slices.front().size() >= count)
+    {
+        result = m_slices.front().subBuffer(0, count);
+    }
+    else
+    {
+        nx::Buffer buffer(count, '\0');
+        copyTo(buffer.data(), 0, count);
+        result = SharedBuffer(std::move(buffer));
+    }
+
+    removePrefix(count);
+    return result;
+}
+
+void BufferChain::removePrefix(std::size_t count)
+{
+    count = std::min(count, m_size);
+    m_size -= count;
+
+    while (count > 0)
+    {
+        auto& front = m_slices.front();
+        if (front.size() > count)
+        {
+            front.removePrefix(count);
+            return;
+        }
+
+        count -= front.size();
+        m_slices.pop_front();
+    }
+}
+
+void BufferChain::clear()
+{
+    m_slices.clear();
+    m_size = 0;
+}
+
+std::size_t BufferChain::copyTo(char* dest, std::size_t pos, std::size_t count) const
+{
+    if (pos >= m_size)
+        return 0;
+
+    count = std::min(count, m_size - pos);
+    std::size_t copied = 0;
+    for (auto [sliceIndex, offset] = locate(pos); copied < count; ++sliceIndex, offset = 0)
+    {
+        const auto& slice = m_slices[sliceIndex];
+        const auto bytesToCopy = std::min(slice.size() - offset, count - copied);
+        memcpy(dest + copied, slice.data() + offset, bytesToCopy);
+        copied += bytesToCopy;
+    }
+
+    return copied;
+}
+
+nx::Buffer BufferChain::toBuffer() const
+{
+    if (m_slices.size() == 1)
+        return m_slices.front().toBuffer();
+
+    nx::Buffer result;
+    result.reserve(m_size);
+    for (const auto& slice: m_slices)
+        result.append(slice.data(), slice.size());
+    return result;
+}
+
+std::vector<std::string_view> BufferChain::views() const
+{
+    std::vector<std::string_view> result;
+    result.reserve(m_slices.size());
+    for (const auto& slice: m_slices)
+        result.push_back(slice.view());
+    return result;
+}
+
+std::pair<std::size_t, std::size_t> BufferChain::locate(std::size_t pos) const
+{
+    std::size_t sliceIndex = 0;
+    while (pos >= m_slices[sliceIndex].size())
+    {
+        pos -= m_slices[sliceIndex].size();
+        ++sliceIndex;
+    }
+
+    return {sliceIndex, pos};
+}
+
+bool BufferChain::matchesAt(
+    std::size_t sliceIndex, std::size_t offset, std::string_view str) const
+{
+    while (!str.empty())
+    {
+        if (sliceIndex == m_slices.size())
+            return false;
+
+        const auto view = m_slices[sliceIndex].view().substr(offset);
+        const auto length = std::min(view.size(), str.size());
+        if (view.substr(0, length) != str.substr(0, length))
+            return false;
+
+        str.remove_prefix(length);
+        ++sliceIndex;
+        offset = 0;
+    }
+
+    return true;
+}
+
+} // namespace nx
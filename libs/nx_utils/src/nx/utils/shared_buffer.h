@@ -0,0 +1,166 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "buffer.h"
+
+namespace nx {
+
+/**
+ * Read-only slice of a reference-counted nx::Buffer.
+ * Copying the slice or taking a subBuffer() of it only increments the reference counter, the
+ * data is never copied. The underlying buffer is freed when the last slice referencing it is gone.
+ * NOTE: Copying is thread-safe as much as copying std::shared_ptr is.
+ */
+class NX_UTILS_API SharedBuffer
+{
+public:
+    static constexpr std::size_t npos = std::string_view::npos;
+
+    SharedBuffer() = default;
+
+    /**
+     * Takes the buffer without copying its data.
+     */
+    explicit SharedBuffer(nx::Buffer buffer);
+
+    explicit SharedBuffer(std::shared_ptr<nx::Buffer> buffer);
+
+    const char* data() const;
+    std::size_t size() const;
+    bool empty() const;
+
+    char operator[](std::size_t pos) const;
+
+    std::string_view view() const;
+
+    /**
+     * @return Slice referencing the same buffer. O(1).
+     */
+    SharedBuffer subBuffer(std::size_t pos, std::size_t count = npos) const;
+
+    void removePrefix(std::size_t count);
+    void removeSuffix(std::size_t count);
+
+    /**
+     * @return Copy of the slice data.
+     */
+    nx::Buffer toBuffer() const;
+
+    /**
+     * Moves the underlying buffer out if this is the only slice and it covers the whole buffer.
+     * Otherwise, copies the slice data. The slice is empty after the call.
+     */
+    nx::Buffer takeBuffer();
+
+    /**
+     * @return Number of the slices that reference the underlying buffer.
+     */
+    long useCount() const;
+
+    bool operator==(const SharedBuffer& right) const { return view() == right.view(); }
+
+private:
+    std::shared_ptr<nx::Buffer> m_buffer;
+    std::size_t m_offset = 0;
+    std::size_t m_size = 0;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Rope of SharedBuffer slices. Represents their concatenation without joining them, so data
+ * received in multiple chunks can be parsed and passed further without copying.
+ * Taking a part of the chain does not copy the data either.
+ */
+class NX_UTILS_API BufferChain
+{
+public:
+    using Slices = std::deque<SharedBuffer>;
+    using const_iterator = Slices::const_iterator;
+
+    static constexpr std::size_t npos = std::string_view::npos;
+
+    BufferChain() = default;
+    explicit BufferChain(SharedBuffer slice);
+
+    /**
+     * Empty slices are skipped.
+     */
+    void append(SharedBuffer slice);
+    void append(nx::Buffer buffer);
+    void append(const BufferChain& chain);
+
+    /**
+     * @return The total number of bytes in all slices.
+     */
+    std::size_t size() const;
+    bool empty() const;
+
+    std::size_t sliceCount() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * O(number of slices).
+     */
+    char operator[](std::size_t pos) const;
+
+    /**
+     * Finds the string in the chain. The string may span several slices.
+     * @return Position of the first match starting from pos or npos.
+     */
+    std::size_t find(std::string_view str, std::size_t pos = 0) const;
+
+    /**
+     * @return Chain referencing the same buffers.
+     */
+    BufferChain subChain(std::size_t pos, std::size_t count = npos) const;
+
+    /**
+     * Removes the first count bytes from the chain and returns them.
+     * The data is copied only if it spans several slices.
+     */
+    SharedBuffer takeFront(std::size_t count);
+
+    void removePrefix(std::size_t count);
+
+    void clear();
+
+    /**
+     * Copies up to count bytes starting from pos to dest.
+     * @return Number of bytes copied.
+     */
+    std::size_t copyTo(char* dest, std::size_t pos = 0, std::size_t count = npos) const;
+
+    /**
+     * @return Copy of the chain data as a single buffer.
+     */
+    nx::Buffer toBuffer() const;
+
+    /**
+     * @return The slices as views. They are valid while the chain (or the slices) are alive.
+     * Can be passed to a gathering send call.
+     */
+    std::vector<std::string_view> views() const;
+
+private:
+    /**
+     * @return Index of the slice that contains the byte at pos and the position in that slice.
+     */
+    std::pair<std::size_t, std::size_t> locate(std::size_t pos) const;
+
+    bool matchesAt(std::size_t sliceIndex, std::size_t offset, std::string_view str) const;
+
+private:
+    Slices m_slices;
+    std::size_t m_size = 0;
+};
+
+} // namespace nx
@@ -2,8 +2,18 @@
 
 #include "std_string_utils.h"
 
+#include <cstdint>
+
 #include <QtCore/QByteArray>
 
+#include "cpu_features.h"
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+    #include <immintrin.h>
+#elif defined(NX_NEON_SUPPORTED)
+    #include <arm_neon.h>
+#endif
+
 namespace nx::utils {
 
 int stricmp(const std::string_view& left, const std::string_view& right)
@@ -18,4 +28,230 @@ int stricmp(const std::string_view& left, const std::string_view& right)
     return left.size() < right.size() ? -1 : 1;
 }
 
+//-------------------------------------------------------------------------------------------------
+// Hex.
+
+namespace {
+
+static constexpr char kHexDigits[] = "0123456789abcdef";
+
+int hexDigitValue(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+    if (ch >= 'a' && ch <= 'f')
+        return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F')
+        return ch - 'A' + 10;
+    return -1;
+}
+
+void encodeHexScalar(const std::uint8_t* data, std::size_t size, char* out)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        *out++ = kHexDigits[data[i] >> 4];
+        *out++ = kHexDigits[data[i] & 0x0f];
+    }
+}
+
+/**
+ * Decodes digit pairs. The same as the parsing below if the input has an even number of
+ * characters and all of them are hex digits.
+ * @return false if a non-digit character is met.
+ */
+bool decodeHexScalar(const char* data, std::size_t size, std::uint8_t* out)
+{
+    for (std::size_t i = 0; i < size; i += 2)
+    {
+        const int high = hexDigitValue(data[i]);
+        const int low = hexDigitValue(data[i + 1]);
+        if (high < 0 || low < 0)
+            return false;
+        *out++ = (std::uint8_t) ((high << 4) | low);
+    }
+    return true;
+}
+
+#if defined(NX_AVX2_CODE_SUPPORTED)
+
+/**
+ * @return Number of bytes encoded.
+ */
+NX_TARGET_AVX2 std::size_t encodeHexAvx2(const std::uint8_t* data, std::size_t size, char* out)
+{
+    const __m256i digits = _mm256_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+
+    std::size_t i = 0;
+    for (; size - i >= 16; i += 16)
+    {
+        // Every byte is expanded to a word: the high nibble to the first byte, the low nibble
+        // to the second one.
+        const __m256i words =
+            _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (data + i)));
+        const __m256i nibbles = _mm256_or_si256(
+            _mm256_srli_epi16(words, 4),
+            _mm256_slli_epi16(_mm256_and_si256(words, _mm256_set1_epi16(0x0f)), 8));
+        _mm256_storeu_si256(
+            (__m256i*) (out + i * 2), _mm256_shuffle_epi8(digits, nibbles));
+    }
+
+    return i;
+}
+
+/**
+ * @return Number of characters decoded or -1 if a non-digit character is met.
+ */
+NX_TARGET_AVX2 std::ptrdiff_t decodeHexAvx2(const char* data, std::size_t size, std::uint8_t* out)
+{
+    std::size_t i = 0;
+    for (; size - i >= 32; i += 32)
+    {
+        const __m256i chars = _mm256_loadu_si256((const __m256i*) (data + i));
+        const __m256i lowerCase = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+        const __m256i isDigit = _mm256_and_si256(
+            _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+        const __m256i isLetter = _mm256_and_si256(
+            _mm256_cmpgt_epi8(lowerCase, _mm256_set1_epi8('a' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lowerCase));
+        if (_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) != -1)
+            return -1;
+
+        const __m256i values = _mm256_blendv_epi8(
+            _mm256_sub_epi8(lowerCase, _mm256_set1_epi8('a' - 10)),
+            _mm256_sub_epi8(chars, _mm256_set1_epi8('0')),
+            isDigit);
+        // high * 16 + low in every word.
+        const __m256i words = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+        const __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), 0x08);
+        _mm_storeu_si128((__m128i*) (out + i / 2), _mm256_castsi256_si128(bytes));
+    }
+
+    return (std::ptrdiff_t) i;
+}
+
+#elif defined(NX_NEON_SUPPORTED)
+
+std::size_t encodeHexNeon(const std::uint8_t* data, std::size_t size, char* out)
+{
+    const uint8x16_t digits = vld1q_u8((const std::uint8_t*) kHexDigits);
+
+    std::size_t i = 0;
+    for (; size - i >= 16; i += 16)
+    {
+        const uint8x16_t bytes = vld1q_u8(data + i);
+        uint8x16x2_t chars;
+        chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+        chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0f)));
+        vst2q_u8((std::uint8_t*) (out + i * 2), chars);
+    }
+
+    return i;
+}
+
+/** @return Digit values, 0xff in the mask for the non-digit characters. */
+uint8x16_t hexDigitValuesNeon(uint8x16_t chars, uint8x16_t* invalid)
+{
+    const uint8x16_t digitValues = vsubq_u8(chars, vdupq_n_u8('0'));
+    const uint8x16_t letterValues =
+        vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a' - 10));
+    const uint8x16_t isDigit = vcltq_u8(digitValues, vdupq_n_u8(10));
+    const uint8x16_t isLetter = vandq_u8(
+        vcgeq_u8(letterValues, vdupq_n_u8(10)), vcltq_u8(letterValues, vdupq_n_u8(16)));
+    *invalid = vorrq_u8(*invalid, vmvnq_u8(vorrq_u8(isDigit, isLetter)));
+    return vbslq_u8(isDigit, digitValues, letterValues);
+}
+
+std::ptrdiff_t decodeHexNeon(const char* data, std::size_t size, std::uint8_t* out)
+{
+    std::size_t i = 0;
+    for (; size - i >= 32; i += 32)
+    {
+        const uint8x16x2_t chars = vld2q_u8((const std::uint8_t*) (data + i));
+        uint8x16_t invalid = vdupq_n_u8(0);
+        const uint8x16_t high = hexDigitValuesNeon(chars.val[0], &invalid);
+        const uint8x16_t low = hexDigitValuesNeon(chars.val[1], &invalid);
+        if (vmaxvq_u8(invalid) != 0)
+            return -1;
+
+        vst1q_u8(out + i / 2, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+
+    return (std::ptrdiff_t) i;
+}
+
+#endif
+
+/**
+ * Fast path for the input of digit pairs only.
+ */
+bool decodeHexPairs(const char* data, std::size_t size, std::uint8_t* out)
+{
+    std::ptrdiff_t decoded = 0;
+
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (cpuSupportsAvx2())
+            decoded = decodeHexAvx2(data, size, out);
+    #elif defined(NX_NEON_SUPPORTED)
+        decoded = decodeHexNeon(data, size, out);
+    #endif
+
+    if (decoded < 0)
+        return false;
+
+    return decodeHexScalar(data + decoded, size - decoded, out + decoded / 2);
+}
+
+} // namespace
+
+namespace detail {
+
+void encodeHex(const char* data, std::size_t size, char* out)
+{
+    const auto bytes = (const std::uint8_t*) data;
+    std::size_t encoded = 0;
+
+    #if defined(NX_AVX2_CODE_SUPPORTED)
+        if (cpuSupportsAvx2())
+            encoded = encodeHexAvx2(bytes, size, out);
+    #elif defined(NX_NEON_SUPPORTED)
+        encoded = encodeHexNeon(bytes, size, out);
+    #endif
+
+    encodeHexScalar(bytes + encoded, size - encoded, out + encoded * 2);
+}
+
+} // namespace detail
+
+std::string fromHex(const std::string_view& str)
+{
+    std::string result((str.size() + 1) / 2, '\0');
+    auto out = (std::uint8_t*) result.data();
+
+    if (str.size() % 2 == 0 && decodeHexPairs(str.data(), str.size(), out))
+        return result;
+
+    // Parsing from the end as QByteArray::fromHex() does.
+    auto pos = result.size();
+    bool isLowDigit = true;
+    for (auto it = str.rbegin(); it != str.rend(); ++it)
+    {
+        const int value = hexDigitValue(*it);
+        if (value < 0)
+            continue;
+
+        if (isLowDigit)
+            out[--pos] = (std::uint8_t) value;
+        else
+            out[pos] |= (std::uint8_t) (value << 4);
+        isLowDigit = !isLowDigit;
+    }
+
+    result.erase(0, pos);
+    return result;
+}
+
 } // namespace nx::utils
@@ -1564,21 +1564,17 @@ std::string to_string(T value)
 
 namespace detail {
 
+/**
+ * Writes size * 2 lower case hex digits to out.
+ */
+NX_UTILS_API void encodeHex(const char* data, std::size_t size, char* out);
+
 template <typename OutputString>
 OutputString toHex(const std::string_view& str)
 {
-    static constexpr char kDigits[] = "0123456789abcdef";
-
     OutputString result;
     result.resize(str.size() * 2);
-
-    std::size_t pos = 0;
-    for (auto ch: str)
-    {
-        result[pos++] = kDigits[(ch >> 4) & 0x0f];
-        result[pos++] = kDigits[ch & 0x0f];
-    }
-
+    encodeHex(str.data(), str.size(), result.data());
     return result;
 }
 
@@ -1602,13 +1598,11 @@ std::decay_t<String> toHex(
     return detail::toHex<String>(std::string_view(str.data(), (std::size_t) str.size()));
 }
 
-// TODO: #akolesnikov Introduced other overloads after introducing local implementation.
-inline std::string fromHex(const std::string_view& str)
-{
-    // TODO: #akolesnikov Get rid of QByteArray. It will save 2 allocations in this function.
-    return QByteArray::fromHex(QByteArray::fromRawData(str.data(), (int) str.size()))
-        .toStdString();
-}
+/**
+ * Same as QByteArray::fromHex(): invalid characters are skipped, an unpaired first digit gives
+ * a byte of its own.
+ */
+NX_UTILS_API std::string fromHex(const std::string_view& str);
 
 template<typename Value>
 // requires std::is_unsigned_v<Value>
@@ -58,4 +58,49 @@ AttributeDictionary& AttributeDictionary::operator=(AttributeDictionary&& other)
     return *this;
 }
 
+//-------------------------------------------------------------------------------------------------
+
+FlatAttributeDictionary::FlatAttributeDictionary():
+    base_type(&m_attrs)
+{
+}
+
+FlatAttributeDictionary::FlatAttributeDictionary(
+    std::initializer_list<std::pair<std::string_view, std::string>> l)
+    :
+    base_type(&m_attrs)
+{
+    m_attrs.reserve(l.size());
+    for (const auto& [k, v]: l)
+        m_attrs[std::string(k)] = v;
+}
+
+FlatAttributeDictionary::FlatAttributeDictionary(const FlatAttributeDictionary& other):
+    base_type(&m_attrs),
+    m_attrs(other.m_attrs)
+{
+}
+
+FlatAttributeDictionary::FlatAttributeDictionary(FlatAttributeDictionary&& other):
+    base_type(&m_attrs),
+    m_attrs(std::move(other.m_attrs))
+{
+}
+
+FlatAttributeDictionary& FlatAttributeDictionary::operator=(const FlatAttributeDictionary& other)
+{
+    if (this != &other)
+        m_attrs = other.m_attrs;
+
+    return *this;
+}
+
+FlatAttributeDictionary& FlatAttributeDictionary::operator=(FlatAttributeDictionary&& other)
+{
+    if (this != &other)
+        m_attrs = std::move(other.m_attrs);
+
+    return *this;
+}
+
 } // namespace nx::utils::stree
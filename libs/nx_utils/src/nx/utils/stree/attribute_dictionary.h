@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <map>
 #include <memory>
@@ -9,6 +10,8 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <nx/reflect/string_conversion.h>
 #include <nx/utils/string.h>
@@ -362,6 +365,103 @@ private:
 
 //-------------------------------------------------------------------------------------------------
 
+/**
+ * Associative container of string attributes stored in a vector in the insertion order.
+ * The lookup is linear, but for a handful of attributes, which is the typical stree input,
+ * it is faster than hashing and does not allocate a node per attribute.
+ */
+class NX_UTILS_API FlatStringAttrDict
+{
+    using InternalContainerType = std::vector<std::pair<std::string, std::string>>;
+
+public:
+    using iterator = InternalContainerType::iterator;
+    using const_iterator = InternalContainerType::const_iterator;
+    using key_type = std::string;
+    using mapped_type = std::string;
+    using value_type = InternalContainerType::value_type;
+
+    FlatStringAttrDict() = default;
+
+    template<typename Iter>
+    FlatStringAttrDict(Iter begin, Iter end)
+    {
+        for (; begin != end; ++begin)
+            (*this)[std::string(begin->first)] = begin->second;
+    }
+
+    iterator begin() { return m_container.begin(); }
+    const_iterator begin() const { return m_container.begin(); }
+    iterator end() { return m_container.end(); }
+    const_iterator end() const { return m_container.end(); }
+
+    iterator find(const std::string_view& key)
+    {
+        return std::find_if(m_container.begin(), m_container.end(),
+            [&key](const auto& item) { return item.first == key; });
+    }
+
+    const_iterator find(const std::string_view& key) const
+    {
+        return std::find_if(m_container.begin(), m_container.end(),
+            [&key](const auto& item) { return item.first == key; });
+    }
+
+    std::string& operator[](std::string key)
+    {
+        if (auto it = find(key); it != m_container.end())
+            return it->second;
+        return m_container.emplace_back(std::move(key), std::string()).second;
+    }
+
+    std::size_t size() const { return m_container.size(); }
+    bool empty() const { return m_container.empty(); }
+    void reserve(std::size_t count) { m_container.reserve(count); }
+    void clear() { m_container.clear(); }
+
+private:
+    InternalContainerType m_container;
+};
+
+/**
+ * Same as AttributeDictionary, but stores attributes in FlatStringAttrDict.
+ * Preferred for the short-living dictionaries with a few attributes like the stree search input
+ * and output.
+ */
+class NX_UTILS_API FlatAttributeDictionary:
+    public AttributeDictionaryAdapter<FlatStringAttrDict>
+{
+public:
+    using Container = FlatStringAttrDict;
+
+private:
+    using base_type = AttributeDictionaryAdapter<Container>;
+
+public:
+    FlatAttributeDictionary();
+    FlatAttributeDictionary(std::initializer_list<std::pair<std::string_view, std::string>> l);
+
+    FlatAttributeDictionary(Container attrs):
+        base_type(&m_attrs),
+        m_attrs(std::move(attrs))
+    {
+    }
+
+    FlatAttributeDictionary(const FlatAttributeDictionary&);
+    FlatAttributeDictionary(FlatAttributeDictionary&&);
+
+    FlatAttributeDictionary& operator=(const FlatAttributeDictionary&);
+    FlatAttributeDictionary& operator=(FlatAttributeDictionary&&);
+
+    const Container& data() const { return m_attrs; }
+    void clear() { m_attrs.clear(); }
+
+private:
+    Container m_attrs;
+};
+
+//-------------------------------------------------------------------------------------------------
+
 /**
  * Reads from mutiple AbstractAttributeReader instances.
  */
@@ -0,0 +1,163 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "compiled_stree.h"
+
+#include "node.h"
+
+namespace nx::utils::stree {
+
+CompiledStree::CompiledStree() = default;
+CompiledStree::~CompiledStree() = default;
+
+CompiledStree::CompiledStree(CompiledStree&&) = default;
+CompiledStree& CompiledStree::operator=(CompiledStree&&) = default;
+
+CompiledStree CompiledStree::compile(std::unique_ptr<AbstractNode> tree)
+{
+    CompiledStree result;
+    if (!tree)
+        return result;
+
+    StreeCompiler compiler(&result);
+    // The children are compiled before their parents, so the root subprogram is the last one.
+    result.m_entryPoint = compiler.compileSubprogram(*tree);
+    result.m_tree = std::move(tree);
+    return result;
+}
+
+void CompiledStree::search(const AbstractAttributeReader& in, AbstractAttributeWriter* out) const
+{
+    if (!m_program.empty())
+        run(m_entryPoint, in, out);
+}
+
+void CompiledStree::run(
+    std::uint32_t pc,
+    const AbstractAttributeReader& in,
+    AbstractAttributeWriter* out) const
+{
+    for (;;)
+    {
+        const Instruction& instruction = m_program[pc++];
+        switch (instruction.opCode)
+        {
+            case OpCode::end:
+                return;
+
+            case OpCode::set:
+                out->putStr(m_attributeNames[instruction.attribute], m_values[instruction.arg1]);
+                break;
+
+            case OpCode::condition:
+            {
+                const auto value = in.getStr(m_attributeNames[instruction.attribute]);
+                if (!value)
+                    break;
+
+                const Condition& condition = m_conditions[instruction.arg1];
+                const int child = condition.selectChild(*value);
+                if (child >= 0)
+                    run(condition.children[child], in, out);
+                break;
+            }
+
+            case OpCode::presence:
+            {
+                const auto subprogram = in.contains(m_attributeNames[instruction.attribute])
+                    ? instruction.arg2
+                    : instruction.arg1;
+                if (subprogram != kNoSubprogram)
+                    run(subprogram, in, out);
+                break;
+            }
+
+            case OpCode::call:
+                m_nodes[instruction.arg1]->get(in, out);
+                break;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+StreeCompiler::StreeCompiler(CompiledStree* result):
+    m_result(result)
+{
+}
+
+void StreeCompiler::emitSet(std::string_view name, std::string value)
+{
+    m_result->m_values.push_back(std::move(value));
+    m_currentSubprogram.push_back({
+        .opCode = CompiledStree::OpCode::set,
+        .attribute = attributeId(name),
+        .arg1 = (std::uint32_t) (m_result->m_values.size() - 1)});
+}
+
+void StreeCompiler::emitCondition(
+    std::string_view attrName,
+    ChildSelector selectChild,
+    const std::vector<const AbstractNode*>& children)
+{
+    CompiledStree::Condition condition;
+    condition.selectChild = std::move(selectChild);
+    condition.children.reserve(children.size());
+    for (const auto child: children)
+        condition.children.push_back(compileSubprogram(*child));
+
+    m_result->m_conditions.push_back(std::move(condition));
+    m_currentSubprogram.push_back({
+        .opCode = CompiledStree::OpCode::condition,
+        .attribute = attributeId(attrName),
+        .arg1 = (std::uint32_t) (m_result->m_conditions.size() - 1)});
+}
+
+void StreeCompiler::emitPresence(
+    std::string_view attrName,
+    const AbstractNode* ifAbsent,
+    const AbstractNode* ifPresent)
+{
+    m_currentSubprogram.push_back({
+        .opCode = CompiledStree::OpCode::presence,
+        .attribute = attributeId(attrName),
+        .arg1 = ifAbsent ? compileSubprogram(*ifAbsent) : CompiledStree::kNoSubprogram,
+        .arg2 = ifPresent ? compileSubprogram(*ifPresent) : CompiledStree::kNoSubprogram});
+}
+
+void StreeCompiler::emitCall(const AbstractNode* node)
+{
+    m_result->m_nodes.push_back(node);
+    m_currentSubprogram.push_back({
+        .opCode = CompiledStree::OpCode::call,
+        .arg1 = (std::uint32_t) (m_result->m_nodes.size() - 1)});
+}
+
+std::uint32_t StreeCompiler::compileSubprogram(const AbstractNode& node)
+{
+    // The children are compiled while the parent subprogram is being emitted, so the parent
+    // subprogram is kept aside and appended after the children.
+    auto parentSubprogram = std::exchange(m_currentSubprogram, {});
+
+    node.compile(this);
+    m_currentSubprogram.push_back({.opCode = CompiledStree::OpCode::end});
+
+    auto& program = m_result->m_program;
+    const auto offset = (std::uint32_t) program.size();
+    program.insert(program.end(), m_currentSubprogram.begin(), m_currentSubprogram.end());
+
+    m_currentSubprogram = std::move(parentSubprogram);
+    return offset;
+}
+
+CompiledStree::AttributeId StreeCompiler::attributeId(std::string_view name)
+{
+    if (auto it = m_attributeIds.find(name); it != m_attributeIds.end())
+        return it->second;
+
+    const auto id = (CompiledStree::AttributeId) m_result->m_attributeNames.size();
+    m_result->m_attributeNames.emplace_back(name);
+    m_attributeIds.emplace(std::string(name), id);
+    return id;
+}
+
+} // namespace nx::utils::stree
@@ -0,0 +1,151 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <nx/utils/move_only_func.h>
+
+#include "attribute_dictionary.h"
+
+namespace nx::utils::stree {
+
+class AbstractNode;
+
+/**
+ * Search tree flattened into a contiguous instruction array.
+ *
+ * Sequence nodes are inlined into their parents, every child of a condition node becomes
+ * a subprogram terminated by the "end" instruction, attribute names are interned into a single
+ * table and referenced by index. So a search is a loop over the instructions with no virtual
+ * calls and no tree walking, except for the nodes of custom types that do not implement
+ * AbstractNode::compile(): those are invoked via AbstractNode::get().
+ *
+ * The result of search() is the same as that of AbstractNode::get() of the source tree.
+ * The object is immutable after compilation, so search() can be called concurrently.
+ */
+class NX_UTILS_API CompiledStree
+{
+public:
+    using AttributeId = std::uint32_t;
+
+    CompiledStree();
+    ~CompiledStree();
+
+    CompiledStree(CompiledStree&&);
+    CompiledStree& operator=(CompiledStree&&);
+
+    /**
+     * Takes ownership of the tree since the instructions may refer to its nodes.
+     */
+    static CompiledStree compile(std::unique_ptr<AbstractNode> tree);
+
+    void search(const AbstractAttributeReader& in, AbstractAttributeWriter* out) const;
+
+    bool empty() const { return m_program.empty(); }
+    std::size_t instructionCount() const { return m_program.size(); }
+    const std::vector<std::string>& attributeNames() const { return m_attributeNames; }
+
+private:
+    friend class StreeCompiler;
+
+    enum class OpCode: std::uint8_t
+    {
+        end,
+        /** Puts the attribute with value m_values[arg1]. */
+        set,
+        /** Runs the child of m_conditions[arg1] selected by the attribute value. */
+        condition,
+        /** Runs subprogram arg1 if the attribute is absent, subprogram arg2 otherwise. */
+        presence,
+        /** Invokes m_nodes[arg1]->get(). */
+        call,
+    };
+
+    struct Instruction
+    {
+        OpCode opCode = OpCode::end;
+        AttributeId attribute = 0;
+        std::uint32_t arg1 = 0;
+        std::uint32_t arg2 = 0;
+    };
+
+    struct Condition
+    {
+        nx::utils::MoveOnlyFunc<int(const std::string&)> selectChild;
+        /** Subprogram offset of each child. */
+        std::vector<std::uint32_t> children;
+    };
+
+    static constexpr std::uint32_t kNoSubprogram = (std::uint32_t) -1;
+
+    void run(
+        std::uint32_t pc,
+        const AbstractAttributeReader& in,
+        AbstractAttributeWriter* out) const;
+
+private:
+    std::unique_ptr<AbstractNode> m_tree;
+    std::vector<Instruction> m_program;
+    std::uint32_t m_entryPoint = 0;
+    std::vector<std::string> m_attributeNames;
+    std::vector<std::string> m_values;
+    std::vector<Condition> m_conditions;
+    std::vector<const AbstractNode*> m_nodes;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Emits the instructions of CompiledStree. Used by the AbstractNode::compile() implementations.
+ */
+class NX_UTILS_API StreeCompiler
+{
+public:
+    /**
+     * Maps a value of the tested attribute to the index of the child to follow, -1 for none.
+     */
+    using ChildSelector = nx::utils::MoveOnlyFunc<int(const std::string& value)>;
+
+    StreeCompiler(CompiledStree* result);
+
+    void emitSet(std::string_view name, std::string value);
+
+    void emitCondition(
+        std::string_view attrName,
+        ChildSelector selectChild,
+        const std::vector<const AbstractNode*>& children);
+
+    /**
+     * @param ifAbsent, ifPresent May be null.
+     */
+    void emitPresence(
+        std::string_view attrName,
+        const AbstractNode* ifAbsent,
+        const AbstractNode* ifPresent);
+
+    /** Emits the invocation of AbstractNode::get() of the node. */
+    void emitCall(const AbstractNode* node);
+
+    /**
+     * Compiles the node into a separate subprogram.
+     * @return The subprogram offset.
+     */
+    std::uint32_t compileSubprogram(const AbstractNode& node);
+
+private:
+    CompiledStree::AttributeId attributeId(std::string_view name);
+
+private:
+    CompiledStree* m_result = nullptr;
+    std::vector<CompiledStree::Instruction> m_currentSubprogram;
+    std::unordered_map<std::string, CompiledStree::AttributeId,
+        nx::utils::StringHashTransparent, nx::utils::StringEqualToTransparent> m_attributeIds;
+};
+
+} // namespace nx::utils::stree
@@ -6,6 +6,11 @@
 
 namespace nx::utils::stree {
 
+void AbstractNode::compile(StreeCompiler* compiler) const
+{
+    compiler->emitCall(this);
+}
+
 //-------------------------------------------------------------------------------------------------
 // class SequenceNode.
 
@@ -21,6 +26,13 @@ bool SequenceNode::addChild(const std::string_view& value, std::unique_ptr<Abstr
     return true;
 }
 
+void SequenceNode::compile(StreeCompiler* compiler) const
+{
+    // The children are inlined.
+    for (const auto& [value, child]: m_children)
+        child->compile(compiler);
+}
+
 
 //-------------------------------------------------------------------------------------------------
 // class AttrPresenceNode.
@@ -64,6 +76,11 @@ bool AttrPresenceNode::addChild(const std::string_view& str, std::unique_ptr<Abs
     return true;
 }
 
+void AttrPresenceNode::compile(StreeCompiler* compiler) const
+{
+    compiler->emitPresence(m_attrToMatchName, m_children[0].get(), m_children[1].get());
+}
+
 
 //-------------------------------------------------------------------------------------------------
 // class SetNode.
@@ -89,4 +106,9 @@ bool SetNode::addChild(const std::string_view& /*value*/, std::unique_ptr<Abstra
     return true;
 }
 
+void SetNode::compile(StreeCompiler* compiler) const
+{
+    compiler->emitSet(m_name, m_value);
+}
+
 } // namespace nx::utils::stree
@@ -8,6 +8,7 @@
 #include <nx/utils/log/log.h>
 
 #include "attribute_dictionary.h"
+#include "compiled_stree.h"
 
 /**
  * Contains implementation of simple search tree.
@@ -34,6 +35,13 @@ public:
      * If node added, true is returned and ownership of child object is taken.
      */
     virtual bool addChild(const std::string_view& value, std::unique_ptr<AbstractNode> child) = 0;
+
+    /**
+     * Emits the instructions that do the same as get(). See CompiledStree.
+     * The default implementation emits the invocation of get(), so custom node types work in
+     * a compiled tree without overriding this.
+     */
+    virtual void compile(StreeCompiler* compiler) const;
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -58,6 +66,8 @@ public:
         const std::string_view& value,
         std::unique_ptr<AbstractNode> child) override;
 
+    virtual void compile(StreeCompiler* compiler) const override;
+
 private:
     std::multimap<int, std::unique_ptr<AbstractNode>> m_children;
 };
@@ -145,6 +155,29 @@ public:
             std::move(child)).second;
     }
 
+    virtual void compile(StreeCompiler* compiler) const override
+    {
+        // The same container maps the keys to the child indexes, so the match rules are kept.
+        ConditionContainer<Key, int> childIndexes;
+        std::vector<const AbstractNode*> children;
+        for (const auto& [key, child]: m_children)
+        {
+            childIndexes.emplace(key, (int) children.size());
+            children.push_back(child.get());
+        }
+
+        compiler->emitCondition(
+            m_attrToMatchName,
+            [childIndexes = std::move(childIndexes)](const std::string& value)
+            {
+                const typename KeyConversionFunc::SearchValueType& typedValue =
+                    KeyConversionFunc::convertToSearchValue(value);
+                const auto it = childIndexes.find(typedValue);
+                return it != childIndexes.end() ? it->second : -1;
+            },
+            children);
+    }
+
 private:
     Container m_children;
     const std::string m_attrToMatchName;
@@ -164,6 +197,7 @@ public:
 
     virtual void get(const AbstractAttributeReader& in, AbstractAttributeWriter* const out) const override;
     virtual bool addChild(const std::string_view& value, std::unique_ptr<AbstractNode> child) override;
+    virtual void compile(StreeCompiler* compiler) const override;
 
 private:
     /** [0] - for false. [1] - for true. */
@@ -187,6 +221,7 @@ public:
      */
     virtual void get(const AbstractAttributeReader& in, AbstractAttributeWriter* const out) const override;
     virtual bool addChild(const std::string_view& value, std::unique_ptr<AbstractNode> child) override;
+    virtual void compile(StreeCompiler* compiler) const override;
 
 private:
     std::unique_ptr<AbstractNode> m_child;
@@ -23,7 +23,7 @@ void StreeManager::search(
     const nx::utils::stree::AbstractAttributeReader& input,
     nx::utils::stree::AbstractAttributeWriter* const output) const
 {
-    m_stree->get(input, output);
+    m_stree.search(input, output);
 }
 
 std::unique_ptr<nx::utils::stree::AbstractNode> StreeManager::loadStree(const nx::Buffer& data)
@@ -51,9 +51,13 @@ void StreeManager::loadStree() noexcept(false)
     }
 
     NX_DEBUG(this, "Parsing stree xml file (%1)", m_xmlFilePath);
-    m_stree = loadStree(xmlFile.readAll());
-    if (!m_stree)
+    auto stree = loadStree(xmlFile.readAll());
+    if (!stree)
         throw std::runtime_error("Failed to parse stree xml file " + m_xmlFilePath);
+
+    m_stree = CompiledStree::compile(std::move(stree));
+    NX_DEBUG(this, "Compiled stree %1 into %2 instructions",
+        m_xmlFilePath, m_stree.instructionCount());
 }
 
 } // namespace nx::utils::stree
@@ -9,6 +9,7 @@
 #include <nx/utils/buffer.h>
 
 #include "attribute_dictionary.h"
+#include "compiled_stree.h"
 #include "node.h"
 
 namespace nx::utils::stree {
@@ -32,7 +33,8 @@ public:
     static std::unique_ptr<nx::utils::stree::AbstractNode> loadStree(const nx::Buffer& xmlData);
 
 private:
-    std::unique_ptr<nx::utils::stree::AbstractNode> m_stree;
+    /** The loaded tree compiled for faster search. */
+    CompiledStree m_stree;
     const std::string m_xmlFilePath;
 
     void loadStree() noexcept(false);
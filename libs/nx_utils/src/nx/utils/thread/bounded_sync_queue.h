@@ -0,0 +1,460 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <nx/utils/thread/mutex.h>
+#include <nx/utils/thread/wait_condition.h>
+
+namespace nx::utils {
+
+enum class QueueOverflowPolicy
+{
+    /** push() waits until there is free space in the queue. */
+    block,
+    /** push() removes the oldest element to make room for the new one. */
+    dropOldest,
+};
+
+/**
+ * Bounded multi-producer multi-consumer queue with the interface similar to SyncQueue, so that
+ * producer/consumer pairs can switch to it.
+ *
+ * Push and pop are lock-free (a ring of cells with per-cell sequence numbers by D. Vyukov): no
+ * mutex is taken on the hot path. A thread that has to wait (a consumer on an empty queue or,
+ * with QueueOverflowPolicy::block, a producer on a full one) first spins for a while and then
+ * parks on a wait condition. The mutex is taken by a producer (consumer) only if there is
+ * a parked consumer (producer) to wake up.
+ *
+ * pushBatch() / popBatch() move several elements with a single wake up / wait.
+ * Unlike SyncQueue, there is no popIf() and no reader termination.
+ */
+template<typename T>
+class BoundedSyncQueue
+{
+public:
+    /**
+     * @param capacity Rounded up to a power of two.
+     */
+    explicit BoundedSyncQueue(
+        std::size_t capacity,
+        QueueOverflowPolicy overflowPolicy = QueueOverflowPolicy::block);
+
+    ~BoundedSyncQueue();
+
+    BoundedSyncQueue(const BoundedSyncQueue&) = delete;
+    BoundedSyncQueue& operator=(const BoundedSyncQueue&) = delete;
+
+    void push(T value);
+
+    /** Constructs the element in-place. */
+    template<typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * Pushes all values in order. Parked consumers are woken up once per batch.
+     */
+    void pushBatch(std::vector<T> values);
+
+    /**
+     * Does not wait and does not drop anything.
+     * @return false if the queue is full.
+     */
+    bool tryPush(T value);
+
+    std::function<void(T)> pusher();
+
+    /** Waits for an element. */
+    T pop();
+
+    /** @return std::nullopt if the queue is still empty after timeout. */
+    std::optional<T> pop(std::optional<std::chrono::milliseconds> timeout);
+
+    std::optional<T> tryPop();
+
+    /**
+     * Waits until the queue is not empty (but not longer than timeout) and then moves up to
+     * maxCount elements to the end of values.
+     * @return The number of elements popped.
+     */
+    std::size_t popBatch(
+        std::vector<T>* values,
+        std::size_t maxCount,
+        std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+    /** The number of elements. Approximate if the queue is being modified concurrently. */
+    std::size_t size() const;
+    bool empty() const;
+    bool isEmpty() const { return empty(); }
+    std::size_t capacity() const { return m_mask + 1; }
+    void clear();
+
+    /** The number of elements removed by QueueOverflowPolicy::dropOldest. */
+    std::size_t droppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0};
+        alignas(T) std::byte data[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(data)); }
+    };
+
+    template<typename... Args>
+    bool tryEmplace(Args&&... args);
+
+    template<typename... Args>
+    void emplaceWithPolicy(Args&&... args);
+
+    template<typename Ready>
+    bool waitFor(
+        Ready ready,
+        nx::WaitCondition* condition,
+        std::atomic<int>* waitingCount,
+        std::optional<std::chrono::steady_clock::time_point> deadline);
+
+    void wakeConsumers(bool all);
+    void wakeProducers();
+
+    bool hasElements() const;
+    bool hasFreeSpace() const;
+
+private:
+    static constexpr int kSpinCount = 64;
+
+    const QueueOverflowPolicy m_overflowPolicy;
+    std::size_t m_mask = 0;
+    std::unique_ptr<Cell[]> m_cells;
+
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<std::size_t> m_dequeuePos{0};
+
+    alignas(64) std::atomic<int> m_waitingConsumers{0};
+    std::atomic<int> m_waitingProducers{0};
+    std::atomic<std::size_t> m_droppedCount{0};
+    nx::Mutex m_mutex;
+    nx::WaitCondition m_notEmpty;
+    nx::WaitCondition m_notFull;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Implementation.
+
+template<typename T>
+BoundedSyncQueue<T>::BoundedSyncQueue(
+    std::size_t capacity,
+    QueueOverflowPolicy overflowPolicy)
+    :
+    m_overflowPolicy(overflowPolicy)
+{
+    capacity = std::bit_ceil(std::max<std::size_t>(capacity, 2));
+    m_mask = capacity - 1;
+    m_cells = std::make_unique<Cell[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i)
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+BoundedSyncQueue<T>::~BoundedSyncQueue()
+{
+    clear();
+}
+
+template<typename T>
+void BoundedSyncQueue<T>::push(T value)
+{
+    emplaceWithPolicy(std::move(value));
+    wakeConsumers(/*all*/ false);
+}
+
+template<typename T>
+template<typename... Args>
+void BoundedSyncQueue<T>::emplace(Args&&... args)
+{
+    emplaceWithPolicy(std::forward<Args>(args)...);
+    wakeConsumers(/*all*/ false);
+}
+
+template<typename T>
+void BoundedSyncQueue<T>::pushBatch(std::vector<T> values)
+{
+    for (auto& value: values)
+        emplaceWithPolicy(std::move(value));
+    wakeConsumers(/*all*/ true);
+}
+
+template<typename T>
+bool BoundedSyncQueue<T>::tryPush(T value)
+{
+    if (!tryEmplace(std::move(value)))
+        return false;
+    wakeConsumers(/*all*/ false);
+    return true;
+}
+
+template<typename T>
+std::function<void(T)> BoundedSyncQueue<T>::pusher()
+{
+    return [this](T value) { push(std::move(value)); };
+}
+
+template<typename T>
+T BoundedSyncQueue<T>::pop()
+{
+    return *pop(std::nullopt);
+}
+
+template<typename T>
+std::optional<T> BoundedSyncQueue<T>::pop(std::optional<std::chrono::milliseconds> timeout)
+{
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    if (timeout)
+        deadline = std::chrono::steady_clock::now() + *timeout;
+
+    std::optional<T> value;
+    waitFor(
+        [this, &value]() { return (bool) (value = tryPop()); },
+        &m_notEmpty, &m_waitingConsumers, deadline);
+    return value;
+}
+
+template<typename T>
+std::optional<T> BoundedSyncQueue<T>::tryPop()
+{
+    std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;)
+    {
+        cell = &m_cells[pos & m_mask];
+        const auto sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = (std::ptrdiff_t) sequence - (std::ptrdiff_t) (pos + 1);
+        if (diff == 0)
+        {
+            if (m_dequeuePos.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return std::nullopt;
+        }
+        else
+        {
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::optional<T> value(std::move(*cell->value()));
+    cell->value()->~T();
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+    wakeProducers();
+    return value;
+}
+
+template<typename T>
+std::size_t BoundedSyncQueue<T>::popBatch(
+    std::vector<T>* values,
+    std::size_t maxCount,
+    std::optional<std::chrono::milliseconds> timeout)
+{
+    if (maxCount == 0)
+        return 0;
+
+    auto value = pop(timeout);
+    if (!value)
+        return 0;
+
+    values->push_back(std::move(*value));
+    std::size_t count = 1;
+    for (; count < maxCount; ++count)
+    {
+        value = tryPop();
+        if (!value)
+            break;
+        values->push_back(std::move(*value));
+    }
+    return count;
+}
+
+template<typename T>
+std::size_t BoundedSyncQueue<T>::size() const
+{
+    const auto dequeuePos = m_dequeuePos.load();
+    const auto enqueuePos = m_enqueuePos.load();
+    return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+}
+
+template<typename T>
+bool BoundedSyncQueue<T>::empty() const
+{
+    return size() == 0;
+}
+
+template<typename T>
+void BoundedSyncQueue<T>::clear()
+{
+    while (tryPop()) {}
+}
+
+template<typename T>
+template<typename... Args>
+bool BoundedSyncQueue<T>::tryEmplace(Args&&... args)
+{
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;)
+    {
+        cell = &m_cells[pos & m_mask];
+        const auto sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = (std::ptrdiff_t) sequence - (std::ptrdiff_t) pos;
+        if (diff == 0)
+        {
+            if (m_enqueuePos.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (cell->data) T(std::forward<Args>(args)...);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+template<typename... Args>
+void BoundedSyncQueue<T>::emplaceWithPolicy(Args&&... args)
+{
+    // The arguments are used only by the successful tryEmplace(), so passing them again is safe.
+    if (tryEmplace(std::forward<Args>(args)...))
+        return;
+
+    if (m_overflowPolicy == QueueOverflowPolicy::dropOldest)
+    {
+        while (!tryEmplace(std::forward<Args>(args)...))
+        {
+            if (tryPop())
+                ++m_droppedCount;
+        }
+        return;
+    }
+
+    waitFor(
+        [&]() { return tryEmplace(std::forward<Args>(args)...); },
+        &m_notFull, &m_waitingProducers, std::nullopt);
+}
+
+template<typename T>
+template<typename Ready>
+bool BoundedSyncQueue<T>::waitFor(
+    Ready ready,
+    nx::WaitCondition* condition,
+    std::atomic<int>* waitingCount,
+    std::optional<std::chrono::steady_clock::time_point> deadline)
+{
+    using namespace std::chrono;
+
+    for (int i = 0; i < kSpinCount; ++i)
+    {
+        if (ready())
+            return true;
+        std::this_thread::yield();
+    }
+
+    const bool waitingForElements = condition == &m_notEmpty;
+    for (;;)
+    {
+        if (ready())
+            return true;
+
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        // Paired with the load in wakeConsumers() / wakeProducers(): either the other side sees
+        // this waiter or this thread sees the change made by the other side.
+        waitingCount->fetch_add(1);
+        const bool canProceed = waitingForElements ? hasElements() : hasFreeSpace();
+        bool timedOut = false;
+        if (!canProceed)
+        {
+            if (deadline)
+            {
+                const auto now = steady_clock::now();
+                timedOut = now >= *deadline
+                    || !condition->wait(
+                        lock.mutex(), ceil<milliseconds>(*deadline - now));
+            }
+            else
+            {
+                condition->wait(lock.mutex());
+            }
+        }
+        waitingCount->fetch_sub(1, std::memory_order_relaxed);
+
+        if (timedOut)
+        {
+            lock.unlock();
+            return ready();
+        }
+    }
+}
+
+template<typename T>
+void BoundedSyncQueue<T>::wakeConsumers(bool all)
+{
+    if (m_waitingConsumers.load() == 0)
+        return;
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (all)
+        m_notEmpty.wakeAll();
+    else
+        m_notEmpty.wakeOne();
+}
+
+template<typename T>
+void BoundedSyncQueue<T>::wakeProducers()
+{
+    if (m_waitingProducers.load() == 0)
+        return;
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_notFull.wakeOne();
+}
+
+template<typename T>
+bool BoundedSyncQueue<T>::hasElements() const
+{
+    // The position is claimed before the element is published, so "has elements" may be
+    // reported for a moment too early. The waiter just spins once more in that case.
+    return m_enqueuePos.load() != m_dequeuePos.load();
+}
+
+template<typename T>
+bool BoundedSyncQueue<T>::hasFreeSpace() const
+{
+    return m_enqueuePos.load() - m_dequeuePos.load() <= m_mask;
+}
+
+} // namespace nx::utils
@@ -4,38 +4,24 @@
 
 #include <functional>
 
+#include <nx/utils/move_only_func.h>
+
 namespace cf {
 namespace detail {
 
 // We can't use std::function as continuation holder, as it
 // requires held type to be copyable. So here is simple move-only
-// callable wrapper.
+// callable wrapper. Small callables are stored without allocation.
 template<typename F>
 class movable_func;
 
 template<typename R, typename... Args>
 class movable_func<R(Args...)> {
-
-  struct base_holder {
-    virtual R operator() (Args... args) = 0;
-    virtual ~base_holder() {}
-  };
-
-  template<typename F>
-  struct holder : base_holder {
-    holder(F f) : f_(std::move(f)) {}
-    virtual R operator() (Args... args) override {
-      return f_(args...);
-    }
-
-    F f_;
-  };
-
 public:
   template<typename F>
-  movable_func(F f) : held_(new holder<F>(std::move(f))) {}
-  movable_func(std::nullptr_t): held_(nullptr) {}
-  movable_func() : held_(nullptr) {}
+  movable_func(F f) : held_(std::move(f)) {}
+  movable_func(std::nullptr_t) {}
+  movable_func() = default;
   movable_func(movable_func<R(Args...)>&&) = default;
   movable_func& operator = (movable_func<R(Args...)>&&) = default;
   movable_func(const movable_func<R(Args...)>&) = delete;
@@ -45,11 +31,11 @@ public:
   explicit operator bool() const { return !empty(); }
 
   R operator() (Args... args) const {
-    return held_->operator()(args...);
+    return held_(std::forward<Args>(args)...);
   }
 
 private:
-  std::unique_ptr<base_holder> held_;
+  nx::utils::MoveOnlyFunc<R(Args...)> held_;
 };
 
 using task_type = movable_func<void()>;
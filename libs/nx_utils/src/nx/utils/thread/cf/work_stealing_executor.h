@@ -0,0 +1,375 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common.h"
+
+namespace cf {
+
+struct work_stealing_executor_statistics {
+  /** Tasks posted from outside the pool and not yet taken by any worker. */
+  size_t injected_queue_depth = 0;
+  /** Tasks in the local deque of each worker. */
+  std::vector<size_t> worker_queue_depths;
+  uint64_t executed = 0;
+  /** Tasks taken from the deque of another worker. */
+  uint64_t steals = 0;
+  /** Steal attempts that found the victim empty or lost the race for the task. */
+  uint64_t failed_steals = 0;
+  /** How many times the workers went to sleep having found no work. */
+  uint64_t parks = 0;
+
+  size_t queue_depth() const {
+    size_t depth = injected_queue_depth;
+    for (const auto worker_depth: worker_queue_depths)
+      depth += worker_depth;
+    return depth;
+  }
+};
+
+namespace detail {
+
+/**
+ * Chase-Lev work-stealing deque of task pointers ("Correct and Efficient Work-Stealing for Weak
+ * Memory Models", Le et al., 2013). push() and take() are called by the owner thread only,
+ * steal() by any thread. The buffer grows on demand; the replaced buffers are kept until the
+ * deque is destroyed since a concurrent steal() may still be reading them.
+ */
+class work_stealing_deque {
+  struct ring {
+    explicit ring(size_t capacity) : mask(capacity - 1), slots(capacity) {}
+
+    task_type* get(int64_t i) const {
+      return slots[(size_t)i & mask].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t i, task_type* task) {
+      slots[(size_t)i & mask].store(task, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    const size_t mask;
+    std::vector<std::atomic<task_type*>> slots;
+  };
+
+public:
+  enum class steal_result { success, empty, lost_race };
+
+  explicit work_stealing_deque(size_t initial_capacity = 256) {
+    rings_.push_back(std::make_unique<ring>(initial_capacity));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+  }
+
+  ~work_stealing_deque() {
+    while (auto task = take())
+      delete task;
+  }
+
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  void push(task_type* task) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    ring* r = ring_.load(std::memory_order_relaxed);
+    if (b - t >= (int64_t)r->capacity())
+      r = grow(r, t, b);
+    r->put(b, task);
+    bottom_.store(b + 1, std::memory_order_seq_cst);
+  }
+
+  /** Takes the most recently pushed task (LIFO, cache-friendly for the owner). */
+  task_type* take() {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* r = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_seq_cst);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    task_type* task = r->get(b);
+    if (t == b) {
+      // The last task: compete with the thieves for it.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst))
+        task = nullptr;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+  }
+
+  /** Takes the oldest task (FIFO). */
+  steal_result steal(task_type** task) {
+    int64_t t = top_.load(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_seq_cst);
+    if (t >= b)
+      return steal_result::empty;
+
+    *task = ring_.load(std::memory_order_acquire)->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst))
+      return steal_result::lost_race;
+    return steal_result::success;
+  }
+
+  size_t size() const {
+    const int64_t b = bottom_.load(std::memory_order_seq_cst);
+    const int64_t t = top_.load(std::memory_order_seq_cst);
+    return b > t ? (size_t)(b - t) : 0;
+  }
+
+private:
+  ring* grow(ring* r, int64_t t, int64_t b) {
+    auto bigger = std::make_unique<ring>(r->capacity() * 2);
+    for (int64_t i = t; i < b; ++i)
+      bigger->put(i, r->get(i));
+    rings_.push_back(std::move(bigger));
+    ring_.store(rings_.back().get(), std::memory_order_release);
+    return rings_.back().get();
+  }
+
+private:
+  alignas(64) std::atomic<int64_t> top_ = {0};
+  alignas(64) std::atomic<int64_t> bottom_ = {0};
+  std::atomic<ring*> ring_ = {nullptr};
+  std::vector<std::unique_ptr<ring>> rings_;
+};
+
+} // namespace detail
+
+/**
+ * Thread pool executor with work stealing. Unlike async_thread_pool_executor, there is no
+ * dispatching thread and no single shared queue on the hot path:
+ * - A task posted from a worker (e.g., a continuation posted by another continuation) goes to
+ *   the local deque of that worker and is most likely executed by the same thread.
+ * - A task posted from outside the pool goes to the shared injection queue.
+ * - An idle worker takes the tasks from its own deque, then from the injection queue, then
+ *   steals from the other workers. Having found nothing, it spins for a while yielding the CPU
+ *   and then parks on a condition variable until a new task is posted.
+ *
+ * Usable as the executor of cf::future::then / cf::async and from nx::coro tasks via
+ * `co_await executor.schedule()`. The tasks still pending on destruction are discarded.
+ */
+class work_stealing_executor {
+  struct alignas(64) worker {
+    detail::work_stealing_deque deque;
+    uint64_t random_state = 0;
+    std::atomic<uint64_t> executed = {0};
+    std::atomic<uint64_t> steals = {0};
+    std::atomic<uint64_t> failed_steals = {0};
+    std::atomic<uint64_t> parks = {0};
+    std::thread thread;
+  };
+
+  struct current_worker {
+    const work_stealing_executor* executor = nullptr;
+    size_t index = 0;
+  };
+
+public:
+  /**
+   * @param size The number of worker threads. If zero, std::thread::hardware_concurrency().
+   * @param spin_count How many rounds of searching for a task a worker makes before parking.
+   */
+  explicit work_stealing_executor(size_t size = 0, int spin_count = 64)
+    : spin_count_(spin_count) {
+    if (size == 0)
+      size = std::max(1U, std::thread::hardware_concurrency());
+
+    workers_.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      workers_.push_back(std::make_unique<worker>());
+      workers_.back()->random_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+    for (size_t i = 0; i < size; ++i)
+      workers_[i]->thread = std::thread([this, i] { run(i); });
+  }
+
+  ~work_stealing_executor() {
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+      need_stop_ = true;
+    }
+    park_cond_.notify_all();
+    for (auto& w : workers_) {
+      if (w->thread.joinable())
+        w->thread.join();
+    }
+    for (auto task : injection_queue_)
+      delete task;
+  }
+
+  work_stealing_executor(const work_stealing_executor&) = delete;
+  work_stealing_executor& operator=(const work_stealing_executor&) = delete;
+
+  size_t size() const { return workers_.size(); }
+
+  void post(detail::task_type task) {
+    auto ptr = new detail::task_type(std::move(task));
+    const auto& current = this_worker();
+    if (current.executor == this) {
+      workers_[current.index]->deque.push(ptr);
+    } else {
+      std::lock_guard<std::mutex> lock(injection_mutex_);
+      injection_queue_.push_back(ptr);
+    }
+    wake_one();
+  }
+
+  /**
+   * Awaitable that resumes the awaiting coroutine on one of the workers:
+   * `co_await executor.schedule();`
+   */
+  auto schedule() {
+    struct awaiter {
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> h) {
+        executor->post([h] { h.resume(); });
+      }
+      void await_resume() const noexcept {}
+
+      work_stealing_executor* executor;
+    };
+    return awaiter{this};
+  }
+
+  work_stealing_executor_statistics statistics() const {
+    work_stealing_executor_statistics result;
+    {
+      std::lock_guard<std::mutex> lock(injection_mutex_);
+      result.injected_queue_depth = injection_queue_.size();
+    }
+    for (const auto& w : workers_) {
+      result.worker_queue_depths.push_back(w->deque.size());
+      result.executed += w->executed.load(std::memory_order_relaxed);
+      result.steals += w->steals.load(std::memory_order_relaxed);
+      result.failed_steals += w->failed_steals.load(std::memory_order_relaxed);
+      result.parks += w->parks.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+private:
+  static current_worker& this_worker() {
+    static thread_local current_worker current;
+    return current;
+  }
+
+  void run(size_t index) {
+    this_worker() = {this, index};
+    worker& self = *workers_[index];
+    int idle_rounds = 0;
+    for (;;) {
+      if (auto task = find_task(self, index)) {
+        idle_rounds = 0;
+        (*task)();
+        delete task;
+        self.executed.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      if (need_stop_.load(std::memory_order_relaxed))
+        return;
+
+      if (++idle_rounds <= spin_count_) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      idle_rounds = 0;
+      std::unique_lock<std::mutex> lock(park_mutex_);
+      // Paired with the load in wake_one(): either the poster sees this sleeper or this worker
+      // sees the posted task.
+      sleeping_count_.fetch_add(1, std::memory_order_seq_cst);
+      if (!need_stop_ && !has_work()) {
+        self.parks.fetch_add(1, std::memory_order_relaxed);
+        park_cond_.wait(lock);
+      }
+      sleeping_count_.fetch_sub(1, std::memory_order_relaxed);
+      if (need_stop_)
+        return;
+    }
+  }
+
+  detail::task_type* find_task(worker& self, size_t index) {
+    if (auto task = self.deque.take())
+      return task;
+
+    {
+      std::lock_guard<std::mutex> lock(injection_mutex_);
+      if (!injection_queue_.empty()) {
+        auto task = injection_queue_.front();
+        injection_queue_.pop_front();
+        return task;
+      }
+    }
+
+    const size_t count = workers_.size();
+    if (count < 2)
+      return nullptr;
+
+    // Xorshift: a random start spreads the thieves over the victims.
+    auto& x = self.random_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    const size_t start = (size_t)(x % count);
+    for (size_t i = 0; i < count; ++i) {
+      const size_t victim = (start + i) % count;
+      if (victim == index)
+        continue;
+
+      detail::task_type* task = nullptr;
+      const auto result = workers_[victim]->deque.steal(&task);
+      if (result == detail::work_stealing_deque::steal_result::success) {
+        self.steals.fetch_add(1, std::memory_order_relaxed);
+        return task;
+      }
+      if (result == detail::work_stealing_deque::steal_result::lost_race)
+        self.failed_steals.fetch_add(1, std::memory_order_relaxed);
+    }
+    return nullptr;
+  }
+
+  bool has_work() const {
+    {
+      std::lock_guard<std::mutex> lock(injection_mutex_);
+      if (!injection_queue_.empty())
+        return true;
+    }
+    return std::any_of(workers_.begin(), workers_.end(),
+      [](const auto& w) { return w->deque.size() > 0; });
+  }
+
+  void wake_one() {
+    if (sleeping_count_.load(std::memory_order_seq_cst) == 0)
+      return;
+    // Locking guarantees that a worker that has registered itself as sleeping is already waiting.
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    park_cond_.notify_one();
+  }
+
+private:
+  const int spin_count_;
+  std::vector<std::unique_ptr<worker>> workers_;
+  mutable std::mutex injection_mutex_;
+  std::deque<detail::task_type*> injection_queue_;
+  std::mutex park_mutex_;
+  std::condition_variable park_cond_;
+  std::atomic<size_t> sleeping_count_ = {0};
+  std::atomic<bool> need_stop_ = {false};
+};
+
+} // namespace cf
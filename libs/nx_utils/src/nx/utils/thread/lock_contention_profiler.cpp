@@ -0,0 +1,212 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "lock_contention_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include <nx/utils/nx_utils_ini.h>
+
+namespace nx {
+
+namespace {
+
+static constexpr std::size_t kMaxProbeCount = 32;
+
+void updateMax(std::atomic<std::uint64_t>* max, std::uint64_t value)
+{
+    auto current = max->load(std::memory_order_relaxed);
+    while (current < value
+        && !max->compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+std::uint64_t siteHash(const char* sourceFile, int sourceLine, LockKind kind)
+{
+    // The file name pointer is a good enough identity: __FILE__ of the same file is usually the
+    // same literal within a module. Duplicates are merged by name in report().
+    std::uint64_t hash = (std::uint64_t) reinterpret_cast<std::uintptr_t>(sourceFile);
+    hash ^= ((std::uint64_t) (unsigned) sourceLine << 2 | (std::uint64_t) kind)
+        * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 29;
+    return hash == 0 ? 1 : hash; //< 0 marks the free slot.
+}
+
+std::chrono::microseconds toUsec(const std::atomic<std::uint64_t>& nanoseconds)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::nanoseconds(nanoseconds.load(std::memory_order_relaxed)));
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+
+struct LockContentionProfiler::Site
+{
+    std::atomic<std::uint64_t> hash{0};
+
+    /** Set after the key fields below are written. */
+    std::atomic<bool> isReady{false};
+    const char* sourceFile = nullptr;
+    int sourceLine = 0;
+    LockKind kind = LockKind::mutex;
+
+    std::atomic<std::uint64_t> sampledLockCount{0};
+    std::atomic<std::uint64_t> contendedLockCount{0};
+    std::atomic<std::uint64_t> totalWaitTimeNsec{0};
+    std::atomic<std::uint64_t> maxWaitTimeNsec{0};
+    std::atomic<std::uint64_t> totalHoldTimeNsec{0};
+    std::atomic<std::uint64_t> maxHoldTimeNsec{0};
+};
+
+//-------------------------------------------------------------------------------------------------
+
+LockContentionProfiler::LockContentionProfiler(int samplingPeriod):
+    m_sites(std::make_unique<Site[]>(kMaxSiteCount)),
+    m_samplingPeriod(std::max(samplingPeriod, 1))
+{
+}
+
+LockContentionProfiler::~LockContentionProfiler() = default;
+
+bool LockContentionProfiler::isSampled() const
+{
+    thread_local int callCount = 0;
+    if (++callCount < m_samplingPeriod.load(std::memory_order_relaxed))
+        return false;
+
+    callCount = 0;
+    return true;
+}
+
+LockContentionProfiler::Site* LockContentionProfiler::site(
+    const char* sourceFile, int sourceLine, LockKind kind)
+{
+    const auto hash = siteHash(sourceFile, sourceLine, kind);
+    for (std::size_t i = 0; i < kMaxProbeCount; ++i)
+    {
+        auto& site = m_sites[(hash + i) % kMaxSiteCount];
+
+        auto currentHash = site.hash.load(std::memory_order_acquire);
+        if (currentHash == 0
+            && site.hash.compare_exchange_strong(currentHash, hash, std::memory_order_acq_rel))
+        {
+            site.sourceFile = sourceFile;
+            site.sourceLine = sourceLine;
+            site.kind = kind;
+            site.isReady.store(true, std::memory_order_release);
+            return &site;
+        }
+
+        // The key fields may be not written yet, but the counters can be updated already.
+        if (currentHash == hash)
+            return &site;
+    }
+
+    ++m_droppedSampleCount;
+    return nullptr;
+}
+
+void LockContentionProfiler::recordWait(
+    Site* site, std::chrono::nanoseconds waitTime, bool isContended)
+{
+    const auto waitTimeNsec = (std::uint64_t) std::max<std::int64_t>(waitTime.count(), 0);
+
+    ++site->sampledLockCount;
+    if (!isContended)
+        return;
+
+    ++site->contendedLockCount;
+    site->totalWaitTimeNsec += waitTimeNsec;
+    updateMax(&site->maxWaitTimeNsec, waitTimeNsec);
+}
+
+void LockContentionProfiler::recordHold(Site* site, std::chrono::nanoseconds holdTime)
+{
+    const auto holdTimeNsec = (std::uint64_t) std::max<std::int64_t>(holdTime.count(), 0);
+
+    site->totalHoldTimeNsec += holdTimeNsec;
+    updateMax(&site->maxHoldTimeNsec, holdTimeNsec);
+}
+
+void LockContentionProfiler::setSamplingPeriod(int samplingPeriod)
+{
+    m_samplingPeriod = std::max(samplingPeriod, 1);
+}
+
+int LockContentionProfiler::samplingPeriod() const
+{
+    return m_samplingPeriod;
+}
+
+LockContentionReport LockContentionProfiler::report(std::size_t maxSiteCount) const
+{
+    LockContentionReport report;
+    report.samplingPeriod = m_samplingPeriod;
+    report.droppedSampleCount = m_droppedSampleCount;
+
+    std::map<std::tuple<std::string, int, LockKind>, LockSiteStatistics> sites;
+    for (std::size_t i = 0; i < kMaxSiteCount; ++i)
+    {
+        const auto& site = m_sites[i];
+        if (!site.isReady.load(std::memory_order_acquire) || site.sampledLockCount == 0)
+            continue;
+
+        const std::string sourceFile = site.sourceFile ? site.sourceFile : "unknown";
+        auto& statistics = sites[{sourceFile, site.sourceLine, site.kind}];
+        statistics.location = sourceFile + ":" + std::to_string(site.sourceLine);
+        statistics.kind = site.kind;
+        statistics.sampledLockCount += site.sampledLockCount;
+        statistics.contendedLockCount += site.contendedLockCount;
+        statistics.totalWaitTimeUsec += toUsec(site.totalWaitTimeNsec);
+        statistics.maxWaitTimeUsec = std::max(
+            statistics.maxWaitTimeUsec, toUsec(site.maxWaitTimeNsec));
+        statistics.totalHoldTimeUsec += toUsec(site.totalHoldTimeNsec);
+        statistics.maxHoldTimeUsec = std::max(
+            statistics.maxHoldTimeUsec, toUsec(site.maxHoldTimeNsec));
+    }
+
+    for (auto& [key, statistics]: sites)
+        report.sites.push_back(std::move(statistics));
+
+    std::sort(
+        report.sites.begin(), report.sites.end(),
+        [](const auto& left, const auto& right)
+        {
+            return std::tie(left.totalWaitTimeUsec, left.contendedLockCount)
+                > std::tie(right.totalWaitTimeUsec, right.contendedLockCount);
+        });
+
+    if (report.sites.size() > maxSiteCount)
+        report.sites.resize(maxSiteCount);
+
+    return report;
+}
+
+void LockContentionProfiler::clear()
+{
+    for (std::size_t i = 0; i < kMaxSiteCount; ++i)
+    {
+        auto& site = m_sites[i];
+        site.sampledLockCount = 0;
+        site.contendedLockCount = 0;
+        site.totalWaitTimeNsec = 0;
+        site.maxWaitTimeNsec = 0;
+        site.totalHoldTimeNsec = 0;
+        site.maxHoldTimeNsec = 0;
+    }
+    m_droppedSampleCount = 0;
+}
+
+LockContentionProfiler& LockContentionProfiler::instance()
+{
+    // Never destroyed: mutexes of other global objects can be unlocked during the process exit.
+    static auto* const instance =
+        new LockContentionProfiler(utils::ini().mutexProfileSamplingPeriod);
+    return *instance;
+}
+
+} // namespace nx
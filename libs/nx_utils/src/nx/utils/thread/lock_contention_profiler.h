@@ -0,0 +1,122 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <nx/reflect/enum_instrument.h>
+#include <nx/reflect/instrument.h>
+
+namespace nx {
+
+NX_REFLECTION_ENUM_CLASS(LockKind,
+    mutex,
+    readLock,
+    writeLock
+);
+
+struct NX_UTILS_API LockSiteStatistics
+{
+    /** "file:line" of the code that locks. "unknown:0" if the lock was called without it. */
+    std::string location;
+
+    LockKind kind = LockKind::mutex;
+
+    std::uint64_t sampledLockCount = 0;
+
+    /** Number of the sampled locks that were not acquired immediately. */
+    std::uint64_t contendedLockCount = 0;
+
+    std::chrono::microseconds totalWaitTimeUsec{0};
+    std::chrono::microseconds maxWaitTimeUsec{0};
+
+    /** Not measured for the read locks since they can be held by multiple threads. */
+    std::chrono::microseconds totalHoldTimeUsec{0};
+    std::chrono::microseconds maxHoldTimeUsec{0};
+};
+
+#define LockSiteStatistics_Fields \
+    (location)(kind)(sampledLockCount)(contendedLockCount) \
+    (totalWaitTimeUsec)(maxWaitTimeUsec)(totalHoldTimeUsec)(maxHoldTimeUsec)
+
+NX_REFLECTION_INSTRUMENT(LockSiteStatistics, LockSiteStatistics_Fields)
+
+struct NX_UTILS_API LockContentionReport
+{
+    /** Whether the mutexes are created with the profiling delegates. */
+    bool enabled = false;
+
+    /** One of this many lock calls of each thread is measured. */
+    int samplingPeriod = 0;
+
+    /** Samples that were lost because there was no free space for a new lock site. */
+    std::uint64_t droppedSampleCount = 0;
+
+    /** Sorted by totalWaitTimeUsec, the most contended first. */
+    std::vector<LockSiteStatistics> sites;
+};
+
+#define LockContentionReport_Fields (enabled)(samplingPeriod)(droppedSampleCount)(sites)
+
+NX_REFLECTION_INSTRUMENT(LockContentionReport, LockContentionReport_Fields)
+
+/**
+ * Accumulates lock wait and hold times sampled by the profiling mutex delegates (see
+ * MutexImplementations::profile) per lock call site.
+ * Everything here is lock-free: the sites are kept in a fixed-size open addressing table that
+ * is never shrunk, so the pointers returned by site() are valid for the profiler life time.
+ * Unsampled lock calls cost a single thread-local counter increment.
+ */
+class NX_UTILS_API LockContentionProfiler
+{
+public:
+    static constexpr std::size_t kMaxSiteCount = 4096;
+    static constexpr int kDefaultSamplingPeriod = 64;
+
+    struct Site;
+
+    LockContentionProfiler(int samplingPeriod = kDefaultSamplingPeriod);
+    ~LockContentionProfiler();
+
+    LockContentionProfiler(const LockContentionProfiler&) = delete;
+    LockContentionProfiler& operator=(const LockContentionProfiler&) = delete;
+
+    /**
+     * @return true if the current lock call of the calling thread has to be measured.
+     */
+    bool isSampled() const;
+
+    /**
+     * @return nullptr if there is no space for a new site. The sample is counted as dropped then.
+     */
+    Site* site(const char* sourceFile, int sourceLine, LockKind kind);
+
+    void recordWait(Site* site, std::chrono::nanoseconds waitTime, bool isContended);
+    void recordHold(Site* site, std::chrono::nanoseconds holdTime);
+
+    void setSamplingPeriod(int samplingPeriod);
+    int samplingPeriod() const;
+
+    /**
+     * @param maxSiteCount The number of the most contended sites to report.
+     */
+    LockContentionReport report(std::size_t maxSiteCount) const;
+
+    /** Resets the accumulated values. */
+    void clear();
+
+    /** The instance used by the delegates created by the mutex delegate factory. */
+    static LockContentionProfiler& instance();
+
+private:
+    std::unique_ptr<Site[]> m_sites;
+    std::atomic<int> m_samplingPeriod;
+    std::atomic<std::uint64_t> m_droppedSampleCount{0};
+};
+
+} // namespace nx
@@ -6,6 +6,7 @@
 #include <nx/utils/nx_utils_ini.h>
 
 #include "mutex_delegates_debug.h"
+#include "mutex_delegates_profile.h"
 #include "mutex_delegates_std.h"
 #include "mutex_delegates_qt.h"
 
@@ -16,6 +17,7 @@ static constexpr auto kQtName("qt");
 static constexpr auto kStdName("std");
 static constexpr auto kDebugName("debug");
 static constexpr auto kAnalyzeName("analyze");
+static constexpr auto kProfileName("profile");
 
 QString MutexImplementations::toString(Value value)
 {
@@ -26,6 +28,7 @@ QString MutexImplementations::toString(Value value)
         case MutexImplementations::std: return kStdName;
         case MutexImplementations::debug: return kDebugName;
         case MutexImplementations::analyze: return kAnalyzeName;
+        case MutexImplementations::profile: return kProfileName;
     }
 
     NX_ASSERT(false);
@@ -46,6 +49,9 @@ MutexImplementations::Value MutexImplementations::parse(const QString& value)
     if (value == kAnalyzeName)
         return MutexImplementations::analyze;
 
+    if (value == kProfileName)
+        return MutexImplementations::profile;
+
     return MutexImplementations::undefined;
 }
 
@@ -72,6 +78,9 @@ std::unique_ptr<MutexDelegate> makeMutexDelegate(Mutex::RecursionMode mode)
     if (impl & MutexImplementations::qt)
         return std::make_unique<MutexQtDelegate>(mode);
 
+    if (impl & MutexImplementations::profile)
+        return std::make_unique<MutexProfileDelegate>(mode);
+
     if (impl & MutexImplementations::std)
         return std::make_unique<MutexStdDelegate>(mode);
 
@@ -88,6 +97,9 @@ std::unique_ptr<ReadWriteLockDelegate> makeReadWriteLockDelegate(ReadWriteLock::
     if (impl & MutexImplementations::qt)
         return std::make_unique<ReadWriteLockQtDelegate>(mode);
 
+    if (impl & MutexImplementations::profile)
+        return std::make_unique<ReadWriteLockProfileDelegate>(mode);
+
     if (impl & MutexImplementations::std)
         return std::make_unique<ReadWriteLockStdDelegate>(mode);
 
@@ -107,6 +119,9 @@ std::unique_ptr<WaitConditionDelegate> makeWaitConditionDelegate()
     if (impl & MutexImplementations::qt)
         return std::make_unique<WaitConditionQtDelegate>();
 
+    if (impl & MutexImplementations::profile)
+        return std::make_unique<WaitConditionProfileDelegate>();
+
     if (impl & MutexImplementations::std)
         return std::make_unique<WaitConditionStdDelegate>();
 
@@ -15,6 +15,7 @@ namespace MutexImplementations
         std = 1 << 2,
         debug = 1 << 3,
         analyze = 1 << 4 | debug,
+        profile = 1 << 5,
     };
 
     QString NX_UTILS_API toString(Value value);
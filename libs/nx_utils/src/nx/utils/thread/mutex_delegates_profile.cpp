@@ -0,0 +1,264 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "mutex_delegates_profile.h"
+
+#include <climits>
+
+namespace nx {
+
+using namespace std::chrono;
+
+namespace {
+
+/**
+ * Tries to lock without waiting first, so the clock is read once if there is no contention.
+ * @return The site to account the hold time to. nullptr if there is no space for the site.
+ */
+template<typename TryLock, typename Lock>
+LockContentionProfiler::Site* lockSampled(
+    LockContentionProfiler* profiler,
+    const char* sourceFile,
+    int sourceLine,
+    LockKind kind,
+    TryLock tryLock,
+    Lock lock,
+    steady_clock::time_point* lockTime)
+{
+    const auto site = profiler->site(sourceFile, sourceLine, kind);
+
+    if (tryLock())
+    {
+        *lockTime = steady_clock::now();
+        if (site)
+            profiler->recordWait(site, nanoseconds::zero(), /*isContended*/ false);
+        return site;
+    }
+
+    const auto waitStartTime = steady_clock::now();
+    lock();
+    *lockTime = steady_clock::now();
+    if (site)
+        profiler->recordWait(site, *lockTime - waitStartTime, /*isContended*/ true);
+    return site;
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+
+MutexProfileDelegate::MutexProfileDelegate(
+    Mutex::RecursionMode mode,
+    LockContentionProfiler* profiler)
+    :
+    m_profiler(profiler)
+{
+    if (mode == Mutex::NonRecursive)
+        m_mutex = std::make_unique<QMutex>();
+    else
+        m_recursiveMutex = std::make_unique<QRecursiveMutex>();
+}
+
+void MutexProfileDelegate::lock(const char* sourceFile, int sourceLine, int /*lockId*/)
+{
+    if (!m_profiler->isSampled())
+    {
+        if (m_mutex)
+            m_mutex->lock();
+        else
+            m_recursiveMutex->lock();
+        afterLock(nullptr, {});
+        return;
+    }
+
+    steady_clock::time_point lockTime;
+    const auto site = m_mutex
+        ? lockSampled(
+            m_profiler, sourceFile, sourceLine, LockKind::mutex,
+            [this]() { return m_mutex->try_lock(); },
+            [this]() { m_mutex->lock(); },
+            &lockTime)
+        : lockSampled(
+            m_profiler, sourceFile, sourceLine, LockKind::mutex,
+            [this]() { return m_recursiveMutex->try_lock(); },
+            [this]() { m_recursiveMutex->lock(); },
+            &lockTime);
+    afterLock(site, lockTime);
+}
+
+bool MutexProfileDelegate::tryLock(const char* /*sourceFile*/, int /*sourceLine*/, int /*lockId*/)
+{
+    const auto result = m_mutex ? m_mutex->try_lock() : m_recursiveMutex->try_lock();
+    if (result)
+        afterLock(nullptr, {});
+
+    return result;
+}
+
+void MutexProfileDelegate::unlock()
+{
+    beforeUnlock();
+    if (m_mutex)
+        m_mutex->unlock();
+    else
+        m_recursiveMutex->unlock();
+}
+
+bool MutexProfileDelegate::isRecursive() const
+{
+    return (bool) m_recursiveMutex;
+}
+
+void MutexProfileDelegate::afterLock(
+    LockContentionProfiler::Site* sampledSite,
+    steady_clock::time_point lockTime)
+{
+    // The hold time of a recursive mutex is accounted to the outermost lock only.
+    if (m_lockDepth++ == 0 && sampledSite)
+    {
+        m_sampledSite = sampledSite;
+        m_lockTime = lockTime;
+    }
+}
+
+void MutexProfileDelegate::beforeUnlock()
+{
+    if (--m_lockDepth == 0 && m_sampledSite)
+    {
+        m_profiler->recordHold(m_sampledSite, steady_clock::now() - m_lockTime);
+        m_sampledSite = nullptr;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+ReadWriteLockProfileDelegate::ReadWriteLockProfileDelegate(
+    ReadWriteLock::RecursionMode mode,
+    LockContentionProfiler* profiler)
+    :
+    m_delegate((mode == ReadWriteLock::Recursive)
+        ? QReadWriteLock::Recursive
+        : QReadWriteLock::NonRecursive),
+    m_profiler(profiler)
+{
+}
+
+void ReadWriteLockProfileDelegate::lockForRead(
+    const char* sourceFile, int sourceLine, int /*lockId*/)
+{
+    if (m_profiler->isSampled())
+    {
+        steady_clock::time_point lockTime;
+        lockSampled(
+            m_profiler, sourceFile, sourceLine, LockKind::readLock,
+            [this]() { return m_delegate.tryLockForRead(); },
+            [this]() { m_delegate.lockForRead(); },
+            &lockTime);
+    }
+    else
+    {
+        m_delegate.lockForRead();
+    }
+
+    afterLockForRead();
+}
+
+void ReadWriteLockProfileDelegate::lockForWrite(
+    const char* sourceFile, int sourceLine, int /*lockId*/)
+{
+    if (!m_profiler->isSampled())
+    {
+        m_delegate.lockForWrite();
+        afterLockForWrite(nullptr, {});
+        return;
+    }
+
+    steady_clock::time_point lockTime;
+    const auto site = lockSampled(
+        m_profiler, sourceFile, sourceLine, LockKind::writeLock,
+        [this]() { return m_delegate.tryLockForWrite(); },
+        [this]() { m_delegate.lockForWrite(); },
+        &lockTime);
+    afterLockForWrite(site, lockTime);
+}
+
+bool ReadWriteLockProfileDelegate::tryLockForRead(
+    const char* /*sourceFile*/, int /*sourceLine*/, int /*lockId*/)
+{
+    if (!m_delegate.tryLockForRead())
+        return false;
+
+    afterLockForRead();
+    return true;
+}
+
+bool ReadWriteLockProfileDelegate::tryLockForWrite(
+    const char* /*sourceFile*/, int /*sourceLine*/, int /*lockId*/)
+{
+    if (!m_delegate.tryLockForWrite())
+        return false;
+
+    afterLockForWrite(nullptr, {});
+    return true;
+}
+
+void ReadWriteLockProfileDelegate::unlock()
+{
+    if (m_writeLockDepth > 0 && --m_writeLockDepth == 0 && m_sampledSite)
+    {
+        m_profiler->recordHold(m_sampledSite, steady_clock::now() - m_lockTime);
+        m_sampledSite = nullptr;
+    }
+
+    m_delegate.unlock();
+}
+
+void ReadWriteLockProfileDelegate::afterLockForRead()
+{
+    // A recursive lock can be locked for reading by the thread that holds it for writing. The
+    // nested lock is a part of the write lock then.
+    if (m_writeLockDepth > 0)
+        ++m_writeLockDepth;
+}
+
+void ReadWriteLockProfileDelegate::afterLockForWrite(
+    LockContentionProfiler::Site* sampledSite,
+    steady_clock::time_point lockTime)
+{
+    if (m_writeLockDepth++ == 0 && sampledSite)
+    {
+        m_sampledSite = sampledSite;
+        m_lockTime = lockTime;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool WaitConditionProfileDelegate::wait(MutexDelegate* mutex, milliseconds timeout)
+{
+    const auto delegate = static_cast<MutexProfileDelegate*>(mutex);
+    if (!delegate->m_mutex)
+        return true; //< Recursive mutex causes immediate return.
+
+    // The mutex is not held while waiting. Re-locking after the wait is not sampled since it is
+    // not attributed to any lock call.
+    delegate->beforeUnlock();
+
+    const auto result = m_delegate.wait(
+        delegate->m_mutex.get(),
+        timeout == milliseconds::max() ? ULONG_MAX : (unsigned long) timeout.count());
+
+    delegate->afterLock(nullptr, {});
+    return result;
+}
+
+void WaitConditionProfileDelegate::wakeAll()
+{
+    m_delegate.wakeAll();
+}
+
+void WaitConditionProfileDelegate::wakeOne()
+{
+    m_delegate.wakeOne();
+}
+
+} // namespace nx
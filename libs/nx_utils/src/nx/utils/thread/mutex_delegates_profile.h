@@ -0,0 +1,99 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QWaitCondition>
+#include <chrono>
+#include <memory>
+
+#include "lock_contention_profiler.h"
+#include "mutex.h"
+
+namespace nx {
+
+/**
+ * Same as MutexQtDelegate, but measures the wait and hold times of the sampled lock calls
+ * with LockContentionProfiler.
+ */
+class NX_UTILS_API MutexProfileDelegate: public MutexDelegate
+{
+public:
+    MutexProfileDelegate(
+        Mutex::RecursionMode mode,
+        LockContentionProfiler* profiler = &LockContentionProfiler::instance());
+
+    virtual void lock(const char* sourceFile, int sourceLine, int lockId) override;
+    virtual bool tryLock(const char* sourceFile, int sourceLine, int lockId) override;
+
+    virtual void unlock() override;
+    virtual bool isRecursive() const override;
+
+private:
+    friend class WaitConditionProfileDelegate;
+
+    void afterLock(
+        LockContentionProfiler::Site* sampledSite,
+        std::chrono::steady_clock::time_point lockTime);
+    void beforeUnlock();
+
+private:
+    std::unique_ptr<QMutex> m_mutex;
+    std::unique_ptr<QRecursiveMutex> m_recursiveMutex;
+    LockContentionProfiler* const m_profiler;
+
+    // Accessed by the thread holding the mutex only.
+    int m_lockDepth = 0;
+    LockContentionProfiler::Site* m_sampledSite = nullptr;
+    std::chrono::steady_clock::time_point m_lockTime;
+};
+
+/**
+ * Same as ReadWriteLockQtDelegate, but measures the wait times of the sampled lock calls and the
+ * hold times of the sampled write locks with LockContentionProfiler.
+ */
+class NX_UTILS_API ReadWriteLockProfileDelegate: public ReadWriteLockDelegate
+{
+public:
+    ReadWriteLockProfileDelegate(
+        ReadWriteLock::RecursionMode mode,
+        LockContentionProfiler* profiler = &LockContentionProfiler::instance());
+
+    virtual void lockForRead(const char* sourceFile, int sourceLine, int lockId) override;
+    virtual void lockForWrite(const char* sourceFile, int sourceLine, int lockId) override;
+
+    virtual bool tryLockForRead(const char* sourceFile, int sourceLine, int lockId) override;
+    virtual bool tryLockForWrite(const char* sourceFile, int sourceLine, int lockId) override;
+
+    virtual void unlock() override;
+
+private:
+    void afterLockForRead();
+    void afterLockForWrite(
+        LockContentionProfiler::Site* sampledSite,
+        std::chrono::steady_clock::time_point lockTime);
+
+private:
+    QReadWriteLock m_delegate;
+    LockContentionProfiler* const m_profiler;
+
+    // Modified only while the lock is held for writing, so never concurrently. The readers can
+    // only see 0 here.
+    int m_writeLockDepth = 0;
+    LockContentionProfiler::Site* m_sampledSite = nullptr;
+    std::chrono::steady_clock::time_point m_lockTime;
+};
+
+class NX_UTILS_API WaitConditionProfileDelegate: public WaitConditionDelegate
+{
+public:
+    virtual bool wait(MutexDelegate* mutex, std::chrono::milliseconds timeout) override;
+    virtual void wakeAll() override;
+    virtual void wakeOne() override;
+
+private:
+    QWaitCondition m_delegate;
+};
+
+} // namespace nx
@@ -0,0 +1,86 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "read_epoch.h"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace nx::utils {
+
+namespace {
+
+static constexpr std::size_t kCacheLineSize = 64;
+static constexpr std::size_t kMinStripeCount = 4;
+static constexpr std::size_t kMaxStripeCount = 256;
+
+std::atomic<std::size_t> sNextThreadIndex{0};
+
+std::size_t threadIndex()
+{
+    thread_local const std::size_t index = sNextThreadIndex++;
+    return index;
+}
+
+} // namespace
+
+struct alignas(kCacheLineSize) ReadEpoch::Stripe
+{
+    /** The number of readers that entered in the even and in the odd epoch. */
+    std::atomic<std::int64_t> readerCount[2] = {0, 0};
+};
+
+//-------------------------------------------------------------------------------------------------
+
+ReadEpoch::ReadGuard::ReadGuard(const ReadEpoch* epoch):
+    m_stripe(&epoch->threadStripe())
+{
+    // The reader is registered in the epoch that is still current after the registration, so
+    // a synchronize() that flips that epoch later is guaranteed to wait for the reader. Whatever
+    // the reader loads after this was published before any such synchronize() call.
+    for (;;)
+    {
+        m_epoch = epoch->m_epoch.load();
+        m_stripe->readerCount[m_epoch].fetch_add(1);
+        if (epoch->m_epoch.load() == m_epoch)
+            return;
+        m_stripe->readerCount[m_epoch].fetch_sub(1, std::memory_order_release);
+    }
+}
+
+ReadEpoch::ReadGuard::~ReadGuard()
+{
+    m_stripe->readerCount[m_epoch].fetch_sub(1, std::memory_order_release);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+ReadEpoch::ReadEpoch():
+    m_stripeCount(std::bit_ceil(std::clamp<std::size_t>(
+        2 * std::thread::hardware_concurrency(), kMinStripeCount, kMaxStripeCount))),
+    m_stripes(new Stripe[m_stripeCount])
+{
+}
+
+ReadEpoch::~ReadEpoch() = default;
+
+void ReadEpoch::synchronize()
+{
+    NX_MUTEX_LOCKER lock(&m_synchronizeMutex);
+
+    const int previousEpoch = m_epoch.load();
+    m_epoch.store(1 - previousEpoch);
+
+    for (std::size_t i = 0; i < m_stripeCount; ++i)
+    {
+        while (m_stripes[i].readerCount[previousEpoch].load() != 0)
+            std::this_thread::yield();
+    }
+}
+
+ReadEpoch::Stripe& ReadEpoch::threadStripe() const
+{
+    return m_stripes[threadIndex() & (m_stripeCount - 1)];
+}
+
+} // namespace nx::utils
@@ -0,0 +1,68 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::utils {
+
+/**
+ * Epoch-based reclamation for read-mostly data, similar to the user-space RCU.
+ *
+ * Readers access an object published through an atomic pointer without locking anything: they
+ * only wrap the access in a ReadGuard. A writer publishes a new version of the object, calls
+ * synchronize() and then frees the old version: synchronize() returns when every reader that
+ * could have seen the old version has left its ReadGuard.
+ *
+ * Readers are counted in per-thread stripes to avoid contention on a single cache line.
+ * ReadGuard is cheap (two atomic increments on a thread-local cache line), synchronize() is not:
+ * it waits for the current readers and is serialized with other synchronize() calls.
+ * synchronize() MUST NOT be called under a ReadGuard.
+ */
+class NX_UTILS_API ReadEpoch
+{
+    struct Stripe;
+
+public:
+    class NX_UTILS_API ReadGuard
+    {
+    public:
+        ReadGuard(const ReadEpoch* epoch);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        Stripe* m_stripe = nullptr;
+        int m_epoch = 0;
+    };
+
+    ReadEpoch();
+    ~ReadEpoch();
+
+    ReadEpoch(const ReadEpoch&) = delete;
+    ReadEpoch& operator=(const ReadEpoch&) = delete;
+
+    ReadGuard read() const { return ReadGuard(this); }
+
+    /**
+     * Waits until all readers that entered a ReadGuard before this call have left it.
+     */
+    void synchronize();
+
+private:
+    Stripe& threadStripe() const;
+
+private:
+    std::size_t m_stripeCount = 0;
+    std::unique_ptr<Stripe[]> m_stripes;
+    std::atomic<int> m_epoch{0};
+    nx::Mutex m_synchronizeMutex;
+};
+
+} // namespace nx::utils
@@ -7,6 +7,8 @@
 #include <cstdio>
 #include <memory>
 #include <mutex>
+#include <sstream>
+#include <vector>
 
 #include <concurrentqueue.h>
 
@@ -28,20 +30,65 @@ namespace {
 constexpr auto kCapacity = 10'000;
 constexpr auto kDumpPeriod = 1s;
 
-class Queue
+struct Event
 {
-private:
-    struct Event
+    Log::EventPhase phase;
+    int64_t id; //< Thread id or object id.
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    const char* name;
+    const char* category;
+    std::unique_ptr<QJsonObject> args;
+};
+
+void writeEvent(std::ostream& os, const Event& event, qint64 pid)
+{
+    const auto ts = duration_cast<microseconds>(event.start.time_since_epoch()).count();
+
+    os << "{\"pid\":" << pid
+        << ",\"ts\":" << ts
+        << ",\"ph\":\"" << static_cast<char>(event.phase) << "\""
+        << ",\"cat\":\"" << event.category << "\"";
+    switch (event.phase)
     {
-        Log::EventPhase phase;
-        int64_t id; //< Thread id or object id.
-        std::chrono::steady_clock::time_point start;
-        std::chrono::steady_clock::time_point end;
-        const char* name;
-        const char* category;
-        std::unique_ptr<QJsonObject> args;
-    };
+        case Log::EventPhase::Begin:
+        case Log::EventPhase::End:
+            os << ",\"tid\":" << event.id;
+            break;
+        case Log::EventPhase::Complete:
+        {
+            os << ",\"tid\":" << event.id;
+            const auto dur = duration_cast<microseconds>(event.end - event.start).count();
+            os << ",\"dur\":" << dur;
+            break;
+        }
+        case Log::EventPhase::Instant:
+            os << ",\"tid\":" << event.id;
+            os << ",\"s\":\"p\"";
+            break;
+        case Log::EventPhase::Counter:
+            if (event.id != -1)
+                os << ",\"id\":" << event.id;
+            break;
+        case Log::EventPhase::BeginAsync:
+        case Log::EventPhase::InstantAsync:
+        case Log::EventPhase::EndAsync:
+            os << ",\"id2\":{\"local\":" << event.id << "}";
+            break;
+        default:
+            break;
+    }
+    if (event.args)
+    {
+        const auto buf = QJsonDocument(*event.args.get()).toJson(QJsonDocument::Compact);
+        os << ",\"args\": " << buf.constData();
+    }
 
+    os << ",\"name\":\"" << event.name << "\"}";
+}
+
+class Queue
+{
 public:
     Queue(Queue const&) = delete;
     Queue(Queue&&) = delete;
@@ -87,41 +134,9 @@ public:
         return i;
     }
 
-    void addCompleteEvent(
-        const steady_clock::time_point& start,
-        const steady_clock::time_point& end,
-        const char* name,
-        const char* category,
-        std::unique_ptr<QJsonObject> args)
-    {
-        m_queue.try_enqueue({
-            Log::EventPhase::Complete,
-            static_cast<int64_t>(currentThreadSystemId()),
-            start,
-            end,
-            name,
-            category,
-            std::move(args)
-        });
-    }
-
-    void addEvent(
-        Log::EventPhase phase,
-        const steady_clock::time_point& timeStamp,
-        const char* name,
-        const char* category,
-        int64_t id,
-        std::unique_ptr<QJsonObject> args)
+    void add(Event event)
     {
-        m_queue.try_enqueue({
-            phase,
-            id,
-            timeStamp,
-            timeStamp, //< 0 duration
-            name,
-            category,
-            std::move(args)
-        });
+        m_queue.try_enqueue(std::move(event));
     }
 
 private:
@@ -163,50 +178,8 @@ private:
 
         for (size_t i = 0; i != count; ++i)
         {
-            const auto& event = events[i];
-
-            const auto ts = duration_cast<microseconds>(event.start.time_since_epoch()).count();
-
-            ofs << "{\"pid\":" << pid
-                << ",\"ts\":" << ts
-                << ",\"ph\":\"" << static_cast<char>(event.phase) << "\"";
-                    ofs << ",\"cat\":\"" << event.category << "\"";
-            switch (event.phase)
-            {
-                case Log::EventPhase::Begin:
-                    break;
-                case Log::EventPhase::End:
-                    break;
-                case Log::EventPhase::Complete:
-                {
-                    ofs << ",\"tid\":" << event.id;
-                    const auto dur = duration_cast<microseconds>(event.end - event.start).count();
-                    ofs << ",\"dur\":" << dur;
-                    break;
-                }
-                case Log::EventPhase::Instant:
-                    ofs << ",\"tid\":" << event.id;
-                    ofs << ",\"s\":\"p\"";
-                    break;
-                case Log::EventPhase::Counter:
-                    if (event.id != -1)
-                        ofs << ",\"id\":" << event.id;
-                    break;
-                case Log::EventPhase::BeginAsync:
-                case Log::EventPhase::InstantAsync:
-                case Log::EventPhase::EndAsync:
-                    ofs << ",\"id2\":{\"local\":" << event.id << "}";
-                    break;
-                default:
-                    break;
-            }
-            if (event.args)
-            {
-                const auto buf = QJsonDocument(*event.args.get()).toJson(QJsonDocument::Compact);
-                ofs << ",\"args\": " << buf.constData();
-            }
-
-            ofs << ",\"name\":\"" << event.name << "\"},\n";
+            writeEvent(ofs, events[i], pid);
+            ofs << ",\n";
         }
 
         ofs.close();
@@ -218,6 +191,161 @@ private:
     std::unique_ptr<QThread> m_thread;
 };
 
+/**
+ * Events of one thread. The mutex is only contended while the recording is exported or
+ * restarted, so writing an event costs an uncontended lock and a move into preallocated storage.
+ */
+class ThreadBuffer
+{
+public:
+    ThreadBuffer(size_t capacity):
+        m_threadId(static_cast<int64_t>(currentThreadSystemId())),
+        m_threadName(QThread::currentThread()->objectName().toStdString())
+    {
+        reset(capacity);
+    }
+
+    void reset(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.clear();
+        m_events.reserve(capacity);
+        m_capacity = capacity;
+        m_next = 0;
+    }
+
+    void add(Event event)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_events.size() < m_capacity)
+        {
+            m_events.push_back(std::move(event));
+            return;
+        }
+
+        if (m_capacity == 0)
+            return;
+
+        m_events[m_next] = std::move(event); //< Overwrite the oldest event.
+        m_next = (m_next + 1) % m_capacity;
+    }
+
+    void write(std::ostream& os, qint64 pid, bool* isFirst)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_events.empty())
+            return;
+
+        if (!m_threadName.empty())
+        {
+            const auto args = QJsonDocument(QJsonObject{{"name", m_threadName.c_str()}})
+                .toJson(QJsonDocument::Compact);
+            os << (*isFirst ? "\n" : ",\n")
+                << "{\"pid\":" << pid << ",\"tid\":" << m_threadId
+                << ",\"ph\":\"M\",\"name\":\"thread_name\",\"args\":" << args.constData() << "}";
+            *isFirst = false;
+        }
+
+        for (size_t i = 0; i < m_events.size(); ++i)
+        {
+            os << (*isFirst ? "\n" : ",\n");
+            writeEvent(os, m_events[(m_next + i) % m_events.size()], pid);
+            *isFirst = false;
+        }
+    }
+
+    void setFinished() { m_finished = true; }
+    bool isFinished() const { return m_finished; }
+
+private:
+    const int64_t m_threadId;
+    const std::string m_threadName;
+    std::mutex m_mutex;
+    std::vector<Event> m_events;
+    size_t m_capacity = 0;
+    size_t m_next = 0;
+    std::atomic<bool> m_finished = false;
+};
+
+class Recorder
+{
+public:
+    static Recorder& instance()
+    {
+        static Recorder i;
+        return i;
+    }
+
+    void start(size_t eventsPerThread)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_eventsPerThread = eventsPerThread;
+
+        // Buffers of the finished threads are kept until here so their events can be exported.
+        std::erase_if(m_buffers, [](const auto& buffer) { return buffer->isFinished(); });
+        for (const auto& buffer: m_buffers)
+            buffer->reset(eventsPerThread);
+    }
+
+    void add(Event event)
+    {
+        threadBuffer().add(std::move(event));
+    }
+
+    std::string exportJson()
+    {
+        std::ostringstream os;
+        os << "{\"traceEvents\":[";
+
+        const auto pid = QCoreApplication::applicationPid();
+        bool isFirst = true;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& buffer: m_buffers)
+                buffer->write(os, pid, &isFirst);
+        }
+
+        os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        return os.str();
+    }
+
+private:
+    class ThreadBufferHolder
+    {
+    public:
+        ThreadBufferHolder(Recorder* recorder)
+        {
+            std::lock_guard<std::mutex> lock(recorder->m_mutex);
+            buffer = std::make_shared<ThreadBuffer>(recorder->m_eventsPerThread);
+            recorder->m_buffers.push_back(buffer);
+        }
+
+        ~ThreadBufferHolder() { buffer->setFinished(); }
+
+        std::shared_ptr<ThreadBuffer> buffer;
+    };
+
+    ThreadBuffer& threadBuffer()
+    {
+        thread_local ThreadBufferHolder holder(this);
+        return *holder.buffer;
+    }
+
+    std::mutex m_mutex;
+    size_t m_eventsPerThread = Log::kDefaultEventsPerThread;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+};
+
+std::atomic<bool> isRecording(false);
+
+void reportEvent(Event event)
+{
+    if (isRecording.load(std::memory_order_relaxed))
+        Recorder::instance().add(std::move(event));
+    else
+        Queue::instance().add(std::move(event));
+}
+
 } // namespace
 
 std::atomic<bool> Log::m_enabled(false);
@@ -238,24 +366,53 @@ bool Log::enable(const std::string& path)
     return true;
 }
 
+bool Log::startRecording(size_t eventsPerThread)
+{
+    if (isEnabled())
+        return false;
+
+    Recorder::instance().start(eventsPerThread);
+    isRecording = true;
+
+    bool expected = false;
+    if (!m_enabled.compare_exchange_strong(expected, true))
+    {
+        isRecording = false;
+        return false;
+    }
+    return true;
+}
+
 void Log::disable()
 {
     if (!isEnabled())
         return;
 
+    if (isRecording)
+    {
+        m_enabled = false;
+        isRecording = false;
+        return;
+    }
+
     Queue::instance().stopThread();
     m_enabled = false;
 }
 
-Log Log::event(EventPhase phase, const char* name)
+std::string Log::exportRecording()
+{
+    return Recorder::instance().exportJson();
+}
+
+Log Log::event(EventPhase phase, const char* name, const char* category)
 {
     const auto id = static_cast<int64_t>(currentThreadSystemId());
-    return Log(phase, name, id, steady_clock::now());
+    return Log(phase, name, category, id, steady_clock::now());
 }
 
-Log Log::eventAsync(EventPhase phase, const char* name, int64_t id)
+Log Log::eventAsync(EventPhase phase, const char* name, int64_t id, const char* category)
 {
-    return Log(phase, name, id, steady_clock::now());
+    return Log(phase, name, category, id, steady_clock::now());
 }
 
 void Log::args(QJsonObject&& data)
@@ -263,9 +420,16 @@ void Log::args(QJsonObject&& data)
     m_args = std::make_unique<QJsonObject>(std::move(data));
 }
 
-Log::Log(EventPhase phase, const char* name, int64_t id, std::chrono::steady_clock::time_point ts):
+Log::Log(
+    EventPhase phase,
+    const char* name,
+    const char* category,
+    int64_t id,
+    std::chrono::steady_clock::time_point ts)
+    :
     m_phase(phase),
     m_name(name),
+    m_category(category),
     m_id(id),
     m_timeStamp(ts)
 {
@@ -275,7 +439,15 @@ Log::~Log()
 {
     if (!Log::isEnabled())
         return;
-    Queue::instance().addEvent(m_phase, m_timeStamp, m_name, "", m_id, std::move(m_args));
+    reportEvent({
+        m_phase,
+        m_id,
+        m_timeStamp,
+        m_timeStamp, //< 0 duration
+        m_name,
+        m_category,
+        std::move(m_args)
+    });
 }
 
 void Scope::args(QJsonObject&& data)
@@ -287,7 +459,15 @@ void Scope::report()
 {
     auto endTime = steady_clock::now();
     ArgsType* ptr = reinterpret_cast<ArgsType*>(&m_data);
-    Queue::instance().addCompleteEvent(m_startTime, endTime, m_name, "", std::move(*ptr));
+    reportEvent({
+        Log::EventPhase::Complete,
+        static_cast<int64_t>(currentThreadSystemId()),
+        m_startTime,
+        endTime,
+        m_name,
+        m_category,
+        std::move(*ptr)
+    });
     ptr->~ArgsType();
 }
 
@@ -10,6 +10,12 @@
 
 #include <stdint.h>
 
+// Building with NX_TRACE_ENABLED=0 compiles out every NX_TRACE_* macro: the arguments are still
+// type-checked, but no code is generated.
+#if !defined(NX_TRACE_ENABLED)
+    #define NX_TRACE_ENABLED 1
+#endif
+
 class QJsonObject;
 
 namespace nx::utils::trace {
@@ -32,6 +38,11 @@ namespace nx::utils::trace {
 // This is OK since Chrome can not consume tracing files which are large enough (depends on RAM).
 // The assert is generated by the dumping thread whenever the queue is more than 90% full.
 //
+// Alternatively, the events can be recorded in memory (see Log::startRecording()). Then each
+// thread writes into its own ring buffer, keeping only the latest events, and the recording is
+// exported as Chrome/Perfetto trace JSON on demand (e.g. from a debug REST handler or a client
+// action), so tracing can stay on in production without filling the disk.
+//
 // Scope::Scope(), Scope::~Scope() and Log::isEnabled() should be inlined because we would like
 // to do as little work as possible when profiling is not enabled.
 
@@ -61,29 +72,53 @@ public:
     Log& operator=(Log const&) = delete;
     Log& operator=(Log&&) = delete;
 
+    static constexpr size_t kDefaultEventsPerThread = 16 * 1024;
+
+    /** Starts dumping the events to the file at the given path every second. */
     static bool enable(const std::string& path);
+
+    /**
+     * Starts recording the events into per-thread ring buffers of the given capacity. The events
+     * recorded before are dropped.
+     */
+    static bool startRecording(size_t eventsPerThread = kDefaultEventsPerThread);
+
+    /** Stops both the file dump and the recording. The recorded events remain exportable. */
     static void disable();
 
+    /**
+     * @return The recorded events in the Trace Event Format JSON object, which is accepted by
+     * chrome://tracing and ui.perfetto.dev. Can be called while recording.
+     */
+    static std::string exportRecording();
+
     static bool isEnabled()
     {
-        return m_enabled.load();
+        return m_enabled.load(std::memory_order_relaxed);
     }
 
-    static Log eventAsync(EventPhase phase, const char* name, int64_t id);
+    static Log eventAsync(
+        EventPhase phase, const char* name, int64_t id, const char* category = "");
 
-    static Log event(EventPhase phase, const char* name);
+    static Log event(EventPhase phase, const char* name, const char* category = "");
 
     void args(QJsonObject&& data);
 
     ~Log();
 
 private:
-    Log(EventPhase phase, const char* name, int64_t id, std::chrono::steady_clock::time_point ts);
+    Log(
+        EventPhase phase,
+        const char* name,
+        const char* category,
+        int64_t id,
+        std::chrono::steady_clock::time_point ts);
 
     static std::atomic<bool> m_enabled;
 
     EventPhase m_phase;
     const char* m_name;
+    const char* m_category;
     int64_t m_id;
     std::chrono::steady_clock::time_point m_timeStamp;
     std::unique_ptr<QJsonObject> m_args;
@@ -100,7 +135,7 @@ public:
     Scope& operator=(Scope const&) = delete;
     Scope& operator=(Scope&&) = delete;
 
-    Scope(const char* name)
+    Scope(const char* name, const char* category = "")
     {
         if (!Log::isEnabled())
         {
@@ -109,6 +144,7 @@ public:
         }
 
         m_name = name;
+        m_category = category;
         m_startTime = std::chrono::steady_clock::now();
 
         // It is not possible to inline destructor code with incomplete QJsonObject.
@@ -135,6 +171,7 @@ private:
 
     std::chrono::steady_clock::time_point m_startTime;
     const char* m_name;
+    const char* m_category;
     std::aligned_storage_t<sizeof(ArgsType), alignof(ArgsType)> m_data;
 };
 
@@ -145,7 +182,7 @@ private:
 #define _NX_TRACE_CONCAT(x, y) _NX_TRACE_CONCAT_(x, y)
 #define _NX_TRACE_UNIQUE(varname) _NX_TRACE_CONCAT(varname, __LINE__)
 
-// Check that legal constexpr string is passed as event name.
+// Check that legal constexpr string is passed as event name or category.
 #define _NX_TRACE_CHECK_LITERAL(name) \
     if constexpr([&]{ \
         static_assert( \
@@ -154,33 +191,57 @@ private:
         return true; \
     }())
 
-// Convenience macros for generating trace events.
+#if NX_TRACE_ENABLED
+    #define _NX_TRACE_IF_ENABLED if (nx::utils::trace::Log::isEnabled())
+#else
+    #define _NX_TRACE_IF_ENABLED if constexpr (false)
+#endif
+
+// Convenience macros for generating trace events. The category is used to filter the events in
+// the viewer, e.g. "aio", "http", "frame".
 
 // Complete event
 // Usage:
 //   NX_TRACE_SCOPE("event").args({{"location": "path"}});
 //   where .args() call is optional.
-#define NX_TRACE_SCOPE(name) \
-    nx::utils::trace::Scope _NX_TRACE_UNIQUE(_trace_scope)(name); \
-    _NX_TRACE_CHECK_LITERAL(name) \
-    if (nx::utils::trace::Log::isEnabled()) _NX_TRACE_UNIQUE(_trace_scope)
-
-#define _NX_TRACE_EVENT(phase, name) \
-    _NX_TRACE_CHECK_LITERAL(name) \
-    if (nx::utils::trace::Log::isEnabled()) \
-        nx::utils::trace::Log::event(nx::utils::trace::Log::Event##phase, (name))
-
-#define _NX_TRACE_EVENT_ASYNC(phase, name, id) \
-    _NX_TRACE_CHECK_LITERAL(name) \
-    if (nx::utils::trace::Log::isEnabled()) \
-        nx::utils::trace::Log::eventAsync(nx::utils::trace::Log::Event##phase, (name), (id))
+#if NX_TRACE_ENABLED
+    #define NX_TRACE_CATEGORY_SCOPE(category, name) \
+        nx::utils::trace::Scope _NX_TRACE_UNIQUE(_trace_scope)((name), (category)); \
+        _NX_TRACE_CHECK_LITERAL(name) _NX_TRACE_CHECK_LITERAL(category) \
+        if (nx::utils::trace::Log::isEnabled()) _NX_TRACE_UNIQUE(_trace_scope)
+#else
+    #define NX_TRACE_CATEGORY_SCOPE(category, name) \
+        _NX_TRACE_CHECK_LITERAL(name) _NX_TRACE_CHECK_LITERAL(category) \
+        if constexpr (false) nx::utils::trace::Scope((name), (category))
+#endif
+#define NX_TRACE_SCOPE(name) NX_TRACE_CATEGORY_SCOPE("", name)
+
+#define _NX_TRACE_EVENT(phase, name, category) \
+    _NX_TRACE_CHECK_LITERAL(name) _NX_TRACE_CHECK_LITERAL(category) \
+    _NX_TRACE_IF_ENABLED \
+        nx::utils::trace::Log::event(nx::utils::trace::Log::Event##phase, (name), (category))
+
+#define _NX_TRACE_EVENT_ASYNC(phase, name, id, category) \
+    _NX_TRACE_CHECK_LITERAL(name) _NX_TRACE_CHECK_LITERAL(category) \
+    _NX_TRACE_IF_ENABLED \
+        nx::utils::trace::Log::eventAsync( \
+            nx::utils::trace::Log::Event##phase, (name), (id), (category))
 
 // Other events
-#define NX_TRACE_COUNTER(name) _NX_TRACE_EVENT_ASYNC(Phase::Counter, (name), -1)
-#define NX_TRACE_COUNTER_ID(name, id) _NX_TRACE_EVENT_ASYNC(Phase::Counter, (name), (id))
-#define NX_TRACE_BEGIN(name) _NX_TRACE_EVENT(Phase::Begin, (name))
-#define NX_TRACE_END(name) _NX_TRACE_EVENT(Phase::End, (name))
-#define NX_TRACE_INSTANT(name) _NX_TRACE_EVENT(Phase::Instant, (name))
-#define NX_TRACE_BEGIN_ASYNC(name, id) _NX_TRACE_EVENT_ASYNC(Phase::BeginAsync, (name), (id))
-#define NX_TRACE_END_ASYNC(name, id) _NX_TRACE_EVENT_ASYNC(Phase::EndAsync, (name), (id))
-#define NX_TRACE_INSTANT_ASYNC(name, id) _NX_TRACE_EVENT_ASYNC(Phase::InstantAsync, (name), (id))
+#define NX_TRACE_COUNTER(name) _NX_TRACE_EVENT_ASYNC(Phase::Counter, (name), -1, "")
+#define NX_TRACE_COUNTER_ID(name, id) _NX_TRACE_EVENT_ASYNC(Phase::Counter, (name), (id), "")
+#define NX_TRACE_BEGIN(name) _NX_TRACE_EVENT(Phase::Begin, (name), "")
+#define NX_TRACE_END(name) _NX_TRACE_EVENT(Phase::End, (name), "")
+#define NX_TRACE_INSTANT(name) _NX_TRACE_EVENT(Phase::Instant, (name), "")
+#define NX_TRACE_BEGIN_ASYNC(name, id) NX_TRACE_CATEGORY_BEGIN_ASYNC("", name, id)
+#define NX_TRACE_END_ASYNC(name, id) NX_TRACE_CATEGORY_END_ASYNC("", name, id)
+#define NX_TRACE_INSTANT_ASYNC(name, id) NX_TRACE_CATEGORY_INSTANT_ASYNC("", name, id)
+
+#define NX_TRACE_CATEGORY_INSTANT(category, name) \
+    _NX_TRACE_EVENT(Phase::Instant, (name), (category))
+#define NX_TRACE_CATEGORY_BEGIN_ASYNC(category, name, id) \
+    _NX_TRACE_EVENT_ASYNC(Phase::BeginAsync, (name), (id), (category))
+#define NX_TRACE_CATEGORY_END_ASYNC(category, name, id) \
+    _NX_TRACE_EVENT_ASYNC(Phase::EndAsync, (name), (id), (category))
+#define NX_TRACE_CATEGORY_INSTANT_ASYNC(category, name, id) \
+    _NX_TRACE_EVENT_ASYNC(Phase::InstantAsync, (name), (id), (category))
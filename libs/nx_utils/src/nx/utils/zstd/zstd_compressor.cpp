@@ -0,0 +1,137 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "zstd_compressor.h"
+
+#include <cstring>
+
+#include <zstd.h>
+
+#include <nx/utils/byte_stream/custom_output_stream.h>
+#include <nx/utils/log/log.h>
+
+#include "zstd_uncompressor.h"
+
+namespace nx::utils::bstream::zstd {
+
+static constexpr unsigned char kFrameMagic[] = {0x28, 0xb5, 0x2f, 0xfd};
+
+class Compressor::Private
+{
+public:
+    ZSTD_CCtx* context = nullptr;
+    nx::Buffer outputBuffer;
+    bool frameStarted = false;
+    bool failed = false;
+};
+
+Compressor::Compressor(
+    const std::shared_ptr<AbstractByteStreamFilter>& nextFilter,
+    int compressionLevel)
+    :
+    AbstractByteStreamFilter(nextFilter),
+    d(std::make_unique<Private>())
+{
+    d->context = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(d->context, ZSTD_c_compressionLevel, compressionLevel);
+    d->outputBuffer.resize(ZSTD_CStreamOutSize());
+}
+
+Compressor::~Compressor()
+{
+    ZSTD_freeCCtx(d->context);
+}
+
+bool Compressor::processData(const ConstBufferRefType& data)
+{
+    if (d->failed)
+        return false;
+    if (data.empty())
+        return true;
+
+    d->frameStarted = true;
+    ZSTD_inBuffer input{data.data(), data.size(), 0};
+    while (input.pos < input.size)
+    {
+        ZSTD_outBuffer output{d->outputBuffer.data(), d->outputBuffer.size(), 0};
+        const auto result = ZSTD_compressStream2(d->context, &output, &input, ZSTD_e_continue);
+        if (ZSTD_isError(result))
+        {
+            NX_DEBUG(this, "Compression failed: %1", ZSTD_getErrorName(result));
+            d->failed = true;
+            return false;
+        }
+
+        if (output.pos > 0 &&
+            !m_nextFilter->processData(ConstBufferRefType(d->outputBuffer.data(), output.pos)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t Compressor::flush()
+{
+    if (d->failed || !d->frameStarted)
+        return 0;
+
+    std::size_t bytesFlushed = 0;
+    ZSTD_inBuffer input{nullptr, 0, 0};
+    for (;;)
+    {
+        ZSTD_outBuffer output{d->outputBuffer.data(), d->outputBuffer.size(), 0};
+        const auto bytesLeft = ZSTD_compressStream2(d->context, &output, &input, ZSTD_e_end);
+        if (ZSTD_isError(bytesLeft))
+        {
+            NX_DEBUG(this, "Compression failed: %1", ZSTD_getErrorName(bytesLeft));
+            d->failed = true;
+            return bytesFlushed;
+        }
+
+        if (output.pos > 0)
+        {
+            m_nextFilter->processData(ConstBufferRefType(d->outputBuffer.data(), output.pos));
+            bytesFlushed += output.pos;
+        }
+
+        if (bytesLeft == 0)
+            break;
+    }
+
+    d->frameStarted = false;
+    return bytesFlushed;
+}
+
+nx::Buffer Compressor::compressData(const ConstBufferRefType& data, int compressionLevel)
+{
+    // The context allocation is much more expensive than compressing a small payload.
+    struct ContextDeleter { void operator()(ZSTD_CCtx* context) { ZSTD_freeCCtx(context); } };
+    thread_local std::unique_ptr<ZSTD_CCtx, ContextDeleter> context(ZSTD_createCCtx());
+
+    nx::Buffer result;
+    result.resize(ZSTD_compressBound(data.size()));
+    const auto size = ZSTD_compressCCtx(
+        context.get(), result.data(), result.size(), data.data(), data.size(), compressionLevel);
+    if (ZSTD_isError(size))
+    {
+        NX_DEBUG(typeid(Compressor), "Compression failed: %1", ZSTD_getErrorName(size));
+        return nx::Buffer();
+    }
+
+    result.resize(size);
+    return result;
+}
+
+nx::Buffer Compressor::uncompressData(const nx::Buffer& data)
+{
+    return runBytesThroughFilter<Uncompressor>(data);
+}
+
+bool Compressor::isZstdCompressed(const ConstBufferRefType& data)
+{
+    return data.size() >= sizeof(kFrameMagic) &&
+        std::memcmp(data.data(), kFrameMagic, sizeof(kFrameMagic)) == 0;
+}
+
+} // namespace nx::utils::bstream::zstd
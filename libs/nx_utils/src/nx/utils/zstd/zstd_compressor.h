@@ -0,0 +1,62 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <memory>
+
+#include <nx/utils/byte_stream/abstract_byte_stream_filter.h>
+
+namespace nx::utils::bstream::zstd {
+
+/**
+ * zstd level that gives about the gzip compression ratio several times faster.
+ */
+static constexpr int kDefaultCompressionLevel = 3;
+
+/**
+ * Compresses the byte stream into zstd (RFC 8878) frames. Suitable for the "zstd" http content
+ * encoding.
+ * The compression context is kept between processData() calls, so the data is compressed as a
+ * single frame until flush() is called. flush() ends the frame, the next processData() starts
+ * a new one. A concatenation of frames is a valid zstd stream.
+ * NOTE: Not thread-safe.
+ */
+class NX_UTILS_API Compressor: public AbstractByteStreamFilter
+{
+public:
+    /**
+     * @param compressionLevel zstd compression level: from ZSTD_minCLevel() (negative, fastest)
+     * to ZSTD_maxCLevel(). 0 stands for the zstd default.
+     */
+    Compressor(
+        const std::shared_ptr<AbstractByteStreamFilter>& nextFilter = nullptr,
+        int compressionLevel = kDefaultCompressionLevel);
+    virtual ~Compressor() override;
+
+    using AbstractByteStreamFilter::processData;
+
+    virtual bool processData(const ConstBufferRefType& data) override;
+
+    /**
+     * Ends the current frame.
+     */
+    virtual size_t flush() override;
+
+    /**
+     * Compresses the data into a single frame.
+     * @return Empty buffer on error.
+     */
+    static nx::Buffer compressData(
+        const ConstBufferRefType& data,
+        int compressionLevel = kDefaultCompressionLevel);
+
+    static nx::Buffer uncompressData(const nx::Buffer& data);
+
+    static bool isZstdCompressed(const ConstBufferRefType& data);
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace nx::utils::bstream::zstd
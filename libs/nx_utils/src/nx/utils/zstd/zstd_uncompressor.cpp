@@ -0,0 +1,67 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "zstd_uncompressor.h"
+
+#include <zstd.h>
+
+#include <nx/utils/log/log.h>
+
+namespace nx::utils::bstream::zstd {
+
+class Uncompressor::Private
+{
+public:
+    ZSTD_DCtx* context = nullptr;
+    nx::Buffer outputBuffer;
+    bool failed = false;
+};
+
+Uncompressor::Uncompressor(const std::shared_ptr<AbstractByteStreamFilter>& nextFilter):
+    AbstractByteStreamFilter(nextFilter),
+    d(std::make_unique<Private>())
+{
+    d->context = ZSTD_createDCtx();
+    d->outputBuffer.resize(ZSTD_DStreamOutSize());
+}
+
+Uncompressor::~Uncompressor()
+{
+    ZSTD_freeDCtx(d->context);
+}
+
+bool Uncompressor::processData(const ConstBufferRefType& data)
+{
+    if (d->failed)
+        return false;
+
+    ZSTD_inBuffer input{data.data(), data.size(), 0};
+    for (;;)
+    {
+        ZSTD_outBuffer output{d->outputBuffer.data(), d->outputBuffer.size(), 0};
+        const auto result = ZSTD_decompressStream(d->context, &output, &input);
+        if (ZSTD_isError(result))
+        {
+            NX_DEBUG(this, "Decompression failed: %1", ZSTD_getErrorName(result));
+            d->failed = true;
+            return false;
+        }
+
+        if (output.pos > 0 &&
+            !m_nextFilter->processData(ConstBufferRefType(d->outputBuffer.data(), output.pos)))
+        {
+            return false;
+        }
+
+        // If the output buffer is full, the decoder may hold more data even with no input left.
+        if (input.pos == input.size && output.pos < output.size)
+            return true;
+    }
+}
+
+size_t Uncompressor::flush()
+{
+    // All the data that can be decoded is passed on by processData().
+    return 0;
+}
+
+} // namespace nx::utils::bstream::zstd
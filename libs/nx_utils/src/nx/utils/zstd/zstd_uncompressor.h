@@ -0,0 +1,36 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <memory>
+
+#include <nx/utils/byte_stream/abstract_byte_stream_filter.h>
+
+namespace nx::utils::bstream::zstd {
+
+/**
+ * Decompresses the zstd stream (a sequence of frames). Suitable for decoding the "zstd" http
+ * content encoding.
+ * NOTE: Not thread-safe.
+ */
+class NX_UTILS_API Uncompressor: public AbstractByteStreamFilter
+{
+public:
+    Uncompressor(const std::shared_ptr<AbstractByteStreamFilter>& nextFilter = nullptr);
+    virtual ~Uncompressor() override;
+
+    using AbstractByteStreamFilter::processData;
+
+    /**
+     * @return false on malformed input. All subsequent calls fail too.
+     */
+    virtual bool processData(const ConstBufferRefType& data) override;
+
+    virtual size_t flush() override;
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace nx::utils::bstream::zstd
@@ -1,11 +1,33 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <chrono>
+#include <iostream>
+
 #include <gtest/gtest.h>
 
 #include <nx/utils/base64.h>
+#include <nx/utils/random.h>
 
 namespace nx::utils {
 
+namespace {
+
+std::string toQtBase64(const std::string& data, bool isUrl)
+{
+    return QByteArray::fromStdString(data).toBase64(isUrl
+        ? (QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals)
+        : QByteArray::Base64Encoding).toStdString();
+}
+
+std::string fromQtBase64(const std::string& data, bool isUrl)
+{
+    return QByteArray::fromBase64(
+        QByteArray::fromStdString(data),
+        isUrl ? QByteArray::Base64UrlEncoding : QByteArray::Base64Encoding).toStdString();
+}
+
+} // namespace
+
 TEST(Base64, decoded_length_estimate)
 {
     for (int len = 1; len < 16; ++len)
@@ -17,4 +39,111 @@ TEST(Base64, decoded_length_estimate)
     }
 }
 
+TEST(Base64, rfc4648_vectors)
+{
+    const std::pair<std::string, std::string> kVectors[] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"}};
+
+    for (const auto& [data, encoded]: kVectors)
+    {
+        ASSERT_EQ(encoded, toBase64(data));
+        ASSERT_EQ(data, fromBase64(encoded));
+    }
+
+    ASSERT_EQ("Zm9vYg", toBase64Url(std::string("foob")));
+    ASSERT_EQ("foob", fromBase64Url(std::string("Zm9vYg")));
+}
+
+/**
+ * The lengths cover the vectorized blocks, their combinations and the scalar tails.
+ */
+TEST(Base64, same_as_qt_for_all_lengths)
+{
+    for (bool isUrl: {false, true})
+    {
+        for (int len = 0; len < 300; ++len)
+        {
+            const auto data = random::generate<std::string>(len);
+            const auto encoded = isUrl ? toBase64Url(data) : toBase64(data);
+            ASSERT_EQ(toQtBase64(data, isUrl), encoded) << len;
+            ASSERT_EQ(data, isUrl ? fromBase64Url(encoded) : fromBase64(encoded)) << len;
+        }
+    }
+}
+
+TEST(Base64, characters_out_of_alphabet_are_skipped)
+{
+    const auto data = random::generate<std::string>(200);
+    for (bool isUrl: {false, true})
+    {
+        auto encoded = isUrl ? toBase64Url(data) : toBase64(data);
+        for (std::size_t pos: {150, 100, 64, 33, 1})
+            encoded.insert(pos, pos % 2 ? "\r\n" : " =\x80");
+
+        const auto decoded = isUrl ? fromBase64Url(encoded) : fromBase64(encoded);
+        ASSERT_EQ(fromQtBase64(encoded, isUrl), decoded);
+        ASSERT_EQ(data, decoded);
+    }
+
+    // The characters of the other alphabet.
+    ASSERT_EQ(fromQtBase64("ab+/cd-_", false), fromBase64(std::string("ab+/cd-_")));
+    ASSERT_EQ(fromQtBase64("ab+/cd-_", true), fromBase64Url(std::string("ab+/cd-_")));
+}
+
+TEST(Base64Decoder, input_split_at_any_position)
+{
+    const auto data = random::generate<std::string>(500);
+    const auto encoded = toBase64(data);
+
+    for (std::size_t chunkSize = 1; chunkSize < 70; ++chunkSize)
+    {
+        Base64Decoder decoder;
+        std::string decoded;
+        for (std::size_t pos = 0; pos < encoded.size(); pos += chunkSize)
+            decoder.decode(std::string_view(encoded).substr(pos, chunkSize), &decoded);
+        ASSERT_EQ(data, decoded) << chunkSize;
+    }
+}
+
+TEST(Base64Decoder, url_alphabet)
+{
+    const auto data = random::generate<std::string>(100);
+    const auto encoded = toBase64Url(data);
+
+    Base64Decoder decoder(Base64Decoder::Alphabet::url);
+    std::string decoded;
+    decoder.decode(std::string_view(encoded).substr(0, 37), &decoded);
+    decoder.decode(std::string_view(encoded).substr(37), &decoded);
+    ASSERT_EQ(data, decoded);
+
+    decoder.reset();
+    decoded.clear();
+    decoder.decode("Zg", &decoded);
+    ASSERT_EQ("f", decoded);
+}
+
+TEST(Base64, DISABLED_performance)
+{
+    static constexpr int kIterations = 1000;
+    const auto data = random::generate<std::string>(1024 * 1024);
+    const auto encoded = toBase64(data);
+
+    const auto measure =
+        [](auto func)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i)
+                func();
+            const std::chrono::duration<double> duration =
+                std::chrono::steady_clock::now() - start;
+            return kIterations / duration.count();
+        };
+
+    std::cout << "Encode: " << measure([&]() { toBase64(data); }) << " MB/s. "
+        << "Qt: " << measure([&]() { toQtBase64(data, false); }) << " MB/s" << std::endl;
+    std::cout << "Decode: " << measure([&]() { fromBase64(encoded); }) << " MB/s. "
+        << "Qt: " << measure([&]() { fromQtBase64(encoded, false); }) << " MB/s" << std::endl;
+}
+
 } // namespace nx::utils
@@ -0,0 +1,101 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/crc32.h>
+#include <nx/utils/random.h>
+#include <nx/utils/zlib.h>
+
+namespace nx::utils::test {
+
+namespace {
+
+std::uint32_t zlibCrc32(const std::string& data)
+{
+    return (std::uint32_t) ::crc32(0, (const Bytef*) data.data(), (uInt) data.size());
+}
+
+} // namespace
+
+TEST(Crc32, check_value)
+{
+    ASSERT_EQ(0U, nx::utils::crc32(std::string()));
+    ASSERT_EQ(0xCBF43926U, nx::utils::crc32(std::string("123456789")));
+}
+
+/**
+ * The lengths cover the folded blocks and the tails.
+ */
+TEST(Crc32, same_as_zlib_for_all_lengths)
+{
+    for (int len = 0; len < 600; ++len)
+    {
+        const auto data = random::generate<std::string>(len);
+        ASSERT_EQ(zlibCrc32(data), nx::utils::crc32(data)) << len;
+    }
+}
+
+TEST(Crc32, calculation_can_be_continued)
+{
+    const auto data = random::generate<std::string>(1000);
+    for (std::size_t split: {0, 1, 63, 64, 100, 999, 1000})
+    {
+        const auto crc = nx::utils::crc32(data.data(), split);
+        ASSERT_EQ(
+            nx::utils::crc32(data),
+            nx::utils::crc32(crc, data.data() + split, data.size() - split)) << split;
+    }
+}
+
+TEST(Crc32c, check_values)
+{
+    ASSERT_EQ(0U, crc32c(std::string_view()));
+    ASSERT_EQ(0xE3069283U, crc32c(std::string_view("123456789")));
+
+    // RFC 3720, B.4.
+    ASSERT_EQ(0x8A9136AAU, crc32c(std::string(32, '\0')));
+    ASSERT_EQ(0x62A8AB43U, crc32c(std::string(32, '\xff')));
+
+    std::string ascending(32, '\0');
+    for (int i = 0; i < 32; ++i)
+        ascending[i] = (char) i;
+    ASSERT_EQ(0x46DD794EU, crc32c(ascending));
+}
+
+TEST(Crc32c, calculation_can_be_continued)
+{
+    const auto data = random::generate<std::string>(1000);
+    for (std::size_t split: {0, 1, 7, 8, 100, 999, 1000})
+    {
+        const auto crc = crc32c(data.data(), split);
+        ASSERT_EQ(crc32c(data), crc32c(crc, data.data() + split, data.size() - split)) << split;
+    }
+}
+
+TEST(Crc32, DISABLED_performance)
+{
+    static constexpr int kIterations = 1000;
+    const auto data = random::generate<std::string>(1024 * 1024);
+
+    const auto measure =
+        [](auto func)
+        {
+            std::uint32_t sum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i)
+                sum += func();
+            const std::chrono::duration<double> duration =
+                std::chrono::steady_clock::now() - start;
+            return std::make_pair(kIterations / duration.count(), sum);
+        };
+
+    std::cout << "crc32: " << measure([&]() { return nx::utils::crc32(data); }).first
+        << " MB/s. zlib: " << measure([&]() { return zlibCrc32(data); }).first
+        << " MB/s. crc32c: " << measure([&]() { return crc32c(data); }).first
+        << " MB/s" << std::endl;
+}
+
+} // namespace nx::utils::test
@@ -1,5 +1,8 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <algorithm>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <nx/utils/crypt/crypted_file_stream.h>
@@ -141,3 +144,34 @@ TEST(CryptedFileStream, EmbeddedMode)
 
     stream1.close();
 }
+
+TEST(CryptedFileStream, LargeBlocks)
+{
+    const auto fileName = TestOptions::temporaryDirectoryPath() + dummyName;
+
+    // Larger than a batch of blocks, and not aligned to the blocks.
+    std::vector<char> data(1024 * 1024 + 777);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (char) (i * 7 % 251);
+
+    // The blocks written by the small pieces are the same as the ones written by the batches.
+    nx::crypt::CryptedFileStream stream(fileName, thePassword);
+    ASSERT_TRUE(stream.open(QIODevice::WriteOnly));
+    ASSERT_EQ(stream.write(data.data(), 100), 100);
+    for (qint64 pos = 100; pos < 5000; pos += 300)
+        ASSERT_EQ(stream.write(data.data() + pos, 300), 300);
+    ASSERT_EQ(stream.write(data.data() + 5200, data.size() - 5200), (qint64) data.size() - 5200);
+    stream.close();
+
+    nx::crypt::CryptedFileStream stream1(fileName, thePassword);
+    ASSERT_TRUE(stream1.open(QIODevice::ReadOnly));
+    std::vector<char> result(data.size());
+    ASSERT_EQ(stream1.read(result.data(), result.size()), (qint64) result.size());
+    ASSERT_EQ(data, result);
+
+    ASSERT_TRUE(stream1.seek(1500));
+    ASSERT_EQ(stream1.read(result.data(), 50), 50);
+    ASSERT_EQ(stream1.read(result.data() + 50, 500'000), 500'000);
+    ASSERT_TRUE(std::equal(result.begin(), result.begin() + 500'050, data.begin() + 1500));
+    stream1.close();
+}
@@ -0,0 +1,70 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/cryptographic_hash.h>
+
+namespace nx::utils::test {
+
+TEST(CryptographicHash, known_digests)
+{
+    ASSERT_EQ(
+        "900150983cd24fb0d6963f7d28e17f72",
+        QnCryptographicHash::hash("abc", QnCryptographicHash::Md5).toHex().toStdString());
+    ASSERT_EQ(
+        "a9993e364706816aba3e25717850c26c9cd0d89d",
+        QnCryptographicHash::hash("abc", QnCryptographicHash::Sha1).toHex().toStdString());
+    ASSERT_EQ(
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+        QnCryptographicHash::hash("abc", QnCryptographicHash::Sha256).toHex().toStdString());
+}
+
+TEST(CryptographicHash, reset)
+{
+    for (const auto algorithm: {QnCryptographicHash::Sha1, QnCryptographicHash::Sha3_256})
+    {
+        QnCryptographicHash hash(algorithm);
+        hash.addData(std::string_view("garbage"));
+        hash.reset();
+        hash.addData(std::string_view("abc"));
+        ASSERT_EQ(QnCryptographicHash::hash("abc", algorithm), hash.result());
+    }
+}
+
+TEST(CryptographicHash, multiple_buffers)
+{
+    const std::vector<std::string_view> buffers = {"", "abc", "frame data", std::string_view()};
+
+    for (const auto algorithm: {QnCryptographicHash::Md5, QnCryptographicHash::Sha256,
+        QnCryptographicHash::Sha3_512})
+    {
+        const auto digests = QnCryptographicHash::hash(buffers, algorithm);
+        ASSERT_EQ(buffers.size(), digests.size());
+        for (std::size_t i = 0; i < buffers.size(); ++i)
+        {
+            ASSERT_EQ(
+                QnCryptographicHash::hash(QByteArray(buffers[i].data(), (int) buffers[i].size()),
+                    algorithm),
+                digests[i]);
+        }
+    }
+}
+
+TEST(CryptographicHash, resume_from_saved_state)
+{
+    QnCryptographicHash hash(QnCryptographicHash::Md5);
+    hash.addData(std::string_view("ab"));
+    const QByteArray state = hash.saveState();
+    ASSERT_FALSE(state.isEmpty());
+
+    QnCryptographicHash resumed(QnCryptographicHash::Md5);
+    resumed.addData(std::string_view("garbage"));
+    ASSERT_TRUE(resumed.restoreState(state));
+    resumed.addData(std::string_view("c"));
+    ASSERT_EQ(QnCryptographicHash::hash("abc", QnCryptographicHash::Md5), resumed.result());
+
+    ASSERT_FALSE(resumed.restoreState(state.left(state.size() - 1)));
+    ASSERT_TRUE(QnCryptographicHash(QnCryptographicHash::Sha3_256).saveState().isEmpty());
+}
+
+} // namespace nx::utils::test
@@ -0,0 +1,165 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/data_structures/concurrent_lru_cache.h>
+#include <nx/utils/data_structures/concurrent_time_out_cache.h>
+#include <nx/utils/time.h>
+
+namespace nx::utils::test {
+
+TEST(ConcurrentLruCache, least_recently_used_element_is_evicted)
+{
+    ConcurrentLruCache<int, std::string> cache(3, /*shardCount*/ 1);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    ASSERT_EQ("one", cache.getValue(1));
+    cache.put(4, "four");
+
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_EQ(3U, cache.size());
+
+    const auto statistics = cache.statistics();
+    ASSERT_EQ(1U, statistics.hits);
+    ASSERT_EQ(0U, statistics.misses);
+    ASSERT_EQ(1U, statistics.evictions);
+}
+
+TEST(ConcurrentLruCache, capacity_is_shared_by_shards)
+{
+    ConcurrentLruCache<int, int> cache(1000, 16);
+    ASSERT_EQ(16U, cache.shardCount());
+    ASSERT_GE(cache.capacity(), 1000U);
+
+    for (int i = 0; i < 10'000; ++i)
+        cache.put(i, i);
+
+    ASSERT_LE(cache.size(), cache.capacity());
+    ASSERT_GT(cache.size(), 900U);
+    ASSERT_EQ(10'000U - cache.size(), cache.statistics().evictions);
+}
+
+TEST(ConcurrentLruCache, small_cache_is_not_split_into_tiny_shards)
+{
+    ConcurrentLruCache<int, int> cache(10, 64);
+    ASSERT_EQ(1U, cache.shardCount());
+}
+
+TEST(ConcurrentClockCache, referenced_element_gets_second_chance)
+{
+    ConcurrentClockCache<int, std::string> cache(3, /*shardCount*/ 1);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    ASSERT_EQ("one", cache.getValue(1));
+    ASSERT_FALSE(cache.getValue(5));
+    cache.put(4, "four");
+
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_FALSE(cache.contains(2));
+
+    cache.put(1, "uno");
+    ASSERT_EQ("uno", cache.getValue(1));
+
+    const auto statistics = cache.statistics();
+    ASSERT_EQ(2U, statistics.hits);
+    ASSERT_EQ(1U, statistics.misses);
+    ASSERT_EQ(1U, statistics.evictions);
+    ASSERT_EQ(3U, statistics.size);
+}
+
+TEST(ConcurrentClockCache, erased_slot_is_reused)
+{
+    ConcurrentClockCache<int, int> cache(2, 1);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.erase(1);
+    cache.put(3, 3);
+
+    ASSERT_TRUE(cache.contains(2));
+    ASSERT_TRUE(cache.contains(3));
+    ASSERT_EQ(0U, cache.statistics().evictions);
+}
+
+template<typename Cache>
+class ConcurrentCacheLoad:
+    public ::testing::Test
+{
+};
+
+using CacheTypes = ::testing::Types<
+    ConcurrentLruCache<int, int>,
+    ConcurrentClockCache<int, int>>;
+TYPED_TEST_SUITE(ConcurrentCacheLoad, CacheTypes);
+
+TYPED_TEST(ConcurrentCacheLoad, values_are_consistent_under_concurrent_access)
+{
+    static constexpr int kKeyCount = 1000;
+    static constexpr int kIterations = 20'000;
+
+    TypeParam cache(kKeyCount / 2);
+    std::atomic<int> wrongValueCount{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&cache, &wrongValueCount, t]()
+            {
+                for (int i = 0; i < kIterations; ++i)
+                {
+                    const int key = (i * 7 + t * 13) % kKeyCount;
+                    if (const auto value = cache.getValue(key); value && *value != key * 2)
+                        ++wrongValueCount;
+                    else if (!value)
+                        cache.put(key, key * 2);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+        thread.join();
+
+    ASSERT_EQ(0, wrongValueCount);
+    ASSERT_LE(cache.size(), cache.capacity());
+
+    const auto statistics = cache.statistics();
+    ASSERT_EQ(4U * kIterations, statistics.hits + statistics.misses);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class ConcurrentTimeOutCache:
+    public ::testing::Test
+{
+protected:
+    static constexpr auto kExpirationPeriod = std::chrono::hours(1);
+
+    nx::utils::ConcurrentTimeOutCache<int, int> m_cache{kExpirationPeriod, 100};
+    ScopedTimeShift m_timeShift{ClockType::steady};
+};
+
+TEST_F(ConcurrentTimeOutCache, expired_element_is_evicted)
+{
+    m_cache.put(1, 111);
+    ASSERT_EQ(111, m_cache.getValue(1));
+
+    m_timeShift.applyRelativeShift(kExpirationPeriod + std::chrono::milliseconds(1));
+
+    ASSERT_FALSE(m_cache.contains(1));
+    ASSERT_FALSE(m_cache.getValue(1));
+
+    const auto statistics = m_cache.statistics();
+    ASSERT_EQ(1U, statistics.hits);
+    ASSERT_EQ(1U, statistics.misses);
+    ASSERT_EQ(1U, statistics.evictions);
+    ASSERT_EQ(0U, statistics.size);
+}
+
+} // namespace nx::utils::test
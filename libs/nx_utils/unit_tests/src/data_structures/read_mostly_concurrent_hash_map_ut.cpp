@@ -0,0 +1,148 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/data_structures/partitioned_concurrent_hash_map.h>
+#include <nx/utils/data_structures/read_mostly_concurrent_hash_map.h>
+
+namespace nx::utils::test {
+
+TEST(ReadMostlyConcurrentHashMap, main)
+{
+    std::vector<std::pair<int, std::string>> vals{
+        {1, {"1"}}, {2, {"2"}}, {3, {"3"}}};
+
+    ReadMostlyConcurrentHashMap<int, std::string> dict;
+    ASSERT_TRUE(dict.empty());
+
+    for (const auto& [key, val]: vals)
+        ASSERT_TRUE(dict.emplace(key, val));
+    ASSERT_FALSE(dict.emplace(1, "one"));
+    ASSERT_EQ(vals.size(), dict.size());
+
+    for (const auto& [key, val]: vals)
+        ASSERT_EQ(val, dict.find(key));
+
+    std::size_t count = 0;
+    dict.forEach([&count](const auto&) { ++count; });
+    ASSERT_EQ(vals.size(), count);
+
+    ASSERT_EQ("1", dict.take(1));
+    ASSERT_FALSE(dict.contains(1));
+    ASSERT_EQ(1U, dict.erase(2));
+    ASSERT_EQ(0U, dict.erase(2));
+
+    dict.modify(3, [](auto& val) { val = "33"; });
+    dict.modify(4, [](auto& val) { val = "44"; });
+    ASSERT_EQ("33", dict.find(3));
+    ASSERT_EQ("44", dict.find(4));
+
+    ASSERT_EQ(2U, dict.takeAll().size());
+    ASSERT_TRUE(dict.empty());
+}
+
+TEST(ReadMostlyConcurrentHashMap, readers_see_consistent_values_during_modifications)
+{
+    static constexpr int kKeyCount = 100;
+
+    ReadMostlyConcurrentHashMap<int, std::string> dict(4);
+    for (int i = 0; i < kKeyCount; ++i)
+        dict.emplace(i, std::to_string(i));
+
+    std::atomic<bool> stopped{false};
+    std::atomic<int> wrongValueCount{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!stopped)
+                {
+                    for (int i = 0; i < kKeyCount; ++i)
+                    {
+                        const auto val = dict.find(i);
+                        if (val && *val != std::to_string(i) && *val != std::to_string(-i))
+                            ++wrongValueCount;
+                    }
+                }
+            });
+    }
+
+    for (int round = 0; round < 200; ++round)
+    {
+        const int key = round % kKeyCount;
+        dict.modify(key, [key](auto& val) { val = std::to_string(-key); });
+        dict.erase(key);
+        dict.emplace(key, std::to_string(key));
+    }
+
+    stopped = true;
+    for (auto& reader: readers)
+        reader.join();
+
+    ASSERT_EQ(0, wrongValueCount);
+    ASSERT_EQ((std::size_t) kKeyCount, dict.size());
+}
+
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+
+template<typename Dict>
+double lookupsPerSecond(int threadCount)
+{
+    static constexpr int kKeyCount = 10'000;
+    static constexpr int kLookupsPerThread = 2'000'000;
+
+    Dict dict;
+    for (int i = 0; i < kKeyCount; ++i)
+        dict.emplace(i, i);
+
+    std::atomic<long long> checksum{0};
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&dict, &checksum, t]()
+            {
+                long long sum = 0;
+                for (int i = 0; i < kLookupsPerThread; ++i)
+                    sum += *dict.find((i * 31 + t) % kKeyCount);
+                checksum += sum;
+            });
+    }
+    for (auto& thread: threads)
+        thread.join();
+
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    return (double) kLookupsPerThread * threadCount / duration.count();
+}
+
+} // namespace
+
+/**
+ * Compares the read scalability of ReadMostlyConcurrentHashMap and PartitionedConcurrentHashMap.
+ */
+TEST(ReadMostlyConcurrentHashMap, DISABLED_read_scalability)
+{
+    std::cout << "threads, PartitionedConcurrentHashMap lookups/s, "
+        "ReadMostlyConcurrentHashMap lookups/s" << std::endl;
+
+    for (int threadCount = 1; threadCount <= 64; threadCount *= 2)
+    {
+        std::cout << threadCount << ", "
+            << lookupsPerSecond<PartitionedConcurrentHashMap<int, int>>(threadCount) << ", "
+            << lookupsPerSecond<ReadMostlyConcurrentHashMap<int, int>>(threadCount)
+            << std::endl;
+    }
+}
+
+} // namespace nx::utils::test
@@ -16,6 +16,9 @@
 #define NX_DEBUG_ENABLE_OUTPUT false //< Set to true to enable verbose output of this test.
 #include <nx/kit/debug.h>
 
+/** Outside of nx namespace, but a tag made from a pointer to it starts with kTestTag. */
+struct TestTagObject {};
+
 namespace nx::log::test {
 
 static const Tag kTestTag(QLatin1String("TestTag"));
@@ -229,6 +232,39 @@ TEST_F(LogMainTest, LevelReducerWithStream)
     });
 }
 
+TEST_F(LogMainTest, call_site_decision_is_reset_by_level_change)
+{
+    const auto logDebug = [](const TestTagObject* object) { NX_DEBUG(object, "Debug"); };
+    const TestTagObject object;
+
+    logDebug(&object);
+    logDebug(&object);
+    expectMessages({});
+
+    getLogger(kTestTag)->setDefaultLevel(Level::debug);
+    logDebug(&object);
+    expectMessages({"* DEBUG TestTagObject(0x*): Debug"});
+}
+
+TEST_F(LogMainTest, call_site_decision_respects_filters_by_address)
+{
+    const auto logDebug = [](const TestTagObject* object) { NX_DEBUG(object, "Debug"); };
+    const TestTagObject first;
+    const TestTagObject second;
+
+    getLogger(kTestTag)->setLevelFilters({{
+        Filter("re:^TestTagObject\\(0x" + QString::number((qulonglong) &first, 16)),
+        Level::debug}});
+
+    logDebug(&second);
+    logDebug(&first);
+    logDebug(&second);
+    logDebug(&first);
+    expectMessages({
+        "* DEBUG TestTagObject(0x*): Debug",
+        "* DEBUG TestTagObject(0x*): Debug"});
+}
+
 //-------------------------------------------------------------------------------------------------
 // NX_SCOPE_TAG tests.
 
@@ -88,6 +88,27 @@ TEST_F(LogSettings, multiple_loggers)
     ASSERT_EQ(logger1Settings, logSettings.loggers[1]);
 }
 
+TEST_F(LogSettings, async_writing)
+{
+    parse({
+        "-log/logger", "file=-,level=WARNING",
+        "-log/logger",
+        "dir=/var/log/,level=DEBUG,asyncLogWriting=true,asyncLogQueueSize=1000,"
+            "asyncLogOverflowPolicy=block"
+    });
+
+    ASSERT_EQ(2U, logSettings.loggers.size());
+    ASSERT_FALSE(logSettings.loggers[0].asyncWritingEnabled);
+
+    LoggerSettings logger1Settings;
+    logger1Settings.directory = "/var/log/";
+    logger1Settings.level.primary = nx::log::Level::debug;
+    logger1Settings.asyncWritingEnabled = true;
+    logger1Settings.asyncQueueSize = 1000;
+    logger1Settings.asyncOverflowPolicy = AsyncWriterOverflowPolicy::block;
+    ASSERT_EQ(logger1Settings, logSettings.loggers[1]);
+}
+
 TEST_F(LogSettings, compatibility_settings)
 {
     parse({
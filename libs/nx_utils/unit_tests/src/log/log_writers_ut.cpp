@@ -1,5 +1,8 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <map>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <quazip/quazip.h>
 #include <quazip/quazipfile.h>
@@ -7,6 +10,8 @@
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 
+#include <nx/utils/log/format.h>
+#include <nx/utils/log/log_async_writer.h>
 #include <nx/utils/log/log_writers.h>
 #include <nx/utils/log/storage_info.h>
 #include <nx/utils/nx_utils_ini.h>
@@ -42,6 +47,11 @@ public:
         return std::make_unique<File>(settings);
     }
 
+    std::unique_ptr<AbstractWriter> makeAsyncWriter(size_t file, size_t volume)
+    {
+        return std::make_unique<AsyncWriter>(makeWriter(file, volume), AsyncWriter::Settings());
+    }
+
     void checkFile(
         const std::vector<QByteArray>& messages = {},
         const QString& suffix = {},
@@ -362,4 +372,122 @@ TEST_F(LogFile, RotationByFreeSpace)
     checkFile();
 }
 
+TEST_F(LogFile, AsyncRotation)
+{
+    static constexpr size_t kLogSize = 20;
+    static constexpr size_t kVolumeSize = 500;
+    {
+        auto w = makeAsyncWriter(kLogSize, kVolumeSize);
+        w->write(Level::undefined, "1234567890");
+    }
+    checkFile({"1234567890"});
+
+    {
+        auto w = makeAsyncWriter(kLogSize, kVolumeSize);
+        w->write(Level::undefined, "1234567890"); //< Overflow
+        w->write(Level::undefined, "xxx");
+        w->write(Level::undefined, "yyy");
+    }
+    checkFile({"1234567890", "1234567890"}, "_001", File::Extension::zip);
+    checkFile({"xxx", "yyy"});
+
+    {
+        auto w = makeAsyncWriter(kLogSize, kVolumeSize);
+        w->write(Level::undefined, "12345678901234567890"); // Overflow
+        w->write(Level::undefined, "1234567890");
+    }
+    checkFile({"1234567890", "1234567890"}, "_001", File::Extension::zip);
+    checkFile({"xxx", "yyy", "12345678901234567890"}, "_002", File::Extension::zip);
+    checkFile({"1234567890"});
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class LogAsyncWriter: public ::testing::Test
+{
+protected:
+    void givenWriter(AsyncWriterOverflowPolicy overflowPolicy, std::size_t queueSize)
+    {
+        auto buffer = std::make_unique<Buffer>();
+        m_buffer = buffer.get();
+
+        AsyncWriter::Settings settings;
+        settings.queueSize = queueSize;
+        settings.overflowPolicy = overflowPolicy;
+        m_writer = std::make_unique<AsyncWriter>(std::move(buffer), settings);
+    }
+
+    void whenWriteConcurrently(int threadCount, int messagesPerThread)
+    {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back(
+                [this, i, messagesPerThread]()
+                {
+                    for (int j = 0; j < messagesPerThread; ++j)
+                        m_writer->write(Level::info, nx::format("%1 %2").args(i, j));
+                });
+        }
+
+        for (auto& thread: threads)
+            thread.join();
+
+        m_writer->flush();
+        m_messages = m_buffer->takeMessages();
+    }
+
+    void thenMessagesOfEachThreadAreInOrder()
+    {
+        std::map<int, int> lastMessages;
+        for (const auto& message: m_messages)
+        {
+            const auto parts = message.split(' ');
+            ASSERT_EQ(2, parts.size());
+            const auto thread = parts[0].toInt();
+            const auto index = parts[1].toInt();
+
+            if (const auto it = lastMessages.find(thread); it != lastMessages.end())
+                ASSERT_LT(it->second, index);
+            lastMessages[thread] = index;
+        }
+    }
+
+    void thenMessageCountIs(std::size_t expected)
+    {
+        ASSERT_EQ(expected, m_messages.size());
+        ASSERT_EQ(expected, m_writer->statistics().writtenMessageCount);
+    }
+
+    AsyncWriter& writer() { return *m_writer; }
+    std::size_t messageCount() const { return m_messages.size(); }
+
+private:
+    Buffer* m_buffer = nullptr;
+    std::unique_ptr<AsyncWriter> m_writer;
+    std::vector<QString> m_messages;
+};
+
+TEST_F(LogAsyncWriter, blocking_writer_loses_no_messages)
+{
+    givenWriter(AsyncWriterOverflowPolicy::block, 16);
+    whenWriteConcurrently(4, 10000);
+
+    thenMessageCountIs(4 * 10000);
+    thenMessagesOfEachThreadAreInOrder();
+    ASSERT_EQ(0U, writer().statistics().droppedMessageCount);
+}
+
+TEST_F(LogAsyncWriter, dropping_writer_counts_lost_messages)
+{
+    givenWriter(AsyncWriterOverflowPolicy::drop, 16);
+    whenWriteConcurrently(4, 10000);
+
+    thenMessagesOfEachThreadAreInOrder();
+    const auto statistics = writer().statistics();
+    ASSERT_EQ(messageCount(), statistics.writtenMessageCount);
+    ASSERT_EQ(4U * 10000, statistics.writtenMessageCount + statistics.droppedMessageCount);
+    ASSERT_EQ(0U, statistics.blockedWriteCount);
+}
+
 } // namespace nx::log::test
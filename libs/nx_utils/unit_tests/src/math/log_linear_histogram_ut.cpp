@@ -0,0 +1,124 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/math/log_linear_histogram.h>
+#include <nx/utils/random.h>
+
+namespace nx::utils::math::test {
+
+class LogLinearHistogram:
+    public ::testing::Test
+{
+protected:
+    void add(std::uint64_t value)
+    {
+        m_histogram.add(value);
+        m_values.push_back(value);
+    }
+
+    void assertPercentileIsPrecise(double percentile)
+    {
+        std::sort(m_values.begin(), m_values.end());
+        const auto rank = std::max<std::size_t>(
+            1, (std::size_t) std::ceil(percentile * m_values.size()));
+        const auto expected = m_values[rank - 1];
+
+        const auto actual = m_histogram.percentile(percentile);
+        ASSERT_GE(actual, expected);
+        ASSERT_LE(
+            actual - expected,
+            expected / math::LogLinearHistogram::kSubBucketCount);
+    }
+
+    math::LogLinearHistogram& histogram() { return m_histogram; }
+
+private:
+    math::LogLinearHistogram m_histogram;
+    std::vector<std::uint64_t> m_values;
+};
+
+TEST_F(LogLinearHistogram, empty)
+{
+    ASSERT_EQ(0U, histogram().count());
+    ASSERT_EQ(0U, histogram().max());
+    ASSERT_EQ(0U, histogram().percentile(0.5));
+}
+
+TEST_F(LogLinearHistogram, bucket_bounds)
+{
+    std::uint64_t prevUpperBound = 0;
+    for (std::size_t i = 1; i < math::LogLinearHistogram::kBucketCount; ++i)
+    {
+        const auto upperBound = math::LogLinearHistogram::bucketUpperBound(i);
+        ASSERT_GT(upperBound, prevUpperBound);
+        ASSERT_EQ(i, math::LogLinearHistogram::bucketIndex(upperBound));
+        ASSERT_EQ(i, math::LogLinearHistogram::bucketIndex(prevUpperBound + 1));
+        prevUpperBound = upperBound;
+    }
+
+    ASSERT_EQ(math::LogLinearHistogram::kMaxTrackableValue, prevUpperBound);
+    ASSERT_EQ(
+        math::LogLinearHistogram::kBucketCount - 1,
+        math::LogLinearHistogram::bucketIndex(std::numeric_limits<std::uint64_t>::max()));
+}
+
+TEST_F(LogLinearHistogram, small_values_are_exact)
+{
+    for (std::uint64_t i = 1; i <= 20; ++i)
+        add(i);
+
+    ASSERT_EQ(10U, histogram().percentile(0.5));
+    ASSERT_EQ(19U, histogram().percentile(0.95));
+    ASSERT_EQ(20U, histogram().percentile(1));
+    ASSERT_EQ(20U, histogram().max());
+    ASSERT_EQ(210U, histogram().sum());
+}
+
+TEST_F(LogLinearHistogram, percentile_relative_error_is_bounded)
+{
+    for (int i = 0; i < 10000; ++i)
+        add(nx::utils::random::number<std::uint64_t>(0, 10'000'000));
+
+    assertPercentileIsPrecise(0.5);
+    assertPercentileIsPrecise(0.95);
+    assertPercentileIsPrecise(0.99);
+}
+
+TEST_F(LogLinearHistogram, percentile_does_not_exceed_max)
+{
+    add(1'000'001);
+
+    ASSERT_EQ(1'000'001U, histogram().percentile(0.99));
+}
+
+TEST_F(LogLinearHistogram, concurrent_add)
+{
+    constexpr int kThreadCount = 4;
+    constexpr int kValuesPerThread = 10000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreadCount; ++i)
+    {
+        threads.emplace_back(
+            [this, i]()
+            {
+                for (int j = 0; j < kValuesPerThread; ++j)
+                    histogram().add(i * kValuesPerThread + j);
+            });
+    }
+
+    for (auto& thread: threads)
+        thread.join();
+
+    ASSERT_EQ((std::uint64_t) kThreadCount * kValuesPerThread, histogram().count());
+    ASSERT_EQ((std::uint64_t) kThreadCount * kValuesPerThread - 1, histogram().max());
+}
+
+} // namespace nx::utils::math::test
@@ -0,0 +1,154 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/byte_array.h>
+#include <nx/utils/memory/aligned_buffer_pool.h>
+
+namespace nx::utils::memory::test {
+
+class AlignedBufferPool:
+    public ::testing::Test
+{
+protected:
+    static constexpr std::size_t kMaxCachedBytes = 1024 * 1024;
+
+    memory::AlignedBufferPool m_pool{kMaxCachedBytes};
+
+    void* allocate(std::size_t size, std::size_t alignment = 32)
+    {
+        void* block = m_pool.allocate(size, alignment);
+        EXPECT_NE(nullptr, block);
+        EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(block) % alignment);
+        return block;
+    }
+
+    AlignedBufferPoolSizeClass sizeClass(std::size_t size) const
+    {
+        const auto blockSize = memory::AlignedBufferPool::blockSize(size);
+        for (const auto& item: m_pool.statistics().sizeClasses)
+        {
+            if (item.blockSize == blockSize)
+                return item;
+        }
+        return {};
+    }
+};
+
+TEST_F(AlignedBufferPool, size_is_rounded_up_to_size_class)
+{
+    ASSERT_EQ(256U, memory::AlignedBufferPool::blockSize(1));
+    ASSERT_EQ(320U, memory::AlignedBufferPool::blockSize(257));
+    ASSERT_EQ(5120U, memory::AlignedBufferPool::blockSize(5000));
+    ASSERT_EQ(8192U, memory::AlignedBufferPool::blockSize(8192));
+    ASSERT_EQ(0U, memory::AlignedBufferPool::blockSize(
+        memory::AlignedBufferPool::kMaxBlockSize + 1));
+}
+
+TEST_F(AlignedBufferPool, freed_block_is_reused)
+{
+    void* block = allocate(5000);
+    m_pool.deallocate(block, 5000, 32);
+
+    // Any size of the same class gets the same block.
+    ASSERT_EQ(block, allocate(4500, 64));
+    m_pool.deallocate(block, 4500, 64);
+
+    const auto stats = sizeClass(5000);
+    ASSERT_EQ(1U, stats.allocationCount);
+    ASSERT_EQ(1U, stats.reuseCount);
+    ASSERT_EQ(1U, stats.cachedBlockCount);
+    ASSERT_EQ(0U, stats.usedBlockCount);
+}
+
+TEST_F(AlignedBufferPool, high_water_mark_is_tracked)
+{
+    std::vector<void*> blocks;
+    for (int i = 0; i < 5; ++i)
+        blocks.push_back(allocate(1000));
+    for (void* block: blocks)
+        m_pool.deallocate(block, 1000, 32);
+
+    void* block = allocate(1000);
+
+    const auto stats = sizeClass(1000);
+    ASSERT_EQ(1U, stats.usedBlockCount);
+    ASSERT_EQ(5U, stats.maxUsedBlockCount);
+    ASSERT_EQ(5 * memory::AlignedBufferPool::blockSize(1000), m_pool.statistics().maxUsedBytes);
+    m_pool.deallocate(block, 1000, 32);
+}
+
+TEST_F(AlignedBufferPool, trim_releases_cached_blocks)
+{
+    for (const std::size_t size: {1000, 100'000})
+        m_pool.deallocate(allocate(size), size, 32);
+    ASSERT_GT(m_pool.statistics().cachedBytes, 0U);
+
+    m_pool.trim();
+    void* block = allocate(1000); //< Thread cache is released on the next call.
+
+    ASSERT_EQ(0U, m_pool.statistics().cachedBytes);
+    ASSERT_EQ(2U, sizeClass(1000).allocationCount);
+    m_pool.deallocate(block, 1000, 32);
+}
+
+TEST_F(AlignedBufferPool, cached_size_is_limited)
+{
+    constexpr std::size_t kSize = 256 * 1024;
+    std::vector<void*> blocks;
+    for (std::size_t i = 0; i < 2 * kMaxCachedBytes / kSize; ++i)
+        blocks.push_back(allocate(kSize));
+    for (void* block: blocks)
+        m_pool.deallocate(block, kSize, 32);
+
+    ASSERT_EQ(kMaxCachedBytes, m_pool.statistics().cachedBytes);
+}
+
+TEST_F(AlignedBufferPool, unsupported_blocks_are_not_pooled)
+{
+    const auto largeSize = memory::AlignedBufferPool::kMaxBlockSize + 1;
+    m_pool.deallocate(allocate(largeSize), largeSize, 32);
+    m_pool.deallocate(allocate(1000, 128), 1000, 128);
+
+    const auto stats = m_pool.statistics();
+    ASSERT_TRUE(stats.sizeClasses.empty());
+    ASSERT_EQ(0U, stats.cachedBytes);
+}
+
+TEST_F(AlignedBufferPool, block_freed_by_another_thread_is_reused)
+{
+    void* block = allocate(1000);
+    std::thread([&]() { m_pool.deallocate(block, 1000, 32); }).join();
+
+    // The exited thread returned its cache to the shared lists.
+    ASSERT_EQ(block, allocate(1000));
+    ASSERT_EQ(1U, sizeClass(1000).reuseCount);
+    m_pool.deallocate(block, 1000, 32);
+}
+
+TEST(AlignedBufferPoolDisabled, blocks_are_not_cached)
+{
+    memory::AlignedBufferPool pool(0);
+    pool.deallocate(pool.allocate(1000, 32), 1000, 32);
+
+    ASSERT_TRUE(pool.statistics().sizeClasses.empty());
+}
+
+TEST(ByteArray, moved_from_array_is_empty)
+{
+    ByteArray source(32, 1000, 64);
+    source.write("data", 4);
+
+    ByteArray target(std::move(source));
+    ASSERT_EQ(1000U, target.capacity());
+    ASSERT_EQ(4U, target.size());
+
+    ASSERT_EQ(0U, source.capacity());
+    source.write("new", 3);
+    ASSERT_EQ(3U, source.size());
+}
+
+} // namespace nx::utils::memory::test
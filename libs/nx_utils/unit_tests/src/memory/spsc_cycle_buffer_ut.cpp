@@ -0,0 +1,125 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/memory/spsc_cycle_buffer.h>
+
+namespace nx::utils::memory::test {
+
+class QnMediaSpscCycleBuffer:
+    public ::testing::Test
+{
+protected:
+    static constexpr std::size_t kBufferSize = 16;
+
+    QnMediaSpscCyclicBuffer m_buffer{kBufferSize, 16};
+
+    std::string readAll()
+    {
+        std::string result;
+        for (const auto& span: m_buffer.fragmentedData())
+            result.append(span.data(), span.size());
+        m_buffer.pop_front(result.size());
+        return result;
+    }
+};
+
+TEST_F(QnMediaSpscCycleBuffer, reserved_span_is_published_on_commit)
+{
+    auto span = m_buffer.reserve();
+    ASSERT_EQ(kBufferSize, span.size());
+
+    memcpy(span.data(), "Hello", 5);
+    ASSERT_TRUE(m_buffer.readableData().empty());
+
+    m_buffer.commit(5);
+    ASSERT_EQ(5U, m_buffer.size());
+    ASSERT_EQ(kBufferSize - 5, m_buffer.freeSize());
+    ASSERT_EQ("Hello", std::string(m_buffer.readableData().data(), 5));
+}
+
+TEST_F(QnMediaSpscCycleBuffer, data_wraps_around_buffer_end)
+{
+    ASSERT_EQ(12U, m_buffer.push_back("0123456789ab", 12));
+    ASSERT_EQ("0123456789ab", readAll());
+
+    ASSERT_EQ(kBufferSize, m_buffer.push_back("Hello, world. Bye!", 18));
+    ASSERT_EQ(0U, m_buffer.freeSize());
+    ASSERT_TRUE(m_buffer.reserve().empty());
+
+    // The first span ends at the buffer end.
+    ASSERT_EQ(4U, m_buffer.readableData().size());
+    ASSERT_EQ(12U, m_buffer.fragmentedData()[1].size());
+
+    char data[10];
+    ASSERT_EQ(10U, m_buffer.read(data, sizeof(data)));
+    ASSERT_EQ("Hello, wor", std::string(data, sizeof(data)));
+    ASSERT_EQ("ld. By", readAll());
+}
+
+TEST_F(QnMediaSpscCycleBuffer, reserve_returns_contiguous_part_of_free_space)
+{
+    m_buffer.push_back("0123456789", 10);
+    m_buffer.pop_front(10);
+
+    ASSERT_EQ(6U, m_buffer.reserve().size());
+    m_buffer.commit(6);
+    ASSERT_EQ(10U, m_buffer.reserve().size());
+}
+
+TEST_F(QnMediaSpscCycleBuffer, stream_is_passed_between_threads)
+{
+    constexpr std::size_t kStreamSize = 1024 * 1024;
+    QnMediaSpscCyclicBuffer buffer(4096, 16);
+
+    std::thread producer(
+        [&buffer]()
+        {
+            std::size_t written = 0;
+            while (written < kStreamSize)
+            {
+                const auto span = buffer.reserve();
+                if (span.empty())
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                const auto count = std::min(span.size(), kStreamSize - written);
+                for (std::size_t i = 0; i < count; ++i)
+                    span[i] = (char) ((written + i) % 251);
+                buffer.commit(count);
+                written += count;
+            }
+        });
+
+    std::size_t received = 0;
+    std::size_t mismatchCount = 0;
+    while (received < kStreamSize)
+    {
+        const auto span = buffer.readableData();
+        if (span.empty())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (std::size_t i = 0; i < span.size(); ++i)
+        {
+            if (span[i] != (char) ((received + i) % 251))
+                ++mismatchCount;
+        }
+        buffer.pop_front(span.size());
+        received += span.size();
+    }
+
+    producer.join();
+    ASSERT_EQ(0U, mismatchCount);
+    ASSERT_EQ(0U, buffer.size());
+}
+
+} // namespace nx::utils::memory::test
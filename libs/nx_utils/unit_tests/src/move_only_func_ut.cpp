@@ -2,7 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <deque>
+#include <functional>
 #include <future>
+#include <memory>
 #include <optional>
 
 #include <nx/utils/std/thread.h>
@@ -24,3 +28,135 @@ TEST(MoveOnlyFunc, common)
         ASSERT_TRUE(promise->get_future().get());
     }
 }
+
+namespace nx::utils::test {
+
+namespace {
+
+static int allocationCount = 0;
+
+/**
+ * Counts the allocations made by MoveOnlyFunc for the callable itself.
+ */
+template<std::size_t Size>
+struct CountedCallable
+{
+    std::array<char, Size> data{};
+    std::unique_ptr<int> result = std::make_unique<int>(Size);
+
+    static void* operator new(std::size_t size)
+    {
+        ++allocationCount;
+        return ::operator new(size);
+    }
+
+    static void operator delete(void* ptr)
+    {
+        ::operator delete(ptr);
+    }
+
+    int operator()() { return *result; }
+};
+
+} // namespace
+
+class MoveOnlyFuncAllocation:
+    public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        allocationCount = 0;
+    }
+
+    /**
+     * Passes the function the way AioThread::post does: by value into a queue and then out of it.
+     */
+    template<typename Func>
+    int passThroughQueue(Func func)
+    {
+        std::deque<Func> queue;
+        queue.push_back(std::move(func));
+        auto taken = std::move(queue.front());
+        queue.pop_front();
+        return taken();
+    }
+};
+
+TEST_F(MoveOnlyFuncAllocation, small_callable_is_stored_inline)
+{
+    static constexpr std::size_t kSize = 16;
+    static_assert(MoveOnlyFunc<int()>::isStoredInline<CountedCallable<kSize>>());
+
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_EQ((int) kSize, passThroughQueue(MoveOnlyFunc<int()>(CountedCallable<kSize>())));
+
+    ASSERT_EQ(0, allocationCount);
+}
+
+TEST_F(MoveOnlyFuncAllocation, large_callable_is_allocated_once)
+{
+    static constexpr std::size_t kSize = 128;
+    static_assert(!MoveOnlyFunc<int()>::isStoredInline<CountedCallable<kSize>>());
+
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_EQ((int) kSize, passThroughQueue(MoveOnlyFunc<int()>(CountedCallable<kSize>())));
+
+    ASSERT_EQ(1000, allocationCount);
+}
+
+TEST_F(MoveOnlyFuncAllocation, buffer_size_is_configurable)
+{
+    static constexpr std::size_t kSize = 128;
+    using LargeFunc = MoveOnlyFunc<int(), 256>;
+    static_assert(LargeFunc::isStoredInline<CountedCallable<kSize>>());
+
+    ASSERT_EQ((int) kSize, passThroughQueue(LargeFunc(CountedCallable<kSize>())));
+    ASSERT_EQ(0, allocationCount);
+}
+
+TEST(MoveOnlyFunc, typical_completion_handler_is_stored_inline)
+{
+    // `this`, a buffer pointer, an error code and a size, as captured by a socket IO handler.
+    struct Handler
+    {
+        void* self = nullptr;
+        void* buffer = nullptr;
+        int errorCode = 0;
+        std::size_t bytesTransferred = 0;
+        std::unique_ptr<int> ownedData;
+
+        void operator()(int, std::size_t) {}
+    };
+
+    static_assert(MoveOnlyFunc<void(int, std::size_t)>::isStoredInline<Handler>());
+}
+
+TEST(MoveOnlyFunc, empty_callables_produce_empty_function)
+{
+    void (*nullFunction)() = nullptr;
+    ASSERT_FALSE(MoveOnlyFunc<void()>(nullFunction));
+    ASSERT_FALSE(MoveOnlyFunc<void()>(std::function<void()>()));
+    ASSERT_TRUE(MoveOnlyFunc<void()>(std::function<void()>([]() {})));
+    ASSERT_THROW(MoveOnlyFunc<void()>()(), std::bad_function_call);
+}
+
+TEST(MoveOnlyFunc, captured_objects_are_destroyed)
+{
+    auto value = std::make_shared<int>(0);
+    {
+        MoveOnlyFunc<void()> inlineFunc = [value]() {};
+        MoveOnlyFunc<void()> allocatedFunc = [value, data = std::array<char, 128>()]() {};
+        ASSERT_EQ(3, value.use_count());
+
+        auto movedFunc = std::move(allocatedFunc);
+        movedFunc.swap(inlineFunc);
+        ASSERT_EQ(3, value.use_count());
+
+        inlineFunc = nullptr;
+        ASSERT_EQ(2, value.use_count());
+    }
+    ASSERT_EQ(1, value.use_count());
+}
+
+} // namespace nx::utils::test
@@ -0,0 +1,118 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/shared_buffer.h>
+
+namespace nx::test {
+
+TEST(SharedBuffer, sub_buffer_references_the_same_data)
+{
+    const SharedBuffer buffer(nx::Buffer("Hello, world"));
+    const auto hello = buffer.subBuffer(0, 5);
+    const auto world = buffer.subBuffer(7);
+
+    ASSERT_EQ("Hello", hello.view());
+    ASSERT_EQ("world", world.view());
+    ASSERT_EQ(buffer.data(), hello.data());
+    ASSERT_EQ(buffer.data() + 7, world.data());
+    ASSERT_EQ(3, buffer.useCount());
+
+    ASSERT_EQ("orl", world.subBuffer(1, 3).view());
+    ASSERT_TRUE(world.subBuffer(100).empty());
+}
+
+TEST(SharedBuffer, take_buffer_moves_the_only_reference)
+{
+    nx::Buffer data(100, 'x');
+    const auto dataPtr = data.data();
+
+    SharedBuffer buffer(std::move(data));
+    const auto taken = buffer.takeBuffer();
+
+    ASSERT_EQ(dataPtr, taken.data());
+    ASSERT_TRUE(buffer.empty());
+}
+
+TEST(SharedBuffer, take_buffer_copies_shared_data)
+{
+    SharedBuffer buffer(nx::Buffer(100, 'x'));
+    const auto copy = buffer;
+
+    ASSERT_EQ(nx::Buffer(100, 'x'), buffer.takeBuffer());
+    ASSERT_EQ(1, copy.useCount());
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class BufferChain:
+    public ::testing::Test
+{
+protected:
+    nx::BufferChain m_chain;
+
+    void givenChain(std::vector<std::string> slices)
+    {
+        for (auto& slice: slices)
+            m_chain.append(nx::Buffer(std::move(slice)));
+    }
+};
+
+TEST_F(BufferChain, empty_slices_are_skipped)
+{
+    givenChain({"Hello", "", ", world"});
+
+    ASSERT_EQ(2U, m_chain.sliceCount());
+    ASSERT_EQ(12U, m_chain.size());
+    ASSERT_EQ(nx::Buffer("Hello, world"), m_chain.toBuffer());
+}
+
+TEST_F(BufferChain, find_across_slices)
+{
+    givenChain({"GET / HTTP/1.1\r", "\n\r", "\nbody\r\n\r\n"});
+
+    ASSERT_EQ(14U, m_chain.find("\r\n\r\n"));
+    ASSERT_EQ(22U, m_chain.find("\r\n\r\n", 15));
+    ASSERT_EQ(18U, m_chain.find("body"));
+    ASSERT_EQ(nx::BufferChain::npos, m_chain.find("\r\n\r\n\r"));
+    ASSERT_EQ('\n', m_chain[15]);
+}
+
+TEST_F(BufferChain, sub_chain_does_not_copy)
+{
+    givenChain({"Hello", ", ", "world"});
+
+    const auto sub = m_chain.subChain(3, 6);
+
+    ASSERT_EQ(nx::Buffer("lo, wo"), sub.toBuffer());
+    ASSERT_EQ(3U, sub.sliceCount());
+    ASSERT_EQ(m_chain.begin()->data() + 3, sub.begin()->data());
+}
+
+TEST_F(BufferChain, take_front)
+{
+    givenChain({"Hello", ", ", "world"});
+
+    const auto hel = m_chain.takeFront(3);
+    ASSERT_EQ("Hel", hel.view());
+    ASSERT_EQ(2, hel.useCount()); //< The slice of the chain slice.
+
+    const auto spanning = m_chain.takeFront(5);
+    ASSERT_EQ("lo, w", spanning.view());
+
+    ASSERT_EQ(4U, m_chain.size());
+    ASSERT_EQ(nx::Buffer("orld"), m_chain.toBuffer());
+}
+
+TEST_F(BufferChain, copy_to)
+{
+    givenChain({"Hello", ", ", "world"});
+
+    std::string data(5, '\0');
+    ASSERT_EQ(5U, m_chain.copyTo(data.data(), 4, 5));
+    ASSERT_EQ("o, wo", data);
+
+    ASSERT_EQ(2U, m_chain.copyTo(data.data(), 10));
+}
+
+} // namespace nx::test
@@ -585,10 +585,36 @@ TEST_F(StringHex, invalidHex)
     ASSERT_EQ("", fromHex("xyz"));
     ASSERT_EQ("12", fromHex("3132xyz"));
     ASSERT_EQ("1234", fromHex("3132xyz3334"));
+    ASSERT_EQ(std::string("\1\x23", 2), fromHex("123"));
+    ASSERT_EQ("\xab", fromHex("A B"));
+}
+
+TEST_F(StringHex, same_as_qt_for_all_lengths)
+{
+    for (int len = 0; len < 100; ++len)
+    {
+        std::string data(len, '\0');
+        std::generate(data.begin(), data.end(), &rand);
+        const auto hex = QByteArray::fromStdString(data).toHex().toStdString();
+        assertReversible(data, hex);
+
+        auto upperHex = hex;
+        toUpper(&upperHex);
+        ASSERT_EQ(data, fromHex(upperHex));
+
+        // A non-digit character in the vectorized block.
+        if (len > 20)
+        {
+            upperHex[37] = 'g';
+            ASSERT_EQ(
+                QByteArray::fromHex(QByteArray::fromStdString(upperHex)).toStdString(),
+                fromHex(upperHex));
+        }
+    }
 }
 
 //-------------------------------------------------------------------------------------------------
 // Base64
-// TODO: Add tests when introducing own implementation.
+// See base64_ut.cpp.
 
 } // namespace nx::utils::test
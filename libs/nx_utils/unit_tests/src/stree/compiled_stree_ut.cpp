@@ -0,0 +1,226 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <nx/utils/stree/compiled_stree.h>
+
+#include "test_fixture.h"
+
+namespace nx::utils::stree::test {
+
+namespace {
+
+static constexpr char kTree[] =
+    "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+    "<sequence>\n"
+    "    <set resName=\"outAttr\" resValue=\"default\"/>\n"
+    "    <condition resName=\"intAttr\" matchType=\"intRange\">\n"
+    "        <set value=\"0-9\" resName=\"outAttr\" resValue=\"digit\"/>\n"
+    "        <sequence value=\"10-99\">\n"
+    "            <set resName=\"outAttr\" resValue=\"number\"/>\n"
+    "            <condition resName=\"strAttr\" matchType=\"equal\">\n"
+    "                <set value=\"abc\" resName=\"outAttr\" resValue=\"number abc\"/>\n"
+    "            </condition>\n"
+    "        </sequence>\n"
+    "    </condition>\n"
+    "    <condition resName=\"strAttr\" matchType=\"wildcard\">\n"
+    "        <set value=\"x*\" resName=\"outAttr\" resValue=\"x-prefixed\"/>\n"
+    "    </condition>\n"
+    "    <condition resName=\"flagAttr\" matchType=\"presence\">\n"
+    "        <set value=\"true\" resName=\"flagOut\" resValue=\"present\"/>\n"
+    "        <set value=\"false\" resName=\"flagOut\" resValue=\"absent\"/>\n"
+    "    </condition>\n"
+    "</sequence>\n";
+
+static const std::vector<AttributeDictionary> kInputs = {
+    {},
+    {{Attributes::intAttr, "5"}},
+    {{Attributes::intAttr, "50"}},
+    {{Attributes::intAttr, "50"}, {Attributes::strAttr, "abc"}},
+    {{Attributes::intAttr, "500"}, {Attributes::strAttr, "abc"}},
+    {{Attributes::strAttr, "xyz"}},
+    {{Attributes::intAttr, "7"}, {Attributes::strAttr, "xyz"}, {"flagAttr", ""}},
+    {{"flagAttr", "1"}},
+};
+
+} // namespace
+
+class StreeCompiled:
+    public StreeFixture
+{
+protected:
+    void compile()
+    {
+        m_compiled = CompiledStree::compile(std::move(m_tree));
+    }
+
+    void givenTree(const char* xml)
+    {
+        ASSERT_TRUE(prepareTree(xml));
+        m_tree = StreeManager::loadStree(
+            QByteArray::fromRawData(xml, (int) std::strlen(xml)));
+        ASSERT_NE(nullptr, m_tree);
+        compile();
+    }
+
+    void assertSameResultAsTreeWalk(const AttributeDictionary& input)
+    {
+        AttributeDictionary expected;
+        streeRoot()->get(makeMultiReader(input, expected), &expected);
+
+        AttributeDictionary actual;
+        m_compiled.search(makeMultiReader(input, actual), &actual);
+
+        ASSERT_EQ(expected.data(), actual.data()) << input.toString();
+    }
+
+protected:
+    std::unique_ptr<AbstractNode> m_tree;
+    CompiledStree m_compiled;
+};
+
+TEST_F(StreeCompiled, produces_same_output_as_tree_walk)
+{
+    givenTree(kTree);
+
+    // outAttr, intAttr, strAttr, flagAttr, flagOut.
+    ASSERT_EQ(5U, m_compiled.attributeNames().size());
+
+    for (const auto& input: kInputs)
+        assertSameResultAsTreeWalk(input);
+}
+
+TEST_F(StreeCompiled, output_attributes_are_visible_to_subsequent_conditions)
+{
+    givenTree(
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<sequence>\n"
+        "    <set resName=\"strAttr\" resValue=\"abc\"/>\n"
+        "    <condition resName=\"strAttr\">\n"
+        "        <set value=\"abc\" resName=\"outAttr\" resValue=\"found\"/>\n"
+        "    </condition>\n"
+        "</sequence>\n");
+
+    AttributeDictionary output;
+    m_compiled.search(makeMultiReader(AttributeDictionary(), output), &output);
+    ASSERT_EQ("found", output.get<std::string>(Attributes::outAttr));
+}
+
+TEST_F(StreeCompiled, empty_tree_produces_nothing)
+{
+    compile();
+    ASSERT_TRUE(m_compiled.empty());
+
+    AttributeDictionary output;
+    m_compiled.search(AttributeDictionary(), &output);
+    ASSERT_TRUE(output.empty());
+}
+
+namespace {
+
+class CustomNode:
+    public AbstractNode
+{
+public:
+    virtual void get(const AbstractAttributeReader& in, AbstractAttributeWriter* out) const override
+    {
+        out->put(Attributes::outAttr, in.get<std::string>(Attributes::strAttr).value_or("none"));
+    }
+
+    virtual bool addChild(const std::string_view&, std::unique_ptr<AbstractNode>) override
+    {
+        return false;
+    }
+};
+
+} // namespace
+
+TEST_F(StreeCompiled, custom_node_is_invoked_via_get)
+{
+    auto root = std::make_unique<SequenceNode>();
+    root->addChild("0", std::make_unique<SetNode>("intAttr", "1"));
+    root->addChild("1", std::make_unique<CustomNode>());
+    m_tree = std::move(root);
+    compile();
+
+    AttributeDictionary output;
+    m_compiled.search(AttributeDictionary{{Attributes::strAttr, "abc"}}, &output);
+    ASSERT_EQ("abc", output.get<std::string>(Attributes::outAttr));
+    ASSERT_EQ(1, output.get<int>(Attributes::intAttr));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+TEST(FlatAttributeDictionary, put_get)
+{
+    FlatAttributeDictionary dictionary{{"a", "1"}, {"b", "2"}};
+    dictionary.put("a", 3);
+    dictionary.put("c", std::string("4"));
+
+    ASSERT_EQ(3, dictionary.get<int>("a"));
+    ASSERT_EQ("2", dictionary.get<std::string>("b"));
+    ASSERT_EQ("4", dictionary.get<std::string>("c"));
+    ASSERT_FALSE(dictionary.contains("d"));
+    ASSERT_EQ(3U, dictionary.data().size());
+
+    int count = 0;
+    for (auto it = dictionary.begin(); !it->atEnd(); it->next())
+        ++count;
+    ASSERT_EQ(3, count);
+
+    dictionary.clear();
+    ASSERT_TRUE(dictionary.empty());
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Compares the tree walk over AttributeDictionary with the compiled tree over
+ * FlatAttributeDictionary.
+ */
+TEST_F(StreeCompiled, DISABLED_search_performance)
+{
+    static constexpr int kIterations = 1'000'000;
+
+    givenTree(kTree);
+
+    std::vector<FlatAttributeDictionary> flatInputs;
+    for (const auto& input: kInputs)
+        flatInputs.emplace_back(FlatAttributeDictionary::Container(
+            input.data().begin(), input.data().end()));
+
+    const auto measure =
+        [](auto func)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i)
+                func(i);
+            const std::chrono::duration<double> duration =
+                std::chrono::steady_clock::now() - start;
+            return kIterations / duration.count();
+        };
+
+    const auto treeWalk = measure(
+        [this](int i)
+        {
+            AttributeDictionary output;
+            const auto& input = kInputs[i % kInputs.size()];
+            streeRoot()->get(makeMultiReader(input, output), &output);
+        });
+
+    const auto compiled = measure(
+        [this, &flatInputs](int i)
+        {
+            FlatAttributeDictionary output;
+            const auto& input = flatInputs[i % flatInputs.size()];
+            m_compiled.search(makeMultiReader(input, output), &output);
+        });
+
+    std::cout << "Tree walk: " << treeWalk << " searches/s. "
+        << "Compiled: " << compiled << " searches/s" << std::endl;
+}
+
+} // namespace nx::utils::stree::test
@@ -0,0 +1,188 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/thread/bounded_sync_queue.h>
+#include <nx/utils/thread/sync_queue.h>
+
+namespace nx::utils::test {
+
+TEST(BoundedSyncQueue, elements_are_popped_in_push_order)
+{
+    BoundedSyncQueue<std::string> queue(4);
+    ASSERT_EQ(4U, queue.capacity());
+    ASSERT_TRUE(queue.empty());
+
+    queue.push("1");
+    queue.emplace(1, '2');
+    ASSERT_EQ(2U, queue.size());
+
+    ASSERT_EQ("1", queue.pop());
+    ASSERT_EQ("2", queue.pop());
+    ASSERT_FALSE(queue.tryPop());
+    ASSERT_FALSE(queue.pop(std::chrono::milliseconds(1)));
+}
+
+TEST(BoundedSyncQueue, capacity_is_rounded_up_to_power_of_two)
+{
+    BoundedSyncQueue<int> queue(5);
+    ASSERT_EQ(8U, queue.capacity());
+}
+
+TEST(BoundedSyncQueue, try_push_fails_on_full_queue)
+{
+    BoundedSyncQueue<int> queue(2);
+    ASSERT_TRUE(queue.tryPush(1));
+    ASSERT_TRUE(queue.tryPush(2));
+    ASSERT_FALSE(queue.tryPush(3));
+
+    ASSERT_EQ(1, queue.pop());
+    ASSERT_TRUE(queue.tryPush(3));
+}
+
+TEST(BoundedSyncQueue, drop_oldest_policy)
+{
+    BoundedSyncQueue<int> queue(4, QueueOverflowPolicy::dropOldest);
+    for (int i = 0; i < 10; ++i)
+        queue.push(i);
+
+    ASSERT_EQ(6U, queue.droppedCount());
+
+    std::vector<int> values;
+    ASSERT_EQ(4U, queue.popBatch(&values, 100));
+    ASSERT_EQ((std::vector<int>{6, 7, 8, 9}), values);
+}
+
+TEST(BoundedSyncQueue, batch_operations)
+{
+    BoundedSyncQueue<int> queue(16);
+    queue.pushBatch({1, 2, 3, 4, 5});
+
+    std::vector<int> values;
+    ASSERT_EQ(3U, queue.popBatch(&values, 3));
+    ASSERT_EQ(2U, queue.popBatch(&values, 3));
+    ASSERT_EQ((std::vector<int>{1, 2, 3, 4, 5}), values);
+
+    ASSERT_EQ(0U, queue.popBatch(&values, 3, std::chrono::milliseconds(1)));
+}
+
+TEST(BoundedSyncQueue, blocked_producer_is_resumed_by_consumer)
+{
+    BoundedSyncQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+
+    std::thread producer([&queue]() { queue.push(3); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(1, queue.pop());
+    producer.join();
+
+    ASSERT_EQ(2, queue.pop());
+    ASSERT_EQ(3, queue.pop());
+}
+
+TEST(BoundedSyncQueue, multiple_producers_and_consumers)
+{
+    static constexpr int kProducerCount = 4;
+    static constexpr int kConsumerCount = 4;
+    static constexpr int kValuesPerProducer = 20'000;
+
+    BoundedSyncQueue<int> queue(64);
+    std::atomic<long long> sum{0};
+    std::atomic<int> poppedCount{0};
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kProducerCount; ++i)
+    {
+        threads.emplace_back(
+            [&queue]()
+            {
+                for (int value = 1; value <= kValuesPerProducer; ++value)
+                    queue.push(value);
+            });
+    }
+
+    for (int i = 0; i < kConsumerCount; ++i)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                std::vector<int> values;
+                while (poppedCount < kProducerCount * kValuesPerProducer)
+                {
+                    values.clear();
+                    queue.popBatch(&values, 16, std::chrono::milliseconds(10));
+                    sum += std::accumulate(values.begin(), values.end(), 0LL);
+                    poppedCount += (int) values.size();
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+        thread.join();
+
+    ASSERT_EQ(
+        (long long) kProducerCount * kValuesPerProducer * (kValuesPerProducer + 1) / 2,
+        sum.load());
+    ASSERT_TRUE(queue.empty());
+}
+
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+
+template<typename Queue>
+double itemsPerSecond(Queue* queue, int threadCount)
+{
+    static constexpr int kValuesPerProducer = 1'000'000;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(
+            [queue]()
+            {
+                for (int value = 0; value < kValuesPerProducer; ++value)
+                    queue->push(value);
+            });
+        threads.emplace_back(
+            [queue]()
+            {
+                for (int value = 0; value < kValuesPerProducer; ++value)
+                    queue->pop();
+            });
+    }
+    for (auto& thread: threads)
+        thread.join();
+
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    return (double) kValuesPerProducer * threadCount / duration.count();
+}
+
+} // namespace
+
+/**
+ * Compares the throughput of BoundedSyncQueue and SyncQueue with the given number of producers
+ * and the same number of consumers.
+ */
+TEST(BoundedSyncQueue, DISABLED_throughput)
+{
+    std::cout << "producers, SyncQueue items/s, BoundedSyncQueue items/s" << std::endl;
+
+    for (int threadCount = 1; threadCount <= 8; threadCount *= 2)
+    {
+        SyncQueue<int> syncQueue;
+        BoundedSyncQueue<int> boundedQueue(1024);
+        std::cout << threadCount << ", "
+            << itemsPerSecond(&syncQueue, threadCount) << ", "
+            << itemsPerSecond(&boundedQueue, threadCount) << std::endl;
+    }
+}
+
+} // namespace nx::utils::test
@@ -0,0 +1,158 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/thread/lock_contention_profiler.h>
+#include <nx/utils/thread/mutex_delegates_profile.h>
+
+namespace nx::test {
+
+using namespace std::chrono;
+
+static constexpr char kSourceFile[] = "test_source.cpp";
+static constexpr milliseconds kHoldTime(50);
+
+class LockContentionProfiler:
+    public ::testing::Test
+{
+protected:
+    nx::LockContentionProfiler m_profiler{/*samplingPeriod*/ 1};
+
+    void givenMutexHeldByAnotherThread(MutexProfileDelegate* mutex, int sourceLine)
+    {
+        m_holder = std::thread(
+            [this, mutex, sourceLine]()
+            {
+                mutex->lock(kSourceFile, sourceLine, 0);
+                m_isLocked = true;
+                std::this_thread::sleep_for(kHoldTime);
+                mutex->unlock();
+            });
+
+        while (!m_isLocked)
+            std::this_thread::yield();
+    }
+
+    void whenLock(MutexProfileDelegate* mutex, int sourceLine)
+    {
+        mutex->lock(kSourceFile, sourceLine, 0);
+        mutex->unlock();
+    }
+
+    void waitForHolderThread()
+    {
+        m_holder.join();
+    }
+
+    LockSiteStatistics site(int sourceLine, LockKind kind)
+    {
+        const auto location = std::string(kSourceFile) + ":" + std::to_string(sourceLine);
+        for (const auto& site: m_profiler.report(nx::LockContentionProfiler::kMaxSiteCount).sites)
+        {
+            if (site.location == location && site.kind == kind)
+                return site;
+        }
+
+        ADD_FAILURE() << location << " is not reported";
+        return {};
+    }
+
+private:
+    std::thread m_holder;
+    std::atomic<bool> m_isLocked{false};
+};
+
+TEST_F(LockContentionProfiler, wait_and_hold_times_are_reported)
+{
+    MutexProfileDelegate mutex(Mutex::NonRecursive, &m_profiler);
+
+    givenMutexHeldByAnotherThread(&mutex, 1);
+    whenLock(&mutex, 2);
+    waitForHolderThread();
+
+    const auto holder = site(1, LockKind::mutex);
+    ASSERT_EQ(1U, holder.sampledLockCount);
+    ASSERT_EQ(0U, holder.contendedLockCount);
+    ASSERT_GE(holder.maxHoldTimeUsec, kHoldTime / 2);
+
+    const auto waiter = site(2, LockKind::mutex);
+    ASSERT_EQ(1U, waiter.sampledLockCount);
+    ASSERT_EQ(1U, waiter.contendedLockCount);
+    ASSERT_GE(waiter.totalWaitTimeUsec, kHoldTime / 2);
+    ASSERT_EQ(waiter.totalWaitTimeUsec, waiter.maxWaitTimeUsec);
+
+    const auto report = m_profiler.report(1);
+    ASSERT_EQ(1U, report.sites.size());
+    ASSERT_EQ(waiter.location, report.sites.front().location);
+}
+
+TEST_F(LockContentionProfiler, only_each_nth_lock_is_sampled)
+{
+    m_profiler.setSamplingPeriod(10);
+    MutexProfileDelegate mutex(Mutex::NonRecursive, &m_profiler);
+
+    for (int i = 0; i < 100; ++i)
+        whenLock(&mutex, 1);
+
+    ASSERT_EQ(10U, site(1, LockKind::mutex).sampledLockCount);
+}
+
+TEST_F(LockContentionProfiler, recursive_mutex_hold_time_is_counted_once)
+{
+    MutexProfileDelegate mutex(Mutex::Recursive, &m_profiler);
+
+    mutex.lock(kSourceFile, 1, 0);
+    mutex.lock(kSourceFile, 2, 0);
+    mutex.unlock();
+    std::this_thread::sleep_for(kHoldTime);
+    mutex.unlock();
+
+    ASSERT_GE(site(1, LockKind::mutex).totalHoldTimeUsec, kHoldTime / 2);
+    ASSERT_EQ(microseconds::zero(), site(2, LockKind::mutex).totalHoldTimeUsec);
+}
+
+TEST_F(LockContentionProfiler, read_write_lock_sites_are_reported_by_kind)
+{
+    ReadWriteLockProfileDelegate lock(ReadWriteLock::NonRecursive, &m_profiler);
+
+    lock.lockForWrite(kSourceFile, 1, 0);
+    std::this_thread::sleep_for(kHoldTime);
+    lock.unlock();
+
+    lock.lockForRead(kSourceFile, 1, 0);
+    lock.lockForRead(kSourceFile, 1, 0);
+    lock.unlock();
+    lock.unlock();
+
+    ASSERT_GE(site(1, LockKind::writeLock).totalHoldTimeUsec, kHoldTime / 2);
+    ASSERT_EQ(2U, site(1, LockKind::readLock).sampledLockCount);
+}
+
+TEST_F(LockContentionProfiler, wait_condition_does_not_count_waiting_as_holding)
+{
+    MutexProfileDelegate mutex(Mutex::NonRecursive, &m_profiler);
+    WaitConditionProfileDelegate waitCondition;
+
+    mutex.lock(kSourceFile, 1, 0);
+    waitCondition.wait(&mutex, kHoldTime);
+    mutex.unlock();
+
+    ASSERT_LT(site(1, LockKind::mutex).totalHoldTimeUsec, kHoldTime / 2);
+}
+
+TEST_F(LockContentionProfiler, clear)
+{
+    MutexProfileDelegate mutex(Mutex::NonRecursive, &m_profiler);
+    whenLock(&mutex, 1);
+
+    m_profiler.clear();
+
+    ASSERT_TRUE(m_profiler.report(10).sites.empty());
+}
+
+} // namespace nx::test
@@ -0,0 +1,157 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/coro/task.h>
+#include <nx/utils/thread/cf/async_thread_pool_executor.h>
+#include <nx/utils/thread/cf/cfuture.h>
+#include <nx/utils/thread/cf/work_stealing_executor.h>
+
+namespace {
+
+void waitFor(const std::atomic<int>& counter, int value)
+{
+    while (counter.load() < value)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+/** Each task of the tree posts two children until the given depth is reached. */
+template<typename Executor>
+void postTree(Executor* executor, int depth, std::atomic<int>* done)
+{
+    executor->post(
+        [executor, depth, done]()
+        {
+            if (depth > 0)
+            {
+                postTree(executor, depth - 1, done);
+                postTree(executor, depth - 1, done);
+            }
+            ++*done;
+        });
+}
+
+nx::coro::FireAndForget switchThread(
+    cf::work_stealing_executor* executor,
+    std::thread::id callerThread,
+    std::promise<bool>* switched)
+{
+    co_await executor->schedule();
+    switched->set_value(std::this_thread::get_id() != callerThread);
+}
+
+} // namespace
+
+TEST(WorkStealingExecutor, executes_tasks_posted_from_outside)
+{
+    static constexpr int kTaskCount = 1000;
+
+    cf::work_stealing_executor executor(4);
+    std::atomic<int> done{0};
+    for (int i = 0; i < kTaskCount; ++i)
+        executor.post([&done]() { ++done; });
+
+    waitFor(done, kTaskCount);
+    ASSERT_EQ(kTaskCount, done.load());
+}
+
+TEST(WorkStealingExecutor, tasks_posted_by_workers_are_stolen_by_idle_workers)
+{
+    static constexpr int kDepth = 12;
+    static constexpr int kTaskCount = (1 << (kDepth + 1)) - 1;
+
+    cf::work_stealing_executor executor(4);
+    std::atomic<int> done{0};
+    postTree(&executor, kDepth, &done);
+    waitFor(done, kTaskCount);
+
+    const auto statistics = executor.statistics();
+    ASSERT_EQ(4U, statistics.worker_queue_depths.size());
+    ASSERT_EQ(0U, statistics.queue_depth());
+    // The counter is incremented after the last task is done.
+    ASSERT_GE(statistics.executed + 1, (uint64_t) kTaskCount);
+}
+
+TEST(WorkStealingExecutor, then_continuation)
+{
+    cf::work_stealing_executor executor(2);
+
+    auto future = cf::async(executor, []() { return 20; })
+        .then(executor, [](cf::future<int> value) { return value.get() + 1; })
+        .then(executor, [](cf::future<int> value) { return value.get() * 2; });
+
+    ASSERT_EQ(42, future.get());
+}
+
+TEST(WorkStealingExecutor, coroutine_is_resumed_on_worker)
+{
+    cf::work_stealing_executor executor(2);
+    std::promise<bool> switched;
+    auto result = switched.get_future();
+
+    switchThread(&executor, std::this_thread::get_id(), &switched);
+    ASSERT_TRUE(result.get());
+}
+
+TEST(WorkStealingExecutor, idle_workers_park)
+{
+    cf::work_stealing_executor executor(2, /*spin_count*/ 1);
+    std::atomic<int> done{0};
+    executor.post([&done]() { ++done; });
+    waitFor(done, 1);
+
+    while (executor.statistics().parks < 2)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // A parked worker is woken up by a new task.
+    executor.post([&done]() { ++done; });
+    waitFor(done, 2);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+
+template<typename Executor>
+double tasksPerSecond(Executor* executor)
+{
+    static constexpr int kDepth = 16;
+    static constexpr int kTaskCount = (1 << (kDepth + 1)) - 1;
+
+    std::atomic<int> done{0};
+    const auto start = std::chrono::steady_clock::now();
+    postTree(executor, kDepth, &done);
+    waitFor(done, kTaskCount);
+
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    return kTaskCount / duration.count();
+}
+
+} // namespace
+
+/**
+ * Compares the throughput of work_stealing_executor and async_thread_pool_executor on a tree of
+ * small tasks, each posting its children.
+ */
+TEST(WorkStealingExecutor, DISABLED_throughput)
+{
+    const auto threadCount = std::max(2U, std::thread::hardware_concurrency());
+
+    cf::async_thread_pool_executor threadPool(threadCount);
+    std::cout << "async_thread_pool_executor: " << tasksPerSecond(&threadPool) << " tasks/s"
+        << std::endl;
+
+    cf::work_stealing_executor workStealing(threadCount);
+    std::cout << "work_stealing_executor: " << tasksPerSecond(&workStealing) << " tasks/s"
+        << std::endl;
+
+    const auto statistics = workStealing.statistics();
+    std::cout << "steals: " << statistics.steals << ", failed steals: "
+        << statistics.failed_steals << ", parks: " << statistics.parks << std::endl;
+}
@@ -0,0 +1,95 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <nx/utils/trace/trace.h>
+
+namespace nx::utils::trace::test {
+
+class Trace: public ::testing::Test
+{
+protected:
+    virtual void TearDown() override
+    {
+        Log::disable();
+    }
+
+    /** @return The exported events with the given name, in the recording order. */
+    static std::vector<QJsonObject> exportedEvents(const QString& name)
+    {
+        const auto json = Log::exportRecording();
+        QJsonParseError error;
+        const auto document = QJsonDocument::fromJson(QByteArray::fromStdString(json), &error);
+        EXPECT_EQ(QJsonParseError::NoError, error.error) << json;
+
+        std::vector<QJsonObject> events;
+        for (const auto& event: document.object()["traceEvents"].toArray())
+        {
+            if (event.toObject()["name"].toString() == name)
+                events.push_back(event.toObject());
+        }
+        return events;
+    }
+};
+
+TEST_F(Trace, recording_keeps_latest_events_of_thread)
+{
+    ASSERT_TRUE(Log::startRecording(/*eventsPerThread*/ 2));
+
+    for (int i = 0; i < 5; ++i)
+    {
+        NX_TRACE_CATEGORY_SCOPE("test", "step").args({{"index", i}});
+    }
+    Log::disable();
+
+    const auto events = exportedEvents("step");
+    ASSERT_EQ(2, events.size());
+    ASSERT_EQ(3, events[0]["args"].toObject()["index"].toInt());
+    ASSERT_EQ(4, events[1]["args"].toObject()["index"].toInt());
+    ASSERT_EQ("X", events[0]["ph"].toString());
+    ASSERT_EQ("test", events[0]["cat"].toString());
+}
+
+TEST_F(Trace, recording_includes_finished_threads)
+{
+    ASSERT_TRUE(Log::startRecording());
+
+    std::thread([]() { NX_TRACE_CATEGORY_BEGIN_ASYNC("test", "request", 7); }).join();
+    NX_TRACE_CATEGORY_END_ASYNC("test", "request", 7);
+
+    const auto events = exportedEvents("request");
+    ASSERT_EQ(2, events.size());
+    for (const auto& event: events)
+        ASSERT_EQ(7, event["id2"].toObject()["local"].toInt());
+}
+
+TEST_F(Trace, restarting_recording_drops_previous_events)
+{
+    ASSERT_TRUE(Log::startRecording());
+    NX_TRACE_INSTANT("old");
+    Log::disable();
+
+    ASSERT_TRUE(Log::startRecording());
+    NX_TRACE_INSTANT("new");
+    NX_TRACE_INSTANT("new");
+
+    ASSERT_TRUE(exportedEvents("old").empty());
+    ASSERT_EQ(2, exportedEvents("new").size());
+}
+
+TEST_F(Trace, nothing_is_recorded_when_disabled)
+{
+    ASSERT_TRUE(Log::startRecording());
+    Log::disable();
+
+    NX_TRACE_INSTANT("ignored");
+    ASSERT_TRUE(exportedEvents("ignored").empty());
+}
+
+} // namespace nx::utils::trace::test
@@ -0,0 +1,121 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/byte_stream/custom_output_stream.h>
+#include <nx/utils/gzip/gzip_compressor.h>
+#include <nx/utils/zstd/zstd_compressor.h>
+#include <nx/utils/zstd/zstd_uncompressor.h>
+
+namespace nx::utils::test {
+
+using namespace nx::utils::bstream;
+
+namespace {
+
+nx::Buffer generateJson(int recordCount)
+{
+    nx::Buffer result("[");
+    for (int i = 0; i < recordCount; ++i)
+    {
+        if (i > 0)
+            result += ",";
+        result += "{\"id\":\"{" + std::to_string(i * 7919) + "}\",\"name\":\"Camera "
+            + std::to_string(i) + "\",\"url\":\"rtsp://192.168.0." + std::to_string(i % 255)
+            + "/stream\",\"status\":\"Online\"}";
+    }
+    result += "]";
+    return result;
+}
+
+} // namespace
+
+TEST(Zstd, compress_uncompress)
+{
+    const auto data = generateJson(1000);
+
+    const auto compressed = zstd::Compressor::compressData(data);
+    ASSERT_TRUE(zstd::Compressor::isZstdCompressed(compressed));
+    ASSERT_LT(compressed.size(), data.size());
+
+    ASSERT_EQ(data, zstd::Compressor::uncompressData(compressed));
+}
+
+TEST(Zstd, streaming_compression_produces_a_frame_per_flush)
+{
+    const auto data = generateJson(100);
+
+    nx::Buffer compressed;
+    zstd::Compressor compressor(makeCustomOutputStream(
+        [&compressed](const auto& data) { compressed += data; }));
+
+    for (int i = 0; i < 2; ++i)
+    {
+        for (std::size_t pos = 0; pos < data.size(); pos += 100)
+            ASSERT_TRUE(compressor.processData(data.substr(pos, 100)));
+        ASSERT_GT(compressor.flush(), 0U);
+    }
+    ASSERT_EQ(0U, compressor.flush());
+
+    ASSERT_EQ(data + data, zstd::Compressor::uncompressData(compressed));
+}
+
+TEST(Zstd, uncompressor_accepts_data_split_at_any_position)
+{
+    const auto data = generateJson(1000);
+    const auto compressed = zstd::Compressor::compressData(data);
+
+    nx::Buffer uncompressed;
+    zstd::Uncompressor uncompressor(makeCustomOutputStream(
+        [&uncompressed](const auto& data) { uncompressed += data; }));
+
+    for (std::size_t pos = 0; pos < compressed.size(); pos += 7)
+        ASSERT_TRUE(uncompressor.processData(compressed.substr(pos, 7)));
+
+    ASSERT_EQ(data, uncompressed);
+}
+
+TEST(Zstd, malformed_input_is_reported)
+{
+    nx::Buffer uncompressed;
+    zstd::Uncompressor uncompressor(makeCustomOutputStream(
+        [&uncompressed](const auto& data) { uncompressed += data; }));
+
+    ASSERT_FALSE(uncompressor.processData(nx::Buffer("\x28\xb5\x2f\xfd garbage")));
+    ASSERT_FALSE(uncompressor.processData(nx::Buffer("more")));
+}
+
+/**
+ * Compares the compression speed and ratio of gzip and zstd on a JSON document.
+ */
+TEST(Zstd, DISABLED_compression_performance)
+{
+    static constexpr int kIterations = 100;
+    const auto data = generateJson(10'000);
+
+    const auto measure =
+        [&data](const std::string& name, auto compress)
+        {
+            nx::Buffer compressed;
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i)
+                compressed = compress(data);
+            const std::chrono::duration<double> duration =
+                std::chrono::steady_clock::now() - start;
+
+            std::cout << name << ": " << (data.size() * kIterations / duration.count() / 1e6)
+                << " MB/s, ratio " << ((double) data.size() / compressed.size()) << std::endl;
+        };
+
+    measure("gzip", [](const auto& data) { return gzip::Compressor::compressData(data); });
+    for (const int level: {1, zstd::kDefaultCompressionLevel, 9})
+    {
+        measure("zstd " + std::to_string(level),
+            [level](const auto& data) { return zstd::Compressor::compressData(data, level); });
+    }
+}
+
+} // namespace nx::utils::test
@@ -2,13 +2,21 @@
 
 #include "extractor.h"
 
+#include <algorithm>
+#include <thread>
+
+#include <QtCore/QThread>
+
+#include <nx/utils/scope_guard.h>
 #include <quazip/quazip.h>
 #include <quazip/quazipfile.h>
 
 namespace {
 
-const int kReadBufferSizeBytes = 1024 * 16;
-const int maxSymlinkLength = kReadBufferSizeBytes;
+// Large buffers make both the inflating and the writing to the disk much cheaper per byte.
+const int kReadBufferSizeBytes = 1024 * 1024;
+const int maxSymlinkLength = 1024 * 16;
+const int kMaxDefaultThreadCount = 4;
 
 bool isSymlink(const QuaZipFileInfo64& info)
 {
@@ -21,7 +29,15 @@ bool isSymlink(const QuaZipFileInfo64& info)
 
 namespace nx::zip {
 
+struct Extractor::Entry
+{
+    unz64_file_pos position{};
+    QString name;
+    QFile::Permissions permissions;
+};
+
 Extractor::Extractor(const QString& fileName, const QDir& targetDir):
+    m_fileName(fileName),
     m_dir(targetDir),
     m_zip(new QuaZip(fileName))
 {
@@ -33,6 +49,11 @@ Extractor::~Extractor()
     stop();
 }
 
+void Extractor::setThreadCount(int threadCount)
+{
+    m_threadCount = threadCount;
+}
+
 QString Extractor::errorToString(Extractor::Error error)
 {
     switch (error)
@@ -81,9 +102,15 @@ Extractor::Error Extractor::extractZip()
     if (!m_zip->open(QuaZip::mdUnzip))
         return BrokenZip;
 
+    auto zipGuard = nx::utils::makeScopeGuard([this]() { m_zip->close(); });
+
     m_extracted = 0;
     QList<QPair<QString, QString>> symlinks;
 
+    // The directories are created and the symlinks are read here, so the threads below only
+    // inflate the regular files.
+    std::vector<Entry> entries;
+
     QuaZipFile file(m_zip.get());
     for (bool more = m_zip->goToFirstFile(); more && !m_needStop; more = m_zip->goToNextFile())
     {
@@ -113,36 +140,41 @@ Extractor::Error Extractor::extractZip()
 
         if (!info.name.endsWith("/"))
         {
-            QFile destFile(m_dir.absoluteFilePath(info.name));
-            if (!destFile.open(QFile::WriteOnly))
-                return CantOpenFile;
-
-            if (!file.open(QuaZipFile::ReadOnly))
+            Entry entry;
+            if (unzGetFilePos64(m_zip->getUnzFile(), &entry.position) != UNZ_OK)
                 return BrokenZip;
 
-            QByteArray buf(kReadBufferSizeBytes, 0);
-            while (file.bytesAvailable() && !m_needStop)
-            {
-                qint64 read = file.read(buf.data(), kReadBufferSizeBytes);
-                if (read != destFile.write(buf.data(), read))
-                {
-                    file.close();
-                    return NoFreeSpace;
-                }
-                m_extracted += read;
-            }
-
-            auto permissions = info.getPermissions();
-            permissions |= QFile::ReadOwner;
-            permissions |= QFile::ReadUser;
-            permissions |= QFile::ReadGroup;
-            destFile.setPermissions(permissions);
-            destFile.close();
-            file.close();
+            entry.name = info.name;
+            entry.permissions = info.getPermissions()
+                | QFile::ReadOwner | QFile::ReadUser | QFile::ReadGroup;
+            entries.push_back(std::move(entry));
         }
+    }
+
+    if (m_needStop)
+        return Stopped;
+
+    const int threadCount = std::clamp(
+        m_threadCount > 0
+            ? m_threadCount
+            : std::min(QThread::idealThreadCount(), kMaxDefaultThreadCount),
+        1,
+        std::max((int) entries.size(), 1));
+
+    std::atomic<size_t> nextEntry = 0;
+    std::vector<Error> results(threadCount, Ok);
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; ++i)
+        threads.emplace_back([&, i]() { results[i] = extractEntries(entries, &nextEntry); });
 
-        if (m_needStop)
-            return Stopped;
+    results[0] = extractEntries(entries, &nextEntry);
+    for (auto& thread: threads)
+        thread.join();
+
+    for (const Error error: results)
+    {
+        if (error != Ok)
+            return error;
     }
 
     for (const QPair<QString, QString>& symlink: symlinks)
@@ -156,11 +188,77 @@ Extractor::Error Extractor::extractZip()
     if (m_needStop)
         return Stopped;
 
-    m_zip->close();
+    zipGuard.fire();
 
     return m_zip->getZipError() == UNZ_OK ? Ok : BrokenZip;
 }
 
+Extractor::Error Extractor::extractEntries(
+    const std::vector<Entry>& entries, std::atomic<size_t>* nextEntry)
+{
+    const auto fail =
+        [&entries, nextEntry](Error error)
+        {
+            // Makes the other threads stop after their current entries.
+            *nextEntry = entries.size();
+            return error;
+        };
+
+    // QuaZip is not thread-safe, so each thread reads the zip file via its own instance.
+    QuaZip zip(m_fileName);
+    if (!zip.open(QuaZip::mdUnzip) || !zip.goToFirstFile())
+        return fail(BrokenZip);
+
+    QuaZipFile file(&zip);
+    QByteArray buffer(kReadBufferSizeBytes, Qt::Uninitialized);
+
+    for (size_t i = (*nextEntry)++; i < entries.size() && !m_needStop; i = (*nextEntry)++)
+    {
+        const Entry& entry = entries[i];
+        if (unzGoToFilePos64(zip.getUnzFile(), &entry.position) != UNZ_OK)
+            return fail(BrokenZip);
+
+        QFile destFile(m_dir.absoluteFilePath(entry.name));
+        if (!destFile.open(QFile::WriteOnly | QFile::Unbuffered))
+            return fail(CantOpenFile);
+
+        if (!file.open(QuaZipFile::ReadOnly))
+            return fail(BrokenZip);
+
+        while (!m_needStop)
+        {
+            const qint64 read = file.read(buffer.data(), buffer.size());
+            if (read < 0)
+            {
+                file.close();
+                return fail(BrokenZip);
+            }
+
+            if (read == 0)
+                break;
+
+            if (read != destFile.write(buffer.data(), read))
+            {
+                file.close();
+                return fail(NoFreeSpace);
+            }
+            m_extracted += read;
+        }
+
+        // Closing the entry verifies its CRC, if it was read completely.
+        file.close();
+        if (file.getZipError() != UNZ_OK)
+            return fail(BrokenZip);
+
+        destFile.setPermissions(entry.permissions);
+        destFile.close();
+    }
+
+    zip.close();
+
+    return m_needStop ? Stopped : Ok;
+}
+
 QStringList Extractor::fileList()
 {
     if (!m_zip->open(QuaZip::mdUnzip))
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <atomic>
+#include <vector>
 
 #include <QtCore/QDir>
 
@@ -33,6 +34,13 @@ public:
     Extractor(const QString& fileName, const QDir& targetDir);
     virtual ~Extractor() override;
 
+    /**
+     * Sets the number of threads inflating the zip entries in parallel, each thread reads the zip
+     * file on its own. By default, the ideal thread count is used, but not more than 4 threads,
+     * because the extraction becomes disk-bound.
+     */
+    void setThreadCount(int threadCount);
+
     static QString errorToString(Error error);
 
     Error error() const;
@@ -54,10 +62,17 @@ protected:
     virtual void run() override;
 
 private:
+    struct Entry;
+
+    Error extractEntries(const std::vector<Entry>& entries, std::atomic<size_t>* nextEntry);
+
+private:
+    const QString m_fileName;
     QDir m_dir;
     QScopedPointer<QuaZip> m_zip;
     std::atomic_int64_t m_extracted;
     Error m_lastError = Ok;
+    int m_threadCount = 0;
 };
 
 } // namespace nx::zip
@@ -0,0 +1,524 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "stream_extractor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QIODevice>
+#include <QtCore/QtEndian>
+
+#include <zlib.h>
+
+namespace {
+
+const int kBufferSizeBytes = 1024 * 1024;
+const int kMaxSymlinkLength = 1024 * 16;
+const int kReadTimeoutMs = 30000;
+
+const quint32 kLocalHeaderSignature = 0x04034b50;
+const quint32 kDataDescriptorSignature = 0x08074b50;
+const quint32 kCentralDirectoryHeaderSignature = 0x02014b50;
+const quint32 kEndOfCentralDirectorySignature = 0x06054b50;
+const quint32 kZip64EndOfCentralDirectorySignature = 0x06064b50;
+const quint32 kZip64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+
+const int kLocalHeaderSize = 30;
+const int kCentralDirectoryHeaderSize = 46;
+
+const quint16 kEncryptedFlag = 0x0001;
+const quint16 kDataDescriptorFlag = 0x0008;
+const quint16 kUtf8NameFlag = 0x0800;
+
+const quint16 kStoredMethod = 0;
+const quint16 kDeflatedMethod = 8;
+
+quint16 readUInt16(const char* data)
+{
+    return qFromLittleEndian<quint16>(data);
+}
+
+quint32 readUInt32(const char* data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+quint64 readUInt64(const char* data)
+{
+    return qFromLittleEndian<quint64>(data);
+}
+
+/** The same conversion as QuaZipFileInfo64::getPermissions() does. */
+QFile::Permissions permissionsFromExternalAttributes(quint32 externalAttributes)
+{
+    static const std::pair<quint32, QFile::Permission> kModeBits[] = {
+        {0400, QFile::ReadOwner}, {0200, QFile::WriteOwner}, {0100, QFile::ExeOwner},
+        {0040, QFile::ReadGroup}, {0020, QFile::WriteGroup}, {0010, QFile::ExeGroup},
+        {0004, QFile::ReadOther}, {0002, QFile::WriteOther}, {0001, QFile::ExeOther},
+    };
+
+    const quint32 mode = externalAttributes >> 16;
+    QFile::Permissions permissions;
+    for (const auto& [bit, permission]: kModeBits)
+    {
+        if (mode & bit)
+            permissions |= permission;
+    }
+    return permissions;
+}
+
+bool isSymlink(quint32 externalAttributes)
+{
+    // The higher 4 bits contain the file type, 0xA is a symlink.
+    return (externalAttributes >> 28) == 0xA;
+}
+
+} // namespace
+
+namespace nx::zip {
+
+class StreamExtractor::Private
+{
+public:
+    enum class State
+    {
+        signature,
+        localHeader,
+        entryData,
+        dataDescriptor,
+        centralDirectoryHeader,
+        end,
+    };
+
+    struct Entry
+    {
+        QString name;
+        quint16 flags = 0;
+        quint16 method = 0;
+        quint32 crc = 0;
+        quint64 compressedSize = 0;
+        quint64 uncompressedSize = 0;
+        bool zip64 = false;
+
+        quint64 compressedRead = 0;
+        quint64 uncompressedWritten = 0;
+        quint32 actualCrc = 0;
+    };
+
+    Private(const QDir& dir): dir(dir), output(kBufferSizeBytes, Qt::Uninitialized) {}
+
+    ~Private()
+    {
+        if (inflating)
+            inflateEnd(&stream);
+    }
+
+    qint64 available() const { return input.size() - inputOffset; }
+    const char* data() const { return input.constData() + inputOffset; }
+    void consume(qint64 size) { inputOffset += size; }
+
+    /** @return False if more data is needed or an error happened. */
+    bool processSignature();
+    bool processLocalHeader();
+    bool processEntryData();
+    bool processDataDescriptor();
+    bool processCentralDirectoryHeader();
+
+    bool writeOutput(const char* data, qint64 size);
+    bool finishEntryData();
+    bool checkEntry();
+
+    bool fail(Error value)
+    {
+        error = value;
+        return false;
+    }
+
+public:
+    const QDir dir;
+    State state = State::signature;
+    Error error = Extractor::Ok;
+
+    QByteArray input;
+    qint64 inputOffset = 0;
+    QByteArray output;
+
+    Entry entry;
+    QFile file;
+    z_stream stream{};
+    bool inflating = false;
+
+    QList<QPair<QString, QString>> symlinks;
+    std::atomic<qint64> extracted = 0;
+};
+
+bool StreamExtractor::Private::processSignature()
+{
+    if (available() < 4)
+        return false;
+
+    switch (readUInt32(data()))
+    {
+        case kLocalHeaderSignature:
+            state = State::localHeader;
+            return true;
+
+        case kCentralDirectoryHeaderSignature:
+            state = State::centralDirectoryHeader;
+            return true;
+
+        case kEndOfCentralDirectorySignature:
+        case kZip64EndOfCentralDirectorySignature:
+        case kZip64EndOfCentralDirectoryLocatorSignature:
+            state = State::end;
+            return true;
+
+        default:
+            return fail(Extractor::BrokenZip);
+    }
+}
+
+bool StreamExtractor::Private::processLocalHeader()
+{
+    if (available() < kLocalHeaderSize)
+        return false;
+
+    const char* header = data();
+    const int nameLength = readUInt16(header + 26);
+    const int extraLength = readUInt16(header + 28);
+    if (available() < kLocalHeaderSize + nameLength + extraLength)
+        return false;
+
+    entry = Entry();
+    entry.flags = readUInt16(header + 6);
+    entry.method = readUInt16(header + 8);
+    entry.crc = readUInt32(header + 14);
+    entry.compressedSize = readUInt32(header + 18);
+    entry.uncompressedSize = readUInt32(header + 22);
+    entry.actualCrc = crc32(0, nullptr, 0);
+
+    const char* name = header + kLocalHeaderSize;
+    entry.name = (entry.flags & kUtf8NameFlag)
+        ? QString::fromUtf8(name, nameLength)
+        : QString::fromLocal8Bit(name, nameLength);
+
+    // The zip64 extra field contains the 64-bit values of the sizes which do not fit 32 bits.
+    for (const char* extra = name + nameLength; extra + 4 <= name + nameLength + extraLength;)
+    {
+        const quint16 id = readUInt16(extra);
+        const int size = readUInt16(extra + 2);
+        const char* value = extra + 4;
+        extra = value + size;
+        if (id != 0x0001 || extra > name + nameLength + extraLength)
+            continue;
+
+        entry.zip64 = true;
+        if (entry.uncompressedSize == 0xFFFFFFFFu && value + 8 <= extra)
+        {
+            entry.uncompressedSize = readUInt64(value);
+            value += 8;
+        }
+        if (entry.compressedSize == 0xFFFFFFFFu && value + 8 <= extra)
+            entry.compressedSize = readUInt64(value);
+    }
+
+    consume(kLocalHeaderSize + nameLength + extraLength);
+
+    if (entry.flags & kEncryptedFlag)
+        return fail(Extractor::OtherError);
+
+    if (entry.method != kStoredMethod && entry.method != kDeflatedMethod)
+        return fail(Extractor::OtherError);
+
+    if (entry.method == kStoredMethod && (entry.flags & kDataDescriptorFlag))
+        return fail(Extractor::OtherError);
+
+    const QString path = QFileInfo(entry.name).path();
+    if (!path.isEmpty() && !dir.exists(path) && !dir.mkpath(path))
+        return fail(Extractor::OtherError);
+
+    if (!entry.name.endsWith("/"))
+    {
+        file.setFileName(dir.absoluteFilePath(entry.name));
+        if (!file.open(QFile::WriteOnly | QFile::Unbuffered))
+            return fail(Extractor::CantOpenFile);
+    }
+
+    if (entry.method == kDeflatedMethod)
+    {
+        stream = z_stream{};
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+            return fail(Extractor::OtherError);
+        inflating = true;
+    }
+
+    state = State::entryData;
+    return true;
+}
+
+bool StreamExtractor::Private::processEntryData()
+{
+    qint64 size = available();
+    if (!(entry.flags & kDataDescriptorFlag))
+        size = std::min<qint64>(size, entry.compressedSize - entry.compressedRead);
+
+    if (entry.method == kStoredMethod)
+    {
+        if (!writeOutput(data(), size))
+            return false;
+
+        consume(size);
+        entry.compressedRead += size;
+        if (entry.compressedRead == entry.compressedSize)
+            return finishEntryData();
+
+        return size > 0;
+    }
+
+    if (size == 0)
+        return false;
+
+    stream.next_in = (Bytef*) data();
+    stream.avail_in = (uInt) std::min<qint64>(size, kBufferSizeBytes);
+
+    int result = Z_OK;
+    do
+    {
+        stream.next_out = (Bytef*) output.data();
+        stream.avail_out = (uInt) output.size();
+        result = inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+            return fail(Extractor::BrokenZip);
+
+        if (!writeOutput(output.constData(), output.size() - stream.avail_out))
+            return false;
+    } while (result == Z_OK && stream.avail_out == 0);
+
+    const qint64 consumed = (const char*) stream.next_in - data();
+    consume(consumed);
+    entry.compressedRead += consumed;
+
+    if (result == Z_STREAM_END)
+        return finishEntryData();
+
+    if (!(entry.flags & kDataDescriptorFlag) && entry.compressedRead == entry.compressedSize)
+        return fail(Extractor::BrokenZip);
+
+    return consumed > 0;
+}
+
+bool StreamExtractor::Private::processDataDescriptor()
+{
+    if (available() < 4)
+        return false;
+
+    // The signature of the data descriptor is optional.
+    const int signatureSize = readUInt32(data()) == kDataDescriptorSignature ? 4 : 0;
+    const int descriptorSize = signatureSize + (entry.zip64 ? 20 : 12);
+    if (available() < descriptorSize)
+        return false;
+
+    const char* descriptor = data() + signatureSize;
+    entry.crc = readUInt32(descriptor);
+    entry.compressedSize = entry.zip64 ? readUInt64(descriptor + 4) : readUInt32(descriptor + 4);
+    entry.uncompressedSize =
+        entry.zip64 ? readUInt64(descriptor + 12) : readUInt32(descriptor + 8);
+    consume(descriptorSize);
+
+    return checkEntry();
+}
+
+bool StreamExtractor::Private::processCentralDirectoryHeader()
+{
+    if (available() < kCentralDirectoryHeaderSize)
+        return false;
+
+    const char* header = data();
+    const quint16 flags = readUInt16(header + 8);
+    const int nameLength = readUInt16(header + 28);
+    const int extraLength = readUInt16(header + 30);
+    const int commentLength = readUInt16(header + 32);
+    const quint32 externalAttributes = readUInt32(header + 38);
+
+    const int recordSize = kCentralDirectoryHeaderSize + nameLength + extraLength + commentLength;
+    if (available() < recordSize)
+        return false;
+
+    const char* name = header + kCentralDirectoryHeaderSize;
+    const QString fileName = (flags & kUtf8NameFlag)
+        ? QString::fromUtf8(name, nameLength)
+        : QString::fromLocal8Bit(name, nameLength);
+    consume(recordSize);
+    state = State::signature;
+
+    if (fileName.endsWith("/"))
+        return true;
+
+    // The entries are already extracted as regular files, the attributes are known only now.
+    QFile extractedFile(dir.absoluteFilePath(fileName));
+    if (isSymlink(externalAttributes))
+    {
+        if (!extractedFile.open(QFile::ReadOnly) || extractedFile.size() > kMaxSymlinkLength)
+            return fail(Extractor::OtherError);
+
+        symlinks.append({fileName, QString::fromLatin1(extractedFile.readAll())});
+        extractedFile.close();
+        if (!extractedFile.remove())
+            return fail(Extractor::OtherError);
+
+        return true;
+    }
+
+    extractedFile.setPermissions(permissionsFromExternalAttributes(externalAttributes)
+        | QFile::ReadOwner | QFile::ReadUser | QFile::ReadGroup);
+    return true;
+}
+
+bool StreamExtractor::Private::writeOutput(const char* data, qint64 size)
+{
+    if (size <= 0)
+        return true;
+
+    entry.actualCrc = crc32(entry.actualCrc, (const Bytef*) data, (uInt) size);
+    entry.uncompressedWritten += size;
+
+    if (file.isOpen() && file.write(data, size) != size)
+        return fail(Extractor::NoFreeSpace);
+
+    extracted += size;
+    return true;
+}
+
+bool StreamExtractor::Private::finishEntryData()
+{
+    if (inflating)
+    {
+        inflateEnd(&stream);
+        inflating = false;
+    }
+
+    if (entry.flags & kDataDescriptorFlag)
+    {
+        state = State::dataDescriptor;
+        return true;
+    }
+
+    return checkEntry();
+}
+
+bool StreamExtractor::Private::checkEntry()
+{
+    file.close();
+
+    if (entry.actualCrc != entry.crc || entry.uncompressedWritten != entry.uncompressedSize)
+        return fail(Extractor::BrokenZip);
+
+    state = State::signature;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+StreamExtractor::StreamExtractor(const QDir& targetDir):
+    d(new Private(targetDir))
+{
+}
+
+StreamExtractor::~StreamExtractor()
+{
+}
+
+StreamExtractor::Error StreamExtractor::write(const char* data, qint64 size)
+{
+    if (d->error != Extractor::Ok || d->state == Private::State::end)
+        return d->error;
+
+    if (d->inputOffset > 0)
+    {
+        d->input.remove(0, d->inputOffset);
+        d->inputOffset = 0;
+    }
+    d->input.append(data, size);
+
+    bool progress = true;
+    while (progress && d->error == Extractor::Ok)
+    {
+        switch (d->state)
+        {
+            case Private::State::signature:
+                progress = d->processSignature();
+                break;
+            case Private::State::localHeader:
+                progress = d->processLocalHeader();
+                break;
+            case Private::State::entryData:
+                progress = d->processEntryData();
+                break;
+            case Private::State::dataDescriptor:
+                progress = d->processDataDescriptor();
+                break;
+            case Private::State::centralDirectoryHeader:
+                progress = d->processCentralDirectoryHeader();
+                break;
+            case Private::State::end:
+                // The end of central directory record and the archive comment are not needed.
+                d->input.clear();
+                d->inputOffset = 0;
+                progress = false;
+                break;
+        }
+    }
+
+    return d->error;
+}
+
+StreamExtractor::Error StreamExtractor::finish()
+{
+    if (d->error != Extractor::Ok)
+        return d->error;
+
+    if (d->state != Private::State::end)
+        return d->error = Extractor::BrokenZip;
+
+    for (const auto& [link, target]: d->symlinks)
+    {
+        if (!QFile::link(target, d->dir.absoluteFilePath(link)))
+            return d->error = Extractor::OtherError;
+    }
+    d->symlinks.clear();
+
+    return Extractor::Ok;
+}
+
+StreamExtractor::Error StreamExtractor::extract(QIODevice* device)
+{
+    QByteArray buffer(kBufferSizeBytes, Qt::Uninitialized);
+    while (true)
+    {
+        const qint64 read = device->read(buffer.data(), buffer.size());
+        if (read < 0)
+            return d->error = Extractor::OtherError;
+
+        if (read == 0)
+        {
+            if (!device->isSequential() || !device->waitForReadyRead(kReadTimeoutMs))
+                break;
+            continue;
+        }
+
+        if (const Error error = write(buffer.constData(), read); error != Extractor::Ok)
+            return error;
+    }
+
+    return finish();
+}
+
+qint64 StreamExtractor::bytesExtracted() const
+{
+    return d->extracted;
+}
+
+} // namespace nx::zip
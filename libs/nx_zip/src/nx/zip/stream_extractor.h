@@ -0,0 +1,51 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <QtCore/QDir>
+#include <QtCore/QScopedPointer>
+
+#include "extractor.h"
+
+class QIODevice;
+
+namespace nx::zip {
+
+/**
+ * Extracts a zip archive while it is being received, e.g. from a download stream, so the archive
+ * is not written to the disk before the extraction. The entries are found via their local
+ * headers, and the permissions and the symlinks are applied when the central directory at the
+ * end of the archive is received.
+ *
+ * Stored (not deflated) entries with the sizes written after the data are not supported, because
+ * their end cannot be found without the central directory. Encrypted entries are not supported.
+ */
+class NX_ZIP_API StreamExtractor
+{
+public:
+    using Error = Extractor::Error;
+
+    StreamExtractor(const QDir& targetDir);
+    ~StreamExtractor();
+
+    /**
+     * Extracts the next part of the archive. After an error, the following calls return the same
+     * error.
+     */
+    Error write(const char* data, qint64 size);
+    Error write(const QByteArray& data) { return write(data.constData(), data.size()); }
+
+    /** Must be called when the whole archive is written. Creates the symlinks. */
+    Error finish();
+
+    /** Extracts the archive read from the device until its end. */
+    Error extract(QIODevice* device);
+
+    qint64 bytesExtracted() const;
+
+private:
+    class Private;
+    const QScopedPointer<Private> d;
+};
+
+} // namespace nx::zip
@@ -41,6 +41,7 @@ Page
         navigator: navigator
 
         mediaPlayer.videoQuality: settings.lastUsedQuality
+        mediaPlayer.adaptiveQuality: true
 
         mediaPlayer.onPlayingChanged:
         {
@@ -30,6 +30,7 @@ Pane
         property real bitrate: 0
         property bool isHwAccelerated: false
         property string codec: ""
+        property string adaptiveQuality: ""
         property string quality
         property string resolution:
         {
@@ -63,6 +64,7 @@ Pane
 
             codec = statistics.codec
             isHwAccelerated = statistics.isHwAccelerated
+            adaptiveQuality = statistics.adaptiveQuality
 
             var quality = player.actualVideoQuality()
             if (quality === MediaPlayer.HighVideoQuality)
@@ -102,6 +104,13 @@ Pane
             text: d.quality
         }
         InformationText
+        {
+            text: d.adaptiveQuality
+            visible: !!text
+            maximumLineCount: 3
+            wrapMode: Text.WrapAtWordBoundaryOrAnywhere
+        }
+        InformationText
         {
             text: videoScreenController.resourceHelper.serverName
             maximumLineCount: 3
@@ -377,10 +377,48 @@ int QnCameraBookmarksManagerPrivate::getBookmarksAsync(
     if (!NX_ASSERT(requestData.filter.endTimeMs.count() >= 0, "Invalid end time passed"))
         requestData.filter.endTimeMs = {};
 
-    return sendGetRequest(
+    // The timeline, the Right Panel and the dialogs often request the same bookmarks at once, so
+    // the request identical to the one in flight is not sent, its reply is shared instead.
+    for (auto it = m_requestsInFlight.begin(); it != m_requestsInFlight.end(); ++it)
+    {
+        if (it->filter == requestData.filter)
+        {
+            NX_VERBOSE(this, "Merging the bookmarks request with the request [%1]", it.key());
+            it->callbacks.push_back(std::move(callback));
+            return it.key();
+        }
+    }
+
+    const auto handleReply = BookmarksCallbackType(
+        [this, callback](bool success, rest::Handle requestId, QnCameraBookmarkList bookmarks)
+        {
+            const auto requestInFlight = m_requestsInFlight.find(requestId);
+            if (requestInFlight == m_requestsInFlight.end())
+            {
+                // The request was not sent at all.
+                if (callback)
+                    callback(success, requestId, std::move(bookmarks));
+                return;
+            }
+
+            const auto callbacks = std::move(requestInFlight->callbacks);
+            m_requestsInFlight.erase(requestInFlight);
+            for (const auto& mergedCallback: callbacks)
+            {
+                if (mergedCallback)
+                    mergedCallback(success, requestId, bookmarks);
+            }
+        });
+
+    const auto requestId = sendGetRequest(
         "/ec2/bookmarks",
         requestData,
-        makeUbjsonResponseWrapper(this, callback));
+        makeUbjsonResponseWrapper(this, handleReply));
+
+    if (requestId != kInvalidRequestId)
+        m_requestsInFlight.insert(requestId, {requestData.filter, {std::move(callback)}});
+
+    return requestId;
 }
 
 int QnCameraBookmarksManagerPrivate::getBookmarkstAroundPointHeuristic(
@@ -4,6 +4,7 @@
 
 #include <functional>
 #include <optional>
+#include <vector>
 
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QTimer>
@@ -200,6 +201,17 @@ private:
 
     QMap<rest::Handle, OperationInfo> m_operations;
 
+    struct RequestInFlight
+    {
+        QnCameraBookmarkSearchFilter filter;
+
+        /** Callbacks of the request and of the identical requests merged with it. */
+        std::vector<BookmarksCallbackType> callbacks;
+    };
+
+    /** Bookmarks requests which are sent but not replied yet. */
+    QHash<rest::Handle, RequestInFlight> m_requestsInFlight;
+
     struct QueryInfo
     {
         /** Weak reference to Query object. */
@@ -32,6 +32,10 @@ struct NX_VMS_CLIENT_CORE_API Ini: nx::kit::IniConfig
     NX_INI_INT(30000, cameraDataLoadingIntervalMs,
         "[Dev] Interval, at which the Client loads camera data chunks.");
 
+    NX_INI_INT(24, cameraChunksCacheMaxAgeHours,
+        "[Dev] Maximum age of the recorded camera chunks, cached on the disk. At the start, the\n"
+        "Client loads only the chunks after the cached ones. 0 disables the cache.");
+
     NX_INI_STRING("", rootCertificatesFolder,
         "Path to a folder with user-provided certificates. If set, all *.pem and *.crt files\n"
         "from this folder are used as trusted root certificates together with the system ones.");
@@ -2,6 +2,8 @@
 
 #include "time_period_storage.h"
 
+#include <algorithm>
+
 namespace nx::vms::client::core {
 
 TimePeriodStorage::TimePeriodStorage(QObject* parent):
@@ -26,6 +28,15 @@ void TimePeriodStorage::setPeriods(Qn::TimePeriodContent type, const QnTimePerio
     emit periodsUpdated(type);
 }
 
+void TimePeriodStorage::updatePeriods(
+    Qn::TimePeriodContent type, const QnTimePeriodList& tail, qint64 startTimeMs)
+{
+    QnTimePeriodList::overwriteTail(m_normalPeriods[type], tail, startTimeMs);
+    updateAggregatedTail(type,
+        tail.empty() ? startTimeMs : std::min(startTimeMs, tail.front().startTimeMs));
+    emit periodsUpdated(type);
+}
+
 void TimePeriodStorage::updateAggregated(Qn::TimePeriodContent type)
 {
     if (!m_aggregationMSecs)
@@ -35,6 +46,35 @@ void TimePeriodStorage::updateAggregated(Qn::TimePeriodContent type)
         QnTimePeriodList::aggregateTimePeriods(m_normalPeriods[type], m_aggregationMSecs);
 }
 
+void TimePeriodStorage::updateAggregatedTail(Qn::TimePeriodContent type, qint64 changedSinceMs)
+{
+    if (!m_aggregationMSecs)
+        return;
+
+    // The aggregated periods before the one which starts before the changed point are not
+    // affected: the periods before the point are the same, and the periods after it may be
+    // joined to that aggregated period only.
+    auto& aggregated = m_aggregatedPeriods[type];
+    const auto changedIt = std::upper_bound(aggregated.begin(), aggregated.end(), changedSinceMs);
+    if (changedIt == aggregated.begin())
+    {
+        updateAggregated(type);
+        return;
+    }
+
+    const auto firstChangedIt = std::prev(changedIt);
+    const auto& periods = m_normalPeriods[type];
+    QnTimePeriodList changedPeriods;
+    changedPeriods.assign(
+        std::lower_bound(periods.begin(), periods.end(), firstChangedIt->startTimeMs),
+        periods.end());
+
+    aggregated.erase(firstChangedIt, aggregated.end());
+    const auto aggregatedTail =
+        QnTimePeriodList::aggregateTimePeriods(changedPeriods, m_aggregationMSecs);
+    aggregated.insert(aggregated.end(), aggregatedTail.begin(), aggregatedTail.end());
+}
+
 void TimePeriodStorage::setAggregationMSecs(int value)
 {
     if (value == m_aggregationMSecs)
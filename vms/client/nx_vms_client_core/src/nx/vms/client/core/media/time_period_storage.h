@@ -21,11 +21,19 @@ public:
     QnTimePeriodList aggregated(Qn::TimePeriodContent type) const;
     void setPeriods(Qn::TimePeriodContent type, const QnTimePeriodList& timePeriods);
 
+    /**
+     * Replaces the periods since the start time with the tail, as
+     * QnTimePeriodList::overwriteTail() does, and aggregates only the changed end of the list.
+     */
+    void updatePeriods(
+        Qn::TimePeriodContent type, const QnTimePeriodList& tail, qint64 startTimeMs);
+
     int aggregationMSecs() const;
     void setAggregationMSecs(int value);
 
 protected:
     void updateAggregated(Qn::TimePeriodContent type);
+    void updateAggregatedTail(Qn::TimePeriodContent type, qint64 changedSinceMs);
 
 private:
     QnTimePeriodList m_normalPeriods[Qn::TimePeriodContentCount];
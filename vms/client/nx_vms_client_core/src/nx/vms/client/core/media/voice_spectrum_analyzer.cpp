@@ -2,6 +2,7 @@
 
 #include "voice_spectrum_analyzer.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <QtCore/QtMath>
@@ -34,27 +35,9 @@ static quint32 toPowerOf2(quint32 v)
     return v;
 }
 
-/**
- * Calculates the power of 2 not exceeding the given number.
- * @param value Must be a positive number.
- */
-static int intLog2(int value)
-{
-    if (!NX_ASSERT(value > 0))
-        return 0;
-
-    int result = 0;
-    int n = value;
-    while (n >>= 1)
-        ++result;
-
-    return result;
-}
-
 void VoiceSpectrumAnalyzer::performFft()
 {
-    av_fft_permute(m_fftContext, m_fftData);
-    av_fft_calc(m_fftContext, m_fftData);
+    m_fft(m_fftContext, m_fftOutput, m_fftInput, sizeof(float));
 }
 
 VoiceSpectrumAnalyzer::VoiceSpectrumAnalyzer()
@@ -63,8 +46,9 @@ VoiceSpectrumAnalyzer::VoiceSpectrumAnalyzer()
 
 VoiceSpectrumAnalyzer::~VoiceSpectrumAnalyzer()
 {
-    nx::kit::utils::freeAligned(m_fftData);
-    av_fft_end(m_fftContext);
+    nx::kit::utils::freeAligned(m_fftInput);
+    nx::kit::utils::freeAligned(m_fftOutput);
+    av_tx_uninit(&m_fftContext);
 }
 
 void VoiceSpectrumAnalyzer::initialize(int srcSampleRate, int channels)
@@ -76,15 +60,26 @@ void VoiceSpectrumAnalyzer::initialize(int srcSampleRate, int channels)
     m_srcSampleRate = srcSampleRate;
     m_channels = channels;
     m_windowSize = toPowerOf2(srcSampleRate / kUpdatesPerSecond);
-    m_bitCount = intLog2(m_windowSize);
-
-    nx::kit::utils::freeAligned(m_fftData);
-    m_fftData = static_cast<FFTComplex*>(nx::kit::utils::mallocAligned(
-        sizeof(FFTComplex) * m_windowSize, nx::media::kMediaAlignment));
-    memset(m_fftData, 0, m_windowSize * sizeof(m_fftData[0]));
-
-    av_fft_end(m_fftContext);
-    m_fftContext = av_fft_init(m_bitCount, /*inverse*/ 0);
+    m_fftDataSize = 0;
+
+    nx::kit::utils::freeAligned(m_fftInput);
+    m_fftInput = static_cast<float*>(nx::kit::utils::mallocAligned(
+        sizeof(float) * m_windowSize, nx::media::kMediaAlignment));
+    memset(m_fftInput, 0, m_windowSize * sizeof(m_fftInput[0]));
+
+    // The real input gives the complex conjugate symmetric output, so only its half is computed.
+    const int outputSize = m_windowSize / 2 + 1;
+    nx::kit::utils::freeAligned(m_fftOutput);
+    m_fftOutput = static_cast<AVComplexFloat*>(nx::kit::utils::mallocAligned(
+        sizeof(AVComplexFloat) * outputSize, nx::media::kMediaAlignment));
+    memset(m_fftOutput, 0, outputSize * sizeof(m_fftOutput[0]));
+
+    av_tx_uninit(&m_fftContext);
+    const float scale = 1.0f;
+    av_tx_init(&m_fftContext, &m_fft, AV_TX_FLOAT_RDFT, /*inverse*/ 0, m_windowSize, &scale,
+        /*flags*/ 0);
+
+    m_bandRanges = bandRanges(m_windowSize, m_srcSampleRate);
 }
 
 bool VoiceSpectrumAnalyzer::processData(const qint16* sampleData, int sampleCount)
@@ -121,6 +116,9 @@ bool VoiceSpectrumAnalyzer::processData(
 template<class T>
 bool VoiceSpectrumAnalyzer::processDataInternal(const T* sampleData, int sampleCount)
 {
+    if (!m_fftContext)
+        return false;
+
     // Max volume amplification for input data.
     static const double kBoostLevel = 10 * log10(kBoostLevelDb);
     T maxAmplifier = std::numeric_limits<T>::max() / kBoostLevel;
@@ -129,46 +127,58 @@ bool VoiceSpectrumAnalyzer::processDataInternal(const T* sampleData, int sampleC
     for (int i = 0; i < sampleCount * m_channels; ++i)
         maxSampleValue = qMax(maxSampleValue, T(abs(sampleData[i])));
     maxSampleValue = qMax(maxSampleValue, maxAmplifier);
+    const double scale = 1.0 / maxSampleValue;
     const T* p = sampleData;
 
     bool updated = false;
-    for (int i = 0; i < sampleCount; ++i)
+    int remainingCount = sampleCount;
+    while (remainingCount > 0)
     {
-        // Calculate an average for all channels. Channel samples are interleaved.
-        qint64 sampleValue = 0;
-        for (int channel = 0; channel < m_channels; ++channel)
-            sampleValue += *(p++);
-        sampleValue /= m_channels;
+        const int count = std::min(remainingCount, m_windowSize - m_fftDataSize);
+        float* const input = m_fftInput + m_fftDataSize;
+        for (int i = 0; i < count; ++i)
+        {
+            // Calculate an average for all channels. Channel samples are interleaved.
+            qint64 sampleValue = 0;
+            for (int channel = 0; channel < m_channels; ++channel)
+                sampleValue += *(p++);
+            sampleValue /= m_channels;
+
+            input[i] = sampleValue * scale;
+        }
+        m_fftDataSize += count;
+        remainingCount -= count;
+
+        if (m_fftDataSize < m_windowSize)
+            break;
 
-        m_fftData[m_fftDataSize].re = sampleValue / double(maxSampleValue);
-        ++m_fftDataSize;
+        m_fftDataSize = 0;
 
-        if (m_fftDataSize == m_windowSize)
+        // Only the spectrum of the last complete window is kept, so the earlier windows of the
+        // same portion are not transformed.
+        if (remainingCount >= m_windowSize)
+            continue;
+
+        performFft();
+
+        const SpectrumData spectrumData = fillSpectrumData(
+            m_fftOutput, m_windowSize, m_bandRanges);
         {
-            performFft();
-
-            const SpectrumData spectrumData = fillSpectrumData(
-                m_fftData, m_windowSize, m_srcSampleRate);
-            {
-                NX_MUTEX_LOCKER lock(&m_mutex);
-                m_spectrumData = spectrumData;
-            }
-
-            updated = true;
-            m_fftDataSize = 0;
-            memset(m_fftData, 0, m_windowSize * sizeof(m_fftData[0]));
+            NX_MUTEX_LOCKER lock(&m_mutex);
+            m_spectrumData = spectrumData;
         }
+
+        updated = true;
     }
     return updated;
 }
 
-/*static*/ SpectrumData VoiceSpectrumAnalyzer::fillSpectrumData(
-    const FFTComplex data[], int windowSize, int srcSampleRate)
+/*static*/ std::vector<VoiceSpectrumAnalyzer::BandRange> VoiceSpectrumAnalyzer::bandRanges(
+    int windowSize, int srcSampleRate)
 {
-    SpectrumData spectrumData;
+    std::vector<BandRange> result;
 
     const double maxIndex = windowSize / 2;
-    const double maxFreqSum = windowSize / 2;
     const double maxFreq = srcSampleRate / 2;
     const double freqPerElement = maxFreq / maxIndex;
 
@@ -179,31 +189,48 @@ bool VoiceSpectrumAnalyzer::processDataInternal(const T* sampleData, int sampleC
     double currentStep = 0.0;
     for (int currentIndex = startIndex; currentIndex <= endIndex;)
     {
-        double value = 0.0;
+        BandRange band{currentIndex, currentIndex};
         static const double epsilon = 1e-10;
         while (currentStep + epsilon < stepsPerBand)
         {
-            const FFTComplex& complexNum = data[currentIndex];
-            double fftMagnitude = sqrt(
-                complexNum.re * complexNum.re + complexNum.im * complexNum.im);
-            value += fftMagnitude;
             currentIndex++;
             currentStep += 1.0;
         }
         currentStep -= stepsPerBand;
-        spectrumData.data.push_back(qBound(0.0, value / maxFreqSum, 1.0));
+        band.end = std::min(currentIndex, windowSize / 2 + 1);
+        result.push_back(band);
     }
 
-    // Convert result data to Db.
-    for (auto& data: spectrumData.data)
+    return result;
+}
+
+/*static*/ SpectrumData VoiceSpectrumAnalyzer::fillSpectrumData(
+    const AVComplexFloat data[], int windowSize, const std::vector<BandRange>& bands)
+{
+    SpectrumData spectrumData;
+    spectrumData.data.reserve(bands.size());
+
+    const double maxFreqSum = windowSize / 2;
+    for (const auto& band: bands)
     {
+        double value = 0.0;
+        for (int i = band.begin; i < band.end; ++i)
+            value += sqrt(data[i].re * data[i].re + data[i].im * data[i].im);
+
+        // Convert result data to Db.
         static const double kScaler = 9;
-        data = log10(data * kScaler + 1.0);
+        spectrumData.data.push_back(log10(qBound(0.0, value / maxFreqSum, 1.0) * kScaler + 1.0));
     }
 
     return spectrumData;
 }
 
+/*static*/ SpectrumData VoiceSpectrumAnalyzer::fillSpectrumData(
+    const AVComplexFloat data[], int windowSize, int srcSampleRate)
+{
+    return fillSpectrumData(data, windowSize, bandRanges(windowSize, srcSampleRate));
+}
+
 SpectrumData VoiceSpectrumAnalyzer::getSpectrumData() const
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
@@ -244,7 +271,28 @@ int VoiceSpectrumAnalyzer::bandsCount()
     return s;
 }
 
-/*static*/ std::string VoiceSpectrumAnalyzer::asString(const FFTComplex data[], int size)
+/*static*/ std::string VoiceSpectrumAnalyzer::asString(const float data[], int size)
+{
+    std::string s;
+    for (int i = 0; i < size; ++i)
+    {
+        s += nx::kit::utils::format("%f", data[i]);
+
+        // Group 8 numbers in one line.
+        if (i < size - 1)
+        {
+            if (i % 8 == 7)
+                s += ",\n";
+            else
+                s += ", ";
+        }
+    }
+    if (!s.empty())
+        s += "\n";
+    return s;
+}
+
+/*static*/ std::string VoiceSpectrumAnalyzer::asString(const AVComplexFloat data[], int size)
 {
     std::string s;
     for (int i = 0; i < size; ++i)
@@ -293,14 +341,16 @@ std::string VoiceSpectrumAnalyzer::dump() const
     s += nx::kit::utils::format("m_srcSampleRate=%d\n", m_srcSampleRate);
     s += nx::kit::utils::format("m_channels=%d\n", m_channels);
     s += nx::kit::utils::format("m_windowSize=%d\n", m_windowSize);
-    s += nx::kit::utils::format("m_bitCount=%d\n", m_bitCount);
     s += nx::kit::utils::format("m_fftDataSize=%d\n", m_fftDataSize);
     s += nx::kit::utils::format("m_fftContext=%s\n", m_fftContext ? "non-null" : "null");
     s += "m_spectrumData={\n";
     s += asString(m_spectrumData.data.data(), m_spectrumData.data.size());
     s += "}\n";
-    s += "m_fftData={\n";
-    s += asString(m_fftData, m_windowSize);
+    s += "m_fftInput={\n";
+    s += asString(m_fftInput, m_windowSize);
+    s += "}\n";
+    s += "m_fftOutput={\n";
+    s += asString(m_fftOutput, m_windowSize / 2 + 1);
     s += "}\n";
 
     return s;
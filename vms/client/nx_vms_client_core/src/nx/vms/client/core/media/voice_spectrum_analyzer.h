@@ -8,7 +8,7 @@
 #include <QtCore/QVector>
 
 extern "C" {
-#include <libavcodec/avfft.h> //< private
+#include <libavutil/tx.h>
 } // extern "C"
 
 #include <nx/media/audio/format.h>
@@ -50,27 +50,47 @@ public:
     static int bandsCount();
 
 protected: //< Made protected for unit tests.
+    /** Range of the FFT output indices summed into one band. */
+    struct BandRange
+    {
+        int begin = 0;
+        int end = 0;
+    };
+
     template<class T>
     bool processDataInternal(const T* sampleData, int sampleCount);
     int windowSize() const { return m_windowSize; }
-    FFTComplex* fftData() const { return m_fftData; }
+
+    /** Real input of the FFT, windowSize() values. */
+    float* fftInput() const { return m_fftInput; }
+
+    /** Non-negative frequency half of the FFT output, windowSize() / 2 + 1 values. */
+    const AVComplexFloat* fftOutput() const { return m_fftOutput; }
+
     void performFft();
-    static SpectrumData fillSpectrumData(const FFTComplex data[], int size, int srcSampleRate);
+    static std::vector<BandRange> bandRanges(int windowSize, int srcSampleRate);
+    static SpectrumData fillSpectrumData(
+        const AVComplexFloat data[], int windowSize, const std::vector<BandRange>& bands);
+    static SpectrumData fillSpectrumData(
+        const AVComplexFloat data[], int windowSize, int srcSampleRate);
 
 protected: //< Intended for experimenting and debugging, e.g. when changing the algorithm.
     static std::string asString(const double data[], int size);
-    static std::string asString(const FFTComplex data[], int size);
+    static std::string asString(const float data[], int size);
+    static std::string asString(const AVComplexFloat data[], int size);
     static std::string asString(const int16_t data[], int size);
     std::string dump() const;
 
 private:
     int m_srcSampleRate = 0;
     int m_channels = 0;
-    int m_windowSize = 0; /**< Number of complex values for FFT. */
-    int m_bitCount = 0; /**< log2(m_windowSize) */
-    FFTComplex* m_fftData = nullptr;
-    FFTContext* m_fftContext = nullptr;
-    int m_fftDataSize = 0; /**< Nmber of currently filled values in m_fftData. */
+    int m_windowSize = 0; /**< Number of real values for FFT. */
+    float* m_fftInput = nullptr;
+    AVComplexFloat* m_fftOutput = nullptr;
+    AVTXContext* m_fftContext = nullptr;
+    av_tx_fn m_fft = nullptr;
+    std::vector<BandRange> m_bandRanges; /**< Precomputed for the window size and sample rate. */
+    int m_fftDataSize = 0; /**< Nmber of currently filled values in m_fftInput. */
     SpectrumData m_spectrumData;
     mutable nx::Mutex m_mutex;
 };
@@ -0,0 +1,92 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "motion_grid_lines.h"
+
+#include <cstring>
+
+#include <QtCore/QtEndian>
+
+namespace nx::vms::client::core {
+
+namespace {
+
+static constexpr int kWidth = Qn::kMotionGridWidth;
+static constexpr int kHeight = Qn::kMotionGridHeight;
+static_assert(kHeight == 32, "Each grid column is expected to be a 32-bit word");
+
+/** @return Whether the bit of the given row is set in the column word. */
+bool hasRow(quint32 column, int row)
+{
+    return column & (0x80000000u >> row);
+}
+
+} // namespace
+
+MotionGridLines::MotionGridLines()
+{
+    rebuild();
+}
+
+bool MotionGridLines::update(const void* motion, const void* skipMask)
+{
+    Grid grid{};
+    if (motion)
+    {
+        std::memcpy(grid.data(), motion, grid.size());
+        if (skipMask)
+            nx::media::motion_mask::subtract(grid.data(), skipMask);
+    }
+
+    if (grid == m_grid)
+        return false;
+
+    m_grid = grid;
+    rebuild();
+    return true;
+}
+
+void MotionGridLines::rebuild()
+{
+    for (auto& lines: m_lines)
+        lines.clear();
+
+    std::array<quint32, kWidth> columns;
+    for (int x = 0; x < kWidth; ++x)
+        columns[x] = qFromBigEndian<quint32>(m_grid.data() + x * sizeof(quint32));
+
+    // A line borders the motion if any of the two cells it separates has motion. Each line is
+    // split into the segments of the same state.
+    const auto addLine =
+        [this](int length, const QPointF& step, const QPointF& offset, const auto& isMotionAt)
+        {
+            bool isMotion = isMotionAt(0);
+            m_lines[isMotion] << offset;
+            for (int i = 1; i < length; ++i)
+            {
+                if (isMotionAt(i) == isMotion)
+                    continue;
+
+                m_lines[isMotion] << offset + step * i;
+                isMotion = !isMotion;
+                m_lines[isMotion] << offset + step * i;
+            }
+            m_lines[isMotion] << offset + step * length;
+        };
+
+    // Horizontal lines.
+    for (int y = 1; y < kHeight; ++y)
+    {
+        addLine(kWidth, QPointF(1, 0), QPointF(0, y),
+            [&columns, y](int x) { return hasRow(columns[x] | (columns[x] >> 1), y); });
+    }
+
+    // Vertical lines.
+    for (int x = 1; x < kWidth; ++x)
+    {
+        const quint32 column = columns[x - 1] | columns[x];
+        addLine(kHeight, QPointF(0, 1), QPointF(x, 0),
+            [column](int y) { return hasRow(column, y); });
+    }
+}
+
+} // namespace nx::vms::client::core
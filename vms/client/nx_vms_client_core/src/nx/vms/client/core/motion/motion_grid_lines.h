@@ -0,0 +1,45 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+
+#include <QtCore/QPointF>
+#include <QtCore/QVector>
+
+#include <nx/media/motion_mask.h>
+
+namespace nx::vms::client::core {
+
+/**
+ * Lines of the motion grid overlay, split into the ones bordering a cell with motion and the
+ * rest. The lines are built in the grid coordinates, so they do not depend on the size of the
+ * painted rectangle, and are rebuilt only when the motion grid changes.
+ */
+class NX_VMS_CLIENT_CORE_API MotionGridLines
+{
+public:
+    MotionGridLines();
+
+    /**
+     * Updates the lines with the motion grid.
+     * @param motion Motion grid bitmask, nullptr if there is no motion.
+     * @param skipMask Bitmask of the cells to ignore, nullptr if there are none.
+     * @return Whether the lines have changed.
+     */
+    bool update(const void* motion, const void* skipMask = nullptr);
+
+    /** Pairs of the line end points for QPainter::drawLines(). */
+    const QVector<QPointF>& backgroundLines() const { return m_lines[0]; }
+    const QVector<QPointF>& motionLines() const { return m_lines[1]; }
+
+private:
+    void rebuild();
+
+private:
+    using Grid = std::array<char, nx::media::motion_mask::kGridSizeBytes>;
+    Grid m_grid{};
+    QVector<QPointF> m_lines[2];
+};
+
+} // namespace nx::vms::client::core
@@ -121,27 +121,9 @@ bool RemoteConnectionFactoryCache::fillContext(
     }
 
     // Reuse server list from the previous connection.
-    const auto serverIt = std::find_if(customData.serversInfo.begin(), customData.serversInfo.end(),
-        [&customData](const auto& server)
-        {
-            return server.id == customData.expectedServerId;
-        });
-
-    if (serverIt == customData.serversInfo.end())
+    if (!fillServersInfo(context, customData.expectedServerId, customData.serversInfo))
         return false;
 
-    // Make sure that we check the server certificate.
-    if (serverIt->certificatePem.empty())
-        return false;
-
-    context->logonData.expectedServerId = customData.expectedServerId;
-    context->serversInfo = customData.serversInfo;
-
-    context->handshakeCertificateChain =
-        nx::network::ssl::Certificate::parse(serverIt->certificatePem);
-    context->moduleInformation = serverIt->getModuleInformation();
-
-    context->logonData.expectedServerVersion = context->moduleInformation.version;
     context->logonData.credentials.username = customData.username;
 
     context->logonData.credentials.authToken =
@@ -162,6 +144,35 @@ bool RemoteConnectionFactoryCache::fillContext(
     return true;
 }
 
+bool RemoteConnectionFactoryCache::fillServersInfo(
+    std::shared_ptr<RemoteConnectionFactory::Context> context,
+    const nx::Uuid& expectedServerId,
+    const std::vector<nx::vms::api::ServerInformationV1>& serversInfo)
+{
+    const auto serverIt = std::find_if(serversInfo.begin(), serversInfo.end(),
+        [&expectedServerId](const auto& server)
+        {
+            return server.id == expectedServerId;
+        });
+
+    if (serverIt == serversInfo.end())
+        return false;
+
+    // Make sure that we check the server certificate.
+    if (serverIt->certificatePem.empty())
+        return false;
+
+    context->logonData.expectedServerId = expectedServerId;
+    context->serversInfo = serversInfo;
+
+    context->handshakeCertificateChain =
+        nx::network::ssl::Certificate::parse(serverIt->certificatePem);
+    context->moduleInformation = serverIt->getModuleInformation();
+
+    context->logonData.expectedServerVersion = context->moduleInformation.version;
+    return true;
+}
+
 void RemoteConnectionFactoryCache::restoreContext(
     std::shared_ptr<RemoteConnectionFactory::Context> context,
     const LogonData& logonData)
@@ -13,6 +13,15 @@ public:
     /** Load data from the cache to the connection context. */
     static bool fillContext(std::shared_ptr<RemoteConnectionFactory::Context> context);
 
+    /**
+     * Load the servers info of the previous connection to the connection context. The credentials
+     * are not touched.
+     */
+    static bool fillServersInfo(
+        std::shared_ptr<RemoteConnectionFactory::Context> context,
+        const nx::Uuid& expectedServerId,
+        const std::vector<nx::vms::api::ServerInformationV1>& serversInfo);
+
     /** Remove cached data from context. */
     static void restoreContext(
         std::shared_ptr<RemoteConnectionFactory::Context> context,
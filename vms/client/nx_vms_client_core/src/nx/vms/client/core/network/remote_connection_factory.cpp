@@ -2,6 +2,7 @@
 
 #include "remote_connection_factory.h"
 
+#include <list>
 #include <memory>
 
 #include <QtCore/QPointer>
@@ -14,7 +15,9 @@
 #include <nx/network/socket_global.h>
 #include <nx/network/url/url_builder.h>
 #include <nx/reflect/to_string.h>
+#include <nx/utils/elapsed_timer.h>
 #include <nx/utils/guarded_callback.h>
+#include <nx/utils/thread/mutex.h>
 #include <nx/utils/thread/thread_util.h>
 #include <nx/vms/api/data/login.h>
 #include <nx/vms/api/data/user_model.h>
@@ -43,6 +46,9 @@ namespace {
 static const nx::utils::SoftwareVersion kSimplifiedLoginSupportVersion(5, 1);
 static const nx::utils::SoftwareVersion kUserRightsRedesignVersion(6, 0);
 
+/** Number of the local Systems which recent connection data is kept. */
+static constexpr int kMaxRecentConnections = 8;
+
 /**
  * Digest authentication requires username to be in lowercase.
  */
@@ -146,6 +152,21 @@ struct RemoteConnectionFactory::Private
     std::shared_ptr<RequestsManager> requestsManager;
     std::unique_ptr<AbstractRemoteConnectionUserInteractionDelegate> userInteractionDelegate;
 
+    struct RecentConnection
+    {
+        std::string address;
+        nx::Uuid serverId;
+        std::vector<nx::vms::api::ServerInformationV1> serversInfo;
+    };
+
+    /**
+     * Servers info of the recently validated connections to the local Systems, the latest first.
+     * It lets switching between the Systems skip the servers info request. No credentials are
+     * kept: each connection logs in with the credentials supplied for it.
+     */
+    nx::Mutex recentConnectionsMutex;
+    std::list<RecentConnection> recentConnections;
+
     Private(
         ec2::AbstractECConnectionFactory* q,
         nx::vms::api::PeerType peerType,
@@ -167,6 +188,61 @@ struct RemoteConnectionFactory::Private
         NX_ASSERT(this->cloudCredentialsProvider.is2FaEnabledForUser);
     }
 
+    /** @return Whether the servers info of a recent connection to the System is loaded. */
+    bool fillFromRecentConnection(ContextPtr context)
+    {
+        if (context->logonData.userType == nx::vms::api::UserType::cloud)
+            return false;
+
+        RecentConnection recent;
+        {
+            NX_MUTEX_LOCKER lock(&recentConnectionsMutex);
+            const auto it = std::find_if(recentConnections.begin(), recentConnections.end(),
+                [address = context->logonData.address.toString()](const auto& item)
+                {
+                    return item.address == address;
+                });
+            if (it == recentConnections.end())
+                return false;
+
+            // The data is stored again when the connection succeeds.
+            recent = std::move(*it);
+            recentConnections.erase(it);
+        }
+
+        if (const auto& serverId = context->logonData.expectedServerId;
+            !serverId.isNull() && serverId != recent.serverId)
+        {
+            return false;
+        }
+
+        return RemoteConnectionFactoryCache::fillServersInfo(
+            context, recent.serverId, recent.serversInfo);
+    }
+
+    void saveRecentConnection(const LogonData& logonData, ContextPtr context)
+    {
+        if (context->userType() == nx::vms::api::UserType::cloud
+            || context->logonData.purpose != LogonData::Purpose::connect
+            || context->serversInfo.empty())
+        {
+            return;
+        }
+
+        RecentConnection recent{
+            .address = logonData.address.toString(),
+            .serverId = context->moduleInformation.id,
+            .serversInfo = context->serversInfo,
+        };
+
+        NX_MUTEX_LOCKER lock(&recentConnectionsMutex);
+        std::erase_if(recentConnections,
+            [&recent](const auto& item) { return item.address == recent.address; });
+        recentConnections.push_front(std::move(recent));
+        if ((int) recentConnections.size() > kMaxRecentConnections)
+            recentConnections.pop_back();
+    }
+
     RemoteConnectionPtr makeRemoteConnectionInstance(ContextPtr context)
     {
         ConnectionInfo connectionInfo{
@@ -1048,6 +1124,13 @@ struct RemoteConnectionFactory::Private
 
         logInitialInfo(context());
 
+        nx::utils::ElapsedTimer stageTimer(nx::utils::ElapsedTimerState::started);
+        const auto stageFinished =
+            [this, &stageTimer](const char* stage)
+            {
+                NX_DEBUG(this, "Connection stage \"%1\" took %2", stage, stageTimer.restart());
+            };
+
         bool hasCachedData = false;
         bool tokenExpired = true;
         if (auto ctx = context())
@@ -1072,6 +1155,7 @@ struct RemoteConnectionFactory::Private
         {
             // GET /api/moduleInformation
             getModuleInformation(context());
+            stageFinished("module information");
 
             // At this moment we definitely know System ID and version, so request token if not
             // done it yet.
@@ -1085,7 +1169,10 @@ struct RemoteConnectionFactory::Private
         {
             // GET /rest/v1/servers/*/info
             if (!hasCachedData)
+            {
                 getServersInfo(context());
+                stageFinished("servers info");
+            }
 
             // At this moment we definitely know System ID and version, so request token if not
             // done it yet.
@@ -1096,6 +1183,7 @@ struct RemoteConnectionFactory::Private
             // Request actually will be sent for 5.0 multi-server Systems only as in 5.1 we can get
             // Server ID from the servers info list reply.
             ensureExpectedServerId(context());
+            stageFinished("server id");
 
             // Ensure expected Server is present in the servers info list, copy it's info to the
             // context module information field, verify handshake certificate and process all
@@ -1103,12 +1191,14 @@ struct RemoteConnectionFactory::Private
             //
             // User interaction.
             processServersInfoList(context());
+            stageFinished("certificates");
         }
         else if (context()) //< 4.2 and older servers.
         {
             // User interaction.
             verifyAndAcceptTargetCertificate(context(), /*certificateIsUserProvided*/ false);
             fixupCertificateCache(context());
+            stageFinished("certificates");
         }
 
         if (!checkCompatibility(context()))
@@ -1122,6 +1212,7 @@ struct RemoteConnectionFactory::Private
 
             // GET /ec2/getUsers in this case.
             requestCompatibilityUserPermissions(context());
+            stageFinished("login");
             return;
         }
 
@@ -1129,6 +1220,7 @@ struct RemoteConnectionFactory::Private
         {
             NX_DEBUG(this, "Login as Video Wall.");
             loginWithToken(context()); //< GET /rest/v1/login/sessions/current
+            stageFinished("login");
             return;
         }
 
@@ -1150,6 +1242,7 @@ struct RemoteConnectionFactory::Private
             //
             // GET /rest/v1/login/users/<username>
             nx::vms::api::LoginUser userType = verifyLocalUserType(context());
+            stageFinished("user type");
             if (userType.methods.testFlag(nx::vms::api::LoginMethod::http))
             {
                 NX_DEBUG(this, "Digest authentication is preferred for the User.");
@@ -1171,6 +1264,7 @@ struct RemoteConnectionFactory::Private
                     issueLocalToken(context()); //< GET /rest/v1/login/sessions
             }
         }
+        stageFinished("login");
 
         // For the older systems (before user rights redesign) expliticly request current user
         // permissions.
@@ -1178,6 +1272,7 @@ struct RemoteConnectionFactory::Private
         {
             // GET /rest/v1/users/<username> in this case.
             requestCompatibilityUserPermissions(context());
+            stageFinished("user permissions");
         }
     }
 };
@@ -1241,13 +1336,21 @@ RemoteConnectionFactory::ProcessPtr RemoteConnectionFactory::connect(
             logonData = std::move(logonData), ignoreCachedData]
         {
             nx::utils::setCurrentThreadName("RemoteConnectionFactoryThread");
+            nx::utils::ElapsedTimer connectionTimer(nx::utils::ElapsedTimerState::started);
 
             bool useFastConnect = false;
+            bool useRecentConnection = false;
 
             if (!ignoreCachedData)
             {
                 if (auto context = contextPtr.lock(); !context->logonData.authCacheData.empty())
+                {
                     useFastConnect = RemoteConnectionFactoryCache::fillContext(context);
+                }
+                else if (context)
+                {
+                    useRecentConnection = d->fillFromRecentConnection(context);
+                }
             }
             else
             {
@@ -1255,11 +1358,12 @@ RemoteConnectionFactory::ProcessPtr RemoteConnectionFactory::connect(
                     RemoteConnectionFactoryCache::restoreContext(context, logonData);
             }
 
-            NX_DEBUG(this, "Connect fast? %1", useFastConnect);
+            NX_DEBUG(this, "Connect fast? %1, use recent connection? %2",
+                useFastConnect, useRecentConnection);
 
             d->connectToServerAsync(contextPtr);
 
-            if (useFastConnect)
+            if (useFastConnect || useRecentConnection)
             {
                 bool retryConnection = false; //< Variable is required to unlock context shared ptr.
 
@@ -1274,6 +1378,7 @@ RemoteConnectionFactory::ProcessPtr RemoteConnectionFactory::connect(
                 {
                     NX_DEBUG(this, "Connect - Try again without cache");
                     useFastConnect = false;
+                    useRecentConnection = false;
                     d->connectToServerAsync(contextPtr);
                 }
             }
@@ -1281,9 +1386,11 @@ RemoteConnectionFactory::ProcessPtr RemoteConnectionFactory::connect(
             if (!contextPtr.lock())
                 return;
 
+            NX_DEBUG(this, "Connection process took %1", connectionTimer.elapsed());
+
             QMetaObject::invokeMethod(
                 this,
-                [this, contextPtr, callback, useFastConnect]()
+                [this, contextPtr, callback, logonData, useFastConnect, useRecentConnection]()
                 {
                     auto context = contextPtr.lock();
                     if (!context)
@@ -1299,9 +1406,12 @@ RemoteConnectionFactory::ProcessPtr RemoteConnectionFactory::connect(
                     else
                     {
                         auto connection = d->makeRemoteConnectionInstance(context);
+                        // The recent connection data is validated by the requests of this process,
+                        // so the connection is not marked as cached.
                         connection->setCached(useFastConnect);
                         RemoteConnectionFactoryCache::startWatchingConnection(
-                            connection, context, useFastConnect);
+                            connection, context, useFastConnect || useRecentConnection);
+                        d->saveRecentConnection(logonData, context);
                         callback(connection);
                     }
                 },
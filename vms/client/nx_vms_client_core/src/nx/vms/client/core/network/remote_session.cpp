@@ -13,6 +13,7 @@
 #include <client_core/client_core_module.h>
 #include <core/resource/media_server_resource.h>
 #include <nx/reflect/json.h>
+#include <nx/utils/elapsed_timer.h>
 #include <nx/utils/guarded_callback.h>
 #include <nx/utils/log/assert.h>
 #include <nx/utils/log/log.h>
@@ -65,6 +66,10 @@ struct RemoteSession::Private
     mutable nx::Mutex mutex;
     bool autoTerminate = false;
 
+    /** Startup phases of the current connection, reported once the resources are received. */
+    nx::utils::ElapsedTimer startupTimer;
+    std::chrono::milliseconds messageBusOpenedTime{};
+
     void terminateServerSessionIfNeeded();
     void updateTokenExpirationTime();
     std::chrono::microseconds age() const;
@@ -282,6 +287,8 @@ void RemoteSession::establishConnection(RemoteConnectionPtr connection)
 {
     NX_DEBUG(this, "Initialize new connection, cached? %1", connection->isCached());
     stopReconnecting();
+    d->startupTimer.restart();
+    d->messageBusOpenedTime = {};
 
     if (auto oldConnection = this->connection())
     {
@@ -412,6 +419,8 @@ void RemoteSession::setState(State value)
 void RemoteSession::onMessageBusConnectionOpened()
 {
     NX_VERBOSE(this, "Connection opened");
+    if (d->startupTimer.isValid())
+        d->messageBusOpenedTime = d->startupTimer.elapsed();
     stopReconnecting();
     setState(State::waitingResources);
 }
@@ -419,6 +428,12 @@ void RemoteSession::onMessageBusConnectionOpened()
 void RemoteSession::onInitialResourcesReceived()
 {
     NX_VERBOSE(this, "Resources received");
+    if (d->startupTimer.isValid())
+    {
+        NX_INFO(this, "Startup phases: message bus opened in %1, initial resources ready in %2",
+            d->messageBusOpenedTime, d->startupTimer.elapsed());
+        d->startupTimer.invalidate();
+    }
     setState(State::connected);
 }
 
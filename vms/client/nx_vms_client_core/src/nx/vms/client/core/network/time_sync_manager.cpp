@@ -29,13 +29,16 @@ TimeSyncManager::~TimeSyncManager()
 void TimeSyncManager::resync()
 {
     m_lastSyncTimeInterval.invalidate();
+    resetTimeSamples();
     updateTime();
 }
 
 void TimeSyncManager::updateTime()
 {
     auto route = QnRouter::routeTo(m_serverId, systemContext());
-    auto networkTimeSyncInterval = systemSettings()->syncTimeExchangePeriod();
+    // Backed off while the time is stable, see nx::vms::time::ClockOffsetFilter.
+    const auto networkTimeSyncInterval =
+        systemSettings()->syncTimeExchangePeriod() * pollBackoff();
     if (route.isValid())
     {
         if (!m_lastSyncTimeInterval.hasExpired(networkTimeSyncInterval))
@@ -0,0 +1,95 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "chunk_periods_cache.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <nx/utils/log/log.h>
+
+namespace nx::vms::client::core {
+
+using namespace std::chrono;
+
+ChunkPeriodsCache::ChunkPeriodsCache(const QString& directory):
+    m_directory(directory)
+{
+}
+
+ChunkPeriodsCache* ChunkPeriodsCache::instance()
+{
+    static ChunkPeriodsCache cache(
+        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/chunks_cache");
+    return &cache;
+}
+
+QString ChunkPeriodsCache::key(
+    const nx::Uuid& systemId,
+    const nx::Uuid& cameraId,
+    nx::vms::api::StorageLocation storageLocation)
+{
+    return nx::format("%1/%2_%3",
+        systemId.toSimpleString(), cameraId.toSimpleString(), (int) storageLocation);
+}
+
+QnTimePeriodList ChunkPeriodsCache::load(const QString& key, milliseconds maxAge) const
+{
+    const QString path = filePath(key);
+    const QFileInfo fileInfo(path);
+    if (!fileInfo.exists()
+        || fileInfo.lastModified().msecsTo(QDateTime::currentDateTime()) > maxAge.count())
+    {
+        return {};
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    QByteArray data = file.readAll();
+    QnTimePeriodList periods;
+    if (!periods.decode(data))
+    {
+        NX_DEBUG(this, "Cached periods %1 are damaged", path);
+        return {};
+    }
+
+    NX_VERBOSE(this, "Loaded %1 cached periods from %2", periods.size(), path);
+    return periods;
+}
+
+bool ChunkPeriodsCache::save(const QString& key, const QnTimePeriodList& periods)
+{
+    QByteArray data;
+    if (!QnTimePeriodList(periods).encode(data))
+        return false;
+
+    const QString path = filePath(key);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return false;
+
+    // The file is replaced at once, so the damaged file is not left if the Client is killed.
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+    {
+        NX_DEBUG(this, "Unable to save the cached periods to %1: %2", path, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+void ChunkPeriodsCache::remove(const QString& key)
+{
+    QFile::remove(filePath(key));
+}
+
+QString ChunkPeriodsCache::filePath(const QString& key) const
+{
+    return m_directory + "/" + key + ".bin";
+}
+
+} // namespace nx::vms::client::core
@@ -0,0 +1,50 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+
+#include <QtCore/QString>
+
+#include <nx/utils/uuid.h>
+#include <nx/vms/api/types/storage_location.h>
+#include <recording/time_period_list.h>
+
+namespace nx::vms::client::core {
+
+/**
+ * Cache of the recorded periods of the Cameras on the disk. After the Client restart, the Camera
+ * data loaders start from the cached periods and request only the periods after them, instead of
+ * the whole archive history. The periods are stored in the compact time period encoding, a file
+ * per System, Camera and storage location.
+ */
+class NX_VMS_CLIENT_CORE_API ChunkPeriodsCache
+{
+public:
+    explicit ChunkPeriodsCache(const QString& directory);
+
+    /** The cache in the application local data directory. */
+    static ChunkPeriodsCache* instance();
+
+    static QString key(
+        const nx::Uuid& systemId,
+        const nx::Uuid& cameraId,
+        nx::vms::api::StorageLocation storageLocation);
+
+    /**
+     * @return The cached periods, or an empty list if they are absent, damaged or have been
+     *     saved earlier than maxAge ago.
+     */
+    QnTimePeriodList load(const QString& key, std::chrono::milliseconds maxAge) const;
+
+    bool save(const QString& key, const QnTimePeriodList& periods);
+    void remove(const QString& key);
+
+private:
+    QString filePath(const QString& key) const;
+
+private:
+    const QString m_directory;
+};
+
+} // namespace nx::vms::client::core
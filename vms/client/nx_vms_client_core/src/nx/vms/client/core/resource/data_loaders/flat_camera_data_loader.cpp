@@ -12,9 +12,12 @@
 #include <nx/utils/guarded_callback.h>
 #include <nx/utils/log/log.h>
 #include <recording/time_period_list.h>
+#include <nx/vms/client/core/ini.h>
 #include <nx/vms/client/core/system_context.h>
 #include <utils/common/synctime.h>
 
+#include "chunk_periods_cache.h"
+
 namespace nx::vms::client::core {
 
 namespace {
@@ -22,6 +25,9 @@ namespace {
 /** Minimum time (in milliseconds) for overlapping time periods requests.  */
 const int minOverlapDuration = 120 * 1000;
 
+/** The cached periods are saved no more often, and when the loader is destroyed. */
+constexpr std::chrono::minutes kCacheSaveInterval(5);
+
 QString filterRepresentation(const QString& filter, Qn::TimePeriodContent dataType)
 {
     switch (dataType)
@@ -65,6 +71,7 @@ FlatCameraDataLoader::FlatCameraDataLoader(
 
 FlatCameraDataLoader::~FlatCameraDataLoader()
 {
+    saveToCache();
 }
 
 void FlatCameraDataLoader::load(const QString &filter, const qint64 resolutionMs)
@@ -83,6 +90,9 @@ void FlatCameraDataLoader::load(const QString &filter, const qint64 resolutionMs
         return;
     }
 
+    if (!m_isCacheLoaded)
+        loadFromCache();
+
     /* We need to load all data after the already loaded piece, assuming there were no periods before already loaded. */
     qint64 startTimeMs = 0;
     if (!m_loadedData.empty())
@@ -112,6 +122,11 @@ void FlatCameraDataLoader::discardCachedData(const qint64 /*resolutionMs*/)
     NX_VERBOSE(this, "Discarding cached data");
     m_loading = LoadingInfo();
     m_loadedData.clear();
+
+    // The periods cached on the disk are not valid anymore either.
+    if (const auto key = cacheKey(); !key.isEmpty())
+        ChunkPeriodsCache::instance()->remove(key);
+    m_isCacheLoaded = true;
 }
 
 void FlatCameraDataLoader::setStorageLocation(nx::vms::api::StorageLocation value)
@@ -120,8 +135,11 @@ void FlatCameraDataLoader::setStorageLocation(nx::vms::api::StorageLocation valu
         return;
 
     NX_VERBOSE(this, "Select storage location: %1", value);
+    saveToCache();
     m_storageLocation = value;
-    discardCachedData();
+    m_loading = LoadingInfo();
+    m_loadedData.clear();
+    m_isCacheLoaded = false;
 }
 
 rest::Handle FlatCameraDataLoader::sendRequest(qint64 startTimeMs, qint64 resolutionMs)
@@ -167,15 +185,17 @@ void FlatCameraDataLoader::at_timePeriodsReceived(bool success,
         return;
     }
 
-    std::vector<QnTimePeriodList> rawPeriods;
-
-    for(auto period: timePeriods)
+    std::vector<std::span<const QnTimePeriod>> rawPeriods;
+    rawPeriods.reserve(timePeriods.size());
+    for (const auto& period: timePeriods)
     {
-        rawPeriods.push_back(period.periods);
+        rawPeriods.emplace_back(period.periods.data(), period.periods.size());
         NX_VERBOSE(this, "Received\n%1", periodsLogString(period.periods));
     }
 
-    QnTimePeriodList periods(QnTimePeriodList::mergeTimePeriods(rawPeriods));
+    // Merges the received lists in place, joining the adjacent periods only.
+    QnTimePeriodList periods(
+        QnTimePeriodList::aggregateTimePeriods(rawPeriods, std::chrono::milliseconds(1)));
 
     NX_VERBOSE(this, "Merged\n%1", periodsLogString(periods));
 
@@ -217,7 +237,56 @@ void FlatCameraDataLoader::handleDataLoaded(
         NX_VERBOSE(this, "Merging finished, size %1.", m_loadedData.size());
     }
 
+    if (m_cacheSaveTimer.hasExpired(kCacheSaveInterval))
+        saveToCache();
+
     emit ready(completedInfo.startTimeMs);
 }
 
+QString FlatCameraDataLoader::cacheKey() const
+{
+    if (m_dataType != Qn::RecordingContent || !m_filter.isEmpty()
+        || ini().cameraChunksCacheMaxAgeHours <= 0)
+    {
+        return QString();
+    }
+
+    const auto systemContext = SystemContext::fromResource(m_resource);
+    if (!systemContext || systemContext->localSystemId().isNull())
+        return QString();
+
+    return ChunkPeriodsCache::key(
+        systemContext->localSystemId(), m_resource->getId(), m_storageLocation);
+}
+
+void FlatCameraDataLoader::loadFromCache()
+{
+    m_isCacheLoaded = true;
+    if (!m_loadedData.empty())
+        return;
+
+    const auto key = cacheKey();
+    if (key.isEmpty())
+        return;
+
+    m_loadedData = ChunkPeriodsCache::instance()->load(
+        key, std::chrono::hours(ini().cameraChunksCacheMaxAgeHours));
+    if (m_loadedData.empty())
+        return;
+
+    NX_VERBOSE(this, "Starting from %1 cached periods", m_loadedData.size());
+    m_cacheSaveTimer.restart();
+    emit ready(/*startTimeMs*/ 0);
+}
+
+void FlatCameraDataLoader::saveToCache()
+{
+    const auto key = cacheKey();
+    if (key.isEmpty() || m_loadedData.empty())
+        return;
+
+    ChunkPeriodsCache::instance()->save(key, m_loadedData);
+    m_cacheSaveTimer.restart();
+}
+
 } // namespace nx::vms::client::core
@@ -8,6 +8,7 @@
 #include <api/server_rest_connection_fwd.h>
 #include <core/resource/camera_bookmark_fwd.h>
 #include <core/resource/resource_fwd.h>
+#include <nx/utils/elapsed_timer.h>
 #include <recording/time_period.h>
 #include <recording/time_period_list.h>
 
@@ -19,6 +20,8 @@ namespace nx::vms::client::core {
  * Per-camera data loader that caches loaded data.
  * Uses flat structure. Data is loaded with the most detailed level.
  * Source data period is solid, no spaces are allowed.
+ * The recorded periods are also cached on the disk by ChunkPeriodsCache, so after the Client
+ * restart only the periods after the cached ones are loaded.
  */
 class FlatCameraDataLoader: public AbstractCameraDataLoader
 {
@@ -51,6 +54,11 @@ private:
     rest::Handle sendRequest(qint64 startTimeMs, qint64 resolutionMs);
     void handleDataLoaded(bool success, QnTimePeriodList&& periods);
 
+    /** @return Empty string if the periods are not cached on the disk. */
+    QString cacheKey() const;
+    void loadFromCache();
+    void saveToCache();
+
 private:
     struct LoadingInfo
     {
@@ -65,6 +73,9 @@ private:
     nx::vms::api::StorageLocation m_storageLocation = nx::vms::api::StorageLocation::both;
 
     LoadingInfo m_loading;
+
+    bool m_isCacheLoaded = false;
+    nx::utils::ElapsedTimer m_cacheSaveTimer;
 };
 
 } // namespace nx::vms::client::core
@@ -7,6 +7,7 @@
 #include <nx/fusion/serialization/json.h>
 #include <nx/fusion/serialization/json_functions.h>
 #include <nx/media/config.h>
+#include <nx/media/motion_mask.h>
 #include <nx/vms/client/core/motion/motion_grid.h>
 #include <utils/common/delayed.h>
 
@@ -48,10 +49,20 @@ QnTimePeriodList QnLayoutFileCameraDataLoader::loadMotion(
     if (!NX_ASSERT(m_aviResource))
         return QnTimePeriodList();
 
-    QVector<MotionGridBitMask> masks;
-    masks.resize(motionRegions.size());
+    // Only the blocks covered by the selection are tested.
+    struct ChannelMask
+    {
+        MotionGridBitMask bits;
+        int firstBlock = 0;
+        int lastBlock = 0;
+    };
+
+    std::vector<ChannelMask> masks(motionRegions.size());
     for (int i = 0; i < motionRegions.size(); ++i)
-        QnMetaDataV1::createMask(motionRegions[i], reinterpret_cast<char*>(&masks[i]));
+    {
+        QnMetaDataV1::createMask(motionRegions[i], reinterpret_cast<char*>(&masks[i].bits),
+            &masks[i].firstBlock, &masks[i].lastBlock);
+    }
 
     std::vector<QnTimePeriodList> periods;
     for (int channel = 0; channel < motionRegions.size(); ++channel)
@@ -63,10 +74,12 @@ QnTimePeriodList QnLayoutFileCameraDataLoader::loadMotion(
 
             for (auto itr = m_motionData.begin(); itr != m_motionData.end(); ++itr)
             {
-                if (itr->channel <= motionRegions.size()
-                    && QnMetaDataV1::matchImage(
-                        (quint64*) itr->data,
-                        reinterpret_cast<simd128i*>(&masks[itr->channel])))
+                if (itr->channel >= motionRegions.size())
+                    continue;
+
+                const ChannelMask& mask = masks[itr->channel];
+                if (nx::media::motion_mask::intersects(
+                    itr->data, mask.bits.data(), mask.firstBlock, mask.lastBlock))
                 {
                     periods.rbegin()->push_back(QnTimePeriod(itr->startTimeMs, itr->durationMs));
                 }
@@ -35,7 +35,7 @@ class DesktopCameraConsumer: public QnAbstractDataConsumer
 {
 public:
     DesktopCameraConsumer(DesktopCameraConnectionProcessor* owner):
-        QnAbstractDataConsumer(50),
+        QnAbstractDataConsumer(50, QueueMode::lockFree),
         m_owner(owner),
         m_needVideoData(false)
     {
@@ -20,18 +20,33 @@ namespace {
 
 using namespace std::chrono;
 
+static constexpr int kMaxPacketsToKeyFrame = 100;
+
 QImage toImage(const CLVideoDecoderOutputPtr& frame, const QSize& size)
 {
-    if (frame->size() == size)
-        return frame->toImage();
-
-    if (const auto scaledFrame = frame->scaled(size))
-        return scaledFrame->toImage();
+    // The scaling is done along with the color conversion.
+    if (const auto image = frame->toImage(size); !image.isNull())
+        return image;
 
     // If FFMPEG scaling fails, use QImage scaling.
     return frame->toImage().scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 }
 
+QnCompressedVideoDataPtr getKeyFrame(const QnAviArchiveDelegatePtr& archiveDelegate)
+{
+    for (int i = 0; i < kMaxPacketsToKeyFrame; ++i)
+    {
+        const auto data = archiveDelegate->getNextData();
+        if (!data)
+            return {};
+
+        auto frame = std::dynamic_pointer_cast<QnCompressedVideoData>(data);
+        if (frame && frame->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey))
+            return frame;
+    }
+    return {};
+}
+
 QImage getFrame(
     const QnResourcePtr& resource, std::chrono::milliseconds position, int maximumSize)
 {
@@ -48,34 +63,31 @@ QImage getFrame(
     }
     else
     {
-        archiveDelegate->seek(microseconds(position).count(), false);
+        // Only the key frame is decoded, so there is no use in the exact seek.
+        archiveDelegate->seek(microseconds(position).count(), true);
     }
 
     // Loading frame.
-    const auto data = archiveDelegate->getNextData();
-    if (!data)
-        return {};
-
-    const auto frame = std::dynamic_pointer_cast<QnCompressedVideoData>(data);
+    const auto frame = getKeyFrame(archiveDelegate);
     if (!frame)
         return {};
 
     // Preparing frame to correctly decode it as a screenshot.
     frame->flags |= QnAbstractMediaData::MediaFlags_StillImage;
 
+    const int effectiveMaximumSize = maximumSize > 0
+        ? maximumSize
+        : std::numeric_limits<int>::max();
+
     QSharedPointer<CLVideoDecoderOutput> outFrame(new CLVideoDecoderOutput());
     QnFfmpegVideoDecoder decoder(
-        DecoderConfig(),
+        DecoderConfig{.keyFramesOnly = true, .minOutputSize = maximumSize},
         /*metrics*/ nullptr,
         frame);
 
     if (!decoder.decode(frame, &outFrame))
         return {};
 
-    const int effectiveMaximumSize = maximumSize > 0
-        ? maximumSize
-        : std::numeric_limits<int>::max();
-
     const auto size = nx::vms::client::core::Geometry::bounded(outFrame->size(),
         QSize(effectiveMaximumSize, effectiveMaximumSize), Qt::KeepAspectRatio).toSize();
 
@@ -2,25 +2,64 @@
 
 #include "thumbnail_cache.h"
 
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <nx/utils/log/log.h>
+
+#include "async_image_result.h"
+
 namespace nx::vms::client::core {
 
+using namespace std::chrono;
+
+namespace {
+
+constexpr int kExtraCost = 100;
+constexpr int kJpegQuality = 85;
+
+/** The frequently refreshed images are saved to the disk not more often than this. */
+constexpr seconds kMinSaveInterval = 1min;
+
+qint64 directorySize(const QString& directory)
+{
+    qint64 result = 0;
+    for (const auto& fileInfo: QDir(directory).entryInfoList(QDir::Files))
+        result += fileInfo.size();
+    return result;
+}
+
+} // namespace
+
 ThumbnailCache::ThumbnailCache(QObject* parent):
     base_type(parent)
 {
-    static const int kDefaultPixelLimit = 400 * 250 * 512;
-    m_cache.setMaxCost(kDefaultPixelLimit);
+    m_cache.setMaxCost(kDefaultMaxCostBytes);
 }
 
 void ThumbnailCache::insert(const QString& key, const QImage& image)
 {
-    static constexpr int kExtraCost = 100;
-    m_cache.insert(key, new QImage(image), (image.width() * image.height()) + kExtraCost);
+    insertToMemory(key, image);
+    save(key, image);
     emit updated(key, image);
 }
 
 void ThumbnailCache::remove(const QString& key)
 {
     m_cache.remove(key);
+    if (m_directory.isEmpty())
+        return;
+
+    const QFileInfo fileInfo(filePath(key));
+    if (QFile::remove(fileInfo.absoluteFilePath()))
+        m_persistentBytes -= fileInfo.size();
 }
 
 void ThumbnailCache::clear()
@@ -30,17 +69,177 @@ void ThumbnailCache::clear()
 
 QImage* ThumbnailCache::image(const QString& key) const
 {
+    if (const auto image = m_cache.object(key))
+        return image;
+
+    const QImage image = load(key);
+    if (image.isNull())
+        return nullptr;
+
+    insertToMemory(key, image);
     return m_cache.object(key);
 }
 
-int ThumbnailCache::maxCostPixels() const
+qint64 ThumbnailCache::maxCostBytes() const
 {
     return m_cache.maxCost();
 }
 
-void ThumbnailCache::setMaxCostPixels(int value)
+void ThumbnailCache::setMaxCostBytes(qint64 value)
 {
     m_cache.setMaxCost(value);
 }
 
+void ThumbnailCache::setPersistentDirectory(const QString& directory)
+{
+    if (m_directory == directory)
+        return;
+
+    m_cache.clear();
+    m_directory = directory;
+    m_persistentBytes = m_directory.isEmpty() ? 0 : directorySize(m_directory);
+    NX_DEBUG(this, "Persistent directory: %1, %2 bytes", m_directory, m_persistentBytes);
+}
+
+QString ThumbnailCache::persistentDirectory() const
+{
+    return m_directory;
+}
+
+void ThumbnailCache::setMaxPersistentBytes(qint64 value)
+{
+    m_maxPersistentBytes = value;
+    evictPersistentImages();
+}
+
+QString ThumbnailCache::persistentDirectory(
+    const nx::Uuid& systemId, const nx::Uuid& userId, const QString& cacheName)
+{
+    return nx::format("%1/thumbnails/%2/%3/%4",
+        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation),
+        systemId.toSimpleString(), userId.toSimpleString(), cacheName);
+}
+
+void ThumbnailCache::insertToMemory(const QString& key, const QImage& image) const
+{
+    m_cache.insert(key, new QImage(image), image.sizeInBytes() + kExtraCost);
+}
+
+QString ThumbnailCache::filePath(const QString& key) const
+{
+    return m_directory + "/"
+        + QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5).toHex() + ".bin";
+}
+
+QImage ThumbnailCache::load(const QString& key) const
+{
+    if (m_directory.isEmpty())
+        return {};
+
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    qint64 timestampUs = 0;
+    QByteArray data;
+    QDataStream stream(&file);
+    stream >> timestampUs >> data;
+
+    QImage image;
+    if (stream.status() != QDataStream::Ok || !image.loadFromData(data))
+    {
+        NX_DEBUG(this, "Cached image %1 is damaged", file.fileName());
+        file.remove();
+        return {};
+    }
+
+    // The modification time orders the images for the eviction.
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    if (timestampUs > 0)
+        AsyncImageResult::setTimestamp(image, microseconds(timestampUs));
+
+    NX_VERBOSE(this, "Loaded cached image %1 (%2)", key, image.size());
+    return image;
+}
+
+void ThumbnailCache::save(const QString& key, const QImage& image)
+{
+    if (m_directory.isEmpty() || image.isNull())
+        return;
+
+    const QString path = filePath(key);
+    const QFileInfo fileInfo(path);
+    const qint64 timestampUs = AsyncImageResult::timestamp(image).count();
+
+    if (fileInfo.exists())
+    {
+        if (fileInfo.lastModified().secsTo(QDateTime::currentDateTime()) < kMinSaveInterval.count())
+            return;
+
+        QFile file(path);
+        qint64 savedTimestampUs = 0;
+        if (file.open(QIODevice::ReadOnly))
+            QDataStream(&file) >> savedTimestampUs;
+
+        if (savedTimestampUs > timestampUs)
+            return;
+    }
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, image.hasAlphaChannel() ? "PNG" : "JPG", kJpegQuality))
+        return;
+
+    if (!QDir().mkpath(m_directory))
+        return;
+
+    // The file is replaced at once, so the damaged file is not left if the Client is killed.
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream << timestampUs << data;
+    if (stream.status() != QDataStream::Ok || !file.commit())
+    {
+        NX_DEBUG(this, "Unable to save the cached image to %1: %2", path, file.errorString());
+        return;
+    }
+
+    m_persistentBytes += QFileInfo(path).size() - fileInfo.size();
+    if (m_persistentBytes > m_maxPersistentBytes)
+        evictPersistentImages();
+}
+
+void ThumbnailCache::evictPersistentImages()
+{
+    if (m_directory.isEmpty() || m_persistentBytes <= m_maxPersistentBytes)
+        return;
+
+    // Some space is freed at once, so the eviction does not happen on every save.
+    const qint64 targetBytes = m_maxPersistentBytes * 3 / 4;
+
+    auto files = QDir(m_directory).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+    m_persistentBytes = 0;
+    for (const auto& fileInfo: files)
+        m_persistentBytes += fileInfo.size();
+
+    int removedCount = 0;
+    for (const auto& fileInfo: files)
+    {
+        if (m_persistentBytes <= targetBytes)
+            break;
+
+        if (QFile::remove(fileInfo.absoluteFilePath()))
+        {
+            m_persistentBytes -= fileInfo.size();
+            ++removedCount;
+        }
+    }
+
+    NX_DEBUG(this, "Evicted %1 cached images, %2 bytes left", removedCount, m_persistentBytes);
+}
+
 } // namespace nx::vms::client::core
@@ -7,11 +7,18 @@
 #include <QtCore/QString>
 #include <QtGui/QImage>
 
+#include <nx/utils/uuid.h>
+
 namespace nx::vms::client::core {
 
 /**
  * Thumbnail image cache with a capability to emit a signal upon each write into.
  * Intended to be used mostly with AbstractCachingResourceThumbnail descendants.
+ *
+ * The memory tier is limited by the size of the decoded images in bytes. An optional persistent
+ * tier keeps the images compressed on the disk, so they survive the memory tier eviction and the
+ * Client restart. The image timestamp is stored along with the image, so an older image never
+ * replaces a newer one.
  */
 class NX_VMS_CLIENT_CORE_API ThumbnailCache: public QObject
 {
@@ -19,17 +26,37 @@ class NX_VMS_CLIENT_CORE_API ThumbnailCache: public QObject
     using base_type = QObject;
 
 public:
+    static constexpr qint64 kDefaultMaxCostBytes = 400 * 250 * 4 * 512;
+    static constexpr qint64 kDefaultMaxPersistentBytes = 100 * 1024 * 1024;
+
     ThumbnailCache(QObject* parent = nullptr);
     virtual ~ThumbnailCache() override = default;
 
     void insert(const QString& key, const QImage& image);
     void remove(const QString& key);
+
+    /** Clears the memory tier. The persistent tier is kept. */
     void clear();
 
+    /** Looks up the image in the memory tier, then in the persistent one. */
     QImage* image(const QString& key) const;
 
-    int maxCostPixels() const;
-    void setMaxCostPixels(int value);
+    qint64 maxCostBytes() const;
+    void setMaxCostBytes(qint64 value);
+
+    /**
+     * Sets the directory of the persistent tier. An empty value disables it. The memory tier is
+     * cleared when the directory changes, as the cached images may belong to the other System or
+     * User.
+     */
+    void setPersistentDirectory(const QString& directory);
+    QString persistentDirectory() const;
+
+    void setMaxPersistentBytes(qint64 value);
+
+    /** The persistent tier directory in the application local data for the System and User. */
+    static QString persistentDirectory(
+        const nx::Uuid& systemId, const nx::Uuid& userId, const QString& cacheName);
 
 signals:
     /**
@@ -39,7 +66,18 @@ signals:
     void updated(const QString& key, const QImage& image);
 
 private:
-    QCache<QString, QImage> m_cache;
+    void insertToMemory(const QString& key, const QImage& image) const;
+    QString filePath(const QString& key) const;
+    QImage load(const QString& key) const;
+    void save(const QString& key, const QImage& image);
+    void evictPersistentImages();
+
+private:
+    mutable QCache<QString, QImage> m_cache;
+
+    QString m_directory;
+    qint64 m_maxPersistentBytes = kDefaultMaxPersistentBytes;
+    qint64 m_persistentBytes = 0;
 };
 
 } // namespace nx::vms::client::core
@@ -0,0 +1,76 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/vms/client/core/media/time_period_storage.h>
+
+namespace nx::vms::client::core::test {
+
+namespace {
+
+static constexpr int kAggregationMs = 1000;
+
+QnTimePeriodList makePeriods(qint64 startTimeMs, int count, qint64 durationMs, qint64 gapMs)
+{
+    QnTimePeriodList result;
+    for (int i = 0; i < count; ++i)
+        result.push_back(QnTimePeriod(startTimeMs + i * (durationMs + gapMs), durationMs));
+    return result;
+}
+
+} // namespace
+
+class TimePeriodStorageTest: public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_storage.setAggregationMSecs(kAggregationMs);
+
+        // The small gaps are aggregated, the large ones are not.
+        m_periods = makePeriods(0, 10, 5000, 500);
+        const auto periods = makePeriods(100'000, 10, 5000, 5000);
+        m_periods.insert(m_periods.end(), periods.begin(), periods.end());
+        m_storage.setPeriods(Qn::RecordingContent, m_periods);
+    }
+
+    /** Checks the storage against the one the whole list is set to. */
+    void update(const QnTimePeriodList& tail, qint64 startTimeMs)
+    {
+        QnTimePeriodList::overwriteTail(m_periods, tail, startTimeMs);
+        m_storage.updatePeriods(Qn::RecordingContent, tail, startTimeMs);
+
+        TimePeriodStorage expected;
+        expected.setAggregationMSecs(kAggregationMs);
+        expected.setPeriods(Qn::RecordingContent, m_periods);
+        ASSERT_EQ(m_periods, m_storage.periods(Qn::RecordingContent));
+        ASSERT_EQ(expected.aggregated(Qn::RecordingContent),
+            m_storage.aggregated(Qn::RecordingContent));
+    }
+
+protected:
+    TimePeriodStorage m_storage;
+    QnTimePeriodList m_periods;
+};
+
+TEST_F(TimePeriodStorageTest, tailIsAppended)
+{
+    update({QnTimePeriod(195'500, 3000), QnTimePeriod(210'000, -1)}, 195'000);
+    update({QnTimePeriod(210'000, 10'000), QnTimePeriod(220'500, -1)}, 210'000);
+}
+
+TEST_F(TimePeriodStorageTest, tailJoinsAggregatedPeriod)
+{
+    // The first period of the tail is closer than the aggregation to the previous one.
+    update({QnTimePeriod(50'500, 1000)}, 50'000);
+    ASSERT_EQ(1, (int) m_storage.aggregated(Qn::RecordingContent).size());
+}
+
+TEST_F(TimePeriodStorageTest, tailOverwritesPeriods)
+{
+    update({QnTimePeriod(20'000, 100)}, 20'000);
+    update({}, 10'000);
+    update(makePeriods(0, 3, 1000, 2000), 0);
+}
+
+} // namespace nx::vms::client::core::test
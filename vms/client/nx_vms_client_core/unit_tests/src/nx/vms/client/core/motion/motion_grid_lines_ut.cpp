@@ -0,0 +1,61 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+#include <nx/media/meta_data_packet.h>
+#include <nx/vms/client/core/motion/motion_grid_lines.h>
+
+namespace nx::vms::client::core::test {
+
+namespace {
+
+/** 64-bit words keep the grid aligned for QnMetaDataV1::addMotion(). */
+using Grid = std::array<quint64, QnMetaDataV1::kMotionDataBufferSize / sizeof(quint64)>;
+
+Grid makeGrid(std::initializer_list<QPoint> cells)
+{
+    Grid grid{};
+    for (const auto& cell: cells)
+        QnMetaDataV1::addMotion((char*) grid.data(), QRect(cell, QSize(1, 1)));
+    return grid;
+}
+
+} // namespace
+
+TEST(MotionGridLines, linesOfEmptyGrid)
+{
+    MotionGridLines lines;
+    ASSERT_TRUE(lines.motionLines().empty());
+    ASSERT_EQ((Qn::kMotionGridWidth - 1 + Qn::kMotionGridHeight - 1) * 2,
+        lines.backgroundLines().size());
+
+    ASSERT_FALSE(lines.update(makeGrid({}).data()));
+    ASSERT_FALSE(lines.update(nullptr));
+}
+
+TEST(MotionGridLines, linesAroundMotion)
+{
+    MotionGridLines lines;
+    const auto grid = makeGrid({QPoint(2, 3)});
+    ASSERT_TRUE(lines.update(grid.data()));
+    ASSERT_FALSE(lines.update(grid.data()));
+
+    ASSERT_EQ(QVector<QPointF>({
+        QPointF(2, 3), QPointF(3, 3),
+        QPointF(2, 4), QPointF(3, 4),
+        QPointF(2, 3), QPointF(2, 4),
+        QPointF(3, 3), QPointF(3, 4)}),
+        lines.motionLines());
+
+    // Each of the four lines is split into two background segments around the motion.
+    ASSERT_EQ((Qn::kMotionGridWidth - 1 + Qn::kMotionGridHeight - 1 + 4) * 2,
+        lines.backgroundLines().size());
+
+    // The skipped cells are not shown as motion.
+    ASSERT_TRUE(lines.update(grid.data(), grid.data()));
+    ASSERT_TRUE(lines.motionLines().empty());
+}
+
+} // namespace nx::vms::client::core::test
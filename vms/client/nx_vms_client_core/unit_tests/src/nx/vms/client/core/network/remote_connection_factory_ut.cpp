@@ -293,6 +293,11 @@ public:
         ASSERT_TRUE((bool) connection->get());
     }
 
+    void thenConnectionFailed()
+    {
+        ASSERT_FALSE(std::holds_alternative<RemoteConnectionPtr>(result));
+    }
+
     void thenAuthenticatedAs(nx::network::http::Credentials credentials)
     {
         if (auto connection = std::get_if<RemoteConnectionPtr>(&result))
@@ -509,6 +514,34 @@ TEST_F(RemoteConnectionFactoryTest, ldapUserTest)
     thenConnectionSuccessful();
 }
 
+// Check scenario when the client switches back to the recently connected System.
+TEST_F(RemoteConnectionFactoryTest, localSystemRecentConnectionTest)
+{
+    givenSystem();
+    givenLogonData({.hasToken = false});
+    whenConnectToSystem();
+    thenRequestsCountIs(3); //< serversInfo, userType, issueToken
+    thenConnectionSuccessful();
+
+    whenConnectToSystem();
+    thenRequestsCountIs(5); //< userType, issueToken
+    thenConnectionSuccessful();
+    thenAuthenticatedAsLocalUser();
+}
+
+// Check that the recent connection does not let the client log in with a wrong password.
+TEST_F(RemoteConnectionFactoryTest, localSystemRecentConnectionWrongPasswordTest)
+{
+    givenSystem();
+    givenLogonData({.hasToken = false});
+    whenConnectToSystem();
+    thenConnectionSuccessful();
+
+    logonData.credentials.authToken = nx::network::http::PasswordAuthToken("wrong_password");
+    whenConnectToSystem();
+    thenConnectionFailed();
+}
+
 // Check whether compatibility model is not requested for 6.0 systems.
 
 // TODO: desktop client
@@ -0,0 +1,43 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include <nx/utils/test_support/test_with_temporary_directory.h>
+#include <nx/vms/client/core/resource/data_loaders/chunk_periods_cache.h>
+
+namespace nx::vms::client::core::test {
+
+using namespace std::chrono;
+
+class ChunkPeriodsCacheTest:
+    public ::testing::Test,
+    public nx::utils::test::TestWithTemporaryDirectory
+{
+protected:
+    ChunkPeriodsCache m_cache{testDataDir()};
+    const QString m_key = ChunkPeriodsCache::key(
+        nx::Uuid::createUuid(), nx::Uuid::createUuid(), nx::vms::api::StorageLocation::both);
+};
+
+TEST_F(ChunkPeriodsCacheTest, periodsAreLoaded)
+{
+    ASSERT_TRUE(m_cache.load(m_key, hours(1)).empty());
+
+    QnTimePeriodList periods;
+    periods.push_back(QnTimePeriod(1'700'000'000'000, 60'000));
+    periods.push_back(QnTimePeriod(1'700'000'100'000, 1));
+    periods.push_back(QnTimePeriod(1'700'000'200'000, QnTimePeriod::kInfiniteDuration));
+    ASSERT_TRUE(m_cache.save(m_key, periods));
+    ASSERT_EQ(periods, m_cache.load(m_key, hours(1)));
+
+    // The outdated periods are not loaded.
+    ASSERT_TRUE(m_cache.load(m_key, milliseconds(-1)).empty());
+
+    m_cache.remove(m_key);
+    ASSERT_TRUE(m_cache.load(m_key, hours(1)).empty());
+}
+
+} // namespace nx::vms::client::core::test
@@ -0,0 +1,88 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/test_support/test_with_temporary_directory.h>
+#include <nx/vms/client/core/thumbnails/async_image_result.h>
+#include <nx/vms/client/core/thumbnails/thumbnail_cache.h>
+
+namespace nx::vms::client::core::test {
+
+using namespace std::chrono;
+
+namespace {
+
+QImage makeImage(QColor color, microseconds timestamp)
+{
+    // The image with alpha channel is saved losslessly, so the pixels can be compared.
+    QImage image(16, 16, QImage::Format_ARGB32);
+    image.fill(color);
+    AsyncImageResult::setTimestamp(image, timestamp);
+    return image;
+}
+
+} // namespace
+
+class ThumbnailCacheTest:
+    public ::testing::Test,
+    public nx::utils::test::TestWithTemporaryDirectory
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_cache.setPersistentDirectory(testDataDir());
+    }
+
+    /** Emulates the Client restart. */
+    void restart()
+    {
+        m_cache.setPersistentDirectory({});
+        m_cache.setPersistentDirectory(testDataDir());
+    }
+
+protected:
+    ThumbnailCache m_cache;
+};
+
+TEST_F(ThumbnailCacheTest, imagesAreLoadedFromPersistentTier)
+{
+    const auto image = makeImage(Qt::red, 1s);
+    m_cache.insert("camera", image);
+    restart();
+
+    const auto cachedImage = m_cache.image("camera");
+    ASSERT_TRUE(cachedImage);
+    ASSERT_EQ(image.pixel(0, 0), cachedImage->pixel(0, 0));
+    ASSERT_EQ(1s, AsyncImageResult::timestamp(*cachedImage));
+
+    m_cache.remove("camera");
+    restart();
+    ASSERT_FALSE(m_cache.image("camera"));
+}
+
+TEST_F(ThumbnailCacheTest, memoryTierIsLimitedByImageBytes)
+{
+    m_cache.setPersistentDirectory({});
+    const auto image = makeImage(Qt::red, 1s);
+    m_cache.setMaxCostBytes(image.sizeInBytes() * 5 / 2);
+
+    m_cache.insert("first", image);
+    m_cache.insert("second", image);
+    m_cache.insert("third", image);
+    ASSERT_FALSE(m_cache.image("first"));
+    ASSERT_TRUE(m_cache.image("second"));
+    ASSERT_TRUE(m_cache.image("third"));
+}
+
+TEST_F(ThumbnailCacheTest, persistentTierIsLimitedBySize)
+{
+    for (int i = 0; i < 10; ++i)
+        m_cache.insert(QString::number(i), makeImage(Qt::red, 1s));
+
+    m_cache.setMaxPersistentBytes(1);
+    restart();
+    for (int i = 0; i < 10; ++i)
+        ASSERT_FALSE(m_cache.image(QString::number(i)));
+}
+
+} // namespace nx::vms::client::core::test
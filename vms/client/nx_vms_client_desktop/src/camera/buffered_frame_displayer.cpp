@@ -2,20 +2,45 @@
 
 #include "buffered_frame_displayer.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include <nx/media/ffmpeg/frame_info.h>
 #include <utils/common/adaptive_sleep.h>
 
+#include "frame_presentation_scheduler.h"
 #include "ui/graphics/items/resource/resource_widget_renderer.h"
 #include "video_stream_display.h"
 
+using namespace std::chrono;
+
+namespace {
+
+constexpr int kMaxQueueSize = 11;
+
+/** Buffer depth of a stream without jitter, in microseconds. */
+constexpr qint64 kMinQueueTime = 40'000;
+
+/** The buffer covers this number of the mean jitter deviations. */
+constexpr int kJitterMultiplier = 4;
+
+/** Larger transit time changes are discontinuities (e.g. seeks), not jitter. */
+constexpr qint64 kMaxJitterSample = 1'000'000;
+
+constexpr auto kWaitTimeout = milliseconds(100);
+
+} // namespace
+
 QnBufferedFrameDisplayer::QnBufferedFrameDisplayer():
-    base_type(),
-    m_queue(11)
+    m_scheduler(QnFramePresentationScheduler::instance())
 {
     m_currentTime = AV_NOPTS_VALUE;
     m_expectedTime = AV_NOPTS_VALUE;
     m_lastDisplayedTime = AV_NOPTS_VALUE;
-    start();
+    m_lastQueuedTime = AV_NOPTS_VALUE;
+    m_lastTransitTime = AV_NOPTS_VALUE;
+    m_arrivalTimer.start();
+    m_scheduler->addDisplayer(this);
 }
 
 void QnBufferedFrameDisplayer::setRenderList(std::set<QnResourceWidgetRenderer*> renderList)
@@ -24,54 +49,92 @@ void QnBufferedFrameDisplayer::setRenderList(std::set<QnResourceWidgetRenderer*>
     m_renderList = renderList;
 }
 
-QnBufferedFrameDisplayer::~QnBufferedFrameDisplayer() {
-    stop();
+QnBufferedFrameDisplayer::~QnBufferedFrameDisplayer()
+{
+    pleaseStop();
+    m_scheduler->removeDisplayer(this);
 }
 
 void QnBufferedFrameDisplayer::waitForFramesDisplayed()
 {
-    while (m_queue.size() > 0)
-        msleep(1);
+    NX_MUTEX_LOCKER lock(&m_sync);
+    while (!m_queue.empty() && !m_terminated)
+        m_queueChanged.wait(&m_sync, kWaitTimeout);
 }
 
 qint64 QnBufferedFrameDisplayer::bufferedDuration()
 {
     NX_MUTEX_LOCKER lock(&m_sync);
-    auto randomAccess = m_queue.lock();
-    if (randomAccess.size() == 0)
+    if (m_queue.empty())
         return 0;
     else
-        return m_lastQueuedTime - randomAccess.front()->pkt_dts;
+        return m_lastQueuedTime - m_queue.front()->pkt_dts;
+}
+
+qint64 QnBufferedFrameDisplayer::targetBufferDuration() const
+{
+    NX_MUTEX_LOCKER lock(&m_sync);
+    return targetBufferDurationUnsafe();
+}
+
+qint64 QnBufferedFrameDisplayer::targetBufferDurationUnsafe() const
+{
+    const auto duration = (qint64) (kJitterMultiplier * m_jitter);
+    return std::clamp<qint64>(duration, kMinQueueTime, kMaxQueueTime);
+}
+
+int QnBufferedFrameDisplayer::droppedFrameCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_sync);
+    return m_droppedFrameCount;
+}
+
+void QnBufferedFrameDisplayer::updateJitterUnsafe(qint64 frameTime)
+{
+    const qint64 transitTime = m_arrivalTimer.nsecsElapsed() / 1000 - frameTime;
+    if (m_lastTransitTime != AV_NOPTS_VALUE)
+    {
+        const qint64 deviation = std::abs(transitTime - m_lastTransitTime);
+        if (deviation < kMaxJitterSample)
+            m_jitter += (deviation - m_jitter) / 16;
+    }
+    m_lastTransitTime = transitTime;
 }
 
 bool QnBufferedFrameDisplayer::addFrame(const CLConstVideoDecoderOutputPtr& outFrame)
 {
     bool wasWaiting = false;
-    bool needWait;
-    do
+    bool wasEmpty = false;
     {
-        {
-            NX_MUTEX_LOCKER lock(&m_sync);
-            m_lastQueuedTime = outFrame->pkt_dts;
-            auto randomAccess = m_queue.lock();
-            needWait = !needToStop() && (randomAccess.size() == m_queue.maxSize() ||
-                (randomAccess.size() > 0 && outFrame->pkt_dts - randomAccess.front()->pkt_dts >= kMaxQueueTime));
-        }
-        if (needWait)
+        NX_MUTEX_LOCKER lock(&m_sync);
+        m_lastQueuedTime = outFrame->pkt_dts;
+        updateJitterUnsafe(outFrame->pkt_dts);
+        const qint64 maxQueueTime = targetBufferDurationUnsafe();
+
+        while (!m_terminated && ((int) m_queue.size() >= kMaxQueueSize
+            || (!m_queue.empty() && outFrame->pkt_dts - m_queue.front()->pkt_dts >= maxQueueTime)))
         {
             wasWaiting = true;
-            msleep(1);
+            m_queueChanged.wait(&m_sync, kWaitTimeout);
         }
-    } while (needWait);
-    m_queue.push(outFrame);
+
+        wasEmpty = m_queue.empty();
+        m_queue.push_back(outFrame);
+    }
+
+    if (wasEmpty)
+        m_scheduler->wakeUp();
     return wasWaiting;
 }
 
 void QnBufferedFrameDisplayer::setCurrentTime(qint64 time)
 {
-    NX_MUTEX_LOCKER lock( &m_sync );
-    m_currentTime = time;
-    m_timer.restart();
+    {
+        NX_MUTEX_LOCKER lock( &m_sync );
+        m_currentTime = time;
+        m_timer.restart();
+    }
+    m_scheduler->wakeUp();
 }
 
 void QnBufferedFrameDisplayer::clear()
@@ -79,7 +142,8 @@ void QnBufferedFrameDisplayer::clear()
     NX_MUTEX_LOCKER lock(&m_sync);
     m_queue.clear();
     m_currentTime = m_expectedTime = AV_NOPTS_VALUE;
-    m_sleepCond.wakeOne();
+    m_lastTransitTime = AV_NOPTS_VALUE;
+    m_queueChanged.wakeAll();
 }
 
 qint64 QnBufferedFrameDisplayer::getTimestampOfNextFrameToRender() const
@@ -96,72 +160,84 @@ void QnBufferedFrameDisplayer::overrideTimestampOfNextFrameToRender(qint64 value
 
 void QnBufferedFrameDisplayer::pleaseStop()
 {
-    base_type::pleaseStop();
-    m_queue.setTerminated(true);
+    NX_MUTEX_LOCKER lock(&m_sync);
+    m_terminated = true;
+    m_queueChanged.wakeAll();
+}
+
+qint64 QnBufferedFrameDisplayer::presentationTimeUnsafe()
+{
+    const auto& frame = m_queue.front();
+    if (m_expectedTime == AV_NOPTS_VALUE)
+    {
+        m_alignedTimer.restart();
+        m_expectedTime = frame->pkt_dts;
+    }
+
+    qint64 expectedTime = m_expectedTime + m_alignedTimer.nsecsElapsed() / 1000;
+    qint64 currentTime = m_currentTime != AV_NOPTS_VALUE
+        ? m_currentTime + m_timer.nsecsElapsed() / 1000
+        : expectedTime;
+
+    // align to grid
+    if (qAbs(expectedTime - currentTime) < 60000)
+    {
+        currentTime = expectedTime;
+    }
+    else
+    {
+        m_alignedTimer.restart();
+        m_expectedTime = currentTime;
+    }
+    if (frame->pkt_dts - currentTime > MAX_VALID_SLEEP_TIME)
+    {
+        currentTime = m_currentTime = m_expectedTime = frame->pkt_dts;
+        m_alignedTimer.restart();
+        m_timer.restart();
+    }
+    return currentTime;
 }
 
-void QnBufferedFrameDisplayer::run()
+std::optional<microseconds> QnBufferedFrameDisplayer::presentDueFrames(
+    microseconds refreshInterval)
 {
     CLConstVideoDecoderOutputPtr frame;
-    m_queue.setTerminated(false);
-    while (!needToStop())
     {
+        NX_MUTEX_LOCKER lock(&m_sync);
+        if (m_queue.empty())
+            return std::nullopt;
+
+        // The frames due in the current refresh interval are presented now.
+        const qint64 currentTime = presentationTimeUnsafe() + refreshInterval.count() / 2;
+        const qint64 sleepTime = m_queue.front()->pkt_dts - currentTime;
+        if (sleepTime > 0)
+            return microseconds(sleepTime);
+        if (sleepTime < -1'000'000)
+            m_currentTime = m_expectedTime = AV_NOPTS_VALUE;
+
+        // When the presentation is behind, only the latest of the due frames is shown.
+        while (m_queue.size() > 1 && m_queue[1]->pkt_dts <= currentTime)
         {
-            auto randomAccess = m_queue.lock();
-            frame = randomAccess.size() > 0 ? randomAccess.front() : CLConstVideoDecoderOutputPtr();
-        }
-        if (frame)
-        {
-            if (m_expectedTime == AV_NOPTS_VALUE)
-            {
-                m_alignedTimer.restart();
-                m_expectedTime = frame->pkt_dts;
-            }
-
-            NX_MUTEX_LOCKER syncLock( &m_sync );
-            qint64 expectedTime = m_expectedTime  + m_alignedTimer.elapsed()*1000ll;
-            qint64 currentTime = m_currentTime != AV_NOPTS_VALUE ? m_currentTime + m_timer.elapsed()*1000ll : expectedTime;
-
-            // align to grid
-            if (qAbs(expectedTime - currentTime) < 60000) {
-                currentTime = expectedTime;
-            }
-            else {
-                m_alignedTimer.restart();
-                m_expectedTime = currentTime;
-            }
-            if (frame->pkt_dts - currentTime >  MAX_VALID_SLEEP_TIME) {
-                currentTime = m_currentTime = m_expectedTime = frame->pkt_dts;
-                m_alignedTimer.restart();
-                m_timer.restart();
-            }
-            qint64 sleepTime = frame->pkt_dts - currentTime;
-            if (sleepTime > 0)
-                m_sleepCond.wait(&m_sync, sleepTime / 1000);
-            else if (sleepTime < -1000000)
-                m_currentTime = m_expectedTime = AV_NOPTS_VALUE;
-
-            if (m_queue.isEmpty())
-                continue; //< queue clear could be called from other thread
-            m_queue.pop(frame);
-            m_lastDisplayedTime = frame->pkt_dts;
-            {
-                NX_MUTEX_LOCKER lock( &m_renderMtx );
-                int maxW = 0, maxH = 0;
-                for (const auto& render: m_renderList)
-                {
-                    QSize sz = render->sizeOnScreen(0);
-                    maxW = qMax(sz.width(), maxW);
-                    maxH = qMax(sz.height(), maxH);
-                }
-                foreach(QnResourceWidgetRenderer* render, m_renderList)
-                    render->draw(frame, QSize(maxW, maxH));
-            }
-        }
-        else {
-            msleep(1);
+            m_queue.pop_front();
+            ++m_droppedFrameCount;
         }
+
+        frame = m_queue.front();
+        m_queue.pop_front();
+        m_lastDisplayedTime = frame->pkt_dts;
+        m_queueChanged.wakeAll();
     }
 
-    m_queue.clear();
+    NX_MUTEX_LOCKER lock( &m_renderMtx );
+    int maxW = 0, maxH = 0;
+    for (const auto& render: m_renderList)
+    {
+        QSize sz = render->sizeOnScreen(0);
+        maxW = qMax(sz.width(), maxW);
+        maxH = qMax(sz.height(), maxH);
+    }
+    for (const auto render: m_renderList)
+        render->draw(frame, QSize(maxW, maxH));
+
+    return microseconds::zero(); //< The next frame may be due as well.
 }
@@ -3,35 +3,47 @@
 #ifndef QN_BUFFERED_FRAME_DISPLAYER_H
 #define QN_BUFFERED_FRAME_DISPLAYER_H
 
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
 #include <set>
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QSharedPointer>
 
-#include <nx/utils/thread/long_runnable.h>
 #include <nx/utils/thread/mutex.h>
-#include <utils/common/threadqueue.h>
 
 class QnResourceWidgetRenderer;
+class QnFramePresentationScheduler;
 class CLVideoDecoderOutput;
 
 using CLConstVideoDecoderOutputPtr = QSharedPointer<const CLVideoDecoderOutput>;
 
-class QnBufferedFrameDisplayer: public QnLongRunnable
+/**
+ * Buffers the decoded frames of a stream and presents them in time. The frames are presented by
+ * the thread of QnFramePresentationScheduler, shared by all the displayers.
+ *
+ * The buffer depth adapts to the jitter of the frame arrival (network and decoding), measured
+ * like the RTP interarrival jitter: a steady stream is buffered for a short time, a jittery one up
+ * to kMaxQueueTime. When the presentation is behind, only the last of the due frames is presented.
+ */
+class QnBufferedFrameDisplayer
 {
-    Q_OBJECT
-
-    using base_type = QnLongRunnable;
 public:
     QnBufferedFrameDisplayer();
+    virtual ~QnBufferedFrameDisplayer();
 
     void setRenderList(std::set<QnResourceWidgetRenderer*> renderList);
 
-    virtual ~QnBufferedFrameDisplayer();
-
     void waitForFramesDisplayed();
 
     qint64 bufferedDuration();
 
+    /**
+     * Blocks while the buffer is full.
+     * @return Whether the call has been blocked.
+     */
     bool addFrame(const CLConstVideoDecoderOutputPtr& outFrame);
 
     void setCurrentTime(qint64 time);
@@ -42,12 +54,30 @@ public:
 
     void overrideTimestampOfNextFrameToRender(qint64 value);
 
-    virtual void pleaseStop() override;
-protected:
-    virtual void run() override;
+    void pleaseStop();
+
+    /** Current buffer depth limit, in microseconds. */
+    qint64 targetBufferDuration() const;
+
+    /** Number of the frames skipped because the presentation was behind. */
+    int droppedFrameCount() const;
+
+    /**
+     * Presents the frames which are due in the current refresh interval. Called by the scheduler.
+     * @return Time until the next frame is due, or nullopt if there are no frames.
+     */
+    std::optional<std::chrono::microseconds> presentDueFrames(
+        std::chrono::microseconds refreshInterval);
+
+private:
+    qint64 targetBufferDurationUnsafe() const;
+    qint64 presentationTimeUnsafe();
+    void updateJitterUnsafe(qint64 frameTime);
 
 private:
-    QnSafeQueue<CLConstVideoDecoderOutputPtr> m_queue;
+    const std::shared_ptr<QnFramePresentationScheduler> m_scheduler;
+
+    std::deque<CLConstVideoDecoderOutputPtr> m_queue;
     std::set<QnResourceWidgetRenderer*> m_renderList;
     qint64 m_lastQueuedTime;
     qint64 m_expectedTime;
@@ -55,10 +85,16 @@ private:
     QElapsedTimer m_alignedTimer;
     qint64 m_currentTime;
     mutable nx::Mutex m_sync;
-    nx::WaitCondition m_sleepCond;
+    nx::WaitCondition m_queueChanged;
     //!This mutex is used for clearing frame queue only
     nx::Mutex m_renderMtx;
     qint64 m_lastDisplayedTime;
+    bool m_terminated = false;
+
+    QElapsedTimer m_arrivalTimer;
+    qint64 m_lastTransitTime;
+    double m_jitter = 0;
+    int m_droppedFrameCount = 0;
 };
 
 #endif // QN_BUFFERED_FRAME_DISPLAYER_H
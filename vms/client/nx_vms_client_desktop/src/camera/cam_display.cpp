@@ -2124,6 +2124,17 @@ QSize QnCamDisplay::getMaxScreenSize() const
         return QSize();
 }
 
+std::chrono::microseconds QnCamDisplay::decodeDuration() const
+{
+    std::chrono::microseconds result{0};
+    for (int i = 0; i < m_channelsCount; ++i)
+    {
+        if (m_display[i])
+            result += m_display[i]->decodeDuration();
+    }
+    return result;
+}
+
 QSize QnCamDisplay::getVideoSize() const
 {
     if (m_display[0])
@@ -2257,6 +2268,11 @@ int QnCamDisplay::maxDataQueueSize() const
     return QnAbstractDataConsumer::maxQueueSize();
 }
 
+qint64 QnCamDisplay::bitrateBitsPerSecond() const
+{
+    return getArchiveReader()->bitrateBitsPerSecond();
+}
+
 void QnCamDisplay::setCallbackForStreamChanges(std::function<void()> callback)
 {
     m_streamsChangedCallback = callback;
@@ -125,6 +125,7 @@ public:
     void setFisheyeEnabled(bool fisheyeEnabled);
 
     virtual bool isBuffering() const override; //< From AbstractVideoDisplay & QnlTimeSource
+    virtual std::chrono::microseconds decodeDuration() const override; //< From AbstractVideoDisplay
 
     QnAspectRatio overridenAspectRatio() const;
     void setOverridenAspectRatio(QnAspectRatio aspectRatio);
@@ -150,6 +151,7 @@ public:
     // Forwarded to QnAbstractDataConsumer
     virtual int dataQueueSize() const override;
     virtual int maxDataQueueSize() const override;
+    virtual qint64 bitrateBitsPerSecond() const override;
 
     virtual void setCallbackForStreamChanges(std::function<void()> callback) override;
 
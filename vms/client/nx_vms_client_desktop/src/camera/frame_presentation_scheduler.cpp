@@ -0,0 +1,96 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "frame_presentation_scheduler.h"
+
+#include <algorithm>
+
+#include "buffered_frame_displayer.h"
+
+using namespace std::chrono;
+
+namespace {
+
+/**
+ * The refresh rate of the most displays. The frames are handed to the renderers on this grid,
+ * the renderers present them with the actual vertical sync.
+ */
+constexpr auto kRefreshInterval = microseconds(1'000'000 / 60);
+
+/** Wait limit when there are no frames to present, the new frames wake the thread up anyway. */
+constexpr auto kIdleWaitTime = milliseconds(100);
+
+} // namespace
+
+QnFramePresentationScheduler::QnFramePresentationScheduler():
+    m_refreshInterval(kRefreshInterval)
+{
+    setObjectName("FramePresentationScheduler");
+}
+
+QnFramePresentationScheduler::~QnFramePresentationScheduler()
+{
+    stop();
+}
+
+std::shared_ptr<QnFramePresentationScheduler> QnFramePresentationScheduler::instance()
+{
+    static nx::Mutex mutex;
+    static std::weak_ptr<QnFramePresentationScheduler> weakInstance;
+
+    NX_MUTEX_LOCKER lock(&mutex);
+    auto scheduler = weakInstance.lock();
+    if (!scheduler)
+    {
+        scheduler = std::make_shared<QnFramePresentationScheduler>();
+        scheduler->start();
+        weakInstance = scheduler;
+    }
+    return scheduler;
+}
+
+void QnFramePresentationScheduler::addDisplayer(QnBufferedFrameDisplayer* displayer)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_displayers.insert(displayer);
+    m_condition.wakeAll();
+}
+
+void QnFramePresentationScheduler::removeDisplayer(QnBufferedFrameDisplayer* displayer)
+{
+    // The displayers are processed under the mutex, so none of them is in use after it is locked.
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_displayers.erase(displayer);
+}
+
+void QnFramePresentationScheduler::wakeUp()
+{
+    // The mutex is released only while the thread is waiting, so the wake-up is never lost.
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_condition.wakeAll();
+}
+
+void QnFramePresentationScheduler::pleaseStop()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    base_type::pleaseStop();
+    m_condition.wakeAll();
+}
+
+void QnFramePresentationScheduler::run()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    while (!needToStop())
+    {
+        microseconds waitTime = kIdleWaitTime;
+        for (const auto displayer: m_displayers)
+        {
+            if (const auto timeToNextFrame = displayer->presentDueFrames(m_refreshInterval))
+                waitTime = std::min(waitTime, *timeToNextFrame);
+        }
+
+        // The next frame is due in the refresh interval after this wait.
+        const auto waitTimeMs = ceil<milliseconds>(waitTime);
+        if (waitTimeMs > milliseconds::zero())
+            m_condition.wait(&m_mutex, waitTimeMs);
+    }
+}
@@ -0,0 +1,53 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <set>
+
+#include <nx/utils/thread/long_runnable.h>
+#include <nx/utils/thread/mutex.h>
+
+class QnBufferedFrameDisplayer;
+
+/**
+ * Presents the buffered frames of all the displayers from a single thread.
+ *
+ * The thread sleeps until the nearest frame of any displayer is due, so the number of the
+ * wake-ups does not depend on the number of the displayed items. The due times are aligned to
+ * the display refresh grid: the frames which fall into the same refresh interval are presented
+ * together, in one wake-up.
+ */
+class QnFramePresentationScheduler: public QnLongRunnable
+{
+    using base_type = QnLongRunnable;
+
+public:
+    QnFramePresentationScheduler();
+    virtual ~QnFramePresentationScheduler() override;
+
+    /** The scheduler lives while it is referenced by the displayers. */
+    static std::shared_ptr<QnFramePresentationScheduler> instance();
+
+    void addDisplayer(QnBufferedFrameDisplayer* displayer);
+
+    /** When the function returns, the displayer is not accessed by the scheduler anymore. */
+    void removeDisplayer(QnBufferedFrameDisplayer* displayer);
+
+    /** Makes the scheduler re-check the displayers, e.g. when a frame is added to an empty one. */
+    void wakeUp();
+
+    std::chrono::microseconds refreshInterval() const { return m_refreshInterval; }
+
+    virtual void pleaseStop() override;
+
+protected:
+    virtual void run() override;
+
+private:
+    const std::chrono::microseconds m_refreshInterval;
+    nx::Mutex m_mutex;
+    nx::WaitCondition m_condition;
+    std::set<QnBufferedFrameDisplayer*> m_displayers;
+};
@@ -18,6 +18,7 @@
 #include <nx/pathkit/rhi_paint_engine.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/thread/mutex.h>
+#include <nx/utils/trace/trace.h>
 #include <nx/vms/client/core/utils/geometry.h>
 #include <nx/vms/client/desktop/opengl/opengl_renderer.h>
 #include <nx/vms/client/desktop/shaders/media_output_shader_data.h>
@@ -294,6 +295,8 @@ Qn::RenderStatus QnGLRenderer::renderBlurFBO(const QRectF &sourceRect)
 Qn::RenderStatus QnGLRenderer::paint(
     QPainter* painter, const QRectF &sourceRect, const QRectF &targetRect)
 {
+    NX_TRACE_CATEGORY_SCOPE("frame", "render");
+
     if (!m_gl)
     {
         if (!m_blurEnabled || qFuzzyEquals(m_blurFactor, 0.0))
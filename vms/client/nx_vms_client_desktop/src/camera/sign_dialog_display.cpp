@@ -6,6 +6,7 @@
 #include <core/resource/resource.h>
 #include <export/sign_helper.h>
 #include <nx/streaming/archive_stream_reader.h>
+#include <nx/streaming/read_ahead_archive_delegate.h>
 #include <utils/common/synctime.h>
 
 QnSignDialogDisplay::QnSignDialogDisplay(QnMediaResourcePtr resource):
@@ -29,7 +30,13 @@ void QnSignDialogDisplay::finalizeSign()
     QByteArray calculatedSign;
     if (m_reader)
     {
-        QnAviArchiveDelegate* aviFile = dynamic_cast<QnAviArchiveDelegate*> (m_reader->getArchiveDelegate());
+        auto archiveDelegate = m_reader->getArchiveDelegate();
+        if (const auto readAhead =
+            dynamic_cast<nx::streaming::ReadAheadArchiveDelegate*>(archiveDelegate))
+        {
+            archiveDelegate = readAhead->delegate();
+        }
+        QnAviArchiveDelegate* aviFile = dynamic_cast<QnAviArchiveDelegate*> (archiveDelegate);
         if (aviFile)
         {
             auto signPattern = aviFile->metadata()->signature;
@@ -2,6 +2,7 @@
 
 #include "video_stream_display.h"
 
+#include <QtCore/QJsonObject>
 #include <QtGui/QWindow>
 
 #include <algorithm>
@@ -21,9 +22,11 @@ extern "C" {
 #include <nx/media/ffmpeg/hw_video_decoder_old_player.h>
 #include <nx/media/supported_decoders.h>
 #include <nx/media/utils.h>
+#include <nx/utils/elapsed_timer.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/math/math.h>
 #include <nx/utils/thread/long_runnable.h>
+#include <nx/utils/trace/trace.h>
 #include <nx/vms/client/core/utils/video_cache.h>
 #include <nx/vms/client/desktop/application_context.h>
 #include <nx/vms/client/desktop/ini.h>
@@ -65,6 +68,9 @@ bool isIntel()
     return QnGlFunctions::openGLInfo().vendor.toLower().contains("intel");
 }
 
+/** The items with a smaller visible part skip the B-frames. */
+constexpr qreal kPartialVisibilityThreshold = 0.25;
+
 QnFrameScaler::DownscaleFactor findScaleFactor(int width, int height, int fitWidth, int fitHeight)
 {
     if (fitWidth * 8 <= width && fitHeight * 8 <= height)
@@ -516,7 +522,7 @@ QnAbstractVideoDecoder* QnVideoStreamDisplay::createVideoDecoder(
                 || appContext()->runtimeSettings()->isSoftwareYuv();
         decoder = new QnFfmpegVideoDecoder(config, /*metrics*/ nullptr, data);
     }
-    decoder->setLightCpuMode(m_decodeMode);
+    decoder->setLightCpuMode(effectiveDecodeMode());
     return decoder;
 }
 
@@ -620,6 +626,30 @@ QnVideoStreamDisplay::FrameDisplayStatus QnVideoStreamDisplay::display(
         m_prevReverseMode = reverseMode;
     }
 
+    const auto visibilityDecodeMode = reverseMode || ini().decodeAllFramesOfHiddenItems
+        ? QnAbstractVideoDecoder::DecodeMode_Full
+        : this->visibilityDecodeMode();
+    if (visibilityDecodeMode != m_visibilityDecodeMode)
+    {
+        NX_VERBOSE(this, "Channel %1 visibility decode mode: %2",
+            m_channelNumber, (int) visibilityDecodeMode);
+        m_visibilityDecodeMode = visibilityDecodeMode;
+
+        NX_MUTEX_LOCKER lock(&m_mtx);
+        if (m_decoderData.decoder)
+            m_decoderData.decoder->setLightCpuMode(effectiveDecodeMode());
+    }
+
+    // The hidden items decode the key frames only. The skipped frames break the references of
+    // the following ones, so the decoding is resumed from the next key frame.
+    if (data->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey))
+        m_waitingForKeyFrame = false;
+    else if (m_visibilityDecodeMode == QnAbstractVideoDecoder::DecodeMode_Fastest)
+        m_waitingForKeyFrame = true;
+
+    if (m_waitingForKeyFrame)
+        return Status_Skipped;
+
     QnAbstractVideoDecoder* dec = nullptr;
     {
         NX_MUTEX_LOCKER lock(&m_mtx);
@@ -680,7 +710,15 @@ QnVideoStreamDisplay::FrameDisplayStatus QnVideoStreamDisplay::display(
     decodedFrame->channel = data->channelNumber;
     decodedFrame->flags = {};
     double decoderSar = 1.0;
-    if (!dec->decode(data, &decodedFrame))
+    const nx::utils::BasicElapsedTimer<std::chrono::microseconds> decodeTimer(
+        nx::utils::ElapsedTimerState::started);
+    bool decoded = false;
+    {
+        NX_TRACE_CATEGORY_SCOPE("frame", "decode").args({{"timestamp", data->timestamp}});
+        decoded = dec->decode(data, &decodedFrame);
+    }
+    m_decodeDuration = m_decodeDuration.load() + decodeTimer.elapsed();
+    if (!decoded)
     {
         decoderSar = dec->getSampleAspectRatio();
         if (dec->getLastDecodeResult() < 0 && dec->hardwareDecoder())
@@ -691,7 +729,7 @@ QnVideoStreamDisplay::FrameDisplayStatus QnVideoStreamDisplay::display(
         }
 
         m_mtx.unlock();
-        if (m_decodeMode == QnAbstractVideoDecoder::DecodeMode_Fastest)
+        if (effectiveDecodeMode() == QnAbstractVideoDecoder::DecodeMode_Fastest)
             return Status_Skipped;
         if (!m_reverseQueue.isEmpty()
             && m_reverseQueue.front()->flags.testFlag(QnAbstractMediaData::MediaFlags_ReverseReordered))
@@ -923,6 +961,11 @@ bool QnVideoStreamDisplay::selfSyncUsed() const
     return m_bufferedFrameDisplayer != nullptr;
 }
 
+std::chrono::microseconds QnVideoStreamDisplay::decodeDuration() const
+{
+    return m_decodeDuration;
+}
+
 QnAspectRatio QnVideoStreamDisplay::overridenAspectRatio() const
 {
     return m_overridenAspectRatio;
@@ -976,7 +1019,30 @@ void QnVideoStreamDisplay::setLightCPUMode(QnAbstractVideoDecoder::DecodeMode va
     NX_MUTEX_LOCKER mutex( &m_mtx );
 
     if (m_decoderData.decoder)
-        m_decoderData.decoder->setLightCpuMode(val);
+        m_decoderData.decoder->setLightCpuMode(effectiveDecodeMode());
+}
+
+QnAbstractVideoDecoder::DecodeMode QnVideoStreamDisplay::visibilityDecodeMode() const
+{
+    // The display without renderers is used for the other purposes than showing the video.
+    if (m_renderList.empty())
+        return QnAbstractVideoDecoder::DecodeMode_Full;
+
+    qreal visibleFraction = 0.0;
+    for (const auto& renderer: m_renderList)
+        visibleFraction = std::max(visibleFraction, renderer->visibleFraction(m_channelNumber));
+
+    if (qFuzzyIsNull(visibleFraction))
+        return QnAbstractVideoDecoder::DecodeMode_Fastest;
+
+    return visibleFraction < kPartialVisibilityThreshold
+        ? QnAbstractVideoDecoder::DecodeMode_Fast
+        : QnAbstractVideoDecoder::DecodeMode_Full;
+}
+
+QnAbstractVideoDecoder::DecodeMode QnVideoStreamDisplay::effectiveDecodeMode() const
+{
+    return std::max(m_decodeMode, m_visibilityDecodeMode);
 }
 
 void QnVideoStreamDisplay::setMTDecoding(bool value)
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <optional>
 #include <set>
@@ -63,6 +64,9 @@ public:
     QSize getMaxScreenSize() const;
     bool selfSyncUsed() const;
 
+    /** Total time spent in the decoder. */
+    std::chrono::microseconds decodeDuration() const;
+
     QnAspectRatio overridenAspectRatio() const;
     void setOverridenAspectRatio(QnAspectRatio aspectRatio);
     void endOfRun();
@@ -107,6 +111,13 @@ private:
     QnMediaResourcePtr m_resource;
 
     QnAbstractVideoDecoder::DecodeMode m_decodeMode;
+
+    /** Decoding mode which depends on the visibility of the renderers on the screen. */
+    QnAbstractVideoDecoder::DecodeMode m_visibilityDecodeMode =
+        QnAbstractVideoDecoder::DecodeMode_Full;
+
+    /** Non-key frames were skipped, so the decoding is resumed from the next key frame. */
+    bool m_waitingForKeyFrame = false;
     bool m_canDownscale;
     const int m_channelNumber;
 
@@ -119,6 +130,7 @@ private:
     int m_outputHeight;
     std::atomic_bool m_mtDecoding = false;
     std::atomic_bool m_needReinitDecoders = false;
+    std::atomic<std::chrono::microseconds> m_decodeDuration{};
     bool m_reverseMode;
     bool m_prevReverseMode;
     QQueue<QSharedPointer<CLVideoDecoderOutput>> m_reverseQueue;
@@ -173,4 +185,9 @@ private:
         const CLConstVideoDecoderOutputPtr& src,
         CLVideoDecoderOutputPtr& dst,
         QnFrameScaler::DownscaleFactor forceScaleFactor);
+
+    QnAbstractVideoDecoder::DecodeMode visibilityDecodeMode() const;
+
+    /** The lightest of the requested and the visibility decoding modes. */
+    QnAbstractVideoDecoder::DecodeMode effectiveDecodeMode() const;
 };
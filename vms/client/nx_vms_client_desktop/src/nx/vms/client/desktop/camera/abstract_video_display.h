@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
 
 #include <nx/media/media_data_packet.h>
@@ -41,6 +42,11 @@ public:
 
     virtual bool isBuffering() const = 0;
 
+    /** Total time spent on decoding the video. Its growth rate is the decoding load. */
+    virtual std::chrono::microseconds decodeDuration() const = 0;
+
+    virtual qint64 bitrateBitsPerSecond() const = 0;
+
 // Cannot derive from QObject so cannot use signals.
     virtual void setCallbackForStreamChanges(std::function<void()> callback) = 0;
 };
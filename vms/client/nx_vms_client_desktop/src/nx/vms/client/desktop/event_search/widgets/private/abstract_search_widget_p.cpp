@@ -67,6 +67,12 @@ constexpr int kTextSearchTopMargin = 12;
 constexpr int kHeaderSideMargin = 8;
 
 constexpr milliseconds kQueuedFetchDataDelay = 50ms;
+
+/**
+ * The data is fetched in advance when the end of the fetched data in the scroll direction is
+ * closer than this number of pages, so the user doesn't wait for it at the end of the ribbon.
+ */
+constexpr qreal kPrefetchPageCount = 1.5;
 constexpr milliseconds kTextFilterDelay = 250ms;
 
 constexpr milliseconds kPlaceholderFadeDuration = 150ms;
@@ -343,8 +349,16 @@ void AbstractSearchWidget::Private::setupRibbon()
     setupViewportHeader();
 
     connect(ui->ribbon->scrollBar(), &QScrollBar::valueChanged, this,
-        [this]()
+        [this](int value)
         {
+            if (value != m_lastScrollValue)
+            {
+                m_scrollDirection = value > m_lastScrollValue
+                    ? FetchDirection::older
+                    : FetchDirection::newer;
+                m_lastScrollValue = value;
+            }
+
             if (!m_skipFetchOnScrollChange)
                 executeLater([this]() { requestFetchIfNeeded(); }, this);
         });
@@ -832,7 +846,19 @@ std::optional<FetchDirection> AbstractSearchWidget::Private::getFetchDirection()
     if (scrollBar->value() == scrollBar->minimum())
         return FetchDirection::newer;
 
-    return {}; //< Scroll bar is not at the beginning nor the end.
+    // The fetched window is limited by the model, so the prefetch only shifts it a bit earlier.
+    const int prefetchDistance = qRound(scrollBar->pageStep() * kPrefetchPageCount);
+    if (m_scrollDirection == FetchDirection::older)
+    {
+        if (scrollBar->maximum() - scrollBar->value() < prefetchDistance)
+            return FetchDirection::older;
+    }
+    else if (scrollBar->value() - scrollBar->minimum() < prefetchDistance)
+    {
+        return FetchDirection::newer;
+    }
+
+    return {}; //< Scroll bar is far from the end in the scroll direction.
 }
 
 void AbstractSearchWidget::Private::requestFetchIfNeeded()
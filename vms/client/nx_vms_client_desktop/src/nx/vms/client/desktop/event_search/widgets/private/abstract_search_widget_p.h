@@ -152,6 +152,9 @@ private:
 
     Controls m_relevantControls = Control::defaults;
     bool m_skipFetchOnScrollChange = false;
+
+    int m_lastScrollValue = 0;
+    core::EventSearch::FetchDirection m_scrollDirection = core::EventSearch::FetchDirection::older;
 };
 
 } // namespace nx::vms::client::desktop
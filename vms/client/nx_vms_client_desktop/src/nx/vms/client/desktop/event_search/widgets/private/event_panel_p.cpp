@@ -174,8 +174,7 @@ EventPanel::Private::Private(EventPanel* q):
     QObject(q),
     WindowContextAware(q),
     q(q),
-    m_callAlarmManager(new CallAlarmManager(windowContext())),
-    m_tooltip(new ThumbnailTooltip(q->windowContext()))
+    m_callAlarmManager(new CallAlarmManager(windowContext()))
 {
     auto compactTabBar = new CompactTabBar();
     compactTabBar->setCustomTabEnabledFunction(
@@ -560,7 +559,8 @@ void EventPanel::Private::at_eventTileHovered(const QModelIndex& index, EventTil
 
     if (!tile || !index.isValid() || (Qt::NoButton != QApplication::mouseButtons()))
     {
-        m_tooltip->hide();
+        if (m_tooltip)
+            m_tooltip->hide();
         return;
     }
 
@@ -572,12 +572,17 @@ void EventPanel::Private::at_eventTileHovered(const QModelIndex& index, EventTil
         text = tile->title();
     if (text.isEmpty())
     {
-        m_tooltip->hide();
+        if (m_tooltip)
+            m_tooltip->hide();
         return;
     }
 
     m_lastHoveredTile = tile;
 
+    // The tooltip loads its QML component, so it is not created until the first use.
+    if (!m_tooltip)
+        m_tooltip = std::make_unique<ThumbnailTooltip>(windowContext());
+
     m_tooltip->setText(text);
     m_tooltip->setImageProvider(imageProvider);
     m_tooltip->setHighlightRect(tile->previewHighlightRect());
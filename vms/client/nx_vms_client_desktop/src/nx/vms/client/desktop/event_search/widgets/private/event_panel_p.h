@@ -89,6 +89,7 @@ private:
     std::unique_ptr<CallAlarmManager> m_callAlarmManager;
     QPointer<NotificationBellWidget> m_notificationBellWidget;
 
+    /** Created on the first hover. */
     std::unique_ptr<ThumbnailTooltip> m_tooltip;
 
     // Required to correctly display tooltip.
@@ -2,8 +2,14 @@
 
 #include "export_layout_tool.h"
 
+#include <list>
+#include <numeric>
+
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QBuffer>
 #include <QtCore/QEventLoop>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QTemporaryDir>
 #include <QtCore/QTimer>
 
 #include <camera/camera_data_manager.h>
@@ -25,6 +31,7 @@
 #include <nx/vms/client/core/resource/data_loaders/caching_camera_data_loader.h>
 #include <nx/vms/client/desktop/application_context.h>
 #include <nx/vms/client/desktop/export/data/nov_metadata.h>
+#include <nx/vms/client/desktop/ini.h>
 #include <nx/vms/client/desktop/resource/layout_password_management.h>
 #include <nx/vms/client/desktop/resource/layout_resource.h>
 #include <nx/vms/client/desktop/resource/resource_descriptor.h>
@@ -46,6 +53,33 @@ namespace {
 
 const int kFileOperationRetries = 3;
 const int kFileOperationRetryDelayMs = 500;
+const qint64 kCopyBufferSize = 1024 * 1024;
+
+/** The extension the recorder appends to the file name for the "mkv" container. */
+const QString kMediaFileExtension = ".mkv";
+
+bool copyFileToStorage(
+    const QString& sourcePath,
+    const QnStorageResourcePtr& storage,
+    const QString& fileName)
+{
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly))
+        return false;
+
+    QIODevicePtr target(storage->open(fileName, QIODevice::WriteOnly));
+    if (!target)
+        return false;
+
+    QByteArray buffer(kCopyBufferSize, Qt::Uninitialized);
+    while (!source.atEnd())
+    {
+        const qint64 size = source.read(buffer.data(), buffer.size());
+        if (size < 0 || target->write(buffer.constData(), size) != size)
+            return false;
+    }
+    return true;
+}
 
 QString fileNameForResource(const QnResourcePtr& resource)
 {
@@ -87,6 +121,38 @@ struct ExportLayoutTool::Private
     /** Copy of the provided layout. */
     LayoutResourcePtr layout;
 
+    struct CameraExport
+    {
+        std::unique_ptr<QnClientVideoCamera> camera;
+
+        /** Index of the camera in the export order, used for the progress. */
+        int index = 0;
+
+        /**
+         * Path of the temporary file without the extension. Empty if the camera is exported
+         * into the layout file directly.
+         */
+        QString temporaryFileName;
+    };
+
+    /** Cameras which are being exported. */
+    std::list<CameraExport> cameraExports;
+
+    /** Cameras exported into the temporary files, which are not written to the layout yet. */
+    std::list<CameraExport> camerasToWrite;
+
+    int startedCameraCount = 0;
+    std::vector<int> progressByCamera;
+
+    /**
+     * The layout file has a single writer: either a camera exported into it directly, or the
+     * copying of a camera exported into a temporary file.
+     */
+    bool layoutFileBusy = false;
+
+    std::unique_ptr<QTemporaryDir> temporaryDir;
+    QFutureWatcher<bool> writer;
+
     explicit Private(ExportLayoutTool* owner, const ExportLayoutSettings& settings):
         q(owner),
         settings(settings),
@@ -103,7 +169,23 @@ struct ExportLayoutTool::Private
         NX_ASSERT(status == ExportProcessStatus::exporting);
         setStatus(ExportProcessStatus::cancelling);
         resources.clear();
+    }
 
+    bool ensureTemporaryDir()
+    {
+        if (!temporaryDir)
+        {
+            temporaryDir = std::make_unique<QTemporaryDir>();
+            if (!temporaryDir->isValid())
+                NX_WARNING(q, "Unable to create a temporary directory, exporting sequentially");
+        }
+        return temporaryDir->isValid();
+    }
+
+    void emitProgress()
+    {
+        emit q->valueChanged(
+            std::accumulate(progressByCamera.cbegin(), progressByCamera.cend(), 0));
     }
 
     void setStatus(ExportProcessStatus value)
@@ -166,10 +248,14 @@ ExportLayoutTool::ExportLayoutTool(
 
     m_isExportToExe = nx::build_info::isWindows()
         && FileExtensionUtils::isExecutable(d->settings.fileName.extension);
+
+    connect(&d->writer, &QFutureWatcher<bool>::finished,
+        this, &ExportLayoutTool::at_writer_finished);
 }
 
 ExportLayoutTool::~ExportLayoutTool()
 {
+    d->writer.waitForFinished();
 }
 
 bool ExportLayoutTool::prepareStorage()
@@ -443,19 +529,16 @@ bool ExportLayoutTool::start()
         return false;
     }
 
+    d->progressByCamera.assign(d->resources.size(), 0);
     emit rangeChanged(0, d->resources.size() * 100);
     emit valueChanged(0);
     d->setStatus(ExportProcessStatus::exporting);
-    return exportNextCamera();
+    return exportNextCameras();
 }
 
 void ExportLayoutTool::stop()
 {
     d->cancelExport();
-
-    if (m_currentCamera)
-        m_currentCamera->stopExport();
-
     finishExport(false);
 }
 
@@ -474,47 +557,93 @@ ExportProcessStatus ExportLayoutTool::processStatus() const
     return d->status;
 }
 
-bool ExportLayoutTool::exportNextCamera()
+bool ExportLayoutTool::exportNextCameras()
 {
     if (d->status != ExportProcessStatus::exporting)
         return false;
 
-    if (d->resources.isEmpty())
+    // The cameras are downloaded and transcoded in parallel. Only one of them is written into
+    // the layout file directly, the others are exported into the temporary files first.
+    const int maxCameraExports = std::max(1, ini().layoutExportParallelCameras);
+    while (!d->resources.isEmpty() && (int) d->cameraExports.size() < maxCameraExports)
     {
-        if (d->exportedAnyData)
-        {
-            finishExport(true);
-        }
-        else
-        {
-            d->lastError = ExportProcessError::dataNotFound;
-            finishExport(false);
-        }
-        return false;
+        if (d->layoutFileBusy && !d->ensureTemporaryDir())
+            break;
+
+        exportMediaResource(d->resources.dequeue());
     }
 
-    m_offset++;
-    return exportMediaResource(d->resources.dequeue());
+    if (!d->resources.isEmpty() || !d->cameraExports.empty() || !d->camerasToWrite.empty())
+        return true;
+
+    if (d->exportedAnyData)
+    {
+        finishExport(true);
+    }
+    else
+    {
+        d->lastError = ExportProcessError::dataNotFound;
+        finishExport(false);
+    }
+    return false;
+}
+
+void ExportLayoutTool::writeNextCamera()
+{
+    if (d->layoutFileBusy || d->camerasToWrite.empty())
+        return;
+
+    d->layoutFileBusy = true;
+    const QString sourcePath = d->camerasToWrite.front().temporaryFileName + kMediaFileExtension;
+    const QString fileName = QFileInfo(sourcePath).fileName();
+    d->writer.setFuture(QtConcurrent::run(
+        [storage = d->storage, sourcePath, fileName]()
+        {
+            return copyFileToStorage(sourcePath, storage, fileName);
+        }));
+}
+
+void ExportLayoutTool::stopCameraExports()
+{
+    // Stopping may notify synchronously, so the exports are detached first.
+    const auto cameraExports = std::move(d->cameraExports);
+    d->cameraExports.clear();
+    for (const auto& cameraExport: cameraExports)
+        cameraExport.camera->stopExport();
+
+    d->writer.waitForFinished();
+    d->camerasToWrite.clear();
+    d->temporaryDir.reset();
+    d->layoutFileBusy = false;
 }
 
 void ExportLayoutTool::finishExport(bool /*success*/)
 {
+    stopCameraExports();
     d->finishExport();
 }
 
-bool ExportLayoutTool::exportMediaResource(const QnMediaResourcePtr& resource)
+void ExportLayoutTool::exportMediaResource(const QnMediaResourcePtr& resource)
 {
-    m_currentCamera.reset(new QnClientVideoCamera(resource));
-    connect(m_currentCamera.get(), SIGNAL(exportProgress(int)), this, SLOT(at_camera_progressChanged(int)));
-    connect(m_currentCamera.get(), &QnClientVideoCamera::exportFinished, this,
-        &ExportLayoutTool::at_camera_exportFinished);
+    auto& cameraExport = d->cameraExports.emplace_back();
+    cameraExport.index = d->startedCameraCount++;
+    cameraExport.camera = std::make_unique<QnClientVideoCamera>(resource);
+
+    const auto camera = cameraExport.camera.get();
+    connect(camera, &QnClientVideoCamera::exportProgress, this,
+        [this, camera](int progress) { at_camera_progressChanged(camera, progress); });
+    connect(camera, &QnClientVideoCamera::exportFinished, this,
+        [this, camera](const std::optional<nx::recording::Error>& status)
+        {
+            at_camera_exportFinished(camera, status);
+        });
 
     int numberOfChannels = resource->getVideoLayout()->channelCount();
     for (int i = 0; i < numberOfChannels; ++i)
     {
         QSharedPointer<QBuffer> motionFileBuffer(new QBuffer());
         motionFileBuffer->open(QIODevice::ReadWrite);
-        m_currentCamera->setMotionIODevice(motionFileBuffer, i);
+        camera->setMotionIODevice(motionFileBuffer, i);
     }
 
     QString uniqId = fileNameForResource(resource);
@@ -526,28 +655,63 @@ bool ExportLayoutTool::exportMediaResource(const QnMediaResourcePtr& resource)
             playbackMask.includeTimePeriod({bookmark.startTimeMs, bookmark.durationMs});
     }
 
-    m_currentCamera->exportMediaPeriodToFile(d->settings.period,
-        uniqId,
+    QnStorageResourcePtr storage = d->storage;
+    QString fileName = uniqId;
+    if (d->layoutFileBusy)
+    {
+        cameraExport.temporaryFileName = d->temporaryDir->filePath(uniqId);
+        fileName = cameraExport.temporaryFileName;
+        storage.reset(); //< The recorder writes to a plain file.
+    }
+    else
+    {
+        d->layoutFileBusy = true;
+    }
+
+    NX_VERBOSE(this, "Exporting %1 to %2", resource, fileName);
+
+    camera->exportMediaPeriodToFile(d->settings.period,
+        fileName,
         "mkv",
-        d->storage,
+        storage,
         timeZone(resource),
         d->settings.transcodingSettings,
         playbackMask);
-
-    return true;
 }
 
-void ExportLayoutTool::at_camera_exportFinished(const std::optional<nx::recording::Error>& status,
-    const QString& /*filename*/)
+void ExportLayoutTool::at_camera_exportFinished(QnClientVideoCamera* camera,
+    const std::optional<nx::recording::Error>& status)
 {
-    if (d->status == ExportProcessStatus::cancelled)
+    if (d->status != ExportProcessStatus::exporting)
         return;
 
+    const auto cameraExportItr = std::find_if(
+        d->cameraExports.begin(), d->cameraExports.end(),
+        [camera](const auto& cameraExport) { return cameraExport.camera.get() == camera; });
+    if (cameraExportItr == d->cameraExports.end())
+        return;
+
+    auto cameraExport = std::move(*cameraExportItr);
+    d->cameraExports.erase(cameraExportItr);
+
+    // The camera is not deleted from its own signal handler.
+    const auto deleteCamera =
+        [&cameraExport]() { cameraExport.camera.release()->deleteLater(); };
+
+    const bool exportedDirectly = cameraExport.temporaryFileName.isEmpty();
+    if (exportedDirectly)
+        d->layoutFileBusy = false;
+
+    d->progressByCamera[cameraExport.index] = 100;
+    d->emitProgress();
+
     d->lastError = convertError(status);
     if (d->lastError == ExportProcessError::dataNotFound)
     {
         d->lastError = ExportProcessError::noError;
-        exportNextCamera();
+        deleteCamera();
+        writeNextCamera();
+        exportNextCameras();
         return;
     }
 
@@ -555,46 +719,76 @@ void ExportLayoutTool::at_camera_exportFinished(const std::optional<nx::recordin
 
     if (d->lastError != ExportProcessError::noError)
     {
+        deleteCamera();
         finishExport(false);
         return;
     }
 
-    auto camera = dynamic_cast<QnClientVideoCamera*>(sender());
-    if (!camera)
+    if (exportedDirectly)
+    {
+        writeMotionData(camera);
+        deleteCamera();
+    }
+    else
+    {
+        d->camerasToWrite.push_back(std::move(cameraExport));
+    }
+
+    writeNextCamera();
+    exportNextCameras();
+}
+
+void ExportLayoutTool::at_writer_finished()
+{
+    if (d->status != ExportProcessStatus::exporting || !NX_ASSERT(!d->camerasToWrite.empty()))
         return;
 
-    int numberOfChannels = camera->resource()->getVideoLayout()->channelCount();
-    bool error = false;
+    auto cameraExport = std::move(d->camerasToWrite.front());
+    d->camerasToWrite.pop_front();
+    d->layoutFileBusy = false;
+    QFile::remove(cameraExport.temporaryFileName + kMediaFileExtension);
+
+    if (!d->writer.result())
+    {
+        NX_WARNING(this, "Unable to write %1 to the layout file",
+            cameraExport.camera->resource());
+        d->lastError = ExportProcessError::fileAccess;
+        finishExport(false);
+        return;
+    }
+
+    writeMotionData(cameraExport.camera.get());
+
+    writeNextCamera();
+    exportNextCameras();
+}
 
+void ExportLayoutTool::writeMotionData(QnClientVideoCamera* camera)
+{
+    int numberOfChannels = camera->resource()->getVideoLayout()->channelCount();
     for (int i = 0; i < numberOfChannels; ++i)
     {
         if (QSharedPointer<QBuffer> motionFileBuffer = camera->motionIODevice(i))
         {
             motionFileBuffer->close();
-            if (error)
-                continue;
-
             QString uniqId = fileNameForResource(camera->resource());
             QString motionFileName = lit("motion%1_%2.bin").arg(i).arg(uniqId);
-            /* Other buffers must be closed even in case of error. */
             writeData(motionFileName, motionFileBuffer->buffer());
         }
     }
-
-    if (error)
-    {
-        d->lastError = ExportProcessError::unsupportedMedia;
-        finishExport(false);
-    }
-    else
-    {
-        exportNextCamera();
-    }
 }
 
-void ExportLayoutTool::at_camera_progressChanged(int progress)
+void ExportLayoutTool::at_camera_progressChanged(QnClientVideoCamera* camera, int progress)
 {
-    emit valueChanged(m_offset * 100 + progress);
+    for (const auto& cameraExport: d->cameraExports)
+    {
+        if (cameraExport.camera.get() == camera)
+        {
+            d->progressByCamera[cameraExport.index] = progress;
+            d->emitProgress();
+            return;
+        }
+    }
 }
 
 bool ExportLayoutTool::tryInLoop(std::function<bool()> handler)
@@ -45,12 +45,13 @@ public:
     virtual ExportProcessError lastError() const override;
     virtual ExportProcessStatus processStatus() const override;
 
-private slots:
-    bool exportMediaResource(const QnMediaResourcePtr& resource);
+private:
+    void exportMediaResource(const QnMediaResourcePtr& resource);
 
-    void at_camera_progressChanged(int progress);
-    void at_camera_exportFinished(const std::optional<nx::recording::Error>& status,
-        const QString& filename);
+    void at_camera_progressChanged(QnClientVideoCamera* camera, int progress);
+    void at_camera_exportFinished(QnClientVideoCamera* camera,
+        const std::optional<nx::recording::Error>& status);
+    void at_writer_finished();
 
 private:
     /** Create and setup storage resource. */
@@ -62,7 +63,10 @@ private:
     /** Write metadata to storage file. */
     bool exportMetadata(const NovMetadata& metadata);
 
-    bool exportNextCamera();
+    bool exportNextCameras();
+    void writeNextCamera();
+    void writeMotionData(QnClientVideoCamera* camera);
+    void stopCameraExports();
     void finishExport(bool success);
 
     bool tryInLoop(std::function<bool()> handler);
@@ -72,11 +76,6 @@ private:
     struct Private;
     QScopedPointer<Private> d;
 
-    /** Stage field, used to show correct progress in multi-video layout. */
-    int m_offset = -1;
-
-    QScopedPointer<QnClientVideoCamera> m_currentCamera;
-
     bool m_isExportToExe = false;
 };
 
@@ -16,6 +16,7 @@
 #include <nx/vms/client/desktop/system_context.h>
 #include <nx/vms/common/system_settings.h>
 #include <recording/helpers/recording_context_helpers.h>
+#include <transcoding/transcoding_ini.h>
 #include <transcoding/transcoding_utils.h>
 
 namespace nx::vms::client::desktop {
@@ -233,6 +234,9 @@ CodecParametersPtr ExportStorageStreamRecorder::getVideoCodecParameters(
         if (m_transcoderFixedFrameRate)
             config.fixedFrameRate = m_transcoderFixedFrameRate;
         config.params = suggestMediaStreamParams(m_dstVideoCodec, m_transcodeQuality);
+        config.hardwareEncoders =
+            nx::transcoding::hwEncoderBackends(nx::transcoding::ini().hardwareEncoders);
+        config.useHardwareDecoder = nx::transcoding::ini().hardwareDecoding;
 
         m_videoTranscoder = std::make_unique<QnFfmpegVideoTranscoder>(
             config,
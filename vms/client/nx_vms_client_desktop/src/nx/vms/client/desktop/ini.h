@@ -128,6 +128,11 @@ struct NX_VMS_CLIENT_DESKTOP_API Ini: nx::kit::IniConfig
     NX_INI_FLAG(0, disableVideoRendering,
         "[Dev] Completely disable video rendering to simplify memory leaks detection.");
 
+    NX_INI_FLAG(0, decodeAllFramesOfHiddenItems,
+        "[Support] Decode all video frames of the items which are not visible on the screen. By "
+        "default such items decode the key frames only, and the items with a small visible part "
+        "skip the B-frames.");
+
     NX_INI_FLAG(0, disableChunksLoading,
         "[Dev] Completely disable camera chunks loading to simplify memory leaks detection.");
 
@@ -405,6 +410,10 @@ struct NX_VMS_CLIENT_DESKTOP_API Ini: nx::kit::IniConfig
     NX_INI_FLAG(true, ignoreTimelineGaps,
         "[Support] Ignores timeline gaps when exporting media data");
 
+    NX_INI_INT(4, layoutExportParallelCameras,
+        "[Support] Number of cameras exported at once when a layout is exported. Set 1 to export\n"
+        "the cameras one by one.");
+
     // VMS-36585.
     NX_INI_INT(60, resourcePreviewRefreshInterval,
         "[Support] How often Resource Tree thumbnails request updates from non-ARM servers,\n"
@@ -457,6 +466,28 @@ struct NX_VMS_CLIENT_DESKTOP_API Ini: nx::kit::IniConfig
         "[Support] Radass should lower item quality if CPU usage is critically high for this "
         "period of time (in milliseconds).");
 
+    NX_INI_FLOAT(0.75f, radassDecodingBudget,
+        "[Support] Share of all CPU cores which the video decoding may take. Radass lowers one "
+        "item quality if the measured decoding load exceeds it. 0 disables the limit. "
+        "Range: [0, 1].");
+
+    NX_INI_INT(0, radassBandwidthBudgetMbps,
+        "[Support] Total bitrate of the received video streams (in megabits per second) above "
+        "which Radass lowers one item quality. 0 disables the limit.");
+
+    NX_INI_INT(2000, showreelPrefetchLeadTimeMs,
+        "[Support] Showreel opens the streams of the next layout items this long (in "
+        "milliseconds) before the switch. 0 disables the prefetching.");
+
+    NX_INI_INT(16, showreelPrefetchMaxItems,
+        "[Support] Maximum number of the next Showreel layout items whose streams are opened in "
+        "advance. It limits the extra bandwidth and the number of the simultaneous streams.");
+
+    NX_INI_STRING("auto", screenRecordingHardwareEncoders,
+        "[Support] Comma-separated hardware video encoder backends which the screen recording "
+        "tries before the software encoder, in the order of preference: vaapi, qsv, nvenc. "
+        "\"auto\" tries all of them, an empty value disables the hardware encoding.");
+
     NX_INI_FLAG(false, showBorderInVideoWallMode,
         "[Support] Show window border in Video Wall mode to workaround graphics drivers issues.");
 
@@ -2,6 +2,8 @@
 
 #include "radass_controller.h"
 
+#include <QtCore/QThread>
+
 #include <client/client_runtime_settings.h>
 #include <nx/fusion/serialization/lexical_functions.h>
 #include <nx/utils/guarded_callback.h>
@@ -105,6 +107,7 @@ enum class LqReason
     performanceInFf,
     tooManyItems,
     cpuUsage,
+    resourceBudget,
     manual,
 };
 
@@ -134,6 +137,12 @@ struct ConsumerInfo
     /** Previous mode for scenario when support is disabled and then enabled again. */
     Mode previousMode = Mode::Auto;
 
+    /** Decoding duration at the last resource usage measurement. */
+    microseconds decodeDuration{0};
+
+    /** Measured decoding load in CPU cores. */
+    double decodingLoad = 0.0;
+
     // Required for std::vector resize.
     ConsumerInfo() = default;
 
@@ -142,6 +151,7 @@ struct ConsumerInfo
         initialTime(timerFactory->createElapsedTimer()),
         awaitingLqTime(timerFactory->createElapsedTimer()),
         itemIsSmallInHq(timerFactory->createElapsedTimer()),
+        decodeDuration(display->decodeDuration()),
         m_name(display->getName())
     {
         initialTime->start();
@@ -197,6 +207,16 @@ struct RadassController::Private
     bool considerOverallCpuUsage = false;
     TimerPtr overallCpuUsageModeTimer;
 
+    RadassController::ResourceBudget resourceBudget;
+    ElapsedTimerPtr resourceUsageTimer;
+
+    /** Timer started when the resource budget is exceeded. Reset when the usage drops. */
+    ElapsedTimerPtr resourceBudgetIssueTimer;
+
+    /** Total decoding load of all the items in CPU cores. */
+    double decodingLoad = 0.0;
+    qint64 bitrateBitsPerSecond = 0;
+
     Private(RadassController* owner, const TimerFactoryPtr& timerFactory):
         q(owner),
         mutex(nx::Mutex::Recursive),
@@ -205,11 +225,17 @@ struct RadassController::Private
         lastSystemRtspDrop(timerFactory->createElapsedTimer()),
         lastModeChangeTimer(timerFactory->createElapsedTimer()),
         cpuIssueTimer(timerFactory->createElapsedTimer()),
-        overallCpuUsageModeTimer(timerFactory->createTimer())
+        overallCpuUsageModeTimer(timerFactory->createTimer()),
+        resourceUsageTimer(timerFactory->createElapsedTimer()),
+        resourceBudgetIssueTimer(timerFactory->createElapsedTimer())
     {
         this->timerFactory = timerFactory;
         lastAutoSwitchTimer->start();
         lastModeChangeTimer->start();
+        resourceUsageTimer->start();
+
+        resourceBudget.decodingCores = ini().radassDecodingBudget * QThread::idealThreadCount();
+        resourceBudget.bitrateBitsPerSecond = ini().radassBandwidthBudgetMbps * 1'000'000LL;
 
         QObject::connect(mainTimer.get(), &AbstractTimer::timeout, q, &RadassController::onTimer);
         mainTimer->start(kTimerInterval);
@@ -297,6 +323,59 @@ struct RadassController::Private
         return result;
     }
 
+    /** Measures the decoding load and the bitrate of the items. */
+    void updateResourceUsage()
+    {
+        if (!resourceUsageTimer->hasExpired(kResourceUsageInterval))
+            return;
+
+        const duration<double> elapsed = resourceUsageTimer->restart();
+        decodingLoad = 0.0;
+        bitrateBitsPerSecond = 0;
+        for (auto& consumer: consumers)
+        {
+            const auto decodeDuration = consumer.display->decodeDuration();
+            consumer.decodingLoad = std::max(0.0,
+                duration<double>(decodeDuration - consumer.decodeDuration) / elapsed);
+            consumer.decodeDuration = decodeDuration;
+
+            decodingLoad += consumer.decodingLoad;
+            bitrateBitsPerSecond += consumer.display->bitrateBitsPerSecond();
+        }
+
+        NX_VERBOSE(this, "Resource usage: decoding %1 cores of %2, bitrate %3 bps of %4",
+            decodingLoad, resourceBudget.decodingCores,
+            bitrateBitsPerSecond, resourceBudget.bitrateBitsPerSecond);
+    }
+
+    bool resourceBudgetIsExceeded() const
+    {
+        return (resourceBudget.decodingCores > 0 && decodingLoad > resourceBudget.decodingCores)
+            || (resourceBudget.bitrateBitsPerSecond > 0
+                && bitrateBitsPerSecond > resourceBudget.bitrateBitsPerSecond);
+    }
+
+    /**
+     * Whether the estimated resource usage stays within the budget with some margin after the
+     * consumer goes to HQ. The margin keeps the items from switching back and forth.
+     */
+    bool resourceBudgetAllowsHighQuality(const ConsumerInfo& consumer) const
+    {
+        const double extraDecodingLoad = consumer.decodingLoad * (kHqToLqCostRatio - 1);
+        if (resourceBudget.decodingCores > 0
+            && decodingLoad + extraDecodingLoad
+                > resourceBudget.decodingCores * kResourceBudgetRaiseThreshold)
+        {
+            return false;
+        }
+
+        const double extraBitrate =
+            consumer.display->bitrateBitsPerSecond() * (kHqToLqCostRatio - 1);
+        return resourceBudget.bitrateBitsPerSecond <= 0
+            || bitrateBitsPerSecond + extraBitrate
+                <= resourceBudget.bitrateBitsPerSecond * kResourceBudgetRaiseThreshold;
+    }
+
     using SearchCondition = std::function<bool(AbstractVideoDisplay*)>;
     Consumer findConsumer(FindMethod method,
         MediaQuality findQuality,
@@ -386,6 +465,8 @@ struct RadassController::Private
                         return "tooManyItems";
                     case LqReason::cpuUsage:
                         return "cpuUsage";
+                    case LqReason::resourceBudget:
+                        return "resourceBudget";
                     case LqReason::manual:
                         return "manual";
                     default:
@@ -676,6 +757,12 @@ struct RadassController::Private
             return;
         }
 
+        if (!resourceBudgetAllowsHighQuality(*consumer))
+        {
+            NX_VERBOSE(this, "%1 in HQ would exceed the resource budget", *consumer);
+            return;
+        }
+
         // If item go to LQ because of small, return to HQ without delay.
         if (consumer->lqReason == LqReason::smallItem)
         {
@@ -819,6 +906,50 @@ struct RadassController::Private
         }
     }
 
+    /**
+     * Check whether the measured decoding load or bitrate exceeds the budget for some time and
+     * lower item quality in this case.
+     */
+    void optimizeItemsQualityByResourceBudget()
+    {
+        if (!resourceBudgetIsExceeded())
+        {
+            if (resourceBudgetIssueTimer->isValid())
+                NX_VERBOSE(this, "Resource usage is back within the budget");
+            resourceBudgetIssueTimer->invalidate();
+            return;
+        }
+
+        if (!resourceBudgetIssueTimer->isValid())
+        {
+            NX_VERBOSE(this, "Resource budget is exceeded, starting timer");
+            resourceBudgetIssueTimer->restart();
+        }
+
+        if (!resourceBudgetIssueTimer->hasExpired(kResourceBudgetExceededInterval))
+            return;
+
+        // Do not go to LQ if recently switch occurred.
+        if (!lastAutoSwitchTimer->hasExpired(kQualitySwitchInterval))
+            return;
+
+        const auto smallestConsumer = findConsumer(
+            FindMethod::Smallest,
+            MEDIA_Quality_High,
+            itemQualityCanBeLowered);
+        if (!isValid(smallestConsumer))
+        {
+            NX_VERBOSE(this, "Cannot find an item to lower its quality.");
+            return;
+        }
+
+        NX_VERBOSE(this, "Resource budget is exceeded for some time, %1 goes to LQ",
+            *smallestConsumer);
+        gotoLowQuality(smallestConsumer, LqReason::resourceBudget);
+        lastAutoSwitchTimer->restart();
+        resourceBudgetIssueTimer->restart();
+    }
+
     void adaptToConsumerChanges(AbstractVideoDisplay* display)
     {
         auto consumer = findByDisplay(display);
@@ -902,6 +1033,8 @@ void RadassController::onTimer()
         }
     }
 
+    d->updateResourceUsage();
+
     for (auto consumer = d->consumers.begin(); consumer != d->consumers.end(); ++consumer)
     {
         switch (consumer->mode)
@@ -936,6 +1069,7 @@ void RadassController::onTimer()
 
     d->optimizeItemsQualityBySize();
     d->optimizeItemsQualityByCpuUsage();
+    d->optimizeItemsQualityByResourceBudget();
 
     if (d->lastModeChangeTimer->hasExpired(kPerformanceLossCheckInterval))
     {
@@ -998,6 +1132,18 @@ void RadassController::unregisterConsumer(AbstractVideoDisplay* display)
         d->cameras.remove(camera);
 }
 
+RadassController::ResourceBudget RadassController::resourceBudget() const
+{
+    NX_MUTEX_LOCKER lock(&d->mutex);
+    return d->resourceBudget;
+}
+
+void RadassController::setResourceBudget(const ResourceBudget& value)
+{
+    NX_MUTEX_LOCKER lock(&d->mutex);
+    d->resourceBudget = value;
+}
+
 RadassMode RadassController::mode(AbstractVideoDisplay* display) const
 {
     NX_MUTEX_LOCKER lock(&d->mutex);
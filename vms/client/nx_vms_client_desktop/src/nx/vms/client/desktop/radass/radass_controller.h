@@ -29,6 +29,19 @@ public:
     RadassMode mode(AbstractVideoDisplay* display) const;
     void setMode(AbstractVideoDisplay* display, RadassMode mode);
 
+    /** Limits of the resources taken by all the items together. Zero values mean no limit. */
+    struct ResourceBudget
+    {
+        /** Number of CPU cores the video decoding may take. */
+        double decodingCores = 0.0;
+
+        qint64 bitrateBitsPerSecond = 0;
+    };
+
+    /** The default budget is set by the ini config. */
+    ResourceBudget resourceBudget() const;
+    void setResourceBudget(const ResourceBudget& value);
+
 signals:
     void performanceCanBeImproved();
 
@@ -52,6 +52,18 @@ static constexpr int kSlowNetworkFrameLimit = 3;
 // Item will go to LQ if it is small for this period of time already.
 static constexpr auto kLowerSmallItemQualityInterval = 1s;
 
+// Measure the decoding load and the bitrate of the items over this period.
+static constexpr auto kResourceUsageInterval = 2s;
+
+// Lower item quality if the resource budget is exceeded for this period of time.
+static constexpr auto kResourceBudgetExceededInterval = 5s;
+
+// Raise item quality only if the estimated resource usage stays below this part of the budget.
+static constexpr double kResourceBudgetRaiseThreshold = 0.8;
+
+// Estimated ratio of the decoding load and the bitrate of the high and low quality streams.
+static constexpr double kHqToLqCostRatio = 4.0;
+
 static constexpr int kAutomaticSpeed = std::numeric_limits<int>::max();
 
 } // namespace nx::vms::client::desktop::radass
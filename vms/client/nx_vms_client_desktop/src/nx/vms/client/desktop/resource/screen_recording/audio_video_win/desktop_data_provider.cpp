@@ -22,6 +22,7 @@ extern "C" {
 #include <nx/media/ffmpeg/audio_encoder.h>
 #include <nx/media/ffmpeg/av_options.h>
 #include <nx/media/ffmpeg/av_packet.h>
+#include <nx/media/ffmpeg/frame_info.h>
 #include <nx/media/ffmpeg/old_api.h>
 #include <nx/media/ffmpeg_helper.h>
 #include <nx/media/media_data_packet.h>
@@ -30,9 +31,11 @@ extern "C" {
 #include <nx/utils/log/log.h>
 #include <nx/vms/client/core/resource/screen_recording/audio_device_info_win.h>
 #include <nx/vms/client/desktop/application_context.h>
+#include <nx/vms/client/desktop/ini.h>
 #include <nx/vms/common/system_context.h>
 #include <nx/vms/common/system_settings.h>
 #include <speex/speex_preprocess.h>
+#include <transcoding/hw_video_encoder.h>
 #include <utils/common/synctime.h>
 
 #include "audio_device_change_notifier.h"
@@ -360,6 +363,7 @@ struct DesktopDataProvider::Private
     AVCodecContext* videoCodecCtx = nullptr;
     CodecParametersConstPtr videoContext;
     AVFrame* frame = nullptr;
+    std::unique_ptr<nx::transcoding::HwVideoEncoder> hwEncoder;
 
     QVector<quint8> buffer;
 
@@ -513,20 +517,59 @@ bool DesktopDataProvider::initVideoCapturing()
         return false;
     }
 
-    d->videoCodecCtx = avcodec_alloc_context3(videoCodec);
-    d->videoCodecCtx->codec_id = videoCodec->id;
-    d->videoCodecCtx->codec_type = AVMEDIA_TYPE_VIDEO ;
-    d->videoCodecCtx->thread_count = QThread::idealThreadCount();
+    // The software encoder competes for the CPU with the video playback, so the hardware
+    // encoders of the same codec are tried first.
+    for (const auto& backend: nx::transcoding::hwEncoderBackends(
+        ini().screenRecordingHardwareEncoders))
+    {
+        const auto encoder = backend.encoders.find(videoCodec->id);
+        if (encoder == backend.encoders.end())
+            continue;
+
+        const AVCodec* hwCodec = avcodec_find_encoder_by_name(encoder->second.c_str());
+        if (hwCodec && openVideoEncoder(hwCodec, &backend))
+        {
+            NX_DEBUG(this, "Using hardware video encoder %1", hwCodec->name);
+            return true;
+        }
+    }
+
+    if (!openVideoEncoder(videoCodec, /*backend*/ nullptr))
+    {
+        m_lastErrorStr = tr("Could not initialize video encoder.");
+        return false;
+    }
 
+    return true;
+}
+
+bool DesktopDataProvider::openVideoEncoder(
+    const AVCodec* codec, const nx::transcoding::HwEncoderBackend* backend)
+{
+    d->videoCodecCtx = avcodec_alloc_context3(codec);
+    d->videoCodecCtx->codec_id = codec->id;
+    d->videoCodecCtx->codec_type = AVMEDIA_TYPE_VIDEO ;
 
     d->videoCodecCtx->time_base = d->grabber->getFrameRate();
 
     d->videoCodecCtx->pix_fmt = d->grabber->format();
     d->videoCodecCtx->coded_width = d->videoCodecCtx->width = d->grabber->width();
     d->videoCodecCtx->coded_height = d->videoCodecCtx->height = d->grabber->height();
-    d->videoCodecCtx->bit_rate = calculateBitrate(videoCodec->name);
+    d->videoCodecCtx->bit_rate = calculateBitrate(codec->name);
 
-    QString codec_prop;
+    if (backend)
+    {
+        d->hwEncoder = nx::transcoding::HwVideoEncoder::create(*backend, d->videoCodecCtx);
+        if (!d->hwEncoder)
+        {
+            avcodec_free_context(&d->videoCodecCtx);
+            return false;
+        }
+    }
+    else
+    {
+        d->videoCodecCtx->thread_count = QThread::idealThreadCount();
+    }
 
     if (d->encodeQualuty == 1)
     {
@@ -554,10 +597,13 @@ bool DesktopDataProvider::initVideoCapturing()
     d->videoContext = CodecParametersConstPtr(codecParameters);
 
     nx::media::ffmpeg::AvOptions options;
-    options.set("motion_est", "epzs", 0);
-    if (avcodec_open2(d->videoCodecCtx, videoCodec, options) < 0)
+    if (!backend)
+        options.set("motion_est", "epzs", 0);
+    if (avcodec_open2(d->videoCodecCtx, codec, options) < 0)
     {
-        m_lastErrorStr = tr("Could not initialize video encoder.");
+        NX_WARNING(this, "Could not initialize video encoder %1.", codec->name);
+        avcodec_free_context(&d->videoCodecCtx);
+        d->hwEncoder.reset();
         return false;
     }
 
@@ -643,8 +689,26 @@ int DesktopDataProvider::processData(bool flush)
     nx::media::ffmpeg::AvPacket avPacket;
     auto packet = avPacket.get();
     int got_packet = 0;
+    AVFrame* frame = flush ? nullptr : d->frame;
+
+    // The captured frame is uploaded to the video memory of the hardware encoder.
+    CLVideoDecoderOutputPtr hwFrame;
+    if (frame && d->hwEncoder)
+    {
+        CLVideoDecoderOutputPtr source(new CLVideoDecoderOutput());
+        if (av_frame_ref(source.get(), d->frame) < 0)
+            return -1;
+
+        hwFrame = d->hwEncoder->prepareFrame(source);
+        if (!hwFrame)
+            return -1;
+
+        hwFrame->pts = d->frame->pts;
+        frame = hwFrame.get();
+    }
+
     int encodeResult = nx::media::ffmpeg::old_api::encode(
-        d->videoCodecCtx, packet, flush ? 0 : d->frame, &got_packet);
+        d->videoCodecCtx, packet, frame, &got_packet);
 
     if (encodeResult < 0)
         return encodeResult; //< error
@@ -897,6 +961,7 @@ void DesktopDataProvider::closeStream()
     d->grabber = 0;
 
     avcodec_free_context(&d->videoCodecCtx);
+    d->hwEncoder.reset();
 
     if (d->frame) {
         av_freep(&d->frame->data[0]);
@@ -7,6 +7,10 @@
 #include <nx/vms/client/core/resource/screen_recording/desktop_data_provider_base.h>
 #include <nx/vms/client/desktop/resource/screen_recording/types.h>
 
+struct AVCodec;
+
+namespace nx::transcoding { struct HwEncoderBackend; }
+
 namespace nx::vms::client::desktop {
 
 class AudioDeviceChangeNotifier;
@@ -50,6 +54,14 @@ protected:
 
 private:
     bool initVideoCapturing();
+
+    /**
+     * Opens the video encoder, on the device of the hardware encoder backend if it is given.
+     * @return False if the encoder can not be opened. The error string is not set.
+     */
+    bool openVideoEncoder(
+        const AVCodec* codec, const nx::transcoding::HwEncoderBackend* backend);
+
     bool initAudioCapturing();
     virtual void closeStream();
 
@@ -146,6 +146,59 @@ bool UniqueKeyListEntity<Key>::addItem(const Key& key)
     return true;
 }
 
+template <class Key>
+int UniqueKeyListEntity<Key>::addItems(const QVector<Key>& keys)
+{
+    std::vector<AbstractItem*> newItems;
+    newItems.reserve(keys.size());
+
+    for (const auto& key: keys)
+    {
+        if (isNull(key) || hasItem(key))
+            continue;
+
+        auto createdItem = m_itemCreator(key);
+        if (!createdItem)
+        {
+            NX_ASSERT("Invalid Key or Key->Item transformation provided, null item created.");
+            continue;
+        }
+        auto keyItr = m_keyMapping.insert(std::make_pair(key, std::move(createdItem)));
+        newItems.push_back(keyItr.first->second.get());
+    }
+    if (newItems.empty())
+        return 0;
+
+    std::sort(std::begin(newItems), std::end(newItems), m_itemOrder.comp);
+
+    // The new items which fall between the same pair of present items form a single run of
+    // rows. Runs are inserted from the front, so the search for the next one starts after the
+    // previous run.
+    int index = 0;
+    auto runItr = std::cbegin(newItems);
+    while (runItr != std::cend(newItems))
+    {
+        const auto positionItr = std::lower_bound(std::next(std::cbegin(m_itemSequence), index),
+            std::cend(m_itemSequence), *runItr, m_itemOrder.comp);
+        index = std::distance(std::cbegin(m_itemSequence), positionItr);
+
+        const auto runEndItr = positionItr == std::cend(m_itemSequence)
+            ? std::cend(newItems)
+            : std::lower_bound(runItr, std::cend(newItems), *positionItr, m_itemOrder.comp);
+        const int count = std::distance(runItr, runEndItr);
+
+        auto guard = insertRowsGuard(modelMapping(), index, count);
+        m_itemSequence.insert(positionItr, runItr, runEndItr);
+        for (auto itemItr = runItr; itemItr != runEndItr; ++itemItr)
+            setupItemNotifications(*itemItr);
+
+        index += count;
+        runItr = runEndItr;
+    }
+
+    return static_cast<int>(newItems.size());
+}
+
 template <class Key>
 bool UniqueKeyListEntity<Key>::moveItem(const Key& key, UniqueKeyListEntity<Key>* otherList)
 {
@@ -205,6 +258,47 @@ bool UniqueKeyListEntity<Key>::removeItem(const Key& key)
     return true;
 }
 
+template <class Key>
+int UniqueKeyListEntity<Key>::removeItems(const QVector<Key>& keys)
+{
+    std::unordered_map<AbstractItem*, Key> removedItems;
+    for (const auto& key: keys)
+    {
+        const auto keyItr = m_keyMapping.find(key);
+        if (keyItr != std::cend(m_keyMapping))
+            removedItems.emplace(keyItr->second.get(), key);
+    }
+    if (removedItems.empty())
+        return 0;
+
+    const auto isRemoved =
+        [&removedItems](AbstractItem* item) { return removedItems.count(item) > 0; };
+
+    // Ranges are removed from the back, so the indexes of the ranges ahead stay valid.
+    auto rangeEndItr = std::end(m_itemSequence);
+    while (rangeEndItr != std::begin(m_itemSequence))
+    {
+        const auto rangeLastItr = std::find_if(std::make_reverse_iterator(rangeEndItr),
+            std::rend(m_itemSequence), isRemoved);
+        if (rangeLastItr == std::rend(m_itemSequence))
+            break;
+
+        const auto rangeBeginItr = std::find_if_not(rangeLastItr,
+            std::rend(m_itemSequence), isRemoved).base();
+        rangeEndItr = rangeLastItr.base();
+
+        const int first = std::distance(std::begin(m_itemSequence), rangeBeginItr);
+        const int count = std::distance(rangeBeginItr, rangeEndItr);
+
+        auto guard = removeRowsGuard(modelMapping(), first, count);
+        for (auto itemItr = rangeBeginItr; itemItr != rangeEndItr; ++itemItr)
+            m_keyMapping.erase(removedItems.at(*itemItr));
+        rangeEndItr = m_itemSequence.erase(rangeBeginItr, rangeEndItr);
+    }
+
+    return static_cast<int>(removedItems.size());
+}
+
 template <class Key>
 bool UniqueKeyListEntity<Key>::hasItem(const Key& key) const
 {
@@ -246,6 +340,12 @@ void UniqueKeyListEntity<Key>::installItemSource(
     m_keySource->removeKeyHandler = std::make_shared<KeyNotifyHandler>(
         [this](const Key& key) { removeItem(key); });
 
+    m_keySource->addKeysHandler =
+        [this](const QVector<Key>& keys) { addItems(keys); };
+
+    m_keySource->removeKeysHandler =
+        [this](const QVector<Key>& keys) { removeItems(keys); };
+
     m_keySource->initializeRequest();
 }
 
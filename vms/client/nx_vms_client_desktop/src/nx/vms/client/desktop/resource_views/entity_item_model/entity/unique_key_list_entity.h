@@ -116,6 +116,15 @@ public:
      */
     bool addItem(const Key& key);
 
+    /**
+     * Adds non null items transformed from the given keys. The added items which take adjacent
+     * rows are announced by a single insert notification, so adding a large number of items
+     * costs a few notifications instead of a notification per item.
+     * @param keys List of keys, the keys of the already present items are ignored.
+     * @returns Number of the added items.
+     */
+    int addItems(const QVector<Key>& keys);
+
     /**
      * Moves item corresponding to the given key to the another list if such operation is
      * performable i.e this list contains such item while other list is not. Generates
@@ -138,6 +147,14 @@ public:
      */
     bool removeItem(const Key& key);
 
+    /**
+     * Removes the items described by the keys if such exist. Each contiguous range of the
+     * removed rows is announced by a single remove notification.
+     * @param keys List of keys.
+     * @returns Number of the removed items.
+     */
+    int removeItems(const QVector<Key>& keys);
+
     /**
      * Query if list contains item described by the given key. Has O(1) complexity.
      * @param key The key.
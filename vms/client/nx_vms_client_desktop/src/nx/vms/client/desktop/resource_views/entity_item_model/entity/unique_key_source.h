@@ -3,6 +3,10 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <utility>
+
+#include <QtCore/QSet>
 
 #include <core/resource/resource.h>
 #include <nx/vms/client/desktop/resource_views/entity_resource_tree/resource_source/abstract_resource_source.h>
@@ -19,11 +23,20 @@ public:
     using SetKeysHandler = std::function<void(const QVector<Key>& keyVector)>;
     using KeyNotifyHandler = std::function<void(const Key& key)>;
     using KeyNotifyHandlerPtr = std::shared_ptr<KeyNotifyHandler>;
+    using KeysNotifyHandler = std::function<void(const QVector<Key>& keyVector)>;
     using InitializeRequest = std::function<void()>;
 
     SetKeysHandler setKeysHandler;
     KeyNotifyHandlerPtr addKeyHandler;
     KeyNotifyHandlerPtr removeKeyHandler;
+
+    /**
+     * Optional handlers of the batched changes. If some consumer doesn't provide them, the
+     * batched changes are delivered to it by the single key handlers.
+     */
+    KeysNotifyHandler addKeysHandler;
+    KeysNotifyHandler removeKeysHandler;
+
     InitializeRequest initializeRequest;
 };
 
@@ -36,7 +49,14 @@ using UniqueUuidSourcePtr = std::shared_ptr<UniqueUuidSource>;
 using UniqueStringSource = UniqueKeySource<QString>;
 using UniqueStringSourcePtr = std::shared_ptr<UniqueStringSource>;
 
-class ResourceSourceAdapter: public UniqueResourceSource
+/**
+ * Adapts the resource source to the key source interface. The resources added or removed
+ * within an entity_resource_tree::ResourceSourceChangesBatch scope are collected and delivered
+ * at once when the scope ends.
+ */
+class ResourceSourceAdapter:
+    public UniqueResourceSource,
+    public std::enable_shared_from_this<ResourceSourceAdapter>
 {
 public:
     ResourceSourceAdapter(entity_resource_tree::AbstractResourceSourcePtr abstractResourceSource):
@@ -51,16 +71,96 @@ public:
 
                 resourceSource->connect(
                     resourceSource, &entity_resource_tree::AbstractResourceSource::resourceAdded,
-                    resourceSource, *addKeyHandler);
+                    resourceSource,
+                    [this](const QnResourcePtr& resource) { addResource(resource); });
 
                 resourceSource->connect(
                     resourceSource, &entity_resource_tree::AbstractResourceSource::resourceRemoved,
-                    resourceSource, *removeKeyHandler);
+                    resourceSource,
+                    [this](const QnResourcePtr& resource) { removeResource(resource); });
             };
     }
 
+private:
+    void addResource(const QnResourcePtr& resource)
+    {
+        if (!entity_resource_tree::ResourceSourceChangesBatch::isActive())
+        {
+            (*addKeyHandler)(resource);
+            return;
+        }
+
+        // Removal and addition of the same resource within the batch cancel each other.
+        if (!m_removedResources.remove(resource))
+            m_addedResources.insert(resource);
+        scheduleChanges();
+    }
+
+    void removeResource(const QnResourcePtr& resource)
+    {
+        if (!entity_resource_tree::ResourceSourceChangesBatch::isActive())
+        {
+            (*removeKeyHandler)(resource);
+            return;
+        }
+
+        if (!m_addedResources.remove(resource))
+            m_removedResources.insert(resource);
+        scheduleChanges();
+    }
+
+    void scheduleChanges()
+    {
+        if (m_changesScheduled)
+            return;
+
+        m_changesScheduled = true;
+        entity_resource_tree::ResourceSourceChangesBatch::defer(
+            [weakThis = weak_from_this()]
+            {
+                if (const auto adapter = weakThis.lock())
+                    adapter->applyChanges();
+            });
+    }
+
+    void applyChanges()
+    {
+        m_changesScheduled = false;
+        const auto removedResources = std::exchange(m_removedResources, {});
+        const auto addedResources = std::exchange(m_addedResources, {});
+
+        if (!removedResources.isEmpty())
+        {
+            if (removeKeysHandler)
+            {
+                removeKeysHandler({removedResources.cbegin(), removedResources.cend()});
+            }
+            else
+            {
+                for (const auto& resource: removedResources)
+                    (*removeKeyHandler)(resource);
+            }
+        }
+
+        if (!addedResources.isEmpty())
+        {
+            if (addKeysHandler)
+            {
+                addKeysHandler({addedResources.cbegin(), addedResources.cend()});
+            }
+            else
+            {
+                for (const auto& resource: addedResources)
+                    (*addKeyHandler)(resource);
+            }
+        }
+    }
+
 private:
     entity_resource_tree::AbstractResourceSourcePtr m_abstractResourceSource;
+    QSet<QnResourcePtr> m_addedResources;
+    QSet<QnResourcePtr> m_removedResources;
+    bool m_changesScheduled = false;
 };
 
 } // namespace entity_item_model
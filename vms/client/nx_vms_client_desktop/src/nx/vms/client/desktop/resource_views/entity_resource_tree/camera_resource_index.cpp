@@ -4,6 +4,7 @@
 
 #include <core/resource_management/resource_pool.h>
 #include <core/resource/camera_resource.h>
+#include <nx/vms/client/desktop/resource_views/entity_resource_tree/resource_source/abstract_resource_source.h>
 
 namespace nx::vms::client::desktop {
 namespace entity_resource_tree {
@@ -19,11 +20,13 @@ CameraResourceIndex::CameraResourceIndex(const QnResourcePool* resourcePool):
     indexAllCameras();
     blockSignals(false);
 
-    connect(m_resourcePool, &QnResourcePool::resourceAdded,
-        this, &CameraResourceIndex::onResourceAdded);
+    // The batched signals are used, so the cameras added or removed at once are applied to the
+    // resource tree at once.
+    connect(m_resourcePool, &QnResourcePool::resourcesAdded,
+        this, &CameraResourceIndex::onResourcesAdded);
 
-    connect(m_resourcePool, &QnResourcePool::resourceRemoved,
-        this, &CameraResourceIndex::onResourceRemoved);
+    connect(m_resourcePool, &QnResourcePool::resourcesRemoved,
+        this, &CameraResourceIndex::onResourcesRemoved);
 }
 
 QVector<QnResourcePtr> CameraResourceIndex::allCameras() const
@@ -50,6 +53,20 @@ void CameraResourceIndex::indexAllCameras()
         indexCamera(camera);
 }
 
+void CameraResourceIndex::onResourcesAdded(const QnResourceList& resources)
+{
+    ResourceSourceChangesBatch batch;
+    for (const auto& resource: resources)
+        onResourceAdded(resource);
+}
+
+void CameraResourceIndex::onResourcesRemoved(const QnResourceList& resources)
+{
+    ResourceSourceChangesBatch batch;
+    for (const auto& resource: resources)
+        onResourceRemoved(resource);
+}
+
 void CameraResourceIndex::onResourceAdded(const QnResourcePtr& resource)
 {
     if (resource->hasFlags(Qn::desktop_camera))
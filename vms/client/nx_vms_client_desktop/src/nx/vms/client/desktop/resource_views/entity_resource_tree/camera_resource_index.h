@@ -31,6 +31,8 @@ signals:
     void cameraRemovedFromServer(const QnResourcePtr& camera, const QnResourcePtr& server);
 
 private:
+    void onResourcesAdded(const QnResourceList& resources);
+    void onResourcesRemoved(const QnResourceList& resources);
     void onResourceAdded(const QnResourcePtr& resource);
     void onResourceRemoved(const QnResourcePtr& resource);
     void onCameraParentIdChanged(const QnResourcePtr& resource, const nx::Uuid& previousParentId);
@@ -2,9 +2,21 @@
 
 #include "abstract_resource_source.h"
 
+#include <utility>
+#include <vector>
+
+#include <nx/utils/log/assert.h>
+
 namespace nx::vms::client::desktop {
 namespace entity_resource_tree {
 
+namespace {
+
+int batchDepth = 0;
+std::vector<std::function<void()>> deferredChanges;
+
+} // namespace
+
 AbstractResourceSource::AbstractResourceSource():
     base_type(nullptr)
 {
@@ -14,5 +26,33 @@ AbstractResourceSource::~AbstractResourceSource()
 {
 }
 
+ResourceSourceChangesBatch::ResourceSourceChangesBatch()
+{
+    ++batchDepth;
+}
+
+ResourceSourceChangesBatch::~ResourceSourceChangesBatch()
+{
+    if (--batchDepth > 0)
+        return;
+
+    // Applied changes are not batched anymore, so the list can't grow while it's applied.
+    for (const auto& applyChanges: std::exchange(deferredChanges, {}))
+        applyChanges();
+}
+
+bool ResourceSourceChangesBatch::isActive()
+{
+    return batchDepth > 0;
+}
+
+void ResourceSourceChangesBatch::defer(std::function<void()> applyChanges)
+{
+    if (NX_ASSERT(isActive()))
+        deferredChanges.push_back(std::move(applyChanges));
+    else
+        applyChanges();
+}
+
 } // namespace entity_resource_tree
 } // namespace nx::vms::client::desktop
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QtCore/QObject>
 #include <QtCore/QVector>
 
@@ -27,5 +29,27 @@ signals:
 
 using AbstractResourceSourcePtr = std::unique_ptr<AbstractResourceSource>;
 
+/**
+ * Scope of the resource changes which are applied to the resource tree at once. While some
+ * instance exists, the consumers of the resource sources collect the added and removed resources
+ * and apply them when the outermost instance is destroyed, so a large change produces a model
+ * notification per contiguous range of rows rather than a notification per row. Intended to be
+ * used from the main thread only.
+ */
+class NX_VMS_CLIENT_DESKTOP_API ResourceSourceChangesBatch
+{
+public:
+    ResourceSourceChangesBatch();
+    ~ResourceSourceChangesBatch();
+
+    ResourceSourceChangesBatch(const ResourceSourceChangesBatch&) = delete;
+    ResourceSourceChangesBatch& operator=(const ResourceSourceChangesBatch&) = delete;
+
+    static bool isActive();
+
+    /** Calls the given function when the outermost batch ends. */
+    static void defer(std::function<void()> applyChanges);
+};
+
 } // namespace entity_resource_tree
 } // namespace nx::vms::client::desktop
@@ -297,6 +297,7 @@ struct RhiVideoRenderer::Private
     QVector2D textureScale;
 
     intptr_t lastUploadedFrame = 0;
+    bool systemMemoryFallbackReported = false;
 };
 
 RhiVideoRenderer::RhiVideoRenderer():
@@ -495,7 +496,8 @@ void RhiVideoRenderer::ensureTextures(const AVFrame* frame)
     d->lastUploadedFrame = 0;
 }
 
-void RhiVideoRenderer::uploadFrame(const AVFrame* frame, QRhiResourceUpdateBatch* rub)
+void RhiVideoRenderer::uploadFrame(
+    const AVFrame* frame, QRhiResourceUpdateBatch* rub, bool copyData)
 {
     ensureTextures(frame);
 
@@ -508,8 +510,10 @@ void RhiVideoRenderer::uploadFrame(const AVFrame* frame, QRhiResourceUpdateBatch
         const auto size = textureSize(
             (AVPixelFormat) frame->format, i, frameSize);
         const auto stride = lineSizes[i];
-        QByteArray data((const char*)planes[i], size.height() * stride);
-        QRhiTextureSubresourceUploadDescription desc(planes[i], size.height() * stride);
+        const auto dataSize = size.height() * stride;
+        QRhiTextureSubresourceUploadDescription desc(copyData
+            ? QByteArray((const char*) planes[i], dataSize)
+            : QByteArray::fromRawData((const char*) planes[i], dataSize));
         desc.setDataStride(stride);
         rub->uploadTexture(d->textures->texture(i), QRhiTextureUploadEntry(0, 0, desc));
     }
@@ -547,6 +551,12 @@ void RhiVideoRenderer::uploadFrame(QVideoFrame* videoFrame, QRhiResourceUpdateBa
         }
     }
 
+    if (!d->systemMemoryFallbackReported)
+    {
+        NX_DEBUG(this, "HW frames are not mapped to textures, copying them via system memory");
+        d->systemMemoryFallbackReported = true;
+    }
+
     AVFrame frame;
     memset(&frame, 0, sizeof(frame));
     frame.format = d->data.frame->format;
@@ -564,7 +574,9 @@ void RhiVideoRenderer::uploadFrame(QVideoFrame* videoFrame, QRhiResourceUpdateBa
         frame.data[i] = videoFrame->bits(i);
     }
 
-    uploadFrame(&frame, rub);
+    // The mapping is valid only until unmap(), so the planes are copied.
+    uploadFrame(&frame, rub, /*copyData*/ true);
+    videoFrame->unmap();
 }
 
 void RhiVideoRenderer::prepare(
@@ -597,7 +609,7 @@ void RhiVideoRenderer::prepare(
         if (d->data.frame->memoryType() == MemoryType::VideoMemory)
             uploadFrame(d->data.frame->getVideoSurface()->frame(), rub);
         else
-            uploadFrame(d->data.frame.get(), rub);
+            uploadFrame(d->data.frame.get(), rub, /*copyData*/ false); //< The frame is held in d.
 
         d->lastUploadedFrame = (intptr_t) d->data.frame.get();
     }
@@ -51,7 +51,11 @@ private:
         QRhiRenderPassDescriptor* desc);
     void createBindings();
     void ensureTextures(const AVFrame* frame);
-    void uploadFrame(const AVFrame* frame, QRhiResourceUpdateBatch* rub);
+    /**
+     * @param copyData Whether the planes are copied to the update batch. Otherwise they are
+     *     referenced and must stay valid until the batch is submitted.
+     */
+    void uploadFrame(const AVFrame* frame, QRhiResourceUpdateBatch* rub, bool copyData);
     void uploadFrame(QVideoFrame* videoFrame, QRhiResourceUpdateBatch* rub);
 
     struct Private;
@@ -4,15 +4,22 @@
 
 #include <QtCore/QTimerEvent>
 
+#include <camera/resource_display.h>
+#include <core/resource/camera_resource.h>
 #include <core/resource_management/resource_pool.h>
+#include <nx/utils/datetime.h>
+#include <nx/utils/log/log.h>
 #include <nx/utils/math/math.h>
 #include <nx/vms/api/data/showreel_data.h>
 #include <nx/vms/client/desktop/application_context.h>
+#include <nx/vms/client/desktop/ini.h>
 #include <nx/vms/client/desktop/layout/layout_data_helper.h>
 #include <nx/vms/client/desktop/menu/action_manager.h>
 #include <nx/vms/client/desktop/radass/radass_resource_manager.h>
 #include <nx/vms/client/desktop/radass/radass_types.h>
 #include <nx/vms/client/desktop/resource/layout_resource.h>
+#include <nx/vms/client/desktop/resource/resource_access_manager.h>
+#include <nx/vms/client/desktop/resource/resource_descriptor.h>
 #include <nx/vms/client/desktop/settings/local_settings.h>
 #include <nx/vms/client/desktop/settings/system_specific_local_settings.h>
 #include <nx/vms/client/desktop/state/client_state_handler.h>
@@ -20,6 +27,7 @@
 #include <nx/vms/client/desktop/workbench/workbench.h>
 #include <nx/vms/client/desktop/system_context.h>
 #include <ui/workbench/workbench_context.h>
+#include <ui/workbench/workbench_display.h>
 #include <ui/workbench/workbench_item.h>
 #include <ui/workbench/workbench_layout.h>
 
@@ -161,6 +169,7 @@ void ShowreelExecutor::stopCurrentShowreel()
             stopTimer();
             setHintVisible(false);
             m_showreel.currentIndex = 0;
+            releasePrefetchedLayout();
             NX_ASSERT(!m_showreel.id.isNull());
             const nx::Uuid showreelId = m_showreel.id;
             m_showreel.id = nx::Uuid();
@@ -303,7 +312,16 @@ void ShowreelExecutor::processShowreelStepInternal(bool forward, bool force)
 
                 const auto& item = m_showreel.items[m_showreel.currentIndex];
                 if (!m_showreel.elapsed.hasExpired(item.delayMs))
+                {
+                    const int leadTimeMs = ini().showreelPrefetchLeadTimeMs;
+                    if (leadTimeMs > 0 && m_showreel.elapsed.hasExpired(item.delayMs - leadTimeMs))
+                    {
+                        prefetchLayout(nextIndex(
+                            m_showreel.currentIndex,
+                            (int) m_showreel.items.size()));
+                    }
                     return;
+                }
             }
 
             m_showreel.currentIndex = nextIndex(
@@ -325,6 +343,9 @@ void ShowreelExecutor::processShowreelStepInternal(bool forward, bool force)
             if (isTimerRunning())
                 m_showreel.elapsed.restart();
             workbench()->setCurrentLayout(wbLayout);
+
+            // The streams which are not taken by the layout widgets are not needed anymore.
+            releasePrefetchedLayout();
             break;
         }
         default:
@@ -332,6 +353,55 @@ void ShowreelExecutor::processShowreelStepInternal(bool forward, bool force)
     }
 }
 
+void ShowreelExecutor::prefetchLayout(int index)
+{
+    if (m_showreel.prefetchedIndex == index)
+        return;
+
+    m_showreel.prefetchedIndex = index;
+    const auto layout = m_showreel.items[index].layout;
+    if (!layout || workbench()->layout(layout) == workbench()->currentLayout())
+        return;
+
+    QList<QnResourceDisplayPtr> displays;
+    for (const auto& data: layout->getItems())
+    {
+        if (displays.size() >= ini().showreelPrefetchMaxItems)
+            break;
+
+        // Zoom windows share the display of their target items.
+        if (!data.zoomTargetUuid.isNull())
+            continue;
+
+        // Only the live streams are opened, as the archive items are positioned on the switch.
+        const qint64 time = layout->itemData(data.uuid, Qn::ItemTimeRole).toLongLong();
+        if (time > 0 && time != DATETIME_NOW)
+            continue;
+
+        const auto camera =
+            getResourceByDescriptor(data.resource).dynamicCast<QnVirtualCameraResource>();
+        if (!camera
+            || !camera->hasFlags(Qn::live)
+            || !ResourceAccessManager::hasPermissions(camera, Qn::ViewContentPermission))
+        {
+            continue;
+        }
+
+        QnResourceDisplayPtr display(new QnResourceDisplay(camera));
+        display->start();
+        displays.push_back(display);
+    }
+
+    NX_DEBUG(this, "Prefetched %1 streams of the layout %2", displays.size(), layout);
+    display()->setPrefetchedDisplays(displays);
+}
+
+void ShowreelExecutor::releasePrefetchedLayout()
+{
+    m_showreel.prefetchedIndex = -1;
+    display()->setPrefetchedDisplays({});
+}
+
 void ShowreelExecutor::clearWorkbenchState()
 {
     m_lastState = WorkbenchState();
@@ -58,6 +58,13 @@ private:
     void resetShowreelItems(const nx::vms::api::ShowreelItemDataList& items);
     void processShowreelStepInternal(bool forward, bool force);
 
+    /**
+     * Opens the streams of the layout items in advance, so the layout shows the live picture as
+     * soon as it is switched to.
+     */
+    void prefetchLayout(int index);
+    void releasePrefetchedLayout();
+
     void clearWorkbenchState();
     void restoreWorkbenchState(const nx::Uuid& showreelId);
 
@@ -93,6 +100,7 @@ private:
         nx::Uuid id;
         std::vector<Item> items;
         int currentIndex{0};
+        int prefetchedIndex{-1};
 
         // Common section
         int timerId{0};
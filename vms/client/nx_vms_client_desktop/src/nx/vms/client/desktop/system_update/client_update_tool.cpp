@@ -762,6 +762,14 @@ ClientUpdateTool::State ClientUpdateTool::getState() const
     return m_state;
 }
 
+QList<ClientUpdateTool::PeerStatistics> ClientUpdateTool::downloadPeerStatistics() const
+{
+    if (!m_downloader || m_clientPackage.file.isEmpty())
+        return {};
+
+    return m_downloader->peerStatistics(m_clientPackage.file);
+}
+
 bool ClientUpdateTool::hasUpdate() const
 {
     return m_state != State::initial
@@ -43,6 +43,7 @@ class ClientUpdateTool:
     using base_type = QObject;
     using Downloader = vms::common::p2p::downloader::Downloader;
     using FileInformation = vms::common::p2p::downloader::FileInformation;
+    using PeerStatistics = vms::common::p2p::downloader::PeerStatistics;
     using PeerManagerPtr = nx::vms::common::p2p::downloader::AbstractPeerManager*;
 
 public:
@@ -121,6 +122,11 @@ public:
 
     State getState() const;
 
+    /**
+     * Statistics of the peers the client package is being downloaded from.
+     */
+    QList<PeerStatistics> downloadPeerStatistics() const;
+
     /**
      * Tells applauncher to install update package.
      * It will work only if tool is in state State::readyInstall. This is asyncronous call.
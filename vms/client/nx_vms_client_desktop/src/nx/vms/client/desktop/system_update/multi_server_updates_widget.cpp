@@ -2884,6 +2884,14 @@ void MultiServerUpdatesWidget::syncDebugInfoToUi()
         if (m_updateInfo.isValidToInstall() && m_updateInfo.noServerWithInternet)
             debugState << "noServerWithInternet";
 
+        for (const auto& peer: m_clientUpdateTool->downloadPeerStatistics())
+        {
+            debugState << nx::format(
+                "peer %1: rank=%2, window=%3, inFlight=%4, chunks=%5, failed=%6, %7 KB/s",
+                peer.peer, peer.rank, peer.window, peer.chunksInFlight, peer.downloadedChunks,
+                peer.failedRequests, (int) (peer.throughputBytesPerSecond / 1024));
+        }
+
         QString debugText = debugState.join(nx::vms::common::html::kLineBreak);
         if (debugText != ui->debugStateLabel->text())
             ui->debugStateLabel->setText(debugText);
@@ -2,6 +2,7 @@
 
 #include "time_slider.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <limits>
@@ -317,18 +318,17 @@ QPoint mapItemToGlobal(const QGraphicsItem* item, const QPointF& point)
 class QnTimeSliderChunkPainter
 {
 public:
-    QnTimeSliderChunkPainter(QnTimeSlider* slider, QPainter* painter):
-        m_slider(slider),
+    QnTimeSliderChunkPainter(QPainter* painter, Qn::TimePeriodContent extraContent):
         m_painter(painter),
         m_minChunkLength(0),
         m_position(0),
         m_pendingLength(0),
         m_pendingPosition(0)
     {
-        NX_ASSERT(m_painter && m_slider);
+        NX_ASSERT(m_painter);
 
         // TODO: #vkutin Refactor this class to operate with "recording" and "extra" content types.
-        const bool analytics = m_slider->selectedExtraContent() == Qn::AnalyticsContent;
+        const bool analytics = extraContent == Qn::AnalyticsContent;
 
         m_colors[Qn::RecordingContent] = core::colorTheme()->color("green");
         m_colors[Qn::MotionContent] = analytics
@@ -339,8 +339,13 @@ public:
         m_position = m_minChunkLength = 0ms;
     }
 
+    /**
+     * Starts painting from the left edge of the rect. Each pixel of the rect covers minChunkLength
+     * of time.
+     */
     void start(milliseconds startPos, milliseconds minChunkLength, const QRectF& rect)
     {
+        m_startPosition = startPos;
         m_position = startPos;
         m_minChunkLength = minChunkLength;
         m_rect = rect;
@@ -388,8 +393,8 @@ private:
         milliseconds leftPosition = m_pendingPosition;
         milliseconds rightPosition = m_pendingPosition + m_pendingLength;
 
-        qreal l = m_slider->quickPositionFromTime(leftPosition);
-        qreal r = m_slider->quickPositionFromTime(rightPosition);
+        qreal l = positionFromTime(leftPosition);
+        qreal r = positionFromTime(rightPosition);
 
         m_painter->fillRect(QRectF(l, m_rect.top(), r - l, m_rect.height()), currentColor(m_colors));
 
@@ -399,6 +404,11 @@ private:
         std::fill(m_weights.begin(), m_weights.end(), 0);
     }
 
+    qreal positionFromTime(milliseconds time) const
+    {
+        return m_rect.left() + qreal((time - m_startPosition).count()) / m_minChunkLength.count();
+    }
+
     QColor currentColor(const std::array<QColor, Qn::TimePeriodContentCount + 1>& colors) const
     {
         qreal rc = m_weights[Qn::RecordingContent];
@@ -427,12 +437,13 @@ private:
     }
 
 private:
-    QnTimeSlider* m_slider;
     QPainter* m_painter;
 
     milliseconds m_minChunkLength;
     QRectF m_rect;
 
+    milliseconds m_startPosition{0};
+
     milliseconds m_position;
     milliseconds m_pendingLength;
     milliseconds m_pendingPosition;
@@ -442,6 +453,130 @@ private:
 };
 
 
+namespace {
+
+/** Width of a period bar tile in the tile pixels. */
+constexpr qint64 kPeriodsTileWidth = 256;
+
+/** Maximum number of the period bar tiles kept for a line besides the visible ones. */
+constexpr size_t kMaxPeriodsTiles = 256;
+
+qint64 floorDiv(qint64 value, qint64 divisor)
+{
+    const qint64 result = value / divisor;
+    return (value % divisor != 0 && value < 0) ? result - 1 : result;
+}
+
+/** Start of the earliest period that differs in the lists, or max() if the lists are equal. */
+milliseconds firstDifference(const QnTimePeriodList& left, const QnTimePeriodList& right)
+{
+    // The comparison is instant when the lists share the data, that is the usual case.
+    if (left == right)
+        return milliseconds::max();
+
+    const auto [l, r] = std::mismatch(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+    qint64 result = std::numeric_limits<qint64>::max();
+    if (l != left.cend())
+        result = l->startTimeMs;
+    if (r != right.cend())
+        result = std::min(result, r->startTimeMs);
+    return milliseconds(result);
+}
+
+/**
+ * The code here may look complicated, but it takes care of not rendering different motion
+ * periods several times over the same location. It makes transparent time slider look better.
+ */
+void paintPeriods(QnTimeSliderChunkPainter* chunkPainter, const QnTimePeriodList& recorded,
+    const QnTimePeriodList& extra, milliseconds minimumValue, milliseconds maximumValue)
+{
+    /* Note that constness of period lists is important here as requesting
+     * iterators from a non-const object will result in detach. */
+    const QnTimePeriodList periods[Qn::TimePeriodContentCount] = {recorded, extra};
+
+    QnTimePeriodList::const_iterator pos[Qn::TimePeriodContentCount];
+    QnTimePeriodList::const_iterator end[Qn::TimePeriodContentCount];
+    for (int i = 0; i < Qn::TimePeriodContentCount; i++)
+    {
+         pos[i] = periods[i].findNearestPeriod(minimumValue.count(), true);
+         end[i] = periods[i].findNearestPeriod(maximumValue.count(), true);
+         if (end[i] != periods[i].end() && end[i]->contains(maximumValue.count()))
+             end[i]++;
+    }
+
+    milliseconds value = minimumValue;
+    bool inside[Qn::TimePeriodContentCount];
+    for (int i = 0; i < Qn::TimePeriodContentCount; i++)
+        inside[i] = pos[i] == end[i] ? false : pos[i]->contains(value.count());
+
+    while (value != maximumValue)
+    {
+        milliseconds nextValue[Qn::TimePeriodContentCount] = {maximumValue, maximumValue};
+        for (int i = 0; i < Qn::TimePeriodContentCount; i++)
+        {
+            if (pos[i] == end[i])
+                continue;
+
+            if (!inside[i])
+            {
+                nextValue[i] = qMin(maximumValue, milliseconds(pos[i]->startTimeMs));
+                continue;
+            }
+
+            if (!pos[i]->isInfinite())
+            {
+                nextValue[i] = qMin(maximumValue,
+                    milliseconds(pos[i]->startTimeMs + pos[i]->durationMs));
+            }
+        }
+
+        milliseconds bestValue =
+            qMin(nextValue[Qn::RecordingContent], nextValue[Qn::MotionContent]);
+
+        Qn::TimePeriodContent content;
+        if (inside[Qn::MotionContent])
+            content = Qn::MotionContent;
+        else if (inside[Qn::RecordingContent])
+            content = Qn::RecordingContent;
+        else
+            content = Qn::TimePeriodContentCount;
+
+        chunkPainter->paintChunk(bestValue - value, content);
+
+        for (int i = 0; i < Qn::TimePeriodContentCount; i++)
+        {
+            if (bestValue != nextValue[i])
+                continue;
+
+            if (inside[i])
+                pos[i]++;
+
+            inside[i] = !inside[i];
+        }
+
+        value = bestValue;
+    }
+}
+
+QImage renderPeriodsTile(const QnTimePeriodList& recorded, const QnTimePeriodList& extra,
+    Qn::TimePeriodContent extraContent, milliseconds tileStart, milliseconds msecsPerTilePixel)
+{
+    QImage image(kPeriodsTileWidth, 1, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    QnTimeSliderChunkPainter chunkPainter(&painter, extraContent);
+    chunkPainter.start(tileStart, msecsPerTilePixel, QRectF(0, 0, kPeriodsTileWidth, 1));
+    paintPeriods(&chunkPainter, recorded, extra,
+        tileStart, tileStart + msecsPerTilePixel * kPeriodsTileWidth);
+    chunkPainter.stop();
+
+    return image;
+}
+
+} // anonymous namespace
+
+
 // -------------------------------------------------------------------------- //
 // QnTimeSliderStepStorage
 // -------------------------------------------------------------------------- //
@@ -979,6 +1114,15 @@ void QnTimeSlider::setTimePeriods(
     m_lineData[line].periodStorage->setPeriods(type, timePeriods);
 }
 
+void QnTimeSlider::updateTimePeriods(
+    int line, Qn::TimePeriodContent type, const QnTimePeriodList& tail, qint64 startTimeMs)
+{
+    if (!checkLinePeriod(line, type))
+        return;
+
+    m_lineData[line].periodStorage->updatePeriods(type, tail, startTimeMs);
+}
+
 QnTimeSlider::Options QnTimeSlider::options() const
 {
     return m_options;
@@ -2475,6 +2619,7 @@ void QnTimeSlider::paint(QPainter* painter, const QStyleOptionGraphicsItem* , QW
 
             drawPeriodsBar(
                 painter,
+                &m_lineData[line].periodsBarCache,
                 m_lineData[line].periodStorage->aggregated(Qn::RecordingContent),
                 extraContent,
                 lineRect);
@@ -2725,82 +2870,75 @@ void QnTimeSlider::drawMarker(QPainter* painter,
     painter->drawLine(QPointF(x, topY), QPointF(x, rect().bottom()));
 }
 
-void QnTimeSlider::drawPeriodsBar(QPainter* painter, const QnTimePeriodList& recorded, const QnTimePeriodList& extra, const QRectF& rect)
+void QnTimeSlider::drawPeriodsBar(QPainter* painter, PeriodsBarCache* cache,
+    const QnTimePeriodList& recorded, const QnTimePeriodList& extra, const QRectF& rect)
 {
-    milliseconds minimumValue = windowStart();
-    milliseconds maximumValue = windowEnd();
-
-    /* The code here may look complicated, but it takes care of not rendering
-     * different motion periods several times over the same location.
-     * It makes transparent time slider look better. */
+    const milliseconds minimumValue = windowStart();
+    const milliseconds maximumValue = windowEnd();
+    if (maximumValue <= minimumValue)
+        return;
 
-    /* Note that constness of period lists is important here as requesting
-     * iterators from a non-const object will result in detach. */
-    const QnTimePeriodList periods[Qn::TimePeriodContentCount] = {recorded, extra};
+    /* The tiles are rendered at the power of two time per pixel not greater than the current one,
+     * so they are reused while the window is zoomed within the level and are never magnified. */
+    qint64 msecsPerTilePixelValue = 1;
+    while (msecsPerTilePixelValue * 2 <= m_msecsPerPixel)
+        msecsPerTilePixelValue *= 2;
+    const milliseconds msecsPerTilePixel(msecsPerTilePixelValue);
+    const qint64 tileSpan = kPeriodsTileWidth * msecsPerTilePixelValue;
 
-    QnTimePeriodList::const_iterator pos[Qn::TimePeriodContentCount];
-    QnTimePeriodList::const_iterator end[Qn::TimePeriodContentCount];
-    for (int i = 0; i < Qn::TimePeriodContentCount; i++)
+    if (cache->msecsPerTilePixel != msecsPerTilePixel
+        || cache->extraContent != m_selectedExtraContent)
     {
-         pos[i] = periods[i].findNearestPeriod(minimumValue.count(), true);
-         end[i] = periods[i].findNearestPeriod(maximumValue.count(), true);
-         if (end[i] != periods[i].end() && end[i]->contains(maximumValue.count()))
-             end[i]++;
+        cache->tiles.clear();
+        cache->msecsPerTilePixel = msecsPerTilePixel;
+        cache->extraContent = m_selectedExtraContent;
     }
-
-    milliseconds value = minimumValue;
-    bool inside[Qn::TimePeriodContentCount];
-    for (int i = 0; i < Qn::TimePeriodContentCount; i++)
-        inside[i] = pos[i] == end[i] ? false : pos[i]->contains(value.count());
-
-    QnTimeSliderChunkPainter chunkPainter(this, painter);
-    chunkPainter.start(value, milliseconds(qint64(m_msecsPerPixel)), rect);
-
-    while (value != maximumValue)
+    else
     {
-        milliseconds nextValue[Qn::TimePeriodContentCount] = {maximumValue, maximumValue};
-        for (int i = 0; i < Qn::TimePeriodContentCount; i++)
+        /* Only the tiles after the first changed period are rendered again, so the live archive
+         * updates do not touch the tiles of the past. */
+        const milliseconds changed = std::min(
+            firstDifference(cache->recorded, recorded), firstDifference(cache->extra, extra));
+        if (changed != milliseconds::max())
         {
-            if (pos[i] == end[i])
-                continue;
-
-            if (!inside[i])
-            {
-                nextValue[i] = qMin(maximumValue, milliseconds(pos[i]->startTimeMs));
-                continue;
-            }
-
-            if (!pos[i]->isInfinite())
-                nextValue[i] = qMin(maximumValue, milliseconds(pos[i]->startTimeMs + pos[i]->durationMs));
+            cache->tiles.erase(cache->tiles.lower_bound(floorDiv(changed.count(), tileSpan)),
+                cache->tiles.end());
         }
+    }
+    cache->recorded = recorded;
+    cache->extra = extra;
 
-        milliseconds bestValue = qMin(nextValue[Qn::RecordingContent], nextValue[Qn::MotionContent]);
+    const qint64 firstTile = floorDiv(minimumValue.count(), tileSpan);
+    const qint64 lastTile = floorDiv(maximumValue.count() - 1, tileSpan);
 
-        Qn::TimePeriodContent content;
-        if (inside[Qn::MotionContent])
-            content = Qn::MotionContent;
-        else if (inside[Qn::RecordingContent])
-            content = Qn::RecordingContent;
-        else
-            content = Qn::TimePeriodContentCount;
-
-        chunkPainter.paintChunk(bestValue - value, content);
+    QnScopedPainterSmoothPixmapTransformRollback smoothRollback(painter, true);
+    for (qint64 index = firstTile; index <= lastTile; ++index)
+    {
+        const milliseconds tileStart(index * tileSpan);
 
-        for (int i = 0; i < Qn::TimePeriodContentCount; i++)
+        QImage& tile = cache->tiles[index];
+        if (tile.isNull())
         {
-            if (bestValue != nextValue[i])
-                continue;
-
-            if (inside[i])
-                pos[i]++;
-
-            inside[i] = !inside[i];
+            tile = renderPeriodsTile(
+                recorded, extra, m_selectedExtraContent, tileStart, msecsPerTilePixel);
         }
 
-        value = bestValue;
+        const milliseconds start = std::max(minimumValue, tileStart);
+        const milliseconds end = std::min(maximumValue, tileStart + milliseconds(tileSpan));
+        const qreal l = quickPositionFromTime(start);
+        const qreal r = quickPositionFromTime(end);
+
+        const QRectF source(
+            qreal((start - tileStart).count()) / msecsPerTilePixelValue, 0,
+            qreal((end - start).count()) / msecsPerTilePixelValue, 1);
+        painter->drawImage(QRectF(l, rect.top(), r - l, rect.height()), tile, source);
     }
 
-    chunkPainter.stop();
+    if (cache->tiles.size() > kMaxPeriodsTiles)
+    {
+        cache->tiles.erase(cache->tiles.begin(), cache->tiles.lower_bound(firstTile));
+        cache->tiles.erase(cache->tiles.upper_bound(lastTile), cache->tiles.end());
+    }
 }
 
 
@@ -3,12 +3,14 @@
 #pragma once
 
 #include <chrono>
+#include <map>
 #include <memory>
 #include <optional>
 
 #include <QtCore/QPointer>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QTimeZone>
+#include <QtGui/QImage>
 
 #include <qt_graphics_items/graphics_slider.h>
 
@@ -173,6 +175,10 @@ public:
     QnTimePeriodList timePeriods(int line, Qn::TimePeriodContent type) const;
     void setTimePeriods(int line, Qn::TimePeriodContent type, const QnTimePeriodList& timePeriods);
 
+    /** Replaces the periods since the start time with the tail, keeping the earlier ones. */
+    void updateTimePeriods(int line, Qn::TimePeriodContent type, const QnTimePeriodList& tail,
+        qint64 startTimeMs);
+
     Options options() const;
     void setOptions(Options options);
     void setOption(Option option, bool value);
@@ -394,10 +400,26 @@ private:
         qreal textOpacitySpeed;
     };
 
+    /**
+     * Period bar rendered into tiles of the fixed width, see drawPeriodsBar(). The tiles are
+     * dropped when the time scale level or the rendered period lists change.
+     */
+    struct PeriodsBarCache
+    {
+        QnTimePeriodList recorded;
+        QnTimePeriodList extra;
+        Qn::TimePeriodContent extraContent = Qn::RecordingContent;
+        milliseconds msecsPerTilePixel{0};
+
+        /** One pixel high tile images by the tile index. */
+        std::map<qint64, QImage> tiles;
+    };
+
     struct LineData
     {
         std::shared_ptr<nx::vms::client::core::TimePeriodStorage> periodStorage{
             new nx::vms::client::core::TimePeriodStorage()};
+        PeriodsBarCache periodsBarCache;
         QString comment;
         QPixmap commentPixmap;
         bool visible = true;
@@ -460,7 +482,8 @@ private:
 
     bool scaleWindow(qreal factor, milliseconds anchor);
 
-    void drawPeriodsBar(QPainter* painter, const QnTimePeriodList& recorded, const QnTimePeriodList& extra, const QRectF& rect);
+    void drawPeriodsBar(QPainter* painter, PeriodsBarCache* cache,
+        const QnTimePeriodList& recorded, const QnTimePeriodList& extra, const QRectF& rect);
     void drawTickmarks(QPainter* painter, const QRectF& rect);
     void drawSolidBackground(QPainter* painter, const QRectF& rect);
     void drawMarker(QPainter* painter,
@@ -9,6 +9,7 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 }
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QRunnable>
 #include <QtGui/QPainter>
 #include <QtWidgets/QApplication>
@@ -18,9 +19,12 @@ extern "C" {
 #include <nx/media/supported_decoders.h>
 #include <nx/media/yuvconvert.h>
 #include <nx/utils/app_info.h>
+#include <nx/utils/elapsed_timer.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/math/math.h>
 #include <nx/utils/random.h>
+#include <nx/utils/scope_guard.h>
+#include <nx/utils/trace/trace.h>
 #include <nx/vms/client/core/graphics/shader_helper.h>
 #include <nx/vms/client/desktop/opengl/opengl_renderer.h>
 #include <transcoding/transcoding_utils.h>
@@ -36,6 +40,10 @@ extern "C" {
     #include <nx/media/quick_sync/quick_sync_video_frame.h>
 #endif
 
+#if !defined(GL_PIXEL_UNPACK_BUFFER)
+    #define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+
 namespace
 {
     const int ROUND_COEFF = 8;
@@ -120,6 +128,7 @@ public:
     bool forceSoftYUV;
     bool yv12SharedUsed;
     bool nv12SharedUsed;
+    bool supportsPixelBufferObjects = false;
     QScopedPointer<QnGlFunctions> functions;
     QnGlFunctions::Features features;
 
@@ -136,6 +145,11 @@ public:
             functions.reset(new QnGlFunctions(glWidget)); //< Resets current context.
             features = functions->features();
             glWidget->makeCurrent();
+
+            const QOpenGLContext* context = glWidget->context();
+            supportsPixelBufferObjects = context->isOpenGLES()
+                ? context->format().majorVersion() >= 3
+                : context->format().version() >= qMakePair(2, 1);
         }
         else if (!qw)
         {
@@ -819,6 +833,8 @@ void DecodedPictureToOpenGLUploader::uploadDecodedPicture(
 {
     NX_VERBOSE(this,
         nx::format("Uploading decoded picture to gl textures. dts %1").arg(decodedPicture->pkt_dts));
+    NX_TRACE_CATEGORY_SCOPE("frame", "upload").args({
+        {"timestamp", (qint64) decodedPicture->pkt_dts}});
 
     //m_hardwareDecoderUsed = decodedPicture->flags & QnAbstractMediaData::MediaFlags_HWDecodingUsed;
 
@@ -1327,6 +1343,11 @@ bool DecodedPictureToOpenGLUploader::uploadDataToGl(
     DecodedPictureToOpenGLUploader::UploadedPicture* const emptyPictureBuf,
     const CLConstVideoDecoderOutputPtr& frame)
 {
+    const nx::utils::BasicElapsedTimer<std::chrono::microseconds> uploadTimer(
+        nx::utils::ElapsedTimerState::started);
+    const auto uploadTimeGuard = nx::utils::makeScopeGuard(
+        [this, &uploadTimer]() { m_lastUploadDuration = uploadTimer.elapsed(); });
+
     if (d->gl)
     {
         if (!m_initializedContext) // TODO: #vkutin #ynikitenkov Why here?
@@ -1436,8 +1457,8 @@ bool DecodedPictureToOpenGLUploader::uploadDataToGl(
             {
                 d->gl->glBindTexture( GL_TEXTURE_2D, texture->id() );
                 d->gl->glPixelStorei(GL_UNPACK_ROW_LENGTH, lineSizes[i]);
-                d->gl->glTexSubImage2D(
-                    GL_TEXTURE_2D, 0, 0, 0, r_w[i], h[i], singleComponent, GL_UNSIGNED_BYTE, planes[i]);
+                uploadPlane(
+                    emptyPictureBuf, i, r_w[i], h[i], lineSizes[i], singleComponent, planes[i]);
                 d->gl->glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
             }
             bitrateCalculator.bytesProcessed( qPower2Ceil(r_w[i],ROUND_COEFF)*h[i] );
@@ -1550,6 +1571,46 @@ bool DecodedPictureToOpenGLUploader::uploadDataToGl(
     return true;
 }
 
+void DecodedPictureToOpenGLUploader::uploadPlane(
+    UploadedPicture* const picture,
+    int index,
+    int width,
+    int height,
+    int lineSize,
+    GLenum format,
+    const uint8_t* data)
+{
+    if (!d->supportsPixelBufferObjects || height <= 0)
+    {
+        d->gl->glTexSubImage2D(
+            GL_TEXTURE_2D, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, data);
+        return;
+    }
+
+    if (picture->m_pbo.size() <= (size_t) index)
+        picture->m_pbo.resize(index + 1);
+
+    auto& pbo = picture->m_pbo[index];
+    if (pbo.id == std::numeric_limits<GLuint>::max())
+        d->gl->glGenBuffers(1, &pbo.id);
+
+    // Every picture of the queue has its own buffers, and the new storage is allocated for each
+    // upload, so the driver never waits for the previous copy from the buffer to complete.
+    pbo.sizeBytes = (size_t) lineSize * (height - 1) + width;
+    d->gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo.id);
+    d->gl->glBufferData(GL_PIXEL_UNPACK_BUFFER, pbo.sizeBytes, data, GL_STREAM_DRAW);
+
+    // The texture is filled from the buffer by the GPU asynchronously.
+    d->gl->glTexSubImage2D(
+        GL_TEXTURE_2D, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, nullptr);
+    d->gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+std::chrono::microseconds DecodedPictureToOpenGLUploader::lastUploadDuration() const
+{
+    return m_lastUploadDuration;
+}
+
 bool DecodedPictureToOpenGLUploader::usingShaderYuvToRgb() const
 {
     return d->usingShaderYuvToRgb();
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <QSharedPointer>
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <memory>
 #include <set>
@@ -220,6 +222,10 @@ public:
         UploadedPicture* const dest, const CLConstVideoDecoderOutputPtr& frame);
     bool renderVideoMemory(
         UploadedPicture* const dest, const CLConstVideoDecoderOutputPtr& frame);
+
+    //!Returns time spent by the last \a uploadDataToGl call
+    std::chrono::microseconds lastUploadDuration() const;
+
 private:
     friend class QnGlRendererTexture;
     friend class DecodedPicturesDeleter;
@@ -246,6 +252,7 @@ private:
     QSurface* m_initializedSurface = nullptr;
 
     nx::vms::api::ImageCorrectionData m_imageCorrection;
+    std::atomic<std::chrono::microseconds> m_lastUploadDuration{};
 
     bool usingShaderYuvToRgb() const;
     bool usingShaderNV12ToRgb() const;
@@ -258,6 +265,16 @@ private:
     //!m_mutex MUST be locked before this call
     void cancelUploadingInGUIThread();
 
+    //!Loads plane \a index of \a picture to the bound texture, through a pixel buffer if supported
+    void uploadPlane(
+        UploadedPicture* const picture,
+        int index,
+        int width,
+        int height,
+        int lineSize,
+        GLenum format,
+        const uint8_t* data);
+
     uchar* convertYuvToRgb(
         const AVPixelFormat format,
         const unsigned int width,
@@ -672,9 +672,16 @@ void QnMediaResourceWidget::initRenderer()
 void QnMediaResourceWidget::initDisplay()
 {
     const auto zoomTargetWidget = dynamic_cast<QnMediaResourceWidget *>(this->zoomTargetWidget());
-    setDisplay(zoomTargetWidget
-        ? zoomTargetWidget->display()
-        : QnResourceDisplayPtr(new QnResourceDisplay(d->resource)));
+    if (zoomTargetWidget)
+    {
+        setDisplay(zoomTargetWidget->display());
+        return;
+    }
+
+    auto display = windowContext()->display()->takePrefetchedDisplay(d->resource);
+    if (!display)
+        display.reset(new QnResourceDisplay(d->resource));
+    setDisplay(display);
 }
 
 void QnMediaResourceWidget::initBlurMask()
@@ -1661,6 +1668,7 @@ void QnMediaResourceWidget::ensureMotionSelectionCache()
         path.addRegion(m_motionSelection[i]);
         m_motionSelectionPathCache[i] = path.simplified();
     }
+    m_motionSelectionCacheValid = true;
 }
 
 void QnMediaResourceWidget::invalidateMotionSelectionCache()
@@ -1888,76 +1896,28 @@ void QnMediaResourceWidget::paintEffects(QPainter* painter)
 
 void QnMediaResourceWidget::paintMotionGrid(QPainter *painter, int channel, const QRectF &rect, const QnMetaDataV1Ptr &motion)
 {
-    // 5-7 fps
-
-    qreal xStep = rect.width() / MotionGrid::kWidth;
-    qreal yStep = rect.height() / MotionGrid::kHeight;
-
-    QVector<QPointF> gridLines[2];
+    if (!NX_ASSERT(channel < m_motionGridLinesCache.size()))
+        return;
 
+    // The lines are rebuilt only when the motion changes, most of the repaints reuse them.
+    auto& lines = m_motionGridLinesCache[channel];
     if (motion && motion->channelNumber == (quint32)channel)
-    {
-        // 2-3 fps
-
-        motion->removeMotion(reinterpret_cast<const simd128i*>(d->motionSkipMask(channel)));
-
-        /* Horizontal lines. */
-        for (int y = 1; y < MotionGrid::kHeight; ++y)
-        {
-            bool isMotion = motion->isMotionAt(0, y - 1) || motion->isMotionAt(0, y);
-            gridLines[isMotion] << QPointF(0, y * yStep);
-            int x = 1;
-            while (x < MotionGrid::kWidth)
-            {
-                while (x < MotionGrid::kWidth && isMotion == (motion->isMotionAt(x, y - 1) || motion->isMotionAt(x, y)))
-                    x++;
-                gridLines[isMotion] << QPointF(x * xStep, y * yStep);
-                if (x < MotionGrid::kWidth)
-                {
-                    isMotion = !isMotion;
-                    gridLines[isMotion] << QPointF(x * xStep, y * yStep);
-                }
-            }
-        }
-
-        /* Vertical lines. */
-        for (int x = 1; x < MotionGrid::kWidth; ++x)
-        {
-            bool isMotion = motion->isMotionAt(x - 1, 0) || motion->isMotionAt(x, 0);
-            gridLines[isMotion] << QPointF(x * xStep, 0);
-            int y = 1;
-            while (y < MotionGrid::kHeight)
-            {
-                while (y < MotionGrid::kHeight && isMotion == (motion->isMotionAt(x - 1, y) || motion->isMotionAt(x, y)))
-                    y++;
-                gridLines[isMotion] << QPointF(x * xStep, y * yStep);
-                if (y < MotionGrid::kHeight)
-                {
-                    isMotion = !isMotion;
-                    gridLines[isMotion] << QPointF(x * xStep, y * yStep);
-                }
-            }
-        }
-    }
+        lines.update(motion->data(), d->motionSkipMask(channel));
     else
-    {
-        for (int x = 1; x < MotionGrid::kWidth; ++x)
-            gridLines[0] << QPointF(x * xStep, 0.0) << QPointF(x * xStep, rect.height());
-        for (int y = 1; y < MotionGrid::kHeight; ++y)
-            gridLines[0] << QPointF(0.0, y * yStep) << QPointF(rect.width(), y * yStep);
-    }
+        lines.update(nullptr);
 
     QnScopedPainterTransformRollback transformRollback(painter);
     painter->translate(rect.topLeft());
+    painter->scale(rect.width() / MotionGrid::kWidth, rect.height() / MotionGrid::kHeight);
 
     QnScopedPainterPenRollback penRollback(painter);
     painter->setPen(QPen(
         nx::vms::client::core::colorTheme()->color("camera.motionGrid.background"), 0.0));
-    painter->drawLines(gridLines[0]);
+    painter->drawLines(lines.backgroundLines());
 
     painter->setPen(QPen(
         nx::vms::client::core::colorTheme()->color("camera.motionGrid.foreground"), 0.0));
-    painter->drawLines(gridLines[1]);
+    painter->drawLines(lines.motionLines());
 }
 
 void QnMediaResourceWidget::paintFilledRegionPath(QPainter *painter, const QRectF &rect, const QPainterPath &path, const QColor &color, const QColor &penColor)
@@ -2173,6 +2133,8 @@ void QnMediaResourceWidget::channelLayoutChangedNotify()
 
     m_motionSelection.resize(channelCount());
     m_motionSelectionPathCache.resize(channelCount());
+    m_motionGridLinesCache.resize(channelCount());
+    invalidateMotionSelectionCache();
     m_paintedChannels.resize(channelCount());
     updateAspectRatio();
 }
@@ -2358,6 +2320,15 @@ QString QnMediaResourceWidget::calculateDetailsText() const
             .arg(actualResolution.width())
             .arg(actualResolution.height()));
         addDetailsString(QString("%1fps").arg(fps, 0, 'f', 2));
+
+        if (ini().developerMode)
+        {
+            microseconds uploadDuration{0};
+            for (int i = 0; i < channelCount(); ++i)
+                uploadDuration = std::max(uploadDuration, m_renderer->lastUploadDuration(i));
+            const auto uploadMs = duration<double, std::milli>(uploadDuration).count();
+            addDetailsString(QString("Upload %1ms").arg(uploadMs, 0, 'f', 2));
+        }
     }
 
     const QString bandwidthString = QString("%1Mbps").arg(mbps, 0, 'f', 2);
@@ -2947,8 +2918,14 @@ void QnMediaResourceWidget::at_ioModuleButton_toggled(bool /*checked*/)
 
 void QnMediaResourceWidget::at_renderWatcher_widgetChanged(QnResourceWidget *widget)
 {
-    if (widget == this)
-        updateRendererEnabled();
+    if (widget != this)
+        return;
+
+    // The widget which is not painted, e.g. when the main window is hidden, decodes the key
+    // frames only.
+    m_renderer->setDisplaying(
+        windowContext()->resourceWidgetRenderWatcher()->isDisplaying(this));
+    updateRendererEnabled();
 }
 
 void QnMediaResourceWidget::at_zoomRectChanged()
@@ -25,6 +25,7 @@
 #include <nx/vms/client/core/camera/iomodule/io_module_monitor.h>
 #include <nx/vms/client/core/common/data/motion_selection.h>
 #include <nx/vms/client/core/media/abstract_analytics_metadata_provider.h>
+#include <nx/vms/client/core/motion/motion_grid_lines.h>
 #include <nx/vms/client/core/resource/resource_fwd.h>
 #include <nx/vms/client/desktop/camera/camera_fwd.h>
 #include <nx/vms/client/desktop/help/help_topic.h>
@@ -486,6 +487,9 @@ private:
     /** Painter path cache for the list of selected regions. */
     QVector<QPainterPath> m_motionSelectionPathCache;
 
+    /** Motion grid overlay lines by channel. */
+    QVector<nx::vms::client::core::MotionGridLines> m_motionGridLinesCache;
+
     QVector<bool> m_paintedChannels;
 
     /** Whether motion selection cached paths are valid. */
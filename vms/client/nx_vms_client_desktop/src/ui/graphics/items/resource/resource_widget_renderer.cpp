@@ -200,6 +200,12 @@ bool QnResourceWidgetRenderer::isHardwareDecoderUsed(int channel) const
     return ctx.renderer && ctx.renderer->isHardwareDecoderUsed();
 }
 
+microseconds QnResourceWidgetRenderer::lastUploadDuration(int channel) const
+{
+    const auto& ctx = m_renderingContexts[channel];
+    return ctx.uploader ? ctx.uploader->lastUploadDuration() : 0us;
+}
+
 microseconds QnResourceWidgetRenderer::lastDisplayedTimestamp(int channel) const
 {
     if (m_renderingContexts.size() <= channel)
@@ -277,11 +283,30 @@ void QnResourceWidgetRenderer::setDisplayedRect(int channel, const QRectF& rect)
         return;
 
     auto& ctx = m_renderingContexts[channel];
-    ctx.displayRect = rect;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        ctx.displayRect = rect;
+    }
     if (ctx.renderer)
         ctx.renderer->setDisplayedRect(rect);
 }
 
+qreal QnResourceWidgetRenderer::visibleFraction(int channel) const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (!m_displaying || channel >= m_renderingContexts.size())
+        return 0.0;
+
+    const auto& ctx = m_renderingContexts[channel];
+    return ctx.renderingEnabled ? ctx.displayRect.width() * ctx.displayRect.height() : 0.0;
+}
+
+void QnResourceWidgetRenderer::setDisplaying(bool value)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_displaying = value;
+}
+
 void QnResourceWidgetRenderer::setPaused(bool value)
 {
     for (const auto& ctx: m_renderingContexts)
@@ -130,6 +130,9 @@ public:
     bool isLowQualityImage(int channel) const;
     bool isHardwareDecoderUsed(int channel) const;
 
+    /** Time spent to upload the last decoded frame of the channel to the textures. */
+    std::chrono::microseconds lastUploadDuration(int channel) const;
+
     std::chrono::microseconds lastDisplayedTimestamp(int channel) const;
 
     QSize sourceSize() const;
@@ -141,6 +144,16 @@ public:
 
     void setDisplayedRect(int channel, const QRectF& rect);
 
+    /**
+     * Part of the channel area which is visible on the screen, in range [0..1]. Zero if the
+     * channel is not rendered or the widget is not displayed. Used by the decoding thread to skip
+     * decoding of the frames which are not seen.
+     */
+    qreal visibleFraction(int channel) const;
+
+    /** Whether the widget is actually painted on the screen. True by default. */
+    void setDisplaying(bool value);
+
     bool isEnabled(int channel) const;
 
     /*!
@@ -190,6 +203,8 @@ private:
     /** Mutex that is used for synchronization. */
     mutable nx::Mutex m_mutex;
 
+    bool m_displaying = true;
+
     /** Current screen size of a single channel, in pixels. */
     QSize m_channelScreenSize;
 
@@ -54,8 +54,26 @@ QnWorkbenchContext::QnWorkbenchContext(
     connect(m_userWatcher, &nx::vms::client::core::UserWatcher::userChanged, this,
         [this](const QnUserResourcePtr& user)
         {
+            using nx::vms::client::core::ResourceIdentificationThumbnail;
+            using nx::vms::client::core::ThumbnailCache;
+
+            // The cached thumbnails are kept on the disk per System and User, as the other User
+            // may have no access to them.
+            const auto systemId = this->systemContext()->localSystemId();
+            const auto persistentDirectory =
+                [&](const QString& cacheName)
+                {
+                    return user && !systemId.isNull()
+                        ? ThumbnailCache::persistentDirectory(systemId, user->getId(), cacheName)
+                        : QString();
+                };
+
             LiveCameraThumbnail::thumbnailCache()->clear();
-            nx::vms::client::core::ResourceIdentificationThumbnail::thumbnailCache()->clear();
+            LiveCameraThumbnail::thumbnailCache()->setPersistentDirectory(
+                persistentDirectory("live"));
+            ResourceIdentificationThumbnail::thumbnailCache()->clear();
+            ResourceIdentificationThumbnail::thumbnailCache()->setPersistentDirectory(
+                persistentDirectory("identification"));
             emit userChanged(user);
         });
 
@@ -1091,6 +1091,18 @@ QnCamDisplay* QnWorkbenchDisplay::camDisplay(QnWorkbenchItem* item) const
     return camera->getCamDisplay();
 }
 
+void QnWorkbenchDisplay::setPrefetchedDisplays(const QList<QnResourceDisplayPtr>& displays)
+{
+    m_prefetchedDisplays.clear();
+    for (const auto& display: displays)
+        m_prefetchedDisplays.insert(display->resource(), display);
+}
+
+QnResourceDisplayPtr QnWorkbenchDisplay::takePrefetchedDisplay(const QnResourcePtr& resource)
+{
+    return m_prefetchedDisplays.take(resource);
+}
+
 // -------------------------------------------------------------------------- //
 // QnWorkbenchDisplay :: mutators
 // -------------------------------------------------------------------------- //
@@ -174,6 +174,16 @@ public:
 
     QnCamDisplay *camDisplay(QnWorkbenchItem *item) const;
 
+    /**
+     * Sets the displays opened in advance, e.g. for the next Showreel layout. They are taken by
+     * the widgets created for the same resources. The previously set displays which were not
+     * taken are released.
+     */
+    void setPrefetchedDisplays(const QList<QnResourceDisplayPtr>& displays);
+
+    /** @return Display opened in advance for the resource, or null if there is none. */
+    QnResourceDisplayPtr takePrefetchedDisplay(const QnResourcePtr& resource);
+
     /**
      * \param item                      Item to get enclosing geometry for.
      * \returns                         Given item's enclosing geometry in scene
@@ -389,6 +399,9 @@ private:
     /** Resource to widget mapping. */
     QHash<QnResourcePtr, QList<QnResourceWidget *> > m_widgetsByResource;
 
+    /** Displays opened in advance, which are not taken by the widgets yet. */
+    QMultiHash<QnResourcePtr, QnResourceDisplayPtr> m_prefetchedDisplays;
+
     /** Widget to zoom target widget mapping. */
     QHash<QnResourceWidget *, QnResourceWidget *> m_zoomTargetWidgetByWidget;
 
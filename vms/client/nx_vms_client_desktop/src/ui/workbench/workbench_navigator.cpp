@@ -1973,6 +1973,34 @@ void QnWorkbenchNavigator::updateCurrentPeriods(Qn::TimePeriodContent type)
         m_calendar->setTimePeriods(type, periods);
 }
 
+void QnWorkbenchNavigator::updateCurrentPeriods(Qn::TimePeriodContent type, qint64 startTimeMs)
+{
+    const auto loader = loaderByWidget(m_currentMediaWidget);
+    if (!loader || !m_timeSlider || startTimeMs <= 0 || startTimeMs == DATETIME_NOW
+        || (type == Qn::MotionContent
+            && !m_currentMediaWidget->options().testFlag(QnResourceWidget::DisplayMotion)))
+    {
+        updateCurrentPeriods(type);
+        return;
+    }
+
+    // The loader has overwritten its periods since the start time with the received ones, which
+    // are the periods ending after the start time.
+    const auto& periods = loader->periods(type);
+    auto tailIt = std::upper_bound(periods.cbegin(), periods.cend(), startTimeMs);
+    if (tailIt != periods.cbegin()
+        && (std::prev(tailIt)->isInfinite() || std::prev(tailIt)->endTimeMs() > startTimeMs))
+    {
+        --tailIt;
+    }
+
+    QnTimePeriodList tail;
+    tail.assign(tailIt, periods.cend());
+    m_timeSlider->updateTimePeriods(CurrentLine, type, tail, startTimeMs);
+    if (m_calendar)
+        m_calendar->setTimePeriods(type, periods);
+}
+
 void QnWorkbenchNavigator::resetSyncedPeriods()
 {
     for (int i = 0; i < Qn::TimePeriodContentCount; i++)
@@ -2649,7 +2677,7 @@ void QnWorkbenchNavigator::updatePeriods(
 
     if (isCurrent)
     {
-        updateCurrentPeriods(type);
+        updateCurrentPeriods(type, startTimeMs);
         if (type == Qn::RecordingContent)
             updateThumbnailsLoader();
     }
@@ -216,6 +216,9 @@ protected slots:
     void updateCurrentPeriods();
     void updateCurrentPeriods(Qn::TimePeriodContent type);
 
+    /** Applies only the periods of the current loader, which are changed since the start time. */
+    void updateCurrentPeriods(Qn::TimePeriodContent type, qint64 startTimeMs);
+
     /** Clean synced line. */
     void resetSyncedPeriods();
 
@@ -449,6 +449,47 @@ TEST_F(EntityItemModelTest, correctMoveNotificationsForListOfTwoItems)
         .verifyIsEmpty();
 }
 
+TEST_F(EntityItemModelTest, batchedChangesProduceNotificationPerRange)
+{
+    TestItemPool itemPool;
+    for (int key = 0; key < 10; ++key)
+        itemPool.setItemName(key, QString("Item_%1").arg(key));
+
+    auto sortedList = std::make_unique<UniqueKeyListEntity<int>>(
+        itemPool.itemCreator(), numericOrder());
+
+    sortedList->setItems({0, 2, 4, 6});
+
+    auto notificationRecorder = std::make_unique<EntityLoggingNotificationListener>();
+    auto queueChecker = notificationRecorder->queueChecker();
+    sortedList->setNotificationObserver(std::move(notificationRecorder));
+
+    // 1. Items added in arbitrary order, present item is ignored.
+    ASSERT_EQ(sortedList->addItems({9, 1, 7, 4, 3, 8}), 5);
+    ASSERT_EQ(getItemNames(sortedList.get()), QStringList({"Item_0", "Item_1", "Item_2",
+        "Item_3", "Item_4", "Item_6", "Item_7", "Item_8", "Item_9"}));
+
+    // 2. Absent item is ignored.
+    ASSERT_EQ(sortedList->removeItems({8, 0, 4, 5, 1, 9}), 5);
+    ASSERT_EQ(getItemNames(sortedList.get()), QStringList({"Item_2", "Item_3", "Item_6",
+        "Item_7"}));
+
+    SCOPED_TRACE("");
+
+    using Record = NotificationRecord;
+
+    queueChecker.withAnnotation("1. Items added")
+        .verifyNotification(Record::beginInsertRows(1, 1)).withClosing()
+        .verifyNotification(Record::beginInsertRows(3, 3)).withClosing()
+        .verifyNotification(Record::beginInsertRows(6, 8)).withClosing();
+
+    queueChecker.withAnnotation("2. Items removed")
+        .verifyNotification(Record::beginRemoveRows(7, 8)).withClosing()
+        .verifyNotification(Record::beginRemoveRows(4, 4)).withClosing()
+        .verifyNotification(Record::beginRemoveRows(0, 1)).withClosing()
+        .verifyIsEmpty();
+}
+
 // Disabled since it doesn't test something particular, more like poor man's benchmark.
 TEST_F(EntityItemModelTest, DISABLED_modelWithNoOrderAddRenameRemove20000TimesEach)
 {
@@ -37,6 +37,13 @@ public:
 
     virtual bool isBuffering() const override { return buffering; }
 
+    virtual std::chrono::microseconds decodeDuration() const override
+    {
+        return decodeDurationValue;
+    }
+
+    virtual qint64 bitrateBitsPerSecond() const override { return bitrateValue; }
+
     virtual void setCallbackForStreamChanges(std::function<void()> callback) override;
 
 // Data members to access from test environment.
@@ -58,6 +65,8 @@ public:
     bool paused = false;
     bool mediaPaused = false;
     bool buffering = false;
+    std::chrono::microseconds decodeDurationValue{0};
+    qint64 bitrateValue = 0;
     void executeStreamChangedCallback();
 
 private:
@@ -134,6 +134,39 @@ TEST_F(RadassControllerTest, CheckDataStarvationToLQ)
     ASSERT_EQ(cameras[1]->qualityValue, MEDIA_Quality_Low);
 }
 
+// Check that the smallest item goes to LQ while the decoding load exceeds the budget.
+TEST_F(RadassControllerTest, DecodingLoadOverBudgetToLQ)
+{
+    givenCameras(/*count*/ 2);
+    controller->setResourceBudget({.decodingCores = 1.0});
+    cameras[1]->maxScreenSize = {1280, 720};
+
+    const auto passIterationWithLoad =
+        [this](microseconds firstLoad, microseconds secondLoad)
+        {
+            // Each iteration passes one second, so the load is a share of one CPU core.
+            cameras[0]->decodeDurationValue += firstLoad;
+            cameras[1]->decodeDurationValue += secondLoad;
+            passIteration();
+        };
+
+    for (int i = 0; i < 20; ++i)
+        passIterationWithLoad(750ms, 750ms);
+    ASSERT_EQ(cameras[0]->qualityValue, MEDIA_Quality_High);
+    ASSERT_EQ(cameras[1]->qualityValue, MEDIA_Quality_Low);
+
+    // The estimated load of the item in HQ does not fit the budget, so the item stays in LQ.
+    for (int i = 0; i < 20; ++i)
+        passIterationWithLoad(750ms, 200ms);
+    ASSERT_EQ(cameras[0]->qualityValue, MEDIA_Quality_High);
+    ASSERT_EQ(cameras[1]->qualityValue, MEDIA_Quality_Low);
+
+    for (int i = 0; i < 20; ++i)
+        passIterationWithLoad(50ms, 100ms);
+    ASSERT_EQ(cameras[0]->qualityValue, MEDIA_Quality_High);
+    ASSERT_EQ(cameras[1]->qualityValue, MEDIA_Quality_High);
+}
+
 // Tests from JIRA (Meta FT-390)
 // Current state: Implementation is stopped due to inconsistencies
 // between specifications, actual RADASS code and test case descriptions.
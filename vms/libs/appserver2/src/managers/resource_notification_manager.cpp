@@ -2,6 +2,8 @@
 
 #include "resource_notification_manager.h"
 
+#include <QtCore/QMetaMethod>
+
 #include <core/resource_management/resource_pool.h>
 #include <nx_ec/data/api_conversion_functions.h>
 
@@ -20,6 +22,7 @@ void QnResourceNotificationManager::triggerNotification(
     NotificationSource source)
 {
     NX_VERBOSE(this, "%1 Emit statusChanged signal for resource %2", Q_FUNC_INFO, tran.params.id);
+    emitPendingParams();
     emit statusChanged(nx::Uuid(tran.params.id), tran.params.status, source);
 }
 
@@ -40,9 +43,14 @@ void QnResourceNotificationManager::triggerNotification(
     NotificationSource source)
 {
     if (tran.command == ApiCommand::setResourceParam)
-        emit resourceParamChanged(tran.params, source);
+    {
+        emitResourceParamChanged(tran.params, source);
+    }
     else if (tran.command == ApiCommand::removeResourceParam)
+    {
+        emitPendingParams();
         emit resourceParamRemoved(tran.params);
+    }
 }
 
 void QnResourceNotificationManager::triggerNotification(
@@ -52,9 +60,14 @@ void QnResourceNotificationManager::triggerNotification(
     for (const auto& param: tran.params)
     {
         if (tran.command == ApiCommand::setResourceParams)
-            emit resourceParamChanged(param, source);
+        {
+            emitResourceParamChanged(param, source);
+        }
         else if (tran.command == ApiCommand::removeResourceParams)
+        {
+            emitPendingParams();
             emit resourceParamRemoved(param);
+        }
     }
 }
 
@@ -62,6 +75,7 @@ void QnResourceNotificationManager::triggerNotification(
     const QnTransaction<vms::api::IdData>& tran,
     NotificationSource source)
 {
+    emitPendingParams();
     if (tran.command == ApiCommand::removeResourceStatus)
         emit resourceStatusRemoved(tran.params.id, source);
     else
@@ -72,8 +86,52 @@ void QnResourceNotificationManager::triggerNotification(
     const QnTransaction<vms::api::IdDataList>& tran,
     NotificationSource source)
 {
+    emitPendingParams();
     for (const vms::api::IdData& id: tran.params)
         emit resourceRemoved(id.id, source);
 }
 
+void QnResourceNotificationManager::emitResourceParamChanged(
+    const vms::api::ResourceParamWithRefData& param, NotificationSource source)
+{
+    emit resourceParamChanged(param, source);
+
+    static const auto batchedSignal =
+        QMetaMethod::fromSignal(&AbstractResourceNotificationManager::resourceParamsChanged);
+    if (!isSignalConnected(batchedSignal))
+        return;
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (!m_pendingParams.empty() && m_pendingSource != source)
+    {
+        lock.unlock();
+        emitPendingParams();
+        lock.relock();
+    }
+
+    if (m_pendingParams.empty())
+    {
+        m_pendingSource = source;
+        QMetaObject::invokeMethod(this, [this]() { emitPendingParams(); }, Qt::QueuedConnection);
+    }
+    m_pendingParams.push_back(param);
+}
+
+void QnResourceNotificationManager::emitPendingParams()
+{
+    vms::api::ResourceParamWithRefDataList params;
+    NotificationSource source;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        std::swap(params, m_pendingParams);
+        source = m_pendingSource;
+    }
+
+    if (params.empty())
+        return;
+
+    NX_VERBOSE(this, "Emit resourceParamsChanged signal for %1 changes", params.size());
+    emit resourceParamsChanged(params, source);
+}
+
 } // namespace ec2
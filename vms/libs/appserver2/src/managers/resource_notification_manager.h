@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <nx/utils/thread/mutex.h>
 #include <nx/vms/api/data/cleanup_db_data.h>
 #include <nx/vms/api/data/license_overflow_data.h>
 #include <nx/vms/api/data/resource_data.h>
@@ -36,6 +37,18 @@ public:
     void triggerNotification(
         const QnTransaction<nx::vms::api::IdDataList>& tran,
         NotificationSource /*source*/);
+
+private:
+    void emitResourceParamChanged(
+        const nx::vms::api::ResourceParamWithRefData& param, NotificationSource source);
+    void emitPendingParams();
+
+private:
+    nx::Mutex m_mutex;
+
+    /** Changes for the resourceParamsChanged() signal, emitted on the next event loop iteration. */
+    nx::vms::api::ResourceParamWithRefDataList m_pendingParams;
+    NotificationSource m_pendingSource = NotificationSource::Remote;
 };
 
 typedef std::shared_ptr<QnResourceNotificationManager> QnResourceNotificationManagerPtr;
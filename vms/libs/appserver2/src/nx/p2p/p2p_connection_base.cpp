@@ -457,6 +457,11 @@ void ConnectionBase::setState(State state, const QString& reason)
 }
 
 void ConnectionBase::sendMessage(MessageType messageType, const nx::Buffer& data)
+{
+    sendMessage(messageType, data.toRawByteArray());
+}
+
+void ConnectionBase::sendMessage(MessageType messageType, const QByteArray& data)
 {
     if (remotePeer().isClient())
         NX_ASSERT(messageType == MessageType::pushTransactionData);
@@ -467,16 +472,12 @@ void ConnectionBase::sendMessage(MessageType messageType, const nx::Buffer& data
             || messageType == MessageType::subscribeAll);
     }
 
-    nx::Buffer buffer;
-    buffer.reserve(data.size() + 1);
-    buffer.append((char) messageType);
-    buffer.append(data);
-    sendMessage(buffer);
-}
-
-void ConnectionBase::sendMessage(MessageType messageType, const QByteArray& data)
-{
-    sendMessage(messageType, nx::Buffer(data));
+    // The data may be shared by the connections, so it is copied to the message once.
+    QByteArray message;
+    message.reserve(data.size() + 1);
+    message.append((char) messageType);
+    message.append(data);
+    sendMessage(nx::Buffer(std::move(message)));
 }
 
 MessageType ConnectionBase::getMessageType(const nx::Buffer& buffer, bool isClient) const
@@ -578,6 +579,8 @@ void ConnectionBase::onMessageSent(SystemError::ErrorCode errorCode, size_t byte
     m_dataToSend.pop_front();
     if (!m_dataToSend.empty())
     {
+        mergeQueuedTransactions();
+
         quint8 messageType = (quint8) getMessageType(m_dataToSend.front(), remotePeer().isClient());
         m_sendCounters[messageType] += m_dataToSend.front().size();
 
@@ -591,6 +594,49 @@ void ConnectionBase::onMessageSent(SystemError::ErrorCode errorCode, size_t byte
     }
 }
 
+void ConnectionBase::mergeQueuedTransactions()
+{
+#if !defined(CHECK_SEQUENCE)
+    // The list messages are handled by the Servers only, as the sequence of the separate
+    // messages. The Cloud and the Clients receive each transaction in its own message.
+    if (!remotePeer().isServer() || remotePeer().dataFormat != Qn::SerializationFormat::ubjson)
+        return;
+
+    static constexpr size_t kMaxListSize = 1024 * 1024;
+
+    size_t count = 0;
+    size_t listSize = 0;
+    for (; count < m_dataToSend.size(); ++count)
+    {
+        const auto& message = m_dataToSend.at(count);
+        if (getMessageType(message, /*isClient*/ false) != MessageType::pushTransactionData
+            || listSize + message.size() > kMaxListSize)
+        {
+            break;
+        }
+        listSize += message.size();
+    }
+
+    if (count < 2)
+        return;
+
+    QList<QByteArray> transactions;
+    transactions.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& message = m_dataToSend.at(i);
+        transactions.push_back(QByteArray::fromRawData(message.data() + 1, message.size() - 1));
+    }
+
+    auto list = serializeTransactionList(transactions, /*reservedSpaceAtFront*/ 1);
+    list.data()[0] = (quint8) MessageType::pushTransactionList;
+    NX_VERBOSE(this, "Merged %1 queued transactions for peer %2, size: %3",
+        count, remotePeer().id, list.size());
+
+    m_dataToSend.replaceFront(count, nx::Buffer(std::move(list)));
+#endif
+}
+
 void ConnectionBase::transactionSkipped()
 {
     if (m_dataToSend.empty())
@@ -262,7 +262,17 @@ private:
             m_queue.pop_front();
         }
 
+        /** Replaces the first count items with the data. */
+        void replaceFront(size_t count, nx::Buffer data)
+        {
+            for (size_t i = 0; i < count; ++i)
+                pop_front();
+            m_dataSize += data.size();
+            m_queue.push_front(std::move(data));
+        }
+
         const nx::Buffer& front() const { return m_queue.front(); }
+        const nx::Buffer& at(size_t index) const { return m_queue[index]; }
         size_t dataSize() const { return m_dataSize; }
         size_t size() const { return m_queue.size(); }
         bool empty() const { return m_queue.empty(); }
@@ -272,6 +282,13 @@ private:
         std::atomic<size_t> m_dataSize = 0;
     };
 
+    /**
+     * Merges the transaction data messages at the front of the send queue into one transaction
+     * list message. The messages accumulate in the queue while the previous one is being sent,
+     * e.g. during the resynchronization, so they are sent in one frame without a delay.
+     */
+    void mergeQueuedTransactions();
+
     Dequeue m_dataToSend;
     nx::Buffer m_readBuffer;
 
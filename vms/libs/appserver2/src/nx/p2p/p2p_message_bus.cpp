@@ -920,7 +920,8 @@ template<class T>
 void MessageBus::sendTransactionImpl(
     const P2pConnectionPtr& connection,
     const ec2::QnTransaction<T>& srcTran,
-    TransportHeader transportHeader)
+    TransportHeader transportHeader,
+    SerializedTransaction* serialized)
 {
     NX_ASSERT(srcTran.command != ApiCommand::NotDefined);
 
@@ -949,6 +950,7 @@ void MessageBus::sendTransactionImpl(
     const auto context = this->context(connection);
 
     ec2::QnTransaction<T> modifiedTran;
+    bool isAmended = false;
     if (connection->remotePeer().isClient())
     {
         modifiedTran = srcTran;
@@ -960,10 +962,16 @@ void MessageBus::sendTransactionImpl(
             // Make persistent info null in case if data has been amended. We don't want such
             // transactions be checked against serialized transactions cache.
             modifiedTran.persistentInfo = ec2::QnAbstractTransaction::PersistentInfo();
+            isAmended = true;
         }
     }
     const ec2::QnTransaction<T>& tran(connection->remotePeer().isClient() ? modifiedTran : srcTran);
 
+    // The amended transaction is specific to the user of the connection, so it is not shared.
+    SerializedTransaction ownSerialized;
+    if (!serialized || isAmended)
+        serialized = &ownSerialized;
+
     if (connection->remotePeer().isServer())
     {
         if (descriptor->isPersistent)
@@ -1040,33 +1048,37 @@ void MessageBus::sendTransactionImpl(
     switch (connection->remotePeer().dataFormat)
     {
     case Qn::SerializationFormat::json:
-        connection->sendTransaction(
-            tran,
-            m_jsonTranSerializer->serializedTransactionWithoutHeader(tran) + QByteArray("\r\n"));
-        break;
-    case Qn::SerializationFormat::ubjson:
-        if (connection->remotePeer().isClient())
+        if (!serialized->json)
         {
-            connection->sendTransaction(
-                tran,
-                m_ubjsonTranSerializer->serializedTransactionWithoutHeader(tran));
+            serialized->json =
+                m_jsonTranSerializer->serializedTransactionWithoutHeader(tran) + QByteArray("\r\n");
         }
-        else if (descriptor->isPersistent)
-        {
-            connection->sendTransaction(
-                tran,
-                MessageType::pushTransactionData,
-                m_ubjsonTranSerializer->serializedTransactionWithoutHeader(tran));
-        }
-        else
+        connection->sendTransaction(tran, *serialized->json);
+        break;
+    case Qn::SerializationFormat::ubjson:
+        if (!descriptor->isPersistent && !connection->remotePeer().isClient())
         {
-            TransportHeader header(transportHeader);
-            header.via.insert(localPeer().id);
+            if (!serialized->ubjsonWithHeader)
+            {
+                TransportHeader header(transportHeader);
+                header.via.insert(localPeer().id);
+                serialized->ubjsonWithHeader =
+                    m_ubjsonTranSerializer->serializedTransactionWithHeader(tran, header);
+            }
             connection->sendTransaction(
                 tran,
                 MessageType::pushImpersistentBroadcastTransaction,
-                m_ubjsonTranSerializer->serializedTransactionWithHeader(tran, header));
+                *serialized->ubjsonWithHeader);
+            break;
         }
+
+        if (!serialized->ubjson)
+            serialized->ubjson = m_ubjsonTranSerializer->serializedTransactionWithoutHeader(tran);
+
+        if (connection->remotePeer().isClient())
+            connection->sendTransaction(tran, *serialized->ubjson);
+        else
+            connection->sendTransaction(tran, MessageType::pushTransactionData, *serialized->ubjson);
         break;
     default:
         qWarning() << "Client has requested data in an unsupported format"
@@ -1589,10 +1601,11 @@ void MessageBus::sendRuntimeInfoRemoved(const vms::api::PeerData& peer)
 {
     QnTransaction<nx::vms::api::IdData> tran(ApiCommand::runtimeInfoRemoved, localPeer().id);
     tran.params.id = peer.id;
+    SerializedTransaction serialized;
     for (const auto& connection: m_connections)
     {
         if (connection->remotePeer().isClient() || peer.peerType == PeerType::videowallClient)
-            sendTransactionImpl(connection, tran, TransportHeader());
+            sendTransactionImpl(connection, tran, TransportHeader(), &serialized);
     }
 }
 
@@ -1635,14 +1648,16 @@ void MessageBus::sendTransaction(const ec2::QnTransaction<vms::api::RuntimeData>
     NX_MUTEX_LOCKER lock(&m_mutex);
     vms::api::PersistentIdData peerId(tran.params.peer);
     m_lastRuntimeInfo[peerId] = tran.params;
+    SerializedTransaction serialized;
     for (const auto& connection: m_connections)
-        sendTransactionImpl(connection, tran, TransportHeader());
+        sendTransactionImpl(connection, tran, TransportHeader(), &serialized);
 }
 
 template<class T>
 void MessageBus::sendTransaction(const ec2::QnTransaction<T>& tran, const TransportHeader& header)
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
+    SerializedTransaction serialized;
     for (const auto& connection: m_connections)
     {
         if (!header.userIds.empty() && connection->remotePeer().isClient()
@@ -1651,7 +1666,7 @@ void MessageBus::sendTransaction(const ec2::QnTransaction<T>& tran, const Transp
             continue;
         }
 
-        sendTransactionImpl(connection, tran, header);
+        sendTransactionImpl(connection, tran, header, &serialized);
     }
 }
 
@@ -1667,8 +1682,9 @@ template<class T>
 void MessageBus::sendTransaction(const ec2::QnTransaction<T>& tran)
 {
     NX_MUTEX_LOCKER lock(&m_mutex);
+    SerializedTransaction serialized;
     for (const auto& connection: m_connections)
-        sendTransactionImpl(connection, tran, TransportHeader());
+        sendTransactionImpl(connection, tran, TransportHeader(), &serialized);
 }
 
 template<class T>
@@ -1810,7 +1826,8 @@ template void MessageBus::sendTransaction(const ec2::QnTransaction<T>&); \
 template void MessageBus::sendTransaction(const ec2::QnTransaction<T>&, const TransportHeader&); \
 template bool MessageBus::sendTransaction(const ec2::QnTransaction<T>&, const vms::api::PeerSet&); \
 template void MessageBus::sendTransactionImpl( \
-    const P2pConnectionPtr&, const ec2::QnTransaction<T>&, TransportHeader);
+    const P2pConnectionPtr&, const ec2::QnTransaction<T>&, TransportHeader, \
+    SerializedTransaction*);
 
 #include <transaction_types.i>
 BOOST_PP_SEQ_FOR_EACH(INSTANTIATE, _, TransactionDataTypes (UserDataEx))
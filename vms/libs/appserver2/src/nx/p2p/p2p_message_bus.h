@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include <QtCore/QTimer>
 
@@ -108,11 +109,24 @@ public:
     virtual ConnectionGuardSharedState* connectionGuardSharedState() override;
 
 protected:
+    /**
+     * The transaction serialized for the connections it is sent to, so a transaction broadcast
+     * to many peers is serialized once per wire format rather than once per peer. All the
+     * connections sharing it are sent the transaction with the same transport header.
+     */
+    struct SerializedTransaction
+    {
+        std::optional<QByteArray> json;
+        std::optional<QByteArray> ubjson;
+        std::optional<QByteArray> ubjsonWithHeader;
+    };
+
     template<class T>
     void sendTransactionImpl(
         const P2pConnectionPtr& connection,
         const ec2::QnTransaction<T>& srcTran,
-        TransportHeader transportHeader);
+        TransportHeader transportHeader,
+        SerializedTransaction* serialized = nullptr);
 
     template<class T>
     bool sendUnicastTransaction(const QnTransaction<T>& tran, const vms::api::PeerSet& dstPeers);
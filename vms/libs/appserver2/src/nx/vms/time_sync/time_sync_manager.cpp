@@ -2,6 +2,9 @@
 
 #include "time_sync_manager.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <api/model/time_reply.h>
 #include <core/resource/media_server_resource.h>
 #include <core/resource_management/resource_pool.h>
@@ -136,14 +139,15 @@ TimeSyncManager::Result TimeSyncManager::loadTimeFromServer(const QnRoute& route
     httpClient->setResponseReadTimeout(std::chrono::milliseconds(maxRtt));
     httpClient->addAdditionalHeader(Qn::SERVER_GUID_HEADER_NAME, route.id.toSimpleStdString());
 
-    nx::utils::ElapsedTimer rttTimer;
-    // With gateway repeat request twice to make sure we have opened tunnel to the target server.
-    // That way it is possible to reduce rtt.
-    const int iterations = route.gatewayId.isNull() ? 1 : 2;
-    std::optional<nx::Buffer> response;
-    for (int i = 0; i < iterations; ++i)
+    // At least two requests: with gateway the first one opens the tunnel to the target server, so
+    // its round trip is longer, and the filter does not select it.
+    const int burstSize = std::max(m_offsetFilter.settings().burstSize, 2);
+    std::vector<ClockOffsetFilter::Sample> samples;
+    SyncTimeData timeData;
+    for (int i = 0; i < burstSize; ++i)
     {
-        rttTimer.restart();
+        const auto sendTime = m_steadyClock->now();
+        std::optional<nx::Buffer> response;
         bool success = httpClient->doGet(url);
         if (success)
             response = httpClient->fetchEntireMessageBody();
@@ -151,42 +155,65 @@ TimeSyncManager::Result TimeSyncManager::loadTimeFromServer(const QnRoute& route
         {
             NX_WARNING(this, "Can't read time from server %1. Error: %2",
                 appContext()->moduleDisplayName(route.id), httpClient->lastSysErrorCode());
+            if (samples.empty())
+                return Result::error;
+            break;
+        }
+        const auto receiveTime = m_steadyClock->now();
+
+        if (httpClient->contentLocationUrl() != httpClient->url())
+        {
+            // In case of client v4.0 connect to the server v3.2 it don't understand this request
+            // and redirect it to the index.html root page instead.
+            NX_DEBUG(this, "Can not synchronized time with incompatible server");
+            return Result::incompatibleServer;
+        }
+
+        auto jsonResult = QJson::deserialized<nx::network::rest::JsonResult>(*response);
+        if (!QJson::deserialize(jsonResult.reply, &timeData))
+        {
+            NX_WARNING(this, "Can't deserialize time reply from server %1",
+                appContext()->moduleDisplayName(route.id));
             return Result::error;
         }
-    }
 
-    if (httpClient->contentLocationUrl() != httpClient->url())
-    {
-        // In case of client v4.0 connect to the server v3.2 it don't understand this request
-        // and redirect it to the index.html root page instead.
-        NX_DEBUG(this, "Can not synchronized time with incompatible server");
-        return Result::incompatibleServer;
-    }
+        if (receiveTime - sendTime > maxRtt)
+            continue; //< Too big rtt.
 
-    auto jsonResult = QJson::deserialized<nx::network::rest::JsonResult>(*response);
-    SyncTimeData timeData;
-    if (!QJson::deserialize(jsonResult.reply, &timeData))
-    {
-        NX_WARNING(this, "Can't deserialize time reply from server %1",
-            appContext()->moduleDisplayName(route.id));
-        return Result::error;
+        samples.push_back({
+            .localSendTime = sendTime,
+            .remoteTime = std::chrono::milliseconds(timeData.utcTimeMs),
+            .localReceiveTime = receiveTime,
+        });
     }
 
-    const std::chrono::milliseconds rtt = rttTimer.elapsed();
-    auto newTime = std::chrono::milliseconds(timeData.utcTimeMs - rtt.count() / 2);
     bool syncWithInternel = systemSettings()->primaryTimeServer().isNull();
     if (syncWithInternel && !timeData.isTakenFromInternet && checkTimeSource)
         return Result::error; //< Target server is not ready yet. Time is not taken from internet yet. Repeat later.
     m_isTimeTakenFromInternet = timeData.isTakenFromInternet;
-    if (rtt > maxRtt)
+    if (samples.empty())
         return Result::error; //< Too big rtt. Try again.
+
+    const auto now = m_steadyClock->now();
+    ClockOffsetFilter::Estimate estimate;
+    double drift = 0;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        for (const auto& sample: samples)
+            m_offsetFilter.addSample(sample);
+        m_offsetFilter.finishPoll();
+        estimate = *m_offsetFilter.estimate(now);
+        drift = m_offsetFilter.drift();
+    }
+
+    const auto newTime = now + estimate.offset;
     const auto ownGuid = peerId();
-    NX_DEBUG(this, "Got time %1 (%2 <-- %3), rtt=%4",
+    NX_DEBUG(this, "Got time %1 (%2 <-- %3), rtt=%4, samples=%5, drift=%6 ppm",
         QDateTime::fromMSecsSinceEpoch(newTime.count()).toString(Qt::ISODate),
         appContext()->moduleDisplayName(ownGuid),
         appContext()->moduleDisplayName(route.id),
-        rtt);
-    if (!setSyncTime(newTime, rtt))
+        estimate.rtt, samples.size(), drift * 1e6);
+    if (!setSyncTime(newTime, estimate.rtt))
     {
         NX_DEBUG(this, "Server %1 ignore new time %2 because of small delta.",
             appContext()->moduleDisplayName(ownGuid),
@@ -229,6 +256,18 @@ std::chrono::milliseconds TimeSyncManager::getSyncTime(bool* outIsTimeTakenFromI
     return m_synchronizedTime + elapsed;
 }
 
+int TimeSyncManager::pollBackoff() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_offsetFilter.pollBackoff();
+}
+
+void TimeSyncManager::resetTimeSamples()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_offsetFilter.reset();
+}
+
 void TimeSyncManager::doPeriodicTasks()
 {
     updateTime();
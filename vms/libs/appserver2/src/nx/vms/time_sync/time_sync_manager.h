@@ -11,6 +11,7 @@
 #include <nx/utils/time.h>
 #include <nx/vms/common/system_context_aware.h>
 #include <nx/vms/time/abstract_time_sync_manager.h>
+#include <nx/vms/time/clock_offset_filter.h>
 
 class AbstractSystemClock
 {
@@ -93,7 +94,8 @@ protected:
     using AbstractStreamSocketPtr = std::unique_ptr<nx::network::AbstractStreamSocket>;
 
     /**
-     * @return time from the VMS Server.
+     * Loads time from the VMS Server by a burst of requests, the offset is taken from the sample
+     * with the smallest round trip, see ClockOffsetFilter.
      * @param route Routing information.
      * @param checkTimeSource If the target server must load time from the Internet but can't do it then
      * it returns local time. Consider this situation as an error if parameter is 'true'.
@@ -106,6 +108,12 @@ protected:
     virtual bool setSyncTime(std::chrono::milliseconds value, std::chrono::milliseconds rtt);
     void setSyncTimeInternal(std::chrono::milliseconds value);
 
+    /** @return Multiplier of the base time polling interval: it grows while the time is stable. */
+    int pollBackoff() const;
+
+    /** Forgets the time samples, e.g. when the time source is changed. */
+    void resetTimeSamples();
+
 private:
     void doPeriodicTasks();
 
@@ -118,6 +126,7 @@ private:
     std::chrono::milliseconds m_synchronizedOnClock{0};
 
     mutable nx::Mutex m_mutex;
+    ClockOffsetFilter m_offsetFilter;
 
     std::unique_ptr<QThread> m_thread = nullptr;
     std::unique_ptr<QTimer> m_timer = nullptr;
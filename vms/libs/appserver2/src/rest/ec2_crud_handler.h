@@ -216,6 +216,23 @@ public:
         return {};
     }
 
+protected:
+    virtual nx::utils::Guard monitorChanges(nx::utils::MoveOnlyFunc<void()> handler) override
+    {
+        auto commands = details::commands<Model>(DeleteCommand);
+        // Changes of the users and their groups may change what the cached responses contain.
+        commands.insert(commands.end(), {
+            ApiCommand::saveUser,
+            ApiCommand::saveUsers,
+            ApiCommand::removeUser,
+            ApiCommand::saveUserGroup,
+            ApiCommand::removeUserGroup});
+        NX_VERBOSE(this, "Add response cache monitor for %1", commands);
+        return m_queryProcessor->addMonitor(
+            [handler = std::move(handler)](const auto& /*transaction*/) { handler(); },
+            std::move(commands));
+    }
+
 protected:
     QueryProcessor* const m_queryProcessor;
 
@@ -1647,11 +1647,10 @@ struct TransactionPersistentInfo
     qint32 sequence = 0;
     nx::vms::api::Timestamp timestamp;
 
-    friend size_t qHash(const TransactionPersistentInfo& id)
+    friend size_t qHash(const TransactionPersistentInfo& id, size_t seed = 0)
     {
-        QByteArray idData(id.dbID.toRfc4122());
-        idData.append((const char*) &id.timestamp, sizeof(id.timestamp));
-        return ::qHash(idData, id.sequence);
+        return qHashMulti(
+            seed, id.dbID, id.sequence, id.timestamp.sequence, id.timestamp.ticks);
     }
 
     bool operator==(const TransactionPersistentInfo& other) const
@@ -2,6 +2,9 @@
 
 #include "transaction_descriptor.h"
 
+#include <unordered_map>
+#include <vector>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCryptographicHash>
 #include <QtCore/QSet>
@@ -3161,8 +3164,51 @@ Result canModifyStorage(SystemContext* systemContext, const CanModifyStorageData
 
 } // namespace transaction_descriptor
 
+namespace {
+
+/**
+ * Flat lookup tables over detail::transactionDescriptors, used on every processed transaction.
+ * The command values are small, so the descriptors are addressed by the value directly instead
+ * of the ordered search in the multi-index container.
+ */
+struct DescriptorIndex
+{
+    std::vector<detail::TransactionDescriptorBase*> byValue;
+    std::unordered_map<QString, detail::TransactionDescriptorBase*> byName;
+
+    DescriptorIndex()
+    {
+        const auto& descriptors = detail::transactionDescriptors;
+        byValue.resize(descriptors.get<0>().rbegin()->get()->getValue() + 1);
+        byName.reserve(descriptors.size());
+
+        for (const auto& descriptor: descriptors.get<0>())
+        {
+            if (descriptor->getValue() >= 0)
+                byValue[descriptor->getValue()] = descriptor.get();
+        }
+
+        // The name index is non-unique, so the first descriptor with the name wins as in find().
+        for (const auto& descriptor: descriptors.get<1>())
+            byName.emplace(descriptor->getName(), descriptor.get());
+    }
+
+    static const DescriptorIndex& instance()
+    {
+        static const DescriptorIndex index;
+        return index;
+    }
+};
+
+} // namespace
+
 detail::TransactionDescriptorBase *getTransactionDescriptorByValue(ApiCommand::Value v)
 {
+    const auto& byValue = DescriptorIndex::instance().byValue;
+    if (v >= 0 && (size_t) v < byValue.size() && byValue[v])
+        return byValue[v];
+
+    // Negative and unknown values fall back to the container, which reports the missing ones.
     auto it = detail::transactionDescriptors.get<0>().find(v);
     bool isEnd = it == detail::transactionDescriptors.get<0>().end();
     NX_ASSERT(!isEnd, "ApiCommand::Value not found");
@@ -3171,9 +3217,9 @@ detail::TransactionDescriptorBase *getTransactionDescriptorByValue(ApiCommand::V
 
 detail::TransactionDescriptorBase *getTransactionDescriptorByName(const QString& s)
 {
-    auto it = detail::transactionDescriptors.get<1>().find(s);
-    bool isEnd = it == detail::transactionDescriptors.get<1>().end();
-    return isEnd ? nullptr : (*it).get();
+    const auto& byName = DescriptorIndex::instance().byName;
+    const auto it = byName.find(s);
+    return it == byName.end() ? nullptr : it->second;
 }
 
 } // namespace ec2
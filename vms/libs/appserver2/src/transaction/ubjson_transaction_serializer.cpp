@@ -6,11 +6,6 @@ namespace ec2
 {
     size_t qHash(const QnUbjsonTransactionSerializer::CacheKey& id)
     {
-        QByteArray idData(id.persistentInfo.dbID.toRfc4122());
-        idData
-            .append((const char*)&id.persistentInfo.timestamp, sizeof(id.persistentInfo.timestamp))
-            .append((const char*)&id.persistentInfo.sequence, sizeof(id.persistentInfo.sequence));
-
-        return ::qHash(idData, id.command);
+        return qHash(id.persistentInfo, id.command);
     }
 }
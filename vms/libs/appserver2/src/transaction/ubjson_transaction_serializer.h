@@ -2,8 +2,6 @@
 
 #pragma once
 
-#include <memory>
-
 #include <QtCore/QCache>
 
 #include <nx/fusion/serialization/ubjson_functions.h>
@@ -55,15 +53,10 @@ namespace ec2
             if (!tran.persistentInfo.isNull() && m_cache.contains(key))
                 return *m_cache[key];
 
-            std::unique_ptr<QByteArray> serializedTran( new QByteArray() );
-            QnUbjsonWriter<QByteArray> stream(serializedTran.get());
-            QnUbjson::serialize( tran, &stream );
-            QByteArray result = *serializedTran;
+            // Serialized via the per-thread buffer: the result is allocated once, at its size.
+            QByteArray result = QnUbjson::serialized(tran);
             if( !tran.persistentInfo.isNull() )
-            {
-                m_cache.insert( key, serializedTran.get(), serializedTran->size() );
-                serializedTran.release();
-            }
+                m_cache.insert( key, new QByteArray(result), result.size() );
 
             return result;
         }
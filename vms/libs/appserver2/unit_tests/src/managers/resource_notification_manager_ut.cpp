@@ -0,0 +1,80 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include <gtest/gtest.h>
+
+#include <managers/resource_notification_manager.h>
+
+namespace ec2::test {
+
+using namespace nx::vms::api;
+
+namespace {
+
+QnTransaction<ResourceParamWithRefData> makeTransaction(const QString& name)
+{
+    QnTransaction<ResourceParamWithRefData> tran(ApiCommand::setResourceParam, nx::Uuid());
+    tran.params = ResourceParamWithRefData(nx::Uuid::createUuid(), name, "value");
+    return tran;
+}
+
+} // namespace
+
+class ResourceNotificationManagerTest: public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        QObject::connect(&m_manager, &AbstractResourceNotificationManager::resourceParamChanged,
+            [this](const ResourceParamWithRefData&, NotificationSource) { ++m_changedCount; });
+        QObject::connect(&m_manager, &AbstractResourceNotificationManager::resourceParamsChanged,
+            [this](const ResourceParamWithRefDataList& params, NotificationSource source)
+            {
+                m_batches.push_back({params, source});
+            });
+    }
+
+protected:
+    QnResourceNotificationManager m_manager;
+    int m_changedCount = 0;
+    std::vector<std::pair<ResourceParamWithRefDataList, NotificationSource>> m_batches;
+};
+
+TEST_F(ResourceNotificationManagerTest, paramChangesAreBatchedPerEventLoopIteration)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        m_manager.triggerNotification(
+            makeTransaction(QString::number(i)), NotificationSource::Remote);
+    }
+
+    ASSERT_EQ(10, m_changedCount);
+    ASSERT_TRUE(m_batches.empty());
+
+    QCoreApplication::sendPostedEvents();
+    ASSERT_EQ(1, m_batches.size());
+    ASSERT_EQ(10, m_batches[0].first.size());
+    ASSERT_EQ("9", m_batches[0].first.back().name);
+}
+
+TEST_F(ResourceNotificationManagerTest, pendingChangesAreEmittedBeforeOtherNotifications)
+{
+    m_manager.triggerNotification(makeTransaction("local"), NotificationSource::Local);
+    m_manager.triggerNotification(makeTransaction("remote"), NotificationSource::Remote);
+    ASSERT_EQ(1, m_batches.size());
+    ASSERT_EQ(NotificationSource::Local, m_batches[0].second);
+
+    QnTransaction<IdData> removal(ApiCommand::removeResource, nx::Uuid());
+    m_manager.triggerNotification(removal, NotificationSource::Remote);
+    ASSERT_EQ(2, m_batches.size());
+    ASSERT_EQ(NotificationSource::Remote, m_batches[1].second);
+
+    QCoreApplication::sendPostedEvents();
+    ASSERT_EQ(2, m_batches.size());
+}
+
+} // namespace ec2::test
@@ -1,7 +1,13 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <algorithm>
+#include <vector>
+
 #include <core/resource/camera_resource.h>
 #include <core/resource_management/resource_pool.h>
+#include <nx/utils/elapsed_timer.h>
+#include <nx/utils/log/log.h>
+#include <nx/utils/test_support/test_options.h>
 #include <nx/vms/api/data/storage_space_data.h>
 #include <nx/vms/common/resource/camera_resource_stub.h>
 #include <nx/vms/common/system_context.h>
@@ -142,4 +148,35 @@ TEST_F(CanModifyStorageTest, SetUsedForWritingForbiddenForLocalWhenCloudIsActive
     ASSERT_EQ(ErrorCode::forbidden, canModifyStorage(&context, data));
 }
 
+TEST(TransactionDescriptorLookup, descriptorsAreFoundByValueAndName)
+{
+    for (const auto& descriptor: detail::transactionDescriptors)
+    {
+        ASSERT_EQ(descriptor.get(), getTransactionDescriptorByValue(descriptor->getValue()));
+        ASSERT_EQ(descriptor->getValue(),
+            getTransactionDescriptorByName(descriptor->getName())->getValue());
+    }
+    ASSERT_EQ(nullptr, getTransactionDescriptorByName("unknownTransaction"));
+}
+
+TEST(TransactionDescriptorLookup, lookupThroughput)
+{
+    std::vector<ApiCommand::Value> commands;
+    for (const auto& descriptor: detail::transactionDescriptors)
+        commands.push_back(descriptor->getValue());
+    const auto count = nx::TestOptions::applyLoadMode<int>(1'000'000);
+
+    int foundCount = 0;
+    nx::utils::ElapsedTimer timer(nx::utils::ElapsedTimerState::started);
+    for (int i = 0; i < count; ++i)
+    {
+        if (getTransactionDescriptorByValue(commands[i % commands.size()])->isPersistent)
+            ++foundCount;
+    }
+
+    const auto elapsed = timer.elapsed();
+    NX_INFO(NX_SCOPE_TAG, "Looked up %1 descriptors (%2 persistent) in %3, %4 lookups/s",
+        count, foundCount, elapsed, count * 1000 / std::max<qint64>(elapsed.count(), 1));
+}
+
 } // namespace ec2::transaction_descriptor::test
@@ -92,6 +92,14 @@ public:
         const QnConstCompressedVideoDataPtr& compressedVideoData,
         VideoFramePtr* outDecodedFrame) = 0;
 
+    /**
+     * Prepares the flushed decoder to decode a new stream of the same codec, resolution and codec
+     * parameters, keeping its expensive resources (e.g. the hardware session). The frame numbers
+     * returned by decode() start from zero again.
+     * @return False if the decoder does not support reuse and should be destroyed.
+     */
+    virtual bool reset() { return false; }
+
     /**
      * Should be called before other methods. Allows to obtain video window coords for some
      * decoders, e.g. hw-based.
@@ -0,0 +1,101 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "adaptive_quality_estimator.h"
+
+#include <algorithm>
+
+#include <nx/utils/log/format.h>
+
+namespace nx::media {
+
+using namespace std::chrono;
+
+namespace {
+
+/** Weight of the new sample in the moving averages. */
+static constexpr double kSampleWeight = 0.3;
+
+/** The stream is not sustained if the media arrives slower than this part of the playback. */
+static constexpr double kMinSustainedMediaRate = 0.9;
+
+/** The stream is stable if the media arrives at least this fast, with no underflows. */
+static constexpr double kStableMediaRate = 0.97;
+
+/** Number of the bad intervals in a row which make the quality step down. */
+static constexpr int kStepDownIntervalCount = 3;
+
+} // namespace
+
+AdaptiveQualityEstimator::Decision AdaptiveQualityEstimator::addSample(
+    const Sample& sample, bool canStepDown, bool canStepUp)
+{
+    if (sample.elapsed <= milliseconds::zero())
+        return Decision::keep;
+
+    const double seconds = duration<double>(sample.elapsed).count();
+    const double throughputBps = sample.receivedBytes * 8 / seconds;
+    const double mediaRate = duration<double>(sample.receivedMediaDuration).count() / seconds;
+
+    if (m_hasSamples)
+    {
+        m_throughputBps += kSampleWeight * (throughputBps - m_throughputBps);
+        m_mediaRate += kSampleWeight * (mediaRate - m_mediaRate);
+    }
+    else
+    {
+        m_throughputBps = throughputBps;
+        m_mediaRate = mediaRate;
+        m_hasSamples = true;
+    }
+
+    if (m_sinceStepUp)
+        *m_sinceStepUp += sample.elapsed;
+
+    if (sample.underflowCount > 0 || m_mediaRate < kMinSustainedMediaRate)
+    {
+        m_stableTime = milliseconds::zero();
+        if (++m_badIntervalCount < kStepDownIntervalCount || !canStepDown)
+            return Decision::keep;
+
+        // The step up has failed, so the next one is tried later.
+        if (m_sinceStepUp && *m_sinceStepUp < m_stepUpDelay)
+            m_stepUpDelay = std::min<milliseconds>(m_stepUpDelay * 2, kMaxStepUpDelay);
+        m_sinceStepUp.reset();
+        reset();
+        return Decision::stepDown;
+    }
+
+    m_badIntervalCount = 0;
+    if (m_mediaRate < kStableMediaRate)
+        return Decision::keep;
+
+    m_stableTime += sample.elapsed;
+    if (m_sinceStepUp && *m_sinceStepUp >= m_stepUpDelay)
+        m_sinceStepUp.reset(); //< The step up is confirmed.
+
+    if (m_stableTime < m_stepUpDelay || !canStepUp)
+        return Decision::keep;
+
+    m_sinceStepUp = milliseconds::zero();
+    reset();
+    return Decision::stepUp;
+}
+
+void AdaptiveQualityEstimator::reset()
+{
+    m_hasSamples = false;
+    m_throughputBps = 0;
+    m_mediaRate = 0;
+    m_badIntervalCount = 0;
+    m_stableTime = milliseconds::zero();
+}
+
+QString AdaptiveQualityEstimator::toString() const
+{
+    return nx::format("%1 Mbps, media rate %2, step up delay %3 s").args(
+        QString::number(m_throughputBps / 1'000'000, 'f', 2),
+        QString::number(m_mediaRate, 'f', 2),
+        duration_cast<seconds>(m_stepUpDelay).count());
+}
+
+} // namespace nx::media
@@ -0,0 +1,82 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+#include <QtCore/QString>
+
+namespace nx::media {
+
+/**
+ * Estimates whether the connection sustains the stream being played, and decides when the Player
+ * should switch to a lower or a higher quality.
+ *
+ * The estimator is fed periodically with the amount of the received data, the media duration it
+ * covers and the number of the playback buffer underflows. The connection sustains the stream if
+ * the media arrives at least as fast as it is played. To prevent oscillation, a step down requires
+ * several bad intervals in a row, and a step up requires a stable period, which is doubled each
+ * time the stream is stepped down soon after a step up.
+ */
+class NX_MEDIA_API AdaptiveQualityEstimator
+{
+public:
+    enum class Decision
+    {
+        keep,
+        stepDown,
+        stepUp,
+    };
+
+    struct Sample
+    {
+        /** Wall-clock duration of the interval. */
+        std::chrono::milliseconds elapsed{};
+
+        qint64 receivedBytes = 0;
+
+        /** Media duration covered by the received data, divided by the playback speed. */
+        std::chrono::microseconds receivedMediaDuration{};
+
+        int underflowCount = 0;
+    };
+
+    static constexpr std::chrono::seconds kInitialStepUpDelay{30};
+    static constexpr std::chrono::seconds kMaxStepUpDelay{480};
+
+    /**
+     * @param canStepDown Whether a lower quality is available.
+     * @param canStepUp Whether a higher quality is available.
+     */
+    Decision addSample(const Sample& sample, bool canStepDown, bool canStepUp);
+
+    /**
+     * Starts the measurement from scratch, e.g. after the quality switch or the seek. The step up
+     * delay is kept.
+     */
+    void reset();
+
+    /** Exponentially weighted moving average of the received data rate. */
+    double throughputBps() const { return m_throughputBps; }
+
+    /** Exponentially weighted moving average of the received media duration per second. */
+    double mediaRate() const { return m_mediaRate; }
+
+    std::chrono::milliseconds stepUpDelay() const { return m_stepUpDelay; }
+
+    QString toString() const;
+
+private:
+    bool m_hasSamples = false;
+    double m_throughputBps = 0;
+    double m_mediaRate = 0;
+    int m_badIntervalCount = 0;
+    std::chrono::milliseconds m_stableTime{};
+    std::chrono::milliseconds m_stepUpDelay = kInitialStepUpDelay;
+
+    /** Time since the last step up, while it is not confirmed by the stable period. */
+    std::optional<std::chrono::milliseconds> m_sinceStepUp;
+};
+
+} // namespace nx::media
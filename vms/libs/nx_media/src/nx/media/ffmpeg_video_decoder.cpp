@@ -123,6 +123,7 @@ public:
         codecContext(nullptr),
         frame(av_frame_alloc()),
         lastPts(AV_NOPTS_VALUE),
+        frameNumOffset(0),
         scaleContext(nullptr)
     {
     }
@@ -148,6 +149,8 @@ public:
     AVCodecContext* codecContext;
     AVFrame* frame;
     qint64 lastPts;
+    /** Value of frame_num at the last reset(). */
+    int64_t frameNumOffset;
     SwsContext* scaleContext;
 };
 
@@ -349,7 +352,8 @@ int FfmpegVideoDecoder::decode(
     if (res <= 0 || !gotPicture)
         return res; //< Negative value means error, zero means buffering.
 
-    const int frameNum = qMax(0, d->codecContext->frame_num - 1);
+    const int frameNum = (int) qMax<int64_t>(0,
+        d->codecContext->frame_num - 1 - d->frameNumOffset);
 
     VideoFrame* videoFrame = FfmpegVideoDecoderPrivate::fromAVFrame(
         &d->frame,
@@ -388,5 +392,17 @@ AbstractVideoDecoder::Capabilities FfmpegVideoDecoder::capabilities() const
     return Capability::noCapability;
 }
 
+bool FfmpegVideoDecoder::reset()
+{
+    Q_D(FfmpegVideoDecoder);
+    if (!d->codecContext)
+        return false;
+
+    avcodec_flush_buffers(d->codecContext);
+    d->frameNumOffset = d->codecContext->frame_num;
+    d->lastPts = AV_NOPTS_VALUE;
+    return true;
+}
+
 } // namespace media
 } // namespace nx
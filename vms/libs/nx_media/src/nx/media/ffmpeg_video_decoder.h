@@ -44,6 +44,8 @@ public:
     virtual double getSampleAspectRatio() const override;
 
     virtual Capabilities capabilities() const override;
+
+    virtual bool reset() override;
 private:
     static QMap<int, QSize> s_maxResolutions;
 
@@ -2,6 +2,9 @@
 
 #include "gop_reverser.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "frame_metadata.h"
 
 extern "C" {
@@ -67,8 +70,9 @@ void GopReverser::Queue::reset(int index)
 
 // ------------- GopReverser -------------
 
-GopReverser::GopReverser(int64_t maxBufferSizeBytes):
-    m_maxBufferSize(maxBufferSizeBytes)
+GopReverser::GopReverser(int64_t maxBufferSizeBytes, double keyFramesOnlySpeed):
+    m_maxBufferSize(maxBufferSizeBytes),
+    m_keyFramesOnlySpeed(keyFramesOnlySpeed)
 {
 }
 
@@ -78,6 +82,13 @@ void GopReverser::push(VideoFramePtr frame)
     bool isStart = metadata.flags.testFlag(QnAbstractMediaData::MediaFlags_ReverseBlockStart);
     if (isStart && !m_queue.empty())
     {
+        // A GOP of a single frame is what the key frames only mode gives, keep the mode then.
+        if (m_queue.size() > 1)
+        {
+            const auto keptFrames = std::count_if(m_queue.begin(), m_queue.end(),
+                [](const VideoFramePtr& frame) { return (bool) frame; });
+            m_isBudgetExceeded = keptFrames <= 1;
+        }
         std::reverse(m_queue.begin(), m_queue.end());
         m_nextFrame = std::move(frame);
     }
@@ -102,6 +113,17 @@ VideoFramePtr GopReverser::pop()
     return VideoFramePtr();
 }
 
+bool GopReverser::isFrameNeeded(const QnCompressedVideoData* frame, double speed) const
+{
+    if (frame->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey))
+        return true;
+
+    if (m_isBudgetExceeded)
+        return false;
+
+    return m_keyFramesOnlySpeed <= 0 || std::abs(speed) < m_keyFramesOnlySpeed;
+}
+
 void GopReverser::removeOneElement()
 {
     std::pair<int, int> filled, empty; //< first - pos, second - count.
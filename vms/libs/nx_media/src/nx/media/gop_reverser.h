@@ -30,16 +30,29 @@ class NX_MEDIA_API GopReverser
     };
 
 public:
-    GopReverser(int64_t maxBufferSizeBytes);
+    /**
+     * @param keyFramesOnlySpeed Absolute reverse speed starting from which only the key frames are
+     *     decoded. Zero means the whole GOPs are decoded at any speed.
+     */
+    GopReverser(int64_t maxBufferSizeBytes, double keyFramesOnlySpeed = 0);
 
     void push(VideoFramePtr decodedFrame);
     VideoFramePtr pop();
 
+    /**
+     * Whether the compressed frame of the reverse playback is worth decoding. Only the key frames
+     * are, if the speed is too high to display the whole GOPs, or if the budget has kept just one
+     * decoded frame of the previous GOP, so the rest of the GOP would be decoded to be dropped.
+     */
+    bool isFrameNeeded(const QnCompressedVideoData* frame, double speed) const;
+
 private:
     void removeOneElement();
 
 private:
     const int64_t m_maxBufferSize;
+    const double m_keyFramesOnlySpeed;
+    bool m_isBudgetExceeded = false;
     Queue m_queue;
     VideoFramePtr m_nextFrame;
 };
@@ -24,6 +24,15 @@ struct NX_MEDIA_API Ini: public nx::kit::IniConfig
     NX_INI_INT(1000, metadataCacheSize, "Size of metadata cache per channel.");
     NX_INI_FLAG(0, forceIframesOnly, "For Low Quality selection, force I-frames-only mode.");
     NX_INI_FLAG(0, unlimitFfmpegMaxResolution, "");
+    NX_INI_INT(4, reverseKeyFramesOnlySpeed,
+        "Reverse playback speed starting from which only the key frames are decoded. 0 means the\n"
+        "whole GOPs are decoded at any speed.");
+    NX_INI_INT(4, videoDecoderPoolSize,
+        "Number of the idle video decoders kept for reuse when the player switches the stream.\n"
+        "0 disables the reuse.");
+    NX_INI_INT(2, videoDecoderPoolHardwareSize,
+        "Number of the idle hardware video decoders, which hold the GPU sessions, kept for\n"
+        "reuse. Counted within videoDecoderPoolSize.");
     NX_INI_FLAG(0, allowSpeedupAudio, "Allow fast audio playing during x2 and x4 speed");
 };
 
@@ -325,6 +325,17 @@ int MacVideoDecoder::decode(
     return d->decoder->frameNum();
 }
 
+bool MacVideoDecoder::reset()
+{
+    Q_D(MacVideoDecoder);
+    if (!d->decoder || !d->decoder->flush())
+        return false;
+
+    d->m_annexbToMp4 = AnnexbToMp4();
+    d->lastPts = AV_NOPTS_VALUE;
+    return true;
+}
+
 AbstractVideoDecoder::Capabilities MacVideoDecoder::capabilities() const
 {
     Q_D(const MacVideoDecoder);
@@ -37,6 +37,8 @@ public:
         const QnConstCompressedVideoDataPtr& frame, VideoFramePtr* result = nullptr) override;
 
     virtual Capabilities capabilities() const override;
+
+    virtual bool reset() override;
 private:
     void ffmpegToQtVideoFrame(VideoFramePtr* result);
 
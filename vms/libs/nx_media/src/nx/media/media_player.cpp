@@ -32,6 +32,7 @@
 #include <nx_ec/abstract_ec_connection.h>
 #include <utils/common/long_runable_cleanup.h>
 
+#include "adaptive_quality_estimator.h"
 #include "audio_output.h"
 #include "frame_metadata.h"
 #include "media_player_quality_chooser.h"
@@ -76,6 +77,9 @@ static constexpr int kGotDataTimeoutMs = 1000 * 30;
 // Periodic tasks timer interval
 static constexpr int kPeriodicTasksTimeoutMs = 1000;
 
+// Transcoding resolution used by the adaptive quality between the high and the low streams.
+static constexpr int kAdaptiveTranscodingLines = 480;
+
 static qint64 msecToUsec(qint64 posMs)
 {
     return posMs == kLivePosition ? DATETIME_NOW : posMs * 1000ll;
@@ -262,11 +266,34 @@ public:
 
     bool allowSoftwareDecoderFallback = true;
 
+    // See property comment.
+    bool adaptiveQuality = false;
+
+    AdaptiveQualityEstimator adaptiveQualityEstimator;
+
+    // Index of the played quality in adaptiveQualities().
+    int adaptiveQualityLevel = 0;
+
+    // The last adaptive quality decision, for the debug info.
+    QString adaptiveQualityDecision;
+
+    // Wall-clock time and media time of the previous adaptive quality sample.
+    QElapsedTimer adaptiveSampleTimer;
+    qint64 lastReceivedVideoTimeUs = AV_NOPTS_VALUE;
+
+    // Playback buffer underflows since the previous adaptive quality sample.
+    int underflowCount = 0;
+
 public:
     Private(Player* parent);
 
     void applyVideoQuality();
 
+    /** The requested quality followed by the lower ones the adaptive quality may switch to. */
+    QList<int> adaptiveQualities() const;
+    void updateAdaptiveQuality();
+    void resetAdaptiveQualitySample();
+
     void handleMediaEventChanged();
 
     void at_hurryUp();
@@ -334,6 +361,8 @@ void Player::Private::setState(State value)
 
 void Player::Private::doPeriodicTasks()
 {
+    updateAdaptiveQuality();
+
     if (state == State::Playing)
     {
         if (dataConsumer)
@@ -508,6 +537,9 @@ void Player::Private::presentNextFrameDelayed()
     {
         if (audioOutput->isBufferUnderflow())
         {
+            if (lastVideoPtsMs.has_value())
+                ++underflowCount;
+
             // If audio buffer is empty we have to display current video frame to unblock data stream
             // and allow audio data to fill the buffer.
             presentNextFrame();
@@ -668,6 +700,12 @@ qint64 Player::Private::getDelayForNextFrameWithoutAudioMs(const VideoFramePtr&
         liveMode && lastVideoPtsMs.has_value() && mediaQueueLenMs == 0 && frameDelayMs < 0;
     bool liveBufferOverflow = liveMode && mediaQueueLenMs > liveBufferMs;
 
+    if (lastVideoPtsMs.has_value() && mediaQueueLenMs == 0 && frameDelayMs < 0
+        && metadata.displayHint == DisplayHint::regular)
+    {
+        ++underflowCount;
+    }
+
     if (ini().outputFrameDelays)
     {
         if (frameDelayMs < 0)
@@ -746,7 +784,8 @@ void Player::Private::applyVideoQuality()
     input.allowHardwareAcceleration = allowHardwareAcceleration;
     input.currentDecoders = &currentVideoDecoders;
 
-    const auto& result = media_player_quality_chooser::chooseVideoQuality(videoQuality, input);
+    const int quality = adaptiveQualities().value(adaptiveQualityLevel, videoQuality);
+    const auto& result = media_player_quality_chooser::chooseVideoQuality(quality, input);
 
     switch (result.quality)
     {
@@ -778,6 +817,74 @@ void Player::Private::applyVideoQuality()
     at_hurryUp(); //< skip waiting for current frame
 }
 
+QList<int> Player::Private::adaptiveQualities() const
+{
+    QList<int> result{videoQuality};
+    if (!adaptiveQuality || videoQuality == LowVideoQuality
+        || videoQuality == LowIframesOnlyVideoQuality)
+    {
+        return result;
+    }
+
+    if (videoQuality == HighVideoQuality || videoQuality > kAdaptiveTranscodingLines)
+        result.append(kAdaptiveTranscodingLines);
+    result.append(LowVideoQuality);
+    return result;
+}
+
+void Player::Private::updateAdaptiveQuality()
+{
+    if (!adaptiveQuality || !dataConsumer || state != State::Playing || speed <= 0)
+    {
+        resetAdaptiveQualitySample();
+        return;
+    }
+
+    const auto statistics = dataConsumer->takeReceivedStatistics();
+    const qint64 previousTimeUs =
+        std::exchange(lastReceivedVideoTimeUs, statistics.lastVideoTimestampUs);
+    if (!adaptiveSampleTimer.isValid()
+        || previousTimeUs == AV_NOPTS_VALUE
+        || statistics.lastVideoTimestampUs < previousTimeUs)
+    {
+        adaptiveSampleTimer.restart();
+        underflowCount = 0;
+        return;
+    }
+
+    AdaptiveQualityEstimator::Sample sample;
+    sample.elapsed = std::chrono::milliseconds(adaptiveSampleTimer.restart());
+    sample.receivedBytes = statistics.bytes;
+    sample.receivedMediaDuration = std::chrono::microseconds(
+        qint64((statistics.lastVideoTimestampUs - previousTimeUs) / speed));
+    sample.underflowCount = std::exchange(underflowCount, 0);
+
+    const auto qualities = adaptiveQualities();
+    const auto decision = adaptiveQualityEstimator.addSample(sample,
+        /*canStepDown*/ adaptiveQualityLevel + 1 < qualities.size(),
+        /*canStepUp*/ adaptiveQualityLevel > 0);
+    if (decision == AdaptiveQualityEstimator::Decision::keep)
+        return;
+
+    const bool stepDown = decision == AdaptiveQualityEstimator::Decision::stepDown;
+    adaptiveQualityLevel += stepDown ? 1 : -1;
+    adaptiveQualityDecision = nx::format("%1 to %2").args(
+        stepDown ? "Stepped down" : "Stepped up",
+        videoQualityToString(qualities[adaptiveQualityLevel]));
+    log(nx::format("updateAdaptiveQuality(): %1, %2").args(
+        adaptiveQualityDecision, adaptiveQualityEstimator));
+
+    applyVideoQuality();
+    resetAdaptiveQualitySample();
+}
+
+void Player::Private::resetAdaptiveQualitySample()
+{
+    adaptiveSampleTimer.invalidate();
+    lastReceivedVideoTimeUs = AV_NOPTS_VALUE;
+    underflowCount = 0;
+}
+
 bool Player::Private::createArchiveReader()
 {
     if (!resource)
@@ -1011,6 +1118,9 @@ void Player::setResource(const QnResourcePtr& value)
 void Player::setResourceInternal(const QnResourcePtr& resource)
 {
     d->resource = resource;
+    d->adaptiveQualityLevel = 0;
+    d->adaptiveQualityEstimator = {};
+    d->adaptiveQualityDecision.clear();
     d->isLocalFile = resource && resource->hasFlags(Qn::local_media);
 }
 
@@ -1058,6 +1168,8 @@ void Player::setPosition(qint64 value)
         value, QDateTime::fromMSecsSinceEpoch(value, QTimeZone::UTC));
 
     d->positionMs = d->lastSeekTimeMs = value;
+    d->adaptiveQualityEstimator.reset();
+    d->resetAdaptiveQualitySample();
 
     if (d->archiveReader)
     {
@@ -1325,6 +1437,8 @@ void Player::setVideoQuality(int videoQuality)
     }
     NX_DEBUG(this, "setVideoQuality(%1) BEGIN", videoQuality);
     d->videoQuality = videoQuality;
+    d->adaptiveQualityLevel = 0;
+    d->adaptiveQualityEstimator.reset();
     d->applyVideoQuality();
     emit videoQualityChanged();
     NX_DEBUG(this, "setVideoQuality(%1) END", videoQuality);
@@ -1506,6 +1620,13 @@ PlayerStatistics Player::currentStatistics() const
     if (const auto codecContext = d->archiveReader->getCodecContext())
         result.codec = codecContext->getCodecName();
     result.isHwAccelerated = d->isHwAccelerated;
+
+    if (d->adaptiveQuality)
+    {
+        result.adaptiveQuality = nx::format("%1 (%2)").args(
+            d->adaptiveQualityDecision.isEmpty() ? "Requested quality" : d->adaptiveQualityDecision,
+            d->adaptiveQualityEstimator);
+    }
     return result;
 }
 
@@ -1632,6 +1753,26 @@ void Player::invalidateServer()
     delegate->invalidateServer();
 }
 
+bool Player::adaptiveQuality() const
+{
+    return d->adaptiveQuality;
+}
+
+void Player::setAdaptiveQuality(bool value)
+{
+    if (d->adaptiveQuality == value)
+        return;
+
+    NX_DEBUG(this, "setAdaptiveQuality(%1)", value);
+    d->adaptiveQuality = value;
+    d->adaptiveQualityLevel = 0;
+    d->adaptiveQualityEstimator = {};
+    d->adaptiveQualityDecision.clear();
+    d->resetAdaptiveQualitySample();
+    d->applyVideoQuality();
+    emit adaptiveQualityChanged();
+}
+
 bool Player::allowSoftwareDecoderFallback() const
 {
     return d->allowSoftwareDecoderFallback;
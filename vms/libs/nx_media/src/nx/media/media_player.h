@@ -32,11 +32,15 @@ private:
     Q_PROPERTY(qreal bitrate MEMBER bitrate CONSTANT)
     Q_PROPERTY(QString codec MEMBER codec CONSTANT)
     Q_PROPERTY(bool isHwAccelerated MEMBER isHwAccelerated CONSTANT)
+    Q_PROPERTY(QString adaptiveQuality MEMBER adaptiveQuality CONSTANT)
 public:
     qreal framerate = 0.0;
     qreal bitrate = 0.0; //< Mbps.
     QString codec;
     bool isHwAccelerated = false;
+
+    /** The last adaptive quality decision and the estimation, empty if it is disabled. */
+    QString adaptiveQuality;
 };
 
 class PlayerPrivate;
@@ -128,6 +132,13 @@ class NX_MEDIA_API Player: public QObject
         WRITE setAllowSoftwareDecoderFallback
         NOTIFY allowSoftwareDecoderFallbackChanged)
 
+    /**
+     * Switch to the lower qualities if the connection does not sustain the stream, and back when
+     * it gets stable. The videoQuality is the highest quality to play.
+     */
+    Q_PROPERTY(bool adaptiveQuality READ adaptiveQuality WRITE setAdaptiveQuality
+        NOTIFY adaptiveQualityChanged)
+
 public:
     enum class State
     {
@@ -301,6 +312,9 @@ public:
     void setAllowSoftwareDecoderFallback(bool value);
     bool allowSoftwareDecoderFallback() const;
 
+    bool adaptiveQuality() const;
+    void setAdaptiveQuality(bool value);
+
 public slots:
     void play();
     void pause();
@@ -346,6 +360,7 @@ signals:
     void cannotDecryptMediaErrorChanged();
     void audioOnlyModeChanged();
     void allowSoftwareDecoderFallbackChanged();
+    void adaptiveQualityChanged();
 
 protected:
     virtual void setResourceInternal(const QnResourcePtr& resource);
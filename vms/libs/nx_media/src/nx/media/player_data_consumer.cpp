@@ -14,6 +14,7 @@
 #include "abstract_audio_decoder.h"
 #include "audio_output.h"
 #include "frame_metadata.h"
+#include "ini.h"
 #include "seamless_audio_decoder.h"
 #include "seamless_video_decoder.h"
 
@@ -105,9 +106,27 @@ int PlayerDataConsumer::getBufferingMask() const
 
 void PlayerDataConsumer::putData(const QnAbstractDataPacketPtr& data)
 {
+    if (const auto media = std::dynamic_pointer_cast<QnAbstractMediaData>(data))
+    {
+        if (media->dataType == QnAbstractMediaData::VIDEO)
+        {
+            m_receivedBytes += media->dataSize();
+            m_lastReceivedVideoTimeUs = media->timestamp;
+        }
+        else if (media->dataType == QnAbstractMediaData::AUDIO)
+        {
+            m_receivedBytes += media->dataSize();
+        }
+    }
+
     base_type::putData(data);
 }
 
+PlayerDataConsumer::ReceivedStatistics PlayerDataConsumer::takeReceivedStatistics()
+{
+    return {m_receivedBytes.exchange(0), m_lastReceivedVideoTimeUs.load()};
+}
+
 qint64 PlayerDataConsumer::queueVideoDurationUsec() const
 {
     qint64 minTime = std::numeric_limits<qint64>::max();
@@ -305,6 +324,13 @@ bool PlayerDataConsumer::processVideoFrame(const QnCompressedVideoDataPtr& video
     }
     SeamlessVideoDecoder* videoDecoder = m_videoDecoders[videoChannel].get();
 
+    if (m_gopReverser
+        && data->flags.testFlag(QnAbstractMediaData::MediaFlags_Reverse)
+        && !m_gopReverser->isFrameNeeded(data.get(), m_speed))
+    {
+        return true;
+    }
+
     VideoFramePtr decodedFrame;
     if (!videoDecoder->decode(data, &decodedFrame))
     {
@@ -317,7 +343,10 @@ bool PlayerDataConsumer::processVideoFrame(const QnCompressedVideoDataPtr& video
         if (metadata.flags.testFlag(QnAbstractMediaData::MediaFlags_Reverse))
         {
             if (!m_gopReverser)
-                m_gopReverser = std::make_unique<GopReverser>(kReorderBufferSizeBytes);
+            {
+                m_gopReverser = std::make_unique<GopReverser>(
+                    kReorderBufferSizeBytes, ini().reverseKeyFramesOnlySpeed);
+            }
             m_gopReverser->push(std::move(decodedFrame));
             std::vector<VideoFramePtr> frames;
             while (auto frame = m_gopReverser->pop())
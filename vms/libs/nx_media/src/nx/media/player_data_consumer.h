@@ -100,6 +100,18 @@ public:
 
     nx::media::StreamEventPacket mediaEvent() const;
 
+    struct ReceivedStatistics
+    {
+        qint64 bytes = 0;
+        qint64 lastVideoTimestampUs = AV_NOPTS_VALUE;
+    };
+
+    /**
+     * @return Statistics of the media data received from the network since the previous call.
+     * Allowed to be called from another thread.
+     */
+    ReceivedStatistics takeReceivedStatistics();
+
 signals:
     /** Hint to render to display current data with no delay due to seek operation in progress. */
     void hurryUp();
@@ -200,6 +212,8 @@ private:
     VideoGeometryAccessor m_videoGeometryAccessor;
 
     std::atomic<qint64> m_lastFrameTimeUs;
+    std::atomic<qint64> m_receivedBytes{0};
+    std::atomic<qint64> m_lastReceivedVideoTimeUs{AV_NOPTS_VALUE};
     std::atomic<qint64> m_lastDisplayedTimeUs;
     MultiSensorHelper m_awaitingFramesMask;
     int m_eofPacketCounter;
@@ -257,13 +257,15 @@ bool SeamlessVideoDecoder::decode(
         }
 
         // Release previous decoder in case the hardware decoder can handle only single instance.
+        // The registry keeps it idle to be reused if the stream is switched back.
         d->videoDecoder.reset();
         d->videoDecoder = VideoDecoderRegistry::instance()->createCompatibleDecoder(
             frame->compressionType,
             frameInfo.size,
             d->allowOverlay,
             d->allowHardwareAcceleration,
-            d->renderContextSynchronizer);
+            d->renderContextSynchronizer,
+            frame->context);
         if (!d->videoDecoder)
         {
             NX_WARNING(this, "Failed to create video decoder, codec: %1, size: %2",
@@ -3,6 +3,7 @@
 #include "video_decoder_registry.h"
 #include "abstract_video_decoder.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 #include <QtCore/QMutexLocker>
@@ -11,6 +12,8 @@
 
 #include <nx/build_info.h>
 
+#include "ini.h"
+
 namespace nx {
 namespace media {
 
@@ -26,12 +29,36 @@ VideoDecoderRegistry* VideoDecoderRegistry::instance()
     return &instance;
 }
 
+VideoDecoderRegistry::VideoDecoderRegistry():
+    m_maxIdleDecoders(ini().videoDecoderPoolSize),
+    m_maxIdleHardwareDecoders(ini().videoDecoderPoolHardwareSize)
+{
+}
+
+bool VideoDecoderRegistry::DecoderKey::isReusableFor(const DecoderKey& other) const
+{
+    if (codec != other.codec
+        || resolution != other.resolution
+        || allowOverlay != other.allowOverlay
+        || allowHardwareAcceleration != other.allowHardwareAcceleration
+        || renderContextSynchronizer != other.renderContextSynchronizer)
+    {
+        return false;
+    }
+
+    if (!codecParameters || !other.codecParameters)
+        return !codecParameters && !other.codecParameters;
+
+    return codecParameters->isEqual(*other.codecParameters);
+}
+
 VideoDecoderPtr VideoDecoderRegistry::createCompatibleDecoder(
     const AVCodecID codec,
     const QSize& resolution,
     bool allowOverlay,
     bool allowHardwareAcceleration,
-    RenderContextSynchronizerPtr renderContextSynchronizer)
+    RenderContextSynchronizerPtr renderContextSynchronizer,
+    CodecParametersConstPtr codecParameters)
 {
     QMutexLocker lock(&mutex);
     auto codecString =
@@ -43,36 +70,160 @@ VideoDecoderPtr VideoDecoderRegistry::createCompatibleDecoder(
                 .arg(resolution.height());
         };
 
+    const DecoderKey key{
+        .codec = codec,
+        .resolution = resolution,
+        .allowOverlay = allowOverlay,
+        .allowHardwareAcceleration = allowHardwareAcceleration,
+        .renderContextSynchronizer = renderContextSynchronizer,
+        .codecParameters = std::move(codecParameters)};
+
+    for (auto it = m_idleDecoders.begin(); it != m_idleDecoders.end(); ++it)
+    {
+        if (!it->second.key.isReusableFor(key))
+            continue;
+
+        const auto [decoder, info] = std::move(*it);
+        m_idleDecoders.erase(it);
+        m_decodersInUse[decoder] = info;
+        NX_DEBUG(this, "Reused idle video decoder: %1 with codec: %2",
+            info.plugin->name, codecString());
+        return makeDecoderPtr(decoder);
+    }
 
-    static std::map<AbstractVideoDecoder*, Metadata*> decodersInUse;
     for (auto& plugin: m_plugins)
     {
         NX_DEBUG(this, "Checking video decoder: %1 with codec: %2", plugin.name, codecString());
-        if (plugin.useCount < plugin.maxUseCount
-            && plugin.isCompatible(codec, resolution, allowOverlay, allowHardwareAcceleration))
-        {
-            auto videoDecoder = VideoDecoderPtr(
-                plugin.createVideoDecoder(renderContextSynchronizer, resolution),
-                [](AbstractVideoDecoder* decoder)
-                {
-                    QMutexLocker lock(&mutex);
-                    auto itr = decodersInUse.find(decoder);
-                    if (itr != decodersInUse.end())
-                    {
-                        --itr->second->useCount;
-                        decodersInUse.erase(itr);
-                    }
-                    delete decoder;
-                });
-            ++plugin.useCount;
-            decodersInUse[videoDecoder.get()] = &plugin;
-            NX_DEBUG(this, "Selected video decoder: %1", plugin.name);
-            return videoDecoder;
-        }
+        if (plugin.useCount >= plugin.maxUseCount && idleDecoderCount(&plugin) == 0)
+            continue;
+
+        if (!plugin.isCompatible(codec, resolution, allowOverlay, allowHardwareAcceleration))
+            continue;
+
+        // The idle decoders of the plugin give way to the new one.
+        evictIdleDecoders(
+            [&plugin](const AbstractVideoDecoder*, const DecoderInfo& info)
+            {
+                return info.plugin == &plugin;
+            },
+            plugin.useCount - plugin.maxUseCount + 1);
+        if (plugin.useCount >= plugin.maxUseCount)
+            continue;
+
+        const auto decoder = plugin.createVideoDecoder(renderContextSynchronizer, resolution);
+        ++plugin.useCount;
+        m_decodersInUse[decoder] = DecoderInfo{.plugin = &plugin, .key = key};
+        NX_DEBUG(this, "Selected video decoder: %1", plugin.name);
+        return makeDecoderPtr(decoder);
     }
     return VideoDecoderPtr(nullptr, nullptr); //< no compatible decoder found
 }
 
+VideoDecoderPtr VideoDecoderRegistry::makeDecoderPtr(AbstractVideoDecoder* decoder)
+{
+    return VideoDecoderPtr(
+        decoder,
+        [](AbstractVideoDecoder* decoder)
+        {
+            VideoDecoderRegistry::instance()->releaseDecoder(decoder);
+        });
+}
+
+void VideoDecoderRegistry::releaseDecoder(AbstractVideoDecoder* decoder)
+{
+    QMutexLocker lock(&mutex);
+    const auto it = m_decodersInUse.find(decoder);
+    if (it == m_decodersInUse.end())
+    {
+        delete decoder;
+        return;
+    }
+
+    DecoderInfo info = std::move(it->second);
+    m_decodersInUse.erase(it);
+    if (m_maxIdleDecoders <= 0 || !decoder->reset())
+    {
+        destroyDecoder(decoder, info.plugin);
+        return;
+    }
+
+    info.isHardwareAccelerated =
+        decoder->capabilities().testFlag(AbstractVideoDecoder::Capability::hardwareAccelerated);
+    NX_DEBUG(this, "Keep idle video decoder: %1", info.plugin->name);
+    m_idleDecoders.emplace_front(decoder, std::move(info));
+
+    evictIdleDecoders(
+        [](const AbstractVideoDecoder*, const DecoderInfo&) { return true; },
+        (int) m_idleDecoders.size() - m_maxIdleDecoders);
+    const auto idleHardwareDecoders = std::count_if(
+        m_idleDecoders.begin(), m_idleDecoders.end(),
+        [](const auto& idle) { return idle.second.isHardwareAccelerated; });
+    evictIdleDecoders(
+        [](const AbstractVideoDecoder*, const DecoderInfo& info)
+        {
+            return info.isHardwareAccelerated;
+        },
+        (int) idleHardwareDecoders - m_maxIdleHardwareDecoders);
+}
+
+void VideoDecoderRegistry::evictIdleDecoders(
+    const std::function<bool(const AbstractVideoDecoder*, const DecoderInfo&)>& condition,
+    int count)
+{
+    // The least recently used decoders are evicted first.
+    auto it = m_idleDecoders.end();
+    while (count > 0 && it != m_idleDecoders.begin())
+    {
+        --it;
+        if (!condition(it->first, it->second))
+            continue;
+
+        NX_DEBUG(this, "Evict idle video decoder: %1", it->second.plugin->name);
+        destroyDecoder(it->first, it->second.plugin);
+        it = m_idleDecoders.erase(it);
+        --count;
+    }
+}
+
+void VideoDecoderRegistry::destroyDecoder(AbstractVideoDecoder* decoder, Metadata* plugin)
+{
+    --plugin->useCount;
+    delete decoder;
+}
+
+int VideoDecoderRegistry::idleDecoderCount(const Metadata* plugin) const
+{
+    return (int) std::count_if(m_idleDecoders.begin(), m_idleDecoders.end(),
+        [plugin](const auto& idle) { return idle.second.plugin == plugin; });
+}
+
+void VideoDecoderRegistry::setPoolSize(int maxIdleDecoders, int maxIdleHardwareDecoders)
+{
+    QMutexLocker lock(&mutex);
+    m_maxIdleDecoders = maxIdleDecoders;
+    m_maxIdleHardwareDecoders = maxIdleHardwareDecoders;
+    evictIdleDecoders(
+        [](const AbstractVideoDecoder*, const DecoderInfo&) { return true; },
+        (int) m_idleDecoders.size() - std::max(0, m_maxIdleDecoders));
+    const auto idleHardwareDecoders = std::count_if(
+        m_idleDecoders.begin(), m_idleDecoders.end(),
+        [](const auto& idle) { return idle.second.isHardwareAccelerated; });
+    evictIdleDecoders(
+        [](const AbstractVideoDecoder*, const DecoderInfo& info)
+        {
+            return info.isHardwareAccelerated;
+        },
+        (int) idleHardwareDecoders - std::max(0, m_maxIdleHardwareDecoders));
+}
+
+void VideoDecoderRegistry::clearPool()
+{
+    QMutexLocker lock(&mutex);
+    evictIdleDecoders(
+        [](const AbstractVideoDecoder*, const DecoderInfo&) { return true; },
+        (int) m_idleDecoders.size());
+}
+
 bool VideoDecoderRegistry::hasCompatibleDecoder(
     const AVCodecID codec,
     const QSize& resolution,
@@ -102,8 +253,8 @@ bool VideoDecoderRegistry::hasCompatibleDecoder(
     QMutexLocker lock(&mutex);
     for (const auto& plugin: m_plugins)
     {
-        const int availableUsageCount =
-            plugin.useCount - decoderCountByTypeIndex[plugin.typeIndex];
+        const int availableUsageCount = plugin.useCount
+            - decoderCountByTypeIndex[plugin.typeIndex] - idleDecoderCount(&plugin);
 
         if (availableUsageCount >= plugin.maxUseCount)
         {
@@ -149,6 +300,7 @@ void VideoDecoderRegistry::setDefaultRenderContextSynchronizer(RenderContextSync
 
 void VideoDecoderRegistry::reinitialize()
 {
+    clearPool();
     m_plugins.clear();
     m_defaultRenderContextSynchronizer = RenderContextSynchronizerPtr();
 }
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <functional>
+#include <list>
+#include <map>
 #include <typeindex>
 
 #include <nx/media/media_fwd.h>
@@ -17,6 +19,12 @@ typedef std::unique_ptr<AbstractVideoDecoder, void(*)(AbstractVideoDecoder*)> Vi
 /**
  * Singleton. Allows to register various implementations for video decoders. The exact list of
  * decoders can be registered in runtime.
+ *
+ * The released decoders which support AbstractVideoDecoder::reset() are kept idle in the pool,
+ * so switching the stream back (e.g. between the primary and secondary ones) reuses the decoder
+ * instead of creating it anew, which is expensive for the hardware decoders. The idle decoders
+ * count against maxUseCount of their plugin, and are evicted in the least recently used order if
+ * the pool limits are exceeded or if a new decoder of the plugin is needed.
  */
 class NX_MEDIA_API VideoDecoderRegistry
 {
@@ -24,6 +32,8 @@ public:
     static VideoDecoderRegistry* instance();
 
     /**
+     * @param codecParameters If not null, only the idle decoder which was used with the equal
+     *     parameters may be reused.
      * @return Optimal video decoder (in case of any) compatible with such frame. Return null
      * pointer if no compatible decoder is found.
      */
@@ -32,7 +42,8 @@ public:
         const QSize& resolution,
         bool allowOverlay,
         bool allowHardwareAcceleration,
-        RenderContextSynchronizerPtr renderContextSynchronizer);
+        RenderContextSynchronizerPtr renderContextSynchronizer,
+        CodecParametersConstPtr codecParameters = {});
 
     /**
      * @return Whether a compatible video decoder is found.
@@ -59,6 +70,15 @@ public:
         m_plugins.push_back(MetadataImpl<Decoder>(name, maxUseCount));
     }
 
+    /**
+     * Limits the number of the idle decoders kept for reuse, by default they are taken from
+     * nx_media.ini. Zero disables the reuse.
+     */
+    void setPoolSize(int maxIdleDecoders, int maxIdleHardwareDecoders);
+
+    /** Destroys the idle decoders. */
+    void clearPool();
+
     /** For tests. */
     void reinitialize();
 
@@ -97,9 +117,44 @@ private:
         }
     };
 
+    /** The parameters a decoder is created for: the idle one is reused for the same ones. */
+    struct DecoderKey
+    {
+        AVCodecID codec = AV_CODEC_ID_NONE;
+        QSize resolution;
+        bool allowOverlay = false;
+        bool allowHardwareAcceleration = false;
+        RenderContextSynchronizerPtr renderContextSynchronizer;
+        CodecParametersConstPtr codecParameters;
+
+        bool isReusableFor(const DecoderKey& other) const;
+    };
+
+    struct DecoderInfo
+    {
+        Metadata* plugin = nullptr;
+        DecoderKey key;
+        bool isHardwareAccelerated = false;
+    };
+
+    VideoDecoderRegistry();
+    VideoDecoderPtr makeDecoderPtr(AbstractVideoDecoder* decoder);
+    void releaseDecoder(AbstractVideoDecoder* decoder);
+    void evictIdleDecoders(
+        const std::function<bool(const AbstractVideoDecoder*, const DecoderInfo&)>& condition,
+        int count);
+    void destroyDecoder(AbstractVideoDecoder* decoder, Metadata* plugin);
+    int idleDecoderCount(const Metadata* plugin) const;
+
 private:
     std::vector<Metadata> m_plugins;
     RenderContextSynchronizerPtr m_defaultRenderContextSynchronizer = nullptr;
+
+    int m_maxIdleDecoders = 0;
+    int m_maxIdleHardwareDecoders = 0;
+    std::map<AbstractVideoDecoder*, DecoderInfo> m_decodersInUse;
+    /** The most recently released decoder comes first. */
+    std::list<std::pair<AbstractVideoDecoder*, DecoderInfo>> m_idleDecoders;
 };
 
 } // namespace media
@@ -0,0 +1,81 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/media/adaptive_quality_estimator.h>
+
+namespace nx::media::test {
+
+using namespace std::chrono;
+using Decision = AdaptiveQualityEstimator::Decision;
+
+namespace {
+
+AdaptiveQualityEstimator::Sample makeSample(double mediaRate, int underflowCount = 0)
+{
+    AdaptiveQualityEstimator::Sample sample;
+    sample.elapsed = 1s;
+    sample.receivedBytes = 500'000;
+    sample.receivedMediaDuration = microseconds(qint64(mediaRate * 1'000'000));
+    sample.underflowCount = underflowCount;
+    return sample;
+}
+
+} // namespace
+
+class AdaptiveQualityEstimatorTest: public ::testing::Test
+{
+protected:
+    /** @return Number of the samples added before the decision, or -1 if there is none. */
+    int addSamplesUntilDecision(
+        double mediaRate, int maxCount, Decision expected, bool canStepUp = true)
+    {
+        for (int i = 1; i <= maxCount; ++i)
+        {
+            const auto decision = estimator.addSample(
+                makeSample(mediaRate), /*canStepDown*/ true, canStepUp);
+            if (decision != Decision::keep)
+                return decision == expected ? i : -1;
+        }
+        return -1;
+    }
+
+protected:
+    AdaptiveQualityEstimator estimator;
+};
+
+TEST_F(AdaptiveQualityEstimatorTest, stepDownRequiresSeveralBadIntervals)
+{
+    ASSERT_EQ(Decision::keep, estimator.addSample(makeSample(1.0, /*underflowCount*/ 1),
+        /*canStepDown*/ true, /*canStepUp*/ true));
+    ASSERT_EQ(Decision::keep, estimator.addSample(makeSample(1.0), true, true));
+    ASSERT_DOUBLE_EQ(4'000'000, estimator.throughputBps());
+
+    // The good interval has reset the bad ones.
+    ASSERT_EQ(3, addSamplesUntilDecision(0.5, 10, Decision::stepDown));
+
+    // The lowest quality is not stepped down.
+    for (int i = 0; i < 10; ++i)
+        ASSERT_EQ(Decision::keep, estimator.addSample(makeSample(0.5), false, true));
+}
+
+TEST_F(AdaptiveQualityEstimatorTest, failedStepUpIsDelayed)
+{
+    const int initialDelay = duration_cast<seconds>(
+        AdaptiveQualityEstimator::kInitialStepUpDelay).count();
+
+    ASSERT_EQ(initialDelay, addSamplesUntilDecision(1.0, 1000, Decision::stepUp));
+
+    // The connection does not sustain the higher quality.
+    ASSERT_EQ(3, addSamplesUntilDecision(0.5, 10, Decision::stepDown));
+    ASSERT_EQ(AdaptiveQualityEstimator::kInitialStepUpDelay * 2, estimator.stepUpDelay());
+    ASSERT_EQ(initialDelay * 2, addSamplesUntilDecision(1.0, 1000, Decision::stepUp));
+
+    // The step up is confirmed by the stable period, so the later step down keeps the delay.
+    ASSERT_EQ(-1, addSamplesUntilDecision(
+        1.0, initialDelay * 2, Decision::stepUp, /*canStepUp*/ false));
+    ASSERT_EQ(3, addSamplesUntilDecision(0.5, 10, Decision::stepDown));
+    ASSERT_EQ(AdaptiveQualityEstimator::kInitialStepUpDelay * 2, estimator.stepUpDelay());
+}
+
+} // namespace nx::media::test
@@ -52,6 +52,19 @@ public:
     std::unique_ptr<GopReverser> reverser;
 };
 
+namespace {
+
+QnWritableCompressedVideoDataPtr makeCompressedFrame(bool isKey)
+{
+    QnWritableCompressedVideoDataPtr frame(new QnWritableCompressedVideoData());
+    frame->flags |= QnAbstractMediaData::MediaFlags_Reverse;
+    if (isKey)
+        frame->flags |= QnAbstractMediaData::MediaFlags_AVKey;
+    return frame;
+}
+
+} // namespace
+
 TEST_F(GopReverserTest, enoughBuffer)
 {
     init(kFrameSize * kFramesCount);
@@ -94,4 +107,28 @@ TEST_F(GopReverserTest, notEnoughBuffer10)
     expectFrames({});
 }
 
+TEST_F(GopReverserTest, keyFramesOnlyAtHighSpeed)
+{
+    reverser = std::make_unique<GopReverser>(kFrameSize * kFramesCount, /*keyFramesOnlySpeed*/ 4);
+    const auto keyFrame = makeCompressedFrame(/*isKey*/ true);
+    const auto frame = makeCompressedFrame(/*isKey*/ false);
+    ASSERT_TRUE(reverser->isFrameNeeded(frame.get(), -2));
+    ASSERT_FALSE(reverser->isFrameNeeded(frame.get(), -4));
+    ASSERT_TRUE(reverser->isFrameNeeded(keyFrame.get(), -4));
+
+    reverser = std::make_unique<GopReverser>(kFrameSize * kFramesCount);
+    ASSERT_TRUE(reverser->isFrameNeeded(frame.get(), -16));
+}
+
+TEST_F(GopReverserTest, keyFramesOnlyIfBudgetExceeded)
+{
+    init(kFrameSize * (kFramesCount - 8));
+    ASSERT_TRUE(reverser->isFrameNeeded(makeCompressedFrame(/*isKey*/ false).get(), -1));
+
+    init(kFrameSize * (kFramesCount - 9));
+    expectFrames({ 0 });
+    ASSERT_FALSE(reverser->isFrameNeeded(makeCompressedFrame(/*isKey*/ false).get(), -1));
+    ASSERT_TRUE(reverser->isFrameNeeded(makeCompressedFrame(/*isKey*/ true).get(), -1));
+}
+
 } // namespace nx::media::test
@@ -0,0 +1,143 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/media/abstract_video_decoder.h>
+#include <nx/media/ini.h>
+#include <nx/media/video_decoder_registry.h>
+
+namespace nx::media::test {
+
+namespace {
+
+static const QSize kPrimaryResolution(1920, 1080);
+static const QSize kSecondaryResolution(640, 360);
+
+class TestVideoDecoder: public AbstractVideoDecoder
+{
+public:
+    TestVideoDecoder(
+        const RenderContextSynchronizerPtr& /*synchronizer*/, const QSize& /*resolution*/)
+    {
+        ++s_instanceCount;
+    }
+
+    virtual ~TestVideoDecoder() override { --s_instanceCount; }
+
+    static bool isCompatible(
+        const AVCodecID codec, const QSize& /*resolution*/, bool /*allowOverlay*/, bool /*allowHW*/)
+    {
+        return codec == AV_CODEC_ID_H264;
+    }
+
+    static QSize maxResolution(const AVCodecID /*codec*/) { return QSize(); }
+
+    virtual Capabilities capabilities() const override
+    {
+        return Capability::hardwareAccelerated;
+    }
+
+    virtual int decode(const QnConstCompressedVideoDataPtr&, VideoFramePtr*) override
+    {
+        return 0;
+    }
+
+    virtual bool reset() override { return true; }
+
+public:
+    static int s_instanceCount;
+};
+
+int TestVideoDecoder::s_instanceCount = 0;
+
+} // namespace
+
+class VideoDecoderRegistryTest: public ::testing::Test
+{
+protected:
+    virtual void TearDown() override
+    {
+        registry()->reinitialize();
+        registry()->setPoolSize(ini().videoDecoderPoolSize, ini().videoDecoderPoolHardwareSize);
+        ASSERT_EQ(0, TestVideoDecoder::s_instanceCount);
+    }
+
+    void init(int maxUseCount, int maxIdleDecoders, int maxIdleHardwareDecoders)
+    {
+        registry()->reinitialize();
+        registry()->addPlugin<TestVideoDecoder>("TestVideoDecoder", maxUseCount);
+        registry()->setPoolSize(maxIdleDecoders, maxIdleHardwareDecoders);
+    }
+
+    static VideoDecoderRegistry* registry() { return VideoDecoderRegistry::instance(); }
+
+    static VideoDecoderPtr createDecoder(const QSize& resolution)
+    {
+        return registry()->createCompatibleDecoder(AV_CODEC_ID_H264, resolution,
+            /*allowOverlay*/ false, /*allowHardwareAcceleration*/ true, /*synchronizer*/ {});
+    }
+};
+
+TEST_F(VideoDecoderRegistryTest, reusesIdleDecoder)
+{
+    init(/*maxUseCount*/ 4, /*maxIdleDecoders*/ 4, /*maxIdleHardwareDecoders*/ 4);
+
+    auto decoder = createDecoder(kPrimaryResolution);
+    const auto primaryDecoder = decoder.get();
+    decoder.reset();
+    ASSERT_EQ(1, TestVideoDecoder::s_instanceCount);
+
+    // Switch to the secondary stream and back.
+    decoder = createDecoder(kSecondaryResolution);
+    ASSERT_NE(primaryDecoder, decoder.get());
+    decoder.reset();
+    decoder = createDecoder(kPrimaryResolution);
+    ASSERT_EQ(primaryDecoder, decoder.get());
+    ASSERT_EQ(2, TestVideoDecoder::s_instanceCount);
+
+    ASSERT_FALSE(registry()->createCompatibleDecoder(AV_CODEC_ID_HEVC, kPrimaryResolution,
+        /*allowOverlay*/ false, /*allowHardwareAcceleration*/ true, /*synchronizer*/ {}));
+
+    decoder.reset();
+    registry()->clearPool();
+    ASSERT_EQ(0, TestVideoDecoder::s_instanceCount);
+}
+
+TEST_F(VideoDecoderRegistryTest, evictsIdleDecoderForNewOne)
+{
+    init(/*maxUseCount*/ 1, /*maxIdleDecoders*/ 4, /*maxIdleHardwareDecoders*/ 4);
+
+    auto decoder = createDecoder(kPrimaryResolution);
+    ASSERT_FALSE(createDecoder(kSecondaryResolution));
+    decoder.reset();
+
+    decoder = createDecoder(kSecondaryResolution);
+    ASSERT_TRUE(decoder);
+    ASSERT_EQ(1, TestVideoDecoder::s_instanceCount);
+}
+
+TEST_F(VideoDecoderRegistryTest, limitsIdleHardwareDecoders)
+{
+    init(/*maxUseCount*/ 4, /*maxIdleDecoders*/ 4, /*maxIdleHardwareDecoders*/ 1);
+
+    auto primaryDecoder = createDecoder(kPrimaryResolution);
+    auto secondaryDecoder = createDecoder(kSecondaryResolution);
+    const auto secondaryDecoderPtr = secondaryDecoder.get();
+    primaryDecoder.reset();
+    secondaryDecoder.reset();
+    ASSERT_EQ(1, TestVideoDecoder::s_instanceCount);
+
+    // The least recently used decoder is evicted.
+    secondaryDecoder = createDecoder(kSecondaryResolution);
+    ASSERT_EQ(secondaryDecoderPtr, secondaryDecoder.get());
+}
+
+TEST_F(VideoDecoderRegistryTest, poolCanBeDisabled)
+{
+    init(/*maxUseCount*/ 4, /*maxIdleDecoders*/ 0, /*maxIdleHardwareDecoders*/ 0);
+
+    createDecoder(kPrimaryResolution).reset();
+    ASSERT_EQ(0, TestVideoDecoder::s_instanceCount);
+}
+
+} // namespace nx::media::test
@@ -8,6 +8,7 @@
 #include <nx/sdk/helpers/to_string.h>
 #include <nx/sdk/helpers/error.h>
 #include <nx/sdk/helpers/integration_diagnostic_event.h>
+#include <nx/sdk/helpers/list.h>
 #include <nx/sdk/analytics/helpers/engine.h>
 
 #include <nx/sdk/analytics/i_event_metadata_packet.h>
@@ -55,6 +56,7 @@ void ConsumingDeviceAgent::setHandler(IDeviceAgent::IHandler* handler)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_handler = shareToPtr(handler);
+    m_metadataListHandler = handler ? handler->queryInterface<IDeviceAgent::IHandler2>() : nullptr;
 }
 
 void ConsumingDeviceAgent::doPushDataPacket(
@@ -121,11 +123,23 @@ void ConsumingDeviceAgent::processMetadataPackets(
             << " metadata packet(s).";
     }
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_metadataListHandler || metadataPackets.size() <= 1)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         for (int i = 0; i < (int) metadataPackets.size(); ++i)
             processMetadataPacket(metadataPackets.at(i), i);
+        return;
+    }
+
+    const auto metadataList = makePtr<List<IMetadataPacket>>();
+    for (int i = 0; i < (int) metadataPackets.size(); ++i)
+    {
+        if (isMetadataPacketValid(metadataPackets.at(i), i))
+            metadataList->addItem(metadataPackets.at(i));
     }
+
+    if (metadataList->count() > 0)
+        m_metadataListHandler->handleMetadataList(metadataList.get());
 }
 
 static std::string packetIndexName(int packetIndex)
@@ -142,16 +156,24 @@ void ConsumingDeviceAgent::processMetadataPacket(
             << "INTERNAL ERROR: setHandler() was not called; ignoring the packet";
         return;
     }
+
+    if (isMetadataPacketValid(metadataPacket, packetIndex))
+        m_handler->handleMetadata(metadataPacket.get());
+}
+
+bool ConsumingDeviceAgent::isMetadataPacketValid(
+    Ptr<IMetadataPacket> metadataPacket, int packetIndex) const
+{
     if (!metadataPacket)
     {
         NX_OUTPUT << __func__ << "(): WARNING: Null metadata packet"
             << packetIndexName(packetIndex) << " found; discarded.";
-        return;
+        return false;
     }
 
     logMetadataPacketIfNeeded(metadataPacket, packetIndex);
     NX_KIT_ASSERT(metadataPacket->timestampUs() >= 0);
-    m_handler->handleMetadata(metadataPacket.get());
+    return true;
 }
 
 void ConsumingDeviceAgent::getManifest(Result<const IString*>* outResult) const
@@ -183,6 +205,12 @@ void ConsumingDeviceAgent::pushMetadataPacket(
     processMetadataPacket(metadataPacket);
 }
 
+void ConsumingDeviceAgent::pushMetadataPackets(
+    const std::vector<Ptr<IMetadataPacket>>& metadataPackets)
+{
+    processMetadataPackets(metadataPackets);
+}
+
 void ConsumingDeviceAgent::pushIntegrationDiagnosticEvent(
     IIntegrationDiagnosticEvent::Level level,
     std::string caption,
@@ -87,8 +87,9 @@ protected:
     /**
      * Override to send the newly constructed metadata packets to Server - add the packets to the
      * provided list. Called after pushVideoFrame() to retrieve any metadata packets available to
-     * the moment (not necessarily referring to that frame). As an alternative, send metadata to
-     * Server by calling pushMetadataPacket() instead of implementing this method.
+     * the moment (not necessarily referring to that frame). The packets are sent to Server in one
+     * call if Server supports it. As an alternative, send metadata to Server by calling
+     * pushMetadataPacket() or pushMetadataPackets() instead of implementing this method.
      */
     virtual bool pullMetadataPackets(std::vector<Ptr<IMetadataPacket>>* /*metadataPackets*/)
     {
@@ -101,6 +102,12 @@ protected:
      */
     void pushMetadataPacket(Ptr<IMetadataPacket> metadataPacket);
 
+    /**
+     * Sends several newly constructed metadata packets to Server in one call if Server supports
+     * it, or one by one otherwise. Can be called at any time, from any thread.
+     */
+    void pushMetadataPackets(const std::vector<Ptr<IMetadataPacket>>& metadataPackets);
+
     /**
      * Sends an IntegrationDiagnosticEvent to the Server. Can be called from any thread, but if
      * called before settingsReceived() was called, will be ignored in case setHandler() was not
@@ -178,10 +185,14 @@ private:
 
     void processMetadataPackets(const std::vector<Ptr<IMetadataPacket>>& metadataPackets);
     void processMetadataPacket(Ptr<IMetadataPacket> metadataPacket, int packetIndex = -1);
+    bool isMetadataPacketValid(Ptr<IMetadataPacket> metadataPacket, int packetIndex) const;
 
 private:
     mutable std::mutex m_mutex;
     Ptr<IDeviceAgent::IHandler> m_handler;
+
+    /** Null if the handler supplied by Server does not support handleMetadataList(). */
+    Ptr<IDeviceAgent::IHandler2> m_metadataListHandler;
     std::map<std::string, std::string> m_settings;
 };
 
@@ -33,7 +33,8 @@ public:
     virtual const char* codec() const = 0;
 
     /**
-     * @return Pointer to the compressed data.
+     * @return Pointer to the compressed data. The data is read-only: the same packet may be
+     *     supplied to several Device Agents.
      */
     virtual const char* data() const = 0;
 
@@ -5,6 +5,7 @@
 #include <nx/sdk/analytics/i_metadata_packet.h>
 #include <nx/sdk/analytics/i_metadata_types.h>
 #include <nx/sdk/i_integration_diagnostic_event.h>
+#include <nx/sdk/i_list.h>
 #include <nx/sdk/i_settings_response.h>
 #include <nx/sdk/i_string.h>
 #include <nx/sdk/i_string_map.h>
@@ -51,18 +52,37 @@ public:
         virtual void handleIntegrationDiagnosticEvent(IIntegrationDiagnosticEvent* event) = 0;
     };
 
+    class IHandler1: public Interface<IHandler1, IHandler0>
+    {
+    public:
+        static auto interfaceId() { return makeId("nx::sdk::analytics::IDeviceAgent::IHandler1"); }
+
+        /** Must be called when the Plugin needs to change the data in the DeviceAgent manifest. */
+        virtual void pushManifest(const IString* manifest) = 0;
+    };
+
     /**
      * Callback methods which allow to pass data from the Plugin to the Server. The methods can be
      * called from any thread at any moment.
+     *
+     * ATTENTION: The Servers of the older versions supply the handler implementing IHandler1 only,
+     * so before calling handleMetadataList(), check that the handler supports it via
+     * queryInterface<IDeviceAgent::IHandler2>().
      */
-    class IHandler: public Interface<IHandler, IHandler0>
+    class IHandler: public Interface<IHandler, IHandler1>
     {
     public:
-        static auto interfaceId() { return makeId("nx::sdk::analytics::IDeviceAgent::IHandler1"); }
+        static auto interfaceId() { return makeId("nx::sdk::analytics::IDeviceAgent::IHandler2"); }
 
-        /** Must be called when the Plugin needs to change the data in the DeviceAgent manifest. */
-        virtual void pushManifest(const IString* manifest) = 0;
+        /**
+         * Passes several metadata packets to the Server in one call, e.g. all the packets
+         * produced for a video frame. Is equivalent to calling handleMetadata() for each packet
+         * of the list in its order, but the Server ingests the packets as a batch, which saves the
+         * per-packet overhead for the Plugins producing many packets at a high rate.
+         */
+        virtual void handleMetadataList(IList<IMetadataPacket>* metadataPackets) = 0;
     };
+    using IHandler2 = IHandler;
 
     /** Called by setSettings() */
     protected: virtual void doSetSettings(
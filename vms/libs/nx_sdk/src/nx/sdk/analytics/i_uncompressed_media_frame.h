@@ -28,7 +28,9 @@ public:
 
     /**
      * @param plane Index of the plane, in range 0..planeCount() - 1.
-     * @return Pointer to the byte data of the plane, or null if the data is not accessible.
+     * @return Pointer to the byte data of the plane, or null if the data is not accessible. The
+     *     data is read-only: the same frame may be supplied to several Device Agents which have
+     *     requested the same pixel format.
      */
     virtual const char* data(int plane) const = 0;
 };
@@ -0,0 +1,87 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "multipart_upload.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <nx/kit/debug.h>
+
+namespace nx::sdk::cloud_storage {
+
+MultipartUpload::MultipartUpload(UploadPart uploadPart, int partSize, int maxPartsInFlight):
+    m_uploadPart(std::move(uploadPart)),
+    m_partSize(std::max(partSize, 1)),
+    m_maxPartsInFlight(std::max(maxPartsInFlight, 1))
+{
+    NX_KIT_ASSERT(m_uploadPart);
+    m_part.reserve(m_partSize);
+}
+
+MultipartUpload::~MultipartUpload()
+{
+    while (!m_partsInFlight.empty())
+        waitForPart();
+}
+
+ErrorCode MultipartUpload::append(const uint8_t* data, int size)
+{
+    m_size += size;
+    while (size > 0)
+    {
+        const int chunkSize = std::min(size, m_partSize - (int) m_part.size());
+        m_part.insert(m_part.end(), data, data + chunkSize);
+        data += chunkSize;
+        size -= chunkSize;
+
+        if ((int) m_part.size() == m_partSize)
+        {
+            startPartUpload(std::move(m_part));
+            m_part = std::vector<uint8_t>();
+            m_part.reserve(m_partSize);
+        }
+    }
+
+    collectUploadedParts();
+    return m_error;
+}
+
+ErrorCode MultipartUpload::finish()
+{
+    if (!m_part.empty() || m_partCount == 0)
+        startPartUpload(std::move(m_part));
+    m_part = std::vector<uint8_t>();
+
+    while (!m_partsInFlight.empty())
+        waitForPart();
+    return m_error;
+}
+
+void MultipartUpload::startPartUpload(std::vector<uint8_t> data)
+{
+    while ((int) m_partsInFlight.size() >= m_maxPartsInFlight)
+        waitForPart();
+
+    m_partsInFlight.push_back(std::async(
+        std::launch::async, m_uploadPart, m_partCount++, std::move(data)));
+}
+
+void MultipartUpload::waitForPart()
+{
+    const ErrorCode error = m_partsInFlight.front().get();
+    m_partsInFlight.pop_front();
+    if (m_error == ErrorCode::noError)
+        m_error = error;
+}
+
+void MultipartUpload::collectUploadedParts()
+{
+    while (!m_partsInFlight.empty()
+        && m_partsInFlight.front().wait_for(std::chrono::seconds::zero())
+            == std::future_status::ready)
+    {
+        waitForPart();
+    }
+}
+
+} // namespace nx::sdk::cloud_storage
@@ -0,0 +1,69 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include <nx/sdk/result.h>
+
+namespace nx::sdk::cloud_storage {
+
+/**
+ * Aggregates the data written by IStreamWriter into parts of the given size, and uploads the
+ * parts in the background, keeping no more than the given number of parts in flight. Intended for
+ * the backends where the per-request latency rather than the bandwidth limits the throughput,
+ * e.g. the S3-style multi-part uploads.
+ *
+ * The methods must be called from a single thread, which is the case for IStreamWriter.
+ */
+class MultipartUpload
+{
+public:
+    /**
+     * Uploads a part of the data. Is called on a background thread, concurrently for the
+     * different parts.
+     */
+    using UploadPart = std::function<ErrorCode(int partIndex, std::vector<uint8_t> data)>;
+
+    MultipartUpload(UploadPart uploadPart, int partSize, int maxPartsInFlight);
+
+    /** Waits for the parts in flight; call finish() before to upload the rest of the data. */
+    ~MultipartUpload();
+
+    /**
+     * Appends the data, and starts uploading the parts which have become complete. Blocks while
+     * the maximum number of parts is in flight.
+     * @return The error of an already uploaded part, if any.
+     */
+    ErrorCode append(const uint8_t* data, int size);
+
+    /**
+     * Uploads the rest of the data as the last part, and waits for all the parts to be uploaded.
+     * @return The error of the first failed part, if any.
+     */
+    ErrorCode finish();
+
+    /** Total size of the data appended so far. */
+    int64_t size() const { return m_size; }
+
+private:
+    void startPartUpload(std::vector<uint8_t> data);
+    void waitForPart();
+    void collectUploadedParts();
+
+private:
+    const UploadPart m_uploadPart;
+    const int m_partSize;
+    const int m_maxPartsInFlight;
+    std::vector<uint8_t> m_part;
+    std::deque<std::future<ErrorCode>> m_partsInFlight;
+    int m_partCount = 0;
+    int64_t m_size = 0;
+    ErrorCode m_error = ErrorCode::noError;
+};
+
+} // namespace nx::sdk::cloud_storage
@@ -0,0 +1,73 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "part_prefetcher.h"
+
+#include <algorithm>
+
+#include <nx/kit/debug.h>
+
+namespace nx::sdk::cloud_storage {
+
+PartPrefetcher::PartPrefetcher(FetchPart fetchPart, int partCount, int prefetchDepth):
+    m_fetchPart(std::move(fetchPart)),
+    m_partCount(partCount),
+    m_prefetchDepth(std::max(prefetchDepth, 0))
+{
+    NX_KIT_ASSERT(m_fetchPart);
+}
+
+PartPrefetcher::~PartPrefetcher()
+{
+    dropFetchedParts();
+}
+
+ErrorCode PartPrefetcher::nextPart(std::vector<uint8_t>* outData)
+{
+    if (m_nextPartIndex >= m_partCount)
+        return ErrorCode::noData;
+
+    // The current part is fetched along with the ones ahead of it.
+    startFetching();
+    FetchResult result = m_partsInFlight.front().get();
+    m_partsInFlight.pop_front();
+    ++m_nextPartIndex;
+    startFetching();
+
+    *outData = std::move(result.second);
+    return result.first;
+}
+
+void PartPrefetcher::seek(int partIndex)
+{
+    if (partIndex == m_nextPartIndex)
+        return;
+
+    dropFetchedParts();
+    m_nextPartIndex = std::clamp(partIndex, 0, m_partCount);
+    m_nextFetchIndex = m_nextPartIndex;
+}
+
+void PartPrefetcher::startFetching()
+{
+    const int lastPartIndex = std::min(m_nextPartIndex + m_prefetchDepth, m_partCount - 1);
+    for (; m_nextFetchIndex <= lastPartIndex; ++m_nextFetchIndex)
+    {
+        m_partsInFlight.push_back(std::async(std::launch::async,
+            [fetchPart = m_fetchPart, partIndex = m_nextFetchIndex]()
+            {
+                FetchResult result;
+                result.first = fetchPart(partIndex, &result.second);
+                return result;
+            }));
+    }
+}
+
+void PartPrefetcher::dropFetchedParts()
+{
+    // The requests can not be cancelled, so wait for them to finish.
+    for (auto& part: m_partsInFlight)
+        part.wait();
+    m_partsInFlight.clear();
+}
+
+} // namespace nx::sdk::cloud_storage
@@ -0,0 +1,61 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <utility>
+#include <vector>
+
+#include <nx/sdk/result.h>
+
+namespace nx::sdk::cloud_storage {
+
+/**
+ * Reads the parts of a stored media data chunk for IStreamReader, fetching the next parts in the
+ * background while the current one is being played back, so that the playback does not wait for
+ * a backend request on each part.
+ *
+ * The methods must be called from a single thread, which is the case for IStreamReader.
+ */
+class PartPrefetcher
+{
+public:
+    /**
+     * Fetches a part of the data. Is called on a background thread, concurrently for the
+     * different parts.
+     */
+    using FetchPart = std::function<ErrorCode(int partIndex, std::vector<uint8_t>* outData)>;
+
+    /** @param prefetchDepth Maximum number of the parts being fetched ahead of the current one. */
+    PartPrefetcher(FetchPart fetchPart, int partCount, int prefetchDepth);
+
+    ~PartPrefetcher();
+
+    /**
+     * Waits for the next part to be fetched, and starts fetching the parts following it.
+     * @return ErrorCode::noData if there are no parts left.
+     */
+    ErrorCode nextPart(std::vector<uint8_t>* outData);
+
+    /** Makes nextPart() return the given part; the parts fetched ahead are discarded. */
+    void seek(int partIndex);
+
+private:
+    void startFetching();
+    void dropFetchedParts();
+
+private:
+    using FetchResult = std::pair<ErrorCode, std::vector<uint8_t>>;
+
+    const FetchPart m_fetchPart;
+    const int m_partCount;
+    const int m_prefetchDepth;
+    std::deque<std::future<FetchResult>> m_partsInFlight;
+    int m_nextPartIndex = 0; //< Index of the part nextPart() returns.
+    int m_nextFetchIndex = 0; //< Index of the part to start fetching next.
+};
+
+} // namespace nx::sdk::cloud_storage
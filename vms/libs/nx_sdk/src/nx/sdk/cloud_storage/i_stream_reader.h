@@ -20,7 +20,8 @@ public:
 
     /**
      * Attempts to read a next media data packet. Should return ErrorCode::noData if there is
-     * no data left to read.
+     * no data left to read. To avoid waiting for the backend on each call, the implementation
+     * may read the data ahead, e.g. using nx::sdk::cloud_storage::PartPrefetcher.
      */
     public: virtual ErrorCode getNextData(IMediaDataPacket** packet) = 0;
 
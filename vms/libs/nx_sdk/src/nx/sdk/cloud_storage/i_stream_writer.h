@@ -27,8 +27,11 @@ public:
     static auto interfaceId() { return makeId("nx::sdk::archive::IStreamWriter"); }
 
     /**
-     * Write a data packet. Implementation is discouraged to buffer packets. Instead, it should
-     * block until the data is completely processed.
+     * Write a data packet. Implementation may either block until the data is completely
+     * processed, or buffer the packets and upload them in the background, e.g. using
+     * nx::sdk::cloud_storage::MultipartUpload, if the backend latency limits the throughput. In
+     * the latter case, putData() should return the errors of the already finished uploads, and
+     * the memory used by the buffers and the uploads in flight must be bounded.
      *
      * packet->channelNumber() corresponds to ICodecInfo::channelNumber() i.e. if packet->type() ==
      * dptVideo && packet->channelNumber() == 1, then CodecInfo with
@@ -44,7 +47,9 @@ public:
 
     /**
      * This function will be called just before destruction of the StreamWriter object and no
-     * other calls (except destructor) will follow.
+     * other calls (except destructor) will follow. If the packets are uploaded in the background,
+     * must not return until all of them are stored, and must return the error if any of them
+     * have failed.
      */
     virtual ErrorCode close(int64_t durationMs) = 0;
 
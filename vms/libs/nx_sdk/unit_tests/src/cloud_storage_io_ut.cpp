@@ -0,0 +1,113 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <nx/kit/test.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <nx/sdk/cloud_storage/helpers/multipart_upload.h>
+#include <nx/sdk/cloud_storage/helpers/part_prefetcher.h>
+
+namespace nx {
+namespace sdk {
+namespace cloud_storage {
+namespace test {
+
+TEST(CloudStorageIo, multipartUpload)
+{
+    static constexpr int kPartSize = 4;
+    static constexpr int kMaxPartsInFlight = 2;
+
+    std::mutex mutex;
+    std::map<int, std::vector<uint8_t>> parts;
+    std::atomic<int> partsInFlight{0};
+    std::atomic<int> maxPartsInFlight{0};
+
+    MultipartUpload upload(
+        [&](int partIndex, std::vector<uint8_t> data)
+        {
+            const int count = ++partsInFlight;
+            int maxCount = maxPartsInFlight;
+            while (count > maxCount && !maxPartsInFlight.compare_exchange_weak(maxCount, count))
+            {
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                parts[partIndex] = std::move(data);
+            }
+            --partsInFlight;
+            return ErrorCode::noError;
+        },
+        kPartSize, kMaxPartsInFlight);
+
+    std::vector<uint8_t> data(10);
+    for (int i = 0; i < (int) data.size(); ++i)
+        data[i] = (uint8_t) i;
+
+    ASSERT_TRUE(ErrorCode::noError == upload.append(data.data(), 3));
+    ASSERT_TRUE(ErrorCode::noError == upload.append(data.data() + 3, 7));
+    ASSERT_TRUE(ErrorCode::noError == upload.finish());
+    ASSERT_EQ(10, (int) upload.size());
+
+    ASSERT_EQ(3, (int) parts.size());
+    ASSERT_TRUE(std::vector<uint8_t>({0, 1, 2, 3}) == parts[0]);
+    ASSERT_TRUE(std::vector<uint8_t>({4, 5, 6, 7}) == parts[1]);
+    ASSERT_TRUE(std::vector<uint8_t>({8, 9}) == parts[2]);
+    ASSERT_TRUE(maxPartsInFlight <= kMaxPartsInFlight);
+}
+
+TEST(CloudStorageIo, multipartUploadError)
+{
+    MultipartUpload upload(
+        [](int partIndex, std::vector<uint8_t> /*data*/)
+        {
+            return partIndex == 1 ? ErrorCode::networkError : ErrorCode::noError;
+        },
+        /*partSize*/ 1, /*maxPartsInFlight*/ 1);
+
+    const uint8_t data[3] = {1, 2, 3};
+    upload.append(data, 3);
+    ASSERT_TRUE(ErrorCode::networkError == upload.finish());
+}
+
+TEST(CloudStorageIo, partPrefetcher)
+{
+    static constexpr int kPartCount = 5;
+
+    std::atomic<int> fetchCount{0};
+    PartPrefetcher prefetcher(
+        [&](int partIndex, std::vector<uint8_t>* outData)
+        {
+            ++fetchCount;
+            *outData = {(uint8_t) partIndex};
+            return ErrorCode::noError;
+        },
+        kPartCount, /*prefetchDepth*/ 2);
+
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(ErrorCode::noError == prefetcher.nextPart(&data));
+    ASSERT_TRUE(std::vector<uint8_t>({0}) == data);
+
+    // The part which follows the current one and the one after it are being fetched.
+    ASSERT_TRUE(ErrorCode::noError == prefetcher.nextPart(&data));
+    ASSERT_TRUE(std::vector<uint8_t>({1}) == data);
+
+    prefetcher.seek(4);
+    ASSERT_TRUE(ErrorCode::noError == prefetcher.nextPart(&data));
+    ASSERT_TRUE(std::vector<uint8_t>({4}) == data);
+    ASSERT_TRUE(ErrorCode::noData == prefetcher.nextPart(&data));
+
+    prefetcher.seek(0);
+    ASSERT_TRUE(ErrorCode::noError == prefetcher.nextPart(&data));
+    ASSERT_TRUE(std::vector<uint8_t>({0}) == data);
+    ASSERT_TRUE(fetchCount >= 4);
+}
+
+} // namespace test
+} // namespace cloud_storage
+} // namespace sdk
+} // namespace nx
@@ -4,6 +4,9 @@
 
 #include <flite.h>
 
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+
 extern "C" {
 
 cst_voice* register_cmu_us_slt();
@@ -20,6 +23,11 @@ using CustomUniquePtr = std::unique_ptr<T, DeleterFromFunc<F>>;
 
 namespace {
 
+/** Identifies the voice and its settings in the cache keys, must be changed with them. */
+static const QByteArray kVoiceId = "cmu_us_slt;duration_stretch=1.0;int_f0_target_mean=180";
+
+static constexpr qint64 kDefaultMaxCacheSizeBytes = 16 * 1024 * 1024;
+
 // TODO: #akolesnikov Use ffmpeg instead of the following code (taken from speech_tools).
 
 static bool saveRawData(
@@ -194,6 +202,16 @@ private:
     CustomUniquePtr<cst_voice, unregister_cmu_us_slt> m_vox; //< Flite voice instance.
 };
 
+QByteArray cacheKey(const QString& text)
+{
+    // Hashed to keep the keys small for the long texts.
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(kVoiceId);
+    hash.addData(QByteArrayView("\0", 1));
+    hash.addData(text.toUtf8());
+    return hash.result();
+}
+
 } // namespace
 
 //-------------------------------------------------------------------------------------------------
@@ -206,7 +224,8 @@ namespace nx::speech_synthesizer {
 
 TextToWaveServer::TextToWaveServer(const QString& binaryPath):
     m_binaryPath(binaryPath),
-    m_prevTaskId(1)
+    m_prevTaskId(1),
+    m_cache(kDefaultMaxCacheSizeBytes)
 {
     m_initializedFuture = m_initializedPromise.get_future();
 }
@@ -229,6 +248,12 @@ void TextToWaveServer::pleaseStop()
     m_textQueue.push(QSharedPointer<SynthesizeSpeechTask>(new SynthesizeSpeechTask()));
 }
 
+void TextToWaveServer::setMaxCacheSizeBytes(qint64 value)
+{
+    NX_MUTEX_LOCKER lock(&m_cacheMutex);
+    m_cache.setMaxCost(value);
+}
+
 int TextToWaveServer::generateSoundAsync(const QString& text, QIODevice* const dest)
 {
     QSharedPointer<SynthesizeSpeechTask> task = addTaskToQueue(text, dest);
@@ -240,6 +265,9 @@ bool TextToWaveServer::generateSoundSync(
     QIODevice* const dest,
     nx::media::audio::Format* outFormat)
 {
+    if (const auto result = writeFromCache(text, dest, outFormat))
+        return *result;
+
     NX_MUTEX_LOCKER lock(&m_mutex);
     const QSharedPointer<SynthesizeSpeechTask> task = addTaskToQueue(text, dest);
     while (!task->done)
@@ -265,7 +293,29 @@ void TextToWaveServer::run()
         if (!task->dest)
             continue;
 
-        const bool result = fliteEngine.textToWave(task->text, task->dest, &task->format);
+        // The same phrase may be queued several times before it is cached.
+        bool result = false;
+        if (const auto cachedResult = writeFromCache(task->text, task->dest, &task->format))
+        {
+            result = *cachedResult;
+        }
+        else
+        {
+            auto sound = std::make_unique<SynthesizedSound>();
+            QBuffer buffer(&sound->data);
+            buffer.open(QIODevice::WriteOnly);
+            result = fliteEngine.textToWave(task->text, &buffer, &sound->format);
+            task->format = sound->format;
+
+            if (result)
+            {
+                result = task->dest->write(sound->data) == sound->data.size();
+
+                const qint64 cost = sound->data.size();
+                NX_MUTEX_LOCKER lock(&m_cacheMutex);
+                m_cache.insert(cacheKey(task->text), sound.release(), cost);
+            }
+        }
 
         {
             NX_MUTEX_LOCKER lock(&m_mutex);
@@ -278,6 +328,24 @@ void TextToWaveServer::run()
     }
 }
 
+std::optional<bool> TextToWaveServer::writeFromCache(
+    const QString& text, QIODevice* dest, nx::media::audio::Format* outFormat)
+{
+    QByteArray data;
+    {
+        NX_MUTEX_LOCKER lock(&m_cacheMutex);
+        const SynthesizedSound* sound = m_cache.object(cacheKey(text));
+        if (!sound)
+            return std::nullopt;
+
+        data = sound->data; //< Implicitly shared, so is not copied.
+        if (outFormat)
+            *outFormat = sound->format;
+    }
+
+    return dest->write(data) == data.size();
+}
+
 QSharedPointer<TextToWaveServer::SynthesizeSpeechTask> TextToWaveServer::addTaskToQueue(
     const QString& text, QIODevice* const dest)
 {
@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <optional>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCache>
 #include <QtCore/QIODevice>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QString>
@@ -19,6 +23,10 @@ namespace nx::speech_synthesizer {
 /**
  * Synthesizes wav based on a text. Uses Flite engine. Has an internal thread. Holds the queue
  * of texts to synthesize.
+ *
+ * The synthesized sounds are cached by the text and the voice, so the phrases which are spoken
+ * repeatedly (e.g. by the rules triggered again and again) are synthesized once. The synchronous
+ * requests of the cached phrases are served without waiting in the queue.
  */
 class TextToWaveServer:
     public QnLongRunnable,
@@ -34,6 +42,9 @@ public:
 
     virtual void pleaseStop() override;
 
+    /** Limits the total size of the cached wave data, 0 disables the caching. */
+    void setMaxCacheSizeBytes(qint64 value);
+
 public slots:
     /**
      * Adds the task to the queue.
@@ -72,6 +83,12 @@ private:
         bool done = false;
     };
 
+    struct SynthesizedSound
+    {
+        QByteArray data; //< Complete wave file.
+        nx::media::audio::Format format;
+    };
+
     QString m_binaryPath;
     QnSafeQueue<QSharedPointer<SynthesizeSpeechTask>> m_textQueue;
     QAtomicInt m_prevTaskId;
@@ -81,7 +98,14 @@ private:
     nx::utils::promise<void> m_initializedPromise;
     nx::utils::future<void> m_initializedFuture;
 
+    nx::Mutex m_cacheMutex;
+    QCache<QByteArray, SynthesizedSound> m_cache;
+
     QSharedPointer<SynthesizeSpeechTask> addTaskToQueue(const QString& text, QIODevice* dest);
+
+    /** @return Result of writing the cached sound to the device, nullopt if it is not cached. */
+    std::optional<bool> writeFromCache(
+        const QString& text, QIODevice* dest, nx::media::audio::Format* outFormat);
 };
 
 } // namespace nx::speech_synthesizer
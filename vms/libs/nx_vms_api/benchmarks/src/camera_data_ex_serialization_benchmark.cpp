@@ -0,0 +1,85 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <benchmark/benchmark.h>
+
+#include <nx/fusion/serialization/ubjson.h>
+#include <nx/reflect/binary.h>
+#include <nx/reflect/json.h>
+#include <nx/vms/api/data/camera_data_ex.h>
+
+namespace nx::vms::api::test {
+
+namespace {
+
+/**
+ * The device list is the largest response a client receives when it connects to a system.
+ */
+CameraDataExList generateCameras(int count)
+{
+    CameraDataExList cameras;
+    for (int i = 0; i < count; ++i)
+    {
+        CameraDataEx camera;
+        camera.id = nx::Uuid::createUuid();
+        camera.parentId = nx::Uuid::createUuid();
+        camera.typeId = nx::Uuid::createUuid();
+        camera.name = QString("Camera %1").arg(i);
+        camera.url = QString("rtsp://10.0.%1.%2/stream").arg(i / 256).arg(i % 256);
+        camera.physicalId = QString("camera-%1").arg(i);
+        camera.model = "Model";
+        camera.vendor = "Vendor";
+        camera.manuallyAdded = i % 2 == 0;
+        camera.status = ResourceStatus::online;
+        camera.addParams.emplace_back("firmware", QString("1.0.%1").arg(i));
+        camera.addParams.emplace_back("streamUrls", R"({"1":"rtsp://host/1","2":"rtsp://host/2"})");
+        cameras.push_back(std::move(camera));
+    }
+    return cameras;
+}
+
+constexpr int kCameraCount = 1000;
+
+} // namespace
+
+static void CameraDataEx_reflectJsonRoundTrip(benchmark::State& state)
+{
+    const auto cameras = generateCameras(kCameraCount);
+    for (auto _: state)
+    {
+        const auto serialized = nx::reflect::json::serialize(cameras);
+        CameraDataExList deserialized;
+        benchmark::DoNotOptimize(nx::reflect::json::deserialize(serialized, &deserialized));
+        state.counters["bytes"] = (double) serialized.size();
+    }
+    state.SetItemsProcessed(state.iterations() * kCameraCount);
+}
+BENCHMARK(CameraDataEx_reflectJsonRoundTrip);
+
+static void CameraDataEx_reflectBinaryRoundTrip(benchmark::State& state)
+{
+    const auto cameras = generateCameras(kCameraCount);
+    for (auto _: state)
+    {
+        const auto serialized = nx::reflect::binary::serialize(cameras);
+        CameraDataExList deserialized;
+        benchmark::DoNotOptimize(nx::reflect::binary::deserialize(serialized, &deserialized));
+        state.counters["bytes"] = (double) serialized.size();
+    }
+    state.SetItemsProcessed(state.iterations() * kCameraCount);
+}
+BENCHMARK(CameraDataEx_reflectBinaryRoundTrip);
+
+static void CameraDataEx_ubjsonRoundTrip(benchmark::State& state)
+{
+    const auto cameras = generateCameras(kCameraCount);
+    for (auto _: state)
+    {
+        const QByteArray serialized = QnUbjson::serialized(cameras);
+        benchmark::DoNotOptimize(QnUbjson::deserialized<CameraDataExList>(serialized));
+        state.counters["bytes"] = (double) serialized.size();
+    }
+    state.SetItemsProcessed(state.iterations() * kCameraCount);
+}
+BENCHMARK(CameraDataEx_ubjsonRoundTrip);
+
+} // namespace nx::vms::api::test
@@ -2,6 +2,7 @@
 
 #include "device_agent_manifest.h"
 
+#include <algorithm>
 #include <set>
 
 #include <nx/fusion/model_functions.h>
@@ -9,9 +10,29 @@
 
 namespace nx::vms::api::analytics {
 
+QN_FUSION_ADAPT_STRUCT_FUNCTIONS(VideoFrameSampling, (json), VideoFrameSampling_Fields,
+    (brief, true))
+
 QN_FUSION_ADAPT_STRUCT_FUNCTIONS(DeviceAgentManifest, (json), DeviceAgentManifest_Fields,
     (brief, true))
 
+VideoFrameSampling VideoFrameSampling::united(const VideoFrameSampling& other) const
+{
+    // Zero means no limit, so it wins over any other value.
+    const auto unitedLimit =
+        [](auto first, auto second)
+        {
+            return (first == 0 || second == 0) ? decltype(first){} : std::max(first, second);
+        };
+
+    VideoFrameSampling result;
+    result.maxFps = unitedLimit(maxFps, other.maxFps);
+    result.maxFrameWidth = unitedLimit(maxFrameWidth, other.maxFrameWidth);
+    result.maxFrameHeight = unitedLimit(maxFrameHeight, other.maxFrameHeight);
+    result.keyFramesOnly = keyFramesOnly && other.keyFramesOnly;
+    return result;
+}
+
 class ListProcessor
 {
 public:
@@ -190,6 +211,10 @@ std::vector<ManifestError> validate(const DeviceAgentManifest& deviceAgentManife
         result.emplace_back(ManifestErrorType::deviceAgentSettingsModelIsIncorrect);
     }
 
+    const auto& sampling = deviceAgentManifest.videoFrameSampling;
+    if (sampling.maxFps < 0 || sampling.maxFrameWidth < 0 || sampling.maxFrameHeight < 0)
+        result.emplace_back(ManifestErrorType::videoFrameSamplingIsIncorrect);
+
     return result;
 }
 
@@ -23,6 +23,38 @@ NX_REFLECTION_ENUM_CLASS(DeviceAgentCapability,
 )
 Q_DECLARE_FLAGS(DeviceAgentCapabilities, DeviceAgentCapability)
 
+/**%apidoc
+ * Limits of the video frames the DeviceAgent needs. The Server does not decode and convert the
+ * frames beyond these limits. Zero values mean no limit.
+ */
+struct NX_VMS_API VideoFrameSampling
+{
+    /**%apidoc[opt] Maximum frame rate, in frames per second. */
+    double maxFps = 0;
+
+    /**%apidoc[opt] Maximum width of the uncompressed frames; the frames are scaled down. */
+    int maxFrameWidth = 0;
+
+    /**%apidoc[opt] Maximum height of the uncompressed frames; the frames are scaled down. */
+    int maxFrameHeight = 0;
+
+    /**%apidoc[opt] Whether only the key frames are needed. */
+    bool keyFramesOnly = false;
+
+    bool isEmpty() const { return *this == VideoFrameSampling(); }
+
+    /**
+     * @return Sampling which provides all the frames needed by either of the samplings, to be
+     *     used when several DeviceAgents consume the same stream.
+     */
+    VideoFrameSampling united(const VideoFrameSampling& other) const;
+
+    bool operator==(const VideoFrameSampling& other) const = default;
+};
+#define VideoFrameSampling_Fields (maxFps)(maxFrameWidth)(maxFrameHeight)(keyFramesOnly)
+NX_REFLECTION_INSTRUMENT(VideoFrameSampling, VideoFrameSampling_Fields);
+QN_FUSION_DECLARE_FUNCTIONS(VideoFrameSampling, (json), NX_VMS_API)
+
 /**%apidoc
  * The data structure that is given by each Analytics Engine's DeviceAgent to the Server after the
  * DeviceAgent has been created by the Engine.
@@ -67,6 +99,9 @@ struct NX_VMS_API DeviceAgentManifest
     /**%apidoc[opt] */
     TypeLibrary typeLibrary;
 
+    /**%apidoc[opt] */
+    VideoFrameSampling videoFrameSampling;
+
     bool operator==(const DeviceAgentManifest& other) const = default;
 };
 
@@ -81,7 +116,8 @@ NX_VMS_API std::vector<ManifestError> validate(const DeviceAgentManifest& device
     (groups) \
     (deviceAgentSettingsModel) \
     (supportedTypes) \
-    (typeLibrary)
+    (typeLibrary) \
+    (videoFrameSampling)
 
 NX_REFLECTION_INSTRUMENT(DeviceAgentManifest, DeviceAgentManifest_Fields);
 
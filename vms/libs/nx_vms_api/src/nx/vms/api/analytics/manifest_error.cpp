@@ -57,6 +57,8 @@ QString toString(ManifestErrorType errorType)
         }
         case ManifestErrorType::excessiveUncompressedFramePixelFormatSpecification:
             return "Pixel format is specified but uncompressed video stream is not requested";
+        case ManifestErrorType::videoFrameSamplingIsIncorrect:
+            return "Video frame sampling contains negative limits";
         default:
             NX_ASSERT(false);
             return "Internal error while processing the manifest";
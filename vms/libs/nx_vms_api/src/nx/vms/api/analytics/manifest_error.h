@@ -40,7 +40,9 @@ NX_REFLECTION_ENUM_CLASS(ManifestErrorType,
     deviceAgentSettingsModelIsIncorrect = 1 << 21,
 
     uncompressedFramePixelFormatIsNotSpecified = 1 << 22,
-    excessiveUncompressedFramePixelFormatSpecification = 1 << 23
+    excessiveUncompressedFramePixelFormatSpecification = 1 << 23,
+
+    videoFrameSamplingIsIncorrect = 1 << 24
 )
 Q_DECLARE_FLAGS(ManifestErrorTypes, ManifestErrorType)
 Q_DECLARE_OPERATORS_FOR_FLAGS(ManifestErrorTypes)
@@ -0,0 +1,97 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <nx/reflect/json.h>
+#include <nx/vms/api/data/camera_data_ex.h>
+
+namespace nx::vms::api::test {
+
+namespace {
+
+CameraDataExList generateCameras(int count)
+{
+    CameraDataExList cameras;
+    for (int i = 0; i < count; ++i)
+    {
+        CameraDataEx camera;
+        camera.id = nx::Uuid::createUuid();
+        camera.parentId = nx::Uuid::createUuid();
+        camera.typeId = nx::Uuid::createUuid();
+        camera.name = QString("Camera %1").arg(i);
+        camera.url = QString("rtsp://10.0.%1.%2/stream").arg(i / 256).arg(i % 256);
+        camera.physicalId = QString("camera-%1").arg(i);
+        camera.model = "Model";
+        camera.vendor = "Vendor";
+        camera.manuallyAdded = i % 2 == 0;
+        camera.status = ResourceStatus::online;
+        camera.addParams.emplace_back("firmware", QString("1.0.%1").arg(i));
+        camera.addParams.emplace_back("streamUrls", R"({"1":"rtsp://host/1","2":"rtsp://host/2"})");
+        cameras.push_back(std::move(camera));
+    }
+    return cameras;
+}
+
+nx::reflect::DeserializationResult deserializeWithDom(
+    const std::string& json, CameraDataExList* cameras)
+{
+    rapidjson::Document document;
+    document.Parse(json.data(), json.size());
+    if (document.HasParseError())
+        return nx::reflect::DeserializationResult(false);
+
+    return nx::reflect::json::deserialize(
+        nx::reflect::json::DeserializationContext{document, /*flags*/ 0}, cameras);
+}
+
+} // namespace
+
+TEST(CameraDataExJson, deserialization_without_dom_gives_same_result)
+{
+    const auto json = nx::reflect::json::serialize(generateCameras(10));
+
+    CameraDataExList expected;
+    ASSERT_TRUE(deserializeWithDom(json, &expected));
+
+    CameraDataExList actual;
+    ASSERT_TRUE(nx::reflect::json_detail::deserializeWithoutDom(json, &actual, /*flags*/ 0));
+    ASSERT_EQ(expected, actual);
+}
+
+TEST(CameraDataExJson, DISABLED_deserialization_performance)
+{
+    static constexpr int kCameraCount = 10'000;
+    static constexpr int kIterations = 20;
+
+    const auto json = nx::reflect::json::serialize(generateCameras(kCameraCount));
+
+    const auto measure =
+        [&json](auto deserialize)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i)
+            {
+                CameraDataExList cameras;
+                EXPECT_TRUE(deserialize(json, &cameras));
+            }
+            const std::chrono::duration<double> duration =
+                std::chrono::steady_clock::now() - start;
+            return kIterations * json.size() / duration.count() / (1024 * 1024);
+        };
+
+    const auto withDom = measure(&deserializeWithDom);
+    const auto withoutDom = measure(
+        [](const std::string& json, CameraDataExList* cameras)
+        {
+            return nx::reflect::json_detail::deserializeWithoutDom(json, cameras, /*flags*/ 0);
+        });
+
+    std::cout << kCameraCount << " cameras, " << json.size() << " bytes. "
+        << "DOM: " << withDom << " MB/s. Without DOM: " << withoutDom << " MB/s" << std::endl;
+}
+
+} // namespace nx::vms::api::test
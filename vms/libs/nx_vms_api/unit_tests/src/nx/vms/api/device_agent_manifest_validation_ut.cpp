@@ -137,6 +137,12 @@ protected:
         givenCorrectManifest();
         m_manifest.deviceAgentSettingsModel = Type{};
     }
+
+    void givenManifestWithNegativeVideoFrameSampling()
+    {
+        givenCorrectManifest();
+        m_manifest.videoFrameSampling.maxFps = -1;
+    }
 };
 
 TEST_F(DeviceAgentManifestValidationTest, correctManifestProducesNoErrors)
@@ -274,4 +280,33 @@ TEST_F(DeviceAgentManifestValidationTest, manifestWithIncorrectTypeInSettingsMod
     makeSureErrorsAreCaught({ManifestErrorType::deviceAgentSettingsModelIsIncorrect});
 }
 
+TEST_F(DeviceAgentManifestValidationTest, manifestWithNegativeVideoFrameSamplingProducesAnError)
+{
+    givenManifestWithNegativeVideoFrameSampling();
+    whenValidatingManifest();
+    makeSureErrorsAreCaught({ManifestErrorType::videoFrameSamplingIsIncorrect});
+}
+
+TEST(VideoFrameSampling, unitedSamplingProvidesFramesOfBoth)
+{
+    VideoFrameSampling first;
+    first.maxFps = 2;
+    first.maxFrameWidth = 640;
+    first.maxFrameHeight = 480;
+    first.keyFramesOnly = true;
+
+    VideoFrameSampling second;
+    second.maxFps = 5;
+    second.maxFrameWidth = 320;
+    second.keyFramesOnly = true;
+
+    const auto united = first.united(second);
+    ASSERT_EQ(5, united.maxFps);
+    ASSERT_EQ(640, united.maxFrameWidth);
+    ASSERT_EQ(0, united.maxFrameHeight); //< The second one needs any height.
+    ASSERT_TRUE(united.keyFramesOnly);
+
+    ASSERT_TRUE(first.united(VideoFrameSampling()).isEmpty());
+}
+
 } // namespace nx::vms::api::analytics
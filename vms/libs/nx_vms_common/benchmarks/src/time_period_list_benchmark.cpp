@@ -0,0 +1,68 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <recording/time_period_list.h>
+
+namespace nx::vms::common::test {
+
+namespace {
+
+/**
+ * Chunks of a day of motion-triggered recording: a minute of recording per two minutes, shifted
+ * by the server index, as the servers of a multi-server system report them.
+ */
+std::vector<QnTimePeriodList> generateServerPeriods(int serverCount)
+{
+    constexpr qint64 kMinuteMs = 60'000;
+    constexpr int kChunkCount = 24 * 60 / 2;
+
+    std::vector<QnTimePeriodList> lists(serverCount);
+    for (int server = 0; server < serverCount; ++server)
+    {
+        for (int i = 0; i < kChunkCount; ++i)
+        {
+            lists[server].push_back(
+                QnTimePeriod(i * 2 * kMinuteMs + server * kMinuteMs / serverCount, kMinuteMs));
+        }
+    }
+    return lists;
+}
+
+} // namespace
+
+static void TimePeriodList_merge(benchmark::State& state)
+{
+    const auto lists = generateServerPeriods((int) state.range(0));
+    for (auto _: state)
+        benchmark::DoNotOptimize(QnTimePeriodList::mergeTimePeriods(lists));
+}
+BENCHMARK(TimePeriodList_merge)->Arg(2)->Arg(16);
+
+static void TimePeriodList_union(benchmark::State& state)
+{
+    const auto lists = generateServerPeriods((int) state.range(0));
+    for (auto _: state)
+    {
+        QnTimePeriodList result = lists[0];
+        for (std::size_t i = 1; i < lists.size(); ++i)
+            QnTimePeriodList::unionTimePeriods(result, lists[i]);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(TimePeriodList_union)->Arg(2)->Arg(16);
+
+static void TimePeriodList_aggregate(benchmark::State& state)
+{
+    const auto lists = generateServerPeriods(/*serverCount*/ 1);
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(
+            QnTimePeriodList::aggregateTimePeriods(lists[0], std::chrono::minutes(5)));
+    }
+}
+BENCHMARK(TimePeriodList_aggregate);
+
+} // namespace nx::vms::common::test
@@ -0,0 +1,293 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "attribute_text_index.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+namespace nx::analytics::db {
+
+using namespace std::chrono;
+
+namespace {
+
+/** TextMatcher ignores the conditions after the first 64 ones. */
+static constexpr size_t kMaxConditions = 64;
+
+void unite(const std::vector<quint32>& postings, std::vector<quint32>* result)
+{
+    std::vector<quint32> united;
+    united.reserve(result->size() + postings.size());
+    std::set_union(result->begin(), result->end(), postings.begin(), postings.end(),
+        std::back_inserter(united));
+    *result = std::move(united);
+}
+
+template<typename Key>
+void uniteAll(
+    const std::map<Key, std::vector<quint32>>& map,
+    const std::set<Key>& keys,
+    std::vector<quint32>* result)
+{
+    for (const auto& key: keys)
+    {
+        if (const auto it = map.find(key); it != map.end())
+            unite(it->second, result);
+    }
+}
+
+void unitePrefixed(
+    const std::map<QString, std::vector<quint32>>& map,
+    const QString& prefix,
+    std::vector<quint32>* result)
+{
+    // The short prefixes match many terms, so the lists are merged once.
+    std::vector<quint32> numbers;
+    for (auto it = map.lower_bound(prefix); it != map.end() && it->first.startsWith(prefix); ++it)
+        numbers.insert(numbers.end(), it->second.begin(), it->second.end());
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+    unite(numbers, result);
+}
+
+/**
+ * @return The longest word of the text, which is contained in a word of the value if the text is
+ *     contained in the value.
+ */
+QString longestWord(const QString& text)
+{
+    QStringView result;
+    for (const auto& word: QStringView(text).split(' ', Qt::SkipEmptyParts))
+    {
+        if (word.size() > result.size())
+            result = word;
+    }
+    return result.toString().toCaseFolded();
+}
+
+} // namespace
+
+AttributeTextIndex::AttributeTextIndex(microseconds partitionDuration):
+    m_partitionDuration(std::max(partitionDuration, microseconds(1)))
+{
+}
+
+void AttributeTextIndex::add(const ObjectTrack& track)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+
+    auto [trackIt, isNew] = m_tracks.try_emplace(track.id);
+    if (isNew)
+    {
+        const auto partitionIt = m_partitions.try_emplace(
+            track.firstAppearanceTimeUs / m_partitionDuration.count()).first;
+        trackIt->second.partition = partitionIt->first;
+        trackIt->second.number = (quint32) partitionIt->second.trackIds.size();
+        partitionIt->second.trackIds.push_back(track.id);
+    }
+
+    const quint32 number = trackIt->second.number;
+    Partition& partition = m_partitions[trackIt->second.partition];
+    partition.maxLastAppearanceTimeUs =
+        std::max(partition.maxLastAppearanceTimeUs, track.lastAppearanceTimeUs);
+    addPosting(&partition.objectTypeIds[track.objectTypeId], number);
+    addPosting(&partition.deviceIds[track.deviceId], number);
+
+    for (const auto& attribute: track.attributes)
+    {
+        // NOTE: The period is used to separate Attribute names of nested Objects.
+        const QString name = attribute.name.toCaseFolded();
+        for (int pos = name.indexOf('.'); pos >= 0; pos = name.indexOf('.', pos + 1))
+            addPosting(&partition.attributeNames[name.left(pos)], number);
+        addPosting(&partition.attributeNames[name], number);
+
+        for (const auto& word: QStringView(attribute.value).split(' ', Qt::SkipEmptyParts))
+        {
+            const QString foldedWord = word.toString().toCaseFolded();
+            for (int i = 0; i + kMinTokenLength <= foldedWord.size(); ++i)
+                addPosting(&partition.valueSuffixes[foldedWord.mid(i)], number);
+        }
+    }
+}
+
+void AttributeTextIndex::removeBefore(microseconds time)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    for (auto it = m_partitions.begin(); it != m_partitions.end();)
+    {
+        if (it->second.maxLastAppearanceTimeUs >= time.count())
+        {
+            ++it;
+            continue;
+        }
+
+        for (const auto& trackId: it->second.trackIds)
+            m_tracks.erase(trackId);
+        it = m_partitions.erase(it);
+    }
+}
+
+std::vector<nx::Uuid> AttributeTextIndex::lookup(
+    const Filter& filter, const AbstractObjectTypeDictionary& objectTypeDictionary) const
+{
+    std::vector<TextSearchCondition> conditions;
+    if (!filter.freeText.isEmpty())
+        conditions = UserTextSearchExpressionParser().parse(filter.freeText);
+    if (conditions.size() > kMaxConditions)
+        conditions.erase(conditions.begin() + kMaxConditions, conditions.end());
+
+    const qint64 startTimeUs = duration_cast<microseconds>(filter.timePeriod.startTime()).count();
+    const std::optional<qint64> endTimeUs = filter.timePeriod.isInfinite()
+        ? std::nullopt
+        : std::optional(duration_cast<microseconds>(filter.timePeriod.endTime()).count());
+
+    ObjectTypeNameMatches objectTypeNameMatches;
+    std::vector<nx::Uuid> result;
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    for (const auto& [index, partition]: m_partitions)
+    {
+        if (endTimeUs && index * m_partitionDuration.count() > *endTimeUs)
+            break;
+        if (partition.maxLastAppearanceTimeUs < startTimeUs)
+            continue;
+
+        auto trackIds = lookupPartition(
+            partition, filter, conditions, objectTypeDictionary, &objectTypeNameMatches);
+        result.insert(result.end(), trackIds.begin(), trackIds.end());
+    }
+    return result;
+}
+
+int AttributeTextIndex::trackCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return (int) m_tracks.size();
+}
+
+void AttributeTextIndex::addPosting(Postings* postings, quint32 number)
+{
+    // The Tracks are mostly added in the order of their numbers, and updated rarely.
+    if (postings->empty() || postings->back() < number)
+    {
+        postings->push_back(number);
+        return;
+    }
+
+    const auto it = std::lower_bound(postings->begin(), postings->end(), number);
+    if (*it != number)
+        postings->insert(it, number);
+}
+
+std::optional<AttributeTextIndex::Postings> AttributeTextIndex::conditionPostings(
+    const Partition& partition,
+    const TextSearchCondition& condition,
+    const AbstractObjectTypeDictionary& objectTypeDictionary,
+    ObjectTypeNameMatches* objectTypeNameMatches) const
+{
+    if (condition.isNegative)
+        return std::nullopt;
+
+    Postings result;
+    switch (condition.type)
+    {
+        case ConditionType::textMatch:
+        {
+            // The text is matched by the Object Type name prefix, or by a part of the Attribute
+            // value word, if it is long enough for TextMatcher.
+            for (const auto& [objectTypeId, postings]: partition.objectTypeIds)
+            {
+                const auto [it, isNew] = objectTypeNameMatches->try_emplace(
+                    std::make_pair(objectTypeId, condition.text));
+                if (isNew)
+                {
+                    const auto name = objectTypeDictionary.idToName(objectTypeId);
+                    it->second = name && name->startsWith(condition.text, Qt::CaseInsensitive);
+                }
+                if (it->second)
+                    unite(postings, &result);
+            }
+
+            if (condition.text.size() >= kMinTokenLength && !condition.text.contains(' '))
+                unitePrefixed(partition.valueSuffixes, condition.text.toCaseFolded(), &result);
+            return result;
+        }
+
+        case ConditionType::attributePresenceCheck:
+        case ConditionType::attributeValueMatch:
+        {
+            const QString name = condition.name.toCaseFolded();
+            if (name.endsWith('*'))
+                unitePrefixed(partition.attributeNames, name.chopped(1), &result);
+            else
+                uniteAll(partition.attributeNames, std::set<QString>{name}, &result);
+
+            if (condition.type == ConditionType::attributePresenceCheck)
+                return result;
+
+            const QString word = longestWord(condition.valueToken.value);
+            if (word.size() < kMinTokenLength)
+                return result;
+
+            Postings valuePostings;
+            unitePrefixed(partition.valueSuffixes, word, &valuePostings);
+            Postings intersection;
+            std::set_intersection(result.begin(), result.end(),
+                valuePostings.begin(), valuePostings.end(), std::back_inserter(intersection));
+            return intersection;
+        }
+
+        case ConditionType::numericRangeMatch:
+            uniteAll(partition.attributeNames, std::set<QString>{condition.name.toCaseFolded()},
+                &result);
+            return result;
+    }
+
+    return std::nullopt;
+}
+
+std::vector<nx::Uuid> AttributeTextIndex::lookupPartition(
+    const Partition& partition,
+    const Filter& filter,
+    const std::vector<TextSearchCondition>& conditions,
+    const AbstractObjectTypeDictionary& objectTypeDictionary,
+    ObjectTypeNameMatches* objectTypeNameMatches) const
+{
+    std::vector<Postings> terms;
+    if (!filter.deviceIds.empty())
+        uniteAll(partition.deviceIds, filter.deviceIds, &terms.emplace_back());
+    if (!filter.objectTypeId.empty())
+        uniteAll(partition.objectTypeIds, filter.objectTypeId, &terms.emplace_back());
+    for (const auto& condition: conditions)
+    {
+        if (auto postings = conditionPostings(
+            partition, condition, objectTypeDictionary, objectTypeNameMatches))
+        {
+            terms.push_back(std::move(*postings));
+        }
+    }
+
+    if (terms.empty())
+        return partition.trackIds;
+
+    std::sort(terms.begin(), terms.end(),
+        [](const auto& left, const auto& right) { return left.size() < right.size(); });
+
+    Postings numbers = std::move(terms.front());
+    for (size_t i = 1; i < terms.size() && !numbers.empty(); ++i)
+    {
+        Postings intersection;
+        std::set_intersection(numbers.begin(), numbers.end(),
+            terms[i].begin(), terms[i].end(), std::back_inserter(intersection));
+        numbers = std::move(intersection);
+    }
+
+    std::vector<nx::Uuid> result;
+    result.reserve(numbers.size());
+    for (const quint32 number: numbers)
+        result.push_back(partition.trackIds[number]);
+    return result;
+}
+
+} // namespace nx::analytics::db
@@ -0,0 +1,120 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include <nx/utils/thread/mutex.h>
+#include <nx/utils/uuid.h>
+
+#include "abstract_object_type_dictionary.h"
+#include "analytics_db_types.h"
+#include "text_search_utils.h"
+
+namespace nx::analytics::db {
+
+/**
+ * Inverted index of the Object Tracks by the words of the Attribute values, the Attribute names,
+ * the Object Type ids and the Device ids. It selects the candidate Tracks for the Filter without
+ * checking each Track.
+ *
+ * The index is partitioned by the first appearance time of the Tracks, so the partitions out of
+ * the Filter time period are not looked up, and the old partitions are dropped as a whole. Each
+ * search term gives a sorted posting list of the Tracks of the partition, and the lists of the
+ * terms are intersected, starting from the shortest one.
+ *
+ * The values are matched by the substrings of the words, so all the suffixes (of at least
+ * kMinTokenLength characters) of each word are indexed: a text is contained in a word if it is a
+ * prefix of a suffix of the word, which is looked up in the sorted term map.
+ *
+ * The candidates are a superset of the Tracks accepted by Filter::acceptsTrack(), which is still
+ * to be called for each of them. The conditions which can not be served by the index (negative
+ * ones, too short texts) do not narrow the candidates. Thread-safe.
+ */
+class NX_VMS_COMMON_API AttributeTextIndex
+{
+public:
+    static constexpr int kMinTokenLength = 3;
+
+    explicit AttributeTextIndex(
+        std::chrono::microseconds partitionDuration = std::chrono::hours(1));
+
+    /**
+     * Indexes the Track. If the Track has been indexed already, the terms of its new Attributes
+     * and Object Type are added to it.
+     */
+    void add(const ObjectTrack& track);
+
+    /** Drops the partitions, all the Tracks of which have disappeared before the time. */
+    void removeBefore(std::chrono::microseconds time);
+
+    /**
+     * @return Ids of the indexed Tracks which may be accepted by the Filter, in no particular
+     *     order. The text filter is treated as it is done by Filter::acceptsTrack().
+     */
+    std::vector<nx::Uuid> lookup(
+        const Filter& filter, const AbstractObjectTypeDictionary& objectTypeDictionary) const;
+
+    int trackCount() const;
+
+private:
+    /** Sorted numbers of the Tracks in the partition. */
+    using Postings = std::vector<quint32>;
+
+    struct Partition
+    {
+        std::vector<nx::Uuid> trackIds;
+        qint64 maxLastAppearanceTimeUs = 0;
+
+        /** By the case-folded suffixes of the Attribute value words. */
+        std::map<QString, Postings> valueSuffixes;
+
+        /** By the case-folded Attribute names and their nested Object prefixes. */
+        std::map<QString, Postings> attributeNames;
+
+        std::map<QString, Postings> objectTypeIds;
+        std::map<nx::Uuid, Postings> deviceIds;
+    };
+
+    struct TrackLocation
+    {
+        qint64 partition = 0;
+        quint32 number = 0;
+    };
+
+    /** Cache of the Object Type ids matched by the name prefixes, shared by the partitions. */
+    using ObjectTypeNameMatches = std::map<std::pair<QString, QString>, bool>;
+
+    static void addPosting(Postings* postings, quint32 number);
+
+    /**
+     * @return The Postings of the condition, or std::nullopt if the condition does not narrow
+     *     the candidates.
+     */
+    std::optional<Postings> conditionPostings(
+        const Partition& partition,
+        const TextSearchCondition& condition,
+        const AbstractObjectTypeDictionary& objectTypeDictionary,
+        ObjectTypeNameMatches* objectTypeNameMatches) const;
+
+    std::vector<nx::Uuid> lookupPartition(
+        const Partition& partition,
+        const Filter& filter,
+        const std::vector<TextSearchCondition>& conditions,
+        const AbstractObjectTypeDictionary& objectTypeDictionary,
+        ObjectTypeNameMatches* objectTypeNameMatches) const;
+
+private:
+    const std::chrono::microseconds m_partitionDuration;
+    mutable nx::Mutex m_mutex;
+    std::map<qint64, Partition> m_partitions;
+    std::unordered_map<nx::Uuid, TrackLocation> m_tracks;
+};
+
+} // namespace nx::analytics::db
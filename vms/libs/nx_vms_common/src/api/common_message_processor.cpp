@@ -27,6 +27,7 @@
 #include <nx/network/rest/user_access_data.h>
 #include <nx/network/socket_common.h>
 #include <nx/network/url/url_parse_helper.h>
+#include <nx/utils/elapsed_timer.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/std/algorithm.h>
 #include <nx/vms/api/data/access_rights_data_deprecated.h>
@@ -194,12 +195,25 @@ void QnCommonMessageProcessor::connectToConnection(const ec2::AbstractECConnecti
         this,
         &QnCommonMessageProcessor::on_resourceStatusChanged,
         connectionType);
-    connect(
-        resourceManager.get(),
-        &ec2::AbstractResourceNotificationManager::resourceParamChanged,
-        this,
-        &QnCommonMessageProcessor::on_resourceParamChanged,
-        connectionType);
+    // Queued handlers opt in to the batched changes, so a bulk update is delivered as one event.
+    if (connectionType == Qt::QueuedConnection)
+    {
+        connect(
+            resourceManager.get(),
+            &ec2::AbstractResourceNotificationManager::resourceParamsChanged,
+            this,
+            &QnCommonMessageProcessor::on_resourceParamsChanged,
+            connectionType);
+    }
+    else
+    {
+        connect(
+            resourceManager.get(),
+            &ec2::AbstractResourceNotificationManager::resourceParamChanged,
+            this,
+            &QnCommonMessageProcessor::on_resourceParamChanged,
+            connectionType);
+    }
     connect(
         resourceManager.get(),
         &ec2::AbstractResourceNotificationManager::resourceParamRemoved,
@@ -666,6 +680,14 @@ void QnCommonMessageProcessor::on_resourceParamChanged(
     }
 }
 
+void QnCommonMessageProcessor::on_resourceParamsChanged(
+    const nx::vms::api::ResourceParamWithRefDataList& params,
+    ec2::NotificationSource source)
+{
+    for (const auto& param: params)
+        on_resourceParamChanged(param, source);
+}
+
 bool QnCommonMessageProcessor::handleRemoteAnalyticsNotification(
     const nx::vms::api::ResourceParamWithRefData& /*param*/,
     ec2::NotificationSource /*source*/)
@@ -1083,27 +1105,46 @@ void QnCommonMessageProcessor::on_initNotification(const FullInfoData& fullData)
 
 void QnCommonMessageProcessor::onGotInitialNotification(const FullInfoData& fullData)
 {
+    // The duration of each phase is logged, so the slow one can be found on the large Systems.
+    QStringList profile;
+    nx::utils::ElapsedTimer timer(nx::utils::ElapsedTimerState::started);
+    const auto runPhase =
+        [&profile, &timer](const char* name, auto&& phase)
+        {
+            phase();
+            profile.append(nx::format("%1 %2").args(name, timer.restart()));
+        };
+
     m_context->resourceAccessManager()->beginUpdate();
 
     m_context->serverAdditionalAddressesDictionary()->clear();
 
-    resetResourceTypes(fullData.resourceTypes);
-    resetServerUserAttributesList(fullData.serversUserAttributesList);
-    resetCameraUserAttributesList(fullData.cameraUserAttributesList);
-    resetPropertyList(fullData.allProperties);
-    resetUserGroups(fullData.userGroups);
-    resetResources(fullData);
-    resetCamerasWithArchiveList(fullData.cameraHistory);
-    resetStatusList(fullData.resStatusList);
-    resetLicenses(fullData.licenses);
+    runPhase("resource types", [&] { resetResourceTypes(fullData.resourceTypes); });
+    runPhase("attributes",
+        [&]
+        {
+            resetServerUserAttributesList(fullData.serversUserAttributesList);
+            resetCameraUserAttributesList(fullData.cameraUserAttributesList);
+        });
+    runPhase("properties", [&] { resetPropertyList(fullData.allProperties); });
+    runPhase("user groups", [&] { resetUserGroups(fullData.userGroups); });
+    runPhase("resources", [&] { resetResources(fullData); });
+    runPhase("camera history", [&] { resetCamerasWithArchiveList(fullData.cameraHistory); });
+    runPhase("statuses", [&] { resetStatusList(fullData.resStatusList); });
+    runPhase("licenses", [&] { resetLicenses(fullData.licenses); });
 
     // TODO: #sivanov Logic is not perfect, who will clean them on disconnect?
-    resetEventRules(fullData.rules);
-    resetVmsRules(fullData.vmsRules);
+    runPhase("rules",
+        [&]
+        {
+            resetEventRules(fullData.rules);
+            resetVmsRules(fullData.vmsRules);
+            m_context->showreelManager()->resetShowreels(fullData.showreels);
+        });
 
-    m_context->showreelManager()->resetShowreels(fullData.showreels);
+    runPhase("access rights", [&] { m_context->resourceAccessManager()->endUpdate(); });
 
-    m_context->resourceAccessManager()->endUpdate();
+    NX_DEBUG(this, "Initial notification phases: %1", profile.join(", "));
 }
 
 void QnCommonMessageProcessor::updateResource(
@@ -165,6 +165,9 @@ private:
     void on_resourceParamChanged(
         const nx::vms::api::ResourceParamWithRefData& param,
         ec2::NotificationSource source);
+    void on_resourceParamsChanged(
+        const nx::vms::api::ResourceParamWithRefDataList& params,
+        ec2::NotificationSource source);
     void on_resourceParamRemoved(const nx::vms::api::ResourceParamWithRefData& param);
     void on_resourceRemoved(const nx::Uuid& resourceId, ec2::NotificationSource source);
     void on_resourceStatusRemoved(const nx::Uuid& resourceId, ec2::NotificationSource source);
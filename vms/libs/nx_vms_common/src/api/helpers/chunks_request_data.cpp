@@ -27,6 +27,7 @@ const QString kPeriodsTypeParam(lit("periodsType"));
 const QString kFilterParam(lit("filter"));
 const QString kLocalParam(lit("local"));
 const QString kFormatParam(lit("format"));
+const QString kBlockCompressedPeriodsParam("blockCompressedPeriods");
 const QString kDeprecatedPhysicalIdParam(lit("physicalId"));
 const QString kDeprecatedMacParam(lit("mac"));
 const QString kDeprecatedIdParam(lit("id"));
@@ -103,6 +104,7 @@ QnChunksRequestData QnChunksRequestData::fromParams(
     request.filter = params.value(kFilterParam);
     request.isLocal = params.contains(kLocalParam);
     nx::reflect::fromString(params.value(kFormatParam).toStdString(), &request.format);
+    request.blockCompressedPeriods = params.contains(kBlockCompressedPeriodsParam);
 
     nx::camera_id_helper::findAllCamerasByFlexibleIds(resourcePool, &request.resList, params,
         {kCameraIdParam, kDeprecatedIdParam, kDeprecatedPhysicalIdParam, kDeprecatedMacParam});
@@ -132,6 +134,8 @@ nx::network::rest::Params QnChunksRequestData::toParams() const
     if (isLocal)
         result.insert(kLocalParam, QString());
     result.insert(kFormatParam, format);
+    if (blockCompressedPeriods)
+        result.insert(kBlockCompressedPeriodsParam, QString());
     for (const auto& resource: resList)
         result.insert(kCameraIdParam, resource->getId().toSimpleString());
 
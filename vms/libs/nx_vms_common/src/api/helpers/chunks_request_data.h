@@ -46,6 +46,14 @@ struct NX_VMS_COMMON_API QnChunksRequestData
     QString filter;
     bool isLocal = false;
     Qn::SerializationFormat format = Qn::SerializationFormat::json;
+
+    /**
+     * Allows the compressedPeriods format to encode the periods in blocks
+     * (QnCompressedTime::BLOCK_FORMAT). The servers not supporting it ignore the parameter and
+     * reply in the format any reader supports.
+     */
+    bool blockCompressedPeriods = false;
+
     int limit = INT_MAX;
 
     GroupBy groupBy = GroupBy::serverId;
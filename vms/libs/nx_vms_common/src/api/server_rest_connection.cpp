@@ -2368,6 +2368,7 @@ Handle ServerConnection::recordedTimePeriods(
 {
     QnChunksRequestData fixedFormatRequest(requestData);
     fixedFormatRequest.format = Qn::SerializationFormat::compressedPeriods;
+    fixedFormatRequest.blockCompressedPeriods = true;
     auto internalCallback =
         [callback=std::move(callback)](
             bool success, Handle requestId, QByteArray result,
@@ -2996,8 +2997,8 @@ Handle ServerConnection::sendRequest(const ContextPtr& context)
 
     auto metrics = nx::vms::common::appContext()->metrics();
     metrics->totalServerRequests()++;
-    NX_VERBOSE(
-        d->logTag, "%1: %2", metrics->totalServerRequests.name(), metrics->totalServerRequests());
+    NX_VERBOSE(d->logTag, "%1: %2",
+        metrics->totalServerRequests.name(), metrics->totalServerRequests().load());
     Handle requestId = d->httpClientPool->sendRequest(context);
 
     // Request can be complete just inside `sendRequest`, so requestId is already invalid.
@@ -7,6 +7,10 @@
 
 #include "audit_manager_fwd.h"
 
+/**
+ * Implementations are expected to keep the records in nx::vms::common::AuditRecordQueue rather
+ * than write them on the caller's path: addAuditRecord() is called for every audited request.
+ */
 class NX_VMS_COMMON_API QnAuditManager: public nx::network::rest::audit::Manager
 {
 public:
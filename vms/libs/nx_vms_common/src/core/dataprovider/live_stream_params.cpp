@@ -1,10 +1,67 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
 #include "live_stream_params.h"
+
+#include <algorithm>
+#include <cmath>
+
 #include <nx/fusion/model_functions.h>
 
+namespace {
+
+/** Cameras round the fps to the supported values, so a smaller difference has no effect. */
+static constexpr float kFpsTolerance = 0.5F;
+
+/** Relative: the encoder rate control does not keep the bitrate more precisely anyway. */
+static constexpr float kBitrateTolerance = 0.05F;
+
+} // namespace
+
 const float QnLiveStreamParams::kFpsNotInitialized = -1.0;
 
+QString QnLiveStreamParamsDiff::toString() const
+{
+    QStringList fields;
+    if (quality)
+        fields << "quality";
+    if (fps)
+        fields << "fps";
+    if (bitrate)
+        fields << "bitrate";
+    if (resolution)
+        fields << "resolution";
+    if (codec)
+        fields << "codec";
+    return fields.isEmpty() ? QString("none") : fields.join(", ");
+}
+
+QnLiveStreamParamsDiff QnLiveStreamParams::diff(const QnLiveStreamParams& other) const
+{
+    const auto fpsDiffers =
+        [](float first, float second)
+        {
+            if ((first == kFpsNotInitialized) != (second == kFpsNotInitialized))
+                return true;
+            return std::abs(first - second) >= kFpsTolerance;
+        };
+
+    const auto bitrateDiffers =
+        [](float first, float second)
+        {
+            if ((first > 0) != (second > 0))
+                return true;
+            return std::abs(first - second) > kBitrateTolerance * std::max(first, second);
+        };
+
+    return QnLiveStreamParamsDiff{
+        .quality = quality != other.quality && bitrateKbps <= 0 && other.bitrateKbps <= 0,
+        .fps = fpsDiffers(fps, other.fps),
+        .bitrate = bitrateDiffers(bitrateKbps, other.bitrateKbps),
+        .resolution = resolution != other.resolution,
+        .codec = codec.compare(other.codec, Qt::CaseInsensitive) != 0,
+    };
+}
+
 QString QnLiveStreamParams::toString() const
 {
     return QJson::serialized(*this);
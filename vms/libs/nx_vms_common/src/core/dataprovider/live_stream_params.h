@@ -7,6 +7,26 @@
 #include <common/common_globals.h>
 #include <nx/fusion/model_functions_fwd.h>
 
+/** Fields of QnLiveStreamParams that differ in a way the camera encoder would notice. */
+struct NX_VMS_COMMON_API QnLiveStreamParamsDiff
+{
+    bool quality = false;
+    bool fps = false;
+    bool bitrate = false;
+    bool resolution = false;
+    bool codec = false;
+
+    bool isEmpty() const { return !(quality || fps || bitrate || resolution || codec); }
+
+    /**
+     * The resolution and the codec change the stream format, so the stream has to be reopened.
+     * The other fields can be changed in the running stream if the camera allows it.
+     */
+    bool requiresRestart() const { return resolution || codec; }
+
+    QString toString() const;
+};
+
 struct NX_VMS_COMMON_API QnLiveStreamParams
 {
     static const float kFpsNotInitialized;
@@ -19,6 +39,13 @@ struct NX_VMS_COMMON_API QnLiveStreamParams
 
     bool operator==(const QnLiveStreamParams& other) const = default;
 
+    /**
+     * Unlike operator==, ignores the differences the encoder does not tell: the fps and bitrate
+     * differences within the rounding, the codec name case, and the quality if the bitrate is set
+     * explicitly.
+     */
+    QnLiveStreamParamsDiff diff(const QnLiveStreamParams& other) const;
+
     QString toString() const;
 };
 #define QnLiveStreamParams_Fields (quality)(fps)(bitrateKbps)(resolution)(codec)
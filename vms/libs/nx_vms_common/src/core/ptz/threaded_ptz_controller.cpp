@@ -2,10 +2,13 @@
 
 #include "threaded_ptz_controller.h"
 
+#include <deque>
+
 #include <QtCore/QThreadPool>
 #include <QtCore/QVariant>
 
 #include <core/ptz/ptz_controller_pool.h>
+#include <nx/utils/log/log.h>
 #include <nx/utils/thread/mutex.h>
 
 using namespace nx::vms::common::ptz;
@@ -39,15 +42,130 @@ private:
     PtzCommandFunctor m_functor;
 };
 
+bool isCoalescable(Command command)
+{
+    return command == Command::continuousMove || command == Command::continuousFocus;
+}
+
 } // namespace
 
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Executes the commands one by one in a thread pool thread. The queue is shared with the running
+ * thread, so it outlives the controller until the queued commands are executed.
+ */
+class QnThreadedPtzController::CommandQueue:
+    public AsyncPtzCommandExecutorInterface,
+    public std::enable_shared_from_this<CommandQueue>
+{
+public:
+    CommandQueue(QThreadPool* threadPool): m_threadPool(threadPool) {}
+
+    void push(const QnPtzControllerPtr& controller, Command command, PtzCommandFunctor functor)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+
+        if (isCoalescable(command) && !m_queue.empty() && m_queue.back().command == command)
+        {
+            // Only the last queued command may be replaced, so the order of the commands is kept.
+            auto& entry = m_queue.back();
+            entry.controller = controller;
+            entry.functor = std::move(functor);
+            ++entry.requestCount;
+            ++m_statistics.coalescedCount;
+            return;
+        }
+
+        m_queue.push_back({controller, command, std::move(functor), Clock::now()});
+        if (m_isRunning)
+            return;
+
+        m_isRunning = true;
+        m_threadPool->start([self = shared_from_this()]() { self->processQueue(); });
+    }
+
+    CommandStatistics statistics() const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_statistics;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        QnPtzControllerPtr controller;
+        Command command;
+        PtzCommandFunctor functor;
+        Clock::time_point queuedAt;
+
+        /** The calls merged into this entry, each of them expects the finished signal. */
+        int requestCount = 1;
+    };
+
+    void processQueue()
+    {
+        for (;;)
+        {
+            Entry entry;
+            {
+                NX_MUTEX_LOCKER lock(&m_mutex);
+                if (m_queue.empty())
+                {
+                    m_isRunning = false;
+                    return;
+                }
+                entry = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            const QVariant result = entry.functor(entry.controller);
+            const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+                Clock::now() - entry.queuedAt);
+            NX_VERBOSE(entry.controller.get(), "Command %1 completed in %2, %3 call(s) merged",
+                entry.command, latency, entry.requestCount);
+
+            {
+                NX_MUTEX_LOCKER lock(&m_mutex);
+                m_totalLatency += latency;
+                ++m_statistics.executedCount;
+                m_statistics.lastLatency = latency;
+                m_statistics.averageLatency = m_totalLatency / m_statistics.executedCount;
+                m_statistics.maxLatency = std::max(m_statistics.maxLatency, latency);
+            }
+
+            for (int i = 0; i < entry.requestCount; ++i)
+                emit finished(entry.command, result);
+        }
+    }
+
+private:
+    QThreadPool* const m_threadPool;
+    mutable nx::Mutex m_mutex;
+    std::deque<Entry> m_queue;
+    bool m_isRunning = false;
+    CommandStatistics m_statistics;
+    std::chrono::milliseconds m_totalLatency{0};
+};
+
+//-------------------------------------------------------------------------------------------------
+
 QnThreadedPtzController::QnThreadedPtzController(
     const QnPtzControllerPtr& baseController,
     QThreadPool* threadPool)
     :
     base_type(baseController),
-    m_threadPool(threadPool)
+    m_threadPool(threadPool),
+    m_commandQueue(std::make_shared<CommandQueue>(threadPool))
 {
+    connect(
+        m_commandQueue.get(),
+        &AsyncPtzCommandExecutorInterface::finished,
+        this,
+        &QnAbstractPtzController::finished,
+        Qt::QueuedConnection);
 }
 
 QnThreadedPtzController::~QnThreadedPtzController()
@@ -75,6 +193,16 @@ void QnThreadedPtzController::callThreaded(
     m_threadPool->start(runnable);
 }
 
+void QnThreadedPtzController::enqueue(Command command, PtzCommandFunctor functor) const
+{
+    m_commandQueue->push(baseController(), command, std::move(functor));
+}
+
+QnThreadedPtzController::CommandStatistics QnThreadedPtzController::commandStatistics() const
+{
+    return m_commandQueue->statistics();
+}
+
 template<typename ResultValue, typename MethodPointer, typename... Args>
 bool QnThreadedPtzController::executeCommand(
     Command command,
@@ -87,7 +215,7 @@ bool QnThreadedPtzController::executeCommand(
     if (!nonConstThis->supports(command, internalOptions))
         return false;
 
-    callThreaded(command,
+    enqueue(command,
         [=](const QnPtzControllerPtr& controller) -> QVariant
         {
             if (std::invoke(method, *controller.get(), args...))
@@ -2,10 +2,12 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
+
 #include <core/ptz/proxy_ptz_controller.h>
 
 class QThreadPool;
-class QnThreadedPtzControllerPrivate;
 
 class AsyncPtzCommandExecutorInterface: public QObject
 {
@@ -15,11 +17,32 @@ signals:
     void finished(nx::vms::common::ptz::Command command, const QVariant& data);
 };
 
+/**
+ * Runs the PTZ commands of the base controller asynchronously in the thread pool.
+ *
+ * The commands which change the camera state are sent to the camera one at a time, in the order
+ * of the calls. While a command is in flight, a continuous move (or focus) queued after it is
+ * replaced by the newer one, so a slow camera gets the latest speed instead of falling behind a
+ * burst of outdated ones. The data requests are not queued.
+ */
 class QnThreadedPtzController: public QnProxyPtzController
 {
     using base_type = QnProxyPtzController;
 
 public:
+    struct CommandStatistics
+    {
+        int executedCount = 0;
+
+        /** Continuous moves and focuses replaced by the newer ones before being executed. */
+        int coalescedCount = 0;
+
+        /** From the call to the completion of the command by the base controller. */
+        std::chrono::milliseconds lastLatency{0};
+        std::chrono::milliseconds averageLatency{0};
+        std::chrono::milliseconds maxLatency{0};
+    };
+
     QnThreadedPtzController(
         const QnPtzControllerPtr& baseController,
         QThreadPool* threadPool);
@@ -98,6 +121,9 @@ public:
         DataFields query,
         const Options& options) const override;
 
+    /** Statistics of the commands of this controller (i.e. of its camera). */
+    CommandStatistics commandStatistics() const;
+
 private:
     template<typename ResultValue, typename MethodPointer, typename... Args>
     bool executeCommand(
@@ -116,7 +142,11 @@ private:
 
     using PtzCommandFunctor = std::function<QVariant(const QnPtzControllerPtr& controller)>;
     void callThreaded(Command command, const PtzCommandFunctor& functor) const;
+    void enqueue(Command command, PtzCommandFunctor functor) const;
 
 private:
+    class CommandQueue;
+
     QThreadPool* m_threadPool;
+    std::shared_ptr<CommandQueue> m_commandQueue;
 };
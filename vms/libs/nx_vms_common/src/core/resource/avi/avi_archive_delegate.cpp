@@ -460,7 +460,8 @@ bool QnAviArchiveDelegate::open(
         if (m_formatContext == nullptr)
             return false;
 
-        m_IOContext = nx::utils::media::createFfmpegIOContext(m_storage, url, QIODevice::ReadOnly);
+        m_IOContext = nx::utils::media::createFfmpegIOContext(
+            m_storage, url, QIODevice::ReadOnly, /*ioBlockSize*/ 32768, m_storageIoClass);
         if (!m_IOContext)
         {
             close();
@@ -780,6 +781,11 @@ void QnAviArchiveDelegate::setStorage(const QnStorageResourcePtr &storage)
     m_storage = storage;
 }
 
+void QnAviArchiveDelegate::setStorageIoClass(nx::recording::StorageIoClass ioClass)
+{
+    m_storageIoClass = ioClass;
+}
+
 void QnAviArchiveDelegate::setFastStreamFind(bool value)
 {
     m_fastStreamFind = value;
@@ -16,6 +16,7 @@ extern "C" {
 #include <nx/streaming/abstract_archive_delegate.h>
 #include <nx/utils/move_only_func.h>
 #include <nx/utils/thread/mutex.h>
+#include <recording/storage_io_scheduler.h>
 
 struct AVPacket;
 struct AVCodecContext;
@@ -79,6 +80,10 @@ public:
     bool isStreamsFound() const;
     void setUseAbsolutePos(bool value);
     void setStorage(const QnStorageResourcePtr &storage);
+
+    /** Class of the file reads in the I/O scheduler of the storage, playback by default. */
+    void setStorageIoClass(nx::recording::StorageIoClass ioClass);
+
     virtual QnAbstractMotionArchiveConnectionPtr getMotionConnection(int channel) override;
     virtual void setMotionRegion(const QnMotionRegion& region) override;
 
@@ -148,6 +153,7 @@ private:
     BeforeOpenInputCallback m_beforeOpenInputCallback = nullptr;
     bool m_readFailed = false;
     std::optional<int> m_forceVideoChannelsCount;
+    nx::recording::StorageIoClass m_storageIoClass = nx::recording::StorageIoClass::playback;
 };
 
 typedef QSharedPointer<QnAviArchiveDelegate> QnAviArchiveDelegatePtr;
@@ -9,6 +9,7 @@
 #include <core/resource/storage_resource.h>
 #include <core/storage/file_storage/layout_storage_resource.h>
 #include <nx/streaming/archive_stream_reader.h>
+#include <nx/streaming/read_ahead_archive_delegate.h>
 #include <nx/utils/fs/file.h>
 #include <nx/vms/time/timezone.h>
 
@@ -87,7 +88,13 @@ QnAbstractStreamDataProvider* QnAviResource::createDataProvider(Qn::ConnectionRo
         return new QnSingleShotFileStreamreader(toSharedPointer());
 
     QnArchiveStreamReader* result = new QnArchiveStreamReader(toSharedPointer());
-    result->setArchiveDelegate(createArchiveDelegate());
+    std::unique_ptr<QnAbstractArchiveDelegate> delegate(createArchiveDelegate());
+    if (const auto budget = nx::streaming::ReadAheadArchiveDelegate::budgetFromIni())
+    {
+        delegate = std::make_unique<nx::streaming::ReadAheadArchiveDelegate>(
+            std::move(delegate), *budget);
+    }
+    result->setArchiveDelegate(delegate.release());
     return result;
 }
 
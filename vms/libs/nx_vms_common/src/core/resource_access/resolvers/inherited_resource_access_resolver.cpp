@@ -264,22 +264,22 @@ void InheritedResourceAccessResolver::Private::handleBaseAccessChanged(
     const QSet<nx::Uuid>& subjectIds)
 {
     NX_DEBUG(q, "Base resolution changed for %1 subjects: %2", subjectIds.size(), subjectIds);
+
+    // Only the changed subjects and their direct and indirect members depend on the changed
+    // access. They are found by one walk down the hierarchy from the changed subjects, instead of
+    // walking up from each cached and watched subject, so the cost does not depend on the total
+    // number of the subjects.
+    const auto affectedSubjectIds = subjectIds + subjectHierarchy->recursiveMembers(subjectIds);
     QSet<nx::Uuid> affectedCachedSubjectIds;
 
     {
         NX_MUTEX_LOCKER lk(&mutex);
 
-        for (const auto& cachedSubjectId: nx::utils::keyRange(cachedAccessData))
+        for (const auto& subjectId: affectedSubjectIds)
         {
-            if (subjectIds.contains(cachedSubjectId)
-                || subjectHierarchy->isRecursiveMember(cachedSubjectId, subjectIds))
-            {
-                affectedCachedSubjectIds.insert(cachedSubjectId);
-            }
+            if (cachedAccessData.remove(subjectId))
+                affectedCachedSubjectIds.insert(subjectId);
         }
-
-        for (const auto& subjectId: affectedCachedSubjectIds)
-            cachedAccessData.remove(subjectId);
     }
 
     NX_DEBUG(q, "Cache invalidated for %1 subjects: %2",
@@ -290,12 +290,8 @@ void InheritedResourceAccessResolver::Private::handleBaseAccessChanged(
 
     for (const auto subjectId: watchedSubjectIds)
     {
-        if (subjectIds.contains(subjectId)
-            || affectedCachedSubjectIds.contains(subjectId)
-            || subjectHierarchy->isRecursiveMember(subjectId, subjectIds))
-        {
+        if (affectedSubjectIds.contains(subjectId))
             affectedWatchedSubjectIds.insert(subjectId);
-        }
     }
 
     if (!affectedCachedSubjectIds.empty())
@@ -20,6 +20,31 @@ QnResourcePool::Private::Private(
 
 void QnResourcePool::Private::handleResourceAdded(const QnResourcePtr& resource)
 {
+    const nx::Uuid id = resource->getId();
+
+    // The connections are made before the values are read, so the changes made concurrently are
+    // not lost.
+    QObject::connect(resource.data(), &QnResource::parentIdChanged, q,
+        [this](const QnResourcePtr& resource)
+        {
+            NX_WRITE_LOCKER lk(&q->m_resourcesMutex);
+            updateParentId(resource);
+        },
+        Qt::DirectConnection);
+    QObject::connect(resource.data(), &QnResource::statusChanged, q,
+        [this](const QnResourcePtr& resource)
+        {
+            NX_WRITE_LOCKER lk(&q->m_resourcesMutex);
+            updateStatus(resource);
+        },
+        Qt::DirectConnection);
+
+    IndexedValues& values = indexedValues[id];
+    values.parentId = resource->getParentId();
+    values.status = resource->getStatus();
+    resourcesByParentId[values.parentId].insert(id, resource);
+    resourcesByStatus[values.status].insert(id, resource);
+
     if (const auto server = resource.dynamicCast<QnMediaServerResource>())
     {
         mediaServers.insert(server);
@@ -66,6 +91,13 @@ void QnResourcePool::Private::handleResourceAdded(const QnResourcePtr& resource)
 
 void QnResourcePool::Private::handleResourceRemoved(const QnResourcePtr& resource)
 {
+    if (const auto it = indexedValues.find(resource->getId()); it != indexedValues.end())
+    {
+        eraseFromIndex(&resourcesByParentId, it->second.parentId, resource->getId());
+        eraseFromIndex(&resourcesByStatus, it->second.status, resource->getId());
+        indexedValues.erase(it);
+    }
+
     if (const auto server = resource.dynamicCast<QnMediaServerResource>())
     {
         mediaServers.remove(server);
@@ -97,6 +129,36 @@ void QnResourcePool::Private::updateIsIOModule(const QnVirtualCameraResourcePtr&
     hasIoModules = !ioModules.isEmpty();
 }
 
+void QnResourcePool::Private::updateParentId(const QnResourcePtr& resource)
+{
+    const auto it = indexedValues.find(resource->getId());
+    if (it == indexedValues.end()) //< The resource is removed already.
+        return;
+
+    const auto parentId = resource->getParentId();
+    if (parentId == it->second.parentId)
+        return;
+
+    eraseFromIndex(&resourcesByParentId, it->second.parentId, resource->getId());
+    resourcesByParentId[parentId].insert(resource->getId(), resource);
+    it->second.parentId = parentId;
+}
+
+void QnResourcePool::Private::updateStatus(const QnResourcePtr& resource)
+{
+    const auto it = indexedValues.find(resource->getId());
+    if (it == indexedValues.end()) //< The resource is removed already.
+        return;
+
+    const auto status = resource->getStatus();
+    if (status == it->second.status)
+        return;
+
+    eraseFromIndex(&resourcesByStatus, it->second.status, resource->getId());
+    resourcesByStatus[status].insert(resource->getId(), resource);
+    it->second.status = status;
+}
+
 void QnResourcePool::Private::removeUser(const QString& name, const QnUserResourcePtr& user)
 {
     const auto it = usersByName.find(name);
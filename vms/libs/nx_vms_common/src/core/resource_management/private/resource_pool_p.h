@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <map>
 #include <unordered_map>
 
 #include <QtCore/QMap>
@@ -18,6 +19,20 @@ struct QnResourcePool::Private
     void handleResourceRemoved(const QnResourcePtr& resource);
 
     void updateIsIOModule(const QnVirtualCameraResourcePtr& camera);
+    void updateParentId(const QnResourcePtr& resource);
+    void updateStatus(const QnResourcePtr& resource);
+
+    template<typename Index, typename Key>
+    static void eraseFromIndex(Index* index, const Key& key, const nx::Uuid& id)
+    {
+        const auto it = index->find(key);
+        if (it == index->end())
+            return;
+
+        it->second.remove(id);
+        if (it->second.empty())
+            index->erase(it);
+    }
     void removeUser(const QString& name, const QnUserResourcePtr& user);
 
     struct SameNameUsers
@@ -40,6 +55,13 @@ struct QnResourcePool::Private
         bool m_hasClash = false;
     };
 
+    /** The values the resource is indexed by, to find it in the index when they change. */
+    struct IndexedValues
+    {
+        nx::Uuid parentId;
+        nx::vms::api::ResourceStatus status = nx::vms::api::ResourceStatus::undefined;
+    };
+
 public:
     const QnResourcePool* const q;
     nx::vms::common::SystemContext* const systemContext;
@@ -49,4 +71,7 @@ public:
     QSet<QnStorageResourcePtr> storages;
     QMap<QString, QnVirtualCameraResourcePtr> camerasByPhysicalId;
     std::unordered_map<QString, SameNameUsers> usersByName;
+    std::unordered_map<nx::Uuid, ResourcesById> resourcesByParentId;
+    std::map<nx::vms::api::ResourceStatus, ResourcesById> resourcesByStatus;
+    std::unordered_map<nx::Uuid, IndexedValues> indexedValues;
 };
@@ -6,6 +6,7 @@
 #include <list>
 #include <set>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QThreadPool>
 
@@ -55,11 +56,14 @@ QnResourceDiscoveryManager::QnResourceDiscoveryManager(
     m_discoveryUpdateIdx(0)
 {
     m_threadPool.setMaxThreadCount(resourceManagementIni().maxResourceDiscoveryThreadCount);
+    m_searchThreadPool.setMaxThreadCount(
+        std::max(1, resourceManagementIni().maxConcurrentResourceSearchers));
 }
 
 QnResourceDiscoveryManager::~QnResourceDiscoveryManager()
 {
     stop();
+    m_searchThreadPool.waitForDone();
     m_threadPool.waitForDone();
 }
 
@@ -325,55 +329,55 @@ QnResourceList QnResourceDiscoveryManager::findNewResources()
     ResourceSearcherList searchersList = m_searchersList;
     m_searchersListMutex.unlock();
     auto searchType = SearchType::Full;
-    for (QnAbstractResourceSearcher *searcher: searchersList)
+    ResourceSearcherList activeSearchers;
+    for (QnAbstractResourceSearcher* searcher: searchersList)
     {
         if ((searcher->discoveryMode() != DiscoveryMode::disabled) && !needToStop())
+            activeSearchers.push_back(searcher);
+        else
+            searchType = SearchType::Partial;
+    }
+
+    // The results are processed in the order of the searchers, so the same driver wins when a
+    // device is found by several ones, regardless of which search has completed first.
+    std::vector<QnResourceList> searchResults = searchResources(activeSearchers);
+    for (int i = 0; i < activeSearchers.size(); ++i)
+    {
+        QnAbstractResourceSearcher* searcher = activeSearchers[i];
+        // Used in case of device replacement.
+        QnResourceList lst = remapPhysicalIdIfNeed(searchResults[i]);
+
+        // resources can be searched by client in or server.
+        // if this client in stand alone => lets add Qn::local
+        // server does not care about flags
+        for(QnResourceList::iterator it = lst.begin(); it != lst.end();)
         {
-            QElapsedTimer timer;
-            timer.restart();
-            QnResourceList lst = searcher->search();
-            lst = remapPhysicalIdIfNeed(lst); //< Used in case of device replacement.
-            NX_DEBUG(this, lit("Searcher %1 took %2 ms to find %3 resources").
-                arg(searcher->manufacturer())
-                .arg(timer.elapsed())
-                .arg(lst.size()));
-
-            // resources can be searched by client in or server.
-            // if this client in stand alone => lets add Qn::local
-            // server does not care about flags
-            for(QnResourceList::iterator it = lst.begin(); it != lst.end();)
+            const QnVirtualCameraResource* camRes = dynamic_cast<QnVirtualCameraResource*>(it->data());
+            if (camRes && !isCameraAllowed(searcher->manufacturer(), camRes))
             {
-                const QnVirtualCameraResource* camRes = dynamic_cast<QnVirtualCameraResource*>(it->data());
-                if (camRes && !isCameraAllowed(searcher->manufacturer(), camRes))
-                {
-                    it = lst.erase( it );
-                    continue;
-                }
+                it = lst.erase( it );
+                continue;
+            }
 
-                const QnVirtualCameraResource* networkRes = dynamic_cast<QnVirtualCameraResource*>(it->data());
-                if( networkRes )
+            const QnVirtualCameraResource* networkRes = dynamic_cast<QnVirtualCameraResource*>(it->data());
+            if( networkRes )
+            {
+                //checking that resource do not duplicate already found ones
+                if( !resourcePhysicalIDs.insert( networkRes->getPhysicalId() ).second )
                 {
-                    //checking that resource do not duplicate already found ones
-                    if( !resourcePhysicalIDs.insert( networkRes->getPhysicalId() ).second )
-                    {
-                        it = lst.erase( it );
-                        continue;   //resource with such unique id is already present
-                    }
+                    it = lst.erase( it );
+                    continue;   //resource with such unique id is already present
                 }
-
-                if( searcher->isLocal() )
-                    (*it)->addFlags(Qn::local);
-
-                ++it;
             }
 
-            for( QnResourcePtr& res: lst )
-                resourcesAndSearches.push_back( std::make_pair( std::move(res), searcher ) );
-        }
-        else
-        {
-            searchType = SearchType::Partial;
+            if( searcher->isLocal() )
+                (*it)->addFlags(Qn::local);
+
+            ++it;
         }
+
+        for( QnResourcePtr& res: lst )
+            resourcesAndSearches.push_back( std::make_pair( std::move(res), searcher ) );
     }
     const auto& resPool = resourcePool();
     //filtering discovered resources by discovery mode
@@ -474,6 +478,45 @@ QnResourceList QnResourceDiscoveryManager::findNewResources()
     }
 }
 
+std::vector<QnResourceList> QnResourceDiscoveryManager::searchResources(
+    const ResourceSearcherList& searchers)
+{
+    std::vector<QnResourceList> results(searchers.size());
+
+    const auto search =
+        [this, &searchers, &results](int index)
+        {
+            QnAbstractResourceSearcher* searcher = searchers[index];
+            if (needToStop())
+                return;
+
+            QElapsedTimer timer;
+            timer.restart();
+            results[index] = searcher->search();
+            NX_DEBUG(this, "Searcher %1 took %2 ms to find %3 resources",
+                searcher->manufacturer(), timer.elapsed(), results[index].size());
+        };
+
+    // The sequential searchers are not run along with any other ones.
+    for (int i = 0; i < searchers.size(); ++i)
+    {
+        if (searchers[i]->isSequential())
+            search(i);
+    }
+
+    std::vector<QFuture<void>> futures;
+    for (int i = 0; i < searchers.size(); ++i)
+    {
+        if (!searchers[i]->isSequential())
+            futures.push_back(QtConcurrent::run(&m_searchThreadPool, search, i));
+    }
+
+    for (auto& future: futures)
+        future.waitForFinished();
+
+    return results;
+}
+
 QThreadPool* QnResourceDiscoveryManager::threadPool()
 {
     return &m_threadPool;
@@ -133,6 +133,12 @@ protected:
 
     // Returns new resources or updates some in resource pool.
     QnResourceList findNewResources();
+
+    /**
+     * Runs the sequential searchers one by one, then the other ones concurrently.
+     * @return Results in the order of the searchers.
+     */
+    std::vector<QnResourceList> searchResources(const ResourceSearcherList& searchers);
     // Run search of local files.
     void doInitialSearch();
 
@@ -154,6 +160,9 @@ protected:
 protected:
     QThreadPool m_threadPool;
 
+    /** Separate from m_threadPool, which the searchers may use themselves. */
+    QThreadPool m_searchThreadPool;
+
     mutable nx::Mutex m_searchersListMutex;
     ResourceSearcherList m_searchersList;
     QnResourceProcessor* m_resourceProcessor;
@@ -15,6 +15,9 @@ struct ResourceManagementIni: public nx::kit::IniConfig
     NX_INI_INT(32, maxResourceDiscoveryThreadCount,
         "The maximum number of threads for the thread pool of the Resource Discovery Manager.\n"
         "Up to 5.0, for ARM32 devices it used to be 8.");
+    NX_INI_INT(8, maxConcurrentResourceSearchers,
+        "The maximum number of non-sequential resource searchers running at the same time during\n"
+        "a discovery iteration. 1 runs all the searchers one by one.");
     NX_INI_INT(15'000, upnpDiscoveryIntervalMs,
         "Wait at least this many milliseconds between the UPnP discovery attempts.");
 };
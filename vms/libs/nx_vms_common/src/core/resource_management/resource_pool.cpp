@@ -122,11 +122,15 @@ void QnResourcePool::addResources(const QnResourceList& resources, AddResourceFl
         }
         else
         {
+            m_resourcesByType[typeid(*resource)].insert(resource->getId(), resource);
             d->handleResourceAdded(resource);
             newResources.insert(resource->getId(), resource);
         }
     }
 
+    if (!newResources.empty())
+        invalidateSnapshotUnsafe();
+
     resourcesLock.unlock();
 
     // Resource updates may emit signal, which should not be done under mutex.
@@ -207,11 +211,15 @@ void QnResourcePool::removeResources(const QnResourceList& resources)
         if (resIter != m_resources.cend())
         {
             d->handleResourceRemoved(resource);
+            removeFromTypeIndex(resource);
             m_resources.erase(resIter);
             appendRemovedResource(resource);
         }
     }
 
+    if (!removedLayouts.empty() || !removedUsers.empty() || !removedOtherResources.empty())
+        invalidateSnapshotUnsafe();
+
     const bool onlyUsers = removedUsers.size() == removedResources.size();
 
     // After resources removing, we must check if removed layouts left on the videowall items
@@ -286,6 +294,28 @@ void QnResourcePool::removeResources(const QnResourceList& resources)
         emit resourcesRemoved(removedResources);
 }
 
+QnResourcePool::SnapshotPtr QnResourcePool::snapshot() const
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_snapshotMutex);
+        if (m_snapshot)
+            return m_snapshot;
+    }
+
+    // The resource hashes are implicitly shared, so only the index by type (one node per resource
+    // class) is copied here.
+    NX_READ_LOCKER locker(&m_resourcesMutex);
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->version = m_version;
+    snapshot->resources = m_resources;
+    snapshot->resourcesByType = m_resourcesByType;
+
+    NX_MUTEX_LOCKER lock(&m_snapshotMutex);
+    if (!m_snapshot) //< Otherwise the same snapshot is made by a concurrent reader.
+        m_snapshot = std::move(snapshot);
+    return m_snapshot;
+}
+
 QnResourceList QnResourcePool::getResources() const
 {
     NX_READ_LOCKER locker(&m_resourcesMutex);
@@ -350,14 +380,29 @@ QnVirtualCameraResourceList QnResourcePool::getAllCameras(
 {
     QnVirtualCameraResourceList result;
     NX_READ_LOCKER locker(&m_resourcesMutex);
-    for (const QnResourcePtr& resource: m_resources)
+    if (parentId.isNull())
+    {
+        forEachResourceUnsafe<QnVirtualCameraResource>(
+            [&](const QnVirtualCameraResourcePtr& camera)
+            {
+                if (!ignoreDesktopCameras || !camera->hasFlags(Qn::desktop_camera))
+                    result.append(camera);
+                return true;
+            });
+        return result;
+    }
+
+    const auto it = d->resourcesByParentId.find(parentId);
+    if (it == d->resourcesByParentId.end())
+        return result;
+
+    for (const QnResourcePtr& resource: it->second)
     {
         if (ignoreDesktopCameras && resource->hasFlags(Qn::desktop_camera))
             continue;
 
-        QnVirtualCameraResourcePtr camResource = resource.dynamicCast<QnVirtualCameraResource>();
-        if (camResource && (parentId.isNull() || camResource->getParentId() == parentId))
-            result.append(camResource);
+        if (auto camera = resource.dynamicCast<QnVirtualCameraResource>())
+            result.append(camera);
     }
 
     return result;
@@ -416,11 +461,16 @@ QnMediaServerResourceList QnResourcePool::getAllServers(nx::vms::api::ResourceSt
 
 QnResourceList QnResourcePool::getResourcesByParentId(const nx::Uuid& parentId) const
 {
-    return getResources(
-        [&parentId](const QnResourcePtr& resource)
-        {
-            return resource->getParentId() == parentId;
-        });
+    NX_READ_LOCKER locker(&m_resourcesMutex);
+    const auto it = d->resourcesByParentId.find(parentId);
+    return it != d->resourcesByParentId.end() ? it->second.values() : QnResourceList();
+}
+
+QnResourceList QnResourcePool::getResourcesByStatus(nx::vms::api::ResourceStatus status) const
+{
+    NX_READ_LOCKER locker(&m_resourcesMutex);
+    const auto it = d->resourcesByStatus.find(status);
+    return it != d->resourcesByStatus.end() ? it->second.values() : QnResourceList();
 }
 
 QnVirtualCameraResourceList QnResourcePool::getAllNetResourceByHostAddress(
@@ -492,7 +542,9 @@ void QnResourcePool::clear(bool notify)
 
         m_tmpResources.clear();
         m_resources.clear();
+        m_resourcesByType.clear();
         m_adminResource.clear();
+        invalidateSnapshotUnsafe();
 
         d->ioModules.clear();
         d->hasIoModules = false;
@@ -500,6 +552,9 @@ void QnResourcePool::clear(bool notify)
         d->storages.clear();
         d->camerasByPhysicalId.clear();
         d->usersByName.clear();
+        d->resourcesByParentId.clear();
+        d->resourcesByStatus.clear();
+        d->indexedValues.clear();
     }
 
     NX_VERBOSE(this, "Cleared resources: %1", nx::containerString(tempList));
@@ -514,6 +569,24 @@ void QnResourcePool::clear(bool notify)
         emit resourcesRemoved(tempList);
 }
 
+void QnResourcePool::invalidateSnapshotUnsafe()
+{
+    ++m_version;
+    NX_MUTEX_LOCKER lock(&m_snapshotMutex);
+    m_snapshot.reset();
+}
+
+void QnResourcePool::removeFromTypeIndex(const QnResourcePtr& resource)
+{
+    const auto it = m_resourcesByType.find(typeid(*resource));
+    if (!NX_ASSERT(it != m_resourcesByType.end()))
+        return;
+
+    it->second.remove(resource->getId());
+    if (it->second.empty())
+        m_resourcesByType.erase(it);
+}
+
 bool QnResourcePool::containsIoModules() const
 {
     return d->hasIoModules;
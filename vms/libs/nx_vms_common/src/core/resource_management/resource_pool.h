@@ -3,6 +3,9 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 #include <QtCore/QHash>
@@ -101,6 +104,72 @@ public:
     template<class Resource>
     using ResourceClassFilter = nx::vms::common::ResourceClassFilter<Resource>;
 
+    using ResourcesById = QHash<nx::Uuid, QnResourcePtr>;
+    using ResourcesByType = std::unordered_map<std::type_index, ResourcesById>;
+
+    /**
+     * Calls the handler for each resource of the given class until it returns false. Only the
+     * resources of the matching concrete types are visited, so there is no cast per resource.
+     */
+    template<class Resource, class Handler>
+    static void forEachResource(const ResourcesByType& resourcesByType, Handler handler)
+    {
+        for (const auto& [type, resources]: resourcesByType)
+        {
+            // All the resources of the same concrete type are cast the same way.
+            if (resources.empty() || !resources.begin().value().template dynamicCast<Resource>())
+                continue;
+
+            for (const QnResourcePtr& resource: resources)
+            {
+                if (!handler(resource.template staticCast<Resource>()))
+                    return;
+            }
+        }
+    }
+
+    /**
+     * Immutable state of the pool resources. It can be iterated without locks for as long as it
+     * is needed, while the pool is changed. The resource hashes are implicitly shared with the
+     * pool and are not copied until the pool is changed, but the index by type is copied when the
+     * snapshot is made (one node per resource class).
+     */
+    struct Snapshot
+    {
+        /** Grows on each change of the pool resources. */
+        qint64 version = 0;
+
+        ResourcesById resources;
+        ResourcesByType resourcesByType;
+
+        template<class Resource, class Handler>
+        void forEach(Handler handler) const
+        {
+            forEachResource<Resource>(resourcesByType, std::move(handler));
+        }
+
+        template<class Resource>
+        QnSharedResourcePointerList<Resource> getResources() const
+        {
+            QnSharedResourcePointerList<Resource> result;
+            forEach<Resource>(
+                [&result](const QnSharedResourcePointer<Resource>& resource)
+                {
+                    result.push_back(resource);
+                    return true;
+                });
+            return result;
+        }
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    /**
+     * The snapshot of the current resources. It is made once after each change of the pool
+     * (a whole batch of the added or removed resources is one change), and is shared by all the
+     * readers until the next change.
+     */
+    SnapshotPtr snapshot() const;
+
     //---------------------------------------------------------------------------------------------
     // Methods to get all resources.
 
@@ -203,14 +272,13 @@ public:
     {
         NX_READ_LOCKER locker(&m_resourcesMutex);
         QnSharedResourcePointerList<Resource> result;
-        for (const QnResourcePtr& resource: m_resources)
-        {
-            if (auto derived = resource.template dynamicCast<Resource>())
+        forEachResourceUnsafe<Resource>(
+            [&](const QnSharedResourcePointer<Resource>& resource)
             {
-                if (filter(derived))
-                    result.push_back(derived);
-            }
-        }
+                if (filter(resource))
+                    result.push_back(resource);
+                return true;
+            });
         return result;
     }
 
@@ -218,16 +286,14 @@ public:
     bool contains(ResourceClassFilter<Resource> filter) const
     {
         NX_READ_LOCKER locker(&m_resourcesMutex);
-        QnSharedResourcePointerList<Resource> result;
-        for (const QnResourcePtr& resource: m_resources)
-        {
-            if (auto derived = resource.template dynamicCast<Resource>())
+        bool result = false;
+        forEachResourceUnsafe<Resource>(
+            [&](const QnSharedResourcePointer<Resource>& resource)
             {
-                if (filter(derived))
-                    return true;
-            }
-        }
-        return false;
+                result = filter(resource);
+                return !result;
+            });
+        return result;
     }
 
     QnVirtualCameraResourceList getAllNetResourceByHostAddress(const nx::String& hostAddress) const;
@@ -260,6 +326,9 @@ public:
 
     QnResourceList getResourcesByParentId(const nx::Uuid& parentId) const;
 
+    /** All resources which have the given status, as reported by QnResource::getStatus(). */
+    QnResourceList getResourcesByStatus(nx::vms::api::ResourceStatus status) const;
+
     // Returns list of resources with such flag.
     QnResourceList getResourcesWithFlag(Qn::ResourceFlag flag) const;
 
@@ -277,13 +346,15 @@ public:
     QnSharedResourcePointer<Resource> getResource(ResourceClassFilter<Resource> filter) const
     {
         NX_READ_LOCKER locker(&m_resourcesMutex);
-        for (const QnResourcePtr& resource: m_resources)
-        {
-            if (auto derived = resource.template dynamicCast<Resource>())
-                if (filter(derived))
-                    return derived;
-        }
-        return QnSharedResourcePointer<Resource>();
+        QnSharedResourcePointer<Resource> result;
+        forEachResourceUnsafe<Resource>(
+            [&](const QnSharedResourcePointer<Resource>& resource)
+            {
+                if (filter(resource))
+                    result = resource;
+                return !result;
+            });
+        return result;
     }
 
     template<class Resource>
@@ -397,15 +468,27 @@ signals:
     void statusChanged(const QnResourcePtr& resource, Qn::StatusChangeReason reason);
 
 private:
+    template<class Resource, class Handler>
+    void forEachResourceUnsafe(Handler handler) const
+    {
+        forEachResource<Resource>(m_resourcesByType, std::move(handler));
+    }
+
+    void removeFromTypeIndex(const QnResourcePtr& resource);
+
+    /** Must be called under the write lock after each change of the resources. */
+    void invalidateSnapshotUnsafe();
+
     template<class Resource>
     QnSharedResourcePointerList<Resource> getResourcesUnsafe() const
     {
         QnSharedResourcePointerList<Resource> result;
-        for (const QnResourcePtr& resource: m_resources)
-        {
-            if (auto derived = resource.template dynamicCast<Resource>())
-                result.push_back(derived);
-        }
+        forEachResourceUnsafe<Resource>(
+            [&result](const QnSharedResourcePointer<Resource>& resource)
+            {
+                result.push_back(resource);
+                return true;
+            });
         return result;
     }
 
@@ -418,6 +501,13 @@ private:
 
     QnResourceList m_tmpResources;
     QHash<nx::Uuid, QnResourcePtr> m_resources;
+
+    /** The same resources, grouped by their concrete class. */
+    ResourcesByType m_resourcesByType;
+
+    qint64 m_version = 0;
+    mutable nx::Mutex m_snapshotMutex;
+    mutable SnapshotPtr m_snapshot;
     mutable QnUserResourcePtr m_adminResource;
     std::unique_ptr<QThreadPool> m_threadPool;
 };
@@ -73,7 +73,7 @@ void QnFfmpegVideoDecoder::determineOptimalThreadType(const QnConstCompressedVid
 {
     // Don't use multithread decoding for images, since then ffmpeg increases AVCodecContext->delay
     // to more than 0 and does not output frames on single call decode(without flushing).
-    if (m_useMtDecoding && !isImage(data))
+    if (m_useMtDecoding && !isImage(data) && !m_config.keyFramesOnly)
         m_context->thread_count = qMin(MAX_DECODE_THREAD, QThread::idealThreadCount() + 1);
     else
         m_context->thread_count = 1; //< Turn off multi thread decoding.
@@ -152,6 +152,8 @@ bool QnFfmpegVideoDecoder::openDecoder(const QnConstCompressedVideoDataPtr& data
         CodecParametersConstPtr(new CodecParameters(m_context)));
 
     determineOptimalThreadType(data);
+    if (m_config.keyFramesOnly)
+        setupKeyFramesOnlyMode(codec);
 
     int status = avcodec_open2(m_context, codec, NULL);
     if (status < 0)
@@ -164,6 +166,26 @@ bool QnFfmpegVideoDecoder::openDecoder(const QnConstCompressedVideoDataPtr& data
     return true;
 }
 
+void QnFfmpegVideoDecoder::setupKeyFramesOnlyMode(const AVCodec* codec)
+{
+    m_context->skip_frame = AVDISCARD_NONKEY;
+    m_context->skip_loop_filter = AVDISCARD_ALL;
+    m_context->flags2 |= AV_CODEC_FLAG2_FAST;
+
+    // The resolution is unknown before the first frame, if the codec parameters are absent.
+    const int maxSide = qMax(m_context->width, m_context->height);
+    if (m_config.minOutputSize <= 0 || maxSide <= 0)
+        return;
+
+    int lowres = 0;
+    while (lowres < codec->max_lowres && (maxSide >> (lowres + 1)) >= m_config.minOutputSize)
+        ++lowres;
+    m_context->lowres = lowres;
+
+    NX_DEBUG(this, "Decode key frames only, codec id: %1, lowres: %2",
+        m_context->codec_id, m_context->lowres);
+}
+
 bool QnFfmpegVideoDecoder::resetDecoder(const QnConstCompressedVideoDataPtr& data)
 {
     if (!data || !(data->flags & AV_PKT_FLAG_KEY))
@@ -271,6 +293,10 @@ bool QnFfmpegVideoDecoder::decode(
             return false;
         }
 
+        // Do not even parse the frames, which are discarded by the decoder.
+        if (m_config.keyFramesOnly && !(data->flags & AV_PKT_FLAG_KEY) && data->data())
+            return false;
+
         if (m_newDecodeMode != DecodeMode_NotDefined && (data->flags & AV_PKT_FLAG_KEY))
         {
             m_decodeMode = m_newDecodeMode;
@@ -62,6 +62,7 @@ private:
         int *got_picture_ptr,
         const AVPacket *avpkt);
     void setMultiThreadDecoding(bool value);
+    void setupKeyFramesOnlyMode(const AVCodec* codec);
 
 private:
     AVCodecContext *m_context;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <nx/media/meta_data_packet.h>
 
@@ -16,6 +17,26 @@ public:
      * If next call got same metadata or no metadata is found return null.
      */
     virtual QnAbstractCompressedMetadataPtr getMotionData(qint64 timeUsec) = 0;
+
+    /**
+     * Appends up to maxCount packets for the specified time to the packets, as if getMotionData()
+     * was called until it returns null. The connections which keep their data in memory may
+     * override it to avoid the call per packet.
+     * @return Number of the appended packets.
+     */
+    virtual int getMotionDataBatch(
+        qint64 timeUsec, int maxCount, std::vector<QnAbstractCompressedMetadataPtr>* packets)
+    {
+        int count = 0;
+        for (; count < maxCount; ++count)
+        {
+            auto packet = getMotionData(timeUsec);
+            if (!packet)
+                break;
+            packets->push_back(std::move(packet));
+        }
+        return count;
+    }
 };
 using QnAbstractMotionArchiveConnectionPtr = std::shared_ptr<QnAbstractMotionArchiveConnection>;
 
@@ -2,37 +2,61 @@
 
 #include "metadata_multiplexer.h"
 
-QnAbstractCompressedMetadataPtr MetadataMultiplexer::getMotionData(qint64 timeUsec)
+#include <algorithm>
+
+namespace {
+
+/** std::push_heap() makes a max-heap, so the order is inverted. */
+struct HeadComparator
 {
-    ReaderContext* selectedReaderContext = nullptr;
-    for (auto& readerIdAndContext: m_readers)
+    template<typename Head>
+    bool operator()(const Head& left, const Head& right) const
     {
-        auto& readerContext = readerIdAndContext.second;
+        return left.timestamp != right.timestamp
+            ? left.timestamp > right.timestamp
+            : left.id > right.id;
+    }
+};
 
-        if (!readerContext.packet)
-            readerContext.packet = readerContext.reader->getMotionData(timeUsec);
+} // namespace
 
-        if (!readerContext.packet)
-            continue;
+MetadataMultiplexer::MetadataMultiplexer(int batchSize):
+    m_batchSize(std::max(batchSize, 1))
+{
+}
 
-        if (!selectedReaderContext ||
-            readerContext.packet->timestamp < selectedReaderContext->packet->timestamp)
-        {
-            selectedReaderContext = &readerContext;
-        }
-    }
+QnAbstractCompressedMetadataPtr MetadataMultiplexer::getMotionData(qint64 timeUsec)
+{
+    readAllPackets(timeUsec);
+    return popPacket(/*refillTimeUsec*/ std::nullopt);
+}
 
-    QnAbstractCompressedMetadataPtr result;
-    if (selectedReaderContext)
-        std::swap(result, selectedReaderContext->packet);
+int MetadataMultiplexer::getMotionDataBatch(
+    qint64 timeUsec,
+    int maxCount,
+    std::vector<QnAbstractCompressedMetadataPtr>* packets)
+{
+    readAllPackets(timeUsec);
 
-    return result;
+    int count = 0;
+    for (; count < maxCount; ++count)
+    {
+        // The reader is asked again as soon as its packets are over, as it may have the packets
+        // earlier than the ones of the other readers.
+        auto packet = popPacket(timeUsec);
+        if (!packet)
+            break;
+        packets->push_back(std::move(packet));
+    }
+    return count;
 }
 
 void MetadataMultiplexer::add(
     int id,
     QnAbstractMotionArchiveConnectionPtr metadataReader)
 {
+    removeHead(id);
+
     ReaderContext context;
     context.reader = std::move(metadataReader);
     m_readers[id] = std::move(context);
@@ -53,5 +77,62 @@ QnAbstractMotionArchiveConnectionPtr MetadataMultiplexer::readerById(int id)
 
 void MetadataMultiplexer::removeById(int id)
 {
+    removeHead(id);
     m_readers.erase(id);
 }
+
+void MetadataMultiplexer::readPackets(int id, ReaderContext* context, qint64 timeUsec)
+{
+    context->packets.clear();
+    context->position = 0;
+    if (context->reader->getMotionDataBatch(timeUsec, m_batchSize, &context->packets) == 0)
+        return;
+
+    m_heads.push_back({context->packets.front()->timestamp, id});
+    std::push_heap(m_heads.begin(), m_heads.end(), HeadComparator());
+}
+
+void MetadataMultiplexer::readAllPackets(qint64 timeUsec)
+{
+    for (auto& [id, context]: m_readers)
+    {
+        if (context.position >= context.packets.size())
+            readPackets(id, &context, timeUsec);
+    }
+}
+
+QnAbstractCompressedMetadataPtr MetadataMultiplexer::popPacket(
+    std::optional<qint64> refillTimeUsec)
+{
+    if (m_heads.empty())
+        return nullptr;
+
+    std::pop_heap(m_heads.begin(), m_heads.end(), HeadComparator());
+    const int id = m_heads.back().id;
+    m_heads.pop_back();
+
+    auto& context = m_readers[id];
+    auto result = std::move(context.packets[context.position++]);
+    if (context.position < context.packets.size())
+    {
+        m_heads.push_back({context.packets[context.position]->timestamp, id});
+        std::push_heap(m_heads.begin(), m_heads.end(), HeadComparator());
+    }
+    else if (refillTimeUsec)
+    {
+        readPackets(id, &context, *refillTimeUsec);
+    }
+
+    return result;
+}
+
+void MetadataMultiplexer::removeHead(int id)
+{
+    const auto it = std::find_if(m_heads.begin(), m_heads.end(),
+        [id](const Head& head) { return head.id == id; });
+    if (it == m_heads.end())
+        return;
+
+    m_heads.erase(it);
+    std::make_heap(m_heads.begin(), m_heads.end(), HeadComparator());
+}
@@ -3,21 +3,37 @@
 #pragma once
 
 #include <map>
+#include <optional>
+#include <vector>
 
 #include "abstract_motion_archive.h"
 
 /**
+ * Merges the packets of several readers in the order of their timestamps. The packets are read
+ * from each reader by batches, and the next packet is selected by a heap of the first buffered
+ * packets of the readers, so the readers are not asked for each packet.
+ *
  * NOTE: All methods are not thread-safe.
  */
 class NX_VMS_COMMON_API MetadataMultiplexer: public QnAbstractMotionArchiveConnection
 {
 public:
+    static constexpr int kDefaultBatchSize = 16;
+
+    explicit MetadataMultiplexer(int batchSize = kDefaultBatchSize);
+
     /**
      * @return Packet with minimal timestamp from any reader.
      * If no reader produces a packet, then null is returned.
      */
     virtual QnAbstractCompressedMetadataPtr getMotionData(qint64 timeUsec) override;
 
+    /** Appends the packets of all the readers sorted by timestamp. */
+    virtual int getMotionDataBatch(
+        qint64 timeUsec,
+        int maxCount,
+        std::vector<QnAbstractCompressedMetadataPtr>* packets) override;
+
     /**
      * NOTE: If id already taken, object is replaced.
      */
@@ -33,8 +49,28 @@ private:
     struct ReaderContext
     {
         QnAbstractMotionArchiveConnectionPtr reader;
-        QnAbstractCompressedMetadataPtr packet;
+
+        /** The packets read from the reader, which are not returned yet, start at position. */
+        std::vector<QnAbstractCompressedMetadataPtr> packets;
+        size_t position = 0;
+    };
+
+    /** The first buffered packet of the reader. */
+    struct Head
+    {
+        qint64 timestamp = 0;
+        int id = 0;
     };
 
+    void readPackets(int id, ReaderContext* context, qint64 timeUsec);
+    void readAllPackets(qint64 timeUsec);
+    QnAbstractCompressedMetadataPtr popPacket(std::optional<qint64> refillTimeUsec);
+    void removeHead(int id);
+
+private:
+    const int m_batchSize;
     std::map<int /*id*/, ReaderContext> m_readers;
+
+    /** Min-heap by the timestamp, the readers with the lower id go first on ties. */
+    std::vector<Head> m_heads;
 };
@@ -14,6 +14,7 @@
 #include <nx/metric/metrics_storage.h>
 #include <nx/network/aio/unified_pollset.h>
 #include <nx/network/flash_socket/types.h>
+#include <nx/network/http/content_encoding.h>
 #include <nx/network/http/custom_headers.h>
 #include <nx/network/http/http_types.h>
 #include <nx/network/rest/result.h>
@@ -22,6 +23,7 @@
 #include <nx/utils/gzip/gzip_compressor.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/value_cache.h>
+#include <nx/utils/zstd/zstd_compressor.h>
 #include <nx/vms/common/system_settings.h>
 #include <utils/common/util.h>
 
@@ -390,6 +392,11 @@ void QnTCPConnectionProcessor::logRequestOrResponse(
     const auto uncompressDataIfNeeded =
         [&]()
         {
+            if (contentEncoding == nx::network::http::kZstdContentEncoding)
+            {
+                return nx::utils::bstream::zstd::Compressor::uncompressData(
+                    httpMessageBodyOnly).toByteArray();
+            }
             return !(contentEncoding.isEmpty() || contentEncoding == "identity")
                 ? nx::utils::bstream::gzip::Compressor::uncompressData(httpMessageBodyOnly).toByteArray()
                 : httpMessageBodyOnly.toByteArray();
@@ -872,19 +879,20 @@ void QnTCPConnectionProcessor::sendUnauthorizedResponse(
     if( acceptEncodingHeaderIter != d->request.headers.end() )
     {
         nx::network::http::header::AcceptEncodingHeader acceptEncodingHeader( acceptEncodingHeaderIter->second );
-        if( acceptEncodingHeader.encodingIsAllowed( "identity" ) )
+        const auto encoding = nx::network::http::selectContentEncoding(acceptEncodingHeader);
+        if (encoding.empty())
         {
-            contentEncoding = "identity";
+            //TODO #akolesnikov not supported encoding requested
         }
-        else if( acceptEncodingHeader.encodingIsAllowed( "gzip" ) )
+        else if (d->response.messageBody.empty())
         {
-            contentEncoding = "gzip";
-            if( !d->response.messageBody.empty() )
-                d->response.messageBody = nx::utils::bstream::gzip::Compressor::compressData(d->response.messageBody);
+            contentEncoding = QByteArray::fromStdString(encoding);
         }
-        else
+        else if (auto encodedBody = nx::network::http::encodeMessageBody(
+            encoding, d->response.messageBody))
         {
-            //TODO #akolesnikov not supported encoding requested
+            d->response.messageBody = std::move(*encodedBody);
+            contentEncoding = QByteArray::fromStdString(encoding);
         }
     }
     sendResponse(
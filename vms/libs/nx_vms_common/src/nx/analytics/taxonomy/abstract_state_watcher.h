@@ -19,6 +19,12 @@ public:
 
     virtual std::shared_ptr<AbstractState> state() const = 0;
 
+    /**
+     * Version of the current state, incremented each time the state is changed. Equal versions
+     * mean that the state has not been replaced, so the data derived from it are still valid.
+     */
+    virtual int stateVersion() const = 0;
+
 signals:
     void stateChanged();
 };
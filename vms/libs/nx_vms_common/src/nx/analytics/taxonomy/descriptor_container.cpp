@@ -77,9 +77,17 @@ Descriptors DescriptorContainer::descriptors(const nx::Uuid& serverId)
         Descriptors result;
         for (const QnMediaServerResourcePtr& server: servers)
         {
-            const QString serializedDescriptors = server->getProperty(kDescriptorsProperty);
-            descriptorsByServer[server->getId()] =
-                QJson::deserialized(serializedDescriptors.toUtf8(), Descriptors());
+            descriptorsByServer[server->getId()] = serverDescriptors(
+                server->getId(), server->getProperty(kDescriptorsProperty));
+        }
+
+        {
+            NX_MUTEX_LOCKER lock(&m_mutex);
+            std::erase_if(m_descriptorsByServer,
+                [&descriptorsByServer](const auto& item)
+                {
+                    return !descriptorsByServer.contains(item.first);
+                });
         }
 
         for (auto& [serverId, descriptors]: descriptorsByServer)
@@ -102,6 +110,23 @@ Descriptors DescriptorContainer::descriptors(const nx::Uuid& serverId)
     return QJson::deserialized(serializedDescriptors.toUtf8(), Descriptors());
 }
 
+Descriptors DescriptorContainer::serverDescriptors(
+    const nx::Uuid& serverId, const QString& serializedDescriptors)
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        const auto it = m_descriptorsByServer.find(serverId);
+        if (it != m_descriptorsByServer.end() && it->second.serialized == serializedDescriptors)
+            return it->second.descriptors;
+    }
+
+    auto descriptors = QJson::deserialized(serializedDescriptors.toUtf8(), Descriptors());
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_descriptorsByServer[serverId] = {serializedDescriptors, descriptors};
+    return descriptors;
+}
+
 void DescriptorContainer::updateDescriptors(const Descriptors& descriptors)
 {
     QnMediaServerResourcePtr ownServer = resourcePool()->getResourceById<QnMediaServerResource>(
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <map>
 #include <optional>
 
 #include <QtCore/QObject>
@@ -38,11 +39,24 @@ private:
 
     void fixScopeCompatibility(nx::vms::api::analytics::Descriptors* descriptors);
 
+    /** @return The descriptors of the Server, parsed again only if its property is changed. */
+    nx::vms::api::analytics::Descriptors serverDescriptors(
+        const nx::Uuid& serverId, const QString& serializedDescriptors);
+
 private:
     mutable nx::Mutex m_mutex;
 
     nx::core::resource::PropertyWatcher m_propertyWatcher;
     std::optional<nx::vms::api::analytics::Descriptors> m_cachedDescriptors;
+
+    struct ServerDescriptors
+    {
+        QString serialized;
+        nx::vms::api::analytics::Descriptors descriptors;
+    };
+
+    /** The parsed descriptors of the Servers, so a change of one Server does not parse all. */
+    std::map<nx::Uuid, ServerDescriptors> m_descriptorsByServer;
 };
 
 } // namespace nx::analytics::taxonomy
@@ -8,6 +8,7 @@
 #include <nx/analytics/taxonomy/state_compiler.h>
 #include <nx/analytics/taxonomy/resource_support_proxy.h>
 #include <nx/analytics/taxonomy/state.h>
+#include <nx/utils/log/log.h>
 
 using namespace nx::vms::api::analytics;
 using namespace nx::vms::common;
@@ -34,6 +35,12 @@ std::shared_ptr<AbstractState> StateWatcher::state() const
     return m_state;
 }
 
+int StateWatcher::stateVersion() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_stateVersion;
+}
+
 Descriptors StateWatcher::currentDescriptors() const
 {
     return m_taxonomyDescriptorContainer->descriptors();
@@ -41,13 +48,26 @@ Descriptors StateWatcher::currentDescriptors() const
 
 void StateWatcher::at_descriptorsUpdated()
 {
+    auto descriptors = currentDescriptors();
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        if (m_descriptors == descriptors)
+        {
+            NX_VERBOSE(this, "Descriptors are not changed, keeping the state %1", m_stateVersion);
+            return;
+        }
+    }
+
     StateCompiler::Result result = StateCompiler::compile(
-        currentDescriptors(),
+        descriptors,
         std::make_unique<ResourceSupportProxy>(systemContext()));
 
     {
         NX_MUTEX_LOCKER lock(&m_mutex);
         m_state = result.state;
+        m_descriptors = std::move(descriptors);
+        ++m_stateVersion;
+        NX_DEBUG(this, "State %1 is compiled", m_stateVersion);
     }
 
     emit stateChanged();
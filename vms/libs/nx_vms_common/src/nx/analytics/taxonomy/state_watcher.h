@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include <optional>
+
 #include <nx/analytics/taxonomy/abstract_state_watcher.h>
 #include <nx/utils/thread/mutex.h>
+#include <nx/vms/api/analytics/descriptors.h>
 #include <nx/vms/common/system_context_aware.h>
 
 namespace nx::analytics::taxonomy {
@@ -11,6 +14,12 @@ namespace nx::analytics::taxonomy {
 class State;
 class DescriptorContainer;
 
+/**
+ * Compiles the taxonomy state of the descriptors of all the Servers. The state is compiled again
+ * only when the merged descriptors are actually changed: the Servers often save the same
+ * descriptors, e.g. on each restart of the Device Agents, and each published state makes the
+ * users (like the Client search filters) rebuild their data.
+ */
 class StateWatcher: public AbstractStateWatcher, public nx::vms::common::SystemContextAware
 {
 public:
@@ -20,6 +29,7 @@ public:
         QObject* parent = nullptr);
 
     virtual std::shared_ptr<AbstractState> state() const override;
+    virtual int stateVersion() const override;
 
 private:
     nx::vms::api::analytics::Descriptors currentDescriptors() const;
@@ -30,6 +40,10 @@ private:
     DescriptorContainer* const m_taxonomyDescriptorContainer;
     mutable nx::Mutex m_mutex;
     mutable std::shared_ptr<AbstractState> m_state;
+
+    /** Descriptors the current state has been compiled from. */
+    std::optional<nx::vms::api::analytics::Descriptors> m_descriptors;
+    int m_stateVersion = 0;
 };
 
 } // namespace nx::analytics::taxonomy
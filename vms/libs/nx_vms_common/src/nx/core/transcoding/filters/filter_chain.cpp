@@ -6,6 +6,7 @@
 #include <nx/core/transcoding/filters/paint_image_filter.h>
 #include <nx/core/transcoding/filters/timestamp_filter.h>
 #include <nx/core/transcoding/filters/watermark_filter.h>
+#include <nx/media/ffmpeg/frame_info.h>
 #include <nx/utils/log/assert.h>
 #include <transcoding/filters/contrast_image_filter.h>
 #include <transcoding/filters/crop_image_filter.h>
@@ -159,14 +160,48 @@ CLVideoDecoderOutputPtr FilterChain::apply(
     if (empty() || !source)
         return source;
 
-    // Make a deep copy of the source frame since modifying a frame received from a decoder can
-    // affect further decoding process.
-    CLVideoDecoderOutputPtr result(new CLVideoDecoderOutput());
-    result->copyFrom(source.get());
+    // Modifying a frame received from a decoder can affect further decoding process, so a deep
+    // copy is made before the first filter modifying the frame in place. The filters producing a
+    // new frame, like scaling or rotation, read the source frame directly.
+    CLVideoDecoderOutputPtr result = source;
+    bool isOwnFrame = false;
+    if (source->memoryType() != MemoryType::SystemMemory)
+    {
+        // The filters work with the system memory only.
+        result = copyFrame(source);
+        isOwnFrame = true;
+    }
 
     for (auto filter: *this)
-        result = filter->updateImage(result, metadata);
+    {
+        if (filter->isInPlace() && !isOwnFrame)
+        {
+            result = copyFrame(result);
+            isOwnFrame = true;
+        }
+
+        const auto filtered = filter->updateImage(result, metadata);
+
+        // A view of the frame, e.g. the cropped one, shares the data with it.
+        if (filtered && filtered != result && !filtered->isExternalData())
+            isOwnFrame = true;
+        result = filtered;
+    }
+
+    return result;
+}
 
+CLVideoDecoderOutputPtr FilterChain::copyFrame(const CLVideoDecoderOutputPtr& frame) const
+{
+    CLVideoDecoderOutputPtr result;
+    if (frame->memoryType() == MemoryType::SystemMemory && !frame->isEmpty())
+    {
+        result = m_framePool->get(frame->size(),
+            CLVideoDecoderOutput::fixDeprecatedPixelFormat((AVPixelFormat) frame->format));
+    }
+    if (!result)
+        result.reset(new CLVideoDecoderOutput());
+    result->copyFrom(frame.get());
     return result;
 }
 
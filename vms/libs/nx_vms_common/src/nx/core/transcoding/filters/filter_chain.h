@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include <core/resource/resource_fwd.h>
 #include <core/resource/resource_media_layout.h>
 #include <nx/core/transcoding/filters/transcoding_settings.h>
+#include <nx/media/ffmpeg/video_frame_pool.h>
 #include <nx/vms/api/data/dewarping_data.h>
 #include <transcoding/filters/abstract_image_filter.h>
 
@@ -77,6 +80,7 @@ private:
     void prepareDownscaleFilter(const QSize& srcFrameResolution, const QSize& resolutionLimit);
     void createScaleImageFilter(const QSize& dstSize);
     void createPixelationImageFilter();
+    CLVideoDecoderOutputPtr copyFrame(const CLVideoDecoderOutputPtr& frame) const;
 
 private:
     bool m_ready = false;
@@ -84,6 +88,10 @@ private:
     nx::vms::api::dewarping::MediaData m_dewarpingParams;
     QnConstResourceVideoLayoutPtr m_layout;
     QnAbstractImageFilterList m_legacyFilters;
+
+    /** Shared by the copies of the chain, as the filters are. */
+    std::shared_ptr<nx::media::ffmpeg::VideoFramePool> m_framePool =
+        std::make_shared<nx::media::ffmpeg::VideoFramePool>();
 };
 
 } // namespace transcoding
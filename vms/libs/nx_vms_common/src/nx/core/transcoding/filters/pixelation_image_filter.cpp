@@ -27,44 +27,42 @@ std::optional<nx::common::metadata::ObjectMetadataPacket> objectDataPacketFromMe
 } // namespace
 
 PixelationImageFilter::PixelationImageFilter(const nx::vms::api::PixelationSettings& settings):
-    m_settings(settings)
+    m_settings(settings),
+    m_regions(settings)
 {
 }
 
 PixelationImageFilter::~PixelationImageFilter()
 {
     // Deleting in the thread it was created.
-    executeInThread(m_pixelation->thread(), [pixelation = m_pixelation]() {});
+    if (m_pixelation)
+        executeInThread(m_pixelation->thread(), [pixelation = m_pixelation]() {});
 }
 
 CLVideoDecoderOutputPtr PixelationImageFilter::updateImage(
     const CLVideoDecoderOutputPtr& frame,
     const QnAbstractCompressedMetadataPtr& metadata)
 {
-    // Creating in the thread it is used.
-    if (!m_pixelation)
-        m_pixelation = std::make_shared<nx::vms::common::pixelation::Pixelation>();
-
-    if (!metadata || (m_settings.objectTypeIds.empty() && !m_settings.isAllObjectTypes))
+    if (m_settings.objectTypeIds.empty() && !m_settings.isAllObjectTypes)
         return frame;
 
-    if (const auto objectDataPacket = objectDataPacketFromMetadata(metadata))
+    if (metadata)
     {
-        QVector<QRectF> boundingBoxes;
-        for (const auto& objectMetadata: objectDataPacket->objectMetadataList)
-        {
-            if (m_settings.isAllObjectTypes
-                || m_settings.objectTypeIds.contains(objectMetadata.typeId))
-            {
-                boundingBoxes.push_back(objectMetadata.boundingBox);
-            }
-        }
-
-        setImage(m_pixelation->pixelate(frame->toImage(), boundingBoxes, m_settings.intensity));
-        return PaintImageFilter::updateImage(frame, /*metadata*/ {});
+        if (const auto objectDataPacket = objectDataPacketFromMetadata(metadata))
+            m_regions.update(*objectDataPacket);
     }
 
-    return frame;
+    // The frames between the metadata packets are masked with the last known regions.
+    const QVector<QRectF> regions = m_regions.regions(frame->pkt_dts);
+    if (regions.isEmpty())
+        return frame;
+
+    // Creating in the thread it is used.
+    if (!m_pixelation)
+        m_pixelation = std::make_shared<nx::vms::common::pixelation::Pixelation>();
+
+    setImage(m_pixelation->pixelate(frame->toImage(), regions, m_settings.intensity));
+    return PaintImageFilter::updateImage(frame, /*metadata*/ {});
 }
 
 } // nx::core::transcoding
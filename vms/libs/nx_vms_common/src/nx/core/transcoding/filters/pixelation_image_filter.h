@@ -5,6 +5,7 @@
 #include <nx/vms/api/data/pixelation_settings.h>
 
 #include "paint_image_filter.h"
+#include "pixelation_regions.h"
 
 namespace nx::vms::common { class PixelationSettings; }
 namespace nx::vms::common::pixelation { class Pixelation; }
@@ -26,6 +27,7 @@ public:
 private:
     std::shared_ptr<nx::vms::common::pixelation::Pixelation> m_pixelation;
     nx::vms::api::PixelationSettings m_settings;
+    PixelationRegions m_regions;
 };
 
 } // nx::core::transcoding
@@ -0,0 +1,60 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "pixelation_regions.h"
+
+#include <algorithm>
+
+namespace nx::core::transcoding {
+
+PixelationRegions::PixelationRegions(const nx::vms::api::PixelationSettings& settings):
+    m_settings(settings)
+{
+}
+
+void PixelationRegions::update(const nx::common::metadata::ObjectMetadataPacket& packet)
+{
+    std::map<nx::Uuid, Object> objects;
+    for (const auto& objectMetadata: packet.objectMetadataList)
+    {
+        if (!m_settings.isAllObjectTypes
+            && !m_settings.objectTypeIds.contains(objectMetadata.typeId))
+        {
+            continue;
+        }
+
+        Object object{objectMetadata.boundingBox};
+        const auto previous = m_objects.find(objectMetadata.trackId);
+        const qint64 elapsedUs = packet.timestampUs - m_timestampUs;
+        if (previous != m_objects.end() && elapsedUs > 0)
+        {
+            object.velocity = (object.boundingBox.center()
+                - previous->second.boundingBox.center()) / elapsedUs;
+        }
+        objects[objectMetadata.trackId] = object;
+    }
+
+    m_objects = std::move(objects);
+    m_timestampUs = packet.timestampUs;
+}
+
+QVector<QRectF> PixelationRegions::regions(qint64 timestampUs) const
+{
+    const qint64 elapsedUs = timestampUs - m_timestampUs;
+    if (m_objects.empty() || elapsedUs > kHoldTime.count())
+        return {};
+
+    const qint64 predictionUs = std::clamp<qint64>(
+        elapsedUs, -kMaxPredictionTime.count(), kMaxPredictionTime.count());
+
+    static const QRectF kFrame(0, 0, 1, 1);
+    QVector<QRectF> result;
+    result.reserve((int) m_objects.size());
+    for (const auto& [_, object]: m_objects)
+    {
+        const QRectF predicted = object.boundingBox.translated(object.velocity * predictionUs);
+        result.push_back(object.boundingBox.united(predicted).intersected(kFrame));
+    }
+    return result;
+}
+
+} // namespace nx::core::transcoding
@@ -0,0 +1,57 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+
+#include <QtCore/QPointF>
+#include <QtCore/QRectF>
+#include <QtCore/QVector>
+
+#include <analytics/common/object_metadata.h>
+#include <nx/vms/api/data/pixelation_settings.h>
+
+namespace nx::core::transcoding {
+
+/**
+ * Regions of the frame to pixelate, derived from the object metadata packets. The metadata
+ * arrives less often than the video frames, so the regions of the last packet are kept for the
+ * frames in between. The object movement is predicted from its two last positions, and the region
+ * covers both the last known and the predicted positions.
+ */
+class NX_VMS_COMMON_API PixelationRegions
+{
+public:
+    /** The regions are dropped if no metadata arrives for this time. */
+    static constexpr std::chrono::microseconds kHoldTime = std::chrono::seconds(1);
+
+    /** The movement is not predicted further than this from the last known position. */
+    static constexpr std::chrono::microseconds kMaxPredictionTime =
+        std::chrono::milliseconds(500);
+
+    PixelationRegions(const nx::vms::api::PixelationSettings& settings);
+
+    /** Replaces the tracked objects with the ones of the packet. */
+    void update(const nx::common::metadata::ObjectMetadataPacket& packet);
+
+    /** @return Regions in the relative coordinates for the frame with the given timestamp. */
+    QVector<QRectF> regions(qint64 timestampUs) const;
+
+    bool isEmpty() const { return m_objects.empty(); }
+
+private:
+    struct Object
+    {
+        QRectF boundingBox;
+
+        /** Movement of the bounding box per microsecond. */
+        QPointF velocity;
+    };
+
+    const nx::vms::api::PixelationSettings m_settings;
+    std::map<nx::Uuid, Object> m_objects;
+    qint64 m_timestampUs = 0;
+};
+
+} // namespace nx::core::transcoding
@@ -2,33 +2,81 @@
 
 #include "abstract_data_consumer.h"
 
+#include <nx/media/video_data_packet.h>
+#include <nx/streaming/data_consumer_pool.h>
 #include <utils/common/sleep.h>
 #include <nx/utils/log/log.h>
 
 namespace {
     static const int kWaitTimeoutMs = 200;
+    static const int kMaxBatchSize = 16;
+
+    quint64 channelBit(const QnCompressedVideoData& video)
+    {
+        return 1ULL << (video.channelNumber % 64);
+    }
 } // namespace
 
 
-QnAbstractDataConsumer::QnAbstractDataConsumer(int maxQueueSize)
+QnAbstractDataConsumer::QnAbstractDataConsumer(int maxQueueSize, QueueMode queueMode)
     : m_dataQueue(maxQueueSize)
 {
+    if (queueMode == QueueMode::lockFree)
+    {
+        m_lockFreeQueue = std::make_unique<
+            nx::streaming::LockFreePacketQueue<QnAbstractDataPacketPtr>>(maxQueueSize);
+        m_batch.reserve(kMaxBatchSize);
+    }
 }
 
 bool QnAbstractDataConsumer::canAcceptData() const
 {
-    return (m_dataQueue.size() < m_dataQueue.maxSize());
+    return queueSize() < maxQueueSize();
 }
 
 void QnAbstractDataConsumer::putData( const QnAbstractDataPacketPtr& data )
 {
-    if (!needToStop())
+    if (needToStop())
+        return;
+
+    if (m_lockFreeQueue)
+        pushToLockFreeQueue(data);
+    else
         m_dataQueue.push(data);
+
+    if (m_pool)
+        schedulePoolTask();
+}
+
+void QnAbstractDataConsumer::pushToLockFreeQueue(QnAbstractDataPacketPtr data)
+{
+    const auto video = dynamic_cast<const QnCompressedVideoData*>(data.get());
+    if (video && (m_droppedChannels & channelBit(*video))
+        && !video->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey))
+    {
+        return;
+    }
+
+    if (m_lockFreeQueue->tryPush(data))
+    {
+        if (video)
+            m_droppedChannels.fetch_and(~channelBit(*video));
+        return;
+    }
+
+    if (video && !(m_droppedChannels.fetch_or(channelBit(*video)) & channelBit(*video)))
+    {
+        NX_VERBOSE(this, "Queue overflow, video of channel %1 is dropped until the next key frame",
+            video->channelNumber);
+    }
 }
 
 void QnAbstractDataConsumer::clearUnprocessedData()
 {
-    m_dataQueue.clear();
+    if (m_lockFreeQueue)
+        m_lockFreeQueue->clear();
+    else
+        m_dataQueue.clear();
 }
 
 void QnAbstractDataConsumer::beforeRun()
@@ -45,13 +93,179 @@ void QnAbstractDataConsumer::pleaseStop()
     NX_MUTEX_LOCKER lock(&m_pleaseStopMutex);
     QnLongRunnable::pleaseStop();
     m_dataQueue.setTerminated(true);
+    if (m_lockFreeQueue)
+        m_lockFreeQueue->setTerminated(true);
+    if (m_pool)
+        schedulePoolTask();
 }
 
 void QnAbstractDataConsumer::resumeDataQueue()
 {
     NX_MUTEX_LOCKER lock(&m_pleaseStopMutex);
-    if (!needToStop())
-        m_dataQueue.setTerminated(false);
+    if (needToStop())
+        return;
+
+    m_dataQueue.setTerminated(false);
+    if (m_lockFreeQueue)
+        m_lockFreeQueue->setTerminated(false);
+}
+
+void QnAbstractDataConsumer::setPool(nx::streaming::DataConsumerPool* pool)
+{
+    NX_ASSERT(m_lockFreeQueue, "Only the lock-free queue consumers can run in a pool");
+    NX_ASSERT(!isRunning());
+    if (m_lockFreeQueue)
+        m_pool = pool;
+}
+
+void QnAbstractDataConsumer::start(Priority priority)
+{
+    if (!m_pool)
+        return QnLongRunnable::start(priority);
+
+    NX_MUTEX_LOCKER lock(&m_poolMutex);
+    if (m_poolRunning)
+        return;
+
+    m_needStop = false;
+    m_poolRunStarted = false;
+    m_poolRunning = true;
+    m_poolTaskState = PoolTaskState::scheduled;
+    m_pool->post(this);
+}
+
+void QnAbstractDataConsumer::stop()
+{
+    if (!m_pool)
+        return QnLongRunnable::stop();
+
+    pleaseStop();
+    NX_MUTEX_LOCKER lock(&m_poolMutex);
+    while (m_poolRunning)
+        m_poolCondition.wait(&m_poolMutex);
+}
+
+void QnAbstractDataConsumer::resume()
+{
+    QnLongRunnable::resume();
+    if (m_pool)
+        schedulePoolTask();
+}
+
+bool QnAbstractDataConsumer::isRunning() const
+{
+    if (!m_pool)
+        return QnLongRunnable::isRunning();
+
+    NX_MUTEX_LOCKER lock(&m_poolMutex);
+    return m_poolRunning;
+}
+
+void QnAbstractDataConsumer::schedulePoolTask()
+{
+    auto state = m_poolTaskState.load();
+    for (;;)
+    {
+        if (state == PoolTaskState::idle)
+        {
+            if (m_poolTaskState.compare_exchange_weak(state, PoolTaskState::scheduled))
+                return m_pool->post(this);
+        }
+        else if (state == PoolTaskState::running)
+        {
+            // The task checks the state when the cycle is over and queues itself again.
+            if (m_poolTaskState.compare_exchange_weak(state, PoolTaskState::runningNotified))
+                return;
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+void QnAbstractDataConsumer::runPoolTask()
+{
+    m_poolTaskState = PoolTaskState::running;
+    switch (runPoolCycle())
+    {
+        case PoolCycleResult::idle:
+        {
+            // A packet put after the queue was found empty has changed the state to
+            // runningNotified, so it is not left unprocessed.
+            auto state = PoolTaskState::running;
+            if (m_poolTaskState.compare_exchange_strong(state, PoolTaskState::idle))
+                return;
+
+            m_poolTaskState = PoolTaskState::scheduled;
+            return m_pool->post(this);
+        }
+
+        case PoolCycleResult::more:
+            // To the end of the pool queue, so a busy consumer does not delay the others.
+            m_poolTaskState = PoolTaskState::scheduled;
+            return m_pool->post(this);
+
+        case PoolCycleResult::retry:
+            m_poolTaskState = PoolTaskState::scheduled;
+            return m_pool->postDelayed(this, std::chrono::milliseconds(kNoDataDelayIntervalMs));
+
+        case PoolCycleResult::finished:
+        {
+            // This is the last access to the consumer by the pool: it may be destroyed as soon
+            // as stop() sees it is not running.
+            NX_MUTEX_LOCKER lock(&m_poolMutex);
+            m_poolTaskState = PoolTaskState::finished;
+            m_poolRunning = false;
+            m_poolCondition.wakeAll();
+            return;
+        }
+    }
+}
+
+QnAbstractDataConsumer::PoolCycleResult QnAbstractDataConsumer::runPoolCycle()
+{
+    if (!m_poolRunStarted)
+    {
+        m_poolRunStarted = true;
+        beforeRun();
+        resumeDataQueue();
+    }
+
+    if (needToStop())
+    {
+        m_refusedPacket.reset();
+        endOfRun();
+        return PoolCycleResult::finished;
+    }
+
+    // resume() queues the task again.
+    if (isPaused())
+        return PoolCycleResult::idle;
+
+    if (m_refusedPacket)
+    {
+        if (!processData(m_refusedPacket))
+            return PoolCycleResult::retry;
+        m_refusedPacket.reset();
+    }
+
+    QnAbstractDataPacketPtr data;
+    for (int i = 0; i < kMaxBatchSize; ++i)
+    {
+        if (needToStop())
+            return PoolCycleResult::more;
+        if (!m_lockFreeQueue->tryPop(data))
+            return PoolCycleResult::idle;
+
+        if (!processData(data))
+        {
+            m_refusedPacket = std::move(data);
+            return PoolCycleResult::retry;
+        }
+    }
+
+    return m_lockFreeQueue->isEmpty() ? PoolCycleResult::idle : PoolCycleResult::more;
 }
 
 void QnAbstractDataConsumer::run()
@@ -73,6 +287,12 @@ void QnAbstractDataConsumer::run()
 
 void QnAbstractDataConsumer::runCycle()
 {
+    if (m_lockFreeQueue)
+    {
+        processLockFreeQueue();
+        return;
+    }
+
     QnAbstractDataPacketPtr data;
     bool get = m_dataQueue.pop(data, kWaitTimeoutMs);
 
@@ -81,6 +301,26 @@ void QnAbstractDataConsumer::runCycle()
         QnSleep::msleep(kNoDataDelayIntervalMs);
         return;
     }
+    processPacket(data);
+}
+
+void QnAbstractDataConsumer::processLockFreeQueue()
+{
+    if (!m_lockFreeQueue->waitForData(std::chrono::milliseconds(kWaitTimeoutMs)))
+        return;
+
+    m_lockFreeQueue->popBatch(&m_batch, kMaxBatchSize);
+    for (const auto& data: m_batch)
+    {
+        if (needToStop())
+            break;
+        processPacket(data);
+    }
+    m_batch.clear();
+}
+
+void QnAbstractDataConsumer::processPacket(const QnAbstractDataPacketPtr& data)
+{
     while(!needToStop())
     {
         if (processData(data))
@@ -92,6 +332,8 @@ void QnAbstractDataConsumer::runCycle()
 
 int QnAbstractDataConsumer::queueSize() const
 {
+    if (m_lockFreeQueue)
+        return (int) m_lockFreeQueue->size();
     return m_dataQueue.size();
 }
 
@@ -3,9 +3,17 @@
 #ifndef abstract_data_consumer_h_2111
 #define abstract_data_consumer_h_2111
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include <core/dataconsumer/abstract_data_receptor.h>
 #include <nx/streaming/data_packet_queue.h>
+#include <nx/streaming/lock_free_packet_queue.h>
 #include <nx/utils/thread/long_runnable.h>
+#include <nx/utils/thread/wait_condition.h>
+
+namespace nx::streaming { class DataConsumerPool; }
 
 class NX_VMS_COMMON_API QnAbstractDataConsumer
 :
@@ -13,9 +21,32 @@ class NX_VMS_COMMON_API QnAbstractDataConsumer
     public QnAbstractMediaDataReceptor
 {
 public:
-    QnAbstractDataConsumer(int maxQueueSize);
+    enum class QueueMode
+    {
+        /** The packets are kept in m_dataQueue, which the descendant may access. */
+        locked,
+
+        /**
+         * The packets are passed through the lock-free queue of at least maxQueueSize capacity and
+         * are processed in batches; m_dataQueue is not used. When the queue is full, the video
+         * packets of the channel are dropped until its next key frame, and the other packets are
+         * dropped one by one.
+         */
+        lockFree,
+    };
+
+    QnAbstractDataConsumer(int maxQueueSize, QueueMode queueMode = QueueMode::locked);
     virtual ~QnAbstractDataConsumer(){ stop(); }
 
+    /**
+     * Makes the consumer run as a task of the pool instead of its own thread: start() queues it
+     * to the pool, and so does every putData(). Must be called before start(). Only for the
+     * QueueMode::lockFree consumers that do not override run() and runCycle(). If processData()
+     * refuses a packet, it is retried after kNoDataDelayIntervalMs without holding a pool thread.
+     * Such a consumer is not registered in QnLongRunnablePool, its owner has to stop it.
+     */
+    void setPool(nx::streaming::DataConsumerPool* pool);
+
     /**
       * @return true is there is any space in the queue, false otherwise
       */
@@ -28,10 +59,13 @@ public:
 
     //virtual qint64 getDisplayedTime() const { return 0; }
     virtual bool isRealTimeSource() const { return false; }
+    virtual void start(Priority priority = InheritPriority) override;
     virtual void pleaseStop() override;
-    virtual bool isRunning() const { return QnLongRunnable::isRunning(); }
+    virtual void stop() override;
+    virtual void resume() override;
+    virtual bool isRunning() const;
 protected:
-    static const int kNoDataDelayIntervalMs = 10;
+    static constexpr int kNoDataDelayIntervalMs = 10;
 
     friend class QnArchiveStreamReader;
 
@@ -42,11 +76,51 @@ protected:
     virtual void beforeRun();
     virtual void endOfRun();
 private:
+    friend class nx::streaming::DataConsumerPool;
+
+    enum class PoolTaskState
+    {
+        idle,
+        scheduled,
+        running,
+        /** Running, and has to be scheduled again after that. */
+        runningNotified,
+        finished,
+    };
+
+    enum class PoolCycleResult
+    {
+        idle,
+        more,
+        retry,
+        finished,
+    };
+
     void resumeDataQueue();
+    void pushToLockFreeQueue(QnAbstractDataPacketPtr data);
+    void processLockFreeQueue();
+    void processPacket(const QnAbstractDataPacketPtr& data);
+
+    void schedulePoolTask();
+    void runPoolTask();
+    PoolCycleResult runPoolCycle();
 protected:
     QnDataPacketQueue m_dataQueue;
 private:
     nx::Mutex m_pleaseStopMutex;
+    std::unique_ptr<nx::streaming::LockFreePacketQueue<QnAbstractDataPacketPtr>> m_lockFreeQueue;
+    /** Bits of the video channels being dropped until their next key frames. */
+    std::atomic<quint64> m_droppedChannels{0};
+    std::vector<QnAbstractDataPacketPtr> m_batch;
+
+    nx::streaming::DataConsumerPool* m_pool = nullptr;
+    std::atomic<PoolTaskState> m_poolTaskState{PoolTaskState::finished};
+    /** Accessed by the pool task only. */
+    bool m_poolRunStarted = false;
+    QnAbstractDataPacketPtr m_refusedPacket;
+    mutable nx::Mutex m_poolMutex;
+    nx::WaitCondition m_poolCondition;
+    bool m_poolRunning = false;
 };
 
 #endif // abstract_data_consumer_h_2111
@@ -0,0 +1,93 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "data_consumer_pool.h"
+
+#include <algorithm>
+
+#include <nx/streaming/abstract_data_consumer.h>
+#include <nx/utils/log/log.h>
+#include <nx/utils/thread/thread_util.h>
+
+using namespace std::chrono;
+
+namespace nx::streaming {
+
+DataConsumerPool::DataConsumerPool(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = std::max(1, (int) std::thread::hardware_concurrency());
+
+    NX_DEBUG(this, "Starting %1 threads", threadCount);
+    for (int i = 0; i < threadCount; ++i)
+        m_threads.emplace_back([this]() { run(); });
+}
+
+DataConsumerPool::~DataConsumerPool()
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        NX_ASSERT(m_ready.empty() && m_delayed.empty(),
+            "The consumers must be stopped before the pool is destroyed");
+        m_terminated = true;
+        m_condition.wakeAll();
+    }
+
+    for (auto& thread: m_threads)
+        thread.join();
+}
+
+void DataConsumerPool::post(QnAbstractDataConsumer* consumer)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_ready.push_back(consumer);
+    m_condition.wakeOne();
+}
+
+void DataConsumerPool::postDelayed(QnAbstractDataConsumer* consumer, milliseconds delay)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    const auto it = m_delayed.emplace(steady_clock::now() + delay, consumer);
+
+    // The sleeping thread has to shorten its wait only if this consumer is the first one due.
+    if (it == m_delayed.begin())
+        m_condition.wakeOne();
+}
+
+void DataConsumerPool::run()
+{
+    nx::utils::setCurrentThreadName("DataConsumerPool");
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    while (!m_terminated)
+    {
+        const auto now = steady_clock::now();
+        while (!m_delayed.empty() && m_delayed.begin()->first <= now)
+        {
+            m_ready.push_back(m_delayed.begin()->second);
+            m_delayed.erase(m_delayed.begin());
+        }
+
+        if (m_ready.empty())
+        {
+            if (m_delayed.empty())
+            {
+                m_condition.wait(&m_mutex);
+            }
+            else
+            {
+                m_condition.wait(&m_mutex,
+                    ceil<milliseconds>(m_delayed.begin()->first - now));
+            }
+            continue;
+        }
+
+        const auto consumer = m_ready.front();
+        m_ready.pop_front();
+
+        lock.unlock();
+        consumer->runPoolTask();
+        lock.relock();
+    }
+}
+
+} // namespace nx::streaming
@@ -0,0 +1,55 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <nx/utils/thread/mutex.h>
+#include <nx/utils/thread/wait_condition.h>
+
+class QnAbstractDataConsumer;
+
+namespace nx::streaming {
+
+/**
+ * Fixed set of threads running the QnAbstractDataConsumer loops that are attached to the pool
+ * with QnAbstractDataConsumer::setPool(). Such a consumer has no thread of its own: it is queued
+ * to the pool when a packet is put to it, and a pool thread processes its queued packets and
+ * moves on to the next consumer. So the thread count depends on the pool size, not on the number
+ * of the consumers, and the idle consumers cost no thread at all.
+ *
+ * The consumers must be stopped before the pool is destroyed.
+ */
+class NX_VMS_COMMON_API DataConsumerPool
+{
+public:
+    /** @param threadCount 0 means the number of the CPU cores. */
+    explicit DataConsumerPool(int threadCount = 0);
+    ~DataConsumerPool();
+
+    DataConsumerPool(const DataConsumerPool&) = delete;
+    DataConsumerPool& operator=(const DataConsumerPool&) = delete;
+
+    int threadCount() const { return (int) m_threads.size(); }
+
+private:
+    friend class ::QnAbstractDataConsumer;
+
+    void post(QnAbstractDataConsumer* consumer);
+    void postDelayed(QnAbstractDataConsumer* consumer, std::chrono::milliseconds delay);
+    void run();
+
+private:
+    nx::Mutex m_mutex;
+    nx::WaitCondition m_condition;
+    std::deque<QnAbstractDataConsumer*> m_ready;
+    std::multimap<std::chrono::steady_clock::time_point, QnAbstractDataConsumer*> m_delayed;
+    bool m_terminated = false;
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace nx::streaming
@@ -0,0 +1,196 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <nx/utils/thread/mutex.h>
+#include <nx/utils/thread/wait_condition.h>
+
+namespace nx::streaming {
+
+/**
+ * Bounded queue of many producers and many consumers, which does not lock a mutex to push or pop
+ * an element: it is a ring of the sequenced cells by Dmitry Vyukov.
+ *
+ * The consumer may block in waitForData() while the queue is empty. The mutex is locked by the
+ * producer only to wake such a consumer, so the producer and consumer threads that keep up with
+ * each other do not contend.
+ */
+template<typename T>
+class LockFreePacketQueue
+{
+public:
+    /** @param capacity Rounded up to the power of two. */
+    explicit LockFreePacketQueue(size_t capacity):
+        m_mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        m_cells(new Cell[m_mask + 1])
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    LockFreePacketQueue(const LockFreePacketQueue&) = delete;
+    LockFreePacketQueue& operator=(const LockFreePacketQueue&) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    /** Approximate, if the queue is used concurrently. */
+    size_t size() const
+    {
+        const size_t dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+        const size_t enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+        return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+    }
+
+    bool isEmpty() const
+    {
+        const size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+        return m_cells[position & m_mask].sequence.load(std::memory_order_acquire)
+            != position + 1;
+    }
+
+    /** @return False if the queue is full, the value is not moved from then. */
+    bool tryPush(T& value)
+    {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = m_cells[position & m_mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = (std::intptr_t) sequence - (std::intptr_t) position;
+            if (difference == 0)
+            {
+                if (m_enqueuePosition.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    wakeConsumers();
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value)
+    {
+        size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = m_cells[position & m_mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = (std::intptr_t) sequence - (std::intptr_t) (position + 1);
+            if (difference == 0)
+            {
+                if (m_dequeuePosition.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.value);
+                    cell.value = T();
+                    cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Appends up to maxCount elements to the values. @return Number of the elements popped. */
+    size_t popBatch(std::vector<T>* values, size_t maxCount)
+    {
+        size_t count = 0;
+        T value;
+        while (count < maxCount && tryPop(value))
+        {
+            values->push_back(std::move(value));
+            ++count;
+        }
+        return count;
+    }
+
+    /** @return False if the queue is still empty after the timeout or the termination. */
+    bool waitForData(std::chrono::milliseconds timeout)
+    {
+        if (!isEmpty())
+            return true;
+
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_waitingConsumers.fetch_add(1);
+        // Pairs with the fence of wakeConsumers(): either the consumer sees the pushed element, or
+        // the producer sees the waiting consumer.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isEmpty() && !m_terminated)
+            m_condition.wait(&m_mutex, timeout);
+        m_waitingConsumers.fetch_sub(1);
+        return !isEmpty();
+    }
+
+    void clear()
+    {
+        T value;
+        while (tryPop(value))
+            value = T();
+    }
+
+    /** The terminated queue does not block waitForData(), but the pushed elements are kept. */
+    void setTerminated(bool value)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_terminated = value;
+        m_condition.wakeAll();
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    void wakeConsumers()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waitingConsumers.load(std::memory_order_relaxed) == 0)
+            return;
+
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_condition.wakeAll();
+    }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    const size_t m_mask;
+    const std::unique_ptr<Cell[]> m_cells;
+    alignas(kCacheLineSize) std::atomic<size_t> m_enqueuePosition{0};
+    alignas(kCacheLineSize) std::atomic<size_t> m_dequeuePosition{0};
+    alignas(kCacheLineSize) std::atomic<int> m_waitingConsumers{0};
+
+    nx::Mutex m_mutex;
+    nx::WaitCondition m_condition;
+    bool m_terminated = false;
+};
+
+} // namespace nx::streaming
@@ -10,3 +10,15 @@ void QnMediaStreamStatistics::onData(const QnAbstractMediaDataPtr& media)
     const auto timestamp = std::chrono::microseconds(media->timestamp);
     return nx::sdk::MediaStreamStatistics::onData(timestamp, media->dataSize(), isKeyFrame);
 }
+
+void QnMediaStreamStatistics::setRetransmissionStatistics(const nx::rtp::RtcpNackStatistics& value)
+{
+    std::lock_guard<std::mutex> lock(m_retransmissionMutex);
+    m_retransmission = value;
+}
+
+nx::rtp::RtcpNackStatistics QnMediaStreamStatistics::retransmissionStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_retransmissionMutex);
+    return m_retransmission;
+}
@@ -3,7 +3,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
+#include <nx/rtp/rtcp_nack.h>
 #include <nx/sdk/helpers/media_stream_statistics.h>
 
 struct QnAbstractMediaData;
@@ -15,4 +17,15 @@ public:
     QnMediaStreamStatistics() = default;
 
     void onData(const QnAbstractMediaDataPtr& media);
+
+    /**
+     * Counters of the RTCP NACK based retransmission, updated by the stream reader if the stream
+     * uses it.
+     */
+    void setRetransmissionStatistics(const nx::rtp::RtcpNackStatistics& value);
+    nx::rtp::RtcpNackStatistics retransmissionStatistics() const;
+
+private:
+    mutable std::mutex m_retransmissionMutex;
+    nx::rtp::RtcpNackStatistics m_retransmission;
 };
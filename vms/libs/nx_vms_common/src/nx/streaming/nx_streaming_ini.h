@@ -44,6 +44,57 @@ struct NxStreamingIniConfig: public nx::kit::IniConfig
         "clock used for metadata and the server clock is bigger than this value plus\n"
         "forceCameraTimeThresholdMs then the server will bind the camera metadata clock to the\n"
         "server one. Otherwise the camera metadata clock will be used");
+
+    NX_INI_INT(
+        16'384,
+        archiveReadAheadKb,
+        "Size of the local file packets read ahead of the archive reader, and kept behind it to\n"
+        "seek inside them without reading the file. 0 disables the read-ahead.");
+
+    NX_INI_INT(
+        5'000,
+        archiveReadAheadMs,
+        "Duration of the local file packets read ahead of the archive reader, and kept behind\n"
+        "it.");
+
+    NX_INI_INT(
+        1024,
+        writeBehindBufferKb,
+        "Size of the buffers, through which the recorded files are written by the I/O threads of\n"
+        "the storage. 0 makes the recorder thread write the files itself.");
+
+    NX_INI_INT(
+        8,
+        writeBehindQueuedBuffers,
+        "Number of the buffers of a recorded file waiting for the I/O thread, after which the\n"
+        "recorder thread waits too.");
+
+    NX_INI_INT(2, writeBehindThreadsPerStorage, "Number of the I/O threads of a storage.");
+
+    NX_INI_FLAG(
+        0,
+        writeBehindDirectIo,
+        "Write the recorded files bypassing the OS page cache (O_DIRECT), if the file system\n"
+        "supports it. Linux only.");
+
+    NX_INI_STRING(
+        "onClose",
+        writeBehindFsync,
+        "When the recorded files are synced to the disk: never, onClose or always (after each\n"
+        "write of the I/O thread).");
+
+    NX_INI_INT(
+        4,
+        storageIoConcurrency,
+        "Number of the reads and writes of a storage running in parallel. The rest are waiting\n"
+        "in the queues of the recording, playback, export and backup, and are started by the\n"
+        "weights and latency targets of these classes. 0 disables the scheduling.");
+
+    NX_INI_INT(
+        0,
+        metadataSearchThreads,
+        "Number of the threads matching the hours of a motion or analytics archive file in\n"
+        "parallel. 0 means the number of the CPU cores, 1 makes the search single-threaded.");
 };
 
 NX_VMS_COMMON_API NxStreamingIniConfig& nxStreamingIni();
@@ -0,0 +1,404 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "read_ahead_archive_delegate.h"
+
+#include <nx/utils/log/log.h>
+
+#include "nx_streaming_ini.h"
+
+namespace nx::streaming {
+
+std::optional<ReadAheadArchiveDelegate::Budget> ReadAheadArchiveDelegate::budgetFromIni()
+{
+    if (nxStreamingIni().archiveReadAheadKb <= 0 || nxStreamingIni().archiveReadAheadMs <= 0)
+        return std::nullopt;
+
+    Budget budget;
+    budget.bytes = (qint64) nxStreamingIni().archiveReadAheadKb * 1024;
+    budget.duration = std::chrono::milliseconds(nxStreamingIni().archiveReadAheadMs);
+    return budget;
+}
+
+ReadAheadArchiveDelegate::ReadAheadArchiveDelegate(
+    std::unique_ptr<QnAbstractArchiveDelegate> delegate, Budget budget)
+    :
+    base_type(std::move(delegate)),
+    m_budget(budget)
+{
+    m_flags = this->delegate()->getFlags();
+    connect(this->delegate(), &QnAbstractArchiveDelegate::qualityChanged,
+        this, &QnAbstractArchiveDelegate::qualityChanged, Qt::DirectConnection);
+    m_thread = std::thread([this]() { run(); });
+}
+
+ReadAheadArchiveDelegate::~ReadAheadArchiveDelegate()
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_needToStop = true;
+        m_condition.wakeAll();
+    }
+    m_thread.join();
+}
+
+bool ReadAheadArchiveDelegate::open(
+    const QnResourcePtr& resource,
+    AbstractArchiveIntegrityWatcher* archiveIntegrityWatcher)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    const bool result = delegate()->open(resource, archiveIntegrityWatcher);
+    m_flags = delegate()->getFlags();
+    const auto layout = result ? delegate()->getVideoLayout() : QnConstResourceVideoLayoutPtr();
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    clearBuffer();
+    m_channelCount = layout ? layout->channelCount() : 1;
+    m_isOpened = result && !delegate()->isRealTimeSource();
+    return result;
+}
+
+void ReadAheadArchiveDelegate::close()
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_isOpened = false;
+        clearBuffer();
+    }
+    delegate()->close();
+}
+
+bool ReadAheadArchiveDelegate::reopen()
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    const bool result = delegate()->reopen();
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    clearBuffer();
+    return result;
+}
+
+QnAbstractMediaDataPtr ReadAheadArchiveDelegate::getNextData()
+{
+    bool isReadingAhead = false;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        isReadingAhead = isActive();
+    }
+
+    if (!isReadingAhead)
+    {
+        // The reading thread is started only with m_delegateMutex locked.
+        NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        if (!isActive())
+        {
+            lock.unlock();
+            return delegate()->getNextData();
+        }
+    }
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_condition.waitFor(&m_mutex, std::chrono::milliseconds::max(),
+        [this]() { return !isActive() || m_readPosition < m_packets.size() || m_isEof; });
+
+    if (m_readPosition < m_packets.size())
+        return takeNext();
+
+    // Let the reading thread check the end of the stream again on the next call, as the wrapped
+    // delegate would do.
+    m_isEof = false;
+    m_condition.wakeAll();
+    return QnAbstractMediaDataPtr();
+}
+
+qint64 ReadAheadArchiveDelegate::seek(qint64 time, bool findIFrame)
+{
+    if (findIFrame)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        if (seekInBuffer(time))
+        {
+            NX_VERBOSE(this, "Seek to %1 inside of the read-ahead buffer", time);
+            return time;
+        }
+    }
+
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    const qint64 result = delegate()->seek(time, findIFrame);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    clearBuffer();
+    return result;
+}
+
+QnConstResourceVideoLayoutPtr ReadAheadArchiveDelegate::getVideoLayout()
+{
+    // The layout is requested by the reader for each packet, so it is not serialized with the
+    // reading thread, as it was not serialized with the other threads before.
+    return delegate()->getVideoLayout();
+}
+
+AudioLayoutConstPtr ReadAheadArchiveDelegate::getAudioLayout()
+{
+    return delegate()->getAudioLayout();
+}
+
+bool ReadAheadArchiveDelegate::setAudioChannel(unsigned num)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    return delegate()->setAudioChannel(num);
+}
+
+void ReadAheadArchiveDelegate::setSpeed(qint64 displayTime, double value)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    delegate()->setSpeed(displayTime, value);
+
+    // The delegate playing backwards itself reorders the stream, so the packets are not read
+    // ahead then.
+    const bool isReverse = value < 0 && m_flags.testFlag(Flag_CanProcessNegativeSpeed);
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (isReverse != m_isReverse)
+    {
+        m_isReverse = isReverse;
+        clearBuffer();
+    }
+}
+
+void ReadAheadArchiveDelegate::setSingleshotMode(bool value)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    delegate()->setSingleshotMode(value);
+}
+
+bool ReadAheadArchiveDelegate::setQuality(
+    MediaQuality quality, bool fastSwitch, const QSize& resolution)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    return delegate()->setQuality(quality, fastSwitch, resolution);
+}
+
+void ReadAheadArchiveDelegate::setRange(qint64 startTime, qint64 endTime, qint64 frameStep)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    delegate()->setRange(startTime, endTime, frameStep);
+}
+
+QnAbstractMotionArchiveConnectionPtr ReadAheadArchiveDelegate::getAnalyticsConnection(int channel)
+{
+    return delegate()->getAnalyticsConnection(channel);
+}
+
+void ReadAheadArchiveDelegate::setStreamDataFilter(nx::vms::api::StreamDataFilters filter)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    delegate()->setStreamDataFilter(filter);
+}
+
+void ReadAheadArchiveDelegate::setStorageLocationFilter(nx::vms::api::StorageLocation filter)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    delegate()->setStorageLocationFilter(filter);
+}
+
+void ReadAheadArchiveDelegate::setMotionRegion(const QnMotionRegion& region)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    delegate()->setMotionRegion(region);
+}
+
+void ReadAheadArchiveDelegate::setPlaybackMode(PlaybackMode value)
+{
+    NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+    delegate()->setPlaybackMode(value);
+}
+
+int ReadAheadArchiveDelegate::protocol() const
+{
+    return delegate()->protocol();
+}
+
+CameraDiagnostics::Result ReadAheadArchiveDelegate::lastError() const
+{
+    return delegate()->lastError();
+}
+
+void ReadAheadArchiveDelegate::pleaseStop()
+{
+    delegate()->pleaseStop();
+}
+
+bool ReadAheadArchiveDelegate::providesMotionPackets() const
+{
+    return delegate()->providesMotionPackets();
+}
+
+std::optional<QnAviArchiveMetadata> ReadAheadArchiveDelegate::metadata() const
+{
+    return delegate()->metadata();
+}
+
+qint64 ReadAheadArchiveDelegate::bufferedBytes() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_aheadBytes;
+}
+
+std::vector<qint64> ReadAheadArchiveDelegate::keyFrames() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    std::vector<qint64> result;
+    for (const auto& [timestamp, sequence]: m_keyFrames)
+        result.push_back(timestamp);
+    return result;
+}
+
+void ReadAheadArchiveDelegate::run()
+{
+    for (;;)
+    {
+        {
+            NX_MUTEX_LOCKER lock(&m_mutex);
+            m_condition.waitFor(&m_mutex, std::chrono::milliseconds::max(),
+                [this]() { return m_needToStop || (isActive() && !m_isEof && !isBufferFull()); });
+            if (m_needToStop)
+                return;
+        }
+
+        // The buffer is cleared only with m_delegateMutex locked, so the packet read here is
+        // always the continuation of the buffered ones.
+        NX_MUTEX_LOCKER delegateLock(&m_delegateMutex);
+        {
+            NX_MUTEX_LOCKER lock(&m_mutex);
+            if (m_needToStop)
+                return;
+            if (!isActive() || m_isEof || isBufferFull())
+                continue;
+        }
+
+        auto packet = delegate()->getNextData();
+
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        if (packet)
+            append(std::move(packet));
+        else
+            m_isEof = true;
+        m_condition.wakeAll();
+    }
+}
+
+bool ReadAheadArchiveDelegate::isActive() const
+{
+    return m_isOpened && !m_isReverse && !m_needToStop;
+}
+
+bool ReadAheadArchiveDelegate::isBufferFull() const
+{
+    return m_aheadBytes >= m_budget.bytes
+        || (m_readPosition < m_packets.size()
+            && packetTime(m_packets.size() - 1) - packetTime(m_readPosition)
+                >= m_budget.duration.count());
+}
+
+void ReadAheadArchiveDelegate::append(QnAbstractMediaDataPtr packet)
+{
+    if (packet->dataType == QnAbstractMediaData::VIDEO
+        && packet->channelNumber == 0
+        && packet->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey)
+        && packet->timestamp != AV_NOPTS_VALUE)
+    {
+        m_keyFrames[packet->timestamp] = m_firstSequence + (qint64) m_packets.size();
+    }
+
+    m_aheadBytes += packet->dataSize();
+    const auto flags = packet->flags;
+    m_packets.push_back(Packet{std::move(packet), flags});
+}
+
+QnAbstractMediaDataPtr ReadAheadArchiveDelegate::takeNext()
+{
+    Packet& packet = m_packets[m_readPosition++];
+    m_aheadBytes -= packet.data->dataSize();
+    m_historyBytes += packet.data->dataSize();
+
+    QnAbstractMediaDataPtr result = packet.data;
+    if (packet.isReturned)
+    {
+        // The packet returned before a seek inside of the buffer may still be processed by the
+        // consumers of the reader.
+        result.reset(packet.data->clone());
+        result->flags = packet.flags;
+    }
+    packet.isReturned = true;
+
+    trimHistory();
+    m_condition.wakeAll();
+    return result;
+}
+
+bool ReadAheadArchiveDelegate::seekInBuffer(qint64 time)
+{
+    // The key frames of the other channels are not indexed.
+    if (!isActive() || m_channelCount != 1 || m_packets.empty())
+        return false;
+
+    // The later key frame could be not read yet.
+    if (time > packetTime(m_packets.size() - 1))
+        return false;
+
+    auto keyFrame = m_keyFrames.upper_bound(time);
+    if (keyFrame == m_keyFrames.begin())
+        return false;
+    --keyFrame;
+
+    m_readPosition = (size_t) (keyFrame->second - m_firstSequence);
+    m_aheadBytes = 0;
+    m_historyBytes = 0;
+    for (size_t i = 0; i < m_packets.size(); ++i)
+        (i < m_readPosition ? m_historyBytes : m_aheadBytes) += m_packets[i].data->dataSize();
+    m_condition.wakeAll();
+    return true;
+}
+
+void ReadAheadArchiveDelegate::trimHistory()
+{
+    bool isTrimmed = false;
+    while (m_readPosition > 0
+        && (m_historyBytes > m_budget.bytes
+            || packetTime(m_readPosition - 1) - packetTime(0) > m_budget.duration.count()))
+    {
+        m_historyBytes -= m_packets.front().data->dataSize();
+        m_packets.pop_front();
+        ++m_firstSequence;
+        --m_readPosition;
+        isTrimmed = true;
+    }
+
+    if (isTrimmed)
+    {
+        std::erase_if(m_keyFrames,
+            [this](const auto& item) { return item.second < m_firstSequence; });
+    }
+}
+
+void ReadAheadArchiveDelegate::clearBuffer()
+{
+    m_firstSequence += (qint64) m_packets.size();
+    m_packets.clear();
+    m_keyFrames.clear();
+    m_readPosition = 0;
+    m_aheadBytes = 0;
+    m_historyBytes = 0;
+    m_isEof = false;
+    m_condition.wakeAll();
+}
+
+qint64 ReadAheadArchiveDelegate::packetTime(size_t index) const
+{
+    const qint64 timestamp = m_packets[index].data->timestamp;
+    return timestamp == AV_NOPTS_VALUE ? 0 : timestamp;
+}
+
+} // namespace nx::streaming
@@ -0,0 +1,134 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <nx/media/media_data_packet.h>
+#include <nx/streaming/archive_delegate_wrapper.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::streaming {
+
+/**
+ * Reads the packets of the wrapped delegate ahead of QnArchiveStreamReader in its own thread, so
+ * the reader does not wait for the storage.
+ *
+ * The packets are kept in a contiguous span of the stream: the read ones are kept within the same
+ * budget as the read-ahead ones, and the key frames of the span are indexed. A key frame seek to a
+ * position inside the span, which is what the timeline scrubbing and the reverse playback do,
+ * moves the read position to the start of the GOP in the buffer instead of seeking the wrapped
+ * delegate.
+ *
+ * All calls of the wrapped delegate are serialized with the reading thread, so the wrapped
+ * delegate must not block in getNextData() for long: it is intended for the file delegates.
+ */
+class NX_VMS_COMMON_API ReadAheadArchiveDelegate:
+    public nx::vms::server::plugins::ArchiveDelegateWrapper
+{
+    using base_type = nx::vms::server::plugins::ArchiveDelegateWrapper;
+
+public:
+    struct Budget
+    {
+        /** Maximum size of the packets buffered ahead of the reader, and behind it. */
+        qint64 bytes = 16 * 1024 * 1024;
+
+        /** Maximum duration of the packets buffered ahead of the reader, and behind it. */
+        std::chrono::microseconds duration = std::chrono::seconds(5);
+    };
+
+    /** The budget of nx_streaming.ini, if read-ahead is enabled there. */
+    static std::optional<Budget> budgetFromIni();
+
+    ReadAheadArchiveDelegate(
+        std::unique_ptr<QnAbstractArchiveDelegate> delegate, Budget budget = Budget());
+    virtual ~ReadAheadArchiveDelegate() override;
+
+    virtual bool open(
+        const QnResourcePtr& resource,
+        AbstractArchiveIntegrityWatcher* archiveIntegrityWatcher = nullptr) override;
+    virtual void close() override;
+    virtual bool reopen() override;
+    virtual QnAbstractMediaDataPtr getNextData() override;
+    virtual qint64 seek(qint64 time, bool findIFrame) override;
+    virtual QnConstResourceVideoLayoutPtr getVideoLayout() override;
+    virtual AudioLayoutConstPtr getAudioLayout() override;
+    virtual bool setAudioChannel(unsigned num) override;
+    virtual void setSpeed(qint64 displayTime, double value) override;
+    virtual void setSingleshotMode(bool value) override;
+    virtual bool setQuality(
+        MediaQuality quality,
+        bool fastSwitch,
+        const QSize& resolution) override;
+    virtual void setRange(qint64 startTime, qint64 endTime, qint64 frameStep) override;
+    virtual QnAbstractMotionArchiveConnectionPtr getAnalyticsConnection(int channel) override;
+    virtual void setStreamDataFilter(nx::vms::api::StreamDataFilters filter) override;
+    virtual void setStorageLocationFilter(nx::vms::api::StorageLocation filter) override;
+    virtual void setMotionRegion(const QnMotionRegion& region) override;
+    virtual void setPlaybackMode(PlaybackMode value) override;
+    virtual int protocol() const override;
+    virtual CameraDiagnostics::Result lastError() const override;
+    virtual void pleaseStop() override;
+    virtual bool providesMotionPackets() const override;
+    virtual std::optional<QnAviArchiveMetadata> metadata() const override;
+
+    /** Size of the packets read from the wrapped delegate, but not by the reader yet. */
+    qint64 bufferedBytes() const;
+
+    /** Timestamps of the key frames of the buffered span of the stream. */
+    std::vector<qint64> keyFrames() const;
+
+private:
+    struct Packet
+    {
+        QnAbstractMediaDataPtr data;
+        /** The reader modifies the flags of the returned packets. */
+        QnAbstractMediaData::MediaFlags flags;
+        bool isReturned = false;
+    };
+
+    void run();
+    bool isActive() const;
+    bool isBufferFull() const;
+    void append(QnAbstractMediaDataPtr packet);
+    QnAbstractMediaDataPtr takeNext();
+    bool seekInBuffer(qint64 time);
+    void trimHistory();
+    void clearBuffer();
+    qint64 packetTime(size_t index) const;
+
+private:
+    const Budget m_budget;
+
+    /** Serializes the calls of the wrapped delegate, locked before m_mutex. */
+    mutable nx::Mutex m_delegateMutex;
+
+    mutable nx::Mutex m_mutex;
+    nx::WaitCondition m_condition;
+    bool m_isOpened = false;
+    bool m_isReverse = false;
+    bool m_isEof = false;
+    bool m_needToStop = false;
+    int m_channelCount = 1;
+    /** Incremented when the buffer is cleared to drop the packet being read at that moment. */
+    int m_generation = 0;
+
+    std::deque<Packet> m_packets;
+    /** Sequence number of the first packet of m_packets. */
+    qint64 m_firstSequence = 0;
+    size_t m_readPosition = 0;
+    qint64 m_aheadBytes = 0;
+    qint64 m_historyBytes = 0;
+    /** Sequence numbers of the key frames of the first video channel by their timestamps. */
+    std::map<qint64, qint64> m_keyFrames;
+
+    std::thread m_thread;
+};
+
+} // namespace nx::streaming
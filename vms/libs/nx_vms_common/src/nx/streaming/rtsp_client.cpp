@@ -29,6 +29,13 @@ static const int TCP_RECEIVE_TIMEOUT_MS = 1000 * 5;
 static const int TCP_CONNECT_TIMEOUT_MS = 1000 * 5;
 static const int SDP_TRACK_STEP = 2;
 
+/**
+ * With UDP GRO the kernel coalesces the packets of a burst into datagrams of up to 64 KB. So,
+ * fewer but larger buffers are needed.
+ */
+static constexpr std::size_t kReadBatchSize = 16;
+static constexpr std::size_t kReceiveOffloadReadBatchSize = 4;
+
 using namespace std::chrono;
 
 namespace {
@@ -139,7 +146,7 @@ qint64 QnRtspIoDevice::read(char *data, qint64 maxSize)
     if (m_transport == nx::vms::api::RtpTransportType::tcp)
         bytesRead = m_owner->readBinaryResponse((quint8*) data, maxSize); // demux binary data from TCP socket
     else
-        bytesRead = m_udpSockets.mediaSocket->recv(data, maxSize);
+        bytesRead = readDatagram(data, maxSize);
 
     m_owner->sendKeepAliveIfNeeded();
     if (m_transport == nx::vms::api::RtpTransportType::udp)
@@ -147,6 +154,64 @@ qint64 QnRtspIoDevice::read(char *data, qint64 maxSize)
     return bytesRead;
 }
 
+bool QnRtspIoDevice::hasBufferedData() const
+{
+    return m_readBatchPos < m_readBatchCount;
+}
+
+int QnRtspIoDevice::readDatagram(char* data, qint64 maxSize)
+{
+    if (m_readBatchPos == m_readBatchCount)
+    {
+        m_readBatchCount = 0;
+        m_readBatchPos = 0;
+        m_datagramOffset = 0;
+
+        for (auto& datagram: m_readBatch)
+            datagram.data.reserve(m_readBatchDatagramSize);
+
+        // Sets the last error to wouldBlock if there is no data.
+        const int datagramCount = m_udpSockets.mediaSocket->recvMultipleFrom(&m_readBatch);
+        if (datagramCount <= 0)
+            return -1;
+        m_readBatchCount = datagramCount;
+    }
+
+    const auto& datagram = m_readBatch[m_readBatchPos];
+    const auto packetSize = std::min(
+        datagram.segmentSize > 0 ? datagram.segmentSize : datagram.data.size(),
+        datagram.data.size() - m_datagramOffset);
+
+    // A packet larger than the buffer is truncated the same way recv() does.
+    const auto bytesRead = std::min<std::size_t>(packetSize, maxSize);
+    memcpy(data, datagram.data.data() + m_datagramOffset, bytesRead);
+
+    m_datagramOffset += packetSize;
+    if (m_datagramOffset >= datagram.data.size())
+    {
+        ++m_readBatchPos;
+        m_datagramOffset = 0;
+    }
+
+    return (int) bytesRead;
+}
+
+void QnRtspIoDevice::resetReadBatch()
+{
+    // The media socket is read by read() only, so the datagrams coalesced by the kernel are split
+    // there.
+    const bool isReceiveOffloadEnabled = m_udpSockets.mediaSocket->setReceiveOffload(true);
+
+    m_readBatch.clear();
+    m_readBatch.resize(isReceiveOffloadEnabled ? kReceiveOffloadReadBatchSize : kReadBatchSize);
+    m_readBatchDatagramSize = isReceiveOffloadEnabled
+        ? nx::network::kMaxUDPDatagramSize
+        : (std::size_t) MAX_RTP_PACKET_SIZE;
+    m_readBatchCount = 0;
+    m_readBatchPos = 0;
+    m_datagramOffset = 0;
+}
+
 nx::network::AbstractCommunicatingSocket* QnRtspIoDevice::getMediaSocket()
 {
     if (m_transport == nx::vms::api::RtpTransportType::tcp)
@@ -263,6 +328,7 @@ bool QnRtspIoDevice::createMulticastSockets()
     if (!m_udpSockets.mediaSocket || !m_udpSockets.rtcpSocket)
         return false;
 
+    resetReadBatch();
     return true;
 }
 
@@ -272,6 +338,9 @@ bool QnRtspIoDevice::updateSockets()
     {
         m_udpSockets.mediaSocket.reset();
         m_udpSockets.rtcpSocket.reset();
+        m_readBatch.clear();
+        m_readBatchCount = 0;
+        m_readBatchPos = 0;
         if (m_owner->m_tcpSock)
         {
             if (m_owner->tcpRecvBufferSize())
@@ -293,6 +362,7 @@ bool QnRtspIoDevice::updateSockets()
 
         configureUdpSocket(m_udpSockets.mediaSocket, m_owner->tcpRecvBufferSize());
         configureUdpSocket(m_udpSockets.rtcpSocket, m_owner->tcpRecvBufferSize());
+        resetReadBatch();
         return true;
     }
     return true;
@@ -357,7 +427,19 @@ bool QnRtspClient::parseSDP(const QByteArray& response)
         return false;
     }
 
-    m_sdp.parse(QString(response.mid(sdpIndex + 4)));
+    const std::string_view sdp(
+        response.constData() + sdpIndex + 4, (size_t) (response.size() - sdpIndex - 4));
+    const size_t sdpHash = std::hash<std::string_view>()(sdp);
+    if (m_sdpData.empty() || sdpHash != m_sdpHash || sdp != m_sdpData)
+    {
+        m_sdp.parse(sdp);
+        m_sdpData = sdp;
+        m_sdpHash = sdpHash;
+    }
+    else
+    {
+        NX_VERBOSE(this, "SDP is not changed, %1 bytes", sdp.size());
+    }
 
     // At this moment we do not support different transport for streams, so use first.
     if (m_sdp.media.size() > 0 && m_sdp.media[0].connectionAddress.isMulticast())
@@ -422,6 +504,7 @@ CameraDiagnostics::Result QnRtspClient::open(const nx::utils::Url& url, qint64 s
     m_SessionId.clear();
     m_url = url;
     m_responseBufferLen = 0;
+    m_responseBufferConsumed = 0;
     m_isProxyAuthorizationRequired = false;
     if (m_defaultAuthScheme == nx::network::http::header::AuthScheme::basic)
         m_responseAuthenticate = nx::network::http::header::WWWAuthenticate(m_defaultAuthScheme);
@@ -592,9 +675,15 @@ const nx::rtp::Sdp& QnRtspClient::getSdp() const
     return m_sdp;
 }
 
+size_t QnRtspClient::sdpHash() const
+{
+    return m_sdpHash;
+}
+
 void QnRtspClient::setPreferredMap(const nx::rtp::Sdp::RtpMap& map)
 {
     m_sdp.preferredMap = map;
+    m_sdpData.clear(); //< The parsed SDP depends on the preferred map.
 }
 
 void QnRtspClient::fillRequestAuthorizationByResponseAuthenticate(
@@ -1202,6 +1291,7 @@ bool QnRtspClient::readAndProcessTextData()
     // have text response or part of text response.
     if (!m_tcpSock)
         return false;
+    discardConsumedData();
     int bytesRead = readSocketWithBuffering(m_responseBuffer+m_responseBufferLen, qMin(1024, RTSP_BUFFER_LEN - m_responseBufferLen), true);
     if (bytesRead <= 0)
         return false;
@@ -1229,42 +1319,69 @@ bool QnRtspClient::readAndProcessTextData()
     return true;
 }
 
-int QnRtspClient::readBinaryResponse(quint8* data, int maxDataSize)
+void QnRtspClient::discardConsumedData()
+{
+    if (m_responseBufferConsumed == 0)
+        return;
+    m_responseBufferLen -= m_responseBufferConsumed;
+    memmove(m_responseBuffer, m_responseBuffer + m_responseBufferConsumed, m_responseBufferLen);
+    m_responseBufferConsumed = 0;
+}
+
+int QnRtspClient::readInterleavedPacket(InterleavedPacket* packet)
 {
     if (!m_tcpSock)
         return 0;
     while (m_tcpSock->isConnected())
     {
-        while (m_responseBufferLen < 4) {
-            int bytesRead = readSocketWithBuffering(m_responseBuffer+m_responseBufferLen, 4 - m_responseBufferLen, true);
-            if (bytesRead <= 0)
-                return bytesRead;
-            m_responseBufferLen += bytesRead;
+        quint8* const data = m_responseBuffer + m_responseBufferConsumed;
+        const int available = m_responseBufferLen - m_responseBufferConsumed;
+        if (available >= 4 && data[0] == '$')
+        {
+            const int dataLen = (data[2] << 8) + data[3] + 4;
+            if (dataLen <= available)
+            {
+                packet->channel = data[1];
+                packet->data = data;
+                packet->size = dataLen;
+                m_responseBufferConsumed += dataLen;
+                return dataLen;
+            }
         }
-        if (m_responseBuffer[0] == '$')
-            break;
 
-        // have text response or part of text response.
-        if (!readAndProcessTextData())
-            return -1;
+        // The rest is moved to the buffer start once per batch instead of once per packet.
+        discardConsumedData();
+        if (m_responseBufferLen > 0 && m_responseBuffer[0] != '$')
+        {
+            // Have text response or part of text response.
+            if (!readAndProcessTextData())
+                return -1;
+            continue;
+        }
+
+        // Any interleaved packet fits the buffer, so there is some space after a partial one.
+        const int bytesRead = readSocketWithBuffering(
+            m_responseBuffer + m_responseBufferLen, RTSP_BUFFER_LEN - m_responseBufferLen,
+            /*readSome*/ true);
+        if (bytesRead <= 0)
+            return bytesRead;
+        m_responseBufferLen += bytesRead;
     }
-    int dataLen = (m_responseBuffer[2]<<8) + m_responseBuffer[3] + 4;
+    return 0;
+}
+
+int QnRtspClient::readBinaryResponse(quint8* data, int maxDataSize)
+{
+    InterleavedPacket packet;
+    const int dataLen = readInterleavedPacket(&packet);
+    if (dataLen <= 0)
+        return dataLen;
     if (maxDataSize < dataLen)
-        return -2; // not enough buffer
-    int copyLen = qMin(dataLen, m_responseBufferLen);
-    memcpy(data, m_responseBuffer, copyLen);
-    if (m_responseBufferLen > copyLen)
-        memmove(m_responseBuffer, m_responseBuffer + copyLen, m_responseBufferLen - copyLen);
-    data += copyLen;
-    m_responseBufferLen -= copyLen;
-    for (int dataRestLen = dataLen - copyLen; dataRestLen > 0;)
     {
-        int bytesRead = readSocketWithBuffering(data, dataRestLen, true);
-        if (bytesRead <= 0)
-            return bytesRead;
-        dataRestLen -= bytesRead;
-        data += bytesRead;
+        m_responseBufferConsumed -= dataLen;
+        return -2; // not enough buffer
     }
+    memcpy(data, packet.data, dataLen);
     return dataLen;
 }
 
@@ -1282,42 +1399,14 @@ quint8* QnRtspClient::prepareDemuxedData(std::vector<nx::utils::ByteArray*>& dem
 
 int QnRtspClient::readBinaryResponse(std::vector<nx::utils::ByteArray*>& demuxedData, int& channelNumber)
 {
-    if (!m_tcpSock)
-        return 0;
-    while (m_tcpSock->isConnected())
-    {
-        while (m_responseBufferLen < 4) {
-            int bytesRead = readSocketWithBuffering(m_responseBuffer+m_responseBufferLen, 4 - m_responseBufferLen, true);
-            if (bytesRead <= 0)
-                return bytesRead;
-            m_responseBufferLen += bytesRead;
-        }
-        if (m_responseBuffer[0] == '$')
-            break;
-        if (!readAndProcessTextData())
-            return -1;
-    }
+    InterleavedPacket packet;
+    const int dataLen = readInterleavedPacket(&packet);
+    if (dataLen <= 0)
+        return dataLen;
 
-    int dataLen = (m_responseBuffer[2]<<8) + m_responseBuffer[3] + 4;
-    int copyLen = qMin(dataLen, m_responseBufferLen);
-    channelNumber = m_responseBuffer[1];
+    channelNumber = packet.channel;
     quint8* data = prepareDemuxedData(demuxedData, channelNumber, dataLen);
-
-    memcpy(data, m_responseBuffer, copyLen);
-    if (m_responseBufferLen > copyLen)
-        memmove(m_responseBuffer, m_responseBuffer + copyLen, m_responseBufferLen - copyLen);
-    data += copyLen;
-    m_responseBufferLen -= copyLen;
-
-    for (int dataRestLen = dataLen - copyLen; dataRestLen > 0;)
-    {
-        int bytesRead = readSocketWithBuffering(data, dataRestLen, true);
-        if (bytesRead <= 0)
-            return bytesRead;
-        dataRestLen -= bytesRead;
-        data += bytesRead;
-    }
-
+    memcpy(data, packet.data, dataLen);
     demuxedData[channelNumber]->finishWriting(dataLen);
     return dataLen;
 }
@@ -1348,6 +1437,7 @@ bool QnRtspClient::readTextResponse(QByteArray& response)
 {
     if (!m_tcpSock)
         return false;
+    discardConsumedData();
     int ignoreDataSize = 0;
     bool needMoreData = m_responseBufferLen == 0;
     for (int i = 0; i < 1000 && ignoreDataSize < 1024*1024*3 && m_tcpSock->isConnected(); ++i)
@@ -1372,8 +1462,8 @@ bool QnRtspClient::readTextResponse(QByteArray& response)
         }
         if (m_responseBuffer[0] == '$') {
             // binary data
-            quint8 tmpData[RTSP_BUFFER_LEN];
-            int bytesRead = readBinaryResponse(tmpData, sizeof(tmpData)); // skip binary data
+            InterleavedPacket packet;
+            int bytesRead = readInterleavedPacket(&packet); // skip binary data
             if (bytesRead < 0)
             {
                 NX_DEBUG(this, "Failed to read data from socket: %1",
@@ -1381,12 +1471,12 @@ bool QnRtspClient::readTextResponse(QByteArray& response)
                 return false;
             }
 
-            int rtpChannelNum = tmpData[1];
-            if (isRtcp(rtpChannelNum))
+            if (bytesRead > 0 && isRtcp(packet.channel))
             {
-                if (!processTcpRtcpData(tmpData, bytesRead))
+                if (!processTcpRtcpData(packet.data, bytesRead))
                     NX_VERBOSE(this, "Can't parse RTCP report while reading text response");
             }
+            discardConsumedData();
 
             int oldIgnoreDataSize = ignoreDataSize;
             ignoreDataSize += bytesRead;
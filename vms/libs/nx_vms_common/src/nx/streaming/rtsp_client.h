@@ -5,6 +5,7 @@
 #include <chrono>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include <QtNetwork/QAuthenticator>
@@ -54,6 +55,12 @@ public:
 
     virtual ~QnRtspIoDevice();
     virtual qint64 read(char * data, qint64 maxSize );
+
+    /**
+     * @return Whether there are RTP packets that have been read from the UDP socket in a batch
+     * and not returned by read() yet. The socket is not reported as readable for them.
+     */
+    bool hasBufferedData() const;
     const nx::rtp::RtcpSenderReport& getSenderReport() { return m_senderReport; }
     void setSenderReport(const nx::rtp::RtcpSenderReport& value) { m_senderReport = value; }
     nx::network::AbstractCommunicatingSocket* getMediaSocket();
@@ -76,6 +83,8 @@ public:
 private:
     AddressInfo addressInfo(int port) const;
     void processRtcpData();
+    int readDatagram(char* data, qint64 maxSize);
+    void resetReadBatch();
     bool updateSockets();
     std::unique_ptr<nx::network::AbstractDatagramSocket> createMulticastSocket(int port);
     bool createMulticastSockets();
@@ -85,6 +94,12 @@ private:
     nx::vms::api::RtpTransportType m_transport = nx::vms::api::RtpTransportType::automatic;
 
     nx::streaming::rtsp::UdpSocketPair m_udpSockets;
+    std::vector<nx::network::Datagram> m_readBatch;
+    std::size_t m_readBatchDatagramSize = 0;
+    std::size_t m_readBatchCount = 0;
+    std::size_t m_readBatchPos = 0;
+    /** Position of the next packet in the datagram coalesced by the kernel. */
+    std::size_t m_datagramOffset = 0;
     nx::rtp::RtcpSenderReport m_senderReport;
 
     quint16 m_remoteMediaPort = 0;
@@ -205,6 +220,12 @@ public:
 
     const nx::rtp::Sdp& getSdp() const;
 
+    /**
+     * @return Hash of the last received SDP. The SDP is parsed again only if its body differs from
+     * the previous one, so the reopened sessions of the same resource reuse the parsed data.
+     */
+    size_t sdpHash() const;
+
     void sendKeepAliveIfNeeded();
 
     void setTransport(nx::vms::api::RtpTransportType transport);
@@ -273,6 +294,23 @@ public:
     void setMediaTypeEnabled(nx::rtp::Sdp::MediaType mediaType, bool enabled);
     bool isMediaTypeEnabled(nx::rtp::Sdp::MediaType mediaType) const;
 
+    struct InterleavedPacket
+    {
+        int channel = -1;
+        /** The packet with the 4-byte interleaved header. */
+        quint8* data = nullptr;
+        int size = 0;
+    };
+
+    /**
+     * Returns the next interleaved packet as a slice of the internal buffer. The slice is valid
+     * until the next read from the connection. The socket is read only when the buffer has no
+     * complete packet, and then as much as the socket has is read at once, so a single recv()
+     * brings a batch of packets which are returned without copying and further system calls.
+     * @return Packet size, 0 if the connection is closed, or a negative value on error.
+     */
+    int readInterleavedPacket(InterleavedPacket* packet);
+
     /*
     * Demux RTSP binary data
     * @param data Buffer to write demuxed data. 4 byte RTSP header keep in buffer
@@ -350,6 +388,8 @@ private:
     QString parseContentBase(const QString& buffer);
     void setTcpSocket(std::unique_ptr<nx::network::AbstractStreamSocket> socket);
     CameraDiagnostics::Result parseErrorResponse(const nx::network::rtsp::RtspResponse& response);
+    /** Removes the packets returned by readInterleavedPacket() from the buffer start. */
+    void discardConsumedData();
 
 private:
     enum { RTSP_BUFFER_LEN = 1024 * 65 };
@@ -374,7 +414,12 @@ private:
 
     quint8* m_responseBuffer;
     int m_responseBufferLen;
+    /** Size of the already returned interleaved packets at the buffer start. */
+    int m_responseBufferConsumed = 0;
     nx::rtp::Sdp m_sdp;
+    /** Body and hash of the SDP m_sdp has been parsed from. */
+    std::string m_sdpData;
+    size_t m_sdpHash = 0;
 
     std::unique_ptr<nx::network::AbstractStreamSocket> m_tcpSock;
     std::unique_ptr<nx::network::AbstractStreamSocket> m_proxySocket;
@@ -440,8 +440,13 @@ bool QnRtspClientArchiveDelegate::openInternal()
     {
         m_sessionTimeout.restart();
 
-        QStringList audioSDP = m_rtspSession->getSdpByType(nx::rtp::Sdp::MediaType::Audio);
-        parseAudioSDP(audioSDP);
+        // The seeks and reconnects to the same server receive the same SDP, and the audio layout
+        // parsed from it is kept.
+        if (m_audioSdpHash != m_rtspSession->sdpHash())
+        {
+            m_audioSdpHash = m_rtspSession->sdpHash();
+            parseAudioSDP(m_rtspSession->getSdpByType(nx::rtp::Sdp::MediaType::Audio));
+        }
 
         QString vLayout = m_rtspSession->getVideoLayout();
         if (!vLayout.isEmpty())
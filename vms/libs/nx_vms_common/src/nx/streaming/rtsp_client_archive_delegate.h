@@ -3,6 +3,7 @@
 #pragma once
 
 #include <atomic>
+#include <optional>
 
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QPointer>
@@ -194,6 +195,8 @@ private:
 
     qint64 m_forcedEndTime = DATETIME_INVALID;
     AudioLayoutPtr m_audioLayout;
+    /** QnRtspClient::sdpHash() of the SDP m_audioLayout has been parsed from. */
+    std::optional<size_t> m_audioSdpHash;
 
     /** Fast open mode without DESCRIBE. */
     bool m_playNowModeAllowed = true;
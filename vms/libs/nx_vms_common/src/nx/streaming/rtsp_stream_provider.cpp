@@ -4,6 +4,7 @@
 
 #include <set>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QSettings>
 
 #include <common/common_module.h>
@@ -27,8 +28,10 @@
 #include <nx/rtp/rtp.h>
 #include <nx/streaming/rtp/parsers/nx_rtp_metadata_parser.h>
 #include <nx/streaming/rtp/parsers/nx_rtp_parser.h>
+#include <nx/streaming/stream_restart_scheduler.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/scope_guard.h>
+#include <nx/utils/trace/trace.h>
 #include <nx/vms/api/types/rtp_types.h>
 #include <nx/vms/common/system_context.h>
 #include <nx/vms/common/system_settings.h>
@@ -208,6 +211,8 @@ QnAbstractMediaDataPtr RtspStreamProvider::getNextData()
     if (result)
     {
         NX_VERBOSE(this, "%1: Got some stream data, dataType: %2", m_logName, result->dataType);
+        NX_TRACE_CATEGORY_INSTANT("frame", "ingest").args({
+            {"camera", m_logName}, {"timestamp", result->timestamp}});
 
         m_gotSomeFrame = true;
         return result;
@@ -408,6 +413,14 @@ bool RtspStreamProvider::processData(
     return true;
 }
 
+bool RtspStreamProvider::retainsPacketBuffer(const TrackInfo& track)
+{
+    return std::any_of(
+        track.rtpParsers.begin(),
+        track.rtpParsers.end(),
+        [](const auto& item) { return item.second && item.second->retainsPacketBuffer(); });
+}
+
 bool RtspStreamProvider::isCodecSupportedByCustomParserFactories(const QString& codecName) const
 {
     return std::any_of(
@@ -459,7 +472,9 @@ QnAbstractMediaDataPtr RtspStreamProvider::getNextDataTCP()
             m_rtcpReportTimer.restart();
         }
 
-        int bytesRead = m_RtpSession.readBinaryResponse(m_demuxedData, rtpChannelNum);
+        QnRtspClient::InterleavedPacket packet;
+        int bytesRead = m_RtpSession.readInterleavedPacket(&packet);
+        rtpChannelNum = packet.channel;
         if (bytesRead < 0 && !nx::network::socketCannotRecoverFromError(SystemError::getLastOSErrorCode()))
         {
             bool isTimeout = SystemError::getLastOSErrorCode() == SystemError::timedOut ||
@@ -475,30 +490,40 @@ QnAbstractMediaDataPtr RtspStreamProvider::getNextDataTCP()
             continue;
         }
 
+        if (bytesRead < 1)
+            break; // error
+
         auto trackIndexIter = m_trackIndices.find(rtpChannelNum);
         if (trackIndexIter == m_trackIndices.end() && m_RtpSession.isPlayNowMode())
         {
             registerPredefinedTrack(rtpChannelNum);
             trackIndexIter = m_trackIndices.find(rtpChannelNum);
         }
-
-        if (bytesRead < 1)
-        {
-            const bool isInvalidTrack = trackIndexIter == m_trackIndices.end();
-            const bool isBufferAllocated = (int) m_demuxedData.size() > rtpChannelNum
-                && rtpChannelNum >= 0
-                && m_demuxedData[rtpChannelNum];
-
-            if (isInvalidTrack && isBufferAllocated)
-                m_demuxedData[rtpChannelNum]->clear();
-            break; // error
-        }
         NX_VERBOSE(this, "Got %1 bytes, trackFound=%2", bytesRead, trackIndexIter != m_trackIndices.end());
 
         if (trackIndexIter != m_trackIndices.end())
         {
             auto& track = m_tracks[trackIndexIter->second];
 
+            // The packet stays in the receive buffer of the RTSP client if no parser of the track
+            // references it after processing, otherwise it is accumulated in the channel buffer.
+            const int length = bytesRead - kInterleavedRtpOverTcpPrefixLength;
+            if (!retainsPacketBuffer(track))
+            {
+                QnRtspClient::prepareDemuxedData(m_demuxedData, rtpChannelNum, 0);
+                if (!processData(track, packet.data, kInterleavedRtpOverTcpPrefixLength, length,
+                    rtpChannelNum, errorRetryCnt))
+                {
+                    return QnAbstractMediaDataPtr(0);
+                }
+                continue;
+            }
+
+            quint8* channelData =
+                QnRtspClient::prepareDemuxedData(m_demuxedData, rtpChannelNum, bytesRead);
+            memcpy(channelData, packet.data, bytesRead);
+            m_demuxedData[rtpChannelNum]->finishWriting(bytesRead);
+
             if (m_demuxedData[rtpChannelNum]->size() > MAX_ALLOWED_FRAME_SIZE)
             {
                 for (auto& [_, parser]: track.rtpParsers)
@@ -511,17 +536,17 @@ QnAbstractMediaDataPtr RtspStreamProvider::getNextDataTCP()
 
             const int rtpBufferOffset = m_demuxedData[rtpChannelNum]->size() - bytesRead;
             const int offset = rtpBufferOffset + kInterleavedRtpOverTcpPrefixLength;
-            const int length = bytesRead - kInterleavedRtpOverTcpPrefixLength;
             uint8_t* rtpPacketData = (uint8_t*)m_demuxedData[rtpChannelNum]->data();
             if (!processData(track, rtpPacketData, offset, length, rtpChannelNum, errorRetryCnt))
                 return QnAbstractMediaDataPtr(0);
         }
         else if (m_RtpSession.isRtcp(rtpChannelNum))
         {
-            processTcpRtcp((quint8*) m_demuxedData[rtpChannelNum]->data(), bytesRead, m_demuxedData[rtpChannelNum]->capacity());
-            m_demuxedData[rtpChannelNum]->clear();
-        }
-        else {
+            // The response is built in place of the report, so it needs a buffer of its own.
+            quint8* rtcpData = QnRtspClient::prepareDemuxedData(
+                m_demuxedData, rtpChannelNum, std::max(bytesRead, MAX_RTCP_PACKET_SIZE));
+            memcpy(rtcpData, packet.data, bytesRead);
+            processTcpRtcp(rtcpData, bytesRead, m_demuxedData[rtpChannelNum]->capacity());
             m_demuxedData[rtpChannelNum]->clear();
         }
     }
@@ -549,6 +574,7 @@ QnAbstractMediaDataPtr RtspStreamProvider::getNextDataUDP()
         int nfds = 0;
         std::vector<int> fdToRtpIndex(m_tracks.size());
         fdToRtpIndex.clear();
+        bool hasBufferedData = false;
 
         for (size_t i = 0; i < m_tracks.size(); ++i)
         {
@@ -563,17 +589,23 @@ QnAbstractMediaDataPtr RtspStreamProvider::getNextDataUDP()
                 mediaSockPollArray[nfds].fd = track.ioDevice->getMediaSocket()->handle();
                 mediaSockPollArray[nfds++].events = POLLIN;
                 fdToRtpIndex.push_back(i);
+                hasBufferedData |= track.ioDevice->hasBufferedData();
             }
         }
         mediaSockPollArray[nfds].fd = m_tcpSocket->handle();
         mediaSockPollArray[nfds++].events = POLLIN;
 
-        const int rez = poll( mediaSockPollArray, nfds, MEDIA_DATA_READ_TIMEOUT_MS );
-        if (rez < 1)
+        // The datagrams read in a batch by the previous read are not reported by poll().
+        const int rez = poll(
+            mediaSockPollArray, nfds, hasBufferedData ? 0 : MEDIA_DATA_READ_TIMEOUT_MS);
+        if (rez < 1 && !hasBufferedData)
             continue;
         for( int i = 0; i < nfds; ++i )
         {
-            if (!(mediaSockPollArray[i].revents & POLLIN ))
+            const bool isTrackSocket = i < (int) fdToRtpIndex.size();
+            const bool isReadable = (rez > 0 && (mediaSockPollArray[i].revents & POLLIN))
+                || (isTrackSocket && m_tracks[fdToRtpIndex[i]].ioDevice->hasBufferedData());
+            if (!isReadable)
                 continue;
             if (mediaSockPollArray[i].fd == m_tcpSocket->handle())
             {
@@ -1127,6 +1159,74 @@ void RtspResourceStreamProvider::updateTimePolicy()
     }
 }
 
+void RtspResourceStreamProvider::pleaseStop()
+{
+    base_type::pleaseStop();
+
+    NX_MUTEX_LOCKER lock(&m_liveParamsMutex);
+    m_restartCondition.wakeAll();
+}
+
+bool RtspResourceStreamProvider::setLiveStreamParams(const QnLiveStreamParams& params)
+{
+    NX_MUTEX_LOCKER lock(&m_liveParamsMutex);
+    const auto diff = m_liveParams.diff(params);
+    if (diff.isEmpty())
+    {
+        NX_VERBOSE(this, "%1: Live stream params %2 have no effective changes",
+            m_logName, params);
+        return false;
+    }
+
+    m_liveParams = params;
+    if (!diff.requiresRestart() && isStreamOpened() && applyLiveStreamParams(params, diff))
+    {
+        NX_DEBUG(this, "%1: Live stream params %2 are applied without restart, changed: %3",
+            m_logName, params, diff);
+        return false;
+    }
+
+    // The slot reserved earlier, if not used yet, is kept: the stream is reopened once anyway.
+    if (!m_restartTime)
+        m_restartTime = StreamRestartScheduler::instance().reserve();
+
+    NX_DEBUG(this, "%1: Live stream params %2 require restart in %3, changed: %4",
+        m_logName, params,
+        std::chrono::ceil<std::chrono::milliseconds>(
+            *m_restartTime - std::chrono::steady_clock::now()),
+        diff);
+    return true;
+}
+
+QnLiveStreamParams RtspResourceStreamProvider::liveStreamParams() const
+{
+    NX_MUTEX_LOCKER lock(&m_liveParamsMutex);
+    return m_liveParams;
+}
+
+bool RtspResourceStreamProvider::applyLiveStreamParams(
+    const QnLiveStreamParams& /*params*/, const QnLiveStreamParamsDiff& /*diff*/)
+{
+    return false;
+}
+
+bool RtspResourceStreamProvider::waitForRestartSlot()
+{
+    NX_MUTEX_LOCKER lock(&m_liveParamsMutex);
+    while (m_restartTime && !m_pleaseStop)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= *m_restartTime)
+            break;
+
+        m_restartCondition.wait(&m_liveParamsMutex,
+            std::chrono::ceil<std::chrono::milliseconds>(*m_restartTime - now));
+    }
+
+    m_restartTime.reset();
+    return !m_pleaseStop;
+}
+
 nx::vms::api::RtpTransportType RtspResourceStreamProvider::getRtpTransport() const
 {
     // Client defined settings for resource.
@@ -1147,6 +1247,9 @@ nx::vms::api::RtpTransportType RtspResourceStreamProvider::getRtpTransport() con
 
 CameraDiagnostics::Result RtspResourceStreamProvider::openStream()
 {
+    if (!waitForRestartSlot())
+        return CameraDiagnostics::Result(CameraDiagnostics::ErrorCode::serverTerminated);
+
     setUrl(m_resource->getUrl());
 
     // Set credentials from resource only if not already forced.
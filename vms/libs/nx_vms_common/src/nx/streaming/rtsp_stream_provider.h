@@ -19,6 +19,7 @@
 #include <nx/utils/log/format.h>
 #include <nx/utils/safe_direct_connection.h>
 #include <nx/utils/thread/stoppable.h>
+#include <nx/utils/thread/wait_condition.h>
 #include <nx/vms/common/system_settings.h>
 #include <nx/vms/event/event_fwd.h>
 #include <utils/camera/camera_diagnostics.h>
@@ -199,6 +200,7 @@ private:
     bool isFormatSupported(const nx::rtp::Sdp::Media media) const;
     bool processData(
         TrackInfo& track, uint8_t* buffer, int offset, int size, int channel, int& errorCount);
+    static bool retainsPacketBuffer(const TrackInfo& track);
 
     // Returns true if any of custom track factories support this codec
     bool isCodecSupportedByCustomParserFactories(const QString& codecName) const;
@@ -271,9 +273,32 @@ public:
 
     virtual CameraDiagnostics::Result openStream() override;
     virtual nx::vms::api::RtpTransportType getRtpTransport() const override;
+    virtual void pleaseStop() override;
+
+    /**
+     * Sets the parameters the live stream is requested with. Only the effective changes are
+     * applied: the ones the encoder would not tell apart are ignored. The fps, bitrate and
+     * quality are tried to be changed in the running stream via applyLiveStreamParams(). If that
+     * is not supported, or the resolution or the codec is changed, the stream has to be reopened
+     * by the owner, and the next openStream() waits for the slot reserved in
+     * StreamRestartScheduler, so the restarts of many cameras are staggered.
+     * @return Whether the stream has to be reopened for the parameters to take effect.
+     */
+    bool setLiveStreamParams(const QnLiveStreamParams& params);
+
+    QnLiveStreamParams liveStreamParams() const;
 
 protected:
     QnVirtualCameraResourcePtr resource() const { return m_resource; }
+
+    /**
+     * Changes the parameters of the opened stream without reopening it, e.g. via the camera API.
+     * Called only for the changes not requiring the restart. Not supported by default.
+     * @return Whether the parameters have been applied.
+     */
+    virtual bool applyLiveStreamParams(
+        const QnLiveStreamParams& params, const QnLiveStreamParamsDiff& diff);
+
     void updateTimePolicy();
     virtual int numberOfVideoChannels() const override;
     virtual void at_numberOfVideoChannelsChanged() override;
@@ -287,8 +312,15 @@ private:
     CameraDiagnostics::Result registerAddressIfNeeded(
         const QnRtspIoDevice::AddressInfo& addressInfo);
 
+    bool waitForRestartSlot();
+
 private:
     QnVirtualCameraResourcePtr m_resource;
+
+    mutable nx::Mutex m_liveParamsMutex;
+    nx::WaitCondition m_restartCondition;
+    QnLiveStreamParams m_liveParams;
+    std::optional<std::chrono::steady_clock::time_point> m_restartTime;
 };
 
 } // namespace nx::streaming
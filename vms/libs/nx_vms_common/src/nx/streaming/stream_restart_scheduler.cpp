@@ -0,0 +1,24 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "stream_restart_scheduler.h"
+
+#include <algorithm>
+
+namespace nx::streaming {
+
+StreamRestartScheduler& StreamRestartScheduler::instance()
+{
+    static StreamRestartScheduler scheduler;
+    return scheduler;
+}
+
+StreamRestartScheduler::Clock::time_point StreamRestartScheduler::reserve(Clock::time_point now)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_lastSlot = m_lastSlot == Clock::time_point()
+        ? now
+        : std::max(now, m_lastSlot + m_interval);
+    return m_lastSlot;
+}
+
+} // namespace nx::streaming
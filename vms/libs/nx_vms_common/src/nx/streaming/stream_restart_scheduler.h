@@ -0,0 +1,41 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::streaming {
+
+/**
+ * Spreads the stream restarts in time. When the parameters of many cameras are changed at once,
+ * e.g. by a schedule or a bulk edit, reopening all the streams at once makes a burst of
+ * connections and of key frame requests, and a visible gap in all the recordings at once. Each
+ * restart reserves a slot here instead, not earlier than the interval after the previous one.
+ */
+class NX_VMS_COMMON_API StreamRestartScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds kDefaultInterval{50};
+
+    explicit StreamRestartScheduler(std::chrono::milliseconds interval = kDefaultInterval):
+        m_interval(interval)
+    {
+    }
+
+    /** The scheduler shared by all the stream providers of the process. */
+    static StreamRestartScheduler& instance();
+
+    /** @return Time the restart may be performed at, not earlier than now. */
+    Clock::time_point reserve(Clock::time_point now = Clock::now());
+
+private:
+    const std::chrono::milliseconds m_interval;
+    nx::Mutex m_mutex;
+    Clock::time_point m_lastSlot;
+};
+
+} // namespace nx::streaming
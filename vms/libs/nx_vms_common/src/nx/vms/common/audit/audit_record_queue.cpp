@@ -0,0 +1,242 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "audit_record_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <concurrentqueue.h>
+
+#include <nx/utils/log/log.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::vms::common {
+
+using nx::vms::api::AuditRecord;
+
+struct AuditRecordQueue::Private
+{
+    Writer writer;
+    const Settings settings;
+
+    moodycamel::ConcurrentQueue<AuditRecord> queue;
+    std::atomic<int> backlog = 0;
+
+    std::atomic<int64_t> written = 0;
+    std::atomic<int64_t> writtenThrough = 0;
+    std::atomic<int64_t> dropped = 0;
+    std::atomic<int64_t> batches = 0;
+    std::atomic<int64_t> failedBatches = 0;
+
+    /** Serializes the Writer calls. */
+    nx::Mutex writeMutex;
+    std::vector<AuditRecord> failedBatch;
+
+    mutable nx::Mutex playbackMutex;
+    std::unordered_map<int, AuditRecord> playbacks;
+    int lastPlaybackId = 0;
+
+    nx::Mutex mutex;
+    nx::WaitCondition condition;
+    bool terminated = false;
+    std::thread thread;
+
+    Private(Writer writer, Settings settings):
+        writer(std::move(writer)),
+        settings(std::move(settings))
+    {
+    }
+
+    void push(AuditRecord record);
+    bool writeQueued();
+    void finishPlayback(int id);
+    void run();
+};
+
+void AuditRecordQueue::Private::push(AuditRecord record)
+{
+    const int size = backlog.fetch_add(1) + 1;
+    if (size > settings.maxBacklog)
+    {
+        --backlog;
+        if (settings.overflowPolicy == OverflowPolicy::drop)
+        {
+            ++dropped;
+            NX_VERBOSE(this, "Dropped a record, %1 records are waiting to be written", size - 1);
+            return;
+        }
+
+        std::vector<AuditRecord> records;
+        records.push_back(std::move(record));
+
+        NX_MUTEX_LOCKER lock(&writeMutex);
+        if (writer(records))
+        {
+            ++writtenThrough;
+        }
+        else
+        {
+            ++dropped;
+            NX_DEBUG(this, "Failed to write a record bypassing the full queue");
+        }
+        return;
+    }
+
+    queue.enqueue(std::move(record));
+    if (size % settings.maxBatchSize == 0)
+    {
+        NX_MUTEX_LOCKER lock(&mutex);
+        condition.wakeAll();
+    }
+}
+
+bool AuditRecordQueue::Private::writeQueued()
+{
+    NX_MUTEX_LOCKER lock(&writeMutex);
+    auto batch = std::exchange(failedBatch, {});
+    while (true)
+    {
+        if ((int) batch.size() < settings.maxBatchSize)
+        {
+            queue.try_dequeue_bulk(
+                std::back_inserter(batch), settings.maxBatchSize - batch.size());
+        }
+        if (batch.empty())
+            return true;
+
+        ++batches;
+        if (!writer(batch))
+        {
+            ++failedBatches;
+            NX_DEBUG(this, "Failed to write %1 records, will retry", batch.size());
+            failedBatch = std::move(batch);
+            return false;
+        }
+
+        written += (int64_t) batch.size();
+        backlog -= (int) batch.size();
+        batch.clear();
+    }
+}
+
+void AuditRecordQueue::Private::finishPlayback(int id)
+{
+    NX_MUTEX_LOCKER lock(&playbackMutex);
+    const auto it = playbacks.find(id);
+    if (it == playbacks.end())
+        return;
+
+    auto record = std::move(it->second);
+    playbacks.erase(it);
+    lock.unlock();
+
+    push(std::move(record));
+}
+
+void AuditRecordQueue::Private::run()
+{
+    NX_MUTEX_LOCKER lock(&mutex);
+    bool failed = false;
+    while (!terminated)
+    {
+        // A failed batch is retried after the full period, not as soon as more records come.
+        if (failed || backlog < settings.maxBatchSize)
+            condition.wait(&mutex, settings.flushPeriod);
+        if (terminated)
+            return;
+
+        lock.unlock();
+        failed = !writeQueued();
+        lock.relock();
+    }
+}
+
+AuditRecordQueue::AuditRecordQueue(Writer writer, Settings settings):
+    d(std::make_shared<Private>(std::move(writer), std::move(settings)))
+{
+    d->thread = std::thread([d = d.get()]() { d->run(); });
+}
+
+AuditRecordQueue::~AuditRecordQueue()
+{
+    {
+        NX_MUTEX_LOCKER lock(&d->mutex);
+        d->terminated = true;
+        d->condition.wakeAll();
+    }
+    d->thread.join();
+
+    std::unordered_map<int, AuditRecord> playbacks;
+    {
+        NX_MUTEX_LOCKER lock(&d->playbackMutex);
+        playbacks = std::exchange(d->playbacks, {});
+    }
+    for (auto& [id, record]: playbacks)
+        d->push(std::move(record));
+
+    if (!d->writeQueued())
+        NX_WARNING(this, "%1 audit records are lost", d->backlog.load());
+}
+
+void AuditRecordQueue::push(AuditRecord record)
+{
+    d->push(std::move(record));
+}
+
+AuditHandle AuditRecordQueue::startPlayback(AuditRecord record)
+{
+    NX_MUTEX_LOCKER lock(&d->playbackMutex);
+    const int id = ++d->lastPlaybackId;
+    d->playbacks.emplace(id, std::move(record));
+
+    // The handle may outlive the queue, the records of unfinished playbacks are written then.
+    return AuditHandle(
+        new int(id),
+        [weakD = std::weak_ptr<Private>(d)](const int* id)
+        {
+            if (const auto d = weakD.lock())
+                d->finishPlayback(*id);
+            delete id;
+        });
+}
+
+void AuditRecordQueue::updatePlayback(const AuditHandle& handle, std::chrono::seconds position)
+{
+    if (!handle)
+        return;
+
+    NX_MUTEX_LOCKER lock(&d->playbackMutex);
+    const auto it = d->playbacks.find(*handle);
+    if (it == d->playbacks.end())
+        return;
+
+    if (auto details = it->second.get<nx::vms::api::PlaybackDetails>())
+        details->endS = std::max(details->endS, position);
+}
+
+void AuditRecordQueue::flush()
+{
+    d->writeQueued();
+}
+
+AuditRecordQueue::Statistics AuditRecordQueue::statistics() const
+{
+    Statistics result{
+        .backlog = d->backlog,
+        .written = d->written,
+        .writtenThrough = d->writtenThrough,
+        .dropped = d->dropped,
+        .batches = d->batches,
+        .failedBatches = d->failedBatches,
+    };
+
+    NX_MUTEX_LOCKER lock(&d->playbackMutex);
+    result.playbacks = (int) d->playbacks.size();
+    return result;
+}
+
+} // namespace nx::vms::common
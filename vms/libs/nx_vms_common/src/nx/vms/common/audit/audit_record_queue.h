@@ -0,0 +1,99 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <audit/audit_manager_fwd.h>
+#include <nx/utils/move_only_func.h>
+#include <nx/vms/api/data/audit.h>
+
+namespace nx::vms::common {
+
+/**
+ * Keeps the audit records in memory and writes them in batches from a dedicated thread, so that
+ * QnAuditManager implementations do not write to the DB on the path of the audited request.
+ *
+ * push() only appends to a lock-free queue. A batch is written when maxBatchSize records are
+ * queued or flushPeriod passes since the previous write, whichever comes first. The Writer is
+ * expected to insert a batch in a single transaction, e.g. with nx::sql::insertMany() inside
+ * nx::sql::AsyncSqlQueryExecutor::executeUpdate().
+ */
+class NX_VMS_COMMON_API AuditRecordQueue
+{
+public:
+    /** What push() does when maxBacklog records are already waiting to be written. */
+    enum class OverflowPolicy
+    {
+        /** The record is discarded and counted in Statistics::dropped. */
+        drop,
+
+        /** The record is written in the calling thread, after the batch being written if any. */
+        writeThrough,
+    };
+
+    struct Settings
+    {
+        int maxBatchSize = 256;
+        std::chrono::milliseconds flushPeriod = std::chrono::seconds(5);
+
+        /** Limits the records waiting to be written, including the ones of a failed batch. */
+        int maxBacklog = 100'000;
+
+        OverflowPolicy overflowPolicy = OverflowPolicy::drop;
+    };
+
+    struct Statistics
+    {
+        /** Records queued but not written yet. */
+        int backlog = 0;
+
+        /** Playbacks started but not finished yet. */
+        int playbacks = 0;
+
+        int64_t written = 0;
+        int64_t writtenThrough = 0;
+        int64_t dropped = 0;
+        int64_t batches = 0;
+        int64_t failedBatches = 0;
+    };
+
+    /**
+     * Writes the records. It is never called concurrently.
+     * @return False if the records are not written. They are retried with the next batch.
+     */
+    using Writer =
+        nx::utils::MoveOnlyFunc<bool(const std::vector<nx::vms::api::AuditRecord>& records)>;
+
+    AuditRecordQueue(Writer writer, Settings settings);
+
+    /** Writes all the queued records and the records of the unfinished playbacks. */
+    ~AuditRecordQueue();
+
+    AuditRecordQueue(const AuditRecordQueue&) = delete;
+    AuditRecordQueue& operator=(const AuditRecordQueue&) = delete;
+
+    void push(nx::vms::api::AuditRecord record);
+
+    /**
+     * Keeps the playback record in memory until the last copy of the returned handle is released,
+     * then queues it. This way the progress reported with updatePlayback() costs no DB writes.
+     */
+    AuditHandle startPlayback(nx::vms::api::AuditRecord record);
+
+    /** Extends the period of the playback record to the position if it has PlaybackDetails. */
+    void updatePlayback(const AuditHandle& handle, std::chrono::seconds position);
+
+    /** Writes the queued records in the calling thread. */
+    void flush();
+
+    Statistics statistics() const;
+
+private:
+    struct Private;
+    std::shared_ptr<Private> d;
+};
+
+} // namespace nx::vms::common
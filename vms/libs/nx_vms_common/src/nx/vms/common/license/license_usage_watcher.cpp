@@ -17,14 +17,14 @@ LicenseUsageWatcher::LicenseUsageWatcher(SystemContext* context, QObject* parent
     SystemContextAware(context)
 {
     connect(context->licensePool(), &QnLicensePool::licensesChanged, this,
-        &LicenseUsageWatcher::licenseUsageChanged);
+        [this]() { notifyChanged(); });
 
     // Call update if server was added or removed or changed its status.
     auto updateIfServerStatusChanged =
         [this](const QnPeerRuntimeInfo& data)
         {
             if (data.data.peer.peerType == nx::vms::api::PeerType::server)
-                emit licenseUsageChanged();
+                notifyChanged();
         };
 
     // Ignoring runtimeInfoChanged as hardwareIds must not change in runtime.
@@ -34,6 +34,22 @@ LicenseUsageWatcher::LicenseUsageWatcher(SystemContext* context, QObject* parent
         updateIfServerStatusChanged);
 }
 
+void LicenseUsageWatcher::notifyChanged()
+{
+    emit licenseUsageInvalidated();
+
+    if (m_changeNotificationScheduled.exchange(true))
+        return;
+
+    QMetaObject::invokeMethod(this,
+        [this]()
+        {
+            m_changeNotificationScheduled = false;
+            emit licenseUsageChanged();
+        },
+        Qt::QueuedConnection);
+}
+
 DeviceLicenseUsageWatcher::DeviceLicenseUsageWatcher(SystemContext* context, QObject* parent):
     base_type(context, parent)
 {
@@ -43,24 +59,20 @@ DeviceLicenseUsageWatcher::DeviceLicenseUsageWatcher(SystemContext* context, QOb
     auto connectToCamera =
         [this](const QnVirtualCameraResourcePtr& camera)
         {
-            connect(camera.get(), &QnVirtualCameraResource::scheduleEnabledChanged, this,
-                &LicenseUsageWatcher::licenseUsageChanged);
-            connect(camera.get(), &QnVirtualCameraResource::groupNameChanged, this,
-                &LicenseUsageWatcher::licenseUsageChanged);
-            connect(camera.get(), &QnVirtualCameraResource::groupIdChanged, this,
-                &LicenseUsageWatcher::licenseUsageChanged);
-            connect(camera.get(), &QnVirtualCameraResource::licenseTypeChanged, this,
-                &LicenseUsageWatcher::licenseUsageChanged);
-            connect(camera.get(), &QnVirtualCameraResource::parentIdChanged, this,
-                &LicenseUsageWatcher::licenseUsageChanged);
-    };
+            const auto notify = [this]() { notifyChanged(); };
+            connect(camera.get(), &QnVirtualCameraResource::scheduleEnabledChanged, this, notify);
+            connect(camera.get(), &QnVirtualCameraResource::groupNameChanged, this, notify);
+            connect(camera.get(), &QnVirtualCameraResource::groupIdChanged, this, notify);
+            connect(camera.get(), &QnVirtualCameraResource::licenseTypeChanged, this, notify);
+            connect(camera.get(), &QnVirtualCameraResource::parentIdChanged, this, notify);
+        };
 
     // Call update if camera was added or removed.
     auto updateIfNeeded =
         [this](const QnResourcePtr &resource)
         {
             if (resource.dynamicCast<QnVirtualCameraResource>())
-                emit licenseUsageChanged();
+                notifyChanged();
         };
 
     connect(resPool, &QnResourcePool::resourceAdded, this, updateIfNeeded);
@@ -96,11 +108,11 @@ VideoWallLicenseUsageWatcher::VideoWallLicenseUsageWatcher(
             connect(videowall.get(),
                 &QnVideoWallResource::itemAdded,
                 this,
-                &LicenseUsageWatcher::licenseUsageChanged);
+                [this]() { notifyChanged(); });
             connect(videowall.get(),
                 &QnVideoWallResource::itemRemoved,
                 this,
-                &LicenseUsageWatcher::licenseUsageChanged);
+                [this]() { notifyChanged(); });
         };
 
     auto resourceAdded =
@@ -109,7 +121,7 @@ VideoWallLicenseUsageWatcher::VideoWallLicenseUsageWatcher(
             if (const auto videowall = resource.dynamicCast<QnVideoWallResource>())
             {
                 connectTo(videowall);
-                emit licenseUsageChanged();
+                notifyChanged();
             }
         };
 
@@ -119,7 +131,7 @@ VideoWallLicenseUsageWatcher::VideoWallLicenseUsageWatcher(
             if (const auto videowall = resource.dynamicCast<QnVideoWallResource>())
             {
                 videowall->disconnect(this);
-                emit licenseUsageChanged();
+                notifyChanged();
             }
         };
 
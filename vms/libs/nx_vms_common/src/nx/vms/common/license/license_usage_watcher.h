@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <QtCore/QObject>
 
 #include <nx/vms/common/system_context_aware.h>
@@ -19,7 +21,25 @@ public:
     LicenseUsageWatcher(SystemContext* context, QObject* parent = nullptr);
 
 signals:
+    /**
+     * Emitted synchronously on each change which may affect the license usage, so the cached
+     * usage can be dropped before it is requested again.
+     */
+    void licenseUsageInvalidated();
+
+    /**
+     * Emitted once for all the changes made in one event loop iteration. A series of changes
+     * (e.g. the initial resource pool population or a bulk schedule change) would otherwise make
+     * each listener recalculate the usage over all the devices on each of them.
+     */
     void licenseUsageChanged();
+
+protected:
+    /** Emits licenseUsageInvalidated() and schedules licenseUsageChanged(). */
+    void notifyChanged();
+
+private:
+    std::atomic<bool> m_changeNotificationScheduled = false;
 };
 
 class NX_VMS_COMMON_API DeviceLicenseUsageWatcher: public LicenseUsageWatcher
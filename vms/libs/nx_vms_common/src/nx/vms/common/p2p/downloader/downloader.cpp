@@ -299,4 +299,13 @@ bool Downloader::isStalled(const QString& fileName) const
     return false;
 }
 
+QList<PeerStatistics> Downloader::peerStatistics(const QString& fileName) const
+{
+    NX_MUTEX_LOCKER lock(&d->mutex);
+    if (const auto& worker = d->workers.value(fileName))
+        return worker->peerStatistics();
+
+    return {};
+}
+
 } // namespace nx::vms::common::p2p::downloader
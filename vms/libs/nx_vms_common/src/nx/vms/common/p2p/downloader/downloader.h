@@ -9,6 +9,7 @@
 #include <nx/vms/common/system_context_aware.h>
 
 #include "file_information.h"
+#include "peer_statistics.h"
 #include "result_code.h"
 
 namespace nx::vms::common::p2p::downloader {
@@ -68,6 +69,9 @@ public:
 
     bool isStalled(const QString& fileName) const;
 
+    /** @return Statistics of the peers the file is being downloaded from. */
+    QList<PeerStatistics> peerStatistics(const QString& fileName) const;
+
 signals:
     void downloadFinished(const QString& fileName);
     void downloadFailed(const QString& fileName);
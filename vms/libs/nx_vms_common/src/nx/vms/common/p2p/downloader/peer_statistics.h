@@ -0,0 +1,24 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <QtCore/QString>
+
+namespace nx::vms::common::p2p::downloader {
+
+/** Download state of a single peer which a file is being downloaded from. */
+struct PeerStatistics
+{
+    QString peer;
+    int rank = 0;
+
+    /** Number of chunk requests the peer is allowed to have in flight at once. */
+    int window = 0;
+
+    int chunksInFlight = 0;
+    int downloadedChunks = 0;
+    int failedRequests = 0;
+    double throughputBytesPerSecond = 0;
+};
+
+} // namespace nx::vms::common::p2p::downloader
@@ -0,0 +1,93 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "chunk_writer.h"
+
+#include <utility>
+
+#include "storage.h"
+
+namespace nx::vms::common::p2p::downloader {
+
+namespace {
+
+// Limits the memory taken by the received chunks when the disk is slower than the network.
+constexpr int kMaxQueuedChunks = 16;
+
+} // namespace
+
+ChunkWriter::ChunkWriter(Storage* storage, const QString& fileName):
+    m_storage(storage),
+    m_fileName(fileName)
+{
+    m_thread = std::thread([this]() { run(); });
+}
+
+ChunkWriter::~ChunkWriter()
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_terminated = true;
+        m_condition.wakeAll();
+    }
+    m_thread.join();
+}
+
+void ChunkWriter::write(int chunkIndex, const QByteArray& data)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    while (m_queue.size() >= kMaxQueuedChunks)
+        m_condition.wait(&m_mutex);
+
+    m_queue.emplace_back(chunkIndex, data);
+    ++m_pendingCount;
+    m_condition.wakeAll();
+}
+
+std::vector<ChunkWriter::Result> ChunkWriter::takeResults()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return std::exchange(m_results, {});
+}
+
+std::vector<ChunkWriter::Result> ChunkWriter::waitForResults()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    while (m_results.empty() && m_pendingCount > 0)
+        m_condition.wait(&m_mutex);
+
+    return std::exchange(m_results, {});
+}
+
+int ChunkWriter::pendingCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_pendingCount;
+}
+
+void ChunkWriter::run()
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    while (true)
+    {
+        while (m_queue.empty() && !m_terminated)
+            m_condition.wait(&m_mutex);
+
+        // The queued chunks are written even on termination, they are already downloaded.
+        if (m_queue.empty())
+            return;
+
+        auto [chunkIndex, data] = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_condition.wakeAll();
+
+        lock.unlock();
+        const ResultCode code = m_storage->writeFileChunk(m_fileName, chunkIndex, data);
+        lock.relock();
+
+        m_results.push_back({chunkIndex, code});
+        --m_pendingCount;
+        m_condition.wakeAll();
+    }
+}
+
+} // namespace nx::vms::common::p2p::downloader
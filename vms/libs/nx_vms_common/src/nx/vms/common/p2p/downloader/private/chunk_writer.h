@@ -0,0 +1,71 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <nx/utils/thread/mutex.h>
+
+#include "../result_code.h"
+
+namespace nx::vms::common::p2p::downloader {
+
+class Storage;
+
+/**
+ * Writes the downloaded chunks to the Storage in a dedicated thread. This keeps the Worker
+ * receiving chunks while the data is written to the disk, and while the Storage checks the md5 of
+ * the completed file.
+ */
+class ChunkWriter
+{
+public:
+    struct Result
+    {
+        int chunkIndex = -1;
+        ResultCode code = ResultCode::ok;
+    };
+
+    ChunkWriter(Storage* storage, const QString& fileName);
+
+    /** Writes all the queued chunks before returning. */
+    ~ChunkWriter();
+
+    /** Queues the chunk. Blocks while too many chunks are waiting to be written. */
+    void write(int chunkIndex, const QByteArray& data);
+
+    /** @return Results of the chunks written since the previous call. Does not block. */
+    std::vector<Result> takeResults();
+
+    /**
+     * Blocks until at least one chunk is written or there are no chunks to write.
+     * @return Results of the chunks written since the previous call.
+     */
+    std::vector<Result> waitForResults();
+
+    /** @return Number of chunks which are queued or being written. */
+    int pendingCount() const;
+
+private:
+    void run();
+
+private:
+    Storage* const m_storage;
+    const QString m_fileName;
+
+    mutable nx::Mutex m_mutex;
+    nx::WaitCondition m_condition;
+    std::deque<std::pair<int, QByteArray>> m_queue;
+    std::vector<Result> m_results;
+    int m_pendingCount = 0;
+    bool m_terminated = false;
+
+    std::thread m_thread;
+};
+
+} // namespace nx::vms::common::p2p::downloader
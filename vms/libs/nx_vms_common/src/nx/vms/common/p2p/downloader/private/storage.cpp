@@ -9,6 +9,7 @@
 
 #include <nx/fusion/model_functions.h>
 #include <nx/fusion/serialization/json.h>
+#include <nx/utils/cryptographic_hash.h>
 #include <nx/utils/file_system.h>
 #include <nx/utils/scope_guard.h>
 #include <nx/utils/suppress_exceptions.h>
@@ -135,7 +136,7 @@ ResultCode Storage::moveFile(
     return ResultCode::ok;
 }
 
-ResultCode Storage::addFileInternal(FileInformation fileInformation, bool loadingDownloads)
+ResultCode Storage::addFileInternal(FileMetadata fileInformation, bool loadingDownloads)
 {
     if (fileInformation.status == FileInformation::Status::downloaded)
         return addDownloadedFile(fileInformation, loadingDownloads);
@@ -143,7 +144,7 @@ ResultCode Storage::addFileInternal(FileInformation fileInformation, bool loadin
 }
 
 ResultCode Storage::addDownloadedFile(
-    const FileInformation& fileInformation, bool loadingDownloads)
+    const FileMetadata& fileInformation, bool loadingDownloads)
 {
     NX_ASSERT(fileInformation.status == FileInformation::Status::downloaded);
 
@@ -164,14 +165,22 @@ ResultCode Storage::addDownloadedFile(
         return ResultCode::fileDoesNotExist;
     }
 
-    const auto md5 = calculateMd5(info.fullFilePath);
-    if (md5.isEmpty())
-        return ResultCode::ioError;
+    // The loaded downloads are marked as downloaded only after their md5 has been checked by
+    // loadMetadata(), there is no need to read them once again.
+    const bool isVerified = loadingDownloads
+        && !info.md5.isEmpty()
+        && info.downloadedChunks.count(true) == info.downloadedChunks.size();
+    if (!isVerified)
+    {
+        const auto md5 = calculateMd5(info.fullFilePath);
+        if (md5.isEmpty())
+            return ResultCode::ioError;
 
-    if (info.md5.isEmpty())
-        info.md5 = md5;
-    else if (info.md5 != md5)
-        return ResultCode::invalidChecksum;
+        if (info.md5.isEmpty())
+            info.md5 = md5;
+        else if (info.md5 != md5)
+            return ResultCode::invalidChecksum;
+    }
 
     const auto size = calculateFileSize(info.fullFilePath);
     if (size < 0)
@@ -184,6 +193,7 @@ ResultCode Storage::addDownloadedFile(
 
     const int chunkCount = calculateChunkCount(info.size, info.chunkSize);
     info.downloadedChunks.fill(true, chunkCount);
+    info.resetMd5State();
 
     if (!saveMetadata(info))
     {
@@ -201,7 +211,7 @@ ResultCode Storage::addDownloadedFile(
     return ResultCode::ok;
 }
 
-ResultCode Storage::addNewFile(const FileInformation& fileInformation, bool loadingDownloads)
+ResultCode Storage::addNewFile(const FileMetadata& fileInformation, bool loadingDownloads)
 {
     NX_ASSERT(fileInformation.status != FileInformation::Status::downloaded);
 
@@ -221,7 +231,8 @@ ResultCode Storage::addNewFile(const FileInformation& fileInformation, bool load
         return ResultCode::ioError;
     }
 
-    if (!info.md5.isEmpty() && calculateMd5(info.fullFilePath) == info.md5)
+    // The loaded downloads have their completion already checked by loadMetadata().
+    if (!loadingDownloads && !info.md5.isEmpty() && calculateMd5(info.fullFilePath) == info.md5)
     {
         info.status = FileInformation::Status::downloaded;
         info.size = calculateFileSize(info.fullFilePath);
@@ -250,6 +261,13 @@ ResultCode Storage::addNewFile(const FileInformation& fileInformation, bool load
             const int chunkCount = calculateChunkCount(info.size, info.chunkSize);
             info.downloadedChunks.resize(chunkCount);
             info.chunkChecksums.clear();
+
+            // The state is kept when a download is resumed after a restart.
+            if (fileInformation.hashedChunkCount <= chunkCount)
+            {
+                info.hashedChunkCount = fileInformation.hashedChunkCount;
+                info.md5State = fileInformation.md5State;
+            }
         }
 
         ResultCode reserveStatus = reserveSpace(info.fullFilePath, info.size >= 0 ? info.size : 0);
@@ -296,6 +314,7 @@ ResultCode Storage::updateFileInformation(const QString& fileName, qint64 size,
         const int chunkCount = calculateChunkCount(size, it->chunkSize);
         it->downloadedChunks.resize(chunkCount);
         it->chunkChecksums.clear();
+        it->resetMd5State();
         resizeFailed = !QFile::resize(it->fullFilePath, size);
 
         updated = true;
@@ -358,6 +377,7 @@ ResultCode Storage::setChunkSize(const QString& fileName, qint64 chunkSize)
         const int chunkCount = calculateChunkCount(it->size, chunkSize);
         it->downloadedChunks.fill(false, chunkCount);
         it->chunkChecksums.clear();
+        it->resetMd5State();
     }
 
     const auto exitGuard = nx::utils::makeScopeGuard(
@@ -457,6 +477,7 @@ ResultCode Storage::writeFileChunk(const QString& fileName, int chunkIndex, cons
 
     it->downloadedChunks.setBit(chunkIndex);
     it->touchTime = QDateTime::currentMSecsSinceEpoch();
+    updateMd5State(it.value(), chunkIndex, buffer);
     checkDownloadCompleted(it.value());
     saveMetadata(it.value());
 
@@ -544,6 +565,7 @@ ResultCode Storage::clearFile(const QString& fileName, bool force)
     if (it->status != FileInformation::Status::uploading)
         it->status = FileInformation::Status::downloading;
     it->downloadedChunks.fill(false);
+    it->resetMd5State();
 
     lock.unlock();
     emit fileInformationChanged(*it);
@@ -620,6 +642,8 @@ ResultCode Storage::setChunkChecksums(
         {
             it->downloadedChunks[i] = false;
             it->status = FileInformation::Status::downloading;
+            if (i < it->hashedChunkCount)
+                it->resetMd5State();
         }
     }
 
@@ -688,20 +712,30 @@ void Storage::findDownloadsImpl()
 {
     const auto startTime = system_clock::now();
 
-    int count = 0;
+    QStringList metadataFileNames;
     for (const auto& entry: QDir(metadataDirectoryPath()).entryInfoList(QDir::Files))
     {
         auto fileName = entry.absoluteFilePath();
         NX_DEBUG(this, "Find downloads: Processing metadata file %1", fileName);
-        if (!fileName.endsWith(kMetadataSuffix))
-            continue;
+        if (fileName.endsWith(kMetadataSuffix))
+            metadataFileNames.append(fileName);
+    }
+
+    // Loading of the completed downloads includes their md5 verification, so the packages are
+    // verified in parallel.
+    const auto loadedFiles = QtConcurrent::blockingMapped<QList<FileMetadata>>(
+        metadataFileNames,
+        [this](const QString& fileName) { return loadMetadata(fileName); });
 
-        const auto fileInfo = loadMetadata(fileName);
+    int count = 0;
+    for (int i = 0; i < loadedFiles.size(); ++i)
+    {
+        const auto& fileInfo = loadedFiles[i];
         if (!fileInfo.isValid())
         {
             NX_DEBUG(
                 this,
-                "Find downloads: Load metadata file (%1) failed", fileName);
+                "Find downloads: Load metadata file (%1) failed", metadataFileNames[i]);
             continue;
         }
 
@@ -740,6 +774,25 @@ QByteArray Storage::calculateMd5(const QString& filePath)
     return hash.result();
 }
 
+QByteArray Storage::resumeMd5(const FileMetadata& fileInfo)
+{
+    QFile file(fileInfo.fullFilePath);
+    if (!file.open(QFile::ReadOnly))
+        return QByteArray();
+
+    nx::utils::QnCryptographicHash hash(nx::utils::QnCryptographicHash::Md5);
+    if (fileInfo.hashedChunkCount > 0 && hash.restoreState(fileInfo.md5State))
+    {
+        if (!file.seek(std::min(fileInfo.size, fileInfo.chunkSize * fileInfo.hashedChunkCount)))
+            return QByteArray();
+    }
+
+    if (!hash.addData(&file))
+        return QByteArray();
+
+    return hash.result();
+}
+
 qint64 Storage::calculateFileSize(const QString& filePath)
 {
     QFile file(filePath);
@@ -891,7 +944,8 @@ void Storage::checkDownloadCompleted(FileMetadata& fileInfo)
             return;
     }
 
-    const auto md5 = calculateMd5(fileInfo.fullFilePath);
+    const auto md5 = resumeMd5(fileInfo);
+    fileInfo.resetMd5State();
     if (md5 != fileInfo.md5)
     {
         fileInfo.status = FileInformation::Status::corrupted;
@@ -901,6 +955,54 @@ void Storage::checkDownloadCompleted(FileMetadata& fileInfo)
     fileInfo.status = FileInformation::Status::downloaded;
 }
 
+void Storage::updateMd5State(FileMetadata& fileInfo, int chunkIndex, const QByteArray& buffer)
+{
+    if (chunkIndex < fileInfo.hashedChunkCount)
+    {
+        // The hashed data has been overwritten.
+        fileInfo.resetMd5State();
+        return;
+    }
+
+    if (chunkIndex != fileInfo.hashedChunkCount)
+        return;
+
+    nx::utils::QnCryptographicHash hash(nx::utils::QnCryptographicHash::Md5);
+    if (fileInfo.hashedChunkCount > 0 && !hash.restoreState(fileInfo.md5State))
+    {
+        fileInfo.resetMd5State();
+        return;
+    }
+
+    hash.addData(buffer);
+    int hashedChunkCount = chunkIndex + 1;
+
+    // The following chunks may have arrived earlier, they are read back from the disk.
+    const int chunkCount = fileInfo.downloadedChunks.size();
+    if (hashedChunkCount < chunkCount && fileInfo.downloadedChunks.testBit(hashedChunkCount))
+    {
+        QFile file(fileInfo.fullFilePath);
+        if (file.open(QFile::ReadOnly) && file.seek(fileInfo.chunkSize * hashedChunkCount))
+        {
+            while (hashedChunkCount < chunkCount
+                && fileInfo.downloadedChunks.testBit(hashedChunkCount))
+            {
+                const qint64 size =
+                    calculateChunkSize(fileInfo.size, hashedChunkCount, fileInfo.chunkSize);
+                const QByteArray data = file.read(size);
+                if (data.size() != size)
+                    break;
+
+                hash.addData(data);
+                ++hashedChunkCount;
+            }
+        }
+    }
+
+    fileInfo.hashedChunkCount = hashedChunkCount;
+    fileInfo.md5State = hash.saveState();
+}
+
 ResultCode Storage::reserveSpace(const QString& fileName, const qint64 size)
 {
     QFile file(fileName);
@@ -941,6 +1043,7 @@ qint64 Storage::calculateChunkSize(qint64 fileSize, int chunkIndex, qint64 chunk
         : fileSize - chunkSize * (chunkCount - 1);
 }
 
-QN_FUSION_ADAPT_STRUCT_FUNCTIONS(FileMetadata, (json), FileInformation_Fields (chunkChecksums))
+QN_FUSION_ADAPT_STRUCT_FUNCTIONS(FileMetadata, (json),
+    FileInformation_Fields (chunkChecksums)(hashedChunkCount)(md5State))
 
 } // nx::vms::common::p2p::downloader
@@ -29,7 +29,23 @@ struct FileMetadata: FileInformation
         const FileInformation& fileInformation,
         const QDir& defaultDownloadsDirectory);
 
+    void resetMd5State()
+    {
+        hashedChunkCount = 0;
+        md5State.clear();
+    }
+
     QVector<QByteArray> chunkChecksums;
+
+    /**
+     * The md5 of the file is calculated while the chunks arrive, so the downloaded file does not
+     * have to be read again. Only the contiguous sequence of the leading chunks can be hashed,
+     * the chunks arrived out of order are hashed when the gap before them is filled.
+     */
+    int hashedChunkCount = 0;
+
+    /** Intermediate md5 state after hashedChunkCount chunks, survives the restarts. */
+    QByteArray md5State;
 };
 
 class NX_VMS_COMMON_API Storage: public QObject
@@ -84,10 +100,10 @@ signals:
     void existingDownloadsLoaded();
 
 private:
-    ResultCode addFileInternal(FileInformation fileInformation, bool loadingDownloads = false);
+    ResultCode addFileInternal(FileMetadata fileInformation, bool loadingDownloads = false);
     ResultCode addDownloadedFile(
-        const FileInformation& fileInformation, bool loadingDownloads = false);
-    ResultCode addNewFile(const FileInformation& fileInformation, bool loadingDownloads = false);
+        const FileMetadata& fileInformation, bool loadingDownloads = false);
+    ResultCode addNewFile(const FileMetadata& fileInformation, bool loadingDownloads = false);
     ResultCode deleteFileInternal(const QString& fileName, bool deleteData = true);
 
     bool saveMetadata(const FileMetadata& fileInformation);
@@ -95,10 +111,12 @@ private:
     FileMetadata fileMetadata(const QString& fileName) const;
     ResultCode loadDownload(const QString& fileName);
     void checkDownloadCompleted(FileMetadata& fileInfo);
+    void updateMd5State(FileMetadata& fileInfo, int chunkIndex, const QByteArray& buffer);
     void findDownloadsImpl();
     QString metadataDirectoryPath() const;
     QString metadataFileName(const QString& fileName);
 
+    static QByteArray resumeMd5(const FileMetadata& fileInfo);
     static ResultCode reserveSpace(const QString& fileName, const qint64 size);
     static qint64 calculateChunkSize(qint64 fileSize, int chunkIndex, qint64 calculateChunkSize);
 
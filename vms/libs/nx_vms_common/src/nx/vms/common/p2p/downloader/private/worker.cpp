@@ -2,7 +2,9 @@
 
 #include "worker.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 
 #include <QtCore/QTimer>
 
@@ -13,12 +15,14 @@
 
 #include "storage.h"
 #include "abstract_peer_manager.h"
+#include "chunk_writer.h"
 
 namespace {
 
 using namespace nx::vms::common::p2p::downloader;
 
-constexpr int kMaxSimultaneousDownloads = 5;
+constexpr int kMaxSimultaneousDownloads = 32;
+constexpr int kEnoughFastPeers = 5;
 constexpr milliseconds kDefaultStepDelay = 15s;
 
 QString statusString(bool success)
@@ -145,6 +149,7 @@ void Worker::run()
     m_availableChunks.resize(fileInfo.downloadedChunks.size());
 
     m_stallDetectionTimer.restart();
+    m_chunkWriter = std::make_unique<ChunkWriter>(m_storage, m_fileName);
     m_started = true;
     doWork();
 }
@@ -231,6 +236,12 @@ bool Worker::isStalled() const
     return m_stalled;
 }
 
+QList<PeerStatistics> Worker::peerStatistics() const
+{
+    NX_MUTEX_LOCKER lock(&m_statisticsMutex);
+    return m_peerStatistics;
+}
+
 void Worker::setState(State state)
 {
     if (m_state == state)
@@ -608,6 +619,10 @@ void Worker::handleChecksumsReply(
 void Worker::downloadChunks()
 {
     constexpr int kSubsequentChunksToDownload = 15;
+    // In the end game the chunks which are still being downloaded are requested from one more
+    // peer, so a single slow peer does not delay the completion of the whole file.
+    constexpr int kMaxChunkCopies = 2;
+    constexpr milliseconds kStatisticsUpdateInterval = 1s;
 
     NX_VERBOSE(m_logTag, "downloadChunks()");
 
@@ -628,48 +643,113 @@ void Worker::downloadChunks()
     int chunksLeft = kSubsequentChunksToDownload;
     bool chunkRequested = false;
 
-    QSet<int> downloadingChunks;
-    QSet<Peer> busyPeers;
+    QHash<int, QSet<Peer>> peersByRequestedChunk;
+    // Chunks which are received and are written or are being written to the storage.
+    QSet<int> receivedChunks;
 
-    while (chunksLeft > 0 && !needToStop())
-    {
-        for (int i = 0;
-            contexts.size() < kMaxSimultaneousDownloads && i < kMaxSimultaneousDownloads
-                && chunksLeft > 0 && !needToStop();
-            ++i)
-        {
-            const int chunk = selectNextChunk(downloadingChunks);
-            if (chunk < 0)
-                break;
+    QElapsedTimer statisticsUpdateTimer;
+    statisticsUpdateTimer.start();
 
-            const Peer& peer = selectPeerForChunk(chunk, busyPeers);
-            if (peer.isNull())
-            {
-                NX_WARNING(m_logTag, "No peers are selected to download chunk %1.", chunk);
-                continue;
-            }
+    const auto downloadingChunks =
+        [&]()
+        {
+            QSet<int> result = receivedChunks;
+            for (auto it = peersByRequestedChunk.cbegin(); it != peersByRequestedChunk.cend(); ++it)
+                result.insert(it.key());
+            return result;
+        };
 
-            const PeerInformation& peerInfo = m_peerInfoByPeer.value(peer);
+    const auto requestChunk =
+        [&](int chunk, const Peer& peer)
+        {
+            PeerInformation& peerInfo = m_peerInfoByPeer[peer];
 
             NX_VERBOSE(m_logTag,
-                "Selected peer %1 for chunk %2, rank: %3, chunk download time: %4",
-                peer, chunk, peerInfo.rank, peerInfo.averageChunkDownloadTime);
+                "Selected peer %1 for chunk %2, rank: %3, chunk download time: %4, window: %5",
+                peer, chunk, peerInfo.rank, peerInfo.averageChunkDownloadTime, peerInfo.window);
 
             auto context = peer.manager->downloadChunk(
                 peer.id, m_fileName, fileInfo.url, chunk, (int) fileInfo.chunkSize, fileInfo.size);
-            if (context && context->isValid())
+            if (!context || !context->isValid())
             {
-                chunkRequested = true;
-                contexts.emplace_back(
-                    ContextData{peer, chunk, steady_clock::now()}, std::move(context));
-                downloadingChunks.insert(chunk);
-                busyPeers.insert(peer);
-                --chunksLeft;
+                decreasePeerRank(peer);
+                return false;
+            }
+
+            const auto now = steady_clock::now();
+            if (peerInfo.firstRequestTime == time_point<steady_clock>())
+                peerInfo.firstRequestTime = now;
+            ++peerInfo.chunksInFlight;
+
+            chunkRequested = true;
+            contexts.emplace_back(ContextData{peer, chunk, now}, std::move(context));
+            peersByRequestedChunk[chunk].insert(peer);
+            return true;
+        };
+
+    const auto selectEndGameChunk =
+        [&](Peer* peer)
+        {
+            for (const Context& context: contexts)
+            {
+                const int chunk = context.data.chunkIndex;
+                const QSet<Peer>& peers = peersByRequestedChunk.value(chunk);
+                if (receivedChunks.contains(chunk) || peers.size() >= kMaxChunkCopies)
+                    continue;
+
+                *peer = selectPeerForChunk(chunk, peers);
+                if (!peer->isNull())
+                    return chunk;
+            }
+
+            return -1;
+        };
+
+    const auto handleWrittenChunks =
+        [&](const std::vector<ChunkWriter::Result>& results)
+        {
+            for (const ChunkWriter::Result& result: results)
+            {
+                if (result.code != ResultCode::ok)
+                    receivedChunks.remove(result.chunkIndex);
+                handleChunkWritten(result.chunkIndex, result.code);
+            }
+        };
+
+    while (chunksLeft > 0 && !needToStop() && m_state == State::downloadingChunks)
+    {
+        // Chunks which cannot be requested right now because their peers have no free windows.
+        QSet<int> ignoredChunks = downloadingChunks();
+
+        while (contexts.size() < kMaxSimultaneousDownloads && chunksLeft > 0 && !needToStop())
+        {
+            Peer peer;
+            int chunk = selectNextChunk(ignoredChunks);
+            if (chunk >= 0)
+            {
+                peer = selectPeerForChunk(chunk);
+                if (peer.isNull())
+                {
+                    ignoredChunks.insert(chunk);
+                    continue;
+                }
             }
             else
             {
-                decreasePeerRank(peer);
+                if (selectNextChunk(downloadingChunks()) >= 0)
+                    break; //< Not all the chunks are requested yet.
+
+                chunk = selectEndGameChunk(&peer);
+                if (chunk < 0)
+                    break;
+
+                NX_VERBOSE(m_logTag, "End game: requesting chunk %1 from one more peer.", chunk);
             }
+
+            if (requestChunk(chunk, peer))
+                --chunksLeft;
+            else
+                ignoredChunks.insert(chunk);
         }
 
         if (contexts.empty())
@@ -687,10 +767,20 @@ void Worker::downloadChunks()
             [&, this](const ContextData& ctx, const std::optional<nx::Buffer>& data)
             {
                 PeerInformation& info = m_peerInfoByPeer[ctx.peer];
+                --info.chunksInFlight;
+                info.lastReplyTime = steady_clock::now();
+
+                QSet<Peer>& chunkPeers = peersByRequestedChunk[ctx.chunkIndex];
+                chunkPeers.remove(ctx.peer);
+                const bool otherRequestsInFlight = !chunkPeers.isEmpty();
+                if (!otherRequestsInFlight)
+                    peersByRequestedChunk.remove(ctx.chunkIndex);
 
                 if (data)
                 {
                     info.lastSuccessfulRequestTime = ctx.requestTime;
+                    ++info.downloadedChunksCount;
+                    info.downloadedBytes += data->size();
 
                     const bool lastChunk = ctx.chunkIndex == m_availableChunks.size() - 1;
                     if (!lastChunk)
@@ -700,20 +790,71 @@ void Worker::downloadChunks()
                             duration_cast<milliseconds>(steady_clock::now() - ctx.requestTime));
                     }
                 }
+                else
+                {
+                    info.recordChunkDownloadFailure();
+                }
 
-                const bool decreaseRankOnFailure =
-                    info.lastSuccessfulRequestTime < ctx.requestTime;
+                if (receivedChunks.contains(ctx.chunkIndex))
+                {
+                    NX_VERBOSE(m_logTag, "Chunk %1 from %2 is already received.",
+                        ctx.chunkIndex, ctx.peer);
+                }
+                else if (data || !otherRequestsInFlight)
+                {
+                    const bool decreaseRankOnFailure =
+                        info.lastSuccessfulRequestTime < ctx.requestTime;
 
-                handleDownloadChunkReply(ctx.peer, ctx.chunkIndex, data, decreaseRankOnFailure);
+                    handleDownloadChunkReply(
+                        ctx.peer, ctx.chunkIndex, data, decreaseRankOnFailure);
 
-                busyPeers.remove(ctx.peer);
-                downloadingChunks.remove(ctx.chunkIndex);
+                    if (data)
+                        receivedChunks.insert(ctx.chunkIndex);
+                }
 
                 return chunksLeft > 0;
             },
             false);
+
+        // The end game requests of the received chunks are not needed anymore.
+        for (auto it = contexts.begin(); it != contexts.end();)
+        {
+            if (!receivedChunks.contains(it->data.chunkIndex))
+            {
+                ++it;
+                continue;
+            }
+
+            it->context->cancel();
+            --m_peerInfoByPeer[it->data.peer].chunksInFlight;
+            peersByRequestedChunk.remove(it->data.chunkIndex);
+            it = contexts.erase(it);
+        }
+
+        handleWrittenChunks(m_chunkWriter->takeResults());
+
+        if (statisticsUpdateTimer.hasExpired(kStatisticsUpdateInterval.count()))
+        {
+            updatePeerStatistics();
+            statisticsUpdateTimer.restart();
+        }
     }
 
+    // Requests are left only if the download is stopped or failed.
+    for (const Context& context: contexts)
+        context.context->cancel();
+    contexts.clear();
+
+    for (PeerInformation& info: m_peerInfoByPeer)
+        info.chunksInFlight = 0;
+
+    do
+    {
+        handleWrittenChunks(m_chunkWriter->waitForResults());
+    } while (m_chunkWriter->pendingCount() > 0);
+
+    updatePeerStatistics();
+
     if (!chunkRequested)
     {
         if (fileInformation().status != FileInformation::Status::downloading)
@@ -745,8 +886,12 @@ void Worker::handleDownloadChunkReply(
         return;
     }
 
-    const auto resultCode =
-        m_storage->writeFileChunk(m_fileName, chunkIndex, data->toRawByteArray());
+    // The result is handled in handleChunkWritten().
+    m_chunkWriter->write(chunkIndex, data->toRawByteArray());
+}
+
+void Worker::handleChunkWritten(int chunkIndex, ResultCode resultCode)
+{
     if (resultCode != ResultCode::ok)
     {
         NX_WARNING(m_logTag, "Cannot write chunk %1. Storage error: %2", chunkIndex, resultCode);
@@ -770,6 +915,25 @@ void Worker::handleDownloadChunkReply(
     markActive();
 }
 
+void Worker::updatePeerStatistics()
+{
+    QList<PeerStatistics> statistics;
+    for (auto it = m_peerInfoByPeer.cbegin(); it != m_peerInfoByPeer.cend(); ++it)
+    {
+        statistics.append(PeerStatistics{
+            it.key().toString(),
+            it->rank,
+            it->window,
+            it->chunksInFlight,
+            it->downloadedChunksCount,
+            it->failedRequests,
+            it->throughputBytesPerSecond()});
+    }
+
+    NX_MUTEX_LOCKER lock(&m_statisticsMutex);
+    m_peerStatistics = std::move(statistics);
+}
+
 void Worker::finish(State state)
 {
     setState(state);
@@ -782,29 +946,26 @@ int Worker::updateAvailableChunks()
     NX_VERBOSE(m_logTag, "Updating available chunks...");
 
     m_availableChunks = fileInformation().downloadedChunks;
-    int availableChunksCount = m_availableChunks.count(true);
+    m_chunkAvailability.fill(0, m_availableChunks.size());
 
     for (const PeerInformation& peer: m_peerInfoByPeer)
     {
-        if (peer.isBanned())
-            continue;
-
-        if (availableChunksCount == m_availableChunks.size())
-            break;
-
-        if (peer.isInternet || peer.downloadedChunks.isEmpty())
+        if (peer.isBanned() || peer.isInternet || peer.downloadedChunks.isEmpty())
             continue;
 
-        for (int i = 0; i < m_availableChunks.size(); ++i)
+        const int chunksCount = std::min(peer.downloadedChunks.size(), m_availableChunks.size());
+        for (int i = 0; i < chunksCount; ++i)
         {
-            if (peer.downloadedChunks[i] && !m_availableChunks[i])
+            if (peer.downloadedChunks[i])
             {
-                ++availableChunksCount;
+                ++m_chunkAvailability[i];
                 m_availableChunks.setBit(i);
             }
         }
     }
 
+    const int availableChunksCount = m_availableChunks.count(true);
+
     NX_VERBOSE(m_logTag, "Chunks available: %1/%2",
         availableChunksCount, m_availableChunks.size());
 
@@ -893,37 +1054,31 @@ QList<Worker::Peer> Worker::getPeersToGetCheksums() const
     return preferredPeers + otherPeers;
 }
 
-Worker::Peer Worker::selectPeerForChunk(int chunk, const QSet<Worker::Peer>& busyPeers) const
+Worker::Peer Worker::selectPeerForChunk(int chunk, const QSet<Worker::Peer>& excludedPeers) const
 {
-    const auto findBestPeer =
-        [this, chunk, busyPeers](bool freeOnly)
-        {
-            Peer bestPeer;
-            milliseconds bestTime = milliseconds::max();
+    Peer bestPeer;
+    double bestTime = std::numeric_limits<double>::max();
 
-            for (auto it = m_peerInfoByPeer.begin(); it != m_peerInfoByPeer.end(); ++it)
-            {
-                if (it->isBanned())
-                    continue;
-
-                if (freeOnly && busyPeers.contains(it.key()))
-                    continue;
-
-                if ((it->isInternet || it->hasChunk(chunk))
-                    && it->averageChunkDownloadTime < bestTime)
-                {
-                    bestPeer = it.key();
-                    bestTime = it->averageChunkDownloadTime;
-                }
-            }
+    for (auto it = m_peerInfoByPeer.begin(); it != m_peerInfoByPeer.end(); ++it)
+    {
+        if (it->isBanned() || !it->hasFreeWindow() || !it->hasChunk(chunk))
+            continue;
 
-            return bestPeer;
-        };
+        if (excludedPeers.contains(it.key()))
+            continue;
 
-    if (const Peer& peer = findBestPeer(true); !peer.isNull())
-        return peer;
+        // Time until the peer delivers one more chunk, given that it serves the whole window at
+        // once.
+        const double time = (double) it->averageChunkDownloadTime.count()
+            * (it->chunksInFlight + 1) / it->window;
+        if (time < bestTime)
+        {
+            bestPeer = it.key();
+            bestTime = time;
+        }
+    }
 
-    return findBestPeer(false);
+    return bestPeer;
 }
 
 void Worker::reviveBannedPeers()
@@ -946,34 +1101,33 @@ int Worker::selectNextChunk(const QSet<int>& ignoredChunks) const
     const int randomChunk = utils::random::number(0, chunksCount - 1);
 
     int firstMetNotDownloadedChunk = -1;
+    int rarestChunk = -1;
+    int rarestChunkAvailability = std::numeric_limits<int>::max();
 
-    auto findChunk =
-        [&](int start, int end)
-        {
-            for (int i = start; i <= end; ++i)
-            {
-                if (fileInfo.downloadedChunks[i] || ignoredChunks.contains(i))
-                    continue;
-
-                if (firstMetNotDownloadedChunk < 0)
-                    firstMetNotDownloadedChunk = i;
-
-                if (m_availableChunks[i])
-                    return i;
-            }
+    // The random start spreads the chunks of equal availability between the downloading peers.
+    for (int n = 0; n < chunksCount; ++n)
+    {
+        const int i = (randomChunk + n) % chunksCount;
+        if (fileInfo.downloadedChunks[i] || ignoredChunks.contains(i))
+            continue;
 
-            return -1;
-        };
+        if (firstMetNotDownloadedChunk < 0)
+            firstMetNotDownloadedChunk = i;
 
-    int chunk = findChunk(randomChunk, chunksCount - 1);
-    if (chunk >= 0)
-        return chunk;
+        if (!m_availableChunks[i])
+            continue;
 
-    chunk = findChunk(0, randomChunk - 1);
-    if (chunk >= 0)
-        return chunk;
+        const int availability = i < m_chunkAvailability.size() ? m_chunkAvailability[i] : 0;
+        if (availability < rarestChunkAvailability)
+        {
+            rarestChunk = i;
+            rarestChunkAvailability = availability;
+            if (availability <= 1)
+                break;
+        }
+    }
 
-    return firstMetNotDownloadedChunk;
+    return rarestChunk >= 0 ? rarestChunk : firstMetNotDownloadedChunk;
 }
 
 bool Worker::needToFindBetterPeersForDownload() const
@@ -995,7 +1149,7 @@ bool Worker::needToFindBetterPeersForDownload() const
             ++fastPeersCount;
     }
 
-    if (fastPeersCount > kMaxSimultaneousDownloads)
+    if (fastPeersCount > kEnoughFastPeers)
     {
         NX_VERBOSE(m_logTag, "Don't need to find better peers. Found %1 fast peers.",
             fastPeersCount);
@@ -1114,6 +1268,42 @@ void Worker::PeerInformation::recordChunkDownloadTime(milliseconds time)
     averageChunkDownloadTime =
         std::accumulate(latestChunksDownloadTime.begin(), latestChunksDownloadTime.end(), 0ms)
             / latestChunksDownloadTime.size();
+
+    // The base time slowly follows the actual one, so the window adapts when the route to the
+    // peer or its load changes.
+    if (latestChunksDownloadTime.size() == 1 || time < baseChunkDownloadTime)
+        baseChunkDownloadTime = time;
+    else
+        baseChunkDownloadTime += (time - baseChunkDownloadTime) / 16;
+
+    // Estimated number of the requests waiting in the peer queue: the difference between the
+    // expected (window / base time) and the actual (window / average time) throughput, in chunks.
+    constexpr double kMinQueuedChunks = 1;
+    constexpr double kMaxQueuedChunks = 3;
+    const double queuedChunks = averageChunkDownloadTime > 0ms
+        ? window * (double) (averageChunkDownloadTime - baseChunkDownloadTime).count()
+            / averageChunkDownloadTime.count()
+        : 0;
+
+    if (queuedChunks < kMinQueuedChunks)
+        window = std::min(window + 1, kMaxWindow);
+    else if (queuedChunks > kMaxQueuedChunks)
+        window = std::max(window - 1, 1);
+}
+
+void Worker::PeerInformation::recordChunkDownloadFailure()
+{
+    ++failedRequests;
+    window = std::max(window / 2, 1);
+}
+
+double Worker::PeerInformation::throughputBytesPerSecond() const
+{
+    const auto activeTime = duration_cast<milliseconds>(lastReplyTime - firstRequestTime);
+    if (downloadedBytes == 0 || activeTime <= 0ms)
+        return 0;
+
+    return downloadedBytes * 1000.0 / activeTime.count();
 }
 
 bool Worker::PeerInformation::hasChunk(int chunk) const
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include <thread>
 
 #include <QtCore/QBitArray>
@@ -11,8 +12,11 @@
 #include <api/server_rest_connection_fwd.h>
 #include <nx/reflect/enum_instrument.h>
 #include <nx/utils/thread/long_runnable.h>
+#include <nx/utils/thread/mutex.h>
 
 #include "../file_information.h"
+#include "../peer_statistics.h"
+#include "../result_code.h"
 #include "abstract_peer_manager.h"
 
 namespace nx::vms::common::p2p::downloader {
@@ -20,6 +24,7 @@ namespace nx::vms::common::p2p::downloader {
 using namespace std::chrono;
 
 class Storage;
+class ChunkWriter;
 
 class NX_VMS_COMMON_API Worker: public QnLongRunnable
 {
@@ -77,6 +82,9 @@ public:
 
     bool isStalled() const;
 
+    /** Thread-safe. */
+    QList<PeerStatistics> peerStatistics() const;
+
 signals:
     void finished(const QString& fileName);
     void failed(const QString& fileName);
@@ -122,6 +130,8 @@ private:
         int chunkIndex,
         const std::optional<nx::Buffer>& data,
         bool decreaseRankOnFailure = true);
+    void handleChunkWritten(int chunkIndex, ResultCode resultCode);
+    void updatePeerStatistics();
 
     void finish(State state = State::finished);
 
@@ -138,9 +148,18 @@ protected:
 
     QSet<Peer> getPeersToCheckInfo() const;
     QList<Peer> getPeersToGetCheksums() const;
-    Peer selectPeerForChunk(int chunk, const QSet<Peer>& busyPeers) const;
+    /**
+     * Selects the fastest peer which has the chunk and has room in its request window.
+     * @return Null peer if all the suitable peers have their windows full.
+     */
+    Peer selectPeerForChunk(int chunk, const QSet<Peer>& excludedPeers = {}) const;
 
     void reviveBannedPeers();
+
+    /**
+     * Selects the chunk which is available from the least number of peers, so the rare chunks are
+     * downloaded while their peers are still online.
+     */
     int selectNextChunk(const QSet<int>& ignoredChunks) const;
 
     bool needToFindBetterPeersForDownload() const;
@@ -171,11 +190,15 @@ private:
     bool m_started = false;
 
     QBitArray m_availableChunks;
+    // Number of peers which have the chunk, not counting the internet peers.
+    QVector<int> m_chunkAvailability;
 
     struct PeerInformation
     {
         static constexpr int kMaxAutoRank = 3;
         static constexpr int kMinAutoRank = 0;
+        static constexpr int kInitialWindow = 2;
+        static constexpr int kMaxWindow = 16;
 
         QBitArray downloadedChunks;
         int rank = kMaxAutoRank / 2;
@@ -186,10 +209,26 @@ private:
         milliseconds averageChunkDownloadTime{0};
         time_point<steady_clock> lastSuccessfulRequestTime{};
 
+        // Number of chunk requests which may be sent to the peer at once. It grows while the
+        // chunk download time stays close to baseChunkDownloadTime, i.e. while the requests are
+        // not queued on the peer side, like the TCP Vegas congestion window does.
+        int window = kInitialWindow;
+        int chunksInFlight = 0;
+        milliseconds baseChunkDownloadTime{0};
+
+        int downloadedChunksCount = 0;
+        int failedRequests = 0;
+        qint64 downloadedBytes = 0;
+        time_point<steady_clock> firstRequestTime{};
+        time_point<steady_clock> lastReplyTime{};
+
         void increaseRank(int value = 1);
         void decreaseRank(int value = 1);
         bool isBanned() const { return rank <= kMinAutoRank; }
+        bool hasFreeWindow() const { return chunksInFlight < window; }
         void recordChunkDownloadTime(milliseconds time);
+        void recordChunkDownloadFailure();
+        double throughputBytesPerSecond() const;
         bool hasChunk(int chunk) const;
     };
     QHash<Peer, PeerInformation> m_peerInfoByPeer;
@@ -200,6 +239,11 @@ private:
 
     QElapsedTimer m_stallDetectionTimer;
     bool m_stalled = false;
+
+    std::unique_ptr<ChunkWriter> m_chunkWriter;
+
+    mutable nx::Mutex m_statisticsMutex;
+    QList<PeerStatistics> m_peerStatistics;
 };
 
 } // namespace nx::vms::common::p2p::downloader
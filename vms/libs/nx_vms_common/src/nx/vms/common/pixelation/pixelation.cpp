@@ -50,6 +50,7 @@ public:
 
     void setSize(const QSize& size);
     void setCaptureImage(bool state) { m_captureImage = state; };
+    bool captureImage() const { return m_captureImage; }
     QImage capturedImage() const { return m_capturedImage; };
 
 protected:
@@ -437,6 +438,10 @@ void PixelationProcess::draw(QRhiResourceUpdateBatch* uploadBatch)
     constexpr int kMaxMaskSize = 2048;
     constexpr int kIterations = 4;
 
+    // Reading the texture back stalls the pipeline, so only the result of the last pass is read.
+    const bool captureImage = this->captureImage();
+    setCaptureImage(false);
+
     for (int i = 0; i < kIterations; ++i)
     {
         const float step = (kIterations - i - 1) * m_intensity * 1.2;
@@ -450,6 +455,8 @@ void PixelationProcess::draw(QRhiResourceUpdateBatch* uploadBatch)
         drawOffscreen(i == 0 ? uploadBatch : nullptr);
 
         m_shaderData.isHorizontalPass = false;
+        if (i == kIterations - 1)
+            setCaptureImage(captureImage);
         drawOffscreen();
     }
 
@@ -471,6 +478,10 @@ struct Pixelation::Private
     std::unique_ptr<QRhiTexture> sourceTexture;
     QPointer<QThread> rhiThread = nullptr;
 
+    /** The mask is redrawn only when the rectangles or the frame size change. */
+    QVector<QRectF> maskRectangles;
+    QSize maskSize;
+
     void initRhi();
     QImage pixelate(const QImage& source, const QVector<QRectF>& rectangles, double intensity);
 };
@@ -514,20 +525,29 @@ QImage Pixelation::Private::pixelate(
     if (!NX_ASSERT(QThread::currentThread() == rhiThread))
         return {};
 
-    mask->setSize(source.size() / kMaskSizeFactor);
-    pixelation->setSize(source.size());
-    pixelation->setCaptureImage(true);
+    if (rectangles.isEmpty())
+        return source;
 
-    mask->clear();
-    for (const auto& rectangle: rectangles)
-        mask->addRectangle(rectangle);
+    const QSize newMaskSize = source.size() / kMaskSizeFactor;
+    if (newMaskSize != maskSize || rectangles != maskRectangles)
+    {
+        mask->setSize(newMaskSize);
+        mask->clear();
+        for (const auto& rectangle: rectangles)
+            mask->addRectangle(rectangle);
+
+        mask->draw();
+        maskSize = newMaskSize;
+        maskRectangles = rectangles;
+    }
 
-    mask->draw();
+    pixelation->setSize(source.size());
+    pixelation->setCaptureImage(true);
 
     const QImage::Format originalFormat = source.format();
     QImage image = source.convertToFormat(QImage::Format_RGBA8888);
     if (rhi->isYUpInFramebuffer())
-        image = source.mirrored();
+        image = image.mirrored();
 
     if (image.size() != sourceTexture->pixelSize())
     {
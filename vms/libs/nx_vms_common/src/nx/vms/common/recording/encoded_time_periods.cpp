@@ -0,0 +1,116 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "encoded_time_periods.h"
+
+#include <limits>
+
+namespace nx::vms::common {
+
+namespace {
+
+static constexpr qint64 kInvalidValue = std::numeric_limits<qint64>::max();
+static constexpr int kStartTimeSize = 6;
+
+qint64 readBigEndian(const quint8*& pos, int size)
+{
+    qint64 value = 0;
+    for (int i = 0; i < size; ++i)
+        value = (value << 8) + *pos++;
+    return value;
+}
+
+// See the field format in QnTimePeriodList::encode().
+qint64 decodeValue(const quint8*& pos, const quint8* end)
+{
+    if (pos >= end)
+        return kInvalidValue;
+    const int fieldSize = 2 + (*pos >> 6);
+    if (end - pos < fieldSize)
+        return kInvalidValue;
+    const qint64 value = (*pos++ & 0x3f);
+    const qint64 field = (value << ((fieldSize - 1) * 8)) + readBigEndian(pos, fieldSize - 1);
+    if (field != 0x3fffffffffll)
+        return field;
+
+    if (end - pos < 6)
+        return kInvalidValue;
+    return readBigEndian(pos, 6);
+}
+
+} // namespace
+
+EncodedTimePeriods::const_iterator::const_iterator(const quint8* pos, const quint8* end):
+    m_pos(pos),
+    m_end(end)
+{
+    if (m_end - m_pos < kStartTimeSize)
+    {
+        finish(/*failed*/ true);
+        return;
+    }
+
+    m_timeMs = readBigEndian(m_pos, kStartTimeSize);
+    readPeriod(/*relativeStartTimeMs*/ 0);
+}
+
+EncodedTimePeriods::const_iterator& EncodedTimePeriods::const_iterator::operator++()
+{
+    // The end of data is where the next period would start.
+    const qint64 relativeStartTimeMs = decodeValue(m_pos, m_end);
+    if (relativeStartTimeMs == kInvalidValue)
+        finish(/*failed*/ false);
+    else
+        readPeriod(relativeStartTimeMs);
+    return *this;
+}
+
+EncodedTimePeriods::const_iterator EncodedTimePeriods::const_iterator::operator++(int)
+{
+    auto result = *this;
+    ++*this;
+    return result;
+}
+
+void EncodedTimePeriods::const_iterator::readPeriod(qint64 relativeStartTimeMs)
+{
+    const qint64 duration = decodeValue(m_pos, m_end);
+    if (duration == kInvalidValue)
+        return finish(/*failed*/ true);
+
+    m_timeMs += relativeStartTimeMs;
+    m_period = QnTimePeriod(m_timeMs, duration - 1);
+    m_timeMs += duration - 1;
+}
+
+void EncodedTimePeriods::const_iterator::finish(bool failed)
+{
+    m_pos = nullptr;
+    m_end = nullptr;
+    m_failed = failed;
+}
+
+EncodedTimePeriods::EncodedTimePeriods(std::string_view data):
+    m_data(data)
+{
+}
+
+EncodedTimePeriods::const_iterator EncodedTimePeriods::begin() const
+{
+    const auto data = (const quint8*) m_data.data();
+    return const_iterator(data, data + m_data.size());
+}
+
+EncodedTimePeriods::const_iterator EncodedTimePeriods::end() const
+{
+    return const_iterator();
+}
+
+bool EncodedTimePeriods::isValid() const
+{
+    auto it = begin();
+    while (it != end())
+        ++it;
+    return !it.isFailed();
+}
+
+} // namespace nx::vms::common
@@ -0,0 +1,75 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+#include <recording/time_period.h>
+
+namespace nx::vms::common {
+
+/**
+ * Read-only view of the time periods encoded by QnTimePeriodList::encode(). The periods are
+ * decoded while iterating, so the data is not copied to a list. E.g., the chunks of several
+ * servers can be merged right from the received buffers with TimePeriods::aggregate().
+ * NOTE: The view does not own the data.
+ */
+class NX_VMS_COMMON_API EncodedTimePeriods
+{
+public:
+    class NX_VMS_COMMON_API const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = QnTimePeriod;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const QnTimePeriod*;
+        using reference = const QnTimePeriod&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return m_period; }
+        pointer operator->() const { return &m_period; }
+
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& other) const { return m_pos == other.m_pos; }
+
+        /**
+         * @return True if the iterator has reached the end because of the malformed data.
+         */
+        bool isFailed() const { return m_failed; }
+
+    private:
+        friend class EncodedTimePeriods;
+
+        const_iterator(const quint8* pos, const quint8* end);
+        void readPeriod(qint64 relativeStartTimeMs);
+        void finish(bool failed);
+
+    private:
+        const quint8* m_pos = nullptr;
+        const quint8* m_end = nullptr;
+        qint64 m_timeMs = 0;
+        QnTimePeriod m_period;
+        bool m_failed = false;
+    };
+
+    EncodedTimePeriods(std::string_view data);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * @return False if the data is malformed. Decodes all the periods without storing them.
+     */
+    bool isValid() const;
+
+private:
+    std::string_view m_data;
+};
+
+} // namespace nx::vms::common
@@ -2,11 +2,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <queue>
+#include <utility>
 #include <vector>
 
-#include <QtCore/QVector>
+#include <QtCore/Qt>
+#include <QtCore/QtGlobal>
 
 namespace nx::vms::common {
 
@@ -20,11 +26,11 @@ public:
         int limit = std::numeric_limits<int>::max(),
         Qt::SortOrder sortOrder = Qt::SortOrder::AscendingOrder)
     {
-        QVector<PeriodList> nonEmptyPeriods;
+        std::vector<const PeriodList*> nonEmptyPeriods;
         for (const PeriodList& periodList: periodLists)
         {
             if (!periodList.empty())
-                nonEmptyPeriods << periodList;
+                nonEmptyPeriods.push_back(&periodList);
         }
 
         if (nonEmptyPeriods.empty())
@@ -32,7 +38,7 @@ public:
 
         if (nonEmptyPeriods.size() == 1)
         {
-            PeriodList result = nonEmptyPeriods.first();
+            PeriodList result = *nonEmptyPeriods.front();
             if ((int) result.size() > limit && limit > 0)
                 result.resize(limit);
             return result;
@@ -43,143 +49,121 @@ public:
             : mergeTimePeriodsDesc(nonEmptyPeriods, limit);
     }
 
+    /**
+     * Merges the ascending sorted ranges of periods (lists or views like EncodedTimePeriods) and
+     * joins the periods with the gaps less than detailLevel in one pass, without building the
+     * intermediate lists. The same as aggregating the merged list.
+     */
+    template<typename Range>
+    static PeriodList aggregate(
+        const std::vector<Range>& ranges,
+        std::chrono::milliseconds detailLevel,
+        int limit = std::numeric_limits<int>::max())
+    {
+        using Iterator = decltype(std::cbegin(ranges.front()));
+        std::vector<std::pair<Iterator, Iterator>> cursors;
+        cursors.reserve(ranges.size());
+        for (const Range& range: ranges)
+            cursors.emplace_back(std::cbegin(range), std::cend(range));
+
+        return mergeSorted(std::move(cursors), limit, std::max(detailLevel, kMinGap));
+    }
+
 private:
-    template <typename IteratorPeriod>
-    static PeriodList mergeTimePeriodsInternal(
-        const QVector<PeriodList>& nonEmptyPeriods,
-        std::vector<IteratorPeriod>&& minIndices,
-        std::vector<IteratorPeriod>&& maxIndices,
-        int limit)
+    /** Merging joins the adjacent periods. */
+    static constexpr std::chrono::milliseconds kMinGap{1};
+
+    /**
+     * K-way merge with a heap of the range heads, O(N log K). Each range is to be sorted by the
+     * start time.
+     */
+    template<typename Iterator>
+    static PeriodList mergeSorted(
+        std::vector<std::pair<Iterator, Iterator>> cursors,
+        int limit,
+        std::chrono::milliseconds gap,
+        size_t reserve = 0)
     {
         if (limit <= 0)
             limit = std::numeric_limits<int>::max();
 
-        PeriodList result;
-
-        int maxSize = std::min<int>(
-            limit,
-            std::max_element(
-                nonEmptyPeriods.cbegin(),
-                nonEmptyPeriods.cend(),
-                [](const PeriodList& l, const PeriodList& r)
-                {
-                    return l.size() < r.size();
-                })->size()
-            );
-        result.reserve(maxSize);
+        // The range index breaks the ties, so the result does not depend on the heap order.
+        using Head = std::pair<std::chrono::milliseconds, size_t>;
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+        for (size_t i = 0; i < cursors.size(); ++i)
+        {
+            if (cursors[i].first != cursors[i].second)
+                heads.emplace(cursors[i].first->startTime(), i);
+        }
 
-        int minIndex = 0;
-        while (minIndex != -1)
+        PeriodList result;
+        result.reserve(std::min(reserve, (size_t) limit));
+        while (!heads.empty())
         {
-            auto minStartTime = std::chrono::milliseconds(Period::kMaxTimeValue);
-            minIndex = -1;
-            for (int i = 0; i < nonEmptyPeriods.size(); ++i)
-            {
-                const auto startIdx = minIndices[i];
+            const size_t index = heads.top().second;
+            heads.pop();
+            auto& [current, end] = cursors[index];
+            const Period period = *current;
 
-                if (startIdx != maxIndices[i])
+            if (!result.empty()
+                && period.startTime() < result.back().startTime() + result.back().duration() + gap)
+            {
+                Period& last = result.back();
+                if (period.isInfinite())
                 {
-                    const Period& startPeriod = *startIdx;
-                    if (startPeriod.startTime() < minStartTime)
-                    {
-                        minIndex = i;
-                        minStartTime = startPeriod.startTime();
-                    }
+                    // Last element is live and starts before all of rest - no need to process
+                    // other elements.
+                    last.resetDuration();
+                    return result;
                 }
-            }
 
-            if (minIndex >= 0)
+                last.setDuration(qMax(
+                    last.duration(),
+                    period.startTime() + period.duration() - last.startTime()));
+            }
+            else
             {
-                auto& startIdx = minIndices[minIndex];
-                const Period& startPeriod = *startIdx;
+                if ((int) result.size() >= limit)
+                    return result;
 
-                // Add chunk to merged data.
-                if (result.empty())
-                {
-                    if ((int) result.size() >= limit)
-                        return result;
-
-                    result.push_back(startPeriod);
-                    if (startPeriod.isInfinite())
-                        return result;
-                }
-                else
-                {
-                    Period& last = result.back();
-                    NX_ASSERT(
-                        last.startTime() <= startPeriod.startTime(),
-                        "Algorithm semantics failure, order failed");
-                    if (startPeriod.isInfinite())
-                    {
-                        NX_ASSERT(!last.isInfinite(), "This should never happen");
-                        if (last.isInfinite())
-                        {
-                            last.startTime() = qMin(last.startTime(), startPeriod.startTime());
-                        }
-                        else if (startPeriod.startTime() > last.startTime() + last.duration())
-                        {
-                            if ((int) result.size() >= limit)
-                                return result;
-                            result.push_back(startPeriod);
-                        }
-                        else
-                        {
-                            last.resetDuration();
-                        }
-                        // Last element is live and starts before all of rest - no need to process other elements.
-                        return result;
-                    }
-                    else if (last.startTime() <= minStartTime
-                        && last.startTime() + last.duration() >= minStartTime)
-                    {
-                        last.setDuration(qMax(
-                            last.duration(),
-                            minStartTime + startPeriod.duration() - last.startTime()));
-                    }
-                    else
-                    {
-                        if ((int) result.size() >= limit)
-                            return result;
-
-                        result.push_back(startPeriod);
-                    }
-                }
-                startIdx++;
+                result.push_back(period);
+                if (period.isInfinite())
+                    return result;
             }
+
+            if (++current != end)
+                heads.emplace(current->startTime(), index);
         }
         return result;
     }
 
-    static PeriodList mergeTimePeriodsAsc(const QVector<PeriodList>& nonEmptyPeriods, int limit)
+    static size_t maxSize(const std::vector<const PeriodList*>& periodLists)
     {
-        std::vector<typename PeriodList::const_iterator> minIndices(nonEmptyPeriods.size());
-        std::vector<typename PeriodList::const_iterator> endIndices(nonEmptyPeriods.size());
-        for (int i = 0; i < nonEmptyPeriods.size(); ++i)
-        {
-            minIndices[i] = nonEmptyPeriods[i].cbegin();
-            endIndices[i] = nonEmptyPeriods[i].cend();
-        }
-        return mergeTimePeriodsInternal<typename PeriodList::const_iterator>(
-            nonEmptyPeriods,
-            std::move(minIndices),
-            std::move(endIndices),
-            limit);
+        size_t result = 0;
+        for (const PeriodList* periodList: periodLists)
+            result = std::max(result, (size_t) periodList->size());
+        return result;
     }
 
-    static PeriodList mergeTimePeriodsDesc(const QVector<PeriodList>& nonEmptyPeriods, int limit)
+    static PeriodList mergeTimePeriodsAsc(
+        const std::vector<const PeriodList*>& nonEmptyPeriods, int limit)
     {
-        std::vector<typename PeriodList::const_reverse_iterator> minIndexes(nonEmptyPeriods.size());
-        std::vector<typename PeriodList::const_reverse_iterator> endIndexes(nonEmptyPeriods.size());
-        for (int i = 0; i < nonEmptyPeriods.size(); ++i)
-        {
-            minIndexes[i] = nonEmptyPeriods[i].crbegin();
-            endIndexes[i] = nonEmptyPeriods[i].crend();
-        }
-        auto result = mergeTimePeriodsInternal<typename PeriodList::const_reverse_iterator>(
-            nonEmptyPeriods,
-            std::move(minIndexes),
-            std::move(endIndexes),
-            std::numeric_limits<int>::max());
+        std::vector<std::pair<typename PeriodList::const_iterator,
+            typename PeriodList::const_iterator>> cursors;
+        for (const PeriodList* periodList: nonEmptyPeriods)
+            cursors.emplace_back(periodList->cbegin(), periodList->cend());
+        return mergeSorted(std::move(cursors), limit, kMinGap, maxSize(nonEmptyPeriods));
+    }
+
+    static PeriodList mergeTimePeriodsDesc(
+        const std::vector<const PeriodList*>& nonEmptyPeriods, int limit)
+    {
+        std::vector<std::pair<typename PeriodList::const_reverse_iterator,
+            typename PeriodList::const_reverse_iterator>> cursors;
+        for (const PeriodList* periodList: nonEmptyPeriods)
+            cursors.emplace_back(periodList->crbegin(), periodList->crend());
+        auto result = mergeSorted(std::move(cursors), std::numeric_limits<int>::max(), kMinGap,
+            maxSize(nonEmptyPeriods));
         if (limit > 0 && (int) result.size() > limit)
             result.erase(result.begin(), result.begin() + (result.size() - limit));
         std::reverse(result.begin(), result.end());
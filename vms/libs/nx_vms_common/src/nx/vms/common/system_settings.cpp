@@ -2,6 +2,7 @@
 
 #include "system_settings.h"
 
+#include <atomic>
 #include <chrono>
 
 #include <api/resource_property_adaptor.h>
@@ -15,6 +16,7 @@
 #include <nx/network/socket_global.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/thread/mutex.h>
+#include <nx/utils/thread/read_epoch.h>
 #include <nx/utils/value_cache.h>
 #include <nx/vms/api/data/backup_settings.h>
 #include <nx/vms/api/data/email_settings.h>
@@ -26,6 +28,7 @@
 #include <nx/vms/api/types/proxy_connection_access_policy.h>
 #include <nx/vms/common/saas/saas_service_manager.h>
 #include <nx/vms/common/system_context.h>
+#include <nx/vms/common/system_settings_snapshot.h>
 #include <nx_ec/abstract_ec_connection.h>
 #include <nx_ec/managers/abstract_misc_manager.h>
 #include <utils/email/email.h>
@@ -36,6 +39,9 @@ namespace {
 
 static constexpr seconds kDefaultSessionLimit = 30 * 24h;
 
+/** Shared by all the instances, so a snapshot version is never reused. */
+std::atomic<uint64_t> lastSnapshotVersion{0};
+
 QSet<QString> parseDisabledVendors(const QString& disabledVendors)
 {
     QStringList disabledVendorList;
@@ -252,6 +258,22 @@ struct SystemSettings::Private
 
     nx::utils::CachedValue<std::string> serverHeaderCache{
         [this] { return makeServerHeaderValue(serverHeaderAdaptor->value()); }};
+
+    using SnapshotPtr = std::shared_ptr<const SystemSettingsSnapshot>;
+
+    /**
+     * The readers copy the published pointer under snapshotEpoch, the replaced one is deleted
+     * after they have left it. Not under the main mutex: the snapshot is updated from the
+     * adaptor signals emitted while it is locked in initialize().
+     */
+    std::atomic<const SnapshotPtr*> snapshot{nullptr};
+    nx::utils::ReadEpoch snapshotEpoch;
+    nx::Mutex snapshotMutex;
+
+    ~Private()
+    {
+        delete snapshot.load();
+    }
 };
 
 SystemSettings::SystemSettings(SystemContext* context, QObject* parent):
@@ -289,6 +311,35 @@ SystemSettings::SystemSettings(SystemContext* context, QObject* parent):
     connect(resourcePool(), &QnResourcePool::resourceRemoved, this,
         &SystemSettings::at_resourcePool_resourceRemoved, Qt::DirectConnection);
 
+    const std::initializer_list<QnAbstractResourcePropertyAdaptor*> snapshotAdaptors = {
+        d->watermarkSettingsAdaptor,
+        d->pixelationSettingsAdaptor,
+        d->sessionLimitSAdaptor,
+        d->useSessionLimitForCloudAdaptor,
+        d->sessionsLimitAdaptor,
+        d->sessionsLimitPerUserAdaptor,
+        d->remoteSessionTimeoutSAdaptor,
+        d->remoteSessionUpdateSAdaptor,
+        d->insecureDeprecatedApiEnabledAdaptor,
+        d->trafficEncryptionForcedAdaptor,
+        d->videoTrafficEncryptionForcedAdaptor,
+        d->securityForPowerUsersAdaptor,
+        d->maxHttpTranscodingSessionsAdaptor,
+        d->maxRtspConnectDurationSecondsAdaptor,
+        d->maxRecordQueueSizeBytesAdaptor,
+        d->maxRecordQueueSizeElementsAdaptor,
+        d->maxP2pQueueSizeBytesAdaptor,
+        d->rtpTimeoutMsAdaptor,
+        d->serverHeaderAdaptor,
+        d->frameOptionsHeaderAdaptor,
+    };
+    for (const auto adaptor: snapshotAdaptors)
+    {
+        connect(adaptor, &QnAbstractResourcePropertyAdaptor::valueChanged,
+            this, &SystemSettings::updateSnapshot, Qt::DirectConnection);
+    }
+    updateSnapshot();
+
     initialize();
 
     d->settingNames.reserve(d->allAdaptors.size());
@@ -325,6 +376,51 @@ bool SystemSettings::isInitialized() const
     return !d->admin.isNull();
 }
 
+std::shared_ptr<const SystemSettingsSnapshot> SystemSettings::snapshot() const
+{
+    const auto guard = d->snapshotEpoch.read();
+    return *d->snapshot.load(std::memory_order_acquire);
+}
+
+void SystemSettings::updateSnapshot()
+{
+    NX_MUTEX_LOCKER locker(&d->snapshotMutex);
+
+    auto snapshot = std::make_shared<SystemSettingsSnapshot>(SystemSettingsSnapshot{
+        .version = ++lastSnapshotVersion,
+        .watermarkSettings = watermarkSettings(),
+        .pixelationSettings = pixelationSettings(),
+        .sessionTimeoutLimit = sessionTimeoutLimit(),
+        .useSessionTimeoutLimitForCloud = useSessionTimeoutLimitForCloud(),
+        .sessionsLimit = sessionsLimit(),
+        .sessionsLimitPerUser = sessionsLimitPerUser(),
+        .remoteSessionTimeout = remoteSessionTimeout(),
+        .remoteSessionUpdate = remoteSessionUpdate(),
+        .insecureDeprecatedApiEnabled = isInsecureDeprecatedApiEnabled(),
+        .trafficEncryptionForced = isTrafficEncryptionForced(),
+        .videoTrafficEncryptionForced = isVideoTrafficEncryptionForced(),
+        .securityForPowerUsers = securityForPowerUsers(),
+        .maxHttpTranscodingSessions = maxHttpTranscodingSessions(),
+        .maxRtspConnectDuration = maxRtspConnectDuration(),
+        .maxRecorderQueueSizeBytes = maxRecorderQueueSizeBytes(),
+        .maxRecorderQueueSizePackets = maxRecorderQueueSizePackets(),
+        .maxP2pQueueSizeBytes = maxP2pQueueSizeBytes(),
+        .rtpFrameTimeoutMs = rtpFrameTimeoutMs(),
+        .serverHeader = makeServerHeader(),
+        .frameOptionsHeader = frameOptionsHeader(),
+    });
+    const auto version = snapshot->version;
+
+    std::unique_ptr<const Private::SnapshotPtr> oldSnapshot(d->snapshot.exchange(
+        new Private::SnapshotPtr(std::move(snapshot)), std::memory_order_acq_rel));
+    d->snapshotEpoch.synchronize();
+    oldSnapshot.reset();
+    locker.unlock();
+
+    NX_VERBOSE(this, "Snapshot %1 is published", version);
+    emit snapshotChanged(version);
+}
+
 SystemSettings::AdaptorList SystemSettings::initEmailAdaptors()
 {
     const auto isValid =
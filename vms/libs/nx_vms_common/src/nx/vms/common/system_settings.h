@@ -3,6 +3,7 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include <optional>
 #include <set>
 #include <unordered_set>
@@ -40,6 +41,8 @@ enum class SystemSettingName;
 
 namespace nx::vms::common {
 
+struct SystemSettingsSnapshot;
+
 struct SystemSettingNames
 {
     #define DECLARE_SETTING_NAME(NAME) static const inline QString NAME = NX_FMT( #NAME )
@@ -152,6 +155,13 @@ public:
     /** Check if global settings are ready to use. */
     bool isInitialized() const;
 
+    /**
+     * @return The current values of the frequently read settings. Nothing is locked and no
+     * QVariant is converted: the snapshot is made when one of its settings changes, and the
+     * returned one is never modified. Thread-safe. See system_settings_snapshot.h.
+     */
+    std::shared_ptr<const SystemSettingsSnapshot> snapshot() const;
+
     void synchronizeNow();
 
     /**
@@ -609,6 +619,12 @@ signals:
     void cloudPollingIntervalChanged();
     void allowRegisteringIntegrationsChanged();
 
+    /**
+     * Emitted after a new snapshot is made. The version is the one of the new snapshot. Direct
+     * connections are invoked in the thread that changed the setting.
+     */
+    void snapshotChanged(quint64 version);
+
 private:
     typedef QList<QnAbstractResourcePropertyAdaptor*> AdaptorList;
 
@@ -621,6 +637,8 @@ private:
 
     void at_resourcePool_resourceRemoved(const QnResourcePtr& resource);
 
+    void updateSnapshot();
+
 private:
     struct Private;
     nx::utils::ImplPtr<Private> d;
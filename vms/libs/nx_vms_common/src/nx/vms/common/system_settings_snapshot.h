@@ -0,0 +1,56 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <QtCore/QString>
+
+#include <nx/vms/api/data/pixelation_settings.h>
+#include <nx/vms/api/data/watermark_settings.h>
+
+namespace nx::vms::common {
+
+/**
+ * Immutable copy of the system settings that are read per request or per frame. Each field has
+ * the value of the SystemSettings getter of the same name at the moment the snapshot was made.
+ */
+struct SystemSettingsSnapshot
+{
+    /**
+     * Increases with every snapshot made by any SystemSettings instance, so the snapshots of the
+     * same instance can be ordered and a changed snapshot can be told apart by the version alone.
+     */
+    uint64_t version = 0;
+
+    nx::vms::api::WatermarkSettings watermarkSettings;
+    nx::vms::api::PixelationSettings pixelationSettings;
+
+    std::optional<std::chrono::seconds> sessionTimeoutLimit;
+    bool useSessionTimeoutLimitForCloud = false;
+    int sessionsLimit = 0;
+    int sessionsLimitPerUser = 0;
+    std::chrono::seconds remoteSessionTimeout{0};
+    std::chrono::seconds remoteSessionUpdate{0};
+
+    bool insecureDeprecatedApiEnabled = false;
+    bool trafficEncryptionForced = false;
+    bool videoTrafficEncryptionForced = false;
+    bool securityForPowerUsers = false;
+
+    int maxHttpTranscodingSessions = 0;
+    std::chrono::seconds maxRtspConnectDuration{0};
+    int maxRecorderQueueSizeBytes = 0;
+    int maxRecorderQueueSizePackets = 0;
+    int maxP2pQueueSizeBytes = 0;
+    int rtpFrameTimeoutMs = 0;
+
+    /** The value of SystemSettings::makeServerHeader(). */
+    std::string serverHeader;
+    QString frameOptionsHeader;
+};
+
+} // namespace nx::vms::common
@@ -2,6 +2,9 @@
 
 #include "event_cache.h"
 
+#include <nx/utils/log/log.h>
+#include <nx/utils/time.h>
+
 namespace nx::vms::event {
 
 namespace {
@@ -10,43 +13,113 @@ static const std::chrono::seconds kObjectDetectedProcessingTimeout(1);
 
 } // namespace
 
+EventCache::EventCache(size_t maxSize):
+    m_maxSize(std::max<size_t>(maxSize, 1))
+{
+}
+
 void EventCache::cleanupOldEventsFromCache(std::chrono::milliseconds timeout)
 {
     if (!m_cleanupTimer.hasExpired(timeout))
         return;
     m_cleanupTimer.restart();
 
-    std::erase_if(
-        m_previousEvents,
-        [timeout](const auto& pair) { return pair.second.lastEvent.hasExpired(timeout); });
+    // The queues are ordered by the last occurrence, so only the expired events are visited.
+    const auto now = nx::utils::monotonicTime();
+    const size_t oldSize = m_previousEvents.size();
+    for (auto queue: {&m_notReported, &m_reported})
+    {
+        while (!queue->empty()
+            && now - m_previousEvents.find(queue->front())->second.lastEvent >= timeout)
+        {
+            erase(queue);
+        }
+    }
+
+    m_expiredCount += oldSize - m_previousEvents.size();
+    NX_VERBOSE(this, "Removed %1 expired events, %2 events left",
+        oldSize - m_previousEvents.size(), m_previousEvents.size());
+}
+
+EventCache::Statistics EventCache::statistics() const
+{
+    return {
+        .size = m_previousEvents.size(),
+        .reportedCount = m_reported.size(),
+        .expiredCount = m_expiredCount,
+        .evictedCount = m_evictedCount,
+    };
 }
 
 bool EventCache::isReportedBefore(const QString& eventKey) const
 {
-    auto it = m_previousEvents.find(eventKey);
-    return it != m_previousEvents.end() && it->second.lastReported.isValid();
+    const auto entry = find(eventKey);
+    return entry && entry->lastReported;
 }
 
 bool EventCache::isReportedRecently(const QString& eventKey) const
 {
-    const auto it = m_previousEvents.find(eventKey);
-    return it != m_previousEvents.end()
-        && !it->second.lastReported.hasExpired(kObjectDetectedProcessingTimeout);
+    const auto entry = find(eventKey);
+    return entry && entry->lastReported
+        && nx::utils::monotonicTime() - *entry->lastReported < kObjectDetectedProcessingTimeout;
 }
 
 nx::vms::api::AnalyticsTrackContext* EventCache::rememberEvent(const QString& eventKey)
 {
     cleanupOldEventsFromCache();
-    auto& data = m_previousEvents[eventKey];
-    data.lastEvent.restart();
-    return &data;
+    return &touch(eventKey).context;
 }
 
 void EventCache::reportEvent(const QString& eventKey)
 {
     if (eventKey.isEmpty())
         return;
-    m_previousEvents[eventKey].lastReported.restart();
+
+    auto& entry = touch(eventKey);
+    if (!entry.lastReported)
+        m_reported.splice(m_reported.end(), m_notReported, entry.position);
+    entry.lastReported = entry.lastEvent;
+}
+
+const EventCache::Entry* EventCache::find(const QString& eventKey) const
+{
+    const auto it = m_previousEvents.find(eventKey.toUtf8());
+    return it != m_previousEvents.end() ? &it->second : nullptr;
+}
+
+EventCache::Entry& EventCache::touch(const QString& eventKey)
+{
+    const QByteArray key = eventKey.toUtf8();
+    auto it = m_previousEvents.find(key);
+    if (it == m_previousEvents.end())
+    {
+        // The events which have never been reported do not suppress anything, so they are
+        // evicted first.
+        if (m_previousEvents.size() >= m_maxSize)
+        {
+            if (m_evictedCount == 0)
+                NX_DEBUG(this, "The cache size limit %1 is reached", m_maxSize);
+            erase(m_notReported.empty() ? &m_reported : &m_notReported);
+            ++m_evictedCount;
+        }
+
+        it = m_previousEvents.emplace(key, Entry()).first;
+        it->second.position = m_notReported.insert(m_notReported.end(), it->first);
+    }
+    else
+    {
+        auto& queue = it->second.lastReported ? m_reported : m_notReported;
+        queue.splice(queue.end(), queue, it->second.position);
+    }
+
+    it->second.lastEvent = nx::utils::monotonicTime();
+    return it->second;
+}
+
+void EventCache::erase(Queue* queue)
+{
+    m_previousEvents.erase(queue->front());
+    queue->pop_front();
 }
 
 } // namespace nx::vms::event
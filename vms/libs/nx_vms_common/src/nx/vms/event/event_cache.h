@@ -2,9 +2,12 @@
 
 #pragma once
 
-#include <set>
+#include <chrono>
+#include <list>
+#include <map>
+#include <optional>
 
-#include <QtCore/QHash>
+#include <QtCore/QByteArray>
 
 #include <nx/utils/elapsed_timer.h>
 #include <nx/utils/uuid.h>
@@ -12,17 +15,32 @@
 
 namespace nx::vms::event {
 
-// Event key to timer map.
-struct NX_VMS_COMMON_API LastEventData: public nx::vms::api::AnalyticsTrackContext
-{
-    nx::utils::ElapsedTimer lastEvent{ nx::utils::ElapsedTimerState::started };
-    nx::utils::ElapsedTimer lastReported{ nx::utils::ElapsedTimerState::invalid };
-};
-
-/** Simple cache to discard frequent duplicate events. */
+/**
+ * Simple cache to discard frequent duplicate events.
+ *
+ * The number of the remembered events is limited, so an event storm does not make the cache grow
+ * unbounded. When the limit is exceeded, the events which have never been reported are evicted
+ * first, as they do not suppress anything, and then the reported ones, the oldest first.
+ */
 class NX_VMS_COMMON_API EventCache
 {
 public:
+    static constexpr size_t kDefaultMaxSize = 100'000;
+
+    struct Statistics
+    {
+        size_t size = 0;
+        size_t reportedCount = 0;
+
+        /** Number of the events removed due to the timeout. */
+        size_t expiredCount = 0;
+
+        /** Number of the events removed before the timeout due to the size limit. */
+        size_t evictedCount = 0;
+    };
+
+    explicit EventCache(size_t maxSize = kDefaultMaxSize);
+
     nx::vms::api::AnalyticsTrackContext* rememberEvent(const QString& eventKey);
     void reportEvent(const QString& eventKey);
 
@@ -31,9 +49,37 @@ public:
 
     void cleanupOldEventsFromCache(std::chrono::milliseconds timeout = std::chrono::seconds(60));
 
+    Statistics statistics() const;
+
+private:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /** Keys of the events in the order of their last occurrence. */
+    using Queue = std::list<QByteArray>;
+
+    struct Entry
+    {
+        nx::vms::api::AnalyticsTrackContext context;
+        TimePoint lastEvent;
+        std::optional<TimePoint> lastReported;
+        Queue::iterator position;
+    };
+
+    const Entry* find(const QString& eventKey) const;
+    Entry& touch(const QString& eventKey);
+    void erase(Queue* queue);
+
 private:
-    std::map<QString, LastEventData> m_previousEvents;
+    const size_t m_maxSize;
+
+    /** The map keys share the data with the queue items, so each key is stored once. */
+    std::map<QByteArray, Entry> m_previousEvents;
+    Queue m_notReported;
+    Queue m_reported;
+
     nx::utils::ElapsedTimer m_cleanupTimer;
+    size_t m_expiredCount = 0;
+    size_t m_evictedCount = 0;
 };
 
 } // namespace nx::vms::event
@@ -4,11 +4,11 @@
 #include <string>
 
 #include "abstract_metadata_binary_file.h"
-#include "qfile_metadata_binary_file.h"
+#include "mmap_metadata_binary_file.h"
 
 namespace nx::vms::metadata {
 
-MetadataBinaryFileFactory::MetadataBinaryFileFactory(): base_type([]() { return std::make_unique<QFileMetadataBinaryFile>(); })
+MetadataBinaryFileFactory::MetadataBinaryFileFactory(): base_type([]() { return std::make_unique<MmapMetadataBinaryFile>(); })
 {
 }
 
@@ -26,6 +26,12 @@ public:
     virtual int64_t size() const = 0;
     virtual int64_t write(const char* buffer, qint64 count) = 0;
     virtual bool flush() = 0;
+
+    /**
+     * @return The data of the file, opened read-only, accessible without copying, or null if the
+     *     range is not mapped to the memory. The data is valid until the file is closed.
+     */
+    virtual const char* mappedData(int64_t /*offset*/, int64_t /*size*/) { return nullptr; }
 };
 
 using MetadataBinaryFileFactoryFunc = std::unique_ptr<AbstractMetadataBinaryFile>();
@@ -0,0 +1,78 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "mmap_metadata_binary_file.h"
+
+#include <algorithm>
+
+#if defined(Q_OS_UNIX)
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#include <nx/utils/log/log.h>
+
+namespace nx::vms::metadata {
+
+void MmapMetadataBinaryFile::close()
+{
+    unmap();
+    QFileMetadataBinaryFile::close();
+}
+
+bool MmapMetadataBinaryFile::openReadOnly()
+{
+    if (!QFileMetadataBinaryFile::openReadOnly())
+        return false;
+
+    // The file which can not be mapped is read through QFile.
+    const int64_t fileSize = m_file.size();
+    if (fileSize > 0)
+        m_data = m_file.map(0, fileSize);
+    if (m_data)
+        m_mappedSize = fileSize;
+    else if (fileSize > 0)
+        NX_DEBUG(this, "Failed to map file %1: %2", m_file.fileName(), m_file.errorString());
+    return true;
+}
+
+const char* MmapMetadataBinaryFile::mappedData(int64_t offset, int64_t size)
+{
+    if (!m_data || offset < 0 || size <= 0 || offset + size > m_mappedSize)
+        return nullptr;
+
+    prefetch(offset, size);
+    if (m_lastOffset >= 0 && offset > m_lastOffset)
+        prefetch(offset + size, size);
+    else if (offset < m_lastOffset)
+        prefetch(offset - size, size);
+    m_lastOffset = offset;
+
+    return (const char*) m_data + offset;
+}
+
+void MmapMetadataBinaryFile::unmap()
+{
+    if (m_data)
+        m_file.unmap(m_data);
+    m_data = nullptr;
+    m_mappedSize = 0;
+    m_lastOffset = -1;
+}
+
+void MmapMetadataBinaryFile::prefetch(int64_t offset, int64_t size)
+{
+    #if defined(Q_OS_UNIX)
+        static const int64_t kPageSize = sysconf(_SC_PAGESIZE);
+
+        // The mapping starts from the beginning of the file, so it is aligned to the page.
+        const int64_t begin = std::max<int64_t>(offset, 0) / kPageSize * kPageSize;
+        const int64_t end = std::min(offset + size, m_mappedSize);
+        if (begin < end)
+            madvise(m_data + begin, end - begin, MADV_WILLNEED);
+    #else
+        (void) offset;
+        (void) size;
+    #endif
+}
+
+} // namespace nx::vms::metadata
@@ -0,0 +1,31 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include "qfile_metadata_binary_file.h"
+
+namespace nx::vms::metadata {
+
+/**
+ * The file, opened read-only, is mapped to the memory, so the records are matched directly on the
+ * mapped pages. The pages of the requested range, and of the adjacent range in the direction of
+ * the scan, are read ahead via madvise(). The writes go through QFile.
+ */
+class NX_VMS_COMMON_API MmapMetadataBinaryFile: public QFileMetadataBinaryFile
+{
+public:
+    void close() override;
+    bool openReadOnly() override;
+    const char* mappedData(int64_t offset, int64_t size) override;
+
+private:
+    void unmap();
+    void prefetch(int64_t offset, int64_t size);
+
+private:
+    uchar* m_data = nullptr;
+    int64_t m_mappedSize = 0;
+    int64_t m_lastOffset = -1;
+};
+
+} // namespace nx::vms::metadata
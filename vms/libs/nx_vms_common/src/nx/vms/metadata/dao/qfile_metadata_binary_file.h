@@ -24,7 +24,7 @@ public:
     int64_t write(const char* buffer, qint64 count) override;
     bool flush() override;
 
-private:
+protected:
     QFile m_file;
 };
 
@@ -2,9 +2,17 @@
 
 #include "metadata_archive.h"
 
+#include <atomic>
+#include <optional>
+
 #include <QtCore/QDir>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 
+#include <nx/media/motion_mask.h>
 #include <nx/media/sse_helper.h>
+#include <nx/streaming/nx_streaming_ini.h>
+#include <nx/utils/concurrent.h>
 #include <nx/utils/log/log_main.h>
 #include <nx/utils/math/math.h>
 #include <nx/utils/scope_guard.h>
@@ -20,6 +28,21 @@ static const int kReadBufferSize = 1024 * 256;
 static const int kAlignment = 16;
 static const int kIndexRecordSize = sizeof(IndexRecord);
 static const int kMetadataIndexHeaderSize = sizeof(IndexHeader);
+static const qint64 kSearchTaskIntervalMs = 3600 * 1000;
+static const int kMinSearchTaskRecords = 1024;
+
+QThreadPool* searchThreadPool()
+{
+    static QThreadPool* const pool =
+        []()
+        {
+            const auto pool = new QThreadPool();
+            const int threadCount = nxStreamingIni().metadataSearchThreads;
+            pool->setMaxThreadCount(threadCount > 0 ? threadCount : QThread::idealThreadCount());
+            return pool;
+        }();
+    return pool;
+}
 
 bool resizeFile(AbstractMetadataBinaryFile* file, qint64 size)
 {
@@ -28,6 +51,30 @@ bool resizeFile(AbstractMetadataBinaryFile* file, qint64 size)
     return file->resize(size);
 }
 
+/**
+ * Provides the data of the file range without copying if the file is mapped to the memory,
+ * otherwise reads it to the buffer.
+ * @return Number of the bytes available.
+ */
+int readData(
+    AbstractMetadataBinaryFile* file,
+    qint64 offset,
+    int size,
+    nx::utils::ByteArray* buffer,
+    const quint8** data)
+{
+    if (const char* mappedData = file->mappedData(offset, size))
+    {
+        *data = (const quint8*) mappedData;
+        return size;
+    }
+
+    buffer->reserve(size);
+    *data = (const quint8*) buffer->data();
+    file->seek(offset);
+    return file->read(buffer->data(), size);
+}
+
 inline bool checkPeriod(const Filter* filter, qint64 startTimeMs, qint32 durationMs)
 {
     return startTimeMs <= filter->endTime.count()
@@ -99,6 +146,12 @@ qint64 Index::extraRecordSize(int index) const
     return records[index].extraWords * header.wordSize;
 }
 
+qint64 Index::recordDataSize(int index, bool noGeometryMode) const
+{
+    const int baseRecordSize = noGeometryMode ? header.noGeometryRecordSize() : header.recordSize;
+    return (baseRecordSize + extraRecordSize(index)) * records[index].recordCount();
+}
+
 void Index::reset()
 {
     records.clear();
@@ -208,6 +261,131 @@ bool Index::load(AbstractMetadataBinaryFile& indexFile)
     return read == sizeInBytes;
 }
 
+//-------------------------------------------------------------------------------------------------
+
+static_assert(kGeometrySize == nx::media::motion_mask::kGridSizeBytes);
+
+bool SummaryIndex::load(AbstractMetadataBinaryFile& file)
+{
+    m_minutes.clear();
+    m_hours.clear();
+
+    file.seek(0);
+    if (file.read((char*) &m_header, sizeof(Header)) != sizeof(Header)
+        || m_header.version != Header().version)
+    {
+        NX_VERBOSE(this, "Failed to load summary file %1", file.fileName());
+        return false;
+    }
+
+    std::vector<Record> records((file.size() - sizeof(Header)) / sizeof(Record));
+    const int64_t sizeInBytes = records.size() * sizeof(Record);
+    if (sizeInBytes > 0 && file.read((char*) records.data(), sizeInBytes) != sizeInBytes)
+    {
+        NX_VERBOSE(this, "Failed to load summary file %1", file.fileName());
+        return false;
+    }
+
+    for (const auto& record: records)
+    {
+        auto& minuteRecord = m_minutes[record.minute];
+        minuteRecord.minute = record.minute;
+        addGrid(&minuteRecord, record.grid);
+
+        const quint32 hour = record.minute / kMinutesPerHour;
+        auto& hourRecord = m_hours[hour];
+        hourRecord.minute = hour * kMinutesPerHour;
+        addGrid(&hourRecord, record.grid);
+    }
+    return true;
+}
+
+bool SummaryIndex::openForAppend(AbstractMetadataBinaryFile* file, const Index& index)
+{
+    m_file = file;
+    m_hasLastRecord = false;
+
+    if (file->size() == 0)
+    {
+        m_header = Header();
+        if (!index.records.isEmpty())
+            m_header.coveredFromMs = (index.records.last().start / kMinuteMs + 1) * kMinuteMs;
+        file->seek(0);
+        return file->write((const char*) &m_header, sizeof(Header)) == sizeof(Header);
+    }
+
+    file->seek(0);
+    if (file->read((char*) &m_header, sizeof(Header)) != sizeof(Header)
+        || m_header.version != Header().version)
+    {
+        return false;
+    }
+
+    // The record, which has been written partially, is dropped.
+    const int64_t recordCount = (file->size() - sizeof(Header)) / sizeof(Record);
+    const int64_t fileSize = sizeof(Header) + recordCount * sizeof(Record);
+    if (!resizeFile(file, fileSize))
+        return false;
+
+    if (recordCount > 0)
+    {
+        file->seek(fileSize - sizeof(Record));
+        if (file->read((char*) &m_lastRecord, sizeof(Record)) != sizeof(Record))
+            return false;
+        m_hasLastRecord = true;
+    }
+    return file->seek(fileSize);
+}
+
+bool SummaryIndex::append(quint32 startMs, const char* data, int recordCount, int recordSize)
+{
+    const quint32 minute = startMs / kMinuteMs;
+    qint64 offset = m_file->size();
+    if (m_hasLastRecord && m_lastRecord.minute == minute)
+    {
+        offset -= sizeof(Record);
+    }
+    else
+    {
+        m_lastRecord = Record();
+        m_lastRecord.minute = minute;
+        m_hasLastRecord = true;
+    }
+
+    for (int i = 0; i < recordCount; ++i)
+        nx::media::motion_mask::unite(m_lastRecord.grid, data + i * recordSize);
+    m_lastRecord.cellCount = nx::media::motion_mask::cellCount(m_lastRecord.grid);
+
+    // The summary reaches the file before the index does.
+    return m_file->seek(offset)
+        && m_file->write((const char*) &m_lastRecord, sizeof(Record)) == sizeof(Record)
+        && m_file->flush();
+}
+
+const SummaryIndex::Record* SummaryIndex::minuteRecord(quint32 minute) const
+{
+    if (minute * kMinuteMs < m_header.coveredFromMs)
+        return nullptr;
+    const auto it = m_minutes.find(minute);
+    return it != m_minutes.end() ? &it->second : nullptr;
+}
+
+const SummaryIndex::Record* SummaryIndex::hourRecord(quint32 hour) const
+{
+    if (hour * kMinutesPerHour * kMinuteMs < m_header.coveredFromMs)
+        return nullptr;
+    const auto it = m_hours.find(hour);
+    return it != m_hours.end() ? &it->second : nullptr;
+}
+
+void SummaryIndex::addGrid(Record* record, const void* grid)
+{
+    nx::media::motion_mask::unite(record->grid, grid);
+    record->cellCount = nx::media::motion_mask::cellCount(record->grid);
+}
+
+//-------------------------------------------------------------------------------------------------
+
 MetadataArchive::MetadataArchive(
     const QString& filePrefix,
     int baseRecordSize,
@@ -290,6 +468,15 @@ void MetadataArchive::fillFileNames(qint64 datetimeMs, AbstractMetadataBinaryFil
     fillFileNames(datetimeMs, nullptr, false, indexFile);
 }
 
+void MetadataArchive::fillSummaryFileName(
+    qint64 datetimeMs, AbstractMetadataBinaryFile* summaryFile) const
+{
+    const QString fileName = getFilePrefix(QDateTime::fromMSecsSinceEpoch(datetimeMs).date());
+    summaryFile->close();
+    summaryFile->setFileName(
+        fileName + QString("%1_summary_index").arg(m_filePrefix) + getChannelPrefix() + ".bin");
+}
+
 void MetadataArchive::fillFileNames(qint64 datetimeMs, AbstractMetadataBinaryFile* metadataFile, bool noGeometry, AbstractMetadataBinaryFile* indexFile) const
 {
     QDateTime datetime = QDateTime::fromMSecsSinceEpoch(datetimeMs);
@@ -310,6 +497,7 @@ void MetadataArchive::fillFileNames(qint64 datetimeMs, AbstractMetadataBinaryFil
 bool MetadataArchive::openFiles(qint64 timestampMs)
 {
     m_index.reset();
+    m_summaryFile.reset();
     dateBounds(timestampMs, m_firstTime, m_lastDateForCurrentFile);
 
     fillFileNames(timestampMs, m_detailedMetadataFile.get(), /*noGeometry*/ false, m_detailedIndexFile.get());
@@ -393,6 +581,15 @@ bool MetadataArchive::openFiles(qint64 timestampMs)
     m_detailedMetadataFile->seek(m_detailedMetadataFile->size());
     m_detailedIndexFile->seek(m_detailedIndexFile->size());
 
+    // The metadata is searched without the summary, if it is not available.
+    m_summaryFile = MetadataBinaryFileFactory::instance().create();
+    fillSummaryFileName(timestampMs, m_summaryFile.get());
+    if (!m_summaryFile->openRW() || !m_summary.openForAppend(m_summaryFile.get(), m_index))
+    {
+        NX_WARNING(this, "Failed to open file %1", m_summaryFile->fileName());
+        m_summaryFile.reset();
+    }
+
     return true;
 }
 
@@ -465,6 +662,12 @@ bool MetadataArchive::saveToArchiveInternal(
     indexRecord.extraWords = extraWords;
     indexRecord.recCount = recordCount - 1;
 
+    if (m_summaryFile
+        && !m_summary.append(indexRecord.start, data->data(), recordCount, fullRecordSize))
+    {
+        NX_WARNING(this, "Failed to write summary file for camera %1", m_physicalId);
+    }
+
     if (m_detailedIndexFile->write((const char* )&indexRecord, sizeof(IndexRecord)) != sizeof(IndexRecord))
     {
         NX_WARNING(this, "Failed to write index file for camera %1", m_physicalId);
@@ -498,7 +701,7 @@ void MetadataArchive::dateBounds(qint64 datetimeMs, qint64& minDate, qint64& max
 bool addToResultAsc(
     const Filter* filter,
     qint64 fullStartTimeMs,
-    qint32 durationMs,
+    qint64 durationMs,
     QnTimePeriodList& rez)
 {
     if (rez.empty())
@@ -525,7 +728,7 @@ bool addToResultAsc(
 bool addToResultAscUnordered(
     const Filter* filter,
     qint64 fullStartTimeMs,
-    qint32 durationMs,
+    qint64 durationMs,
     QnTimePeriodList& rez)
 {
     if (rez.empty())
@@ -550,7 +753,7 @@ bool addToResultAscUnordered(
 bool addToResultDesc(
     const Filter* filter,
     qint64 fullStartTimeMs,
-    qint32 durationMs,
+    qint64 durationMs,
     QnTimePeriodList& rez)
 {
     if (rez.empty())
@@ -579,7 +782,7 @@ bool addToResultDesc(
 bool addToResultDescUnordered(
     const Filter* filter,
     qint64 fullStartTimeMs,
-    qint32 durationMs,
+    qint64 durationMs,
     QnTimePeriodList& rez)
 {
     if (rez.empty())
@@ -604,43 +807,46 @@ bool addToResultDescUnordered(
     return true;
 }
 
-void MetadataArchive::loadDataFromIndex(
+bool MetadataArchive::loadDataFromIndex(
     AddRecordFunc addRecordFunc,
     RecordMatcher* recordMatcher,
     std::function<bool()> interruptionCallback,
     AbstractMetadataBinaryFile& metadataFile,
     const Index& index,
-    const QVector<IndexRecord>::const_iterator startItr,
-    const QVector<IndexRecord>::const_iterator endItr,
+    const IndexRange& range,
     QnTimePeriodList& rez) const
 {
     nx::utils::ByteArray buffer(kAlignment, 0, 0);
+    const auto startItr = range.startItr;
+    const auto endItr = range.endItr;
 
     int mediaRecordsLeft = 0;
     for (auto i = startItr; i < endItr; ++i)
         mediaRecordsLeft += i->recordCount();
     if (mediaRecordsLeft == 0)
-        return;
+        return true;
 
     const int baseRecordSize = recordMatcher->isNoGeometryMode()
         ? index.header.noGeometryRecordSize() : index.header.recordSize;
 
     int indexRecordNumber = startItr - index.records.begin();
-    qint64 dataOffset = index.dataOffset(indexRecordNumber, recordMatcher->isNoGeometryMode());
-    metadataFile.seek(dataOffset);
+    qint64 dataOffset = range.dataOffset;
 
     QVector<IndexRecord>::const_iterator i = startItr;
     int mediaRecordsPerIndexRecord = i->recordCount();
     while (mediaRecordsLeft > 0)
     {
-        const int bufferSize = index.mediaSize(indexRecordNumber, kReadBufferSize, recordMatcher->isNoGeometryMode());
+        const int bufferSize = std::min(
+            index.mediaSize(indexRecordNumber, kReadBufferSize, recordMatcher->isNoGeometryMode()),
+            range.endDataOffset - dataOffset);
 
-        buffer.reserve(bufferSize);
-        const int read = metadataFile.read(buffer.data(), bufferSize);
+        const quint8* data = nullptr;
+        const int read = readData(&metadataFile, dataOffset, bufferSize, &buffer, &data);
         if (read <= 0)
             break;
-        const quint8* dataEnd = (quint8*) buffer.data() + read;
-        quint8* curData = (quint8*) buffer.data();
+        dataOffset += read;
+        const quint8* dataEnd = data + read;
+        const quint8* curData = data;
         const auto filter = recordMatcher->filter();
         while (i < endItr && curData < dataEnd)
         {
@@ -656,10 +862,10 @@ void MetadataArchive::loadDataFromIndex(
                 if (recordMatcher->matchRecord(fullStartTimeMs, curData, recordSize))
                 {
                 if (!addRecordFunc(recordMatcher->filter(), fullStartTimeMs, i->duration, rez))
-                        return;
+                        return false;
                 }
                 if (interruptionCallback && interruptionCallback())
-                    return;
+                    return false;
             }
 
             curData += recordSize;
@@ -672,6 +878,7 @@ void MetadataArchive::loadDataFromIndex(
             }
         }
     }
+    return true;
 }
 
 void MetadataArchive::loadDataFromIndex(
@@ -695,17 +902,18 @@ void MetadataArchive::loadDataFromIndex(
     }
 }
 
-void MetadataArchive::loadDataFromIndexDesc(
+bool MetadataArchive::loadDataFromIndexDesc(
     AddRecordFunc addRecordFunc,
     RecordMatcher* recordMatcher,
     std::function<bool()> interruptionCallback,
     AbstractMetadataBinaryFile& metadataFile,
     const Index& index,
-    const QVector<IndexRecord>::const_iterator startItr,
-    const QVector<IndexRecord>::const_iterator endItr,
+    const IndexRange& range,
     QnTimePeriodList& rez) const
 {
     nx::utils::ByteArray buffer(kAlignment, 0, 0);
+    const auto startItr = range.startItr;
+    const auto endItr = range.endItr;
 
     const int baseRecordSize = recordMatcher->isNoGeometryMode()
         ? index.header.noGeometryRecordSize() : index.header.recordSize;
@@ -714,30 +922,31 @@ void MetadataArchive::loadDataFromIndexDesc(
     for (auto i = startItr; i < endItr; ++i)
         mediaRecordsLeft += i->recordCount();
     if (mediaRecordsLeft == 0)
-        return;
+        return true;
 
     // math file (one month)
     QVector<IndexRecord>::const_iterator i = endItr - 1;
     const QVector<IndexRecord>::const_iterator itBegin = index.records.begin();
-    int64_t mediaFileOffset = index.dataOffset(endItr - itBegin, recordMatcher->isNoGeometryMode());
+    int64_t mediaFileOffset = range.endDataOffset;
     while (mediaRecordsLeft > 0)
     {
-        const int mediaDataSize = index.mediaSizeDesc(i - itBegin,
-            kReadBufferSize, recordMatcher->isNoGeometryMode());
+        const int mediaDataSize = std::min(
+            index.mediaSizeDesc(i - itBegin, kReadBufferSize, recordMatcher->isNoGeometryMode()),
+            mediaFileOffset - range.dataOffset);
 
         mediaFileOffset -= mediaDataSize;
-        metadataFile.seek(mediaFileOffset);
 
-        buffer.reserve(mediaDataSize);
-        const int read = metadataFile.read(buffer.data(), mediaDataSize);
+        const quint8* data = nullptr;
+        const int read =
+            readData(&metadataFile, mediaFileOffset, mediaDataSize, &buffer, &data);
         if (read <= 0)
             break;
 
         int mediaRecordsPerIndexRecord = i->recordCount();
         int fullRecordSize = baseRecordSize + index.extraRecordSize(i - itBegin);
-        quint8* curData = (quint8*)buffer.data() + read;
+        const quint8* curData = data + read;
         const auto filter = recordMatcher->filter();
-        while (i >= startItr && curData > (quint8*) buffer.data())
+        while (i >= startItr && curData > data)
         {
             curData -= fullRecordSize;
             qint64 fullStartTimeMs = i->start + index.header.startTimeMs;
@@ -746,10 +955,10 @@ void MetadataArchive::loadDataFromIndexDesc(
                 if (recordMatcher->matchRecord(fullStartTimeMs, curData, fullRecordSize))
                 {
                     if (!addRecordFunc(filter, fullStartTimeMs, i->duration, rez))
-                        return;
+                        return false;
                 }
                 if (interruptionCallback && interruptionCallback())
-                    return;
+                    return false;
             }
 
             --mediaRecordsLeft;
@@ -763,6 +972,7 @@ void MetadataArchive::loadDataFromIndexDesc(
             }
         }
     }
+    return true;
 }
 
 void MetadataArchive::loadDataFromIndexDesc(
@@ -787,6 +997,180 @@ void MetadataArchive::loadDataFromIndexDesc(
     }
 }
 
+std::vector<MetadataArchive::IndexRange> MetadataArchive::candidateRanges(
+    const RecordMatcher* recordMatcher,
+    const Index& index,
+    const SummaryIndex* summary,
+    const QVector<IndexRecord>::const_iterator startItr,
+    const QVector<IndexRecord>::const_iterator endItr) const
+{
+    const bool noGeometryMode = recordMatcher->isNoGeometryMode();
+    const auto itBegin = index.records.begin();
+    const auto mayMatch =
+        [recordMatcher](const SummaryIndex::Record* record)
+        {
+            return !record
+                || (record->cellCount > 0 && recordMatcher->matchGeometrySummary(record->grid));
+        };
+
+    std::vector<IndexRange> result;
+    std::optional<IndexRange> range;
+    int rangeRecords = 0;
+    std::optional<quint32> checkedHour;
+    std::optional<quint32> checkedMinute;
+    bool isHourMatched = true;
+    bool isMinuteMatched = true;
+    qint64 dataOffset = index.dataOffset(startItr - itBegin, noGeometryMode);
+    for (auto i = startItr; i < endItr; ++i)
+    {
+        const quint32 minute = i->start / SummaryIndex::kMinuteMs;
+        if (summary && minute != checkedMinute)
+        {
+            const quint32 hour = minute / SummaryIndex::kMinutesPerHour;
+            if (hour != checkedHour)
+            {
+                checkedHour = hour;
+                isHourMatched = mayMatch(summary->hourRecord(hour));
+            }
+            checkedMinute = minute;
+            isMinuteMatched = isHourMatched && mayMatch(summary->minuteRecord(minute));
+        }
+
+        const qint64 recordDataSize = index.recordDataSize(i - itBegin, noGeometryMode);
+        if (isMinuteMatched)
+        {
+            if (range
+                && rangeRecords >= kMinSearchTaskRecords
+                && i->start / kSearchTaskIntervalMs != (i - 1)->start / kSearchTaskIntervalMs)
+            {
+                result.push_back(*range);
+                range.reset();
+            }
+            if (!range)
+            {
+                range = IndexRange{i, i, dataOffset, dataOffset};
+                rangeRecords = 0;
+            }
+            range->endItr = i + 1;
+            range->endDataOffset = dataOffset + recordDataSize;
+            ++rangeRecords;
+        }
+        else if (range)
+        {
+            result.push_back(*range);
+            range.reset();
+        }
+        dataOffset += recordDataSize;
+    }
+    if (range)
+        result.push_back(*range);
+    return result;
+}
+
+void MetadataArchive::matchRanges(
+    AddRecordFunc addRecordFunc,
+    RecordMatcher* recordMatcher,
+    std::function<bool()> interruptionCallback,
+    AbstractMetadataBinaryFile& metadataFile,
+    const Index& index,
+    std::vector<IndexRange> ranges,
+    bool isParallel,
+    QnTimePeriodList& rez) const
+{
+    const bool descendingOrder =
+        recordMatcher->filter()->sortOrder == Qt::SortOrder::DescendingOrder;
+    if (descendingOrder)
+        std::reverse(ranges.begin(), ranges.end());
+
+    const auto match =
+        [&](const IndexRange& range,
+            std::function<bool()> callback,
+            AbstractMetadataBinaryFile& file,
+            QnTimePeriodList& result)
+        {
+            return descendingOrder
+                ? loadDataFromIndexDesc(
+                    addRecordFunc, recordMatcher, callback, file, index, range, result)
+                : loadDataFromIndex(
+                    addRecordFunc, recordMatcher, callback, file, index, range, result);
+        };
+
+    // The ranges are joined until each task has enough records to outweigh opening the file.
+    std::vector<std::vector<IndexRange>> tasks;
+    int taskRecords = kMinSearchTaskRecords;
+    for (const auto& range: ranges)
+    {
+        if (taskRecords >= kMinSearchTaskRecords)
+        {
+            tasks.emplace_back();
+            taskRecords = 0;
+        }
+        tasks.back().push_back(range);
+        taskRecords += range.endItr - range.startItr;
+    }
+
+    if (!isParallel || tasks.size() < 2 || searchThreadPool()->maxThreadCount() < 2)
+    {
+        for (const auto& range: ranges)
+        {
+            if (!match(range, interruptionCallback, metadataFile, rez))
+                break;
+        }
+        return;
+    }
+
+    // All the tasks are waited for below, so they may refer to the local data.
+    std::atomic<bool> isStopped = false;
+    const auto isTaskStopped = [&isStopped]() { return isStopped.load(); };
+    const QString metadataFileName = metadataFile.fileName();
+    std::vector<nx::utils::concurrent::Future<QnTimePeriodList>> results;
+    for (const auto& task: tasks)
+    {
+        results.push_back(nx::utils::concurrent::run(searchThreadPool(),
+            [&, taskRanges = &task]()
+            {
+                QnTimePeriodList result;
+                if (isStopped)
+                    return result;
+
+                auto file = MetadataBinaryFileFactory::instance().create();
+                file->setFileName(metadataFileName);
+                if (!file->openReadOnly())
+                {
+                    NX_DEBUG(this, "Failed to open metadata file %1", metadataFileName);
+                    return result;
+                }
+
+                for (const auto& range: *taskRanges)
+                {
+                    if (!match(range, isTaskStopped, *file, result))
+                        break;
+                }
+                return result;
+            }));
+    }
+
+    // The periods are added the same way the records are, so the adjacent periods of the
+    // neighbouring tasks are joined.
+    for (auto& result: results)
+    {
+        result.waitForFinished();
+        if (isStopped)
+            continue;
+
+        for (const auto& period: result.resultAt(0))
+        {
+            if (!addRecordFunc(recordMatcher->filter(), period.startTimeMs, period.durationMs, rez))
+            {
+                isStopped = true;
+                break;
+            }
+        }
+        if (interruptionCallback && interruptionCallback())
+            isStopped = true;
+    }
+}
+
 QDate MetadataArchive::monthForDate(const QDate& currentMonth) const
 {
     MetadataHelper helper(m_dataDir);
@@ -894,22 +1278,25 @@ QnTimePeriodList MetadataArchive::matchPeriodInternal(
                 }
                 else
                 {
-                    if (descendingOrder)
-                    {
-                        loadDataFromIndexDesc(
-                            hasDiscontinue ? addToResultDescUnordered : addToResultDesc,
-                            recordMatcher, breakCallback,
-                            *metadataFile, index, startItr, endItr,
-                            rez);
-                    }
-                    else
+                    // The summary is not used for the unordered records, as well as the threads.
+                    SummaryIndex summary;
+                    bool hasSummary = false;
+                    if (!hasDiscontinue)
                     {
-                        loadDataFromIndex(
-                            hasDiscontinue ? addToResultAscUnordered : addToResultAsc,
-                            recordMatcher, breakCallback,
-                            *metadataFile, index, startItr, endItr,
-                            rez);
+                        auto summaryFile = MetadataBinaryFileFactory::instance().create();
+                        fillSummaryFileName(timePointMs, summaryFile.get());
+                        hasSummary = summaryFile->openReadOnly() && summary.load(*summaryFile);
                     }
+
+                    const auto addRecordFunc = descendingOrder
+                        ? (hasDiscontinue ? addToResultDescUnordered : addToResultDesc)
+                        : (hasDiscontinue ? addToResultAscUnordered : addToResultAsc);
+                    matchRanges(
+                        addRecordFunc, recordMatcher, breakCallback, *metadataFile, index,
+                        candidateRanges(recordMatcher, index, hasSummary ? &summary : nullptr,
+                            startItr, endItr),
+                        /*isParallel*/ !hasDiscontinue,
+                        rez);
                 }
 
                 if (!hasDiscontinue
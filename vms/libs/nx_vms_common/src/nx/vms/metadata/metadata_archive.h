@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <map>
+
 #include <QtCore/QFile>
 #include <QtCore/QString>
 #include <QtCore/QVector>
@@ -125,6 +127,9 @@ struct NX_VMS_COMMON_API Index
     qint64 mediaSizeDesc(int from, int suggestedbufferSize, bool noGeometryMode) const;
     qint64 extraRecordSize(int index) const;
 
+    /** Size of the data of all the records described by the index record. */
+    qint64 recordDataSize(int index, bool noGeometryMode) const;
+
     void reset();
     bool truncateToBytes(qint64 dataSize, bool noGeometryMode);
     bool updateTail(AbstractMetadataBinaryFile* indexFile);
@@ -135,6 +140,77 @@ struct NX_VMS_COMMON_API Index
     MetadataArchive* m_owner = nullptr;
 };
 
+/**
+ * Second-level index of the metadata file: the geometry of the records, started in the same
+ * minute, is OR-merged, so the search skips the minutes and hours which can not match the
+ * region. The records are added to the summary before they are written to the index, so each
+ * indexed record started at or after coveredFromMs is summarized.
+ */
+class NX_VMS_COMMON_API SummaryIndex
+{
+public:
+    static constexpr quint32 kMinuteMs = 60 * 1000;
+    static constexpr quint32 kMinutesPerHour = 60;
+
+#pragma pack(push, 1)
+    struct Header
+    {
+        quint8 version = 1;
+        char reserved[3]{};
+
+        /**
+         * The records started before this time, relative to IndexHeader::startTimeMs, were
+         * written before the summary file had been created, so they are not summarized.
+         */
+        quint32 coveredFromMs = 0;
+    };
+
+    struct Record
+    {
+        /** Relative to IndexHeader::startTimeMs. */
+        quint32 minute = 0;
+
+        /** Number of the cells set in the grid. */
+        quint16 cellCount = 0;
+
+        quint8 grid[kGeometrySize]{};
+    };
+#pragma pack(pop)
+
+    /** Loads the summary of the metadata file for the search. */
+    bool load(AbstractMetadataBinaryFile& file);
+
+    /**
+     * Prepares the summary file, opened read-write, for the appending. The summary file, which is
+     * empty, covers the minutes after the last record of the index.
+     */
+    bool openForAppend(AbstractMetadataBinaryFile* file, const Index& index);
+
+    /**
+     * Adds the geometry of the records, each starting with the grid, to the minute of startMs.
+     * The last record of the file is rewritten while the minute is the same.
+     */
+    bool append(quint32 startMs, const char* data, int recordCount, int recordSize);
+
+    /** @return Summary of the minute, or null if it is not known. */
+    const Record* minuteRecord(quint32 minute) const;
+
+    /** @return Summary of the hour, or null if it is not known. */
+    const Record* hourRecord(quint32 hour) const;
+
+private:
+    static void addGrid(Record* record, const void* grid);
+
+private:
+    Header m_header;
+    std::map<quint32, Record> m_minutes;
+    std::map<quint32, Record> m_hours;
+
+    AbstractMetadataBinaryFile* m_file = nullptr;
+    Record m_lastRecord;
+    bool m_hasLastRecord = false;
+};
+
 struct NX_VMS_COMMON_API Filter
 {
     std::chrono::milliseconds startTime{ 0 };
@@ -151,7 +227,15 @@ public:
 
     const Filter* filter() const { return m_filter; }
     virtual bool isWholeFrame() const = 0;
+
+    /** Called from the search threads concurrently, for the records of the same file. */
     virtual bool matchRecord(int64_t timestampMs, const uint8_t* data, int recordSize) const = 0;
+
+    /**
+     * @param grid Geometry of several records, OR-merged.
+     * @return False if none of these records can match.
+     */
+    virtual bool matchGeometrySummary(const uint8_t* /*grid*/) const { return true; }
     virtual bool isEmpty() const = 0;
 
     void setNoGeometryMode(bool value) { m_noGeometryMode = value; }
@@ -228,16 +312,25 @@ protected:
 
 private:
 
-    using AddRecordFunc = std::function<bool(const Filter*, qint64, qint32, QnTimePeriodList&)>;
+    using AddRecordFunc = std::function<bool(const Filter*, qint64, qint64, QnTimePeriodList&)>;
 
-    void loadDataFromIndex(
+    /** Records of the index, with the offsets of their data in the metadata file. */
+    struct IndexRange
+    {
+        QVector<IndexRecord>::const_iterator startItr;
+        QVector<IndexRecord>::const_iterator endItr;
+        qint64 dataOffset = 0; //< Of the start record.
+        qint64 endDataOffset = 0; //< Of the end record.
+    };
+
+    /** @return False if the matching is stopped by the addRecordFunc or the interruption. */
+    bool loadDataFromIndex(
         AddRecordFunc addRecordFunc,
         RecordMatcher* recordMatcher,
         std::function<bool()> interruptionCallback,
         AbstractMetadataBinaryFile& motionFile,
         const Index& index,
-        const QVector<IndexRecord>::const_iterator startItr,
-        const QVector<IndexRecord>::const_iterator endItr,
+        const IndexRange& range,
         QnTimePeriodList& rez) const;
     void loadDataFromIndex(
         AddRecordFunc addRecordFunc,
@@ -248,14 +341,14 @@ private:
         const QVector<IndexRecord>::const_iterator endItr,
         QnTimePeriodList& rez) const;
 
-    void loadDataFromIndexDesc(
+    /** @return False if the matching is stopped by the addRecordFunc or the interruption. */
+    bool loadDataFromIndexDesc(
         AddRecordFunc addRecordFunc,
         RecordMatcher* recordMatcher,
         std::function<bool()> interruptionCallback,
         AbstractMetadataBinaryFile& motionFile,
         const Index& index,
-        const QVector<IndexRecord>::const_iterator startItr,
-        const QVector<IndexRecord>::const_iterator endItr,
+        const IndexRange& range,
         QnTimePeriodList& rez) const;
     void loadDataFromIndexDesc(
         AddRecordFunc addRecordFunc,
@@ -266,6 +359,34 @@ private:
         const QVector<IndexRecord>::const_iterator endItr,
         QnTimePeriodList& rez) const;
 
+    /**
+     * Splits the records into the ranges which may match: the minutes and hours, which can not
+     * match according to the summary, are skipped. The ranges are also split by the hours, once
+     * they are big enough to be matched in parallel.
+     */
+    std::vector<IndexRange> candidateRanges(
+        const RecordMatcher* recordMatcher,
+        const Index& index,
+        const SummaryIndex* summary,
+        const QVector<IndexRecord>::const_iterator startItr,
+        const QVector<IndexRecord>::const_iterator endItr) const;
+
+    /**
+     * Matches the ranges in the search thread pool if there are enough records, and merges their
+     * periods in order. The tasks are stopped once the limit of the filter is reached.
+     */
+    void matchRanges(
+        AddRecordFunc addRecordFunc,
+        RecordMatcher* recordMatcher,
+        std::function<bool()> interruptionCallback,
+        AbstractMetadataBinaryFile& metadataFile,
+        const Index& index,
+        std::vector<IndexRange> ranges,
+        bool isParallel,
+        QnTimePeriodList& rez) const;
+
+    void fillSummaryFileName(qint64 datetimeMs, AbstractMetadataBinaryFile* summaryFile) const;
+
 protected:
     bool openFiles(qint64 timestampMs);
     QDate monthForDate(const QDate& currentMonth) const;
@@ -279,6 +400,7 @@ private:
     std::shared_ptr<AbstractMetadataBinaryFile> m_detailedMetadataFile;
     std::unique_ptr<AbstractMetadataBinaryFile> m_noGeometryMetadataFile;
     std::shared_ptr<AbstractMetadataBinaryFile> m_detailedIndexFile;
+    std::unique_ptr<AbstractMetadataBinaryFile> m_summaryFile;
 
     qint64 m_lastDateForCurrentFile = -1;
 
@@ -288,6 +410,7 @@ private:
     qint64 m_lastRecordedTime = AV_NOPTS_VALUE;
 
     Index m_index;
+    SummaryIndex m_summary;
 
 protected:
     const QString m_dataDir;
@@ -2,6 +2,8 @@
 
 #include "motion_filter.h"
 
+#include <nx/media/motion_mask.h>
+
 namespace nx::vms::metadata {
 
 MotionRecordMatcher::MotionRecordMatcher(const MotionFilter* filter):
@@ -20,7 +22,7 @@ MotionRecordMatcher::MotionRecordMatcher(const MotionFilter* filter):
     }
 
     if (!m_wholeFrame)
-        QnMetaDataV1::createMask(filter->region, (char*) m_mask, &m_maskStart, &m_maskEnd);
+        QnMetaDataV1::createMask(filter->region, m_mask.data(), &m_maskStart, &m_maskEnd);
 }
 
 const MotionFilter* MotionRecordMatcher::filter() const
@@ -33,7 +35,12 @@ bool MotionRecordMatcher::matchRecord(
 {
     if (m_wholeFrame)
         return true;
-    return QnMetaDataV1::matchImage((quint64*)data, m_mask, m_maskStart, m_maskEnd);
+    return nx::media::motion_mask::intersects(data, m_mask.data(), m_maskStart, m_maskEnd);
+}
+
+bool MotionRecordMatcher::matchGeometrySummary(const uint8_t* grid) const
+{
+    return matchRecord(/*timestampMs*/ 0, grid, kGridDataSizeBytes);
 }
 
 
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <QtGui/QRegion>
 
 #include <nx/media/motion_detection.h>
@@ -24,6 +26,7 @@ public:
     MotionRecordMatcher(const MotionFilter* filter);
 
     virtual bool matchRecord(int64_t timestampMs, const uint8_t* data, int recordSize) const override;
+    virtual bool matchGeometrySummary(const uint8_t* grid) const override;
     const MotionFilter* filter() const;
 
     virtual bool isWholeFrame() const override { return m_wholeFrame; }
@@ -33,7 +36,7 @@ private:
     int m_maskStart = 0;
     int m_maskEnd = 0;
     bool m_wholeFrame = false;
-    simd128i m_mask[kGridDataSizeBytes / sizeof(simd128i)];
+    std::array<char, kGridDataSizeBytes> m_mask{};
 };
 
 } // namespace nx::vms::metadata
@@ -0,0 +1,102 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "clock_offset_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace std::chrono;
+
+namespace nx::vms::time {
+
+namespace {
+
+/** The frequency tolerance of NTP: a larger drift means a broken sample, not a slow clock. */
+static constexpr double kMaxDrift = 500e-6;
+
+/** The offsets selected closer in time tell the delay jitter rather than the drift. */
+static constexpr milliseconds kMinDriftSpan = 10s;
+
+/** Weight of a new drift measurement in the running estimation. */
+static constexpr double kDriftGain = 0.25;
+
+} // namespace
+
+void ClockOffsetFilter::addSample(const Sample& sample)
+{
+    m_samples.push_back(sample);
+    while ((int) m_samples.size() > std::max(m_settings.windowSize, 1))
+        m_samples.pop_front();
+    ++m_pollSampleCount;
+}
+
+void ClockOffsetFilter::finishPoll()
+{
+    const auto pollSampleCount = std::min(std::exchange(m_pollSampleCount, 0), m_samples.size());
+    const auto pollSample = bestSample(pollSampleCount);
+    if (!pollSample)
+        return;
+
+    const auto predicted = estimate(pollSample->localReceiveTime);
+    const bool isStable = predicted
+        && abs(pollSample->offset() - predicted->offset) <= m_settings.stabilityThreshold;
+    m_pollBackoff = isStable ? std::min(m_pollBackoff * 2, m_settings.maxPollBackoff) : 1;
+
+    // The remote clock has been set, or the local one has drifted away: the older samples would
+    // keep the offset from following it.
+    if (predicted && !isStable)
+        m_samples.erase(m_samples.begin(), m_samples.end() - pollSampleCount);
+
+    const auto selected = *bestSample(m_samples.size());
+    if (m_selected && isStable)
+    {
+        const auto span = selected.localReceiveTime - m_selected->localReceiveTime;
+        if (span >= kMinDriftSpan)
+        {
+            const double drift = duration<double>(selected.offset() - m_selected->offset())
+                / duration<double>(span);
+            if (std::abs(drift) <= kMaxDrift)
+                m_drift = m_drift ? *m_drift + (drift - *m_drift) * kDriftGain : drift;
+        }
+    }
+    m_selected = selected;
+}
+
+std::optional<ClockOffsetFilter::Estimate> ClockOffsetFilter::estimate(
+    milliseconds localTime) const
+{
+    if (!m_selected)
+        return std::nullopt;
+
+    const auto elapsed = duration<double>(localTime - m_selected->localReceiveTime);
+    return Estimate{
+        .offset = m_selected->offset()
+            + round<milliseconds>(elapsed * drift()),
+        .rtt = m_selected->rtt(),
+    };
+}
+
+void ClockOffsetFilter::reset()
+{
+    m_samples.clear();
+    m_pollSampleCount = 0;
+    m_selected.reset();
+    m_drift.reset();
+    m_pollBackoff = 1;
+}
+
+const ClockOffsetFilter::Sample* ClockOffsetFilter::bestSample(std::size_t count) const
+{
+    count = std::min(count, m_samples.size());
+    const Sample* result = nullptr;
+    for (auto it = m_samples.end() - count; it != m_samples.end(); ++it)
+    {
+        // The later one of the equal samples is preferred.
+        if (!result || it->rtt() <= result->rtt())
+            result = &*it;
+    }
+    return result;
+}
+
+} // namespace nx::vms::time
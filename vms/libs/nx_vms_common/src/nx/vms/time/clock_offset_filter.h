@@ -0,0 +1,103 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <optional>
+
+namespace nx::vms::time {
+
+/**
+ * Estimates the offset of a remote clock from the local monotonic one the way NTP does it.
+ *
+ * Each poll of the remote peer is a burst of requests, each of them giving a sample. The offset
+ * is taken from the sample with the smallest round trip among the recent ones, since the delay
+ * asymmetry, and so the error, of such a sample is the smallest one. The drift of the local clock
+ * is estimated from the offsets selected by the consecutive polls and is used to extrapolate the
+ * offset between the polls. While the offset keeps to the extrapolation, the polling interval is
+ * backed off.
+ *
+ * Not thread-safe.
+ */
+class NX_VMS_COMMON_API ClockOffsetFilter
+{
+public:
+    struct Settings
+    {
+        /** Recent samples the offset is selected from. */
+        int windowSize = 8;
+
+        /** Requests made per poll. */
+        int burstSize = 4;
+
+        /** The polling interval grows up to this many base intervals. */
+        int maxPollBackoff = 16;
+
+        /** A poll differing from the extrapolated offset by not more than this is stable. */
+        std::chrono::milliseconds stabilityThreshold{20};
+    };
+
+    struct Sample
+    {
+        /** Local monotonic time the request was sent at. */
+        std::chrono::milliseconds localSendTime{0};
+
+        /** Remote time the request was handled at. */
+        std::chrono::milliseconds remoteTime{0};
+
+        /** Local monotonic time the response was received at. */
+        std::chrono::milliseconds localReceiveTime{0};
+
+        std::chrono::milliseconds rtt() const { return localReceiveTime - localSendTime; }
+
+        /** The remote time minus the local one, assuming the same delay both ways. */
+        std::chrono::milliseconds offset() const
+        {
+            return remoteTime - (localSendTime + localReceiveTime) / 2;
+        }
+    };
+
+    struct Estimate
+    {
+        std::chrono::milliseconds offset{0};
+
+        /** Round trip of the sample the offset is taken from: the offset error is within half. */
+        std::chrono::milliseconds rtt{0};
+    };
+
+    ClockOffsetFilter() = default;
+    explicit ClockOffsetFilter(Settings settings): m_settings(settings) {}
+
+    const Settings& settings() const { return m_settings; }
+
+    void addSample(const Sample& sample);
+
+    /** Selects the offset from the samples of the poll and adjusts the polling interval. */
+    void finishPoll();
+
+    /** @return Offset at the local monotonic time, std::nullopt before the first poll. */
+    std::optional<Estimate> estimate(std::chrono::milliseconds localTime) const;
+
+    /** Local clock drift: the seconds the offset changes by per second. */
+    double drift() const { return m_drift.value_or(0.0); }
+
+    /** @return Multiplier of the base polling interval, from 1 up to Settings::maxPollBackoff. */
+    int pollBackoff() const { return m_pollBackoff; }
+
+    /** Forgets all the samples, e.g. when the remote peer is changed. */
+    void reset();
+
+private:
+    const Sample* bestSample(std::size_t count) const;
+
+private:
+    Settings m_settings;
+    std::deque<Sample> m_samples;
+    std::size_t m_pollSampleCount = 0;
+    std::optional<Sample> m_selected;
+    std::optional<double> m_drift;
+    int m_pollBackoff = 1;
+};
+
+} // namespace nx::vms::time
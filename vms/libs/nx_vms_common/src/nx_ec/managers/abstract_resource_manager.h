@@ -28,6 +28,15 @@ signals:
         const nx::vms::api::ResourceParamWithRefData& param,
         ec2::NotificationSource source);
 
+    /**
+     * Batched form of resourceParamChanged(): the changes received during one event loop
+     * iteration, in the order of their arrival. Emitted only if connected, so the listeners
+     * which apply the changes in bulk may opt in by connecting to it instead.
+     */
+    void resourceParamsChanged(
+        const nx::vms::api::ResourceParamWithRefDataList& params,
+        ec2::NotificationSource source);
+
     void resourceParamRemoved(const nx::vms::api::ResourceParamWithRefData& param);
     void resourceRemoved(const nx::Uuid& resourceId, ec2::NotificationSource source);
     void resourceStatusRemoved(const nx::Uuid& resourceId, ec2::NotificationSource source);
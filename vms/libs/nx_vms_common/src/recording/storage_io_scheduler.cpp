@@ -0,0 +1,264 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "storage_io_scheduler.h"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <utility>
+
+#include <nx/streaming/nx_streaming_ini.h>
+#include <nx/utils/log/log.h>
+
+namespace nx::recording {
+
+using namespace std::chrono;
+
+StorageIoScheduler::Operation::Operation(Operation&& other) noexcept:
+    m_scheduler(std::exchange(other.m_scheduler, nullptr)),
+    m_ioClass(other.m_ioClass),
+    m_bytes(other.m_bytes),
+    m_requestTime(other.m_requestTime)
+{
+}
+
+StorageIoScheduler::Operation& StorageIoScheduler::Operation::operator=(Operation&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_scheduler)
+            m_scheduler->finish(*this);
+        m_scheduler = std::exchange(other.m_scheduler, nullptr);
+        m_ioClass = other.m_ioClass;
+        m_bytes = other.m_bytes;
+        m_requestTime = other.m_requestTime;
+    }
+    return *this;
+}
+
+StorageIoScheduler::Operation::~Operation()
+{
+    if (m_scheduler)
+        m_scheduler->finish(*this);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+StorageIoScheduler::StorageIoScheduler(const Settings& settings):
+    m_settings(settings)
+{
+}
+
+StorageIoScheduler::~StorageIoScheduler()
+{
+    NX_ASSERT(m_runningOperations == 0);
+}
+
+StorageIoScheduler* StorageIoScheduler::forStorage(const QString& storageId)
+{
+    static nx::Mutex mutex;
+    static std::map<QString, std::unique_ptr<StorageIoScheduler>> schedulers;
+
+    NX_MUTEX_LOCKER lock(&mutex);
+    auto& scheduler = schedulers[storageId];
+    if (!scheduler)
+    {
+        Settings settings;
+        settings.maxConcurrentOperations = nxStreamingIni().storageIoConcurrency;
+        scheduler = std::make_unique<StorageIoScheduler>(settings);
+    }
+    return scheduler.get();
+}
+
+StorageIoScheduler::Operation StorageIoScheduler::start(StorageIoClass ioClass, qint64 bytes)
+{
+    Operation operation;
+    operation.m_scheduler = this;
+    operation.m_ioClass = ioClass;
+    operation.m_bytes = bytes;
+    operation.m_requestTime = steady_clock::now();
+
+    auto& ioClassData = m_classes[(int) ioClass];
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (m_settings.maxConcurrentOperations <= 0)
+    {
+        ++m_runningOperations;
+        ++ioClassData.runningOperations;
+        return operation;
+    }
+
+    if (ioClassData.queue.empty() && ioClassData.runningOperations == 0)
+    {
+        // The class, which was idle, does not get the bytes it has not requested: it starts from
+        // the least virtual time of the busy classes.
+        std::optional<double> minVirtualTime;
+        for (const auto& other: m_classes)
+        {
+            if ((!other.queue.empty() || other.runningOperations > 0)
+                && (!minVirtualTime || other.virtualTime < *minVirtualTime))
+            {
+                minVirtualTime = other.virtualTime;
+            }
+        }
+        if (minVirtualTime)
+            ioClassData.virtualTime = std::max(ioClassData.virtualTime, *minVirtualTime);
+    }
+
+    const auto request = std::make_shared<Request>();
+    request->bytes = bytes;
+    request->deadline =
+        operation.m_requestTime + m_settings.classes[(int) ioClass].latencyTarget;
+    ioClassData.queue.push_back(request);
+    dispatch();
+
+    while (!request->isStarted)
+        m_condition.wait(&m_mutex);
+    return operation;
+}
+
+StorageIoScheduler::ClassStatistics StorageIoScheduler::statistics(StorageIoClass ioClass) const
+{
+    const auto& ioClassData = m_classes[(int) ioClass];
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    ClassStatistics result = ioClassData.statistics;
+    result.waitingOperations = (int) ioClassData.queue.size();
+    result.runningOperations = ioClassData.runningOperations;
+    result.bitrateBitsPerSecond = ioClassData.throughput.bitrateBitsPerSecond();
+    if (result.operationCount > 0)
+        result.averageLatency = ioClassData.totalLatency / result.operationCount;
+    return result;
+}
+
+void StorageIoScheduler::finish(const Operation& operation)
+{
+    const auto now = steady_clock::now();
+    const auto latency = duration_cast<microseconds>(now - operation.m_requestTime);
+
+    auto& ioClassData = m_classes[(int) operation.m_ioClass];
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    --m_runningOperations;
+    --ioClassData.runningOperations;
+
+    auto& statistics = ioClassData.statistics;
+    ++statistics.operationCount;
+    statistics.bytes += operation.m_bytes;
+    statistics.maxLatency = std::max(statistics.maxLatency, latency);
+    ioClassData.totalLatency += latency;
+    ioClassData.throughput.onData(
+        duration_cast<microseconds>(now.time_since_epoch()), operation.m_bytes, false);
+    if (latency > m_settings.classes[(int) operation.m_ioClass].latencyTarget)
+    {
+        ++statistics.latencyTargetMisses;
+        NX_VERBOSE(this, "Operation of class %1 took %2, the target is %3",
+            (int) operation.m_ioClass, latency,
+            m_settings.classes[(int) operation.m_ioClass].latencyTarget);
+    }
+
+    dispatch();
+}
+
+void StorageIoScheduler::dispatch()
+{
+    bool isStarted = false;
+    const auto now = steady_clock::now();
+    while (m_runningOperations < m_settings.maxConcurrentOperations)
+    {
+        Class* const ioClassData = nextClass(now);
+        if (!ioClassData)
+            break;
+
+        const auto request = std::move(ioClassData->queue.front());
+        ioClassData->queue.pop_front();
+        const int index = (int) (ioClassData - m_classes.data());
+        ioClassData->virtualTime +=
+            (double) std::max<qint64>(request->bytes, 1) / m_settings.classes[index].weight;
+        ++ioClassData->runningOperations;
+        ++m_runningOperations;
+        request->isStarted = true;
+        isStarted = true;
+    }
+
+    if (isStarted)
+        m_condition.wakeAll();
+}
+
+StorageIoScheduler::Class* StorageIoScheduler::nextClass(steady_clock::time_point now)
+{
+    // The last slot is reserved for the recording.
+    const bool isRecordOnly = m_settings.maxConcurrentOperations > 1
+        && m_runningOperations >= m_settings.maxConcurrentOperations - 1;
+
+    Class* overdueClass = nullptr;
+    Class* fairClass = nullptr;
+    for (int i = 0; i < kStorageIoClassCount; ++i)
+    {
+        auto& ioClassData = m_classes[i];
+        if (ioClassData.queue.empty() || (isRecordOnly && i != (int) StorageIoClass::record))
+            continue;
+
+        const auto deadline = ioClassData.queue.front()->deadline;
+        if (deadline <= now
+            && (!overdueClass || deadline < overdueClass->queue.front()->deadline))
+        {
+            overdueClass = &ioClassData;
+        }
+
+        if (!fairClass || ioClassData.virtualTime < fairClass->virtualTime)
+            fairClass = &ioClassData;
+    }
+
+    return overdueClass ? overdueClass : fairClass;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+ScheduledIoDevice::ScheduledIoDevice(
+    std::unique_ptr<QIODevice> device,
+    StorageIoScheduler* scheduler,
+    StorageIoClass ioClass)
+    :
+    m_device(std::move(device)),
+    m_scheduler(scheduler),
+    m_ioClass(ioClass)
+{
+    QIODevice::open(m_device->openMode() | QIODevice::Unbuffered);
+}
+
+ScheduledIoDevice::~ScheduledIoDevice()
+{
+    close();
+}
+
+bool ScheduledIoDevice::seek(qint64 pos)
+{
+    return m_device->seek(pos) && QIODevice::seek(pos);
+}
+
+qint64 ScheduledIoDevice::size() const
+{
+    return m_device->size();
+}
+
+void ScheduledIoDevice::close()
+{
+    if (!isOpen())
+        return;
+
+    const auto operation = m_scheduler->start(m_ioClass, /*bytes*/ 0);
+    m_device->close();
+    QIODevice::close();
+}
+
+qint64 ScheduledIoDevice::readData(char* data, qint64 maxSize)
+{
+    const auto operation = m_scheduler->start(m_ioClass, maxSize);
+    return m_device->read(data, maxSize);
+}
+
+qint64 ScheduledIoDevice::writeData(const char* data, qint64 size)
+{
+    const auto operation = m_scheduler->start(m_ioClass, size);
+    return m_device->write(data, size);
+}
+
+} // namespace nx::recording
@@ -0,0 +1,164 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <memory>
+
+#include <QtCore/QIODevice>
+#include <QtCore/QString>
+
+#include <nx/sdk/helpers/media_stream_statistics.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::recording {
+
+enum class StorageIoClass
+{
+    record,
+    playback,
+    archiveExport,
+    backup,
+};
+
+static constexpr int kStorageIoClassCount = 4;
+
+/**
+ * Dispatches the I/O operations of the storage: the number of the operations running in parallel
+ * is limited, and the waiting ones are started by the class weights and latency targets.
+ *
+ * The head operation of the class, which has waited longer than the latency target of the class,
+ * is started first (the earliest deadline first). Otherwise the class which has got the least
+ * bytes per its weight is chosen. One slot is reserved for the recording, so the recording is
+ * never starved by the readers.
+ */
+class NX_VMS_COMMON_API StorageIoScheduler
+{
+public:
+    struct ClassSettings
+    {
+        int weight = 1;
+        std::chrono::milliseconds latencyTarget{1000};
+    };
+
+    struct Settings
+    {
+        /** 0 disables the scheduling: the operations are started immediately. */
+        int maxConcurrentOperations = 4;
+
+        std::array<ClassSettings, kStorageIoClassCount> classes = {{
+            {.weight = 8, .latencyTarget = std::chrono::milliseconds(50)}, //< record
+            {.weight = 4, .latencyTarget = std::chrono::milliseconds(200)}, //< playback
+            {.weight = 2, .latencyTarget = std::chrono::milliseconds(1000)}, //< archiveExport
+            {.weight = 1, .latencyTarget = std::chrono::milliseconds(5000)}, //< backup
+        }};
+    };
+
+    struct ClassStatistics
+    {
+        int waitingOperations = 0;
+        int runningOperations = 0;
+        qint64 operationCount = 0;
+        qint64 bytes = 0;
+        int64_t bitrateBitsPerSecond = 0;
+
+        /** From the request to the completion of the operation. */
+        std::chrono::microseconds averageLatency{0};
+        std::chrono::microseconds maxLatency{0};
+
+        /** Number of the operations completed later than the latency target of the class. */
+        qint64 latencyTargetMisses = 0;
+    };
+
+    /** Releases the slot of the operation, when it is done. */
+    class NX_VMS_COMMON_API Operation
+    {
+    public:
+        Operation() = default;
+        Operation(Operation&& other) noexcept;
+        Operation& operator=(Operation&& other) noexcept;
+        ~Operation();
+
+    private:
+        friend class StorageIoScheduler;
+
+        StorageIoScheduler* m_scheduler = nullptr;
+        StorageIoClass m_ioClass = StorageIoClass::record;
+        qint64 m_bytes = 0;
+        std::chrono::steady_clock::time_point m_requestTime;
+    };
+
+    explicit StorageIoScheduler(const Settings& settings);
+    ~StorageIoScheduler();
+
+    /** The scheduler of the storage, configured by nx_streaming.ini. */
+    static StorageIoScheduler* forStorage(const QString& storageId);
+
+    /** Blocks until the operation may be started. */
+    Operation start(StorageIoClass ioClass, qint64 bytes);
+
+    ClassStatistics statistics(StorageIoClass ioClass) const;
+
+private:
+    struct Request
+    {
+        qint64 bytes = 0;
+        std::chrono::steady_clock::time_point deadline;
+        bool isStarted = false;
+    };
+
+    struct Class
+    {
+        std::deque<std::shared_ptr<Request>> queue;
+        int runningOperations = 0;
+
+        /** Bytes started, divided by the weight. */
+        double virtualTime = 0;
+
+        ClassStatistics statistics;
+        std::chrono::microseconds totalLatency{0};
+        nx::sdk::MediaStreamStatistics throughput;
+    };
+
+    void finish(const Operation& operation);
+    void dispatch();
+    Class* nextClass(std::chrono::steady_clock::time_point now);
+
+private:
+    const Settings m_settings;
+    mutable nx::Mutex m_mutex;
+    nx::WaitCondition m_condition;
+    std::array<Class, kStorageIoClassCount> m_classes;
+    int m_runningOperations = 0;
+};
+
+/**
+ * Device of the storage, the reads and writes of which are started by the storage scheduler.
+ */
+class NX_VMS_COMMON_API ScheduledIoDevice: public QIODevice
+{
+public:
+    ScheduledIoDevice(
+        std::unique_ptr<QIODevice> device,
+        StorageIoScheduler* scheduler,
+        StorageIoClass ioClass);
+    virtual ~ScheduledIoDevice() override;
+
+    virtual bool isSequential() const override { return m_device->isSequential(); }
+    virtual bool seek(qint64 pos) override;
+    virtual qint64 size() const override;
+    virtual void close() override;
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize) override;
+    virtual qint64 writeData(const char* data, qint64 size) override;
+
+private:
+    const std::unique_ptr<QIODevice> m_device;
+    StorageIoScheduler* const m_scheduler;
+    const StorageIoClass m_ioClass;
+};
+
+} // namespace nx::recording
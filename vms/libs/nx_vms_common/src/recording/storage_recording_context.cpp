@@ -13,6 +13,7 @@
 #include <nx/media/ffmpeg_helper.h>
 #include <nx/media/utils.h>
 #include <nx/media/video_data_packet.h>
+#include <nx/streaming/nx_streaming_ini.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/url.h>
 #include <utils/media/ffmpeg_io_context.h>
@@ -57,6 +58,26 @@ bool convertExtraDataToMp4(
     return true;
 }
 
+std::optional<WriteBehindSettings> writeBehindSettingsFromIni()
+{
+    const auto& ini = nxStreamingIni();
+    if (ini.writeBehindBufferKb <= 0)
+        return std::nullopt;
+
+    WriteBehindSettings settings;
+    settings.bufferSize = ini.writeBehindBufferKb * 1024;
+    settings.maxQueuedBuffers = ini.writeBehindQueuedBuffers;
+    settings.threadsPerStorage = ini.writeBehindThreadsPerStorage;
+    settings.directIo = ini.writeBehindDirectIo;
+
+    const std::string_view fsync = ini.writeBehindFsync;
+    if (fsync == "never")
+        settings.fsyncPolicy = WriteBehindSettings::FsyncPolicy::never;
+    else if (fsync == "always")
+        settings.fsyncPolicy = WriteBehindSettings::FsyncPolicy::always;
+    return settings;
+}
+
 } // namespace
 
 StorageRecordingContext::StorageRecordingContext(bool exportMode):
@@ -64,6 +85,14 @@ StorageRecordingContext::StorageRecordingContext(bool exportMode):
     m_convertDataToMp4Format(!exportMode),
     m_container("matroska")
 {
+    if (!exportMode)
+        m_writeBehindSettings = writeBehindSettingsFromIni();
+}
+
+void StorageRecordingContext::setWriteBehindSettings(
+    std::optional<nx::recording::WriteBehindSettings> settings)
+{
+    m_writeBehindSettings = std::move(settings);
 }
 
 void StorageRecordingContext::initializeRecordingContext(int64_t startTimeUs)
@@ -210,8 +239,19 @@ void StorageRecordingContext::cleanFfmpegContexts()
 
 void StorageRecordingContext::initIoContext(StorageContext& context)
 {
-    context.formatCtx->pb = nx::utils::media::createFfmpegIOContext(
-        context.storage, context.fileName, QIODevice::WriteOnly);
+    if (!m_writeBehindSettings)
+    {
+        context.formatCtx->pb = nx::utils::media::createFfmpegIOContext(
+            context.storage, context.fileName, QIODevice::WriteOnly, /*ioBlockSize*/ 32768,
+            m_exportMode ? StorageIoClass::archiveExport : StorageIoClass::record);
+    }
+    else if (const auto device = context.storage->open(context.fileName, QIODevice::WriteOnly))
+    {
+        context.formatCtx->pb = nx::utils::media::createFfmpegIOContext(new WriteBehindIoDevice(
+            std::unique_ptr<QIODevice>(device),
+            context.storage->getId().toSimpleString(),
+            *m_writeBehindSettings));
+    }
 
     if (context.formatCtx->pb == nullptr)
     {
@@ -12,6 +12,7 @@
 #include <recording/abstract_recording_context.h>
 #include <recording/abstract_recording_context_callback.h>
 #include <recording/stream_recorder_data.h>
+#include <recording/write_behind_io_device.h>
 #include <utils/media/annexb_to_mp4.h>
 
 namespace nx {
@@ -50,6 +51,12 @@ public:
     void setContainer(const QString& container);
     void setLastError(nx::recording::Error::Code code);
 
+    /**
+     * With the settings, the files are written through WriteBehindIoDevice. By default, it is
+     * configured by nx_streaming.ini, and is not used in the export mode.
+     */
+    void setWriteBehindSettings(std::optional<nx::recording::WriteBehindSettings> settings);
+
     // AbstractRecordingContext.
     virtual void closeRecordingContext(std::chrono::milliseconds durationMs) override;
     virtual void writeData(const QnConstAbstractMediaDataPtr& md, int streamIndex) override;
@@ -92,6 +99,7 @@ private:
     std::optional<nx::recording::Error> m_lastError;
     nx::media::AnnexbToMp4 m_annexbToMp4;
     std::map<int, int64_t> m_streamIndexToLastDts;
+    std::optional<nx::recording::WriteBehindSettings> m_writeBehindSettings;
 
     virtual qint64 getPacketTimeUsec(const QnConstAbstractMediaDataPtr& md);
 
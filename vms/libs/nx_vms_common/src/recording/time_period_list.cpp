@@ -7,18 +7,13 @@
 #include <nx/network/socket_common.h> //< For htonll().
 #include <nx/utils/datetime.h>
 #include <nx/utils/math/math.h>
+#include <nx/vms/common/recording/encoded_time_periods.h>
 #include <nx/vms/common/recording/time_periods_utils.h>
 #include <utils/common/util.h>
 
 QN_FUSION_ADAPT_STRUCT_FUNCTIONS(MultiServerPeriodData,
     (json)(ubjson)(xml)(csv_record)(compressed_time), (guid)(periods))
 
-namespace {
-
-static const qint64 InvalidValue = std::numeric_limits<qint64>::max();
-
-} // namespace
-
 QnTimePeriodList::QnTimePeriodList(const QnTimePeriod &singlePeriod):
     QnTimePeriodList()
 {
@@ -264,61 +259,16 @@ bool QnTimePeriodList::encode(QByteArray &stream)
     return true;
 };
 
-qint64 decodeValue(const quint8 *&curPtr, const quint8 *end)
-{
-    if (curPtr >= end)
-        return InvalidValue;
-    int fieldSize = 2 + (*curPtr >> 6);
-    if (end - curPtr < fieldSize)
-        return InvalidValue;
-    qint64 value = *curPtr++ & 0x3f;
-    for (int i = 0; i < fieldSize - 1; ++i)
-        value = (value << 8) + *curPtr++;
-    if (value == 0x3fffffffffll)
-    {
-        if (end - curPtr < 6)
-            return InvalidValue;
-        value = *curPtr++;
-        for (int i = 0; i < 5; ++i)
-            value = (value << 8) + *curPtr++;
-    }
-    return value;
-};
-
 bool QnTimePeriodList::decode(const quint8 *data, int dataSize)
 {
     clear();
 
-    const quint8* curPtr = data;
-    const quint8* end = data + dataSize;
-    if (end - curPtr < 6)
-        return false;
-
-    qint64 fullStartTime = 0;
-    memcpy(&fullStartTime, curPtr, 6);
-    curPtr += 6;
-#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
-    fullStartTime <<= 16;
-#else
-    fullStartTime >>= 16;
-#endif
-    fullStartTime = ntohll(fullStartTime);
-
-    qint64 relStartTime = 0;
-    while (relStartTime != InvalidValue)
-    {
-        qint64 duration = decodeValue(curPtr, end);
-        if (duration == InvalidValue)
-            return false;
-        duration--;
-
-        fullStartTime += relStartTime;
-        push_back(QnTimePeriod(fullStartTime, duration));
-        fullStartTime += duration;
-
-        relStartTime = decodeValue(curPtr, end);
-    }
-    return true;
+    const nx::vms::common::EncodedTimePeriods periods(
+        std::string_view((const char*) data, (size_t) dataSize));
+    auto it = periods.begin();
+    for (; it != periods.end(); ++it)
+        push_back(*it);
+    return !it.isFailed();
 }
 
 bool QnTimePeriodList::decode(QByteArray &stream)
@@ -381,6 +331,14 @@ QnTimePeriodList QnTimePeriodList::aggregateTimePeriods(
     return aggregateTimePeriodsUnconstrained(periods, detailLevel);
 }
 
+QnTimePeriodList QnTimePeriodList::aggregateTimePeriods(
+    const std::vector<std::span<const QnTimePeriod>>& periodLists,
+    std::chrono::milliseconds detailLevel)
+{
+    return nx::vms::common::TimePeriods<QnTimePeriod, QnTimePeriodList>::aggregate(
+        periodLists, detailLevel);
+}
+
 QnTimePeriodList QnTimePeriodList::intersection(
     const QnTimePeriodList& first, const QnTimePeriodList& second)
 {
@@ -5,6 +5,8 @@
 
 #define QN_TIME_PERIODS_STD
 
+#include <span>
+
 #ifdef QN_TIME_PERIODS_STD
     #include <vector>
 #else
@@ -151,6 +153,14 @@ public:
         const QnTimePeriodList& periods,
         std::chrono::milliseconds detailLevel);
 
+    /**
+     * Merges the sorted lists and aggregates the result in one pass, without the intermediate
+     * merged list.
+     */
+    static QnTimePeriodList aggregateTimePeriods(
+        const std::vector<std::span<const QnTimePeriod>>& periodLists,
+        std::chrono::milliseconds detailLevel);
+
     static QnTimePeriodList intersection(
         const QnTimePeriodList& first, const QnTimePeriodList& second);
 
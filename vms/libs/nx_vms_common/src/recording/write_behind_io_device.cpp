@@ -0,0 +1,537 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "write_behind_io_device.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QFileDevice>
+
+#if defined(Q_OS_UNIX)
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+#include <nx/utils/log/log.h>
+#include <nx/utils/system_error.h>
+#include <nx/utils/thread/thread_util.h>
+
+namespace nx::recording {
+
+using namespace std::chrono;
+using FsyncPolicy = WriteBehindSettings::FsyncPolicy;
+
+namespace {
+
+/** Alignment of the buffer address, size and file offset required by the direct I/O. */
+static constexpr int kAlignment = 4096;
+
+/** The adjacent buffers of a file written by one call. */
+static constexpr int kMaxBuffersPerWrite = 16;
+
+#if defined(Q_OS_UNIX)
+
+bool writeFully(int handle, qint64 offset, const char* data, qint64 size)
+{
+    while (size > 0)
+    {
+        const auto written = ::pwrite(handle, data, size, offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        offset += written;
+        size -= written;
+    }
+    return true;
+}
+
+#endif
+
+} // namespace
+
+namespace detail {
+
+struct Buffer
+{
+    explicit Buffer(int capacity):
+        data(static_cast<char*>(::operator new(capacity, std::align_val_t(kAlignment)))),
+        capacity(capacity)
+    {
+    }
+
+    ~Buffer() { ::operator delete(data, std::align_val_t(kAlignment)); }
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    qint64 end() const { return offset + size; }
+    bool isAligned() const { return offset % kAlignment == 0 && size % kAlignment == 0; }
+
+    char* const data;
+    const int capacity;
+    int size = 0;
+    qint64 offset = 0;
+};
+
+using BufferPtr = std::unique_ptr<Buffer>;
+
+struct WriteBehindFile
+{
+    std::unique_ptr<QIODevice> device;
+    WriteBehindSettings settings;
+    WriteBehindIoPool::Storage* storage = nullptr;
+    StorageIoScheduler* scheduler = nullptr;
+
+    /** POSIX file descriptor of the device, written without QIODevice if it is known. */
+    int handle = -1;
+    bool isDirectIo = false;
+
+    /** Being filled by the writer thread. */
+    BufferPtr buffer;
+
+    // Guarded by the storage mutex.
+    std::deque<BufferPtr> queue;
+    std::vector<BufferPtr> freeBuffers;
+    bool isScheduled = false;
+    bool hasError = false;
+
+    bool setDirectIo(bool value);
+
+    /** Writes the adjacent buffers. Called by the I/O thread. */
+    bool write(const BufferPtr* buffers, int count);
+    bool sync();
+};
+
+bool WriteBehindFile::setDirectIo(bool value)
+{
+    if (value == isDirectIo)
+        return true;
+
+    #if defined(Q_OS_LINUX)
+        const int flags = ::fcntl(handle, F_GETFL);
+        if (flags == -1
+            || ::fcntl(handle, F_SETFL, value ? (flags | O_DIRECT) : (flags & ~O_DIRECT)) == -1)
+        {
+            return false;
+        }
+        isDirectIo = value;
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+bool WriteBehindFile::write(const BufferPtr* buffers, int count)
+{
+    #if defined(Q_OS_UNIX)
+        if (handle >= 0)
+        {
+            if (settings.directIo)
+            {
+                const bool isAligned = std::all_of(buffers, buffers + count,
+                    [](const BufferPtr& buffer) { return buffer->isAligned(); });
+                if (!setDirectIo(isAligned))
+                    return false;
+            }
+
+            const qint64 offset = buffers[0]->offset;
+            qint64 written = 0;
+            #if defined(Q_OS_LINUX)
+                iovec vectors[kMaxBuffersPerWrite];
+                qint64 totalSize = 0;
+                for (int i = 0; i < count; ++i)
+                {
+                    vectors[i].iov_base = buffers[i]->data;
+                    vectors[i].iov_len = (size_t) buffers[i]->size;
+                    totalSize += buffers[i]->size;
+                }
+
+                do
+                {
+                    written = ::pwritev(handle, vectors, count, offset);
+                } while (written < 0 && errno == EINTR);
+
+                if (written == totalSize)
+                    return true;
+                if (written < 0)
+                    return false;
+
+                // The rest of the short write is not aligned anymore.
+                if (!setDirectIo(false))
+                    return false;
+            #endif
+
+            for (int i = 0; i < count; ++i)
+            {
+                const Buffer& buffer = *buffers[i];
+                const qint64 skipped =
+                    std::clamp<qint64>(written - (buffer.offset - offset), 0, buffer.size);
+                if (!writeFully(handle, buffer.offset + skipped, buffer.data + skipped,
+                    buffer.size - skipped))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    #endif
+
+    for (int i = 0; i < count; ++i)
+    {
+        const Buffer& buffer = *buffers[i];
+        if (device->pos() != buffer.offset && !device->seek(buffer.offset))
+            return false;
+        if (device->write(buffer.data, buffer.size) != buffer.size)
+            return false;
+    }
+    return true;
+}
+
+bool WriteBehindFile::sync()
+{
+    #if defined(Q_OS_LINUX)
+        if (handle >= 0)
+            return ::fdatasync(handle) == 0;
+    #elif defined(Q_OS_UNIX)
+        if (handle >= 0)
+            return ::fsync(handle) == 0;
+    #endif
+
+    if (const auto fileDevice = qobject_cast<QFileDevice*>(device.get()))
+        return fileDevice->flush();
+    return true;
+}
+
+} // namespace detail
+
+using namespace detail;
+
+//-------------------------------------------------------------------------------------------------
+
+struct WriteBehindIoPool::Storage
+{
+    QString id;
+    nx::Mutex mutex;
+    nx::WaitCondition hasWork;
+    nx::WaitCondition hasProgress;
+    std::deque<std::shared_ptr<WriteBehindFile>> readyFiles;
+    std::vector<std::thread> threads;
+    bool isTerminated = false;
+    Statistics statistics;
+
+    /** The buffers of the failed file are not written. */
+    void dropQueue(WriteBehindFile* file)
+    {
+        for (const auto& buffer: file->queue)
+        {
+            --statistics.queuedBuffers;
+            statistics.queuedBytes -= buffer->size;
+        }
+        file->queue.clear();
+    }
+};
+
+WriteBehindIoPool* WriteBehindIoPool::instance()
+{
+    static WriteBehindIoPool instance;
+    return &instance;
+}
+
+WriteBehindIoPool::~WriteBehindIoPool()
+{
+    for (const auto& [id, storage]: m_storages)
+    {
+        {
+            NX_MUTEX_LOCKER lock(&storage->mutex);
+            storage->isTerminated = true;
+            storage->hasWork.wakeAll();
+        }
+        for (auto& thread: storage->threads)
+            thread.join();
+    }
+}
+
+std::map<QString, WriteBehindIoPool::Statistics> WriteBehindIoPool::statistics() const
+{
+    std::map<QString, Statistics> result;
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    for (const auto& [id, storage]: m_storages)
+    {
+        NX_MUTEX_LOCKER storageLock(&storage->mutex);
+        result[id] = storage->statistics;
+    }
+    return result;
+}
+
+WriteBehindIoPool::Storage* WriteBehindIoPool::storage(const QString& storageId, int threadCount)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    auto& storage = m_storages[storageId];
+    if (!storage)
+    {
+        storage = std::make_unique<Storage>();
+        storage->id = storageId;
+        threadCount = std::max(threadCount, 1);
+        for (int i = 0; i < threadCount; ++i)
+            storage->threads.emplace_back([this, s = storage.get()]() { run(s); });
+        NX_DEBUG(this, "Started %1 I/O threads of the storage %2", threadCount, storageId);
+    }
+    return storage.get();
+}
+
+void WriteBehindIoPool::run(Storage* storage)
+{
+    nx::utils::setCurrentThreadName("WriteBehindIo");
+
+    std::vector<BufferPtr> buffers;
+    NX_MUTEX_LOCKER lock(&storage->mutex);
+    while (!storage->isTerminated)
+    {
+        if (storage->readyFiles.empty())
+        {
+            storage->hasWork.wait(&storage->mutex);
+            continue;
+        }
+
+        // The file is not taken by another thread until it is scheduled again, so its buffers
+        // are written in order.
+        const auto file = std::move(storage->readyFiles.front());
+        storage->readyFiles.pop_front();
+        for (auto& buffer: file->queue)
+            buffers.push_back(std::move(buffer));
+        file->queue.clear();
+
+        lock.unlock();
+        const auto startTime = steady_clock::now();
+        bool success = true;
+        int writeCount = 0;
+        for (size_t i = 0; success && i < buffers.size(); ++writeCount)
+        {
+            size_t end = i + 1;
+            while (end < buffers.size() && end - i < kMaxBuffersPerWrite
+                && buffers[end]->offset == buffers[end - 1]->end())
+            {
+                ++end;
+            }
+            qint64 bytes = 0;
+            for (size_t j = i; j < end; ++j)
+                bytes += buffers[j]->size;
+            const auto operation = file->scheduler->start(file->settings.ioClass, bytes);
+            success = file->write(&buffers[i], (int) (end - i));
+            i = end;
+        }
+        if (success && file->settings.fsyncPolicy == FsyncPolicy::always)
+            success = file->sync();
+        const std::string errorText = success ? std::string() : SystemError::getLastOSErrorText();
+        const auto writeTime = duration_cast<microseconds>(steady_clock::now() - startTime);
+        lock.relock();
+
+        auto& statistics = storage->statistics;
+        statistics.writeCount += writeCount;
+        statistics.writeTime += writeTime;
+        for (auto& buffer: buffers)
+        {
+            --statistics.queuedBuffers;
+            statistics.queuedBytes -= buffer->size;
+            if (success)
+                statistics.writtenBytes += buffer->size;
+            buffer->size = 0;
+            if ((int) file->freeBuffers.size() < file->settings.maxQueuedBuffers)
+                file->freeBuffers.push_back(std::move(buffer));
+        }
+        buffers.clear();
+
+        if (!success)
+        {
+            NX_WARNING(this, "Write failed on the storage %1: %2", storage->id, errorText);
+            ++statistics.errorCount;
+            file->hasError = true;
+            storage->dropQueue(file.get());
+        }
+
+        if (file->queue.empty())
+            file->isScheduled = false;
+        else
+            storage->readyFiles.push_back(file); //< After the other files of the storage.
+        storage->hasProgress.wakeAll();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+WriteBehindIoDevice::WriteBehindIoDevice(
+    std::unique_ptr<QIODevice> device,
+    const QString& storageId,
+    const WriteBehindSettings& settings)
+    :
+    m_file(std::make_shared<WriteBehindFile>()),
+    m_size(device->size())
+{
+    auto& fileSettings = m_file->settings;
+    fileSettings = settings;
+    fileSettings.bufferSize =
+        (std::max(settings.bufferSize, 1) + kAlignment - 1) / kAlignment * kAlignment;
+    fileSettings.maxQueuedBuffers = std::max(settings.maxQueuedBuffers, 1);
+
+    #if defined(Q_OS_UNIX)
+        if (const auto fileDevice = qobject_cast<QFileDevice*>(device.get()))
+        {
+            fileDevice->flush();
+            m_file->handle = fileDevice->handle();
+        }
+    #endif
+    m_file->device = std::move(device);
+
+    if (fileSettings.directIo && (m_file->handle < 0 || !m_file->setDirectIo(true)))
+    {
+        NX_DEBUG(this, "Direct I/O is not supported for the file, the OS cache is used");
+        fileSettings.directIo = false;
+    }
+
+    m_file->storage = WriteBehindIoPool::instance()->storage(
+        storageId, settings.threadsPerStorage);
+    m_file->scheduler = StorageIoScheduler::forStorage(storageId);
+    {
+        NX_MUTEX_LOCKER lock(&m_file->storage->mutex);
+        ++m_file->storage->statistics.fileCount;
+    }
+
+    QIODevice::open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+}
+
+WriteBehindIoDevice::~WriteBehindIoDevice()
+{
+    close();
+}
+
+bool WriteBehindIoDevice::seek(qint64 pos)
+{
+    // The buffer being filled is continued by the sequential write only.
+    const auto& buffer = m_file->buffer;
+    if (buffer && buffer->size > 0 && buffer->end() != pos && !submitBuffer())
+        return false;
+
+    return QIODevice::seek(pos);
+}
+
+qint64 WriteBehindIoDevice::size() const
+{
+    return m_size;
+}
+
+void WriteBehindIoDevice::close()
+{
+    if (!isOpen())
+        return;
+
+    if (!flush())
+        NX_WARNING(this, "Failed to write the file");
+    else if (m_file->settings.fsyncPolicy == FsyncPolicy::onClose && !m_file->sync())
+        NX_WARNING(this, "Failed to sync the file");
+    m_file->device->close();
+
+    const auto storage = m_file->storage;
+    {
+        NX_MUTEX_LOCKER lock(&storage->mutex);
+        --storage->statistics.fileCount;
+        m_file->freeBuffers.clear();
+    }
+    m_file->buffer.reset();
+
+    QIODevice::close();
+}
+
+bool WriteBehindIoDevice::flush()
+{
+    if (!submitBuffer())
+        return false;
+
+    const auto storage = m_file->storage;
+    NX_MUTEX_LOCKER lock(&storage->mutex);
+    while (m_file->isScheduled)
+        storage->hasProgress.wait(&storage->mutex);
+    return !m_file->hasError;
+}
+
+qint64 WriteBehindIoDevice::readData(char* /*data*/, qint64 /*maxSize*/)
+{
+    return -1;
+}
+
+qint64 WriteBehindIoDevice::writeData(const char* data, qint64 size)
+{
+    auto& buffer = m_file->buffer;
+    for (qint64 written = 0; written < size; )
+    {
+        if (!buffer)
+        {
+            NX_MUTEX_LOCKER lock(&m_file->storage->mutex);
+            if (m_file->hasError)
+                return -1;
+
+            if (m_file->freeBuffers.empty())
+            {
+                buffer = std::make_unique<Buffer>(m_file->settings.bufferSize);
+            }
+            else
+            {
+                buffer = std::move(m_file->freeBuffers.back());
+                m_file->freeBuffers.pop_back();
+            }
+        }
+
+        if (buffer->size == 0)
+            buffer->offset = pos() + written;
+
+        const qint64 chunkSize = std::min<qint64>(size - written, buffer->capacity - buffer->size);
+        memcpy(buffer->data + buffer->size, data + written, chunkSize);
+        buffer->size += (int) chunkSize;
+        written += chunkSize;
+
+        if (buffer->size == buffer->capacity && !submitBuffer())
+            return -1;
+    }
+
+    m_size = std::max(m_size, pos() + size);
+    return size;
+}
+
+bool WriteBehindIoDevice::submitBuffer()
+{
+    const auto storage = m_file->storage;
+    NX_MUTEX_LOCKER lock(&storage->mutex);
+    auto& buffer = m_file->buffer;
+    if (!buffer || buffer->size == 0)
+        return !m_file->hasError;
+
+    while ((int) m_file->queue.size() >= m_file->settings.maxQueuedBuffers && !m_file->hasError)
+        storage->hasProgress.wait(&storage->mutex);
+    if (m_file->hasError)
+        return false;
+
+    auto& statistics = storage->statistics;
+    ++statistics.queuedBuffers;
+    statistics.queuedBytes += buffer->size;
+    statistics.maxQueuedBuffers = std::max(statistics.maxQueuedBuffers, statistics.queuedBuffers);
+
+    m_file->queue.push_back(std::move(buffer));
+    if (!m_file->isScheduled)
+    {
+        m_file->isScheduled = true;
+        storage->readyFiles.push_back(m_file);
+        storage->hasWork.wakeOne();
+    }
+    return true;
+}
+
+} // namespace nx::recording
@@ -0,0 +1,130 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+
+#include <QtCore/QIODevice>
+#include <QtCore/QString>
+
+#include <nx/utils/thread/mutex.h>
+
+#include "storage_io_scheduler.h"
+
+namespace nx::recording {
+
+struct WriteBehindSettings
+{
+    enum class FsyncPolicy
+    {
+        never,
+        /** Once, when the file is closed. */
+        onClose,
+        /** After each write of the I/O thread. */
+        always,
+    };
+
+    /** Rounded up to the direct I/O alignment. */
+    int bufferSize = 1024 * 1024;
+
+    /** The writer is blocked while this number of its buffers is waiting for the I/O thread. */
+    int maxQueuedBuffers = 8;
+
+    /** Number of the I/O threads of the storage, set by the first file of the storage. */
+    int threadsPerStorage = 2;
+
+    /**
+     * Bypasses the OS page cache for the aligned writes, if the file system supports it. Linux
+     * only: the file is opened by the storage, and Windows can not switch the opened file to
+     * FILE_FLAG_NO_BUFFERING.
+     */
+    bool directIo = false;
+
+    FsyncPolicy fsyncPolicy = FsyncPolicy::onClose;
+
+    /** Class of the writes in the I/O scheduler of the storage. */
+    StorageIoClass ioClass = StorageIoClass::record;
+};
+
+namespace detail { struct WriteBehindFile; }
+
+/**
+ * Write-only file device, which collects the written data into large aligned buffers and passes
+ * them to the I/O threads of the storage, so the recorder thread does not wait for the disk. Each
+ * buffer is written at its own offset, so seek() does not wait for the queued buffers.
+ *
+ * The write error of the I/O thread is reported by the next write(), flush() or close().
+ */
+class NX_VMS_COMMON_API WriteBehindIoDevice: public QIODevice
+{
+public:
+    /** @param storageId The files of the same storage share the I/O threads. */
+    WriteBehindIoDevice(
+        std::unique_ptr<QIODevice> device,
+        const QString& storageId,
+        const WriteBehindSettings& settings);
+    virtual ~WriteBehindIoDevice() override;
+
+    virtual bool isSequential() const override { return false; }
+    virtual bool seek(qint64 pos) override;
+    virtual qint64 size() const override;
+    virtual void close() override;
+
+    /** Waits until all the written data is passed to the wrapped device. */
+    bool flush();
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize) override;
+    virtual qint64 writeData(const char* data, qint64 size) override;
+
+private:
+    bool submitBuffer();
+
+private:
+    std::shared_ptr<detail::WriteBehindFile> m_file;
+    qint64 m_size = 0;
+};
+
+/** I/O threads of the write-behind files, a bounded set per storage. */
+class NX_VMS_COMMON_API WriteBehindIoPool
+{
+public:
+    struct Statistics
+    {
+        int fileCount = 0;
+
+        /** Buffers waiting for the I/O thread or being written: the queue depth. */
+        int queuedBuffers = 0;
+        qint64 queuedBytes = 0;
+        int maxQueuedBuffers = 0;
+
+        qint64 writtenBytes = 0;
+
+        /** The adjacent buffers of a file are written by one call. */
+        int writeCount = 0;
+        std::chrono::microseconds writeTime{0};
+        int errorCount = 0;
+    };
+
+    struct Storage;
+
+    static WriteBehindIoPool* instance();
+    ~WriteBehindIoPool();
+
+    /** @return Statistics per storage id. */
+    std::map<QString, Statistics> statistics() const;
+
+    Storage* storage(const QString& storageId, int threadCount);
+
+private:
+    WriteBehindIoPool() = default;
+    void run(Storage* storage);
+
+private:
+    mutable nx::Mutex m_mutex;
+    std::map<QString, std::unique_ptr<Storage>> m_storages;
+};
+
+} // namespace nx::recording
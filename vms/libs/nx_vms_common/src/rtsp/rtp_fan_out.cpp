@@ -0,0 +1,190 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "rtp_fan_out.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <nx/utils/log/log.h>
+
+namespace nx::vms::server::rtsp {
+
+namespace {
+
+static constexpr int kRtcpSsrcOffset = 4;
+static constexpr int kRtpSsrcOffset = 8;
+
+bool isKeyFrame(const QnConstAbstractMediaDataPtr& media)
+{
+    return media->dataType != QnAbstractMediaData::VIDEO
+        || (media->flags & QnAbstractMediaData::MediaFlags_AVKey);
+}
+
+} // namespace
+
+RtpFanOut::Subscriber::Subscriber(const SubscriberSettings& settings):
+    m_settings(settings),
+    m_sequence(settings.initialSequence)
+{
+}
+
+void RtpFanOut::Subscriber::push(
+    const std::vector<QueuedPacket>& packets, size_t bytes, bool isKeyFrame)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (m_overflowed)
+        return;
+
+    if (!m_queue.empty() && m_queuedBytes + bytes > m_settings.maxQueueBytes)
+    {
+        NX_VERBOSE(this, "Queue overflow: %1 bytes queued, dropping %2 packets",
+            m_queuedBytes, m_queue.size());
+        m_droppedPackets += m_queue.size();
+        m_queue.clear();
+        m_queuedBytes = 0;
+        if (m_settings.policy == SlowConsumerPolicy::disconnect)
+        {
+            m_overflowed = true;
+            return;
+        }
+        m_waitingForKeyFrame = true;
+    }
+
+    if (m_waitingForKeyFrame)
+    {
+        if (!isKeyFrame)
+        {
+            // The frames before the first key frame are not dropped, they are not subscribed to.
+            if (m_hasReceivedKeyFrame)
+                m_droppedPackets += packets.size();
+            return;
+        }
+        m_waitingForKeyFrame = false;
+        m_hasReceivedKeyFrame = true;
+    }
+
+    m_queue.insert(m_queue.end(), packets.begin(), packets.end());
+    m_queuedBytes += bytes;
+}
+
+bool RtpFanOut::Subscriber::takeNextPacket(Packet* packet)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (m_queue.empty())
+        return false;
+
+    QueuedPacket queued = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_queuedBytes -= queued.data.size();
+
+    const uint32_t ssrc = htonl(m_settings.ssrc);
+    std::memcpy(packet->header.data(), queued.data.data(), packet->header.size());
+    if (queued.isRtcp)
+    {
+        std::memcpy(packet->header.data() + kRtcpSsrcOffset, &ssrc, sizeof(ssrc));
+    }
+    else
+    {
+        auto header = (nx::rtp::RtpHeader*) packet->header.data();
+        header->sequence = htons(m_sequence++);
+        std::memcpy(packet->header.data() + kRtpSsrcOffset, &ssrc, sizeof(ssrc));
+    }
+    packet->payload = queued.data.subBuffer(packet->header.size());
+    return true;
+}
+
+bool RtpFanOut::Subscriber::getNextPacket(nx::utils::ByteArray& sendBuffer)
+{
+    Packet packet;
+    if (!takeNextPacket(&packet))
+        return false;
+
+    sendBuffer.write(packet.header.data(), packet.header.size());
+    sendBuffer.write(packet.payload.data(), packet.payload.size());
+    return true;
+}
+
+size_t RtpFanOut::Subscriber::queuedBytes() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_queuedBytes;
+}
+
+size_t RtpFanOut::Subscriber::droppedPackets() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_droppedPackets;
+}
+
+bool RtpFanOut::Subscriber::isOverflowed() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return m_overflowed;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+RtpFanOut::RtpFanOut(AbstractRtspEncoderPtr encoder):
+    m_encoder(std::move(encoder))
+{
+}
+
+std::shared_ptr<RtpFanOut::Subscriber> RtpFanOut::addSubscriber(
+    const SubscriberSettings& settings)
+{
+    auto subscriber = std::make_shared<Subscriber>(settings);
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_subscribers.push_back(subscriber);
+    return subscriber;
+}
+
+void RtpFanOut::pushFrame(const QnConstAbstractMediaDataPtr& media)
+{
+    // Packets are written one after another, their boundaries are kept separately.
+    std::vector<size_t> packetEnds;
+    m_packetizationBuffer.clear();
+    m_encoder->setDataPacket(media);
+    while (m_encoder->getNextPacket(m_packetizationBuffer))
+        packetEnds.push_back(m_packetizationBuffer.size());
+    if (packetEnds.empty())
+        return;
+
+    const nx::SharedBuffer frame(
+        nx::Buffer(m_packetizationBuffer.data(), m_packetizationBuffer.size()));
+    m_packets.clear();
+    size_t bytes = 0;
+    size_t offset = 0;
+    for (const size_t end: packetEnds)
+    {
+        const size_t size = end - offset;
+        if (size >= (size_t) nx::rtp::RtpHeader::kSize)
+        {
+            const auto header = (const nx::rtp::RtpHeader*) (frame.data() + offset);
+            m_packets.push_back({frame.subBuffer(offset, size), header->isRtcp()});
+            bytes += size;
+        }
+        else
+        {
+            NX_DEBUG(this, "Ignoring a packet of %1 bytes", size);
+        }
+        offset = end;
+    }
+
+    const bool keyFrame = isKeyFrame(media);
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    std::erase_if(m_subscribers, [](const auto& subscriber) { return subscriber.expired(); });
+    for (const auto& weakSubscriber: m_subscribers)
+    {
+        if (auto subscriber = weakSubscriber.lock())
+            subscriber->push(m_packets, bytes, keyFrame);
+    }
+}
+
+size_t RtpFanOut::subscriberCount() const
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    return std::count_if(m_subscribers.begin(), m_subscribers.end(),
+        [](const auto& subscriber) { return !subscriber.expired(); });
+}
+
+} // namespace nx::vms::server::rtsp
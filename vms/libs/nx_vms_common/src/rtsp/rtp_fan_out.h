@@ -0,0 +1,123 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <nx/rtp/rtp.h>
+#include <nx/utils/shared_buffer.h>
+#include <nx/utils/thread/mutex.h>
+
+#include "rtsp/abstract_rtsp_encoder.h"
+
+namespace nx::vms::server::rtsp {
+
+/**
+ * Serves one media track to several RTP consumers. Each frame is packetized once by the encoder
+ * into a reference-counted buffer, and the queues of all the subscribers reference its slices.
+ * Only the fixed RTP header (the sequence number and SSRC) is written per subscriber.
+ * NOTE: The encoder must not encrypt the packets (SRTP), since the keys are per consumer.
+ */
+class NX_VMS_COMMON_API RtpFanOut
+{
+public:
+    enum class SlowConsumerPolicy
+    {
+        /** Drops the queued packets and skips the frames up to the next key frame. */
+        dropToKeyFrame,
+        /** Drops the queued packets and marks the subscriber as overflowed. */
+        disconnect,
+    };
+
+    struct SubscriberSettings
+    {
+        uint32_t ssrc = 0;
+        uint16_t initialSequence = 0;
+        /** The policy is applied when the queued packets would exceed this size. */
+        size_t maxQueueBytes = 4 * 1024 * 1024;
+        SlowConsumerPolicy policy = SlowConsumerPolicy::dropToKeyFrame;
+    };
+
+    struct Packet
+    {
+        /** Fixed RTP header with the sequence number and SSRC of the subscriber. */
+        std::array<char, nx::rtp::RtpHeader::kSize> header{};
+        /** The rest of the packet, shared by all the subscribers. */
+        nx::SharedBuffer payload;
+    };
+
+    class NX_VMS_COMMON_API Subscriber
+    {
+    public:
+        Subscriber(const SubscriberSettings& settings);
+
+        /**
+         * Takes the next queued packet. The header and the payload are meant to be sent with a
+         * single gathered write.
+         * @return False if the queue is empty.
+         */
+        bool takeNextPacket(Packet* packet);
+
+        /**
+         * Appends the next queued packet to the buffer, the same way
+         * AbstractRtspEncoder::getNextPacket() does.
+         */
+        bool getNextPacket(nx::utils::ByteArray& sendBuffer);
+
+        size_t queuedBytes() const;
+        /** Number of the packets dropped by the slow consumer policy. */
+        size_t droppedPackets() const;
+        /** True if the queue has overflowed with the SlowConsumerPolicy::disconnect policy. */
+        bool isOverflowed() const;
+
+    private:
+        friend class RtpFanOut;
+
+        struct QueuedPacket
+        {
+            nx::SharedBuffer data;
+            bool isRtcp = false;
+        };
+
+        void push(const std::vector<QueuedPacket>& packets, size_t bytes, bool isKeyFrame);
+
+    private:
+        const SubscriberSettings m_settings;
+        mutable nx::Mutex m_mutex;
+        std::deque<QueuedPacket> m_queue;
+        size_t m_queuedBytes = 0;
+        size_t m_droppedPackets = 0;
+        uint16_t m_sequence = 0;
+        bool m_waitingForKeyFrame = true;
+        bool m_hasReceivedKeyFrame = false;
+        bool m_overflowed = false;
+    };
+
+    RtpFanOut(AbstractRtspEncoderPtr encoder);
+
+    /**
+     * The subscriber receives the packets starting from the next key frame. It is unsubscribed
+     * when the returned pointer is released.
+     */
+    std::shared_ptr<Subscriber> addSubscriber(const SubscriberSettings& settings);
+
+    /**
+     * Packetizes the frame and queues its packets to all the subscribers. Must be called from a
+     * single thread.
+     */
+    void pushFrame(const QnConstAbstractMediaDataPtr& media);
+
+    size_t subscriberCount() const;
+
+private:
+    const AbstractRtspEncoderPtr m_encoder;
+    nx::utils::ByteArray m_packetizationBuffer;
+    std::vector<Subscriber::QueuedPacket> m_packets;
+    mutable nx::Mutex m_mutex;
+    std::vector<std::weak_ptr<Subscriber>> m_subscribers;
+};
+
+} // namespace nx::vms::server::rtsp
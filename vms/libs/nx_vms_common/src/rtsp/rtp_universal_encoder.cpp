@@ -434,6 +434,13 @@ bool QnUniversalRtpEncoder::getNextNackPacket(nx::utils::ByteArray& sendBuffer)
     return m_rtcpNackResponder && m_rtcpNackResponder->getNextPacket(sendBuffer);
 }
 
+nx::rtp::RtcpNackStatistics QnUniversalRtpEncoder::nackStatistics() const
+{
+    return m_rtcpNackResponder
+        ? m_rtcpNackResponder->statistics()
+        : nx::rtp::RtcpNackStatistics();
+}
+
 void QnUniversalRtpEncoder::setDataPacket(QnConstAbstractMediaDataPtr media)
 {
     // Do not continue rtsp stream if codec changed.
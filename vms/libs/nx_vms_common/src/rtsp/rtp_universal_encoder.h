@@ -50,6 +50,8 @@ public:
 
     void setRtcpPacket(uint8_t* data, int size);
     bool getNextNackPacket(nx::utils::ByteArray& sendBuffer);
+    /** Counters of the packets resent on the RTCP NACK requests. */
+    nx::rtp::RtcpNackStatistics nackStatistics() const;
     void setSrtpEncryptionData(const nx::vms::server::rtsp::EncryptionData& data);
     nx::vms::server::rtsp::SrtpEncryptor* encryptor() const;
     FfmpegMuxer::PacketTimestamp getLastTimestamps() const;
@@ -6,6 +6,7 @@
 #include <nx/media/video_data_packet.h>
 #include <nx/network/socket.h>
 #include <nx/rtp/rtp.h>
+#include <transcoding/transcoding_ini.h>
 #include <utils/common/util.h>
 
 namespace {
@@ -35,6 +36,9 @@ void QnRtspFfmpegEncoder::setDstResolution(const QSize& dstVideoSize, AVCodecID
     config.decoderConfig = m_decoderConfig;
     config.targetCodecId = dstCodec;
     config.outputResolutionLimit = dstVideoSize;
+    config.hardwareEncoders =
+        nx::transcoding::hwEncoderBackends(nx::transcoding::ini().hardwareEncoders);
+    config.useHardwareDecoder = nx::transcoding::ini().hardwareDecoding;
     m_videoTranscoder.reset(new QnFfmpegVideoTranscoder(config, m_metrics));
 }
 
@@ -2,6 +2,8 @@
 
 #include "ffmpeg_audio_buffer.h"
 
+#include <algorithm>
+
 #include <nx/media/ffmpeg/ffmpeg_utils.h>
 #include <nx/utils/log/log.h>
 
@@ -25,7 +27,8 @@ uint8_t** FfmpegAudioBuffer::startWriting(uint64_t sampleCount)
     uint64_t requestedSize = m_sampleSize * sampleCount;
     if (m_sampleBuffers == nullptr || requestedSize > m_bufferSize - m_dataSize)
     {
-        if (!allocBuffers(sampleCount + m_dataSize / m_sampleSize))
+        const uint64_t requiredCount = sampleCount + m_dataSize / m_sampleSize;
+        if (!allocBuffers(std::max(requiredCount, 2 * capacity())))
             return nullptr;
     }
 
@@ -10,6 +10,10 @@ extern "C" {
 
 /**
  * Audio sample buffer, that help to implement non copy audio resampling.
+ *
+ * The storage grows geometrically and the unread samples are moved to its start only when there
+ * is no room left at its end, so a stream of writes and reads of similar size settles down to a
+ * fixed storage without per-packet reallocations or copies.
  */
 class NX_VMS_COMMON_API FfmpegAudioBuffer
 {
@@ -52,6 +56,9 @@ public:
     uint32_t planeCount() const { return m_planeCount; }
     uint32_t sampleSize() const { return m_sampleSize; }
 
+    /** Number of samples which fit the allocated storage. */
+    uint64_t capacity() const { return m_sampleSize ? m_bufferSize / m_sampleSize : 0; }
+
 private:
     bool allocBuffers(uint64_t sampleCount);
     void releaseBuffers();
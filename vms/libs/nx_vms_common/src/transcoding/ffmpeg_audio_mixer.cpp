@@ -0,0 +1,140 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "ffmpeg_audio_mixer.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+#include <nx/media/ffmpeg/ffmpeg_utils.h>
+#include <nx/utils/log/log.h>
+
+FfmpegAudioMixer::FfmpegAudioMixer(const Config& config):
+    m_config(config),
+    m_frame(av_frame_alloc())
+{
+    m_frame->format = AV_SAMPLE_FMT_FLTP;
+    m_frame->sample_rate = m_config.sampleRate;
+    m_frame->nb_samples = m_config.frameSize;
+    av_channel_layout_copy(&m_frame->ch_layout, &m_config.channelLayout);
+
+    if (int status = av_frame_get_buffer(m_frame, /*align*/ 0); status < 0)
+    {
+        NX_ERROR(this, "Failed to allocate mixer frame, error: %1",
+            nx::media::ffmpeg::avErrorToString(status));
+        av_frame_free(&m_frame);
+    }
+}
+
+FfmpegAudioMixer::~FfmpegAudioMixer()
+{
+    av_frame_free(&m_frame);
+}
+
+int FfmpegAudioMixer::addInput()
+{
+    const int inputId = ++m_lastInputId;
+    m_inputs.emplace(inputId, Input());
+    return inputId;
+}
+
+void FfmpegAudioMixer::removeInput(int inputId)
+{
+    if (auto it = m_inputs.find(inputId); it != m_inputs.end())
+        it->second.isRemoved = true;
+}
+
+bool FfmpegAudioMixer::pushFrame(int inputId, AVFrame* inputFrame)
+{
+    auto it = m_inputs.find(inputId);
+    if (!m_frame || it == m_inputs.end() || it->second.isRemoved)
+        return false;
+
+    auto& resampler = it->second.resampler;
+    if (!resampler)
+    {
+        FfmpegAudioResampler::Config config{
+            inputFrame->sample_rate,
+            inputFrame->ch_layout,
+            (AVSampleFormat) inputFrame->format,
+            m_config.sampleRate,
+            m_config.channelLayout,
+            AV_SAMPLE_FMT_FLTP,
+            m_config.frameSize};
+
+        resampler = std::make_unique<FfmpegAudioResampler>();
+        if (!resampler->init(config))
+        {
+            resampler.reset();
+            return false;
+        }
+    }
+    return resampler->pushFrame(inputFrame);
+}
+
+AVFrame* FfmpegAudioMixer::nextFrame()
+{
+    if (!m_frame)
+        return nullptr;
+
+    bool hasSamples = false;
+    for (const auto& [inputId, input]: m_inputs)
+    {
+        if (input.resampler && input.resampler->hasFrame())
+            hasSamples = true;
+        else if (!input.isRemoved)
+            return nullptr; //< Waiting for the input.
+    }
+
+    bool isFirst = true;
+    for (auto it = m_inputs.begin(); it != m_inputs.end();)
+    {
+        auto& input = it->second;
+        if (input.resampler && input.resampler->hasFrame())
+        {
+            const AVFrame* frame = input.resampler->nextFrame();
+            if (isFirst)
+                m_frame->pts = frame->pts;
+            addSamples(frame, isFirst);
+            isFirst = false;
+        }
+
+        // The incomplete frame of a removed input is never mixed.
+        if (input.isRemoved && !(input.resampler && input.resampler->hasFrame()))
+            it = m_inputs.erase(it);
+        else
+            ++it;
+    }
+
+    if (!hasSamples)
+        return nullptr;
+
+    for (int channel = 0; channel < m_frame->ch_layout.nb_channels; ++channel)
+    {
+        float* samples = (float*) m_frame->extended_data[channel];
+        for (uint32_t i = 0; i < m_config.frameSize; ++i)
+            samples[i] = std::clamp(samples[i], -1.0f, 1.0f);
+    }
+    return m_frame;
+}
+
+void FfmpegAudioMixer::addSamples(const AVFrame* source, bool isFirst)
+{
+    for (int channel = 0; channel < m_frame->ch_layout.nb_channels; ++channel)
+    {
+        float* destination = (float*) m_frame->extended_data[channel];
+        const float* samples = (const float*) source->extended_data[channel];
+        if (isFirst)
+        {
+            std::memcpy(destination, samples, m_config.frameSize * sizeof(float));
+            continue;
+        }
+
+        // A plain loop over the contiguous planes, vectorized by the compiler.
+        for (uint32_t i = 0; i < m_config.frameSize; ++i)
+            destination[i] += samples[i];
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include "ffmpeg_audio_resampler.h"
+
+/**
+ * Mixes the audio of several sources (e.g. the cameras of an exported layout) into one stream.
+ *
+ * Every input has its own resampler, which converts its frames to the output sample rate and
+ * channel layout, so the inputs may have different formats. The mixing is done in the planar
+ * float format, which is the native one of the AAC encoder, and the result is clipped to
+ * [-1.0, 1.0].
+ */
+class NX_VMS_COMMON_API FfmpegAudioMixer
+{
+public:
+    struct Config
+    {
+        int32_t sampleRate = 0;
+        AVChannelLayout channelLayout;
+        uint32_t frameSize = 1024;
+    };
+
+public:
+    FfmpegAudioMixer(const Config& config);
+    ~FfmpegAudioMixer();
+
+    /** @return Id of the new input. */
+    int addInput();
+
+    /**
+     * The mixer stops waiting for the samples of the input. The samples which have been already
+     * pushed are still mixed.
+     */
+    void removeInput(int inputId);
+
+    bool pushFrame(int inputId, AVFrame* inputFrame);
+
+    /**
+     * @return The mixed frame in AV_SAMPLE_FMT_FLTP, valid until the next call, or nullptr if
+     *     some input does not have enough samples yet. Its pts is the one of the first input
+     *     which has participated in the mixing.
+     */
+    AVFrame* nextFrame();
+
+private:
+    struct Input
+    {
+        std::unique_ptr<FfmpegAudioResampler> resampler;
+        bool isRemoved = false;
+    };
+
+    void addSamples(const AVFrame* source, bool isFirst);
+
+private:
+    const Config m_config;
+    AVFrame* m_frame = nullptr;
+    std::map<int, Input> m_inputs;
+    int m_lastInputId = 0;
+};
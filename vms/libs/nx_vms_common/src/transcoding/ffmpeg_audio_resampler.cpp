@@ -2,6 +2,8 @@
 
 #include "ffmpeg_audio_resampler.h"
 
+#include <algorithm>
+
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavutil/opt.h>
@@ -18,47 +20,131 @@ FfmpegAudioResampler::FfmpegAudioResampler()
 
 FfmpegAudioResampler::~FfmpegAudioResampler()
 {
-    if (m_swrContext)
-        swr_free(&m_swrContext);
+    clearContexts();
     av_frame_free(&m_frame);
 }
 
+bool FfmpegAudioResampler::SourceFormat::operator==(const SourceFormat& other) const
+{
+    return sampleRate == other.sampleRate
+        && sampleFormat == other.sampleFormat
+        && av_channel_layout_compare(&channelLayout, &other.channelLayout) == 0;
+}
+
 bool FfmpegAudioResampler::init(const Config& config)
 {
+    clearContexts();
     m_samplePts.clear();
     m_config = config;
+
+    const SourceFormat format{
+        config.srcSampleRate, config.srcChannelLayout, config.srcSampleFormat};
+    m_swrContext = createContext(format);
+    if (!m_swrContext)
+        return false;
+
+    m_contexts.push_back({format, m_swrContext});
+    m_buffer.init(
+        FfmpegAudioBuffer::Config{config.dstChannelLayout.nb_channels, config.dstSampleFormat});
+    return true;
+}
+
+SwrContext* FfmpegAudioResampler::createContext(const SourceFormat& format)
+{
+    SwrContext* context = nullptr;
     swr_alloc_set_opts2(
-        &m_swrContext,
-        &config.dstChannelLayout,
-        config.dstSampleFormat,
-        config.dstSampleRate,
-        &config.srcChannelLayout,
-        config.srcSampleFormat,
-        config.srcSampleRate,
+        &context,
+        &m_config.dstChannelLayout,
+        m_config.dstSampleFormat,
+        m_config.dstSampleRate,
+        &format.channelLayout,
+        format.sampleFormat,
+        format.sampleRate,
         0,
         NULL);
-    if (!m_swrContext)
+    if (!context)
     {
         NX_ERROR(this, "Could not allocate resample context");
-        return false;
+        return nullptr;
     }
-    int status = swr_init(m_swrContext);
+    int status = swr_init(context);
     if (status < 0)
     {
         NX_ERROR(this, "Could not open resample context, error: %1",
             nx::media::ffmpeg::avErrorToString(status));
-        swr_free(&m_swrContext);
-        m_swrContext = nullptr;
+        swr_free(&context);
+        return nullptr;
+    }
+    return context;
+}
+
+void FfmpegAudioResampler::clearContexts()
+{
+    for (auto& context: m_contexts)
+        swr_free(&context.swrContext);
+    m_contexts.clear();
+    m_swrContext = nullptr;
+}
+
+bool FfmpegAudioResampler::selectContext(const AVFrame* inputFrame)
+{
+    SourceFormat format{
+        inputFrame->sample_rate, inputFrame->ch_layout, (AVSampleFormat) inputFrame->format};
+    if (format.sampleRate <= 0 || format.sampleFormat == AV_SAMPLE_FMT_NONE
+        || format.channelLayout.nb_channels == 0)
+    {
+        return true; //< The format is unknown, suppose it has not changed.
+    }
+
+    if (m_contexts.front().format == format)
+        return true;
+
+    NX_DEBUG(this, "Source format changed to %1 Hz, %2 channels, sample format %3",
+        format.sampleRate, format.channelLayout.nb_channels, format.sampleFormat);
+
+    // The samples delayed by the previous context belong to the stream before the change.
+    if (!convert(/*data*/ nullptr, /*sampleCount*/ 0, /*pts*/ 0))
         return false;
+
+    auto it = std::find_if(m_contexts.begin(), m_contexts.end(),
+        [&format](const Context& context) { return context.format == format; });
+    if (it == m_contexts.end())
+    {
+        SwrContext* swrContext = createContext(format);
+        if (!swrContext)
+            return false;
+
+        if ((int) m_contexts.size() >= kMaxContextCount)
+        {
+            swr_free(&m_contexts.back().swrContext);
+            m_contexts.pop_back();
+        }
+        m_contexts.insert(m_contexts.begin(), {format, swrContext});
     }
-    m_buffer.init(
-        FfmpegAudioBuffer::Config{config.dstChannelLayout.nb_channels, config.dstSampleFormat});
+    else
+    {
+        std::rotate(m_contexts.begin(), it, it + 1);
+    }
+    m_swrContext = m_contexts.front().swrContext;
     return true;
 }
 
 bool FfmpegAudioResampler::pushFrame(AVFrame* inputFrame)
 {
-    uint64_t outSampleCount = swr_get_out_samples(m_swrContext, inputFrame->nb_samples);
+    if (m_contexts.empty() || !selectContext(inputFrame))
+        return false;
+
+    return convert(
+        const_cast<const uint8_t**>(inputFrame->extended_data),
+        inputFrame->nb_samples,
+        inputFrame->pts);
+}
+
+bool FfmpegAudioResampler::convert(const uint8_t** data, int sampleCount, int64_t pts)
+{
+    uint64_t outSampleCount = swr_get_out_samples(m_swrContext, sampleCount);
+    if (outSampleCount == 0)
+        return true;
 
     uint8_t** sampleBuffer = m_buffer.startWriting(outSampleCount);
     if (!sampleBuffer)
@@ -70,8 +156,8 @@ bool FfmpegAudioResampler::pushFrame(AVFrame* inputFrame)
         m_swrContext,
         sampleBuffer,
         outSampleCount,
-        const_cast<const uint8_t**>(inputFrame->extended_data),
-        inputFrame->nb_samples);
+        data,
+        sampleCount);
 
     if (result < 0)
     {
@@ -80,7 +166,13 @@ bool FfmpegAudioResampler::pushFrame(AVFrame* inputFrame)
         return false;
     }
     m_buffer.finishWriting(static_cast<uint64_t>(result));
-    m_samplePts.push_back({inputFrame->pts, result});
+    if (result == 0)
+        return true;
+
+    if (!data && !m_samplePts.empty()) //< The flushed samples continue the previous frame.
+        m_samplePts.back().sampleCount += result;
+    else
+        m_samplePts.push_back({pts, result});
     return true;
 }
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <queue>
+#include <vector>
 
 #include <stdint.h>
 
@@ -11,6 +12,14 @@
 struct SwrContext;
 struct AVFrame;
 
+/**
+ * Converts the audio frames to the destination format and splits them to the frames of the
+ * destination size.
+ *
+ * The source format is taken from every frame, so a stream may change it on the fly (e.g. after
+ * a camera reconfiguration). The resampling contexts of the recently used source formats are kept,
+ * so a stream switching between the formats does not set them up again.
+ */
 class FfmpegAudioResampler
 {
 public:
@@ -34,8 +43,29 @@ public:
     AVFrame* nextFrame();
     bool hasFrame() const;
 
+    /** Maximum number of the cached resampling contexts. */
+    static constexpr int kMaxContextCount = 4;
+
 private:
-    bool allocSampleBuffers(uint64_t srcFrameSize);
+    struct SourceFormat
+    {
+        int32_t sampleRate = 0;
+        AVChannelLayout channelLayout;
+        AVSampleFormat sampleFormat = AV_SAMPLE_FMT_NONE;
+
+        bool operator==(const SourceFormat& other) const;
+    };
+
+    struct Context
+    {
+        SourceFormat format;
+        SwrContext* swrContext = nullptr;
+    };
+
+    SwrContext* createContext(const SourceFormat& format);
+    bool selectContext(const AVFrame* inputFrame);
+    bool convert(const uint8_t** data, int sampleCount, int64_t pts);
+    void clearContexts();
 
 private:
     struct PtsData
@@ -48,5 +78,8 @@ private:
     Config m_config;
     AVFrame* m_frame = nullptr;
     SwrContext* m_swrContext = nullptr;
+
+    /** Most recently used first, the current one is at the front. */
+    std::vector<Context> m_contexts;
     std::deque<PtsData> m_samplePts;
 };
@@ -68,13 +68,15 @@ int getDefaultBitrate(AVCodecContext* context)
 } // namespace
 
 QnFfmpegAudioTranscoder::QnFfmpegAudioTranscoder(const Config& config):
-    m_config(config)
+    m_config(config),
+    m_decodedFrame(av_frame_alloc())
 {
 }
 
 QnFfmpegAudioTranscoder::~QnFfmpegAudioTranscoder()
 {
     close();
+    av_frame_free(&m_decodedFrame);
 }
 
 void QnFfmpegAudioTranscoder::close()
@@ -225,17 +227,17 @@ bool QnFfmpegAudioTranscoder::sendPacket(const QnConstAbstractMediaDataPtr& medi
     }
 
     // 2. get media from decoder
+    if (!m_decodedFrame)
+    {
+        NX_ERROR(this, "Failed to transcode audio packet: out of memory");
+        return false;
+    }
     while (true)
     {
-        AVFrame* decodedFrame = av_frame_alloc();
-        if (!decodedFrame)
-        {
-            NX_ERROR(this, "Failed to transcode audio packet: out of memory");
-            return false;
-        }
-        auto guard = nx::utils::makeScopeGuard([&decodedFrame]() {av_frame_free(&decodedFrame); });
+        // The frame is reused for all the packets, only its data is released.
+        auto guard = nx::utils::makeScopeGuard([this]() { av_frame_unref(m_decodedFrame); });
 
-        error = avcodec_receive_frame(m_decoderCtx, decodedFrame);
+        error = avcodec_receive_frame(m_decoderCtx, m_decodedFrame);
         // There is not enough data to decode
         if (error == AVERROR(EAGAIN) || error == AVERROR_EOF)
             break;
@@ -248,7 +250,7 @@ bool QnFfmpegAudioTranscoder::sendPacket(const QnConstAbstractMediaDataPtr& medi
         }
 
         // 3. Resample data
-        if (!m_resampler->pushFrame(decodedFrame))
+        if (!m_resampler->pushFrame(m_decodedFrame))
         {
             NX_WARNING(this, "Could not allocate sample buffers");
             return false;
@@ -106,6 +106,7 @@ private:
     const Config m_config;
     AVCodecContext* m_encoderCtx = nullptr;
     AVCodecContext* m_decoderCtx = nullptr;
+    AVFrame* m_decodedFrame = nullptr;
     std::unique_ptr<FfmpegAudioResampler> m_resampler;
 
     /**
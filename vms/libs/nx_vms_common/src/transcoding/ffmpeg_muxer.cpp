@@ -2,6 +2,8 @@
 
 #include "ffmpeg_muxer.h"
 
+#include <map>
+
 extern "C" {
 #include <libavutil/opt.h>
 }
@@ -10,6 +12,7 @@ extern "C" {
 #include <nx/media/ffmpeg/ffmpeg_utils.h>
 #include <nx/media/utils.h>
 #include <nx/utils/log/log.h>
+#include <nx/utils/thread/mutex.h>
 #include <utils/common/util.h>
 #include <utils/media/ffmpeg_io_context.h>
 
@@ -34,6 +37,74 @@ static AVPixelFormat getPixelFormatJpeg(const std::string_view container, AVPixe
         return format;
 }
 
+/**
+ * The fragments are flushed by the muxer, the moov box is written by the header and the trailer
+ * with the fragment index is omitted, since the output is streamed.
+ */
+static constexpr char kFragmentedMovFlags[] =
+    "+frag_custom+empty_moov+default_base_moof+cmaf+skip_trailer";
+
+static bool isMovContainer(const AVFormatContext* context)
+{
+    const std::string_view name = context->oformat->name;
+    return name == "mp4" || name == "mov" || name == "ismv";
+}
+
+static std::string codecConfigurationKey(const AVFormatContext* context)
+{
+    std::string key = context->oformat->name;
+    for (unsigned int i = 0; i < context->nb_streams; ++i)
+    {
+        const AVCodecParameters* parameters = context->streams[i]->codecpar;
+        for (const int value: {(int) parameters->codec_type, (int) parameters->codec_id,
+            parameters->format, parameters->width, parameters->height, parameters->sample_rate,
+            parameters->ch_layout.nb_channels, parameters->extradata_size})
+        {
+            key += ':';
+            key += std::to_string(value);
+        }
+        key.append((const char*) parameters->extradata, parameters->extradata_size);
+    }
+    return key;
+}
+
+/** Init segments of the alive muxers by their codec configuration. */
+class InitSegmentCache
+{
+public:
+    std::shared_ptr<const nx::Buffer> share(const std::string& key, nx::Buffer data)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        std::erase_if(m_segments, [](const auto& item) { return item.second.expired(); });
+
+        auto& cached = m_segments[key];
+        if (auto segment = cached.lock(); segment && *segment == data)
+            return segment;
+
+        // The init segment of the same codec configuration may differ by the metadata.
+        auto segment = std::make_shared<const nx::Buffer>(std::move(data));
+        cached = segment;
+        return segment;
+    }
+
+    std::shared_ptr<const nx::Buffer> find(const std::string& key) const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        const auto it = m_segments.find(key);
+        return it != m_segments.end() ? it->second.lock() : nullptr;
+    }
+
+    static InitSegmentCache& instance()
+    {
+        static InitSegmentCache* const cache = new InitSegmentCache();
+        return *cache;
+    }
+
+private:
+    mutable nx::Mutex m_mutex;
+    std::map<std::string, std::weak_ptr<const nx::Buffer>> m_segments;
+};
+
 }
 
 FfmpegMuxer::FfmpegMuxer(const Config& config):
@@ -93,6 +164,8 @@ void FfmpegMuxer::closeFfmpegContext()
         avformat_close_input(&m_formatCtx);
     }
     m_timestampCorrector.clear();
+    m_isFragmented = false;
+    m_fragmentStart.reset();
 }
 
 bool FfmpegMuxer::setContainer(const QString& container)
@@ -191,6 +264,12 @@ bool FfmpegMuxer::open(std::optional<QnAviArchiveMetadata> metadata)
     m_formatCtx->pb = m_ioContext->getAvioContext();
     if (metadata)
         metadata->saveToFile(m_formatCtx, metadata->formatFromExtension(m_container));
+    if (m_config.fragmentDuration.count() > 0 && !setupFragmentation())
+    {
+        closeFfmpegContext();
+        return false;
+    }
+
     int rez = avformat_write_header(m_formatCtx, 0);
     if (rez < 0)
     {
@@ -199,9 +278,103 @@ bool FfmpegMuxer::open(std::optional<QnAviArchiveMetadata> metadata)
         return false;
     }
     m_initialized = true;
+
+    if (m_isFragmented)
+    {
+        avio_flush(m_formatCtx->pb);
+        m_initSegmentKey = codecConfigurationKey(m_formatCtx);
+        m_initSegment = InitSegmentCache::instance().share(m_initSegmentKey, takeOutput());
+        if (m_fragmentHandler)
+        {
+            Fragment fragment;
+            fragment.isInitSegment = true;
+            fragment.data = *m_initSegment;
+            m_fragmentHandler(std::move(fragment));
+        }
+        else
+        {
+            m_internalBuffer.write(m_initSegment->data(), m_initSegment->size());
+        }
+    }
+    return true;
+}
+
+bool FfmpegMuxer::setupFragmentation()
+{
+    if (!isMovContainer(m_formatCtx))
+    {
+        NX_WARNING(this, "Fragmented output is not supported for container %1", m_container);
+        return false;
+    }
+
+    const int status = av_opt_set(m_formatCtx->priv_data, "movflags", kFragmentedMovFlags, 0);
+    if (status < 0)
+    {
+        NX_WARNING(this, "Unable to enable fragmented output: %1",
+            nx::media::ffmpeg::avErrorToString(status));
+        return false;
+    }
+
+    NX_DEBUG(this, "Fragmented output with fragments of %1", m_config.fragmentDuration);
+    m_isFragmented = true;
+    return true;
+}
+
+void FfmpegMuxer::setFragmentHandler(FragmentHandler handler)
+{
+    m_fragmentHandler = std::move(handler);
+}
+
+bool FfmpegMuxer::isFragmentBoundary(
+    const QnConstAbstractMediaDataPtr& media, std::chrono::microseconds timestamp) const
+{
+    if (!m_fragmentStart || timestamp - *m_fragmentStart < m_config.fragmentDuration)
+        return false;
+
+    // The audio packets are added to the current fragment until the next video key frame.
+    if (m_initializedVideo)
+        return media->dataType == QnAbstractMediaData::VIDEO && (media->flags & AV_PKT_FLAG_KEY);
     return true;
 }
 
+void FfmpegMuxer::flushFragment(std::chrono::microseconds endTimestamp)
+{
+    if (!m_fragmentStart)
+        return;
+
+    // Writes the moof and mdat boxes of the buffered packets.
+    const int status = av_write_frame(m_formatCtx, nullptr);
+    if (status < 0)
+    {
+        NX_WARNING(this, "Unable to flush the fragment: %1",
+            nx::media::ffmpeg::avErrorToString(status));
+    }
+    avio_flush(m_formatCtx->pb);
+
+    if (m_fragmentHandler)
+    {
+        Fragment fragment;
+        fragment.isIndependent = m_isFragmentIndependent;
+        fragment.timestamp = *m_fragmentStart;
+        fragment.duration = endTimestamp - *m_fragmentStart;
+        fragment.data = takeOutput();
+        m_fragmentHandler(std::move(fragment));
+    }
+    m_fragmentStart.reset();
+}
+
+nx::Buffer FfmpegMuxer::takeOutput()
+{
+    nx::Buffer result(m_internalBuffer.data(), m_internalBuffer.size());
+    m_internalBuffer.clear();
+    return result;
+}
+
+std::shared_ptr<const nx::Buffer> FfmpegMuxer::findInitSegment(const std::string& key)
+{
+    return InitSegmentCache::instance().find(key);
+}
+
 bool FfmpegMuxer::addTag(const char* name, const char* value)
 {
     return av_dict_set(&m_formatCtx->metadata, name, value, 0) >= 0;
@@ -244,6 +417,9 @@ bool FfmpegMuxer::muxPacket(const QnConstAbstractMediaDataPtr& media)
     m_lastPacketTimestamp.ntpTimestamp = media->timestamp;
     m_lastPacketTimestamp.rtpTimestamp = packet->pts;
 
+    if (m_isFragmented && isFragmentBoundary(media, std::chrono::microseconds(timestamp)))
+        flushFragment(std::chrono::microseconds(timestamp));
+
     int status = av_write_frame(m_formatCtx, packet);
     if (status < 0)
     {
@@ -252,6 +428,18 @@ bool FfmpegMuxer::muxPacket(const QnConstAbstractMediaDataPtr& media)
         return false;
     }
 
+    if (m_isFragmented)
+    {
+        if (!m_fragmentStart)
+        {
+            m_fragmentStart = std::chrono::microseconds(timestamp);
+            m_isFragmentIndependent = !m_initializedVideo
+                || (media->dataType == QnAbstractMediaData::VIDEO
+                    && (media->flags & AV_PKT_FLAG_KEY));
+        }
+        m_lastTimestamp = std::chrono::microseconds(timestamp);
+    }
+
     if (m_config.computeSignature)
     {
         auto context = media->dataType == QnAbstractMediaData::VIDEO ?
@@ -263,6 +451,8 @@ bool FfmpegMuxer::muxPacket(const QnConstAbstractMediaDataPtr& media)
 
 bool FfmpegMuxer::finalize()
 {
+    if (m_initialized && m_isFragmented)
+        flushFragment(m_lastTimestamp);
     closeFfmpegContext();
     return true;
 }
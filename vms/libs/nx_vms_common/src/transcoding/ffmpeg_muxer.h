@@ -2,6 +2,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
 #include <QtCore/QQueue>
 
 extern "C" {
@@ -12,7 +17,9 @@ extern "C" {
 #include <export/signer.h>
 #include <nx/media/media_data_packet.h>
 #include <nx/media/ffmpeg/io_context.h>
+#include <nx/utils/buffer.h>
 #include <nx/utils/cryptographic_hash.h>
+#include <nx/utils/move_only_func.h>
 #include <transcoding/timestamp_corrector.h>
 
 class QnLicensePool;
@@ -25,8 +32,31 @@ public:
     struct Config
     {
         bool computeSignature = false;
+
+        /**
+         * If positive, the mp4 container is written as fragmented MP4 (CMAF): the init segment
+         * followed by the fragments of at least this duration. With video, each fragment starts
+         * with a key frame.
+         */
+        std::chrono::microseconds fragmentDuration{0};
+    };
+
+    /** Piece of the fragmented MP4 output, complete to be sent to the client. */
+    struct Fragment
+    {
+        /** The ftyp and moov boxes, followed by the moof and mdat boxes of the other fragments. */
+        bool isInitSegment = false;
+
+        /** Starts with a video key frame or contains no video, so the playback can start here. */
+        bool isIndependent = false;
+
+        std::chrono::microseconds timestamp{0};
+        std::chrono::microseconds duration{0};
+        nx::Buffer data;
     };
 
+    using FragmentHandler = nx::utils::MoveOnlyFunc<void(Fragment fragment)>;
+
 public:
     FfmpegMuxer(const Config& config);
     ~FfmpegMuxer();
@@ -83,10 +113,36 @@ public:
     void setStartTimeOffset(int64_t value);
     const Config& config() const { return m_config; }
 
+    /**
+     * Makes the fragmented MP4 output to be passed to the handler as soon as each fragment is
+     * complete, instead of being collected for getResult(). Must be called before open().
+     */
+    void setFragmentHandler(FragmentHandler handler);
+
+    bool isFragmented() const { return m_isFragmented; }
+
+    /**
+     * @return Init segment of the fragmented MP4 output, null before open() or if the output is
+     *     not fragmented. The muxers of the same codec configuration share the same buffer, so
+     *     the init segment can be cached by the pointer or by initSegmentKey().
+     */
+    std::shared_ptr<const nx::Buffer> initSegment() const { return m_initSegment; }
+
+    /** Codec configuration the init segment depends on, empty before open(). */
+    const std::string& initSegmentKey() const { return m_initSegmentKey; }
+
+    /** @return Init segment of the muxer opened with the key, if it is still alive. */
+    static std::shared_ptr<const nx::Buffer> findInitSegment(const std::string& key);
+
 private:
     void closeFfmpegContext();
     bool muxPacket(const QnConstAbstractMediaDataPtr& mediaPacket);
     void checkDiscontinuity(const QnConstAbstractMediaDataPtr& data, int streamIndex);
+    bool setupFragmentation();
+    bool isFragmentBoundary(
+        const QnConstAbstractMediaDataPtr& media, std::chrono::microseconds timestamp) const;
+    void flushFragment(std::chrono::microseconds endTimestamp);
+    nx::Buffer takeOutput();
 
 private:
     Config m_config;
@@ -108,4 +164,12 @@ private:
     TimestampCorrector m_timestampCorrector;
     PacketTimestamp m_lastPacketTimestamp;
     int m_rtpMtu = MTU_SIZE;
+
+    bool m_isFragmented = false;
+    FragmentHandler m_fragmentHandler;
+    std::shared_ptr<const nx::Buffer> m_initSegment;
+    std::string m_initSegmentKey;
+    std::optional<std::chrono::microseconds> m_fragmentStart;
+    std::chrono::microseconds m_lastTimestamp{0};
+    bool m_isFragmentIndependent = false;
 };
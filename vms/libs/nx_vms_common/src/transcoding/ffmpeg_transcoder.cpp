@@ -22,6 +22,11 @@ static bool isMoovFormat(const QString& container)
         || container.compare("ismv", Qt::CaseInsensitive) == 0;
 }
 
+static bool isLengthPrefixedFormat(const QString& container)
+{
+    return isMoovFormat(container) || container.compare("matroska", Qt::CaseInsensitive) == 0;
+}
+
 bool QnFfmpegTranscoder::setVideoCodec(
     AVCodecID codec,
     TranscodeMethod method,
@@ -252,6 +257,16 @@ bool QnFfmpegTranscoder::open(const QnConstCompressedVideoDataPtr& video, const
     if (!audio)
         m_mediaTranscoder.resetAudio();
 
+    m_convertVideoToMp4 = false;
+    bool remuxVideo = false;
+    if (m_mediaTranscoder.isVideoRemuxPossible(video.get()))
+    {
+        NX_DEBUG(this, "Remux %1 video to %2 without transcoding",
+            m_videoCodec, m_muxer.container());
+        m_mediaTranscoder.resetVideo();
+        remuxVideo = true;
+    }
+
     if (video && m_videoCodec != AV_CODEC_ID_NONE)
     {
         CodecParameters codecParameters;
@@ -278,7 +293,20 @@ bool QnFfmpegTranscoder::open(const QnConstCompressedVideoDataPtr& video, const
             if (video->context)
                 avcodec_parameters_copy(codecpar, video->context->getAvCodecParameters());
 
-            if (isMoovFormat(m_muxer.container()))
+            if (remuxVideo && isLengthPrefixedFormat(m_muxer.container())
+                && nx::media::isAnnexb(video.get()))
+            {
+                const auto extradata = nx::media::buildExtraDataMp4(video.get());
+                if (extradata.empty())
+                {
+                    NX_WARNING(this, "Failed to build extra data in mp4 format");
+                    return false;
+                }
+                codecParameters.setExtradata(extradata.data(), extradata.size());
+                m_annexbToMp4 = nx::media::AnnexbToMp4();
+                m_convertVideoToMp4 = true;
+            }
+            else if (isMoovFormat(m_muxer.container()))
             {
                 if (!nx::media::fillExtraDataAnnexB(
                     video.get(),
@@ -383,6 +411,19 @@ bool QnFfmpegTranscoder::open(const QnConstCompressedVideoDataPtr& video, const
 bool QnFfmpegTranscoder::transcodePacketInternal(
     const QnConstAbstractMediaDataPtr& media)
 {
+    if (m_convertVideoToMp4 && media->dataType == QnAbstractMediaData::VIDEO)
+    {
+        const auto converted = m_annexbToMp4.process(
+            static_cast<const QnCompressedVideoData*>(media.get()));
+        if (!converted)
+        {
+            NX_VERBOSE(this, "Skip video packet %1 which can't be remuxed", media->timestamp);
+            return true;
+        }
+        m_muxer.process(converted);
+        return true;
+    }
+
     return m_mediaTranscoder.transcodePacket(media,
         [this](const QnConstAbstractMediaDataPtr& media)
         {
@@ -18,6 +18,7 @@ extern "C" {
 #include <transcoding/transcoding_utils.h>
 #include <transcoding/media_transcoder.h>
 #include <transcoding/ffmpeg_muxer.h>
+#include <utils/media/annexb_to_mp4.h>
 
 class QnLicensePool;
 
@@ -110,6 +111,9 @@ private:
     AVCodecID m_audioCodec = AV_CODEC_ID_NONE;
 
     bool m_initialized = false;
+    // The remuxed Annex B video is converted to the length prefixed NAL units of MP4.
+    bool m_convertVideoToMp4 = false;
+    nx::media::AnnexbToMp4 m_annexbToMp4;
 
     QQueue<QnConstCompressedVideoDataPtr> m_delayedVideoQueue;
     QQueue<QnConstCompressedAudioDataPtr> m_delayedAudioQueue;
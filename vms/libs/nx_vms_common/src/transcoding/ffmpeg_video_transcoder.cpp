@@ -11,6 +11,7 @@
 #include <nx/media/ffmpeg/av_options.h>
 #include <nx/media/ffmpeg/av_packet.h>
 #include <nx/media/ffmpeg/ffmpeg_utils.h>
+#include <nx/media/ffmpeg/hw_video_decoder.h>
 #include <nx/media/ffmpeg/old_api.h>
 #include <nx/media/utils.h>
 #include <nx/media/video_data_packet.h>
@@ -63,6 +64,23 @@ namespace {
         else
             return codec;
     }
+
+    bool supportsHardwareDecoding(AVHWDeviceType deviceType, AVCodecID codec)
+    {
+        const AVCodec* decoder = avcodec_find_decoder(codec);
+        if (!decoder)
+            return false;
+
+        for (int i = 0; const AVCodecHWConfig* config = avcodec_get_hw_config(decoder, i); ++i)
+        {
+            if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX)
+                && config->device_type == deviceType)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
 }
 
 QnFfmpegVideoTranscoder::QnFfmpegVideoTranscoder(
@@ -91,8 +109,10 @@ void QnFfmpegVideoTranscoder::close()
 {
     if (m_encoderCtx)
         avcodec_free_context(&m_encoderCtx);
+    m_hwEncoder.reset();
     m_lastFlushedDecoder = 0;
     m_videoDecoders.clear();
+    m_lastKeyFrames.clear();
 }
 
 bool QnFfmpegVideoTranscoder::prepareFilters(
@@ -151,13 +171,49 @@ bool QnFfmpegVideoTranscoder::open(const QnConstCompressedVideoDataPtr& video)
     if (!prepareFilters(m_config.targetCodecId, video))
         return false;
 
-    const AVCodec* avCodec = avcodec_find_encoder(m_config.targetCodecId);
-    if (avCodec == 0)
+    for (const auto& backend: m_config.hardwareEncoders)
     {
-        NX_WARNING(this, "Could not find encoder for codec %1.", m_config.targetCodecId);
-        return false;
+        const auto encoderName = backend.encoders.find(m_config.targetCodecId);
+        if (encoderName == backend.encoders.end())
+            continue;
+
+        const AVCodec* avCodec = avcodec_find_encoder_by_name(encoderName->second.c_str());
+        if (!avCodec)
+        {
+            NX_DEBUG(this, "Hardware encoder %1 is not available", encoderName->second);
+            continue;
+        }
+
+        if (openEncoder(avCodec, &backend))
+            break;
     }
 
+    if (!m_encoderCtx)
+    {
+        const AVCodec* avCodec = avcodec_find_encoder(m_config.targetCodecId);
+        if (avCodec == 0)
+        {
+            NX_WARNING(this, "Could not find encoder for codec %1.", m_config.targetCodecId);
+            return false;
+        }
+
+        if (!openEncoder(avCodec, /*backend*/ nullptr))
+        {
+            close();
+            return false;
+        }
+    }
+
+    if (!m_codecParamaters)
+        m_codecParamaters.reset(new CodecParameters(m_encoderCtx));
+
+    m_encodeTimer.start();
+    return true;
+}
+
+bool QnFfmpegVideoTranscoder::openEncoder(
+    const AVCodec* avCodec, const nx::transcoding::HwEncoderBackend* backend)
+{
     m_encoderCtx = avcodec_alloc_context3(avCodec);
     m_encoderCtx->codec_type = AVMEDIA_TYPE_VIDEO;
     m_encoderCtx->codec_id = m_config.targetCodecId;
@@ -178,8 +234,19 @@ bool QnFfmpegVideoTranscoder::open(const QnConstCompressedVideoDataPtr& video)
     m_encoderCtx->time_base.num = 1;
     m_encoderCtx->time_base.den = m_config.fixedFrameRate ? m_config.fixedFrameRate : 60;
     m_encoderCtx->sample_aspect_ratio.den = m_encoderCtx->sample_aspect_ratio.num = 1;
-    if (m_config.useMultiThreadEncode && m_config.targetCodecId != AV_CODEC_ID_MJPEG)
+    if (backend)
+    {
+        m_hwEncoder = nx::transcoding::HwVideoEncoder::create(*backend, m_encoderCtx);
+        if (!m_hwEncoder)
+        {
+            avcodec_free_context(&m_encoderCtx);
+            return false;
+        }
+    }
+    else if (m_config.useMultiThreadEncode && m_config.targetCodecId != AV_CODEC_ID_MJPEG)
+    {
         m_encoderCtx->thread_count = qMin(2, QThread::idealThreadCount());
+    }
 
     nx::media::ffmpeg::AvOptions options;
     for (auto it = m_config.params.begin(); it != m_config.params.end(); ++it)
@@ -221,15 +288,14 @@ bool QnFfmpegVideoTranscoder::open(const QnConstCompressedVideoDataPtr& video)
 
     if (avcodec_open2(m_encoderCtx, avCodec, options) < 0)
     {
-        NX_WARNING(this, "Could not initialize video encoder.");
-        close();
+        NX_WARNING(this, "Could not initialize video encoder %1.", avCodec->name);
+        avcodec_free_context(&m_encoderCtx);
+        m_hwEncoder.reset();
         return false;
     }
 
-    if (!m_codecParamaters)
-        m_codecParamaters.reset(new CodecParameters(m_encoderCtx));
-
-    m_encodeTimer.start();
+    if (backend)
+        NX_DEBUG(this, "Using hardware video encoder %1", avCodec->name);
     return true;
 }
 
@@ -264,17 +330,72 @@ int QnFfmpegVideoTranscoder::transcodePacket(const QnConstAbstractMediaDataPtr&
     return 0;
 }
 
-std::pair<uint32_t, QnFfmpegVideoDecoder*> QnFfmpegVideoTranscoder::getDecoder(
+CLVideoDecoderOutputPtr QnFfmpegVideoTranscoder::repeatedKeyFrame(
+    uint32_t channelNumber, const QnConstCompressedVideoDataPtr& video) const
+{
+    if (!video || !video->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey))
+        return {};
+
+    const auto it = m_lastKeyFrames.find(channelNumber);
+    if (it == m_lastKeyFrames.end())
+        return {};
+
+    const auto& [packet, frame] = it->second;
+    if (packet->dataSize() != video->dataSize()
+        || memcmp(packet->data(), video->data(), video->dataSize()) != 0)
+    {
+        return {};
+    }
+
+    // The frames after the decoder may be modified in place, so the copy is returned.
+    CLVideoDecoderOutputPtr result(new CLVideoDecoderOutput());
+    result->copyFrom(frame.get());
+    result->pkt_dts = video->timestamp;
+    return result;
+}
+
+void QnFfmpegVideoTranscoder::updateLastKeyFrame(uint32_t channelNumber,
+    const QnConstCompressedVideoDataPtr& video, const CLVideoDecoderOutputPtr& frame)
+{
+    // The decoded frame is remembered only if it belongs to the decoded packet, i.e. the decoder
+    // has no delay, and the decoder state is not changed by the following packets.
+    if (video
+        && video->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey)
+        && frame->pkt_dts == video->timestamp
+        && frame->memoryType() == MemoryType::SystemMemory
+        && !frame->isExternalData())
+    {
+        m_lastKeyFrames[channelNumber] = {video, frame};
+    }
+    else
+    {
+        m_lastKeyFrames.erase(channelNumber);
+    }
+}
+
+std::pair<uint32_t, QnAbstractVideoDecoder*> QnFfmpegVideoTranscoder::getDecoder(
         const QnConstCompressedVideoDataPtr& video)
 {
-    QnFfmpegVideoDecoder* decoder = nullptr;
+    QnAbstractVideoDecoder* decoder = nullptr;
     if (video)
     {
         auto decoderIter = m_videoDecoders.find(video->channelNumber);
         if (decoderIter != m_videoDecoders.end())
             return std::make_pair(decoderIter->first, decoderIter->second.get());
 
-        decoder = new QnFfmpegVideoDecoder(m_config.decoderConfig, m_metrics, video);
+        // The decoder shares the pooled device with the encoder, so the decoded frames can be
+        // encoded without leaving the video memory.
+        const auto deviceType =
+            m_hwEncoder ? m_hwEncoder->backend().deviceType : AV_HWDEVICE_TYPE_NONE;
+        if (m_config.useHardwareDecoder && video->context
+            && supportsHardwareDecoding(deviceType, video->compressionType))
+        {
+            decoder = new nx::media::ffmpeg::HwVideoDecoder(deviceType, m_metrics);
+        }
+        else
+        {
+            decoder = new QnFfmpegVideoDecoder(m_config.decoderConfig, m_metrics, video);
+        }
         m_videoDecoders[video->channelNumber].reset(decoder);
         return std::make_pair(video->channelNumber, decoder);
     }
@@ -315,9 +436,19 @@ int QnFfmpegVideoTranscoder::transcodePacketImpl(const QnConstCompressedVideoDat
     if (result)
         *result = QnCompressedVideoDataPtr();
 
-    CLVideoDecoderOutputPtr decodedFrame(new CLVideoDecoderOutput());
-    if (!decoder->decode(video, &decodedFrame))
-        return 0; // ignore decode error
+    // Timelapse export repeats the same key frame if the archive has no other frames within the
+    // step, so the frame decoded before is reused instead of decoding it once more.
+    CLVideoDecoderOutputPtr decodedFrame = repeatedKeyFrame(channelNumber, video);
+    if (!decodedFrame)
+    {
+        decodedFrame.reset(new CLVideoDecoderOutput());
+        if (!decoder->decode(video, &decodedFrame))
+        {
+            m_lastKeyFrames.erase(channelNumber);
+            return 0; // ignore decode error
+        }
+        updateLastKeyFrame(channelNumber, video, decodedFrame);
+    }
 
     if (decodedFrame->pkt_dts < m_config.startTimeUs)
         return 0; // Ignore frames before start time.
@@ -328,25 +459,41 @@ int QnFfmpegVideoTranscoder::transcodePacketImpl(const QnConstCompressedVideoDat
     decodedFrame->channel = channelNumber;
     decodedFrame->pts = decodedFrame->pkt_dts;
 
-    // Second stream must be upscaled to the first stream resolution before the filters apply.
-    if (decodedFrame->size() != m_sourceResolution || decodedFrame->format != AV_PIX_FMT_YUV420P)
+    // The frames decoded on the device of the encoder are encoded as is if no processing is
+    // needed, the other video memory frames are downloaded for the filters.
+    if (!m_hwEncoder || !m_filters.empty() || !m_hwEncoder->isCompatible(decodedFrame.get()))
     {
-        decodedFrame = decodedFrame->scaled(m_sourceResolution, AV_PIX_FMT_YUV420P);
+        if (decodedFrame->hw_frames_ctx)
+        {
+            decodedFrame = decodedFrame->toSystemMemory();
+            if (!decodedFrame)
+            {
+                NX_ERROR(this, "Failed to download video frame from video memory");
+                return 0;
+            }
+        }
 
+        // Second stream must be upscaled to the first stream resolution before the filters apply.
+        if (decodedFrame->size() != m_sourceResolution
+            || decodedFrame->format != AV_PIX_FMT_YUV420P)
+        {
+            decodedFrame = decodedFrame->scaled(m_sourceResolution, AV_PIX_FMT_YUV420P);
+
+            if (!decodedFrame)
+            {
+                NX_ERROR(this, "Failed to scale video frame to %1", m_sourceResolution);
+                return 0;
+            }
+        }
+
+        decodedFrame = m_filters.apply(decodedFrame, /*metadata*/ {});
         if (!decodedFrame)
         {
-            NX_ERROR(this, "Failed to scale video frame to %1", m_sourceResolution);
+            NX_ERROR(this, "Failed to process filter chain for video frame");
             return 0;
         }
     }
 
-    decodedFrame = m_filters.apply(decodedFrame, /*metadata*/ {});
-    if (!decodedFrame)
-    {
-        NX_ERROR(this, "Failed to process filter chain for video frame");
-        return 0;
-    }
-
     static AVRational r = { 1, 1'000'000 };
     if (m_config.fixedFrameRate)
     {
@@ -382,6 +529,17 @@ int QnFfmpegVideoTranscoder::transcodePacketImpl(const QnConstCompressedVideoDat
     }
     decodedFrame->pict_type = AV_PICTURE_TYPE_NONE;
 
+    if (m_hwEncoder)
+    {
+        decodedFrame = m_hwEncoder->prepareFrame(decodedFrame);
+        if (!decodedFrame)
+        {
+            NX_ERROR(this, "Failed to upload video frame to %1 encoder",
+                m_hwEncoder->backend().name);
+            return 0;
+        }
+    }
+
     nx::media::ffmpeg::AvPacket avPacket;
     auto packet = avPacket.get();
     int got_packet = 0;
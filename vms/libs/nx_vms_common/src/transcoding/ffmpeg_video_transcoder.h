@@ -4,6 +4,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QElapsedTimer>
@@ -13,6 +14,7 @@
 #include <nx/media/ffmpeg/frame_info.h>
 #include <nx/media/video_data_packet.h>
 #include <transcoding/abstract_codec_transcoder.h>
+#include <transcoding/hw_video_encoder.h>
 #include <transcoding/transcoding_utils.h>
 
 namespace nx::metric { struct Storage; }
@@ -43,6 +45,10 @@ public:
         int64_t startTimeUs = 0;
         // Set this to true if stream will mux into RTP.
         bool rtpContatiner = false;
+        // Hardware encoders to try before the software one, see nx::transcoding::ini().
+        std::vector<nx::transcoding::HwEncoderBackend> hardwareEncoders;
+        // Decode on the device of the hardware encoder, if the device supports the codec.
+        bool useHardwareDecoder = false;
     };
 
 public:
@@ -69,13 +75,27 @@ public:
 private:
     int transcodePacketImpl(const QnConstCompressedVideoDataPtr& video, QnAbstractMediaDataPtr* const result);
     bool prepareFilters(AVCodecID dstCodec, const QnConstCompressedVideoDataPtr& video);
-    std::pair<uint32_t, QnFfmpegVideoDecoder*> getDecoder(
+    bool openEncoder(const AVCodec* avCodec, const nx::transcoding::HwEncoderBackend* backend);
+    std::pair<uint32_t, QnAbstractVideoDecoder*> getDecoder(
         const QnConstCompressedVideoDataPtr& video);
 
+    /** Returns a copy of the frame decoded before if the packet repeats the last key frame. */
+    CLVideoDecoderOutputPtr repeatedKeyFrame(
+        uint32_t channelNumber, const QnConstCompressedVideoDataPtr& video) const;
+    void updateLastKeyFrame(uint32_t channelNumber,
+        const QnConstCompressedVideoDataPtr& video, const CLVideoDecoderOutputPtr& frame);
+
 private:
     const Config m_config;
     uint32_t m_lastFlushedDecoder = 0;
-    std::map<uint32_t, std::unique_ptr<QnFfmpegVideoDecoder>> m_videoDecoders;
+    std::map<uint32_t, std::unique_ptr<QnAbstractVideoDecoder>> m_videoDecoders;
+
+    struct DecodedKeyFrame
+    {
+        QnConstCompressedVideoDataPtr packet;
+        CLVideoDecoderOutputPtr frame;
+    };
+    std::map<uint32_t, DecodedKeyFrame> m_lastKeyFrames;
     nx::core::transcoding::FilterChain m_filters;
     QSize m_outputResolutionLimit;
     QSize m_targetResolution;
@@ -83,6 +103,7 @@ private:
     int m_bitrate = -1;
 
     AVCodecContext* m_encoderCtx = nullptr;
+    std::unique_ptr<nx::transcoding::HwVideoEncoder> m_hwEncoder;
     int m_lastSrcWidth[CL_MAX_CHANNELS];
     int m_lastSrcHeight[CL_MAX_CHANNELS];
     QElapsedTimer m_encodeTimer;
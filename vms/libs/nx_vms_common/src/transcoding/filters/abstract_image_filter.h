@@ -48,6 +48,13 @@ public:
      * @param srcSize input image size. Function should return output image size
      */
     virtual QSize updatedResolution(const QSize& srcSize) = 0;
+
+    /**
+     * Whether the filter may modify the passed frame. The filters that only read it, returning a
+     * new frame or a view of the passed one, let the filter chain skip the copy of the decoded
+     * frame.
+     */
+    virtual bool isInPlace() const { return true; }
 };
 
 using QnAbstractImageFilterPtr = QSharedPointer<QnAbstractImageFilter>;
@@ -25,6 +25,8 @@ public:
 
     virtual QSize updatedResolution(const QSize& srcSize) override;
 
+    virtual bool isInPlace() const override { return false; }
+
 private:
     bool m_alignSize;
     QRectF m_rectF;
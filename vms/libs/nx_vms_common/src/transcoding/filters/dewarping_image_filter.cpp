@@ -221,8 +221,23 @@ CLVideoDecoderOutputPtr QnDewarpingImageFilter::updateImage(
         m_lastImageFormat = frame->format;
     }
 
-    CLVideoDecoderOutputPtr outputFrame(new CLVideoDecoderOutput);
-    outputFrame->copyFrom(frame.get());
+    // Each pixel of the planar formats is written below, so the source is copied only to keep the
+    // planes the transform map does not cover.
+    CLVideoDecoderOutputPtr outputFrame;
+    if (QnFfmpegHelper::planeCount(descr) == descr->nb_components)
+    {
+        outputFrame = m_framePool.get(frame->size(),
+            CLVideoDecoderOutput::fixDeprecatedPixelFormat((AVPixelFormat) frame->format));
+    }
+    if (outputFrame)
+    {
+        outputFrame->assignMiscData(frame.get());
+    }
+    else
+    {
+        outputFrame.reset(new CLVideoDecoderOutput);
+        outputFrame->copyFrom(frame.get());
+    }
 
     for (int plane = 0; plane < descr->nb_components && outputFrame->data[plane]; ++plane)
     {
@@ -10,6 +10,7 @@
 #include <QtGui/QVector3D>
 
 #include <nx/media/ffmpeg/frame_info.h>
+#include <nx/media/ffmpeg/video_frame_pool.h>
 #include <nx/vms/api/data/dewarping_data.h>
 
 #include "abstract_image_filter.h"
@@ -29,6 +30,8 @@ public:
 
     virtual QSize updatedResolution(const QSize& srcSize) override;
 
+    virtual bool isInPlace() const override { return false; }
+
     void setParameters(
         const nx::vms::api::dewarping::MediaData& mediaDewarping,
         const nx::vms::api::dewarping::ViewData& itemDewarping);
@@ -61,6 +64,7 @@ private:
     QSize m_lastImageSize;
 
     int m_lastImageFormat = -1;
+    nx::media::ffmpeg::VideoFramePool m_framePool;
 
 protected: //< For unit tests.
     nx::vms::api::dewarping::MediaData m_mediaParams;
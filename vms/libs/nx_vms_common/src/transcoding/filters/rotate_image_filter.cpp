@@ -2,9 +2,47 @@
 
 #include "rotate_image_filter.h"
 
+#include <algorithm>
+
 #include <nx/media/ffmpeg/frame_info.h>
 
-CLVideoDecoderOutputPtr rotateImage(const CLConstVideoDecoderOutputPtr& frame, int angle)
+namespace {
+
+/**
+ * Rotates the plane by 90 degrees clockwise or counterclockwise. The plane is processed in the
+ * square tiles, so both the source and the target rows of a tile stay in the cache, instead of
+ * writing each source pixel to a different target row.
+ */
+template<bool clockwise>
+void rotatePlane(const quint8* src, int srcStride, quint8* dst, int dstStride, int w, int h)
+{
+    static constexpr int kTileSize = 16;
+
+    for (int tileY = 0; tileY < h; tileY += kTileSize)
+    {
+        const int endY = std::min(tileY + kTileSize, h);
+        for (int tileX = 0; tileX < w; tileX += kTileSize)
+        {
+            const int endX = std::min(tileX + kTileSize, w);
+            for (int y = tileY; y < endY; ++y)
+            {
+                const quint8* srcLine = src + srcStride * y;
+                for (int x = tileX; x < endX; ++x)
+                {
+                    if constexpr (clockwise)
+                        dst[dstStride * x + h - 1 - y] = srcLine[x];
+                    else
+                        dst[dstStride * (w - 1 - x) + y] = srcLine[x];
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+CLVideoDecoderOutputPtr rotateImage(
+    const CLConstVideoDecoderOutputPtr& frame, int angle, nx::media::ffmpeg::VideoFramePool* pool)
 {
     if (angle > 180)
         angle = 270;
@@ -24,19 +62,35 @@ CLVideoDecoderOutputPtr rotateImage(const CLConstVideoDecoderOutputPtr& frame, i
             transposeChroma = true;
     }
 
-    CLVideoDecoderOutputPtr dstPict(new CLVideoDecoderOutput());
-    dstPict->reallocate(dstWidth, dstHeight, frame->format);
+    CLVideoDecoderOutputPtr dstPict;
+    if (pool)
+    {
+        dstPict = pool->get(dstWidth, dstHeight, (AVPixelFormat) frame->format);
+        if (!dstPict)
+            return dstPict;
+    }
+    else
+    {
+        dstPict.reset(new CLVideoDecoderOutput());
+        dstPict->reallocate(dstWidth, dstHeight, frame->format);
+    }
     dstPict->assignMiscData(frame.get());
 
+    // The rotated planes cover the whole picture unless the chroma size is rounded down.
+    const bool isFullyCovered = frame->width % 2 == 0 && frame->height % 2 == 0;
+
     const AVPixFmtDescriptor* descriptor = av_pix_fmt_desc_get((AVPixelFormat) frame->format);
     for (int i = 0; i < QnFfmpegHelper::planeCount(descriptor) && frame->data[i]; ++i)
     {
-        int filler = (i == 0 ? 0x0 : 0x80);
-        int numBytes = dstPict->linesize[i] * dstHeight;
         const bool isChromaPlane = QnFfmpegHelper::isChromaPlane(i, descriptor);
-        if (isChromaPlane)
-            numBytes >>= descriptor->log2_chroma_h;
-        memset(dstPict->data[i], filler, numBytes);
+        if (!isFullyCovered)
+        {
+            int filler = (i == 0 ? 0x0 : 0x80);
+            int numBytes = dstPict->linesize[i] * dstHeight;
+            if (isChromaPlane)
+                numBytes >>= descriptor->log2_chroma_h;
+            memset(dstPict->data[i], filler, numBytes);
+        }
 
         int w = frame->width;
         int h = frame->height;
@@ -67,18 +121,10 @@ CLVideoDecoderOutputPtr rotateImage(const CLConstVideoDecoderOutputPtr& frame, i
                     }
                 }
             }
-            else {
-                for (int y = 0; y < h; ++y)
-                {
-                    quint8* src = frame->data[i] + frame->linesize[i] * y;
-                    quint8* dst = dstPict->data[i] + h - y -1;
-                    if (angle == 270)
-                        dst += (w-1) * dstPict->linesize[i];
-                    for (int x = 0; x < w; ++x) {
-                        *dst = *src++;
-                        dst += dstLineStep;
-                    }
-                }
+            else
+            {
+                rotatePlane</*clockwise*/ true>(
+                    frame->data[i], frame->linesize[i], dstPict->data[i], dstLineStep, w, h);
             }
         }
         else if (angle == 270)
@@ -101,16 +147,10 @@ CLVideoDecoderOutputPtr rotateImage(const CLConstVideoDecoderOutputPtr& frame, i
                     }
                 }
             }
-            else {
-                for (int y = 0; y < h; ++y)
-                {
-                    quint8* src = frame->data[i] + frame->linesize[i] * y;
-                    quint8* dst = dstPict->data[i] + (w-1) * dstPict->linesize[i] + y;
-                    for (int x = 0; x < w; ++x) {
-                        *dst = *src++;
-                        dst += dstLineStep;
-                    }
-                }
+            else
+            {
+                rotatePlane</*clockwise*/ false>(frame->data[i], frame->linesize[i],
+                    dstPict->data[i], dstPict->linesize[i], w, h);
             }
         }
         else
@@ -145,7 +185,7 @@ CLVideoDecoderOutputPtr QnRotateImageFilter::updateImage(
     if (m_angle == 0)
         return frame;
     else
-        return rotateImage(frame, m_angle);
+        return rotateImage(frame, m_angle, &m_framePool);
 }
 
 QSize QnRotateImageFilter::updatedResolution(const QSize& srcSize)
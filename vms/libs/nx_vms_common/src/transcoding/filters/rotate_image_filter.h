@@ -5,11 +5,17 @@
 #include <QtCore/QScopedPointer>
 
 #include <nx/media/ffmpeg/frame_info.h>
+#include <nx/media/ffmpeg/video_frame_pool.h>
 
 #include "abstract_image_filter.h"
 
+/**
+ * @param pool The target frame is taken from the pool if specified.
+ */
 NX_VMS_COMMON_API CLVideoDecoderOutputPtr rotateImage(
-    const CLConstVideoDecoderOutputPtr& frame, int angle);
+    const CLConstVideoDecoderOutputPtr& frame,
+    int angle,
+    nx::media::ffmpeg::VideoFramePool* pool = nullptr);
 
 class NX_VMS_COMMON_API QnRotateImageFilter: public QnAbstractImageFilter
 {
@@ -22,7 +28,10 @@ public:
 
     virtual QSize updatedResolution(const QSize& srcSize) override;
 
+    virtual bool isInPlace() const override { return false; }
+
     int angle() const { return m_angle; }
 private:
     int m_angle;
+    nx::media::ffmpeg::VideoFramePool m_framePool;
 };
@@ -14,17 +14,46 @@ QnScaleImageFilter::QnScaleImageFilter(
 {
 }
 
+QnScaleImageFilter::~QnScaleImageFilter()
+{
+    sws_freeContext(m_scaleContext);
+}
+
 CLVideoDecoderOutputPtr QnScaleImageFilter::updateImage(
     const CLVideoDecoderOutputPtr& frame,
     const QnAbstractCompressedMetadataPtr&)
 {
-    auto result = frame->scaled(m_size, m_format);
+    // Same as CLVideoDecoderOutput::scaled(), but reuses the scaler and the target frames.
+    if (m_size.width() <= 0 || m_size.height() <= 0 || frame->width <= 0 || frame->height <= 0)
+    {
+        NX_DEBUG(this, "Error while scaling frame of %1 to %2", frame->size(), m_size);
+        return frame;
+    }
+
+    auto format = m_format;
+    if (format == AV_PIX_FMT_NONE)
+    {
+        format = (AVPixelFormat) frame->format;
+        if (!sws_isSupportedOutput(format))
+            format = AV_PIX_FMT_RGB24;
+    }
+
+    m_scaleContext = sws_getCachedContext(m_scaleContext,
+        frame->width, frame->height, (AVPixelFormat) frame->format,
+        m_size.width(), m_size.height(), format,
+        SWS_BICUBIC, /*srcFilter*/ nullptr, /*dstFilter*/ nullptr, /*param*/ nullptr);
+    const auto result =
+        m_scaleContext ? m_framePool.get(m_size, format) : CLVideoDecoderOutputPtr();
     if (!result)
     {
         NX_DEBUG(this, "Error while scaling frame to %1 (%2)", m_size, m_format);
         return frame;
     }
 
+    result->assignMiscData(frame.data());
+    result->sample_aspect_ratio = 1.0;
+    sws_scale(m_scaleContext, frame->data, frame->linesize, 0, frame->height,
+        result->data, result->linesize);
     return result;
 }
 
@@ -6,12 +6,17 @@
 
 #include <libavutil/pixfmt.h>
 
+#include <nx/media/ffmpeg/video_frame_pool.h>
+
 #include "abstract_image_filter.h"
 
+struct SwsContext;
+
 class NX_VMS_COMMON_API QnScaleImageFilter: public QnAbstractImageFilter
 {
 public:
     QnScaleImageFilter(const QSize& size, AVPixelFormat format = AV_PIX_FMT_NONE);
+    virtual ~QnScaleImageFilter() override;
 
     /** Returns the original frame if scaling has failed. */
     virtual CLVideoDecoderOutputPtr updateImage(
@@ -20,9 +25,15 @@ public:
 
     virtual QSize updatedResolution(const QSize& srcSize) override;
 
+    virtual bool isInPlace() const override { return false; }
+
     void setOutputImageSize( const QSize& size );
 
 private:
     QSize m_size;
     AVPixelFormat m_format;
+
+    /** Kept between the frames, since the initialization of the filter tables is expensive. */
+    SwsContext* m_scaleContext = nullptr;
+    nx::media::ffmpeg::VideoFramePool m_framePool;
 };
@@ -2,57 +2,197 @@
 
 #include "tiled_image_filter.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
 #include <nx/media/ffmpeg/frame_info.h>
+#include <nx/utils/concurrent.h>
+#include <nx/utils/log/log.h>
 #include <utils/common/util.h>
 
-#include "crop_image_filter.h"
+namespace {
+
+static constexpr int kMinBandHeight = 64;
+static constexpr int kMaxThreadCount = 8;
+
+QThreadPool* threadPool()
+{
+    static QThreadPool* const pool =
+        []()
+        {
+            const auto pool = new QThreadPool();
+            pool->setMaxThreadCount(std::clamp(QThread::idealThreadCount(), 1, kMaxThreadCount));
+            return pool;
+        }();
+    return pool;
+}
+
+AVPixelFormat pixelFormat(const AVFrame* frame)
+{
+    return CLVideoDecoderOutput::fixDeprecatedPixelFormat((AVPixelFormat) frame->format);
+}
+
+/**
+ * Copies the frame to the frame of the same size and format in horizontal bands, processed by the
+ * pool threads in parallel: a single thread does not saturate the memory bandwidth when copying
+ * the composite frames of tens of megabytes.
+ */
+void copyInBands(const AVFrame* source, AVFrame* target)
+{
+    const AVPixFmtDescriptor* descriptor = av_pix_fmt_desc_get(pixelFormat(source));
+    if (!descriptor)
+        return;
+
+    const int alignment = 1 << descriptor->log2_chroma_h;
+    const int bandCount =
+        std::clamp(source->height / kMinBandHeight, 1, threadPool()->maxThreadCount());
+    const auto copyBand =
+        [&](int band)
+        {
+            for (int i = 0; i < QnFfmpegHelper::planeCount(descriptor) && source->data[i]; ++i)
+            {
+                int width = source->width;
+                int height = source->height;
+                int top = source->height * band / bandCount / alignment * alignment;
+                int bottom = source->height * (band + 1) / bandCount / alignment * alignment;
+                if (QnFfmpegHelper::isChromaPlane(i, descriptor))
+                {
+                    width >>= descriptor->log2_chroma_w;
+                    height >>= descriptor->log2_chroma_h;
+                    top >>= descriptor->log2_chroma_h;
+                    bottom >>= descriptor->log2_chroma_h;
+                }
+                if (band == bandCount - 1)
+                    bottom = height;
+
+                const int bytes = width * descriptor->comp[i].step * descriptor->comp[i].depth / 8;
+                for (int y = top; y < bottom; ++y)
+                {
+                    memcpy(target->data[i] + y * target->linesize[i],
+                        source->data[i] + y * source->linesize[i], bytes);
+                }
+            }
+        };
+
+    if (bandCount == 1)
+    {
+        copyBand(0);
+        return;
+    }
+
+    std::vector<int> bands(bandCount);
+    std::iota(bands.begin(), bands.end(), 0);
+    nx::utils::concurrent::mapped(threadPool(), bands, copyBand).waitForFinished();
+}
+
+} // namespace
 
 QnTiledImageFilter::QnTiledImageFilter(const QnConstResourceVideoLayoutPtr& videoLayout):
     m_layout(videoLayout)
 {
 }
 
+QnTiledImageFilter::~QnTiledImageFilter()
+{
+    sws_freeContext(m_scaleContext);
+}
+
 CLVideoDecoderOutputPtr QnTiledImageFilter::updateImage(
     const CLVideoDecoderOutputPtr& frame,
-    const QnAbstractCompressedMetadataPtr& metadata)
+    const QnAbstractCompressedMetadataPtr& /*metadata*/)
 {
     if (m_layout->size().width() == 1 && m_layout->size().height() == 1)
         return frame;
 
-    const QSize size(frame->width, frame->height);
-    if (!m_tiledFrame || size != m_size)
+    // The composite frame size is defined by the first frame. The frames of the channels with the
+    // other resolution are scaled to their tiles, so the composite frame is not rescaled and its
+    // size stays the same for the encoder.
+    if (!m_tiledFrame)
     {
-        m_size = size;
+        m_size = frame->size();
         const QSize newSize(frame->width * m_layout->size().width(),
             frame->height * m_layout->size().height());
-        if (m_tiledFrame)
-            m_tiledFrame = m_tiledFrame->scaled(newSize, static_cast<AVPixelFormat>(frame->format));
-
-        // Handling first channel of the camera. Also CLVideoDecoderOutput::scaled() function can
-        // return nullptr in case of error, handling it here.
-        if (!m_tiledFrame)
-        {
-            m_tiledFrame = CLVideoDecoderOutputPtr(new CLVideoDecoderOutput());
-            m_tiledFrame->reallocate(newSize, frame->format);
-            m_tiledFrame->memZero();
-        }
+        m_tiledFrame = CLVideoDecoderOutputPtr(new CLVideoDecoderOutput());
+        m_tiledFrame->reallocate(newSize, pixelFormat(frame.data()));
+        m_tiledFrame->memZero();
     }
     m_tiledFrame->assignMiscData(frame.data());
     m_prevFrameTime = m_tiledFrame->pts = qMax(static_cast<qint64>(m_tiledFrame->pts),
         m_prevFrameTime + MIN_FRAME_DURATION_USEC);
 
     const auto pos = m_layout->position(frame->channel);
-    const QRect rect(pos.x() * m_size.width(), pos.y() * m_size.height(),
-        m_size.width(), m_size.height());
-    auto croppedFrame = QnCropImageFilter(rect).updateImage(m_tiledFrame, metadata);
-    croppedFrame->copyFrom(frame.data());
+    if (pos.x() < 0 || pos.x() >= m_layout->size().width()
+        || pos.y() < 0 || pos.y() >= m_layout->size().height())
+    {
+        NX_DEBUG(this, "Frame of channel %1 is out of the layout", frame->channel);
+    }
+    else
+    {
+        updateTile(frame.data(), QPoint(pos.x() * m_size.width(), pos.y() * m_size.height()));
+    }
 
     // Make sure overlays will be painter on frame copy, not on the combined frame itself.
-    auto result = CLVideoDecoderOutputPtr(new CLVideoDecoderOutput());
-    result->copyFrom(m_tiledFrame.data());
+    auto result = m_framePool.get(m_tiledFrame->size(), pixelFormat(m_tiledFrame.data()));
+    if (!result)
+    {
+        result.reset(new CLVideoDecoderOutput());
+        result->copyFrom(m_tiledFrame.data());
+        return result;
+    }
+
+    copyInBands(m_tiledFrame.data(), result.data());
+    result->assignMiscData(m_tiledFrame.data());
     return result;
 }
 
+void QnTiledImageFilter::updateTile(const CLVideoDecoderOutput* frame, const QPoint& topLeft)
+{
+    const AVPixFmtDescriptor* descriptor = av_pix_fmt_desc_get(pixelFormat(m_tiledFrame.data()));
+    if (!descriptor)
+        return;
+
+    AVFrame tile{};
+    tile.format = m_tiledFrame->format;
+    tile.width = m_size.width();
+    tile.height = m_size.height();
+    for (int i = 0; i < QnFfmpegHelper::planeCount(descriptor) && m_tiledFrame->data[i]; ++i)
+    {
+        int x = topLeft.x();
+        int y = topLeft.y();
+        if (QnFfmpegHelper::isChromaPlane(i, descriptor))
+        {
+            x >>= descriptor->log2_chroma_w;
+            y >>= descriptor->log2_chroma_h;
+        }
+        const int pixelBytes = descriptor->comp[i].step * descriptor->comp[i].depth / 8;
+        tile.data[i] = m_tiledFrame->data[i] + y * m_tiledFrame->linesize[i] + x * pixelBytes;
+        tile.linesize[i] = m_tiledFrame->linesize[i];
+    }
+
+    if (frame->size() == m_size && pixelFormat(frame) == pixelFormat(m_tiledFrame.data()))
+    {
+        copyInBands(frame, &tile);
+        return;
+    }
+
+    m_scaleContext = sws_getCachedContext(m_scaleContext,
+        frame->width, frame->height, (AVPixelFormat) frame->format,
+        tile.width, tile.height, (AVPixelFormat) tile.format,
+        SWS_BICUBIC, /*srcFilter*/ nullptr, /*dstFilter*/ nullptr, /*param*/ nullptr);
+    if (!m_scaleContext)
+    {
+        NX_DEBUG(this, "Unable to scale the frame of channel %1 from %2 to %3",
+            frame->channel, frame->size(), m_size);
+        return;
+    }
+    sws_scale(m_scaleContext, frame->data, frame->linesize, 0, frame->height,
+        tile.data, tile.linesize);
+}
+
 QSize QnTiledImageFilter::updatedResolution(const QSize& srcSize)
 {
     return QSize(srcSize.width() * m_layout->size().width(),
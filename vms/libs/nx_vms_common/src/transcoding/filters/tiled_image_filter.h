@@ -5,22 +5,38 @@
 #include <QtGui/QFont>
 
 #include <core/resource/resource_media_layout.h>
+#include <nx/media/ffmpeg/video_frame_pool.h>
 
 #include "abstract_image_filter.h"
 
+struct SwsContext;
+
+/**
+ * Composes the frames of the channels of a multi-sensor camera into one frame by the video
+ * layout. Each channel frame updates its tile, and the composite frame is copied to the output.
+ */
 class NX_VMS_COMMON_API QnTiledImageFilter: public QnAbstractImageFilter
 {
 public:
     explicit QnTiledImageFilter(const QnConstResourceVideoLayoutPtr& videoLayout);
+    virtual ~QnTiledImageFilter() override;
+
     virtual CLVideoDecoderOutputPtr updateImage(
         const CLVideoDecoderOutputPtr& frame,
         const QnAbstractCompressedMetadataPtr& metadata) override;
 
     virtual QSize updatedResolution(const QSize& srcSize) override;
 
+    virtual bool isInPlace() const override { return false; }
+
+private:
+    void updateTile(const CLVideoDecoderOutput* frame, const QPoint& topLeft);
+
 private:
     QnConstResourceVideoLayoutPtr m_layout;
     CLVideoDecoderOutputPtr m_tiledFrame;
     QSize m_size;
     qint64 m_prevFrameTime = 0;
+    nx::media::ffmpeg::VideoFramePool m_framePool;
+    SwsContext* m_scaleContext = nullptr;
 };
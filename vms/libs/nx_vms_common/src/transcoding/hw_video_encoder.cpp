@@ -0,0 +1,200 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "hw_video_encoder.h"
+
+#include <algorithm>
+
+#include <QtCore/QStringList>
+
+#include <nx/media/ffmpeg/ffmpeg_utils.h>
+#include <nx/media/ffmpeg/hw_device_pool.h>
+#include <nx/utils/log/log.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::transcoding {
+
+namespace {
+
+struct Registry
+{
+    nx::Mutex mutex;
+    std::vector<HwEncoderBackend> backends{
+        {
+            .name = "vaapi",
+            .deviceType = AV_HWDEVICE_TYPE_VAAPI,
+            .hwPixelFormat = AV_PIX_FMT_VAAPI,
+            .encoders = {
+                {AV_CODEC_ID_H264, "h264_vaapi"},
+                {AV_CODEC_ID_HEVC, "hevc_vaapi"},
+                {AV_CODEC_ID_MJPEG, "mjpeg_vaapi"},
+                {AV_CODEC_ID_VP8, "vp8_vaapi"},
+                {AV_CODEC_ID_VP9, "vp9_vaapi"},
+            },
+        },
+        {
+            .name = "qsv",
+            .deviceType = AV_HWDEVICE_TYPE_QSV,
+            .hwPixelFormat = AV_PIX_FMT_QSV,
+            // The QSV frames context can not grow.
+            .framePoolSize = 32,
+            .encoders = {
+                {AV_CODEC_ID_H264, "h264_qsv"},
+                {AV_CODEC_ID_HEVC, "hevc_qsv"},
+                {AV_CODEC_ID_MJPEG, "mjpeg_qsv"},
+                {AV_CODEC_ID_VP9, "vp9_qsv"},
+            },
+        },
+        {
+            .name = "nvenc",
+            .deviceType = AV_HWDEVICE_TYPE_CUDA,
+            .hwPixelFormat = AV_PIX_FMT_CUDA,
+            .encoders = {
+                {AV_CODEC_ID_H264, "h264_nvenc"},
+                {AV_CODEC_ID_HEVC, "hevc_nvenc"},
+            },
+        },
+    };
+};
+
+Registry& registry()
+{
+    static Registry registry;
+    return registry;
+}
+
+const AVHWFramesContext* framesContext(const AVBufferRef* frames)
+{
+    return (const AVHWFramesContext*) frames->data;
+}
+
+} // namespace
+
+void registerHwEncoderBackend(HwEncoderBackend backend)
+{
+    auto& registry = nx::transcoding::registry();
+    NX_MUTEX_LOCKER lock(&registry.mutex);
+    const auto it = std::find_if(registry.backends.begin(), registry.backends.end(),
+        [&backend](const auto& item) { return item.name == backend.name; });
+    if (it != registry.backends.end())
+        *it = std::move(backend);
+    else
+        registry.backends.push_back(std::move(backend));
+}
+
+std::vector<HwEncoderBackend> hwEncoderBackends(const QString& names)
+{
+    auto& registry = nx::transcoding::registry();
+    NX_MUTEX_LOCKER lock(&registry.mutex);
+    if (names.trimmed().compare("auto", Qt::CaseInsensitive) == 0)
+        return registry.backends;
+
+    std::vector<HwEncoderBackend> result;
+    for (const auto& name: names.split(',', Qt::SkipEmptyParts))
+    {
+        const auto it = std::find_if(registry.backends.begin(), registry.backends.end(),
+            [name = name.trimmed().toLower().toStdString()](const auto& item)
+            {
+                return item.name == name;
+            });
+        if (it != registry.backends.end())
+            result.push_back(*it);
+        else
+            NX_WARNING(NX_SCOPE_TAG, "Unknown hardware encoder backend: %1", name);
+    }
+    return result;
+}
+
+HwVideoEncoder::HwVideoEncoder(const HwEncoderBackend& backend):
+    m_backend(backend)
+{
+}
+
+HwVideoEncoder::~HwVideoEncoder()
+{
+    av_buffer_unref(&m_frames);
+    av_buffer_unref(&m_device);
+}
+
+std::unique_ptr<HwVideoEncoder> HwVideoEncoder::create(
+    const HwEncoderBackend& backend, AVCodecContext* encoderContext)
+{
+    std::unique_ptr<HwVideoEncoder> encoder(new HwVideoEncoder(backend));
+    encoder->m_device =
+        nx::media::ffmpeg::HwDevicePool::instance().acquire(backend.deviceType);
+    if (!encoder->m_device)
+        return nullptr;
+
+    encoder->m_frames = av_hwframe_ctx_alloc(encoder->m_device);
+    if (!encoder->m_frames)
+        return nullptr;
+
+    auto frames = (AVHWFramesContext*) encoder->m_frames->data;
+    frames->format = backend.hwPixelFormat;
+    frames->sw_format = backend.swPixelFormat;
+    frames->width = encoderContext->width;
+    frames->height = encoderContext->height;
+    frames->initial_pool_size = backend.framePoolSize;
+    if (const int status = av_hwframe_ctx_init(encoder->m_frames); status < 0)
+    {
+        NX_DEBUG(NX_SCOPE_TAG, "Failed to initialize %1 frames %2x%3: %4", backend.name,
+            frames->width, frames->height, nx::media::ffmpeg::avErrorToString(status));
+        return nullptr;
+    }
+
+    encoderContext->pix_fmt = backend.hwPixelFormat;
+    encoderContext->hw_frames_ctx = av_buffer_ref(encoder->m_frames);
+    return encoder;
+}
+
+bool HwVideoEncoder::isCompatible(const AVFrame* frame) const
+{
+    if (!frame->hw_frames_ctx)
+        return false;
+
+    const auto source = framesContext(frame->hw_frames_ctx);
+    const auto target = framesContext(m_frames);
+    return frame->format == target->format
+        && source->device_ctx == target->device_ctx
+        && source->sw_format == target->sw_format
+        && frame->width == target->width
+        && frame->height == target->height;
+}
+
+CLVideoDecoderOutputPtr HwVideoEncoder::prepareFrame(const CLVideoDecoderOutputPtr& frame) const
+{
+    if (isCompatible(frame.get()))
+        return frame;
+
+    CLVideoDecoderOutputPtr source = frame;
+    if (source->hw_frames_ctx)
+    {
+        source = source->toSystemMemory();
+        if (!source)
+            return nullptr;
+    }
+
+    const auto target = framesContext(m_frames);
+    const QSize targetSize(target->width, target->height);
+    if (source->format != target->sw_format || source->size() != targetSize)
+    {
+        source = source->scaled(targetSize, target->sw_format);
+        if (!source)
+            return nullptr;
+    }
+
+    CLVideoDecoderOutputPtr result(new CLVideoDecoderOutput());
+    int status = av_hwframe_get_buffer(m_frames, result.get(), 0);
+    if (status >= 0)
+        status = av_hwframe_transfer_data(result.get(), source.get(), 0);
+    if (status < 0)
+    {
+        NX_DEBUG(this, "Failed to upload the frame to the %1 device: %2", m_backend.name,
+            nx::media::ffmpeg::avErrorToString(status));
+        return nullptr;
+    }
+    result->assignMiscData(source.get());
+    result->pict_type = source->pict_type;
+    return result;
+}
+
+} // namespace nx::transcoding
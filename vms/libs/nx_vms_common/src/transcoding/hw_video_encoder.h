@@ -0,0 +1,90 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include <nx/media/ffmpeg/frame_info.h>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/hwcontext.h>
+} // extern "C"
+
+namespace nx::transcoding {
+
+/** Family of the FFmpeg hardware encoders working on one device type. */
+struct HwEncoderBackend
+{
+    std::string name;
+    AVHWDeviceType deviceType = AV_HWDEVICE_TYPE_NONE;
+
+    /** Format of the video memory frames the encoders accept. */
+    AVPixelFormat hwPixelFormat = AV_PIX_FMT_NONE;
+
+    /** Layout of the video memory frames. The system memory frames are converted to it. */
+    AVPixelFormat swPixelFormat = AV_PIX_FMT_NV12;
+
+    /** Number of the preallocated video memory frames, 0 for the dynamic pool. */
+    int framePoolSize = 0;
+
+    /** FFmpeg encoder names by the codec, e.g. h264_vaapi for AV_CODEC_ID_H264. */
+    std::map<AVCodecID, std::string> encoders;
+};
+
+/**
+ * Adds the backend, replacing the one with the same name. The vaapi, qsv and nvenc backends are
+ * registered by default.
+ */
+NX_VMS_COMMON_API void registerHwEncoderBackend(HwEncoderBackend backend);
+
+/**
+ * @param names Comma-separated backend names in the order of preference, "auto" for all the
+ *     registered backends. The unknown names are skipped.
+ */
+NX_VMS_COMMON_API std::vector<HwEncoderBackend> hwEncoderBackends(const QString& names);
+
+/**
+ * Video memory frames of a hardware encoder on the device from nx::media::ffmpeg::HwDevicePool.
+ * The frames decoded on the same device are passed to the encoder as is, the other ones are
+ * uploaded.
+ */
+class NX_VMS_COMMON_API HwVideoEncoder
+{
+public:
+    /**
+     * Attaches the frames context to the encoder context before avcodec_open2(). The context
+     * width and height must be set.
+     * @return Null if the device is not available.
+     */
+    static std::unique_ptr<HwVideoEncoder> create(
+        const HwEncoderBackend& backend, AVCodecContext* encoderContext);
+
+    ~HwVideoEncoder();
+
+    HwVideoEncoder(const HwVideoEncoder&) = delete;
+    HwVideoEncoder& operator=(const HwVideoEncoder&) = delete;
+
+    const HwEncoderBackend& backend() const { return m_backend; }
+
+    /** @return Whether the frame can be encoded without a copy: a frame of the same device. */
+    bool isCompatible(const AVFrame* frame) const;
+
+    /** @return The frame in the video memory of the encoder, null on failure. */
+    CLVideoDecoderOutputPtr prepareFrame(const CLVideoDecoderOutputPtr& frame) const;
+
+private:
+    HwVideoEncoder(const HwEncoderBackend& backend);
+
+private:
+    const HwEncoderBackend m_backend;
+    AVBufferRef* m_device = nullptr;
+    AVBufferRef* m_frames = nullptr;
+};
+
+} // namespace nx::transcoding
@@ -8,6 +8,7 @@
 #include <nx/utils/log/log.h>
 #include <transcoding/filters/abstract_image_filter.h>
 #include <transcoding/filters/filter_helper.h>
+#include <transcoding/transcoding_ini.h>
 
 MediaTranscoder::MediaTranscoder(const Config& config, nx::metric::Storage* metrics):
     m_config(config),
@@ -38,6 +39,9 @@ bool MediaTranscoder::setVideoCodec(
     config.targetCodecId = codec;
     config.useMultiThreadEncode = nx::transcoding::useMultiThreadEncode(codec, resolution);
     config.rtpContatiner = m_config.rtpContatiner;
+    config.hardwareEncoders =
+        nx::transcoding::hwEncoderBackends(nx::transcoding::ini().hardwareEncoders);
+    config.useHardwareDecoder = nx::transcoding::ini().hardwareDecoding;
 
     return setVideoCodec(config, m_transcodingSettings);
 }
@@ -48,6 +52,8 @@ bool MediaTranscoder::setVideoCodec(
 {
     m_vTranscoder = std::make_unique<QnFfmpegVideoTranscoder>(config, m_metrics);
     auto filterChain = QnImageFilterHelper::createFilterChain(transcodingSettings);
+    m_videoConfig = config;
+    m_videoFiltersRequired = filterChain.isTranscodingRequired();
     m_vTranscoder->setFilterChain(filterChain);
     return true;
 }
@@ -70,6 +76,32 @@ void MediaTranscoder::setSourceResolution(const QSize& resolution)
     m_sourceResolution = resolution;
 }
 
+bool MediaTranscoder::isVideoRemuxPossible(const QnCompressedVideoData* video) const
+{
+    if (!m_vTranscoder || !video || !nx::transcoding::ini().remuxMatchingCodecs)
+        return false;
+
+    if (video->compressionType != m_videoConfig.targetCodecId || m_videoFiltersRequired)
+        return false;
+
+    if (m_videoConfig.bitrate > 0 || m_videoConfig.fixedFrameRate > 0)
+        return false;
+
+    const QSize& limit = m_videoConfig.outputResolutionLimit;
+    if (!limit.isValid())
+        return true;
+
+    QSize resolution = m_videoConfig.sourceResolution;
+    if (resolution.isEmpty())
+        resolution = QSize(video->width, video->height);
+    if (resolution.isEmpty() && video->context)
+        resolution = QSize(video->context->getWidth(), video->context->getHeight());
+
+    // The unknown source resolution may exceed the limit.
+    return !resolution.isEmpty()
+        && resolution.width() <= limit.width() && resolution.height() <= limit.height();
+}
+
 bool MediaTranscoder::openVideo(const QnConstCompressedVideoDataPtr& video)
 {
     if (!m_vTranscoder)
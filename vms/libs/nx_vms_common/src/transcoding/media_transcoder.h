@@ -60,6 +60,13 @@ public:
     */
     bool setAudioCodec(AVCodecID codec);
 
+    /**
+     * Whether the video can be passed to the muxer as is, without decoding and encoding: the
+     * codec set by setVideoCodec() is the codec of the source, and neither image filters, nor
+     * downscaling, nor the other bitrate or frame rate are requested.
+     */
+    bool isVideoRemuxPossible(const QnCompressedVideoData* video) const;
+
     /*
     * Prepare to transcode. If 'direct stream copy' is used, function got not empty video and audio data
     * Destination codecs MUST be used from source data codecs. If 'direct stream copy' is false, video or audio may be empty
@@ -86,6 +93,8 @@ private:
     const Config m_config;
     nx::metric::Storage* m_metrics = nullptr;
     std::unique_ptr<QnFfmpegVideoTranscoder> m_vTranscoder;
+    QnFfmpegVideoTranscoder::Config m_videoConfig;
+    bool m_videoFiltersRequired = false;
     std::unique_ptr<QnFfmpegAudioTranscoder> m_aTranscoder;
     QnLegacyTranscodingSettings m_transcodingSettings;
     QSize m_sourceResolution;
@@ -0,0 +1,15 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "transcoding_ini.h"
+
+namespace nx::transcoding {
+
+Ini::Ini(): IniConfig("nx_transcoding.ini") { reload(); }
+
+Ini& ini()
+{
+    static Ini ini;
+    return ini;
+}
+
+} // namespace nx::transcoding
@@ -0,0 +1,29 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <nx/kit/ini_config.h>
+
+namespace nx::transcoding {
+
+struct NX_VMS_COMMON_API Ini: nx::kit::IniConfig
+{
+    Ini();
+
+    NX_INI_STRING("", hardwareEncoders,
+        "Comma-separated hardware video encoder backends to try before the software encoder,\n"
+        "in the order of preference: vaapi, qsv, nvenc. \"auto\" tries all of them. The\n"
+        "software encoder is used if none of them is available.");
+
+    NX_INI_FLAG(1, hardwareDecoding,
+        "Decode on the device of the hardware encoder. The frames stay in the video memory if\n"
+        "neither scaling nor image filters are needed.");
+
+    NX_INI_FLAG(1, remuxMatchingCodecs,
+        "Pass the video to the muxer without transcoding if the requested codec is the codec of\n"
+        "the source and neither image filters nor the other resolution or bitrate are requested.");
+};
+
+NX_VMS_COMMON_API Ini& ini();
+
+} // namespace nx::transcoding
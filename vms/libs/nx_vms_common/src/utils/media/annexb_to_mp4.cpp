@@ -5,7 +5,6 @@
 #include <nx/codec/h265/extradata.h>
 #include <nx/codec/nal_units.h>
 #include <nx/media/h264_utils.h>
-#include <nx/media/utils.h>
 #include <nx/utils/log/log.h>
 
 namespace nx::media {
@@ -81,40 +80,6 @@ bool isAnnexb(const QnCompressedVideoData* data)
     return !isMp4Format(data);
 }
 
-void AnnexbToMp4::updateCodecParameters(const QnCompressedVideoData* frame)
-{
-    std::vector<uint8_t> extradata = buildExtraDataMp4(frame);
-    if (extradata.empty())
-    {
-        NX_DEBUG(this, "Failed to build extradata");
-        return;
-    }
-
-    CodecParametersPtr context;
-    if (frame->context)
-    {
-        context = std::make_shared<CodecParameters>(frame->context->getAvCodecParameters());
-    }
-    else
-    {
-        context = std::make_shared<CodecParameters>();
-        context->getAvCodecParameters()->codec_type = AVMEDIA_TYPE_VIDEO;
-        context->getAvCodecParameters()->codec_id = frame->compressionType;
-    }
-    context->setExtradata(extradata.data(), extradata.size());
-
-    QSize streamResolution = nx::media::getFrameSize(frame);
-    if (streamResolution.isEmpty())
-    {
-        NX_DEBUG(this, "Failed to get frame size");
-        return;
-    }
-
-    context->getAvCodecParameters()->width = streamResolution.width();
-    context->getAvCodecParameters()->height = streamResolution.height();
-    m_context = context;
-}
-
 QnCompressedVideoDataPtr AnnexbToMp4::process(const QnCompressedVideoData* frame)
 {
     if (frame->compressionType != AV_CODEC_ID_H264 && frame->compressionType != AV_CODEC_ID_H265)
@@ -126,12 +91,17 @@ QnCompressedVideoDataPtr AnnexbToMp4::process(const QnCompressedVideoData* frame
         return nullptr;
     }
 
+    bool isNewCodecParameters = false;
     if (frame->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey))
     {
-        updateCodecParameters(frame);
+        const bool hadParameters = m_parameterSets.entry() != nullptr;
+        bool changed = false;
+        m_parameterSets.update(frame, &changed);
+        isNewCodecParameters = changed && hadParameters;
     }
 
-    if (!m_context)
+    const auto parameters = m_parameterSets.entry();
+    if (!parameters)
     {
         NX_WARNING(this, "Failed to build codec parameters");
         return nullptr;
@@ -143,7 +113,9 @@ QnCompressedVideoDataPtr AnnexbToMp4::process(const QnCompressedVideoData* frame
         NX_WARNING(this, "Failed to convert from AnnexB to MP4 format, invalid NAL units");
         return nullptr;
     }
-    result->context = m_context;
+    result->context = parameters->codecParameters;
+    if (isNewCodecParameters)
+        result->flags |= QnAbstractMediaData::MediaFlags_newCodecParams;
     return result;
 }
 
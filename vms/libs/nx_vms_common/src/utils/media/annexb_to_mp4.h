@@ -5,6 +5,8 @@
 #include <nx/media/codec_parameters.h>
 #include <nx/media/video_data_packet.h>
 
+#include "parameter_set_cache.h"
+
 namespace nx::media {
 
 NX_VMS_COMMON_API std::vector<uint8_t> buildExtraDataMp4(const QnCompressedVideoData* frame);
@@ -16,13 +18,14 @@ NX_VMS_COMMON_API QnCompressedVideoDataPtr convertStartCodesToSizes(
 class NX_VMS_COMMON_API AnnexbToMp4
 {
 public:
+    /**
+     * The output frames share the codec parameters until the parameter sets of the stream
+     * change. The first frame after the change is marked with MediaFlags_newCodecParams.
+     */
     QnCompressedVideoDataPtr process(const QnCompressedVideoData* frame);
 
 private:
-    void updateCodecParameters(const QnCompressedVideoData* frame);
-
-private:
-    CodecParametersConstPtr m_context;
+    ParameterSetCache m_parameterSets;
 };
 
 } // namespace nx::media
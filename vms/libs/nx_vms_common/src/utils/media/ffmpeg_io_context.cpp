@@ -59,7 +59,8 @@ AVIOContext* createFfmpegIOContext(
     QnStorageResourcePtr resource,
     const QString& url,
     QIODevice::OpenMode openMode,
-    int ioBlockSize)
+    int ioBlockSize,
+    std::optional<nx::recording::StorageIoClass> ioClass)
 {
     QString path = url;
 
@@ -70,6 +71,14 @@ AVIOContext* createFfmpegIOContext(
     if (ioDevice == 0)
         return 0;
 
+    if (ioClass)
+    {
+        ioDevice = new nx::recording::ScheduledIoDevice(
+            std::unique_ptr<QIODevice>(ioDevice),
+            nx::recording::StorageIoScheduler::forStorage(resource->getId().toSimpleString()),
+            *ioClass);
+    }
+
     ioBuffer = (quint8*) av_malloc(ioBlockSize);
     ffmpegIOContext = avio_alloc_context(
         ioBuffer,
@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include <optional>
+
 #include <QtCore/QIODevice>
 
+#include <recording/storage_io_scheduler.h>
+
 #include "core/resource/resource_fwd.h"
 
 extern "C" {
@@ -13,11 +17,16 @@ extern "C" {
 
 namespace nx::utils::media {
 
+/**
+ * @param ioClass If set, the reads and writes of the file are started by the scheduler of the
+ *     storage.
+ */
 NX_VMS_COMMON_API AVIOContext* createFfmpegIOContext(
     QnStorageResourcePtr resource,
     const QString& url,
     QIODevice::OpenMode openMode,
-    int ioBlockSize = 32768);
+    int ioBlockSize = 32768,
+    std::optional<nx::recording::StorageIoClass> ioClass = std::nullopt);
 
 NX_VMS_COMMON_API AVIOContext* createFfmpegIOContext(QIODevice* ioDevice, int ioBlockSize = 32768);
 NX_VMS_COMMON_API void closeFfmpegIOContext(AVIOContext* ioContext);
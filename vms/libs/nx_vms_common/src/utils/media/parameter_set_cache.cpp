@@ -0,0 +1,130 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "parameter_set_cache.h"
+
+#include <nx/codec/h264/common.h>
+#include <nx/codec/h265/hevc_common.h>
+#include <nx/codec/nal_units.h>
+#include <nx/media/utils.h>
+#include <nx/utils/log/log.h>
+
+#include "annexb_to_mp4.h"
+
+namespace nx::media {
+
+namespace {
+
+bool isParameterSet(AVCodecID codec, uint8_t nalHeader)
+{
+    if (codec == AV_CODEC_ID_H264)
+    {
+        const auto type = h264::decodeType(nalHeader);
+        return type == h264::nuSPS || type == h264::nuPPS;
+    }
+
+    const auto type = (h265::NalUnitType)
+        ((nalHeader & h265::kPayloadHeaderNalUnitTypeMask) >> 1);
+    return type == h265::NalUnitType::vpsNut
+        || type == h265::NalUnitType::spsNut
+        || type == h265::NalUnitType::ppsNut;
+}
+
+bool isSameContext(const CodecParametersConstPtr& first, const CodecParametersConstPtr& second)
+{
+    return first == second || (first && second && first->isEqual(*second));
+}
+
+} // namespace
+
+void ParameterSetCache::readParameterSets(const QnCompressedVideoData* frame)
+{
+    // Each unit is prefixed with the start code, so the unit boundaries are a part of the key.
+    m_frameParameterSets.clear();
+    const auto nalUnits =
+        nal::findNalUnitsAnnexB((const uint8_t*) frame->data(), frame->dataSize());
+    for (const auto& nalu: nalUnits)
+    {
+        if (nalu.size > 0 && isParameterSet(frame->compressionType, *nalu.data))
+        {
+            m_frameParameterSets.insert(
+                m_frameParameterSets.end(), nal::kStartCode.begin(), nal::kStartCode.end());
+            m_frameParameterSets.insert(
+                m_frameParameterSets.end(), nalu.data, nalu.data + nalu.size);
+        }
+    }
+}
+
+bool ParameterSetCache::isCached(const QnCompressedVideoData* frame) const
+{
+    return m_entry
+        && frame->compressionType == m_codec
+        && m_frameParameterSets == m_parameterSets
+        && isSameContext(frame->context, m_context);
+}
+
+const ParameterSetCache::Entry* ParameterSetCache::update(
+    const QnCompressedVideoData* frame, bool* changed)
+{
+    if (changed)
+        *changed = false;
+
+    readParameterSets(frame);
+    if (isCached(frame))
+        return &*m_entry;
+
+    Entry entry;
+    entry.extradataMp4 = buildExtraDataMp4(frame);
+    if (entry.extradataMp4.empty())
+    {
+        NX_DEBUG(this, "Failed to build extradata");
+        return nullptr;
+    }
+
+    entry.resolution = getFrameSize(frame);
+    if (entry.resolution.isEmpty())
+    {
+        NX_DEBUG(this, "Failed to get frame size");
+        return nullptr;
+    }
+
+    CodecParametersPtr context;
+    if (frame->context)
+    {
+        context = std::make_shared<CodecParameters>(frame->context->getAvCodecParameters());
+    }
+    else
+    {
+        context = std::make_shared<CodecParameters>();
+        context->getAvCodecParameters()->codec_type = AVMEDIA_TYPE_VIDEO;
+        context->getAvCodecParameters()->codec_id = frame->compressionType;
+    }
+    context->setExtradata(entry.extradataMp4.data(), entry.extradataMp4.size());
+    context->getAvCodecParameters()->width = entry.resolution.width();
+    context->getAvCodecParameters()->height = entry.resolution.height();
+    entry.codecParameters = std::move(context);
+
+    NX_VERBOSE(this, "New parameter sets: %1 bytes, resolution %2x%3",
+        m_frameParameterSets.size(), entry.resolution.width(), entry.resolution.height());
+    m_codec = frame->compressionType;
+    m_context = frame->context;
+    std::swap(m_parameterSets, m_frameParameterSets);
+    m_entry = std::move(entry);
+    if (changed)
+        *changed = true;
+    return &*m_entry;
+}
+
+const ParameterSetCache::Entry* ParameterSetCache::entry() const
+{
+    return m_entry ? &*m_entry : nullptr;
+}
+
+void ParameterSetCache::clear()
+{
+    m_codec = AV_CODEC_ID_NONE;
+    m_context.reset();
+    m_parameterSets.clear();
+    m_entry.reset();
+}
+
+} // namespace nx::media
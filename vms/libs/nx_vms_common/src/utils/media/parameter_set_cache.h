@@ -0,0 +1,57 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <QtCore/QSize>
+
+#include <nx/media/codec_parameters.h>
+#include <nx/media/video_data_packet.h>
+
+namespace nx::media {
+
+/**
+ * Per-stream cache of the data derived from the H.264/H.265 parameter sets (VPS, SPS and PPS).
+ * Cameras resend the same parameter sets with each key frame, so the data is rebuilt only when
+ * the raw parameter set bytes or the frame context actually change.
+ */
+class NX_VMS_COMMON_API ParameterSetCache
+{
+public:
+    struct Entry
+    {
+        /** AVCDecoderConfigurationRecord or HEVCDecoderConfigurationRecord. */
+        std::vector<uint8_t> extradataMp4;
+        QSize resolution;
+        /** The frame context, if any, with extradataMp4 and the resolution. */
+        CodecParametersConstPtr codecParameters;
+    };
+
+    /**
+     * Looks up the parameter sets of the key frame, building the new entry if they differ from
+     * the cached ones.
+     * @param changed Set to true if the new entry has been built.
+     * @return Null if there are no valid parameter sets, the previous entry is kept then.
+     */
+    const Entry* update(const QnCompressedVideoData* frame, bool* changed = nullptr);
+
+    /** @return The entry of the last valid parameter sets, null if there were none. */
+    const Entry* entry() const;
+
+    void clear();
+
+private:
+    void readParameterSets(const QnCompressedVideoData* frame);
+    bool isCached(const QnCompressedVideoData* frame) const;
+
+private:
+    AVCodecID m_codec = AV_CODEC_ID_NONE;
+    CodecParametersConstPtr m_context;
+    std::vector<uint8_t> m_parameterSets;
+    std::vector<uint8_t> m_frameParameterSets;
+    std::optional<Entry> m_entry;
+};
+
+} // namespace nx::media
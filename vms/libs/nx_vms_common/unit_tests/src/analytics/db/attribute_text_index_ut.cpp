@@ -0,0 +1,150 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <algorithm>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include <analytics/db/attribute_text_index.h>
+
+namespace nx::analytics::db::test {
+
+using namespace std::chrono;
+
+namespace {
+
+class ObjectTypeDictionary: public AbstractObjectTypeDictionary
+{
+public:
+    virtual std::optional<QString> idToName(const QString& id) const override
+    {
+        if (const auto it = m_names.find(id); it != m_names.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+private:
+    const std::map<QString, QString> m_names{
+        {"nx.base.Vehicle", "Vehicle"},
+        {"nx.base.Person", "Person"},
+    };
+};
+
+} // namespace
+
+class AttributeTextIndexTest: public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        addTrack(0, "nx.base.Vehicle", {{"Color", "Dark Red"}, {"License Plate.Number", "AB123"}});
+        addTrack(1, "nx.base.Vehicle", {{"Color", "Blue"}, {"Speed", "[40 ... 60]"}});
+        addTrack(2, "nx.base.Person", {{"Clothes.Color", "Red"}, {"Gender", "Woman"}});
+        addTrack(3, "nx.base.Person", {});
+    }
+
+    void addTrack(
+        int number, const QString& objectTypeId, nx::common::metadata::Attributes attributes)
+    {
+        ObjectTrack track;
+        track.id = nx::Uuid::createUuid();
+        track.deviceId = number % 2 == 0 ? m_deviceId : nx::Uuid::createUuid();
+        track.objectTypeId = objectTypeId;
+        track.attributes = std::move(attributes);
+        track.firstAppearanceTimeUs = microseconds(hours(number)).count();
+        track.lastAppearanceTimeUs = track.firstAppearanceTimeUs + 1'000'000;
+        m_index.add(track);
+        m_tracks.push_back(track);
+    }
+
+    /** Checks that the candidates include all the accepted Tracks, and returns their numbers. */
+    std::vector<int> lookup(const Filter& filter)
+    {
+        const auto candidates = m_index.lookup(filter, m_dictionary);
+
+        std::vector<int> result;
+        for (int i = 0; i < (int) m_tracks.size(); ++i)
+        {
+            const bool isCandidate =
+                std::find(candidates.begin(), candidates.end(), m_tracks[i].id)
+                    != candidates.end();
+            if (filter.acceptsTrack(m_tracks[i], m_dictionary))
+                EXPECT_TRUE(isCandidate) << "Track " << i << " is missed by " << toString(filter);
+            if (isCandidate)
+                result.push_back(i);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<int> lookupText(const QString& text)
+    {
+        Filter filter;
+        filter.freeText = text;
+        return lookup(filter);
+    }
+
+protected:
+    AttributeTextIndex m_index;
+    ObjectTypeDictionary m_dictionary;
+    nx::Uuid m_deviceId = nx::Uuid::createUuid();
+    std::vector<ObjectTrack> m_tracks;
+};
+
+TEST_F(AttributeTextIndexTest, textIsMatchedByWordSubstrings)
+{
+    ASSERT_EQ(std::vector<int>({0, 2}), lookupText("red"));
+    ASSERT_EQ(std::vector<int>({0, 2}), lookupText("RED"));
+    ASSERT_EQ(std::vector<int>({0}), lookupText("b12"));
+    ASSERT_EQ(std::vector<int>({0}), lookupText("red ark"));
+    ASSERT_EQ(std::vector<int>(), lookupText("green"));
+}
+
+TEST_F(AttributeTextIndexTest, textIsMatchedByObjectTypeName)
+{
+    ASSERT_EQ(std::vector<int>({2, 3}), lookupText("pers"));
+    ASSERT_EQ(std::vector<int>({0, 1}), lookupText("ve"));
+}
+
+TEST_F(AttributeTextIndexTest, attributeConditions)
+{
+    ASSERT_EQ(std::vector<int>({0, 1}), lookupText("$color"));
+    ASSERT_EQ(std::vector<int>({2}), lookupText("$clothes"));
+    ASSERT_EQ(std::vector<int>({0}), lookupText("color:red"));
+    ASSERT_EQ(std::vector<int>({1}), lookupText("speed=50"));
+
+    // The negative conditions do not narrow the candidates.
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 3}), lookupText("!$color"));
+}
+
+TEST_F(AttributeTextIndexTest, filterFields)
+{
+    Filter filter;
+    filter.deviceIds.insert(m_deviceId);
+    filter.objectTypeId.insert("nx.base.Vehicle");
+    ASSERT_EQ(std::vector<int>({0}), lookup(filter));
+
+    filter = Filter();
+    filter.timePeriod = QnTimePeriod(hours(2), hours(1));
+    ASSERT_EQ(std::vector<int>({2, 3}), lookup(filter));
+}
+
+TEST_F(AttributeTextIndexTest, trackIsUpdated)
+{
+    ObjectTrack track = m_tracks[3];
+    track.attributes.push_back({"Bag", "Backpack"});
+    m_tracks[3] = track;
+    m_index.add(track);
+
+    ASSERT_EQ(4, m_index.trackCount());
+    ASSERT_EQ(std::vector<int>({3}), lookupText("pack"));
+}
+
+TEST_F(AttributeTextIndexTest, oldPartitionsAreRemoved)
+{
+    m_index.removeBefore(hours(2));
+    ASSERT_EQ(2, m_index.trackCount());
+    ASSERT_EQ(2, m_index.lookup(Filter(), m_dictionary).size());
+}
+
+} // namespace nx::analytics::db::test
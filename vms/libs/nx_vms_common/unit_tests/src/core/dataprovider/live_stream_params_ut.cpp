@@ -0,0 +1,76 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <core/dataprovider/live_stream_params.h>
+
+namespace nx::vms::common::test {
+
+namespace {
+
+QnLiveStreamParams makeParams()
+{
+    QnLiveStreamParams params;
+    params.quality = Qn::StreamQuality::high;
+    params.fps = 15;
+    params.resolution = QSize(1920, 1080);
+    params.codec = "H264";
+    return params;
+}
+
+} // namespace
+
+TEST(LiveStreamParamsDiff, insignificantChangesAreIgnored)
+{
+    const auto params = makeParams();
+    ASSERT_TRUE(params.diff(params).isEmpty());
+
+    auto changed = params;
+    changed.fps = 15.3F;
+    changed.codec = "h264";
+    ASSERT_TRUE(params.diff(changed).isEmpty());
+
+    auto withBitrate = params;
+    withBitrate.bitrateKbps = 4000;
+    changed = withBitrate;
+    changed.bitrateKbps = 4100;
+    changed.quality = Qn::StreamQuality::low; //< Overridden by the bitrate.
+    ASSERT_TRUE(withBitrate.diff(changed).isEmpty());
+}
+
+TEST(LiveStreamParamsDiff, restartIsRequiredForFormatChangesOnly)
+{
+    const auto params = makeParams();
+
+    auto changed = params;
+    changed.fps = 25;
+    changed.quality = Qn::StreamQuality::low;
+    auto diff = params.diff(changed);
+    ASSERT_TRUE(diff.fps);
+    ASSERT_TRUE(diff.quality);
+    ASSERT_FALSE(diff.requiresRestart());
+
+    changed = params;
+    changed.bitrateKbps = 2000;
+    diff = params.diff(changed);
+    ASSERT_TRUE(diff.bitrate);
+    ASSERT_FALSE(diff.requiresRestart());
+
+    changed = params;
+    changed.resolution = QSize(1280, 720);
+    ASSERT_TRUE(params.diff(changed).requiresRestart());
+
+    changed = params;
+    changed.codec = "H265";
+    ASSERT_TRUE(params.diff(changed).requiresRestart());
+}
+
+TEST(LiveStreamParamsDiff, fpsInitialization)
+{
+    QnLiveStreamParams params;
+    auto changed = params;
+    changed.fps = 1;
+    ASSERT_TRUE(params.diff(changed).fps);
+}
+
+} // namespace nx::vms::common::test
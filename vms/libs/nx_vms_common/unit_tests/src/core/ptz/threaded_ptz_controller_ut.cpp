@@ -0,0 +1,100 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <QtCore/QThreadPool>
+
+#include <core/ptz/basic_ptz_controller.h>
+#include <core/ptz/threaded_ptz_controller.h>
+#include <nx/utils/std/future.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::vms::common::ptz::test {
+
+namespace {
+
+/** Blocks in the first command until released, like a slow camera. */
+class SlowPtzController: public QnBasicPtzController
+{
+public:
+    SlowPtzController(): QnBasicPtzController(QnResourcePtr()) {}
+
+    virtual Ptz::Capabilities getCapabilities(const Options& /*options*/) const override
+    {
+        return Ptz::ContinuousPtzCapabilities | Ptz::PresetsPtzCapability;
+    }
+
+    virtual bool continuousMove(const Vector& speed, const Options& /*options*/) override
+    {
+        addCall(QString("move %1").arg(speed.pan));
+        return true;
+    }
+
+    virtual bool activatePreset(const QString& presetId, qreal /*speed*/) override
+    {
+        addCall("preset " + presetId);
+        return true;
+    }
+
+    void waitForFirstCall() { m_firstCallStarted.get_future().wait(); }
+    void release() { m_release.set_value(); }
+
+    QStringList calls() const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_calls;
+    }
+
+private:
+    void addCall(const QString& call)
+    {
+        bool isFirstCall = false;
+        {
+            NX_MUTEX_LOCKER lock(&m_mutex);
+            isFirstCall = m_calls.empty();
+            m_calls.push_back(call);
+        }
+
+        if (isFirstCall)
+        {
+            m_firstCallStarted.set_value();
+            m_release.get_future().wait();
+        }
+    }
+
+private:
+    mutable nx::Mutex m_mutex;
+    QStringList m_calls;
+    nx::utils::promise<void> m_firstCallStarted;
+    nx::utils::promise<void> m_release;
+};
+
+} // namespace
+
+TEST(ThreadedPtzController, continuous_moves_are_coalesced_while_command_is_in_flight)
+{
+    QThreadPool threadPool;
+    auto camera = QSharedPointer<SlowPtzController>::create();
+    QnThreadedPtzController controller(camera, &threadPool);
+
+    ASSERT_TRUE(controller.continuousMove(Vector(1, 0, 0, 0), {Type::operational}));
+    camera->waitForFirstCall();
+
+    ASSERT_TRUE(controller.continuousMove(Vector(2, 0, 0, 0), {Type::operational}));
+    ASSERT_TRUE(controller.continuousMove(Vector(3, 0, 0, 0), {Type::operational}));
+    ASSERT_TRUE(controller.activatePreset("home", 1.0));
+    ASSERT_TRUE(controller.continuousMove(Vector(4, 0, 0, 0), {Type::operational}));
+    ASSERT_TRUE(controller.continuousMove(Vector(5, 0, 0, 0), {Type::operational}));
+
+    camera->release();
+    threadPool.waitForDone();
+
+    ASSERT_EQ(QStringList({"move 1", "move 3", "preset home", "move 5"}), camera->calls());
+
+    const auto statistics = controller.commandStatistics();
+    ASSERT_EQ(4, statistics.executedCount);
+    ASSERT_EQ(2, statistics.coalescedCount);
+    ASSERT_GE(statistics.maxLatency, statistics.averageLatency);
+}
+
+} // namespace nx::vms::common::ptz::test
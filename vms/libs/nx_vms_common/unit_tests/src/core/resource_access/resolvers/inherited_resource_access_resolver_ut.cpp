@@ -15,9 +15,11 @@
 #include <core/resource_access/resolvers/own_resource_access_resolver.h>
 #include <core/resource_access/resolvers/videowall_item_access_resolver.h>
 #include <nx/reflect/to_string.h>
+#include <nx/utils/elapsed_timer.h>
 #include <nx/utils/log/format.h>
 #include <nx/utils/range_adapters.h>
 #include <nx/utils/scoped_connections.h>
+#include <nx/utils/test_support/test_options.h>
 #include <nx/vms/api/data/user_group_data.h>
 #include <nx/vms/common/resource/camera_resource_stub.h>
 #include <nx/vms/common/system_context.h>
@@ -456,5 +458,63 @@ TEST_F(InheritedResourceAccessResolverTest, inheritedAdminAccessRights)
     ASSERT_EQ(resolver->accessRights(subjects->id("User 2"), desktopCamera), AccessRights());
 }
 
+TEST_F(InheritedResourceAccessResolverTest, largeHierarchyChangePerformance)
+{
+    // A site-scale model: top-level groups with nested groups, each user in two nested groups.
+    static constexpr int kTopGroupCount = 10;
+    static constexpr int kNestedGroupsPerTopGroup = 10;
+    const int userCount = nx::TestOptions::applyLoadMode<int>(10'000);
+
+    std::vector<nx::Uuid> topGroups;
+    std::vector<nx::Uuid> nestedGroups;
+    for (int i = 0; i < kTopGroupCount; ++i)
+    {
+        const auto topGroup = topGroups.emplace_back(nx::Uuid::createUuid());
+        subjects->addOrUpdate(topGroup, {});
+        for (int j = 0; j < kNestedGroupsPerTopGroup; ++j)
+            subjects->addOrUpdate(nestedGroups.emplace_back(nx::Uuid::createUuid()), {topGroup});
+    }
+
+    QSet<nx::Uuid> users;
+    QSet<nx::Uuid> changedGroupMembers;
+    for (int i = 0; i < userCount; ++i)
+    {
+        const auto user = nx::Uuid::createUuid();
+        const auto& group1 = nestedGroups[i % nestedGroups.size()];
+        const auto& group2 = nestedGroups[(i * 7 + 3) % nestedGroups.size()];
+        subjects->addOrUpdate(user, {group1, group2});
+        users.insert(user);
+        if (group1 == nestedGroups.front() || group2 == nestedGroups.front())
+            changedGroupMembers.insert(user);
+    }
+
+    for (const auto& groups: {topGroups, nestedGroups})
+    {
+        for (const auto& group: groups)
+            manager->setOwnResourceAccessMap(group, {{nx::Uuid::createUuid(), AccessRight::view}});
+    }
+
+    resolver->notifier()->subscribeSubjects(users);
+    nx::utils::ElapsedTimer timer(nx::utils::ElapsedTimerState::started);
+    for (const auto& user: users)
+        resolver->resourceAccessMap(user);
+    NX_INFO(this, "Resolved %1 users in %2", users.size(), timer.elapsed());
+
+    qRegisterMetaType<UuidSet>();
+    QSignalSpy spy(resolver->notifier(), &Notifier::resourceAccessChanged);
+
+    // Only the members of the changed group are notified and resolved again.
+    const auto camera = nx::Uuid::createUuid();
+    timer.restart();
+    manager->setOwnResourceAccessMap(nestedGroups.front(), {{camera, AccessRight::view}});
+    for (const auto& user: changedGroupMembers)
+        ASSERT_TRUE(resolver->resourceAccessMap(user).contains(camera));
+    NX_INFO(this, "Updated %1 users of %2 in %3",
+        changedGroupMembers.size(), users.size(), timer.elapsed());
+
+    ASSERT_EQ(spy.size(), 1);
+    ASSERT_EQ(spy.takeFirst()[0].value<UuidSet>(), changedGroupMembers);
+}
+
 } // namespace test
 } // namespace nx::core::access
@@ -6,6 +6,7 @@
 
 #include <api/helpers/camera_id_helper.h>
 #include <core/resource/layout_resource.h>
+#include <core/resource/media_server_resource.h>
 #include <core/resource/videowall_resource.h>
 #include <core/resource_management/resource_pool.h>
 #include <nx/utils/random.h>
@@ -207,6 +208,70 @@ TEST_F(QnResourcePoolTest, userByName)
     ASSERT_EQ(resourcePool()->userByName(kName).first, cloudUser);
 }
 
+TEST_F(QnResourcePoolTest, secondaryIndexes)
+{
+    const auto server1 = addServer();
+    const auto server2 = addServer();
+    const auto camera1 = addCamera();
+    const auto camera2 = addCamera();
+    camera1->setParentId(server1->getId());
+    camera2->setParentId(server1->getId());
+    const auto layout = addLayout();
+
+    ASSERT_EQ(resourcePool()->getResources<QnVirtualCameraResource>().size(), 2);
+    ASSERT_EQ(resourcePool()->getResources<QnMediaServerResource>().size(), 2);
+    ASSERT_EQ(resourcePool()->getResources<QnLayoutResource>(),
+        QnLayoutResourceList({layout}));
+    ASSERT_EQ(resourcePool()->getAllCameras(server1).size(), 2);
+    ASSERT_TRUE(resourcePool()->getAllCameras(server2).empty());
+
+    camera2->setParentId(server2->getId());
+    ASSERT_EQ(resourcePool()->getAllCameras(server1), QnVirtualCameraResourceList({camera1}));
+    ASSERT_EQ(resourcePool()->getResourcesByParentId(server2->getId()),
+        QnResourceList({camera2}));
+
+    camera1->setStatus(nx::vms::api::ResourceStatus::online);
+    camera2->setStatus(nx::vms::api::ResourceStatus::offline);
+    ASSERT_EQ(resourcePool()->getResourcesByStatus(nx::vms::api::ResourceStatus::online)
+        .filtered<QnVirtualCameraResource>(), QnVirtualCameraResourceList({camera1}));
+
+    camera2->setStatus(nx::vms::api::ResourceStatus::online);
+    ASSERT_EQ(resourcePool()->getResourcesByStatus(nx::vms::api::ResourceStatus::online)
+        .filtered<QnVirtualCameraResource>().size(), 2);
+
+    resourcePool()->removeResource(camera2);
+    ASSERT_EQ(resourcePool()->getResources<QnVirtualCameraResource>(),
+        QnVirtualCameraResourceList({camera1}));
+    ASSERT_TRUE(resourcePool()->getResourcesByParentId(server2->getId()).empty());
+    ASSERT_EQ(resourcePool()->getResourcesByStatus(nx::vms::api::ResourceStatus::online)
+        .filtered<QnVirtualCameraResource>(), QnVirtualCameraResourceList({camera1}));
+}
+
+TEST_F(QnResourcePoolTest, snapshot)
+{
+    const auto camera1 = addCamera();
+    const auto snapshot = resourcePool()->snapshot();
+    ASSERT_EQ(snapshot, resourcePool()->snapshot());
+    ASSERT_EQ(snapshot->getResources<QnVirtualCameraResource>(),
+        QnVirtualCameraResourceList({camera1}));
+
+    // The snapshot is not changed by the pool changes.
+    const auto camera2 = addCamera();
+    resourcePool()->removeResource(camera1);
+    ASSERT_EQ(snapshot->resources.size(), 1);
+    ASSERT_TRUE(snapshot->resources.contains(camera1->getId()));
+
+    const auto newSnapshot = resourcePool()->snapshot();
+    ASSERT_GT(newSnapshot->version, snapshot->version);
+    ASSERT_EQ(newSnapshot->getResources<QnVirtualCameraResource>(),
+        QnVirtualCameraResourceList({camera2}));
+
+    // The batch of the resources is one change.
+    const auto version = newSnapshot->version;
+    resourcePool()->addResources({createCamera(), createCamera()});
+    ASSERT_EQ(resourcePool()->snapshot()->version, version + 1);
+}
+
 TEST_F(QnResourcePoolTest, removeSignal)
 {
     auto listener = SignalListener(resourcePool());
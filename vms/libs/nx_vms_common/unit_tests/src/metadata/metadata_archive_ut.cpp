@@ -0,0 +1,107 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include <nx/media/meta_data_packet.h>
+#include <nx/utils/test_support/test_with_temporary_directory.h>
+#include <nx/vms/metadata/motion_filter.h>
+
+namespace nx::vms::metadata::test {
+
+using namespace std::chrono;
+
+namespace {
+
+static constexpr int kRecordCount = 3 * 3600;
+static constexpr int kFirstMatchedRecord = 70 * 60;
+static constexpr int kMatchedRecordCount = 3 * 60;
+
+class TestArchive: public MetadataArchive
+{
+public:
+    TestArchive(const QString& dataDir):
+        MetadataArchive(
+            "motion", kGeometrySize, /*wordSize*/ 0, /*aggregationIntervalSeconds*/ 1,
+            dataDir, "camera", /*channel*/ 0)
+    {
+    }
+
+    using MetadataArchive::matchPeriodInternal;
+    using MetadataArchive::saveToArchiveInternal;
+};
+
+} // namespace
+
+class MetadataArchiveTest:
+    public ::testing::Test,
+    public nx::utils::test::TestWithTemporaryDirectory
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_archive = std::make_unique<TestArchive>(testDataDir());
+
+        // The top left cell moves in 3 minutes of the second hour only, the bottom right one in
+        // the first and the last hours.
+        for (int i = 0; i < kRecordCount; ++i)
+        {
+            QByteArray grid(kGeometrySize, 0);
+            if (i >= kFirstMatchedRecord && i < kFirstMatchedRecord + kMatchedRecordCount)
+                grid[0] = (char) 0x80;
+            else if (i < 3600 || i >= 2 * 3600)
+                grid[kGeometrySize - 1] = 1;
+
+            auto packet = std::make_shared<QnCompressedMetadata>(MetadataType::Motion);
+            packet->timestamp = (kStartTime + seconds(i)).count() * 1000;
+            packet->setDurationUsec(duration_cast<microseconds>(seconds(1)).count());
+            packet->setData(grid);
+            ASSERT_TRUE(m_archive->saveToArchiveInternal(packet, /*extraWords*/ 0));
+        }
+    }
+
+    QnTimePeriodList match(Qt::SortOrder sortOrder)
+    {
+        MotionFilter filter;
+        filter.startTime = kStartTime;
+        filter.endTime = kStartTime + hours(3);
+        filter.sortOrder = sortOrder;
+        filter.region = QRegion(0, 0, 1, 1);
+        MotionRecordMatcher matcher(&filter);
+        return m_archive->matchPeriodInternal(&matcher);
+    }
+
+    void removeSummary()
+    {
+        const QString dir = QDir(testDataDir()).filePath("metadata/camera/2024/05");
+        ASSERT_TRUE(QFile::remove(QDir(dir).filePath("motion_summary_index.bin")));
+    }
+
+protected:
+    const milliseconds kStartTime{
+        QDateTime(QDate(2024, 5, 10), QTime(10, 0)).toMSecsSinceEpoch()};
+    std::unique_ptr<TestArchive> m_archive;
+};
+
+TEST_F(MetadataArchiveTest, matchesWithSummary)
+{
+    const QnTimePeriodList expected{QnTimePeriod(
+        kStartTime + seconds(kFirstMatchedRecord), seconds(kMatchedRecordCount))};
+    ASSERT_EQ(expected, match(Qt::AscendingOrder));
+    ASSERT_EQ(expected, match(Qt::DescendingOrder));
+}
+
+TEST_F(MetadataArchiveTest, matchesWithoutSummary)
+{
+    removeSummary();
+
+    const QnTimePeriodList expected{QnTimePeriod(
+        kStartTime + seconds(kFirstMatchedRecord), seconds(kMatchedRecordCount))};
+    ASSERT_EQ(expected, match(Qt::AscendingOrder));
+    ASSERT_EQ(expected, match(Qt::DescendingOrder));
+}
+
+} // namespace nx::vms::metadata::test
@@ -89,6 +89,15 @@ protected:
         }
     }
 
+    void whenReadAllPacketsByBatches()
+    {
+        constexpr int kMaxCount = 5;
+        while (m_metadataMultiplexer.getMotionDataBatch(
+            std::numeric_limits<qint64>::max(), kMaxCount, &m_packetsRead) == kMaxCount)
+        {
+        }
+    }
+
     void thenAllPacketsHaveBeenProvided()
     {
         fetchPacketsGenerated();
@@ -151,4 +160,15 @@ TEST_F(MetadataMultiplexer, dataless_reader_does_not_block_other_readers)
     andPacketsReadAreSortedByTimestamp();
 }
 
+TEST_F(MetadataMultiplexer, provides_packets_by_batches_sorted_by_timestamp)
+{
+    givenRandomReaders();
+    addEmptyReader();
+
+    whenReadAllPacketsByBatches();
+
+    thenAllPacketsHaveBeenProvided();
+    andPacketsReadAreSortedByTimestamp();
+}
+
 } // namespace test
@@ -0,0 +1,67 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include <nx/utils/test_support/test_with_temporary_directory.h>
+#include <nx/vms/metadata/dao/mmap_metadata_binary_file.h>
+
+namespace nx::vms::metadata::test {
+
+class MmapMetadataBinaryFileTest:
+    public ::testing::Test,
+    public nx::utils::test::TestWithTemporaryDirectory
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_fileName = QDir(testDataDir()).filePath("motion_detailed_data.bin");
+        for (int i = 0; i < 100000; ++i)
+            m_data.append((char) (i * 13));
+
+        QFile file(m_fileName);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        ASSERT_EQ(m_data.size(), file.write(m_data));
+    }
+
+protected:
+    QString m_fileName;
+    QByteArray m_data;
+};
+
+TEST_F(MmapMetadataBinaryFileTest, readOnlyFileIsMapped)
+{
+    MmapMetadataBinaryFile file;
+    file.setFileName(m_fileName);
+    ASSERT_TRUE(file.openReadOnly());
+
+    // The ranges are requested in the descending order, like the descending search does.
+    for (int offset: {90000, 5000, 100})
+    {
+        const char* data = file.mappedData(offset, 1000);
+        ASSERT_NE(nullptr, data);
+        ASSERT_EQ(m_data.mid(offset, 1000), QByteArray(data, 1000));
+    }
+    ASSERT_EQ(nullptr, file.mappedData(m_data.size() - 10, 11));
+
+    // The buffered reads are still available.
+    char data[10];
+    ASSERT_TRUE(file.seek(500));
+    ASSERT_EQ(10, file.read(data, sizeof(data)));
+    ASSERT_EQ(m_data.mid(500, 10), QByteArray(data, sizeof(data)));
+
+    file.close();
+    ASSERT_EQ(nullptr, file.mappedData(0, 10));
+}
+
+TEST_F(MmapMetadataBinaryFileTest, writableFileIsNotMapped)
+{
+    MmapMetadataBinaryFile file;
+    file.setFileName(m_fileName);
+    ASSERT_TRUE(file.openRW());
+    ASSERT_EQ(nullptr, file.mappedData(0, 10));
+}
+
+} // namespace nx::vms::metadata::test
@@ -0,0 +1,72 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/analytics/taxonomy/abstract_state_watcher.h>
+#include <nx/analytics/taxonomy/descriptor_container.h>
+#include <nx/vms/api/analytics/descriptors.h>
+#include <nx/vms/common/system_context.h>
+#include <nx/vms/common/test_support/test_context.h>
+
+namespace nx::analytics::taxonomy::test {
+
+using namespace nx::vms::api::analytics;
+
+namespace {
+
+Descriptors makeDescriptors(const QString& objectTypeName)
+{
+    ObjectTypeDescriptor objectType;
+    objectType.id = "nx.test.Vehicle";
+    objectType.name = objectTypeName;
+
+    Descriptors descriptors;
+    descriptors.objectTypeDescriptors[objectType.id] = objectType;
+    return descriptors;
+}
+
+} // namespace
+
+class StateWatcherTest: public nx::vms::common::test::ContextBasedTest
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_watcher = systemContext()->analyticsTaxonomyStateWatcher();
+        QObject::connect(m_watcher, &AbstractStateWatcher::stateChanged,
+            [this]() { ++m_stateChangedCount; });
+    }
+
+    void updateDescriptors(Descriptors descriptors)
+    {
+        systemContext()->analyticsDescriptorContainer()->updateDescriptorsForTests(
+            std::move(descriptors));
+    }
+
+protected:
+    AbstractStateWatcher* m_watcher = nullptr;
+    int m_stateChangedCount = 0;
+};
+
+TEST_F(StateWatcherTest, stateIsCompiledOnlyForChangedDescriptors)
+{
+    const int initialVersion = m_watcher->stateVersion();
+
+    updateDescriptors(makeDescriptors("Vehicle"));
+    const auto state = m_watcher->state();
+    ASSERT_EQ(1, m_stateChangedCount);
+    ASSERT_EQ(initialVersion + 1, m_watcher->stateVersion());
+
+    // The same descriptors saved again keep the published state.
+    updateDescriptors(makeDescriptors("Vehicle"));
+    ASSERT_EQ(1, m_stateChangedCount);
+    ASSERT_EQ(initialVersion + 1, m_watcher->stateVersion());
+    ASSERT_EQ(state, m_watcher->state());
+
+    updateDescriptors(makeDescriptors("Car"));
+    ASSERT_EQ(2, m_stateChangedCount);
+    ASSERT_EQ(initialVersion + 2, m_watcher->stateVersion());
+    ASSERT_NE(state, m_watcher->state());
+}
+
+} // namespace nx::analytics::taxonomy::test
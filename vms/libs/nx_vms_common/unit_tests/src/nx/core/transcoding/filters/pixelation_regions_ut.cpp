@@ -0,0 +1,76 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/core/transcoding/filters/pixelation_regions.h>
+
+namespace nx::core::transcoding::test {
+
+namespace {
+
+const nx::Uuid kTrackId = nx::Uuid::createUuid();
+
+nx::common::metadata::ObjectMetadataPacket makePacket(
+    qint64 timestampUs, const QRectF& boundingBox, const QString& typeId = "person")
+{
+    nx::common::metadata::ObjectMetadata object;
+    object.trackId = kTrackId;
+    object.typeId = typeId;
+    object.boundingBox = boundingBox;
+
+    nx::common::metadata::ObjectMetadataPacket packet;
+    packet.timestampUs = timestampUs;
+    packet.objectMetadataList.push_back(object);
+    return packet;
+}
+
+} // namespace
+
+TEST(PixelationRegions, regionsAreKeptBetweenPackets)
+{
+    nx::vms::api::PixelationSettings settings;
+    settings.objectTypeIds = {"person"};
+    PixelationRegions regions(settings);
+
+    regions.update(makePacket(1'000'000, QRectF(0.1, 0.1, 0.2, 0.2)));
+    regions.update(makePacket(1'000'000, QRectF(0.5, 0.5, 0.2, 0.2), "car"));
+    ASSERT_TRUE(regions.isEmpty());
+
+    regions.update(makePacket(1'000'000, QRectF(0.1, 0.1, 0.2, 0.2)));
+    ASSERT_EQ(QVector<QRectF>({QRectF(0.1, 0.1, 0.2, 0.2)}), regions.regions(1'040'000));
+
+    // The object has not moved, and the regions are dropped when no metadata arrives.
+    ASSERT_TRUE(regions.regions(1'000'000 + PixelationRegions::kHoldTime.count() + 1).isEmpty());
+}
+
+TEST(PixelationRegions, movementIsPredicted)
+{
+    nx::vms::api::PixelationSettings settings;
+    settings.isAllObjectTypes = true;
+    PixelationRegions regions(settings);
+
+    regions.update(makePacket(1'000'000, QRectF(0.1, 0.1, 0.2, 0.2)));
+    regions.update(makePacket(1'100'000, QRectF(0.2, 0.1, 0.2, 0.2)));
+
+    // The region covers both the last known and the predicted positions.
+    const auto result = regions.regions(1'150'000);
+    ASSERT_EQ(1, result.size());
+    ASSERT_NEAR(0.2, result[0].left(), 1e-9);
+    ASSERT_NEAR(0.45, result[0].right(), 1e-9);
+    ASSERT_NEAR(0.1, result[0].top(), 1e-9);
+    ASSERT_NEAR(0.3, result[0].bottom(), 1e-9);
+
+    // The prediction time is limited.
+    const auto farResult = regions.regions(1'900'000);
+    ASSERT_EQ(1, farResult.size());
+    ASSERT_NEAR(0.2, farResult[0].left(), 1e-9);
+    ASSERT_NEAR(0.9, farResult[0].right(), 1e-9);
+
+    // The predicted region does not leave the frame.
+    regions.update(makePacket(1'200'000, QRectF(0.7, 0.1, 0.2, 0.2)));
+    const auto clippedResult = regions.regions(1'300'000);
+    ASSERT_EQ(1, clippedResult.size());
+    ASSERT_NEAR(1.0, clippedResult[0].right(), 1e-9);
+}
+
+} // namespace nx::core::transcoding::test
@@ -0,0 +1,67 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/metric/metrics_storage.h>
+
+namespace nx::metric::test {
+
+TEST(MetricsStorage, sharded_values_are_summed_over_threads)
+{
+    static constexpr int kThreadCount = ShardedCounter::kShardCount * 2;
+    static constexpr int kIterations = 10'000;
+
+    Storage storage;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreadCount; ++i)
+    {
+        threads.emplace_back(
+            [&storage]()
+            {
+                for (int j = 0; j < kIterations; ++j)
+                {
+                    storage.tcpConnections().totalBytesSent() += 10;
+                    storage.tcpConnections().total()++;
+                }
+                for (int j = 0; j < kIterations / 2; ++j)
+                    storage.tcpConnections().total()--;
+            });
+    }
+    for (auto& thread: threads)
+        thread.join();
+
+    ASSERT_EQ(kThreadCount * kIterations * 10, storage.tcpConnections().totalBytesSent().load());
+    ASSERT_EQ(kThreadCount * kIterations / 2, storage.tcpConnections().total().load());
+    ASSERT_EQ(
+        kThreadCount * kIterations / 2,
+        storage.toJson(/*brief*/ true)["tcpConnections"]["total"].toInteger());
+}
+
+TEST(MetricsStorage, prometheus_exposition)
+{
+    Storage storage;
+    storage.decodedPixels() += 100;
+    storage.tcpConnections().p2p()++;
+    storage.transactions().logSize() = 7;
+    storage.p2pCounters().dataSentByMessageType()["say \"hi\""] = 5;
+
+    const QString text = storage.toPrometheus();
+    ASSERT_TRUE(text.contains(
+        "# HELP nx_decodedPixels Amount of decoded video pixels\n"
+        "# TYPE nx_decodedPixels counter\n"
+        "nx_decodedPixels 100\n")) << text.toStdString();
+    ASSERT_TRUE(text.contains(
+        "# TYPE nx_tcpConnections_p2p gauge\n"
+        "nx_tcpConnections_p2p 1\n")) << text.toStdString();
+    ASSERT_TRUE(text.contains(
+        "# TYPE nx_transactions_logSize untyped\n"
+        "nx_transactions_logSize 7\n")) << text.toStdString();
+    ASSERT_TRUE(text.contains(
+        "nx_p2pCounters_dataSentByMessageType{key=\"say \\\"hi\\\"\"} 5\n"))
+        << text.toStdString();
+}
+
+} // namespace nx::metric::test
@@ -0,0 +1,173 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/media/video_data_packet.h>
+#include <nx/streaming/abstract_data_consumer.h>
+#include <nx/streaming/data_consumer_pool.h>
+
+namespace nx::streaming::test {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+/** Not less than the packets put by the tests, so none of them is dropped. */
+constexpr int kMaxQueueSize = 128;
+
+class TestConsumer: public QnAbstractDataConsumer
+{
+public:
+    TestConsumer(DataConsumerPool* pool, int refusalCount = 0):
+        QnAbstractDataConsumer(kMaxQueueSize, QueueMode::lockFree),
+        m_refusalCount(refusalCount)
+    {
+        setPool(pool);
+    }
+
+    virtual ~TestConsumer() override { stop(); }
+
+    std::vector<qint64> timestamps() const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_timestamps;
+    }
+
+    void waitForProcessed(size_t count) const
+    {
+        while (timestamps().size() < count)
+            std::this_thread::sleep_for(1ms);
+    }
+
+    void putFrame(qint64 timestamp)
+    {
+        QnWritableCompressedVideoDataPtr frame(new QnWritableCompressedVideoData());
+        frame->timestamp = timestamp;
+        frame->flags |= QnAbstractMediaData::MediaFlags_AVKey;
+        putData(frame);
+    }
+
+protected:
+    virtual bool processData(const QnAbstractDataPacketPtr& data) override
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        if (m_refusalCount > 0)
+        {
+            --m_refusalCount;
+            return false;
+        }
+
+        m_timestamps.push_back(std::static_pointer_cast<QnAbstractMediaData>(data)->timestamp);
+        return true;
+    }
+
+private:
+    mutable nx::Mutex m_mutex;
+    int m_refusalCount = 0;
+    std::vector<qint64> m_timestamps;
+};
+
+std::vector<qint64> range(qint64 count)
+{
+    std::vector<qint64> result;
+    for (qint64 i = 0; i < count; ++i)
+        result.push_back(i);
+    return result;
+}
+
+} // namespace
+
+TEST(DataConsumerPool, consumersShareThreads)
+{
+    static constexpr int kConsumerCount = 20;
+    static constexpr int kPacketCount = 100;
+
+    DataConsumerPool pool(2);
+    std::vector<std::unique_ptr<TestConsumer>> consumers;
+    for (int i = 0; i < kConsumerCount; ++i)
+    {
+        consumers.push_back(std::make_unique<TestConsumer>(&pool));
+        consumers.back()->start();
+    }
+
+    std::vector<std::thread> producers;
+    for (const auto& consumer: consumers)
+    {
+        producers.emplace_back(
+            [consumer = consumer.get()]()
+            {
+                for (int i = 0; i < kPacketCount; ++i)
+                    consumer->putFrame(i);
+            });
+    }
+    for (auto& producer: producers)
+        producer.join();
+
+    for (const auto& consumer: consumers)
+    {
+        consumer->waitForProcessed(kPacketCount);
+        consumer->stop();
+        ASSERT_FALSE(consumer->isRunning());
+        ASSERT_EQ(range(kPacketCount), consumer->timestamps());
+    }
+}
+
+TEST(DataConsumerPool, refusedPacketIsRetried)
+{
+    DataConsumerPool pool(1);
+    TestConsumer refusing(&pool, /*refusalCount*/ 3);
+    TestConsumer other(&pool);
+    refusing.start();
+    other.start();
+
+    for (int i = 0; i < 5; ++i)
+    {
+        refusing.putFrame(i);
+        other.putFrame(i);
+    }
+
+    // The single pool thread is not held by the retries of the refused packet.
+    other.waitForProcessed(5);
+    refusing.waitForProcessed(5);
+    ASSERT_EQ(range(5), refusing.timestamps());
+}
+
+TEST(DataConsumerPool, packetsPutBeforeStartAreProcessed)
+{
+    DataConsumerPool pool(1);
+    TestConsumer consumer(&pool);
+    consumer.putFrame(0);
+    consumer.putFrame(1);
+    ASSERT_FALSE(consumer.isRunning());
+
+    consumer.start();
+    ASSERT_TRUE(consumer.isRunning());
+    consumer.waitForProcessed(2);
+    consumer.stop();
+
+    // Restarted after stop().
+    consumer.start();
+    consumer.putFrame(2);
+    consumer.waitForProcessed(3);
+    ASSERT_EQ(range(3), consumer.timestamps());
+}
+
+TEST(DataConsumerPool, pausedConsumerIsResumed)
+{
+    DataConsumerPool pool(1);
+    TestConsumer consumer(&pool);
+    consumer.start();
+    consumer.pause();
+    consumer.putFrame(0);
+    std::this_thread::sleep_for(20ms);
+    ASSERT_TRUE(consumer.timestamps().empty());
+
+    consumer.resume();
+    consumer.waitForProcessed(1);
+}
+
+} // namespace nx::streaming::test
@@ -0,0 +1,146 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/media/video_data_packet.h>
+#include <nx/streaming/abstract_data_consumer.h>
+#include <nx/streaming/lock_free_packet_queue.h>
+#include <nx/utils/thread/mutex.h>
+
+namespace nx::streaming::test {
+
+using namespace std::chrono;
+
+TEST(LockFreePacketQueue, boundedFifo)
+{
+    LockFreePacketQueue<int> queue(3);
+    ASSERT_EQ(4, queue.capacity());
+    ASSERT_TRUE(queue.isEmpty());
+
+    for (int i = 0; i < 4; ++i)
+        ASSERT_TRUE(queue.tryPush(i));
+    int value = 4;
+    ASSERT_FALSE(queue.tryPush(value));
+    ASSERT_EQ(4, queue.size());
+
+    std::vector<int> values;
+    ASSERT_EQ(3, queue.popBatch(&values, 3));
+    ASSERT_EQ(std::vector<int>({0, 1, 2}), values);
+    ASSERT_TRUE(queue.tryPush(value));
+    ASSERT_EQ(2, queue.popBatch(&values, 10));
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 3, 4}), values);
+    ASSERT_FALSE(queue.tryPop(value));
+    ASSERT_FALSE(queue.waitForData(1ms));
+}
+
+TEST(LockFreePacketQueue, manyProducers)
+{
+    static constexpr int kProducerCount = 4;
+    static constexpr int kValueCount = 100'000;
+
+    LockFreePacketQueue<int> queue(64);
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < kProducerCount; ++producer)
+    {
+        producers.emplace_back(
+            [&queue, producer]()
+            {
+                for (int i = 0; i < kValueCount; ++i)
+                {
+                    int value = producer * kValueCount + i;
+                    while (!queue.tryPush(value))
+                        std::this_thread::yield();
+                }
+            });
+    }
+
+    // The values of each producer are popped in the order they are pushed.
+    std::vector<int> lastValues(kProducerCount, -1);
+    std::vector<int> batch;
+    for (int count = 0; count < kProducerCount * kValueCount; )
+    {
+        ASSERT_TRUE(queue.waitForData(10s));
+        batch.clear();
+        count += (int) queue.popBatch(&batch, 16);
+        for (const int value: batch)
+        {
+            const int producer = value / kValueCount;
+            ASSERT_LT(lastValues[producer], value);
+            lastValues[producer] = value;
+        }
+    }
+
+    for (auto& producer: producers)
+        producer.join();
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+namespace {
+
+class TestConsumer: public QnAbstractDataConsumer
+{
+public:
+    TestConsumer(): QnAbstractDataConsumer(4, QueueMode::lockFree) {}
+    virtual ~TestConsumer() override { stop(); }
+
+    std::vector<qint64> timestamps() const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_timestamps;
+    }
+
+    void waitForProcessed(size_t count) const
+    {
+        while (timestamps().size() < count)
+            std::this_thread::sleep_for(1ms);
+    }
+
+protected:
+    virtual bool processData(const QnAbstractDataPacketPtr& data) override
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_timestamps.push_back(std::static_pointer_cast<QnAbstractMediaData>(data)->timestamp);
+        return true;
+    }
+
+private:
+    mutable nx::Mutex m_mutex;
+    std::vector<qint64> m_timestamps;
+};
+
+QnAbstractDataPacketPtr makeFrame(qint64 timestamp, bool isKey)
+{
+    QnWritableCompressedVideoDataPtr frame(new QnWritableCompressedVideoData());
+    frame->timestamp = timestamp;
+    if (isKey)
+        frame->flags |= QnAbstractMediaData::MediaFlags_AVKey;
+    return frame;
+}
+
+} // namespace
+
+TEST(LockFreePacketQueue, consumerDropsUntilKeyFrame)
+{
+    TestConsumer consumer;
+    consumer.putData(makeFrame(0, /*isKey*/ true));
+    for (int i = 1; i < 4; ++i)
+        consumer.putData(makeFrame(i, /*isKey*/ false));
+    ASSERT_FALSE(consumer.canAcceptData());
+    consumer.putData(makeFrame(4, /*isKey*/ false));
+
+    consumer.start();
+    consumer.waitForProcessed(4);
+    consumer.putData(makeFrame(5, /*isKey*/ false));
+    consumer.putData(makeFrame(6, /*isKey*/ true));
+    consumer.putData(makeFrame(7, /*isKey*/ false));
+    consumer.waitForProcessed(6);
+    consumer.stop();
+
+    ASSERT_EQ(std::vector<qint64>({0, 1, 2, 3, 6, 7}), consumer.timestamps());
+}
+
+} // namespace nx::streaming::test
@@ -0,0 +1,164 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <core/resource/resource_media_layout.h>
+#include <nx/media/video_data_packet.h>
+#include <nx/streaming/read_ahead_archive_delegate.h>
+
+namespace nx::streaming::test {
+
+using namespace std::chrono;
+
+namespace {
+
+static constexpr int kFrameCount = 100;
+static constexpr int kGopSize = 10;
+static constexpr int kFrameSize = 1000;
+static constexpr microseconds kFrameDuration = 100ms;
+
+/** The stream of 10 fps video with a key frame each second. */
+class TestArchiveDelegate: public QnAbstractArchiveDelegate
+{
+public:
+    virtual bool open(const QnResourcePtr&, AbstractArchiveIntegrityWatcher*) override
+    {
+        m_position = 0;
+        return true;
+    }
+
+    virtual void close() override {}
+    virtual qint64 startTime() const override { return 0; }
+    virtual qint64 endTime() const override { return kFrameCount * kFrameDuration.count(); }
+
+    virtual QnAbstractMediaDataPtr getNextData() override
+    {
+        if (m_position >= kFrameCount)
+            return nullptr;
+
+        QnWritableCompressedVideoDataPtr frame(new QnWritableCompressedVideoData(kFrameSize));
+        frame->compressionType = AV_CODEC_ID_H264;
+        frame->timestamp = m_position * kFrameDuration.count();
+        if (m_position % kGopSize == 0)
+            frame->flags |= QnAbstractMediaData::MediaFlags_AVKey;
+        frame->m_data.resize(kFrameSize);
+        ++m_position;
+        ++readCount;
+        return frame;
+    }
+
+    virtual qint64 seek(qint64 time, bool findIFrame) override
+    {
+        m_position = (int) (time / kFrameDuration.count());
+        if (findIFrame)
+            m_position -= m_position % kGopSize;
+        ++seekCount;
+        return time;
+    }
+
+    virtual QnConstResourceVideoLayoutPtr getVideoLayout() override
+    {
+        return std::make_shared<QnDefaultResourceVideoLayout>();
+    }
+
+    virtual AudioLayoutConstPtr getAudioLayout() override { return nullptr; }
+
+public:
+    std::atomic<int> readCount = 0;
+    std::atomic<int> seekCount = 0;
+
+private:
+    int m_position = 0;
+};
+
+class ReadAheadArchiveDelegateTest: public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        auto source = std::make_unique<TestArchiveDelegate>();
+        m_source = source.get();
+        ReadAheadArchiveDelegate::Budget budget;
+        budget.duration = 3s;
+        m_delegate = std::make_unique<ReadAheadArchiveDelegate>(std::move(source), budget);
+        ASSERT_TRUE(m_delegate->open(QnResourcePtr()));
+    }
+
+    qint64 nextTimestamp()
+    {
+        const auto packet = m_delegate->getNextData();
+        return packet ? packet->timestamp : -1;
+    }
+
+    void waitForReadAhead(int readCount)
+    {
+        while (m_source->readCount < readCount)
+            std::this_thread::sleep_for(1ms);
+    }
+
+protected:
+    TestArchiveDelegate* m_source = nullptr;
+    std::unique_ptr<ReadAheadArchiveDelegate> m_delegate;
+};
+
+} // namespace
+
+TEST_F(ReadAheadArchiveDelegateTest, readsAheadWithinBudget)
+{
+    // The read-ahead is stopped after 3 seconds of the video.
+    waitForReadAhead(31);
+    std::this_thread::sleep_for(50ms);
+    ASSERT_EQ(31, m_source->readCount);
+    ASSERT_EQ(31 * kFrameSize, m_delegate->bufferedBytes());
+    ASSERT_EQ(std::vector<qint64>({0, 1'000'000, 2'000'000, 3'000'000}), m_delegate->keyFrames());
+
+    for (int i = 0; i < kFrameCount; ++i)
+        ASSERT_EQ(i * kFrameDuration.count(), nextTimestamp());
+    ASSERT_EQ(-1, nextTimestamp());
+    ASSERT_EQ(0, m_source->seekCount);
+}
+
+TEST_F(ReadAheadArchiveDelegateTest, seeksInsideOfBuffer)
+{
+    QnAbstractMediaDataPtr keyFrame;
+    for (int i = 0; i < 15; ++i)
+    {
+        const auto packet = m_delegate->getNextData();
+        if (i == 10)
+            keyFrame = packet;
+    }
+    keyFrame->flags |= QnAbstractMediaData::MediaFlags_BOF;
+    waitForReadAhead(40);
+
+    // Backwards, to the start of the GOP being read.
+    ASSERT_EQ(1'400'000, m_delegate->seek(1'400'000, /*findIFrame*/ true));
+    const auto packet = m_delegate->getNextData();
+    ASSERT_EQ(1'000'000, packet->timestamp);
+    ASSERT_NE(keyFrame, packet);
+    ASSERT_TRUE(packet->flags.testFlag(QnAbstractMediaData::MediaFlags_AVKey));
+    ASSERT_FALSE(packet->flags.testFlag(QnAbstractMediaData::MediaFlags_BOF));
+    ASSERT_EQ(11 * kFrameDuration.count(), nextTimestamp());
+
+    // Forward, to the GOP read ahead.
+    ASSERT_EQ(3'500'000, m_delegate->seek(3'500'000, /*findIFrame*/ true));
+    ASSERT_EQ(3'000'000, nextTimestamp());
+    ASSERT_EQ(0, m_source->seekCount);
+}
+
+TEST_F(ReadAheadArchiveDelegateTest, seeksOutsideOfBuffer)
+{
+    waitForReadAhead(31);
+    ASSERT_EQ(8'500'000, m_delegate->seek(8'500'000, /*findIFrame*/ true));
+    ASSERT_EQ(1, m_source->seekCount);
+    ASSERT_EQ(8'000'000, nextTimestamp());
+
+    // The exact seek is never served from the buffer.
+    ASSERT_EQ(8'500'000, m_delegate->seek(8'500'000, /*findIFrame*/ false));
+    ASSERT_EQ(2, m_source->seekCount);
+    ASSERT_EQ(8'500'000, nextTimestamp());
+}
+
+} // namespace nx::streaming::test
@@ -0,0 +1,24 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/streaming/stream_restart_scheduler.h>
+
+namespace nx::streaming::test {
+
+using namespace std::chrono_literals;
+
+TEST(StreamRestartScheduler, restartsAreStaggered)
+{
+    StreamRestartScheduler scheduler(50ms);
+    const auto now = StreamRestartScheduler::Clock::now();
+
+    ASSERT_EQ(now, scheduler.reserve(now));
+    ASSERT_EQ(now + 50ms, scheduler.reserve(now));
+    ASSERT_EQ(now + 100ms, scheduler.reserve(now + 10ms));
+
+    // The restart after a pause is not delayed.
+    ASSERT_EQ(now + 1s, scheduler.reserve(now + 1s));
+}
+
+} // namespace nx::streaming::test
@@ -0,0 +1,171 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <nx/network/rest/user_access_data.h>
+#include <nx/utils/thread/mutex.h>
+#include <nx/vms/common/audit/audit_record_queue.h>
+
+namespace nx::vms::common::test {
+
+using namespace std::chrono;
+using nx::vms::api::AuditRecord;
+using nx::vms::api::AuditRecordType;
+
+class AuditRecordQueueTest: public ::testing::Test
+{
+protected:
+    std::unique_ptr<AuditRecordQueue> createQueue(AuditRecordQueue::Settings settings)
+    {
+        return std::make_unique<AuditRecordQueue>(
+            [this](const std::vector<AuditRecord>& records)
+            {
+                NX_MUTEX_LOCKER lock(&m_mutex);
+                if (m_failWrites)
+                    return false;
+
+                m_batches.push_back(records);
+                return true;
+            },
+            std::move(settings));
+    }
+
+    static AuditRecord record(AuditRecordType type = AuditRecordType::notDefined)
+    {
+        return AuditRecord::prepareRecord(
+            type, nx::network::rest::kSystemSession, /*createdTime*/ seconds(1));
+    }
+
+    std::vector<std::vector<AuditRecord>> batches() const
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_batches;
+    }
+
+    void setFailWrites(bool value)
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_failWrites = value;
+    }
+
+private:
+    mutable nx::Mutex m_mutex;
+    std::vector<std::vector<AuditRecord>> m_batches;
+    bool m_failWrites = false;
+};
+
+TEST_F(AuditRecordQueueTest, full_batch_is_written_without_waiting_for_period)
+{
+    auto queue = createQueue({.maxBatchSize = 3, .flushPeriod = hours(1)});
+    for (int i = 0; i < 7; ++i)
+        queue->push(record());
+
+    while (queue->statistics().written < 6)
+        std::this_thread::sleep_for(milliseconds(1));
+
+    // The records queued while a batch is written may be written with it in a smaller batch.
+    for (const auto& batch: batches())
+        ASSERT_GE(3, batch.size());
+    ASSERT_EQ(3, batches()[0].size());
+
+    queue->flush();
+    ASSERT_EQ(7, queue->statistics().written);
+    ASSERT_EQ(0, queue->statistics().backlog);
+}
+
+TEST_F(AuditRecordQueueTest, records_are_written_after_period)
+{
+    auto queue = createQueue({.flushPeriod = milliseconds(10)});
+    queue->push(record());
+
+    while (queue->statistics().written < 1)
+        std::this_thread::sleep_for(milliseconds(1));
+    ASSERT_EQ(1, batches().size());
+}
+
+TEST_F(AuditRecordQueueTest, failed_batch_is_retried)
+{
+    auto queue = createQueue({.flushPeriod = hours(1)});
+    setFailWrites(true);
+    queue->push(record());
+    queue->flush();
+    ASSERT_EQ(1, queue->statistics().failedBatches);
+    ASSERT_EQ(1, queue->statistics().backlog);
+
+    setFailWrites(false);
+    queue->push(record());
+    queue->flush();
+    ASSERT_EQ(1, batches().size());
+    ASSERT_EQ(2, batches()[0].size());
+    ASSERT_EQ(0, queue->statistics().backlog);
+}
+
+TEST_F(AuditRecordQueueTest, overflow_drops_records)
+{
+    auto queue = createQueue({.flushPeriod = hours(1), .maxBacklog = 2});
+    for (int i = 0; i < 5; ++i)
+        queue->push(record());
+
+    ASSERT_EQ(2, queue->statistics().backlog);
+    ASSERT_EQ(3, queue->statistics().dropped);
+    queue->flush();
+    ASSERT_EQ(2, queue->statistics().written);
+}
+
+TEST_F(AuditRecordQueueTest, overflow_writes_through)
+{
+    auto queue = createQueue({
+        .flushPeriod = hours(1),
+        .maxBacklog = 1,
+        .overflowPolicy = AuditRecordQueue::OverflowPolicy::writeThrough});
+    for (int i = 0; i < 3; ++i)
+        queue->push(record());
+
+    ASSERT_EQ(2, batches().size());
+    ASSERT_EQ(2, queue->statistics().writtenThrough);
+    ASSERT_EQ(0, queue->statistics().dropped);
+    ASSERT_EQ(1, queue->statistics().backlog);
+}
+
+TEST_F(AuditRecordQueueTest, playback_progress_is_merged_in_memory)
+{
+    auto queue = createQueue({.flushPeriod = hours(1)});
+    auto playback = record(AuditRecordType::viewArchive);
+    nx::vms::api::PlaybackDetails details;
+    details.startS = seconds(10);
+    details.endS = seconds(10);
+    playback.details = details;
+
+    auto handle = queue->startPlayback(std::move(playback));
+    for (int position = 20; position <= 50; position += 10)
+        queue->updatePlayback(handle, seconds(position));
+    ASSERT_EQ(1, queue->statistics().playbacks);
+    ASSERT_EQ(0, queue->statistics().backlog);
+
+    handle.reset();
+    queue->flush();
+    ASSERT_EQ(0, queue->statistics().playbacks);
+    const auto written = batches();
+    ASSERT_EQ(1, written.size());
+    ASSERT_EQ(1, written[0].size());
+    const auto writtenDetails = written[0][0].get<nx::vms::api::PlaybackDetails>();
+    ASSERT_TRUE(writtenDetails);
+    ASSERT_EQ(seconds(10), writtenDetails->startS);
+    ASSERT_EQ(seconds(50), writtenDetails->endS);
+}
+
+TEST_F(AuditRecordQueueTest, destruction_writes_everything)
+{
+    auto queue = createQueue({.flushPeriod = hours(1)});
+    queue->push(record());
+    const auto handle = queue->startPlayback(record(AuditRecordType::viewLive));
+    queue.reset();
+
+    ASSERT_EQ(1, batches().size());
+    ASSERT_EQ(2, batches()[0].size());
+}
+
+} // namespace nx::vms::common::test
@@ -572,6 +572,58 @@ TEST_F(DistributedFileDownloaderStorageTest, chunkOperations)
     ASSERT_TRUE(testFileMd5 == targetMd5);
 }
 
+TEST_F(DistributedFileDownloaderStorageTest, chunksOutOfOrderWithRestart)
+{
+    createDefaultTestFile();
+
+    const auto targetFileName = testFileName + ".new";
+
+    {
+        FileInformation fileInfo(testFileName);
+        fileInfo.status = FileInformation::Status::downloaded;
+
+        ASSERT_EQ(downloaderStorage->addFile(fileInfo),
+            ResultCode::ok);
+
+        FileInformation targetFileInfo(targetFileName);
+        targetFileInfo.md5 = testFileMd5;
+        targetFileInfo.size = kTestFileSize;
+
+        ASSERT_EQ(downloaderStorage->addFile(targetFileInfo),
+            ResultCode::ok);
+    }
+
+    const int chunkCount = downloaderStorage->fileInformation(testFileName).downloadedChunks.size();
+    ASSERT_GT(chunkCount, 2);
+
+    const auto copyChunk =
+        [this, &targetFileName](Storage* storage, int chunkIndex)
+        {
+            QByteArray buffer;
+            ASSERT_EQ(downloaderStorage->readFileChunk(testFileName, chunkIndex, buffer),
+                ResultCode::ok);
+            ASSERT_EQ(storage->writeFileChunk(targetFileName, chunkIndex, buffer),
+                ResultCode::ok);
+        };
+
+    // The chunks after the gap are hashed once the gap is filled, after the restart.
+    copyChunk(downloaderStorage.data(), 0);
+    for (int i = 2; i < chunkCount; ++i)
+        copyChunk(downloaderStorage.data(), i);
+
+    Storage restartedStorage(workingDirectory);
+    restartedStorage.loadExistingDownloads(true);
+    ASSERT_EQ(restartedStorage.fileInformation(targetFileName).status,
+        FileInformation::Status::downloading);
+
+    copyChunk(&restartedStorage, 1);
+
+    ASSERT_EQ(restartedStorage.fileInformation(targetFileName).status,
+        FileInformation::Status::downloaded);
+    ASSERT_TRUE(testFileMd5 == Storage::calculateMd5(
+        workingDirectory.absoluteFilePath(targetFileName)));
+}
+
 TEST_F(DistributedFileDownloaderStorageTest, readByInvalidChunkIndex)
 {
     createDefaultTestFile();
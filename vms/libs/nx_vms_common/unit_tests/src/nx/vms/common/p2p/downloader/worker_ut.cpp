@@ -233,6 +233,39 @@ TEST_F(DistributedFileDownloaderWorkerTest, simpleDownload)
     ASSERT_EQ(newFileInfo.md5, fileInfo.md5);
 }
 
+TEST_F(DistributedFileDownloaderWorkerTest, downloadFromSeveralPeers)
+{
+    auto fileInfo = createTestFile();
+    NX_ASSERT(defaultPeer->storage->addFile(fileInfo) == ResultCode::ok);
+    fileInfo.downloadedChunks.fill(true);
+    for (int i = 0; i < 3; ++i)
+        addPeerWithFile(fileInfo);
+
+    std::promise<void> readyPromise;
+    QObject::connect(defaultPeer->worker.get(), &Worker::finished,
+        [&readyPromise]() mutable { readyPromise.set_value(); });
+
+    defaultPeer->peerManager->setPeerList(defaultPeer->peerManager->getAllPeers());
+    defaultPeer->worker->start();
+
+    readyPromise.get_future().wait();
+
+    const auto& newFileInfo = defaultPeer->storage->fileInformation(fileInfo.name);
+    ASSERT_TRUE(newFileInfo.isValid());
+    ASSERT_EQ(newFileInfo.md5, fileInfo.md5);
+
+    int downloadedChunks = 0;
+    int usedPeers = 0;
+    for (const auto& peer: defaultPeer->worker->peerStatistics())
+    {
+        downloadedChunks += peer.downloadedChunks;
+        if (peer.downloadedChunks > 0)
+            ++usedPeers;
+    }
+    ASSERT_GE(downloadedChunks, fileInfo.downloadedChunks.size());
+    ASSERT_GT(usedPeers, 1);
+}
+
 TEST_F(DistributedFileDownloaderWorkerTest, chunkDownloadFailedAndRecovered)
 {
     auto fileInfo = createTestFile();
@@ -0,0 +1,58 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/vms/common/system_context.h>
+#include <nx/vms/common/system_settings.h>
+#include <nx/vms/common/system_settings_snapshot.h>
+#include <nx/vms/common/test_support/test_context.h>
+
+namespace nx::vms::common {
+namespace test {
+
+class SystemSettingsSnapshotTest: public ContextBasedTest
+{
+protected:
+    SystemSettings* settings() const { return systemContext()->globalSettings(); }
+};
+
+TEST_F(SystemSettingsSnapshotTest, initialValues)
+{
+    const auto snapshot = settings()->snapshot();
+    ASSERT_TRUE(snapshot);
+    EXPECT_GT(snapshot->version, 0u);
+    EXPECT_EQ(settings()->sessionsLimit(), snapshot->sessionsLimit);
+    EXPECT_EQ(settings()->maxHttpTranscodingSessions(), snapshot->maxHttpTranscodingSessions);
+    EXPECT_EQ(settings()->makeServerHeader(), snapshot->serverHeader);
+    EXPECT_EQ(settings()->frameOptionsHeader(), snapshot->frameOptionsHeader);
+}
+
+TEST_F(SystemSettingsSnapshotTest, republishedOnChange)
+{
+    const auto oldSnapshot = settings()->snapshot();
+
+    std::vector<quint64> versions;
+    QObject::connect(settings(), &SystemSettings::snapshotChanged,
+        [&](quint64 version) { versions.push_back(version); });
+
+    settings()->setSessionsLimit(oldSnapshot->sessionsLimit + 1);
+
+    const auto snapshot = settings()->snapshot();
+    ASSERT_EQ(1u, versions.size());
+    EXPECT_EQ(versions.front(), snapshot->version);
+    EXPECT_GT(snapshot->version, oldSnapshot->version);
+    EXPECT_EQ(oldSnapshot->sessionsLimit + 1, snapshot->sessionsLimit);
+
+    // The snapshot taken before the change is not modified.
+    EXPECT_EQ(settings()->sessionsLimit() - 1, oldSnapshot->sessionsLimit);
+}
+
+TEST_F(SystemSettingsSnapshotTest, notRepublishedOnUnrelatedChange)
+{
+    const auto snapshot = settings()->snapshot();
+    settings()->setAutoDiscoveryEnabled(!settings()->isAutoDiscoveryEnabled());
+    EXPECT_EQ(snapshot, settings()->snapshot());
+}
+
+} // namespace test
+} // namespace nx::vms::common
@@ -0,0 +1,109 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/vms/time/clock_offset_filter.h>
+
+namespace nx::vms::time::test {
+
+using namespace std::chrono;
+
+class ClockOffsetFilterTest: public ::testing::Test
+{
+protected:
+    /**
+     * Polls the remote clock, which is ahead of the local one by the offset, by the burst of the
+     * requests with the round trips given. The delay is asymmetric: the whole round trip is spent
+     * on the way back, so the error of a sample is half of its round trip.
+     */
+    void poll(milliseconds offset, std::vector<milliseconds> rtts)
+    {
+        for (const auto rtt: rtts)
+        {
+            filter.addSample({
+                .localSendTime = now,
+                .remoteTime = now + offset,
+                .localReceiveTime = now + rtt,
+            });
+            now += rtt;
+        }
+        filter.finishPoll();
+        now += 1min;
+    }
+
+    milliseconds estimatedOffset() const { return filter.estimate(now)->offset; }
+
+protected:
+    ClockOffsetFilter filter;
+    milliseconds now = 1h;
+};
+
+TEST_F(ClockOffsetFilterTest, noEstimateBeforePoll)
+{
+    ASSERT_FALSE(filter.estimate(now));
+    filter.addSample({.localSendTime = now, .remoteTime = now, .localReceiveTime = now});
+    ASSERT_FALSE(filter.estimate(now));
+}
+
+TEST_F(ClockOffsetFilterTest, minimalRttSampleIsSelected)
+{
+    poll(1000ms, {400ms, 20ms, 200ms, 100ms});
+    const auto estimate = filter.estimate(now);
+    ASSERT_TRUE(estimate);
+    EXPECT_EQ(20ms, estimate->rtt);
+    EXPECT_EQ(1000ms - 10ms, estimate->offset);
+
+    // The sample of the previous poll is still better.
+    poll(1000ms, {100ms, 60ms});
+    EXPECT_EQ(20ms, filter.estimate(now)->rtt);
+}
+
+TEST_F(ClockOffsetFilterTest, pollingBacksOffWhileStable)
+{
+    const int maxPollBackoff = filter.settings().maxPollBackoff;
+
+    poll(1000ms, {20ms});
+    EXPECT_EQ(1, filter.pollBackoff());
+
+    for (int i = 0; i < 10; ++i)
+        poll(1000ms, {20ms});
+    EXPECT_EQ(maxPollBackoff, filter.pollBackoff());
+
+    // The remote clock is set: the backoff is reset, and the new offset is taken at once though
+    // the older samples have a smaller round trip.
+    poll(5000ms, {40ms});
+    EXPECT_EQ(1, filter.pollBackoff());
+    EXPECT_EQ(5000ms - 20ms, estimatedOffset());
+}
+
+TEST_F(ClockOffsetFilterTest, driftIsExtrapolated)
+{
+    // The local clock is slow by 100 ppm: the offset grows by 6 ms every minute.
+    milliseconds offset = 1000ms;
+    for (int i = 0; i < 20; ++i)
+    {
+        poll(offset, {0ms});
+        offset += 6ms;
+    }
+    EXPECT_NEAR(100e-6, filter.drift(), 10e-6);
+
+    // The offset is extrapolated by the drift between the polls.
+    now += 10min;
+    EXPECT_NEAR(
+        (double) (offset + 60ms).count(), (double) estimatedOffset().count(), 10.0);
+}
+
+TEST_F(ClockOffsetFilterTest, reset)
+{
+    poll(1000ms, {20ms});
+    poll(1000ms, {20ms});
+    ASSERT_EQ(2, filter.pollBackoff());
+
+    filter.reset();
+    EXPECT_FALSE(filter.estimate(now));
+    EXPECT_EQ(1, filter.pollBackoff());
+}
+
+} // namespace nx::vms::time::test
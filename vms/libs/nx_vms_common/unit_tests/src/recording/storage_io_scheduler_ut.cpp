@@ -0,0 +1,135 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/thread/mutex.h>
+#include <recording/storage_io_scheduler.h>
+
+namespace nx::recording::test {
+
+using namespace std::chrono;
+
+class StorageIoSchedulerTest: public ::testing::Test
+{
+protected:
+    virtual void TearDown() override
+    {
+        for (auto& thread: m_threads)
+            thread.join();
+    }
+
+    void init(const StorageIoScheduler::Settings& settings)
+    {
+        m_scheduler = std::make_unique<StorageIoScheduler>(settings);
+    }
+
+    /**
+     * Runs the operation in another thread and waits until it is queued. The operations are
+     * finished in the order they are started, if they run one at a time.
+     */
+    void startInThread(StorageIoClass ioClass)
+    {
+        const int waitingOperations = m_scheduler->statistics(ioClass).waitingOperations;
+        m_threads.emplace_back(
+            [this, ioClass]()
+            {
+                m_scheduler->start(ioClass, /*bytes*/ 100);
+                NX_MUTEX_LOCKER lock(&m_mutex);
+                m_finishedClasses.push_back(ioClass);
+            });
+
+        while (m_scheduler->statistics(ioClass).waitingOperations == waitingOperations)
+            std::this_thread::sleep_for(1ms);
+    }
+
+    std::vector<StorageIoClass> finishedClasses()
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        return m_finishedClasses;
+    }
+
+    void waitForFinished(size_t count)
+    {
+        while (finishedClasses().size() < count)
+            std::this_thread::sleep_for(1ms);
+    }
+
+protected:
+    std::unique_ptr<StorageIoScheduler> m_scheduler;
+
+private:
+    nx::Mutex m_mutex;
+    std::vector<StorageIoClass> m_finishedClasses;
+    std::vector<std::thread> m_threads;
+};
+
+TEST_F(StorageIoSchedulerTest, recordingIsNotStarved)
+{
+    StorageIoScheduler::Settings settings;
+    settings.maxConcurrentOperations = 2;
+    init(settings);
+
+    {
+        const auto playback = m_scheduler->start(StorageIoClass::playback, 100);
+        startInThread(StorageIoClass::playback);
+
+        // The last slot is taken by the recording only.
+        const auto record = m_scheduler->start(StorageIoClass::record, 100);
+        ASSERT_EQ(1, m_scheduler->statistics(StorageIoClass::playback).waitingOperations);
+        ASSERT_EQ(1, m_scheduler->statistics(StorageIoClass::record).runningOperations);
+    }
+
+    waitForFinished(1);
+    const auto statistics = m_scheduler->statistics(StorageIoClass::playback);
+    ASSERT_EQ(2, statistics.operationCount);
+    ASSERT_EQ(200, statistics.bytes);
+}
+
+TEST_F(StorageIoSchedulerTest, overdueOperationIsStartedFirst)
+{
+    StorageIoScheduler::Settings settings;
+    settings.maxConcurrentOperations = 1;
+    settings.classes[(int) StorageIoClass::playback] = {.weight = 100, .latencyTarget = 10s};
+    settings.classes[(int) StorageIoClass::backup] = {.weight = 1, .latencyTarget = 1ms};
+    init(settings);
+
+    {
+        const auto record = m_scheduler->start(StorageIoClass::record, 100);
+        startInThread(StorageIoClass::playback);
+        startInThread(StorageIoClass::backup);
+        std::this_thread::sleep_for(10ms);
+    }
+
+    waitForFinished(2);
+    ASSERT_EQ(
+        std::vector<StorageIoClass>({StorageIoClass::backup, StorageIoClass::playback}),
+        finishedClasses());
+    ASSERT_EQ(1, m_scheduler->statistics(StorageIoClass::backup).latencyTargetMisses);
+}
+
+TEST_F(StorageIoSchedulerTest, weightedClassIsStartedFirst)
+{
+    StorageIoScheduler::Settings settings;
+    settings.maxConcurrentOperations = 1;
+    settings.classes[(int) StorageIoClass::playback] = {.weight = 1, .latencyTarget = 10s};
+    settings.classes[(int) StorageIoClass::archiveExport] = {.weight = 10, .latencyTarget = 10s};
+    init(settings);
+
+    {
+        // The playback has got its bytes already.
+        m_scheduler->start(StorageIoClass::playback, 100);
+        const auto record = m_scheduler->start(StorageIoClass::record, 100);
+        startInThread(StorageIoClass::playback);
+        startInThread(StorageIoClass::archiveExport);
+    }
+
+    waitForFinished(2);
+    ASSERT_EQ(
+        std::vector<StorageIoClass>({StorageIoClass::archiveExport, StorageIoClass::playback}),
+        finishedClasses());
+}
+
+} // namespace nx::recording::test
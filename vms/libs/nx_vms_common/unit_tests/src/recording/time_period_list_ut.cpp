@@ -9,6 +9,7 @@
 #include <nx/utils/elapsed_timer.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/test_support/test_options.h>
+#include <nx/vms/common/recording/encoded_time_periods.h>
 #include <recording/time_period_list.h>
 
 #include <nx/build_info.h>
@@ -286,6 +287,54 @@ TEST( QnTimePeriodsListTest, serializationUnsigned )
     ASSERT_EQ(resultList, sourceList);
 }
 
+TEST( QnTimePeriodsListTest, encodedView )
+{
+    QnTimePeriodList sourceList;
+    sourceList << QnTimePeriod(10, 5) << QnTimePeriod(20, 0x5000) << QnTimePeriod(0x100000, 5)
+        << QnTimePeriod(0x10000000000ll, QnTimePeriod::kInfiniteDuration);
+
+    QByteArray serialized;
+    sourceList.encode(serialized);
+
+    const nx::vms::common::EncodedTimePeriods view(
+        std::string_view(serialized.constData(), serialized.size()));
+    ASSERT_TRUE(view.isValid());
+    QnTimePeriodList viewList;
+    for (const QnTimePeriod& period: view)
+        viewList << period;
+    ASSERT_EQ(sourceList, viewList);
+
+    serialized.chop(1);
+    const nx::vms::common::EncodedTimePeriods truncatedView(
+        std::string_view(serialized.constData(), serialized.size()));
+    ASSERT_FALSE(truncatedView.isValid());
+
+    QnTimePeriodList resultList;
+    ASSERT_FALSE(resultList.decode(serialized));
+}
+
+TEST( QnTimePeriodsListTest, aggregateSpans )
+{
+    std::vector<QnTimePeriodList> lists;
+    lists.push_back(makeTimePeriods(0, 10, 20, 100));
+    lists.push_back(makeTimePeriods(5, 10, 25, 100));
+    lists.push_back(makeTimePeriods(40, 3, 7, 300));
+    lists.push_back({});
+
+    std::vector<std::span<const QnTimePeriod>> spans;
+    for (const auto& list: lists)
+        spans.emplace_back(list.data(), list.size());
+
+    for (const auto detailLevel: {1, 5, 100})
+    {
+        const QnTimePeriodList expected = QnTimePeriodList::aggregateTimePeriodsUnconstrained(
+            QnTimePeriodList::mergeTimePeriods(lists), std::chrono::milliseconds(detailLevel));
+
+        ASSERT_EQ(expected, QnTimePeriodList::aggregateTimePeriods(
+            spans, std::chrono::milliseconds(detailLevel)));
+    }
+}
+
 TEST( QnTimePeriodsListTest, overwriteEmptyListTail )
 {
     QnTimePeriodList sourceList;
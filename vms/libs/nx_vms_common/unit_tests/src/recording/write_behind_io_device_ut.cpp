@@ -0,0 +1,115 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include <nx/utils/test_support/test_with_temporary_directory.h>
+#include <recording/write_behind_io_device.h>
+
+namespace nx::recording::test {
+
+namespace {
+
+static constexpr int kBufferSize = 4096;
+static constexpr int kFileSize = 10 * kBufferSize + 123;
+
+QByteArray makeData(int size, char seed)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        data[i] = (char) (seed + i * 7);
+    return data;
+}
+
+} // namespace
+
+class WriteBehindIoDeviceTest:
+    public ::testing::Test,
+    public nx::utils::test::TestWithTemporaryDirectory
+{
+protected:
+    /**
+     * Writes the file by pieces, then rewrites its header like the muxer does in the trailer.
+     * @return The expected file contents.
+     */
+    QByteArray writeFile(QIODevice* device)
+    {
+        QByteArray expected = makeData(kFileSize, 1);
+        for (int offset = 0; offset < kFileSize; offset += 1000)
+        {
+            const auto piece = expected.mid(offset, 1000);
+            EXPECT_EQ(piece.size(), device->write(piece));
+        }
+        EXPECT_EQ(kFileSize, device->size());
+
+        const QByteArray header = makeData(100, 2);
+        EXPECT_TRUE(device->seek(10));
+        EXPECT_EQ(header.size(), device->write(header));
+        expected.replace(10, header.size(), header);
+        EXPECT_TRUE(device->seek(kFileSize));
+        EXPECT_EQ(kFileSize, device->size());
+        return expected;
+    }
+
+    void writeAndCheckFile(const WriteBehindSettings& settings)
+    {
+        const QString fileName = QDir(testDataDir()).filePath("file.mkv");
+        auto file = std::make_unique<QFile>(fileName);
+        ASSERT_TRUE(file->open(QIODevice::WriteOnly));
+
+        QByteArray expected;
+        {
+            WriteBehindIoDevice device(std::move(file), "storage", settings);
+            expected = writeFile(&device);
+        }
+
+        QFile result(fileName);
+        ASSERT_TRUE(result.open(QIODevice::ReadOnly));
+        ASSERT_EQ(expected, result.readAll());
+    }
+};
+
+TEST_F(WriteBehindIoDeviceTest, writesFile)
+{
+    WriteBehindSettings settings;
+    settings.bufferSize = kBufferSize;
+    settings.maxQueuedBuffers = 2;
+    writeAndCheckFile(settings);
+
+    const auto statistics = WriteBehindIoPool::instance()->statistics().at("storage");
+    ASSERT_EQ(0, statistics.fileCount);
+    ASSERT_EQ(0, statistics.queuedBuffers);
+    ASSERT_EQ(0, statistics.queuedBytes);
+    ASSERT_GE(statistics.writtenBytes, kFileSize);
+    ASSERT_GT(statistics.maxQueuedBuffers, 0);
+    ASSERT_EQ(0, statistics.errorCount);
+}
+
+TEST_F(WriteBehindIoDeviceTest, writesFileWithDirectIo)
+{
+    // Falls back to the buffered writes if the file system does not support the direct I/O.
+    WriteBehindSettings settings;
+    settings.bufferSize = kBufferSize;
+    settings.directIo = true;
+    settings.fsyncPolicy = WriteBehindSettings::FsyncPolicy::always;
+    writeAndCheckFile(settings);
+}
+
+TEST_F(WriteBehindIoDeviceTest, writesQtDevice)
+{
+    QByteArray data;
+    auto buffer = std::make_unique<QBuffer>(&data);
+    ASSERT_TRUE(buffer->open(QIODevice::WriteOnly));
+
+    WriteBehindSettings settings;
+    settings.bufferSize = kBufferSize;
+    WriteBehindIoDevice device(std::move(buffer), "memory", settings);
+    const QByteArray expected = writeFile(&device);
+    ASSERT_TRUE(device.flush());
+    ASSERT_EQ(expected, data);
+}
+
+} // namespace nx::recording::test
@@ -0,0 +1,187 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+#include <nx/media/video_data_packet.h>
+#include <rtsp/rtp_fan_out.h>
+
+namespace nx::vms::server::rtsp::test {
+
+static constexpr int kPayloadSize = 100;
+static constexpr uint32_t kEncoderSsrc = 0x11111111;
+
+/** Splits the frame data to the packets of kPayloadSize bytes. */
+class TestEncoder: public AbstractRtspEncoder
+{
+public:
+    virtual QString getSdpMedia(bool, int, int) override { return QString(); }
+
+    virtual void setDataPacket(QnConstAbstractMediaDataPtr media) override
+    {
+        m_media = media;
+        m_offset = 0;
+    }
+
+    virtual bool getNextPacket(nx::utils::ByteArray& sendBuffer) override
+    {
+        if (!m_media || m_offset >= m_media->dataSize())
+            return false;
+
+        nx::rtp::RtpHeader header{};
+        header.version = nx::rtp::RtpHeader::kVersion;
+        header.payloadType = 96;
+        header.sequence = htons(m_sequence++);
+        header.ssrc = htonl(kEncoderSsrc);
+        sendBuffer.write((const char*) &header, sizeof(header));
+        sendBuffer.write(m_media->data() + m_offset, kPayloadSize);
+        m_offset += kPayloadSize;
+        return true;
+    }
+
+    virtual void init() override {}
+    virtual bool isEof() const override { return false; }
+    virtual void setMtu(int) override {}
+
+private:
+    QnConstAbstractMediaDataPtr m_media;
+    size_t m_offset = 0;
+    uint16_t m_sequence = 0;
+};
+
+QnConstAbstractMediaDataPtr makeFrame(int packets, bool isKeyFrame, char fill = 'x')
+{
+    QnWritableCompressedVideoDataPtr video(new QnWritableCompressedVideoData());
+    video->m_data.writeFiller(fill, packets * kPayloadSize);
+    if (isKeyFrame)
+        video->flags |= QnAbstractMediaData::MediaFlags_AVKey;
+    return video;
+}
+
+class RtpFanOutTest: public ::testing::Test
+{
+protected:
+    std::shared_ptr<RtpFanOut::Subscriber> addSubscriber(
+        uint32_t ssrc, size_t maxQueueBytes = 4 * 1024 * 1024,
+        RtpFanOut::SlowConsumerPolicy policy = RtpFanOut::SlowConsumerPolicy::dropToKeyFrame)
+    {
+        RtpFanOut::SubscriberSettings settings;
+        settings.ssrc = ssrc;
+        settings.initialSequence = (uint16_t) ssrc;
+        settings.maxQueueBytes = maxQueueBytes;
+        settings.policy = policy;
+        return m_fanOut.addSubscriber(settings);
+    }
+
+    int takeAll(RtpFanOut::Subscriber* subscriber)
+    {
+        int count = 0;
+        RtpFanOut::Packet packet;
+        while (subscriber->takeNextPacket(&packet))
+            ++count;
+        return count;
+    }
+
+protected:
+    RtpFanOut m_fanOut{std::make_shared<TestEncoder>()};
+};
+
+TEST_F(RtpFanOutTest, sharedPayload)
+{
+    auto first = addSubscriber(1);
+    auto second = addSubscriber(1000);
+
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 3, /*isKeyFrame*/ true, 'a'));
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 2, /*isKeyFrame*/ false, 'b'));
+    ASSERT_EQ(5U * (nx::rtp::RtpHeader::kSize + kPayloadSize), first->queuedBytes());
+
+    for (int i = 0; i < 5; ++i)
+    {
+        RtpFanOut::Packet firstPacket;
+        RtpFanOut::Packet secondPacket;
+        ASSERT_TRUE(first->takeNextPacket(&firstPacket));
+        ASSERT_TRUE(second->takeNextPacket(&secondPacket));
+
+        const auto firstHeader = (const nx::rtp::RtpHeader*) firstPacket.header.data();
+        const auto secondHeader = (const nx::rtp::RtpHeader*) secondPacket.header.data();
+        ASSERT_EQ(1 + i, firstHeader->getSequence());
+        ASSERT_EQ(1000 + i, secondHeader->getSequence());
+        ASSERT_EQ(1U, ntohl(firstHeader->ssrc));
+        ASSERT_EQ(1000U, ntohl(secondHeader->ssrc));
+        ASSERT_EQ(96, secondHeader->payloadType);
+
+        ASSERT_EQ((size_t) kPayloadSize, firstPacket.payload.size());
+        ASSERT_EQ(i < 3 ? 'a' : 'b', firstPacket.payload[0]);
+        // The payload is not copied per subscriber.
+        ASSERT_EQ(firstPacket.payload.data(), secondPacket.payload.data());
+    }
+    ASSERT_EQ(0U, first->queuedBytes());
+    ASSERT_EQ(0U, second->queuedBytes());
+}
+
+TEST_F(RtpFanOutTest, startFromKeyFrame)
+{
+    auto subscriber = addSubscriber(1);
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 2, /*isKeyFrame*/ false));
+    ASSERT_EQ(0U, subscriber->queuedBytes());
+
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 2, /*isKeyFrame*/ true));
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 1, /*isKeyFrame*/ false));
+    ASSERT_EQ(3, takeAll(subscriber.get()));
+    ASSERT_EQ(0U, subscriber->droppedPackets());
+}
+
+TEST_F(RtpFanOutTest, dropToKeyFrame)
+{
+    static constexpr size_t kPacketSize = nx::rtp::RtpHeader::kSize + kPayloadSize;
+    auto slow = addSubscriber(1, /*maxQueueBytes*/ 4 * kPacketSize);
+    auto fast = addSubscriber(2, /*maxQueueBytes*/ 4 * kPacketSize);
+
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 2, /*isKeyFrame*/ true));
+    ASSERT_EQ(2, takeAll(fast.get()));
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 2, /*isKeyFrame*/ false));
+    ASSERT_EQ(2, takeAll(fast.get()));
+
+    // The queue of the slow subscriber overflows: the queued packets and the frames up to the
+    // next key frame are dropped.
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 1, /*isKeyFrame*/ false));
+    ASSERT_EQ(0U, slow->queuedBytes());
+    ASSERT_EQ(5U, slow->droppedPackets());
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 1, /*isKeyFrame*/ true));
+    ASSERT_EQ(kPacketSize, slow->queuedBytes());
+    ASSERT_FALSE(slow->isOverflowed());
+
+    ASSERT_EQ(2, takeAll(fast.get()));
+    ASSERT_EQ(0U, fast->droppedPackets());
+
+    // The sequence numbers stay continuous for the receiver.
+    RtpFanOut::Packet packet;
+    ASSERT_TRUE(slow->takeNextPacket(&packet));
+    ASSERT_EQ(1, ((const nx::rtp::RtpHeader*) packet.header.data())->getSequence());
+}
+
+TEST_F(RtpFanOutTest, disconnectSlowConsumer)
+{
+    static constexpr size_t kPacketSize = nx::rtp::RtpHeader::kSize + kPayloadSize;
+    auto subscriber = addSubscriber(
+        1, /*maxQueueBytes*/ 2 * kPacketSize, RtpFanOut::SlowConsumerPolicy::disconnect);
+
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 2, /*isKeyFrame*/ true));
+    ASSERT_FALSE(subscriber->isOverflowed());
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 1, /*isKeyFrame*/ true));
+    ASSERT_TRUE(subscriber->isOverflowed());
+    ASSERT_EQ(0, takeAll(subscriber.get()));
+}
+
+TEST_F(RtpFanOutTest, unsubscribe)
+{
+    auto first = addSubscriber(1);
+    auto second = addSubscriber(2);
+    ASSERT_EQ(2U, m_fanOut.subscriberCount());
+
+    second.reset();
+    m_fanOut.pushFrame(makeFrame(/*packets*/ 1, /*isKeyFrame*/ true));
+    ASSERT_EQ(1U, m_fanOut.subscriberCount());
+    ASSERT_EQ(1, takeAll(first.get()));
+}
+
+} // namespace nx::vms::server::rtsp::test
@@ -197,6 +197,42 @@ TEST( TimePeriodCompressedSerializationTest, SerializeCompressedMultiServerPerio
     ASSERT_TRUE( dstData == srcData );
 }
 
+TEST( TimePeriodCompressedSerializationTest, SerializeBlockCompressedMultiServerPeriodDataList)
+{
+    MultiServerPeriodDataList srcData;
+    for (int i = 0; i < 3; ++i)
+    {
+        MultiServerPeriodData data;
+        data.guid = nx::Uuid::createUuid();
+
+        // More than a block of regular chunks with some gaps and overlaps.
+        qint64 currentTime = 1429889084026 + i * 1000;
+        for (int j = 0; j < QnCompressedTime::kBlockSize * 2 + 17; ++j)
+        {
+            const qint64 duration = 60'000 + (j % 7) * 13;
+            data.periods.push_back(QnTimePeriod(currentTime, duration));
+            currentTime += duration + (j % 11 == 0 ? 3'600'000 : 0) - (j % 13 == 0 ? 5 : 0);
+        }
+        data.periods.push_back(QnTimePeriod(currentTime, QnTimePeriod::kInfiniteDuration));
+        srcData.push_back(std::move(data));
+    }
+    srcData.push_back(MultiServerPeriodData());
+
+    const QByteArray buffer = QnCompressedTime::serialized(srcData, true, /*blockFormat*/ true);
+    ASSERT_LT(buffer.size(), QnCompressedTime::serialized(srcData, true).size());
+
+    bool success = false;
+    MultiServerPeriodDataList dstData = QnCompressedTime::deserialized(buffer, MultiServerPeriodDataList(), &success);
+
+    ASSERT_TRUE( success );
+    ASSERT_TRUE( dstData == srcData );
+
+    // Truncated data is not accepted.
+    QnCompressedTime::deserialized(
+        buffer.left(buffer.size() / 2), MultiServerPeriodDataList(), &success);
+    ASSERT_FALSE( success );
+}
+
 class TimePeriodCompressionBenchmark: public ::testing::Test
 {
 protected:
@@ -285,6 +321,31 @@ protected:
         }
     }
 
+    // F must accept `const QByteArray&`
+    template<typename F>
+    [[nodiscard]] Report runDecode(size_t sampleSize, const QByteArray& buffer, F f) const
+    {
+        using std::chrono::milliseconds;
+        using std::chrono::steady_clock;
+
+        std::vector<milliseconds> results{};
+        results.reserve(sampleSize);
+        for (size_t i = 0; i < sampleSize; ++i)
+        {
+            const auto start = steady_clock::now();
+            const auto decoded = f(buffer);
+            results.emplace_back(
+                std::chrono::duration_cast<milliseconds>(steady_clock::now() - start));
+            EXPECT_EQ(periods().size(), decoded.size());
+        }
+
+        std::sort(results.begin(), results.end());
+        return {.sizeBytes = (size_t) buffer.size(),
+            .min = results.front(),
+            .max = results.back(),
+            .median = results[std::midpoint<size_t>(0, results.size())]};
+    }
+
 private:
     enum class Distribution
     {
@@ -499,4 +560,27 @@ TEST_F(TimePeriodCompressionBenchmark, DISABLED_Compare)
     printReports(reports);
 }
 
+TEST_F(TimePeriodCompressionBenchmark, DISABLED_CompareDecode)
+{
+    const size_t sampleSize = 10;
+    const auto decode =
+        [](const QByteArray& buffer)
+        {
+            std::vector<QnTimePeriod> periods;
+            QnCompressedTimeReader<QByteArray> stream(&buffer);
+            QnCompressedTime::deserialize(&stream, &periods);
+            return periods;
+        };
+
+    using namespace std::string_view_literals;
+
+    std::array reports{
+        std::pair{"Legacy"sv, runDecode(sampleSize,
+            QnCompressedTime::serialized(periods(), /*signedFormat*/ false), decode)},
+        std::pair{"Block"sv, runDecode(sampleSize,
+            QnCompressedTime::serialized(periods(), true, /*blockFormat*/ true), decode)}};
+
+    printReports(reports);
+}
+
 } // namespace
@@ -86,3 +86,26 @@ TEST(FFmpegAudioFilter, Test)
     testReadWrite(1, 1, 1);
     testReadWrite(3, 7, 100);
 }
+
+TEST(FFmpegAudioFilter, storageIsReused)
+{
+    FfmpegAudioBuffer buffer;
+    buffer.init({2, AV_SAMPLE_FMT_S16});
+
+    uint8_t* buffers[1] = {};
+    uint64_t capacity = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        // The written chunks vary in size, as the output of a resampler does.
+        const int sampleCount = 1000 + (i % 3) * 24;
+        ASSERT_NE(nullptr, buffer.startWriting(sampleCount));
+        buffer.finishWriting(sampleCount);
+        while (buffer.sampleCount() >= 1024)
+            ASSERT_TRUE(buffer.popData(1024, buffers));
+
+        if (i == 100)
+            capacity = buffer.capacity();
+    }
+    ASSERT_EQ(capacity, buffer.capacity());
+    ASSERT_LE(capacity, 4 * 1048U);
+}
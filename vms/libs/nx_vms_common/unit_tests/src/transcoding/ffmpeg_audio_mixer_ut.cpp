@@ -0,0 +1,115 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+#include <transcoding/ffmpeg_audio_mixer.h>
+
+namespace {
+
+constexpr int kSampleRate = 8000;
+constexpr int kFrameSize = 256;
+
+struct FrameDeleter
+{
+    void operator()(AVFrame* frame) const { av_frame_free(&frame); }
+};
+using FramePtr = std::unique_ptr<AVFrame, FrameDeleter>;
+
+FramePtr makeMonoFrame(AVSampleFormat format, float value, int64_t pts)
+{
+    FramePtr frame(av_frame_alloc());
+    frame->format = format;
+    frame->sample_rate = kSampleRate;
+    frame->nb_samples = kFrameSize;
+    frame->pts = pts;
+    av_channel_layout_default(&frame->ch_layout, 1);
+    if (av_frame_get_buffer(frame.get(), 0) < 0)
+        return nullptr;
+
+    for (int i = 0; i < kFrameSize; ++i)
+    {
+        if (format == AV_SAMPLE_FMT_S16)
+            ((int16_t*) frame->data[0])[i] = (int16_t) (value * 32768);
+        else
+            ((float*) frame->data[0])[i] = value;
+    }
+    return frame;
+}
+
+class FfmpegAudioMixerTest: public ::testing::Test
+{
+protected:
+    FfmpegAudioMixerTest()
+    {
+        FfmpegAudioMixer::Config config;
+        config.sampleRate = kSampleRate;
+        av_channel_layout_default(&config.channelLayout, 1);
+        config.frameSize = kFrameSize;
+        mixer = std::make_unique<FfmpegAudioMixer>(config);
+    }
+
+    void assertMixedFrame(float expectedValue)
+    {
+        AVFrame* frame = mixer->nextFrame();
+        ASSERT_NE(nullptr, frame);
+        ASSERT_EQ(AV_SAMPLE_FMT_FLTP, frame->format);
+        ASSERT_EQ(kFrameSize, frame->nb_samples);
+        for (int i = 0; i < kFrameSize; ++i)
+            ASSERT_NEAR(expectedValue, ((const float*) frame->data[0])[i], 1e-3);
+    }
+
+    std::unique_ptr<FfmpegAudioMixer> mixer;
+};
+
+} // namespace
+
+TEST_F(FfmpegAudioMixerTest, inputsAreMixed)
+{
+    const int first = mixer->addInput();
+    const int second = mixer->addInput();
+
+    ASSERT_TRUE(mixer->pushFrame(first, makeMonoFrame(AV_SAMPLE_FMT_S16, 0.25f, 0).get()));
+    ASSERT_EQ(nullptr, mixer->nextFrame()); //< Waiting for the second input.
+
+    ASSERT_TRUE(mixer->pushFrame(second, makeMonoFrame(AV_SAMPLE_FMT_FLT, 0.5f, 0).get()));
+    assertMixedFrame(0.75f);
+    ASSERT_EQ(nullptr, mixer->nextFrame());
+
+    // The sum is clipped.
+    ASSERT_TRUE(mixer->pushFrame(first, makeMonoFrame(AV_SAMPLE_FMT_S16, 0.75f, 1).get()));
+    ASSERT_TRUE(mixer->pushFrame(second, makeMonoFrame(AV_SAMPLE_FMT_FLT, 0.75f, 1).get()));
+    assertMixedFrame(1.0f);
+}
+
+TEST_F(FfmpegAudioMixerTest, removedInputIsNotWaitedFor)
+{
+    const int first = mixer->addInput();
+    const int second = mixer->addInput();
+
+    ASSERT_TRUE(mixer->pushFrame(first, makeMonoFrame(AV_SAMPLE_FMT_FLT, 0.25f, 0).get()));
+    ASSERT_TRUE(mixer->pushFrame(second, makeMonoFrame(AV_SAMPLE_FMT_FLT, 0.5f, 0).get()));
+    ASSERT_TRUE(mixer->pushFrame(first, makeMonoFrame(AV_SAMPLE_FMT_FLT, 0.25f, 1).get()));
+    mixer->removeInput(second);
+
+    assertMixedFrame(0.75f);
+    assertMixedFrame(0.25f);
+    ASSERT_EQ(nullptr, mixer->nextFrame());
+}
+
+TEST_F(FfmpegAudioMixerTest, inputFormatChanges)
+{
+    const int input = mixer->addInput();
+
+    ASSERT_TRUE(mixer->pushFrame(input, makeMonoFrame(AV_SAMPLE_FMT_S16, 0.5f, 0).get()));
+    assertMixedFrame(0.5f);
+
+    ASSERT_TRUE(mixer->pushFrame(input, makeMonoFrame(AV_SAMPLE_FMT_FLT, -0.5f, 1).get()));
+    assertMixedFrame(-0.5f);
+
+    ASSERT_TRUE(mixer->pushFrame(input, makeMonoFrame(AV_SAMPLE_FMT_S16, 0.25f, 2).get()));
+    assertMixedFrame(0.25f);
+}
@@ -0,0 +1,130 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nx/media/video_data_packet.h>
+#include <transcoding/ffmpeg_muxer.h>
+
+namespace nx::transcoding::test {
+
+using namespace std::chrono;
+
+namespace {
+
+bool containsBox(const nx::Buffer& data, const char* type)
+{
+    return data.find(std::string(type)) != nx::Buffer::npos;
+}
+
+QnWritableCompressedVideoDataPtr makeFrame(microseconds timestamp)
+{
+    QnWritableCompressedVideoDataPtr frame(new QnWritableCompressedVideoData(1024));
+    frame->compressionType = AV_CODEC_ID_MJPEG;
+    frame->timestamp = timestamp.count();
+    frame->flags |= QnAbstractMediaData::MediaFlags_AVKey;
+    const std::vector<char> payload(1000, 0x55);
+    frame->m_data.write(payload.data(), payload.size());
+    return frame;
+}
+
+class FragmentedMuxer
+{
+public:
+    FragmentedMuxer(): m_muxer(FfmpegMuxer::Config{.fragmentDuration = 1s})
+    {
+        m_muxer.setFragmentHandler(
+            [this](FfmpegMuxer::Fragment fragment) { fragments.push_back(std::move(fragment)); });
+    }
+
+    bool open()
+    {
+        if (!m_muxer.setContainer("mp4"))
+            return false;
+
+        AVCodecParameters* parameters = avcodec_parameters_alloc();
+        parameters->codec_type = AVMEDIA_TYPE_VIDEO;
+        parameters->codec_id = AV_CODEC_ID_MJPEG;
+        parameters->width = 640;
+        parameters->height = 480;
+        const bool result = m_muxer.addVideo(parameters) && m_muxer.open();
+        avcodec_parameters_free(&parameters);
+        return result;
+    }
+
+    FfmpegMuxer& muxer() { return m_muxer; }
+
+public:
+    std::vector<FfmpegMuxer::Fragment> fragments;
+
+private:
+    FfmpegMuxer m_muxer;
+};
+
+} // namespace
+
+TEST(FfmpegMuxer, fragmentedMp4)
+{
+    FragmentedMuxer muxer;
+    ASSERT_TRUE(muxer.open());
+    ASSERT_TRUE(muxer.muxer().isFragmented());
+    ASSERT_EQ(1, muxer.fragments.size());
+    ASSERT_TRUE(muxer.fragments[0].isInitSegment);
+    ASSERT_TRUE(containsBox(muxer.fragments[0].data, "ftyp"));
+    ASSERT_TRUE(containsBox(muxer.fragments[0].data, "moov"));
+    ASSERT_EQ(*muxer.muxer().initSegment(), muxer.fragments[0].data);
+
+    // 3.5 seconds of 10 fps video.
+    for (int i = 0; i < 35; ++i)
+        ASSERT_TRUE(muxer.muxer().process(makeFrame(i * 100ms)));
+    ASSERT_EQ(4, muxer.fragments.size());
+    ASSERT_TRUE(muxer.muxer().finalize());
+    ASSERT_EQ(5, muxer.fragments.size());
+
+    microseconds timestamp{0};
+    for (size_t i = 1; i < muxer.fragments.size(); ++i)
+    {
+        const auto& fragment = muxer.fragments[i];
+        ASSERT_FALSE(fragment.isInitSegment);
+        ASSERT_TRUE(fragment.isIndependent);
+        ASSERT_TRUE(containsBox(fragment.data, "moof"));
+        ASSERT_TRUE(containsBox(fragment.data, "mdat"));
+        ASSERT_FALSE(containsBox(fragment.data, "moov"));
+        ASSERT_GT(fragment.timestamp, timestamp - 1us);
+        timestamp = fragment.timestamp + fragment.duration;
+        if (i + 1 < muxer.fragments.size())
+            ASSERT_EQ(1s, fragment.duration);
+    }
+}
+
+TEST(FfmpegMuxer, sharedInitSegment)
+{
+    FragmentedMuxer first;
+    FragmentedMuxer second;
+    ASSERT_TRUE(first.open());
+    ASSERT_TRUE(second.open());
+
+    ASSERT_FALSE(first.muxer().initSegmentKey().empty());
+    ASSERT_EQ(first.muxer().initSegmentKey(), second.muxer().initSegmentKey());
+    ASSERT_EQ(first.muxer().initSegment(), second.muxer().initSegment());
+    ASSERT_EQ(first.muxer().initSegment(),
+        FfmpegMuxer::findInitSegment(first.muxer().initSegmentKey()));
+}
+
+TEST(FfmpegMuxer, fragmentationRequiresMp4)
+{
+    FfmpegMuxer muxer(FfmpegMuxer::Config{.fragmentDuration = 1s});
+    ASSERT_TRUE(muxer.setContainer("matroska"));
+    AVCodecParameters* parameters = avcodec_parameters_alloc();
+    parameters->codec_type = AVMEDIA_TYPE_VIDEO;
+    parameters->codec_id = AV_CODEC_ID_MJPEG;
+    parameters->width = 640;
+    parameters->height = 480;
+    ASSERT_TRUE(muxer.addVideo(parameters));
+    avcodec_parameters_free(&parameters);
+    ASSERT_FALSE(muxer.open());
+}
+
+} // namespace nx::transcoding::test
@@ -239,3 +239,38 @@ TEST(FfmpegVideoTranscoder, FlushBFrames)
     }
     ASSERT_EQ(outFrames, inputFrames);
 }
+
+TEST(FfmpegVideoTranscoder, hardwareEncoderBackends)
+{
+    const auto names =
+        [](const std::vector<nx::transcoding::HwEncoderBackend>& backends)
+        {
+            std::vector<std::string> result;
+            for (const auto& backend: backends)
+                result.push_back(backend.name);
+            return result;
+        };
+
+    ASSERT_TRUE(nx::transcoding::hwEncoderBackends("").empty());
+    ASSERT_EQ(std::vector<std::string>({"nvenc", "vaapi"}),
+        names(nx::transcoding::hwEncoderBackends(" nvenc, unknown ,vaapi")));
+    ASSERT_EQ(std::vector<std::string>({"vaapi", "qsv", "nvenc"}),
+        names(nx::transcoding::hwEncoderBackends("auto")));
+}
+
+TEST(FfmpegVideoTranscoder, hardwareEncoderFallback)
+{
+    // The device of the backend is never available, so the software encoder is used.
+    nx::transcoding::HwEncoderBackend backend;
+    backend.name = "test";
+    backend.deviceType = AV_HWDEVICE_TYPE_NONE;
+    backend.encoders[AV_CODEC_ID_H264] = "h264_nonexistent";
+
+    auto provider = getProvider(QSize(1280, 720));
+    QnFfmpegVideoTranscoder::Config config;
+    config.targetCodecId = AV_CODEC_ID_H264;
+    config.hardwareEncoders = {backend};
+    QnFfmpegVideoTranscoder transcoder(config, nullptr);
+    ASSERT_TRUE(transcoder.open(getVideoData(provider.get())));
+    ASSERT_EQ(transcoder.getOutputResolution(), QSize(1280, 720));
+}
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <nx/media/ffmpeg/video_frame_pool.h>
 #include <transcoding/filters/rotate_image_filter.h>
 
 namespace transcoding::filters::test {
@@ -31,4 +32,46 @@ TEST(RotateImageFilter, values)
     ASSERT_EQ(0, QnRotateImageFilter(370).angle());
 }
 
+TEST(RotateImageFilter, pixels)
+{
+    nx::media::ffmpeg::VideoFramePool pool;
+    for (const QSize& size: {QSize(64, 48), QSize(50, 38)})
+    {
+        CLVideoDecoderOutputPtr frame(new CLVideoDecoderOutput());
+        frame->reallocate(size, AV_PIX_FMT_YUV420P);
+        for (int y = 0; y < size.height(); ++y)
+        {
+            for (int x = 0; x < size.width(); ++x)
+                frame->data[0][y * frame->linesize[0] + x] = (quint8) (x * 7 + y * 13);
+        }
+        frame->pts = 100;
+
+        for (int angle: {90, 180, 270})
+        {
+            for (auto framePool: {(nx::media::ffmpeg::VideoFramePool*) nullptr, &pool})
+            {
+                const auto rotated = rotateImage(frame, angle, framePool);
+                ASSERT_TRUE((bool) rotated);
+                ASSERT_EQ(100, rotated->pts);
+                ASSERT_EQ(angle == 180 ? size : size.transposed(), rotated->size());
+
+                for (int y = 0; y < size.height(); ++y)
+                {
+                    for (int x = 0; x < size.width(); ++x)
+                    {
+                        const QPoint target = angle == 90
+                            ? QPoint(size.height() - 1 - y, x)
+                            : angle == 180
+                                ? QPoint(size.width() - 1 - x, size.height() - 1 - y)
+                                : QPoint(y, size.width() - 1 - x);
+                        ASSERT_EQ(frame->data[0][y * frame->linesize[0] + x],
+                            rotated->data[0][target.y() * rotated->linesize[0] + target.x()])
+                            << angle << " " << x << " " << y;
+                    }
+                }
+            }
+        }
+    }
+}
+
 } // namespace transcoding::filters::test
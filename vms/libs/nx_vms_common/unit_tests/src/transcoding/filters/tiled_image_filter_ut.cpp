@@ -0,0 +1,111 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <core/resource/resource_media_layout.h>
+#include <nx/media/ffmpeg/frame_info.h>
+#include <transcoding/filters/tiled_image_filter.h>
+
+namespace transcoding::filters::test {
+
+namespace {
+
+QnConstResourceVideoLayoutPtr makeLayout(const QSize& size)
+{
+    const auto layout = std::make_shared<QnCustomResourceVideoLayout>(size);
+    for (int i = 0; i < size.width() * size.height(); ++i)
+        layout->setChannel(i, i);
+    return layout;
+}
+
+CLVideoDecoderOutputPtr makeFrame(const QSize& size, int channel, quint8 luma)
+{
+    CLVideoDecoderOutputPtr frame(new CLVideoDecoderOutput());
+    frame->reallocate(size, AV_PIX_FMT_YUV420P);
+    frame->memZero();
+    for (int y = 0; y < size.height(); ++y)
+        memset(frame->data[0] + y * frame->linesize[0], luma, size.width());
+    frame->channel = channel;
+    return frame;
+}
+
+quint8 lumaAt(const CLVideoDecoderOutputPtr& frame, int x, int y)
+{
+    return frame->data[0][y * frame->linesize[0] + x];
+}
+
+} // namespace
+
+TEST(TiledImageFilter, composesTiles)
+{
+    const QSize tileSize(64, 48);
+    QnTiledImageFilter filter(makeLayout(QSize(2, 2)));
+    ASSERT_EQ(QSize(128, 96), filter.updatedResolution(tileSize));
+
+    CLVideoDecoderOutputPtr result;
+    for (int channel = 0; channel < 4; ++channel)
+    {
+        result = filter.updateImage(
+            makeFrame(tileSize, channel, (quint8) (10 * (channel + 1))), /*metadata*/ {});
+        ASSERT_EQ(QSize(128, 96), result->size());
+    }
+
+    for (int channel = 0; channel < 4; ++channel)
+    {
+        const int left = (channel % 2) * tileSize.width();
+        const int top = (channel / 2) * tileSize.height();
+        ASSERT_EQ(10 * (channel + 1), lumaAt(result, left, top));
+        ASSERT_EQ(10 * (channel + 1),
+            lumaAt(result, left + tileSize.width() - 1, top + tileSize.height() - 1));
+    }
+
+    // The output frames are independent of the composite one.
+    memset(result->data[0], 0, result->linesize[0]);
+    const auto next = filter.updateImage(makeFrame(tileSize, 3, 40), /*metadata*/ {});
+    ASSERT_EQ(10, lumaAt(next, 0, 0));
+    ASSERT_GT(next->pts, result->pts);
+}
+
+TEST(TiledImageFilter, scalesOtherResolution)
+{
+    QnTiledImageFilter filter(makeLayout(QSize(2, 1)));
+    filter.updateImage(makeFrame(QSize(64, 48), 0, 50), /*metadata*/ {});
+    const auto result = filter.updateImage(makeFrame(QSize(256, 192), 1, 100), /*metadata*/ {});
+
+    ASSERT_EQ(QSize(128, 48), result->size());
+    ASSERT_EQ(50, lumaAt(result, 63, 47));
+    ASSERT_NEAR(100, lumaAt(result, 64, 0), 1);
+    ASSERT_NEAR(100, lumaAt(result, 127, 47), 1);
+}
+
+/** Measures the rate of the frames of the panoramic camera composed by the filter. */
+TEST(TiledImageFilter, DISABLED_performance)
+{
+    static constexpr int kFrameCount = 100;
+
+    for (const QSize& layoutSize: {QSize(2, 1), QSize(2, 2), QSize(4, 1)})
+    {
+        const QSize tileSize(3840, 2160);
+        const int channelCount = layoutSize.width() * layoutSize.height();
+        std::vector<CLVideoDecoderOutputPtr> frames;
+        for (int channel = 0; channel < channelCount; ++channel)
+            frames.push_back(makeFrame(tileSize, channel, (quint8) channel));
+
+        QnTiledImageFilter filter(makeLayout(layoutSize));
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kFrameCount; ++i)
+            ASSERT_TRUE(filter.updateImage(frames[i % channelCount], /*metadata*/ {}));
+        const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+        std::cout << layoutSize.width() << "x" << layoutSize.height() << " layout of "
+            << tileSize.width() << "x" << tileSize.height() << " channels: "
+            << kFrameCount / duration.count() << " fps" << std::endl;
+    }
+}
+
+} // namespace transcoding::filters::test
@@ -825,3 +825,31 @@ TEST(CLVideoDecoderOutput, ScaleTo8x4)
         QSize(8, 4));
 
 }
+
+TEST(CLVideoDecoderOutput, KeyFrameToScaledImage)
+{
+    nx::utils::ByteArray data(CL_MEDIA_ALIGNMENT, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+    data.write((const char*) kRawH264, sizeof(kRawH264));
+    QnCompressedVideoDataPtr video = std::make_shared<QnWritableCompressedVideoData>();
+    video->setData(std::move(data));
+    video->compressionType = AV_CODEC_ID_H264;
+    video->flags = QnAbstractMediaData::MediaFlags_AVKey;
+    video->timestamp = 1;
+    video->context = QnFfmpegHelper::createVideoCodecParametersAnnexB(video.get());
+
+    QnFfmpegVideoDecoder decoder(DecoderConfig{.keyFramesOnly = true}, nullptr, video);
+    QSharedPointer<CLVideoDecoderOutput> decodedVideoFrame(new CLVideoDecoderOutput());
+    ASSERT_TRUE(
+        decoder.decode(video, &decodedVideoFrame)
+        || decoder.decode(nullptr, &decodedVideoFrame)); //< Need to flush.
+
+    const QSize size = decodedVideoFrame->size() / 2;
+    const QImage image = decodedVideoFrame->toImage(size);
+    ASSERT_EQ(size, image.size());
+    ASSERT_EQ(QImage::Format_RGB32, image.format());
+    ASSERT_TRUE(decodedVideoFrame->toImage(QSize()).isNull());
+
+    // The non-key frames are not decoded at all.
+    video->flags = {};
+    ASSERT_FALSE(decoder.decode(video, &decodedVideoFrame));
+}
@@ -0,0 +1,92 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/media/annexb_to_mp4.h>
+#include <utils/media/parameter_set_cache.h>
+
+namespace nx::media::test {
+
+namespace {
+
+const std::vector<uint8_t> kSps = {
+    0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x29, 0xe3, 0x50, 0x14, 0x07, 0xb6, 0x02, 0xdc,
+    0x04, 0x04, 0x06, 0x90, 0x78, 0x91, 0x15};
+const std::vector<uint8_t> kPps = {0x00, 0x00, 0x00, 0x01, 0x68, 0xce, 0x3c, 0x80};
+const std::vector<uint8_t> kOtherPps = {0x00, 0x00, 0x00, 0x01, 0x68, 0xce, 0x38, 0x80};
+const std::vector<uint8_t> kSlice = {
+    0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x00, 0x00, 0x0c, 0x21, 0x18, 0xa0, 0x00, 0x67,
+    0xf9, 0x39, 0x39, 0x39, 0x39, 0x38, 0x8f, 0xd1, 0x1e, 0xa4, 0xe2, 0x35, 0xe9, 0x38};
+
+QnWritableCompressedVideoDataPtr makeKeyFrame(
+    const std::vector<std::vector<uint8_t>>& nalUnits)
+{
+    QnWritableCompressedVideoDataPtr frame(new QnWritableCompressedVideoData());
+    frame->compressionType = AV_CODEC_ID_H264;
+    frame->flags |= QnAbstractMediaData::MediaFlags_AVKey;
+    for (const auto& nalUnit: nalUnits)
+        frame->m_data.write((const char*) nalUnit.data(), nalUnit.size());
+    return frame;
+}
+
+} // namespace
+
+TEST(ParameterSetCache, rebuildsOnlyOnChange)
+{
+    ParameterSetCache cache;
+    bool changed = false;
+
+    const auto first = cache.update(makeKeyFrame({kSps, kPps, kSlice}).get(), &changed);
+    ASSERT_NE(nullptr, first);
+    ASSERT_TRUE(changed);
+    ASSERT_FALSE(first->extradataMp4.empty());
+    ASSERT_FALSE(first->resolution.isEmpty());
+    const auto codecParameters = first->codecParameters;
+
+    // The camera resends the same parameter sets.
+    const auto second = cache.update(makeKeyFrame({kSps, kPps, kSlice}).get(), &changed);
+    ASSERT_NE(nullptr, second);
+    ASSERT_FALSE(changed);
+    ASSERT_EQ(codecParameters, second->codecParameters);
+
+    const auto third = cache.update(makeKeyFrame({kSps, kOtherPps, kSlice}).get(), &changed);
+    ASSERT_NE(nullptr, third);
+    ASSERT_TRUE(changed);
+    ASSERT_NE(codecParameters, third->codecParameters);
+}
+
+TEST(ParameterSetCache, keepsEntryWithoutParameterSets)
+{
+    ParameterSetCache cache;
+    ASSERT_EQ(nullptr, cache.entry());
+    ASSERT_NE(nullptr, cache.update(makeKeyFrame({kSps, kPps, kSlice}).get()));
+    const auto codecParameters = cache.entry()->codecParameters;
+
+    bool changed = true;
+    ASSERT_EQ(nullptr, cache.update(makeKeyFrame({kSlice}).get(), &changed));
+    ASSERT_FALSE(changed);
+    ASSERT_NE(nullptr, cache.entry());
+    ASSERT_EQ(codecParameters, cache.entry()->codecParameters);
+
+    cache.clear();
+    ASSERT_EQ(nullptr, cache.entry());
+}
+
+TEST(ParameterSetCache, newCodecParamsFlag)
+{
+    AnnexbToMp4 converter;
+    const auto first = converter.process(makeKeyFrame({kSps, kPps, kSlice}).get());
+    const auto second = converter.process(makeKeyFrame({kSps, kPps, kSlice}).get());
+    const auto third = converter.process(makeKeyFrame({kSps, kOtherPps, kSlice}).get());
+    ASSERT_TRUE(first && second && third);
+
+    ASSERT_FALSE(first->flags.testFlag(QnAbstractMediaData::MediaFlags_newCodecParams));
+    ASSERT_FALSE(second->flags.testFlag(QnAbstractMediaData::MediaFlags_newCodecParams));
+    ASSERT_EQ(first->context, second->context);
+    ASSERT_TRUE(third->flags.testFlag(QnAbstractMediaData::MediaFlags_newCodecParams));
+    ASSERT_NE(first->context, third->context);
+}
+
+} // namespace nx::media::test
@@ -41,7 +41,7 @@ int ListHelper::totalLicenseByType(Qn::LicenseType licenseType,
 
     int result = g_fakeLicenseCount[(size_t) licenseType];
 
-    for (const QnLicensePtr& license: m_licenseDict.values())
+    for (const QnLicensePtr& license: m_licenseDict)
     {
         if (license->type() != licenseType)
             continue;
@@ -54,6 +54,22 @@ int ListHelper::totalLicenseByType(Qn::LicenseType licenseType,
     return result;
 }
 
+std::array<int, Qn::LC_Count> ListHelper::totalLicenses(const Validator* validator) const
+{
+    std::array<int, Qn::LC_Count> result = g_fakeLicenseCount;
+
+    for (const QnLicensePtr& license: m_licenseDict)
+    {
+        if (validator && !validator->isValid(license))
+            continue;
+
+        result[(size_t) license->type()] += license->cameraCount();
+    }
+
+    result[Qn::LC_Free] = std::numeric_limits<int>::max();
+    return result;
+}
+
 void ListHelper::update(const QnLicenseList& licenseList)
 {
     m_licenseDict.clear();
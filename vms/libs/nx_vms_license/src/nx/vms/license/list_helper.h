@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <common/common_globals.h>
 #include <nx/vms/license/license_usage_fwd.h>
 
@@ -22,6 +24,12 @@ public:
     /** If validator is passed, only valid licenses are counted. */
     int totalLicenseByType(Qn::LicenseType licenseType, const Validator* validator) const;
 
+    /**
+     * Same as totalLicenseByType() for all the types at once, so each license is validated only
+     * once.
+     */
+    std::array<int, Qn::LC_Count> totalLicenses(const Validator* validator) const;
+
 private:
     QnLicenseDict m_licenseDict;
 };
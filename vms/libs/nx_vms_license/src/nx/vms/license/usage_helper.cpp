@@ -41,6 +41,14 @@ QString joinedString(
     return result.join('\n');
 }
 
+/** Cameras of a group share a single license. */
+QString licenseGroupId(const QnVirtualCameraResourcePtr& camera)
+{
+    return camera->isSharingLicenseInGroup()
+        ? camera->getGroupId()
+        : camera->getId().toSimpleString();
+}
+
 } // namespace
 
 namespace nx::vms::license {
@@ -244,6 +252,12 @@ QString UsageHelper::getRequiredMsg() const
 }
 
 void UsageHelper::invalidate()
+{
+    m_dirty = true;
+    m_resourcesChanged = true;
+}
+
+void UsageHelper::invalidateProposed()
 {
     m_dirty = true;
 }
@@ -255,10 +269,13 @@ void UsageHelper::setCustomValidator(std::unique_ptr<Validator> validator)
 
 void UsageHelper::updateCache() const
 {
-    if (!m_dirty && !m_invalidateTimer.hasExpired(kLicenseRefreshInterval))
+    const bool refreshRequired = m_invalidateTimer.hasExpired(kLicenseRefreshInterval);
+    if (!m_dirty && !refreshRequired)
         return;
     /* Need to set flag right here as virtual methods may call various cache-dependent getters. */
     m_dirty = false;
+    if (refreshRequired)
+        m_resourcesChanged = true;
     m_invalidateTimer.restart();
     m_cache.reset();
 
@@ -276,12 +293,14 @@ void UsageHelper::updateCache() const
     LicensesArray basicBorrowedLicenses;
     std::fill(basicBorrowedLicenses.begin(), basicBorrowedLicenses.end(), 0);
 
-    /* Calculate total licenses. */
+    /* Calculate total licenses, validating each license only once. */
+    const auto totalLicenses = m_cache.licenses.totalLicenses(m_validator.get());
     for (Qn::LicenseType lt : licenseTypes())
-        m_cache.total[lt] = m_cache.licenses.totalLicenseByType(lt, m_validator.get());
+        m_cache.total[lt] = totalLicenses[lt];
 
     /* Calculate used licenses with and without proposed cameras (to get proposed value as difference). */
     calculateUsedLicenses(basicUsedLicenses, m_cache.used);
+    m_resourcesChanged = false;
 
     /* Borrow some licenses (if available). Also repeating with and without proposed cameras. */
     for (const LicenseCompatibility& c : compatibleLicenseType)
@@ -377,12 +396,12 @@ CamLicenseUsageHelper::CamLicenseUsageHelper(
     // Watcher exists only on the client side.
     if (auto watcher = context->deviceLicenseUsageWatcher())
     {
+        // The cache is dropped on each change, but the usage is recalculated only when requested,
+        // which is done by the listeners once for a series of changes.
+        connect(watcher, &nx::vms::common::LicenseUsageWatcher::licenseUsageInvalidated, this,
+            &UsageHelper::invalidate);
         connect(watcher, &nx::vms::common::LicenseUsageWatcher::licenseUsageChanged, this,
-            [this]()
-            {
-                invalidate();
-                emit licenseUsageChanged();
-            });
+            &CamLicenseUsageHelper::licenseUsageChanged);
     }
 }
 
@@ -430,7 +449,7 @@ void CamLicenseUsageHelper::propose(
         m_proposedToDisable.unite(proposedCamerasSet);
         m_proposedToEnable.subtract(proposedCamerasSet);
     }
-    invalidate();
+    invalidateProposed();
 }
 
 bool CamLicenseUsageHelper::isOverflowForCamera(const QnVirtualCameraResourcePtr& camera) const
@@ -472,7 +491,7 @@ bool CamLicenseUsageHelper::canEnableRecording(
         camerasLicenses.insert(camera->licenseType());
         m_proposedToEnable.insert(camera);
     }
-    invalidate();
+    invalidateProposed();
 
     const bool result = std::all_of(allLicenseTypes.cbegin(), allLicenseTypes.cend(),
         [&](Qn::LicenseType licenseType)
@@ -484,7 +503,7 @@ bool CamLicenseUsageHelper::canEnableRecording(
         });
 
     m_proposedToEnable = proposedBackup;
-    invalidate();
+    invalidateProposed();
 
     return result;
 }
@@ -510,45 +529,55 @@ void CamLicenseUsageHelper::calculateUsedLicenses(
     LicensesArray& basicUsedLicenses,
     LicensesArray& proposedToUse) const
 {
-    std::fill(basicUsedLicenses.begin(), basicUsedLicenses.end(), 0);
-    std::fill(proposedToUse.begin(), proposedToUse.end(), 0);
-
-    auto groupId =
-        [](const QnVirtualCameraResourcePtr& camera)
-        {
-            return camera->isSharingLicenseInGroup()
-                ? camera->getGroupId()
-                : camera->getId().toSimpleString();
-        };
-
-    QMap<QString, QSet<QnVirtualCameraResourcePtr>> oldCameras;
-    for (const auto& camera: resourcePool()->getAllCameras(QnResourcePtr(), true))
+    if (resourcesChanged())
     {
-        if (camera->isScheduleEnabled())
+        m_usedCameraGroups.clear();
+        for (const auto& camera: resourcePool()->getAllCameras(QnResourcePtr(), true))
         {
-            if (m_considerOnlineServersOnly)
+            if (camera->isScheduleEnabled())
             {
-                auto server = camera->getParentResource();
-                if (server && server->getStatus() != nx::vms::api::ResourceStatus::online)
-                    continue;
+                if (m_considerOnlineServersOnly)
+                {
+                    auto server = camera->getParentResource();
+                    if (server && server->getStatus() != nx::vms::api::ResourceStatus::online)
+                        continue;
+                }
+                m_usedCameraGroups[licenseGroupId(camera)].insert(camera);
             }
-            oldCameras[groupId(camera)].insert(camera);
         }
+
+        std::fill(m_basicUsedLicenses.begin(), m_basicUsedLicenses.end(), 0);
+        for (const auto& data: m_usedCameraGroups)
+            m_basicUsedLicenses[(*data.begin())->licenseType()]++;
     }
 
-    for (const auto& data : oldCameras)
-        basicUsedLicenses[(*data.begin())->licenseType()]++;
+    basicUsedLicenses = m_basicUsedLicenses;
+    proposedToUse = m_basicUsedLicenses;
 
-    auto newCameras = oldCameras;
+    // Only the groups of the proposed cameras can change their usage.
+    CameraGroups proposedGroups;
     for (const auto& camera: m_proposedToEnable)
-        newCameras[groupId(camera)].insert(camera);
+    {
+        const QString groupId = licenseGroupId(camera);
+        if (!proposedGroups.contains(groupId))
+            proposedGroups.insert(groupId, m_usedCameraGroups.value(groupId));
+        proposedGroups[groupId].insert(camera);
+    }
     for (const auto& camera: m_proposedToDisable)
-        newCameras[groupId(camera)].remove(camera);
+    {
+        const QString groupId = licenseGroupId(camera);
+        if (!proposedGroups.contains(groupId))
+            proposedGroups.insert(groupId, m_usedCameraGroups.value(groupId));
+        proposedGroups[groupId].remove(camera);
+    }
 
-    for (const auto& data: newCameras)
+    for (auto it = proposedGroups.cbegin(); it != proposedGroups.cend(); ++it)
     {
-        if (!data.isEmpty())
-            proposedToUse[(*data.begin())->licenseType()]++;
+        const auto usedGroup = m_usedCameraGroups.constFind(it.key());
+        if (usedGroup != m_usedCameraGroups.cend())
+            proposedToUse[(*usedGroup->begin())->licenseType()]--;
+        if (!it->isEmpty())
+            proposedToUse[(*it->begin())->licenseType()]++;
     }
 }
 
@@ -603,7 +632,7 @@ VideoWallLicenseUsageHelper::VideoWallLicenseUsageHelper(
     // Watcher exists only on the client side.
     if (auto watcher = context->videoWallLicenseUsageWatcher())
     {
-        connect(watcher, &nx::vms::common::LicenseUsageWatcher::licenseUsageChanged, this,
+        connect(watcher, &nx::vms::common::LicenseUsageWatcher::licenseUsageInvalidated, this,
             &UsageHelper::invalidate);
     }
 }
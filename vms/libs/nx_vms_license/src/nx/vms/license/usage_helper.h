@@ -134,11 +134,25 @@ protected:
     virtual QList<Qn::LicenseType> calculateLicenseTypes() const = 0;
 
     void updateCache() const;
+
+    /**
+     * Mark data as invalid when only the proposed changes are modified, so the usage of the
+     * existing resources can be reused by calculateUsedLicenses().
+     */
+    void invalidateProposed();
+
+    /**
+     * Whether the existing resources may have changed since the previous calculateUsedLicenses()
+     * call, so their usage must be recalculated.
+     */
+    bool resourcesChanged() const { return m_resourcesChanged; }
+
 private:
     int borrowLicenses(const LicenseCompatibility& compat, LicensesArray& licenses) const;
 
 private:
     mutable bool m_dirty;
+    mutable bool m_resourcesChanged = true;
     mutable QList<Qn::LicenseType> m_licenseTypes;
 
     struct Cache
@@ -204,9 +218,18 @@ protected:
         LicensesArray& proposedToUse) const override;
 
 private:
+    using CameraGroups = QMap<QString, QSet<QnVirtualCameraResourcePtr>>;
+
     QSet<QnVirtualCameraResourcePtr> m_proposedToEnable;
     QSet<QnVirtualCameraResourcePtr> m_proposedToDisable;
     bool m_considerOnlineServersOnly = false;
+
+    /**
+     * Cameras which use the licenses, grouped by the license they share. Rebuilt only when the
+     * resources change, the proposals are applied to the affected groups only.
+     */
+    mutable CameraGroups m_usedCameraGroups;
+    mutable LicensesArray m_basicUsedLicenses{};
 };
 
 class SingleCamLicenseStatusHelper: public QObject
@@ -12,10 +12,37 @@
 
 namespace nx::vms::license {
 
+namespace {
+
+/**
+ * Limits the age of the cached validation results, so a result which depends on the current time
+ * is recalculated after the sync time is adjusted.
+ */
+static constexpr std::chrono::seconds kMaxCachedResultAge(60);
+
+} // namespace
+
 Validator::Validator(nx::vms::common::SystemContext* context, QObject* parent):
     base_type(parent),
     nx::vms::common::SystemContextAware(context)
 {
+    // The signals may come from any thread, and the cache must be dropped before the next
+    // validation.
+    if (const auto manager = context->runtimeInfoManager())
+    {
+        connect(manager, &QnRuntimeInfoManager::runtimeInfoAdded, this,
+            &Validator::clearCache, Qt::DirectConnection);
+        connect(manager, &QnRuntimeInfoManager::runtimeInfoChanged, this,
+            &Validator::clearCache, Qt::DirectConnection);
+        connect(manager, &QnRuntimeInfoManager::runtimeInfoRemoved, this,
+            &Validator::clearCache, Qt::DirectConnection);
+    }
+
+    if (const auto licensePool = context->licensePool())
+    {
+        connect(licensePool, &QnLicensePool::licensesChanged, this,
+            &Validator::clearCache, Qt::DirectConnection);
+    }
 }
 
 Validator::~Validator()
@@ -34,6 +61,57 @@ bool Validator::overrideMissingRuntimeInfo(const QnLicensePtr&, QnPeerRuntimeInf
 }
 
 QnLicenseErrorCode Validator::validate(const QnLicensePtr& license, ValidationMode mode) const
+{
+    nx::Uuid currentServerId;
+    auto connection = messageBusConnection();
+    if (connection)
+        currentServerId = connection->moduleInformation().id;
+
+    // Licenses which are not in the pool yet are checked in the other modes, so they are not
+    // cached.
+    if (mode != VM_Regular)
+        return validateUncached(license, mode, currentServerId);
+
+    const QPair<QByteArray, QString> key(license->key(), license->hardwareId());
+    const auto now = std::chrono::steady_clock::now();
+    int cacheGeneration = 0;
+    {
+        NX_MUTEX_LOCKER lock(&m_cacheMutex);
+        cacheGeneration = m_cacheGeneration;
+        const auto cached = m_cachedResults.constFind(key);
+        if (cached != m_cachedResults.cend()
+            && cached->currentServerId == currentServerId
+            && now - cached->cachedAt < kMaxCachedResultAge
+            && qnSyncTime->currentMSecsSinceEpoch() <= cached->validUntilMs)
+        {
+            return cached->code;
+        }
+    }
+
+    CachedResult result;
+    result.code = validateUncached(license, mode, currentServerId);
+    result.currentServerId = currentServerId;
+    result.cachedAt = now;
+    result.validUntilMs = std::numeric_limits<qint64>::max();
+    if (result.code == QnLicenseErrorCode::NoError)
+    {
+        if (license->expirationTime() > 0)
+            result.validUntilMs = license->expirationTime();
+
+        const auto date = license->tmpExpirationDate();
+        if (license->type() == Qn::LC_SaasLocalRecording && date.isValid())
+            result.validUntilMs = std::min(result.validUntilMs, date.toMSecsSinceEpoch());
+    }
+
+    // The result may be calculated from the outdated data if the cache was cleared meanwhile.
+    NX_MUTEX_LOCKER lock(&m_cacheMutex);
+    if (cacheGeneration == m_cacheGeneration)
+        m_cachedResults.insert(key, result);
+    return result.code;
+}
+
+QnLicenseErrorCode Validator::validateUncached(
+    const QnLicensePtr& license, ValidationMode mode, const nx::Uuid& currentServerId) const
 {
     /**
      * >= v1.5, should have hwid1, hwid2 or hwid3, and have brand
@@ -43,11 +121,6 @@ QnLicenseErrorCode Validator::validate(const QnLicensePtr& license, ValidationMo
     if (!license->isValidSignature() && mode != VM_CanActivate)
         return QnLicenseErrorCode::InvalidSignature;
 
-    nx::Uuid currentServerId;
-    auto connection = messageBusConnection();
-    if (connection)
-        currentServerId = connection->moduleInformation().id;
-
     const auto& manager = m_context->runtimeInfoManager();
     QnPeerRuntimeInfo info;
 
@@ -141,20 +214,40 @@ QString Validator::errorMessage(QnLicenseErrorCode errCode, Qn::LicenseType lice
 
 nx::Uuid Validator::serverId(const QnLicensePtr& license) const
 {
-    const auto items = m_context->runtimeInfoManager()->items()->getItems();
-    for (const QnPeerRuntimeInfo& info: items)
+    NX_MUTEX_LOCKER lock(&m_cacheMutex);
+    if (!m_serversCached)
     {
-        if (info.data.peer.peerType != vms::api::PeerType::server)
-            continue;
+        // The order of the servers is kept, so the first matching one is found as before.
+        const auto items = m_context->runtimeInfoManager()->items()->getItems();
+        for (const QnPeerRuntimeInfo& info: items)
+        {
+            if (info.data.peer.peerType != vms::api::PeerType::server)
+                continue;
 
-        bool hwKeyOK = info.data.hardwareIds.contains(license->hardwareId());
-        bool brandOK = license->brand().isEmpty() || (license->brand() == info.data.brand);
-        if (hwKeyOK && brandOK)
-            return info.uuid;
+            for (const QString& hardwareId: info.data.hardwareIds)
+                m_serversByHardwareId[hardwareId].push_back({info.uuid, info.data.brand});
+        }
+        m_serversCached = true;
+    }
+
+    const QString brand = license->brand();
+    for (const ServerInfo& server: m_serversByHardwareId.value(license->hardwareId()))
+    {
+        if (brand.isEmpty() || brand == server.brand)
+            return server.id;
     }
     return nx::Uuid();
 }
 
+void Validator::clearCache()
+{
+    NX_MUTEX_LOCKER lock(&m_cacheMutex);
+    m_cachedResults.clear();
+    m_serversByHardwareId.clear();
+    m_serversCached = false;
+    ++m_cacheGeneration;
+}
+
 QnLicenseErrorCode Validator::isValidUniqueLicense(const QnLicensePtr& license,
     ValidationMode mode) const
 {
@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include <chrono>
+
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 
 #include <common/common_globals.h>
 #include <licensing/license_fwd.h>
+#include <nx/utils/thread/mutex.h>
 #include <nx/utils/uuid.h>
 #include <nx/vms/common/system_context_aware.h>
 
@@ -51,7 +55,9 @@ public:
     bool isValid(const QnLicensePtr& license, ValidationMode mode = VM_Regular) const;
 
     /**
-     * Check if signature matches other fields, also check hardwareId and brand
+     * Check if signature matches other fields, also check hardwareId and brand. The results of the
+     * regular validation are cached by the license key and hardware id until the licenses or the
+     * servers change, or the license expires.
      */
     virtual QnLicenseErrorCode validate(
         const QnLicensePtr& license, ValidationMode mode = VM_Regular) const;
@@ -74,6 +80,38 @@ protected:
      */
     QnLicenseErrorCode isValidUniqueLicense(const QnLicensePtr& license,
         ValidationMode mode = VM_Regular) const;
+
+private:
+    struct ServerInfo
+    {
+        nx::Uuid id;
+        QString brand;
+    };
+
+    struct CachedResult
+    {
+        QnLicenseErrorCode code;
+        nx::Uuid currentServerId;
+
+        /** Sync time after which the result can change because of the license expiration. */
+        qint64 validUntilMs = 0;
+
+        std::chrono::steady_clock::time_point cachedAt;
+    };
+
+    QnLicenseErrorCode validateUncached(
+        const QnLicensePtr& license, ValidationMode mode, const nx::Uuid& currentServerId) const;
+    void clearCache();
+
+private:
+    mutable nx::Mutex m_cacheMutex;
+    mutable QHash<QPair<QByteArray, QString>, CachedResult> m_cachedResults;
+
+    /** Servers by their hardware ids, built on demand. */
+    mutable QHash<QString, QList<ServerInfo>> m_serversByHardwareId;
+    mutable bool m_serversCached = false;
+
+    int m_cacheGeneration = 0;
 };
 
 } // namespace nx::vms::license
@@ -277,6 +277,38 @@ TEST_F(QnCamLicenseUsageHelperTest, proposeSingleLicenseType)
     ASSERT_TRUE(m_helper->isValid());
 }
 
+/**
+ *  The usage of the existing cameras is reused when only the proposals change, so the changes of
+ *  the cameras made between the proposals must still be taken into account.
+ */
+TEST_F(QnCamLicenseUsageHelperTest, proposeAfterCamerasChanged)
+{
+    auto encoderCameras = addRecordingCameras(Qn::LC_AnalogEncoder, 2, false);
+    for (const auto& camera: encoderCameras)
+        camera->setGroupId("encoder");
+
+    addLicenses(Qn::LC_AnalogEncoder, 1);
+
+    m_helper->propose(encoderCameras[0], true);
+    ASSERT_EQ(m_helper->usedLicenses(Qn::LC_AnalogEncoder), 1);
+    ASSERT_EQ(m_helper->proposedLicenses(Qn::LC_AnalogEncoder), 1);
+
+    // The group already uses the license, so the proposed camera needs no more licenses.
+    encoderCameras[1]->setScheduleEnabled(true);
+    m_helper->propose(encoderCameras[0], true);
+    ASSERT_EQ(m_helper->usedLicenses(Qn::LC_AnalogEncoder), 1);
+    ASSERT_EQ(m_helper->proposedLicenses(Qn::LC_AnalogEncoder), 0);
+
+    // Disabling the last recording camera of the group releases the license.
+    m_helper->propose(encoderCameras[1], false);
+    ASSERT_EQ(m_helper->usedLicenses(Qn::LC_AnalogEncoder), 1);
+    ASSERT_EQ(m_helper->proposedLicenses(Qn::LC_AnalogEncoder), 0);
+    m_helper->propose(encoderCameras[0], false);
+    ASSERT_EQ(m_helper->usedLicenses(Qn::LC_AnalogEncoder), 0);
+    ASSERT_EQ(m_helper->proposedLicenses(Qn::LC_AnalogEncoder), -1);
+    ASSERT_TRUE(m_helper->isValid());
+}
+
 /** Basic test for single license type proposing with borrowing. */
 TEST_F(QnCamLicenseUsageHelperTest, proposeSingleLicenseTypeWithBorrowing)
 {
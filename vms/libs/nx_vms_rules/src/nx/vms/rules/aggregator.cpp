@@ -46,6 +46,7 @@ bool Aggregator::aggregate(
                 }),
             event);
 
+        ++m_aggregatedEventCount;
         return true;
     }
 
@@ -78,6 +79,7 @@ std::vector<AggregatedEventPtr> Aggregator::popEvents()
                         return e->timestamp() < timestamp;
                     });
                 result.insert(lb, AggregatedEventPtr::create(std::move(aggregationInfo.eventList)));
+                ++m_poppedEventCount;
 
                 // Store the time aggregated event is popped out to conform the logic that
                 // events should be processed not often than once per the installed interval.
@@ -107,4 +109,18 @@ bool Aggregator::empty() const
     return true;
 }
 
+Aggregator::Statistics Aggregator::statistics() const
+{
+    Statistics result{
+        .keyCount = m_aggregatedEvents.size(),
+        .aggregatedEventCount = m_aggregatedEventCount,
+        .poppedEventCount = m_poppedEventCount,
+    };
+
+    for (const auto& [_, aggregationInfo]: m_aggregatedEvents)
+        result.pendingEventCount += aggregationInfo.eventList.size();
+
+    return result;
+}
+
 } // namespace nx::vms::rules
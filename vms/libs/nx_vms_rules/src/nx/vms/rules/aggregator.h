@@ -15,6 +15,23 @@ namespace nx::vms::rules {
 class NX_VMS_RULES_API Aggregator
 {
 public:
+    struct Statistics
+    {
+        size_t keyCount = 0;
+
+        /** Number of the events waiting for the end of their aggregation period. */
+        size_t pendingEventCount = 0;
+
+        /** Total number of the aggregated events. */
+        size_t aggregatedEventCount = 0;
+
+        /**
+         * Total number of the popped aggregated events. The ratio of the aggregated events to
+         * them shows how many events are processed at once.
+         */
+        size_t poppedEventCount = 0;
+    };
+
     explicit Aggregator(std::chrono::microseconds interval);
 
     /** Returns a key the event will be aggregated by. */
@@ -32,6 +49,8 @@ public:
     /** Returns whether the aggregator has aggregated events. */
     bool empty() const;
 
+    Statistics statistics() const;
+
 private:
     struct AggregationData
     {
@@ -43,6 +62,8 @@ private:
 
     std::chrono::microseconds m_interval;
     std::unordered_map<QString, AggregationData> m_aggregatedEvents;
+    size_t m_aggregatedEventCount = 0;
+    size_t m_poppedEventCount = 0;
 };
 
 } // namespace nx::vms::rules
@@ -2,15 +2,18 @@
 
 #include "engine.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <QtCore/QMetaProperty>
 #include <QtCore/QThread>
 
 #include <nx/fusion/serialization/json.h>
+#include <nx/utils/elapsed_timer.h>
 #include <nx/utils/i18n/scoped_locale.h>
 #include <nx/utils/log/log.h>
 #include <nx/utils/qobject.h>
+#include <nx/utils/scope_guard.h>
 #include <nx/vms/api/rules/rule.h>
 #include <nx/vms/common/system_context.h>
 #include <nx/vms/common/utils/schedule.h>
@@ -27,6 +30,7 @@
 #include "event_connector.h"
 #include "event_filter.h"
 #include "event_filter_field.h"
+#include "event_filter_fields/source_camera_field.h"
 #include "group.h"
 #include "manifest.h"
 #include "router.h"
@@ -206,6 +210,9 @@ void Engine::updateRule(const api::Rule& ruleData)
     auto ruleId = rule->id();
     NX_MUTEX_LOCKER lock(&m_ruleMutex);
     auto result = m_rules.insert_or_assign(ruleId, std::move(rule));
+    if (!result.second)
+        removeFromIndexUnsafe(ruleId);
+    addToIndexUnsafe(result.first->second.get());
     lock.unlock();
 
     emit ruleAddedOrUpdated(ruleId, result.second);
@@ -215,6 +222,11 @@ void Engine::removeRule(nx::Uuid ruleId)
 {
     NX_MUTEX_LOCKER lock(&m_ruleMutex);
     const auto erasedCount = m_rules.erase(ruleId);
+    if (erasedCount > 0)
+    {
+        removeFromIndexUnsafe(ruleId);
+        m_ruleStatistics.erase(ruleId);
+    }
     lock.unlock();
 
     if (erasedCount > 0)
@@ -232,6 +244,8 @@ void Engine::resetRules(const std::vector<api::Rule>& rulesData)
 
     NX_MUTEX_LOCKER lock(&m_ruleMutex);
     m_rules = std::move(ruleSet);
+    rebuildIndexUnsafe();
+    m_ruleStatistics.clear();
     lock.unlock();
 
     emit rulesReset();
@@ -830,11 +844,22 @@ size_t Engine::processEvent(const EventPtr& event)
     {
         NX_MUTEX_LOCKER lock(&m_ruleMutex);
 
-        for (const auto& [id, rule]: m_rules)
+        for (const auto& id: candidateRulesUnsafe(event))
         {
+            const auto& rule = m_rules.at(id);
             if (!rule->enabled() || !rule->isCompatible())
                 continue;
 
+            auto& statistics = m_ruleStatistics[id];
+            const nx::utils::BasicElapsedTimer<std::chrono::microseconds> evaluationTimer(
+                nx::utils::ElapsedTimerState::started);
+            const auto updateStatistics = nx::utils::makeScopeGuard(
+                [&statistics, &evaluationTimer]()
+                {
+                    ++statistics.evaluationCount;
+                    statistics.evaluationTime += evaluationTimer.elapsed();
+                });
+
             auto cacheKey = event->cacheKey();
             if (!cacheKey.isEmpty())
             {
@@ -864,6 +889,7 @@ size_t Engine::processEvent(const EventPtr& event)
 
             if (!matchedFilters.empty())
             {
+                ++statistics.triggerCount;
                 triggeredRules.push_back(rule);
                 if (!cacheKey.isEmpty())
                     m_eventCache.reportEvent(cacheKey);
@@ -897,6 +923,15 @@ size_t Engine::processAnalyticsEvents(const std::vector<EventPtr>& events)
     return matchedRules;
 }
 
+Engine::RuleStatistics Engine::ruleStatistics(nx::Uuid ruleId) const
+{
+    NX_MUTEX_LOCKER lock(&m_ruleMutex);
+    if (const auto it = m_ruleStatistics.find(ruleId); it != m_ruleStatistics.end())
+        return it->second;
+
+    return {};
+}
+
 void Engine::onEventReceived(const EventPtr& event, const std::vector<ConstRulePtr>& triggeredRules)
 {
     for (const auto& rule: triggeredRules)
@@ -1089,4 +1124,80 @@ void Engine::stopRunningAction(const ActionPtr& action)
     processAcceptedAction(action); //< TODO: #mmalofeev should it be written to the event log?
 }
 
+
+void Engine::addToIndexUnsafe(const Rule* rule)
+{
+    for (const auto filter: rule->eventFilters())
+    {
+        auto& typeRules = m_rulesByEventType[filter->eventType()];
+
+        // The filter matches the event device id by the field of the same name, so the filters
+        // accepting only the selected devices are candidates for the events from these devices.
+        const auto deviceField =
+            filter->fieldByName<SourceCameraField>(utils::kDeviceIdFieldName);
+        if (!deviceField || deviceField->acceptAll())
+        {
+            typeRules.anyDevice.push_back(rule->id());
+            continue;
+        }
+
+        for (const auto& deviceId: deviceField->ids())
+            typeRules.byDevice[deviceId].push_back(rule->id());
+    }
+}
+
+void Engine::removeFromIndexUnsafe(nx::Uuid ruleId)
+{
+    for (auto typeIt = m_rulesByEventType.begin(); typeIt != m_rulesByEventType.end();)
+    {
+        auto& typeRules = typeIt->second;
+        std::erase(typeRules.anyDevice, ruleId);
+        std::erase_if(typeRules.byDevice,
+            [&ruleId](auto& item)
+            {
+                std::erase(item.second, ruleId);
+                return item.second.empty();
+            });
+
+        if (typeRules.anyDevice.empty() && typeRules.byDevice.empty())
+            typeIt = m_rulesByEventType.erase(typeIt);
+        else
+            ++typeIt;
+    }
+}
+
+void Engine::rebuildIndexUnsafe()
+{
+    m_rulesByEventType.clear();
+    for (const auto& [id, rule]: m_rules)
+        addToIndexUnsafe(rule.get());
+}
+
+std::vector<nx::Uuid> Engine::candidateRulesUnsafe(const EventPtr& event) const
+{
+    const auto typeIt = m_rulesByEventType.find(event->type());
+    if (typeIt == m_rulesByEventType.end())
+        return {};
+
+    const auto& typeRules = typeIt->second;
+    auto result = typeRules.anyDevice;
+
+    if (!typeRules.byDevice.empty())
+    {
+        const auto deviceId = event->property(utils::kDeviceIdFieldName);
+        if (deviceId.isValid())
+        {
+            const auto deviceIt = typeRules.byDevice.find(deviceId.value<nx::Uuid>());
+            if (deviceIt != typeRules.byDevice.end())
+                result.insert(result.end(), deviceIt->second.begin(), deviceIt->second.end());
+        }
+    }
+
+    // The rule with several filters of the same type may be indexed several times.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
 } // namespace nx::vms::rules
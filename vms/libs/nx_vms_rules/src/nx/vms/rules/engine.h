@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -174,6 +176,20 @@ public:
     /** Processes incoming analytics events and returns matched rule count. */
     size_t processAnalyticsEvents(const std::vector<EventPtr>& events);
 
+    /** Statistics of the rule evaluation by the incoming events. */
+    struct RuleStatistics
+    {
+        /** Number of the events the rule has been evaluated for. */
+        size_t evaluationCount = 0;
+
+        /** Number of the events the rule has been triggered by. */
+        size_t triggerCount = 0;
+
+        std::chrono::microseconds evaluationTime{0};
+    };
+
+    RuleStatistics ruleStatistics(nx::Uuid ruleId) const;
+
     RunningEventWatcher runningEventWatcher(nx::Uuid ruleId);
 
     void toggleTimer(nx::utils::TimerEventHandler* handler, bool on);
@@ -244,6 +260,13 @@ private:
     void stopRunningActions(nx::Uuid ruleId);
     void stopRunningAction(const ActionPtr& action);
 
+    void addToIndexUnsafe(const Rule* rule);
+    void removeFromIndexUnsafe(nx::Uuid ruleId);
+    void rebuildIndexUnsafe();
+
+    /** @return Ids of the rules which filters may match the event, without duplicates. */
+    std::vector<nx::Uuid> candidateRulesUnsafe(const EventPtr& event) const;
+
 private:
     nx::Uuid m_id;
     std::unique_ptr<Router> m_router;
@@ -269,6 +292,21 @@ private:
     RuleSet m_rules;
     QSet<nx::utils::TimerEventHandler*> m_timerHandlers;
 
+    /** Ids of the rules having the filters of the same event type. */
+    struct EventTypeRules
+    {
+        /** Rules with the filters which are not scoped to the particular devices. */
+        std::vector<nx::Uuid> anyDevice;
+
+        /** Rules with the filters accepting only the selected devices, by the device id. */
+        std::unordered_map<nx::Uuid, std::vector<nx::Uuid>> byDevice;
+    };
+
+    /** Dispatch index of m_rules, so an event is matched only with the candidate rules. */
+    std::unordered_map<QString, EventTypeRules> m_rulesByEventType;
+
+    std::unordered_map<nx::Uuid, RuleStatistics> m_ruleStatistics;
+
 private: // All the fields below should be used by Engine's thread only.
     QHash<nx::Uuid, RunningRuleInfo> m_runningRules;
 
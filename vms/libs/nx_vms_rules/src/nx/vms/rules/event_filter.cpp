@@ -3,6 +3,7 @@
 #include "event_filter.h"
 
 #include <QtCore/QJsonValue>
+#include <QtCore/QMetaProperty>
 #include <QtCore/QScopedValueRollback>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QVariant>
@@ -70,6 +71,14 @@ void EventFilter::addField(const QString& name, std::unique_ptr<EventFilterField
     }
 
     m_fields[name] = std::move(field);
+
+    m_matchedFields.clear();
+    for (const auto& [fieldName, filterField]: m_fields)
+    {
+        if (fieldName != utils::kStateFieldName)
+            m_matchedFields.push_back({fieldName.toUtf8(), filterField.get()});
+    }
+    m_eventMetaObject = nullptr;
 }
 
 QHash<QString, EventFilterField*> EventFilter::fields() const
@@ -84,12 +93,19 @@ QHash<QString, EventFilterField*> EventFilter::fields() const
 
 bool EventFilter::matchFields(const EventPtr& event) const
 {
-    for (const auto& [name, field]: m_fields)
+    const auto metaObject = event->metaObject();
+    if (metaObject != m_eventMetaObject)
+        updatePropertyIndexes(metaObject);
+
+    for (size_t i = 0; i < m_matchedFields.size(); ++i)
     {
-        if (name == utils::kStateFieldName)
-            continue;
+        const auto& [name, field] = m_matchedFields[i];
+        const auto index = m_propertyIndexes[i];
 
-        const auto& value = event->property(name.toUtf8().data());
+        // Dynamic properties have no index in the class.
+        const auto& value = index >= 0
+            ? metaObject->property(index).read(event.get())
+            : event->property(name.constData());
         NX_VERBOSE(this, "Matching property: %1, valid: %2, null: %3",
             name, value.isValid(), value.isNull());
 
@@ -113,6 +129,15 @@ bool EventFilter::matchState(const EventPtr& event) const
     return true;
 }
 
+void EventFilter::updatePropertyIndexes(const QMetaObject* metaObject) const
+{
+    m_propertyIndexes.clear();
+    for (const auto& matchedField: m_matchedFields)
+        m_propertyIndexes.push_back(metaObject->indexOfProperty(matchedField.propertyName.constData()));
+
+    m_eventMetaObject = metaObject;
+}
+
 void EventFilter::onFieldChanged()
 {
     const auto changedField = sender();
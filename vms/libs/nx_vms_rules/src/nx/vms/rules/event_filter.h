@@ -4,6 +4,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <QtCore/QObject>
 
@@ -39,7 +40,10 @@ public:
 
     QHash<QString, EventFilterField*> fields() const;
 
-    /** Match all event fields excluding state. */
+    /**
+     * Match all event fields excluding state. The event properties are read by their indexes,
+     * which are resolved once per event class.
+     */
     bool matchFields(const EventPtr& event) const;
     /** Match state field only. */
     bool matchState(const EventPtr& event) const;
@@ -120,10 +124,26 @@ private:
         return result;
     }
 
+    /** The field matched with the event property of the same name. */
+    struct MatchedField
+    {
+        QByteArray propertyName;
+        const EventFilterField* field = nullptr;
+    };
+
+    void updatePropertyIndexes(const QMetaObject* metaObject) const;
+
     nx::Uuid m_id;
     QString m_eventType;
     const Rule* m_rule = {};
     std::map<QString, std::unique_ptr<EventFilterField>> m_fields;
+
+    /** All the fields except the state one, in the order of m_fields. */
+    std::vector<MatchedField> m_matchedFields;
+
+    /** Indexes of the m_matchedFields properties in the class of the last matched event. */
+    mutable const QMetaObject* m_eventMetaObject = nullptr;
+    mutable std::vector<int> m_propertyIndexes;
 };
 
 } // namespace nx::vms::rules
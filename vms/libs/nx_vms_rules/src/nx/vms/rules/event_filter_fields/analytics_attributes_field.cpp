@@ -16,8 +16,13 @@ bool AnalyticsAttributesField::match(const QVariant& eventValue) const
     if (attributes.empty())
         return false;
 
-    nx::analytics::db::TextMatcher textMatcher(text);
-    return textMatcher.matchAttributes(attributes);
+    if (!m_matcher || m_matcherText != text)
+    {
+        m_matcher = std::make_shared<nx::analytics::db::TextMatcher>(text);
+        m_matcherText = text;
+    }
+
+    return m_matcher->matchAttributes(attributes);
 }
 
 } // namespace nx::vms::rules
@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include "../base_fields/simple_type_field.h"
 
+namespace nx::analytics::db { class TextMatcher; }
+
 namespace nx::vms::rules {
 
 class NX_VMS_RULES_API AnalyticsAttributesField:
@@ -21,6 +25,11 @@ public:
 
 signals:
     void valueChanged();
+
+private:
+    /** The matcher is parsed once for the value instead of each matched event. */
+    mutable QString m_matcherText;
+    mutable std::shared_ptr<const nx::analytics::db::TextMatcher> m_matcher;
 };
 
 } // namespace nx::vms::rules
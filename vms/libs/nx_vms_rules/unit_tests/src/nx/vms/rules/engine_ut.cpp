@@ -1,6 +1,7 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
 #include <chrono>
+#include <optional>
 #include <thread>
 
 #include <gmock/gmock.h>
@@ -14,6 +15,7 @@
 #include <nx/vms/rules/action_builder_fields/optional_time_field.h>
 #include <nx/vms/rules/engine.h>
 #include <nx/vms/rules/event_filter.h>
+#include <nx/vms/rules/event_filter_fields/source_camera_field.h>
 #include <nx/vms/rules/manifest.h>
 #include <nx/vms/rules/rule.h>
 #include <nx/vms/rules/utils/api.h>
@@ -539,6 +541,59 @@ TEST_F(EngineTest, instantEventsAreNotAddedToRunningEventWatcher)
     EXPECT_FALSE(engine->runningEventWatcher(rule->id()).isRunning(event));
 }
 
+TEST_F(EngineTest, eventIsEvaluatedByCandidateRulesOnly)
+{
+    auto plugin = TestPlugin(engine.get());
+
+    const auto cameraA = nx::Uuid::createUuid();
+    const auto cameraB = nx::Uuid::createUuid();
+
+    const auto addCameraRule =
+        [this](std::optional<nx::Uuid> cameraId)
+        {
+            auto rule = makeRule<TestEventInstant, TestAction>();
+            if (cameraId)
+            {
+                auto cameraField = rule->eventFilters().front()->fieldByType<SourceCameraField>();
+                cameraField->setAcceptAll(false);
+                cameraField->setIds({*cameraId});
+            }
+            engine->updateRule(serialize(rule.get()));
+            return rule->id();
+        };
+
+    const auto anyCameraRuleId = addCameraRule(std::nullopt);
+    const auto cameraARuleId = addCameraRule(cameraA);
+    const auto cameraBRuleId = addCameraRule(cameraB);
+
+    const auto otherEventRule = makeRule<TestEventProlonged, TestAction>();
+    engine->updateRule(serialize(otherEventRule.get()));
+
+    auto event = TestEventInstantPtr::create(std::chrono::microseconds::zero(), State::instant);
+    event->m_deviceId = cameraA;
+    EXPECT_EQ(engine->processEvent(event), 2);
+
+    EXPECT_EQ(engine->ruleStatistics(anyCameraRuleId).evaluationCount, 1);
+    EXPECT_EQ(engine->ruleStatistics(anyCameraRuleId).triggerCount, 1);
+    EXPECT_EQ(engine->ruleStatistics(cameraARuleId).evaluationCount, 1);
+    EXPECT_EQ(engine->ruleStatistics(cameraARuleId).triggerCount, 1);
+    EXPECT_EQ(engine->ruleStatistics(cameraBRuleId).evaluationCount, 0);
+    EXPECT_EQ(engine->ruleStatistics(otherEventRule->id()).evaluationCount, 0);
+
+    // The index follows the rule update.
+    auto cameraBRule = engine->cloneRule(cameraBRuleId);
+    cameraBRule->eventFilters().front()->fieldByType<SourceCameraField>()->setIds({cameraA});
+    engine->updateRule(serialize(cameraBRule.get()));
+    EXPECT_EQ(engine->processEvent(event), 3);
+
+    event->m_deviceId = cameraB;
+    EXPECT_EQ(engine->processEvent(event), 1);
+
+    engine->removeRule(anyCameraRuleId);
+    EXPECT_EQ(engine->processEvent(event), 0);
+    EXPECT_EQ(engine->ruleStatistics(anyCameraRuleId).evaluationCount, 0);
+}
+
 TEST_F(EngineTest, notStartedEventIsNotProcessed)
 {
     engine->registerEvent(TestEvent::manifest(), testEventConstructor);
@@ -61,6 +61,35 @@ TEST_F(EventCacheTest, cacheCleanup)
     EXPECT_FALSE(cache.isReportedBefore("a"));
 }
 
+TEST_F(EventCacheTest, cacheSizeLimit)
+{
+    nx::vms::event::EventCache cache(/*maxSize*/ 3);
+
+    cache.reportEvent("a");
+    cache.rememberEvent("b");
+    cache.reportEvent("c");
+
+    // Not reported events are evicted first.
+    cache.rememberEvent("d");
+    EXPECT_TRUE(cache.isReportedBefore("a"));
+    EXPECT_TRUE(cache.isReportedBefore("c"));
+    EXPECT_EQ(cache.statistics().evictedCount, 1);
+
+    // Then the oldest reported ones.
+    cache.reportEvent("d");
+    cache.reportEvent("a");
+    cache.reportEvent("e");
+    EXPECT_FALSE(cache.isReportedBefore("c"));
+    EXPECT_TRUE(cache.isReportedBefore("a"));
+    EXPECT_TRUE(cache.isReportedBefore("d"));
+    EXPECT_TRUE(cache.isReportedBefore("e"));
+
+    const auto statistics = cache.statistics();
+    EXPECT_EQ(statistics.size, 3);
+    EXPECT_EQ(statistics.reportedCount, 3);
+    EXPECT_EQ(statistics.evictedCount, 2);
+}
+
 TEST_F(EventCacheTest, cacheKey)
 {
     auto rule = makeRule<TestEventInstant, TestAction>();
@@ -0,0 +1,105 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <algorithm>
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include <nx/utils/elapsed_timer.h>
+#include <nx/utils/log/log.h>
+#include <nx/utils/test_support/test_options.h>
+#include <nx/vms/rules/event_filter.h>
+#include <nx/vms/rules/event_filter_fields/analytics_attributes_field.h>
+#include <nx/vms/rules/event_filter_fields/source_camera_field.h>
+#include <nx/vms/rules/event_filter_fields/text_field.h>
+#include <nx/vms/rules/utils/field_names.h>
+#include <nx/vms/rules/utils/type.h>
+
+#include "test_event.h"
+
+namespace nx::vms::rules::test {
+
+using namespace std::chrono;
+
+namespace {
+
+const FieldDescriptor kDummyDescriptor;
+
+} // namespace
+
+class EventFilterTest: public ::testing::Test
+{
+protected:
+    EventFilterTest():
+        m_filter(nx::Uuid::createUuid(), utils::type<TestEvent>())
+    {
+        auto deviceField = std::make_unique<SourceCameraField>(&kDummyDescriptor);
+        deviceField->setIds({m_deviceId});
+        m_filter.addField(utils::kDeviceIdFieldName, std::move(deviceField));
+
+        auto textField = std::make_unique<EventTextField>(&kDummyDescriptor);
+        textField->setValue("Entrance");
+        m_filter.addField(utils::kTextFieldName, std::move(textField));
+
+        auto attributesField = std::make_unique<AnalyticsAttributesField>(&kDummyDescriptor);
+        attributesField->setValue("color:red");
+        m_filter.addField(utils::kAttributesFieldName, std::move(attributesField));
+    }
+
+    TestEventPtr makeEvent(const QString& color) const
+    {
+        auto event = TestEventPtr::create(microseconds::zero(), State::instant);
+        event->m_deviceId = m_deviceId;
+        event->m_text = "Entrance";
+        event->attributes = {{"Color", color}, {"Speed", "40"}};
+        return event;
+    }
+
+protected:
+    const nx::Uuid m_deviceId = nx::Uuid::createUuid();
+    EventFilter m_filter;
+};
+
+TEST_F(EventFilterTest, fieldsAreMatchedWithEventProperties)
+{
+    ASSERT_TRUE(m_filter.matchFields(makeEvent("Red")));
+    ASSERT_FALSE(m_filter.matchFields(makeEvent("Blue")));
+
+    auto event = makeEvent("Red");
+    event->m_deviceId = nx::Uuid::createUuid();
+    ASSERT_FALSE(m_filter.matchFields(event));
+
+    // The event of the other class has no text and attributes properties.
+    auto instantEvent = TestEventInstantPtr::create(microseconds::zero(), State::instant);
+    instantEvent->m_deviceId = m_deviceId;
+    ASSERT_FALSE(m_filter.matchFields(instantEvent));
+    ASSERT_TRUE(m_filter.matchFields(makeEvent("Red")));
+
+    // The attribute condition is parsed again after the change.
+    m_filter.fieldByName<AnalyticsAttributesField>(utils::kAttributesFieldName)
+        ->setValue("color:blue");
+    ASSERT_FALSE(m_filter.matchFields(makeEvent("Red")));
+    ASSERT_TRUE(m_filter.matchFields(makeEvent("Blue")));
+}
+
+TEST_F(EventFilterTest, matchThroughput)
+{
+    const std::vector<EventPtr> events{makeEvent("Red"), makeEvent("Blue"), makeEvent("Green")};
+    const auto count = nx::TestOptions::applyLoadMode<int>(100'000);
+
+    int matchedCount = 0;
+    nx::utils::ElapsedTimer timer(nx::utils::ElapsedTimerState::started);
+    for (int i = 0; i < count; ++i)
+    {
+        if (m_filter.matchFields(events[i % events.size()]))
+            ++matchedCount;
+    }
+
+    const auto elapsed = timer.elapsed();
+    NX_INFO(this, "Matched %1 events in %2, %3 events/s", count, elapsed,
+        count * 1000 / std::max<qint64>(elapsed.count(), 1));
+
+    ASSERT_EQ((count + 2) / 3, matchedCount);
+}
+
+} // namespace nx::vms::rules::test
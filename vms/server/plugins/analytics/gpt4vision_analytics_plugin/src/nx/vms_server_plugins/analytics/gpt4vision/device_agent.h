@@ -4,11 +4,10 @@
 
 #include <nx/sdk/analytics/helpers/consuming_device_agent.h>
 #include <nx/sdk/helpers/uuid_helper.h>
+#include <nx/utils/async_operation_guard.h>
 
 #include "openai_interface.h"
 
-namespace nx::network::http { class AsyncClient; }
-
 namespace nx::vms_server_plugins::analytics::gpt4vision {
 
 using namespace std::chrono_literals;
@@ -37,26 +36,23 @@ protected:
 private:
     const std::string kEventType = "nx.gpt4vision.response";
 
-    open_ai::QueryPayload::Message::Content::ImageUrl encodeImage(
-        nx::sdk::Ptr<const nx::sdk::analytics::IUncompressedVideoFrame> videoFrame,
-        std::string format = "jpg") const;
-
-    void sendVideoFrameToOpenAi(const open_ai::QueryPayload& payload);
-    void handleOpenAiResponse(const open_ai::Response& response);
+    void handleOpenAiResponse(
+        const open_ai::Response& response, std::chrono::microseconds frameTimestamp);
     void showErrorMessage(const std::string& message) const;
 
 private:
     const Engine* const m_engine;
+    const std::string m_deviceId;
 
-    /** Last time when a query was sent. */
+    /** Last time when a query was scheduled. */
     std::chrono::microseconds m_lastQueryTimestamp{0us};
 
-    bool m_queryInProgress = false;
-    std::unique_ptr<nx::network::http::AsyncClient> m_client;
-
     std::string m_queryText;
 
     std::chrono::seconds m_queryPeriod = kDefaultQueryPeriod;
+
+    /** Protects the DeviceAgent from the query handlers called after its destruction. */
+    nx::utils::AsyncOperationGuard m_asyncOperationGuard;
 };
 
 } // namespace nx::vms_server_plugins::analytics::gpt4vision
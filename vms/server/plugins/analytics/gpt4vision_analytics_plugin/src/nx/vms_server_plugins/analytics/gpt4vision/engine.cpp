@@ -11,7 +11,9 @@ using namespace nx::sdk;
 using namespace nx::sdk::analytics;
 
 Engine::Engine():
-    nx::sdk::analytics::Engine(ini().enableOutput)
+    nx::sdk::analytics::Engine(ini().enableOutput),
+    m_requestScheduler(std::make_unique<RequestScheduler>(
+        ini().maxConcurrentRequests, ini().encoderThreadCount, ini().maxImageSize))
 {
 }
 
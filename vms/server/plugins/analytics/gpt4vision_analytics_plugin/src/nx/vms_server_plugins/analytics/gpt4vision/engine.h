@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include <memory>
+
 #include <nx/sdk/analytics/helpers/engine.h>
 #include <nx/sdk/analytics/helpers/integration.h>
 #include <nx/sdk/analytics/i_compressed_video_packet.h>
 
+#include "request_scheduler.h"
+
 namespace nx::vms_server_plugins::analytics::gpt4vision {
 
 class Engine: public nx::sdk::analytics::Engine
@@ -19,6 +23,8 @@ public:
 
     std::string apiKey() const { return m_apiKey; };
 
+    RequestScheduler* requestScheduler() const { return m_requestScheduler.get(); }
+
 protected:
     virtual std::string manifestString() const override;
     virtual nx::sdk::Result<const nx::sdk::ISettingsResponse*> settingsReceived() override;
@@ -30,6 +36,7 @@ protected:
 
 private:
     std::string m_apiKey;
+    const std::unique_ptr<RequestScheduler> m_requestScheduler;
 };
 
 } // namespace nx::vms_server_plugins::analytics::gpt4vision
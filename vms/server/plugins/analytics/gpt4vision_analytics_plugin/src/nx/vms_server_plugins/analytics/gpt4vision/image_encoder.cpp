@@ -0,0 +1,149 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "image_encoder.h"
+
+#include <algorithm>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/imgutils.h>
+#include <libswscale/swscale.h>
+} // extern "C"
+
+#include <QtCore/QByteArray>
+
+#include <nx/utils/log/format.h>
+#include <nx/utils/scope_guard.h>
+
+namespace nx::vms_server_plugins::analytics::gpt4vision {
+
+using namespace nx::sdk::analytics;
+
+namespace {
+
+std::string encoderError(int error, const std::string& format, int width, int height)
+{
+    return NX_FMT("Internal plugin error %1: cannot use %2 to encode image of %3x%4.",
+        error, format, width, height).toStdString();
+}
+
+} // namespace
+
+EncodedImage encodeImage(
+    const IUncompressedVideoFrame* videoFrame,
+    int maxSize,
+    const std::string& format)
+{
+    // TODO: #sivanov Support other frame pixel formats.
+    if (videoFrame->pixelFormat() != IUncompressedVideoFrame::PixelFormat::yuv420)
+    {
+        return {.error = NX_FMT(
+            "Internal plugin error: unexpected frame format %1.",
+            (int) videoFrame->pixelFormat()
+        ).toStdString()};
+    }
+
+    int width = videoFrame->width();
+    int height = videoFrame->height();
+    if (maxSize > 0 && std::max(width, height) > maxSize)
+    {
+        const double scale = (double) maxSize / std::max(width, height);
+        // Even dimensions are required by the chroma subsampling.
+        width = std::max(2, (int) (width * scale) & ~1);
+        height = std::max(2, (int) (height * scale) & ~1);
+    }
+
+    const AVCodec* codec = avcodec_find_encoder_by_name(
+        (format == "jpg" || format == "jpeg") ? "mjpeg" : format.c_str());
+    if (!codec)
+    {
+        return {.error = NX_FMT(
+            "Internal plugin error: codec %1 cannot be found.",
+            format
+        ).toStdString()};
+    }
+
+    AVCodecContext* context = avcodec_alloc_context3(codec);
+    if (!context)
+        return {.error = "Internal plugin error: cannot initialize encoder context."};
+    auto contextGuard = nx::utils::makeScopeGuard([&context]() {avcodec_free_context(&context); });
+
+    context->pix_fmt = AV_PIX_FMT_YUVJ420P;
+    context->width = width;
+    context->height = height;
+    context->bit_rate = width * height;
+    context->time_base.num = 1;
+    context->time_base.den = 30;
+
+    if (int error = avcodec_open2(context, codec, nullptr); error < 0)
+    {
+        return {.error = NX_FMT(
+            "Internal plugin error %1: cannot initialize encoder %2 to encode image of %3x%4.",
+            error,
+            format,
+            width,
+            height
+        ).toStdString()};
+    }
+    auto codecGuard = nx::utils::makeScopeGuard([context]() {avcodec_close(context); });
+
+    AVPacket* packet = av_packet_alloc();
+    if (!packet)
+        return {.error = "Internal plugin error: cannot allocate ffmpeg packet."};
+    auto packetGuard = nx::utils::makeScopeGuard([&packet]() {av_packet_free(&packet); });
+
+    AVFrame* frame = av_frame_alloc();
+    if (!frame)
+        return {.error = "Internal plugin error: cannot allocate video frame."};
+    auto frameGuard = nx::utils::makeScopeGuard([&frame]() {av_frame_free(&frame); });
+    frame->width = width;
+    frame->height = height;
+    frame->format = AV_PIX_FMT_YUVJ420P;
+
+    if (width == videoFrame->width() && height == videoFrame->height())
+    {
+        for (int i = 0; i < videoFrame->planeCount(); ++i)
+        {
+            frame->linesize[i] = videoFrame->lineSize(i);
+            frame->data[i] = (uint8_t*) (videoFrame->data(i));
+        }
+    }
+    else
+    {
+        if (int error = av_frame_get_buffer(frame, /*align*/ 0); error < 0)
+            return {.error = encoderError(error, format, width, height)};
+
+        SwsContext* scaleContext = sws_getContext(
+            videoFrame->width(), videoFrame->height(), AV_PIX_FMT_YUV420P,
+            width, height, AV_PIX_FMT_YUVJ420P,
+            SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!scaleContext)
+            return {.error = "Internal plugin error: cannot initialize image scaler."};
+        auto scaleContextGuard = nx::utils::makeScopeGuard(
+            [scaleContext]() { sws_freeContext(scaleContext); });
+
+        const uint8_t* sourceData[AV_NUM_DATA_POINTERS] = {};
+        int sourceLineSize[AV_NUM_DATA_POINTERS] = {};
+        for (int i = 0; i < videoFrame->planeCount(); ++i)
+        {
+            sourceData[i] = (const uint8_t*) videoFrame->data(i);
+            sourceLineSize[i] = videoFrame->lineSize(i);
+        }
+        sws_scale(scaleContext, sourceData, sourceLineSize, 0, videoFrame->height(),
+            frame->data, frame->linesize);
+    }
+
+    if (int error = avcodec_send_frame(context, frame); error < 0)
+        return {.error = encoderError(error, format, width, height)};
+
+    if (int error = avcodec_receive_packet(context, packet); error < 0)
+        return {.error = encoderError(error, format, width, height)};
+
+    QByteArray buffer;
+    buffer.append((const char*) packet->data, packet->size);
+    std::string imageData = buffer.toBase64().toStdString();
+    av_packet_unref(packet);
+    return {.url = "data:image/" + format + ";base64," + std::move(imageData)};
+}
+
+} // namespace nx::vms_server_plugins::analytics::gpt4vision
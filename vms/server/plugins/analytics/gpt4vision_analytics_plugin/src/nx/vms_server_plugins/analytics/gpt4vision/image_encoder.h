@@ -0,0 +1,29 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <string>
+
+#include <nx/sdk/analytics/i_uncompressed_video_frame.h>
+
+namespace nx::vms_server_plugins::analytics::gpt4vision {
+
+struct EncodedImage
+{
+    /** Data url with the base64-encoded image, empty on error. */
+    std::string url;
+
+    std::string error;
+};
+
+/**
+ * Encodes the frame to be sent in a query. The frame is downscaled, preserving the aspect ratio,
+ * if its width or height exceeds maxSize: the larger images are downscaled by the API anyway, so
+ * sending them only costs bandwidth and encoding time.
+ */
+EncodedImage encodeImage(
+    const nx::sdk::analytics::IUncompressedVideoFrame* videoFrame,
+    int maxSize,
+    const std::string& format = "jpg");
+
+} // namespace nx::vms_server_plugins::analytics::gpt4vision
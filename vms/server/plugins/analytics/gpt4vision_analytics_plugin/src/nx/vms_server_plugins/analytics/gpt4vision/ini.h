@@ -11,6 +11,16 @@ struct Ini: public nx::kit::IniConfig
     Ini(): IniConfig("gpt4vision_analytics_plugin.ini") { reload(); }
 
     NX_INI_FLAG(false, enableOutput, "");
+
+    NX_INI_INT(4, maxConcurrentRequests,
+        "Maximum number of the queries sent simultaneously by an Engine for all its devices.");
+
+    NX_INI_INT(2, encoderThreadCount,
+        "Number of the threads which downscale and encode the frames, per Engine.");
+
+    NX_INI_INT(1024, maxImageSize,
+        "Frames are downscaled to fit this size in both dimensions before being sent. 0 means\n"
+        "the frames are sent in their original resolution.");
 };
 
 Ini& ini();
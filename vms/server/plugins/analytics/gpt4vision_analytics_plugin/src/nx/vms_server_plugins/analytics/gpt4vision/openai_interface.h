@@ -4,6 +4,8 @@
  * This header defines structures used for OpenAI interoperation in the json format.
  */
 
+#pragma once
+
 #include <optional>
 #include <string>
 #include <vector>
@@ -0,0 +1,168 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "request_scheduler.h"
+
+#include <algorithm>
+
+#include <nx/kit/utils.h>
+#include <nx/network/http/buffer_source.h>
+#include <nx/network/http/http_async_client.h>
+#include <nx/network/http/http_types.h>
+#include <nx/reflect/json.h>
+
+#include "image_encoder.h"
+
+namespace nx::vms_server_plugins::analytics::gpt4vision {
+
+namespace {
+
+constexpr auto kOpenAiApiPath = "https://api.openai.com/v1/chat/completions";
+
+} // namespace
+
+RequestScheduler::RequestScheduler(
+    int maxConcurrentRequests, int encoderThreadCount, int maxImageSize)
+    :
+    m_maxConcurrentRequests(std::max(1, maxConcurrentRequests)),
+    m_maxImageSize(maxImageSize)
+{
+    m_encoderThreadPool.setMaxThreadCount(std::max(1, encoderThreadCount));
+}
+
+RequestScheduler::~RequestScheduler()
+{
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        m_terminated = true;
+        m_waitingDevices.clear();
+        m_waitingRequests.clear();
+    }
+
+    // No new clients are created after the encoding is finished.
+    m_encoderThreadPool.waitForDone();
+
+    std::map<int, std::unique_ptr<nx::network::http::AsyncClient>> clients;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        std::swap(clients, m_clients);
+    }
+    for (auto& [id, client]: clients)
+        client->pleaseStopSync();
+}
+
+void RequestScheduler::schedule(Query query, Handler handler)
+{
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (m_terminated)
+        return;
+
+    const std::string deviceId = query.deviceId;
+    auto request = std::make_shared<Request>(Request{std::move(query), std::move(handler)});
+    if (const auto [it, inserted] = m_waitingRequests.emplace(deviceId, request); !inserted)
+    {
+        // The frame has not been sent yet, so the newer one is sent instead.
+        it->second = std::move(request);
+        return;
+    }
+    m_waitingDevices.push_back(deviceId);
+
+    startRequests();
+}
+
+void RequestScheduler::startRequests()
+{
+    for (auto it = m_waitingDevices.begin();
+        it != m_waitingDevices.end() && (int) m_activeDevices.size() < m_maxConcurrentRequests;)
+    {
+        if (m_activeDevices.contains(*it))
+        {
+            ++it;
+            continue;
+        }
+
+        auto request = std::move(m_waitingRequests[*it]);
+        m_waitingRequests.erase(*it);
+        m_activeDevices.insert(*it);
+        it = m_waitingDevices.erase(it);
+
+        m_encoderThreadPool.start(
+            [this, request = std::move(request)]() { encodeAndSend(std::move(request)); });
+    }
+}
+
+void RequestScheduler::encodeAndSend(std::shared_ptr<Request> request)
+{
+    using namespace nx::network::http;
+
+    auto image = encodeImage(request->query.frame.get(), m_maxImageSize);
+    request->query.frame.reset(); //< The frame is not needed anymore, release it early.
+    if (image.url.empty())
+        return complete(std::move(request), std::nullopt, std::move(image.error));
+
+    using ImageUrl = open_ai::QueryPayload::Message::Content::ImageUrl;
+    const open_ai::QueryPayload payload{.messages = {
+        {.content = {
+            {.type = "text", .text = request->query.text},
+            {.type = "image_url", .image_url = ImageUrl{.url = std::move(image.url)}}
+        }}
+    }};
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    if (m_terminated)
+        return;
+
+    const int clientId = ++m_lastClientId;
+    auto& client = m_clients[clientId];
+    client = std::make_unique<AsyncClient>(nx::network::ssl::kDefaultCertificateCheck);
+    client->setOnDone([this, clientId, request]() { onRequestDone(clientId, request); });
+    client->setCredentials(BearerAuthToken{request->query.apiKey});
+    client->setRequestBody(std::make_unique<BufferSource>(
+        header::ContentType::kJson,
+        nx::reflect::json::serialize(payload)));
+    client->setTimeouts(AsyncClient::kInfiniteTimeouts);
+    client->doPost(kOpenAiApiPath);
+}
+
+void RequestScheduler::onRequestDone(int clientId, std::shared_ptr<Request> request)
+{
+    std::unique_ptr<nx::network::http::AsyncClient> client;
+    {
+        NX_MUTEX_LOCKER lock(&m_mutex);
+        const auto it = m_clients.find(clientId);
+        if (it == m_clients.end())
+            return; //< Terminated.
+        client = std::move(it->second);
+        m_clients.erase(it);
+    }
+
+    if (!client->response())
+    {
+        return complete(std::move(request), std::nullopt,
+            "Request cannot be sent: " + SystemError::toString(client->lastSysErrorCode()));
+    }
+
+    const std::string result = client->fetchMessageBodyBuffer().takeStdString();
+    auto [response, success] = nx::reflect::json::deserialize<open_ai::Response>(result);
+    if (!success)
+    {
+        return complete(std::move(request), std::nullopt,
+            "Response cannot be deserialized:\n" + nx::kit::utils::toString(result));
+    }
+
+    complete(std::move(request), std::move(response), /*error*/ {});
+}
+
+void RequestScheduler::complete(
+    std::shared_ptr<Request> request,
+    std::optional<open_ai::Response> response,
+    std::string error)
+{
+    request->handler(std::move(response), std::move(error));
+
+    NX_MUTEX_LOCKER lock(&m_mutex);
+    m_activeDevices.erase(request->query.deviceId);
+    if (!m_terminated)
+        startRequests();
+}
+
+} // namespace nx::vms_server_plugins::analytics::gpt4vision
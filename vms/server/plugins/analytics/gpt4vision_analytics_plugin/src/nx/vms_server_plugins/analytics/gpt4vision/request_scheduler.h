@@ -0,0 +1,84 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+
+#include <QtCore/QThreadPool>
+
+#include <nx/sdk/analytics/i_uncompressed_video_frame.h>
+#include <nx/sdk/ptr.h>
+#include <nx/utils/move_only_func.h>
+#include <nx/utils/thread/mutex.h>
+
+#include "openai_interface.h"
+
+namespace nx::network::http { class AsyncClient; }
+
+namespace nx::vms_server_plugins::analytics::gpt4vision {
+
+/**
+ * Sends the queries of all the DeviceAgents of an Engine, so the number of the simultaneous
+ * requests to the API does not grow with the number of the cameras.
+ * - At most maxConcurrentRequests queries are processed at a time, at most one per device.
+ * - The frames are downscaled and encoded in a worker pool, not in the DeviceAgent thread.
+ * - A device has at most one waiting query: a newer frame replaces the waiting one, the handler
+ *   of the replaced query is never called.
+ */
+class RequestScheduler
+{
+public:
+    struct Query
+    {
+        std::string deviceId;
+        nx::sdk::Ptr<const nx::sdk::analytics::IUncompressedVideoFrame> frame;
+        std::string text;
+        std::string apiKey;
+    };
+
+    /** Called with the error description if the response has not been received. */
+    using Handler = nx::utils::MoveOnlyFunc<void(
+        std::optional<open_ai::Response> response, std::string error)>;
+
+    RequestScheduler(int maxConcurrentRequests, int encoderThreadCount, int maxImageSize);
+    ~RequestScheduler();
+
+    /** The handler is called in an unspecified thread. */
+    void schedule(Query query, Handler handler);
+
+private:
+    struct Request
+    {
+        Query query;
+        Handler handler;
+    };
+
+    void startRequests();
+    void encodeAndSend(std::shared_ptr<Request> request);
+    void onRequestDone(int clientId, std::shared_ptr<Request> request);
+    void complete(
+        std::shared_ptr<Request> request,
+        std::optional<open_ai::Response> response,
+        std::string error);
+
+private:
+    const int m_maxConcurrentRequests;
+    const int m_maxImageSize;
+
+    nx::Mutex m_mutex;
+    bool m_terminated = false;
+    std::deque<std::string> m_waitingDevices;
+    std::map<std::string, std::shared_ptr<Request>> m_waitingRequests;
+    std::set<std::string> m_activeDevices;
+    std::map<int, std::unique_ptr<nx::network::http::AsyncClient>> m_clients;
+    int m_lastClientId = 0;
+
+    QThreadPool m_encoderThreadPool;
+};
+
+} // namespace nx::vms_server_plugins::analytics::gpt4vision
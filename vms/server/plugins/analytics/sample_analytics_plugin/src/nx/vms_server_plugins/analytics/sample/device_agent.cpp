@@ -76,14 +76,6 @@ bool DeviceAgent::pushCompressedVideoFrame(Ptr<const ICompressedVideoPacket> vid
     ++m_frameIndex;
     m_lastVideoFrameTimestampUs = videoFrame->timestampUs();
 
-    // Generate an Event on every kTrackFrameCount'th frame.
-    if (m_frameIndex % kTrackFrameCount == 0)
-    {
-        auto eventMetadataPacket = generateEventMetadataPacket();
-        // Send generated metadata packet to the Server.
-        pushMetadataPacket(eventMetadataPacket);
-    }
-
     return true; //< There were no errors while processing the video frame.
 }
 
@@ -93,12 +85,16 @@ bool DeviceAgent::pushCompressedVideoFrame(Ptr<const ICompressedVideoPacket> vid
  * - pushMetadataPacket() expects one metadata packet, while pullMetadataPacket expects the
  *     std::vector of them.
  *
- * There are no strict rules for deciding which method is "better". A rule of thumb is to use
- * pushMetadataPacket() when you generate one metadata packet and do not want to store it in the
- * class field, and use pullMetadataPackets otherwise.
+ * All the packets produced for a frame are sent to the Server in one call if the Server
+ * supports it, so it is better to return them together than to push them one by one. Outside of
+ * the frame processing, use pushMetadataPackets() for the same purpose.
  */
 bool DeviceAgent::pullMetadataPackets(std::vector<Ptr<IMetadataPacket>>* metadataPackets)
 {
+    // Generate an Event on every kTrackFrameCount'th frame.
+    if (m_frameIndex % kTrackFrameCount == 0)
+        metadataPackets->push_back(generateEventMetadataPacket());
+
     metadataPackets->push_back(generateObjectMetadataPacket());
 
     return true; //< There were no errors while filling metadataPackets.
@@ -0,0 +1,333 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "device_agent.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <nx/kit/json.h>
+#include <nx/kit/utils.h>
+#include <nx/sdk/analytics/helpers/event_metadata.h>
+#include <nx/sdk/analytics/helpers/event_metadata_packet.h>
+#include <nx/sdk/analytics/helpers/object_metadata_packet.h>
+#include <nx/sdk/analytics/helpers/object_track_best_shot_packet.h>
+
+#include "stub_analytics_plugin_load_generator_ini.h"
+
+#undef NX_PRINT_PREFIX
+#define NX_PRINT_PREFIX (this->logUtils.printPrefix)
+#include <nx/kit/debug.h>
+
+namespace nx {
+namespace vms_server_plugins {
+namespace analytics {
+namespace stub {
+namespace load_generator {
+
+using namespace nx::sdk;
+using namespace nx::sdk::analytics;
+using namespace std::chrono;
+using nx::kit::Json;
+
+static constexpr milliseconds kEventGenerationPeriod{100};
+
+static int64_t usSinceEpoch()
+{
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+/** Places the objects on a grid, moving them slightly along the track. */
+static Rect boundingBox(int objectIndex, int objectCount, float trackProgress)
+{
+    const int columnCount = std::max(1, (int) std::ceil(std::sqrt((float) objectCount)));
+    const float cellSize = 1.0F / columnCount;
+
+    Rect result;
+    result.width = cellSize * 0.7F;
+    result.height = cellSize * 0.7F;
+    result.x = cellSize * (objectIndex % columnCount) + cellSize * 0.3F * trackProgress;
+    result.y = cellSize * (objectIndex / columnCount) + cellSize * 0.15F;
+    return result;
+}
+
+DeviceAgent::DeviceAgent(const IDeviceInfo* deviceInfo):
+    ConsumingDeviceAgent(deviceInfo, ini().enableOutput),
+    m_random((unsigned) ini().randomSeed)
+{
+    m_eventThread = std::thread([this]() { eventThreadLoop(); });
+}
+
+DeviceAgent::~DeviceAgent()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_eventThreadMutex);
+        m_terminated = true;
+        m_eventThreadCondition.notify_all();
+    }
+
+    m_eventThread.join();
+}
+
+std::string DeviceAgent::manifestString() const
+{
+    int attributeCount = 0;
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        attributeCount = m_settings.attributesPerObject;
+    }
+
+    Json::array attributes;
+    for (int i = 1; i <= attributeCount; ++i)
+        attributes.push_back(kAttributeNamePrefix + std::to_string(i));
+
+    return Json(Json::object{
+        {"supportedTypes", Json::array{
+            Json::object{{"objectTypeId", kObjectType}, {"attributes", attributes}},
+            Json::object{{"eventTypeId", kEventType}}
+        }}
+    }).dump();
+}
+
+Result<const ISettingsResponse*> DeviceAgent::settingsReceived()
+{
+    const auto intSetting =
+        [this](const std::string& name, int maxValue)
+        {
+            return std::clamp(std::atoi(settingValue(name).c_str()), 0, maxValue);
+        };
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_settings.objectsPerFrame = intSetting(kObjectsPerFrameSetting, 1000);
+        m_settings.trackLengthFrames = std::max(1, intSetting(kTrackLengthSetting, 100000));
+        m_settings.attributesPerObject =
+            intSetting(kAttributesPerObjectSetting, kMaxAttributesPerObject);
+        m_settings.attributeCardinality =
+            std::max(1, intSetting(kAttributeCardinalitySetting, 1000000));
+        m_settings.bestShotImageSizeBytes =
+            intSetting(kBestShotImageSizeSetting, 10 * 1024 * 1024);
+        m_settings.eventsPerSecond = intSetting(kEventsPerSecondSetting, 100000);
+
+        // The image content is not decodable; only its size matters for the benchmark.
+        m_bestShotImage.assign(m_settings.bestShotImageSizeBytes, '\0');
+        for (char& c: m_bestShotImage)
+            c = (char) m_random();
+
+        m_frameIndex = 0;
+        m_tracks.clear();
+    }
+
+    // The supported attributes depend on the settings.
+    pushManifest(manifestString());
+
+    return nullptr;
+}
+
+bool DeviceAgent::pushCompressedVideoFrame(Ptr<const ICompressedVideoPacket> videoFrame)
+{
+    onFrameReceived(videoFrame->timestampUs());
+    pushAndMeasure(generateFrameMetadata(videoFrame->timestampUs()));
+    maybeReportStatistics();
+    return true;
+}
+
+/** Must be called with m_mutex locked. */
+void DeviceAgent::startNewTracks()
+{
+    m_tracks.resize(m_settings.objectsPerFrame);
+    for (Track& track: m_tracks)
+    {
+        track.trackId = UuidHelper::randomUuid();
+        track.attributes.clear();
+        for (int i = 1; i <= m_settings.attributesPerObject; ++i)
+        {
+            const int valueIndex = std::uniform_int_distribution<int>(
+                0, m_settings.attributeCardinality - 1)(m_random);
+            track.attributes.push_back(makePtr<Attribute>(
+                kAttributeNamePrefix + std::to_string(i), "Value " + std::to_string(valueIndex)));
+        }
+    }
+}
+
+std::vector<Ptr<IMetadataPacket>> DeviceAgent::generateFrameMetadata(int64_t frameTimestampUs)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    const int frameInTrack = m_frameIndex % m_settings.trackLengthFrames;
+    if (frameInTrack == 0)
+        startNewTracks();
+    ++m_frameIndex;
+
+    if (m_tracks.empty())
+        return {};
+
+    std::vector<Ptr<IMetadataPacket>> result;
+    const float trackProgress = (float) frameInTrack / m_settings.trackLengthFrames;
+
+    auto objectMetadataPacket = makePtr<ObjectMetadataPacket>();
+    objectMetadataPacket->setTimestampUs(frameTimestampUs);
+    for (int i = 0; i < (int) m_tracks.size(); ++i)
+    {
+        auto objectMetadata = makePtr<ObjectMetadata>();
+        objectMetadata->setTypeId(kObjectType);
+        objectMetadata->setTrackId(m_tracks[i].trackId);
+        objectMetadata->setBoundingBox(boundingBox(i, (int) m_tracks.size(), trackProgress));
+        objectMetadata->addAttributes(m_tracks[i].attributes);
+        objectMetadataPacket->addItem(objectMetadata);
+    }
+    result.push_back(objectMetadataPacket);
+
+    // The best shot of each track is generated at the last frame of the track.
+    const bool isLastFrameOfTrack = frameInTrack == m_settings.trackLengthFrames - 1;
+    if (isLastFrameOfTrack && !m_bestShotImage.empty())
+    {
+        for (int i = 0; i < (int) m_tracks.size(); ++i)
+        {
+            auto bestShotPacket = makePtr<ObjectTrackBestShotPacket>(
+                m_tracks[i].trackId,
+                frameTimestampUs,
+                boundingBox(i, (int) m_tracks.size(), trackProgress));
+            bestShotPacket->setImage("image/jpeg", m_bestShotImage);
+            result.push_back(bestShotPacket);
+        }
+    }
+
+    const std::lock_guard<std::mutex> statisticsLock(m_statisticsMutex);
+    m_statistics.objectCount += (int64_t) m_tracks.size();
+    if (isLastFrameOfTrack && !m_bestShotImage.empty())
+    {
+        m_statistics.bestShotCount += (int64_t) m_tracks.size();
+        m_statistics.bestShotBytes += (int64_t) (m_tracks.size() * m_bestShotImage.size());
+    }
+
+    return result;
+}
+
+Ptr<IMetadataPacket> DeviceAgent::generateEvents(int eventCount, int64_t timestampUs)
+{
+    auto eventMetadataPacket = makePtr<EventMetadataPacket>();
+    eventMetadataPacket->setTimestampUs(timestampUs);
+    eventMetadataPacket->setDurationUs(0);
+
+    for (int i = 0; i < eventCount; ++i)
+    {
+        auto eventMetadata = makePtr<EventMetadata>();
+        eventMetadata->setTypeId(kEventType);
+        eventMetadata->setCaption("Load generator event");
+        eventMetadata->setDescription("Load generator event " + std::to_string(i));
+        eventMetadata->setIsActive(true);
+        eventMetadataPacket->addItem(eventMetadata);
+    }
+
+    return eventMetadataPacket;
+}
+
+void DeviceAgent::pushAndMeasure(const std::vector<Ptr<IMetadataPacket>>& metadataPackets)
+{
+    if (metadataPackets.empty())
+        return;
+
+    const auto start = steady_clock::now();
+    pushMetadataPackets(metadataPackets);
+    const auto pushTime = duration_cast<microseconds>(steady_clock::now() - start);
+
+    const std::lock_guard<std::mutex> lock(m_statisticsMutex);
+    ++m_statistics.pushCount;
+    m_statistics.pushTimeSum += pushTime;
+    m_statistics.pushTimeMax = std::max(m_statistics.pushTimeMax, pushTime);
+}
+
+void DeviceAgent::onFrameReceived(int64_t frameTimestampUs)
+{
+    const microseconds frameLag(std::max<int64_t>(0, usSinceEpoch() - frameTimestampUs));
+
+    const std::lock_guard<std::mutex> lock(m_statisticsMutex);
+    ++m_statistics.frameCount;
+    m_statistics.frameLagSum += frameLag;
+    m_statistics.frameLagMax = std::max(m_statistics.frameLagMax, frameLag);
+}
+
+void DeviceAgent::maybeReportStatistics()
+{
+    Statistics statistics;
+    {
+        const std::lock_guard<std::mutex> lock(m_statisticsMutex);
+        if (steady_clock::now() - m_statistics.periodStart < seconds(ini().statisticsPeriodS))
+            return;
+
+        statistics = m_statistics;
+        m_statistics = Statistics();
+    }
+
+    const double periodS =
+        duration<double>(steady_clock::now() - statistics.periodStart).count();
+    const auto averageMs =
+        [](microseconds sum, int64_t count)
+        {
+            return count > 0 ? sum.count() / 1000.0 / count : 0.0;
+        };
+
+    const std::string description = nx::kit::utils::format(
+        "objects/s: %.1f, best shots/s: %.1f (%.1f KB/s), events/s: %.1f; "
+        "frame lag: avg %.1f ms, max %.1f ms; push time: avg %.2f ms, max %.2f ms",
+        statistics.objectCount / periodS,
+        statistics.bestShotCount / periodS,
+        statistics.bestShotBytes / 1024.0 / periodS,
+        statistics.eventCount / periodS,
+        averageMs(statistics.frameLagSum, statistics.frameCount),
+        statistics.frameLagMax.count() / 1000.0,
+        averageMs(statistics.pushTimeSum, statistics.pushCount),
+        statistics.pushTimeMax.count() / 1000.0);
+
+    NX_PRINT << "Load statistics: " << description;
+    pushIntegrationDiagnosticEvent(
+        IIntegrationDiagnosticEvent::Level::info, "Load generator statistics", description);
+}
+
+void DeviceAgent::eventThreadLoop()
+{
+    // Events are generated in batches each period; the fractional part is carried over, so that
+    // the average rate matches the setting.
+    double pendingEventCount = 0;
+    auto lastGenerationTime = steady_clock::now();
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_eventThreadMutex);
+            m_eventThreadCondition.wait_for(lock, kEventGenerationPeriod,
+                [this]() { return m_terminated; });
+            if (m_terminated)
+                break;
+        }
+
+        int eventsPerSecond = 0;
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            eventsPerSecond = m_settings.eventsPerSecond;
+        }
+
+        const auto now = steady_clock::now();
+        pendingEventCount += eventsPerSecond * duration<double>(now - lastGenerationTime).count();
+        lastGenerationTime = now;
+
+        const int eventCount = (int) pendingEventCount;
+        if (eventCount == 0)
+            continue;
+        pendingEventCount -= eventCount;
+
+        pushAndMeasure({generateEvents(eventCount, usSinceEpoch())});
+        {
+            const std::lock_guard<std::mutex> lock(m_statisticsMutex);
+            m_statistics.eventCount += eventCount;
+        }
+        maybeReportStatistics();
+    }
+}
+
+} // namespace load_generator
+} // namespace stub
+} // namespace analytics
+} // namespace vms_server_plugins
+} // namespace nx
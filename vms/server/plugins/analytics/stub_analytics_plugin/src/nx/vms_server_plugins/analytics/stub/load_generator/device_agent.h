@@ -0,0 +1,134 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nx/sdk/analytics/helpers/consuming_device_agent.h>
+#include <nx/sdk/analytics/helpers/object_metadata.h>
+#include <nx/sdk/helpers/uuid_helper.h>
+
+#include "engine.h"
+
+namespace nx {
+namespace vms_server_plugins {
+namespace analytics {
+namespace stub {
+namespace load_generator {
+
+const std::string kObjectType = "nx.stub.loadGenerator.object";
+const std::string kEventType = "nx.stub.loadGenerator.event";
+const std::string kAttributeNamePrefix = "Attribute ";
+constexpr int kMaxAttributesPerObject = 32;
+
+const std::string kObjectsPerFrameSetting = "objectsPerFrame";
+const std::string kTrackLengthSetting = "trackLengthFrames";
+const std::string kAttributesPerObjectSetting = "attributesPerObject";
+const std::string kAttributeCardinalitySetting = "attributeCardinality";
+const std::string kBestShotImageSizeSetting = "bestShotImageSizeBytes";
+const std::string kEventsPerSecondSetting = "eventsPerSecond";
+
+/**
+ * Generates the analytics metadata at the rate defined by the settings: the object tracks with the
+ * given number of objects per frame and attributes per object, a best shot image per track, and
+ * the events. The attribute values are pseudo-random with a fixed seed, so the load is
+ * reproducible, and the number of distinct values of each attribute is limited by the attribute
+ * cardinality setting, which defines the size of the attribute index in the analytics database.
+ *
+ * Periodically reports the generated load and the ingestion lag observed by the plugin via a
+ * Plugin Diagnostic Event:
+ * - Frame lag: how late the video frames arrive to the plugin relative to their timestamps; grows
+ *     when the Server can not keep up with the analytics pipeline.
+ * - Push time: how long the Server takes to accept the metadata packets.
+ */
+class DeviceAgent: public nx::sdk::analytics::ConsumingDeviceAgent
+{
+public:
+    DeviceAgent(const nx::sdk::IDeviceInfo* deviceInfo);
+    virtual ~DeviceAgent() override;
+
+protected:
+    virtual std::string manifestString() const override;
+
+    virtual bool pushCompressedVideoFrame(
+        nx::sdk::Ptr<const nx::sdk::analytics::ICompressedVideoPacket> videoFrame) override;
+
+    virtual nx::sdk::Result<const nx::sdk::ISettingsResponse*> settingsReceived() override;
+
+private:
+    struct LoadSettings
+    {
+        int objectsPerFrame = 10;
+        int trackLengthFrames = 100;
+        int attributesPerObject = 5;
+        int attributeCardinality = 10;
+        int bestShotImageSizeBytes = 0; //< 0 disables the best shots.
+        int eventsPerSecond = 10;
+    };
+
+    struct Track
+    {
+        nx::sdk::Uuid trackId;
+        std::vector<nx::sdk::Ptr<nx::sdk::Attribute>> attributes;
+    };
+
+    struct Statistics
+    {
+        std::chrono::steady_clock::time_point periodStart = std::chrono::steady_clock::now();
+        int64_t objectCount = 0;
+        int64_t bestShotCount = 0;
+        int64_t bestShotBytes = 0;
+        int64_t eventCount = 0;
+        int64_t frameCount = 0;
+        std::chrono::microseconds frameLagSum{0};
+        std::chrono::microseconds frameLagMax{0};
+        int64_t pushCount = 0;
+        std::chrono::microseconds pushTimeSum{0};
+        std::chrono::microseconds pushTimeMax{0};
+    };
+
+private:
+    void startNewTracks();
+
+    std::vector<nx::sdk::Ptr<nx::sdk::analytics::IMetadataPacket>> generateFrameMetadata(
+        int64_t frameTimestampUs);
+
+    nx::sdk::Ptr<nx::sdk::analytics::IMetadataPacket> generateEvents(
+        int eventCount, int64_t timestampUs);
+
+    void pushAndMeasure(
+        const std::vector<nx::sdk::Ptr<nx::sdk::analytics::IMetadataPacket>>& metadataPackets);
+
+    void onFrameReceived(int64_t frameTimestampUs);
+    void maybeReportStatistics();
+    void eventThreadLoop();
+
+private:
+    mutable std::mutex m_mutex;
+    LoadSettings m_settings;
+    std::mt19937 m_random;
+    std::vector<Track> m_tracks;
+    int m_frameIndex = 0;
+    std::vector<char> m_bestShotImage;
+
+    std::mutex m_statisticsMutex;
+    Statistics m_statistics;
+
+    std::thread m_eventThread;
+    std::mutex m_eventThreadMutex;
+    std::condition_variable m_eventThreadCondition;
+    bool m_terminated = false;
+};
+
+} // namespace load_generator
+} // namespace stub
+} // namespace analytics
+} // namespace vms_server_plugins
+} // namespace nx
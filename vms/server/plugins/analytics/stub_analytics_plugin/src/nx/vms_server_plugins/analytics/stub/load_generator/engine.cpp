@@ -0,0 +1,107 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "engine.h"
+
+#include <string>
+
+#include <nx/kit/json.h>
+
+#include "device_agent.h"
+#include "stub_analytics_plugin_load_generator_ini.h"
+
+namespace nx {
+namespace vms_server_plugins {
+namespace analytics {
+namespace stub {
+namespace load_generator {
+
+using namespace nx::sdk;
+using namespace nx::sdk::analytics;
+using nx::kit::Json;
+
+Engine::Engine(): nx::sdk::analytics::Engine(ini().enableOutput)
+{
+}
+
+Engine::~Engine()
+{
+}
+
+void Engine::doObtainDeviceAgent(Result<IDeviceAgent*>* outResult, const IDeviceInfo* deviceInfo)
+{
+    *outResult = new DeviceAgent(deviceInfo);
+}
+
+static Json::object spinBox(
+    const std::string& name,
+    const std::string& caption,
+    const std::string& description,
+    int defaultValue,
+    int maxValue)
+{
+    return Json::object{
+        {"type", "SpinBox"},
+        {"name", name},
+        {"caption", caption},
+        {"description", description},
+        {"defaultValue", defaultValue},
+        {"minValue", 0},
+        {"maxValue", maxValue}
+    };
+}
+
+std::string Engine::manifestString() const
+{
+    Json::array attributes;
+    for (int i = 1; i <= kMaxAttributesPerObject; ++i)
+    {
+        attributes.push_back(Json::object{
+            {"type", "String"},
+            {"name", kAttributeNamePrefix + std::to_string(i)}
+        });
+    }
+
+    const Json::array settings = {
+        spinBox(kObjectsPerFrameSetting, "Objects per frame",
+            "Number of object tracks present in each video frame", 10, 1000),
+        spinBox(kTrackLengthSetting, "Track length",
+            "Number of video frames after which the tracks are replaced with the new ones",
+            100, 100000),
+        spinBox(kAttributesPerObjectSetting, "Attributes per object",
+            "Number of attributes of each object", 5, kMaxAttributesPerObject),
+        spinBox(kAttributeCardinalitySetting, "Attribute cardinality",
+            "Number of distinct values of each attribute", 10, 1000000),
+        spinBox(kBestShotImageSizeSetting, "Best shot image size",
+            "Size of the best shot image generated for each track, in bytes; 0 disables the "
+            "best shots", 0, 10 * 1024 * 1024),
+        spinBox(kEventsPerSecondSetting, "Events per second",
+            "Number of events generated per second", 10, 100000),
+    };
+
+    const Json::object manifest = {
+        {"streamTypeFilter", "compressedVideo"},
+        {"typeLibrary", Json::object{
+            {"objectTypes", Json::array{Json::object{
+                {"id", kObjectType},
+                {"name", "Load generator object"},
+                {"attributes", attributes}
+            }}},
+            {"eventTypes", Json::array{Json::object{
+                {"id", kEventType},
+                {"name", "Load generator event"}
+            }}}
+        }},
+        {"deviceAgentSettingsModel", Json::object{
+            {"type", "Settings"},
+            {"items", settings}
+        }}
+    };
+
+    return Json(manifest).dump();
+}
+
+} // namespace load_generator
+} // namespace stub
+} // namespace analytics
+} // namespace vms_server_plugins
+} // namespace nx
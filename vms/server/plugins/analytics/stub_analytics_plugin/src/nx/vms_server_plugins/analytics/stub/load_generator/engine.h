@@ -0,0 +1,33 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <nx/sdk/analytics/helpers/engine.h>
+#include <nx/sdk/analytics/helpers/integration.h>
+
+namespace nx {
+namespace vms_server_plugins {
+namespace analytics {
+namespace stub {
+namespace load_generator {
+
+class Engine: public nx::sdk::analytics::Engine
+{
+public:
+    Engine();
+    virtual ~Engine() override;
+
+protected:
+    virtual std::string manifestString() const override;
+
+protected:
+    virtual void doObtainDeviceAgent(
+        nx::sdk::Result<nx::sdk::analytics::IDeviceAgent*>* outResult,
+        const nx::sdk::IDeviceInfo* deviceInfo) override;
+};
+
+} // namespace load_generator
+} // namespace stub
+} // namespace analytics
+} // namespace vms_server_plugins
+} // namespace nx
@@ -0,0 +1,38 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "integration.h"
+
+#include "engine.h"
+
+namespace nx {
+namespace vms_server_plugins {
+namespace analytics {
+namespace stub {
+namespace load_generator {
+
+using namespace nx::sdk;
+using namespace nx::sdk::analytics;
+
+Result<IEngine*> Integration::doObtainEngine()
+{
+    return new Engine();
+}
+
+std::string Integration::manifestString() const
+{
+    return /*suppress newline*/ 1 + (const char*) R"json(
+{
+    "id": "nx.stub.load_generator",
+    "name": "Stub, Load Generator",
+    "description": "A plugin generating a configurable amount of analytics metadata, for benchmarking the metadata throughput of the Server, from the Plugin through the analytics database to the search in the Client.",
+    "version": "1.0.0",
+    "vendor": "Plugin vendor"
+}
+)json";
+}
+
+} // namespace load_generator
+} // namespace stub
+} // namespace analytics
+} // namespace vms_server_plugins
+} // namespace nx
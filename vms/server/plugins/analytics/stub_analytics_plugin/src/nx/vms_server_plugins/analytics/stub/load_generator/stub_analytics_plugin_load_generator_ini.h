@@ -0,0 +1,30 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <nx/kit/ini_config.h>
+
+namespace nx {
+namespace vms_server_plugins {
+namespace analytics {
+namespace stub {
+namespace load_generator {
+
+struct Ini: public nx::kit::IniConfig
+{
+    Ini(): IniConfig("stub_analytics_plugin_load_generator.ini") { reload(); }
+
+    NX_INI_FLAG(0, enableOutput, "");
+    NX_INI_INT(10, statisticsPeriodS,
+        "Period of reporting the load statistics via a Plugin Diagnostic Event, in seconds.");
+    NX_INI_INT(42, randomSeed,
+        "Seed of the generated attribute values; the same seed yields the same load.");
+};
+
+Ini& ini();
+
+} // namespace load_generator
+} // namespace stub
+} // namespace analytics
+} // namespace vms_server_plugins
+} // namespace nx
@@ -221,6 +221,17 @@ public:
         ASSERT_TRUE(metadata->timestampUs() >= 0);
     }
 
+    virtual void handleMetadataList(IList<IMetadataPacket>* metadataList) override
+    {
+        ASSERT_TRUE(metadataList != nullptr);
+
+        NX_PRINT << "DeviceAgentHandler: Received a list of " << metadataList->count()
+            << " metadata packets";
+
+        for (int i = 0; i < metadataList->count(); ++i)
+            handleMetadata(metadataList->at(i).get());
+    }
+
     virtual void handleIntegrationDiagnosticEvent(IIntegrationDiagnosticEvent* event) override
     {
         ASSERT_TRUE(event != nullptr);
@@ -5,6 +5,8 @@
 #include <cstddef>
 #include <cstring>
 
+#include <QtCore/QMutexLocker>
+
 #include "axis_camera_plugin.h"
 #include "axis_cam_params.h"
 #include "axis_media_encoder.h"
@@ -196,19 +198,48 @@ int AxisCameraManager::updateCameraInfo() const
         | nxcip::BaseCameraManager::sharePixelsCapability
         | nxcip::BaseCameraManager::fixedQualityCapability;
 
-    std::unique_ptr<SyncHttpClient> httpClient;
+    //reading all missing info with a single request, since each request is a round-trip
+    //to the camera
+    QList<QByteArray> paramNames;
+    if( std::strlen(m_info.modelName) == 0 )
+        paramNames << "Brand.ProdShortName";
+    if( std::strlen(m_info.firmware) == 0 )
+        paramNames << "Properties.Firmware.Version";    //< Firmware is unavailable via MDNS.
+    if( !m_relayIOInfoRead )
+    {
+        //also prefetching the parameters needed by the encoders, which are requested right
+        //after the camera info
+        paramNames << "Input.NbrOfInputs" << "Output.NbrOfOutputs"
+            << "Network.RTSP.Port" << "Properties.Image.Resolution";
+    }
+    if( paramNames.isEmpty() )
+        return nxcip::NX_NO_ERROR;
+
+    SyncHttpClient httpClient(
+        AxisCameraPlugin::instance()->networkAccessManager(),
+        m_info.url,
+        DEFAULT_AXIS_API_PORT,
+        m_credentials );
+    std::map<QByteArray, QByteArray> paramValues;
+    const int status = readAxisParameters( &httpClient, paramNames, &paramValues );
+    if( status != SyncHttpClient::HTTP_OK )
+        return status == SyncHttpClient::HTTP_NOT_AUTHORIZED ? nxcip::NX_NOT_AUTHORIZED : nxcip::NX_OTHER_ERROR;
+
+    const auto value =
+        [&paramValues]( const QByteArray& paramName, QByteArray* paramValue )
+        {
+            const auto it = paramValues.find( paramName.toLower() );
+            if( it == paramValues.end() )
+                return false;
+            *paramValue = it->second;
+            return true;
+        };
+
     if( std::strlen(m_info.modelName) == 0 )
     {
-        if( !httpClient.get() )
-            httpClient.reset( new SyncHttpClient(
-                AxisCameraPlugin::instance()->networkAccessManager(),
-                m_info.url,
-                DEFAULT_AXIS_API_PORT,
-                m_credentials ) );
         QByteArray prodShortName;
-        const int status = readAxisParameter( httpClient.get(), "root.Brand.ProdShortName", &prodShortName );
-        if( status != SyncHttpClient::HTTP_OK )
-            return status == SyncHttpClient::HTTP_NOT_AUTHORIZED ? nxcip::NX_NOT_AUTHORIZED : nxcip::NX_OTHER_ERROR;
+        if( !value( "Brand.ProdShortName", &prodShortName ) )
+            return nxcip::NX_OTHER_ERROR;
         prodShortName.replace( QByteArray(" "), QByteArray() );
         prodShortName.replace( QByteArray("-"), QByteArray() );
         strncpy( m_info.modelName, prodShortName.constData(), sizeof(m_info.modelName)/sizeof(*m_info.modelName)-1 );
@@ -216,52 +247,76 @@ int AxisCameraManager::updateCameraInfo() const
 
     if( std::strlen(m_info.firmware) == 0 )
     {
-        //reading firmware, since it is unavailable via MDNS
-        if( !httpClient.get() )
-            httpClient.reset( new SyncHttpClient(
-                AxisCameraPlugin::instance()->networkAccessManager(),
-                m_info.url,
-                DEFAULT_AXIS_API_PORT,
-                m_credentials ) );
-
         QByteArray firmware;
-        int status = readAxisParameter( httpClient.get(), "root.Properties.Firmware.Version", &firmware );
-        if( status != SyncHttpClient::HTTP_OK )
-            return status == SyncHttpClient::HTTP_NOT_AUTHORIZED ? nxcip::NX_NOT_AUTHORIZED : nxcip::NX_OTHER_ERROR;
-
-        firmware = firmware.mid(firmware.indexOf('=')+1);
+        if( !value( "Properties.Firmware.Version", &firmware ) )
+            return nxcip::NX_OTHER_ERROR;
         strncpy( m_info.firmware, firmware.constData(), sizeof(m_info.firmware)-1 );
         m_info.firmware[sizeof(m_info.firmware)-1] = 0;
     }
 
     if( !m_relayIOInfoRead )
     {
-        if( !httpClient.get() )
-            httpClient.reset( new SyncHttpClient(
-                AxisCameraPlugin::instance()->networkAccessManager(),
-                m_info.url,
-                DEFAULT_AXIS_API_PORT,
-                m_credentials ) );
-
-        //requesting I/O port information (if needed)
-        int status = readAxisParameter( httpClient.get(), "Input.NbrOfInputs", &m_inputPortCount );
-        if( status != SyncHttpClient::HTTP_OK )
-            return status == SyncHttpClient::HTTP_NOT_AUTHORIZED ? nxcip::NX_NOT_AUTHORIZED : nxcip::NX_OTHER_ERROR;
+        QByteArray portCount;
+        if( !value( "Input.NbrOfInputs", &portCount ) )
+            return nxcip::NX_OTHER_ERROR;
+        m_inputPortCount = portCount.toUInt();
         if( m_inputPortCount > 0 )
             m_cameraCapabilities |= BaseCameraManager::relayInputCapability;
 
-        status = readAxisParameter( httpClient.get(), "Output.NbrOfOutputs", &m_outputPortCount );
-        if( status != SyncHttpClient::HTTP_OK )
-            return status == SyncHttpClient::HTTP_NOT_AUTHORIZED ? nxcip::NX_NOT_AUTHORIZED : nxcip::NX_OTHER_ERROR;
+        if( !value( "Output.NbrOfOutputs", &portCount ) )
+            return nxcip::NX_OTHER_ERROR;
+        m_outputPortCount = portCount.toUInt();
         if( m_outputPortCount > 0 )
             m_cameraCapabilities |= BaseCameraManager::relayOutputCapability;
 
         m_relayIOInfoRead = true;
     }
 
+    QMutexLocker lk( &m_prefetchedParametersMutex );
+    m_prefetchedParameters.insert( paramValues.begin(), paramValues.end() );
     return nxcip::NX_NO_ERROR;
 }
 
+bool AxisCameraManager::prefetchedParameter( const QByteArray& paramName, QByteArray* paramValue ) const
+{
+    QMutexLocker lk( &m_prefetchedParametersMutex );
+    const auto it = m_prefetchedParameters.find( paramName.toLower() );
+    if( it == m_prefetchedParameters.end() )
+        return false;
+    *paramValue = it->second;
+    return true;
+}
+
+int AxisCameraManager::readAxisParameters(
+    SyncHttpClient* const httpClient,
+    const QList<QByteArray>& paramNames,
+    std::map<QByteArray, QByteArray>* paramValues )
+{
+    static const QByteArray kRootPrefix( "root." );
+
+    const QByteArray path = "/axis-cgi/param.cgi?action=list&group=" + paramNames.join(',');
+    if( httpClient->get( QString::fromLatin1(path) ) != QNetworkReply::NoError )
+        return nxcip::NX_NETWORK_ERROR;
+    if( httpClient->statusCode() != SyncHttpClient::HTTP_OK )
+        return httpClient->statusCode();
+
+    const QByteArray& body = httpClient->readWholeMessageBody();
+    for( const QByteArray& line: body.split('\n') )
+    {
+        //line has format root.param=value
+        const int paramValueSepPos = line.indexOf('=');
+        if( paramValueSepPos == -1 )
+            continue;   //error message or unknown param format
+
+        QByteArray paramName = line.left(paramValueSepPos).trimmed().toLower();
+        if( paramName.startsWith(kRootPrefix) )
+            paramName.remove( 0, kRootPrefix.size() );
+        (*paramValues)[paramName] = line.mid(paramValueSepPos+1).trimmed();
+    }
+
+    return SyncHttpClient::HTTP_OK;
+}
+
 int AxisCameraManager::readAxisParameter(
     SyncHttpClient* const httpClient,
     const QByteArray& paramName,
@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <vector>
 
+#include <QtCore/QMutex>
 #include <QtCore/QString>
 #include <QtNetwork/QAuthenticator>
 
@@ -81,6 +83,23 @@ public:
         SyncHttpClient* const httpClient,
         const QByteArray& paramName,
         int* paramValue );
+    //!reads several axis parameters or groups in one request
+    /*!
+        Triggers url like http://ip/axis-cgi/param.cgi?action=list&group=Input,Output
+        \param paramValues Receives all parameters of the requested groups. Names are lower-cased
+            and have no "root." prefix, since VAPIX parameter names are case-insensitive
+        \return http status code
+    */
+    static int readAxisParameters(
+        SyncHttpClient* const httpClient,
+        const QList<QByteArray>& paramNames,
+        std::map<QByteArray, QByteArray>* paramValues );
+
+    //!Returns parameter read by \a updateCameraInfo along with camera info, if any
+    /*!
+        Saves a request to the camera for the parameters needed right after the camera info
+    */
+    bool prefetchedParameter( const QByteArray& paramName, QByteArray* paramValue ) const;
 
     nxpt::CommonRefManager* refManager();
 
@@ -101,6 +120,8 @@ private:
     mutable unsigned int m_cameraCapabilities;
     mutable unsigned int m_inputPortCount;
     mutable unsigned int m_outputPortCount;
+    mutable QMutex m_prefetchedParametersMutex;
+    mutable std::map<QByteArray, QByteArray> m_prefetchedParameters;
 
     int updateCameraInfo() const;
 };
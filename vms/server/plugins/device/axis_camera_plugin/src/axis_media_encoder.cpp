@@ -66,6 +66,10 @@ int AxisMediaEncoder::releaseRef() const
 
 int AxisMediaEncoder::getMediaUrl( char* urlBuf ) const
 {
+    QByteArray rtspPort;
+    if( m_rtspPort == -1 && m_cameraManager->prefetchedParameter( "Network.RTSP.Port", &rtspPort ) )
+        m_rtspPort = rtspPort.toInt();
+
     if( m_rtspPort == -1 )
     {
         SyncHttpClient http(
@@ -172,23 +176,28 @@ int AxisMediaEncoder::setBitrate( int bitrateKbps, int* selectedBitrateKbps )
 int AxisMediaEncoder::fetchCameraResolutionList() const
 {
     // determin camera max resolution
-    SyncHttpClient http(
-        AxisCameraPlugin::instance()->networkAccessManager(),
-        m_cameraManager->cameraInfo().url,
-        DEFAULT_AXIS_API_PORT,
-        m_cameraManager->credentials() );
-    if( http.get( QLatin1String("/axis-cgi/param.cgi?action=list&group=Properties.Image.Resolution") ) != QNetworkReply::NoError )
-        return nxcip::NX_NETWORK_ERROR;
-    if( http.statusCode() != SyncHttpClient::HTTP_OK )
-        return http.statusCode() == SyncHttpClient::HTTP_NOT_AUTHORIZED ? nxcip::NX_NOT_AUTHORIZED : nxcip::NX_OTHER_ERROR;
-
-    const QByteArray& body = http.readWholeMessageBody();
-
-    int paramValuePos = body.indexOf('=');
-    if( paramValuePos == -1 )
-        return nxcip::NX_OTHER_ERROR;
-
-    const QList<QByteArray>& resolutionNameList = body.mid(paramValuePos+1).split(',');
+    QByteArray resolutionList;
+    if( !m_cameraManager->prefetchedParameter( "Properties.Image.Resolution", &resolutionList ) )
+    {
+        SyncHttpClient http(
+            AxisCameraPlugin::instance()->networkAccessManager(),
+            m_cameraManager->cameraInfo().url,
+            DEFAULT_AXIS_API_PORT,
+            m_cameraManager->credentials() );
+        if( http.get( QLatin1String("/axis-cgi/param.cgi?action=list&group=Properties.Image.Resolution") ) != QNetworkReply::NoError )
+            return nxcip::NX_NETWORK_ERROR;
+        if( http.statusCode() != SyncHttpClient::HTTP_OK )
+            return http.statusCode() == SyncHttpClient::HTTP_NOT_AUTHORIZED ? nxcip::NX_NOT_AUTHORIZED : nxcip::NX_OTHER_ERROR;
+
+        const QByteArray& body = http.readWholeMessageBody();
+
+        int paramValuePos = body.indexOf('=');
+        if( paramValuePos == -1 )
+            return nxcip::NX_OTHER_ERROR;
+        resolutionList = body.mid(paramValuePos+1);
+    }
+
+    const QList<QByteArray>& resolutionNameList = resolutionList.split(',');
     m_supportedResolutions.reserve( resolutionNameList.size() );
     for( int i = 0; i < resolutionNameList.size(); ++i )
     {
@@ -25,32 +25,27 @@ AxisRelayIOManager::AxisRelayIOManager(
     m_outputPortCount( outputPortCount ),
     m_multipartedParsingState( waitingDelimiter )
 {
-    std::unique_ptr<SyncHttpClient> httpClient;
-    if( !httpClient.get() )
-        httpClient.reset( new SyncHttpClient(
-            AxisCameraPlugin::instance()->networkAccessManager(),
-            m_cameraManager->cameraInfo().url,
-            DEFAULT_AXIS_API_PORT,
-            m_cameraManager->credentials() ) );
-
-    //reading port direction and names
+    SyncHttpClient httpClient(
+        AxisCameraPlugin::instance()->networkAccessManager(),
+        m_cameraManager->cameraInfo().url,
+        DEFAULT_AXIS_API_PORT,
+        m_cameraManager->credentials() );
+
+    //reading port direction and names of all ports with a single request
+    std::map<QByteArray, QByteArray> ioPortParams;
+    AxisCameraManager::readAxisParameters( &httpClient, QList<QByteArray>() << "IOPort", &ioPortParams );
     for( unsigned int i = 0; i < m_inputPortCount+m_outputPortCount; ++i )
     {
-        QByteArray portDirection;
-        int status = AxisCameraManager::readAxisParameter(
-            httpClient.get(),
-            QString::fromLatin1("IOPort.I%1.Direction").arg(i).toLatin1(),
-            &portDirection );
-        if( status != SyncHttpClient::HTTP_OK )
+        const QByteArray portPrefix = "ioport.i" + QByteArray::number(i) + ".";
+        const auto directionIt = ioPortParams.find( portPrefix + "direction" );
+        if( directionIt == ioPortParams.end() )
             continue;
+        const QByteArray portDirection = directionIt->second.toLower();
 
-        QString portName;
-        status = AxisCameraManager::readAxisParameter(
-            httpClient.get(),
-            QString::fromLatin1("IOPort.I%1.%2.Name").arg(i).arg(QString::fromUtf8(portDirection)).toLatin1(),
-            &portName );
-        if( status != SyncHttpClient::HTTP_OK )
+        const auto nameIt = ioPortParams.find( portPrefix + portDirection + ".name" );
+        if( nameIt == ioPortParams.end() )
             continue;
+        const QString portName = QString::fromUtf8( nameIt->second );
 
         if( portDirection == "input" )
             m_inputPortNameToIndex[portName] = i;
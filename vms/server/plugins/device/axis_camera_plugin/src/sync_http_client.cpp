@@ -57,6 +57,9 @@ QNetworkReply::NetworkError SyncHttpClient::get( const QNetworkRequest& request
     if( requestUrlCopy.password().isEmpty() )
         requestUrlCopy.setPassword( m_defaultUrl.password() );
     requestCopy.setUrl( requestUrlCopy );
+    //all clients share the plugin's QNetworkAccessManager, so the connection (and authentication)
+    //to the camera is reused by the subsequent requests instead of being established for each call
+    requestCopy.setRawHeader( "Connection", "keep-alive" );
 
     //initiating async request
     //waiting for request completion
@@ -4,23 +4,68 @@
 
 #include <sys/timeb.h>
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
 
 #include "dir_iterator.h"
+#include "wildcard_match.h"
 
 static const nxcip::UsecUTCTimestamp USEC_IN_MS = 1000;
 static const nxcip::UsecUTCTimestamp USEC_IN_SEC = 1000*1000;
 static const nxcip::UsecUTCTimestamp NSEC_IN_USEC = 1000;
 static const unsigned int MAX_IMAGES_IN_ARCHIVE = 10000;
+static const size_t IMAGE_CACHE_SIZE_BYTES = 64*1024*1024;
+static const unsigned int DIR_POLL_PERIOD_MS = 2*1000;
+static const char* const IMAGE_FILE_MASK = "*.jp*g";
+static const char* const INDEX_FILE_NAME = ".image_library_index";
+
+static nxcip::UsecUTCTimestamp currentTimeUsec()
+{
+    struct timeb curTime;
+    memset( &curTime, 0, sizeof(curTime) );
+    ftime( &curTime );
+    return curTime.time * USEC_IN_SEC + curTime.millitm * USEC_IN_MS;
+}
+
+//!\return (uint64_t)-1, if \a path does not exist
+static uint64_t modificationTime( const std::string& path )
+{
+    struct stat fStat;
+    memset( &fStat, 0, sizeof(fStat) );
+    if( ::stat( path.c_str(), &fStat ) != 0 )
+        return (uint64_t)-1;
+    return fStat.st_mtime;
+}
 
 DirContentsManager::DirContentsManager(
     const std::string& imageDir,
     unsigned int frameDurationUsec )
 :
     m_imageDir( imageDir ),
-    m_frameDurationUsec( frameDurationUsec )
+    m_frameDurationUsec( frameDurationUsec ),
+    m_imageCache( IMAGE_CACHE_SIZE_BYTES ),
+    m_terminated( false )
 {
-    readDirContents();
+    //providing contents known from previous run until directory is scanned
+    loadIndex();
+    updateDirContents();
+
+    m_scanThread = std::thread( [this]() { scanThreadFunc(); } );
+}
+
+DirContentsManager::~DirContentsManager()
+{
+    {
+        std::lock_guard<std::mutex> lk( m_scanMutex );
+        m_terminated = true;
+        m_scanCond.notify_all();
+    }
+    m_scanThread.join();
 }
 
 /*!
@@ -28,6 +73,8 @@ DirContentsManager::DirContentsManager(
 */
 std::map<nxcip::UsecUTCTimestamp, std::string> DirContentsManager::dirContents() const
 {
+    Mutex::ScopedLock lk( &m_mutex );
+
     return m_dirContents;
 }
 
@@ -58,32 +105,234 @@ nxcip::UsecUTCTimestamp DirContentsManager::maxTimestamp() const
     return m_dirContents.rbegin()->first;
 }
 
-void DirContentsManager::readDirContents()
+ImageCache* DirContentsManager::imageCache()
 {
-    DirIterator dirIterator( m_imageDir );
+    return &m_imageCache;
+}
+
+void DirContentsManager::scanThreadFunc()
+{
+    std::unique_lock<std::mutex> lk( m_scanMutex );
+    for( bool rescanNeeded = true; !m_terminated; )
+    {
+        lk.unlock();
+        if( rescanNeeded && scanDir() )
+        {
+            updateDirContents();
+            saveIndex();
+        }
+        lk.lock();
+
+        m_scanCond.wait_for(
+            lk,
+            std::chrono::milliseconds( DIR_POLL_PERIOD_MS ),
+            [this]() { return m_terminated; } );
+        if( m_terminated )
+            break;
 
+        //adding or removing a file changes modification time of its directory
+        lk.unlock();
+        rescanNeeded = dirModified();
+        lk.lock();
+    }
+}
+
+bool DirContentsManager::scanDir()
+{
+    DirIterator dirIterator( m_imageDir );
     dirIterator.setRecursive( true );
-    dirIterator.setEntryTypeFilter( FsEntryType::etRegularFile );
-    dirIterator.setWildCardMask( "*.jp*g" );
 
-    struct timeb curTime;
-    memset( &curTime, 0, sizeof(curTime) );
-    ftime( &curTime );
-    const nxcip::UsecUTCTimestamp lastPicTimestamp = curTime.time * USEC_IN_SEC + curTime.millitm * USEC_IN_MS;
+    std::map<std::string, FileInfo> newIndex;
+    std::map<std::string, uint64_t> newDirModificationTimes;
+    std::vector<std::string> newFiles;
+    bool indexChanged = false;
 
-    std::map<nxcip::UsecUTCTimestamp, std::string> newDirContents;
+    newDirModificationTimes[std::string()] = modificationTime( m_imageDir );
+    while( dirIterator.next() )
+    {
+        const std::string entryPath = dirIterator.entryPath();
+        if( dirIterator.entryType() == FsEntryType::etDirectory )
+        {
+            newDirModificationTimes[entryPath] = dirIterator.entryModificationTime();
+            continue;
+        }
+
+        const std::string::size_type nameStart = entryPath.find_last_of( "/\\" );
+        const std::string entryName =
+            nameStart == std::string::npos ? entryPath : entryPath.substr( nameStart + 1 );
+        if( dirIterator.entryType() != FsEntryType::etRegularFile ||
+            !wildcardMatch( IMAGE_FILE_MASK, entryName.c_str() ) )
+        {
+            continue;
+        }
+
+        FileInfo fileInfo;
+        fileInfo.timestamp = nxcip::INVALID_TIMESTAMP_VALUE;
+        fileInfo.modificationTime = dirIterator.entryModificationTime();
+        fileInfo.size = dirIterator.entrySize();
 
-    //reading directory
-    for( nxcip::UsecUTCTimestamp
-        curTimestamp = lastPicTimestamp;
-        dirIterator.next();
-        curTimestamp -= m_frameDurationUsec )
+        std::map<std::string, FileInfo>::const_iterator indexIt = m_index.find( entryPath );
+        if( indexIt == m_index.end() )
+        {
+            newFiles.push_back( entryPath );
+            indexChanged = true;
+        }
+        else
+        {
+            //file keeps its place in the archive even if modified
+            fileInfo.timestamp = indexIt->second.timestamp;
+            if( indexIt->second.modificationTime != fileInfo.modificationTime ||
+                indexIt->second.size != fileInfo.size )
+            {
+                m_imageCache.invalidate( dirIterator.entryFullPath() );
+                indexChanged = true;
+            }
+        }
+        newIndex[entryPath] = fileInfo;
+    }
+
+    if( newIndex.size() - newFiles.size() != m_index.size() )
+    {
+        //some files have been removed
+        for( std::map<std::string, FileInfo>::const_iterator
+            it = m_index.begin();
+            it != m_index.end();
+            ++it )
+        {
+            if( newIndex.find( it->first ) == newIndex.end() )
+                m_imageCache.invalidate( m_imageDir + "/" + it->first );
+        }
+        indexChanged = true;
+    }
+
+    //assigning timestamps to new files
+    if( !newFiles.empty() )
+    {
+        nxcip::UsecUTCTimestamp maxTimestamp = nxcip::INVALID_TIMESTAMP_VALUE;
+        for( std::map<std::string, FileInfo>::const_iterator
+            it = newIndex.begin();
+            it != newIndex.end();
+            ++it )
+        {
+            const nxcip::UsecUTCTimestamp timestamp = it->second.timestamp;
+            if( timestamp != nxcip::INVALID_TIMESTAMP_VALUE &&
+                (maxTimestamp == nxcip::INVALID_TIMESTAMP_VALUE || timestamp > maxTimestamp) )
+            {
+                maxTimestamp = timestamp;
+            }
+        }
+
+        if( maxTimestamp == nxcip::INVALID_TIMESTAMP_VALUE )
+        {
+            //nothing known about directory: files end at current time
+            nxcip::UsecUTCTimestamp curTimestamp = currentTimeUsec();
+            for( std::vector<std::string>::const_reverse_iterator
+                it = newFiles.rbegin();
+                it != newFiles.rend();
+                ++it, curTimestamp -= m_frameDurationUsec )
+            {
+                newIndex[*it].timestamp = curTimestamp;
+            }
+        }
+        else
+        {
+            //appending new files to the end of archive
+            nxcip::UsecUTCTimestamp curTimestamp = maxTimestamp;
+            for( const std::string& filePath: newFiles )
+            {
+                curTimestamp += m_frameDurationUsec;
+                newIndex[filePath].timestamp = curTimestamp;
+            }
+        }
+    }
+
+    m_index.swap( newIndex );
+    m_dirModificationTimes.swap( newDirModificationTimes );
+    return indexChanged;
+}
+
+bool DirContentsManager::dirModified() const
+{
+    for( std::map<std::string, uint64_t>::const_iterator
+        it = m_dirModificationTimes.begin();
+        it != m_dirModificationTimes.end();
+        ++it )
+    {
+        const std::string dirPath = it->first.empty() ? m_imageDir : m_imageDir + "/" + it->first;
+        if( modificationTime( dirPath ) != it->second )
+            return true;
+    }
+    return false;
+}
+
+void DirContentsManager::updateDirContents()
+{
+    std::map<nxcip::UsecUTCTimestamp, std::string> newDirContents;
+    for( std::map<std::string, FileInfo>::const_iterator
+        it = m_index.begin();
+        it != m_index.end();
+        ++it )
     {
-        newDirContents.insert( std::make_pair( curTimestamp, dirIterator.entryFullPath() ) );
+        newDirContents.insert(
+            std::make_pair( it->second.timestamp, m_imageDir + "/" + it->first ) );
     }
+    while( newDirContents.size() > MAX_IMAGES_IN_ARCHIVE )
+        newDirContents.erase( newDirContents.begin() );
 
     {
         Mutex::ScopedLock lk( &m_mutex );
-        m_dirContents = newDirContents;
+        m_dirContents.swap( newDirContents );
     }
 }
+
+void DirContentsManager::loadIndex()
+{
+    std::ifstream f( indexFilePath().c_str() );
+    if( !f.is_open() )
+        return;
+
+    //each line: timestamp \t modification time \t size \t relative path
+    std::string line;
+    while( std::getline( f, line ) )
+    {
+        std::istringstream lineStream( line );
+        FileInfo fileInfo;
+        std::string filePath;
+        if( !(lineStream >> fileInfo.timestamp >> fileInfo.modificationTime >> fileInfo.size) )
+            continue;
+        lineStream.ignore( 1 );
+        if( !std::getline( lineStream, filePath ) || filePath.empty() )
+            continue;
+        m_index[filePath] = fileInfo;
+    }
+}
+
+void DirContentsManager::saveIndex() const
+{
+    //writing to temporary file, so that index is not lost if process terminates while saving
+    const std::string tmpFilePath = indexFilePath() + ".tmp";
+    {
+        std::ofstream f( tmpFilePath.c_str(), std::ios_base::out | std::ios_base::trunc );
+        if( !f.is_open() )
+            return; //< Image directory may be read-only, the index is an optimization only.
+
+        for( std::map<std::string, FileInfo>::const_iterator
+            it = m_index.begin();
+            it != m_index.end();
+            ++it )
+        {
+            f << it->second.timestamp << '\t' << it->second.modificationTime << '\t'
+                << it->second.size << '\t' << it->first << '\n';
+        }
+        if( !f.good() )
+            return;
+    }
+
+    ::remove( indexFilePath().c_str() );
+    ::rename( tmpFilePath.c_str(), indexFilePath().c_str() );
+}
+
+std::string DirContentsManager::indexFilePath() const
+{
+    return m_imageDir + "/" + INDEX_FILE_NAME;
+}
@@ -2,20 +2,34 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+
+#include <stdint.h>
 
 #include <camera/camera_plugin.h>
 
+#include "image_cache.h"
 #include "mutex.h"
 
 //!Manages information about image directory contents: Provides file list, generates timestamps of files, keep track of directory contents
+/*!
+    Directory is scanned in a background thread, so that creating camera does not block on large
+    directories. File timestamps, modification times and sizes are saved to the index file in the
+    image directory, so that after restart the archive is available immediately and only changed
+    files are re-examined. After initial scan, directory modification times are polled and the
+    directory is re-scanned when files are added or removed.
+*/
 class DirContentsManager
 {
 public:
     DirContentsManager(
         const std::string& imageDir,
         unsigned int frameDurationUsec );
+    ~DirContentsManager();
 
     /*!
         \return map<timestamp, file full path>
@@ -26,11 +40,40 @@ public:
     nxcip::UsecUTCTimestamp minTimestamp() const;
     nxcip::UsecUTCTimestamp maxTimestamp() const;
 
+    //!Cache of image file contents, shared by all stream readers of the camera
+    ImageCache* imageCache();
+
 private:
+    struct FileInfo
+    {
+        nxcip::UsecUTCTimestamp timestamp;
+        uint64_t modificationTime;
+        uint64_t size;
+    };
+
     std::string m_imageDir;
     std::map<nxcip::UsecUTCTimestamp, std::string> m_dirContents;
     unsigned int m_frameDurationUsec;
     mutable Mutex m_mutex;
+    //!map<path relative to image dir, file info>. Used by scanning thread only
+    std::map<std::string, FileInfo> m_index;
+    //!map<path relative to image dir, modification time>. Used by scanning thread only
+    std::map<std::string, uint64_t> m_dirModificationTimes;
+    ImageCache m_imageCache;
+    std::mutex m_scanMutex;
+    std::condition_variable m_scanCond;
+    bool m_terminated;
+    std::thread m_scanThread;
 
-    void readDirContents();
+    void scanThreadFunc();
+    //!Updates \a m_index with actual directory contents
+    /*!
+        \return true, if index has been changed
+    */
+    bool scanDir();
+    bool dirModified() const;
+    void updateDirContents();
+    void loadIndex();
+    void saveIndex() const;
+    std::string indexFilePath() const;
 };
@@ -60,6 +60,8 @@ public:
     FsEntryType::Value entryType;
     //!(uint64_t)-1, if not set
     uint64_t entrySize;
+    //!(uint64_t)-1, if not set
+    uint64_t entryModificationTime;
 
     DirIteratorImpl()
     :
@@ -71,7 +73,8 @@ public:
         dp( NULL ),
 #endif
         entryType( FsEntryType::etOther ),
-        entrySize( (uint64_t)-1 )
+        entrySize( (uint64_t)-1 ),
+        entryModificationTime( (uint64_t)-1 )
     {
     }
 
@@ -160,6 +163,11 @@ public:
             }
 
             entrySize = ((uint64_t)fileData.nFileSizeHigh << 32) | fileData.nFileSizeLow;
+            //FILETIME counts 100-nanosecond intervals since 1601-01-01
+            const uint64_t lastWriteTime =
+                ((uint64_t)fileData.ftLastWriteTime.dwHighDateTime << 32) |
+                fileData.ftLastWriteTime.dwLowDateTime;
+            entryModificationTime = lastWriteTime / 10000000 - 11644473600ULL;
             //SYSTEMTIME systemTime;
             //if( !FileTimeToSystemTime( &fileData.ftCreationTime, &systemTime ) )
             //    return false;
@@ -228,6 +236,7 @@ public:
 
 #ifdef _BSD_SOURCE
             entrySize = (uint64_t)-1;
+            entryModificationTime = (uint64_t)-1;
             switch( result->d_type )
             {
                 case DT_DIR:
@@ -268,6 +277,7 @@ public:
                 entryType = FsEntryType::etOther;
             }
             entrySize = st.st_size;
+            entryModificationTime = st.st_mtime;
             //creationTimestamp.m_val = st.st_ctime;
 
             return true;
@@ -346,7 +356,17 @@ uint64_t DirIterator::entrySize() const
         if( ::stat64( (m_impl->dir + "/" + m_impl->entryPath).c_str(), &st ) )
             return 0;
         m_impl->entrySize = st.st_size;
+        m_impl->entryModificationTime = st.st_mtime;
     }
 #endif
     return m_impl->entrySize;
 }
+
+uint64_t DirIterator::entryModificationTime() const
+{
+#ifndef _WIN32
+    if( m_impl->entryModificationTime == (uint64_t)-1 )
+        entrySize(); //< Reads both with a single stat call.
+#endif
+    return m_impl->entryModificationTime == (uint64_t)-1 ? 0 : m_impl->entryModificationTime;
+}
@@ -71,6 +71,8 @@ public:
     std::string entryFullPath() const;
     FsEntryType::Value entryType() const;
     uint64_t entrySize() const;
+    //!Returns last modification time of current entry (seconds since epoch)
+    uint64_t entryModificationTime() const;
 
 private:
     DirIteratorImpl* m_impl;
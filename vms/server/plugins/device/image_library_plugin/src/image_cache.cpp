@@ -0,0 +1,137 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include "image_cache.h"
+
+#include <fstream>
+
+ImageCache::ImageCache( size_t maxSizeBytes )
+:
+    m_maxSizeBytes( maxSizeBytes ),
+    m_sizeBytes( 0 ),
+    m_terminated( false )
+{
+    m_prefetchThread = std::thread( [this]() { prefetchThreadFunc(); } );
+}
+
+ImageCache::~ImageCache()
+{
+    {
+        std::lock_guard<std::mutex> lk( m_mutex );
+        m_terminated = true;
+        m_cond.notify_all();
+    }
+    m_prefetchThread.join();
+}
+
+ImageCache::ImageData ImageCache::get( const std::string& filePath )
+{
+    {
+        std::lock_guard<std::mutex> lk( m_mutex );
+        std::map<std::string, CacheEntry>::iterator it = m_entries.find( filePath );
+        if( it != m_entries.end() )
+        {
+            m_lru.splice( m_lru.begin(), m_lru, it->second.lruPos );
+            return it->second.data;
+        }
+    }
+
+    //not cached (yet): reading synchronously
+    ImageData data = readFile( filePath );
+    if( data )
+    {
+        std::lock_guard<std::mutex> lk( m_mutex );
+        insert( filePath, data );
+    }
+    return data;
+}
+
+void ImageCache::prefetch( const std::vector<std::string>& filePaths )
+{
+    std::lock_guard<std::mutex> lk( m_mutex );
+    m_prefetchQueue.clear();
+    for( const std::string& filePath: filePaths )
+    {
+        std::map<std::string, CacheEntry>::iterator it = m_entries.find( filePath );
+        if( it == m_entries.end() )
+            m_prefetchQueue.push_back( filePath );
+        else
+            m_lru.splice( m_lru.begin(), m_lru, it->second.lruPos ); //< Keeping it from eviction.
+    }
+    m_cond.notify_all();
+}
+
+void ImageCache::invalidate( const std::string& filePath )
+{
+    std::lock_guard<std::mutex> lk( m_mutex );
+    std::map<std::string, CacheEntry>::iterator it = m_entries.find( filePath );
+    if( it != m_entries.end() )
+        remove( it );
+}
+
+void ImageCache::prefetchThreadFunc()
+{
+    std::unique_lock<std::mutex> lk( m_mutex );
+    for( ;; )
+    {
+        m_cond.wait( lk, [this]() { return m_terminated || !m_prefetchQueue.empty(); } );
+        if( m_terminated )
+            return;
+
+        const std::string filePath = m_prefetchQueue.front();
+        m_prefetchQueue.pop_front();
+        if( m_entries.find( filePath ) != m_entries.end() )
+            continue;
+
+        lk.unlock();
+        ImageData data = readFile( filePath );
+        lk.lock();
+
+        if( data )
+            insert( filePath, data );
+    }
+}
+
+void ImageCache::insert( const std::string& filePath, ImageData data )
+{
+    std::map<std::string, CacheEntry>::iterator it = m_entries.find( filePath );
+    if( it != m_entries.end() )
+        remove( it );
+
+    if( data->size() > m_maxSizeBytes )
+        return;
+
+    while( m_sizeBytes + data->size() > m_maxSizeBytes && !m_lru.empty() )
+        remove( m_entries.find( m_lru.back() ) );
+
+    m_lru.push_front( filePath );
+    CacheEntry& entry = m_entries[filePath];
+    entry.data = data;
+    entry.lruPos = m_lru.begin();
+    m_sizeBytes += data->size();
+}
+
+void ImageCache::remove( std::map<std::string, CacheEntry>::iterator it )
+{
+    m_sizeBytes -= it->second.data->size();
+    m_lru.erase( it->second.lruPos );
+    m_entries.erase( it );
+}
+
+ImageCache::ImageData ImageCache::readFile( const std::string& filePath )
+{
+    std::ifstream f(
+        filePath.c_str(), std::ios_base::in | std::ios_base::binary | std::ios_base::ate );
+    if( !f.is_open() )
+        return ImageData();
+
+    const std::streamoff fileSize = f.tellg();
+    if( fileSize < 0 )
+        return ImageData();
+    f.seekg( 0 );
+
+    std::shared_ptr<std::vector<char>> data =
+        std::make_shared<std::vector<char>>( (size_t) fileSize );
+    if( !f.read( data->data(), fileSize ) )
+        return ImageData();
+    return data;
+}
@@ -0,0 +1,65 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//!Keeps contents of recently used image files in memory and reads upcoming files in advance
+/*!
+    Total size of cached files is limited, least recently used files are evicted first.
+    \note Class is thread-safe
+*/
+class ImageCache
+{
+public:
+    typedef std::shared_ptr<const std::vector<char>> ImageData;
+
+    ImageCache( size_t maxSizeBytes );
+    ~ImageCache();
+
+    //!Returns file contents from the cache, or reads the file, if it is not cached
+    /*!
+        \return NULL, if the file could not be read
+    */
+    ImageData get( const std::string& filePath );
+    //!Schedules asynchronous reading of files, which are expected to be requested soon
+    /*!
+        Replaces previously scheduled files, which have not been read yet
+        \param filePaths Files in order of expected use
+    */
+    void prefetch( const std::vector<std::string>& filePaths );
+    //!Removes file from the cache, e.g. if it has been modified
+    void invalidate( const std::string& filePath );
+
+private:
+    struct CacheEntry
+    {
+        ImageData data;
+        std::list<std::string>::iterator lruPos;
+    };
+
+    const size_t m_maxSizeBytes;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::map<std::string, CacheEntry> m_entries;
+    //!Most recently used file is at front
+    std::list<std::string> m_lru;
+    size_t m_sizeBytes;
+    std::deque<std::string> m_prefetchQueue;
+    bool m_terminated;
+    std::thread m_prefetchThread;
+
+    void prefetchThreadFunc();
+    void insert( const std::string& filePath, ImageData data );
+    void remove( std::map<std::string, CacheEntry>::iterator it );
+
+    static ImageData readFile( const std::string& filePath );
+};
@@ -13,11 +13,11 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
-#include <fstream>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "dir_contents_manager.h"
-#include "dir_iterator.h"
 #include "ilp_video_packet.h"
 #include "ilp_empty_packet.h"
 #include "motion_data_picture.h"
@@ -31,6 +31,8 @@ static const unsigned int MOTION_PRESENCE_CHANCE_PERCENT = 70;
 static const nxcip::UsecUTCTimestamp USEC_IN_MS = 1000;
 static const nxcip::UsecUTCTimestamp USEC_IN_SEC = 1000*1000;
 static const nxcip::UsecUTCTimestamp NSEC_IN_USEC = 1000;
+//!Number of files read in advance in the playback direction
+static const size_t PREFETCH_FRAME_COUNT = 16;
 
 StreamReader::StreamReader(
     nxpt::CommonRefManager* const parentRefManager,
@@ -99,6 +101,15 @@ int StreamReader::getNextData( nxcip::MediaDataPacket** lpPacket )
     {
         Mutex::ScopedLock lk( &m_mutex );
 
+        if( m_liveMode && m_curPos == m_dirEntries.end() )
+        {
+            //directory may have been still being scanned when the stream was opened
+            readDirContents();
+            m_curPos = m_dirEntries.begin();
+            if( m_curTimestamp == nxcip::INVALID_TIMESTAMP_VALUE && m_curPos != m_dirEntries.end() )
+                m_curTimestamp = m_curPos->first;
+        }
+
         //copying data for consistency
         curTimestamp = m_curTimestamp;
         streamReset = m_streamReset;
@@ -147,36 +158,22 @@ int StreamReader::getNextData( nxcip::MediaDataPacket** lpPacket )
     }
 #endif
 
-    struct stat fStat;
-    memset( &fStat, 0, sizeof(fStat) );
-    if( ::stat( fileName.c_str(), &fStat ) != 0 )
+    const ImageCache::ImageData imageData = m_dirContentsManager->imageCache()->get( fileName );
+    if( !imageData )
     {
         Mutex::ScopedLock lk( &m_mutex );
         moveCursorToNextFrame();
         return nxcip::NX_IO_ERROR;
     }
 
-    videoPacket->resizeBuffer( fStat.st_size );
+    videoPacket->resizeBuffer( imageData->size() );
     if( !videoPacket->data() )
     {
         Mutex::ScopedLock lk( &m_mutex );
         moveCursorToNextFrame();
         return nxcip::NX_OTHER_ERROR;
     }
-
-    //reading file into
-    std::ifstream f( fileName.c_str(), std::ios_base::in | std::ios_base::binary );
-    if( !f.is_open() )
-        return nxcip::NX_OTHER_ERROR;
-    for( size_t
-        bytesRead = 0;
-        bytesRead < videoPacket->dataSize() && !f.eof();
-         )
-    {
-        f.read( (char*)videoPacket->data() + bytesRead, videoPacket->dataSize() - bytesRead );
-        bytesRead += f.gcount();
-    }
-    f.close();
+    memcpy( videoPacket->data(), imageData->data(), imageData->size() );
 
     {
         Mutex::ScopedLock lk( &m_mutex );
@@ -223,6 +220,7 @@ nxcip::UsecUTCTimestamp StreamReader::setPosition(
     m_curTimestamp = it == m_dirEntries.end() ? nxcip::INVALID_TIMESTAMP_VALUE : it->first;
     m_streamReset = true;
     m_cSeq = cSeq;
+    prefetchNextFrames();
 
     return m_curTimestamp;
 }
@@ -241,6 +239,7 @@ nxcip::UsecUTCTimestamp StreamReader::setReverseMode(
     if( timestamp == nxcip::INVALID_TIMESTAMP_VALUE )
     {
         m_cSeq = cSeq;
+        prefetchNextFrames();
         return m_curTimestamp;
     }
     else
@@ -314,4 +313,33 @@ void StreamReader::moveCursorToNextFrame()
         m_curTimestamp += m_frameDuration;
     else
         m_curTimestamp = m_curPos != m_dirEntries.end() ? m_curPos->first : nxcip::INVALID_TIMESTAMP_VALUE;
+
+    prefetchNextFrames();
+}
+
+void StreamReader::prefetchNextFrames()
+{
+    //files which are already cached or being read are skipped by the cache
+    if( m_curPos == m_dirEntries.end() )
+        return;
+
+    std::vector<std::string> filePaths;
+    std::map<nxcip::UsecUTCTimestamp, std::string>::const_iterator it = m_curPos;
+    for( size_t i = 0; i < PREFETCH_FRAME_COUNT; ++i )
+    {
+        filePaths.push_back( it->second );
+        if( m_isReverse )
+        {
+            if( it == m_dirEntries.begin() )
+                break;
+            --it;
+        }
+        else
+        {
+            if( ++it == m_dirEntries.end() )
+                break;
+        }
+    }
+
+    m_dirContentsManager->imageCache()->prefetch( filePaths );
 }
@@ -73,4 +73,6 @@ private:
     void doLiveDelay();
     void readDirContents();
     void moveCursorToNextFrame();
+    //!Requests image cache to read files following current position in playback direction
+    void prefetchNextFrames();
 };
@@ -266,7 +266,8 @@ namespace rpi_cam
 
     /// @warning This method is called from separate threads (one per stream). So it can't lock common mutex.
     /// But it needs a guarantee, that another thread doesn't destroy components the same time.
-    bool RPiCamera::read(unsigned streamNo, std::vector<uint8_t>& data, uint64_t& ts, unsigned& flags)
+    bool RPiCamera::read(unsigned streamNo, std::vector<uint8_t>& data, uint64_t& ts,
+                         unsigned& flags, rpi_omx::Buffer ** heldBuffer)
     {
         if (streamNo >= STREAMS_NUM())
             return false;
@@ -279,51 +280,61 @@ namespace rpi_cam
         if (! encoder)
             return false;
 
+        if (heldBuffer)
+            *heldBuffer = nullptr;
+
         try
         {
             static const unsigned MAX_ATTEMPTS = 1000;
 
             encoder->prepare(); // fill buffers first time
-            Buffer& encBuffer = encoder->outBuffer();
 
             for (unsigned i = 0; i < MAX_ATTEMPTS; ++i)
             {
-                bool aval = false;
-                if (encBuffer.filled())
+                Buffer * encBuffer = encoder->popFilled();
+                if (! encBuffer)
                 {
-                    flags = encBuffer.flags();
+                    usleep(1000);
+                    continue;
+                }
 
-                    unsigned bufSize = encBuffer.dataSize();
-                    if (bufSize)
-                    {
-                        //debug_print("RPiCamera.read(). size: %d, flags: %d\n", bufSize, flags);
+                flags = encBuffer->flags();
 
-                        aval = true;
-                        unsigned frameSize = data.size();
-                        data.resize(frameSize + bufSize);
+                unsigned bufSize = encBuffer->dataSize();
+                if (bufSize)
+                {
+                    //debug_print("RPiCamera.read(). size: %d, flags: %d\n", bufSize, flags);
 
-                        std::memcpy(&data[frameSize], encBuffer.data(), bufSize);
+                    ts = encBuffer->timeStamp().nHighPart;
+                    ts <<= 32;
+                    ts |= encBuffer->timeStamp().nLowPart;
 
-                        ts = encBuffer.timeStamp().nHighPart;
-                        ts <<= 32;
-                        ts |= encBuffer.timeStamp().nLowPart;
+                    // The whole frame is in one buffer: give it to the caller without copying.
+                    // The read lock is kept until releaseBuffer(), so the buffer is not freed.
+                    if (heldBuffer && data.empty()
+                        && (flags & FLAG_ENDOFFRAME) && !(flags & FLAG_CODECCONFIG))
+                    {
+                        m_rw.tryReadLock();
+                        *heldBuffer = encBuffer;
+                        return true;
                     }
 
-                    // Buffer flushed, request a new buffer to be filled by the encoder component
-                    encBuffer.setFilled(false);
-                    encoder->callFillThisBuffer();
+                    unsigned frameSize = data.size();
+                    data.resize(frameSize + bufSize);
 
-                    if (flags & FLAG_CODECCONFIG)
-                        continue; // merge SPS/PPS data with next frame
+                    std::memcpy(&data[frameSize], encBuffer->data(), bufSize);
+                }
 
-                    //debug_print("RPiCamera.read() timestamp: %llu\n", ts);
+                // Buffer flushed, request a new buffer to be filled by the encoder component
+                encoder->callFillThisBuffer(*encBuffer);
 
-                    if (flags & FLAG_ENDOFFRAME)
-                        return true;
-                }
+                if (flags & FLAG_CODECCONFIG)
+                    continue; // merge SPS/PPS data with next frame
 
-                if (!aval)
-                    usleep(1000);
+                //debug_print("RPiCamera.read() timestamp: %llu\n", ts);
+
+                if (flags & FLAG_ENDOFFRAME)
+                    return true;
             }
         }
         catch (const OMXExeption& ex)
@@ -340,6 +351,20 @@ namespace rpi_cam
         return false;
     }
 
+    void RPiCamera::releaseBuffer(unsigned streamNo, rpi_omx::Buffer * buffer)
+    {
+        try
+        {
+            m_encoders[streamNo]->callFillThisBuffer(*buffer);
+        }
+        catch (const OMXExeption& ex)
+        {
+            debug_print("OMXExeption: %s %s\n", __FUNCTION__, ex.what());
+        }
+
+        m_rw.unlock(); // locked in read()
+    }
+
     void RPiCamera::getEncoderConfig(unsigned streamNo, unsigned& width, unsigned& height, unsigned& fps, unsigned& bitrate) const
     {
         std::lock_guard<std::recursive_mutex> lock(m_mutex); // LOCK
@@ -482,11 +507,8 @@ namespace rpi_cam
     // In fact I'm not sure if we realy need this step.
     void RPiCamera::returnBuffers()
     {
-        m_encoders[0]->outBuffer().flags() |= OMX_BUFFERFLAG_EOS;
-        m_encoders[1]->outBuffer().flags() |= OMX_BUFFERFLAG_EOS;
-
-        m_encoders[0]->callFillThisBuffer();
-        m_encoders[1]->callFillThisBuffer();
+        m_encoders[0]->returnBuffers();
+        m_encoders[1]->returnBuffers();
     }
 
     void RPiCamera::flushBuffers()
@@ -90,7 +90,12 @@ namespace rpi_cam
         ~RPiCamera();
 
         bool isOK() const;
-        bool read(unsigned streamNo, std::vector<uint8_t>& data, uint64_t& timeStamp, unsigned& flags);
+        /// Reads the next frame to data. If heldBuffer is set, a frame which is in one encoder
+        /// buffer is not copied: the buffer is returned in heldBuffer instead and must be given
+        /// back with releaseBuffer(). The camera is not reconfigured while the buffer is held.
+        bool read(unsigned streamNo, std::vector<uint8_t>& data, uint64_t& timeStamp,
+                  unsigned& flags, rpi_omx::Buffer ** heldBuffer = nullptr);
+        void releaseBuffer(unsigned streamNo, rpi_omx::Buffer * buffer);
         void getEncoderConfig(unsigned streamNo, unsigned& width, unsigned& height, unsigned& fps, unsigned& bitrateKbps) const;
         void configEncoder(unsigned streamNo, unsigned width, unsigned height, unsigned framerate, unsigned bitrateKbps);
         void update(); // update if need it
@@ -126,7 +126,7 @@ namespace rpi_omx
         return OMX_ErrorNone;
     }
 
-    static OMX_ERRORTYPE callback_FillBufferDone(OMX_HANDLETYPE /*hComponent*/, OMX_PTR pAppData, OMX_BUFFERHEADERTYPE * /*pBuffer*/)
+    static OMX_ERRORTYPE callback_FillBufferDone(OMX_HANDLETYPE /*hComponent*/, OMX_PTR pAppData, OMX_BUFFERHEADERTYPE * pBuffer)
     {
         Component * component = static_cast<Component *>(pAppData);
 
@@ -137,7 +137,7 @@ namespace rpi_omx
         if (component->type() == Encoder::cType)
         {
             Encoder * encoder = static_cast<Encoder *>(pAppData);
-            encoder->outBuffer().setFilled();
+            encoder->fillBufferDone(pBuffer);
         }
 
         return OMX_ErrorNone;
@@ -3,9 +3,12 @@
 #ifndef _RPI_OMX_
 #define _RPI_OMX_
 
+#include <algorithm>
 #include <atomic>
 #include <cstdio>
+#include <deque>
 #include <exception>
+#include <mutex>
 #include <vector>
 
 #define OMX
@@ -170,6 +173,7 @@ namespace rpi_omx
         OMX_U8 * data() { return  m_ppBuffer->pBuffer + m_ppBuffer->nOffset; }
         OMX_U32 dataSize() const { return m_ppBuffer->nFilledLen; }
         OMX_U32 allocSize() const { return m_ppBuffer->nAllocLen; }
+        OMX_U32 freeSpace() const { return allocSize() - m_ppBuffer->nOffset - dataSize(); }
 
     private:
         OMX_BUFFERHEADERTYPE * m_ppBuffer;
@@ -621,6 +625,10 @@ namespace rpi_omx
         static const unsigned IPORT = 200;
         static const unsigned OPORT = 201;
 
+        /// Several output buffers let the encoder go on while the client holds a filled one.
+        static const unsigned OUT_BUFFERS_NUM = 3;
+        static const unsigned OUT_BUFFER_ALIGNMENT = 64;
+
         Encoder()
         :   Component(cType, (OMX_PTR) this, &cbsEvents),
             m_empty(true)
@@ -641,6 +649,10 @@ namespace rpi_omx
             if (framerate)
                 portDef->format.video.xFramerate = framerate;
 
+            portDef->nBufferCountActual = OUT_BUFFERS_NUM;
+            portDef->nBufferAlignment =
+                std::max<OMX_U32>(portDef->nBufferAlignment, OUT_BUFFER_ALIGNMENT);
+
             setPortDefinition(OPORT, portDef);
         }
 
@@ -680,34 +692,92 @@ namespace rpi_omx
 
         void allocBuffers()
         {
-            Component::allocBuffers(OPORT, m_bufferOut);
+            for (Buffer& buffer : m_buffersOut)
+                Component::allocBuffers(OPORT, buffer);
         }
 
         void freeBuffers()
         {
             m_empty = true;
-            Component::freeBuffers(OPORT, m_bufferOut);
+            {
+                std::lock_guard<std::mutex> lock(m_filledMutex); // LOCK
+                m_filled.clear();
+            }
+
+            for (Buffer& buffer : m_buffersOut)
+                Component::freeBuffers(OPORT, buffer);
         }
 
-        void callFillThisBuffer()
+        void callFillThisBuffer(Buffer& buffer)
         {
-            Component::callFillThisBuffer(m_bufferOut);
+            buffer.setFilled(false);
+            Component::callFillThisBuffer(buffer);
         }
 
         void prepare()
         {
             if (m_empty)
             {
-                callFillThisBuffer();
+                for (Buffer& buffer : m_buffersOut)
+                    callFillThisBuffer(buffer);
                 m_empty = false;
             }
         }
 
-        Buffer& outBuffer() { return m_bufferOut; }
+        /// Gives back with EOS flag the buffers which are filled and not held by the client.
+        void returnBuffers()
+        {
+            prepare();
+
+            std::deque<Buffer *> filled;
+            {
+                std::lock_guard<std::mutex> lock(m_filledMutex); // LOCK
+                filled.swap(m_filled);
+            }
+
+            for (Buffer * buffer : filled)
+            {
+                buffer->flags() |= OMX_BUFFERFLAG_EOS;
+                callFillThisBuffer(*buffer);
+            }
+        }
+
+        /// The next filled buffer in the order the component has filled them, nullptr if none.
+        /// It's owned by the client until it's given back with callFillThisBuffer().
+        Buffer * popFilled()
+        {
+            std::lock_guard<std::mutex> lock(m_filledMutex); // LOCK
+
+            if (m_filled.empty())
+                return nullptr;
+
+            Buffer * buffer = m_filled.front();
+            m_filled.pop_front();
+            return buffer;
+        }
+
+        // from callbacks
+
+        void fillBufferDone(OMX_BUFFERHEADERTYPE * pBuffer)
+        {
+            for (Buffer& buffer : m_buffersOut)
+            {
+                if (buffer.header() == pBuffer)
+                {
+                    buffer.setFilled();
+
+                    std::lock_guard<std::mutex> lock(m_filledMutex); // LOCK
+                    m_filled.push_back(&buffer);
+                    return;
+                }
+            }
+        }
 
     private:
         Parameter<OMX_PARAM_PORTDEFINITIONTYPE> m_encoderPortDef;
-        Buffer m_bufferOut;
+        Buffer m_buffersOut[OUT_BUFFERS_NUM];
+        std::mutex m_filledMutex;
+        std::deque<Buffer *> m_filled;
         bool m_empty;
     };
 
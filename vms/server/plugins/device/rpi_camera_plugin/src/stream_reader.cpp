@@ -1,5 +1,7 @@
 // Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
 
+#include <cstring>
+
 #include "rpi_camera.h"
 
 #include "camera_manager.h"
@@ -8,6 +10,10 @@
 
 namespace rpi_cam
 {
+    // Secondary stream gets I-frames of 320x240 at most, they fit the buffers of the pool.
+    static const unsigned SECONDARY_POOL_BUFFERS_NUM = 4;
+    static const size_t SECONDARY_POOL_BUFFER_SIZE = 128 * 1024;
+
     TimeCorrection StreamReader::m_timeCorrect;
 
     StreamReader::StreamReader(std::shared_ptr<RPiCamera> camera, unsigned encoderNumber)
@@ -17,6 +23,12 @@ namespace rpi_cam
         m_interrupt(false)
     {
         debug_print("%s %d\n", __FUNCTION__, m_encoderNumber);
+
+        if (m_encoderNumber)
+        {
+            m_bufferPool = PacketBufferPool::create(
+                SECONDARY_POOL_BUFFERS_NUM, SECONDARY_POOL_BUFFER_SIZE);
+        }
     }
 
     StreamReader::~StreamReader()
@@ -46,10 +58,12 @@ namespace rpi_cam
 
         uint64_t timeStamp = 0;
         unsigned rpiFlags = 0;
+        std::shared_ptr<RPiCamera> camera;
+        rpi_omx::Buffer * heldBuffer = nullptr;
 
         while (! m_interrupt)
         {
-            std::shared_ptr<RPiCamera> camera = m_camera.lock();
+            camera = m_camera.lock();
 
             if (! camera || ! camera->isOK())
             {
@@ -58,16 +72,25 @@ namespace rpi_cam
             }
 
             m_data.clear();
-            if (camera->read(m_encoderNumber, m_data, timeStamp, rpiFlags))
+            if (camera->read(m_encoderNumber, m_data, timeStamp, rpiFlags, &heldBuffer))
             {
                 // only I-Frames for second stream
                 if (!m_encoderNumber || rpiFlags & RPiCamera::FLAG_SYNCFRAME)
                     break;
+
+                if (heldBuffer)
+                {
+                    camera->releaseBuffer(m_encoderNumber, heldBuffer);
+                    heldBuffer = nullptr;
+                }
             }
         }
 
         if (m_interrupt)
         {
+            if (heldBuffer)
+                camera->releaseBuffer(m_encoderNumber, heldBuffer);
+
             m_data.clear();
             m_interrupt.store(false);
 
@@ -75,7 +98,7 @@ namespace rpi_cam
             return nxcip::NX_INTERRUPTED;
         }
 
-        if (m_data.empty())
+        if (m_data.empty() && ! heldBuffer)
         {
             debug_print("StreamReader.getNextData() %d failed. Flags: %d\n", m_encoderNumber, rpiFlags);
 
@@ -94,7 +117,43 @@ namespace rpi_cam
         if (rpiFlags & RPiCamera::FLAG_SYNCFRAME)
             flags |= nxcip::MediaDataPacket::fKeyPacket;
 
-        *lpPacket = new VideoPacket(&m_data[0], m_data.size(), timeStamp, flags);
+        std::shared_ptr<uint8_t> data;
+        size_t size = 0;
+        if (heldBuffer)
+        {
+            size = heldBuffer->dataSize();
+
+            // Pass the encoder buffer to the packet if the padding fits in it. The buffer is given
+            // back to the encoder when the packet is released.
+            if (heldBuffer->freeSpace() >= nxcip::MEDIA_PACKET_BUFFER_PADDING_SIZE
+                && (uintptr_t) heldBuffer->data() % nxcip::MEDIA_DATA_BUFFER_ALIGNMENT == 0)
+            {
+                memset(heldBuffer->data() + size, 0, nxcip::MEDIA_PACKET_BUFFER_PADDING_SIZE);
+
+                unsigned encoderNumber = m_encoderNumber;
+                data = std::shared_ptr<uint8_t>(heldBuffer->data(),
+                    [camera, encoderNumber, heldBuffer](uint8_t *)
+                    {
+                        camera->releaseBuffer(encoderNumber, heldBuffer);
+                    });
+            }
+            else
+            {
+                data = m_bufferPool
+                    ? m_bufferPool->copy(heldBuffer->data(), size)
+                    : PacketBufferPool::copyAllocated(heldBuffer->data(), size);
+                camera->releaseBuffer(m_encoderNumber, heldBuffer);
+            }
+        }
+        else
+        {
+            size = m_data.size();
+            data = m_bufferPool
+                ? m_bufferPool->copy(&m_data[0], size)
+                : PacketBufferPool::copyAllocated(&m_data[0], size);
+        }
+
+        *lpPacket = new VideoPacket(data, size, timeStamp, flags);
         return nxcip::NX_NO_ERROR;
     }
 }
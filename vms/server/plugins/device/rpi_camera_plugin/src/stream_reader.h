@@ -12,6 +12,7 @@
 
 #include "ref_counter.h"
 #include "timer.h"
+#include "video_packet.h"
 
 namespace rpi_cam
 {
@@ -39,6 +40,7 @@ namespace rpi_cam
         std::weak_ptr<RPiCamera> m_camera;
         unsigned m_encoderNumber;
         std::vector<uint8_t> m_data;
+        std::shared_ptr<PacketBufferPool> m_bufferPool;
         static TimeCorrection m_timeCorrect;
         uint64_t m_pts;
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstring>
 #include <cstdlib>
+#include <utility>
 
 #include <plugins/plugin_tools.h>
 #include <nx/kit/utils.h>
@@ -16,20 +17,22 @@ namespace rpi_cam
         m_time(ts),
         m_flags(flags)
     {
-        typedef void FreeAlignedFunc(void*); //< Needed to choose the proper overloaded version.
         if (data)
         {
-            m_data = std::shared_ptr<uint8_t>((uint8_t*)
-                nx::kit::utils::mallocAligned(
-                    size + nxcip::MEDIA_PACKET_BUFFER_PADDING_SIZE,
-                    nxcip::MEDIA_DATA_BUFFER_ALIGNMENT),
-                (FreeAlignedFunc*) nx::kit::utils::freeAligned);
-            memcpy( m_data.get(), data, size );
-            memset( m_data.get() + size, 0, nxcip::MEDIA_PACKET_BUFFER_PADDING_SIZE );
+            m_data = PacketBufferPool::copyAllocated(data, size);
             m_size = size;
         }
     }
 
+    VideoPacket::VideoPacket(
+        std::shared_ptr<uint8_t> data, size_t size, uint64_t ts, unsigned flags)
+    :   m_data(std::move(data)),
+        m_size(m_data ? size : 0),
+        m_time(ts),
+        m_flags(flags)
+    {
+    }
+
     VideoPacket::~VideoPacket()
     {
     }
@@ -94,4 +97,78 @@ namespace rpi_cam
     {
         return nullptr;
     }
+
+    //
+
+    std::shared_ptr<PacketBufferPool> PacketBufferPool::create(
+        unsigned buffersNum, size_t bufferSize)
+    {
+        return std::shared_ptr<PacketBufferPool>(new PacketBufferPool(buffersNum, bufferSize));
+    }
+
+    PacketBufferPool::PacketBufferPool(unsigned buffersNum, size_t bufferSize)
+    :   m_bufferSize(bufferSize)
+    {
+        for (unsigned i = 0; i < buffersNum; ++i)
+        {
+            uint8_t * buffer = (uint8_t *) nx::kit::utils::mallocAligned(
+                m_bufferSize + nxcip::MEDIA_PACKET_BUFFER_PADDING_SIZE,
+                nxcip::MEDIA_DATA_BUFFER_ALIGNMENT);
+            if (! buffer)
+                break;
+
+            m_buffers.push_back(buffer);
+        }
+
+        m_freeBuffers = m_buffers;
+    }
+
+    PacketBufferPool::~PacketBufferPool()
+    {
+        for (uint8_t * buffer : m_buffers)
+            nx::kit::utils::freeAligned(buffer);
+    }
+
+    std::shared_ptr<uint8_t> PacketBufferPool::copy(const uint8_t * data, size_t size)
+    {
+        uint8_t * buffer = nullptr;
+        if (size <= m_bufferSize)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex); // LOCK
+
+            if (! m_freeBuffers.empty())
+            {
+                buffer = m_freeBuffers.back();
+                m_freeBuffers.pop_back();
+            }
+        }
+
+        if (! buffer)
+            return copyAllocated(data, size);
+
+        memcpy( buffer, data, size );
+        memset( buffer + size, 0, nxcip::MEDIA_PACKET_BUFFER_PADDING_SIZE );
+
+        std::shared_ptr<PacketBufferPool> pool = shared_from_this();
+        return std::shared_ptr<uint8_t>(buffer, [pool](uint8_t * ptr) { pool->release(ptr); });
+    }
+
+    std::shared_ptr<uint8_t> PacketBufferPool::copyAllocated(const uint8_t * data, size_t size)
+    {
+        typedef void FreeAlignedFunc(void*); //< Needed to choose the proper overloaded version.
+        std::shared_ptr<uint8_t> buffer((uint8_t*)
+            nx::kit::utils::mallocAligned(
+                size + nxcip::MEDIA_PACKET_BUFFER_PADDING_SIZE,
+                nxcip::MEDIA_DATA_BUFFER_ALIGNMENT),
+            (FreeAlignedFunc*) nx::kit::utils::freeAligned);
+        memcpy( buffer.get(), data, size );
+        memset( buffer.get() + size, 0, nxcip::MEDIA_PACKET_BUFFER_PADDING_SIZE );
+        return buffer;
+    }
+
+    void PacketBufferPool::release(uint8_t * buffer)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // LOCK
+        m_freeBuffers.push_back(buffer);
+    }
 }
@@ -4,6 +4,8 @@
 #define RPI_VIDEO_PACKET_H
 
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <camera/camera_plugin.h>
 #include <plugins/plugin_tools.h>
@@ -22,6 +24,9 @@ namespace rpi_cam
         {}
 
         VideoPacket(const uint8_t * data, size_t size, uint64_t ts, unsigned flags);
+
+        /// The data is not copied. It must be aligned and padded as nxcip::MediaDataPacket needs.
+        VideoPacket(std::shared_ptr<uint8_t> data, size_t size, uint64_t ts, unsigned flags);
         virtual ~VideoPacket();
 
         // nxpl::PluginInterface
@@ -58,6 +63,32 @@ namespace rpi_cam
         nxcip::UsecUTCTimestamp m_time;
         unsigned m_flags;
     };
+
+    /// Preallocated aligned and padded buffers for the packet data, reused instead of allocating
+    /// memory for each packet. A buffer returns to the pool when the last packet using it is
+    /// destroyed, the pool lives until then.
+    class PacketBufferPool : public std::enable_shared_from_this<PacketBufferPool>
+    {
+    public:
+        static std::shared_ptr<PacketBufferPool> create(unsigned buffersNum, size_t bufferSize);
+        ~PacketBufferPool();
+
+        /// Copies the data to a free buffer. Allocates a new one if there are no free buffers of
+        /// a sufficient size.
+        std::shared_ptr<uint8_t> copy(const uint8_t * data, size_t size);
+
+        /// Copies the data to a newly allocated buffer.
+        static std::shared_ptr<uint8_t> copyAllocated(const uint8_t * data, size_t size);
+
+    private:
+        std::mutex m_mutex;
+        std::vector<uint8_t *> m_buffers;
+        std::vector<uint8_t *> m_freeBuffers;
+        size_t m_bufferSize;
+
+        PacketBufferPool(unsigned buffersNum, size_t bufferSize);
+        void release(uint8_t * buffer);
+    };
 }
 
 #endif
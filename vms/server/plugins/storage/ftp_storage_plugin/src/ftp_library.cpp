@@ -3,12 +3,15 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -29,6 +32,9 @@
 namespace nx_spl {
 namespace aux {
 
+// Buffer of the local copy of a remote file, big enough to write a media chunk in a few calls.
+static constexpr size_t kFileBufferSize = 1024 * 1024;
+
 // Scoped file remover
 class FileRemover
 {
@@ -408,28 +414,99 @@ public:
     std::optional<FileType> fileType(const std::string& remotePath);
 
 private:
-    void establishFtpConnection();
-    void ftpReconnect() const;
+    std::unique_ptr<ftplib> connect() const;
+    std::unique_ptr<ftplib> takeConnection() const;
+    void returnConnection(std::unique_ptr<ftplib> connection) const;
 
     template<typename F>
     bool executeWithRetry(F f, const std::string& command) const;
 
+    // Must be called after any change of the remote path, so that no stale listing is used.
+    void invalidateListings(const std::string& remotePath);
+
 private:
+    // Each control connection runs one command at a time, so several of them allow the transfers
+    // of the different files to go in parallel.
+    static constexpr int kMaxConnections = 4;
+
+    // Listings are reused for this time, because a single file check or directory iteration
+    // needs a lot of them, and other clients are not expected to change the storage much.
+    static constexpr std::chrono::seconds kListingTtl{5};
+
+    struct Listing
+    {
+        std::chrono::steady_clock::time_point time;
+        std::vector<std::string> entries;
+    };
+
     std::string m_url;
     std::string m_username;
     std::string m_password;
     mutable std::mutex m_mutex;
-    mutable std::unique_ptr<ftplib> m_ftplib;
+    mutable std::condition_variable m_connectionReturned;
+    mutable std::vector<std::unique_ptr<ftplib>> m_idleConnections;
+    mutable int m_connectionCount = 0;
+    mutable std::map<std::string, Listing> m_listings;
+    mutable int m_listingsGeneration = 0;
 };
 
-void FtpLibWrapper::ftpReconnect() const
+// Key of a remote directory listing: a relative path without the trailing '/'.
+static std::string listingKey(const std::string& remotePath)
+{
+    std::string result = toRelativeFtpPath(remotePath);
+    while (result.size() > 1 && result.back() == '/')
+        result.pop_back();
+    return result;
+}
+
+std::unique_ptr<ftplib> FtpLibWrapper::connect() const
 {
-    m_ftplib = std::make_unique<ftplib>();
-    if (m_ftplib->Connect(m_url.data()) == 0)
+    auto connection = std::make_unique<ftplib>();
+    if (connection->Connect(m_url.data()) == 0)
         throw std::runtime_error("Couldn't connect");
 
-    if (m_ftplib->Login(m_username.data(), m_password.data()) == 0)
+    if (connection->Login(m_username.data(), m_password.data()) == 0)
         throw std::runtime_error("Couldn't login");
+
+    return connection;
+}
+
+std::unique_ptr<ftplib> FtpLibWrapper::takeConnection() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_connectionReturned.wait(lock,
+        [this]() { return !m_idleConnections.empty() || m_connectionCount < kMaxConnections; });
+
+    if (!m_idleConnections.empty())
+    {
+        auto connection = std::move(m_idleConnections.back());
+        m_idleConnections.pop_back();
+        return connection;
+    }
+
+    ++m_connectionCount;
+    lock.unlock();
+    try
+    {
+        return connect();
+    }
+    catch (...)
+    {
+        returnConnection(nullptr);
+        throw;
+    }
+}
+
+void FtpLibWrapper::returnConnection(std::unique_ptr<ftplib> connection) const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (connection)
+            m_idleConnections.push_back(std::move(connection));
+        else
+            --m_connectionCount;
+    }
+    m_connectionReturned.notify_one();
 }
 
 FtpLibWrapper::FtpLibWrapper(const std::string& url)
@@ -438,40 +515,77 @@ FtpLibWrapper::FtpLibWrapper(const std::string& url)
     m_url = u.host + ':' + (u.port.empty() ? std::string("21") : u.port);
     m_username = u.uname.empty() ? "anonymous" : u.uname.data();
     m_password = u.upasswd.empty() ? "" : u.upasswd.data();
-    ftpReconnect();
+    m_idleConnections.push_back(connect());
+    m_connectionCount = 1;
 }
 
 template<typename F>
 bool FtpLibWrapper::executeWithRetry(F f, const std::string& command) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (f())
+    std::unique_ptr<ftplib> connection;
+    try
     {
-        log(command + " succeeded");
-        return true;
+        connection = takeConnection();
+    }
+    catch (...)
+    {
+        log(command + " failed. Couldn't connect.");
+        return false;
     }
 
-    try
+    bool result = f(connection.get());
+    if (result)
     {
-        log(command + " failed. Retrying.");
-        ftpReconnect();
-        if (!f())
+        log(command + " succeeded");
+    }
+    else
+    {
+        try
+        {
+            log(command + " failed. Retrying.");
+            connection = connect();
+            result = f(connection.get());
+            if (!result)
+                log(command + " retry failed");
+        }
+        catch(...)
         {
-            log(command + " retry failed");
-            return false;
+            connection.reset();
+            log(command + " retry failed.");
         }
     }
-    catch(...)
+
+    returnConnection(std::move(connection));
+    return result;
+}
+
+void FtpLibWrapper::invalidateListings(const std::string& remotePath)
+{
+    const std::string key = listingKey(remotePath);
+    std::string parentDir;
+    std::string name;
+    dirFromUri(key, &parentDir, &name);
+    const std::string parentKey = listingKey(parentDir);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_listingsGeneration;
+    for (auto it = m_listings.begin(); it != m_listings.end();)
     {
-        log(command + " retry failed.");
-        return false;
+        const std::string& listingPath = it->first;
+        if (listingPath == key || listingPath == parentKey
+            || listingPath.compare(0, key.size() + 1, key + '/') == 0)
+        {
+            it = m_listings.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
     }
-
-    return true;
 }
 
 #define EXEC_WITH_RETRY(command, args) \
-    executeWithRetry([&]() { return m_ftplib->command args; }, #command)
+    executeWithRetry([&](ftplib* ftp) { return ftp->command args; }, #command)
 
 bool FtpLibWrapper::isAvailable() const
 {
@@ -481,7 +595,10 @@ bool FtpLibWrapper::isAvailable() const
 bool FtpLibWrapper::put(const std::string& localPath, const std::string& remotePath)
 {
     log("Put. path: '" + remotePath + "'");
-    return EXEC_WITH_RETRY(Put, (localPath.data(), remotePath.data(), ftplib::image));
+    const bool result =
+        EXEC_WITH_RETRY(Put, (localPath.data(), remotePath.data(), ftplib::image));
+    invalidateListings(remotePath);
+    return result;
 }
 
 bool FtpLibWrapper::get(const std::string& localPath, const std::string& remotePath)
@@ -493,23 +610,45 @@ bool FtpLibWrapper::get(const std::string& localPath, const std::string& remoteP
 bool FtpLibWrapper::removeFile(const std::string& remotePath)
 {
     log("RemoveFile (Delete). path: '" + remotePath + "'");
-    return EXEC_WITH_RETRY(Delete, (remotePath.data()));
+    const bool result = EXEC_WITH_RETRY(Delete, (remotePath.data()));
+    invalidateListings(remotePath);
+    return result;
 }
 
 bool FtpLibWrapper::removeDir(const std::string& remotePath)
 {
     log("RmDir. path: '" + remotePath + "'");
-    return EXEC_WITH_RETRY(Rmdir, (remotePath.data()));
+    const bool result = EXEC_WITH_RETRY(Rmdir, (remotePath.data()));
+    invalidateListings(remotePath);
+    return result;
 }
 
 bool FtpLibWrapper::renameFile(const std::string& oldPath, const std::string& newPath)
 {
     log("Rename. old path: '" + oldPath + "', new path: '" + newPath + "'");
-    return EXEC_WITH_RETRY(Rename, (oldPath.data(), newPath.data()));
+    const bool result = EXEC_WITH_RETRY(Rename, (oldPath.data(), newPath.data()));
+    invalidateListings(oldPath);
+    invalidateListings(newPath);
+    return result;
 }
 
 std::optional<std::vector<std::string>> FtpLibWrapper::nlst(const std::string& remotePath) const
 {
+    using namespace std::chrono;
+
+    const std::string key = listingKey(remotePath);
+    int generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_listings.find(key);
+        if (it != m_listings.end() && steady_clock::now() - it->second.time < kListingTtl)
+        {
+            log("nlst: arg: '" + key + "' (cached)");
+            return it->second.entries;
+        }
+        generation = m_listingsGeneration;
+    }
+
     const auto fileInfo = aux::localUniqueFilePath();
     aux::FileRemover fr(fileInfo.fullPath);
 
@@ -534,6 +673,15 @@ std::optional<std::vector<std::string>> FtpLibWrapper::nlst(const std::string& r
         }
     }
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto now = steady_clock::now();
+    for (auto it = m_listings.begin(); it != m_listings.end();)
+        it = (now - it->second.time < kListingTtl) ? std::next(it) : m_listings.erase(it);
+
+    // The listing is dropped if the directory might have changed while it was being received.
+    if (generation == m_listingsGeneration)
+        m_listings[key] = Listing{now, result};
+
     return result;
 }
 
@@ -595,6 +743,7 @@ bool FtpLibWrapper::makePath(const std::string& dirPath)
 
             log("Mkdir. (whole) path: '" + dirPath + "'");
             EXEC_WITH_RETRY(Mkdir, (dirPath.data()));
+            invalidateListings(dirPath);
             break;
         }
         else
@@ -604,6 +753,7 @@ bool FtpLibWrapper::makePath(const std::string& dirPath)
             {
                 log("Mkdir. path: '" + path + "'");
                 EXEC_WITH_RETRY(Mkdir, (path.data()));
+                invalidateListings(path);
             }
 
             pos = newPos + 1;
@@ -1041,6 +1191,12 @@ FtpIODevice::FtpIODevice(FtpImplPtr ftpImplPtr, const char *uri, int mode):
         // calculate local file size
         if ((m_localsize = aux::getFileSize(m_localfile.fullPath.c_str())) == -1)
             throw std::runtime_error("local file calculate size failed");
+
+        // The local copy is kept open, so that the small reads and writes hit the buffer.
+        m_file = fopen(m_localfile.fullPath.c_str(), "r+b");
+        if (m_file == NULL)
+            throw std::runtime_error("couldn't open local temporary file");
+        setvbuf(m_file, NULL, _IOFBF, aux::kFileBufferSize);
     }
     catch(...)
     {
@@ -1050,6 +1206,7 @@ FtpIODevice::FtpIODevice(FtpImplPtr ftpImplPtr, const char *uri, int mode):
 
 FtpIODevice::~FtpIODevice()
 {
+    fclose(m_file);
     flush();
     remove(m_localfile.fullPath.c_str());
 }
@@ -1072,25 +1229,16 @@ uint32_t FtpIODevice::write(const void* src, const uint32_t size, int* ecode)
         return 0;
     }
 
-    FILE * f = fopen(m_localfile.fullPath.c_str(), "r+b");
-    if (f == NULL)
-        goto bad_end;
-
-    if (fseek(f, (int)m_pos, SEEK_SET) != 0)
-        goto bad_end;
+    if (fseek(m_file, (long) m_pos, SEEK_SET) != 0 || fwrite(src, 1, size, m_file) != size)
+    {
+        *ecode = error::UnknownError;
+        return 0;
+    }
 
-    fwrite(src, 1, size, f);
     m_pos += size;
-    m_localsize += size;
+    m_localsize = std::max<long long>(m_localsize, m_pos);
     m_altered = true;
-    fclose(f);
     return size;
-
-bad_end:
-    if (f != NULL)
-        fclose(f);
-    *ecode = error::UnknownError;
-    return 0;
 }
 
 uint32_t STORAGE_METHOD_CALL FtpIODevice::read(
@@ -1110,25 +1258,17 @@ uint32_t STORAGE_METHOD_CALL FtpIODevice::read(
         return 0;
     }
 
-    FILE * f = fopen(m_localfile.fullPath.c_str(), "rb");
-    if (f == NULL)
-        goto bad_end;
-
     readSize = (uint32_t)(m_pos + size > m_localsize ? m_localsize - m_pos : size);
 
-    if (fseek(f, (int)m_pos, SEEK_SET) != 0)
-        goto bad_end;
+    if (fseek(m_file, (long) m_pos, SEEK_SET) != 0)
+    {
+        *ecode = error::UnknownError;
+        return 0;
+    }
 
-    fread(dst, 1, readSize, f);
+    readSize = (uint32_t) fread(dst, 1, readSize, m_file);
     m_pos += readSize;
-    fclose(f);
     return readSize;
-
-bad_end:
-    if (f != NULL)
-        fclose(f);
-    *ecode = error::UnknownError;
-    return 0;
 }
 
 int STORAGE_METHOD_CALL FtpIODevice::seek(
@@ -1162,6 +1302,7 @@ uint32_t STORAGE_METHOD_CALL FtpIODevice::size(int* ecode) const
         *ecode = error::NoError;
 
     long long ret;
+    fflush(m_file);
     if ((ret = aux::getFileSize(m_localfile.fullPath.c_str())) == -1)
     {
         if (ecode)
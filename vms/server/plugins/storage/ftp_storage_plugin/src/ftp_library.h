@@ -46,6 +46,7 @@
 #include <vector>
 
 #include <stdint.h>
+#include <stdio.h>
 
 #include "ftplibpp/ftplib.h"
 #include "storage/third_party_storage.h"
@@ -157,6 +158,7 @@ class FtpLibWrapper;
         bool m_altered;
         long long m_localsize;
         mutable std::mutex m_mutex;
+        FILE* m_file = nullptr; //< The local copy, opened for the lifetime of the device.
         std::string m_implurl;
         std::string m_user;
         std::string m_passwd;
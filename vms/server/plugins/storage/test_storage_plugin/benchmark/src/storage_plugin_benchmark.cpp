@@ -0,0 +1,434 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+/**@file
+ * Measures the throughput and the operation latency of a Storage plugin under a workload similar
+ * to the one of the Server: the cameras record the chunks of media data, the recorded chunks are
+ * played back, and the oldest chunks are removed to keep the archive size.
+ *
+ * Usage:
+ * <pre><code>
+ * storage_plugin_benchmark --plugin <library> --url <storage url> [options]
+ * </code></pre>
+ * Run without arguments to see the options. To benchmark against a slow or unreliable backend,
+ * use the test storage plugin with the fault injection parameters in the url, for example:
+ * `test://storage/benchmark?config=storage.cfg&latencyMs=20&bytesPerSecond=10000000`.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
+#include <storage/third_party_storage.h>
+
+namespace {
+
+using namespace std::chrono;
+
+struct Options
+{
+    std::string pluginPath;
+    std::string url;
+    int cameras = 8;
+    int readers = 2;
+    seconds duration{30};
+    int chunkSize = 4 * 1024 * 1024;
+    int writeSize = 64 * 1024;
+    int keptChunks = 10; //< Per camera; older chunks are removed.
+    int chunksPerListing = 5; //< Each camera lists its directory after this many chunks.
+};
+
+void printUsage()
+{
+    const Options defaults;
+    std::printf(
+        "Usage: storage_plugin_benchmark --plugin <library> --url <storage url> [options]\n"
+        "Options:\n"
+        "  --cameras <n>       Number of recording cameras; default %d.\n"
+        "  --readers <n>       Number of playback clients; default %d.\n"
+        "  --duration <s>      Duration of the workload; default %d.\n"
+        "  --chunk-size <b>    Size of a recorded chunk; default %d.\n"
+        "  --write-size <b>    Size of a single write or read; default %d.\n"
+        "  --kept-chunks <n>   Chunks kept per camera before the rotation; default %d.\n",
+        defaults.cameras, defaults.readers, (int) defaults.duration.count(), defaults.chunkSize,
+        defaults.writeSize, defaults.keptChunks);
+}
+
+bool parseOptions(int argc, const char* argv[], Options* options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string name = argv[i];
+        const char* value = argv[i + 1];
+        if (name == "--plugin")
+            options->pluginPath = value;
+        else if (name == "--url")
+            options->url = value;
+        else if (name == "--cameras")
+            options->cameras = std::atoi(value);
+        else if (name == "--readers")
+            options->readers = std::atoi(value);
+        else if (name == "--duration")
+            options->duration = seconds(std::atoi(value));
+        else if (name == "--chunk-size")
+            options->chunkSize = std::atoi(value);
+        else if (name == "--write-size")
+            options->writeSize = std::atoi(value);
+        else if (name == "--kept-chunks")
+            options->keptChunks = std::atoi(value);
+        else
+            return false;
+    }
+
+    return argc % 2 == 1 && !options->pluginPath.empty() && !options->url.empty()
+        && options->cameras > 0 && options->chunkSize > 0 && options->writeSize > 0;
+}
+
+/** Path part of the storage url; the Server passes the paths in this form to the plugin. */
+std::string pathFromUrl(const std::string& url)
+{
+    const auto schemeEnd = url.find("://");
+    const auto pathStart = url.find('/', schemeEnd == std::string::npos ? 0 : schemeEnd + 3);
+    if (pathStart == std::string::npos)
+        return std::string();
+
+    const auto pathEnd = url.find('?', pathStart);
+    std::string path = url.substr(pathStart, pathEnd - pathStart);
+    while (!path.empty() && path.back() == '/')
+        path.pop_back();
+    return path;
+}
+
+class Stats
+{
+public:
+    void add(const std::string& operation, microseconds latency, bool success, int64_t bytes = 0)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& stats = m_operations[operation];
+        stats.latenciesUs.push_back(latency.count());
+        if (success)
+            stats.bytes += bytes;
+        else
+            ++stats.failures;
+    }
+
+    void print(duration<double> elapsed, double cpuSeconds)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::printf("%-10s %8s %8s %10s %10s %10s %10s\n",
+            "operation", "count", "failed", "p50 ms", "p95 ms", "p99 ms", "max ms");
+
+        for (auto& [operation, stats]: m_operations)
+        {
+            auto& latencies = stats.latenciesUs;
+            std::sort(latencies.begin(), latencies.end());
+            const auto percentile =
+                [&latencies](double p)
+                {
+                    return latencies[(size_t) (p * (latencies.size() - 1))] / 1000.0;
+                };
+
+            std::printf("%-10s %8d %8d %10.2f %10.2f %10.2f %10.2f\n",
+                operation.c_str(), (int) latencies.size(), stats.failures,
+                percentile(0.5), percentile(0.95), percentile(0.99), percentile(1.0));
+        }
+
+        const double writtenMb = m_operations["write"].bytes / 1e6;
+        const double readMb = m_operations["read"].bytes / 1e6;
+        std::printf("\nElapsed: %.1f s\n", elapsed.count());
+        std::printf("Write throughput: %.2f MB/s (%.1f MB)\n", writtenMb / elapsed.count(),
+            writtenMb);
+        std::printf("Read throughput: %.2f MB/s (%.1f MB)\n", readMb / elapsed.count(), readMb);
+        std::printf("CPU time: %.2f s, %.3f s per 100 MB transferred\n", cpuSeconds,
+            (writtenMb + readMb) > 0 ? cpuSeconds * 100 / (writtenMb + readMb) : 0.0);
+    }
+
+private:
+    struct OperationStats
+    {
+        std::vector<int64_t> latenciesUs;
+        int64_t bytes = 0;
+        int failures = 0;
+    };
+
+    std::mutex m_mutex;
+    std::map<std::string, OperationStats> m_operations;
+};
+
+/** Measures the latency of a single operation and reports it to the stats. */
+template<typename Operation>
+auto measure(Stats* stats, const std::string& name, Operation operation)
+{
+    int ecode = nx_spl::error::NoError;
+    int64_t bytes = 0;
+    const auto start = steady_clock::now();
+    const auto result = operation(&ecode, &bytes);
+    stats->add(name, duration_cast<microseconds>(steady_clock::now() - start),
+        ecode == nx_spl::error::NoError, bytes);
+    return ecode == nx_spl::error::NoError ? result : decltype(result){};
+}
+
+class Workload
+{
+public:
+    Workload(const Options& options, nx_spl::Storage* storage):
+        m_options(options),
+        m_storage(storage),
+        m_basePath(pathFromUrl(options.url) + "/storage_plugin_benchmark")
+    {
+    }
+
+    void run()
+    {
+        m_deadline = steady_clock::now() + m_options.duration;
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < m_options.cameras; ++i)
+            threads.emplace_back([this, i]() { record(i); });
+        for (int i = 0; i < m_options.readers; ++i)
+            threads.emplace_back([this]() { playBack(); });
+
+        for (auto& thread: threads)
+            thread.join();
+    }
+
+    Stats* stats() { return &m_stats; }
+
+private:
+    void record(int camera)
+    {
+        const std::string dir = m_basePath + "/camera" + std::to_string(camera);
+        const std::vector<char> data(m_options.writeSize, 'x');
+        std::deque<std::string> chunks;
+
+        for (int chunkIndex = 0; steady_clock::now() < m_deadline; ++chunkIndex)
+        {
+            const std::string path = dir + "/" + std::to_string(chunkIndex) + ".mkv";
+            if (writeChunk(path, data))
+            {
+                chunks.push_back(path);
+                std::lock_guard<std::mutex> lock(m_chunksMutex);
+                m_recordedChunks.push_back(path);
+            }
+
+            // Rotation: the Server removes the oldest chunks when the storage is full.
+            while ((int) chunks.size() > m_options.keptChunks)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_chunksMutex);
+                    m_recordedChunks.erase(std::remove(
+                        m_recordedChunks.begin(), m_recordedChunks.end(), chunks.front()),
+                        m_recordedChunks.end());
+                }
+                measure(&m_stats, "remove",
+                    [&](int* ecode, int64_t*)
+                    {
+                        m_storage->removeFile(chunks.front().c_str(), ecode);
+                        return true;
+                    });
+                chunks.pop_front();
+            }
+
+            // Indexing: the Server lists the archive directories to rebuild the chunk index.
+            if (chunkIndex % m_options.chunksPerListing == 0)
+                listDirectory(dir);
+        }
+    }
+
+    bool writeChunk(const std::string& path, const std::vector<char>& data)
+    {
+        nx_spl::IODevice* const file = measure(&m_stats, "open",
+            [&](int* ecode, int64_t*)
+            {
+                return m_storage->open(path.c_str(), nx_spl::io::WriteOnly, ecode);
+            });
+        if (!file)
+            return false;
+
+        bool success = true;
+        for (int written = 0; success && written < m_options.chunkSize;
+            written += (int) data.size())
+        {
+            success = measure(&m_stats, "write",
+                [&](int* ecode, int64_t* bytes)
+                {
+                    *bytes = file->write(data.data(), (uint32_t) data.size(), ecode);
+                    return true;
+                });
+        }
+
+        // Many plugins upload the data when the file is closed.
+        measure(&m_stats, "close",
+            [&](int*, int64_t*)
+            {
+                file->releaseRef();
+                return true;
+            });
+        return success;
+    }
+
+    void listDirectory(const std::string& dir)
+    {
+        measure(&m_stats, "list",
+            [&](int* ecode, int64_t*)
+            {
+                nx_spl::FileInfoIterator* const iterator =
+                    m_storage->getFileIterator(dir.c_str(), ecode);
+                if (!iterator)
+                    return false;
+
+                int nextEcode = nx_spl::error::NoError;
+                while (iterator->next(&nextEcode))
+                {
+                }
+                iterator->releaseRef();
+                return true;
+            });
+    }
+
+    void playBack()
+    {
+        std::mt19937 random(std::random_device{}());
+        std::vector<char> buffer(m_options.writeSize);
+        while (steady_clock::now() < m_deadline)
+        {
+            std::string path;
+            {
+                std::lock_guard<std::mutex> lock(m_chunksMutex);
+                if (!m_recordedChunks.empty())
+                {
+                    path = m_recordedChunks[
+                        std::uniform_int_distribution<size_t>(
+                            0, m_recordedChunks.size() - 1)(random)];
+                }
+            }
+
+            if (path.empty())
+            {
+                std::this_thread::sleep_for(milliseconds(100));
+                continue;
+            }
+
+            nx_spl::IODevice* const file = measure(&m_stats, "open",
+                [&](int* ecode, int64_t*)
+                {
+                    return m_storage->open(path.c_str(), nx_spl::io::ReadOnly, ecode);
+                });
+            if (!file)
+                continue;
+
+            for (;;)
+            {
+                const uint32_t readBytes = measure(&m_stats, "read",
+                    [&](int* ecode, int64_t* bytes)
+                    {
+                        *bytes = file->read(buffer.data(), (uint32_t) buffer.size(), ecode);
+                        return (uint32_t) *bytes;
+                    });
+                if (readBytes == 0)
+                    break;
+            }
+            file->releaseRef();
+        }
+    }
+
+private:
+    const Options m_options;
+    nx_spl::Storage* const m_storage;
+    const std::string m_basePath;
+    steady_clock::time_point m_deadline;
+    Stats m_stats;
+    std::mutex m_chunksMutex;
+    std::vector<std::string> m_recordedChunks;
+};
+
+nx_spl::StorageFactory* loadStorageFactory(const std::string& pluginPath)
+{
+    using CreatePluginInstance = nxpl::PluginInterface* (*)();
+
+    #if defined(_WIN32)
+        const HMODULE library = LoadLibraryA(pluginPath.c_str());
+        const auto createPluginInstance = library
+            ? (CreatePluginInstance) GetProcAddress(library, "createNXPluginInstance")
+            : nullptr;
+    #else
+        void* const library = dlopen(pluginPath.c_str(), RTLD_NOW);
+        if (!library)
+            std::fprintf(stderr, "%s\n", dlerror());
+        const auto createPluginInstance = library
+            ? (CreatePluginInstance) dlsym(library, "createNXPluginInstance")
+            : nullptr;
+    #endif
+
+    if (!createPluginInstance)
+        return nullptr;
+
+    nxpl::PluginInterface* const plugin = createPluginInstance();
+    if (!plugin)
+        return nullptr;
+
+    const auto factory = static_cast<nx_spl::StorageFactory*>(
+        plugin->queryInterface(nx_spl::IID_StorageFactory));
+    plugin->releaseRef();
+    return factory;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, &options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    nx_spl::StorageFactory* const factory = loadStorageFactory(options.pluginPath);
+    if (!factory)
+    {
+        std::fprintf(stderr, "Unable to load a Storage plugin from %s\n",
+            options.pluginPath.c_str());
+        return 1;
+    }
+
+    int ecode = nx_spl::error::NoError;
+    nx_spl::Storage* const storage = factory->createStorage(options.url.c_str(), &ecode);
+    if (!storage)
+    {
+        std::fprintf(stderr, "Unable to create the storage %s: %s\n", options.url.c_str(),
+            factory->lastErrorMessage(ecode));
+        factory->releaseRef();
+        return 1;
+    }
+
+    Workload workload(options, storage);
+    const auto start = steady_clock::now();
+    const std::clock_t cpuStart = std::clock();
+    workload.run();
+
+    // NOTE: On Windows, std::clock() measures the wall time rather than the CPU time.
+    const double cpuSeconds = (double) (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    workload.stats()->print(steady_clock::now() - start, cpuSeconds);
+
+    storage->releaseRef();
+    factory->releaseRef();
+    return 0;
+}
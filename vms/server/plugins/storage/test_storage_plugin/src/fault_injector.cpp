@@ -0,0 +1,55 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include <fault_injector.h>
+
+namespace {
+
+template<typename T>
+T paramValue(const utils::ParamsMap& params, const std::string& name, T defaultValue)
+{
+    const auto it = params.find(name);
+    if (it == params.cend())
+        return defaultValue;
+
+    return (T) std::strtod(it->second.c_str(), nullptr);
+}
+
+}
+
+FaultInjector::Settings FaultInjector::settingsFromParams(const utils::ParamsMap& params)
+{
+    Settings settings;
+    settings.latencyMs = paramValue(params, "latencyMs", settings.latencyMs);
+    settings.bytesPerSecond = paramValue(params, "bytesPerSecond", settings.bytesPerSecond);
+    settings.failureRate = paramValue(params, "failureRate", settings.failureRate);
+    return settings;
+}
+
+FaultInjector::FaultInjector(const Settings& settings):
+    m_settings(settings),
+    m_random(std::random_device()())
+{
+}
+
+bool FaultInjector::onOperation(int64_t dataSize) const
+{
+    using namespace std::chrono;
+
+    microseconds delay = milliseconds(std::max(m_settings.latencyMs, 0));
+    if (m_settings.bytesPerSecond > 0 && dataSize > 0)
+        delay += microseconds(dataSize * 1000000 / m_settings.bytesPerSecond);
+
+    if (delay.count() > 0)
+        std::this_thread::sleep_for(delay);
+
+    if (m_settings.failureRate <= 0)
+        return true;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::uniform_real_distribution<double>(0, 1)(m_random) >= m_settings.failureRate;
+}
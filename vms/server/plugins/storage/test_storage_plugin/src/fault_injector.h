@@ -0,0 +1,51 @@
+// Copyright 2018-present Network Optix, Inc. Licensed under MPL 2.0: www.mozilla.org/MPL/2.0/
+
+#pragma once
+
+#include <mutex>
+#include <random>
+
+#include <stdint.h>
+
+#include <url.h>
+
+/**
+ * Makes the storage behave like a remote one, so that the Server and the storage plugin benchmark
+ * can be tested against a slow or unreliable backend. Configured via the storage url parameters:
+ * - latencyMs: delay of each operation.
+ * - bytesPerSecond: bandwidth limit of the reads and writes, per operation.
+ * - failureRate: probability of an operation to fail, from 0 to 1.
+ *
+ * For example: `test://storage/path?config=storage.cfg&latencyMs=20&failureRate=0.01`
+ */
+class FaultInjector
+{
+public:
+    struct Settings
+    {
+        int latencyMs = 0;
+        int64_t bytesPerSecond = 0; //< 0 means no limit.
+        double failureRate = 0;
+
+        bool isEmpty() const
+        {
+            return latencyMs <= 0 && bytesPerSecond <= 0 && failureRate <= 0;
+        }
+    };
+
+    static Settings settingsFromParams(const utils::ParamsMap& params);
+
+    FaultInjector(const Settings& settings);
+
+    /**
+     * Delays the operation according to the settings.
+     * @param dataSize Amount of data read or written by the operation.
+     * @return Whether the operation should succeed.
+     */
+    bool onOperation(int64_t dataSize = 0) const;
+
+private:
+    const Settings m_settings;
+    mutable std::mutex m_mutex;
+    mutable std::mt19937 m_random;
+};
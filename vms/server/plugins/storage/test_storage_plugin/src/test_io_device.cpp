@@ -48,6 +48,11 @@ int TestIODevice::releaseRef() const
     return pReleaseRef();
 }
 
+void TestIODevice::setFaultInjector(std::shared_ptr<FaultInjector> faultInjector)
+{
+    m_faultInjector = std::move(faultInjector);
+}
+
 uint32_t TestIODevice::write(const void* /*src*/, const uint32_t size, int* ecode)
 {
     if (!(m_mode & nx_spl::io::WriteOnly))
@@ -57,6 +62,12 @@ uint32_t TestIODevice::write(const void* /*src*/, const uint32_t size, int* ecod
         return 0;
     }
 
+    if (m_faultInjector && !m_faultInjector->onOperation(size))
+    {
+        setEcode(ecode, nx_spl::error::UnknownError);
+        return 0;
+    }
+
     if (ecode)
         *ecode = nx_spl::error::NoError;
     return size;
@@ -64,6 +75,12 @@ uint32_t TestIODevice::write(const void* /*src*/, const uint32_t size, int* ecod
 
 uint32_t TestIODevice::read(void* dst, const uint32_t size, int* ecode) const
 {
+    if (m_faultInjector && !m_faultInjector->onOperation(size))
+    {
+        setEcode(ecode, nx_spl::error::UnknownError);
+        return 0;
+    }
+
     switch (m_category)
     {
     case FileCategory::db:
@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <common.h>
+#include <fault_injector.h>
 
 #include <detail/fs_stub.h>
 #include <storage/third_party_storage.h>
@@ -24,6 +26,9 @@ public:
     TestIODevice(const std::string& name, FileCategory category,
                  int mode, int64_t size = 0, FILE* f = nullptr);
     ~TestIODevice();
+
+    void setFaultInjector(std::shared_ptr<FaultInjector> faultInjector);
+
 public:
     virtual uint32_t STORAGE_METHOD_CALL write(
         const void*     src,
@@ -65,4 +70,5 @@ private:
     int64_t m_size;
     FILE* m_file;
     mutable int m_camInfoPos;
+    std::shared_ptr<FaultInjector> m_faultInjector;
 };
@@ -56,12 +56,24 @@ bool nodeExists(struct FsStubNode* root, const char* url, int* ecode)
 
 TestStorage::TestStorage(const utils::VfsPair& vfsPair,
                          const std::string& prefix,
-                         std::function<void()> onDestroyCb):
+                         std::function<void()> onDestroyCb,
+                         std::shared_ptr<FaultInjector> faultInjector):
     m_vfsPair(vfsPair),
     m_prefix(prefix),
-    m_onDestroyCb(onDestroyCb)
+    m_onDestroyCb(onDestroyCb),
+    m_faultInjector(std::move(faultInjector))
 {}
 
+bool TestStorage::injectFault(int* ecode) const
+{
+    if (!m_faultInjector || m_faultInjector->onOperation())
+        return true;
+
+    if (ecode)
+        *ecode = nx_spl::error::StorageUnavailable;
+    return false;
+}
+
 TestStorage::~TestStorage()
 {
     m_onDestroyCb();
@@ -75,6 +87,10 @@ int STORAGE_METHOD_CALL TestStorage::isAvailable() const
 nx_spl::IODevice* STORAGE_METHOD_CALL TestStorage::open(
     const char* url, int flags, int* ecode) const
 {
+    if (!injectFault(ecode))
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_vfsMutex);
     FileCategory category = FileCategory::media;
     if (strstr(url, ".nxdb") != nullptr)
     {
@@ -146,7 +162,9 @@ nx_spl::IODevice* TestStorage::createIODevice(
     if (ecode)
         *ecode = nx_spl::error::NoError;
 
-    return new TestIODevice(name, (FileCategory)category, flags, size, f);
+    auto ioDevice = new TestIODevice(name, (FileCategory)category, flags, size, f);
+    ioDevice->setFaultInjector(m_faultInjector);
+    return ioDevice;
 }
 
 uint64_t STORAGE_METHOD_CALL TestStorage::getFreeSpace(int* ecode) const
@@ -173,6 +191,10 @@ void STORAGE_METHOD_CALL TestStorage::removeFile(
     int*        ecode
 )
 {
+    if (!injectFault(ecode))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_vfsMutex);
     removeNode(m_vfsPair.root, file, urlToPath(url).c_str(), ecode);
 }
 
@@ -181,6 +203,10 @@ void STORAGE_METHOD_CALL TestStorage::removeDir(
     int*        ecode
 )
 {
+    if (!injectFault(ecode))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_vfsMutex);
     removeNode(m_vfsPair.root, dir, urlToPath(url).c_str(), ecode);
 }
 
@@ -197,6 +223,10 @@ void STORAGE_METHOD_CALL TestStorage::renameFile(
         return;
     }
 
+    if (!injectFault(ecode))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_vfsMutex);
     struct FsStubNode* nodeToRename = FsStubNode_find(m_vfsPair.root, urlToPath(oldUrl).c_str());
     if (nodeToRename == nullptr || nodeToRename->type != file)
     {
@@ -229,6 +259,10 @@ nx_spl::FileInfoIterator* STORAGE_METHOD_CALL TestStorage::getFileIterator(
     int*            ecode
 ) const
 {
+    if (!injectFault(ecode))
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_vfsMutex);
     struct FsStubNode* fsNode = FsStubNode_find(m_vfsPair.root, urlToPath(dirUrl).c_str());
     if (fsNode == nullptr)
     {
@@ -249,6 +283,10 @@ int STORAGE_METHOD_CALL TestStorage::fileExists(
     int*            ecode
 ) const
 {
+    if (!injectFault(ecode))
+        return 0;
+
+    std::lock_guard<std::mutex> lock(m_vfsMutex);
     return nodeExists(m_vfsPair.root, urlToPath(url).c_str(), ecode);
 }
 
@@ -257,6 +295,10 @@ int STORAGE_METHOD_CALL TestStorage::dirExists(
     int*            ecode
 ) const
 {
+    if (!injectFault(ecode))
+        return 0;
+
+    std::lock_guard<std::mutex> lock(m_vfsMutex);
     return nodeExists(m_vfsPair.root, urlToPath(url).c_str(), ecode);
 }
 
@@ -265,6 +307,10 @@ uint64_t STORAGE_METHOD_CALL TestStorage::fileSize(
     int*            ecode
 ) const
 {
+    if (!injectFault(ecode))
+        return unknown_size;
+
+    std::lock_guard<std::mutex> lock(m_vfsMutex);
     struct FsStubNode* fsNode = FsStubNode_find(m_vfsPair.root, urlToPath(url).c_str());
     if (fsNode == nullptr)
     {
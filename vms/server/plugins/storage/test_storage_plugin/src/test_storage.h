@@ -3,8 +3,11 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <mutex>
 
 #include <common.h>
+#include <fault_injector.h>
 #include <vfs.h>
 
 #include <storage/third_party_storage.h>
@@ -18,7 +21,8 @@ class TestStorage:
 public:
     TestStorage(const utils::VfsPair& vfsPair,
                 const std::string& prefix,
-                std::function<void()> onDestroyCb);
+                std::function<void()> onDestroyCb,
+                std::shared_ptr<FaultInjector> faultInjector = nullptr);
     virtual ~TestStorage();
 
     virtual int STORAGE_METHOD_CALL isAvailable() const override;
@@ -84,8 +88,16 @@ private:
         int64_t size,
         int* ecode) const;
 
+private:
+    /** @return Whether the operation should succeed; sets ecode if not. */
+    bool injectFault(int* ecode) const;
+
 private:
     utils::VfsPair m_vfsPair;
     const std::string m_prefix;
     std::function<void()> m_onDestroyCb;
+    std::shared_ptr<FaultInjector> m_faultInjector;
+
+    /** The Server calls the storage from many threads, while the VFS is not thread-safe. */
+    mutable std::mutex m_vfsMutex;
 };
@@ -160,12 +160,16 @@ nx_spl::Storage* TestStorageFactory::createStorageImpl(
     const utils::VfsPair& vfsPair,
     const ::utils::Url& url)
 {
+    const auto faultInjectorSettings = FaultInjector::settingsFromParams(url.params());
     return new TestStorage(vfsPair, url.scheme() + "://" + url.host(),
         [this, url]()
         {
             std::lock_guard<std::mutex> lock(m_storageHostsMutex);
             m_storageHosts.erase(url.host());
-        });
+        },
+        faultInjectorSettings.isEmpty()
+            ? nullptr
+            : std::make_shared<FaultInjector>(faultInjectorSettings));
 }
 
 const char* STORAGE_METHOD_CALL TestStorageFactory::storageType() const